@@ -111,6 +111,8 @@ public class CesiumEditor : ModuleRules
                 "SlateCore",
                 "MeshDescription",
                 "StaticMeshDescription",
+                "MeshMergeUtilities",
+                "MeshReductionInterface",
                 "HTTP",
                 "MikkTSpace",
                 "Chaos",
@@ -0,0 +1,173 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumBakeTilesCommandlet.h"
+#include "Cesium3DTileset.h"
+#include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumCachePrewarmer.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumEditor.h"
+#include "CesiumEditorTicking.h"
+#include "CesiumRuntime.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace {
+
+// How often, in seconds, the progress of the bake is logged.
+constexpr double progressLogInterval = 5.0;
+
+template <typename T>
+T* findActorByLabel(UWorld* pWorld, const FString& label) {
+  for (TActorIterator<T> it(pWorld); it; ++it) {
+    if (it->GetActorLabel() == label) {
+      return *it;
+    }
+  }
+  return nullptr;
+}
+
+UWorld* loadWorld(const FString& map) {
+  UPackage* pPackage = LoadPackage(nullptr, *map, LOAD_None);
+  UWorld* pWorld = pPackage ? UWorld::FindWorldInPackage(pPackage) : nullptr;
+  if (!pWorld) {
+    return nullptr;
+  }
+
+  pWorld->WorldType = EWorldType::Editor;
+  GEngine->CreateNewWorldContext(EWorldType::Editor).SetCurrentWorld(pWorld);
+  if (!pWorld->bIsWorldInitialized) {
+    pWorld->InitWorld(UWorld::InitializationValues()
+                          .AllowAudioPlayback(false)
+                          .CreatePhysicsScene(true)
+                          .ShouldSimulatePhysics(false));
+  }
+  pWorld->UpdateWorldComponents(true, false);
+  return pWorld;
+}
+
+} // namespace
+
+UCesiumBakeTilesCommandlet::UCesiumBakeTilesCommandlet() {
+  this->IsClient = false;
+  this->IsServer = false;
+  this->IsEditor = true;
+  this->LogToConsole = true;
+}
+
+int32 UCesiumBakeTilesCommandlet::Main(const FString& Params) {
+  FString output;
+  FString map;
+  FString tilesetLabel;
+  FString regionLabel;
+  double maximumScreenSpaceError = 16.0;
+  double viewHeight = 500.0;
+  FParse::Value(*Params, TEXT("CesiumRequestCache="), output);
+  FParse::Value(*Params, TEXT("Map="), map);
+  FParse::Value(*Params, TEXT("Tileset="), tilesetLabel);
+  FParse::Value(*Params, TEXT("Region="), regionLabel);
+  FParse::Value(
+      *Params,
+      TEXT("MaximumScreenSpaceError="),
+      maximumScreenSpaceError);
+  FParse::Value(*Params, TEXT("ViewHeight="), viewHeight);
+
+  // The cache database is created from the process command line, so the
+  // output can't be given any other way.
+  if (output.IsEmpty() || map.IsEmpty() || tilesetLabel.IsEmpty() ||
+      regionLabel.IsEmpty()) {
+    UE_LOG(
+        LogCesiumEditor,
+        Error,
+        TEXT(
+            "Usage: -run=CesiumBakeTiles -CesiumRequestCache=<Output.sqlite> -Map=<Package> -Tileset=<Label> -Region=<Label> [-MaximumScreenSpaceError=16] [-ViewHeight=500]"));
+    return 1;
+  }
+
+  UWorld* pWorld = loadWorld(map);
+  if (!pWorld) {
+    UE_LOG(LogCesiumEditor, Error, TEXT("Could not load the map %s."), *map);
+    return 1;
+  }
+
+  ACesium3DTileset* pTileset =
+      findActorByLabel<ACesium3DTileset>(pWorld, tilesetLabel);
+  ACesiumCartographicPolygon* pRegion =
+      findActorByLabel<ACesiumCartographicPolygon>(pWorld, regionLabel);
+  if (!pTileset || !pRegion) {
+    UE_LOG(
+        LogCesiumEditor,
+        Error,
+        TEXT("The map %s has no tileset %s or no cartographic polygon %s."),
+        *map,
+        *tilesetLabel,
+        *regionLabel);
+    return 1;
+  }
+
+  getCacheDatabase()->clearAll();
+
+  // Loading the tiles with physics meshes caches the cooked meshes too.
+  pTileset->UpdateInEditor = true;
+  pTileset->SetCreatePhysicsMeshes(true);
+
+  UCesiumCachePrewarmer* pPrewarmer = NewObject<UCesiumCachePrewarmer>();
+  pPrewarmer->AddToRoot();
+  pPrewarmer->Tileset = pTileset;
+  pPrewarmer->Region = pRegion;
+  pPrewarmer->MaximumScreenSpaceError = maximumScreenSpaceError;
+  pPrewarmer->ViewHeight = viewHeight;
+
+  if (!pPrewarmer->Start()) {
+    pPrewarmer->RemoveFromRoot();
+    return 1;
+  }
+
+  const double startTime = FPlatformTime::Seconds();
+  double lastTime = startTime;
+  double lastLogTime = startTime;
+  while (pPrewarmer->IsRunning()) {
+    const double now = FPlatformTime::Seconds();
+    CesiumEditorTicking::tick(pWorld, float(now - lastTime));
+    lastTime = now;
+
+    if (now - lastLogTime >= progressLogInterval) {
+      lastLogTime = now;
+      const FCesiumCachePrewarmProgress progress = pPrewarmer->GetProgress();
+      UE_LOG(
+          LogCesiumEditor,
+          Display,
+          TEXT("Baked %d of %d views (%.0f%% of the current step loaded)"),
+          progress.CompletedViews,
+          progress.TotalViews,
+          progress.CurrentLoadProgress);
+    }
+
+    FPlatformProcess::Sleep(0.0f);
+  }
+
+  const FCesiumCachePrewarmProgress progress = pPrewarmer->GetProgress();
+  const bool complete = progress.CompletedViews == progress.TotalViews;
+  pPrewarmer->RemoveFromRoot();
+  flushCacheDatabase();
+
+  const int64 sizeBytes = IFileManager::Get().FileSize(
+      *FPaths::ConvertRelativePathToFull(output));
+  UE_LOG(
+      LogCesiumEditor,
+      Display,
+      TEXT("%s baking %s in %.0f seconds: %s is %.1f MB."),
+      complete ? TEXT("Finished") : TEXT("Stopped"),
+      *regionLabel,
+      FPlatformTime::Seconds() - startTime,
+      *output,
+      double(FMath::Max<int64>(sizeBytes, 0)) / (1024.0 * 1024.0));
+
+  return complete ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "CoreMinimal.h"
+#include "CesiumBakeTilesCommandlet.generated.h"
+
+/**
+ * Bakes the tiles of a region of a tileset into a request cache database that
+ * can be shipped with a project and named in the Baked Cache Filename of the
+ * Cesium runtime settings, so that the region loads without the network.
+ *
+ * The region is loaded with a `CesiumCachePrewarmer`, with physics meshes, so
+ * the responses of every tile down to the chosen screen-space error, and the
+ * cooked physics meshes of the tiles, end up in the database.
+ *
+ * Usage:
+ *
+ *   UnrealEditor-Cmd <Project> -run=CesiumBakeTiles
+ *     -CesiumRequestCache=<Output.sqlite> -Map=<Package> -Tileset=<Label>
+ *     -Region=<Label> [-MaximumScreenSpaceError=16] [-ViewHeight=500]
+ *
+ * The tileset and the region are the labels of a `Cesium3DTileset` and a
+ * `CesiumCartographicPolygon` in the map. The output database is cleared
+ * first.
+ */
+UCLASS()
+class UCesiumBakeTilesCommandlet : public UCommandlet {
+  GENERATED_BODY()
+
+public:
+  UCesiumBakeTilesCommandlet();
+
+  virtual int32 Main(const FString& Params) override;
+};
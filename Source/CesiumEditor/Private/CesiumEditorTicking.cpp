@@ -0,0 +1,32 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumEditorTicking.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/World.h"
+#include "HttpManager.h"
+#include "HttpModule.h"
+#include "Misc/CoreDelegates.h"
+#include "RenderingThread.h"
+#include "Tickable.h"
+
+namespace CesiumEditorTicking {
+
+void tick(UWorld* pWorld, float deltaTime) {
+  FHttpModule::Get().GetHttpManager().Tick(deltaTime);
+  FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+  pWorld->Tick(LEVELTICK_ViewportsOnly, deltaTime);
+  FTickableGameObject::TickObjects(
+      nullptr,
+      LEVELTICK_ViewportsOnly,
+      false,
+      deltaTime);
+  FTSTicker::GetCoreTicker().Tick(deltaTime);
+  FlushRenderingCommands();
+  // The runtime module updates the state shared by all tilesets at the end
+  // of each frame.
+  FCoreDelegates::OnEndFrame.Broadcast();
+  ++GFrameCounter;
+}
+
+} // namespace CesiumEditorTicking
@@ -0,0 +1,19 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+namespace CesiumEditorTicking {
+
+/**
+ * @brief Runs one frame of the engine loop that matters to loading tiles
+ * outside of the engine's own loop, such as in a commandlet: network
+ * responses, main thread tasks, the world with its tilesets, the tickable
+ * objects, the render thread, and the end of the frame.
+ */
+void tick(UWorld* pWorld, float deltaTime);
+
+} // namespace CesiumEditorTicking
@@ -65,6 +65,15 @@ void FCesiumGlobeAnchorCustomization::CustomizeDetails(
   CesiumCategory.AddProperty(GET_MEMBER_NAME_CHECKED(
       UCesiumGlobeAnchorComponent,
       TeleportWhenUpdatingTransform));
+  CesiumCategory.AddProperty(GET_MEMBER_NAME_CHECKED(
+      UCesiumGlobeAnchorComponent,
+      UseLocalGeodeticApproximation));
+  CesiumCategory.AddProperty(GET_MEMBER_NAME_CHECKED(
+      UCesiumGlobeAnchorComponent,
+      LocalGeodeticApproximationRadius));
+  CesiumCategory.AddProperty(GET_MEMBER_NAME_CHECKED(
+      UCesiumGlobeAnchorComponent,
+      BatchTransformChanges));
 
   this->UpdateDerivedProperties();
 
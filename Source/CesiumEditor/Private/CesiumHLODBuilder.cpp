@@ -0,0 +1,196 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumHLODBuilder.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCamera.h"
+#include "CesiumCameraManager.h"
+#include "CesiumEditor.h"
+#include "CesiumEditorTicking.h"
+#include "CesiumHLODSource.h"
+#include "CesiumHLODSourceComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "IMeshMergeUtilities.h"
+#include "IMeshReductionInterfaces.h"
+#include "MeshMergeModule.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/ArchiveCrc32.h"
+
+namespace {
+
+// The view from above a box, which it fills.
+constexpr double viewFieldOfViewDegrees = 90.0;
+const FVector2D viewViewportSize(1024.0, 1024.0);
+
+// The number of frames to tick before the tileset's load progress means that
+// it has selected the tiles for the view.
+constexpr int32 minimumFramesToLoad = 2;
+
+/**
+ * Adds the primitives of the tiles of a tileset that are shown inside a box.
+ */
+void gatherTilePrimitives(
+    const ACesium3DTileset& tileset,
+    const FBox& box,
+    TArray<UStaticMeshComponent*>& primitives) {
+  USceneComponent* pRoot = tileset.GetRootComponent();
+  if (!pRoot) {
+    return;
+  }
+
+  TArray<USceneComponent*> children;
+  pRoot->GetChildrenComponents(true, children);
+  for (USceneComponent* pChild : children) {
+    UStaticMeshComponent* pPrimitive = Cast<UStaticMeshComponent>(pChild);
+    if (!IsValid(pPrimitive) ||
+        pPrimitive->IsA<UInstancedStaticMeshComponent>() ||
+        !pPrimitive->GetStaticMesh() || !pPrimitive->IsVisible() ||
+        !pPrimitive->Bounds.GetBox().Intersect(box)) {
+      continue;
+    }
+    primitives.Add(pPrimitive);
+  }
+}
+
+/**
+ * Loads the tiles of a tileset inside a box to the maximum screen space error
+ * of the settings, and adds the primitives of those tiles.
+ */
+void captureTiles(
+    ACesium3DTileset& tileset,
+    const FBox& box,
+    const UCesiumHLODBuilderSettings& settings,
+    TArray<UStaticMeshComponent*>& primitives) {
+  UWorld* pWorld = tileset.GetWorld();
+  ACesiumCameraManager* pCameraManager = tileset.ResolveCameraManager();
+  if (!pWorld || !pCameraManager) {
+    return;
+  }
+
+  const FVector extent = box.GetExtent();
+  const double viewDistance =
+      FMath::Max(extent.X, extent.Y) /
+      FMath::Tan(FMath::DegreesToRadians(viewFieldOfViewDegrees * 0.5));
+  const FCesiumCamera camera(
+      viewViewportSize,
+      box.GetCenter() + FVector(0.0, 0.0, extent.Z + viewDistance),
+      FRotator(-90.0, 0.0, 0.0),
+      viewFieldOfViewDegrees);
+
+  const bool originalUpdateInEditor = tileset.UpdateInEditor;
+  const double originalMaximumScreenSpaceError =
+      tileset.GetMaximumScreenSpaceError();
+  tileset.UpdateInEditor = true;
+  tileset.SetMaximumScreenSpaceError(settings.MaximumScreenSpaceError);
+  const int32 cameraId = pCameraManager->AddCamera(camera);
+
+  const double startTime = FPlatformTime::Seconds();
+  double lastTime = startTime;
+  for (int32 frame = 1;; ++frame) {
+    const double now = FPlatformTime::Seconds();
+    CesiumEditorTicking::tick(pWorld, float(now - lastTime));
+    lastTime = now;
+
+    if (frame >= minimumFramesToLoad && tileset.GetLoadProgress() >= 100.0f) {
+      break;
+    }
+    if (now - startTime >= settings.LoadTimeout) {
+      UE_LOG(
+          LogCesiumEditor,
+          Warning,
+          TEXT(
+              "Timed out loading the tiles of %s for an HLOD, so only the tiles loaded so far are captured."),
+          *tileset.GetName());
+      break;
+    }
+
+    FPlatformProcess::Sleep(0.0f);
+  }
+
+  gatherTilePrimitives(tileset, box, primitives);
+
+  pCameraManager->RemoveCamera(cameraId);
+  tileset.SetMaximumScreenSpaceError(originalMaximumScreenSpaceError);
+  tileset.UpdateInEditor = originalUpdateInEditor;
+}
+
+} // namespace
+
+uint32 UCesiumHLODBuilderSettings::GetCRC() const {
+  FArchiveCrc32 ar;
+  FMeshProxySettings meshProxySettings = this->MeshProxySettings;
+  FMeshProxySettings::StaticStruct()->SerializeItem(
+      ar,
+      &meshProxySettings,
+      nullptr);
+  double maximumScreenSpaceError = this->MaximumScreenSpaceError;
+  ar << maximumScreenSpaceError;
+  return ar.GetCrc();
+}
+
+TSubclassOf<UHLODBuilderSettings>
+UCesiumHLODBuilder::GetSettingsClass() const {
+  return UCesiumHLODBuilderSettings::StaticClass();
+}
+
+TArray<UActorComponent*> UCesiumHLODBuilder::Build(
+    const FHLODBuildContext& InHLODBuildContext,
+    const TArray<UActorComponent*>& InSourceComponents) const {
+  const UCesiumHLODBuilderSettings* pSettings =
+      CastChecked<UCesiumHLODBuilderSettings>(this->HLODBuilderSettings);
+
+  TArray<UStaticMeshComponent*> primitives;
+  for (UActorComponent* pComponent : InSourceComponents) {
+    const UCesiumHLODSourceComponent* pBox =
+        Cast<UCesiumHLODSourceComponent>(pComponent);
+    const ACesiumHLODSource* pSource =
+        pBox ? Cast<ACesiumHLODSource>(pBox->GetOwner()) : nullptr;
+    ACesium3DTileset* pTileset = pSource ? pSource->Tileset.Get() : nullptr;
+    if (!pTileset) {
+      continue;
+    }
+    captureTiles(*pTileset, pBox->Bounds.GetBox(), *pSettings, primitives);
+  }
+
+  TArray<UActorComponent*> components;
+  if (primitives.IsEmpty()) {
+    return components;
+  }
+
+  TArray<UObject*> assets;
+  FCreateProxyDelegate proxyDelegate;
+  proxyDelegate.BindLambda(
+      [&assets](const FGuid guid, TArray<UObject*>& assetsCreated) {
+        assets = assetsCreated;
+      });
+
+  // The proxy is created synchronously, so the delegate is called before this
+  // returns.
+  const IMeshMergeUtilities& meshMergeUtilities =
+      FModuleManager::Get()
+          .LoadModuleChecked<IMeshMergeModule>("MeshMergeUtilities")
+          .GetUtilities();
+  meshMergeUtilities.CreateProxyMesh(
+      primitives,
+      pSettings->MeshProxySettings,
+      InHLODBuildContext.AssetsOuter->GetPackage(),
+      InHLODBuildContext.AssetsBaseName,
+      FGuid::NewGuid(),
+      proxyDelegate,
+      false);
+
+  for (UObject* pAsset : assets) {
+    UStaticMesh* pStaticMesh = Cast<UStaticMesh>(pAsset);
+    if (pStaticMesh) {
+      UStaticMeshComponent* pComponent = NewObject<UStaticMeshComponent>();
+      pComponent->SetStaticMesh(pStaticMesh);
+      components.Add(pComponent);
+    }
+  }
+
+  return components;
+}
@@ -0,0 +1,64 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/MeshMerging.h"
+#include "WorldPartition/HLOD/HLODBuilder.h"
+#include "CesiumHLODBuilder.generated.h"
+
+/**
+ * The settings of a {@link UCesiumHLODBuilder}.
+ */
+UCLASS()
+class UCesiumHLODBuilderSettings : public UHLODBuilderSettings {
+  GENERATED_BODY()
+
+public:
+  virtual uint32 GetCRC() const override;
+
+  /**
+   * The maximum screen space error of the tiles that are captured, for a view
+   * from above the box of each Cesium HLOD Source that it fills. Higher values
+   * capture coarser tiles.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0.0))
+  double MaximumScreenSpaceError = 64.0;
+
+  /**
+   * The longest time, in seconds, to wait for the tiles of a box to load.
+   * The tiles that have loaded by then are captured.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium", meta = (ClampMin = 0.0))
+  double LoadTimeout = 120.0;
+
+  /**
+   * How the captured tiles are merged into a simplified proxy mesh, and the
+   * size of the textures into which their materials are baked.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium")
+  FMeshProxySettings MeshProxySettings;
+};
+
+/**
+ * Builds the World Partition HLODs of the Cesium HLOD Sources of a cell.
+ *
+ * For each source, the tiles of its tileset inside its box are loaded to the
+ * Maximum Screen Space Error of the settings, for a view from above the box,
+ * and then merged into one simplified proxy mesh, whose materials are baked
+ * into textures.
+ *
+ * To use it, make a custom HLOD layer with this builder, and give it to the
+ * Cesium HLOD Sources.
+ */
+UCLASS()
+class UCesiumHLODBuilder : public UHLODBuilder {
+  GENERATED_BODY()
+
+public:
+  virtual TSubclassOf<UHLODBuilderSettings> GetSettingsClass() const override;
+
+  virtual TArray<UActorComponent*> Build(
+      const FHLODBuildContext& InHLODBuildContext,
+      const TArray<UActorComponent*>& InSourceComponents) const override;
+};
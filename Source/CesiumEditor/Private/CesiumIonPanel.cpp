@@ -13,6 +13,7 @@
 #include "EditorModeManager.h"
 #include "EngineUtils.h"
 #include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "HAL/PlatformTime.h"
 #include "IonLoginPanel.h"
 #include "IonQuickAddPanel.h"
 #include "SelectCesiumIonToken.h"
@@ -175,12 +176,13 @@ void CesiumIonPanel::OnSortChange(
     _sortColumnName = ColumnName;
     _sortMode = EColumnSortMode::Type::Ascending;
   }
-  Refresh();
+  StartFilter();
 }
 
 void CesiumIonPanel::OnSearchTextChange(const FText& SearchText) {
   _searchString = SearchText.ToString().TrimStartAndEnd();
-  Refresh();
+  _filterTime = FPlatformTime::Seconds() + searchDebounceSeconds;
+  _filterPending = true;
 }
 
 static bool isSupportedTileset(const TSharedPtr<Asset>& pAsset) {
@@ -329,76 +331,174 @@ TSharedRef<SWidget> CesiumIonPanel::AssetDetails() {
                     })];
 }
 
+namespace {
+
+// The columns of the asset table view, in the order of the sort keys of each
+// asset.
+const FName* const sortColumns[] = {
+    &ColumnName_Name,
+    &ColumnName_Type,
+    &ColumnName_DateAdded};
+constexpr int32 sortColumnCount = UE_ARRAY_COUNT(sortColumns);
+
+// The time, in seconds, that the search text must stay unchanged before the
+// list is filtered.
+constexpr double searchDebounceSeconds = 0.25;
+
+// The number of assets that are added to the list view in each tick.
+constexpr int32 assetsPerTick = 1000;
+
+int32 sortColumnIndex(const FName& columnName) {
+  for (int32 i = 0; i < sortColumnCount; ++i) {
+    if (*sortColumns[i] == columnName) {
+      return i;
+    }
+  }
+  return 0;
+}
+
 /**
  * @brief Returns a comparator for the property of an Asset that is
- * associated with the given column name.
+ * associated with the given column index.
  *
- * @param columnName The column name
+ * @param columnIndex The index of the column in sortColumns.
  * @return The comparator, comparing is ascending order (comparing by
- * the asset->name by default, if the given column name was not known)
+ * the asset->name by default, if the given column was not known)
  */
-static std::function<bool(const TSharedPtr<Asset>&, const TSharedPtr<Asset>&)>
-comparatorFor(const FName& columnName) {
-  if (columnName == ColumnName_Type) {
-    return [](const TSharedPtr<Asset>& a0, const TSharedPtr<Asset>& a1) {
-      return a0->type < a1->type;
-    };
+std::function<bool(const Asset&, const Asset&)>
+comparatorFor(int32 columnIndex) {
+  if (*sortColumns[columnIndex] == ColumnName_Type) {
+    return [](const Asset& a0, const Asset& a1) { return a0.type < a1.type; };
   }
-  if (columnName == ColumnName_DateAdded) {
-    return [](const TSharedPtr<Asset>& a0, const TSharedPtr<Asset>& a1) {
-      return a0->dateAdded < a1->dateAdded;
+  if (*sortColumns[columnIndex] == ColumnName_DateAdded) {
+    return [](const Asset& a0, const Asset& a1) {
+      return a0.dateAdded < a1.dateAdded;
     };
   }
-  return [](const TSharedPtr<Asset>& a0, const TSharedPtr<Asset>& a1) {
-    return a0->name < a1->name;
-  };
+  return [](const Asset& a0, const Asset& a1) { return a0.name < a1.name; };
 }
 
-void CesiumIonPanel::ApplyFilter() {
+} // namespace
 
-  // UE_LOG(LogCesiumEditor, Warning, TEXT("ApplyFilter %s"), *_searchString);
+struct CesiumIonPanel::AssetListEntry {
+  TSharedPtr<Asset> pAsset;
 
-  if (_searchString.IsEmpty()) {
-    return;
+  // The name and description of the asset, converted once for the
+  // case-insensitive search.
+  FString name;
+  FString description;
+
+  // The position of the asset when all assets are sorted by each column in
+  // ascending order, so that sorting the filtered assets only compares
+  // integers.
+  int32 sortKeys[sortColumnCount];
+};
+
+namespace {
+
+TArray<CesiumIonPanel::AssetListEntry>
+createEntries(std::vector<Asset>&& assets) {
+  TArray<CesiumIonPanel::AssetListEntry> entries;
+  entries.SetNum(int32(assets.size()));
+  for (int32 i = 0; i < entries.Num(); ++i) {
+    CesiumIonPanel::AssetListEntry& entry = entries[i];
+    entry.pAsset = MakeShared<Asset>(std::move(assets[size_t(i)]));
+    entry.name = UTF8_TO_TCHAR(entry.pAsset->name.c_str());
+    entry.description = UTF8_TO_TCHAR(entry.pAsset->description.c_str());
   }
-  this->_assets =
-      this->_assets.FilterByPredicate([this](const TSharedPtr<Asset>& Asset) {
-        // This mimics the behavior of the ion web UI, which
-        // searches for the given text in the name and description.
-        //
-        // Creating and using FString instances here instead of
-        // converting the _searchString to a std::string, because
-        // the 'FString::Contains' function does the desired
-        // case-INsensitive check by default.
-        FString Name = UTF8_TO_TCHAR(Asset->name.c_str());
-        if (Name.Contains(_searchString)) {
-          return true;
-        }
-        FString Description = UTF8_TO_TCHAR(Asset->description.c_str());
-        if (Description.Contains(_searchString)) {
-          return true;
-        }
-        return false;
-      });
+
+  TArray<int32> order;
+  order.SetNum(entries.Num());
+  for (int32 column = 0; column < sortColumnCount; ++column) {
+    for (int32 i = 0; i < order.Num(); ++i) {
+      order[i] = i;
+    }
+    const std::function<bool(const Asset&, const Asset&)> comparator =
+        comparatorFor(column);
+    order.StableSort([&entries, &comparator](int32 i0, int32 i1) {
+      return comparator(*entries[i0].pAsset, *entries[i1].pAsset);
+    });
+    for (int32 rank = 0; rank < order.Num(); ++rank) {
+      entries[order[rank]].sortKeys[column] = rank;
+    }
+  }
+  return entries;
 }
 
-void CesiumIonPanel::ApplySorting() {
+TArray<TSharedPtr<Asset>> filterAndSort(
+    const TArray<CesiumIonPanel::AssetListEntry>& entries,
+    const FString& searchString,
+    int32 sortColumn,
+    EColumnSortMode::Type sortMode) {
+  TArray<const CesiumIonPanel::AssetListEntry*> matches;
+  matches.Reserve(entries.Num());
+  for (const CesiumIonPanel::AssetListEntry& entry : entries) {
+    // This mimics the behavior of the ion web UI, which
+    // searches for the given text in the name and description.
+    //
+    // The 'FString::Contains' function does the desired
+    // case-INsensitive check by default.
+    if (searchString.IsEmpty() || entry.name.Contains(searchString) ||
+        entry.description.Contains(searchString)) {
+      matches.Add(&entry);
+    }
+  }
 
-  // UE_LOG(LogCesiumEditor, Warning, TEXT("ApplySorting %s with %d"),
-  // *_sortColumnName.ToString(), _sortMode);
+  if (sortMode == EColumnSortMode::Type::Ascending) {
+    matches.Sort([sortColumn](
+                     const CesiumIonPanel::AssetListEntry& e0,
+                     const CesiumIonPanel::AssetListEntry& e1) {
+      return e0.sortKeys[sortColumn] < e1.sortKeys[sortColumn];
+    });
+  } else if (sortMode == EColumnSortMode::Type::Descending) {
+    matches.Sort([sortColumn](
+                     const CesiumIonPanel::AssetListEntry& e0,
+                     const CesiumIonPanel::AssetListEntry& e1) {
+      return e1.sortKeys[sortColumn] < e0.sortKeys[sortColumn];
+    });
+  }
 
-  if (_sortMode == EColumnSortMode::Type::None) {
-    return;
+  TArray<TSharedPtr<Asset>> result;
+  result.Reserve(matches.Num());
+  for (const CesiumIonPanel::AssetListEntry* pEntry : matches) {
+    result.Add(pEntry->pAsset);
   }
-  auto baseComparator = comparatorFor(_sortColumnName);
-  if (_sortMode == EColumnSortMode::Type::Ascending) {
-    this->_assets.Sort(baseComparator);
-  } else {
-    this->_assets.Sort(
-        [&baseComparator](
-            const TSharedPtr<Asset>& a0,
-            const TSharedPtr<Asset>& a1) { return baseComparator(a1, a0); });
+  return result;
+}
+
+} // namespace
+
+void CesiumIonPanel::StartFilter() {
+  this->_filterPending = false;
+  const int32 generation = ++this->_filterGeneration;
+  if (!this->_pEntries) {
+    return;
   }
+
+  TWeakPtr<CesiumIonPanel> pWeakThis = SharedThis(this);
+  getAsyncSystem()
+      .runInWorkerThread([pEntries = this->_pEntries,
+                          searchString = this->_searchString,
+                          sortColumn = sortColumnIndex(this->_sortColumnName),
+                          sortMode = this->_sortMode]() {
+        return filterAndSort(*pEntries, searchString, sortColumn, sortMode);
+      })
+      .thenInMainThread(
+          [pWeakThis, generation](TArray<TSharedPtr<Asset>>&& assets) {
+            TSharedPtr<CesiumIonPanel> pThis = pWeakThis.Pin();
+            if (pThis && pThis->_filterGeneration == generation) {
+              pThis->SetFilteredAssets(std::move(assets));
+            }
+          });
+}
+
+void CesiumIonPanel::SetFilteredAssets(TArray<TSharedPtr<Asset>>&& assets) {
+  this->_filteredAssets = std::move(assets);
+  this->_assets.Reset();
+  this->_assets.Append(
+      this->_filteredAssets.GetData(),
+      FMath::Min(this->_filteredAssets.Num(), assetsPerTick));
+  this->_pListView->RequestListRefresh();
 }
 
 void CesiumIonPanel::Refresh() {
@@ -408,14 +508,40 @@ void CesiumIonPanel::Refresh() {
   const Assets& assets =
       FCesiumEditorModule::serverManager().GetCurrentSession()->getAssets();
 
-  this->_assets.SetNum(assets.items.size());
-
-  for (size_t i = 0; i < assets.items.size(); ++i) {
-    this->_assets[i] = MakeShared<Asset>(assets.items[i]);
-  }
-  ApplyFilter();
-  ApplySorting();
-  this->_pListView->RequestListRefresh();
+  // Converting the assets and computing their sort keys takes a while for
+  // accounts with many assets, so it's done in a worker thread along with
+  // the first filter.
+  this->_filterPending = false;
+  const int32 generation = ++this->_filterGeneration;
+  TWeakPtr<CesiumIonPanel> pWeakThis = SharedThis(this);
+  getAsyncSystem()
+      .runInWorkerThread([items = assets.items,
+                          searchString = this->_searchString,
+                          sortColumn = sortColumnIndex(this->_sortColumnName),
+                          sortMode = this->_sortMode]() mutable {
+        TSharedPtr<const TArray<AssetListEntry>> pEntries =
+            MakeShared<TArray<AssetListEntry>>(createEntries(std::move(items)));
+        TArray<TSharedPtr<Asset>> filtered =
+            filterAndSort(*pEntries, searchString, sortColumn, sortMode);
+        return std::make_pair(std::move(pEntries), std::move(filtered));
+      })
+      .thenInMainThread(
+          [pWeakThis, generation](
+              std::pair<
+                  TSharedPtr<const TArray<AssetListEntry>>,
+                  TArray<TSharedPtr<Asset>>>&& result) {
+            TSharedPtr<CesiumIonPanel> pThis = pWeakThis.Pin();
+            if (!pThis) {
+              return;
+            }
+            pThis->_pEntries = std::move(result.first);
+            if (pThis->_filterGeneration == generation) {
+              pThis->SetFilteredAssets(std::move(result.second));
+            } else {
+              // The search text or sorting changed in the meantime.
+              pThis->StartFilter();
+            }
+          });
 }
 
 void CesiumIonPanel::Tick(
@@ -423,6 +549,20 @@ void CesiumIonPanel::Tick(
     const double InCurrentTime,
     const float InDeltaTime) {
   getAsyncSystem().dispatchMainThreadTasks();
+
+  if (this->_filterPending && FPlatformTime::Seconds() >= this->_filterTime) {
+    this->StartFilter();
+  }
+
+  // Adds the next page of the filtered assets to the list view.
+  const int32 shown = this->_assets.Num();
+  if (this->_pListView && shown < this->_filteredAssets.Num()) {
+    this->_assets.Append(
+        this->_filteredAssets.GetData() + shown,
+        FMath::Min(this->_filteredAssets.Num() - shown, assetsPerTick));
+    this->_pListView->RequestListRefresh();
+  }
+
   SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 }
 
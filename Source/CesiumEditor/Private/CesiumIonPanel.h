@@ -31,6 +31,12 @@ class CesiumIonPanel : public SCompoundWidget {
       const double InCurrentTime,
       const float InDeltaTime) override;
 
+  /**
+   * An asset in the list, with its search text and sort keys, which are
+   * computed once when the asset list is loaded.
+   */
+  struct AssetListEntry;
+
 private:
   TSharedRef<SWidget> AssetDetails();
   TSharedRef<ITableRow> CreateAssetRow(
@@ -48,17 +54,19 @@ private:
   void OnServerChanged();
 
   /**
-   * Filter the current _assets array, based on the current _searchString.
-   * This will replace the _assets array with one that only contains
-   * assets whose name or description contain the search string
+   * Filters the _pEntries in a worker thread, keeping the assets whose name
+   * or description contain the current _searchString, and sorts them based
+   * on the current _sortColumnName and _sortMode. The result replaces the
+   * contents of the list view when it is ready, unless a newer filter has
+   * been started by then.
    */
-  void ApplyFilter();
+  void StartFilter();
 
   /**
-   * Sort the current _assets array, based on the current _sortColumnName
-   * and _sortMode, before using it to populate the list view.
+   * Replaces the contents of the list view with the given assets, which are
+   * added to it a page at a time over the next ticks.
    */
-  void ApplySorting();
+  void SetFilteredAssets(TArray<TSharedPtr<CesiumIonClient::Asset>>&& assets);
 
   /**
    * Will be called whenever one header of the asset list view is
@@ -72,13 +80,43 @@ private:
 
   /**
    * Will be called whenever the contents of the _SearchBox changes,
-   * store the corresponding _searchString, and refresh the view.
+   * store the corresponding _searchString, and filter the list once the
+   * text has not changed for a moment.
    */
   void OnSearchTextChange(const FText& SearchText);
 
   FDelegateHandle _serverChangedDelegateHandle;
   TSharedPtr<SListView<TSharedPtr<CesiumIonClient::Asset>>> _pListView;
+
+  /**
+   * The assets shown in the list view.
+   */
   TArray<TSharedPtr<CesiumIonClient::Asset>> _assets;
+
+  /**
+   * All the assets of the current session, which are filtered and sorted in
+   * worker threads.
+   */
+  TSharedPtr<const TArray<AssetListEntry>> _pEntries;
+
+  /**
+   * The filtered and sorted assets, of which the first _assets.Num() are
+   * already shown in the list view.
+   */
+  TArray<TSharedPtr<CesiumIonClient::Asset>> _filteredAssets;
+
+  /**
+   * Incremented whenever the asset list is rebuilt or filtered, so that the
+   * results of older filters that finish later are ignored.
+   */
+  int32 _filterGeneration = 0;
+
+  /**
+   * The time, in seconds, at which the list is filtered after a change of
+   * the search text, if _filterPending is set.
+   */
+  double _filterTime = 0.0;
+  bool _filterPending = false;
   TSharedPtr<CesiumIonClient::Asset> _pSelection;
   TObjectPtr<UCesiumIonServer> _pLastServer;
 
@@ -101,7 +139,7 @@ private:
   /**
    * The string that is currently entered in the SearchBox,
    * (trimmed from whitespace), used for filtering the asset
-   * list in ApplyFilter.
+   * list in StartFilter.
    */
   FString _searchString;
 };
@@ -166,6 +166,9 @@ public class CesiumRuntime : ModuleRules
             PrivateDependencyModuleNames.Add("MikkTSpace");
         }
 
+        // The automation tests listen on a local socket.
+        PrivateDependencyModuleNames.Add("Sockets");
+
 
         PublicDefinitions.AddRange(
             new string[]
@@ -181,6 +184,7 @@ public class CesiumRuntime : ModuleRules
         );
 
         PrivateDependencyModuleNames.Add("Chaos");
+        PrivateDependencyModuleNames.Add("NavigationSystem");
 
         if (Target.bBuildEditor == true)
         {
@@ -194,6 +198,9 @@ public class CesiumRuntime : ModuleRules
                     "MaterialEditor"
                 }
             );
+
+            // Nanite resources can only be built in the editor.
+            PrivateDependencyModuleNames.Add("NaniteBuilder");
         }
 
         DynamicallyLoadedModuleNames.AddRange(
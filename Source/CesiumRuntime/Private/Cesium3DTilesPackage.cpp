@@ -0,0 +1,490 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "Cesium3DTilesPackage.h"
+#include "Async/MappedFileHandle.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include <CesiumUtility/Uri.h>
+#include <cstring>
+
+namespace {
+
+constexpr uint32 endOfCentralDirectorySignature = 0x06054b50;
+constexpr uint32 zip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+constexpr uint32 zip64EndOfCentralDirectorySignature = 0x06064b50;
+constexpr uint32 centralDirectoryHeaderSignature = 0x02014b50;
+constexpr uint32 localFileHeaderSignature = 0x04034b50;
+
+constexpr int64 endOfCentralDirectorySize = 22;
+constexpr int64 zip64EndOfCentralDirectoryLocatorSize = 20;
+constexpr int64 zip64EndOfCentralDirectorySize = 56;
+constexpr int64 centralDirectoryHeaderSize = 46;
+constexpr int64 localFileHeaderSize = 30;
+constexpr int64 maximumCommentSize = 0xFFFF;
+
+constexpr uint16 zip64ExtraFieldId = 0x0001;
+
+constexpr uint16 compressionMethodStored = 0;
+constexpr uint16 compressionMethodDeflate = 8;
+
+uint16 readUint16(const uint8* p) { return uint16(p[0]) | uint16(p[1]) << 8; }
+
+uint32 readUint32(const uint8* p) {
+  return uint32(readUint16(p)) | uint32(readUint16(p + 2)) << 16;
+}
+
+uint64 readUint64(const uint8* p) {
+  return uint64(readUint32(p)) | uint64(readUint32(p + 4)) << 32;
+}
+
+const std::string getMethod = "GET";
+const CesiumAsync::HttpHeaders emptyHeaders{};
+
+class Cesium3DTilesPackageAssetRequestResponse
+    : public CesiumAsync::IAssetRequest,
+      public CesiumAsync::IAssetResponse {
+public:
+  Cesium3DTilesPackageAssetRequestResponse(
+      const std::string& url,
+      uint16_t statusCode,
+      Cesium3DTilesPackage::EntryData&& data)
+      : _url(url), _statusCode(statusCode), _data(std::move(data)) {}
+
+  virtual const std::string& method() const override { return getMethod; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return emptyHeaders;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return this;
+  }
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override { return std::string(); }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return this->_data.data;
+  }
+
+private:
+  std::string _url;
+  uint16_t _statusCode;
+  Cesium3DTilesPackage::EntryData _data;
+};
+
+} // namespace
+
+/*static*/ std::shared_ptr<Cesium3DTilesPackage>
+Cesium3DTilesPackage::open(const FString& filename) {
+  IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+  std::shared_ptr<Cesium3DTilesPackage> pPackage(new Cesium3DTilesPackage());
+  pPackage->_filename = filename;
+
+  pPackage->_pMappedFile.Reset(platformFile.OpenMapped(*filename));
+  if (pPackage->_pMappedFile) {
+    pPackage->_fileSize = pPackage->_pMappedFile->GetFileSize();
+    pPackage->_pMappedRegion.Reset(pPackage->_pMappedFile->MapRegion());
+  }
+
+  if (!pPackage->_pMappedRegion) {
+    pPackage->_pMappedFile.Reset();
+    pPackage->_pFile.Reset(platformFile.OpenRead(*filename));
+    if (!pPackage->_pFile) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("Could not open 3D Tiles package %s"),
+          *filename);
+      return nullptr;
+    }
+    pPackage->_fileSize = pPackage->_pFile->Size();
+  }
+
+  if (!pPackage->readIndex()) {
+    return nullptr;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Log,
+      TEXT("Opened 3D Tiles package %s with %d entries"),
+      *filename,
+      int32(pPackage->_entries.size()));
+
+  return pPackage;
+}
+
+Cesium3DTilesPackage::~Cesium3DTilesPackage() = default;
+
+bool Cesium3DTilesPackage::read(
+    const std::string& path,
+    EntryData& result) const {
+  auto it = this->_entries.find(path);
+  if (it == this->_entries.end()) {
+    return false;
+  }
+
+  const Entry& entry = it->second;
+
+  uint8 localHeader[localFileHeaderSize];
+  if (!this->readBytes(
+          entry.localHeaderOffset,
+          localFileHeaderSize,
+          localHeader) ||
+      readUint32(localHeader) != localFileHeaderSignature) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Invalid local file header for %s in 3D Tiles package %s"),
+        UTF8_TO_TCHAR(path.c_str()),
+        *this->_filename);
+    return false;
+  }
+
+  const int64 dataOffset = entry.localHeaderOffset + localFileHeaderSize +
+                           readUint16(localHeader + 26) +
+                           readUint16(localHeader + 28);
+
+  if (entry.compressionMethod == compressionMethodStored) {
+    const uint8* pMapped =
+        this->getMappedBytes(dataOffset, entry.uncompressedSize);
+    if (pMapped) {
+      result.pPackage = this->shared_from_this();
+      result.data = gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(pMapped),
+          size_t(entry.uncompressedSize));
+      return true;
+    }
+
+    result.buffer.SetNumUninitialized(entry.uncompressedSize);
+    if (!this->readBytes(
+            dataOffset,
+            entry.uncompressedSize,
+            result.buffer.GetData())) {
+      return false;
+    }
+  } else if (entry.compressionMethod == compressionMethodDeflate) {
+    if (entry.compressedSize > MAX_int32 ||
+        entry.uncompressedSize > MAX_int32) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("Compressed entry %s in 3D Tiles package %s is too large"),
+          UTF8_TO_TCHAR(path.c_str()),
+          *this->_filename);
+      return false;
+    }
+
+    TArray64<uint8> compressed;
+    const uint8* pCompressed =
+        this->getMappedBytes(dataOffset, entry.compressedSize);
+    if (!pCompressed) {
+      compressed.SetNumUninitialized(entry.compressedSize);
+      if (!this->readBytes(
+              dataOffset,
+              entry.compressedSize,
+              compressed.GetData())) {
+        return false;
+      }
+      pCompressed = compressed.GetData();
+    }
+
+    // A negative window size tells zlib to expect raw deflate data, without
+    // the zlib header, as stored in ZIP archives.
+    result.buffer.SetNumUninitialized(entry.uncompressedSize);
+    if (!FCompression::UncompressMemory(
+            NAME_Zlib,
+            result.buffer.GetData(),
+            int32(entry.uncompressedSize),
+            pCompressed,
+            int32(entry.compressedSize),
+            COMPRESS_NoFlags,
+            -DEFAULT_ZLIB_BIT_WINDOW)) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("Could not decompress %s in 3D Tiles package %s"),
+          UTF8_TO_TCHAR(path.c_str()),
+          *this->_filename);
+      return false;
+    }
+  } else {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "Entry %s in 3D Tiles package %s uses unsupported compression method %d"),
+        UTF8_TO_TCHAR(path.c_str()),
+        *this->_filename,
+        entry.compressionMethod);
+    return false;
+  }
+
+  result.data = gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(result.buffer.GetData()),
+      size_t(result.buffer.Num()));
+  return true;
+}
+
+bool Cesium3DTilesPackage::readIndex() {
+  // Find the end of central directory record, which is followed only by a
+  // variable-length comment.
+  const int64 tailSize = FMath::Min(
+      this->_fileSize,
+      endOfCentralDirectorySize + maximumCommentSize +
+          zip64EndOfCentralDirectoryLocatorSize);
+  const int64 tailOffset = this->_fileSize - tailSize;
+  TArray64<uint8> tail;
+  tail.SetNumUninitialized(tailSize);
+  if (tailSize < endOfCentralDirectorySize ||
+      !this->readBytes(tailOffset, tailSize, tail.GetData())) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("3D Tiles package %s is not a valid ZIP archive"),
+        *this->_filename);
+    return false;
+  }
+
+  int64 eocd = -1;
+  for (int64 i = tailSize - endOfCentralDirectorySize; i >= 0; --i) {
+    if (readUint32(&tail[i]) == endOfCentralDirectorySignature) {
+      eocd = i;
+      break;
+    }
+  }
+
+  if (eocd < 0) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("3D Tiles package %s is not a valid ZIP archive"),
+        *this->_filename);
+    return false;
+  }
+
+  uint64 entryCount = readUint16(&tail[eocd + 10]);
+  int64 centralDirectorySize = readUint32(&tail[eocd + 12]);
+  int64 centralDirectoryOffset = readUint32(&tail[eocd + 16]);
+
+  // Large archives store the real values in the ZIP64 end of central
+  // directory record, which is found through a locator just before the
+  // regular record.
+  const int64 locator = eocd - zip64EndOfCentralDirectoryLocatorSize;
+  if (locator >= 0 && readUint32(&tail[locator]) ==
+                          zip64EndOfCentralDirectoryLocatorSignature) {
+    const int64 zip64Offset = int64(readUint64(&tail[locator + 8]));
+    uint8 zip64Record[zip64EndOfCentralDirectorySize];
+    if (!this->readBytes(
+            zip64Offset,
+            zip64EndOfCentralDirectorySize,
+            zip64Record) ||
+        readUint32(zip64Record) != zip64EndOfCentralDirectorySignature) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("3D Tiles package %s has an invalid ZIP64 directory"),
+          *this->_filename);
+      return false;
+    }
+
+    entryCount = readUint64(zip64Record + 32);
+    centralDirectorySize = int64(readUint64(zip64Record + 40));
+    centralDirectoryOffset = int64(readUint64(zip64Record + 48));
+  }
+
+  if (centralDirectoryOffset < 0 || centralDirectorySize < 0 ||
+      centralDirectoryOffset + centralDirectorySize > this->_fileSize) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("3D Tiles package %s has an invalid central directory"),
+        *this->_filename);
+    return false;
+  }
+
+  TArray64<uint8> directory;
+  directory.SetNumUninitialized(centralDirectorySize);
+  if (!this->readBytes(
+          centralDirectoryOffset,
+          centralDirectorySize,
+          directory.GetData())) {
+    return false;
+  }
+
+  this->_entries.reserve(size_t(entryCount));
+
+  int64 position = 0;
+  for (uint64 i = 0; i < entryCount; ++i) {
+    if (position + centralDirectoryHeaderSize > centralDirectorySize ||
+        readUint32(&directory[position]) != centralDirectoryHeaderSignature) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("3D Tiles package %s has an invalid central directory"),
+          *this->_filename);
+      return false;
+    }
+
+    const uint8* pHeader = &directory[position];
+    const uint16 nameLength = readUint16(pHeader + 28);
+    const uint16 extraLength = readUint16(pHeader + 30);
+    const uint16 commentLength = readUint16(pHeader + 32);
+
+    const int64 nextPosition = position + centralDirectoryHeaderSize +
+                               nameLength + extraLength + commentLength;
+    if (nextPosition > centralDirectorySize) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("3D Tiles package %s has an invalid central directory"),
+          *this->_filename);
+      return false;
+    }
+
+    Entry entry;
+    entry.compressionMethod = readUint16(pHeader + 10);
+    entry.compressedSize = readUint32(pHeader + 20);
+    entry.uncompressedSize = readUint32(pHeader + 24);
+    entry.localHeaderOffset = readUint32(pHeader + 42);
+
+    // Values that don't fit in 32 bits are stored in the ZIP64 extra field,
+    // in this order, and only if the corresponding header field is 0xFFFFFFFF.
+    const uint8* pExtra = pHeader + centralDirectoryHeaderSize + nameLength;
+    const uint8* pExtraEnd = pExtra + extraLength;
+    while (pExtra + 4 <= pExtraEnd) {
+      const uint16 id = readUint16(pExtra);
+      const uint16 size = readUint16(pExtra + 2);
+      const uint8* pField = pExtra + 4;
+      const uint8* pFieldEnd = FMath::Min(pField + size, pExtraEnd);
+      if (id == zip64ExtraFieldId) {
+        if (entry.uncompressedSize == 0xFFFFFFFF && pField + 8 <= pFieldEnd) {
+          entry.uncompressedSize = int64(readUint64(pField));
+          pField += 8;
+        }
+        if (entry.compressedSize == 0xFFFFFFFF && pField + 8 <= pFieldEnd) {
+          entry.compressedSize = int64(readUint64(pField));
+          pField += 8;
+        }
+        if (entry.localHeaderOffset == 0xFFFFFFFF && pField + 8 <= pFieldEnd) {
+          entry.localHeaderOffset = int64(readUint64(pField));
+        }
+        break;
+      }
+      pExtra = pFieldEnd;
+    }
+
+    std::string name(
+        reinterpret_cast<const char*>(pHeader + centralDirectoryHeaderSize),
+        nameLength);
+    if (!name.empty() && name.back() != '/') {
+      this->_entries.emplace(std::move(name), entry);
+    }
+
+    position = nextPosition;
+  }
+
+  return true;
+}
+
+bool Cesium3DTilesPackage::readBytes(
+    int64 offset,
+    int64 size,
+    uint8* pDestination) const {
+  if (offset < 0 || size < 0 || offset + size > this->_fileSize) {
+    return false;
+  }
+
+  const uint8* pMapped = this->getMappedBytes(offset, size);
+  if (pMapped) {
+    std::memcpy(pDestination, pMapped, size_t(size));
+    return true;
+  }
+
+  if (!this->_pFile) {
+    return false;
+  }
+
+  std::scoped_lock<std::mutex> lock(this->_fileMutex);
+  return this->_pFile->Seek(offset) && this->_pFile->Read(pDestination, size);
+}
+
+const uint8*
+Cesium3DTilesPackage::getMappedBytes(int64 offset, int64 size) const {
+  if (!this->_pMappedRegion || offset < 0 || size < 0 ||
+      offset + size > this->_pMappedRegion->GetMappedSize()) {
+    return nullptr;
+  }
+  return this->_pMappedRegion->GetMappedPtr() + offset;
+}
+
+/*static*/ const std::string Cesium3DTilesPackageAssetAccessor::RootUrl =
+    "cesium-package://local/";
+
+Cesium3DTilesPackageAssetAccessor::Cesium3DTilesPackageAssetAccessor(
+    const std::shared_ptr<const Cesium3DTilesPackage>& pPackage,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pFallback)
+    : _pPackage(pPackage), _pFallback(pFallback) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+Cesium3DTilesPackageAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (url.compare(0, RootUrl.size(), RootUrl) != 0) {
+    return this->_pFallback->get(asyncSystem, url, headers);
+  }
+
+  return asyncSystem.runInWorkerThread(
+      [pPackage = this->_pPackage,
+       url]() -> std::shared_ptr<CesiumAsync::IAssetRequest> {
+        // Resolved content URLs may carry a query string or fragment, such as
+        // the one implicit tiling templates add. Neither is part of the path.
+        std::string path = url.substr(RootUrl.size());
+        const size_t end = path.find_first_of("?#");
+        if (end != std::string::npos) {
+          path.resize(end);
+        }
+        path = CesiumUtility::Uri::unescape(path);
+
+        Cesium3DTilesPackage::EntryData data;
+        if (!pPackage || !pPackage->read(path, data)) {
+          return std::make_shared<Cesium3DTilesPackageAssetRequestResponse>(
+              url,
+              404,
+              Cesium3DTilesPackage::EntryData());
+        }
+
+        return std::make_shared<Cesium3DTilesPackageAssetRequestResponse>(
+            url,
+            200,
+            std::move(data));
+      });
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+Cesium3DTilesPackageAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  if (verb == getMethod) {
+    return this->get(asyncSystem, url, headers);
+  }
+  return this->_pFallback
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void Cesium3DTilesPackageAssetAccessor::tick() noexcept {
+  this->_pFallback->tick();
+}
@@ -0,0 +1,144 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "Templates/UniquePtr.h"
+#include <CesiumAsync/IAssetAccessor.h>
+#include <gsl/span>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A 3D Tiles package (3TZ) file opened for reading. A 3TZ file is a ZIP
+ * archive with a tileset.json at its root and the rest of the tileset's
+ * files alongside it.
+ *
+ * The archive's central directory is read once, when it is opened, into an
+ * in-memory index of entries. The file then stays open for the lifetime of
+ * this object, so reading an entry is a single positioned read with no file
+ * open or close. When the platform supports it, the whole archive is
+ * memory-mapped and stored entries are returned without being copied.
+ *
+ * Entries may be read from any thread.
+ */
+class Cesium3DTilesPackage
+    : public std::enable_shared_from_this<Cesium3DTilesPackage> {
+public:
+  /**
+   * The contents of an entry. If the entry is stored uncompressed in a
+   * memory-mapped archive, `data` refers directly to the mapping, which is
+   * kept alive by `pPackage`. Otherwise it refers to `buffer`.
+   */
+  struct EntryData {
+    std::shared_ptr<const Cesium3DTilesPackage> pPackage;
+    TArray64<uint8> buffer;
+    gsl::span<const std::byte> data;
+  };
+
+  /**
+   * Opens a 3TZ file and reads its index of entries.
+   *
+   * @return The package, or nullptr if the file could not be opened or is not
+   * a valid ZIP archive. The reason is logged.
+   */
+  static std::shared_ptr<Cesium3DTilesPackage> open(const FString& filename);
+
+  ~Cesium3DTilesPackage();
+
+  /**
+   * Gets the number of entries in the package.
+   */
+  size_t getEntryCount() const noexcept { return this->_entries.size(); }
+
+  /**
+   * Reads the entry at the given path, relative to the root of the archive.
+   *
+   * @return True if the entry exists and was read successfully.
+   */
+  bool read(const std::string& path, EntryData& result) const;
+
+private:
+  struct Entry {
+    int64 localHeaderOffset;
+    int64 compressedSize;
+    int64 uncompressedSize;
+    uint16 compressionMethod;
+  };
+
+  Cesium3DTilesPackage() = default;
+
+  bool readIndex();
+  bool readBytes(int64 offset, int64 size, uint8* pDestination) const;
+  const uint8* getMappedBytes(int64 offset, int64 size) const;
+
+  FString _filename;
+  int64 _fileSize = 0;
+
+  // The mapped region must be released before the file handle, so it is
+  // declared after it.
+  TUniquePtr<IMappedFileHandle> _pMappedFile;
+  TUniquePtr<IMappedFileRegion> _pMappedRegion;
+
+  // Used when the platform can't map the file. Reads through it are
+  // serialized because a file handle has a single position.
+  TUniquePtr<IFileHandle> _pFile;
+  mutable std::mutex _fileMutex;
+
+  std::unordered_map<std::string, Entry> _entries;
+};
+
+/**
+ * An asset accessor that serves requests for the contents of a
+ * {@link Cesium3DTilesPackage}. URLs starting with
+ * {@link Cesium3DTilesPackageAssetAccessor::RootUrl} are resolved against the
+ * entries in the package, and a missing entry produces a 404 response. All
+ * other requests, such as those for raster overlays or for external content
+ * referenced by absolute URL, are passed to the fallback accessor.
+ */
+class Cesium3DTilesPackageAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  /**
+   * The URL of the root of the package. The package's tileset is at
+   * `RootUrl + "tileset.json"`.
+   */
+  static const std::string RootUrl;
+
+  /**
+   * Creates an accessor for the given package.
+   *
+   * @param pPackage The package, or nullptr if it could not be opened, in
+   * which case every request for an entry fails.
+   * @param pFallback The accessor to use for URLs outside the package.
+   */
+  Cesium3DTilesPackageAssetAccessor(
+      const std::shared_ptr<const Cesium3DTilesPackage>& pPackage,
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pFallback);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::shared_ptr<const Cesium3DTilesPackage> _pPackage;
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pFallback;
+};
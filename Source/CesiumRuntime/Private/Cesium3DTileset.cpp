@@ -2,6 +2,8 @@
 
 #include "Cesium3DTileset.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Cesium3DTilesPackage.h"
 #include "Camera/CameraTypes.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Cesium3DTilesSelection/IPrepareRendererResources.h"
@@ -11,24 +13,60 @@
 #include "Cesium3DTilesetLoadFailureDetails.h"
 #include "Cesium3DTilesetRoot.h"
 #include "CesiumActors.h"
-#include "CesiumBoundingVolumeComponent.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
 #include "CesiumCamera.h"
+#include "CesiumCancellableAssetAccessor.h"
 #include "CesiumCameraManager.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumFeatureStyleExpression.h"
+#include "CesiumFlyToComponent.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
 #include "CesiumGltf/ImageCesium.h"
-#include "CesiumGltf/Ktx2TranscodeTargets.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumGltfVoxelComponent.h"
+#include "CesiumHorizonCuller.h"
 #include "CesiumIonClient/Connection.h"
 #include "CesiumLifetime.h"
+#include "CesiumInstanceBatches.h"
+#include "CesiumLinkedTileComponents.h"
+#include "CesiumMaterialInstanceCache.h"
+#include "CesiumMemoryUsageTracker.h"
+#include "CesiumMeshResourceBatch.h"
+#include "CesiumNaniteBuilder.h"
+#include "CesiumNativeTileExcluder.h"
+#include "CesiumOcclusionProxyPool.h"
+#include "CesiumPerWorldState.h"
+#include "CesiumPhysicsMeshCache.h"
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumPSOPrecaching.h"
+#include "CesiumPolygonClippingComponent.h"
+#include "CesiumPrimitiveComponentPool.h"
 #include "CesiumRasterOverlay.h"
+#include "CesiumRasterOverlayRendererData.h"
+#include "CesiumRasterOverlayTextureArray.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumSelectionTrace.h"
+#include "CesiumSharedTilesets.h"
+#include "CesiumStats.h"
+#include "CesiumStreamingGovernor.h"
+#include "CesiumTextureCompression.h"
+#include "CesiumTextureResidency.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTileContentBuilder.h"
+#include "CesiumTileDistanceExcluder.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTileFinalizationBudget.h"
+#include "CesiumTileStateChanges.h"
+#include "CesiumTrace.h"
+#include "CesiumTilesetScheduler.h"
+#include "CesiumTilesetStatistics.h"
+#include "CesiumTriangleBVH.h"
 #include "CesiumViewExtension.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "CreateGltfOptions.h"
@@ -40,17 +78,24 @@
 #include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
 #include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "LevelSequenceActor.h"
 #include "LevelSequencePlayer.h"
+#include "NavigationSystem.h"
 #include "Math/UnrealMathUtility.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
 #include "PixelFormat.h"
 #include "StereoRendering.h"
+#include "UnrealTaskProcessor.h"
 #include "VecMath.h"
+#include "VT/RuntimeVirtualTexture.h"
 #include <glm/gtc/matrix_inverse.hpp>
 #include <memory>
 #include <spdlog/spdlog.h>
+#include <unordered_set>
 
 FCesium3DTilesetLoadFailure OnCesium3DTilesetLoadFailure{};
 
@@ -298,6 +343,15 @@ void ACesium3DTileset::SetUrl(const FString& InUrl) {
   }
 }
 
+void ACesium3DTileset::SetLocalPackageFilename(const FString& InFilename) {
+  if (InFilename != this->LocalPackageFilename) {
+    if (this->TilesetSource == ETilesetSource::FromLocalPackage) {
+      this->DestroyTileset();
+    }
+    this->LocalPackageFilename = InFilename;
+  }
+}
+
 void ACesium3DTileset::SetIonAssetID(int64 InAssetID) {
   if (InAssetID >= 0 && InAssetID != this->IonAssetID) {
     if (this->TilesetSource == ETilesetSource::FromCesiumIon) {
@@ -333,6 +387,20 @@ void ACesium3DTileset::SetMaximumScreenSpaceError(
   }
 }
 
+double
+ACesium3DTileset::ComputePrimitiveCullDistance(double PrimitiveSize) const {
+  if (this->MinimumPrimitiveScreenSize <= 0.0f ||
+      this->_largestProjectionScale <= 0.0 || PrimitiveSize <= 0.0) {
+    return 0.0;
+  }
+
+  // The draw distance is measured to the center of the primitive, so half of
+  // its size is added for its nearest point to be that far.
+  return PrimitiveSize * this->_largestProjectionScale /
+             double(this->MinimumPrimitiveScreenSize) +
+         0.5 * PrimitiveSize;
+}
+
 bool ACesium3DTileset::GetEnableOcclusionCulling() const {
   return GetDefault<UCesiumRuntimeSettings>()
              ->EnableExperimentalOcclusionCullingFeature &&
@@ -347,10 +415,7 @@ void ACesium3DTileset::SetEnableOcclusionCulling(bool bEnableOcclusionCulling) {
 }
 
 void ACesium3DTileset::SetOcclusionPoolSize(int32 newOcclusionPoolSize) {
-  if (this->OcclusionPoolSize != newOcclusionPoolSize) {
-    this->OcclusionPoolSize = newOcclusionPoolSize;
-    this->DestroyTileset();
-  }
+  this->OcclusionPoolSize_DEPRECATED = newOcclusionPoolSize;
 }
 
 void ACesium3DTileset::SetDelayRefinementForOcclusion(
@@ -364,6 +429,72 @@ void ACesium3DTileset::SetDelayRefinementForOcclusion(
 void ACesium3DTileset::SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes) {
   if (this->CreatePhysicsMeshes != bCreatePhysicsMeshes) {
     this->CreatePhysicsMeshes = bCreatePhysicsMeshes;
+    this->onCreatePhysicsMeshesChanged();
+  }
+}
+
+void ACesium3DTileset::onCreatePhysicsMeshesChanged() {
+  // Tiles that released their buffers can't build physics meshes anymore.
+  if (this->CreatePhysicsMeshes && !this->CreatePhysicsMeshesOnDemand &&
+      this->TileBufferResidency == ECesiumTileBufferResidency::KeepNothing) {
+    this->DestroyTileset();
+  } else {
+    this->_physicsMeshesChanged = true;
+  }
+}
+
+void ACesium3DTileset::SetCreatePhysicsMeshesOnDemand(
+    bool bCreatePhysicsMeshesOnDemand) {
+  if (this->CreatePhysicsMeshesOnDemand != bCreatePhysicsMeshesOnDemand) {
+    this->CreatePhysicsMeshesOnDemand = bCreatePhysicsMeshesOnDemand;
+    if (this->CreatePhysicsMeshes) {
+      this->DestroyTileset();
+    }
+  }
+}
+
+void ACesium3DTileset::SetPhysicsMeshSimplificationError(
+    double InPhysicsMeshSimplificationError) {
+  InPhysicsMeshSimplificationError =
+      FMath::Max(InPhysicsMeshSimplificationError, 0.0);
+  if (this->PhysicsMeshSimplificationError !=
+      InPhysicsMeshSimplificationError) {
+    this->PhysicsMeshSimplificationError = InPhysicsMeshSimplificationError;
+    if (this->CreatePhysicsMeshes) {
+      this->DestroyTileset();
+    }
+  }
+}
+
+void ACesium3DTileset::SetPhysicsMeshRadius(double InPhysicsMeshRadius) {
+  this->PhysicsMeshRadius = FMath::Max(InPhysicsMeshRadius, 0.0);
+}
+
+void ACesium3DTileset::SetPhysicsMeshFocusActors(
+    const TArray<AActor*>& InPhysicsMeshFocusActors) {
+  this->PhysicsMeshFocusActors = InPhysicsMeshFocusActors;
+}
+
+void ACesium3DTileset::AddPhysicsMeshFocusActor(AActor* Actor) {
+  if (Actor) {
+    this->PhysicsMeshFocusActors.AddUnique(Actor);
+  }
+}
+
+void ACesium3DTileset::RemovePhysicsMeshFocusActor(AActor* Actor) {
+  this->PhysicsMeshFocusActors.Remove(Actor);
+}
+
+void ACesium3DTileset::SetCreateTraceMeshes(bool bCreateTraceMeshes) {
+  if (this->CreateTraceMeshes != bCreateTraceMeshes) {
+    this->CreateTraceMeshes = bCreateTraceMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetCreateFeatureIndices(bool bCreateFeatureIndices) {
+  if (this->CreateFeatureIndices != bCreateFeatureIndices) {
+    this->CreateFeatureIndices = bCreateFeatureIndices;
     this->DestroyTileset();
   }
 }
@@ -375,6 +506,27 @@ void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
   }
 }
 
+// Tile meshes are created not affecting navigation when it is managed, so the
+// tileset must be reloaded when that changes.
+void ACesium3DTileset::SetRestrictNavigationToInvokers(
+    bool bRestrictNavigationToInvokers) {
+  const bool wasManaged = this->IsNavigationManaged();
+  this->RestrictNavigationToInvokers = bRestrictNavigationToInvokers;
+  if (this->IsNavigationManaged() != wasManaged) {
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetMaximumNavigationUpdatesPerFrame(
+    int32 InMaximumNavigationUpdatesPerFrame) {
+  const bool wasManaged = this->IsNavigationManaged();
+  this->MaximumNavigationUpdatesPerFrame =
+      FMath::Max(InMaximumNavigationUpdatesPerFrame, 0);
+  if (this->IsNavigationManaged() != wasManaged) {
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents) {
   if (this->AlwaysIncludeTangents != bAlwaysIncludeTangents) {
     this->AlwaysIncludeTangents = bAlwaysIncludeTangents;
@@ -389,6 +541,18 @@ void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
   }
 }
 
+void ACesium3DTileset::SetSmoothNormalsCreaseAngle(
+    float InSmoothNormalsCreaseAngle) {
+  InSmoothNormalsCreaseAngle =
+      FMath::Clamp(InSmoothNormalsCreaseAngle, 0.0f, 180.0f);
+  if (this->SmoothNormalsCreaseAngle != InSmoothNormalsCreaseAngle) {
+    this->SmoothNormalsCreaseAngle = InSmoothNormalsCreaseAngle;
+    if (this->GenerateSmoothNormals) {
+      this->DestroyTileset();
+    }
+  }
+}
+
 void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask) {
   if (this->EnableWaterMask != bEnableMask) {
     this->EnableWaterMask = bEnableMask;
@@ -404,24 +568,156 @@ void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
   }
 }
 
+void ACesium3DTileset::SetCompressTextures(bool bCompressTextures) {
+  if (this->CompressTextures != bCompressTextures) {
+    this->CompressTextures = bCompressTextures;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetUseCompactVertexFormat(
+    bool bUseCompactVertexFormat) {
+  if (this->UseCompactVertexFormat != bUseCompactVertexFormat) {
+    this->UseCompactVertexFormat = bUseCompactVertexFormat;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetPackFeatureIds(bool bPackFeatureIds) {
+  if (this->PackFeatureIds != bPackFeatureIds) {
+    this->PackFeatureIds = bPackFeatureIds;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetQuantizePointClouds(bool bQuantizePointClouds) {
+  if (this->QuantizePointClouds != bQuantizePointClouds) {
+    this->QuantizePointClouds = bQuantizePointClouds;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetUseFastTangentsForWater(
+    bool bUseFastTangentsForWater) {
+  if (this->UseFastTangentsForWater != bUseFastTangentsForWater) {
+    this->UseFastTangentsForWater = bUseFastTangentsForWater;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetUseTerrainHeightmaps(bool bUseTerrainHeightmaps) {
+  if (this->UseTerrainHeightmaps != bUseTerrainHeightmaps) {
+    this->UseTerrainHeightmaps = bUseTerrainHeightmaps;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetTerrainHeightmapResolution(
+    int32 InTerrainHeightmapResolution) {
+  if (this->TerrainHeightmapResolution != InTerrainHeightmapResolution) {
+    this->TerrainHeightmapResolution = InTerrainHeightmapResolution;
+    if (this->UseTerrainHeightmaps) {
+      this->DestroyTileset();
+    }
+  }
+}
+
+void ACesium3DTileset::SetComputeRasterOverlayTextureCoordinates(
+    bool bComputeRasterOverlayTextureCoordinates) {
+  if (this->ComputeRasterOverlayTextureCoordinates !=
+      bComputeRasterOverlayTextureCoordinates) {
+    this->ComputeRasterOverlayTextureCoordinates =
+        bComputeRasterOverlayTextureCoordinates;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetOptimizeMeshes(bool bOptimizeMeshes) {
+  if (this->OptimizeMeshes != bOptimizeMeshes) {
+    this->OptimizeMeshes = bOptimizeMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetBuildNaniteMeshes(bool bBuildNaniteMeshes) {
+  if (this->BuildNaniteMeshes != bBuildNaniteMeshes) {
+    this->BuildNaniteMeshes = bBuildNaniteMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetGenerateSimplifiedLod(bool bGenerateSimplifiedLod) {
+  if (this->GenerateSimplifiedLod != bGenerateSimplifiedLod) {
+    this->GenerateSimplifiedLod = bGenerateSimplifiedLod;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetSimplifiedLodScreenSize(
+    float InSimplifiedLodScreenSize) {
+  InSimplifiedLodScreenSize =
+      FMath::Clamp(InSimplifiedLodScreenSize, 0.0f, 1.0f);
+  if (this->SimplifiedLodScreenSize != InSimplifiedLodScreenSize) {
+    this->SimplifiedLodScreenSize = InSimplifiedLodScreenSize;
+    if (this->GenerateSimplifiedLod) {
+      this->DestroyTileset();
+    }
+  }
+}
+
+void ACesium3DTileset::SetUseClusterCulling(bool bUseClusterCulling) {
+  if (this->UseClusterCulling != bUseClusterCulling) {
+    this->UseClusterCulling = bUseClusterCulling;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetMergeInstancedMeshes(bool bMergeInstancedMeshes) {
+  if (this->MergeInstancedMeshes != bMergeInstancedMeshes) {
+    this->MergeInstancedMeshes = bMergeInstancedMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetMergeSmallPrimitives(bool bMergeSmallPrimitives) {
+  if (this->MergeSmallPrimitives != bMergeSmallPrimitives) {
+    this->MergeSmallPrimitives = bMergeSmallPrimitives;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetTileBufferResidency(
+    ECesiumTileBufferResidency InResidency) {
+  if (this->TileBufferResidency != InResidency) {
+    this->TileBufferResidency = InResidency;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial) {
   if (this->Material != InMaterial) {
     this->Material = InMaterial;
-    this->DestroyTileset();
+    if (!this->updateMaterialsInPlace()) {
+      this->DestroyTileset();
+    }
   }
 }
 
 void ACesium3DTileset::SetTranslucentMaterial(UMaterialInterface* InMaterial) {
   if (this->TranslucentMaterial != InMaterial) {
     this->TranslucentMaterial = InMaterial;
-    this->DestroyTileset();
+    if (!this->updateMaterialsInPlace()) {
+      this->DestroyTileset();
+    }
   }
 }
 
 void ACesium3DTileset::SetWaterMaterial(UMaterialInterface* InMaterial) {
   if (this->WaterMaterial != InMaterial) {
     this->WaterMaterial = InMaterial;
-    this->DestroyTileset();
+    if (!this->updateMaterialsInPlace()) {
+      this->DestroyTileset();
+    }
   }
 }
 
@@ -429,6 +725,16 @@ void ACesium3DTileset::SetCustomDepthParameters(
     FCustomDepthParameters InCustomDepthParameters) {
   if (this->CustomDepthParameters != InCustomDepthParameters) {
     this->CustomDepthParameters = InCustomDepthParameters;
+    this->updateCustomDepthInPlace();
+  }
+}
+
+void ACesium3DTileset::SetRuntimeVirtualTextures(
+    const TArray<URuntimeVirtualTexture*>& InRuntimeVirtualTextures) {
+  TArray<TObjectPtr<URuntimeVirtualTexture>> newTextures(
+      InRuntimeVirtualTextures);
+  if (this->RuntimeVirtualTextures != newTextures) {
+    this->RuntimeVirtualTextures = MoveTemp(newTextures);
     this->DestroyTileset();
   }
 }
@@ -441,6 +747,21 @@ void ACesium3DTileset::SetPointCloudShading(
   }
 }
 
+void ACesium3DTileset::SetVoxelRendering(
+    FCesiumVoxelRendering InVoxelRendering) {
+  if (VoxelRendering != InVoxelRendering) {
+    // The attribute is chosen when the voxels are loaded.
+    const bool attributeChanged =
+        VoxelRendering.Attribute != InVoxelRendering.Attribute;
+    VoxelRendering = InVoxelRendering;
+    if (attributeChanged) {
+      this->DestroyTileset();
+    } else {
+      this->updateVoxelRendering();
+    }
+  }
+}
+
 void ACesium3DTileset::PlayMovieSequencer() {
   this->_beforeMoviePreloadAncestors = this->PreloadAncestors;
   this->_beforeMoviePreloadSiblings = this->PreloadSiblings;
@@ -587,19 +908,20 @@ ACesium3DTileset::GetCesiumTilesetToUnrealRelativeWorldTransform() const {
 }
 
 void ACesium3DTileset::UpdateTransformFromCesium() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTilesetTransform)
 
   const glm::dmat4& CesiumToUnreal =
       this->GetCesiumTilesetToUnrealRelativeWorldTransform();
   TArray<UCesiumGltfComponent*> gltfComponents;
   this->GetComponents<UCesiumGltfComponent>(gltfComponents);
 
+  // Hidden tiles are only moved when they're shown again.
   for (UCesiumGltfComponent* pGltf : gltfComponents) {
-    pGltf->UpdateTransformFromCesium(CesiumToUnreal);
+    pGltf->UpdateTransformFromCesiumWhenVisible(CesiumToUnreal);
   }
 
-  if (this->BoundingVolumePoolComponent) {
-    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
-        CesiumToUnreal);
+  if (this->_pInstanceBatches) {
+    this->_pInstanceBatches->updateTransforms(CesiumToUnreal);
   }
 }
 
@@ -694,7 +1016,12 @@ void ACesium3DTileset::NotifyHit(
 class UnrealResourcePreparer
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
-  UnrealResourcePreparer(ACesium3DTileset* pActor) : _pActor(pActor) {}
+  UnrealResourcePreparer(
+      ACesium3DTileset* pActor,
+      const std::shared_ptr<CesiumCancellableAssetAccessor>& pAssetAccessor)
+      : _pActor(pActor),
+        _pAssetAccessor(pAssetAccessor),
+        _pTileContentBuilder(pActor->GetTileContentBuilder()) {}
 
   virtual CesiumAsync::Future<
       Cesium3DTilesSelection::TileLoadResultAndRenderResources>
@@ -703,8 +1030,11 @@ public:
       Cesium3DTilesSelection::TileLoadResult&& tileLoadResult,
       const glm::dmat4& transform,
       const std::any& rendererOptions) override {
+    // Tiles of a tileset that is being destroyed are not worth converting.
     CesiumGltf::Model* pModel =
-        std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
+        this->_pAssetAccessor->isCancelled()
+            ? nullptr
+            : std::get_if<CesiumGltf::Model>(&tileLoadResult.contentKind);
     if (!pModel)
       return asyncSystem.createResolvedFuture(
           Cesium3DTilesSelection::TileLoadResultAndRenderResources{
@@ -715,13 +1045,65 @@ public:
     options.pModel = pModel;
     options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
     options.createPhysicsMeshes = this->_pActor->GetCreatePhysicsMeshes();
+    options.createPhysicsMeshesOnDemand =
+        this->_pActor->GetCreatePhysicsMeshesOnDemand();
+    // While the device is under pressure, the physics meshes are built later,
+    // by updatePhysicsMeshesInPlace, from the buffers that are kept for them.
+    if (options.createPhysicsMeshes && !options.createPhysicsMeshesOnDemand &&
+        CesiumStreamingGovernor::shouldDeferPhysicsMeshes()) {
+      options.createPhysicsMeshesOnDemand = true;
+      this->_pActor->_physicsMeshesDeferred = true;
+    }
+    options.physicsMeshSimplificationError =
+        this->_pActor->GetPhysicsMeshSimplificationError();
+    options.createTraceMeshes = this->_pActor->GetCreateTraceMeshes();
+    options.createFeatureIndices = this->_pActor->GetCreateFeatureIndices();
 
     options.ignoreKhrMaterialsUnlit =
         this->_pActor->GetIgnoreKhrMaterialsUnlit();
-
-    if (this->_pActor->_featuresMetadataDescription) {
+    options.compressTextures = this->_pActor->GetCompressTextures();
+    options.useCompactVertexFormat =
+        this->_pActor->GetUseCompactVertexFormat();
+    options.packFeatureIds = this->_pActor->GetPackFeatureIds();
+    options.quantizePointClouds = this->_pActor->GetQuantizePointClouds();
+    options.generateSmoothNormals = this->_pActor->GetGenerateSmoothNormals();
+    options.smoothNormalsCreaseAngle =
+        this->_pActor->GetSmoothNormalsCreaseAngle();
+    options.useFastTangentsForWater =
+        this->_pActor->GetUseFastTangentsForWater();
+    options.useTerrainHeightmaps = this->_pActor->GetUseTerrainHeightmaps();
+    options.terrainHeightmapResolution =
+        this->_pActor->GetTerrainHeightmapResolution();
+    options.computeOverlayTextureCoordinates =
+        this->_pActor->GetComputeRasterOverlayTextureCoordinates();
+    options.voxelAttribute =
+        TCHAR_TO_UTF8(*this->_pActor->GetVoxelRendering().Attribute);
+    options.optimizeMeshes = this->_pActor->GetOptimizeMeshes();
+    options.buildNaniteMeshes = this->_pActor->GetBuildNaniteMeshes();
+    options.generateSimplifiedLod = this->_pActor->GetGenerateSimplifiedLod();
+    options.simplifiedLodScreenSize =
+        this->_pActor->GetSimplifiedLodScreenSize();
+    options.useClusterCulling = this->_pActor->GetUseClusterCulling();
+    options.mergeInstancedMeshes = this->_pActor->GetMergeInstancedMeshes();
+    options.mergeSmallPrimitives = this->_pActor->GetMergeSmallPrimitives();
+    const ECesiumTileBufferResidency residency =
+        this->_pActor->GetTileBufferResidency();
+    options.releaseBuffers = residency != ECesiumTileBufferResidency::KeepAll;
+    options.keepPickingBuffers =
+        residency == ECesiumTileBufferResidency::KeepPickingData ||
+        options.createPhysicsMeshesOnDemand;
+    options.headless = IsRunningDedicatedServer();
+
+    // The description is kept while the tile is created, even if the
+    // properties encoded on demand change meanwhile.
+    TSharedPtr<
+        const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+        ESPMode::ThreadSafe>
+        pFeaturesMetadataDescription =
+            this->_pActor->getFeaturesMetadataDescription();
+    if (pFeaturesMetadataDescription) {
       options.pFeaturesMetadataDescription =
-          &(*this->_pActor->_featuresMetadataDescription);
+          pFeaturesMetadataDescription.Get();
     } else if (this->_pActor->_metadataDescription_DEPRECATED) {
       options.pEncodedMetadataDescription_DEPRECATED =
           &(*this->_pActor->_metadataDescription_DEPRECATED);
@@ -729,16 +1111,64 @@ public:
 
     const CesiumGeospatial::Ellipsoid& ellipsoid = tileLoadResult.ellipsoid;
 
-    TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf =
-        UCesiumGltfComponent::CreateOffGameThread(
-            transform,
-            options,
-            ellipsoid);
+    // The RHI textures of the tile are all created before waiting for any of
+    // them, and the worker thread isn't blocked while they're made ready.
+    CesiumTextureUtility::AsyncTextureCreations textureCreations;
+
+    // The sizes are taken before the images are handed to the textures.
+    CesiumTrace::TileLoadStatistics traceStatistics;
+    const bool trace = CesiumTrace::isEnabled();
+    if (trace) {
+      if (tileLoadResult.pCompletedRequest) {
+        traceStatistics.url =
+            UTF8_TO_TCHAR(tileLoadResult.pCompletedRequest->url().c_str());
+        const CesiumAsync::IAssetResponse* pResponse =
+            tileLoadResult.pCompletedRequest->response();
+        traceStatistics.contentBytes =
+            pResponse ? uint64(pResponse->data().size()) : 0;
+      }
+      CesiumTrace::addModelSizes(*pModel, traceStatistics);
+      traceStatistics.loadStartCycle = FPlatformTime::Cycles64();
+    }
 
-    return asyncSystem.createResolvedFuture(
-        Cesium3DTilesSelection::TileLoadResultAndRenderResources{
-            std::move(tileLoadResult),
-            pHalf.Release()});
+    TUniquePtr<ICesiumTileContentBuilder::LoadThreadResult> pBuilderResult;
+    if (this->_pTileContentBuilder) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PrepareTileContentInLoadThread)
+      pBuilderResult = this->_pTileContentBuilder->prepareInLoadThread(
+          *pModel,
+          transform,
+          ellipsoid);
+    }
+
+    double startTime = FPlatformTime::Seconds();
+    TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf;
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(
+          *traceStatistics.url,
+          CesiumChannel)
+      pHalf = UCesiumGltfComponent::CreateOffGameThread(
+          transform,
+          options,
+          ellipsoid);
+    }
+    pHalf->LoadMilliseconds = (FPlatformTime::Seconds() - startTime) * 1000.0;
+    pHalf->TileContentBuilderResult = MoveTemp(pBuilderResult);
+    UCesiumTilesetStatistics::RecordStage(
+        ECesiumTileLoadStage::CreateOffGameThread,
+        pHalf->LoadMilliseconds);
+
+    if (trace) {
+      traceStatistics.loadEndCycle = FPlatformTime::Cycles64();
+      pHalf->TraceStatistics = MoveTemp(traceStatistics);
+    }
+
+    return textureCreations.whenReady(asyncSystem).thenImmediately(
+        [tileLoadResult = std::move(tileLoadResult),
+         pHalf = std::move(pHalf)]() mutable {
+          return Cesium3DTilesSelection::TileLoadResultAndRenderResources{
+              std::move(tileLoadResult),
+              pHalf.Release()};
+        });
   }
 
   virtual void* prepareInMainThread(
@@ -749,9 +1179,32 @@ public:
       TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf(
           reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
               pLoadThreadResult));
+      if (!pHalf) {
+        return nullptr;
+      }
       Cesium3DTilesSelection::TileRenderContent& renderContent =
           *content.getRenderContent();
-      return UCesiumGltfComponent::CreateOnGameThread(
+
+      const UWorld* pWorld = this->_pActor->GetWorld();
+      const bool trace = CesiumTrace::isEnabled();
+      const FString traceTileId =
+          trace ? FString(UTF8_TO_TCHAR(
+                      Cesium3DTilesSelection::TileIdUtilities::
+                          createTileIdString(tile.getTileID())
+                              .c_str()))
+                : FString();
+      const CesiumTrace::TileLoadStatistics traceStatistics =
+          trace ? MoveTemp(pHalf->TraceStatistics)
+                : CesiumTrace::TileLoadStatistics();
+      const uint64 startCycle = trace ? FPlatformTime::Cycles64() : 0;
+      const double loadMilliseconds = pHalf->LoadMilliseconds;
+      TUniquePtr<ICesiumTileContentBuilder::LoadThreadResult> pBuilderResult =
+          MoveTemp(pHalf->TileContentBuilderResult);
+      TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*traceTileId, CesiumChannel)
+      SCOPE_CYCLE_COUNTER(STAT_CesiumTileCreation);
+
+      double startTime = FPlatformTime::Seconds();
+      UCesiumGltfComponent* pGltf = UCesiumGltfComponent::CreateOnGameThread(
           renderContent.getModel(),
           this->_pActor,
           std::move(pHalf),
@@ -761,7 +1214,58 @@ public:
           this->_pActor->GetWaterMaterial(),
           this->_pActor->GetCustomDepthParameters(),
           tile,
-          this->_pActor->GetCreateNavCollision());
+          this->_pActor->GetCreateNavCollision(),
+          CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld));
+      const double elapsedMilliseconds =
+          (FPlatformTime::Seconds() - startTime) * 1000.0;
+      CesiumTileFinalizationBudget::recordTileFinalized(
+          pWorld,
+          elapsedMilliseconds);
+      UCesiumTilesetStatistics::RecordStage(
+          ECesiumTileLoadStage::CreateOnGameThread,
+          elapsedMilliseconds);
+      pGltf->LoadMilliseconds = loadMilliseconds + elapsedMilliseconds;
+      for (const Cesium3DTilesSelection::Tile* pParent = tile.getParent();
+           pParent;
+           pParent = pParent->getParent()) {
+        ++pGltf->RefinementDepth;
+      }
+      if (trace) {
+        CesiumTrace::traceTileLoad(
+            traceTileId,
+            traceStatistics,
+            startCycle,
+            FPlatformTime::Cycles64());
+      }
+
+      if (this->_pTileContentBuilder) {
+        pGltf->TileContentBuildPending = true;
+        pGltf->TileContentBuilderResult = MoveTemp(pBuilderResult);
+        pGltf->pTileContentModel = &renderContent.getModel();
+      }
+
+      if (!pGltf->IsBuildComplete()) {
+        // The rest of this tile's primitives will be created in later frames.
+        this->_pActor->_gltfComponentsBeingBuilt.Add(pGltf);
+      } else {
+        this->_pActor->finishTileContent(*pGltf);
+      }
+
+      // The tile may have been loaded before the properties encoded on
+      // demand last changed.
+      const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
+          this->_pActor
+              ->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+      if (pFeaturesMetadataComponent &&
+          pFeaturesMetadataComponent->EncodePropertiesOnDemand) {
+        this->_pActor->_gltfComponentsToEncode.Add(pGltf);
+      }
+
+      if (this->_pActor->_pFeatureStyle) {
+        this->_pActor->_gltfComponentsToStyle.Add(pGltf);
+      }
+
+      return pGltf;
     }
     // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
     return nullptr;
@@ -779,23 +1283,48 @@ public:
     } else if (pMainThreadResult) {
       UCesiumGltfComponent* pGltf =
           reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
-      CesiumLifetime::destroyComponentRecursively(pGltf);
+      pGltf->CancelBuild();
+      if (this->_pTileContentBuilder) {
+        this->_pTileContentBuilder->releaseInGameThread(*this->_pActor, *pGltf);
+      }
+      pGltf->TileContentBuildPending = false;
+      pGltf->TileContentBuilderResult.Reset();
+      pGltf->pTileContentModel = nullptr;
+      this->_pActor->GetMemoryUsageTracker().removeComponent(pGltf);
+      if (this->_pActor->_pInstanceBatches) {
+        this->_pActor->_pInstanceBatches->remove(*pGltf);
+      }
+      if (this->_pActor->_pHeldTileStateChanges) {
+        this->_pActor->_pHeldTileStateChanges->remove(pGltf);
+      }
+      this->_pActor->GetPrimitiveComponentPool().releaseGltfComponent(pGltf);
     }
   }
 
   virtual void* prepareRasterInLoadThread(
       CesiumGltf::ImageCesium& image,
       const std::any& rendererOptions) override {
-    auto ppOptions =
-        std::any_cast<FRasterOverlayRendererOptions*>(&rendererOptions);
-    check(ppOptions != nullptr && *ppOptions != nullptr);
-    if (ppOptions == nullptr || *ppOptions == nullptr) {
+    auto ppData =
+        std::any_cast<CesiumRasterOverlayRendererDataPtr>(&rendererOptions);
+    check(ppData != nullptr && ppData->IsValid());
+    if (ppData == nullptr || !ppData->IsValid()) {
       return nullptr;
     }
 
-    auto pOptions = *ppOptions;
+    const FRasterOverlayRendererOptions* pOptions = (*ppData)->getOptions();
 
-    if (pOptions->useMipmaps) {
+    // A tile that goes into the overlay's texture array is resized to the
+    // size of its slices, which generates its mipmaps too.
+    const bool packed = (*ppData)->usesTextureArray() &&
+                        CesiumRasterOverlayTextureArray::prepareImage(
+                            image,
+                            *pOptions);
+
+    const bool generateMipmapsOnGpu =
+        pOptions->useMipmaps && pOptions->generateMipmapsOnGpu &&
+        !pOptions->compressTextures && !packed;
+
+    if (pOptions->useMipmaps && !generateMipmapsOnGpu && !packed) {
       std::optional<std::string> errorMessage =
           CesiumGltfReader::GltfReader::generateMipMaps(image);
       if (errorMessage) {
@@ -807,6 +1336,11 @@ public:
       }
     }
 
+    if (pOptions->compressTextures && !packed) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompressTexture)
+      CesiumTextureCompression::compressImage(image);
+    }
+
     auto texture = CesiumTextureUtility::loadTextureAnyThreadPart(
         image,
         TextureAddress::TA_Clamp,
@@ -817,7 +1351,12 @@ public:
         // TODO: sRGB should probably be configurable on the raster overlay.
         true,
         std::nullopt,
-        nullptr);
+        nullptr,
+        generateMipmapsOnGpu,
+        std::nullopt,
+        // Overlay tiles are nearly all the same size and are released as
+        // often as they're loaded, so their RHI textures are reused.
+        true);
     return texture.Release();
   }
 
@@ -833,6 +1372,10 @@ public:
       return nullptr;
     }
 
+    // This runs in a main thread continuation rather than in the tileset's
+    // main thread loading, so its time is added to the budget here, and the
+    // tiles finalized later in the frame make up for it.
+    const double startTime = FPlatformTime::Seconds();
     CesiumUtility::IntrusivePointer<
         CesiumTextureUtility::ReferenceCountedUnrealTexture>
         pTexture = CesiumTextureUtility::loadTextureGameThreadPart(
@@ -841,6 +1384,28 @@ public:
       return nullptr;
     }
 
+    // Copy the tile into a slice of the overlay's texture array, if it has
+    // one, and then release the tile's own texture.
+    CesiumRasterOverlayRendererData* pOverlayData =
+        CesiumRasterOverlayRendererData::get(rasterTile.getOverlay());
+    CesiumRasterOverlayTextureArray* pTextureArray =
+        pOverlayData ? pOverlayData->getTextureArray() : nullptr;
+    if (pTextureArray) {
+      const int32 slice = pTextureArray->addTexture(pTexture);
+      if (slice >= 0) {
+        pTexture = new CesiumTextureUtility::ReferenceCountedUnrealTexture();
+        pTexture->setTextureArraySlice(slice);
+      }
+    }
+
+    if (pOverlayData) {
+      pOverlayData->addTexture(pTexture.get());
+    }
+
+    CesiumTileFinalizationBudget::recordFinalizationTime(
+        this->_pActor->GetWorld(),
+        (FPlatformTime::Seconds() - startTime) * 1000.0);
+
     // Don't let this ReferenceCountedUnrealTexture be destroyed when the
     // intrusive pointer goes out of scope.
     pTexture->addReference();
@@ -862,6 +1427,20 @@ public:
       CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture =
           static_cast<CesiumTextureUtility::ReferenceCountedUnrealTexture*>(
               pMainThreadResult);
+
+      CesiumRasterOverlayRendererData* pOverlayData =
+          CesiumRasterOverlayRendererData::get(rasterTile.getOverlay());
+      if (pOverlayData) {
+        pOverlayData->removeTexture(pTexture);
+
+        const int32 slice = pTexture->getTextureArraySlice();
+        CesiumRasterOverlayTextureArray* pTextureArray =
+            slice >= 0 ? pOverlayData->getTextureArray() : nullptr;
+        if (pTextureArray) {
+          pTextureArray->removeTexture(slice);
+        }
+      }
+
       pTexture->releaseReference();
     }
   }
@@ -881,15 +1460,17 @@ public:
           reinterpret_cast<UCesiumGltfComponent*>(
               pRenderContent->getRenderResources());
       if (pGltfContent) {
+        const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture =
+            static_cast<CesiumTextureUtility::ReferenceCountedUnrealTexture*>(
+                pMainThreadRendererResources);
         pGltfContent->AttachRasterTile(
             tile,
             rasterTile,
-            static_cast<CesiumTextureUtility::ReferenceCountedUnrealTexture*>(
-                pMainThreadRendererResources)
-                ->getUnrealTexture(),
+            pTexture->getUnrealTexture(),
             translation,
             scale,
-            overlayTextureCoordinateID);
+            overlayTextureCoordinateID,
+            pTexture->getTextureArraySlice());
       }
     }
   }
@@ -919,6 +1500,9 @@ public:
 
 private:
   ACesium3DTileset* _pActor;
+  std::shared_ptr<CesiumCancellableAssetAccessor> _pAssetAccessor;
+  TSharedPtr<ICesiumTileContentBuilder, ESPMode::ThreadSafe>
+      _pTileContentBuilder;
 };
 
 void ACesium3DTileset::UpdateLoadStatus() {
@@ -977,8 +1561,8 @@ getCesiumViewExtension() {
 void ACesium3DTileset::LoadTileset() {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadTileset)
 
-  if (this->_pTileset) {
-    // Tileset already loaded, do nothing.
+  if (this->_pTileset || this->getLinkedTileset()) {
+    // Tileset already loaded, or shown from the linked tileset, do nothing.
     return;
   }
 
@@ -1004,10 +1588,29 @@ void ACesium3DTileset::LoadTileset() {
     this->CesiumIonServer = UCesiumIonServer::GetServerForNewObjects();
   }
 
+#if WITH_EDITOR
+  // Tiles are loaded in worker threads, which can't load the module.
+  if (this->BuildNaniteMeshes) {
+    CesiumNaniteBuilder::loadModule();
+  }
+#endif
+
   const TSharedRef<CesiumViewExtension, ESPMode::ThreadSafe>&
       cesiumViewExtension = getCesiumViewExtension();
-  const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor =
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor =
       getAssetAccessor();
+
+  // A package is read through its own accessor, which passes any requests
+  // outside the package, such as for raster overlays, to the global one. If
+  // the package can't be opened, every request for its tileset.json fails and
+  // is reported like any other load failure.
+  if (this->TilesetSource == ETilesetSource::FromLocalPackage) {
+    pAssetAccessor = std::make_shared<Cesium3DTilesPackageAssetAccessor>(
+        Cesium3DTilesPackage::open(this->LocalPackageFilename),
+        pAssetAccessor);
+  }
+  this->_pAssetAccessor =
+      std::make_shared<CesiumCancellableAssetAccessor>(pAssetAccessor);
   const CesiumAsync::AsyncSystem& asyncSystem = getAsyncSystem();
 
   // Both the feature flag and the CesiumViewExtension are global, not owned by
@@ -1022,6 +1625,12 @@ void ACesium3DTileset::LoadTileset() {
   TArray<UCesiumTileExcluder*> tileExcluders;
   this->GetComponents<UCesiumTileExcluder>(tileExcluders);
 
+  TArray<UCesiumNativeTileExcluder*> nativeTileExcluders;
+  this->GetComponents<UCesiumNativeTileExcluder>(nativeTileExcluders);
+
+  TArray<UCesiumPolygonClippingComponent*> polygonClippings;
+  this->GetComponents<UCesiumPolygonClippingComponent>(polygonClippings);
+
   const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
       this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
 
@@ -1031,18 +1640,26 @@ void ACesium3DTileset::LoadTileset() {
   const UDEPRECATED_CesiumEncodedMetadataComponent* pEncodedMetadataComponent =
       this->FindComponentByClass<UDEPRECATED_CesiumEncodedMetadataComponent>();
 
-  this->_featuresMetadataDescription = std::nullopt;
+  TSharedPtr<
+      const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+      ESPMode::ThreadSafe>
+      pFeaturesMetadataDescription;
   this->_metadataDescription_DEPRECATED = std::nullopt;
 
   if (pFeaturesMetadataComponent) {
-    FCesiumFeaturesMetadataDescription& description =
-        this->_featuresMetadataDescription.emplace();
+    FCesiumFeaturesMetadataDescription description;
     description.Features = {pFeaturesMetadataComponent->FeatureIdSets};
     description.PrimitiveMetadata = {
         pFeaturesMetadataComponent->PropertyTextureNames};
     description.ModelMetadata = {
-        pFeaturesMetadataComponent->PropertyTables,
+        pFeaturesMetadataComponent->GetPropertyTablesToEncode(
+            {this->Material, this->TranslucentMaterial, this->WaterMaterial}),
         pFeaturesMetadataComponent->PropertyTextures};
+    this->_usedMetadataPropertiesVersion =
+        pFeaturesMetadataComponent->GetUsedPropertiesVersion();
+    pFeaturesMetadataDescription = MakeShared<
+        CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+        ESPMode::ThreadSafe>(MoveTemp(description));
   } else if (pEncodedMetadataComponent) {
     UE_LOG(
         LogCesium,
@@ -1056,24 +1673,18 @@ void ACesium3DTileset::LoadTileset() {
 
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
+  {
+    FScopeLock lock(&this->_featuresMetadataDescriptionLock);
+    this->_pFeaturesMetadataDescription = pFeaturesMetadataDescription;
+  }
+
   this->_cesiumViewExtension = cesiumViewExtension;
+  this->_pointsUseEyeDomeLighting = this->PointCloudShading.EyeDomeLighting;
 
   if (GetDefault<UCesiumRuntimeSettings>()
           ->EnableExperimentalOcclusionCullingFeature &&
-      this->EnableOcclusionCulling && !this->BoundingVolumePoolComponent) {
-    const glm::dmat4& cesiumToUnreal =
-        GetCesiumTilesetToUnrealRelativeWorldTransform();
-    this->BoundingVolumePoolComponent =
-        NewObject<UCesiumBoundingVolumePoolComponent>(this);
-    this->BoundingVolumePoolComponent->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    this->BoundingVolumePoolComponent->RegisterComponent();
-    this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
-        cesiumToUnreal);
-  }
-
-  if (this->BoundingVolumePoolComponent) {
-    this->BoundingVolumePoolComponent->initPool(this->OcclusionPoolSize);
+      this->EnableOcclusionCulling) {
+    this->_pOcclusionPool = std::make_shared<CesiumOcclusionProxyPool>();
   }
 
   CesiumGeospatial::Ellipsoid pNativeEllipsoid =
@@ -1082,16 +1693,12 @@ void ACesium3DTileset::LoadTileset() {
   ACesiumCreditSystem* pCreditSystem = this->ResolvedCreditSystem;
 
   Cesium3DTilesSelection::TilesetExternals externals{
-      pAssetAccessor,
-      std::make_shared<UnrealResourcePreparer>(this),
+      this->_pAssetAccessor,
+      std::make_shared<UnrealResourcePreparer>(this, this->_pAssetAccessor),
       asyncSystem,
       pCreditSystem ? pCreditSystem->GetExternalCreditSystem() : nullptr,
       spdlog::default_logger(),
-      (GetDefault<UCesiumRuntimeSettings>()
-           ->EnableExperimentalOcclusionCullingFeature &&
-       this->EnableOcclusionCulling && this->BoundingVolumePoolComponent)
-          ? this->BoundingVolumePoolComponent->getPool()
-          : nullptr};
+      this->_pOcclusionPool};
 
   this->_startTime = std::chrono::high_resolution_clock::now();
 
@@ -1107,10 +1714,39 @@ void ACesium3DTileset::LoadTileset() {
       this->EnableOcclusionCulling;
   options.delayRefinementForOcclusion = this->DelayRefinementForOcclusion;
 
+  this->_pHorizonCuller = std::make_shared<CesiumHorizonCuller>();
+  options.excluders.push_back(this->_pHorizonCuller);
+  this->_pDistanceExcluder = std::make_shared<CesiumTileDistanceExcluder>();
+  options.excluders.push_back(this->_pDistanceExcluder);
+
+  const UCesiumRuntimeSettings* pRuntimeSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (pRuntimeSettings->SelectionTraceMode !=
+      ECesiumSelectionTraceMode::Disabled) {
+    const FString filename = FPaths::Combine(
+        FPaths::ConvertRelativePathToFull(
+            FPaths::ProjectSavedDir(),
+            pRuntimeSettings->SelectionTraceDirectory),
+        this->GetName() + TEXT(".cesiumtrace"));
+    this->_pSelectionTrace = CesiumSelectionTrace::open(
+        pRuntimeSettings->SelectionTraceMode ==
+                ECesiumSelectionTraceMode::Replay
+            ? CesiumSelectionTrace::Mode::Replay
+            : CesiumSelectionTrace::Mode::Record,
+        filename);
+  }
+
   options.showCreditsOnScreen = ShowCreditsOnScreen;
 
   options.loadErrorCallback =
-      [this](const Cesium3DTilesSelection::TilesetLoadFailureDetails& details) {
+      [this, pAssetAccessor = this->_pAssetAccessor](
+          const Cesium3DTilesSelection::TilesetLoadFailureDetails& details) {
+        // Loads of a destroyed tileset fail when their requests are
+        // cancelled, which is not worth reporting.
+        if (pAssetAccessor->isCancelled()) {
+          return;
+        }
+
         static_assert(
             uint8_t(ECesium3DTilesetLoadType::CesiumIon) ==
             uint8_t(Cesium3DTilesSelection::TilesetLoadType::CesiumIon));
@@ -1143,12 +1779,13 @@ void ACesium3DTileset::LoadTileset() {
             });
       };
 
-  // Generous per-frame time limits for loading / unloading on main thread.
-  options.mainThreadLoadingTimeLimit = 5.0;
-  options.tileCacheUnloadTimeLimit = 5.0;
+  // The main thread loading time limit is shared by all tilesets in the world
+  // and is updated every frame by updateTilesetOptionsFromProperties.
+  options.mainThreadLoadingTimeLimit =
+      CesiumTileFinalizationBudget::getRemainingMilliseconds(this->GetWorld());
 
-  options.contentOptions.generateMissingNormalsSmooth =
-      this->GenerateSmoothNormals;
+  // Generous per-frame time limit for unloading on main thread.
+  options.tileCacheUnloadTimeLimit = 5.0;
 
   // TODO: figure out why water material crashes mac
 #if PLATFORM_MAC
@@ -1156,29 +1793,15 @@ void ACesium3DTileset::LoadTileset() {
   options.contentOptions.enableWaterMask = this->EnableWaterMask;
 #endif
 
-  CesiumGltf::SupportedGpuCompressedPixelFormats supportedFormats;
-  supportedFormats.ETC1_RGB = GPixelFormats[EPixelFormat::PF_ETC1].Supported;
-  supportedFormats.ETC2_RGBA =
-      GPixelFormats[EPixelFormat::PF_ETC2_RGBA].Supported;
-  supportedFormats.BC1_RGB = GPixelFormats[EPixelFormat::PF_DXT1].Supported;
-  supportedFormats.BC3_RGBA = GPixelFormats[EPixelFormat::PF_DXT5].Supported;
-  supportedFormats.BC4_R = GPixelFormats[EPixelFormat::PF_BC4].Supported;
-  supportedFormats.BC5_RG = GPixelFormats[EPixelFormat::PF_BC5].Supported;
-  supportedFormats.BC7_RGBA = GPixelFormats[EPixelFormat::PF_BC7].Supported;
-  supportedFormats.ASTC_4x4_RGBA =
-      GPixelFormats[EPixelFormat::PF_ASTC_4x4].Supported;
-  supportedFormats.PVRTC2_4_RGBA =
-      GPixelFormats[EPixelFormat::PF_PVRTC2].Supported;
-  supportedFormats.ETC2_EAC_R11 =
-      GPixelFormats[EPixelFormat::PF_ETC2_R11_EAC].Supported;
-  supportedFormats.ETC2_EAC_RG11 =
-      GPixelFormats[EPixelFormat::PF_ETC2_RG11_EAC].Supported;
-
   options.contentOptions.ktx2TranscodeTargets =
-      CesiumGltf::Ktx2TranscodeTargets(supportedFormats, false);
+      CesiumTextureUtility::getKtx2TranscodeTargets();
 
   options.contentOptions.applyTextureTransform = false;
 
+  // The PSOs are compiled while the tileset's root and first tiles are being
+  // requested.
+  CesiumPSOPrecaching::precacheTileset(*this);
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(LogCesium, Log, TEXT("Loading tileset from URL %s"), *this->Url);
@@ -1187,6 +1810,17 @@ void ACesium3DTileset::LoadTileset() {
         TCHAR_TO_UTF8(*this->Url),
         options);
     break;
+  case ETilesetSource::FromLocalPackage:
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Loading tileset from package %s"),
+        *this->LocalPackageFilename);
+    this->_pTileset = MakeUnique<Cesium3DTilesSelection::Tileset>(
+        externals,
+        Cesium3DTilesPackageAssetAccessor::RootUrl + "tileset.json",
+        options);
+    break;
   case ETilesetSource::FromCesiumIon:
     UE_LOG(
         LogCesium,
@@ -1231,6 +1865,18 @@ void ACesium3DTileset::LoadTileset() {
     }
   }
 
+  for (UCesiumNativeTileExcluder* pTileExcluder : nativeTileExcluders) {
+    if (pTileExcluder->IsActive()) {
+      pTileExcluder->AddToTileset();
+    }
+  }
+
+  for (UCesiumPolygonClippingComponent* pClipping : polygonClippings) {
+    if (pClipping->IsActive()) {
+      pClipping->AddToTileset();
+    }
+  }
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(
@@ -1239,6 +1885,13 @@ void ACesium3DTileset::LoadTileset() {
         TEXT("Loading tileset from URL %s done"),
         *this->Url);
     break;
+  case ETilesetSource::FromLocalPackage:
+    UE_LOG(
+        LogCesium,
+        Log,
+        TEXT("Loading tileset from package %s done"),
+        *this->LocalPackageFilename);
+    break;
   case ETilesetSource::FromCesiumIon:
     UE_LOG(
         LogCesium,
@@ -1265,9 +1918,26 @@ void ACesium3DTileset::LoadTileset() {
 }
 
 void ACesium3DTileset::DestroyTileset() {
+  if (this->_pLinkedTileComponents) {
+    this->_pLinkedTileComponents->clear();
+  }
+  this->_linkedTilesets.RemoveAll(
+      [](const TWeakObjectPtr<ACesium3DTileset>& pWeak) {
+        return !pWeak.IsValid();
+      });
+
+  CesiumTrace::traceTileQueues(this, 0, 0, 0);
+  this->_isEditorViewIdle = false;
+  CesiumStats::removeTileset(this);
   if (this->_cesiumViewExtension) {
+    this->_cesiumViewExtension->SetEyeDomeLighting(this, nullptr, 0.0f, 0.0f);
+    this->_cesiumViewExtension->SetOcclusionBounds(this, nullptr, {});
     this->_cesiumViewExtension = nullptr;
   }
+  this->_pOcclusionPool = nullptr;
+  this->_pHorizonCuller = nullptr;
+  this->_pDistanceExcluder = nullptr;
+  this->_pSelectionTrace.Reset();
 
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
@@ -1277,6 +1947,13 @@ void ACesium3DTileset::DestroyTileset() {
         TEXT("Destroying tileset from URL %s"),
         *this->Url);
     break;
+  case ETilesetSource::FromLocalPackage:
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Destroying tileset from package %s"),
+        *this->LocalPackageFilename);
+    break;
   case ETilesetSource::FromCesiumIon:
     UE_LOG(
         LogCesium,
@@ -1306,6 +1983,18 @@ void ACesium3DTileset::DestroyTileset() {
     }
   }
 
+  TArray<UCesiumNativeTileExcluder*> nativeTileExcluders;
+  this->GetComponents<UCesiumNativeTileExcluder>(nativeTileExcluders);
+  for (UCesiumNativeTileExcluder* pTileExcluder : nativeTileExcluders) {
+    pTileExcluder->RemoveFromTileset();
+  }
+
+  TArray<UCesiumPolygonClippingComponent*> polygonClippings;
+  this->GetComponents<UCesiumPolygonClippingComponent>(polygonClippings);
+  for (UCesiumPolygonClippingComponent* pClipping : polygonClippings) {
+    pClipping->RemoveFromTileset();
+  }
+
   if (!this->_pTileset) {
     return;
   }
@@ -1313,11 +2002,40 @@ void ACesium3DTileset::DestroyTileset() {
   // Don't allow this Cesium3DTileset to be fully destroyed until
   // any cesium-native Tilesets it created have wrapped up any async
   // operations in progress and have been fully destroyed.
-  // See IsReadyForFinishDestroy.
+  // See IsReadyForFinishDestroy. The requests in flight are abandoned, so
+  // only the work already begun on the tiles is waited for.
+  if (this->_pAssetAccessor) {
+    this->_pAssetAccessor->cancel();
+    this->_pAssetAccessor.reset();
+  }
   ++this->_tilesetsBeingDestroyed;
   this->_pTileset->getAsyncDestructionCompleteEvent().thenInMainThread(
       [this]() { --this->_tilesetsBeingDestroyed; });
   this->_pTileset.Reset();
+  this->_gltfComponentsBeingBuilt.Empty();
+  this->_gltfComponentsToEncode.Empty();
+  this->_gltfComponentsToStyle.Empty();
+  this->_loadedTilesOnlyRendered.clear();
+  this->_shadowCastingChanged.Empty();
+  this->_pHeldTileStateChanges.Reset();
+  this->_rayTracingProxies.Empty();
+  this->_physicsMeshesChanged = false;
+
+  // The components pooled so far are destroyed. Tiles may continue to be
+  // freed as the tileset's asynchronous destruction completes, and the
+  // components they return to the pool after this are kept pooled for the
+  // next tileset.
+  if (this->_pPrimitiveComponentPool) {
+    this->_pPrimitiveComponentPool->clear();
+  }
+
+  if (this->_pMaterialInstanceCache) {
+    this->_pMaterialInstanceCache->clear();
+  }
+
+  if (this->_pInstanceBatches) {
+    this->_pInstanceBatches->clear();
+  }
 
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
@@ -1327,6 +2045,13 @@ void ACesium3DTileset::DestroyTileset() {
         TEXT("Destroying tileset from URL %s done"),
         *this->Url);
     break;
+  case ETilesetSource::FromLocalPackage:
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Destroying tileset from package %s done"),
+        *this->LocalPackageFilename);
+    break;
   case ETilesetSource::FromCesiumIon:
     UE_LOG(
         LogCesium,
@@ -1337,15 +2062,69 @@ void ACesium3DTileset::DestroyTileset() {
   }
 }
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
-  std::vector<FCesiumCamera> cameras = this->GetPlayerCameras();
+namespace {
 
-  std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(sceneCaptures.begin()),
-      std::make_move_iterator(sceneCaptures.end()));
+// The cameras of a world, as collected for tilesets with the same settings.
+struct WorldCameraSnapshot {
+  bool scaleUsingDPI;
+  // Negative when the cameras weren't collected for prefetching.
+  float prefetchTime;
+  double sceneCaptureScreenSpaceErrorMultiplier;
+  bool sceneCapturesUseLoadedTilesOnly;
+  bool mergeStereoViews;
+  std::vector<FCesiumCamera> cameras;
+};
+
+// The snapshots of the cameras of a world that were collected in a frame.
+struct WorldCameras {
+  uint64 frame = 0;
+  std::vector<WorldCameraSnapshot> snapshots;
+};
+
+CesiumPerWorldState<WorldCameras>& getWorldCameras() {
+  static CesiumPerWorldState<WorldCameras> worldCameras;
+  return worldCameras;
+}
+
+} // namespace
+
+const std::vector<FCesiumCamera>& ACesium3DTileset::GetWorldCameras() const {
+  static const std::vector<FCesiumCamera> noCameras;
+  const UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return noCameras;
+  }
+
+  WorldCameras* pWorldCameras = &getWorldCameras().get(pWorld);
+  if (pWorldCameras->frame != GFrameCounter) {
+    pWorldCameras->frame = GFrameCounter;
+    pWorldCameras->snapshots.clear();
+  }
+
+  // Tilesets with the same settings collect the same cameras, so in a frame,
+  // only the first of them needs to find them.
+  const float prefetchTime =
+      this->PrefetchAlongCameraMotion ? this->PrefetchTime : -1.0f;
+  for (const WorldCameraSnapshot& snapshot : pWorldCameras->snapshots) {
+    if (snapshot.scaleUsingDPI == this->_scaleUsingDPI &&
+        snapshot.prefetchTime == prefetchTime &&
+        snapshot.sceneCaptureScreenSpaceErrorMultiplier ==
+            this->SceneCaptureScreenSpaceErrorMultiplier &&
+        snapshot.sceneCapturesUseLoadedTilesOnly ==
+            this->SceneCapturesUseLoadedTilesOnly &&
+        snapshot.mergeStereoViews == this->MergeStereoViews) {
+      return snapshot.cameras;
+    }
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectWorldCameras)
+  std::vector<FCesiumCamera> cameras = this->GetPlayerCameras();
+
+  std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
+  cameras.insert(
+      cameras.end(),
+      std::make_move_iterator(sceneCaptures.begin()),
+      std::make_move_iterator(sceneCaptures.end()));
 
 #if WITH_EDITOR
   std::vector<FCesiumCamera> editorCameras = this->GetEditorCameras();
@@ -1355,6 +2134,20 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
       std::make_move_iterator(editorCameras.end()));
 #endif
 
+  pWorldCameras->snapshots.push_back(
+      {this->_scaleUsingDPI,
+       prefetchTime,
+       this->SceneCaptureScreenSpaceErrorMultiplier,
+       this->SceneCapturesUseLoadedTilesOnly,
+       this->MergeStereoViews,
+       std::move(cameras)});
+  return pWorldCameras->snapshots.back().cameras;
+}
+
+std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
+  std::vector<FCesiumCamera> cameras = this->GetWorldCameras();
+
   ACesiumCameraManager* pCameraManager = this->ResolvedCameraManager;
   if (pCameraManager) {
     const TMap<int32, FCesiumCamera>& extraCameras =
@@ -1365,9 +2158,183 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
     }
   }
 
+  this->addLinkedTilesetCameras(cameras);
+
   return cameras;
 }
 
+ACesium3DTileset* ACesium3DTileset::getLinkedTileset() const {
+  ACesium3DTileset* pLinkedTileset = this->LinkedTileset;
+  if (!IsValid(pLinkedTileset)) {
+    return this->ShareTilesAcrossWorlds
+               ? CesiumSharedTilesets::findSource(*this)
+               : nullptr;
+  }
+  if (pLinkedTileset == this ||
+      IsValid(pLinkedTileset->LinkedTileset) ||
+      pLinkedTileset->GetWorld() != this->GetWorld()) {
+    return nullptr;
+  }
+  return pLinkedTileset;
+}
+
+void ACesium3DTileset::SetTileContentBuilder(
+    const TSharedPtr<ICesiumTileContentBuilder, ESPMode::ThreadSafe>&
+        Builder) {
+  if (this->_pTileContentBuilder != Builder) {
+    // The tiles are released by the builder that built them.
+    this->DestroyTileset();
+    this->_pTileContentBuilder = Builder;
+  }
+}
+
+void ACesium3DTileset::ReleaseTilesSharedFromWorld(const UWorld* World) {
+  const ACesium3DTileset* pSource =
+      this->_pLinkedTileComponents
+          ? this->_pLinkedTileComponents->getSourceTileset()
+          : nullptr;
+  if (pSource && pSource->GetWorld() == World) {
+    this->_pLinkedTileComponents->clear();
+    this->_pLinkedTileComponents.Reset();
+  }
+}
+
+void ACesium3DTileset::addLinkedTilesetCameras(
+    std::vector<FCesiumCamera>& cameras) const {
+  const FTransform& tilesetTransform = this->GetActorTransform();
+  for (const TWeakObjectPtr<ACesium3DTileset>& pWeak : this->_linkedTilesets) {
+    const ACesium3DTileset* pLinked = pWeak.Get();
+    if (!pLinked || pLinked->getLinkedTileset() != this) {
+      continue;
+    }
+
+    // A view of the linked tileset sees the same tiles as the view at the
+    // same place relative to this tileset.
+    const FTransform& linkedTransform = pLinked->GetActorTransform();
+    for (FCesiumCamera camera : pLinked->GetCameras()) {
+      camera.Location = tilesetTransform.TransformPosition(
+          linkedTransform.InverseTransformPosition(camera.Location));
+      camera.Rotation =
+          tilesetTransform
+              .TransformRotation(linkedTransform.InverseTransformRotation(
+                  camera.Rotation.Quaternion()))
+              .Rotator();
+      cameras.push_back(camera);
+    }
+  }
+}
+
+namespace {
+
+/**
+ * Gets the average velocity of the view target of a player over the next
+ * given number of seconds of the flight that its Cesium Fly To Component has
+ * in progress, or zero if it isn't flying.
+ */
+FVector
+getFlightVelocity(const APlayerController& playerController, float seconds) {
+  AActor* pViewTarget = playerController.GetViewTarget();
+  if (!IsValid(pViewTarget) || seconds <= 0.0f) {
+    return FVector::ZeroVector;
+  }
+
+  UCesiumFlyToComponent* pFlyTo =
+      pViewTarget->FindComponentByClass<UCesiumFlyToComponent>();
+  FVector predictedLocation;
+  if (!pFlyTo || !pFlyTo->PredictLocationUnreal(seconds, predictedLocation)) {
+    return FVector::ZeroVector;
+  }
+
+  return (predictedLocation - pViewTarget->GetActorLocation()) / seconds;
+}
+
+/**
+ * The largest half-angle, in degrees, of the frustum of a merged stereo view,
+ * so that its field of view stays finite.
+ */
+constexpr double MaximumMergedHalfAngleDegrees = 85.0;
+
+/**
+ * Combines the views of the two eyes of a stereo pair into one view, which
+ * looks in the average direction of the eyes and is moved back from between
+ * them until its frustum contains both of theirs. Its horizontal and
+ * vertical half-angles are those of the wider eye, widened by the angle
+ * between each eye's direction and the average for canted displays, and it
+ * has the larger viewport size of the two, so that its screen-space error is
+ * about the larger of theirs.
+ */
+FCesiumCamera
+mergeStereoCameras(const FCesiumCamera& left, const FCesiumCamera& right) {
+  const FVector forward =
+      (left.Rotation.Vector() + right.Rotation.Vector()).GetSafeNormal();
+  const FVector up = (left.Rotation.RotateVector(FVector::UpVector) +
+                      right.Rotation.RotateVector(FVector::UpVector))
+                         .GetSafeNormal();
+  const FRotator rotation = FRotationMatrix::MakeFromXZ(forward, up).Rotator();
+  const FVector rightAxis = rotation.RotateVector(FVector::RightVector);
+  const FVector upAxis = rotation.RotateVector(FVector::UpVector);
+
+  double horizontalHalfAngle = 0.0;
+  double verticalHalfAngle = 0.0;
+  for (const FCesiumCamera* pEye : {&left, &right}) {
+    const double cant = glm::acos(FMath::Clamp(
+        FVector::DotProduct(pEye->Rotation.Vector(), forward),
+        -1.0,
+        1.0));
+    const double eyeAspectRatio =
+        pEye->OverrideAspectRatio != 0.0
+            ? pEye->OverrideAspectRatio
+            : pEye->ViewportSize.X / pEye->ViewportSize.Y;
+    const double eyeTanHalfHorizontal =
+        glm::tan(glm::radians(0.5 * pEye->FieldOfViewDegrees));
+    horizontalHalfAngle = std::max(
+        horizontalHalfAngle,
+        glm::atan(eyeTanHalfHorizontal) + cant);
+    verticalHalfAngle = std::max(
+        verticalHalfAngle,
+        glm::atan(eyeTanHalfHorizontal / eyeAspectRatio) + cant);
+  }
+  const double maximumHalfAngle = glm::radians(MaximumMergedHalfAngleDegrees);
+  const double tanHalfHorizontal =
+      glm::tan(std::min(horizontalHalfAngle, maximumHalfAngle));
+  const double tanHalfVertical =
+      glm::tan(std::min(verticalHalfAngle, maximumHalfAngle));
+
+  // The eyes are inside the frustum once the view is moved back far enough
+  // along both its horizontal and its vertical half-angle.
+  const FVector center = 0.5 * (left.Location + right.Location);
+  double backOff = 0.0;
+  for (const FCesiumCamera* pEye : {&left, &right}) {
+    const FVector offset = pEye->Location - center;
+    const double required =
+        std::max(
+            FMath::Abs(FVector::DotProduct(offset, rightAxis)) /
+                tanHalfHorizontal,
+            FMath::Abs(FVector::DotProduct(offset, upAxis)) /
+                tanHalfVertical) -
+        FVector::DotProduct(offset, forward);
+    backOff = std::max(backOff, required);
+  }
+
+  // The field of view is horizontal, so it is widened until the merged
+  // viewport's aspect ratio gives the vertical half-angle, too.
+  const FVector2D viewportSize(
+      std::max(left.ViewportSize.X, right.ViewportSize.X),
+      std::max(left.ViewportSize.Y, right.ViewportSize.Y));
+  const double aspectRatio = viewportSize.X / viewportSize.Y;
+  const double fov = glm::degrees(
+      2.0 *
+      glm::atan(std::max(tanHalfHorizontal, tanHalfVertical * aspectRatio)));
+
+  return FCesiumCamera(
+      viewportSize,
+      center - forward * backOff,
+      rotation,
+      fov);
+}
+
+} // namespace
+
 std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
   UWorld* pWorld = this->GetWorld();
   if (!pWorld) {
@@ -1430,6 +2397,8 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
       }
     }
 
+    const size_t firstCamera = cameras.size();
+
     if (useStereoRendering) {
       const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
       const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
@@ -1504,6 +2473,12 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
             rightEyeRotation,
             hfov);
       }
+
+      if (this->MergeStereoViews && cameras.size() == firstCamera + 2) {
+        cameras[firstCamera] =
+            mergeStereoCameras(cameras[firstCamera], cameras[firstCamera + 1]);
+        cameras.pop_back();
+      }
     } else {
       cameras.emplace_back(
           FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
@@ -1511,6 +2486,14 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
           rotation,
           fov);
     }
+
+    if (this->PrefetchAlongCameraMotion) {
+      const FVector velocity =
+          getFlightVelocity(*pPlayerController, this->PrefetchTime);
+      for (size_t i = firstCamera; i < cameras.size(); ++i) {
+        cameras[i].Velocity = velocity;
+      }
+    }
   }
 
   return cameras;
@@ -1561,16 +2544,123 @@ std::vector<FCesiumCamera> ACesium3DTileset::GetSceneCaptures() const {
     FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
     double captureFov = pSceneCaptureComponent->FOVAngle;
 
-    cameras.emplace_back(
+    FCesiumCamera& camera = cameras.emplace_back(
         renderTargetSize,
         captureLocation,
         captureRotation,
         captureFov);
+    camera.ScreenSpaceErrorMultiplier =
+        this->SceneCaptureScreenSpaceErrorMultiplier;
+    camera.UseLoadedTilesOnly = this->SceneCapturesUseLoadedTilesOnly;
   }
 
   return cameras;
 }
 
+namespace {
+
+bool areViewStatesEqual(
+    const std::vector<Cesium3DTilesSelection::ViewState>& views0,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views1) {
+  if (views0.size() != views1.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < views0.size(); ++i) {
+    const Cesium3DTilesSelection::ViewState& view0 = views0[i];
+    const Cesium3DTilesSelection::ViewState& view1 = views1[i];
+    if (view0.getPosition() != view1.getPosition() ||
+        view0.getDirection() != view1.getDirection() ||
+        view0.getUp() != view1.getUp() ||
+        view0.getViewportSize() != view1.getViewportSize() ||
+        view0.getHorizontalFieldOfView() != view1.getHorizontalFieldOfView() ||
+        view0.getVerticalFieldOfView() != view1.getVerticalFieldOfView()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Adds the views of a camera to those that tiles are selected for. Tiles are
+ * refined as much as the most demanding view that they are in requires, so
+ * for a camera with a focus region, the whole view is added with a viewport
+ * that is smaller by the peripheral multiplier, which multiplies the
+ * screen-space error that it allows. Narrower views around the focus point,
+ * with the full pixel density of the camera, are added to refine the tiles in
+ * the focus region as usual, along with views between them that step the
+ * multiplier up across the falloff.
+ */
+void addFocusViewStates(
+    const FCesiumCamera& camera,
+    const glm::dmat4& unrealWorldToTileset,
+    const Cesium3DTilesSelection::ViewState& view,
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  const double multiplier = camera.PeripheralScreenSpaceErrorMultiplier;
+  if (camera.FocusRadiusDegrees <= 0.0 || multiplier <= 1.0) {
+    views.push_back(view);
+    return;
+  }
+
+  const glm::dvec2& viewportSize = view.getViewportSize();
+  views.push_back(Cesium3DTilesSelection::ViewState::create(
+      view.getPosition(),
+      view.getDirection(),
+      view.getUp(),
+      viewportSize / multiplier,
+      view.getHorizontalFieldOfView(),
+      view.getVerticalFieldOfView(),
+      ellipsoid));
+
+  const double tanHalfHorizontal =
+      glm::tan(view.getHorizontalFieldOfView() * 0.5);
+  const double tanHalfVertical = glm::tan(view.getVerticalFieldOfView() * 0.5);
+
+  // The screen-space error is computed from the pixels per unit of the
+  // tangent of the angle away from the view direction.
+  const double pixelDensity = viewportSize.y / (2.0 * tanHalfVertical);
+
+  const double focusX = 2.0 * camera.FocusPoint.X - 1.0;
+  const double focusY = 1.0 - 2.0 * camera.FocusPoint.Y;
+  const FVector forward = camera.Rotation.RotateVector(FVector::ForwardVector);
+  const FVector right = camera.Rotation.RotateVector(FVector::RightVector);
+  const FVector up = camera.Rotation.RotateVector(FVector::UpVector);
+  const FVector focus = forward + right * (focusX * tanHalfHorizontal) +
+                        up * (focusY * tanHalfVertical);
+
+  const glm::dvec3 focusDirection = glm::normalize(glm::dvec3(
+      unrealWorldToTileset * glm::dvec4(focus.X, focus.Y, focus.Z, 0.0)));
+  glm::dvec3 focusUp =
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0));
+  focusUp = glm::normalize(
+      focusUp - glm::dot(focusUp, focusDirection) * focusDirection);
+
+  constexpr int falloffSteps = 2;
+  const int steps = camera.FocusFalloffDegrees > 0.0 ? falloffSteps : 0;
+  for (int step = 0; step <= steps; ++step) {
+    const double radiusDegrees =
+        camera.FocusRadiusDegrees +
+        (steps > 0 ? camera.FocusFalloffDegrees * step / steps : 0.0);
+    const double halfAngle =
+        FMath::DegreesToRadians(glm::min(radiusDegrees, 89.0));
+    const double stepMultiplier =
+        glm::pow(multiplier, double(step) / double(steps + 1));
+    const double size =
+        pixelDensity * 2.0 * glm::tan(halfAngle) / stepMultiplier;
+
+    views.push_back(Cesium3DTilesSelection::ViewState::create(
+        view.getPosition(),
+        focusDirection,
+        focusUp,
+        glm::dvec2(size, size),
+        halfAngle * 2.0,
+        halfAngle * 2.0,
+        ellipsoid));
+  }
+}
+
+} // namespace
+
 /*static*/ Cesium3DTilesSelection::ViewState
 ACesium3DTileset::CreateViewStateFromViewParameters(
     const FCesiumCamera& camera,
@@ -1607,6 +2697,11 @@ ACesium3DTileset::CreateViewStateFromViewParameters(
   double verticalFieldOfView =
       atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
 
+  // The screen-space error of a tile is proportional to the viewport size.
+  if (camera.ScreenSpaceErrorMultiplier > 0.0) {
+    size /= camera.ScreenSpaceErrorMultiplier;
+  }
+
   FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
   FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
 
@@ -1629,6 +2724,88 @@ ACesium3DTileset::CreateViewStateFromViewParameters(
       ellipsoid->GetNativeEllipsoid());
 }
 
+void ACesium3DTileset::addPrefetchViewStates(
+    const std::vector<FCesiumCamera>& cameras,
+    const glm::dmat4& unrealWorldToTileset,
+    UCesiumEllipsoid* ellipsoid,
+    float deltaTime,
+    std::vector<Cesium3DTilesSelection::ViewState>& viewStates) {
+  std::vector<FVector> previousLocations =
+      std::move(this->_previousCameraLocations);
+  this->_previousCameraLocations.clear();
+
+  if (!this->PrefetchAlongCameraMotion || this->PrefetchTime <= 0.0f) {
+    return;
+  }
+
+  // The cameras are only assumed to be the same as in the previous frame when
+  // there are as many of them.
+  const bool canEstimateVelocity =
+      deltaTime > 0.0f && previousLocations.size() == cameras.size();
+  const double viewportScale =
+      1.0 / glm::max(double(this->PrefetchScreenSpaceErrorMultiplier), 1.0);
+
+  this->_previousCameraLocations.reserve(cameras.size());
+  for (size_t i = 0; i < cameras.size(); ++i) {
+    const FCesiumCamera& camera = cameras[i];
+    this->_previousCameraLocations.push_back(camera.Location);
+
+    FVector velocity = camera.Velocity;
+    if (velocity.IsZero() && canEstimateVelocity) {
+      velocity = (camera.Location - previousLocations[i]) / deltaTime;
+    }
+    if (velocity.IsNearlyZero()) {
+      continue;
+    }
+
+    // A smaller viewport allows a larger screen-space error, so fewer and
+    // coarser tiles are loaded for the predicted view.
+    FCesiumCamera predicted = camera;
+    predicted.Location += velocity * this->PrefetchTime;
+    predicted.ViewportSize *= viewportScale;
+    viewStates.push_back(CreateViewStateFromViewParameters(
+        predicted,
+        unrealWorldToTileset,
+        ellipsoid));
+  }
+}
+
+Cesium3DTilesSelection::ViewUpdateResult ACesium3DTileset::updateViewForMovie(
+    std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+    size_t frameViewCount) {
+  if (viewStates.size() == frameViewCount) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
+    return this->_pTileset->updateViewOffline(viewStates);
+  }
+
+  // Selecting the tiles of the predicted and upcoming views along with this
+  // frame's starts their loads, which continue in the background while this
+  // frame's tiles finish loading and the frame renders, and keeps them from
+  // being unloaded. Only this frame's tiles are then waited for.
+  std::unordered_set<Cesium3DTilesSelection::Tile*> tilesFadingOut;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewForUpcomingFrames)
+    tilesFadingOut =
+        this->_pTileset->updateView(viewStates, 0.0f).tilesFadingOut;
+  }
+
+  viewStates.erase(viewStates.begin() + frameViewCount, viewStates.end());
+  Cesium3DTilesSelection::ViewUpdateResult result;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
+    result = this->_pTileset->updateViewOffline(viewStates);
+  }
+
+  // The tiles that were rendered in the last frame but weren't selected by
+  // the first view update aren't reported by the second, and need to be
+  // hidden too, unless this frame renders them.
+  for (Cesium3DTilesSelection::Tile* pTile : result.tilesToRenderThisFrame) {
+    tilesFadingOut.erase(pTile);
+  }
+  result.tilesFadingOut.insert(tilesFadingOut.begin(), tilesFadingOut.end());
+  return result;
+}
+
 #if WITH_EDITOR
 std::vector<FCesiumCamera> ACesium3DTileset::GetEditorCameras() const {
   if (!GEditor) {
@@ -1710,17 +2887,91 @@ bool ACesium3DTileset::ShouldTickIfViewportsOnly() const {
 
 namespace {
 
-void removeVisibleTilesFromList(
-    std::vector<Cesium3DTilesSelection::Tile*>& list,
-    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles) {
-  if (list.empty()) {
+/**
+ * @brief Stamps the visual representations of the given tiles with the
+ * epoch of the current frame.
+ *
+ * @param tiles The tiles rendered this frame
+ * @param epoch The epoch of the current frame
+ */
+/**
+ * @brief Adds the tiles that are already loaded and best meet the screen-space
+ * error in the given views to the tiles to render, without loading any.
+ *
+ * A tile is replaced by its children when it is not detailed enough for one
+ * of the views and all of its children are loaded, so that no holes appear.
+ * Tiles culled by all views are skipped.
+ */
+void addLoadedTilesToRender(
+    Cesium3DTilesSelection::Tile& tile,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views,
+    double maximumScreenSpaceError,
+    std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    return;
+  }
+
+  bool visible = false;
+  double screenSpaceError = 0.0;
+  for (const Cesium3DTilesSelection::ViewState& view : views) {
+    if (!view.isBoundingVolumeVisible(tile.getBoundingVolume())) {
+      continue;
+    }
+    visible = true;
+    const double distance = glm::sqrt(glm::max(
+        view.computeDistanceSquaredToBoundingVolume(tile.getBoundingVolume()),
+        0.0));
+    screenSpaceError = glm::max(
+        screenSpaceError,
+        view.computeScreenSpaceError(tile.getGeometricError(), distance));
+  }
+  if (!visible) {
     return;
   }
 
-  for (Cesium3DTilesSelection::Tile* pTile : visibleTiles) {
-    auto it = std::find(list.begin(), list.end(), pTile);
-    if (it != list.end()) {
-      list.erase(it);
+  const bool additive =
+      tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
+  bool refine =
+      screenSpaceError > maximumScreenSpaceError && !tile.getChildren().empty();
+  if (refine && !additive) {
+    for (const Cesium3DTilesSelection::Tile& child : tile.getChildren()) {
+      if (child.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+        refine = false;
+        break;
+      }
+    }
+  }
+
+  if ((!refine || additive) && tile.getContent().getRenderContent()) {
+    tiles.push_back(&tile);
+  }
+
+  if (refine) {
+    for (Cesium3DTilesSelection::Tile& child : tile.getChildren()) {
+      addLoadedTilesToRender(child, views, maximumScreenSpaceError, tiles);
+    }
+  }
+}
+
+void markTilesRendered(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    uint64 epoch) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MarkTilesRendered)
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+      continue;
+    }
+
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    if (!pRenderContent) {
+      continue;
+    }
+
+    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (Gltf) {
+      Gltf->MarkRendered(epoch);
     }
   }
 }
@@ -1730,11 +2981,17 @@ void removeVisibleTilesFromList(
  *
  * The visual representations (i.e. the `getRendererResources` of the
  * tiles) are assumed to be `UCesiumGltfComponent` instances that
- * are made invisible by this call.
+ * are made invisible by this call. Tiles that were marked as rendered in
+ * the current epoch are left visible.
  *
  * @param tiles The tiles to hide
+ * @param epoch The epoch of the current frame
+ * @param changes The changes to add the hidden tiles to
  */
-void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+void hideTiles(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    uint64 epoch,
+    CesiumTileStateChanges& changes) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HideTiles)
   for (Cesium3DTilesSelection::Tile* pTile : tiles) {
     if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
@@ -1750,10 +3007,16 @@ void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
 
     UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
         pRenderContent->getRenderResources());
-    if (Gltf && Gltf->IsVisible()) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityFalse)
-      Gltf->SetVisibility(false, true);
-    } else {
+    if (Gltf && Gltf->WasRenderedIn(epoch)) {
+      continue;
+    }
+
+    if (Gltf) {
+      // Requested even if the tile isn't visible, to override a request to
+      // show it that the tileset is still holding back.
+      changes.setVisibility(Gltf, false);
+    }
+    if (!Gltf || !Gltf->IsVisible()) {
       // TODO: why is this happening?
       UE_LOG(
           LogCesium,
@@ -1768,7 +3031,8 @@ void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
  * list. This includes tiles that are fading out.
  */
 void removeCollisionForTiles(
-    const std::unordered_set<Cesium3DTilesSelection::Tile*>& tiles) {
+    const std::unordered_set<Cesium3DTilesSelection::Tile*>& tiles,
+    CesiumTileStateChanges& changes) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RemoveCollisionForTiles)
   for (Cesium3DTilesSelection::Tile* pTile : tiles) {
     if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
@@ -1785,8 +3049,7 @@ void removeCollisionForTiles(
     UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
         pRenderContent->getRenderResources());
     if (Gltf) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
-      Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+      changes.setCollisionEnabled(Gltf, ECollisionEnabled::NoCollision);
     }
   }
 }
@@ -1830,14 +3093,39 @@ void applyActorCollisionSettings(
 void ACesium3DTileset::updateTilesetOptionsFromProperties() {
   Cesium3DTilesSelection::TilesetOptions& options =
       this->_pTileset->getOptions();
+  // A device under thermal or battery pressure renders less detail, on top
+  // of any adjustments of the Cesium Adaptive Lod Component.
   options.maximumScreenSpaceError =
-      static_cast<double>(this->MaximumScreenSpaceError);
+      static_cast<double>(this->MaximumScreenSpaceError) *
+      CesiumStreamingGovernor::getScreenSpaceErrorScale();
   options.maximumCachedBytes = this->MaximumCachedBytes;
   options.preloadAncestors = this->PreloadAncestors;
   options.preloadSiblings = this->PreloadSiblings;
   options.forbidHoles = this->ForbidHoles;
   options.maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
   options.loadingDescendantLimit = this->LoadingDescendantLimit;
+
+  UWorld* pWorld = this->GetWorld();
+  UCesiumTilesetScheduler* pScheduler =
+      pWorld ? pWorld->GetSubsystem<UCesiumTilesetScheduler>() : nullptr;
+  if (pScheduler) {
+    const UCesiumTilesetScheduler::Allocation allocation =
+        pScheduler->allocate(*this);
+    options.maximumCachedBytes = allocation.maximumCachedBytes;
+    options.maximumSimultaneousTileLoads =
+        allocation.maximumSimultaneousTileLoads;
+  }
+
+  // cesium-native only counts the glTF data of the tiles, so its cache is
+  // shrunk by the size of the Unreal resources that it doesn't know about.
+  if (this->IncludeUnrealResourcesInCachedBytes &&
+      this->_pMemoryUsageTracker) {
+    options.maximumCachedBytes = std::max<int64_t>(
+        0,
+        options.maximumCachedBytes -
+            this->_pMemoryUsageTracker->getUnrealOnlyBytes());
+  }
+
   options.enableFrustumCulling = this->EnableFrustumCulling;
   options.enableOcclusionCulling =
       GetDefault<UCesiumRuntimeSettings>()
@@ -1853,12 +3141,79 @@ void ACesium3DTileset::updateTilesetOptionsFromProperties() {
   options.enableLodTransitionPeriod = this->UseLodTransitions;
   options.lodTransitionLength = this->LodTransitionLength;
   // options.kickDescendantsWhileFadingIn = false;
+  options.mainThreadLoadingTimeLimit =
+      CesiumTileFinalizationBudget::getRemainingMilliseconds(this->GetWorld());
+}
+
+CesiumPrimitiveComponentPool& ACesium3DTileset::GetPrimitiveComponentPool() {
+  if (!this->_pPrimitiveComponentPool) {
+    this->_pPrimitiveComponentPool =
+        MakeShared<CesiumPrimitiveComponentPool>(this);
+  }
+  return *this->_pPrimitiveComponentPool;
+}
+
+CesiumMaterialInstanceCache& ACesium3DTileset::GetMaterialInstanceCache() {
+  if (!this->_pMaterialInstanceCache) {
+    this->_pMaterialInstanceCache = MakeShared<CesiumMaterialInstanceCache>();
+  }
+  return *this->_pMaterialInstanceCache;
+}
+
+CesiumInstanceBatches& ACesium3DTileset::GetInstanceBatches() {
+  if (!this->_pInstanceBatches) {
+    this->_pInstanceBatches = MakeShared<CesiumInstanceBatches>(this);
+  }
+  return *this->_pInstanceBatches;
+}
+
+CesiumMemoryUsageTracker& ACesium3DTileset::GetMemoryUsageTracker() {
+  if (!this->_pMemoryUsageTracker) {
+    this->_pMemoryUsageTracker = MakeShared<CesiumMemoryUsageTracker>();
+  }
+  return *this->_pMemoryUsageTracker;
+}
+
+FCesiumMemoryUsage ACesium3DTileset::GetMemoryUsage() const {
+  return this->_pMemoryUsageTracker ? this->_pMemoryUsageTracker->getUsage()
+                                    : FCesiumMemoryUsage();
+}
+
+FCesiumPrimitiveComponentPoolStats
+ACesium3DTileset::GetPrimitiveComponentPoolStats() const {
+  return this->_pPrimitiveComponentPool
+             ? this->_pPrimitiveComponentPool->getStats()
+             : FCesiumPrimitiveComponentPoolStats();
+}
+
+FCesiumTileFinalizationStats
+ACesium3DTileset::GetTileFinalizationStats() const {
+  return CesiumTileFinalizationBudget::getLastFrameStats(this->GetWorld());
 }
 
 void ACesium3DTileset::updateLastViewUpdateResultState(
     const Cesium3DTilesSelection::ViewUpdateResult& result) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateLastViewUpdateResultState)
 
+  CesiumTileFinalizationBudget::addQueueLength(
+      this->GetWorld(),
+      result.mainThreadTileLoadQueueLength);
+  CesiumTrace::traceTileQueues(
+      this,
+      int32(result.workerThreadTileLoadQueueLength),
+      int32(result.mainThreadTileLoadQueueLength),
+      this->_gltfComponentsBeingBuilt.Num());
+
+  const FCesiumMemoryUsage usage = this->GetMemoryUsage();
+  CesiumStats::TilesetStats stats;
+  stats.tilesRendered = int32(result.tilesToRenderThisFrame.size());
+  stats.tilesVisited = int32(result.tilesVisited);
+  stats.workerThreadQueueLength = int32(result.workerThreadTileLoadQueueLength);
+  stats.mainThreadQueueLength = int32(result.mainThreadTileLoadQueueLength);
+  stats.textureBytes = usage.TextureBytes;
+  stats.meshBytes = usage.VertexBytes + usage.IndexBytes;
+  CesiumStats::updateTileset(this, stats);
+
   if (!this->LogSelectionStats) {
     return;
   }
@@ -1911,85 +3266,1457 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
   }
 }
 
-void ACesium3DTileset::showTilesToRender(
-    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
+void ACesium3DTileset::continueIncrementalGltfBuilds() {
+  if (this->_gltfComponentsBeingBuilt.IsEmpty()) {
+    return;
+  }
 
-  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
-    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
-      continue;
-    }
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ContinueIncrementalGltfBuilds)
 
-    // That looks like some reeeally entertaining debug session...:
-    // const Cesium3DTilesSelection::TileID& id = pTile->getTileID();
-    // const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
-    // std::get_if<CesiumGeometry::QuadtreeTileID>(&id); if (!pQuadtreeID ||
-    // pQuadtreeID->level != 14 || pQuadtreeID->x != 5503 || pQuadtreeID->y !=
-    // 11626) { 	continue;
-    //}
+  const UWorld* pWorld = this->GetWorld();
+  CesiumMeshResourceBatch::Scope meshResourceBatch;
 
-    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
-        content.getRenderContent();
-    if (!pRenderContent) {
-      continue;
+  // Work on the oldest builds first so that they finish as soon as possible.
+  using Step = CesiumTileFinalizationBudget::Step;
+  int32 i = 0;
+  CesiumTileFinalizationBudget::runWithinBudget(pWorld, [this, pWorld, &i]() {
+    if (i >= this->_gltfComponentsBeingBuilt.Num()) {
+      return Step::Done;
     }
 
-    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
-        pRenderContent->getRenderResources());
-    if (!Gltf) {
-      // When a tile does not have render resources (i.e. a glTF), then
-      // the resources either have not yet been loaded or prepared,
-      // or the tile is from an external tileset and does not directly
-      // own renderable content. In both cases, the tile is ignored here.
-      continue;
+    UCesiumGltfComponent* pGltf = this->_gltfComponentsBeingBuilt[i].Get();
+    if (!IsValid(pGltf) || pGltf->IsBuildComplete()) {
+      this->_gltfComponentsBeingBuilt.RemoveAt(i);
+      return Step::Skipped;
     }
 
-    applyActorCollisionSettings(BodyInstance, Gltf);
-
-    if (Gltf->GetAttachParent() == nullptr) {
+    double startTime = FPlatformTime::Seconds();
+    bool complete = pGltf->ContinueBuild(
+        CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld));
+    pGltf->LoadMilliseconds += (FPlatformTime::Seconds() - startTime) * 1000.0;
 
-      // The AttachToComponent method is ridiculously complex,
-      // so print a warning if attaching fails for some reason
-      bool attached = Gltf->AttachToComponent(
-          this->RootComponent,
-          FAttachmentTransformRules::KeepRelativeTransform);
-      if (!attached) {
-        FString tileIdString(
-            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
-                pTile->getTileID())
-                .c_str());
-        UE_LOG(
-            LogCesium,
-            Warning,
-            TEXT("Tile %s could not be attached to root"),
-            *tileIdString);
-      }
+    if (complete) {
+      this->_gltfComponentsBeingBuilt.RemoveAt(i);
+      this->finishTileContent(*pGltf);
+    } else {
+      ++i;
     }
+    return Step::Worked;
+  });
+}
 
-    if (!Gltf->IsVisible()) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
-      Gltf->SetVisibility(true, true);
-    }
+void ACesium3DTileset::finishTileContent(UCesiumGltfComponent& gltf) {
+  if (!gltf.TileContentBuildPending) {
+    return;
+  }
+  gltf.TileContentBuildPending = false;
+
+  const CesiumGltf::Model* pModel = gltf.pTileContentModel;
+  gltf.pTileContentModel = nullptr;
+  if (this->_pTileContentBuilder && pModel) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildTileContentInGameThread)
+    this->_pTileContentBuilder->buildInGameThread(
+        *this,
+        gltf,
+        *pModel,
+        MoveTemp(gltf.TileContentBuilderResult));
+  }
+  gltf.TileContentBuilderResult.Reset();
+}
 
-    {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
-      Gltf->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+TSharedPtr<
+    const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+    ESPMode::ThreadSafe>
+ACesium3DTileset::getFeaturesMetadataDescription() const {
+  FScopeLock lock(&this->_featuresMetadataDescriptionLock);
+  return this->_pFeaturesMetadataDescription;
+}
+
+void ACesium3DTileset::updateMetadataEncodedOnDemand() {
+  const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
+      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+  if (pFeaturesMetadataComponent &&
+      pFeaturesMetadataComponent->EncodePropertiesOnDemand &&
+      pFeaturesMetadataComponent->GetUsedPropertiesVersion() !=
+          this->_usedMetadataPropertiesVersion) {
+    this->_usedMetadataPropertiesVersion =
+        pFeaturesMetadataComponent->GetUsedPropertiesVersion();
+
+    TSharedPtr<
+        const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+        ESPMode::ThreadSafe>
+        pCurrent = this->getFeaturesMetadataDescription();
+    if (pCurrent) {
+      FCesiumFeaturesMetadataDescription description =
+          pCurrent->getDescription();
+      description.ModelMetadata.PropertyTables =
+          pFeaturesMetadataComponent->GetPropertyTablesToEncode(
+              {this->Material, this->TranslucentMaterial, this->WaterMaterial});
+      auto pDescription = MakeShared<
+          CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+          ESPMode::ThreadSafe>(MoveTemp(description));
+
+      {
+        FScopeLock lock(&this->_featuresMetadataDescriptionLock);
+        this->_pFeaturesMetadataDescription = pDescription;
+      }
+
+      // The tiles that are already loaded may be missing newly used
+      // properties.
+      TArray<UCesiumGltfComponent*> gltfComponents;
+      this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+      this->_gltfComponentsToEncode.Reset(gltfComponents.Num());
+      for (UCesiumGltfComponent* pGltf : gltfComponents) {
+        this->_gltfComponentsToEncode.Add(pGltf);
+      }
     }
   }
-}
 
-static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn) {
-  if (!pTile || !pTile->getContent().isRenderContent()) {
+  if (this->_gltfComponentsToEncode.IsEmpty()) {
     return;
   }
 
-  if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+  TSharedPtr<
+      const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+      ESPMode::ThreadSafe>
+      pDescription = this->getFeaturesMetadataDescription();
+  if (!pDescription) {
+    this->_gltfComponentsToEncode.Empty();
     return;
   }
 
-  const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
-  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateMetadataEncodedOnDemand)
+
+  const UWorld* pWorld = this->GetWorld();
+
+  using Step = CesiumTileFinalizationBudget::Step;
+  const TArray<FCesiumPropertyTableDescription>& propertyTables =
+      pDescription->getDescription().ModelMetadata.PropertyTables;
+  CesiumTileFinalizationBudget::runWithinBudget(
+      pWorld,
+      [this, &propertyTables]() {
+        if (this->_gltfComponentsToEncode.IsEmpty()) {
+          return Step::Done;
+        }
+
+        UCesiumGltfComponent* pGltf =
+            this->_gltfComponentsToEncode.Pop().Get();
+        return IsValid(pGltf) && pGltf->EncodeMissingProperties(propertyTables)
+                   ? Step::Worked
+                   : Step::Skipped;
+      });
+}
+
+void ACesium3DTileset::updateTileCostHeatmap() {
+  const ECesiumTileCostMetric metric = this->DebugTileCostMetric;
+  if (metric == ECesiumTileCostMetric::None &&
+      this->_tileCostMetric == ECesiumTileCostMetric::None) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileCostHeatmap)
+
+  this->_tileCostMetric = metric;
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+  if (metric == ECesiumTileCostMetric::None) {
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      pGltf->SetDebugColor(std::nullopt);
+    }
+    return;
+  }
+
+  const CesiumMemoryUsageTracker& tracker = this->GetMemoryUsageTracker();
+  TArray<double> costs;
+  costs.Reserve(gltfComponents.Num());
+  double maximum = this->DebugTileCostMaximum;
+  const bool automaticMaximum = maximum <= 0.0;
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    const double cost = pGltf->GetTileCost(metric, tracker);
+    costs.Add(cost);
+    if (automaticMaximum) {
+      maximum = FMath::Max(maximum, cost);
+    }
+  }
+
+  for (int32 i = 0; i < gltfComponents.Num(); ++i) {
+    UCesiumGltfComponent* pGltf = gltfComponents[i];
+    if (!pGltf->IsBuildComplete()) {
+      // It's colored once all of its primitives have been created.
+      continue;
+    }
+
+    // Quantize the colors, so that the materials are only updated when a
+    // tile's cost, or the maximum, changes noticeably.
+    const float fraction =
+        maximum > 0.0 ? float(FMath::Clamp(costs[i] / maximum, 0.0, 1.0))
+                      : 0.0f;
+    const float quantized = FMath::RoundToFloat(fraction * 32.0f) / 32.0f;
+
+    // Hue goes from blue, for the cheapest tiles, through green and yellow to
+    // red, for the most expensive.
+    pGltf->SetDebugColor(
+        FLinearColor((1.0f - quantized) * 240.0f, 1.0f, 1.0f)
+            .HSVToLinearRGB());
+  }
+}
+
+void ACesium3DTileset::updateFeatureStyle() {
+  const UCesiumFeaturesMetadataComponent* pFeaturesMetadataComponent =
+      this->FindComponentByClass<UCesiumFeaturesMetadataComponent>();
+  if (pFeaturesMetadataComponent &&
+      pFeaturesMetadataComponent->GetStyleVersion() !=
+          this->_featureStyleVersion) {
+    this->_featureStyleVersion = pFeaturesMetadataComponent->GetStyleVersion();
+
+    TSharedRef<const CesiumCompiledFeatureStyle> pStyle =
+        CesiumCompiledFeatureStyle::compile(pFeaturesMetadataComponent->Style);
+
+    // An empty style still needs to be applied to replace a previous one, so
+    // that all features are shown in white again.
+    if (!pStyle->isEmpty() || this->_pFeatureStyle) {
+      this->_pFeatureStyle = pStyle;
+
+      TArray<UCesiumGltfComponent*> gltfComponents;
+      this->GetComponents<UCesiumGltfComponent>(gltfComponents);
+      this->_gltfComponentsToStyle.Reset(gltfComponents.Num());
+      for (UCesiumGltfComponent* pGltf : gltfComponents) {
+        this->_gltfComponentsToStyle.Add(pGltf);
+      }
+    }
+  }
+
+  if (this->_gltfComponentsToStyle.IsEmpty()) {
+    return;
+  }
+
+  if (!this->_pFeatureStyle) {
+    this->_gltfComponentsToStyle.Empty();
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateFeatureStyle)
+
+  const UWorld* pWorld = this->GetWorld();
+
+  using Step = CesiumTileFinalizationBudget::Step;
+  CesiumTileFinalizationBudget::runWithinBudget(pWorld, [this]() {
+    if (this->_gltfComponentsToStyle.IsEmpty()) {
+      return Step::Done;
+    }
+
+    UCesiumGltfComponent* pGltf = this->_gltfComponentsToStyle.Pop().Get();
+    return IsValid(pGltf) && pGltf->ApplyFeatureStyle(*this->_pFeatureStyle)
+               ? Step::Worked
+               : Step::Skipped;
+  });
+}
+
+namespace {
+
+// Primitives get physics meshes within the Physics Mesh Radius of a focus
+// actor, but only lose them beyond this multiple of it, so that the physics
+// mesh of a primitive at the edge of the radius isn't built and removed over
+// and over as the actor moves.
+constexpr double PhysicsMeshEvictionRadiusScale = 1.25;
+
+void removePhysicsMesh(
+    UStaticMeshComponent& mesh,
+    CesiumPrimitiveData& primitiveData) {
+  UBodySetup* pBodySetup = mesh.GetBodySetup();
+  if (pBodySetup && CesiumPhysicsMeshes::hasMeshes(*pBodySetup)) {
+    CesiumPhysicsMeshes::removeMeshes(*pBodySetup);
+    mesh.RecreatePhysicsState();
+    // Navigation data is built from the physics mesh.
+    if (mesh.CanEverAffectNavigation()) {
+      FNavigationSystem::UpdateComponentData(mesh);
+    }
+  }
+
+  primitiveData.PhysicsMeshState = CesiumPhysicsMeshes::OnDemandState::None;
+  ++primitiveData.PhysicsMeshBuild;
+}
+
+void buildOnDemandPhysicsMesh(
+    UStaticMeshComponent& mesh,
+    CesiumPrimitiveData& primitiveData,
+    double simplificationError) {
+  // The triangles are copied now, because the glTF may be unloaded before the
+  // worker thread gets to them.
+  TArray<FVector3f> positions;
+  TArray<uint32> indices;
+  if (!CesiumPhysicsMeshes::copyTriangles(primitiveData, positions, indices)) {
+    primitiveData.PhysicsMeshState =
+        CesiumPhysicsMeshes::OnDemandState::Unavailable;
+    return;
+  }
+
+  primitiveData.PhysicsMeshState =
+      CesiumPhysicsMeshes::OnDemandState::Building;
+  const uint32 build = ++primitiveData.PhysicsMeshBuild;
+  TWeakObjectPtr<UStaticMeshComponent> pWeakMesh(&mesh);
+
+  getAsyncSystem()
+      .runInWorkerThread([positions = MoveTemp(positions),
+                          indices = MoveTemp(indices),
+                          simplificationError]() {
+        return CesiumPhysicsMeshCache::getOrBuild(
+            positions,
+            indices,
+            simplificationError);
+      })
+      .thenInMainThread([pWeakMesh, build](
+                            CesiumPhysicsMeshes::MeshPointer&& pMesh) {
+        UStaticMeshComponent* pComponent = pWeakMesh.Get();
+        ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pComponent);
+        if (!IsValid(pComponent) || !pPrimitive) {
+          return;
+        }
+
+        // The physics mesh is no longer wanted if it was removed, or the
+        // component was reused for another primitive, in the meantime.
+        CesiumPrimitiveData& data = pPrimitive->getPrimitiveData();
+        if (data.PhysicsMeshBuild != build ||
+            data.PhysicsMeshState !=
+                CesiumPhysicsMeshes::OnDemandState::Building) {
+          return;
+        }
+
+        UBodySetup* pBodySetup = pComponent->GetBodySetup();
+        if (!pMesh || !pBodySetup) {
+          data.PhysicsMeshState =
+              CesiumPhysicsMeshes::OnDemandState::Unavailable;
+          return;
+        }
+
+        CesiumPhysicsMeshes::addMesh(*pBodySetup, pMesh);
+        data.PhysicsMeshState = CesiumPhysicsMeshes::OnDemandState::Added;
+        pComponent->RecreatePhysicsState();
+        if (pComponent->CanEverAffectNavigation()) {
+          FNavigationSystem::UpdateComponentData(*pComponent);
+        }
+      });
+}
+
+} // namespace
+
+void ACesium3DTileset::updatePhysicsMeshesOnDemand() {
+  if (!this->CreatePhysicsMeshes || !this->CreatePhysicsMeshesOnDemand) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdatePhysicsMeshesOnDemand)
+
+  // The bounding spheres of the focus actors, not yet extended by the radius.
+  TArray<FSphere, TInlineAllocator<8>> focusSpheres;
+  for (AActor* pActor : this->PhysicsMeshFocusActors) {
+    if (!IsValid(pActor)) {
+      continue;
+    }
+
+    FVector origin;
+    FVector extent;
+    pActor->GetActorBounds(false, origin, extent);
+    focusSpheres.Emplace(origin, extent.Size());
+  }
+
+  for (USceneComponent* pChild : this->RootComponent->GetAttachChildren()) {
+    UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pChild);
+    if (!pGltf) {
+      continue;
+    }
+
+    // Hidden tiles have their collision disabled, so they don't need physics
+    // meshes.
+    const bool isVisible = pGltf->IsVisible();
+
+    for (USceneComponent* pGltfChild : pGltf->GetAttachChildren()) {
+      UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pGltfChild);
+      ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pGltfChild);
+      if (!pMesh || !pPrimitive) {
+        continue;
+      }
+
+      CesiumPrimitiveData& primitiveData = pPrimitive->getPrimitiveData();
+      const CesiumPhysicsMeshes::OnDemandState state =
+          primitiveData.PhysicsMeshState;
+      if (state == CesiumPhysicsMeshes::OnDemandState::Unavailable) {
+        continue;
+      }
+
+      const bool isWanted = state != CesiumPhysicsMeshes::OnDemandState::None;
+      const double radius =
+          isWanted ? this->PhysicsMeshRadius * PhysicsMeshEvictionRadiusScale
+                   : this->PhysicsMeshRadius;
+      const FBox bounds = pMesh->Bounds.GetBox();
+
+      bool isInRange = false;
+      for (int32 i = 0; isVisible && !isInRange && i < focusSpheres.Num();
+           ++i) {
+        const FSphere& sphere = focusSpheres[i];
+        const double distance = sphere.W + radius;
+        isInRange = bounds.ComputeSquaredDistanceToPoint(sphere.Center) <=
+                    distance * distance;
+      }
+
+      if (isInRange && !isWanted) {
+        buildOnDemandPhysicsMesh(
+            *pMesh,
+            primitiveData,
+            this->PhysicsMeshSimplificationError);
+      } else if (!isInRange && isWanted) {
+        removePhysicsMesh(*pMesh, primitiveData);
+      }
+    }
+  }
+}
+
+void ACesium3DTileset::updatePhysicsMeshesInPlace() {
+  if (!this->_physicsMeshesChanged) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdatePhysicsMeshesInPlace)
+
+  // The physics meshes that are created on demand are added by
+  // updatePhysicsMeshesOnDemand instead.
+  const bool buildMissing =
+      this->CreatePhysicsMeshes && !this->CreatePhysicsMeshesOnDemand;
+
+  TInlineComponentArray<UCesiumGltfComponent*> gltfComponents(this);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    for (USceneComponent* pGltfChild : pGltf->GetAttachChildren()) {
+      UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pGltfChild);
+      ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pGltfChild);
+      UBodySetup* pBodySetup = pMesh ? pMesh->GetBodySetup() : nullptr;
+      if (!pBodySetup || !pPrimitive) {
+        continue;
+      }
+
+      CesiumPrimitiveData& primitiveData = pPrimitive->getPrimitiveData();
+      const bool hasMeshes = CesiumPhysicsMeshes::hasMeshes(*pBodySetup);
+      if (!this->CreatePhysicsMeshes) {
+        if (hasMeshes || primitiveData.PhysicsMeshState !=
+                             CesiumPhysicsMeshes::OnDemandState::None) {
+          removePhysicsMesh(*pMesh, primitiveData);
+        }
+      } else if (
+          buildMissing && !hasMeshes &&
+          primitiveData.PhysicsMeshState ==
+              CesiumPhysicsMeshes::OnDemandState::None) {
+        buildOnDemandPhysicsMesh(
+            *pMesh,
+            primitiveData,
+            this->PhysicsMeshSimplificationError);
+      }
+    }
+  }
+
+  if (!this->_pTileset || (this->_pTileset->computeLoadProgress() >= 100.0f &&
+                           this->_gltfComponentsBeingBuilt.IsEmpty())) {
+    this->_physicsMeshesChanged = false;
+  }
+}
+
+bool ACesium3DTileset::updateMaterialsInPlace() {
+  if (this->_pInstanceBatches &&
+      this->_pInstanceBatches->getBatchCount() > 0) {
+    return false;
+  }
+
+  const UCesiumGltfComponent* pDefaults = GetDefault<UCesiumGltfComponent>();
+  UMaterialInterface* pMaterial =
+      this->Material ? this->Material : pDefaults->BaseMaterial;
+  UMaterialInterface* pTranslucentMaterial =
+      this->TranslucentMaterial ? this->TranslucentMaterial
+                                : pDefaults->BaseMaterialWithTranslucency;
+  UMaterialInterface* pWaterMaterial =
+      this->WaterMaterial ? this->WaterMaterial
+                          : pDefaults->BaseMaterialWithWater;
+
+  // Nothing is changed unless all of the tiles can keep their parameters.
+  TInlineComponentArray<UCesiumGltfComponent*> gltfComponents(this);
+  for (const UCesiumGltfComponent* pGltf : gltfComponents) {
+    if (!UCesiumGltfComponent::HaveSameMaterialLayers(
+            pGltf->BaseMaterial,
+            pMaterial) ||
+        !UCesiumGltfComponent::HaveSameMaterialLayers(
+            pGltf->BaseMaterialWithTranslucency,
+            pTranslucentMaterial) ||
+        !UCesiumGltfComponent::HaveSameMaterialLayers(
+            pGltf->BaseMaterialWithWater,
+            pWaterMaterial)) {
+      return false;
+    }
+  }
+
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->SetBaseMaterials(
+        this->Material,
+        this->TranslucentMaterial,
+        this->WaterMaterial);
+  }
+
+  // The templates of the replaced materials won't be used again.
+  if (this->_pMaterialInstanceCache) {
+    this->_pMaterialInstanceCache->clear();
+  }
+
+  return true;
+}
+
+void ACesium3DTileset::updateCustomDepthInPlace() {
+  TInlineComponentArray<UCesiumGltfComponent*> gltfComponents(this);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->SetCustomDepthParameters(
+        this->CustomDepthParameters,
+        this->PointCloudShading.EyeDomeLighting);
+  }
+
+  if (this->_pInstanceBatches) {
+    this->_pInstanceBatches->setCustomDepthParameters(
+        this->CustomDepthParameters);
+  }
+}
+
+void ACesium3DTileset::updateNavigationRelevance() {
+  if (!this->IsNavigationManaged()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateNavigationRelevance)
+
+  // The invokers are also used to decide which changes to make first.
+  TArray<FSphere, TInlineAllocator<8>> invokerSpheres;
+  const UNavigationSystemV1* pNavigationSystem =
+      FNavigationSystem::GetCurrent<UNavigationSystemV1>(this->GetWorld());
+  if (pNavigationSystem) {
+    for (const FNavigationInvokerRaw& invoker :
+         pNavigationSystem->GetInvokerLocations()) {
+      invokerSpheres.Emplace(invoker.Location, invoker.RadiusMax);
+    }
+  }
+
+  struct NavigationChange {
+    UStaticMeshComponent* pMesh;
+    bool affectsNavigation;
+    double priority;
+  };
+  TArray<NavigationChange> changes;
+
+  for (USceneComponent* pChild : this->RootComponent->GetAttachChildren()) {
+    UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pChild);
+    if (!pGltf) {
+      continue;
+    }
+
+    const bool isVisible = pGltf->IsVisible();
+
+    for (USceneComponent* pGltfChild : pGltf->GetAttachChildren()) {
+      UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pGltfChild);
+      if (!pMesh || !Cast<ICesiumPrimitive>(pGltfChild)) {
+        continue;
+      }
+
+      const FBox bounds = pMesh->Bounds.GetBox();
+      double distanceSquared = TNumericLimits<double>::Max();
+      bool isInRange = !this->RestrictNavigationToInvokers;
+      for (const FSphere& sphere : invokerSpheres) {
+        const double invokerDistanceSquared =
+            bounds.ComputeSquaredDistanceToPoint(sphere.Center);
+        distanceSquared = FMath::Min(distanceSquared, invokerDistanceSquared);
+        isInRange |= invokerDistanceSquared <= sphere.W * sphere.W;
+      }
+
+      const bool affectsNavigation = isVisible && isInRange;
+      if (affectsNavigation != pMesh->CanEverAffectNavigation()) {
+        // Meshes that stop affecting navigation go first, so that the
+        // navigation data doesn't keep tiles that are no longer shown.
+        changes.Add(
+            {pMesh,
+             affectsNavigation,
+             affectsNavigation ? distanceSquared : -1.0});
+      }
+    }
+  }
+
+  if (this->MaximumNavigationUpdatesPerFrame > 0 &&
+      changes.Num() > this->MaximumNavigationUpdatesPerFrame) {
+    changes.Sort([](const NavigationChange& a, const NavigationChange& b) {
+      return a.priority < b.priority;
+    });
+    changes.SetNum(this->MaximumNavigationUpdatesPerFrame);
+  }
+
+  // The navigation system collects the areas that are marked dirty by these
+  // changes in this frame, and rebuilds them together.
+  for (const NavigationChange& change : changes) {
+    change.pMesh->SetCanEverAffectNavigation(change.affectsNavigation);
+  }
+}
+
+TArray<FVector> ACesium3DTileset::getCollisionPriorityLocations() const {
+  TArray<FVector> locations;
+  for (AActor* pActor : this->PhysicsMeshFocusActors) {
+    if (IsValid(pActor)) {
+      locations.Add(pActor->GetActorLocation());
+    }
+  }
+
+  const UWorld* pWorld = this->GetWorld();
+  if (!locations.IsEmpty() || !pWorld) {
+    return locations;
+  }
+
+  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+       playerControllerIt;
+       ++playerControllerIt) {
+    const APlayerController* pPlayerController = playerControllerIt->Get();
+    if (!pPlayerController) {
+      continue;
+    }
+
+    const APawn* pPawn = pPlayerController->GetPawn();
+    if (pPawn) {
+      locations.Add(pPawn->GetActorLocation());
+    } else if (pPlayerController->PlayerCameraManager) {
+      locations.Add(
+          pPlayerController->PlayerCameraManager->GetCameraLocation());
+    }
+  }
+
+  return locations;
+}
+
+void ACesium3DTileset::commitTileStateChanges(
+    CesiumTileStateChanges& changes) {
+  if (this->MaximumCollisionUpdatesPerFrame <= 0) {
+    this->_deferredCollisionUpdates = changes.commit();
+    return;
+  }
+
+  const TArray<FVector> priorityLocations =
+      this->getCollisionPriorityLocations();
+  // The tiles left without collision are shown again next frame, and so
+  // requested again.
+  this->_deferredCollisionUpdates =
+      changes.commit(this->MaximumCollisionUpdatesPerFrame, priorityLocations);
+}
+
+namespace {
+
+// The heights above and below the ellipsoid, in meters, between which heights
+// are sampled.
+constexpr double MaximumSampledHeight = 100000.0;
+constexpr double MinimumSampledHeight = -100000.0;
+
+/**
+ * A primitive that lines can be traced against, gathered on the game thread so
+ * that the traces can run on other threads.
+ */
+struct TraceTarget {
+  TSharedPtr<const CesiumTriangleBVH> pTraceMesh;
+  FTransform transform;
+  FBox bounds;
+  UPrimitiveComponent* pComponent;
+};
+
+void gatherTraceTargets(
+    const USceneComponent& root,
+    TArray<TraceTarget>& targets) {
+  for (USceneComponent* pChild : root.GetAttachChildren()) {
+    UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pChild);
+    if (!pGltf || !pGltf->IsVisible()) {
+      continue;
+    }
+
+    for (USceneComponent* pGltfChild : pGltf->GetAttachChildren()) {
+      UPrimitiveComponent* pComponent = Cast<UPrimitiveComponent>(pGltfChild);
+      ICesiumPrimitive* pPrimitive = Cast<ICesiumPrimitive>(pGltfChild);
+      if (!pComponent || !pPrimitive || !pComponent->IsVisible()) {
+        continue;
+      }
+
+      const CesiumPrimitiveData& data = pPrimitive->getPrimitiveData();
+      if (data.pTraceMesh) {
+        targets.Add(
+            {data.pTraceMesh,
+             pComponent->GetComponentTransform(),
+             pComponent->Bounds.GetBox(),
+             pComponent});
+      }
+    }
+  }
+}
+
+/**
+ * The first hit of a line against one trace target.
+ */
+struct TargetHit {
+  int32 line;
+  CesiumTriangleBVH::Hit hit;
+};
+
+/**
+ * Traces lines against the trace targets. The lines are grouped by the
+ * targets whose bounds they cross, and the targets are traced against in
+ * parallel.
+ *
+ * @returns The number of lines that hit a target.
+ */
+int32 traceLines(
+    TArrayView<const TraceTarget> targets,
+    TArrayView<const FVector> starts,
+    TArrayView<const FVector> ends,
+    TArray<FHitResult>& hits) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TraceTiles)
+
+  const int32 lineCount = FMath::Min(starts.Num(), ends.Num());
+  TArray<TArray<TargetHit>> targetHits;
+  targetHits.SetNum(targets.Num());
+  ParallelFor(targets.Num(), [&](int32 i) {
+    const TraceTarget& target = targets[i];
+    for (int32 line = 0; line < lineCount; ++line) {
+      const FVector& start = starts[line];
+      const FVector& end = ends[line];
+      CesiumTriangleBVH::Hit hit;
+      if (FMath::LineBoxIntersection(target.bounds, start, end, end - start) &&
+          target.pTraceMesh->lineTrace(
+              target.transform.InverseTransformPosition(start),
+              target.transform.InverseTransformPosition(end),
+              hit)) {
+        targetHits[i].Add({line, hit});
+      }
+    }
+  });
+
+  TArray<int32> hitTargets;
+  hitTargets.Init(-1, lineCount);
+  TArray<const CesiumTriangleBVH::Hit*> firstHits;
+  firstHits.Init(nullptr, lineCount);
+  for (int32 i = 0; i < targets.Num(); ++i) {
+    for (const TargetHit& targetHit : targetHits[i]) {
+      const CesiumTriangleBVH::Hit*& pFirstHit = firstHits[targetHit.line];
+      if (!pFirstHit || targetHit.hit.time < pFirstHit->time) {
+        pFirstHit = &targetHit.hit;
+        hitTargets[targetHit.line] = i;
+      }
+    }
+  }
+
+  hits.SetNum(lineCount);
+  int32 hitCount = 0;
+  for (int32 line = 0; line < lineCount; ++line) {
+    const FVector& start = starts[line];
+    const FVector& end = ends[line];
+    const CesiumTriangleBVH::Hit* pFirstHit = firstHits[line];
+    if (!pFirstHit) {
+      hits[line] = FHitResult(start, end);
+      continue;
+    }
+
+    const TraceTarget& target = targets[hitTargets[line]];
+
+    // Normals are transformed by the inverse transpose of the transform.
+    FVector normal = target.transform
+                         .TransformVectorNoScale(
+                             pFirstHit->normal / target.transform.GetScale3D())
+                         .GetSafeNormal();
+    if (FVector::DotProduct(normal, end - start) > 0.0) {
+      normal = -normal;
+    }
+
+    const FVector location = FMath::Lerp(start, end, pFirstHit->time);
+    FHitResult& hit = hits[line];
+    hit = FHitResult(
+        target.pComponent->GetOwner(),
+        target.pComponent,
+        location,
+        normal);
+    hit.bBlockingHit = true;
+    hit.TraceStart = start;
+    hit.TraceEnd = end;
+    hit.Time = float(pFirstHit->time);
+    hit.Distance = float(FVector::Distance(start, location));
+    hit.FaceIndex = pFirstHit->triangleIndex;
+    ++hitCount;
+  }
+  return hitCount;
+}
+
+} // namespace
+
+bool ACesium3DTileset::LineTraceTiles(
+    const FVector& Start,
+    const FVector& End,
+    FHitResult& OutHit) const {
+  TArray<FHitResult> hits;
+  const bool isHit = this->LineTraceTilesBatch({Start}, {End}, hits) > 0;
+  OutHit = hits[0];
+  return isHit;
+}
+
+int32 ACesium3DTileset::LineTraceTilesBatch(
+    const TArray<FVector>& Starts,
+    const TArray<FVector>& Ends,
+    TArray<FHitResult>& OutHits) const {
+  if (Starts.Num() != Ends.Num()) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("LineTraceTilesBatch was given %d starts but %d ends."),
+        Starts.Num(),
+        Ends.Num());
+  }
+
+  TArray<TraceTarget> targets;
+  if (this->RootComponent) {
+    gatherTraceTargets(*this->RootComponent, targets);
+  }
+  return traceLines(targets, Starts, Ends, OutHits);
+}
+
+bool ACesium3DTileset::LineTraceTilesFromScreenPosition(
+    const APlayerController* PlayerController,
+    const FVector2D& ScreenPosition,
+    FHitResult& OutHit,
+    double TraceDistance) const {
+  FVector start;
+  FVector direction;
+  if (!PlayerController ||
+      !UGameplayStatics::DeprojectScreenToWorld(
+          PlayerController,
+          ScreenPosition,
+          start,
+          direction)) {
+    OutHit = FHitResult();
+    return false;
+  }
+
+  return this->LineTraceTiles(start, start + direction * TraceDistance, OutHit);
+}
+
+bool ACesium3DTileset::SampleHeightMostDetailed(
+    const FVector& LongitudeLatitudeHeight,
+    FVector& OutLongitudeLatitudeHeight) {
+  TArray<FVector> positions;
+  TArray<bool> success;
+  this->SampleHeightMostDetailedBatch(
+      {LongitudeLatitudeHeight},
+      positions,
+      success);
+  OutLongitudeLatitudeHeight = positions[0];
+  return success[0];
+}
+
+int32 ACesium3DTileset::SampleHeightMostDetailedBatch(
+    const TArray<FVector>& LongitudeLatitudeHeights,
+    TArray<FVector>& OutLongitudeLatitudeHeights,
+    TArray<bool>& OutSampleSuccess) {
+  OutLongitudeLatitudeHeights = LongitudeLatitudeHeights;
+  OutSampleSuccess.Init(false, LongitudeLatitudeHeights.Num());
+
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  if (!pGeoreference) {
+    return 0;
+  }
+
+  // The georeference transforms to and from the frame of the tileset actor.
+  const FTransform& actorTransform = this->GetActorTransform();
+  TArray<FVector> starts;
+  TArray<FVector> ends;
+  starts.SetNumUninitialized(LongitudeLatitudeHeights.Num());
+  ends.SetNumUninitialized(LongitudeLatitudeHeights.Num());
+  for (int32 i = 0; i < LongitudeLatitudeHeights.Num(); ++i) {
+    const FVector& position = LongitudeLatitudeHeights[i];
+    starts[i] = actorTransform.TransformPosition(
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            FVector(position.X, position.Y, MaximumSampledHeight)));
+    ends[i] = actorTransform.TransformPosition(
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            FVector(position.X, position.Y, MinimumSampledHeight)));
+  }
+
+  TArray<FHitResult> hits;
+  const int32 hitCount = this->LineTraceTilesBatch(starts, ends, hits);
+
+  for (int32 i = 0; i < hits.Num(); ++i) {
+    if (!hits[i].bBlockingHit) {
+      continue;
+    }
+
+    const FVector hitPosition =
+        pGeoreference->TransformUnrealPositionToLongitudeLatitudeHeight(
+            actorTransform.InverseTransformPosition(hits[i].ImpactPoint));
+    OutLongitudeLatitudeHeights[i].Z = hitPosition.Z;
+    OutSampleSuccess[i] = true;
+  }
+
+  return hitCount;
+}
+
+/**
+ * A SampleHeightMostDetailedAsync query that waits for the tiles seen by its
+ * views to load.
+ */
+struct CesiumSampleHeightQuery {
+  CesiumAsync::Promise<TArray<FCesiumSampleHeightResult>> promise;
+  TArray<FVector> positions;
+  TArray<int32> cameraIds;
+  int32 frames = 0;
+};
+
+namespace {
+
+// The views of height queries cover a square footprint twice their height
+// wide, so a cell as wide as their height is seen with a generous margin.
+constexpr double SampleHeightViewFieldOfViewDegrees = 90.0;
+const FVector2D SampleHeightViewViewportSize(1024.0, 1024.0);
+
+// Load progress is only meaningful once the tileset has ticked with the new
+// views, so it is checked after this many frames.
+constexpr int32 MinimumSampleHeightQueryFrames = 2;
+
+} // namespace
+
+CesiumAsync::Future<TArray<FCesiumSampleHeightResult>>
+ACesium3DTileset::SampleHeightMostDetailedAsync(
+    const TArray<FVector>& LongitudeLatitudeHeights,
+    double LoadTilesFromHeight) {
+  if (!this->CreateTraceMeshes) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "Heights of %s can't be sampled, because Create Trace Meshes isn't set."),
+        *this->GetName());
+  }
+
+  ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
+  ACesiumCameraManager* pCameraManager = this->ResolveCameraManager();
+  if (LoadTilesFromHeight <= 0.0 || !this->CreateTraceMeshes ||
+      !pGeoreference || !pCameraManager) {
+    TArray<FVector> positions;
+    TArray<bool> success;
+    this->SampleHeightMostDetailedBatch(
+        LongitudeLatitudeHeights,
+        positions,
+        success);
+
+    TArray<FCesiumSampleHeightResult> result;
+    result.SetNum(positions.Num());
+    for (int32 i = 0; i < result.Num(); ++i) {
+      result[i].LongitudeLatitudeHeight = positions[i];
+      result[i].SampleSuccess = success[i];
+    }
+    return getAsyncSystem().createResolvedFuture(MoveTemp(result));
+  }
+
+  TSharedPtr<CesiumSampleHeightQuery> pQuery =
+      MakeShared<CesiumSampleHeightQuery>(CesiumSampleHeightQuery{
+          getAsyncSystem()
+              .createPromise<TArray<FCesiumSampleHeightResult>>(),
+          LongitudeLatitudeHeights});
+
+  // The positions are grouped into cells as wide as the view height, and one
+  // view looks down at the center of each cell that has positions.
+  const double spacingLatitude =
+      LoadTilesFromHeight /
+      pGeoreference->GetEllipsoid()->GetNativeEllipsoid().getMaximumRadius();
+  TSet<FIntPoint> cells;
+  for (const FVector& position : LongitudeLatitudeHeights) {
+    const int32 row = FMath::FloorToInt(
+        FMath::DegreesToRadians(position.Y) / spacingLatitude);
+    const double latitude = (row + 0.5) * spacingLatitude;
+    const double spacingLongitude =
+        spacingLatitude / FMath::Max(std::cos(latitude), 0.01);
+    const int32 column = FMath::FloorToInt(
+        FMath::DegreesToRadians(position.X) / spacingLongitude);
+
+    bool isAlreadyInSet = false;
+    cells.Add(FIntPoint(column, row), &isAlreadyInSet);
+    if (isAlreadyInSet) {
+      continue;
+    }
+
+    const FVector location =
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(FVector(
+            FMath::RadiansToDegrees((column + 0.5) * spacingLongitude),
+            FMath::RadiansToDegrees(latitude),
+            LoadTilesFromHeight));
+    const FRotator rotation =
+        pGeoreference->TransformEastSouthUpRotatorToUnreal(
+            FRotator(-90.0, 0.0, 0.0),
+            location);
+    FCesiumCamera camera(
+        SampleHeightViewViewportSize,
+        location,
+        rotation,
+        SampleHeightViewFieldOfViewDegrees);
+    pQuery->cameraIds.Add(pCameraManager->AddCamera(camera));
+  }
+
+  this->_sampleHeightQueries.Add(pQuery);
+  return pQuery->promise.getFuture();
+}
+
+void ACesium3DTileset::updateEyeDomeLighting() {
+  if (!this->_cesiumViewExtension) {
+    return;
+  }
+
+  const UWorld* pWorld = this->GetWorld();
+  const bool enabled = this->PointCloudShading.EyeDomeLighting &&
+                       !this->IsHidden() && pWorld != nullptr;
+  this->_cesiumViewExtension->SetEyeDomeLighting(
+      this,
+      enabled ? pWorld->Scene : nullptr,
+      enabled ? this->PointCloudShading.EyeDomeLightingStrength : 0.0f,
+      this->PointCloudShading.EyeDomeLightingRadius);
+}
+
+void ACesium3DTileset::updateVoxelRendering() {
+  TArray<UCesiumGltfVoxelComponent*> voxelComponents;
+  this->GetComponents<UCesiumGltfVoxelComponent>(voxelComponents);
+  for (UCesiumGltfVoxelComponent* pVoxelComponent : voxelComponents) {
+    pVoxelComponent->MarkRenderStateDirty();
+  }
+}
+
+void ACesium3DTileset::updateOcclusion() {
+  if (!this->_pOcclusionPool || !this->_cesiumViewExtension) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateOcclusion)
+
+  const UWorld* pWorld = this->GetWorld();
+  const glm::dmat4 tilesetToUnrealWorld =
+      VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale()) *
+      this->GetCesiumTilesetToUnrealRelativeWorldTransform();
+  const double startTime = FPlatformTime::Seconds();
+  this->_pOcclusionPool->update(
+      *this->_cesiumViewExtension,
+      this,
+      pWorld && !this->IsHidden() ? pWorld->Scene : nullptr,
+      tilesetToUnrealWorld);
+  UCesiumTilesetStatistics::RecordStage(
+      ECesiumTileLoadStage::OcclusionUpdate,
+      (FPlatformTime::Seconds() - startTime) * 1000.0);
+}
+
+void ACesium3DTileset::updateSampleHeightQueries() {
+  if (this->_sampleHeightQueries.IsEmpty()) {
+    return;
+  }
+
+  // The tileset loads the tiles for the views of all queries together, so
+  // they are all resolved once it has finished loading.
+  bool isLoaded = this->GetLoadProgress() >= 100.0f;
+  for (const TSharedPtr<CesiumSampleHeightQuery>& pQuery :
+       this->_sampleHeightQueries) {
+    isLoaded &= ++pQuery->frames >= MinimumSampleHeightQueryFrames;
+  }
+
+  if (isLoaded) {
+    this->finishSampleHeightQueries();
+  }
+}
+
+void ACesium3DTileset::finishSampleHeightQueries() {
+  if (this->_sampleHeightQueries.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FinishSampleHeightQueries)
+
+  // The positions of all queries are sampled together, so that they are
+  // traced in parallel.
+  TArray<FVector> positions;
+  for (const TSharedPtr<CesiumSampleHeightQuery>& pQuery :
+       this->_sampleHeightQueries) {
+    positions.Append(pQuery->positions);
+  }
+
+  TArray<FVector> sampledPositions;
+  TArray<bool> success;
+  this->SampleHeightMostDetailedBatch(positions, sampledPositions, success);
+
+  ACesiumCameraManager* pCameraManager = this->ResolveCameraManager();
+  TArray<TSharedPtr<CesiumSampleHeightQuery>> queries =
+      MoveTemp(this->_sampleHeightQueries);
+  this->_sampleHeightQueries.Reset();
+
+  int32 first = 0;
+  for (const TSharedPtr<CesiumSampleHeightQuery>& pQuery : queries) {
+    if (pCameraManager) {
+      for (int32 cameraId : pQuery->cameraIds) {
+        pCameraManager->RemoveCamera(cameraId);
+      }
+    }
+
+    TArray<FCesiumSampleHeightResult> result;
+    result.SetNum(pQuery->positions.Num());
+    for (int32 i = 0; i < result.Num(); ++i) {
+      result[i].LongitudeLatitudeHeight = sampledPositions[first + i];
+      result[i].SampleSuccess = success[first + i];
+    }
+    first += result.Num();
+    pQuery->promise.resolve(MoveTemp(result));
+  }
+}
+
+void ACesium3DTileset::showTilesToRender(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    CesiumTileStateChanges& changes) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
+
+  for (Cesium3DTilesSelection::Tile* pTile : tiles) {
+    if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+      continue;
+    }
+
+    // That looks like some reeeally entertaining debug session...:
+    // const Cesium3DTilesSelection::TileID& id = pTile->getTileID();
+    // const CesiumGeometry::QuadtreeTileID* pQuadtreeID =
+    // std::get_if<CesiumGeometry::QuadtreeTileID>(&id); if (!pQuadtreeID ||
+    // pQuadtreeID->level != 14 || pQuadtreeID->x != 5503 || pQuadtreeID->y !=
+    // 11626) { 	continue;
+    //}
+
+    const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        content.getRenderContent();
+    if (!pRenderContent) {
+      continue;
+    }
+
+    UCesiumGltfComponent* Gltf = static_cast<UCesiumGltfComponent*>(
+        pRenderContent->getRenderResources());
+    if (!Gltf) {
+      // When a tile does not have render resources (i.e. a glTF), then
+      // the resources either have not yet been loaded or prepared,
+      // or the tile is from an external tileset and does not directly
+      // own renderable content. In both cases, the tile is ignored here.
+      continue;
+    }
+
+    if (!Gltf->IsBuildComplete()) {
+      // Keep the tile hidden until all of its primitives have been created.
+      continue;
+    }
+
+    applyActorCollisionSettings(BodyInstance, Gltf);
+
+    if (Gltf->GetAttachParent() == nullptr) {
+
+      // The AttachToComponent method is ridiculously complex,
+      // so print a warning if attaching fails for some reason
+      bool attached = Gltf->AttachToComponent(
+          this->RootComponent,
+          FAttachmentTransformRules::KeepRelativeTransform);
+      if (!attached) {
+        FString tileIdString(
+            Cesium3DTilesSelection::TileIdUtilities::createTileIdString(
+                pTile->getTileID())
+                .c_str());
+        UE_LOG(
+            LogCesium,
+            Warning,
+            TEXT("Tile %s could not be attached to root"),
+            *tileIdString);
+      }
+    }
+
+    // Requested even if the tile is visible, to override a request to hide it
+    // that the tileset is still holding back.
+    changes.setVisibility(Gltf, true);
+    changes.setCollisionEnabled(Gltf, ECollisionEnabled::QueryAndPhysics);
+  }
+}
+
+namespace {
+
+// Gets the glTF component of a loaded tile, if it's completely built.
+UCesiumGltfComponent* getBuiltGltf(const Cesium3DTilesSelection::Tile& tile) {
+  if (tile.getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    return nullptr;
+  }
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  UCesiumGltfComponent* pGltf =
+      pRenderContent ? static_cast<UCesiumGltfComponent*>(
+                           pRenderContent->getRenderResources())
+                     : nullptr;
+  return pGltf && pGltf->IsBuildComplete() ? pGltf : nullptr;
+}
+
+// Determines if a bounding volume is farther than the given distance from all
+// of the views.
+bool isBeyondDistance(
+    const Cesium3DTilesSelection::BoundingVolume& boundingVolume,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views,
+    double distanceSquared) {
+  for (const Cesium3DTilesSelection::ViewState& view : views) {
+    if (view.computeDistanceSquaredToBoundingVolume(boundingVolume) <=
+        distanceSquared) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Finds the ancestor of a tile that stands in for it beyond a distance from
+ * the views: the highest loaded ancestor, at most the given number of levels
+ * up, that is replaced by its children, not rendered in the given epoch, and
+ * entirely beyond the distance. The tiles it stands in for are then all
+ * beyond the distance too.
+ */
+const Cesium3DTilesSelection::Tile* findProxyAncestor(
+    const Cesium3DTilesSelection::Tile& tile,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views,
+    double distanceSquared,
+    int32 levels,
+    uint64 epoch) {
+  const Cesium3DTilesSelection::Tile* pProxy = nullptr;
+  const Cesium3DTilesSelection::Tile* pAncestor = tile.getParent();
+  for (int32 level = 0; pAncestor && level < levels;
+       ++level, pAncestor = pAncestor->getParent()) {
+    if (pAncestor->getRefine() != Cesium3DTilesSelection::TileRefine::Replace ||
+        !isBeyondDistance(
+            pAncestor->getBoundingVolume(),
+            views,
+            distanceSquared)) {
+      break;
+    }
+    const UCesiumGltfComponent* pGltf = getBuiltGltf(*pAncestor);
+    if (pGltf && !pGltf->WasRenderedIn(epoch)) {
+      pProxy = pAncestor;
+    }
+  }
+  return pProxy;
+}
+
+// Determines if one of the ancestors of a proxy is a proxy too, in which case
+// both would stand in for the same tiles.
+bool hasProxyAncestor(
+    const Cesium3DTilesSelection::Tile& proxy,
+    const TSet<const Cesium3DTilesSelection::Tile*>& proxies) {
+  for (const Cesium3DTilesSelection::Tile* pAncestor = proxy.getParent();
+       pAncestor;
+       pAncestor = pAncestor->getParent()) {
+    if (proxies.Contains(pAncestor)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Prepares the glTF of a tile that may never have been shown to be used as a
+// proxy while it's hidden.
+void prepareProxy(UCesiumGltfComponent& gltf, USceneComponent* pRoot) {
+  if (gltf.GetAttachParent() == nullptr) {
+    gltf.AttachToComponent(
+        pRoot,
+        FAttachmentTransformRules::KeepRelativeTransform);
+  }
+  gltf.ApplyPendingTransform();
+}
+
+} // namespace
+
+void ACesium3DTileset::updateShadowCasting(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateShadowCasting)
+
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> changed;
+  TSet<const Cesium3DTilesSelection::Tile*> proxies;
+
+  if (this->ShadowCastingDistance > 0.0 && !views.empty()) {
+    const double distanceSquared =
+        this->ShadowCastingDistance * this->ShadowCastingDistance;
+
+    for (const Cesium3DTilesSelection::Tile* pTile : tiles) {
+      UCesiumGltfComponent* pGltf = getBuiltGltf(*pTile);
+      if (!pGltf || !isBeyondDistance(
+                        pTile->getBoundingVolume(),
+                        views,
+                        distanceSquared)) {
+        continue;
+      }
+
+      pGltf->SetShadowCasting(ECesiumGltfShadowCasting::None);
+      changed.Add(pGltf);
+
+      if (this->UseAncestorShadowProxies) {
+        const Cesium3DTilesSelection::Tile* pProxy = findProxyAncestor(
+            *pTile,
+            views,
+            distanceSquared,
+            this->ShadowProxyAncestorLevels,
+            this->_renderEpoch);
+        if (pProxy) {
+          proxies.Add(pProxy);
+        }
+      }
+    }
+  }
+
+  for (const Cesium3DTilesSelection::Tile* pProxy : proxies) {
+    if (hasProxyAncestor(*pProxy, proxies)) {
+      continue;
+    }
+    UCesiumGltfComponent* pGltf = getBuiltGltf(*pProxy);
+    prepareProxy(*pGltf, this->RootComponent);
+    pGltf->SetShadowCasting(ECesiumGltfShadowCasting::HiddenProxy);
+    changed.Add(pGltf);
+  }
+
+  // The tiles that no longer need a change cast their shadows as usual.
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pGltf :
+       this->_shadowCastingChanged) {
+    if (pGltf.IsValid() && !changed.Contains(pGltf)) {
+      pGltf->SetShadowCasting(ECesiumGltfShadowCasting::Visible);
+    }
+  }
+  this->_shadowCastingChanged = MoveTemp(changed);
+}
+
+void ACesium3DTileset::updateRayTracing(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    const std::vector<Cesium3DTilesSelection::ViewState>& views) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateRayTracing)
+
+  if (!this->IsRayTracingManaged()) {
+    // All of the tiles go back to being ray traced as usual.
+    TInlineComponentArray<UCesiumGltfComponent*> gltfComponents(this);
+    for (UCesiumGltfComponent* pGltf : gltfComponents) {
+      pGltf->SetRayTracing(ECesiumGltfRayTracing::Visible);
+    }
+    this->_rayTracingProxies.Empty();
+    this->_isRayTracingManaged = false;
+    return;
+  }
+  this->_isRayTracingManaged = true;
+
+  const bool limitDistance = this->RayTracingDistance > 0.0 && !views.empty();
+  const double distanceSquared =
+      this->RayTracingDistance * this->RayTracingDistance;
+
+  // The tiles to add to the ray tracing scene, each of which needs its BLAS
+  // to be built.
+  struct RayTracingAddition {
+    UCesiumGltfComponent* pGltf;
+    ECesiumGltfRayTracing rayTracing;
+    double distanceSquared;
+  };
+  TArray<RayTracingAddition> additions;
+  TSet<const Cesium3DTilesSelection::Tile*> proxies;
+
+  for (const Cesium3DTilesSelection::Tile* pTile : tiles) {
+    UCesiumGltfComponent* pGltf = getBuiltGltf(*pTile);
+    if (!pGltf) {
+      continue;
+    }
+
+    double nearest = views.empty() ? 0.0 : TNumericLimits<double>::Max();
+    for (const Cesium3DTilesSelection::ViewState& view : views) {
+      nearest = std::min(
+          nearest,
+          view.computeDistanceSquaredToBoundingVolume(
+              pTile->getBoundingVolume()));
+    }
+
+    if (!limitDistance || nearest <= distanceSquared) {
+      if (pGltf->GetRayTracing() != ECesiumGltfRayTracing::Visible) {
+        additions.Add({pGltf, ECesiumGltfRayTracing::Visible, nearest});
+      }
+      continue;
+    }
+
+    pGltf->SetRayTracing(ECesiumGltfRayTracing::None);
+
+    if (this->UseAncestorRayTracingProxies) {
+      const Cesium3DTilesSelection::Tile* pProxy = findProxyAncestor(
+          *pTile,
+          views,
+          distanceSquared,
+          this->RayTracingProxyAncestorLevels,
+          this->_renderEpoch);
+      if (pProxy) {
+        proxies.Add(pProxy);
+      }
+    }
+  }
+
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> proxyComponents;
+  for (const Cesium3DTilesSelection::Tile* pProxy : proxies) {
+    if (hasProxyAncestor(*pProxy, proxies)) {
+      continue;
+    }
+    UCesiumGltfComponent* pGltf = getBuiltGltf(*pProxy);
+    proxyComponents.Add(pGltf);
+    if (pGltf->GetRayTracing() != ECesiumGltfRayTracing::HiddenProxy) {
+      double nearest = TNumericLimits<double>::Max();
+      for (const Cesium3DTilesSelection::ViewState& view : views) {
+        nearest = std::min(
+            nearest,
+            view.computeDistanceSquaredToBoundingVolume(
+                pProxy->getBoundingVolume()));
+      }
+      additions.Add({pGltf, ECesiumGltfRayTracing::HiddenProxy, nearest});
+    }
+  }
+
+  // The proxies that are no longer needed leave the ray tracing scene. Those
+  // that are rendered again are added back below, like any other tile.
+  for (const TWeakObjectPtr<UCesiumGltfComponent>& pGltf :
+       this->_rayTracingProxies) {
+    if (pGltf.IsValid() && !proxyComponents.Contains(pGltf)) {
+      pGltf->SetRayTracing(ECesiumGltfRayTracing::None);
+    }
+  }
+  this->_rayTracingProxies = MoveTemp(proxyComponents);
+
+  // The nearest tiles are added first, and the rest wait for later frames,
+  // so that a burst of new tiles doesn't build all of their BLASes at once.
+  const int32 budget = this->MaximumRayTracingUpdatesPerFrame;
+  if (budget > 0 && additions.Num() > budget) {
+    additions.Sort(
+        [](const RayTracingAddition& a, const RayTracingAddition& b) {
+          return a.distanceSquared < b.distanceSquared;
+        });
+    additions.SetNum(budget);
+  }
+  for (const RayTracingAddition& addition : additions) {
+    if (addition.rayTracing == ECesiumGltfRayTracing::HiddenProxy) {
+      prepareProxy(*addition.pGltf, this->RootComponent);
+    }
+    addition.pGltf->SetRayTracing(addition.rayTracing);
+  }
+}
+
+static void updateTileFade(
+    Cesium3DTilesSelection::Tile* pTile,
+    bool fadingIn,
+    int32 customDataIndex,
+    float time,
+    float length,
+    CesiumTileStateChanges& changes) {
+  if (!pTile || !pTile->getContent().isRenderContent()) {
+    return;
+  }
+
+  if (pTile->getState() != Cesium3DTilesSelection::TileLoadState::Done) {
+    return;
+  }
+
+  const Cesium3DTilesSelection::TileContent& content = pTile->getContent();
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
       content.getRenderContent();
   if (!pRenderContent) {
     return;
@@ -2004,12 +4731,20 @@ static void updateTileFade(Cesium3DTilesSelection::Tile* pTile, bool fadingIn) {
   float percentage =
       pTile->getContent().getRenderContent()->getLodTransitionFadePercentage();
 
-  pGltf->UpdateFade(percentage, fadingIn);
+  if (customDataIndex < 0) {
+    changes.setFade(pGltf, percentage, fadingIn);
+  } else if (!pGltf->IsTimedFadeCurrent(percentage, fadingIn, time, length)) {
+    // Start the fade as far back as it has already progressed.
+    const float start =
+        time - glm::clamp(percentage, 0.0f, 1.0f) * FMath::Max(length, 0.0f);
+    changes.setTimedFade(pGltf, customDataIndex, start, length, fadingIn);
+  }
 }
 
 // Called every frame
 void ACesium3DTileset::Tick(float DeltaTime) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TilesetTick)
+  SCOPE_CYCLE_COUNTER(STAT_CesiumTilesetTick);
 
   Super::Tick(DeltaTime);
 
@@ -2026,6 +4761,26 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  ACesium3DTileset* pLinkedTileset = this->getLinkedTileset();
+  if (pLinkedTileset) {
+    // The linked tileset loads the tiles for the views of this one, too.
+    if (this->_pTileset) {
+      this->DestroyTileset();
+    }
+    pLinkedTileset->_linkedTilesets.AddUnique(this);
+    if (!this->_pLinkedTileComponents) {
+      this->_pLinkedTileComponents =
+          MakeShared<CesiumLinkedTileComponents>(this);
+    }
+    this->_pLinkedTileComponents->update(*pLinkedTileset);
+    return;
+  }
+
+  if (this->_pLinkedTileComponents) {
+    this->_pLinkedTileComponents->clear();
+    this->_pLinkedTileComponents.Reset();
+  }
+
   if (!this->_pTileset) {
     LoadTileset();
 
@@ -2037,21 +4792,21 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     }
   }
 
-  if (this->BoundingVolumePoolComponent && this->_cesiumViewExtension) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateOcclusion)
-    const TArray<USceneComponent*>& children =
-        this->BoundingVolumePoolComponent->GetAttachChildren();
-    for (USceneComponent* pChild : children) {
-      UCesiumBoundingVolumeComponent* pBoundingVolume =
-          Cast<UCesiumBoundingVolumeComponent>(pChild);
-
-      if (!pBoundingVolume) {
-        continue;
-      }
-
-      pBoundingVolume->UpdateOcclusion(*this->_cesiumViewExtension.Get());
-    }
+  this->updateOcclusion();
+  this->continueIncrementalGltfBuilds();
+  this->updateMetadataEncodedOnDemand();
+  this->updateFeatureStyle();
+  this->updateTileCostHeatmap();
+  if (this->_physicsMeshesDeferred &&
+      !CesiumStreamingGovernor::shouldDeferPhysicsMeshes()) {
+    this->_physicsMeshesDeferred = false;
+    this->_physicsMeshesChanged = true;
   }
+  this->updatePhysicsMeshesInPlace();
+  this->updatePhysicsMeshesOnDemand();
+  this->updateNavigationRelevance();
+  this->updateSampleHeightQueries();
+  this->updateEyeDomeLighting();
 
   updateTilesetOptionsFromProperties();
 
@@ -2060,6 +4815,17 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     return;
   }
 
+  this->_largestProjectionScale = 0.0;
+  for (const FCesiumCamera& camera : cameras) {
+    const double tanHalfFieldOfView =
+        FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees) * 0.5);
+    if (tanHalfFieldOfView > 0.0) {
+      this->_largestProjectionScale = FMath::Max(
+          this->_largestProjectionScale,
+          camera.ViewportSize.X / (2.0 * tanHalfFieldOfView));
+    }
+  }
+
   glm::dmat4 ueTilesetToUeWorld =
       VecMath::createMatrix4D(this->GetActorTransform().ToMatrixWithScale());
 
@@ -2078,29 +4844,207 @@ void ACesium3DTileset::Tick(float DeltaTime) {
   UCesiumEllipsoid* ellipsoid = this->ResolveGeoreference()->GetEllipsoid();
 
   std::vector<Cesium3DTilesSelection::ViewState> frustums;
+  std::vector<Cesium3DTilesSelection::ViewState> loadedTilesOnlyFrustums;
+  std::vector<FCesiumCamera> loadingCameras;
+  loadingCameras.reserve(cameras.size());
   for (const FCesiumCamera& camera : cameras) {
-    frustums.push_back(CreateViewStateFromViewParameters(
+    Cesium3DTilesSelection::ViewState frustum =
+        CreateViewStateFromViewParameters(
+            camera,
+            unrealWorldToCesiumTileset,
+            ellipsoid);
+    if (camera.UseLoadedTilesOnly) {
+      loadedTilesOnlyFrustums.push_back(frustum);
+      continue;
+    }
+    loadingCameras.push_back(camera);
+    addFocusViewStates(
         camera,
         unrealWorldToCesiumTileset,
-        ellipsoid));
+        frustum,
+        ellipsoid->GetNativeEllipsoid(),
+        frustums);
+  }
+
+  // In movie mode, only the views of the frame being rendered are waited for.
+  const size_t frameViewCount = frustums.size();
+  this->addPrefetchViewStates(
+      loadingCameras,
+      unrealWorldToCesiumTileset,
+      ellipsoid,
+      DeltaTime,
+      frustums);
+  if (this->_captureMovieMode && this->ResolvedCameraManager) {
+    for (const FCesiumCamera& camera :
+         this->ResolvedCameraManager->GetUpcomingCameras()) {
+      frustums.push_back(CreateViewStateFromViewParameters(
+          camera,
+          unrealWorldToCesiumTileset,
+          ellipsoid));
+    }
+  }
+
+  // A replayed trace selects tiles for the recorded views instead. Movies
+  // select tiles for the frames they render, so they are neither recorded nor
+  // replayed.
+  float viewUpdateDeltaTime = DeltaTime;
+  const bool traceSelection =
+      this->_pSelectionTrace && !this->_captureMovieMode;
+  if (traceSelection &&
+      this->_pSelectionTrace->getMode() == CesiumSelectionTrace::Mode::Replay &&
+      !this->_pSelectionTrace->replayViews(
+          ellipsoid->GetNativeEllipsoid(),
+          frustums,
+          viewUpdateDeltaTime)) {
+    this->_pSelectionTrace.Reset();
+  }
+
+  if (this->_pHorizonCuller) {
+    // Like frustum and fog culling, horizon culling would make tiles pop
+    // instead of fading.
+    std::vector<glm::dvec3> positions;
+    if (this->EnableHorizonCulling && !this->UseLodTransitions) {
+      positions.reserve(frustums.size());
+      for (const Cesium3DTilesSelection::ViewState& frustum : frustums) {
+        positions.push_back(frustum.getPosition());
+      }
+    }
+    this->_pHorizonCuller->setViews(ellipsoid->GetNativeEllipsoid(), positions);
+  }
+
+  if (this->_pDistanceExcluder) {
+    std::vector<glm::dvec3> positions;
+    positions.reserve(frustums.size());
+    for (const Cesium3DTilesSelection::ViewState& frustum : frustums) {
+      positions.push_back(frustum.getPosition());
+    }
+    this->_pDistanceExcluder->setViews(
+        ellipsoid->GetNativeEllipsoid(),
+        positions,
+        this->HLODDistance);
   }
 
+  const UWorld* pWorld = this->GetWorld();
+  // Each frame of a trace is one view update.
+  const bool skipIdleUpdates = this->SkipIdleEditorUpdates &&
+                               !this->_captureMovieMode && !traceSelection &&
+                               pWorld &&
+                               pWorld->WorldType == EWorldType::Editor;
+  std::vector<Cesium3DTilesSelection::ViewState> idleViewStates;
+  if (skipIdleUpdates) {
+    idleViewStates = frustums;
+    idleViewStates.insert(
+        idleViewStates.end(),
+        loadedTilesOnlyFrustums.begin(),
+        loadedTilesOnlyFrustums.end());
+  }
+  if (skipIdleUpdates && this->_isEditorViewIdle &&
+      areViewStatesEqual(idleViewStates, this->_lastEditorViewStates)) {
+    // The view update would select the same tiles. The main thread tasks and
+    // requests that it would otherwise handle may belong to others.
+    getAssetAccessor()->tick();
+    CesiumTileFinalizationBudget::dispatchMainThreadTasks(pWorld);
+
+    UCesiumTilesetScheduler* pScheduler =
+        pWorld->GetSubsystem<UCesiumTilesetScheduler>();
+    if (pScheduler) {
+      pScheduler->reportDemand(
+          *this,
+          0,
+          CesiumStats::getTileset(this).tilesRendered);
+    }
+    return;
+  }
+
+  // The view update must stay on the game thread, and can't run for several
+  // tilesets at once. Besides selecting tiles, it dispatches the main thread
+  // tasks of the shared AsyncSystem, finishes loads in the main thread, which
+  // creates tiles' components, attaches raster overlays to tiles, and unloads
+  // cached tiles, which destroys their components.
+  //
+  // The loads started by the view update, and their continuations, are for
+  // tiles to be rendered, unless the tileset itself is hidden.
+  CesiumTaskPriorityScope priorityScope(
+      this->IsHidden() ? ECesiumTaskPriority::Low : ECesiumTaskPriority::High);
+
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
-  if (this->_captureMovieMode) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
-    pResult = &this->_pTileset->updateViewOffline(frustums);
-  } else {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateView)
-    pResult = &this->_pTileset->updateView(frustums, DeltaTime);
+  Cesium3DTilesSelection::ViewUpdateResult movieResult;
+  const double viewUpdateStartTime = FPlatformTime::Seconds();
+  {
+    // The meshes of the tiles that finish loading in the view update create
+    // their render resources together, once it's done.
+    CesiumMeshResourceBatch::Scope meshResourceBatch;
+    if (this->_captureMovieMode) {
+      movieResult = this->updateViewForMovie(frustums, frameViewCount);
+      pResult = &movieResult;
+    } else {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateView)
+      pResult = &this->_pTileset->updateView(frustums, viewUpdateDeltaTime);
+    }
+  }
+  const double viewUpdateMilliseconds =
+      (FPlatformTime::Seconds() - viewUpdateStartTime) * 1000.0;
+  UCesiumTilesetStatistics::RecordStage(
+      ECesiumTileLoadStage::ViewUpdate,
+      viewUpdateMilliseconds);
+  if (traceSelection && this->_pSelectionTrace) {
+    this->_pSelectionTrace->addFrame(
+        frustums,
+        viewUpdateDeltaTime,
+        viewUpdateMilliseconds,
+        *pResult,
+        this->_pTileset->getNumberOfTilesLoaded());
   }
   updateLastViewUpdateResultState(*pResult);
 
-  removeCollisionForTiles(pResult->tilesFadingOut);
+  UCesiumTilesetScheduler* pScheduler =
+      this->GetWorld()->GetSubsystem<UCesiumTilesetScheduler>();
+  if (pScheduler) {
+    pScheduler->reportDemand(
+        *this,
+        int32(pResult->workerThreadTileLoadQueueLength),
+        int32(pResult->tilesToRenderThisFrame.size()));
+  }
+
+  // Visibility, collision, and fade changes are gathered here and applied
+  // together once the whole view update result has been processed.
+  CesiumTileStateChanges changes;
+
+  removeCollisionForTiles(pResult->tilesFadingOut, changes);
+
+  ++this->_renderEpoch;
+  markTilesRendered(pResult->tilesToRenderThisFrame, this->_renderEpoch);
+
+  // The views that use loaded tiles only are shown what the others loaded.
+  std::vector<Cesium3DTilesSelection::Tile*> loadedTilesOnly;
+  Cesium3DTilesSelection::Tile* pRootTile = this->_pTileset->getRootTile();
+  if (!loadedTilesOnlyFrustums.empty() && pRootTile) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SelectLoadedTiles)
+    addLoadedTilesToRender(
+        *pRootTile,
+        loadedTilesOnlyFrustums,
+        this->MaximumScreenSpaceError,
+        loadedTilesOnly);
+    markTilesRendered(loadedTilesOnly, this->_renderEpoch);
+  }
+
+  hideTiles(_tilesToHideNextFrame, this->_renderEpoch, changes);
 
-  removeVisibleTilesFromList(
-      _tilesToHideNextFrame,
-      pResult->tilesToRenderThisFrame);
-  hideTiles(_tilesToHideNextFrame);
+  std::unordered_set<Cesium3DTilesSelection::Tile*> loadedTilesNoLongerShown;
+  for (Cesium3DTilesSelection::Tile* pTile : this->_loadedTilesOnlyRendered) {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    const UCesiumGltfComponent* pGltf =
+        pRenderContent ? static_cast<const UCesiumGltfComponent*>(
+                             pRenderContent->getRenderResources())
+                       : nullptr;
+    if (pGltf && !pGltf->WasRenderedIn(this->_renderEpoch)) {
+      loadedTilesNoLongerShown.insert(pTile);
+    }
+  }
+  removeCollisionForTiles(loadedTilesNoLongerShown, changes);
+  hideTiles(this->_loadedTilesOnlyRendered, this->_renderEpoch, changes);
+  this->_loadedTilesOnlyRendered = loadedTilesOnly;
 
   _tilesToHideNextFrame.clear();
   for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
@@ -2113,25 +5057,113 @@ void ACesium3DTileset::Tick(float DeltaTime) {
     }
   }
 
-  showTilesToRender(pResult->tilesToRenderThisFrame);
+  showTilesToRender(pResult->tilesToRenderThisFrame, changes);
+  showTilesToRender(loadedTilesOnly, changes);
+
+  const bool updateShadows = this->ShadowCastingDistance > 0.0 ||
+                             !this->_shadowCastingChanged.IsEmpty();
+  const bool updateRayTracing =
+      this->IsRayTracingManaged() || this->_isRayTracingManaged;
+  if (updateShadows || updateRayTracing) {
+    std::vector<Cesium3DTilesSelection::Tile*> renderedTiles =
+        pResult->tilesToRenderThisFrame;
+    renderedTiles.insert(
+        renderedTiles.end(),
+        loadedTilesOnly.begin(),
+        loadedTilesOnly.end());
+    // The distances are measured from the views of this frame, not from the
+    // predicted ones.
+    std::vector<Cesium3DTilesSelection::ViewState> renderedViews(
+        frustums.begin(),
+        frustums.begin() + frameViewCount);
+    renderedViews.insert(
+        renderedViews.end(),
+        loadedTilesOnlyFrustums.begin(),
+        loadedTilesOnlyFrustums.end());
+    if (updateShadows) {
+      this->updateShadowCasting(renderedTiles, renderedViews);
+    }
+    if (updateRayTracing) {
+      this->updateRayTracing(renderedTiles, renderedViews);
+    }
+  }
+
+  if (CesiumTextureResidency::isGatheringFootprints()) {
+    TArray<UCesiumGltfComponent*> rendered;
+    for (Cesium3DTilesSelection::Tile* pTile :
+         pResult->tilesToRenderThisFrame) {
+      const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+          pTile->getContent().getRenderContent();
+      if (pRenderContent) {
+        UCesiumGltfComponent* pGltf = static_cast<UCesiumGltfComponent*>(
+            pRenderContent->getRenderResources());
+        if (pGltf) {
+          rendered.Add(pGltf);
+        }
+      }
+    }
+    CesiumTextureResidency::addRenderedComponents(cameras, rendered);
+  }
 
   if (this->UseLodTransitions) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileFades)
 
+    // With the fades in Custom Primitive Data, only the fades that start,
+    // reverse, or drift from what the material computes are written.
+    const int32 customDataIndex = this->LodTransitionCustomPrimitiveDataIndex;
+    const float time = this->GetWorld()->GetTimeSeconds();
+    const float length = this->LodTransitionLength;
+
     for (Cesium3DTilesSelection::Tile* pTile :
          pResult->tilesToRenderThisFrame) {
-      updateTileFade(pTile, true);
+      updateTileFade(pTile, true, customDataIndex, time, length, changes);
     }
 
     for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
-      updateTileFade(pTile, false);
+      updateTileFade(pTile, false, customDataIndex, time, length, changes);
+    }
+  }
+
+  if (this->TileUpdateWindow > 0.0f) {
+    // Showing or hiding a tile invalidates the cached shadow pages it covers,
+    // so the changes are held back and applied together once per window.
+    if (!this->_pHeldTileStateChanges) {
+      this->_pHeldTileStateChanges = MakeShared<CesiumTileStateChanges>();
+    }
+    this->_pHeldTileStateChanges->append(MoveTemp(changes));
+    const double now = FPlatformTime::Seconds();
+    if (now - this->_lastTileUpdateWindowStart >= this->TileUpdateWindow) {
+      this->commitTileStateChanges(*this->_pHeldTileStateChanges);
+      this->_lastTileUpdateWindowStart = now;
+    }
+  } else {
+    if (this->_pHeldTileStateChanges) {
+      this->_pHeldTileStateChanges->append(MoveTemp(changes));
+      this->commitTileStateChanges(*this->_pHeldTileStateChanges);
+      this->_pHeldTileStateChanges.Reset();
     }
+    this->commitTileStateChanges(changes);
+  }
+
+  if (skipIdleUpdates) {
+    this->_lastEditorViewStates = std::move(idleViewStates);
+    this->_isEditorViewIdle =
+        pResult->workerThreadTileLoadQueueLength == 0 &&
+        pResult->mainThreadTileLoadQueueLength == 0 &&
+        pResult->tilesWaitingForOcclusionResults == 0 &&
+        pResult->tilesFadingOut.empty() && _tilesToHideNextFrame.empty() &&
+        this->_gltfComponentsBeingBuilt.IsEmpty() &&
+        this->_deferredCollisionUpdates == 0 &&
+        this->_pTileset->computeLoadProgress() >= 100.0f;
+  } else {
+    this->_isEditorViewIdle = false;
   }
 
   this->UpdateLoadStatus();
 }
 
 void ACesium3DTileset::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  this->finishSampleHeightQueries();
   this->DestroyTileset();
   AActor::EndPlay(EndPlayReason);
 }
@@ -2184,6 +5216,7 @@ void ACesium3DTileset::Serialize(FArchive& Ar) {
 void ACesium3DTileset::PostEditChangeProperty(
     FPropertyChangedEvent& PropertyChangedEvent) {
   Super::PostEditChangeProperty(PropertyChangedEvent);
+  this->_isEditorViewIdle = false;
 
   if (!PropertyChangedEvent.Property) {
     return;
@@ -2194,12 +5227,28 @@ void ACesium3DTileset::PostEditChangeProperty(
 
   if (PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TilesetSource) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Url) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, LocalPackageFilename) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IonAssetID) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IonAccessToken) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      CreatePhysicsMeshesOnDemand) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      PhysicsMeshSimplificationError) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateTraceMeshes) ||
       PropName ==
-          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes) ||
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateFeatureIndices) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateNavCollision) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      RestrictNavigationToInvokers) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      MaximumNavigationUpdatesPerFrame) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AlwaysIncludeTangents) ||
       PropName ==
@@ -2207,10 +5256,48 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
-      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
       PropName ==
-          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
-      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, WaterMaterial) ||
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CompressTextures) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseCompactVertexFormat) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PackFeatureIds) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, QuantizePointClouds) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, SmoothNormalsCreaseAngle) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseFastTangentsForWater) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseTerrainHeightmaps) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      TerrainHeightmapResolution) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      ComputeRasterOverlayTextureCoordinates) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, OptimizeMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, BuildNaniteMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GenerateSimplifiedLod) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, SimplifiedLodScreenSize) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseClusterCulling) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MergeInstancedMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MergeSmallPrimitives) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TileBufferResidency) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, RuntimeVirtualTextures) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      VirtualTextureRenderPassType) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      ShadowCacheInvalidationBehavior) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ApplyDpiScaling) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableOcclusionCulling) ||
@@ -2219,13 +5306,27 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, ShowCreditsOnScreen) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Root) ||
-      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CesiumIonServer) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CesiumIonServer)) {
+    this->DestroyTileset();
+  } else if (
+      PropName ==
+      GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes)) {
+    this->onCreatePhysicsMeshesChanged();
+  } else if (
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, WaterMaterial)) {
+    if (!this->updateMaterialsInPlace()) {
+      this->DestroyTileset();
+    }
+  } else if (
       // For properties nested in structs, GET_MEMBER_NAME_CHECKED will prefix
       // with the struct name, so just do a manual string comparison.
       PropNameAsString == TEXT("RenderCustomDepth") ||
       PropNameAsString == TEXT("CustomDepthStencilValue") ||
       PropNameAsString == TEXT("CustomDepthStencilWriteMask")) {
-    this->DestroyTileset();
+    this->updateCustomDepthInPlace();
   } else if (
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Georeference)) {
     this->InvalidateResolvedGeoreference();
@@ -2257,6 +5358,7 @@ void ACesium3DTileset::PostEditChangeProperty(
 void ACesium3DTileset::PostEditChangeChainProperty(
     FPropertyChangedChainEvent& PropertyChangedChainEvent) {
   Super::PostEditChangeChainProperty(PropertyChangedChainEvent);
+  this->_isEditorViewIdle = false;
 
   if (!PropertyChangedChainEvent.Property ||
       PropertyChangedChainEvent.PropertyChain.IsEmpty()) {
@@ -2268,6 +5370,18 @@ void ACesium3DTileset::PostEditChangeChainProperty(
   if (PropName ==
       GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PointCloudShading)) {
     FCesiumGltfPointsSceneProxyUpdater::UpdateSettingsInProxies(this);
+  } else if (
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, VoxelRendering)) {
+    // The attribute is chosen when the voxels are loaded.
+    const FName TailName =
+        PropertyChangedChainEvent.PropertyChain.GetTail()->GetValue()
+            ->GetFName();
+    if (TailName ==
+        GET_MEMBER_NAME_CHECKED(FCesiumVoxelRendering, Attribute)) {
+      this->DestroyTileset();
+    } else {
+      this->updateVoxelRendering();
+    }
   }
 }
 
@@ -2289,6 +5403,7 @@ void ACesium3DTileset::PostEditImport() {
 #endif
 
 void ACesium3DTileset::BeginDestroy() {
+  this->finishSampleHeightQueries();
   this->InvalidateResolvedGeoreference();
   this->DestroyTileset();
 
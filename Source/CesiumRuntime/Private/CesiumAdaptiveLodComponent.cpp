@@ -0,0 +1,140 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAdaptiveLodComponent.h"
+#include "Cesium3DTileset.h"
+#include "CesiumMemoryUsage.h"
+#include "CesiumRuntime.h"
+#include "CesiumScreenSpaceErrorController.h"
+#include "HAL/PlatformTime.h"
+#include "RHI.h"
+#include "RenderCore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/**
+ * Gets the longest of the game thread, render thread, and GPU times of the
+ * previous frame, in milliseconds. The GPU time is zero on platforms that
+ * don't measure it.
+ */
+double getFrameTimeMilliseconds() {
+  const uint32 cycles = std::max(
+      {GGameThreadTime, GRenderThreadTime, RHIGetGPUFrameCycles()});
+  return FPlatformTime::ToMilliseconds(cycles);
+}
+
+} // namespace
+
+UCesiumAdaptiveLodComponent::UCesiumAdaptiveLodComponent() {
+  this->PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UCesiumAdaptiveLodComponent::BeginPlay() {
+  Super::BeginPlay();
+
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (!pTileset) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "CesiumAdaptiveLodComponent %s is not attached to a Cesium3DTileset, so it has no effect."),
+        *this->GetName());
+    return;
+  }
+
+  this->_originalScreenSpaceError = pTileset->MaximumScreenSpaceError;
+  this->_originalCulledScreenSpaceError = pTileset->CulledScreenSpaceError;
+  this->_smoothedFrameTime = 0.0f;
+
+  this->_pController = MakeShared<CesiumScreenSpaceErrorController>();
+  this->_pController->reset(std::clamp(
+      this->_originalScreenSpaceError,
+      this->MinimumScreenSpaceError,
+      std::max(this->MinimumScreenSpaceError, this->MaximumScreenSpaceError)));
+  this->_isControlling = true;
+}
+
+void UCesiumAdaptiveLodComponent::EndPlay(
+    const EEndPlayReason::Type EndPlayReason) {
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (this->_isControlling && pTileset) {
+    pTileset->SetMaximumScreenSpaceError(this->_originalScreenSpaceError);
+    pTileset->CulledScreenSpaceError = this->_originalCulledScreenSpaceError;
+  }
+
+  this->_isControlling = false;
+  this->_pController.Reset();
+
+  Super::EndPlay(EndPlayReason);
+}
+
+void UCesiumAdaptiveLodComponent::TickComponent(
+    float DeltaTime,
+    ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (!this->_isControlling || !pTileset || DeltaTime <= 0.0f) {
+    return;
+  }
+
+  // Average the frame times exponentially, with the smoothing time as the
+  // time constant.
+  const double frameTime = getFrameTimeMilliseconds();
+  if (this->_smoothedFrameTime <= 0.0f || this->SmoothingTime <= 0.0f) {
+    this->_smoothedFrameTime = float(frameTime);
+  } else {
+    const double weight = 1.0 - std::exp(-DeltaTime / this->SmoothingTime);
+    this->_smoothedFrameTime +=
+        float(weight * (frameTime - this->_smoothedFrameTime));
+  }
+
+  const double targetFrameTime =
+      1000.0 / std::max(double(this->TargetFramesPerSecond), 1.0);
+  double error = (this->_smoothedFrameTime - targetFrameTime) / targetFrameTime;
+
+  if (this->MemoryBudgetMB > 0) {
+    const FCesiumMemoryUsage usage = pTileset->GetMemoryUsage();
+    const double totalBytes = double(
+        usage.TextureBytes + usage.VertexBytes + usage.IndexBytes +
+        usage.CollisionBytes);
+    const double budgetBytes = double(this->MemoryBudgetMB) * 1024.0 * 1024.0;
+    const double memoryError = (totalBytes - budgetBytes) / budgetBytes;
+    if (memoryError > 0.0) {
+      error = std::max(error, memoryError);
+    } else if (memoryError > -this->Tolerance) {
+      // Nearly at the budget, so don't load more detail.
+      error = std::max(error, 0.0);
+    }
+  }
+
+  CesiumScreenSpaceErrorController::Settings settings;
+  settings.minimumScreenSpaceError = this->MinimumScreenSpaceError;
+  settings.maximumScreenSpaceError =
+      std::max(this->MinimumScreenSpaceError, this->MaximumScreenSpaceError);
+  settings.tolerance = this->Tolerance;
+  settings.proportionalGain = this->ProportionalGain;
+  settings.integralGain = this->IntegralGain;
+  settings.derivativeGain = this->DerivativeGain;
+
+  const double screenSpaceError =
+      this->_pController->update(settings, error, DeltaTime);
+  if (pTileset->MaximumScreenSpaceError == screenSpaceError) {
+    return;
+  }
+
+  pTileset->SetMaximumScreenSpaceError(screenSpaceError);
+  if (this->AdjustCulledScreenSpaceError &&
+      this->_originalScreenSpaceError > 0.0) {
+    pTileset->CulledScreenSpaceError =
+        this->_originalCulledScreenSpaceError * screenSpaceError /
+        this->_originalScreenSpaceError;
+  }
+}
+
+ACesium3DTileset* UCesiumAdaptiveLodComponent::getTileset() const {
+  return Cast<ACesium3DTileset>(this->GetOwner());
+}
@@ -0,0 +1,209 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAdaptiveTileLoads.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformTime.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+
+namespace {
+
+/**
+ * The shortest time over which responses are sampled before the number of
+ * loads is adjusted.
+ */
+constexpr double WindowSeconds = 0.5;
+
+/**
+ * The fewest responses in a window for its latency to be meaningful.
+ */
+constexpr int64 MinimumResponsesPerWindow = 4;
+
+/**
+ * The longest time over which responses are sampled. A window that still
+ * has too few responses by then is discarded, since the network is idle.
+ */
+constexpr double IdleWindowSeconds = 5.0;
+
+/**
+ * How many times the lowest mean latency the mean latency of a window may be
+ * before the network is considered congested.
+ */
+constexpr double LatencyTolerance = 2.0;
+
+/**
+ * The factor by which the number of loads is cut when the network is
+ * congested.
+ */
+constexpr double DecreaseFactor = 0.7;
+
+/**
+ * The factor by which the throughput of a window may be lower than that of
+ * the previous window for the number of loads to still be raised.
+ */
+constexpr double ThroughputTolerance = 0.9;
+
+/**
+ * The factor by which the lowest mean latency is raised every window, so
+ * that a route that became slower is eventually treated as the new normal
+ * rather than as congested forever.
+ */
+constexpr double LowestLatencyDrift = 1.01;
+
+/**
+ * The number of loads to start with, the default Maximum Simultaneous Tile
+ * Loads of a tileset.
+ */
+constexpr double InitialTileLoads = 20.0;
+
+struct Samples {
+  int64 responses = 0;
+  int64 overloadedResponses = 0;
+  double latencySum = 0.0;
+  int64 bytes = 0;
+};
+
+struct Controller {
+  // The responses of the current window, recorded from any thread.
+  std::mutex mutex;
+  Samples samples;
+
+  // Everything else is only used in the game thread.
+  double windowStart = 0.0;
+  double loads = 0.0;
+  double lowestLatency = 0.0;
+  double previousThroughput = 0.0;
+  bool decreasedInPreviousWindow = false;
+  uint64 lastUpdatedFrame = 0;
+};
+
+Controller& getController() {
+  static Controller controller;
+  return controller;
+}
+
+Samples takeSamples(Controller& controller) {
+  std::scoped_lock<std::mutex> lock(controller.mutex);
+  Samples result = controller.samples;
+  controller.samples = Samples();
+  return result;
+}
+
+} // namespace
+
+namespace CesiumAdaptiveTileLoads {
+
+bool isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->AdaptiveSimultaneousTileLoads;
+}
+
+void recordResponse(double latencySeconds, int64 bytes, bool overloaded) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  Controller& controller = getController();
+  std::scoped_lock<std::mutex> lock(controller.mutex);
+  Samples& samples = controller.samples;
+  if (overloaded) {
+    ++samples.overloadedResponses;
+  } else {
+    ++samples.responses;
+    samples.latencySum += latencySeconds;
+    samples.bytes += bytes;
+  }
+}
+
+void update() {
+  check(IsInGameThread());
+
+  Controller& controller = getController();
+  if (controller.lastUpdatedFrame == GFrameCounter) {
+    return;
+  }
+  controller.lastUpdatedFrame = GFrameCounter;
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  const double minimum =
+      double(std::max(pSettings->MinimumAdaptiveTileLoads, 1));
+  const double maximum =
+      std::max(double(pSettings->MaximumAdaptiveTileLoads), minimum);
+
+  const double now = FPlatformTime::Seconds();
+  if (controller.loads <= 0.0) {
+    controller.loads = InitialTileLoads;
+    controller.windowStart = now;
+    takeSamples(controller);
+  }
+  controller.loads = FMath::Clamp(controller.loads, minimum, maximum);
+
+  const double elapsed = now - controller.windowStart;
+  if (elapsed < WindowSeconds) {
+    return;
+  }
+
+  {
+    // Too few responses say little about the network, so wait for more.
+    std::scoped_lock<std::mutex> lock(controller.mutex);
+    const Samples& samples = controller.samples;
+    if (samples.overloadedResponses == 0 &&
+        samples.responses < MinimumResponsesPerWindow &&
+        elapsed < IdleWindowSeconds) {
+      return;
+    }
+  }
+
+  const Samples samples = takeSamples(controller);
+  controller.windowStart = now;
+  if (samples.overloadedResponses == 0 &&
+      samples.responses < MinimumResponsesPerWindow) {
+    // The network was idle.
+    return;
+  }
+
+  bool congested = samples.overloadedResponses > 0;
+  if (samples.responses > 0) {
+    const double meanLatency =
+        samples.latencySum / double(samples.responses);
+    controller.lowestLatency =
+        controller.lowestLatency > 0.0
+            ? std::min(
+                  controller.lowestLatency * LowestLatencyDrift,
+                  meanLatency)
+            : meanLatency;
+    congested =
+        congested || meanLatency > controller.lowestLatency * LatencyTolerance;
+  }
+
+  const double throughput = double(samples.bytes) / elapsed;
+
+  if (congested) {
+    // Right after a decrease, most responses are still for requests sent
+    // before it, so they don't warrant another one.
+    if (!controller.decreasedInPreviousWindow) {
+      controller.loads =
+          std::max(minimum, std::floor(controller.loads * DecreaseFactor));
+      controller.decreasedInPreviousWindow = true;
+    } else {
+      controller.decreasedInPreviousWindow = false;
+    }
+  } else {
+    if (throughput >= controller.previousThroughput * ThroughputTolerance) {
+      controller.loads = std::min(maximum, controller.loads + 1.0);
+    }
+    controller.decreasedInPreviousWindow = false;
+  }
+
+  controller.previousThroughput = throughput;
+}
+
+int32 getSimultaneousTileLoads() {
+  check(IsInGameThread());
+
+  const Controller& controller = getController();
+  return int32(controller.loads > 0.0 ? controller.loads : InitialTileLoads);
+}
+
+} // namespace CesiumAdaptiveTileLoads
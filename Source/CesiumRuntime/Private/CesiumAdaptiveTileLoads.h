@@ -0,0 +1,54 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Adjusts the number of tile loads that may be in progress at once to the
+ * capacity of the network, when Adaptive Simultaneous Tile Loads is enabled
+ * in the Cesium runtime settings.
+ *
+ * The latency and size of every HTTP response are recorded. At the end of
+ * each sampling window, of about half a second, the number of loads is
+ * raised by one load if the mean latency in the window stayed below twice
+ * the lowest mean latency observed so far and the throughput didn't drop by
+ * more than a tenth compared with the previous window. It is cut by 30% if
+ * the latency grew beyond that, which means that requests are queueing
+ * somewhere on the way, or if a server answered that it is overloaded. This
+ * is the additive increase and multiplicative decrease of TCP congestion
+ * control, applied to whole requests.
+ */
+namespace CesiumAdaptiveTileLoads {
+
+/**
+ * @brief Gets whether the number of simultaneous tile loads is adjusted.
+ * May be called from any thread.
+ */
+bool isEnabled();
+
+/**
+ * @brief Records an HTTP response. May be called from any thread.
+ *
+ * @param latencySeconds The time from sending the request to its completion.
+ * @param bytes The size of the response's content.
+ * @param overloaded Whether the server answered that it is overloaded or
+ * took too long, such as with a 429 or 503 status.
+ */
+void recordResponse(double latencySeconds, int64 bytes, bool overloaded);
+
+/**
+ * @brief Adjusts the number of simultaneous tile loads from the responses
+ * recorded since the last adjustment, if a sampling window has passed. Only
+ * the first call in a frame has an effect. Must be called from the game
+ * thread.
+ */
+void update();
+
+/**
+ * @brief Gets the number of tile loads that may currently be in progress at
+ * once, shared by all tilesets. Must be called from the game thread.
+ */
+int32 getSimultaneousTileLoads();
+
+} // namespace CesiumAdaptiveTileLoads
@@ -0,0 +1,54 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumBakedCacheDatabase.h"
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumTilesetStatistics.h"
+#include "HAL/PlatformTime.h"
+#include <limits>
+
+CesiumBakedCacheDatabase::CesiumBakedCacheDatabase(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pBakedDatabase,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase)
+    : _pBakedDatabase(pBakedDatabase), _pDatabase(pDatabase) {}
+
+std::optional<CesiumAsync::CacheItem>
+CesiumBakedCacheDatabase::getEntry(const std::string& key) const {
+  const double startTime = FPlatformTime::Seconds();
+  std::optional<CesiumAsync::CacheItem> result =
+      this->_pBakedDatabase->getEntry(key);
+  UCesiumTilesetStatistics::RecordStage(
+      ECesiumTileLoadStage::CacheRead,
+      (FPlatformTime::Seconds() - startTime) * 1000.0);
+
+  if (result) {
+    result->expiryTime = std::numeric_limits<std::time_t>::max();
+    return result;
+  }
+  return this->_pDatabase->getEntry(key);
+}
+
+bool CesiumBakedCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  return this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+bool CesiumBakedCacheDatabase::prune() { return this->_pDatabase->prune(); }
+
+bool CesiumBakedCacheDatabase::clearAll() {
+  return this->_pDatabase->clearAll();
+}
@@ -0,0 +1,50 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include <memory>
+
+/**
+ * A request cache database that looks entries up in a read-only database,
+ * baked ahead of time and shipped with the project, before the database of
+ * the user, where entries are stored.
+ *
+ * Entries found in the baked database never expire, so they are used without
+ * asking the server whether they are still current. Storing, pruning, and
+ * clearing only affect the database of the user.
+ */
+class CesiumBakedCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * Creates a database.
+   *
+   * @param pBakedDatabase The database baked ahead of time. It is never
+   * written to.
+   * @param pDatabase The database of the user.
+   */
+  CesiumBakedCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pBakedDatabase,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+private:
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pBakedDatabase;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+};
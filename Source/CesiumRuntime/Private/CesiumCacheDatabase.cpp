@@ -0,0 +1,234 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCacheDatabase.h"
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumRuntime.h"
+#include "CesiumTilesetStatistics.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Tasks/Task.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// A rough allowance for the URL, headers, and row overhead of each entry, so
+// that many small entries are not undercounted.
+constexpr int64_t entryOverheadBytes = 512;
+
+} // namespace
+
+CesiumCacheDatabase::CesiumCacheDatabase(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+    int64_t maximumBytes,
+    const FString& indexFilename)
+    : _pDatabase(pDatabase),
+      _maximumBytes(maximumBytes),
+      _indexFilename(indexFilename),
+      _mutex(),
+      _index(),
+      _sizeBytes(0),
+      _pruneScheduled(false) {
+  this->loadIndex();
+}
+
+std::optional<CesiumAsync::CacheItem>
+CesiumCacheDatabase::getEntry(const std::string& key) const {
+  const double startTime = FPlatformTime::Seconds();
+  std::optional<CesiumAsync::CacheItem> result =
+      this->_pDatabase->getEntry(key);
+  UCesiumTilesetStatistics::RecordStage(
+      ECesiumTileLoadStage::CacheRead,
+      (FPlatformTime::Seconds() - startTime) * 1000.0);
+
+  // Evicted entries are left as expired placeholders until the next prune,
+  // and aren't counted.
+  if (result && result->expiryTime != 0) {
+    const int64_t sizeBytes =
+        int64_t(result->cacheResponse.data.size()) + entryOverheadBytes;
+
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    IndexEntry& entry = this->_index[key];
+    if (entry.sizeBytes != sizeBytes) {
+      // The entry was stored before the index was created, or the index was
+      // lost.
+      this->_sizeBytes += sizeBytes - entry.sizeBytes;
+      entry.sizeBytes = sizeBytes;
+    }
+    entry.lastAccessTime = std::time(nullptr);
+  }
+  return result;
+}
+
+bool CesiumCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  const bool stored = this->_pDatabase->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+  if (stored) {
+    const int64_t sizeBytes = int64_t(responseData.size()) + entryOverheadBytes;
+
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    IndexEntry& entry = this->_index[key];
+    this->_sizeBytes += sizeBytes - entry.sizeBytes;
+    entry.sizeBytes = sizeBytes;
+    entry.lastAccessTime = std::time(nullptr);
+  }
+  return stored;
+}
+
+bool CesiumCacheDatabase::prune() {
+  bool expected = false;
+  if (!this->_pruneScheduled.compare_exchange_strong(expected, true)) {
+    return true;
+  }
+
+  UE::Tasks::Launch(
+      TEXT("CesiumCacheDatabasePrune"),
+      [pThis = this->shared_from_this()]() {
+        pThis->_pruneScheduled = false;
+        pThis->pruneNow();
+      },
+      UE::Tasks::ETaskPriority::BackgroundLow);
+  return true;
+}
+
+bool CesiumCacheDatabase::clearAll() {
+  const bool cleared = this->_pDatabase->clearAll();
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_index.clear();
+    this->_sizeBytes = 0;
+  }
+  this->saveIndex();
+  return cleared;
+}
+
+void CesiumCacheDatabase::pruneNow() {
+  std::vector<std::string> evicted;
+
+  if (this->_maximumBytes > 0) {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    if (this->_sizeBytes > this->_maximumBytes) {
+      struct Candidate {
+        const std::string* pKey;
+        double weight;
+      };
+
+      const std::time_t now = std::time(nullptr);
+      std::vector<Candidate> candidates;
+      candidates.reserve(this->_index.size());
+      for (const auto& [key, entry] : this->_index) {
+        const double idleSeconds =
+            double(std::max<std::time_t>(now - entry.lastAccessTime, 1));
+        candidates.push_back({&key, idleSeconds * double(entry.sizeBytes)});
+      }
+
+      std::sort(
+          candidates.begin(),
+          candidates.end(),
+          [](const Candidate& a, const Candidate& b) {
+            return a.weight > b.weight;
+          });
+
+      int64_t sizeBytes = this->_sizeBytes;
+      for (const Candidate& candidate : candidates) {
+        if (sizeBytes <= this->_maximumBytes) {
+          break;
+        }
+        sizeBytes -= this->_index[*candidate.pKey].sizeBytes;
+        evicted.emplace_back(*candidate.pKey);
+      }
+
+      for (const std::string& key : evicted) {
+        this->_index.erase(key);
+      }
+      this->_sizeBytes = sizeBytes;
+    }
+  }
+
+  // Replace each evicted entry with an empty one that has already expired.
+  // The wrapped database deletes expired entries when it prunes.
+  for (const std::string& key : evicted) {
+    this->_pDatabase->storeEntry(
+        key,
+        0,
+        std::string(),
+        std::string(),
+        CesiumAsync::HttpHeaders(),
+        0,
+        CesiumAsync::HttpHeaders(),
+        gsl::span<const std::byte>());
+  }
+
+  if (!evicted.empty()) {
+    UE_LOG(
+        LogCesium,
+        Verbose,
+        TEXT("Evicted %d entries from the request cache to stay within %lld "
+             "bytes"),
+        int32(evicted.size()),
+        int64(this->_maximumBytes));
+  }
+
+  this->_pDatabase->prune();
+  this->saveIndex();
+}
+
+int64_t CesiumCacheDatabase::getSizeBytes() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_sizeBytes;
+}
+
+void CesiumCacheDatabase::loadIndex() {
+  TArray<FString> lines;
+  if (!FFileHelper::LoadFileToStringArray(lines, *this->_indexFilename)) {
+    return;
+  }
+
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  for (const FString& line : lines) {
+    TArray<FString> fields;
+    if (line.ParseIntoArray(fields, TEXT("\t"), false) != 3) {
+      continue;
+    }
+
+    IndexEntry entry{
+        FCString::Atoi64(*fields[1]),
+        std::time_t(FCString::Atoi64(*fields[2]))};
+    this->_sizeBytes += entry.sizeBytes;
+    this->_index.emplace(TCHAR_TO_UTF8(*fields[0]), entry);
+  }
+}
+
+void CesiumCacheDatabase::saveIndex() const {
+  FString contents;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    for (const auto& [key, entry] : this->_index) {
+      contents += FString::Printf(
+          TEXT("%s\t%lld\t%lld\n"),
+          UTF8_TO_TCHAR(key.c_str()),
+          int64(entry.sizeBytes),
+          int64(entry.lastAccessTime));
+    }
+  }
+
+  FFileHelper::SaveStringToFile(
+      contents,
+      *this->_indexFilename,
+      FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
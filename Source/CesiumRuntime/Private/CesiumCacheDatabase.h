@@ -0,0 +1,100 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include "Containers/UnrealString.h"
+#include <atomic>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * A request cache database that limits another database, such as a
+ * `SqliteCache`, by the total size of its responses rather than only by the
+ * number of entries, and that prunes it in the background.
+ *
+ * The size and last access time of each entry are kept in an index that is
+ * saved next to the database each time it is pruned. Entries missing from the
+ * index are added when they are next read. When the total size exceeds the budget, entries
+ * are evicted in order of their time since last access multiplied by their
+ * size, so that large entries that haven't been used recently go first and
+ * small entries such as tileset.json files are kept longer. An entry is
+ * evicted by replacing it with an empty, expired one, which the wrapped
+ * database deletes when it is next pruned.
+ *
+ * Calls to {@link prune} return immediately. The pruning itself runs in a
+ * low-priority background task, so requests never wait for it.
+ */
+class CesiumCacheDatabase
+    : public CesiumAsync::ICacheDatabase,
+      public std::enable_shared_from_this<CesiumCacheDatabase> {
+public:
+  /**
+   * Creates a database.
+   *
+   * @param pDatabase The database to limit.
+   * @param maximumBytes The maximum total size of the cached responses. A
+   * value of zero removes the limit, leaving only that of the wrapped
+   * database.
+   * @param indexFilename The file in which to keep the index of entry sizes.
+   */
+  CesiumCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pDatabase,
+      int64_t maximumBytes,
+      const FString& indexFilename);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * Schedules pruning in a background task, unless it is already scheduled,
+   * and returns immediately.
+   */
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * Evicts entries until the total size is within the budget, then prunes
+   * the wrapped database and saves the index. This is what the background
+   * task runs.
+   */
+  void pruneNow();
+
+  /**
+   * Gets the total size of the entries in the index.
+   */
+  int64_t getSizeBytes() const;
+
+private:
+  struct IndexEntry {
+    int64_t sizeBytes;
+    std::time_t lastAccessTime;
+  };
+
+  void loadIndex();
+  void saveIndex() const;
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pDatabase;
+  int64_t _maximumBytes;
+  FString _indexFilename;
+
+  mutable std::mutex _mutex;
+  mutable std::unordered_map<std::string, IndexEntry> _index;
+  mutable int64_t _sizeBytes;
+
+  std::atomic<bool> _pruneScheduled;
+};
@@ -0,0 +1,316 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCachePrewarmer.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCamera.h"
+#include "CesiumCameraManager.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumGeoreference.h"
+#include "CesiumGeospatial/CartographicPolygon.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumGeospatial/GlobeRectangle.h"
+#include "CesiumRuntime.h"
+#include "CesiumUtility/Math.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include <glm/trigonometric.hpp>
+#include <vector>
+
+using namespace CesiumGeospatial;
+
+namespace {
+
+// Views cover a square footprint twice their height wide, so spacing them by
+// their height gives a generous overlap.
+constexpr double viewFieldOfViewDegrees = 90.0;
+const FVector2D viewViewportSize(1024.0, 1024.0);
+
+// Load progress is only meaningful once the tileset has ticked with the new
+// views, so wait at least this many frames before checking it.
+constexpr int32 minimumFramesPerStep = 2;
+
+constexpr int32 maximumViews = 100000;
+
+} // namespace
+
+bool UCesiumCachePrewarmer::Start() {
+  if (this->_running) {
+    return false;
+  }
+
+  if (!IsValid(this->Tileset) || !IsValid(this->Region)) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Cannot prewarm the cache without a tileset and a region."));
+    return false;
+  }
+
+  CartographicPolygon polygon = this->Region->CreateCartographicPolygon(
+      this->Tileset->GetActorTransform().Inverse());
+  const std::optional<GlobeRectangle>& maybeRectangle =
+      polygon.getBoundingRectangle();
+  if (!maybeRectangle) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("The region %s for prewarming the cache is not a valid polygon."),
+        *this->Region->GetName());
+    return false;
+  }
+
+  const GlobeRectangle& rectangle = *maybeRectangle;
+  const std::vector<CartographicPolygon> polygons{polygon};
+  const double radius = Ellipsoid::WGS84.getMaximumRadius();
+  const double spacingLatitude = this->ViewHeight / radius;
+
+  double west = rectangle.getWest();
+  double east = rectangle.getEast();
+  if (east < west) {
+    east += CesiumUtility::Math::TwoPi;
+  }
+
+  this->_viewLocations.Empty();
+  for (double latitude = rectangle.getSouth() + 0.5 * spacingLatitude;
+       latitude - 0.5 * spacingLatitude < rectangle.getNorth();
+       latitude += spacingLatitude) {
+    const double spacingLongitude =
+        spacingLatitude / FMath::Max(std::cos(latitude), 0.01);
+    for (double longitude = west + 0.5 * spacingLongitude;
+         longitude - 0.5 * spacingLongitude < east;
+         longitude += spacingLongitude) {
+      const double cellLongitude =
+          CesiumUtility::Math::convertLongitudeRange(longitude);
+      GlobeRectangle cell(
+          cellLongitude - 0.5 * spacingLongitude,
+          latitude - 0.5 * spacingLatitude,
+          cellLongitude + 0.5 * spacingLongitude,
+          latitude + 0.5 * spacingLatitude);
+      if (CartographicPolygon::rectangleIsOutsidePolygons(cell, polygons)) {
+        continue;
+      }
+
+      this->_viewLocations.Add(FVector(
+          glm::degrees(cellLongitude),
+          glm::degrees(latitude),
+          this->ViewHeight));
+    }
+
+    if (this->_viewLocations.Num() > maximumViews) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT(
+              "Prewarming the cache over %s would need more than %d views. Increase the view height or use a smaller region."),
+          *this->Region->GetName(),
+          maximumViews);
+      this->_viewLocations.Empty();
+      return false;
+    }
+  }
+
+  this->_pTileset = this->Tileset;
+  this->_originalMaximumScreenSpaceError =
+      this->Tileset->GetMaximumScreenSpaceError();
+  this->_originalMaximumSimultaneousTileLoads =
+      this->Tileset->MaximumSimultaneousTileLoads;
+  this->Tileset->SetMaximumScreenSpaceError(this->MaximumScreenSpaceError);
+  this->Tileset->MaximumSimultaneousTileLoads =
+      this->MaximumSimultaneousTileLoads;
+
+  this->_completedViews = this->loadResumePoint();
+  this->_running = true;
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Prewarming the cache for %s with %d views, starting at view %d"),
+      *this->Tileset->GetName(),
+      this->_viewLocations.Num(),
+      this->_completedViews);
+
+  this->addViews();
+  return true;
+}
+
+void UCesiumCachePrewarmer::Cancel() {
+  if (this->_running) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Cancelled prewarming the cache after %d of %d views"),
+        this->_completedViews,
+        this->_viewLocations.Num());
+    this->finish(false);
+  }
+}
+
+FCesiumCachePrewarmProgress UCesiumCachePrewarmer::GetProgress() const {
+  FCesiumCachePrewarmProgress progress;
+  progress.CompletedViews = this->_completedViews;
+  progress.TotalViews = this->_viewLocations.Num();
+  progress.bIsComplete = !this->_running;
+
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  if (this->_running && pTileset) {
+    progress.CurrentLoadProgress = pTileset->GetLoadProgress();
+  }
+  return progress;
+}
+
+void UCesiumCachePrewarmer::BeginDestroy() {
+  if (this->_running) {
+    this->finish(false);
+  }
+  Super::BeginDestroy();
+}
+
+void UCesiumCachePrewarmer::Tick(float DeltaTime) {
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  if (!pTileset) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Stopped prewarming the cache because the tileset was destroyed"));
+    this->finish(false);
+    return;
+  }
+
+  ++this->_framesSinceStep;
+  if (this->_framesSinceStep < minimumFramesPerStep ||
+      pTileset->GetLoadProgress() < 100.0f) {
+    return;
+  }
+
+  this->removeViews();
+  this->_completedViews += this->_stepViews;
+  this->saveResumePoint();
+  this->OnProgress.Broadcast(this->GetProgress());
+
+  if (this->_completedViews >= this->_viewLocations.Num()) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Finished prewarming the cache for %s"),
+        *pTileset->GetName());
+    this->finish(true);
+    return;
+  }
+
+  this->addViews();
+}
+
+ETickableTickType UCesiumCachePrewarmer::GetTickableTickType() const {
+  return this->HasAnyFlags(RF_ClassDefaultObject)
+             ? ETickableTickType::Never
+             : ETickableTickType::Conditional;
+}
+
+bool UCesiumCachePrewarmer::IsTickable() const { return this->_running; }
+
+bool UCesiumCachePrewarmer::IsTickableWhenPaused() const { return true; }
+
+bool UCesiumCachePrewarmer::IsTickableInEditor() const { return true; }
+
+TStatId UCesiumCachePrewarmer::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCesiumCachePrewarmer, STATGROUP_Tickables);
+}
+
+void UCesiumCachePrewarmer::addViews() {
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  ACesiumGeoreference* pGeoreference =
+      pTileset ? pTileset->ResolveGeoreference() : nullptr;
+  ACesiumCameraManager* pCameraManager =
+      pTileset ? pTileset->ResolveCameraManager() : nullptr;
+  if (!pGeoreference || !pCameraManager) {
+    this->finish(false);
+    return;
+  }
+
+  this->_stepViews = FMath::Min(
+      this->ViewsPerStep,
+      this->_viewLocations.Num() - this->_completedViews);
+  for (int32 i = 0; i < this->_stepViews; ++i) {
+    const FVector location =
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            this->_viewLocations[this->_completedViews + i]);
+    const FRotator rotation =
+        pGeoreference->TransformEastSouthUpRotatorToUnreal(
+            FRotator(-90.0, 0.0, 0.0),
+            location);
+    FCesiumCamera camera(
+        viewViewportSize,
+        location,
+        rotation,
+        viewFieldOfViewDegrees);
+    this->_activeCameraIds.Add(pCameraManager->AddCamera(camera));
+  }
+
+  this->_framesSinceStep = 0;
+}
+
+void UCesiumCachePrewarmer::removeViews() {
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  ACesiumCameraManager* pCameraManager =
+      pTileset ? pTileset->ResolveCameraManager() : nullptr;
+  if (pCameraManager) {
+    for (int32 cameraId : this->_activeCameraIds) {
+      pCameraManager->RemoveCamera(cameraId);
+    }
+  }
+  this->_activeCameraIds.Empty();
+}
+
+void UCesiumCachePrewarmer::finish(bool deleteResumeFile) {
+  this->removeViews();
+
+  ACesium3DTileset* pTileset = this->_pTileset.Get();
+  if (pTileset) {
+    pTileset->SetMaximumScreenSpaceError(
+        this->_originalMaximumScreenSpaceError);
+    pTileset->MaximumSimultaneousTileLoads =
+        this->_originalMaximumSimultaneousTileLoads;
+  }
+
+  if (deleteResumeFile && !this->ResumeFilename.IsEmpty()) {
+    IFileManager::Get().Delete(*this->ResumeFilename);
+  }
+
+  this->_running = false;
+  this->_pTileset.Reset();
+  this->OnComplete.Broadcast(this->GetProgress());
+}
+
+FString UCesiumCachePrewarmer::getResumeSignature() const {
+  // A resume point only applies to the same set of views.
+  return FString::Printf(
+      TEXT("%d %f %f"),
+      this->_viewLocations.Num(),
+      this->ViewHeight,
+      this->MaximumScreenSpaceError);
+}
+
+int32 UCesiumCachePrewarmer::loadResumePoint() const {
+  TArray<FString> lines;
+  if (this->ResumeFilename.IsEmpty() ||
+      !FFileHelper::LoadFileToStringArray(lines, *this->ResumeFilename) ||
+      lines.Num() < 2 || lines[0] != this->getResumeSignature()) {
+    return 0;
+  }
+
+  return FMath::Clamp(
+      FCString::Atoi(*lines[1]),
+      0,
+      this->_viewLocations.Num());
+}
+
+void UCesiumCachePrewarmer::saveResumePoint() const {
+  if (this->ResumeFilename.IsEmpty()) {
+    return;
+  }
+
+  FFileHelper::SaveStringToFile(
+      this->getResumeSignature() + TEXT("\n") +
+          FString::FromInt(this->_completedViews) + TEXT("\n"),
+      *this->ResumeFilename);
+}
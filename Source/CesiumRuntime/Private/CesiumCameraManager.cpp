@@ -114,3 +114,12 @@ bool ACesiumCameraManager::UpdateCamera(
 const TMap<int32, FCesiumCamera>& ACesiumCameraManager::GetCameras() const {
   return this->_cameras;
 }
+
+void ACesiumCameraManager::SetUpcomingCameras(
+    const TArray<FCesiumCamera>& Cameras) {
+  this->_upcomingCameras = Cameras;
+}
+
+const TArray<FCesiumCamera>& ACesiumCameraManager::GetUpcomingCameras() const {
+  return this->_upcomingCameras;
+}
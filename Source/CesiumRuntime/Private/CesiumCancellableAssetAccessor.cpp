@@ -0,0 +1,127 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCancellableAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+const char* cancelledMessage = "The request was cancelled because its "
+                               "tileset was destroyed.";
+
+} // namespace
+
+CesiumCancellableAssetAccessor::CesiumCancellableAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor),
+      _mutex(),
+      _cancelled(false),
+      _nextRequestId(0),
+      _requestsInFlight() {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumCancellableAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (this->isCancelled()) {
+    RequestPromise promise = asyncSystem.createPromise<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>();
+    promise.reject(std::runtime_error(cancelledMessage));
+    return promise.getFuture();
+  }
+  return this->track(
+      asyncSystem,
+      this->_pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumCancellableAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  if (this->isCancelled()) {
+    return this->get(asyncSystem, url, headers);
+  }
+  return this->track(
+      asyncSystem,
+      this->_pAssetAccessor
+          ->request(asyncSystem, verb, url, headers, contentPayload));
+}
+
+void CesiumCancellableAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+void CesiumCancellableAssetAccessor::cancel() {
+  std::unordered_map<uint64_t, RequestPromise> requestsInFlight;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    this->_cancelled = true;
+    requestsInFlight.swap(this->_requestsInFlight);
+  }
+
+  // Rejecting may run continuations immediately, so it is done outside the
+  // lock.
+  for (auto& [id, promise] : requestsInFlight) {
+    promise.reject(std::runtime_error(cancelledMessage));
+  }
+}
+
+bool CesiumCancellableAssetAccessor::isCancelled() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_cancelled;
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumCancellableAssetAccessor::track(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+        request) {
+  RequestPromise promise =
+      asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+  uint64_t id;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    id = this->_nextRequestId++;
+    this->_requestsInFlight.emplace(id, promise);
+  }
+
+  // Whichever of the response and the cancellation comes first settles the
+  // promise. A response that comes after the cancellation is dropped.
+  std::move(request)
+      .thenImmediately(
+          [pThis = this->shared_from_this(), id](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            std::optional<RequestPromise> maybePromise = pThis->take(id);
+            if (maybePromise) {
+              maybePromise->resolve(std::move(pRequest));
+            }
+          })
+      .catchImmediately(
+          [pThis = this->shared_from_this(), id](std::exception&& e) {
+            std::optional<RequestPromise> maybePromise = pThis->take(id);
+            if (maybePromise) {
+              maybePromise->reject(std::runtime_error(e.what()));
+            }
+          });
+
+  return promise.getFuture();
+}
+
+std::optional<CesiumCancellableAssetAccessor::RequestPromise>
+CesiumCancellableAssetAccessor::take(uint64_t id) {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  auto it = this->_requestsInFlight.find(id);
+  if (it == this->_requestsInFlight.end()) {
+    return std::nullopt;
+  }
+  RequestPromise promise = std::move(it->second);
+  this->_requestsInFlight.erase(it);
+  return promise;
+}
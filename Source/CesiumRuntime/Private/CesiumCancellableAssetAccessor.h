@@ -0,0 +1,85 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/Promise.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * An asset accessor through which a single tileset makes its requests, so
+ * that they can all be abandoned when the tileset is destroyed.
+ *
+ * A cesium-native tileset is only destroyed once every load it started has
+ * finished, and the actor waits for that in IsReadyForFinishDestroy. Without
+ * cancellation, a level transition would wait for every pending download of
+ * every tileset. After {@link cancel}, the futures of the requests in flight
+ * are rejected at once and later requests fail immediately, so the loads of
+ * the tileset wind down within a few frames. The requests themselves are left
+ * to complete, since other tilesets may be waiting for the same responses,
+ * and their responses are discarded.
+ */
+class CesiumCancellableAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumCancellableAssetAccessor> {
+public:
+  /**
+   * Creates an accessor.
+   *
+   * @param pAssetAccessor The accessor through which requests are made.
+   */
+  explicit CesiumCancellableAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Rejects the futures of the requests in flight, and makes later requests
+   * fail immediately.
+   */
+  void cancel();
+
+  /**
+   * Determines whether {@link cancel} has been called. This may be called
+   * from any thread, so that work for the tileset can be skipped.
+   */
+  bool isCancelled() const;
+
+private:
+  using RequestPromise =
+      CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> track(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+          request);
+
+  std::optional<RequestPromise> take(uint64_t id);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+
+  mutable std::mutex _mutex;
+  bool _cancelled;
+  uint64_t _nextRequestId;
+  std::unordered_map<uint64_t, RequestPromise> _requestsInFlight;
+};
@@ -0,0 +1,142 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumClusterCullingSceneProxy.h"
+#include "Components/StaticMeshComponent.h"
+#include "MeshBatch.h"
+#include "SceneManagement.h"
+#include "SceneView.h"
+
+FCesiumClusterCullingSceneProxy::FCesiumClusterCullingSceneProxy(
+    UStaticMeshComponent* Component,
+    const TArray<CesiumMeshCluster>& Clusters)
+    : FStaticMeshSceneProxy(Component, false), Clusters(Clusters) {}
+
+SIZE_T FCesiumClusterCullingSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+FPrimitiveViewRelevance
+FCesiumClusterCullingSceneProxy::GetViewRelevance(
+    const FSceneView* View) const {
+  FPrimitiveViewRelevance Result =
+      FStaticMeshSceneProxy::GetViewRelevance(View);
+
+  // The clusters are culled for each view, so the mesh can't be drawn from
+  // the cached static mesh draw commands.
+  if (Result.bStaticRelevance) {
+    Result.bStaticRelevance = false;
+    Result.bDynamicRelevance = true;
+  }
+
+  return Result;
+}
+
+void FCesiumClusterCullingSceneProxy::GetDynamicMeshElements(
+    const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily,
+    uint32 VisibilityMap,
+    FMeshElementCollector& Collector) const {
+  // Views in which a static mesh is already drawn through the dynamic path,
+  // such as when it's selected or in a debug view mode, are drawn as usual.
+  uint32 StaticMeshVisibilityMap = 0;
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex) {
+    if ((VisibilityMap & (1 << ViewIndex)) &&
+        FStaticMeshSceneProxy::GetViewRelevance(Views[ViewIndex])
+            .bDynamicRelevance) {
+      StaticMeshVisibilityMap |= 1 << ViewIndex;
+    }
+  }
+
+  if (StaticMeshVisibilityMap != 0) {
+    FStaticMeshSceneProxy::GetDynamicMeshElements(
+        Views,
+        ViewFamily,
+        StaticMeshVisibilityMap,
+        Collector);
+  }
+
+  const uint8 DepthPriority = this->GetStaticDepthPriorityGroup();
+
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex) {
+    if (!(VisibilityMap & (1 << ViewIndex)) ||
+        (StaticMeshVisibilityMap & (1 << ViewIndex))) {
+      continue;
+    }
+
+    const FSceneView* View = Views[ViewIndex];
+    const int32 LODIndex = this->GetLOD(View);
+
+    FMeshBatch& Mesh = Collector.AllocateMesh();
+    if (!this->GetMeshElement(
+            LODIndex,
+            0,
+            0,
+            DepthPriority,
+            false,
+            true,
+            Mesh)) {
+      continue;
+    }
+
+    // Simplified LODs aren't split into clusters.
+    if (LODIndex != 0) {
+      Collector.AddMesh(ViewIndex, Mesh);
+      continue;
+    }
+
+    if (Mesh.CastShadow) {
+      FMeshBatch& ShadowMesh = Collector.AllocateMesh();
+      ShadowMesh = Mesh;
+      ShadowMesh.bUseForMaterial = false;
+      ShadowMesh.bUseForDepthPass = false;
+      ShadowMesh.bUseAsOccluder = false;
+      Collector.AddMesh(ViewIndex, ShadowMesh);
+      Mesh.CastShadow = false;
+    }
+
+    if (this->CullClusters(*View, Mesh)) {
+      Collector.AddMesh(ViewIndex, Mesh);
+    }
+  }
+}
+
+uint32 FCesiumClusterCullingSceneProxy::GetMemoryFootprint(void) const {
+  return sizeof(*this) + this->GetAllocatedSize() +
+         uint32(this->Clusters.GetAllocatedSize());
+}
+
+bool FCesiumClusterCullingSceneProxy::CullClusters(
+    const FSceneView& View,
+    FMeshBatch& Mesh) const {
+  const FMatrix& LocalToWorld = this->GetLocalToWorld();
+  const double RadiusScale = LocalToWorld.GetMaximumAxisScale();
+
+  const FMeshBatchElement Template = Mesh.Elements[0];
+  Mesh.Elements.Reset();
+
+  for (const CesiumMeshCluster& Cluster : this->Clusters) {
+    const FVector Center =
+        LocalToWorld.TransformPosition(FVector(Cluster.center));
+    if (!View.ViewFrustum.IntersectSphere(
+            Center,
+            float(Cluster.radius * RadiusScale))) {
+      continue;
+    }
+
+    const uint32 FirstIndex = Template.FirstIndex + Cluster.firstIndex;
+    if (!Mesh.Elements.IsEmpty()) {
+      FMeshBatchElement& Last = Mesh.Elements.Last();
+      if (Last.FirstIndex + Last.NumPrimitives * 3 == FirstIndex) {
+        Last.NumPrimitives += Cluster.triangleCount;
+        continue;
+      }
+    }
+
+    FMeshBatchElement& Element = Mesh.Elements.Add_GetRef(Template);
+    Element.FirstIndex = FirstIndex;
+    Element.NumPrimitives = Cluster.triangleCount;
+  }
+
+  return !Mesh.Elements.IsEmpty();
+}
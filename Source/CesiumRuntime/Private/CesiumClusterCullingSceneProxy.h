@@ -0,0 +1,47 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMeshClusters.h"
+#include "StaticMeshSceneProxy.h"
+
+/**
+ * The scene proxy of a tile mesh that has been split into clusters by
+ * {@link CesiumMeshClusters::build}. Instead of being drawn as a whole, the
+ * first LOD of the mesh is drawn through the dynamic path, and only its
+ * clusters whose bounds are in the view frustum are drawn, so that a large
+ * tile that is only partly on screen costs less vertex shading. Shadows are
+ * still cast by the whole mesh, because clusters outside of the view frustum
+ * can cast shadows into it.
+ */
+class FCesiumClusterCullingSceneProxy final : public FStaticMeshSceneProxy {
+public:
+  FCesiumClusterCullingSceneProxy(
+      UStaticMeshComponent* Component,
+      const TArray<CesiumMeshCluster>& Clusters);
+
+  SIZE_T GetTypeHash() const override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual void GetDynamicMeshElements(
+      const TArray<const FSceneView*>& Views,
+      const FSceneViewFamily& ViewFamily,
+      uint32 VisibilityMap,
+      FMeshElementCollector& Collector) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  /**
+   * Replaces the single element of a mesh batch of the first LOD with one
+   * element for each run of consecutive clusters that intersect the view
+   * frustum.
+   *
+   * @returns false if no cluster is visible.
+   */
+  bool CullClusters(const FSceneView& View, FMeshBatch& Mesh) const;
+
+  TArray<CesiumMeshCluster> Clusters;
+};
@@ -0,0 +1,269 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumConvertedTileCache.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTextureCompression.h"
+#include "Hash/CityHash.h"
+#include "Interfaces/IPluginManager.h"
+#include "Rendering/StaticMeshVertexBuffer.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "StaticMeshResources.h"
+#include <CesiumAsync/ICacheDatabase.h>
+#include <cstring>
+#include <ctime>
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Converted results are removed after this long, or earlier when the request
+// cache runs out of space.
+constexpr std::time_t CacheLifetimeSeconds = 30 * 24 * 60 * 60;
+
+// Changed whenever the way that textures are compressed or serialized
+// changes.
+constexpr int32 TextureFormatVersion = 1;
+
+// Changed whenever the way that tangents are generated or serialized changes.
+constexpr int32 TangentFormatVersion = 1;
+
+// The smallest images and meshes whose converted results are cached. Smaller
+// ones are faster to convert than to read from the cache.
+constexpr int64 MinimumTexelCount = 128 * 128;
+constexpr uint32 MinimumVertexCount = 2048;
+
+const FString& getPluginVersion() {
+  static const FString version = []() {
+    TSharedPtr<IPlugin> pPlugin =
+        IPluginManager::Get().FindPlugin(TEXT("CesiumForUnreal"));
+    return pPlugin ? pPlugin->GetDescriptor().VersionName : FString();
+  }();
+  return version;
+}
+
+uint64 hashBytes(const void* pData, size_t size, uint64 seed) {
+  return CityHash64WithSeed(
+      reinterpret_cast<const char*>(pData),
+      uint32(size),
+      seed);
+}
+
+void serializeImage(const ImageCesium& image, TArray<uint8>& data) {
+  FMemoryWriter writer(data);
+  int32 format = int32(image.compressedPixelFormat);
+  int32 mipCount = int32(image.mipPositions.size());
+  writer << format << mipCount;
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    uint64 byteOffset = mip.byteOffset;
+    uint64 byteSize = mip.byteSize;
+    writer << byteOffset << byteSize;
+  }
+  writer.Serialize(
+      const_cast<std::byte*>(image.pixelData.data()),
+      int64(image.pixelData.size()));
+}
+
+bool deserializeImage(const std::vector<std::byte>& data, ImageCesium& image) {
+  FMemoryReaderView reader(TArrayView<const uint8>(
+      reinterpret_cast<const uint8*>(data.data()),
+      int32(data.size())));
+  int32 format = 0;
+  int32 mipCount = 0;
+  reader << format << mipCount;
+  if (reader.IsError() || mipCount < 0) {
+    return false;
+  }
+
+  std::vector<ImageCesiumMipPosition> mipPositions(size_t(mipCount));
+  for (ImageCesiumMipPosition& mip : mipPositions) {
+    uint64 byteOffset = 0;
+    uint64 byteSize = 0;
+    reader << byteOffset << byteSize;
+    mip.byteOffset = size_t(byteOffset);
+    mip.byteSize = size_t(byteSize);
+  }
+  if (reader.IsError()) {
+    return false;
+  }
+
+  std::vector<std::byte> pixelData(size_t(reader.TotalSize() - reader.Tell()));
+  reader.Serialize(pixelData.data(), int64(pixelData.size()));
+  if (reader.IsError()) {
+    return false;
+  }
+
+  image.pixelData = std::move(pixelData);
+  image.mipPositions = std::move(mipPositions);
+  image.compressedPixelFormat = GpuCompressedPixelFormat(format);
+  return true;
+}
+
+} // namespace
+
+namespace CesiumConvertedTileCache {
+
+bool isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->CacheConvertedTileData &&
+         getCacheDatabase();
+}
+
+std::string createKey(
+    const TCHAR* kind,
+    int32 formatVersion,
+    const FString& options,
+    uint64 hash) {
+  // The engine version is part of the key, because the serialized formats of
+  // engine types, such as Chaos meshes, can change between versions.
+  const FString key = FString::Printf(
+      TEXT("cesium-%s:%d:%s:%d.%d:%s:%016llx"),
+      kind,
+      formatVersion,
+      *getPluginVersion(),
+      ENGINE_MAJOR_VERSION,
+      ENGINE_MINOR_VERSION,
+      *options,
+      hash);
+  return TCHAR_TO_UTF8(*key);
+}
+
+std::optional<std::vector<std::byte>> read(const std::string& key) {
+  std::optional<CesiumAsync::CacheItem> maybeItem =
+      getCacheDatabase()->getEntry(key);
+  if (!maybeItem || maybeItem->expiryTime <= std::time(nullptr) ||
+      maybeItem->cacheResponse.data.empty()) {
+    return std::nullopt;
+  }
+  return std::move(maybeItem->cacheResponse.data);
+}
+
+void write(const std::string& key, TArrayView<const uint8> data) {
+  getCacheDatabase()->storeEntry(
+      key,
+      std::time(nullptr) + CacheLifetimeSeconds,
+      key,
+      "GET",
+      CesiumAsync::HttpHeaders(),
+      200,
+      CesiumAsync::HttpHeaders(),
+      gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(data.GetData()),
+          size_t(data.Num())));
+}
+
+bool compressImage(ImageCesium& image) {
+  if (!isEnabled() ||
+      image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      int64(image.width) * int64(image.height) < MinimumTexelCount) {
+    return CesiumTextureCompression::compressImage(image);
+  }
+
+  // The formats that are compressed to depend on the RHI.
+  const FString options = FString::Printf(
+      TEXT("%dx%dx%dx%d:%d:%d:%d"),
+      image.width,
+      image.height,
+      image.channels,
+      image.bytesPerChannel,
+      int32(image.mipPositions.size()),
+      int32(CesiumTextureCompression::getTargetFormat(false)),
+      int32(CesiumTextureCompression::getTargetFormat(true)));
+  uint64 hash = hashBytes(image.pixelData.data(), image.pixelData.size(), 0);
+  for (const ImageCesiumMipPosition& mip : image.mipPositions) {
+    hash = hashBytes(&mip, sizeof(mip), hash);
+  }
+  const std::string key =
+      createKey(TEXT("texture"), TextureFormatVersion, options, hash);
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadCachedTexture)
+    std::optional<std::vector<std::byte>> maybeData = read(key);
+    if (maybeData && deserializeImage(*maybeData, image)) {
+      return true;
+    }
+  }
+
+  if (!CesiumTextureCompression::compressImage(image)) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WriteCachedTexture)
+  TArray<uint8> data;
+  serializeImage(image, data);
+  write(key, data);
+  return true;
+}
+
+void generateTangents(
+    FStaticMeshVertexBuffers& vertexBuffers,
+    const TArray<uint32>& indices,
+    const FString& options,
+    TFunctionRef<void()> generate) {
+  FStaticMeshVertexBuffer& staticMeshVertexBuffer =
+      vertexBuffers.StaticMeshVertexBuffer;
+  const uint32 vertexCount = staticMeshVertexBuffer.GetNumVertices();
+  if (!isEnabled() || vertexCount < MinimumVertexCount) {
+    generate();
+    return;
+  }
+
+  // The tangent data holds the normals until the tangents are generated.
+  FPositionVertexBuffer& positionVertexBuffer =
+      vertexBuffers.PositionVertexBuffer;
+  uint64 hash = hashBytes(
+      positionVertexBuffer.GetVertexData(),
+      size_t(positionVertexBuffer.GetNumVertices()) *
+          positionVertexBuffer.GetStride(),
+      0);
+  hash = hashBytes(
+      staticMeshVertexBuffer.GetTangentData(),
+      staticMeshVertexBuffer.GetTangentSize(),
+      hash);
+  hash = hashBytes(
+      staticMeshVertexBuffer.GetTexCoordData(),
+      staticMeshVertexBuffer.GetTexCoordSize(),
+      hash);
+  hash = hashBytes(
+      indices.GetData(),
+      size_t(indices.Num()) * sizeof(uint32),
+      hash);
+
+  const std::string key = createKey(
+      TEXT("tangents"),
+      TangentFormatVersion,
+      FString::Printf(
+          TEXT("%s:%d:%d:%u:%d"),
+          *options,
+          staticMeshVertexBuffer.GetUseHighPrecisionTangentBasis() ? 1 : 0,
+          staticMeshVertexBuffer.GetUseFullPrecisionUVs() ? 1 : 0,
+          vertexCount,
+          indices.Num()),
+      hash);
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadCachedTangents)
+    std::optional<std::vector<std::byte>> maybeData = read(key);
+    if (maybeData &&
+        maybeData->size() == staticMeshVertexBuffer.GetTangentSize()) {
+      std::memcpy(
+          staticMeshVertexBuffer.GetTangentData(),
+          maybeData->data(),
+          maybeData->size());
+      return;
+    }
+  }
+
+  generate();
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WriteCachedTangents)
+  write(
+      key,
+      TArrayView<const uint8>(
+          static_cast<const uint8*>(staticMeshVertexBuffer.GetTangentData()),
+          int32(staticMeshVertexBuffer.GetTangentSize())));
+}
+
+} // namespace CesiumConvertedTileCache
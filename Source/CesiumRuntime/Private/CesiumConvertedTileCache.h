@@ -0,0 +1,92 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct ImageCesium;
+} // namespace CesiumGltf
+
+struct FStaticMeshVertexBuffers;
+
+/**
+ * A cache of the results of the expensive steps of converting tiles for
+ * Unreal, stored in the request cache alongside the responses they were
+ * converted from: cooked physics meshes, block-compressed textures, and
+ * generated tangents. Tiles that are loaded again, after they were unloaded
+ * or in a later session, then skip those steps.
+ *
+ * Each result is cached under a hash of its inputs, and a version key made of
+ * the format version of that kind of result, the plugin and engine versions,
+ * and the options that affect the result. Results converted by another
+ * version or with other options are therefore never used.
+ *
+ * Only used when Cache Converted Tile Data is enabled in the Cesium runtime
+ * settings. All functions may be called from any thread.
+ */
+namespace CesiumConvertedTileCache {
+
+/**
+ * Checks whether converted results are cached.
+ */
+bool isEnabled();
+
+/**
+ * Creates the key under which a converted result is cached.
+ *
+ * @param kind The kind of result, such as "physics-mesh".
+ * @param formatVersion The version of the way this kind of result is
+ * computed or serialized, changed whenever either changes.
+ * @param options The options that affect the result.
+ * @param hash The hash of the inputs of the result.
+ */
+std::string createKey(
+    const TCHAR* kind,
+    int32 formatVersion,
+    const FString& options,
+    uint64 hash);
+
+/**
+ * Reads a converted result, or returns nothing if it is not cached, or has
+ * expired.
+ */
+std::optional<std::vector<std::byte>> read(const std::string& key);
+
+/**
+ * Stores a converted result.
+ */
+void write(const std::string& key, TArrayView<const uint8> data);
+
+/**
+ * Block-compresses an image with
+ * {@link CesiumTextureCompression::compressImage}, or replaces it with the
+ * cached result of compressing the same image.
+ *
+ * @param image The image to compress in place.
+ * @return True if the image was compressed.
+ */
+bool compressImage(CesiumGltf::ImageCesium& image);
+
+/**
+ * Calls the function to generate the tangents of the vertices, or replaces
+ * the tangents with the cached result of generating them for the same
+ * vertices and triangles. The positions, normals, and texture coordinates
+ * must already be in the vertex buffers.
+ *
+ * @param vertexBuffers The vertex buffers whose tangents to generate.
+ * @param indices The indices of the triangles, three per triangle.
+ * @param options The options of the generation that affect its result.
+ * @param generate The function that generates the tangents.
+ */
+void generateTangents(
+    FStaticMeshVertexBuffers& vertexBuffers,
+    const TArray<uint32>& indices,
+    const FString& options,
+    TFunctionRef<void()> generate);
+
+} // namespace CesiumConvertedTileCache
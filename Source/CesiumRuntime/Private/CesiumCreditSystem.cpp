@@ -1,6 +1,7 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumCreditSystem.h"
+#include "CesiumAsync/AsyncSystem.h"
 #include "CesiumCommon.h"
 #include "CesiumCreditSystemBPLoader.h"
 #include "CesiumRuntime.h"
@@ -8,6 +9,8 @@
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "ScreenCreditsWidget.h"
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <tidybuffio.h>
 #include <vector>
@@ -176,7 +179,7 @@ ACesiumCreditSystem::GetDefaultCreditSystem(const UObject* WorldContextObject) {
 ACesiumCreditSystem::ACesiumCreditSystem()
     : AActor(),
       _pCreditSystem(std::make_shared<CesiumUtility::CreditSystem>()),
-      _lastCreditsCount(0) {
+      _lastCredits() {
   PrimaryActorTick.bCanEverTick = true;
 #if WITH_EDITOR
   this->SetIsSpatiallyLoaded(false);
@@ -260,6 +263,8 @@ void ACesiumCreditSystem::updateCreditsViewport(bool recreateWidget) {
   if (!IsValid(CreditsWidget) || recreateWidget) {
     CreditsWidget =
         CreateWidget<UScreenCreditsWidget>(GetWorld(), CreditsWidgetClass);
+    this->_htmlToRtf.clear();
+    this->_lastCredits.clear();
   }
 
 #if WITH_EDITOR
@@ -336,31 +341,49 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
   const std::vector<CesiumUtility::Credit>& creditsToShowThisFrame =
       _pCreditSystem->getCreditsToShowThisFrame();
 
-  // if the credit list has changed, we want to reformat the credits
+  auto isShownThisFrame = [&creditsToShowThisFrame](
+                              const CesiumUtility::Credit& credit) {
+    return std::find(
+               creditsToShowThisFrame.begin(),
+               creditsToShowThisFrame.end(),
+               credit) != creditsToShowThisFrame.end();
+  };
+
+  // The credits are only reformatted when the set of credits changes, or
+  // when the HTML of some has been parsed, not when cesium-native merely ranks
+  // them differently, which happens on nearly every camera move.
   CreditsUpdated =
-      creditsToShowThisFrame.size() != _lastCreditsCount ||
-      _pCreditSystem->getCreditsToNoLongerShowThisFrame().size() > 0;
+      this->_parsedHtmlChanged ||
+      creditsToShowThisFrame.size() != _lastCredits.size() ||
+      !std::all_of(_lastCredits.begin(), _lastCredits.end(), isShownThisFrame);
+  this->_parsedHtmlChanged = false;
 
   if (CreditsUpdated) {
+    // Credits that are still shown keep their places, and new credits are
+    // added after them, so that the text only changes where credits come and
+    // go.
+    std::vector<CesiumUtility::Credit> credits;
+    credits.reserve(creditsToShowThisFrame.size());
+    std::copy_if(
+        _lastCredits.begin(),
+        _lastCredits.end(),
+        std::back_inserter(credits),
+        isShownThisFrame);
+    for (const CesiumUtility::Credit& credit : creditsToShowThisFrame) {
+      if (std::find(_lastCredits.begin(), _lastCredits.end(), credit) ==
+          _lastCredits.end()) {
+        credits.push_back(credit);
+      }
+    }
+    _lastCredits = std::move(credits);
+
     FString OnScreenCredits;
     FString Credits;
 
-    _lastCreditsCount = creditsToShowThisFrame.size();
-
     bool firstCreditOnScreen = true;
-    for (int i = 0; i < creditsToShowThisFrame.size(); i++) {
-      const CesiumUtility::Credit& credit = creditsToShowThisFrame[i];
-
-      FString CreditRtf;
-      const std::string& html = _pCreditSystem->getHtml(credit);
-
-      auto htmlFind = _htmlToRtf.find(html);
-      if (htmlFind != _htmlToRtf.end()) {
-        CreditRtf = htmlFind->second;
-      } else {
-        CreditRtf = ConvertHtmlToRtf(html);
-        _htmlToRtf.insert({html, CreditRtf});
-      }
+    for (const CesiumUtility::Credit& credit : _lastCredits) {
+      const FString CreditRtf =
+          this->getCreditRtf(_pCreditSystem->getHtml(credit));
 
       if (_pCreditSystem->shouldBeShownOnScreen(credit)) {
         if (firstCreditOnScreen) {
@@ -371,7 +394,7 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
 
         OnScreenCredits += CreditRtf;
       } else {
-        if (i != 0) {
+        if (!Credits.IsEmpty()) {
           Credits += "\n";
         }
 
@@ -389,12 +412,13 @@ void ACesiumCreditSystem::Tick(float DeltaTime) {
 }
 
 namespace {
+// Appends the RTF of a node's children to the last element of the output,
+// and the URLs of their images as elements of their own.
 void convertHtmlToRtf(
-    std::string& output,
+    std::vector<std::string>& output,
     std::string& parentUrl,
     TidyDoc tdoc,
-    TidyNode tnod,
-    UScreenCreditsWidget* CreditsWidget) {
+    TidyNode tnod) {
   TidyNode child;
   TidyBuffer buf;
   tidyBufInit(&buf);
@@ -409,10 +433,10 @@ void convertHtmlToRtf(
           text.pop_back();
         }
         if (!parentUrl.empty()) {
-          output +=
+          output.back() +=
               "<credits url=\"" + parentUrl + "\"" + " text=\"" + text + "\"/>";
         } else {
-          output += text;
+          output.back() += text;
         }
       }
     } else if (tidyNodeGetId(child) == TidyTagId::TidyTag_IMG) {
@@ -420,14 +444,13 @@ void convertHtmlToRtf(
       if (srcAttr) {
         auto srcValue = tidyAttrValue(srcAttr);
         if (srcValue) {
-          output += "<credits id=\"" +
-                    CreditsWidget->LoadImage(
-                        std::string(reinterpret_cast<const char*>(srcValue))) +
-                    "\"";
+          output.back() += "<credits id=\"";
+          output.emplace_back(reinterpret_cast<const char*>(srcValue));
+          output.emplace_back("\"");
           if (!parentUrl.empty()) {
-            output += " url=\"" + parentUrl + "\"";
+            output.back() += " url=\"" + parentUrl + "\"";
           }
-          output += "/>";
+          output.back() += "/>";
         }
       }
     }
@@ -436,13 +459,14 @@ void convertHtmlToRtf(
       auto hrefValue = tidyAttrValue(hrefAttr);
       parentUrl = std::string(reinterpret_cast<const char*>(hrefValue));
     }
-    convertHtmlToRtf(output, parentUrl, tdoc, child, CreditsWidget);
+    convertHtmlToRtf(output, parentUrl, tdoc, child);
   }
   tidyBufFree(&buf);
 }
-} // namespace
 
-FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
+// Converts a credit's HTML to RTF, except for its images. Each call uses a
+// document of its own, so this may be called from any thread.
+std::vector<std::string> parseHtml(std::string html) {
   TidyDoc tdoc;
   TidyBuffer tidy_errbuf = {0};
   int err;
@@ -456,12 +480,73 @@ FString ACesiumCreditSystem::ConvertHtmlToRtf(std::string html) {
 
   html = "<!DOCTYPE html><html><body>" + html + "</body></html>";
 
-  std::string output, url;
+  std::vector<std::string> output(1);
+  std::string url;
   err = tidyParseString(tdoc, html.c_str());
   if (err < 2) {
-    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc), CreditsWidget);
+    convertHtmlToRtf(output, url, tdoc, tidyGetRoot(tdoc));
   }
   tidyBufFree(&tidy_errbuf);
   tidyRelease(tdoc);
-  return UTF8_TO_TCHAR(output.c_str());
+  return output;
+}
+
+// The text of a credit's HTML without its tags, shown until it is parsed.
+FString stripTags(const std::string& html) {
+  std::string text;
+  text.reserve(html.size());
+  bool inTag = false;
+  for (char c : html) {
+    if (c == '<') {
+      inTag = true;
+    } else if (c == '>') {
+      inTag = false;
+    } else if (!inTag) {
+      text += c;
+    }
+  }
+  return UTF8_TO_TCHAR(text.c_str());
+}
+} // namespace
+
+FString ACesiumCreditSystem::getCreditRtf(const std::string& html) {
+  auto rtfIt = this->_htmlToRtf.find(html);
+  if (rtfIt != this->_htmlToRtf.end()) {
+    return rtfIt->second;
+  }
+
+  auto parsedIt = this->_parsedHtml.find(html);
+  if (parsedIt == this->_parsedHtml.end()) {
+    this->parseHtmlInBackground(html);
+    return stripTags(html);
+  }
+
+  // The images are loaded by the current widget, so the RTF is finished here.
+  std::string rtf;
+  const std::vector<std::string>& parsed = parsedIt->second;
+  for (size_t i = 0; i < parsed.size(); ++i) {
+    rtf += i % 2 == 0 ? parsed[i] : this->CreditsWidget->LoadImage(parsed[i]);
+  }
+  return this->_htmlToRtf.emplace(html, UTF8_TO_TCHAR(rtf.c_str()))
+      .first->second;
+}
+
+void ACesiumCreditSystem::parseHtmlInBackground(const std::string& html) {
+  if (!this->_htmlBeingParsed.insert(html).second) {
+    return;
+  }
+
+  getAsyncSystem()
+      .runInWorkerThread([html]() { return parseHtml(html); })
+      .thenInMainThread(
+          [pThis = TWeakObjectPtr<ACesiumCreditSystem>(this),
+           html](std::vector<std::string>&& parsed) {
+            ACesiumCreditSystem* pCreditSystem = pThis.Get();
+            if (!pCreditSystem) {
+              return;
+            }
+            pCreditSystem->_htmlBeingParsed.erase(html);
+            pCreditSystem->_parsedHtml.emplace(html, std::move(parsed));
+            pCreditSystem->_parsedHtmlChanged = true;
+          });
 }
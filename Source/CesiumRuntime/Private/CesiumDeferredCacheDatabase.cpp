@@ -0,0 +1,65 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumDeferredCacheDatabase.h"
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumRuntime.h"
+#include "HAL/PlatformTime.h"
+#include <utility>
+
+CesiumDeferredCacheDatabase::CesiumDeferredCacheDatabase(
+    std::function<std::shared_ptr<CesiumAsync::ICacheDatabase>()>&& create)
+    : _creation(UE::Tasks::Launch(
+          TEXT("CesiumDeferredCacheDatabaseCreation"),
+          [create = std::move(create)]() {
+            const double start = FPlatformTime::Seconds();
+            std::shared_ptr<CesiumAsync::ICacheDatabase> pDatabase = create();
+            UE_LOG(
+                LogCesium,
+                Verbose,
+                TEXT("Opened the Cesium request cache in %.1fms"),
+                (FPlatformTime::Seconds() - start) * 1000.0);
+            return pDatabase;
+          },
+          UE::Tasks::ETaskPriority::BackgroundHigh)) {}
+
+std::optional<CesiumAsync::CacheItem>
+CesiumDeferredCacheDatabase::getEntry(const std::string& key) const {
+  return this->getDatabase()->getEntry(key);
+}
+
+bool CesiumDeferredCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  return this->getDatabase()->storeEntry(
+      key,
+      expiryTime,
+      url,
+      requestMethod,
+      requestHeaders,
+      statusCode,
+      responseHeaders,
+      responseData);
+}
+
+bool CesiumDeferredCacheDatabase::prune() {
+  return this->getDatabase()->prune();
+}
+
+bool CesiumDeferredCacheDatabase::clearAll() {
+  return this->getDatabase()->clearAll();
+}
+
+bool CesiumDeferredCacheDatabase::isReady() const {
+  return this->_creation.IsCompleted();
+}
+
+const std::shared_ptr<CesiumAsync::ICacheDatabase>&
+CesiumDeferredCacheDatabase::getDatabase() const {
+  return this->_creation.GetResult();
+}
@@ -0,0 +1,63 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include "Tasks/Task.h"
+#include <functional>
+#include <memory>
+
+/**
+ * A request cache database that is created in a background task, so that
+ * opening the SQLite connections and reading the index of the on-disk cache
+ * don't hold up the thread that asks for it.
+ *
+ * Each call waits until the database has been created, and is then passed on
+ * to it. Since the first requests of a tileset are only looked up once its
+ * tileset.json is being loaded, they rarely wait at all when the creation is
+ * started early, such as when the module starts up.
+ */
+class CesiumDeferredCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  /**
+   * Starts creating a database.
+   *
+   * @param create The function that creates the database. It is called in a
+   * background task, so it must not touch anything that is only safe to use
+   * from the game thread.
+   */
+  explicit CesiumDeferredCacheDatabase(
+      std::function<std::shared_ptr<CesiumAsync::ICacheDatabase>()>&& create);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+
+  /**
+   * Determines whether the database has been created, so that calls won't
+   * wait for it.
+   */
+  bool isReady() const;
+
+  /**
+   * Waits until the database has been created, and gets it.
+   */
+  const std::shared_ptr<CesiumAsync::ICacheDatabase>& getDatabase() const;
+
+private:
+  mutable UE::Tasks::TTask<std::shared_ptr<CesiumAsync::ICacheDatabase>>
+      _creation;
+};
@@ -13,10 +13,13 @@
 #include "CesiumPropertyTexture.h"
 #include "CesiumRuntime.h"
 #include "Containers/Map.h"
+#include "Hash/CityHash.h"
 #include "PixelFormat.h"
 #include "TextureResource.h"
 #include "UnrealMetadataConversions.h"
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
 #include <CesiumGltf/FeatureIdTextureView.h>
+#include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 #include <glm/gtx/integer.hpp>
 #include <optional>
@@ -96,6 +99,27 @@ encodeFeatureIdAttribute(const FCesiumFeatureIdAttribute& attribute) {
   return result;
 }
 
+/**
+ * Gets the format of a texture that can be created straight from the pixel
+ * data of a feature ID texture's image, so that materials can read the
+ * channels of its feature IDs.
+ */
+std::optional<EPixelFormat>
+getFeatureIdTexturePixelFormat(const CesiumGltf::ImageCesium& image) {
+  if (image.bytesPerChannel != 1) {
+    return std::nullopt;
+  }
+
+  switch (image.channels) {
+  case 1:
+    return EPixelFormat::PF_R8_UINT;
+  case 4:
+    return EPixelFormat::PF_R8G8B8A8_UINT;
+  default:
+    return std::nullopt;
+  }
+}
+
 std::optional<EncodedFeatureIdSet> encodeFeatureIdTexture(
     const FCesiumFeatureIdTexture& texture,
     TMap<const CesiumGltf::ImageCesium*, TWeakPtr<LoadedTextureResult>>&
@@ -141,20 +165,33 @@ std::optional<EncodedFeatureIdSet> encodeFeatureIdTexture(
       addressY = convertGltfWrapTToUnreal(pSampler->wrapT);
     }
 
-    // Copy the image, so that we can keep a copy of it in the glTF.
-    CesiumGltf::ImageCesium imageCopy(*pFeatureIdImage);
-    encodedFeatureIdTexture.pTexture =
-        MakeShared<LoadedTextureResult>(std::move(*loadTextureAnyThreadPart(
-            imageCopy,
+    std::optional<EPixelFormat> pixelFormat =
+        getFeatureIdTexturePixelFormat(*pFeatureIdImage);
+    if (!pixelFormat) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT(
+              "Can't encode feature ID texture with %d channels of %d bytes, skipped."),
+          pFeatureIdImage->channels,
+          pFeatureIdImage->bytesPerChannel);
+      return std::nullopt;
+    }
+
+    // The image stays in the glTF for feature ID lookups on the CPU, so the
+    // texture is created from it without taking its pixel data.
+    TUniquePtr<LoadedTextureResult> pTexture =
+        loadTextureFromRetainedImageAnyThreadPart(
+            *pFeatureIdImage,
             addressX,
             addressY,
-            TextureFilter::TF_Nearest,
-            false,
             TEXTUREGROUP_8BitData,
-            false,
-            // TODO: currently this is always the case, but doesn't have to be
-            EPixelFormat::PF_R8G8B8A8_UINT,
-            nullptr)));
+            *pixelFormat);
+    if (!pTexture) {
+      return std::nullopt;
+    }
+    encodedFeatureIdTexture.pTexture =
+        MakeShared<LoadedTextureResult>(MoveTemp(*pTexture));
     featureIdTextureMap.Emplace(
         pFeatureIdImage,
         encodedFeatureIdTexture.pTexture);
@@ -164,13 +201,118 @@ std::optional<EncodedFeatureIdSet> encodeFeatureIdTexture(
 }
 } // namespace
 
+FeatureIdSetParameterNames
+FeatureIdSetParameterNames::create(const FString& featureIdSetName) {
+  FeatureIdSetParameterNames names;
+  names.nullFeatureId = FName(featureIdSetName + MaterialNullFeatureIdSuffix);
+  names.texture = FName(featureIdSetName + MaterialTextureSuffix);
+  names.numChannels = FName(featureIdSetName + MaterialNumChannelsSuffix);
+  names.channels = FName(featureIdSetName + MaterialChannelsSuffix);
+  names.textureScaleOffset =
+      FName(featureIdSetName + MaterialTextureScaleOffsetSuffix);
+  names.textureRotation =
+      FName(featureIdSetName + MaterialTextureRotationSuffix);
+  return names;
+}
+
+PropertyParameterNames
+PropertyParameterNames::create(const FString& materialName) {
+  PropertyParameterNames names;
+  names.texture = FName(materialName);
+  names.offset = FName(materialName + MaterialPropertyOffsetSuffix);
+  names.scale = FName(materialName + MaterialPropertyScaleSuffix);
+  names.noData = FName(materialName + MaterialPropertyNoDataSuffix);
+  names.defaultValue =
+      FName(materialName + MaterialPropertyDefaultValueSuffix);
+  names.hasValue = FName(materialName + MaterialPropertyHasValueSuffix);
+  names.channels = FName(materialName + MaterialChannelsSuffix);
+  names.textureScaleOffset =
+      FName(materialName + MaterialTextureScaleOffsetSuffix);
+  names.textureRotation = FName(materialName + MaterialTextureRotationSuffix);
+  return names;
+}
+
+ModelMetadataDescriptionIndex::ModelMetadataDescriptionIndex(
+    const FCesiumModelMetadataDescription& description) {
+  this->_propertyTables.Reserve(description.PropertyTables.Num());
+  for (const FCesiumPropertyTableDescription& propertyTable :
+       description.PropertyTables) {
+    if (this->_propertyTables.Contains(propertyTable.Name)) {
+      continue;
+    }
+
+    PropertyTableDescriptionIndex& index = this->_propertyTables.Add(
+        propertyTable.Name,
+        {&propertyTable,
+         DescriptionsByName<FCesiumPropertyTablePropertyDescription>(
+             propertyTable.Properties)});
+
+    // Build the names of the material parameters once here, rather than for
+    // every tile that encodes the property table.
+    index.parameterNames.Reserve(propertyTable.Properties.Num());
+    for (const FCesiumPropertyTablePropertyDescription& property :
+         propertyTable.Properties) {
+      if (!index.parameterNames.Contains(property.Name)) {
+        index.parameterNames.Add(
+            property.Name,
+            PropertyParameterNames::create(
+                getMaterialNameForPropertyTableProperty(
+                    propertyTable.Name,
+                    createHlslSafeName(property.Name))));
+      }
+    }
+  }
+
+  this->_propertyTextures.Reserve(description.PropertyTextures.Num());
+  for (const FCesiumPropertyTextureDescription& propertyTexture :
+       description.PropertyTextures) {
+    if (this->_propertyTextures.Contains(propertyTexture.Name)) {
+      continue;
+    }
+
+    PropertyTextureDescriptionIndex& index = this->_propertyTextures.Add(
+        propertyTexture.Name,
+        {&propertyTexture,
+         DescriptionsByName<FCesiumPropertyTexturePropertyDescription>(
+             propertyTexture.Properties)});
+
+    index.parameterNames.Reserve(propertyTexture.Properties.Num());
+    for (const FCesiumPropertyTexturePropertyDescription& property :
+         propertyTexture.Properties) {
+      if (!index.parameterNames.Contains(property.Name)) {
+        index.parameterNames.Add(
+            property.Name,
+            PropertyParameterNames::create(
+                getMaterialNameForPropertyTextureProperty(
+                    propertyTexture.Name,
+                    createHlslSafeName(property.Name))));
+      }
+    }
+  }
+}
+
+IndexedFeaturesMetadataDescription::IndexedFeaturesMetadataDescription(
+    FCesiumFeaturesMetadataDescription&& description)
+    : _description(MoveTemp(description)),
+      _featureIdSets(this->_description.Features.FeatureIdSets),
+      _modelMetadata(this->_description.ModelMetadata) {}
+
 EncodedPrimitiveFeatures encodePrimitiveFeaturesAnyThreadPart(
     const FCesiumPrimitiveFeaturesDescription& featuresDescription,
-    const FCesiumPrimitiveFeatures& features) {
+    const FCesiumPrimitiveFeatures& features,
+    const DescriptionsByName<FCesiumFeatureIdSetDescription>*
+        pFeatureIdSetIndex) {
   EncodedPrimitiveFeatures result;
 
   const TArray<FCesiumFeatureIdSetDescription>& featureIDSetDescriptions =
       featuresDescription.FeatureIdSets;
+
+  std::optional<DescriptionsByName<FCesiumFeatureIdSetDescription>>
+      localIndex;
+  if (!pFeatureIdSetIndex) {
+    pFeatureIdSetIndex = &localIndex.emplace(featureIDSetDescriptions);
+  }
+
   result.featureIdSets.Reserve(featureIDSetDescriptions.Num());
 
   // Not all feature ID sets are necessarily textures, but reserve the max
@@ -187,11 +329,7 @@ EncodedPrimitiveFeatures encodePrimitiveFeaturesAnyThreadPart(
     const FCesiumFeatureIdSet& set = featureIdSets[i];
     FString name = getNameForFeatureIDSet(set, featureIdTextureCounter);
     const FCesiumFeatureIdSetDescription* pDescription =
-        featureIDSetDescriptions.FindByPredicate(
-            [&name](
-                const FCesiumFeatureIdSetDescription& existingFeatureIDSet) {
-              return existingFeatureIDSet.Name == name;
-            });
+        pFeatureIdSetIndex->find(name);
 
     if (!pDescription) {
       // The description doesn't need this feature ID set, skip.
@@ -222,6 +360,8 @@ EncodedPrimitiveFeatures encodePrimitiveFeaturesAnyThreadPart(
     encodedSet->propertyTableName = pDescription->PropertyTableName;
     encodedSet->nullFeatureId =
         UCesiumFeatureIdSetBlueprintLibrary::GetNullFeatureID(set);
+    encodedSet->parameterNames =
+        FeatureIdSetParameterNames::create(createHlslSafeName(name));
 
     result.featureIdSets.Add(*encodedSet);
   }
@@ -453,16 +593,120 @@ bool isValidPropertyTexturePropertyDescription(
   return true;
 }
 
+/**
+ * Adds the bytes of a glTF buffer view to a hash. Returns false if the buffer
+ * view doesn't exist or is outside of its buffer.
+ */
+bool hashBufferView(
+    const CesiumGltf::Model& model,
+    int32_t bufferViewIndex,
+    uint64& hash) {
+  const CesiumGltf::BufferView* pBufferView =
+      CesiumGltf::Model::getSafe(&model.bufferViews, bufferViewIndex);
+  if (!pBufferView) {
+    return false;
+  }
+
+  const CesiumGltf::Buffer* pBuffer =
+      CesiumGltf::Model::getSafe(&model.buffers, pBufferView->buffer);
+  if (!pBuffer || pBufferView->byteOffset < 0 ||
+      pBufferView->byteLength < 0 ||
+      pBufferView->byteOffset + pBufferView->byteLength >
+          int64_t(pBuffer->cesium.data.size())) {
+    return false;
+  }
+
+  hash = CityHash64WithSeed(
+      reinterpret_cast<const char*>(
+          pBuffer->cesium.data.data() + pBufferView->byteOffset),
+      uint32(pBufferView->byteLength),
+      hash);
+  return true;
+}
+
+/**
+ * Creates the key that the texture of an encoded property table property is
+ * shared with, from the property's values in the glTF buffers and how they
+ * are encoded. Each texture is encoded from nothing else, so tiles that use
+ * the same property table, such as an external one, share their textures
+ * without encoding them again.
+ */
+std::optional<uint64> createPropertyTablePropertySourceKey(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::PropertyTable& gltfPropertyTable,
+    const FString& propertyId,
+    const FCesiumPropertyTablePropertyDescription& propertyDescription,
+    const FCesiumPropertyTableProperty& property,
+    const EncodedPixelFormat& encodedFormat) {
+  auto it = gltfPropertyTable.properties.find(TCHAR_TO_UTF8(*propertyId));
+  if (it == gltfPropertyTable.properties.end()) {
+    return std::nullopt;
+  }
+
+  const CesiumGltf::PropertyTableProperty& gltfProperty = it->second;
+  const FCesiumMetadataValueType valueType =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(property);
+  const FCesiumMetadataEncodingDetails& encodingDetails =
+      propertyDescription.EncodingDetails;
+  const int64 settings[] = {
+      gltfPropertyTable.count,
+      int64(valueType.Type),
+      int64(valueType.ComponentType),
+      int64(valueType.bIsArray),
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetArraySize(property),
+      int64(UCesiumPropertyTablePropertyBlueprintLibrary::IsNormalized(
+          property)),
+      int64(encodingDetails.Type),
+      int64(encodingDetails.ComponentType),
+      int64(encodingDetails.Conversion),
+      int64(encodedFormat.format)};
+  uint64 hash =
+      CityHash64(reinterpret_cast<const char*>(settings), sizeof(settings));
+  hash = CityHash64WithSeed(
+      gltfProperty.arrayOffsetType.data(),
+      uint32(gltfProperty.arrayOffsetType.size()),
+      hash);
+  hash = CityHash64WithSeed(
+      gltfProperty.stringOffsetType.data(),
+      uint32(gltfProperty.stringOffsetType.size()),
+      hash);
+
+  if (!hashBufferView(model, gltfProperty.values, hash)) {
+    return std::nullopt;
+  }
+  if (gltfProperty.arrayOffsets >= 0 &&
+      !hashBufferView(model, gltfProperty.arrayOffsets, hash)) {
+    return std::nullopt;
+  }
+  if (gltfProperty.stringOffsets >= 0 &&
+      !hashBufferView(model, gltfProperty.stringOffsets, hash)) {
+    return std::nullopt;
+  }
+
+  return hash;
+}
+
 } // namespace
 
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
     const FCesiumPropertyTableDescription& propertyTableDescription,
-    const FCesiumPropertyTable& propertyTable) {
+    const FCesiumPropertyTable& propertyTable,
+    const CesiumGltf::Model* pModel,
+    const CesiumGltf::PropertyTable* pGltfPropertyTable,
+    const DescriptionsByName<FCesiumPropertyTablePropertyDescription>*
+        pPropertyIndex,
+    const TMap<FString, PropertyParameterNames>* pParameterNames) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTable)
 
   EncodedPropertyTable encodedPropertyTable;
 
+  std::optional<DescriptionsByName<FCesiumPropertyTablePropertyDescription>>
+      localIndex;
+  if (!pPropertyIndex) {
+    pPropertyIndex = &localIndex.emplace(propertyTableDescription.Properties);
+  }
+
   int64 propertyTableCount =
       UCesiumPropertyTableBlueprintLibrary::GetPropertyTableCount(
           propertyTable);
@@ -475,11 +719,7 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     const FCesiumPropertyTableProperty& property = pair.Value;
 
     const FCesiumPropertyTablePropertyDescription* pDescription =
-        propertyTableDescription.Properties.FindByPredicate(
-            [&key = pair.Key](const FCesiumPropertyTablePropertyDescription&
-                                  expectedProperty) {
-              return key == expectedProperty.Name;
-            });
+        pPropertyIndex->find(pair.Key);
 
     if (!pDescription) {
       continue;
@@ -535,49 +775,80 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
     encodedProperty.name = createHlslSafeName(pDescription->Name);
     encodedProperty.type = pDescription->EncodingDetails.Type;
 
+    const PropertyParameterNames* pNames =
+        pParameterNames ? pParameterNames->Find(pDescription->Name) : nullptr;
+    encodedProperty.parameterNames =
+        pNames ? *pNames
+               : PropertyParameterNames::create(
+                     getMaterialNameForPropertyTableProperty(
+                         propertyTableDescription.Name,
+                         encodedProperty.name));
+
     if (UCesiumPropertyTablePropertyBlueprintLibrary::
             GetPropertyTablePropertyStatus(property) ==
         ECesiumPropertyTablePropertyStatus::Valid) {
-
-      int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
-      int64 textureDimension =
-          (floorSqrtFeatureCount * floorSqrtFeatureCount == propertyTableCount)
-              ? floorSqrtFeatureCount
-              : (floorSqrtFeatureCount + 1);
-
-      CesiumGltf::ImageCesium image;
-      image.width = image.height = textureDimension;
-      image.bytesPerChannel = encodedFormat.bytesPerChannel;
-      image.channels = encodedFormat.channels;
-      image.pixelData.resize(
-          textureDimension * textureDimension * encodedFormat.bytesPerChannel *
-          encodedFormat.channels);
-
-      if (encodingDetails.Conversion ==
-          ECesiumEncodedMetadataConversion::ParseColorFromString) {
-        CesiumEncodedMetadataParseColorFromString::encode(
-            *pDescription,
-            property,
-            gsl::span(image.pixelData),
-            encodedFormat.bytesPerChannel * encodedFormat.channels);
-      } else /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
-        CesiumEncodedMetadataCoerce::encode(
+      std::optional<uint64> sourceKey;
+      if (pModel && pGltfPropertyTable) {
+        sourceKey = createPropertyTablePropertySourceKey(
+            *pModel,
+            *pGltfPropertyTable,
+            pair.Key,
             *pDescription,
             property,
-            gsl::span(image.pixelData),
+            encodedFormat);
+      }
+
+      if (sourceKey) {
+        encodedProperty.pTexture = loadSharedTextureAnyThreadPart(*sourceKey);
+      }
+
+      if (!encodedProperty.pTexture) {
+        int64 floorSqrtFeatureCount = glm::sqrt(propertyTableCount);
+        const bool isSquare =
+            floorSqrtFeatureCount * floorSqrtFeatureCount == propertyTableCount;
+        int64 textureDimension =
+            isSquare ? floorSqrtFeatureCount : (floorSqrtFeatureCount + 1);
+
+        CesiumGltf::ImageCesium image;
+        image.width = image.height = textureDimension;
+        image.bytesPerChannel = encodedFormat.bytesPerChannel;
+        image.channels = encodedFormat.channels;
+        image.pixelData.resize(
+            textureDimension * textureDimension *
             encodedFormat.bytesPerChannel * encodedFormat.channels);
+
+        if (encodingDetails.Conversion ==
+            ECesiumEncodedMetadataConversion::ParseColorFromString) {
+          CesiumEncodedMetadataParseColorFromString::encode(
+              *pDescription,
+              property,
+              gsl::span(image.pixelData),
+              encodedFormat.bytesPerChannel * encodedFormat.channels);
+        } else
+        /* info.Conversion == ECesiumEncodedMetadataConversion::Coerce */ {
+          CesiumEncodedMetadataCoerce::encode(
+              *pDescription,
+              property,
+              gsl::span(image.pixelData),
+              encodedFormat.bytesPerChannel * encodedFormat.channels);
+        }
+
+        encodedProperty.pTexture = loadTextureAnyThreadPart(
+            image,
+            TextureAddress::TA_Clamp,
+            TextureAddress::TA_Clamp,
+            TextureFilter::TF_Nearest,
+            false,
+            TEXTUREGROUP_8BitData,
+            false,
+            encodedFormat.format,
+            nullptr,
+            false,
+            sourceKey);
       }
 
-      encodedProperty.pTexture = loadTextureAnyThreadPart(
-          image,
-          TextureAddress::TA_Clamp,
-          TextureAddress::TA_Clamp,
-          TextureFilter::TF_Nearest,
-          false,
-          TEXTUREGROUP_8BitData,
-          false,
-          encodedFormat.format,
-          nullptr);
+      encodedProperty.statistics =
+          CesiumTilePropertyStatistics::compute(property);
     }
 
     if (pDescription->PropertyDetails.bHasOffset) {
@@ -624,16 +895,79 @@ EncodedPropertyTable encodePropertyTableAnyThreadPart(
   return encodedPropertyTable;
 }
 
+EncodedPropertyTableProperty encodeFeatureStyleAnyThreadPart(
+    const FString& propertyTableName,
+    const TArray<FColor>& featureColors) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeFeatureStyle)
+
+  EncodedPropertyTableProperty encodedProperty;
+  encodedProperty.name = FeatureStylePropertyName;
+  encodedProperty.type = ECesiumEncodedMetadataType::Vec4;
+  encodedProperty.parameterNames = PropertyParameterNames::create(
+      getMaterialNameForPropertyTableProperty(
+          propertyTableName,
+          FeatureStylePropertyName));
+
+  const int64 featureCount = featureColors.Num();
+  if (featureCount == 0) {
+    return encodedProperty;
+  }
+
+  int64 floorSqrtFeatureCount = glm::sqrt(featureCount);
+  const bool isSquare =
+      floorSqrtFeatureCount * floorSqrtFeatureCount == featureCount;
+  int64 textureDimension =
+      isSquare ? floorSqrtFeatureCount : (floorSqrtFeatureCount + 1);
+
+  CesiumGltf::ImageCesium image;
+  image.width = image.height = int32_t(textureDimension);
+  image.bytesPerChannel = 1;
+  image.channels = 4;
+  image.pixelData.resize(textureDimension * textureDimension * 4);
+
+  std::byte* pPixel = image.pixelData.data();
+  for (const FColor& color : featureColors) {
+    pPixel[0] = std::byte(color.R);
+    pPixel[1] = std::byte(color.G);
+    pPixel[2] = std::byte(color.B);
+    pPixel[3] = std::byte(color.A);
+    pPixel += 4;
+  }
+
+  encodedProperty.pTexture = loadTextureAnyThreadPart(
+      image,
+      TextureAddress::TA_Clamp,
+      TextureAddress::TA_Clamp,
+      TextureFilter::TF_Nearest,
+      false,
+      TEXTUREGROUP_8BitData,
+      false,
+      EPixelFormat::PF_R8G8B8A8,
+      nullptr);
+
+  return encodedProperty;
+}
+
 EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     const FCesiumPropertyTextureDescription& propertyTextureDescription,
     const FCesiumPropertyTexture& propertyTexture,
     TMap<const CesiumGltf::ImageCesium*, TWeakPtr<LoadedTextureResult>>&
-        propertyTexturePropertyMap) {
+        propertyTexturePropertyMap,
+    const DescriptionsByName<FCesiumPropertyTexturePropertyDescription>*
+        pPropertyIndex,
+    const TMap<FString, PropertyParameterNames>* pParameterNames) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTexture)
 
   EncodedPropertyTexture encodedPropertyTexture;
 
+  std::optional<DescriptionsByName<FCesiumPropertyTexturePropertyDescription>>
+      localIndex;
+  if (!pPropertyIndex) {
+    pPropertyIndex =
+        &localIndex.emplace(propertyTextureDescription.Properties);
+  }
+
   const TMap<FString, FCesiumPropertyTextureProperty>& properties =
       UCesiumPropertyTextureBlueprintLibrary::GetProperties(propertyTexture);
 
@@ -643,11 +977,7 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     const FCesiumPropertyTextureProperty& property = pair.Value;
 
     const FCesiumPropertyTexturePropertyDescription* pDescription =
-        propertyTextureDescription.Properties.FindByPredicate(
-            [&key = pair.Key](const FCesiumPropertyTexturePropertyDescription&
-                                  expectedProperty) {
-              return key == expectedProperty.Name;
-            });
+        pPropertyIndex->find(pair.Key);
 
     if (!pDescription) {
       continue;
@@ -663,6 +993,15 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     encodedProperty.name = createHlslSafeName(pDescription->Name);
     encodedProperty.type =
         CesiumMetadataTypeToEncodingType(pDescription->PropertyDetails.Type);
+
+    const PropertyParameterNames* pNames =
+        pParameterNames ? pParameterNames->Find(pDescription->Name) : nullptr;
+    encodedProperty.parameterNames =
+        pNames ? *pNames
+               : PropertyParameterNames::create(
+                     getMaterialNameForPropertyTextureProperty(
+                         propertyTextureDescription.Name,
+                         encodedProperty.name));
     encodedProperty.textureCoordinateSetIndex = property.getTexCoordSetIndex();
 
     if (UCesiumPropertyTexturePropertyBlueprintLibrary::
@@ -692,22 +1031,22 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
           addressY = convertGltfWrapTToUnreal(pSampler->wrapT);
         }
 
-        // Copy the image, so that we can keep a copy of it in the glTF.
-        CesiumGltf::ImageCesium imageCopy(*pImage);
-        encodedProperty.pTexture =
-            MakeShared<LoadedTextureResult>(std::move(*loadTextureAnyThreadPart(
-                imageCopy,
+        // The image stays in the glTF for property lookups on the CPU, so the
+        // texture is created from it without taking its pixel data.
+        // TODO: account for texture filter
+        TUniquePtr<LoadedTextureResult> pTexture =
+            loadTextureFromRetainedImageAnyThreadPart(
+                *pImage,
                 addressX,
                 addressY,
-                // TODO: account for texture filter
-                TextureFilter::TF_Nearest,
-                false,
                 TEXTUREGROUP_8BitData,
-                false,
                 // This assumes that the texture's image only contains one byte
                 // per channel.
-                EPixelFormat::PF_R8G8B8A8_UINT,
-                nullptr)));
+                EPixelFormat::PF_R8G8B8A8_UINT);
+        if (pTexture) {
+          encodedProperty.pTexture =
+              MakeShared<LoadedTextureResult>(MoveTemp(*pTexture));
+        }
         propertyTexturePropertyMap.Emplace(pImage, encodedProperty.pTexture);
       }
     };
@@ -773,32 +1112,49 @@ EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
 
 EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
-    const FCesiumModelMetadata& metadata) {
+    const FCesiumModelMetadata& metadata,
+    const CesiumGltf::Model* pModel,
+    const ModelMetadataDescriptionIndex* pIndex) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeModelMetadata)
 
   EncodedModelMetadata result;
 
+  std::optional<ModelMetadataDescriptionIndex> localIndex;
+  if (!pIndex) {
+    pIndex = &localIndex.emplace(metadataDescription);
+  }
+
+  // The property tables of the metadata were created from those of the
+  // model's extension, in the same order.
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pExtension =
+      pModel ? pModel->getExtension<
+                   CesiumGltf::ExtensionModelExtStructuralMetadata>()
+             : nullptr;
+
   const TArray<FCesiumPropertyTable>& propertyTables =
       UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(metadata);
   result.propertyTables.Reserve(propertyTables.Num());
-  for (const auto& propertyTable : propertyTables) {
+  for (int32 i = 0; i < propertyTables.Num(); ++i) {
+    const FCesiumPropertyTable& propertyTable = propertyTables[i];
     const FString propertyTableName = getNameForPropertyTable(propertyTable);
 
-    const FCesiumPropertyTableDescription* pExpectedPropertyTable =
-        metadataDescription.PropertyTables.FindByPredicate(
-            [&propertyTableName](
-                const FCesiumPropertyTableDescription& expectedPropertyTable) {
-              return propertyTableName == expectedPropertyTable.Name;
-            });
+    const PropertyTableDescriptionIndex* pExpectedPropertyTable =
+        pIndex->findPropertyTable(propertyTableName);
 
     if (pExpectedPropertyTable) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTable)
 
       auto& encodedPropertyTable =
           result.propertyTables.Emplace_GetRef(encodePropertyTableAnyThreadPart(
-              *pExpectedPropertyTable,
-              propertyTable));
+              *pExpectedPropertyTable->pDescription,
+              propertyTable,
+              pModel,
+              pExtension && size_t(i) < pExtension->propertyTables.size()
+                  ? &pExtension->propertyTables[size_t(i)]
+                  : nullptr,
+              &pExpectedPropertyTable->properties,
+              &pExpectedPropertyTable->parameterNames));
       encodedPropertyTable.name = propertyTableName;
     }
   }
@@ -815,21 +1171,19 @@ EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FString propertyTextureName =
         getNameForPropertyTexture(propertyTexture);
 
-    const FCesiumPropertyTextureDescription* pExpectedPropertyTexture =
-        metadataDescription.PropertyTextures.FindByPredicate(
-            [&propertyTextureName](const FCesiumPropertyTextureDescription&
-                                       expectedPropertyTexture) {
-              return propertyTextureName == expectedPropertyTexture.Name;
-            });
+    const PropertyTextureDescriptionIndex* pExpectedPropertyTexture =
+        pIndex->findPropertyTexture(propertyTextureName);
 
     if (pExpectedPropertyTexture) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodePropertyTexture)
 
       auto& encodedPropertyTexture = result.propertyTextures.Emplace_GetRef(
           encodePropertyTextureAnyThreadPart(
-              *pExpectedPropertyTexture,
+              *pExpectedPropertyTexture->pDescription,
               propertyTexture,
-              propertyTexturePropertyMap));
+              propertyTexturePropertyMap,
+              &pExpectedPropertyTexture->properties,
+              &pExpectedPropertyTexture->parameterNames));
       encodedPropertyTexture.name = propertyTextureName;
     }
   }
@@ -2,15 +2,18 @@
 
 #pragma once
 
+#include "CesiumFeaturesMetadataComponent.h"
 #include "CesiumMetadataEncodingDetails.h"
 #include "CesiumMetadataValue.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTilePropertyStatistics.h"
 #include "Containers/Array.h"
 #include "Containers/Map.h"
 #include "Containers/UnrealString.h"
 #include "Templates/SharedPointer.h"
 #include "Templates/UniquePtr.h"
 #include <CesiumGltf/KhrTextureTransform.h>
+#include <optional>
 #include <variant>
 
 struct FCesiumFeatureIdSet;
@@ -27,6 +30,11 @@ struct FCesiumModelMetadataDescription;
 struct FCesiumPrimitiveFeaturesDescription;
 struct FCesiumPrimitiveMetadataDescription;
 
+namespace CesiumGltf {
+struct Model;
+struct PropertyTable;
+} // namespace CesiumGltf
+
 /**
  * @brief Provides utility for encoding feature IDs from EXT_mesh_features and
  * metadata from EXT_structural_metadata. "Encoding" refers broadly to the
@@ -57,6 +65,12 @@ static const FString MaterialNumChannelsSuffix = "_NUM_CHANNELS";
  */
 static const FString MaterialNullFeatureIdSuffix = "_NULL_ID";
 
+/**
+ * - Feature ID packing node, when feature IDs are packed: FeatureIDSetName +
+ *   "_PACKING"
+ */
+static const FString MaterialFeatureIdPackingSuffix = "_PACKING";
+
 /**
  * Naming convention for metadata parameter nodes
  * - Property Table Property: "PTABLE_" + PropertyTableName + PropertyName
@@ -103,6 +117,25 @@ static const FString MaterialPropertyRawSuffix = "_RAW";
 static const FString MaterialPropertyValueSuffix = "_VALUE";
 static const FString MaterialPropertyUVSuffix = "_UV";
 
+/**
+ * The name of the property that holds the colors of the features of a property
+ * table, as evaluated from the Style of a UCesiumFeaturesMetadataComponent. Its
+ * texture is a parameter of the material like those of the other properties of
+ * the property table, such as "PTABLE_buildings_CESIUM_STYLE", and holds the
+ * sRGB color of each feature with its alpha, or zero alpha if the feature is
+ * hidden.
+ */
+static const FString FeatureStylePropertyName = "CESIUM_STYLE";
+
+/**
+ * The name of the property that holds the state flags of the features of a
+ * property table, as set with UCesiumFeatureStateBlueprintLibrary. Its texture
+ * is a parameter of the material like those of the other properties of the
+ * property table, such as "PTABLE_buildings_CESIUM_STATE", and holds the
+ * flags of each feature in its red channel, divided by 255.
+ */
+static const FString FeatureStatePropertyName = "CESIUM_STATE";
+
 /**
  * Naming convention for KHR_texture_transform inputs:
  *  - Texture Scale + Offset: TextureName + "_TX_SCALE_OFFSET"
@@ -111,6 +144,187 @@ static const FString MaterialPropertyUVSuffix = "_UV";
 static const FString MaterialTextureScaleOffsetSuffix = "_TX_SCALE_OFFSET";
 static const FString MaterialTextureRotationSuffix = "_TX_ROTATION";
 
+/**
+ * @brief The names of the material parameters of an encoded feature ID set.
+ * They are created when the feature ID set is encoded, so that setting the
+ * parameters of the tile's materials doesn't build any names.
+ */
+struct FeatureIdSetParameterNames {
+  FName nullFeatureId;
+  FName texture;
+  FName numChannels;
+  FName channels;
+  FName textureScaleOffset;
+  FName textureRotation;
+
+  /**
+   * @brief Creates the names of the parameters of the feature ID set with the
+   * given HLSL-safe name.
+   */
+  static FeatureIdSetParameterNames create(const FString& featureIdSetName);
+};
+
+/**
+ * @brief The names of the material parameters of an encoded property table
+ * property or property texture property. They are created once for each
+ * property of a description, so that setting the parameters of the materials
+ * of every tile doesn't build any names.
+ */
+struct PropertyParameterNames {
+  FName texture;
+  FName offset;
+  FName scale;
+  FName noData;
+  FName defaultValue;
+  FName hasValue;
+
+  // These are only used by property texture properties.
+  FName channels;
+  FName textureScaleOffset;
+  FName textureRotation;
+
+  /**
+   * @brief Creates the names of the parameters of the property with the given
+   * material name, such as one returned by
+   * getMaterialNameForPropertyTableProperty.
+   */
+  static PropertyParameterNames create(const FString& materialName);
+};
+
+#pragma region Description Indices
+
+/**
+ * @brief Finds the descriptions with a given name in an array of descriptions,
+ * such as the feature ID sets or property table properties of a
+ * FCesiumFeaturesMetadataDescription, without searching the whole array for
+ * each name.
+ *
+ * The index points into the array, so the array must outlive it and must not
+ * be modified while it is used. Like a search of the array, names compare
+ * case-insensitively, and the first of several descriptions with the same name
+ * is found.
+ */
+template <typename TDescription> class DescriptionsByName {
+public:
+  DescriptionsByName() = default;
+
+  explicit DescriptionsByName(const TArray<TDescription>& descriptions) {
+    this->_descriptions.Reserve(descriptions.Num());
+    for (const TDescription& description : descriptions) {
+      if (!this->_descriptions.Contains(description.Name)) {
+        this->_descriptions.Add(description.Name, &description);
+      }
+    }
+  }
+
+  /**
+   * @brief Finds the description with the given name, or returns nullptr if
+   * there is no such description.
+   */
+  const TDescription* find(const FString& name) const {
+    const TDescription* const* ppDescription = this->_descriptions.Find(name);
+    return ppDescription ? *ppDescription : nullptr;
+  }
+
+private:
+  TMap<FString, const TDescription*> _descriptions;
+};
+
+/**
+ * @brief The description of a property table, with its properties indexed by
+ * name.
+ */
+struct PropertyTableDescriptionIndex {
+  const FCesiumPropertyTableDescription* pDescription = nullptr;
+  DescriptionsByName<FCesiumPropertyTablePropertyDescription> properties;
+
+  /**
+   * @brief The names of the material parameters of the properties, by the
+   * names of the properties.
+   */
+  TMap<FString, PropertyParameterNames> parameterNames;
+};
+
+/**
+ * @brief The description of a property texture, with its properties indexed
+ * by name.
+ */
+struct PropertyTextureDescriptionIndex {
+  const FCesiumPropertyTextureDescription* pDescription = nullptr;
+  DescriptionsByName<FCesiumPropertyTexturePropertyDescription> properties;
+
+  /**
+   * @brief The names of the material parameters of the properties, by the
+   * names of the properties.
+   */
+  TMap<FString, PropertyParameterNames> parameterNames;
+};
+
+/**
+ * @brief Indexes the property tables and property textures of a
+ * FCesiumModelMetadataDescription, and their properties, by name. The
+ * description must outlive the index and must not be modified while it is
+ * used.
+ */
+class ModelMetadataDescriptionIndex {
+public:
+  explicit ModelMetadataDescriptionIndex(
+      const FCesiumModelMetadataDescription& description);
+
+  const PropertyTableDescriptionIndex*
+  findPropertyTable(const FString& name) const {
+    return this->_propertyTables.Find(name);
+  }
+
+  const PropertyTextureDescriptionIndex*
+  findPropertyTexture(const FString& name) const {
+    return this->_propertyTextures.Find(name);
+  }
+
+private:
+  TMap<FString, PropertyTableDescriptionIndex> _propertyTables;
+  TMap<FString, PropertyTextureDescriptionIndex> _propertyTextures;
+};
+
+/**
+ * @brief A FCesiumFeaturesMetadataDescription together with the indices that
+ * find its parts by name. It is built once when a tileset is loaded and then
+ * shared, unmodified, by the threads that load its tiles, instead of every
+ * tile searching the description for each of its feature ID sets, property
+ * tables, and properties.
+ */
+class IndexedFeaturesMetadataDescription {
+public:
+  explicit IndexedFeaturesMetadataDescription(
+      FCesiumFeaturesMetadataDescription&& description);
+
+  // The indices point into the description, so it must stay where it is.
+  IndexedFeaturesMetadataDescription(
+      const IndexedFeaturesMetadataDescription&) = delete;
+  IndexedFeaturesMetadataDescription&
+  operator=(const IndexedFeaturesMetadataDescription&) = delete;
+
+  const FCesiumFeaturesMetadataDescription& getDescription() const {
+    return this->_description;
+  }
+
+  const DescriptionsByName<FCesiumFeatureIdSetDescription>&
+  getFeatureIdSets() const {
+    return this->_featureIdSets;
+  }
+
+  const ModelMetadataDescriptionIndex& getModelMetadata() const {
+    return this->_modelMetadata;
+  }
+
+private:
+  FCesiumFeaturesMetadataDescription _description;
+  DescriptionsByName<FCesiumFeatureIdSetDescription> _featureIdSets;
+  ModelMetadataDescriptionIndex _modelMetadata;
+};
+
+#pragma endregion
+
 #pragma region Encoded Primitive Features
 
 /**
@@ -221,6 +435,11 @@ struct EncodedFeatureIdSet {
    * texels that have this value.
    */
   std::optional<int64> nullFeatureId;
+
+  /**
+   * @brief The names of the material parameters of this feature ID set.
+   */
+  FeatureIdSetParameterNames parameterNames;
 };
 
 /**
@@ -235,10 +454,15 @@ struct EncodedPrimitiveFeatures {
  * @brief Prepares the EXT_mesh_features of a glTF primitive to be encoded, for
  * use with Unreal Engine materials. This only encodes the feature ID sets
  * specified by the FCesiumPrimitiveFeaturesDescription.
+ *
+ * @param pFeatureIdSetIndex The feature ID sets of the description, indexed by
+ * name. If nullptr, they are indexed for this primitive only.
  */
 EncodedPrimitiveFeatures encodePrimitiveFeaturesAnyThreadPart(
     const FCesiumPrimitiveFeaturesDescription& featuresDescription,
-    const FCesiumPrimitiveFeatures& features);
+    const FCesiumPrimitiveFeatures& features,
+    const DescriptionsByName<FCesiumFeatureIdSetDescription>*
+        pFeatureIdSetIndex = nullptr);
 
 /**
  * @brief Encodes the EXT_mesh_features of a glTF primitive for use with Unreal
@@ -347,6 +571,16 @@ struct EncodedPropertyTableProperty {
    * @brief The property table property's default value.
    */
   FCesiumMetadataValue defaultValue;
+
+  /**
+   * @brief The names of the material parameters of this property.
+   */
+  PropertyParameterNames parameterNames;
+
+  /**
+   * @brief The statistics of the property's values, if it is a scalar.
+   */
+  std::optional<CesiumTilePropertyStatistics> statistics;
 };
 
 /**
@@ -425,6 +659,11 @@ struct EncodedPropertyTextureProperty {
    * it exists.
    */
   std::optional<CesiumGltf::KhrTextureTransform> textureTransform;
+
+  /**
+   * @brief The names of the material parameters of this property.
+   */
+  PropertyParameterNames parameterNames;
 };
 
 /**
@@ -464,9 +703,38 @@ struct EncodedModelMetadata {
   TArray<EncodedPropertyTexture> propertyTextures;
 };
 
+/**
+ * @brief Encodes the properties of a property table into textures.
+ *
+ * When the glTF model and property table that the property table was created
+ * from are given, the texture of a property is shared with other tiles whose
+ * property has identical values in its buffers and is encoded the same way,
+ * and the values are only encoded if no such texture is in use.
+ *
+ * @param pPropertyIndex The properties of the description, indexed by name. If
+ * nullptr, they are indexed for this property table only.
+ */
 EncodedPropertyTable encodePropertyTableAnyThreadPart(
     const FCesiumPropertyTableDescription& propertyTableDescription,
-    const FCesiumPropertyTable& propertyTable);
+    const FCesiumPropertyTable& propertyTable,
+    const CesiumGltf::Model* pModel = nullptr,
+    const CesiumGltf::PropertyTable* pGltfPropertyTable = nullptr,
+    const DescriptionsByName<FCesiumPropertyTablePropertyDescription>*
+        pPropertyIndex = nullptr,
+    const TMap<FString, PropertyParameterNames>* pParameterNames = nullptr);
+
+/**
+ * @brief Encodes the colors of the features of a property table, as evaluated
+ * from a style, into a texture for the property named
+ * {@link FeatureStylePropertyName}.
+ *
+ * @param propertyTableName The name of the property table, as returned by
+ * getNameForPropertyTable.
+ * @param featureColors The color of each feature, in order of feature ID.
+ */
+EncodedPropertyTableProperty encodeFeatureStyleAnyThreadPart(
+    const FString& propertyTableName,
+    const TArray<FColor>& featureColors);
 
 EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     const FCesiumPropertyTextureDescription& propertyTextureDescription,
@@ -474,16 +742,29 @@ EncodedPropertyTexture encodePropertyTextureAnyThreadPart(
     TMap<
         const CesiumGltf::ImageCesium*,
         TWeakPtr<CesiumTextureUtility::LoadedTextureResult>>&
-        propertyTexturePropertyMap);
+        propertyTexturePropertyMap,
+    const DescriptionsByName<FCesiumPropertyTexturePropertyDescription>*
+        pPropertyIndex = nullptr,
+    const TMap<FString, PropertyParameterNames>* pParameterNames = nullptr);
 
 EncodedPrimitiveMetadata encodePrimitiveMetadataAnyThreadPart(
     const FCesiumPrimitiveMetadataDescription& metadataDescription,
     const FCesiumPrimitiveMetadata& primitive,
     const FCesiumModelMetadata& modelMetadata);
 
+/**
+ * @brief Encodes the metadata of a glTF model. If the model that the metadata
+ * was created from is given, textures are shared between the property tables
+ * of tiles as described for {@link encodePropertyTableAnyThreadPart}.
+ *
+ * @param pIndex The index of the description. If nullptr, the description is
+ * indexed for this model only.
+ */
 EncodedModelMetadata encodeModelMetadataAnyThreadPart(
     const FCesiumModelMetadataDescription& metadataDescription,
-    const FCesiumModelMetadata& modelMetadata);
+    const FCesiumModelMetadata& modelMetadata,
+    const CesiumGltf::Model* pModel = nullptr,
+    const ModelMetadataDescriptionIndex* pIndex = nullptr);
 
 bool encodePropertyTableGameThreadPart(
     EncodedPropertyTable& encodedFeatureTable);
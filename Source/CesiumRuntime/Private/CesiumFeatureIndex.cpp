@@ -0,0 +1,92 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureIndex.h"
+#include "CesiumPrimitiveFeatures.h"
+#include <CesiumUtility/Tracing.h>
+
+TSharedPtr<const CesiumFeatureIndex> CesiumFeatureIndex::build(
+    const FCesiumPrimitiveFeatures& features,
+    const TArray<FVector3f>& positions,
+    const TArray<uint32>& indices) {
+  const TArray<FCesiumFeatureIdSet>& featureIDSets =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(features);
+  const int32 faceCount = indices.Num() / 3;
+  if (featureIDSets.IsEmpty() || faceCount == 0) {
+    return nullptr;
+  }
+
+  for (uint32 index : indices) {
+    if (index >= uint32(positions.Num())) {
+      return nullptr;
+    }
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildFeatureIndex)
+
+  TSharedRef<CesiumFeatureIndex> pIndex = MakeShared<CesiumFeatureIndex>();
+  pIndex->_featureIdSets.SetNum(featureIDSets.Num());
+
+  TMap<int64, TArray<FaceRange>> rangesByFeature;
+  for (int32 set = 0; set < featureIDSets.Num(); ++set) {
+    TMap<int64, Feature>& featuresByID = pIndex->_featureIdSets[set];
+    rangesByFeature.Reset();
+
+    // Collect the runs of consecutive faces with the same feature ID, which
+    // are usually long because the faces of a feature are stored together.
+    int64 runFeatureID = -1;
+    for (int32 face = 0; face < faceCount; ++face) {
+      const int64 featureID =
+          UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromFace(
+              features,
+              face,
+              set);
+      if (featureID < 0) {
+        runFeatureID = -1;
+        continue;
+      }
+
+      Feature* pFeature = featuresByID.Find(featureID);
+      if (!pFeature) {
+        pFeature = &featuresByID.Add(featureID, Feature{FBox3f(ForceInit)});
+      }
+      for (int32 vertex = 0; vertex < 3; ++vertex) {
+        pFeature->bounds += positions[indices[face * 3 + vertex]];
+      }
+
+      TArray<FaceRange>& ranges = rangesByFeature.FindOrAdd(featureID);
+      if (featureID == runFeatureID && !ranges.IsEmpty()) {
+        ++ranges.Last().faceCount;
+      } else {
+        ranges.Add({face, 1});
+      }
+      runFeatureID = featureID;
+    }
+
+    for (TPair<int64, TArray<FaceRange>>& pair : rangesByFeature) {
+      Feature& feature = featuresByID[pair.Key];
+      feature.firstRange = pIndex->_faceRanges.Num();
+      feature.rangeCount = pair.Value.Num();
+      pIndex->_faceRanges.Append(pair.Value);
+    }
+  }
+
+  pIndex->_faceRanges.Shrink();
+  return pIndex;
+}
+
+const CesiumFeatureIndex::Feature*
+CesiumFeatureIndex::find(int32 featureIDSetIndex, int64 featureID) const {
+  if (!this->_featureIdSets.IsValidIndex(featureIDSetIndex)) {
+    return nullptr;
+  }
+  return this->_featureIdSets[featureIDSetIndex].Find(featureID);
+}
+
+SIZE_T CesiumFeatureIndex::getAllocatedSize() const {
+  SIZE_T size = sizeof(*this) + this->_featureIdSets.GetAllocatedSize() +
+                this->_faceRanges.GetAllocatedSize();
+  for (const TMap<int64, Feature>& featuresByID : this->_featureIdSets) {
+    size += featuresByID.GetAllocatedSize();
+  }
+  return size;
+}
@@ -0,0 +1,86 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+
+struct FCesiumPrimitiveFeatures;
+
+/**
+ * An index from the feature IDs of a tile mesh to the faces that have them
+ * and their bounds, which is the reverse of
+ * UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromFace. It is
+ * immutable once built, so it may be queried from any thread.
+ */
+class CesiumFeatureIndex {
+public:
+  /**
+   * A run of consecutive faces of the primitive.
+   */
+  struct FaceRange {
+    int32 firstFace;
+    int32 faceCount;
+  };
+
+  /**
+   * The faces of a feature and their bounds.
+   */
+  struct Feature {
+    /**
+     * The bounds of the vertices of the feature's faces, in the coordinates
+     * of the triangles the index was built from.
+     */
+    FBox3f bounds;
+
+    int32 firstRange;
+    int32 rangeCount;
+  };
+
+  /**
+   * @brief Builds the index of every feature ID set of a primitive. May be
+   * called from any thread while the primitive's glTF is loaded.
+   *
+   * @param features The features of the primitive.
+   * @param positions The positions of the vertices of the triangles.
+   * @param indices The indices of the triangles, three per face of the
+   * primitive, in the order of its faces.
+   * @returns The index, or nullptr if the primitive has no feature ID sets or
+   * triangles.
+   */
+  static TSharedPtr<const CesiumFeatureIndex> build(
+      const FCesiumPrimitiveFeatures& features,
+      const TArray<FVector3f>& positions,
+      const TArray<uint32>& indices);
+
+  /**
+   * @brief Finds a feature.
+   *
+   * @param featureIDSetIndex The index of the feature ID set in the
+   * primitive's features.
+   * @param featureID The ID of the feature.
+   * @returns The feature, or nullptr if no face has the feature ID.
+   */
+  const Feature* find(int32 featureIDSetIndex, int64 featureID) const;
+
+  /**
+   * @brief Gets the runs of faces of a feature, in order of their faces.
+   */
+  TArrayView<const FaceRange> getFaceRanges(const Feature& feature) const {
+    return TArrayView<const FaceRange>(
+        this->_faceRanges.GetData() + feature.firstRange,
+        feature.rangeCount);
+  }
+
+  /**
+   * @brief Gets the number of bytes used by the index.
+   */
+  SIZE_T getAllocatedSize() const;
+
+private:
+  // The features of each feature ID set, by feature ID.
+  TArray<TMap<int64, Feature>> _featureIdSets;
+
+  // The face ranges of all features, grouped by feature.
+  TArray<FaceRange> _faceRanges;
+};
@@ -0,0 +1,78 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStateBlueprintLibrary.h"
+#include "CesiumFeatureIdSet.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumPrimitiveFeatures.h"
+
+namespace {
+
+UCesiumGltfComponent* getGltfComponent(const UPrimitiveComponent* Component) {
+  const UCesiumGltfPrimitiveComponent* pGltfPrimitive =
+      Cast<UCesiumGltfPrimitiveComponent>(Component);
+  if (!IsValid(pGltfPrimitive)) {
+    return nullptr;
+  }
+
+  UCesiumGltfComponent* pGltf =
+      Cast<UCesiumGltfComponent>(pGltfPrimitive->GetOuter());
+  return IsValid(pGltf) ? pGltf : nullptr;
+}
+
+} // namespace
+
+bool UCesiumFeatureStateBlueprintLibrary::SetFeatureState(
+    UPrimitiveComponent* Component,
+    int64 PropertyTableIndex,
+    int64 FeatureID,
+    int32 Flags) {
+  UCesiumGltfComponent* pGltf = getGltfComponent(Component);
+  return pGltf &&
+         pGltf->SetFeatureState(PropertyTableIndex, FeatureID, uint8(Flags));
+}
+
+bool UCesiumFeatureStateBlueprintLibrary::SetFeatureStateFromHit(
+    const FHitResult& Hit,
+    int32 Flags,
+    int64 FeatureIDSetIndex) {
+  const UCesiumGltfPrimitiveComponent* pGltfPrimitive =
+      Cast<UCesiumGltfPrimitiveComponent>(Hit.Component);
+  UCesiumGltfComponent* pGltf = getGltfComponent(pGltfPrimitive);
+  if (!pGltf) {
+    return false;
+  }
+
+  const FCesiumPrimitiveFeatures& features =
+      pGltfPrimitive->getPrimitiveData().Features;
+  const TArray<FCesiumFeatureIdSet>& featureIDSets =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(features);
+  if (FeatureIDSetIndex < 0 || FeatureIDSetIndex >= featureIDSets.Num()) {
+    return false;
+  }
+
+  const int64 propertyTableIndex =
+      UCesiumFeatureIdSetBlueprintLibrary::GetPropertyTableIndex(
+          featureIDSets[FeatureIDSetIndex]);
+  const int64 featureID =
+      UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromHit(
+          features,
+          Hit,
+          FeatureIDSetIndex);
+  return pGltf->SetFeatureState(propertyTableIndex, featureID, uint8(Flags));
+}
+
+int32 UCesiumFeatureStateBlueprintLibrary::GetFeatureState(
+    const UPrimitiveComponent* Component,
+    int64 PropertyTableIndex,
+    int64 FeatureID) {
+  const UCesiumGltfComponent* pGltf = getGltfComponent(Component);
+  return pGltf ? pGltf->GetFeatureState(PropertyTableIndex, FeatureID) : 0;
+}
+
+void UCesiumFeatureStateBlueprintLibrary::ClearFeatureStates(
+    UPrimitiveComponent* Component) {
+  if (UCesiumGltfComponent* pGltf = getGltfComponent(Component)) {
+    pGltf->ClearFeatureStates();
+  }
+}
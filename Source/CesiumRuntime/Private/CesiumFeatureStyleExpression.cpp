@@ -0,0 +1,826 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStyleExpression.h"
+#include "CesiumFeatureStyle.h"
+#include "CesiumMetadataValue.h"
+#include "CesiumPropertyTable.h"
+#include "CesiumRuntime.h"
+#include "Misc/Char.h"
+#include "Misc/Parse.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <iterator>
+
+using Value = CesiumFeatureStyleExpression::Value;
+using Operation = CesiumFeatureStyleExpression::Operation;
+using Node = CesiumFeatureStyleExpression::Node;
+
+/**
+ * Parses the source of a CesiumFeatureStyleExpression into its nodes, by
+ * recursive descent with one function per level of operator precedence.
+ */
+class CesiumFeatureStyleParser {
+public:
+  CesiumFeatureStyleParser(
+      const FString& source,
+      TArray<FString>& variables,
+      CesiumFeatureStyleExpression& expression)
+      : _source(source), _variables(variables), _expression(expression) {}
+
+  bool parse(FString& error) {
+    const int32 root = this->parseConditional();
+    this->skipWhitespace();
+    if (root != INDEX_NONE && this->_position < this->_source.Len()) {
+      this->fail(TEXT("unexpected character"));
+    }
+
+    if (!this->_error.IsEmpty()) {
+      error = FString::Printf(
+          TEXT("%s at position %d"),
+          *this->_error,
+          this->_errorPosition);
+      return false;
+    }
+
+    this->_expression._root = root;
+    return true;
+  }
+
+private:
+  int32 fail(const TCHAR* message) {
+    if (this->_error.IsEmpty()) {
+      this->_error = message;
+      this->_errorPosition = this->_position;
+    }
+    return INDEX_NONE;
+  }
+
+  int32 addNode(Node&& node) {
+    return this->_expression._nodes.Add(MoveTemp(node));
+  }
+
+  int32 addConstant(Value&& value) {
+    Node node;
+    node.operation = Operation::Constant;
+    node.constant = MoveTemp(value);
+    return this->addNode(MoveTemp(node));
+  }
+
+  int32
+  addOperation(Operation operation, std::initializer_list<int32> operands) {
+    for (int32 operand : operands) {
+      if (operand == INDEX_NONE) {
+        return INDEX_NONE;
+      }
+    }
+
+    Node node;
+    node.operation = operation;
+    node.operands.Append(operands.begin(), int32(operands.size()));
+    return this->addNode(MoveTemp(node));
+  }
+
+  TCHAR peekCharacter(int32 offset = 0) const {
+    const int32 position = this->_position + offset;
+    return position < this->_source.Len() ? this->_source[position] : 0;
+  }
+
+  void skipWhitespace() {
+    while (FChar::IsWhitespace(this->peekCharacter())) {
+      ++this->_position;
+    }
+  }
+
+  /**
+   * Consumes the token if it is next. Callers try longer tokens before their
+   * prefixes, such as `<=` before `<`.
+   */
+  bool match(const TCHAR* token) {
+    this->skipWhitespace();
+    const int32 length = FCString::Strlen(token);
+    if (FCString::Strncmp(*this->_source + this->_position, token, length) !=
+        0) {
+      return false;
+    }
+    this->_position += length;
+    return true;
+  }
+
+  int32 parseConditional() {
+    const int32 condition = this->parseOr();
+    if (!this->match(TEXT("?"))) {
+      return condition;
+    }
+
+    const int32 whenTrue = this->parseConditional();
+    if (!this->match(TEXT(":"))) {
+      return this->fail(TEXT("expected ':'"));
+    }
+    const int32 whenFalse = this->parseConditional();
+    return this->addOperation(
+        Operation::Conditional,
+        {condition, whenTrue, whenFalse});
+  }
+
+  int32 parseOr() {
+    int32 left = this->parseAnd();
+    while (left != INDEX_NONE && this->match(TEXT("||"))) {
+      left = this->addOperation(Operation::Or, {left, this->parseAnd()});
+    }
+    return left;
+  }
+
+  int32 parseAnd() {
+    int32 left = this->parseEquality();
+    while (left != INDEX_NONE && this->match(TEXT("&&"))) {
+      left = this->addOperation(Operation::And, {left, this->parseEquality()});
+    }
+    return left;
+  }
+
+  int32 parseEquality() {
+    int32 left = this->parseRelational();
+    while (left != INDEX_NONE) {
+      Operation operation;
+      if (this->match(TEXT("===")) || this->match(TEXT("=="))) {
+        operation = Operation::Equal;
+      } else if (this->match(TEXT("!==")) || this->match(TEXT("!="))) {
+        operation = Operation::NotEqual;
+      } else {
+        break;
+      }
+      left = this->addOperation(operation, {left, this->parseRelational()});
+    }
+    return left;
+  }
+
+  int32 parseRelational() {
+    int32 left = this->parseAdditive();
+    while (left != INDEX_NONE) {
+      Operation operation;
+      if (this->match(TEXT("<="))) {
+        operation = Operation::LessOrEqual;
+      } else if (this->match(TEXT("<"))) {
+        operation = Operation::Less;
+      } else if (this->match(TEXT(">="))) {
+        operation = Operation::GreaterOrEqual;
+      } else if (this->match(TEXT(">"))) {
+        operation = Operation::Greater;
+      } else {
+        break;
+      }
+      left = this->addOperation(operation, {left, this->parseAdditive()});
+    }
+    return left;
+  }
+
+  int32 parseAdditive() {
+    int32 left = this->parseMultiplicative();
+    while (left != INDEX_NONE) {
+      Operation operation;
+      if (this->match(TEXT("+"))) {
+        operation = Operation::Add;
+      } else if (this->match(TEXT("-"))) {
+        operation = Operation::Subtract;
+      } else {
+        break;
+      }
+      left = this->addOperation(operation, {left, this->parseMultiplicative()});
+    }
+    return left;
+  }
+
+  int32 parseMultiplicative() {
+    int32 left = this->parseUnary();
+    while (left != INDEX_NONE) {
+      Operation operation;
+      if (this->match(TEXT("*"))) {
+        operation = Operation::Multiply;
+      } else if (this->match(TEXT("/"))) {
+        operation = Operation::Divide;
+      } else if (this->match(TEXT("%"))) {
+        operation = Operation::Remainder;
+      } else {
+        break;
+      }
+      left = this->addOperation(operation, {left, this->parseUnary()});
+    }
+    return left;
+  }
+
+  int32 parseUnary() {
+    if (this->match(TEXT("!"))) {
+      return this->addOperation(Operation::Not, {this->parseUnary()});
+    }
+    if (this->match(TEXT("-"))) {
+      return this->addOperation(Operation::Negate, {this->parseUnary()});
+    }
+    if (this->match(TEXT("+"))) {
+      // Unary plus only requires a number.
+      const int32 operand = this->parseUnary();
+      return this->addOperation(
+          Operation::Add,
+          {this->addConstant(0.0), operand});
+    }
+    return this->parsePrimary();
+  }
+
+  int32 parsePrimary() {
+    this->skipWhitespace();
+    const TCHAR c = this->peekCharacter();
+
+    if (FChar::IsDigit(c) ||
+        (c == TEXT('.') && FChar::IsDigit(this->peekCharacter(1)))) {
+      return this->parseNumber();
+    }
+    if (c == TEXT('\'') || c == TEXT('"')) {
+      return this->parseString();
+    }
+    if (c == TEXT('$') && this->peekCharacter(1) == TEXT('{')) {
+      return this->parseVariable();
+    }
+    if (this->match(TEXT("("))) {
+      const int32 expression = this->parseConditional();
+      if (!this->match(TEXT(")"))) {
+        return this->fail(TEXT("expected ')'"));
+      }
+      return expression;
+    }
+    if (FChar::IsAlpha(c) || c == TEXT('_')) {
+      return this->parseIdentifier();
+    }
+
+    return this->fail(TEXT("expected an expression"));
+  }
+
+  int32 parseNumber() {
+    const int32 start = this->_position;
+    while (FChar::IsDigit(this->peekCharacter())) {
+      ++this->_position;
+    }
+    if (this->peekCharacter() == TEXT('.')) {
+      ++this->_position;
+      while (FChar::IsDigit(this->peekCharacter())) {
+        ++this->_position;
+      }
+    }
+    const TCHAR e = this->peekCharacter();
+    if (e == TEXT('e') || e == TEXT('E')) {
+      int32 exponent = 1;
+      const TCHAR sign = this->peekCharacter(1);
+      if (sign == TEXT('+') || sign == TEXT('-')) {
+        exponent = 2;
+      }
+      if (FChar::IsDigit(this->peekCharacter(exponent))) {
+        this->_position += exponent;
+        while (FChar::IsDigit(this->peekCharacter())) {
+          ++this->_position;
+        }
+      }
+    }
+
+    const FString number = this->_source.Mid(start, this->_position - start);
+    return this->addConstant(FCString::Atod(*number));
+  }
+
+  int32 parseString() {
+    const TCHAR quote = this->peekCharacter();
+    ++this->_position;
+
+    FString string;
+    while (this->_position < this->_source.Len()) {
+      TCHAR c = this->peekCharacter();
+      ++this->_position;
+      if (c == quote) {
+        return this->addConstant(MoveTemp(string));
+      }
+      if (c == TEXT('\\') && this->_position < this->_source.Len()) {
+        c = this->peekCharacter();
+        ++this->_position;
+      }
+      string.AppendChar(c);
+    }
+
+    return this->fail(TEXT("unterminated string"));
+  }
+
+  int32 parseVariable() {
+    this->_position += 2;
+    const int32 end = this->_source.Find(
+        TEXT("}"),
+        ESearchCase::CaseSensitive,
+        ESearchDir::FromStart,
+        this->_position);
+    if (end == INDEX_NONE) {
+      return this->fail(TEXT("expected '}'"));
+    }
+
+    const FString name =
+        this->_source.Mid(this->_position, end - this->_position)
+            .TrimStartAndEnd();
+    this->_position = end + 1;
+    if (name.IsEmpty()) {
+      return this->fail(TEXT("expected a property name"));
+    }
+
+    int32 variable = this->_variables.IndexOfByKey(name);
+    if (variable == INDEX_NONE) {
+      variable = this->_variables.Add(name);
+    }
+
+    Node node;
+    node.operation = Operation::Variable;
+    node.variable = variable;
+    return this->addNode(MoveTemp(node));
+  }
+
+  int32 parseIdentifier() {
+    const int32 start = this->_position;
+    while (FChar::IsAlnum(this->peekCharacter()) ||
+           this->peekCharacter() == TEXT('_')) {
+      ++this->_position;
+    }
+    const FString name = this->_source.Mid(start, this->_position - start);
+
+    if (name == TEXT("true")) {
+      return this->addConstant(true);
+    }
+    if (name == TEXT("false")) {
+      return this->addConstant(false);
+    }
+    if (name == TEXT("undefined")) {
+      return this->addConstant(Value());
+    }
+
+    struct Function {
+      const TCHAR* name;
+      Operation operation;
+      int32 minimumArguments;
+      int32 maximumArguments;
+    };
+    static const Function functions[] = {
+        {TEXT("color"), Operation::Color, 0, 2},
+        {TEXT("rgb"), Operation::Rgb, 3, 3},
+        {TEXT("rgba"), Operation::Rgba, 4, 4},
+        {TEXT("abs"), Operation::Abs, 1, 1},
+        {TEXT("min"), Operation::Min, 2, 2},
+        {TEXT("max"), Operation::Max, 2, 2},
+        {TEXT("clamp"), Operation::Clamp, 3, 3}};
+
+    const Function* pFunction = std::find_if(
+        std::begin(functions),
+        std::end(functions),
+        [&name](const Function& function) {
+          return name.Equals(function.name, ESearchCase::CaseSensitive);
+        });
+    if (pFunction == std::end(functions)) {
+      this->_position = start;
+      return this->fail(TEXT("unknown identifier"));
+    }
+
+    if (!this->match(TEXT("("))) {
+      return this->fail(TEXT("expected '('"));
+    }
+
+    Node node;
+    node.operation = pFunction->operation;
+    if (!this->match(TEXT(")"))) {
+      do {
+        const int32 argument = this->parseConditional();
+        if (argument == INDEX_NONE) {
+          return INDEX_NONE;
+        }
+        node.operands.Add(argument);
+      } while (this->match(TEXT(",")));
+
+      if (!this->match(TEXT(")"))) {
+        return this->fail(TEXT("expected ')'"));
+      }
+    }
+
+    if (node.operands.Num() < pFunction->minimumArguments ||
+        node.operands.Num() > pFunction->maximumArguments) {
+      return this->fail(TEXT("wrong number of arguments"));
+    }
+
+    return this->addNode(MoveTemp(node));
+  }
+
+  const FString& _source;
+  TArray<FString>& _variables;
+  CesiumFeatureStyleExpression& _expression;
+  int32 _position = 0;
+  FString _error;
+  int32 _errorPosition = 0;
+};
+
+namespace {
+
+const double* getNumber(const Value& value) {
+  return std::get_if<double>(&value);
+}
+
+template <typename TCompare>
+Value compare(const Value& left, const Value& right, TCompare&& predicate) {
+  const double* pLeft = std::get_if<double>(&left);
+  const double* pRight = std::get_if<double>(&right);
+  if (pLeft && pRight) {
+    return predicate(*pLeft, *pRight);
+  }
+
+  const FString* pLeftString = std::get_if<FString>(&left);
+  const FString* pRightString = std::get_if<FString>(&right);
+  if (pLeftString && pRightString) {
+    return predicate(
+        pLeftString->Compare(*pRightString, ESearchCase::CaseSensitive),
+        0);
+  }
+
+  return Value();
+}
+
+struct NamedColor {
+  const TCHAR* name;
+  uint32 rgb;
+};
+
+// The basic colors of CSS, with a few common extended ones.
+const NamedColor namedColors[] = {
+    {TEXT("black"), 0x000000},   {TEXT("silver"), 0xc0c0c0},
+    {TEXT("gray"), 0x808080},    {TEXT("grey"), 0x808080},
+    {TEXT("white"), 0xffffff},   {TEXT("maroon"), 0x800000},
+    {TEXT("red"), 0xff0000},     {TEXT("purple"), 0x800080},
+    {TEXT("fuchsia"), 0xff00ff}, {TEXT("magenta"), 0xff00ff},
+    {TEXT("green"), 0x008000},   {TEXT("lime"), 0x00ff00},
+    {TEXT("olive"), 0x808000},   {TEXT("yellow"), 0xffff00},
+    {TEXT("navy"), 0x000080},    {TEXT("blue"), 0x0000ff},
+    {TEXT("teal"), 0x008080},    {TEXT("aqua"), 0x00ffff},
+    {TEXT("cyan"), 0x00ffff},    {TEXT("orange"), 0xffa500},
+    {TEXT("brown"), 0xa52a2a},   {TEXT("pink"), 0xffc0cb}};
+
+Value toStyleValue(const FCesiumMetadataValue& value) {
+  const FCesiumMetadataValueType valueType =
+      UCesiumMetadataValueBlueprintLibrary::GetValueType(value);
+  if (valueType.bIsArray) {
+    return Value();
+  }
+
+  switch (valueType.Type) {
+  case ECesiumMetadataType::Boolean:
+    return UCesiumMetadataValueBlueprintLibrary::GetBoolean(value, false);
+  case ECesiumMetadataType::Scalar:
+    return UCesiumMetadataValueBlueprintLibrary::GetFloat64(value, 0.0);
+  case ECesiumMetadataType::String:
+  case ECesiumMetadataType::Enum:
+    return UCesiumMetadataValueBlueprintLibrary::GetString(value, FString());
+  default:
+    return Value();
+  }
+}
+
+TSharedPtr<const CesiumFeatureStyleExpression> compileExpression(
+    const FString& source,
+    const TCHAR* description,
+    TArray<FString>& variables) {
+  if (source.TrimStartAndEnd().IsEmpty()) {
+    return nullptr;
+  }
+
+  FString error;
+  TSharedPtr<const CesiumFeatureStyleExpression> pExpression =
+      CesiumFeatureStyleExpression::parse(source, variables, error);
+  if (!pExpression) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Ignoring the invalid %s expression \"%s\" of a style: %s"),
+        description,
+        *source,
+        *error);
+  }
+  return pExpression;
+}
+
+} // namespace
+
+TSharedPtr<const CesiumFeatureStyleExpression>
+CesiumFeatureStyleExpression::parse(
+    const FString& source,
+    TArray<FString>& variables,
+    FString& error) {
+  // Don't add the variables of an invalid expression.
+  TArray<FString> newVariables = variables;
+  TSharedRef<CesiumFeatureStyleExpression> pExpression =
+      MakeShared<CesiumFeatureStyleExpression>();
+  CesiumFeatureStyleParser parser(source, newVariables, *pExpression);
+  if (!parser.parse(error)) {
+    return nullptr;
+  }
+
+  variables = MoveTemp(newVariables);
+  return pExpression;
+}
+
+Value CesiumFeatureStyleExpression::evaluate(
+    TFunctionRef<Value(int32)> getVariable) const {
+  return this->evaluateNode(this->_root, getVariable);
+}
+
+bool CesiumFeatureStyleExpression::isTrue(const Value& value) {
+  if (const bool* pBool = std::get_if<bool>(&value)) {
+    return *pBool;
+  }
+  if (const double* pNumber = std::get_if<double>(&value)) {
+    return *pNumber != 0.0 && !std::isnan(*pNumber);
+  }
+  if (const FString* pString = std::get_if<FString>(&value)) {
+    return !pString->IsEmpty();
+  }
+  return std::holds_alternative<FLinearColor>(value);
+}
+
+std::optional<FLinearColor>
+CesiumFeatureStyleExpression::parseColor(const FString& color) {
+  const FString trimmed = color.TrimStartAndEnd();
+
+  if (trimmed.StartsWith(TEXT("#"))) {
+    const int32 digits = trimmed.Len() - 1;
+    if (digits != 3 && digits != 6) {
+      return std::nullopt;
+    }
+
+    uint32 rgb = 0;
+    for (int32 i = 1; i < trimmed.Len(); ++i) {
+      if (!FChar::IsHexDigit(trimmed[i])) {
+        return std::nullopt;
+      }
+      const uint32 digit = FParse::HexDigit(trimmed[i]);
+      // Each digit of the short form is repeated.
+      rgb = digits == 3 ? (rgb << 8) | (digit << 4) | digit
+                        : (rgb << 4) | digit;
+    }
+
+    return FLinearColor(
+        float((rgb >> 16) & 0xff) / 255.0f,
+        float((rgb >> 8) & 0xff) / 255.0f,
+        float(rgb & 0xff) / 255.0f);
+  }
+
+  for (const NamedColor& namedColor : namedColors) {
+    if (trimmed.Equals(namedColor.name, ESearchCase::IgnoreCase)) {
+      return FLinearColor(
+          float((namedColor.rgb >> 16) & 0xff) / 255.0f,
+          float((namedColor.rgb >> 8) & 0xff) / 255.0f,
+          float(namedColor.rgb & 0xff) / 255.0f);
+    }
+  }
+
+  return std::nullopt;
+}
+
+Value CesiumFeatureStyleExpression::evaluateNode(
+    int32 index,
+    TFunctionRef<Value(int32)> getVariable) const {
+  const Node& node = this->_nodes[index];
+  const auto operand = [this, &node, getVariable](int32 i) {
+    return this->evaluateNode(node.operands[i], getVariable);
+  };
+
+  switch (node.operation) {
+  case Operation::Constant:
+    return node.constant;
+  case Operation::Variable:
+    return getVariable(node.variable);
+  case Operation::Not:
+    return !isTrue(operand(0));
+  case Operation::Negate: {
+    const Value value = operand(0);
+    const double* pNumber = getNumber(value);
+    return pNumber ? Value(-*pNumber) : Value();
+  }
+  case Operation::Multiply:
+  case Operation::Divide:
+  case Operation::Remainder:
+  case Operation::Subtract:
+  case Operation::Add: {
+    Value left = operand(0);
+    Value right = operand(1);
+    const double* pLeft = getNumber(left);
+    const double* pRight = getNumber(right);
+    if (pLeft && pRight) {
+      switch (node.operation) {
+      case Operation::Multiply:
+        return *pLeft * *pRight;
+      case Operation::Divide:
+        return *pLeft / *pRight;
+      case Operation::Remainder:
+        return std::fmod(*pLeft, *pRight);
+      case Operation::Subtract:
+        return *pLeft - *pRight;
+      default:
+        return *pLeft + *pRight;
+      }
+    }
+
+    FString* pLeftString = std::get_if<FString>(&left);
+    const FString* pRightString = std::get_if<FString>(&right);
+    if (node.operation == Operation::Add && pLeftString && pRightString) {
+      return MoveTemp(*pLeftString) + *pRightString;
+    }
+    return Value();
+  }
+  case Operation::Less:
+    return compare(operand(0), operand(1), [](auto a, auto b) {
+      return a < b;
+    });
+  case Operation::LessOrEqual:
+    return compare(operand(0), operand(1), [](auto a, auto b) {
+      return a <= b;
+    });
+  case Operation::Greater:
+    return compare(operand(0), operand(1), [](auto a, auto b) {
+      return a > b;
+    });
+  case Operation::GreaterOrEqual:
+    return compare(operand(0), operand(1), [](auto a, auto b) {
+      return a >= b;
+    });
+  case Operation::Equal:
+    return operand(0) == operand(1);
+  case Operation::NotEqual:
+    return operand(0) != operand(1);
+  case Operation::And:
+    return isTrue(operand(0)) && isTrue(operand(1));
+  case Operation::Or:
+    return isTrue(operand(0)) || isTrue(operand(1));
+  case Operation::Conditional:
+    return isTrue(operand(0)) ? operand(1) : operand(2);
+  case Operation::Color: {
+    if (node.operands.Num() == 0) {
+      return FLinearColor::White;
+    }
+
+    const Value name = operand(0);
+    const FString* pName = std::get_if<FString>(&name);
+    std::optional<FLinearColor> maybeColor =
+        pName ? parseColor(*pName) : std::nullopt;
+    if (!maybeColor) {
+      return Value();
+    }
+
+    if (node.operands.Num() > 1) {
+      const Value alpha = operand(1);
+      const double* pAlpha = getNumber(alpha);
+      if (!pAlpha) {
+        return Value();
+      }
+      maybeColor->A = float(std::clamp(*pAlpha, 0.0, 1.0));
+    }
+    return *maybeColor;
+  }
+  case Operation::Rgb:
+  case Operation::Rgba: {
+    double components[4] = {0.0, 0.0, 0.0, 255.0};
+    for (int32 i = 0; i < node.operands.Num(); ++i) {
+      const Value component = operand(i);
+      const double* pComponent = getNumber(component);
+      if (!pComponent) {
+        return Value();
+      }
+      // The alpha of rgba is between zero and one, like in CSS.
+      components[i] = i == 3 ? *pComponent * 255.0 : *pComponent;
+    }
+    return FLinearColor(
+        float(std::clamp(components[0], 0.0, 255.0) / 255.0),
+        float(std::clamp(components[1], 0.0, 255.0) / 255.0),
+        float(std::clamp(components[2], 0.0, 255.0) / 255.0),
+        float(std::clamp(components[3], 0.0, 255.0) / 255.0));
+  }
+  case Operation::Abs:
+  case Operation::Min:
+  case Operation::Max:
+  case Operation::Clamp: {
+    double arguments[3] = {0.0, 0.0, 0.0};
+    for (int32 i = 0; i < node.operands.Num(); ++i) {
+      const Value argument = operand(i);
+      const double* pArgument = getNumber(argument);
+      if (!pArgument) {
+        return Value();
+      }
+      arguments[i] = *pArgument;
+    }
+
+    switch (node.operation) {
+    case Operation::Abs:
+      return std::abs(arguments[0]);
+    case Operation::Min:
+      return std::min(arguments[0], arguments[1]);
+    case Operation::Max:
+      return std::max(arguments[0], arguments[1]);
+    default:
+      return std::clamp(
+          arguments[0],
+          arguments[1],
+          std::max(arguments[1], arguments[2]));
+    }
+  }
+  }
+
+  return Value();
+}
+
+TSharedRef<const CesiumCompiledFeatureStyle>
+CesiumCompiledFeatureStyle::compile(const FCesiumFeatureStyle& style) {
+  TSharedRef<CesiumCompiledFeatureStyle> pStyle =
+      MakeShared<CesiumCompiledFeatureStyle>();
+
+  pStyle->_pShow =
+      compileExpression(style.Show, TEXT("show"), pStyle->_variables);
+
+  for (const FCesiumFeatureStyleCondition& condition : style.ColorConditions) {
+    TSharedPtr<const CesiumFeatureStyleExpression> pCondition =
+        compileExpression(
+            condition.Condition,
+            TEXT("condition"),
+            pStyle->_variables);
+    TSharedPtr<const CesiumFeatureStyleExpression> pColor =
+        compileExpression(condition.Color, TEXT("color"), pStyle->_variables);
+    if (pCondition && pColor) {
+      pStyle->_colorConditions.Add({MoveTemp(pCondition), MoveTemp(pColor)});
+    }
+  }
+
+  return pStyle;
+}
+
+bool CesiumCompiledFeatureStyle::isEmpty() const {
+  return !this->_pShow && this->_colorConditions.IsEmpty();
+}
+
+TArray<FColor> CesiumCompiledFeatureStyle::evaluate(
+    const FCesiumPropertyTable& propertyTable) const {
+  const int64 count =
+      UCesiumPropertyTableBlueprintLibrary::GetPropertyTableCount(
+          propertyTable);
+  if (count <= 0 || count > MAX_int32) {
+    return TArray<FColor>();
+  }
+
+  // Fetch the values of the variables for all features at once, rather than
+  // one value of one feature at a time.
+  TArray<TArray<Value>> columns;
+  if (!this->_variables.IsEmpty()) {
+    TArray<int64> featureIDs;
+    featureIDs.SetNumUninitialized(int32(count));
+    for (int32 i = 0; i < featureIDs.Num(); ++i) {
+      featureIDs[i] = i;
+    }
+
+    TArray<FCesiumPropertyTableValues> values =
+        UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatures(
+            propertyTable,
+            featureIDs,
+            this->_variables);
+
+    columns.SetNum(this->_variables.Num());
+    for (int32 i = 0; i < values.Num() && i < columns.Num(); ++i) {
+      columns[i].Reserve(values[i].Values.Num());
+      for (const FCesiumMetadataValue& value : values[i].Values) {
+        columns[i].Add(toStyleValue(value));
+      }
+    }
+  }
+
+  TArray<FColor> colors;
+  colors.SetNumUninitialized(int32(count));
+  for (int32 feature = 0; feature < colors.Num(); ++feature) {
+    const auto getVariable = [&columns, feature](int32 variable) {
+      const TArray<Value>& column = columns[variable];
+      return column.IsValidIndex(feature) ? column[feature] : Value();
+    };
+
+    const bool show = !this->_pShow || CesiumFeatureStyleExpression::isTrue(
+                                           this->_pShow->evaluate(getVariable));
+
+    FLinearColor color = FLinearColor::White;
+    for (const Condition& condition : this->_colorConditions) {
+      if (CesiumFeatureStyleExpression::isTrue(
+              condition.pCondition->evaluate(getVariable))) {
+        const Value value = condition.pColor->evaluate(getVariable);
+        if (const FLinearColor* pColor = std::get_if<FLinearColor>(&value)) {
+          color = *pColor;
+        }
+        break;
+      }
+    }
+
+    // The colors are already sRGB, so they are quantized without conversion.
+    FColor& result = colors[feature] = color.QuantizeRound();
+    if (!show) {
+      result.A = 0;
+    }
+  }
+
+  return colors;
+}
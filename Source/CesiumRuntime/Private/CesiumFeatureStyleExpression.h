@@ -0,0 +1,159 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Containers/UnrealString.h"
+#include "Math/Color.h"
+#include "Templates/Function.h"
+#include "Templates/SharedPointer.h"
+#include <optional>
+#include <variant>
+
+struct FCesiumFeatureStyle;
+struct FCesiumPropertyTable;
+
+/**
+ * An expression of the 3D Tiles styling language, such as
+ * `${height} > 100 ? color('red') : color('white', 0.5)`, that is evaluated
+ * for the features of property tables.
+ *
+ * This supports boolean, number, and string literals; `${name}` variables,
+ * which are the values of properties; the unary `!`, `-`, and `+`
+ * operators; the binary `*`, `/`, `%`, `+`, `-`, `<`, `<=`, `>`, `>=`,
+ * `==`, `!=`, `===`, `!==`, `&&`, and `||` operators; the `?:` operator;
+ * and the `color`, `rgb`, `rgba`, `abs`, `min`, `max`, and `clamp`
+ * functions. Operations on values of the wrong types are undefined.
+ */
+class CesiumFeatureStyleExpression {
+public:
+  /**
+   * The value of an expression or variable, which is undefined if it is
+   * std::monostate. Colors are the sRGB colors of CSS, with components
+   * between zero and one.
+   */
+  using Value =
+      std::variant<std::monostate, bool, double, FString, FLinearColor>;
+
+  /**
+   * @brief Parses an expression.
+   *
+   * @param source The text of the expression.
+   * @param variables The names of the variables that expressions refer to.
+   * Variables of this expression that aren't in it yet are added to it, so
+   * that several expressions may share their variables.
+   * @param error Receives a description of the error if the expression is
+   * invalid.
+   * @returns The expression, or nullptr if it is invalid.
+   */
+  static TSharedPtr<const CesiumFeatureStyleExpression>
+  parse(const FString& source, TArray<FString>& variables, FString& error);
+
+  /**
+   * @brief Evaluates the expression.
+   *
+   * @param getVariable Gets the value of the variable with an index into the
+   * variables the expression was parsed with.
+   */
+  Value evaluate(TFunctionRef<Value(int32)> getVariable) const;
+
+  /**
+   * @brief Determines whether a value is true. Undefined values, false, zero,
+   * NaN, and empty strings are not.
+   */
+  static bool isTrue(const Value& value);
+
+  /**
+   * @brief Parses a CSS color, such as `red`, `#f00`, or `#ff0000`.
+   */
+  static std::optional<FLinearColor> parseColor(const FString& color);
+
+  enum class Operation : uint8 {
+    Constant,
+    Variable,
+    Not,
+    Negate,
+    Multiply,
+    Divide,
+    Remainder,
+    Add,
+    Subtract,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual,
+    Equal,
+    NotEqual,
+    And,
+    Or,
+    Conditional,
+    Color,
+    Rgb,
+    Rgba,
+    Abs,
+    Min,
+    Max,
+    Clamp
+  };
+
+  /**
+   * A node of the expression tree. The nodes are stored in an array, and a
+   * node refers to its operands by their indices in it.
+   */
+  struct Node {
+    Operation operation = Operation::Constant;
+    Value constant;
+    int32 variable = INDEX_NONE;
+    TArray<int32, TInlineAllocator<3>> operands;
+  };
+
+private:
+  Value
+  evaluateNode(int32 node, TFunctionRef<Value(int32)> getVariable) const;
+
+  TArray<Node> _nodes;
+  int32 _root = INDEX_NONE;
+
+  friend class CesiumFeatureStyleParser;
+};
+
+/**
+ * A FCesiumFeatureStyle whose expressions have been parsed, so that it can be
+ * evaluated for the features of many property tables. It is immutable once
+ * compiled, so it may be evaluated on any thread.
+ */
+class CesiumCompiledFeatureStyle {
+public:
+  /**
+   * @brief Compiles a style. Expressions that are invalid are logged and
+   * ignored.
+   */
+  static TSharedRef<const CesiumCompiledFeatureStyle>
+  compile(const FCesiumFeatureStyle& style);
+
+  /**
+   * @brief Determines whether the style has no valid expressions, so that it
+   * doesn't change the appearance of any feature.
+   */
+  bool isEmpty() const;
+
+  /**
+   * @brief Evaluates the style for each feature of a property table.
+   *
+   * @returns The color of each feature, in order of feature ID, as the sRGB
+   * color of the style with the alpha of the color, or zero alpha if the
+   * feature isn't shown. Empty if the property table is invalid.
+   */
+  TArray<FColor> evaluate(const FCesiumPropertyTable& propertyTable) const;
+
+private:
+  struct Condition {
+    TSharedPtr<const CesiumFeatureStyleExpression> pCondition;
+    TSharedPtr<const CesiumFeatureStyleExpression> pColor;
+  };
+
+  TArray<FString> _variables;
+  TSharedPtr<const CesiumFeatureStyleExpression> _pShow;
+  TArray<Condition> _colorConditions;
+};
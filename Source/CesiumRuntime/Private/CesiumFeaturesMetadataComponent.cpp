@@ -8,6 +8,7 @@
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumModelMetadata.h"
 #include "CesiumRuntime.h"
+#include "Materials/MaterialInterface.h"
 #include "UnrealMetadataConversions.h"
 
 #if WITH_EDITOR
@@ -2726,3 +2727,134 @@ void UCesiumFeaturesMetadataComponent::GenerateMaterial() {
 }
 
 #endif // WITH_EDITOR
+
+void UCesiumFeaturesMetadataComponent::SetUsedProperties(
+    const FString& PropertyTableName,
+    const TArray<FString>& PropertyNames) {
+  this->_usedProperties.Add(PropertyTableName, PropertyNames);
+  ++this->_usedPropertiesVersion;
+}
+
+void UCesiumFeaturesMetadataComponent::ClearUsedProperties() {
+  this->_usedProperties.Empty();
+  ++this->_usedPropertiesVersion;
+}
+
+void UCesiumFeaturesMetadataComponent::SetStyle(
+    const FCesiumFeatureStyle& NewStyle) {
+  this->Style = NewStyle;
+  ++this->_styleVersion;
+}
+
+bool UCesiumFeaturesMetadataComponent::GetPropertyStatistics(
+    const FString& PropertyTableName,
+    const FString& PropertyName,
+    FCesiumPropertyStatistics& Statistics,
+    int32 HistogramBucketCount) const {
+  Statistics = FCesiumPropertyStatistics();
+
+  const AActor* pOwner = this->GetOwner();
+  if (!pOwner) {
+    return false;
+  }
+
+  // Encoded properties have HLSL-safe names.
+  const FString encodedName =
+      CesiumEncodedFeaturesMetadata::createHlslSafeName(PropertyName);
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  pOwner->GetComponents<UCesiumGltfComponent>(gltfComponents);
+
+  TArray<const CesiumTilePropertyStatistics*> tileStatistics;
+  for (const UCesiumGltfComponent* pGltf : gltfComponents) {
+    for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable& table :
+         pGltf->EncodedMetadata.propertyTables) {
+      if (table.name != PropertyTableName) {
+        continue;
+      }
+      for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty&
+               property : table.properties) {
+        if (property.name == encodedName && property.statistics) {
+          tileStatistics.Add(&*property.statistics);
+        }
+      }
+    }
+  }
+
+  if (tileStatistics.IsEmpty()) {
+    return false;
+  }
+
+  Statistics = CesiumTilePropertyStatistics::aggregate(
+      tileStatistics,
+      HistogramBucketCount);
+  return Statistics.Count > 0;
+}
+
+#if WITH_EDITOR
+void UCesiumFeaturesMetadataComponent::PostEditChangeProperty(
+    FPropertyChangedEvent& PropertyChangedEvent) {
+  Super::PostEditChangeProperty(PropertyChangedEvent);
+
+  if (PropertyChangedEvent.GetMemberPropertyName() ==
+      GET_MEMBER_NAME_CHECKED(UCesiumFeaturesMetadataComponent, Style)) {
+    ++this->_styleVersion;
+  }
+}
+#endif
+
+TArray<FCesiumPropertyTableDescription>
+UCesiumFeaturesMetadataComponent::GetPropertyTablesToEncode(
+    const TArray<const UMaterialInterface*>& Materials) const {
+  if (!this->EncodePropertiesOnDemand) {
+    return this->PropertyTables;
+  }
+
+  // Generated materials sample each property table property through a
+  // texture parameter, which may be in a material layer.
+  TSet<FName> textureParameters;
+  TArray<FMaterialParameterInfo> parameterInfos;
+  TArray<FGuid> parameterIds;
+  for (const UMaterialInterface* pMaterial : Materials) {
+    if (!pMaterial) {
+      continue;
+    }
+
+    pMaterial->GetAllTextureParameterInfo(parameterInfos, parameterIds);
+    for (const FMaterialParameterInfo& info : parameterInfos) {
+      textureParameters.Add(info.Name);
+    }
+  }
+
+  TArray<FCesiumPropertyTableDescription> result;
+  result.Reserve(this->PropertyTables.Num());
+  for (const FCesiumPropertyTableDescription& propertyTable :
+       this->PropertyTables) {
+    const TArray<FString>* pUsedProperties =
+        this->_usedProperties.Find(propertyTable.Name);
+
+    FCesiumPropertyTableDescription& usedPropertyTable =
+        result.Emplace_GetRef();
+    usedPropertyTable.Name = propertyTable.Name;
+    for (const FCesiumPropertyTablePropertyDescription& property :
+         propertyTable.Properties) {
+      bool isUsed;
+      if (pUsedProperties) {
+        isUsed = pUsedProperties->Contains(property.Name);
+      } else {
+        const FString parameterName = CesiumEncodedFeaturesMetadata::
+            getMaterialNameForPropertyTableProperty(
+                propertyTable.Name,
+                CesiumEncodedFeaturesMetadata::createHlslSafeName(
+                    property.Name));
+        isUsed = textureParameters.Contains(FName(parameterName));
+      }
+
+      if (isUsed) {
+        usedPropertyTable.Properties.Add(property);
+      }
+    }
+  }
+
+  return result;
+}
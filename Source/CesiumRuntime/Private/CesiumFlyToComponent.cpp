@@ -1,12 +1,16 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumFlyToComponent.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CesiumCamera.h"
+#include "CesiumCameraManager.h"
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Curves/CurveFloat.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
 #include "UObject/ConstructorHelpers.h"
 #include "VecMath.h"
 
@@ -109,6 +113,8 @@ void UCesiumFlyToComponent::FlyToLocationEarthCenteredEarthFixed(
   this->_previousPositionEcef = ecefSource;
   this->_flightInProgress = true;
   this->_destinationEcef = EarthCenteredEarthFixedDestination;
+
+  this->addPrefetchCameras();
 }
 
 void UCesiumFlyToComponent::FlyToLocationLongitudeLatitudeHeight(
@@ -164,6 +170,7 @@ void UCesiumFlyToComponent::FlyToLocationUnreal(
 
 void UCesiumFlyToComponent::InterruptFlight() {
   this->_flightInProgress = false;
+  this->removePrefetchCameras(1.0f);
 
   UCesiumGlobeAnchorComponent* GlobeAnchor = this->GetGlobeAnchor();
   if (IsValid(GlobeAnchor)) {
@@ -179,6 +186,11 @@ void UCesiumFlyToComponent::InterruptFlight() {
   OnFlightInterrupted.Broadcast();
 }
 
+void UCesiumFlyToComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  this->removePrefetchCameras(1.0f);
+  Super::EndPlay(EndPlayReason);
+}
+
 void UCesiumFlyToComponent::TickComponent(
     float DeltaTime,
     ELevelTick TickType,
@@ -205,20 +217,8 @@ void UCesiumFlyToComponent::TickComponent(
 
   this->_currentFlyTime += DeltaTime;
 
-  // In order to accelerate at start and slow down at end, we use a progress
-  // profile curve
-  float flyPercentage;
-  if (this->_currentFlyTime >= this->Duration) {
-    flyPercentage = 1.0f;
-  } else if (this->ProgressCurve) {
-    flyPercentage = glm::clamp(
-        this->ProgressCurve->GetFloatValue(
-            this->_currentFlyTime / this->Duration),
-        0.0f,
-        1.0f);
-  } else {
-    flyPercentage = this->_currentFlyTime / this->Duration;
-  }
+  const float flyPercentage = this->computeFlyPercentage(this->_currentFlyTime);
+  this->removePrefetchCameras(flyPercentage);
 
   // If we reached the end, set actual destination location and
   // orientation
@@ -229,6 +229,7 @@ void UCesiumFlyToComponent::TickComponent(
     this->SetCurrentRotationEastSouthUp(this->_destinationRotation);
     this->_flightInProgress = false;
     this->_currentFlyTime = 0.0f;
+    this->removePrefetchCameras(1.0f);
 
     // Trigger callback accessible from BP
     UE_LOG(LogCesium, Verbose, TEXT("Broadcasting OnFlightComplete"));
@@ -237,17 +238,7 @@ void UCesiumFlyToComponent::TickComponent(
     return;
   }
 
-  // Get altitude offset from profile curve if one is specified
-  double altitudeOffset = 0.0;
-  if (this->_maxHeight != 0.0 && this->HeightPercentageCurve) {
-    double curveOffset =
-        this->_maxHeight *
-        this->HeightPercentageCurve->GetFloatValue(flyPercentage);
-    altitudeOffset = curveOffset;
-  }
-
-  glm::dvec3 currentPositionEcef =
-      _currentCurve->getPosition(flyPercentage, altitudeOffset);
+  glm::dvec3 currentPositionEcef = this->computePositionEcef(flyPercentage);
 
   FVector currentPositionVector(
       currentPositionEcef.x,
@@ -269,6 +260,135 @@ void UCesiumFlyToComponent::TickComponent(
       GlobeAnchor->GetEarthCenteredEarthFixedPosition();
 }
 
+bool UCesiumFlyToComponent::PredictLocationUnreal(
+    float Seconds,
+    FVector& Location) {
+  if (!this->_flightInProgress || !this->_currentCurve) {
+    return false;
+  }
+
+  UCesiumGlobeAnchorComponent* GlobeAnchor = this->GetGlobeAnchor();
+  if (!IsValid(GlobeAnchor)) {
+    return false;
+  }
+
+  ACesiumGeoreference* Georeference = GlobeAnchor->ResolveGeoreference();
+  if (!IsValid(Georeference)) {
+    return false;
+  }
+
+  const float flyTime = this->_currentFlyTime + FMath::Max(Seconds, 0.0f);
+  const glm::dvec3 positionEcef =
+      flyTime >= this->Duration
+          ? VecMath::createVector3D(this->_destinationEcef)
+          : this->computePositionEcef(this->computeFlyPercentage(flyTime));
+
+  Location = Georeference->TransformEarthCenteredEarthFixedPositionToUnreal(
+      FVector(positionEcef.x, positionEcef.y, positionEcef.z));
+  return true;
+}
+
+float UCesiumFlyToComponent::computeFlyPercentage(float flyTime) const {
+  // In order to accelerate at start and slow down at end, we use a progress
+  // profile curve
+  if (flyTime >= this->Duration) {
+    return 1.0f;
+  } else if (this->ProgressCurve) {
+    return glm::clamp(
+        this->ProgressCurve->GetFloatValue(flyTime / this->Duration),
+        0.0f,
+        1.0f);
+  } else {
+    return flyTime / this->Duration;
+  }
+}
+
+glm::dvec3
+UCesiumFlyToComponent::computePositionEcef(float flyPercentage) const {
+  // Get altitude offset from profile curve if one is specified
+  double altitudeOffset = 0.0;
+  if (this->_maxHeight != 0.0 && this->HeightPercentageCurve) {
+    double curveOffset =
+        this->_maxHeight *
+        this->HeightPercentageCurve->GetFloatValue(flyPercentage);
+    altitudeOffset = curveOffset;
+  }
+
+  return this->_currentCurve->getPosition(flyPercentage, altitudeOffset);
+}
+
+void UCesiumFlyToComponent::addPrefetchCameras() {
+  this->removePrefetchCameras(1.0f);
+  if (!this->PrefetchDestination || !this->_currentCurve) {
+    return;
+  }
+
+  ACesiumGeoreference* Georeference =
+      this->GetGlobeAnchor()->ResolveGeoreference();
+  ACesiumCameraManager* CameraManager =
+      ACesiumCameraManager::GetDefaultCameraManager(this);
+  if (!IsValid(Georeference) || !IsValid(CameraManager)) {
+    return;
+  }
+
+  // Use the view of the player controlling the Actor, if there is one.
+  FVector2D viewportSize(1920.0, 1080.0);
+  double fieldOfView = 90.0;
+  APawn* Pawn = Cast<APawn>(this->GetOwner());
+  APlayerController* PlayerController =
+      IsValid(Pawn) ? Cast<APlayerController>(Pawn->Controller) : nullptr;
+  if (PlayerController) {
+    int32 sizeX, sizeY;
+    PlayerController->GetViewportSize(sizeX, sizeY);
+    if (sizeX > 0 && sizeY > 0) {
+      viewportSize = FVector2D(sizeX, sizeY);
+    }
+    if (PlayerController->PlayerCameraManager) {
+      fieldOfView = PlayerController->PlayerCameraManager->GetFOVAngle();
+    }
+  }
+
+  this->_pPrefetchCameraManager = CameraManager;
+
+  const int32 samples = FMath::Max(this->PrefetchPathSamples, 0);
+  for (int32 i = 1; i <= samples + 1; ++i) {
+    const float flyPercentage = float(i) / float(samples + 1);
+    const glm::dvec3 positionEcef =
+        i > samples ? VecMath::createVector3D(this->_destinationEcef)
+                    : this->computePositionEcef(flyPercentage);
+    const FVector location =
+        Georeference->TransformEarthCenteredEarthFixedPositionToUnreal(
+            FVector(positionEcef.x, positionEcef.y, positionEcef.z));
+    const FQuat eastSouthUpRotation = FQuat::Slerp(
+        this->_sourceRotation,
+        this->_destinationRotation,
+        flyPercentage);
+    const FRotator rotation = Georeference->TransformEastSouthUpRotatorToUnreal(
+        eastSouthUpRotation.Rotator(),
+        location);
+
+    const int32 cameraId = CameraManager->AddCamera(
+        FCesiumCamera(viewportSize, location, rotation, fieldOfView));
+    this->_prefetchCameras.Add({flyPercentage, cameraId});
+  }
+}
+
+void UCesiumFlyToComponent::removePrefetchCameras(float upToFlyPercentage) {
+  ACesiumCameraManager* CameraManager = this->_pPrefetchCameraManager.Get();
+  for (int32 i = 0; i < this->_prefetchCameras.Num();) {
+    const PrefetchCamera& camera = this->_prefetchCameras[i];
+    if (camera.flyPercentage > upToFlyPercentage) {
+      ++i;
+      continue;
+    }
+
+    if (CameraManager) {
+      CameraManager->RemoveCamera(camera.cameraId);
+    }
+    this->_prefetchCameras.RemoveAt(i);
+  }
+}
+
 FQuat UCesiumFlyToComponent::GetCurrentRotationEastSouthUp() {
   if (this->RotationToUse != ECesiumFlyToRotation::Actor) {
     APawn* Pawn = Cast<APawn>(this->GetOwner());
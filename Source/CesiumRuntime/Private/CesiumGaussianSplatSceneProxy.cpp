@@ -0,0 +1,464 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGaussianSplatSceneProxy.h"
+#include "CesiumGltfGaussianSplatComponent.h"
+#include "CommonRenderResources.h"
+#include "GlobalShader.h"
+#include "PipelineStateCache.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "Runtime/Renderer/Private/PostProcess/PostProcessing.h"
+#include "Runtime/Renderer/Private/SceneRendering.h"
+#include "SceneInterface.h"
+#include "ShaderParameterStruct.h"
+
+namespace {
+
+constexpr int32 SortThreadGroupSize = 256;
+constexpr int32 SortGroupElements = SortThreadGroupSize * 2;
+
+// The splats are sorted again once the view has moved by this fraction of its
+// distance to them, or has turned by about half a degree.
+constexpr double ResortDistanceFraction = 0.01;
+constexpr double ResortDirectionCosine = 0.99996;
+
+/**
+ * The proxies whose render thread resources have been created. Only accessed
+ * from the render thread.
+ */
+TArray<FCesiumGaussianSplatSceneProxy*>& getProxies() {
+  static TArray<FCesiumGaussianSplatSceneProxy*> proxies;
+  return proxies;
+}
+
+class FCesiumGaussianSplatShader : public FGlobalShader {
+public:
+  FCesiumGaussianSplatShader() = default;
+  FCesiumGaussianSplatShader(
+      const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+      : FGlobalShader(Initializer) {}
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+  }
+
+  static void ModifyCompilationEnvironment(
+      const FGlobalShaderPermutationParameters& Parameters,
+      FShaderCompilerEnvironment& OutEnvironment) {
+    FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+    OutEnvironment.SetDefine(
+        TEXT("SORT_THREAD_GROUP_SIZE"),
+        SortThreadGroupSize);
+  }
+};
+
+class FCesiumGaussianSplatKeysCS : public FCesiumGaussianSplatShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumGaussianSplatKeysCS);
+  SHADER_USE_PARAMETER_STRUCT(
+      FCesiumGaussianSplatKeysCS,
+      FCesiumGaussianSplatShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, Splats)
+  SHADER_PARAMETER(uint32, NumSplats)
+  SHADER_PARAMETER(FMatrix44f, LocalToView)
+  SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint2>, RWSortPairs)
+  SHADER_PARAMETER(uint32, NumSortPairs)
+  END_SHADER_PARAMETER_STRUCT()
+};
+
+class FCesiumGaussianSplatSortCS : public FCesiumGaussianSplatShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumGaussianSplatSortCS);
+  SHADER_USE_PARAMETER_STRUCT(
+      FCesiumGaussianSplatSortCS,
+      FCesiumGaussianSplatShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_RDG_BUFFER_UAV(RWStructuredBuffer<uint2>, RWSortPairs)
+  SHADER_PARAMETER(uint32, SortK)
+  SHADER_PARAMETER(uint32, SortJ)
+  END_SHADER_PARAMETER_STRUCT()
+};
+
+class FCesiumGaussianSplatVS : public FCesiumGaussianSplatShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumGaussianSplatVS);
+  SHADER_USE_PARAMETER_STRUCT(
+      FCesiumGaussianSplatVS,
+      FCesiumGaussianSplatShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, Splats)
+  SHADER_PARAMETER(uint32, NumSplats)
+  SHADER_PARAMETER(FMatrix44f, LocalToView)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<uint2>, SortPairs)
+  SHADER_PARAMETER(float, MinimumAlpha)
+  END_SHADER_PARAMETER_STRUCT()
+};
+
+class FCesiumGaussianSplatPS : public FCesiumGaussianSplatShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumGaussianSplatPS);
+  SHADER_USE_PARAMETER_STRUCT(
+      FCesiumGaussianSplatPS,
+      FCesiumGaussianSplatShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+  SHADER_PARAMETER(float, MinimumAlpha)
+  END_SHADER_PARAMETER_STRUCT()
+};
+
+BEGIN_SHADER_PARAMETER_STRUCT(FCesiumGaussianSplatDrawParameters, )
+SHADER_PARAMETER_STRUCT_INCLUDE(FCesiumGaussianSplatVS::FParameters, VS)
+SHADER_PARAMETER_STRUCT_INCLUDE(FCesiumGaussianSplatPS::FParameters, PS)
+RENDER_TARGET_BINDING_SLOTS()
+END_SHADER_PARAMETER_STRUCT()
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumGaussianSplatKeysCS,
+    "/Plugin/CesiumForUnreal/Private/CesiumGaussianSplatting.usf",
+    "KeysCS",
+    SF_Compute);
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumGaussianSplatSortCS,
+    "/Plugin/CesiumForUnreal/Private/CesiumGaussianSplatting.usf",
+    "SortCS",
+    SF_Compute);
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumGaussianSplatVS,
+    "/Plugin/CesiumForUnreal/Private/CesiumGaussianSplatting.usf",
+    "MainVS",
+    SF_Vertex);
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumGaussianSplatPS,
+    "/Plugin/CesiumForUnreal/Private/CesiumGaussianSplatting.usf",
+    "MainPS",
+    SF_Pixel);
+
+// Splats that are more transparent than this aren't drawn.
+constexpr float MinimumAlpha = 1.0f / 255.0f;
+
+} // namespace
+
+FCesiumGaussianSplatSceneProxy::FCesiumGaussianSplatSceneProxy(
+    UCesiumGltfGaussianSplatComponent* InComponent,
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FPrimitiveSceneProxy(InComponent),
+      Splats(InComponent->Splats),
+      NumSplats(
+          Splats ? Splats->Num() / CesiumGaussianSplats::Float4sPerSplat : 0),
+      VisibleViews(),
+      VisibleFrameNumber(0),
+      SplatBuffer(),
+      SortBuffer(),
+      SortedViewOrigin(0.0),
+      SortedViewDirection(0.0),
+      bIsSorted(false) {}
+
+FCesiumGaussianSplatSceneProxy::~FCesiumGaussianSplatSceneProxy() {}
+
+SIZE_T FCesiumGaussianSplatSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+void FCesiumGaussianSplatSceneProxy::CreateRenderThreadResources(
+    FRHICommandListBase& RHICmdList) {
+  getProxies().Add(this);
+}
+#else
+void FCesiumGaussianSplatSceneProxy::CreateRenderThreadResources() {
+  getProxies().Add(this);
+}
+#endif
+
+void FCesiumGaussianSplatSceneProxy::DestroyRenderThreadResources() {
+  getProxies().RemoveSwap(this);
+  SplatBuffer.SafeRelease();
+  SortBuffer.SafeRelease();
+}
+
+void FCesiumGaussianSplatSceneProxy::GetDynamicMeshElements(
+    const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily,
+    uint32 VisibilityMap,
+    FMeshElementCollector& Collector) const {
+  // The splats are drawn after translucency, so no mesh is added. Each view
+  // family of a frame adds its views.
+  if (VisibleFrameNumber != ViewFamily.FrameNumber) {
+    VisibleViews.Reset();
+    VisibleFrameNumber = ViewFamily.FrameNumber;
+  }
+
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
+    if (VisibilityMap & (1 << ViewIndex)) {
+      VisibleViews.AddUnique(Views[ViewIndex]);
+    }
+  }
+}
+
+FPrimitiveViewRelevance
+FCesiumGaussianSplatSceneProxy::GetViewRelevance(const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View) && NumSplats > 0;
+  Result.bDynamicRelevance = true;
+  Result.bStaticRelevance = false;
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bShadowRelevance = false;
+  Result.bVelocityRelevance = false;
+  return Result;
+}
+
+uint32 FCesiumGaussianSplatSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize());
+}
+
+bool FCesiumGaussianSplatSceneProxy::IsVisibleIn(
+    const FSceneView& View) const {
+  return NumSplats > 0 && VisibleFrameNumber == View.Family->FrameNumber &&
+         VisibleViews.Contains(&View);
+}
+
+FMatrix44f
+FCesiumGaussianSplatSceneProxy::GetLocalToView(const FSceneView& View) const {
+  const FMatrix LocalToTranslatedWorld = GetLocalToWorld().ConcatTranslation(
+      View.ViewMatrices.GetPreViewTranslation());
+  return FMatrix44f(
+      LocalToTranslatedWorld * View.ViewMatrices.GetTranslatedViewMatrix());
+}
+
+/*static*/ void FCesiumGaussianSplatSceneProxy::AddPasses(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    const FPostProcessingInputs& Inputs) {
+  if (!View.bIsViewInfo || View.GetFeatureLevel() < ERHIFeatureLevel::SM5 ||
+      !Inputs.SceneTextures) {
+    return;
+  }
+
+  TArray<FCesiumGaussianSplatSceneProxy*, TInlineAllocator<64>> visible;
+  for (FCesiumGaussianSplatSceneProxy* pProxy : getProxies()) {
+    if (pProxy->IsVisibleIn(View)) {
+      visible.Add(pProxy);
+    }
+  }
+
+  if (visible.IsEmpty()) {
+    return;
+  }
+
+  const FSceneTextureUniformParameters& sceneTextures =
+      *Inputs.SceneTextures->GetParameters();
+  if (!sceneTextures.SceneColorTexture || !sceneTextures.SceneDepthTexture) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GaussianSplats)
+  RDG_EVENT_SCOPE(GraphBuilder, "CesiumGaussianSplats");
+
+  // The splats of different proxies are sorted separately, so the proxies
+  // are drawn back to front as a whole.
+  const FVector viewOrigin = View.ViewMatrices.GetViewOrigin();
+  visible.Sort([&viewOrigin](
+                   const FCesiumGaussianSplatSceneProxy& a,
+                   const FCesiumGaussianSplatSceneProxy& b) {
+    return FVector::DistSquared(a.GetBounds().Origin, viewOrigin) >
+           FVector::DistSquared(b.GetBounds().Origin, viewOrigin);
+  });
+
+  for (FCesiumGaussianSplatSceneProxy* pProxy : visible) {
+    pProxy->AddSortPasses(GraphBuilder, View);
+    pProxy->AddDrawPass(
+        GraphBuilder,
+        View,
+        sceneTextures.SceneColorTexture,
+        sceneTextures.SceneDepthTexture);
+  }
+}
+
+void FCesiumGaussianSplatSceneProxy::AddSortPasses(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View) {
+  if (!SplatBuffer) {
+    FRDGBufferRef splats = CreateStructuredBuffer(
+        GraphBuilder,
+        TEXT("CesiumGaussianSplats"),
+        sizeof(FVector4f),
+        Splats->Num(),
+        Splats->GetData(),
+        Splats->Num() * sizeof(FVector4f));
+    SplatBuffer = GraphBuilder.ConvertToExternalBuffer(splats);
+  }
+
+  const FVector viewOrigin = View.ViewMatrices.GetViewOrigin();
+  const FVector viewDirection = View.GetViewDirection();
+  if (bIsSorted && SortBuffer) {
+    const FBoxSphereBounds& bounds = GetBounds();
+    const double distance =
+        FVector::Dist(bounds.Origin, viewOrigin) + bounds.SphereRadius;
+    if (FVector::Dist(viewOrigin, SortedViewOrigin) <=
+            distance * ResortDistanceFraction &&
+        FVector::DotProduct(viewDirection, SortedViewDirection) >=
+            ResortDirectionCosine) {
+      return;
+    }
+  }
+
+  const uint32 numSortPairs = FMath::Max(
+      FMath::RoundUpToPowerOfTwo(uint32(NumSplats)),
+      uint32(SortGroupElements));
+  const uint64 sortBytes = uint64(numSortPairs) * sizeof(uint32) * 2;
+  if (!SortBuffer || SortBuffer->GetSize() != sortBytes) {
+    SortBuffer = GraphBuilder.ConvertToExternalBuffer(GraphBuilder.CreateBuffer(
+        FRDGBufferDesc::CreateStructuredDesc(sizeof(uint32) * 2, numSortPairs),
+        TEXT("CesiumGaussianSplatSortPairs")));
+  }
+
+  FRDGBufferRef splats = GraphBuilder.RegisterExternalBuffer(SplatBuffer);
+  FRDGBufferRef sortPairs = GraphBuilder.RegisterExternalBuffer(SortBuffer);
+  FRDGBufferUAVRef sortPairsUAV = GraphBuilder.CreateUAV(sortPairs);
+  const FGlobalShaderMap* pShaderMap =
+      static_cast<const FViewInfo&>(View).ShaderMap;
+
+  {
+    auto* pParameters =
+        GraphBuilder.AllocParameters<FCesiumGaussianSplatKeysCS::FParameters>();
+    pParameters->Splats = GraphBuilder.CreateSRV(splats);
+    pParameters->NumSplats = uint32(NumSplats);
+    pParameters->LocalToView = GetLocalToView(View);
+    pParameters->RWSortPairs = sortPairsUAV;
+    pParameters->NumSortPairs = numSortPairs;
+    FComputeShaderUtils::AddPass(
+        GraphBuilder,
+        RDG_EVENT_NAME("CesiumGaussianSplatKeys"),
+        TShaderMapRef<FCesiumGaussianSplatKeysCS>(pShaderMap),
+        pParameters,
+        FIntVector(int32(numSortPairs) / SortThreadGroupSize, 1, 1));
+  }
+
+  // Each group first sorts its own pairs. Then, for each size of the
+  // sequences being merged, the pairs that are further apart than a group
+  // are compared one step at a time, and the rest of the steps are made
+  // together in groupshared memory.
+  TShaderMapRef<FCesiumGaussianSplatSortCS> sortShader(pShaderMap);
+  const FIntVector groups(int32(numSortPairs) / SortGroupElements, 1, 1);
+  auto addSortPass = [&](uint32 k, uint32 j) {
+    auto* pParameters =
+        GraphBuilder.AllocParameters<FCesiumGaussianSplatSortCS::FParameters>();
+    pParameters->RWSortPairs = sortPairsUAV;
+    pParameters->SortK = k;
+    pParameters->SortJ = j;
+    FComputeShaderUtils::AddPass(
+        GraphBuilder,
+        RDG_EVENT_NAME("CesiumGaussianSplatSort"),
+        sortShader,
+        pParameters,
+        groups);
+  };
+
+  addSortPass(0, 0);
+  for (uint32 k = SortGroupElements * 2; k <= numSortPairs; k <<= 1) {
+    uint32 j = k >> 1;
+    for (; j >= uint32(SortGroupElements); j >>= 1) {
+      addSortPass(k, j);
+    }
+    addSortPass(k, j);
+  }
+
+  SortedViewOrigin = viewOrigin;
+  SortedViewDirection = viewDirection;
+  bIsSorted = true;
+}
+
+void FCesiumGaussianSplatSceneProxy::AddDrawPass(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    FRDGTextureRef SceneColor,
+    FRDGTextureRef SceneDepth) {
+  const FViewInfo& viewInfo = static_cast<const FViewInfo&>(View);
+
+  auto* pParameters =
+      GraphBuilder.AllocParameters<FCesiumGaussianSplatDrawParameters>();
+  pParameters->VS.View = View.ViewUniformBuffer;
+  pParameters->VS.Splats =
+      GraphBuilder.CreateSRV(GraphBuilder.RegisterExternalBuffer(SplatBuffer));
+  pParameters->VS.NumSplats = uint32(NumSplats);
+  pParameters->VS.LocalToView = GetLocalToView(View);
+  pParameters->VS.SortPairs =
+      GraphBuilder.CreateSRV(GraphBuilder.RegisterExternalBuffer(SortBuffer));
+  pParameters->VS.MinimumAlpha = MinimumAlpha;
+  pParameters->PS.View = View.ViewUniformBuffer;
+  pParameters->PS.MinimumAlpha = MinimumAlpha;
+  pParameters->RenderTargets[0] =
+      FRenderTargetBinding(SceneColor, ERenderTargetLoadAction::ELoad);
+  pParameters->RenderTargets.DepthStencil = FDepthStencilBinding(
+      SceneDepth,
+      ERenderTargetLoadAction::ELoad,
+      ERenderTargetLoadAction::ENoAction,
+      FExclusiveDepthStencil::DepthRead_StencilNop);
+
+  TShaderMapRef<FCesiumGaussianSplatVS> vertexShader(viewInfo.ShaderMap);
+  TShaderMapRef<FCesiumGaussianSplatPS> pixelShader(viewInfo.ShaderMap);
+  const FIntRect viewRect = viewInfo.ViewRect;
+  const uint32 numInstances = uint32(NumSplats);
+
+  GraphBuilder.AddPass(
+      RDG_EVENT_NAME("CesiumGaussianSplatDraw"),
+      pParameters,
+      ERDGPassFlags::Raster,
+      [pParameters, vertexShader, pixelShader, viewRect, numInstances](
+          FRHICommandList& RHICmdList) {
+        RHICmdList.SetViewport(
+            float(viewRect.Min.X),
+            float(viewRect.Min.Y),
+            0.0f,
+            float(viewRect.Max.X),
+            float(viewRect.Max.Y),
+            1.0f);
+
+        // The splats are premultiplied and blended over each other in sorted
+        // order. They are depth tested against the scene, but don't write
+        // depth.
+        FGraphicsPipelineStateInitializer pipelineState;
+        RHICmdList.ApplyCachedRenderTargets(pipelineState);
+        pipelineState.BlendState = TStaticBlendState<
+            CW_RGB,
+            BO_Add,
+            BF_One,
+            BF_InverseSourceAlpha>::GetRHI();
+        pipelineState.RasterizerState =
+            TStaticRasterizerState<FM_Solid, CM_None>::GetRHI();
+        pipelineState.DepthStencilState =
+            TStaticDepthStencilState<false, CF_DepthNearOrEqual>::GetRHI();
+        pipelineState.BoundShaderState.VertexDeclarationRHI =
+            GEmptyVertexDeclaration.VertexDeclarationRHI;
+        pipelineState.BoundShaderState.VertexShaderRHI =
+            vertexShader.GetVertexShader();
+        pipelineState.BoundShaderState.PixelShaderRHI =
+            pixelShader.GetPixelShader();
+        pipelineState.PrimitiveType = PT_TriangleStrip;
+        SetGraphicsPipelineState(RHICmdList, pipelineState, 0);
+
+        SetShaderParameters(
+            RHICmdList,
+            vertexShader,
+            vertexShader.GetVertexShader(),
+            pParameters->VS);
+        SetShaderParameters(
+            RHICmdList,
+            pixelShader,
+            pixelShader.GetPixelShader(),
+            pParameters->PS);
+
+        RHICmdList.DrawPrimitive(0, 2, numInstances);
+      });
+}
@@ -0,0 +1,94 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "CesiumGaussianSplats.h"
+#include "PrimitiveSceneProxy.h"
+#include "RenderGraphResources.h"
+
+class FRDGBuilder;
+class UCesiumGltfGaussianSplatComponent;
+struct FPostProcessingInputs;
+
+/**
+ * Draws the Gaussian splats of a glTF primitive.
+ *
+ * The splats are blended over the scene color, back to front, after the
+ * translucency of each view. They don't go through the mesh passes at all: the
+ * proxy only records the views it's visible in, and the splats of all visible
+ * proxies are then drawn by {@link AddPasses}, farthest proxy first.
+ *
+ * The splats of each proxy are sorted by their depth in the view on the GPU,
+ * with a bitonic sort. Since they only need to be sorted again when the view
+ * has moved or turned noticeably, the sorted order is kept from frame to
+ * frame.
+ */
+class FCesiumGaussianSplatSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  FCesiumGaussianSplatSceneProxy(
+      UCesiumGltfGaussianSplatComponent* InComponent,
+      ERHIFeatureLevel::Type InFeatureLevel);
+
+  virtual ~FCesiumGaussianSplatSceneProxy();
+
+  SIZE_T GetTypeHash() const override;
+
+  /**
+   * Sorts and draws the splats of the proxies that are visible in a view. Must
+   * be called from the render thread, after the proxies' dynamic mesh elements
+   * have been gathered for the view.
+   */
+  static void AddPasses(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      const FPostProcessingInputs& Inputs);
+
+protected:
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  virtual void
+  CreateRenderThreadResources(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void CreateRenderThreadResources() override;
+#endif
+  virtual void DestroyRenderThreadResources() override;
+
+  virtual void GetDynamicMeshElements(
+      const TArray<const FSceneView*>& Views,
+      const FSceneViewFamily& ViewFamily,
+      uint32 VisibilityMap,
+      FMeshElementCollector& Collector) const override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  bool IsVisibleIn(const FSceneView& View) const;
+
+  void AddSortPasses(FRDGBuilder& GraphBuilder, const FSceneView& View);
+
+  void AddDrawPass(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      FRDGTextureRef SceneColor,
+      FRDGTextureRef SceneDepth);
+
+  FMatrix44f GetLocalToView(const FSceneView& View) const;
+
+  CesiumGaussianSplats::PackedSplats Splats;
+  int32 NumSplats;
+
+  // The views that the proxy is visible in, in the frame it was last drawn.
+  mutable TArray<const FSceneView*, TInlineAllocator<2>> VisibleViews;
+  mutable uint32 VisibleFrameNumber;
+
+  // The splats, once they have been uploaded, and their sort keys and indices
+  // sorted for the view at SortedViewOrigin looking along SortedViewDirection.
+  TRefCountPtr<FRDGPooledBuffer> SplatBuffer;
+  TRefCountPtr<FRDGPooledBuffer> SortBuffer;
+  FVector SortedViewOrigin;
+  FVector SortedViewDirection;
+  bool bIsSorted;
+};
@@ -0,0 +1,166 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGaussianSplats.h"
+#include "Rendering/ColorVertexBuffer.h"
+#include "Rendering/PositionVertexBuffer.h"
+#include "VecMath.h"
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/Model.h>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/mat3x3.hpp>
+#include <type_traits>
+
+using namespace CesiumGltf;
+
+namespace {
+
+const std::string scaleAttributes[] = {
+    "KHR_gaussian_splatting:SCALE",
+    "_SCALE"};
+const std::string rotationAttributes[] = {
+    "KHR_gaussian_splatting:ROTATION",
+    "_ROTATION"};
+
+int32_t findAttribute(
+    const MeshPrimitive& primitive,
+    const std::string (&names)[2]) {
+  for (const std::string& name : names) {
+    auto it = primitive.attributes.find(name);
+    if (it != primitive.attributes.end()) {
+      return it->second;
+    }
+  }
+  return -1;
+}
+
+template <typename T> struct is_quat : std::false_type {};
+
+template <typename T>
+struct is_quat<AccessorTypes::VEC4<T>>
+    : std::disjunction<
+          std::is_same<T, float>,
+          std::conjunction<std::is_integral<T>, std::is_signed<T>>> {};
+
+template <typename T> float normalizedComponent(T value) {
+  if constexpr (std::is_same_v<T, float>) {
+    return value;
+  } else {
+    return GltfNormalized(value);
+  }
+}
+
+} // namespace
+
+namespace CesiumGaussianSplats {
+
+bool isGaussianSplatPrimitive(const MeshPrimitive& primitive) {
+  return primitive.mode == MeshPrimitive::Mode::POINTS &&
+         findAttribute(primitive, scaleAttributes) >= 0 &&
+         findAttribute(primitive, rotationAttributes) >= 0;
+}
+
+void packSplat(
+    const FVector3f& position,
+    const FVector3f& scale,
+    const FVector4f& rotation,
+    const FColor& color,
+    FVector4f* pOut) {
+  glm::quat quaternion(rotation.W, rotation.X, rotation.Y, rotation.Z);
+  const float length = glm::length(quaternion);
+  quaternion =
+      length > 0.0f ? quaternion / length : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+
+  // The covariance is R * S * S^T * R^T, where the columns of R are the axes
+  // of the splat and S scales them.
+  const glm::mat3 axes = glm::mat3_cast(quaternion);
+  const glm::mat3 scaledAxes(
+      axes[0] * scale.X,
+      axes[1] * scale.Y,
+      axes[2] * scale.Z);
+  const glm::mat3 covariance = scaledAxes * glm::transpose(scaledAxes);
+
+  // The static mesh inverts Y, which negates the elements that mix Y with
+  // another axis.
+  pOut[0] = FVector4f(position, float(color.A) / 255.0f);
+  pOut[1] = FVector4f(
+      covariance[0][0],
+      -covariance[0][1],
+      covariance[0][2],
+      covariance[1][1]);
+
+  const uint32 packedColor = uint32(color.R) | (uint32(color.G) << 8) |
+                             (uint32(color.B) << 16) | (uint32(color.A) << 24);
+  float colorBits;
+  FMemory::Memcpy(&colorBits, &packedColor, sizeof(float));
+  pOut[2] = FVector4f(-covariance[1][2], covariance[2][2], colorBits, 0.0f);
+}
+
+PackedSplats load(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FPositionVertexBuffer& positions,
+    const FColorVertexBuffer* pColors,
+    const uint32* pVertexSources) {
+  const Accessor* pScaleAccessor = Model::getSafe(
+      &model.accessors,
+      findAttribute(primitive, scaleAttributes));
+  const Accessor* pRotationAccessor = Model::getSafe(
+      &model.accessors,
+      findAttribute(primitive, rotationAttributes));
+  if (!pScaleAccessor || !pRotationAccessor) {
+    return nullptr;
+  }
+
+  const int64 count = int64(positions.GetNumVertices());
+  AccessorView<FVector3f> scaleView(model, *pScaleAccessor);
+  if (count == 0 || scaleView.status() != AccessorViewStatus::Valid ||
+      pRotationAccessor->count != scaleView.size()) {
+    return nullptr;
+  }
+
+  const bool hasColors =
+      pColors && int64(pColors->GetNumVertices()) == count;
+
+  TSharedRef<TArray<FVector4f>, ESPMode::ThreadSafe> pSplats =
+      MakeShared<TArray<FVector4f>, ESPMode::ThreadSafe>();
+  pSplats->SetNumUninitialized(count * Float4sPerSplat);
+
+  bool valid = false;
+  createAccessorView(model, *pRotationAccessor, [&](auto&& rotationView) {
+    using Element = std::decay_t<decltype(rotationView[0])>;
+    if constexpr (is_quat<Element>::value) {
+      if (rotationView.status() != AccessorViewStatus::Valid) {
+        return;
+      }
+
+      for (int64 i = 0; i < count; ++i) {
+        const int64 source = pVertexSources ? int64(pVertexSources[i]) : i;
+        if (source >= scaleView.size()) {
+          return;
+        }
+
+        const Element& rotation = rotationView[source];
+        packSplat(
+            positions.VertexPosition(uint32(i)),
+            scaleView[source],
+            FVector4f(
+                normalizedComponent(rotation.value[0]),
+                normalizedComponent(rotation.value[1]),
+                normalizedComponent(rotation.value[2]),
+                normalizedComponent(rotation.value[3])),
+            hasColors ? pColors->VertexColor(uint32(i)) : FColor::White,
+            &(*pSplats)[i * Float4sPerSplat]);
+      }
+      valid = true;
+    }
+  });
+
+  if (!valid) {
+    return nullptr;
+  }
+  return pSplats;
+}
+
+} // namespace CesiumGaussianSplats
@@ -0,0 +1,87 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Color.h"
+#include "Math/Vector.h"
+#include "Math/Vector4.h"
+#include "Templates/SharedPointer.h"
+
+namespace CesiumGltf {
+struct MeshPrimitive;
+struct Model;
+} // namespace CesiumGltf
+
+class FPositionVertexBuffer;
+class FColorVertexBuffer;
+
+/**
+ * Loads the 3D Gaussian splats of glTF point primitives, as described by the
+ * KHR_gaussian_splatting extension, into the form they are drawn from.
+ *
+ * Each splat is packed into three float4s, so that a shader reads it with
+ * three loads:
+ *
+ * - The position, in the coordinates of the static mesh, and the opacity.
+ * - The XX, XY, XZ, and YY elements of the splat's 3D covariance, in the same
+ *   coordinates.
+ * - The YZ and ZZ elements of the covariance, the linear RGBA8 color of the
+ *   splat reinterpreted as a float, and zero.
+ *
+ * The covariance takes the place of the scale and rotation of the splat, so
+ * that the shader doesn't need to build it for every view.
+ */
+namespace CesiumGaussianSplats {
+
+/**
+ * The number of float4s that each splat is packed into.
+ */
+constexpr int32 Float4sPerSplat = 3;
+
+using PackedSplats = TSharedPtr<const TArray<FVector4f>, ESPMode::ThreadSafe>;
+
+/**
+ * Determines if a primitive consists of Gaussian splats: points with a scale
+ * and rotation attribute, named either `KHR_gaussian_splatting:SCALE` and
+ * `KHR_gaussian_splatting:ROTATION`, or `_SCALE` and `_ROTATION` as in earlier
+ * versions of the extension.
+ */
+bool isGaussianSplatPrimitive(const CesiumGltf::MeshPrimitive& primitive);
+
+/**
+ * Packs a single splat.
+ *
+ * @param position The position of the splat, in static mesh coordinates.
+ * @param scale The standard deviations of the splat along its axes, in glTF
+ * coordinates.
+ * @param rotation The rotation of the splat's axes, as an XYZW quaternion in
+ * glTF coordinates.
+ * @param color The color of the splat. Its alpha is the splat's opacity.
+ * @param pOut The three float4s to pack the splat into.
+ */
+void packSplat(
+    const FVector3f& position,
+    const FVector3f& scale,
+    const FVector4f& rotation,
+    const FColor& color,
+    FVector4f* pOut);
+
+/**
+ * Packs the splats of a primitive, from the positions and colors that have
+ * been copied into its static mesh and its scale and rotation attributes.
+ * Scales are linear, and rotations may be floats or normalized integers.
+ *
+ * @param pVertexSources The glTF vertex that each vertex of the static mesh
+ * was copied from, or nullptr if they were copied in order.
+ * @return The packed splats, or nullptr if the attributes aren't valid or
+ * don't have an element for each vertex.
+ */
+PackedSplats load(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive,
+    const FPositionVertexBuffer& positions,
+    const FColorVertexBuffer* pColors,
+    const uint32* pVertexSources);
+
+} // namespace CesiumGaussianSplats
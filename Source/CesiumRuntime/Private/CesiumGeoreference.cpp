@@ -1,6 +1,7 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumGeoreference.h"
+#include "Async/ParallelFor.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Cesium3DTileset.h"
 #include "CesiumActors.h"
@@ -307,6 +308,204 @@ FVector ACesiumGeoreference::TransformUnrealPositionToEarthCenteredEarthFixed(
       VecMath::createVector3D(UnrealPosition)));
 }
 
+namespace {
+
+// The number of positions transformed by each task of a batch transform.
+constexpr int32 PositionsPerTransformChunk = 1024;
+
+/**
+ * Transforms positions by calling the given function for chunks of them, in
+ * parallel if there is more than one chunk.
+ */
+template <typename TransformChunk>
+void transformPositions(
+    TArrayView<const FVector> input,
+    TArrayView<FVector> output,
+    TransformChunk&& transformChunk) {
+  check(output.Num() >= input.Num());
+
+  const int32 count = input.Num();
+  const int32 chunkCount =
+      FMath::DivideAndRoundUp(count, PositionsPerTransformChunk);
+  ParallelFor(
+      chunkCount,
+      [input, output, count, &transformChunk](int32 chunk) {
+        const int32 first = chunk * PositionsPerTransformChunk;
+        const int32 chunkSize =
+            FMath::Min(PositionsPerTransformChunk, count - first);
+        transformChunk(
+            input.Slice(first, chunkSize),
+            output.Slice(first, chunkSize));
+      },
+      chunkCount <= 1 ? EParallelForFlags::ForceSingleThread
+                      : EParallelForFlags::None);
+}
+
+/**
+ * Transforms positions by an affine matrix, with the matrix in locals so that
+ * the loop compiles to straight-line double-precision arithmetic.
+ */
+void transformAffine(
+    const glm::dmat4& matrix,
+    TArrayView<const FVector> input,
+    TArrayView<FVector> output) {
+  const double m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2];
+  const double m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2];
+  const double m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
+  const double m30 = matrix[3][0], m31 = matrix[3][1], m32 = matrix[3][2];
+
+  for (int32 i = 0; i < input.Num(); ++i) {
+    const double x = input[i].X;
+    const double y = input[i].Y;
+    const double z = input[i].Z;
+    output[i] = FVector(
+        m00 * x + m10 * y + m20 * z + m30,
+        m01 * x + m11 * y + m21 * z + m31,
+        m02 * x + m12 * y + m22 * z + m32);
+  }
+}
+
+void longitudeLatitudeHeightToEcef(
+    const Ellipsoid& ellipsoid,
+    TArrayView<const FVector> input,
+    TArrayView<FVector> output) {
+  for (int32 i = 0; i < input.Num(); ++i) {
+    output[i] = VecMath::createVector(
+        ellipsoid.cartographicToCartesian(Cartographic::fromDegrees(
+            input[i].X,
+            input[i].Y,
+            input[i].Z)));
+  }
+}
+
+void ecefToLongitudeLatitudeHeight(
+    const Ellipsoid& ellipsoid,
+    TArrayView<FVector> positions) {
+  for (FVector& position : positions) {
+    std::optional<Cartographic> maybeCartographic =
+        ellipsoid.cartesianToCartographic(VecMath::createVector3D(position));
+    if (!maybeCartographic) {
+      position = FVector(0.0, 0.0, 0.0);
+      continue;
+    }
+
+    position = FVector(
+        CesiumUtility::Math::radiansToDegrees(maybeCartographic->longitude),
+        CesiumUtility::Math::radiansToDegrees(maybeCartographic->latitude),
+        maybeCartographic->height);
+  }
+}
+
+} // namespace
+
+void ACesiumGeoreference::TransformLongitudeLatitudeHeightPositionsToUnreal(
+    const TArray<FVector>& LongitudeLatitudeHeights,
+    TArray<FVector>& UnrealPositions) const {
+  UnrealPositions.SetNumUninitialized(LongitudeLatitudeHeights.Num());
+  this->TransformLongitudeLatitudeHeightPositionsToUnreal(
+      TArrayView<const FVector>(LongitudeLatitudeHeights),
+      TArrayView<FVector>(UnrealPositions));
+}
+
+void ACesiumGeoreference::TransformLongitudeLatitudeHeightPositionsToUnreal(
+    TArrayView<const FVector> LongitudeLatitudeHeights,
+    TArrayView<FVector> UnrealPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformPositions)
+
+  const Ellipsoid& ellipsoid = this->GetEllipsoid()->GetNativeEllipsoid();
+  const glm::dmat4& ecefToUnreal =
+      this->_coordinateSystem.getEcefToLocalTransformation();
+  transformPositions(
+      LongitudeLatitudeHeights,
+      UnrealPositions,
+      [&ellipsoid, &ecefToUnreal](
+          TArrayView<const FVector> input,
+          TArrayView<FVector> output) {
+        longitudeLatitudeHeightToEcef(ellipsoid, input, output);
+        transformAffine(ecefToUnreal, output, output);
+      });
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToLongitudeLatitudeHeight(
+    const TArray<FVector>& UnrealPositions,
+    TArray<FVector>& LongitudeLatitudeHeights) const {
+  LongitudeLatitudeHeights.SetNumUninitialized(UnrealPositions.Num());
+  this->TransformUnrealPositionsToLongitudeLatitudeHeight(
+      TArrayView<const FVector>(UnrealPositions),
+      TArrayView<FVector>(LongitudeLatitudeHeights));
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToLongitudeLatitudeHeight(
+    TArrayView<const FVector> UnrealPositions,
+    TArrayView<FVector> LongitudeLatitudeHeights) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformPositions)
+
+  const Ellipsoid& ellipsoid = this->GetEllipsoid()->GetNativeEllipsoid();
+  const glm::dmat4& unrealToEcef =
+      this->_coordinateSystem.getLocalToEcefTransformation();
+  transformPositions(
+      UnrealPositions,
+      LongitudeLatitudeHeights,
+      [&ellipsoid, &unrealToEcef](
+          TArrayView<const FVector> input,
+          TArrayView<FVector> output) {
+        transformAffine(unrealToEcef, input, output);
+        ecefToLongitudeLatitudeHeight(ellipsoid, output);
+      });
+}
+
+void ACesiumGeoreference::TransformEarthCenteredEarthFixedPositionsToUnreal(
+    const TArray<FVector>& EarthCenteredEarthFixedPositions,
+    TArray<FVector>& UnrealPositions) const {
+  UnrealPositions.SetNumUninitialized(EarthCenteredEarthFixedPositions.Num());
+  this->TransformEarthCenteredEarthFixedPositionsToUnreal(
+      TArrayView<const FVector>(EarthCenteredEarthFixedPositions),
+      TArrayView<FVector>(UnrealPositions));
+}
+
+void ACesiumGeoreference::TransformEarthCenteredEarthFixedPositionsToUnreal(
+    TArrayView<const FVector> EarthCenteredEarthFixedPositions,
+    TArrayView<FVector> UnrealPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformPositions)
+
+  const glm::dmat4& ecefToUnreal =
+      this->_coordinateSystem.getEcefToLocalTransformation();
+  transformPositions(
+      EarthCenteredEarthFixedPositions,
+      UnrealPositions,
+      [&ecefToUnreal](
+          TArrayView<const FVector> input,
+          TArrayView<FVector> output) {
+        transformAffine(ecefToUnreal, input, output);
+      });
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToEarthCenteredEarthFixed(
+    const TArray<FVector>& UnrealPositions,
+    TArray<FVector>& EarthCenteredEarthFixedPositions) const {
+  EarthCenteredEarthFixedPositions.SetNumUninitialized(UnrealPositions.Num());
+  this->TransformUnrealPositionsToEarthCenteredEarthFixed(
+      TArrayView<const FVector>(UnrealPositions),
+      TArrayView<FVector>(EarthCenteredEarthFixedPositions));
+}
+
+void ACesiumGeoreference::TransformUnrealPositionsToEarthCenteredEarthFixed(
+    TArrayView<const FVector> UnrealPositions,
+    TArrayView<FVector> EarthCenteredEarthFixedPositions) const {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TransformPositions)
+
+  const glm::dmat4& unrealToEcef =
+      this->_coordinateSystem.getLocalToEcefTransformation();
+  transformPositions(
+      UnrealPositions,
+      EarthCenteredEarthFixedPositions,
+      [&unrealToEcef](
+          TArrayView<const FVector> input,
+          TArrayView<FVector> output) {
+        transformAffine(unrealToEcef, input, output);
+      });
+}
+
 FVector ACesiumGeoreference::TransformEarthCenteredEarthFixedDirectionToUnreal(
     const FVector& EarthCenteredEarthFixedDirection) const {
   return VecMath::createVector(this->_coordinateSystem.ecefDirectionToLocal(
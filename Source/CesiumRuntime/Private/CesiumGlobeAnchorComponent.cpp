@@ -4,10 +4,12 @@
 #include "CesiumCustomVersion.h"
 #include "CesiumGeometry/Transforms.h"
 #include "CesiumGeoreference.h"
+#include "CesiumGlobeAnchorSubsystem.h"
 #include "CesiumRuntime.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Components/SceneComponent.h"
 #include "GameFramework/Actor.h"
+#include "Net/UnrealNetwork.h"
 #include "VecMath.h"
 #include <glm/gtx/quaternion.hpp>
 
@@ -92,6 +94,8 @@ UCesiumGlobeAnchorComponent::GetResolvedGeoreference() const {
 
 FVector
 UCesiumGlobeAnchorComponent::GetEarthCenteredEarthFixedPosition() const {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     // Only log a warning if we're actually in a world. Otherwise we'll spam the
     // log when editing a CDO.
@@ -111,6 +115,8 @@ UCesiumGlobeAnchorComponent::GetEarthCenteredEarthFixedPosition() const {
 
 FMatrix
 UCesiumGlobeAnchorComponent::GetActorToEarthCenteredEarthFixedMatrix() const {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     const_cast<UCesiumGlobeAnchorComponent*>(this)
         ->_setNewActorToECEFFromRelativeTransform();
@@ -123,6 +129,8 @@ void UCesiumGlobeAnchorComponent::SetActorToEarthCenteredEarthFixedMatrix(
     const FMatrix& Value) {
   // This method is equivalent to
   // CesiumGlobeAnchorImpl::SetNewLocalToGlobeFixedMatrix in Cesium for Unity.
+  this->_processPendingTransformChange();
+
   USceneComponent* pOwnerRoot = this->_getRootComponent(/*warnIfNull*/ true);
   if (!IsValid(pOwnerRoot)) {
     return;
@@ -160,8 +168,37 @@ void UCesiumGlobeAnchorComponent::SetAdjustOrientationForGlobeWhenMoving(
   this->AdjustOrientationForGlobeWhenMoving = Value;
 }
 
+bool UCesiumGlobeAnchorComponent::GetUseLocalGeodeticApproximation() const {
+  return this->UseLocalGeodeticApproximation;
+}
+
+void UCesiumGlobeAnchorComponent::SetUseLocalGeodeticApproximation(
+    bool Value) {
+  this->UseLocalGeodeticApproximation = Value;
+}
+
+double
+UCesiumGlobeAnchorComponent::GetLocalGeodeticApproximationRadius() const {
+  return this->LocalGeodeticApproximationRadius;
+}
+
+void UCesiumGlobeAnchorComponent::SetLocalGeodeticApproximationRadius(
+    double Value) {
+  this->LocalGeodeticApproximationRadius = Value;
+}
+
+bool UCesiumGlobeAnchorComponent::GetBatchTransformChanges() const {
+  return this->BatchTransformChanges;
+}
+
+void UCesiumGlobeAnchorComponent::SetBatchTransformChanges(bool Value) {
+  this->BatchTransformChanges = Value;
+  this->_updateBatchRegistration(Value && this->IsRegistered());
+}
+
 void UCesiumGlobeAnchorComponent::MoveToEarthCenteredEarthFixedPosition(
     const FVector& TargetEcef) {
+  this->_processPendingTransformChange();
   if (!this->_actorToECEFIsValid)
     this->_setNewActorToECEFFromRelativeTransform();
   FMatrix newMatrix = this->ActorToEarthCenteredEarthFixedMatrix;
@@ -170,6 +207,8 @@ void UCesiumGlobeAnchorComponent::MoveToEarthCenteredEarthFixedPosition(
 }
 
 void UCesiumGlobeAnchorComponent::SnapLocalUpToEllipsoidNormal() {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid || !IsValid(this->ResolvedGeoreference)) {
     UE_LOG(
         LogCesium,
@@ -223,6 +262,8 @@ void UCesiumGlobeAnchorComponent::SnapToEastSouthUp() {
 }
 
 void UCesiumGlobeAnchorComponent::Sync() {
+  this->_processPendingTransformChange();
+
   // If we don't have a actor -> ECEF matrix yet, we must update from the
   // actor's root transform.
   bool updateFromTransform = !this->_actorToECEFIsValid;
@@ -265,6 +306,7 @@ UCesiumGlobeAnchorComponent::ResolveGeoreference(bool bForceReresolve) {
     }
 
     this->ResolvedGeoreference = Next;
+    this->_geodeticApproximation.reset();
 
     if (this->ResolvedGeoreference) {
       this->ResolvedGeoreference->OnGeoreferenceUpdated.AddUniqueDynamic(
@@ -303,6 +345,19 @@ void UCesiumGlobeAnchorComponent::InvalidateResolvedGeoreference() {
 }
 
 FVector UCesiumGlobeAnchorComponent::GetLongitudeLatitudeHeight() const {
+  ACesiumGeoreference* pGeoreference = this->GetResolvedGeoreference();
+  if (this->UseLocalGeodeticApproximation && IsValid(pGeoreference)) {
+    if (!this->_geodeticApproximation) {
+      this->_geodeticApproximation = pGeoreference->GetGeoTransforms();
+    }
+    this->_geodeticApproximation->setLocalApproximationRadius(
+        this->LocalGeodeticApproximationRadius);
+    return VecMath::createVector(
+        this->_geodeticApproximation->TransformEcefToLongitudeLatitudeHeight(
+            VecMath::createVector3D(
+                this->GetEarthCenteredEarthFixedPosition())));
+  }
+
   ELLIPSOID_CHECK(this, FVector::ZeroVector);
   return this->GetEllipsoid()
       ->EllipsoidCenteredEllipsoidFixedToLongitudeLatitudeHeight(
@@ -342,6 +397,8 @@ CesiumGeospatial::LocalHorizontalCoordinateSystem createEastSouthUp(
 } // namespace
 
 FQuat UCesiumGlobeAnchorComponent::GetEastSouthUpRotation() const {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     // Only log a warning if we're actually in a world. Otherwise we'll spam the
     // log when editing a CDO.
@@ -377,6 +434,8 @@ FQuat UCesiumGlobeAnchorComponent::GetEastSouthUpRotation() const {
 
 void UCesiumGlobeAnchorComponent::SetEastSouthUpRotation(
     const FQuat& EastSouthUpRotation) {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     UE_LOG(
         LogCesium,
@@ -423,6 +482,8 @@ void UCesiumGlobeAnchorComponent::SetEastSouthUpRotation(
 }
 
 FQuat UCesiumGlobeAnchorComponent::GetEarthCenteredEarthFixedRotation() const {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     // Only log a warning if we're actually in a world. Otherwise we'll spam the
     // log when editing a CDO.
@@ -448,6 +509,8 @@ FQuat UCesiumGlobeAnchorComponent::GetEarthCenteredEarthFixedRotation() const {
 
 void UCesiumGlobeAnchorComponent::SetEarthCenteredEarthFixedRotation(
     const FQuat& EarthCenteredEarthFixedRotation) {
+  this->_processPendingTransformChange();
+
   if (!this->_actorToECEFIsValid) {
     UE_LOG(
         LogCesium,
@@ -562,9 +625,12 @@ void UCesiumGlobeAnchorComponent::OnRegister() {
   }
 
   this->ResolveGeoreference();
+  this->_updateBatchRegistration(this->BatchTransformChanges);
 }
 
 void UCesiumGlobeAnchorComponent::OnUnregister() {
+  this->_updateBatchRegistration(false);
+
   Super::OnUnregister();
 
   // Unsubscribe from the ResolvedGeoreference.
@@ -590,6 +656,17 @@ void UCesiumGlobeAnchorComponent::OnUnregister() {
   }
 }
 
+void UCesiumGlobeAnchorComponent::GetLifetimeReplicatedProps(
+    TArray<FLifetimeProperty>& OutLifetimeProps) const {
+  Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+  // The client that controls the Actor moves it itself.
+  DOREPLIFETIME_CONDITION(
+      UCesiumGlobeAnchorComponent,
+      _replicatedTransform,
+      COND_SimulatedOnly);
+}
+
 CesiumGeospatial::GlobeAnchor
 UCesiumGlobeAnchorComponent::_createNativeGlobeAnchor() const {
   return createNativeGlobeAnchor(this->ActorToEarthCenteredEarthFixedMatrix);
@@ -725,6 +802,7 @@ void UCesiumGlobeAnchorComponent::_updateFromNativeGlobeAnchor(
   this->ActorToEarthCenteredEarthFixedMatrix =
       VecMath::createMatrix(nativeAnchor.getAnchorToFixedTransform());
   this->_actorToECEFIsValid = true;
+  this->_updateReplicatedTransform();
 
   // Update the Unreal relative transform
   ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
@@ -747,6 +825,15 @@ void UCesiumGlobeAnchorComponent::_onActorTransformChanged(
     return;
   }
 
+  UCesiumGlobeAnchorSubsystem* pBatchSubsystem = this->_pBatchSubsystem.Get();
+  if (pBatchSubsystem) {
+    if (!this->_transformChangePending) {
+      this->_transformChangePending = true;
+      pBatchSubsystem->markDirty(this->_batchSlot);
+    }
+    return;
+  }
+
   this->_setNewActorToECEFFromRelativeTransform();
 }
 
@@ -754,6 +841,8 @@ void UCesiumGlobeAnchorComponent::_setNewActorToECEFFromRelativeTransform() {
   // This method is equivalent to
   // CesiumGlobeAnchorImpl::SetNewLocalToGlobeFixedMatrixFromTransform in Cesium
   // for Unity.
+  this->_transformChangePending = false;
+
   ACesiumGeoreference* pGeoreference = this->ResolveGeoreference();
   if (!IsValid(pGeoreference)) {
     UE_LOG(
@@ -785,7 +874,81 @@ void UCesiumGlobeAnchorComponent::_setNewActorToECEFFromRelativeTransform() {
 #endif
 }
 
+void UCesiumGlobeAnchorComponent::_updateReplicatedTransform() {
+  if (this->GetIsReplicated() && this->GetOwnerRole() == ROLE_Authority) {
+    this->_replicatedTransform = FCesiumReplicatedGlobeTransform::FromMatrix(
+        this->ActorToEarthCenteredEarthFixedMatrix);
+  }
+}
+
+void UCesiumGlobeAnchorComponent::_onReplicatedTransformChanged() {
+  this->_transformChangePending = false;
+  this->_updateFromNativeGlobeAnchor(
+      createNativeGlobeAnchor(this->_replicatedTransform.ToMatrix()));
+}
+
+void UCesiumGlobeAnchorComponent::_updateBatchRegistration(
+    bool batchTransformChanges) {
+  UWorld* pWorld = this->GetWorld();
+  UCesiumGlobeAnchorSubsystem* pSubsystem =
+      batchTransformChanges && pWorld
+          ? pWorld->GetSubsystem<UCesiumGlobeAnchorSubsystem>()
+          : nullptr;
+  if (pSubsystem == this->_pBatchSubsystem.Get()) {
+    return;
+  }
+
+  if (UCesiumGlobeAnchorSubsystem* pPrevious = this->_pBatchSubsystem.Get()) {
+    this->_processPendingTransformChange();
+    pPrevious->unregisterAnchor(this->_batchSlot);
+  }
+  this->_transformChangePending = false;
+  this->_pBatchSubsystem = pSubsystem;
+  this->_batchSlot =
+      pSubsystem ? pSubsystem->registerAnchor(*this) : INDEX_NONE;
+}
+
+void UCesiumGlobeAnchorComponent::_processPendingTransformChange() const {
+  if (this->_transformChangePending) {
+    const_cast<UCesiumGlobeAnchorComponent*>(this)
+        ->_setNewActorToECEFFromRelativeTransform();
+  }
+}
+
+void UCesiumGlobeAnchorComponent::_updateFromBatchedTransformChange(
+    const glm::dmat4& anchorToFixed,
+    const glm::dmat4& anchorToLocal,
+    bool updateRelativeTransform) {
+  this->_transformChangePending = false;
+  this->ActorToEarthCenteredEarthFixedMatrix =
+      VecMath::createMatrix(anchorToFixed);
+  this->_actorToECEFIsValid = true;
+  this->_updateReplicatedTransform();
+
+  if (updateRelativeTransform) {
+    this->_setCurrentRelativeTransform(
+        FTransform(VecMath::createMatrix(anchorToLocal)));
+  } else {
+    // The relative transform is the one the globe transform was computed
+    // from, so it doesn't need to be set again.
+    this->_lastRelativeTransform = this->_getCurrentRelativeTransform();
+    this->_lastRelativeTransformIsValid = true;
+  }
+
+#if WITH_EDITOR
+  // In the Editor, mark this component and the root component modified so Undo
+  // works properly.
+  this->Modify();
+  if (USceneComponent* pOwnerRoot = this->_getRootComponent(false)) {
+    pOwnerRoot->Modify();
+  }
+#endif
+}
+
 void UCesiumGlobeAnchorComponent::_onGeoreferenceChanged() {
+  this->_processPendingTransformChange();
+  this->_geodeticApproximation.reset();
+
   if (this->_actorToECEFIsValid) {
     this->SetActorToEarthCenteredEarthFixedMatrix(
         this->ActorToEarthCenteredEarthFixedMatrix);
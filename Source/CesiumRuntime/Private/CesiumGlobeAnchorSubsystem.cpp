@@ -0,0 +1,169 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGlobeAnchorSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "CesiumEllipsoid.h"
+#include "CesiumGeospatial/GlobeAnchor.h"
+#include "CesiumGeoreference.h"
+#include "CesiumGlobeAnchorComponent.h"
+#include "Components/SceneComponent.h"
+#include "VecMath.h"
+
+using namespace CesiumGeospatial;
+
+namespace {
+
+// The fewest anchors in a batch for which they are updated in parallel.
+constexpr int32 MinimumAnchorsForParallelUpdate = 256;
+
+enum BatchFlags : uint8 {
+  // The anchor has a valid globe transform to move from.
+  HasGlobeTransform = 1 << 0,
+  // The anchor's orientation is adjusted for globe curvature.
+  AdjustOrientation = 1 << 1
+};
+
+} // namespace
+
+int32 UCesiumGlobeAnchorSubsystem::registerAnchor(
+    UCesiumGlobeAnchorComponent& anchor) {
+  int32 slot;
+  if (this->_freeSlots.IsEmpty()) {
+    slot = this->_anchors.Add(&anchor);
+    this->_dirty.Add(false);
+  } else {
+    slot = this->_freeSlots.Pop(false);
+    this->_anchors[slot] = &anchor;
+    this->_dirty[slot] = false;
+  }
+  return slot;
+}
+
+void UCesiumGlobeAnchorSubsystem::unregisterAnchor(int32 slot) {
+  if (!this->_anchors.IsValidIndex(slot)) {
+    return;
+  }
+
+  this->_anchors[slot] = nullptr;
+  this->_dirty[slot] = false;
+  this->_freeSlots.Add(slot);
+}
+
+void UCesiumGlobeAnchorSubsystem::markDirty(int32 slot) {
+  if (this->_anchors.IsValidIndex(slot)) {
+    this->_dirty[slot] = true;
+  }
+}
+
+void UCesiumGlobeAnchorSubsystem::ProcessTransformChanges() {
+  if (this->_dirty.Find(true) == INDEX_NONE) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateGlobeAnchors)
+
+  // Gather the inputs of the anchors with pending changes. Any anchor that
+  // can't be updated in the batch takes the usual path, which also logs why
+  // it can't be updated.
+  for (TConstSetBitIterator<> it(this->_dirty); it; ++it) {
+    UCesiumGlobeAnchorComponent* pAnchor = this->_anchors[it.GetIndex()].Get();
+    if (!pAnchor || !pAnchor->_transformChangePending) {
+      continue;
+    }
+
+    ACesiumGeoreference* pGeoreference = pAnchor->ResolveGeoreference();
+    UCesiumEllipsoid* pEllipsoid =
+        IsValid(pGeoreference) ? pGeoreference->GetEllipsoid() : nullptr;
+    const USceneComponent* pOwnerRoot =
+        pAnchor->_getRootComponent(/*warnIfNull*/ false);
+    if (!IsValid(pEllipsoid) || !IsValid(pOwnerRoot)) {
+      pAnchor->_setNewActorToECEFFromRelativeTransform();
+      continue;
+    }
+
+    uint8 flags = 0;
+    if (pAnchor->_actorToECEFIsValid) {
+      flags |= BatchFlags::HasGlobeTransform;
+    }
+    if (pAnchor->AdjustOrientationForGlobeWhenMoving) {
+      flags |= BatchFlags::AdjustOrientation;
+    }
+
+    this->_batchAnchors.Add(pAnchor);
+    this->_batchCoordinateSystems.Add(&pGeoreference->GetCoordinateSystem());
+    this->_batchEllipsoids.Add(&pEllipsoid->GetNativeEllipsoid());
+    this->_batchFlags.Add(flags);
+    this->_batchModelToLocal.Add(VecMath::createMatrix4D(
+        pOwnerRoot->GetRelativeTransform().ToMatrixWithScale()));
+    this->_batchAnchorToFixed.Add(VecMath::createMatrix4D(
+        pAnchor->ActorToEarthCenteredEarthFixedMatrix));
+  }
+  this->_dirty.SetRange(0, this->_dirty.Num(), false);
+
+  // Compute the new globe transforms. When the orientation is adjusted, the
+  // Actor's relative transform changes too, so it replaces the input.
+  const int32 count = this->_batchAnchors.Num();
+  ParallelFor(
+      count,
+      [this](int32 i) {
+        const LocalHorizontalCoordinateSystem& local =
+            *this->_batchCoordinateSystems[i];
+        const uint8 flags = this->_batchFlags[i];
+        glm::dmat4& modelToLocal = this->_batchModelToLocal[i];
+        glm::dmat4& anchorToFixed = this->_batchAnchorToFixed[i];
+
+        if (!(flags & BatchFlags::HasGlobeTransform)) {
+          anchorToFixed =
+              GlobeAnchor::fromAnchorToLocalTransform(local, modelToLocal)
+                  .getAnchorToFixedTransform();
+          return;
+        }
+
+        const bool adjustOrientation =
+            (flags & BatchFlags::AdjustOrientation) != 0;
+        GlobeAnchor anchor(anchorToFixed);
+        anchor.setAnchorToLocalTransform(
+            local,
+            modelToLocal,
+            adjustOrientation,
+            *this->_batchEllipsoids[i]);
+        anchorToFixed = anchor.getAnchorToFixedTransform();
+        if (adjustOrientation) {
+          modelToLocal = anchor.getAnchorToLocalTransform(local);
+        }
+      },
+      count < MinimumAnchorsForParallelUpdate
+          ? EParallelForFlags::ForceSingleThread
+          : EParallelForFlags::None);
+
+  for (int32 i = 0; i < count; ++i) {
+    this->_batchAnchors[i]->_updateFromBatchedTransformChange(
+        this->_batchAnchorToFixed[i],
+        this->_batchModelToLocal[i],
+        (this->_batchFlags[i] & BatchFlags::AdjustOrientation) &&
+            (this->_batchFlags[i] & BatchFlags::HasGlobeTransform));
+  }
+
+  this->_batchAnchors.Reset();
+  this->_batchCoordinateSystems.Reset();
+  this->_batchEllipsoids.Reset();
+  this->_batchFlags.Reset();
+  this->_batchModelToLocal.Reset();
+  this->_batchAnchorToFixed.Reset();
+}
+
+void UCesiumGlobeAnchorSubsystem::Deinitialize() {
+  this->ProcessTransformChanges();
+  Super::Deinitialize();
+}
+
+void UCesiumGlobeAnchorSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+  this->ProcessTransformChanges();
+}
+
+TStatId UCesiumGlobeAnchorSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(
+      UCesiumGlobeAnchorSubsystem,
+      STATGROUP_Tickables);
+}
@@ -0,0 +1,110 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfBufferRelease.h"
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace CesiumGltfBufferRelease {
+
+bool canRelease(const Model& model) {
+  if (model.getExtension<ExtensionModelExtStructuralMetadata>()) {
+    return false;
+  }
+
+  for (const Mesh& mesh : model.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      if (primitive.getExtension<ExtensionExtMeshFeatures>() ||
+          primitive
+              .getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>()) {
+        return false;
+      }
+      for (const auto& attribute : primitive.attributes) {
+        if (attribute.first.rfind("_CESIUMOVERLAY_", 0) == 0) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+int64 release(Model& model, bool keepPickingData) {
+  int64 originalBytes = 0;
+  for (const Buffer& buffer : model.buffers) {
+    originalBytes += int64(buffer.cesium.data.size());
+  }
+
+  std::vector<bool> keep(model.bufferViews.size(), false);
+  const auto keepBufferView = [&keep](int32_t bufferViewIndex) {
+    if (bufferViewIndex >= 0 && size_t(bufferViewIndex) < keep.size()) {
+      keep[size_t(bufferViewIndex)] = true;
+    }
+  };
+  const auto keepAccessor = [&model, &keepBufferView](int32_t accessorIndex) {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+    if (!pAccessor) {
+      return;
+    }
+    keepBufferView(pAccessor->bufferView);
+    if (pAccessor->sparse) {
+      keepBufferView(pAccessor->sparse->indices.bufferView);
+      keepBufferView(pAccessor->sparse->values.bufferView);
+    }
+  };
+
+  if (keepPickingData) {
+    for (const Mesh& mesh : model.meshes) {
+      for (const MeshPrimitive& primitive : mesh.primitives) {
+        keepAccessor(primitive.indices);
+        auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt != primitive.attributes.end()) {
+          keepAccessor(positionIt->second);
+        }
+      }
+    }
+  }
+
+  // The buffer views are pointed at the new buffer as they're copied, which
+  // is only added once all of them have been read from the old buffers.
+  std::vector<std::byte> data;
+  for (size_t i = 0; i < model.bufferViews.size(); ++i) {
+    BufferView& bufferView = model.bufferViews[i];
+    const Buffer* pBuffer = Model::getSafe(&model.buffers, bufferView.buffer);
+    if (!keep[i] || !pBuffer || bufferView.byteOffset < 0 ||
+        bufferView.byteLength < 0 ||
+        bufferView.byteOffset + bufferView.byteLength >
+            int64_t(pBuffer->cesium.data.size())) {
+      bufferView.buffer = -1;
+      continue;
+    }
+
+    const size_t offset = (data.size() + 7) & ~size_t(7);
+    data.resize(offset + size_t(bufferView.byteLength));
+    std::memcpy(
+        data.data() + offset,
+        pBuffer->cesium.data.data() + bufferView.byteOffset,
+        size_t(bufferView.byteLength));
+    bufferView.buffer = 0;
+    bufferView.byteOffset = int64_t(offset);
+  }
+
+  model.buffers.clear();
+  const int64 keptBytes = int64(data.size());
+  if (!data.empty()) {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = keptBytes;
+    buffer.cesium.data = std::move(data);
+  }
+
+  return originalBytes - keptBytes;
+}
+
+} // namespace CesiumGltfBufferRelease
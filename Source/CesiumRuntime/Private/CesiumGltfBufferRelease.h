@@ -0,0 +1,41 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumGltfBufferRelease {
+
+/**
+ * @brief Determines if the buffers of a glTF may be released once its meshes
+ * have been built.
+ *
+ * They may not if it has features or metadata, whose values are read from
+ * the buffers whenever they are queried, or raster overlay texture
+ * coordinates, because cesium-native may upsample the tile's geometry into
+ * child tiles for the overlays.
+ */
+bool canRelease(const CesiumGltf::Model& model);
+
+/**
+ * @brief Releases the data of a glTF's buffers, except, if `keepPickingData`
+ * is true, the positions and indices of its primitives, which are needed to
+ * build physics meshes on demand, to sample heights, and to intersect rays
+ * with the tile.
+ *
+ * The data that is kept is copied into a single, tightly packed buffer, which
+ * replaces all of the others. The buffer views of the data that is released
+ * no longer have a buffer, so that views of their accessors are invalid
+ * rather than wrong. Views created before this call must be created again.
+ *
+ * May be called from any thread, while nothing else uses the model.
+ *
+ * @returns The number of bytes released.
+ */
+int64 release(CesiumGltf::Model& model, bool keepPickingData);
+
+} // namespace CesiumGltfBufferRelease
@@ -2,23 +2,52 @@
 
 #include "CesiumGltfComponent.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "CesiumCommon.h"
+#include "CesiumConvertedTileCache.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
 #include "CesiumFeatureIdSet.h"
+#include "CesiumFeatureStyleExpression.h"
+#include "CesiumGltfBufferRelease.h"
+#include "CesiumGltfGaussianSplatComponent.h"
+#include "CesiumGltfTerrainHeightmapComponent.h"
+#include "CesiumGltfVoxelComponent.h"
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumInstanceBatches.h"
+#include "CesiumLifetime.h"
+#include "CesiumMaterialInstanceCache.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumMeshClusters.h"
+#include "CesiumMeshResourceBatch.h"
+#include "CesiumMemoryUsageTracker.h"
+#include "CesiumNameUtility.h"
+#include "CesiumNaniteBuilder.h"
+#include "CesiumPhysicsMeshCache.h"
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumPolygonClippingComponent.h"
+#include "CesiumPrimitiveComponentPool.h"
+#include "CesiumPrimitiveMerging.h"
+#include "CesiumRasterOverlay.h"
+#include "CesiumRasterOverlayRendererData.h"
+#include "CesiumRasterOverlayTextureArray.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRuntime.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTilesetStatistics.h"
 #include "CesiumTransforms.h"
+#include "CesiumTriangleBVH.h"
+#include "CesiumVertexKernels.h"
 #include "Chaos/AABBTree.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 #include "CreateGltfOptions.h"
+#include "DataDrivenShaderPlatformInfo.h"
 #include "Engine/CollisionProfile.h"
 #include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Hash/CityHash.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "LoadGltfResult.h"
@@ -38,6 +67,7 @@
 #include <CesiumGeometry/Axis.h>
 #include <CesiumGeometry/Rectangle.h>
 #include <CesiumGeometry/Transforms.h>
+#include <CesiumGeospatial/Projection.h>
 #include <CesiumGltf/AccessorUtility.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/ExtensionExtMeshFeatures.h>
@@ -46,6 +76,7 @@
 #include <CesiumGltf/ExtensionKhrTextureTransform.h>
 #include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
 #include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/ExtensionTextureWebp.h>
 #include <CesiumGltf/KhrTextureTransform.h>
 #include <CesiumGltf/PropertyType.h>
 #include <CesiumGltf/TextureInfo.h>
@@ -60,6 +91,7 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat3x3.hpp>
 #include <iostream>
+#include <meshoptimizer.h>
 #include <type_traits>
 
 #if WITH_EDITOR
@@ -70,6 +102,7 @@ using namespace CesiumGltf;
 using namespace CesiumTextureUtility;
 using namespace CreateGltfOptions;
 using namespace LoadGltfResult;
+using namespace CesiumNameUtility;
 
 // To debug which urls correspond to which gltf components you see in the view,
 // - Set this define to 1
@@ -83,15 +116,124 @@ namespace {
 using TMeshVector2 = FVector2f;
 using TMeshVector3 = FVector3f;
 using TMeshVector4 = FVector4f;
+
+// An estimate of the size of the bounding volume hierarchy that Chaos builds
+// over a collision mesh, per triangle. Its leaves hold a few triangles each,
+// and each node holds the bounds of its two children.
+constexpr uint64 CollisionBVHBytesPerTriangle = 32;
+
+void addPropertyTableTextures(
+    const CesiumEncodedFeaturesMetadata::EncodedPropertyTable& propertyTable,
+    std::vector<ReferenceCountedUnrealTexture*>& textures) {
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty&
+           property : propertyTable.properties) {
+    if (property.pTexture) {
+      textures.emplace_back(property.pTexture->pTexture.get());
+    }
+  }
+}
 } // namespace
 
 static uint32_t nextMaterialId = 0;
 
 namespace {
+/**
+ * The projection of the texture coordinates of an overlay, which a material
+ * needs when it computes them from the positions of the vertices.
+ */
+struct OverlayProjection {
+  /**
+   * The minimum X and Y of the projected rectangle that the texture
+   * coordinates go from zero to one over, then the inverse of its width and
+   * height.
+   */
+  FVector4 rectangle{0.0, 0.0, 0.0, 0.0};
+
+  /**
+   * The radii of the ellipsoid of the projection, then one for the Web
+   * Mercator projection or zero for the geographic projection.
+   */
+  FVector4 ellipsoid{0.0, 0.0, 0.0, 0.0};
+};
+
+OverlayProjection getOverlayProjection(
+    const Cesium3DTilesSelection::Tile& tile,
+    int32 textureCoordinateID) {
+  OverlayProjection result;
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  if (!pRenderContent) {
+    return result;
+  }
+
+  const auto& details = pRenderContent->getRasterOverlayDetails();
+  const size_t id = size_t(textureCoordinateID);
+  if (id >= details.rasterOverlayRectangles.size() ||
+      id >= details.rasterOverlayProjections.size()) {
+    return result;
+  }
+
+  const CesiumGeometry::Rectangle& rectangle =
+      details.rasterOverlayRectangles[id];
+  const double width = rectangle.computeWidth();
+  const double height = rectangle.computeHeight();
+  if (width <= 0.0 || height <= 0.0) {
+    return result;
+  }
+
+  const CesiumGeospatial::Projection& projection =
+      details.rasterOverlayProjections[id];
+  const glm::dvec3& radii =
+      CesiumGeospatial::getProjectionEllipsoid(projection).getRadii();
+  const bool isWebMercator =
+      std::holds_alternative<CesiumGeospatial::WebMercatorProjection>(
+          projection);
+
+  result.rectangle = FVector4(
+      rectangle.minimumX,
+      rectangle.minimumY,
+      1.0 / width,
+      1.0 / height);
+  result.ellipsoid =
+      FVector4(radii.x, radii.y, radii.z, isWebMercator ? 1.0 : 0.0);
+  return result;
+}
+
 class HalfConstructedReal : public UCesiumGltfComponent::HalfConstructed {
 public:
   LoadModelResult loadModelResult{};
 };
+
+/**
+ * The state of a glTF component whose primitives are still being created on
+ * the game thread, possibly over several frames.
+ */
+class IncrementalBuild : public UCesiumGltfComponent::HalfConstructed {
+public:
+  struct RasterAttachment {
+    const CesiumRasterOverlays::RasterOverlayTile* pRasterTile;
+    UTexture2D* pTexture;
+    FVector4 translationAndScale;
+    int32 textureCoordinateID;
+    int32 textureArraySlice;
+    OverlayProjection projection;
+  };
+
+  TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalfConstructed;
+  CesiumGltf::Model* pModel = nullptr;
+  const Cesium3DTilesSelection::Tile* pTile = nullptr;
+  ACesium3DTileset* pTilesetActor = nullptr;
+  glm::dmat4x4 cesiumToUnrealTransform{1.0};
+  bool createNavCollision = false;
+
+  // The next primitive to create.
+  size_t nodeIndex = 0;
+  size_t primitiveIndex = 0;
+
+  // Raster overlay tiles that were attached before all primitives were
+  // created. These are applied to each primitive as it is created.
+  std::vector<RasterAttachment> rasterAttachments;
+};
 } // namespace
 
 template <class... T> struct IsAccessorView;
@@ -100,12 +242,35 @@ template <class T> struct IsAccessorView<T> : std::false_type {};
 
 template <class T> struct IsAccessorView<AccessorView<T>> : std::true_type {};
 
+/**
+ * The texture coordinates of a primitive's vertices, one array per Unreal UV
+ * channel. The number of channels is only known once the textures and the
+ * features metadata of the primitive have been processed, so the channels are
+ * kept here until the static mesh vertex buffer is created.
+ */
+struct TexCoordChannels {
+  int32 vertexCount = 0;
+  TArray<TArray<TMeshVector2>> channels;
+
+  /**
+   * @brief Gets the channel with the given index, zero-filled.
+   */
+  TArray<TMeshVector2>& getChannel(uint32 index) {
+    if (int32(index) >= this->channels.Num()) {
+      this->channels.SetNum(int32(index) + 1);
+    }
+    TArray<TMeshVector2>& channel = this->channels[index];
+    channel.SetNumZeroed(this->vertexCount);
+    return channel;
+  }
+};
+
 template <class T>
 static uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    TexCoordChannels& texCoords,
     const TArray<uint32>& indices,
     const std::optional<T>& texture,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -117,7 +282,7 @@ static uint32_t updateTextureCoordinates(
       model,
       primitive,
       duplicateVertices,
-      vertices,
+      texCoords,
       indices,
       "TEXCOORD_" + std::to_string(texture.value().texCoord),
       gltfToUnrealTexCoordMap);
@@ -127,7 +292,7 @@ uint32_t updateTextureCoordinates(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    TexCoordChannels& texCoords,
     const TArray<uint32>& indices,
     const std::string& attributeName,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -152,41 +317,55 @@ uint32_t updateTextureCoordinates(
     return 0;
   }
 
+  TArray<TMeshVector2>& uvs = texCoords.getChannel(textureCoordinateIndex);
   if (duplicateVertices) {
     for (int i = 0; i < indices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
       uint32 vertexIndex = indices[i];
       if (vertexIndex >= 0 && vertexIndex < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[vertexIndex];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+        uvs[i] = uvAccessor[vertexIndex];
       }
     }
   } else {
-    for (int i = 0; i < vertices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
-      if (i >= 0 && i < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[i];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-      }
+    for (int i = 0; i < uvs.Num() && i < uvAccessor.size(); ++i) {
+      uvs[i] = uvAccessor[i];
     }
   }
 
   return textureCoordinateIndex;
 }
 
+namespace {
+/**
+ * The triangles that mikktspace generates tangents for.
+ */
+struct MikkTSpaceMesh {
+  FStaticMeshVertexBuffers& vertexBuffers;
+  const uint32* pIndices;
+  int32 triangleCount;
+
+  uint32 getVertexIndex(const int FaceIdx, const int VertIdx) const {
+    return this->pIndices[FaceIdx * 3 + VertIdx];
+  }
+};
+
+/**
+ * The number of triangles that mikktspace processes in one task, when a
+ * mesh's triangles don't share vertices.
+ */
+constexpr int32 MikkTSpaceTrianglesPerChunk = 8192;
+} // namespace
+
 static int mikkGetNumFaces(const SMikkTSpaceContext* Context) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return vertices.Num() / 3;
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  return mesh.triangleCount;
 }
 
 static int
 mikkGetNumVertsOfFace(const SMikkTSpaceContext* Context, const int FaceIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return FaceIdx < (vertices.Num() / 3) ? 3 : 0;
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  return FaceIdx < mesh.triangleCount ? 3 : 0;
 }
 
 static void mikkGetPosition(
@@ -194,9 +373,11 @@ static void mikkGetPosition(
     float Position[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& position = vertices[FaceIdx * 3 + VertIdx].Position;
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  const TMeshVector3& position =
+      mesh.vertexBuffers.PositionVertexBuffer.VertexPosition(
+          mesh.getVertexIndex(FaceIdx, VertIdx));
   Position[0] = position.X;
   Position[1] = -position.Y;
   Position[2] = position.Z;
@@ -207,9 +388,11 @@ static void mikkGetNormal(
     float Normal[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& normal = vertices[FaceIdx * 3 + VertIdx].TangentZ;
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  const TMeshVector4 normal =
+      mesh.vertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(
+          mesh.getVertexIndex(FaceIdx, VertIdx));
   Normal[0] = normal.X;
   Normal[1] = -normal.Y;
   Normal[2] = normal.Z;
@@ -220,9 +403,11 @@ static void mikkGetTexCoord(
     float UV[2],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector2& uv = vertices[FaceIdx * 3 + VertIdx].UVs[0];
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  const TMeshVector2 uv = mesh.vertexBuffers.StaticMeshVertexBuffer.GetVertexUV(
+      mesh.getVertexIndex(FaceIdx, VertIdx),
+      0);
   UV[0] = uv.X;
   UV[1] = uv.Y;
 }
@@ -233,11 +418,14 @@ static void mikkSetTSpaceBasic(
     const float BitangentSign,
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  FStaticMeshBuildVertex& vertex = vertices[FaceIdx * 3 + VertIdx];
-
-  FVector3f TangentZ = vertex.TangentZ;
+  const MikkTSpaceMesh& mesh =
+      *reinterpret_cast<const MikkTSpaceMesh*>(Context->m_pUserData);
+  FStaticMeshVertexBuffer& vertexBuffer =
+      mesh.vertexBuffers.StaticMeshVertexBuffer;
+  const uint32 vertexIndex = mesh.getVertexIndex(FaceIdx, VertIdx);
+
+  const TMeshVector3 Normal(vertexBuffer.VertexTangentZ(vertexIndex));
+  FVector3f TangentZ = Normal;
   TangentZ.Y = -TangentZ.Y;
 
   FVector3f TangentX = TMeshVector3(Tangent[0], Tangent[1], Tangent[2]);
@@ -247,11 +435,20 @@ static void mikkSetTSpaceBasic(
   TangentX.Y = -TangentX.Y;
   TangentY.Y = -TangentY.Y;
 
-  vertex.TangentX = TangentX;
-  vertex.TangentY = TangentY;
+  vertexBuffer.SetVertexTangents(vertexIndex, TangentX, TangentY, Normal);
 }
 
-static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
+/**
+ * Generates tangents with mikktspace. When the triangles don't share vertices,
+ * as when vertices were duplicated for it, chunks of triangles are processed
+ * in parallel. Mikktspace then can't average the tangents of identical
+ * vertices in different chunks, but the chunks are contiguous ranges of
+ * triangles, which are mostly contiguous in space, too.
+ */
+static void computeTangentSpace(
+    FStaticMeshVertexBuffers& vertexBuffers,
+    const TArray<uint32>& indices,
+    bool trianglesShareVertices) {
   SMikkTSpaceInterface MikkTInterface{};
   MikkTInterface.m_getNormal = mikkGetNormal;
   MikkTInterface.m_getNumFaces = mikkGetNumFaces;
@@ -261,64 +458,613 @@ static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
   MikkTInterface.m_setTSpaceBasic = mikkSetTSpaceBasic;
   MikkTInterface.m_setTSpace = nullptr;
 
-  SMikkTSpaceContext MikkTContext{};
-  MikkTContext.m_pInterface = &MikkTInterface;
-  MikkTContext.m_pUserData = (void*)(&vertices);
-  // MikkTContext.m_bIgnoreDegenerates = false;
-  genTangSpaceDefault(&MikkTContext);
+  const int32 triangleCount = indices.Num() / 3;
+  const int32 trianglesPerChunk =
+      trianglesShareVertices ? FMath::Max(triangleCount, 1)
+                             : MikkTSpaceTrianglesPerChunk;
+  const int32 chunkCount =
+      FMath::DivideAndRoundUp(triangleCount, trianglesPerChunk);
+
+  ParallelFor(chunkCount, [&](int32 chunk) {
+    const int32 firstTriangle = chunk * trianglesPerChunk;
+    MikkTSpaceMesh mesh{
+        vertexBuffers,
+        indices.GetData() + 3 * firstTriangle,
+        FMath::Min(trianglesPerChunk, triangleCount - firstTriangle)};
+
+    SMikkTSpaceContext MikkTContext{};
+    MikkTContext.m_pInterface = &MikkTInterface;
+    MikkTContext.m_pUserData = (void*)(&mesh);
+    // MikkTContext.m_bIgnoreDegenerates = false;
+    genTangSpaceDefault(&MikkTContext);
+  });
+}
+
+/**
+ * Generates tangents from the texture coordinates of the triangles around
+ * each vertex, orthogonalized against the vertex normal. This is much cheaper
+ * than mikktspace and works on shared vertices, but it doesn't split vertices
+ * at texture seams or handle mirrored texture coordinates as well, so it's
+ * only used for the water effect, whose normals are procedural.
+ */
+static void computeFastTangents(
+    FStaticMeshVertexBuffers& vertexBuffers,
+    const TArray<uint32>& indices) {
+  const FPositionVertexBuffer& positions = vertexBuffers.PositionVertexBuffer;
+  FStaticMeshVertexBuffer& vertexBuffer = vertexBuffers.StaticMeshVertexBuffer;
+  const uint32 vertexCount = positions.GetNumVertices();
+
+  TArray<TMeshVector3> tangents;
+  TArray<TMeshVector3> bitangents;
+  tangents.SetNumZeroed(vertexCount);
+  bitangents.SetNumZeroed(vertexCount);
+
+  for (int32 i = 0; i + 2 < indices.Num(); i += 3) {
+    const uint32 i0 = indices[i];
+    const uint32 i1 = indices[i + 1];
+    const uint32 i2 = indices[i + 2];
+    if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
+      continue;
+    }
+
+    const TMeshVector3 e1 =
+        positions.VertexPosition(i1) - positions.VertexPosition(i0);
+    const TMeshVector3 e2 =
+        positions.VertexPosition(i2) - positions.VertexPosition(i0);
+    const TMeshVector2 uv0 = vertexBuffer.GetVertexUV(i0, 0);
+    const TMeshVector2 d1 = vertexBuffer.GetVertexUV(i1, 0) - uv0;
+    const TMeshVector2 d2 = vertexBuffer.GetVertexUV(i2, 0) - uv0;
+
+    const float determinant = d1.X * d2.Y - d2.X * d1.Y;
+    if (FMath::IsNearlyZero(determinant)) {
+      continue;
+    }
+
+    // Not normalized, so larger triangles have more weight.
+    const float scale = FMath::Sign(determinant);
+    const TMeshVector3 tangent = (e1 * d2.Y - e2 * d1.Y) * scale;
+    const TMeshVector3 bitangent = (e2 * d1.X - e1 * d2.X) * scale;
+    for (uint32 index : {i0, i1, i2}) {
+      tangents[index] += tangent;
+      bitangents[index] += bitangent;
+    }
+  }
+
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    const TMeshVector3 normal(vertexBuffer.VertexTangentZ(i));
+    TMeshVector3 tangent =
+        tangents[i] - normal * TMeshVector3::DotProduct(normal, tangents[i]);
+    if (!tangent.Normalize()) {
+      // No usable texture coordinates, so any tangent will do.
+      tangent = TMeshVector3::CrossProduct(
+          normal,
+          FMath::Abs(normal.Z) < 0.9f ? TMeshVector3(0.0f, 0.0f, 1.0f)
+                                      : TMeshVector3(1.0f, 0.0f, 0.0f));
+      tangent.Normalize();
+    }
+
+    TMeshVector3 bitangent = TMeshVector3::CrossProduct(normal, tangent);
+    if (TMeshVector3::DotProduct(bitangent, bitangents[i]) < 0.0f) {
+      bitangent = -bitangent;
+    }
+
+    vertexBuffer.SetVertexTangents(i, tangent, bitangent, normal);
+  }
 }
 
 static void setUniformNormals(
-    TArray<FStaticMeshBuildVertex>& vertices,
+    FStaticMeshVertexBuffer& vertexBuffer,
     TMeshVector3 normal) {
-  for (int i = 0; i < vertices.Num(); i++) {
-    FStaticMeshBuildVertex& v = vertices[i];
-    v.TangentX = v.TangentY = TMeshVector3(0.0f);
-    v.TangentZ = normal;
+  for (uint32 i = 0; i < vertexBuffer.GetNumVertices(); i++) {
+    vertexBuffer.SetVertexTangents(
+        i,
+        TMeshVector3(0.0f),
+        TMeshVector3(0.0f),
+        normal);
+  }
+}
+
+/**
+ * Quantizes the positions of a point primitive to 16 bits per component,
+ * relative to their bounding box, and replaces the float positions with a
+ * single placeholder vertex.
+ */
+static void quantizePointPositions(
+    FPositionVertexBuffer& positions,
+    LoadPrimitiveResult& primitiveResult) {
+  const uint32 numVertices = positions.GetNumVertices();
+
+  FBox3f bounds(ForceInit);
+  for (uint32 i = 0; i < numVertices; ++i) {
+    bounds += positions.VertexPosition(i);
+  }
+  const FVector3f extent = bounds.GetSize();
+
+  TSharedRef<TArray<uint16>, ESPMode::ThreadSafe> pQuantized =
+      MakeShared<TArray<uint16>, ESPMode::ThreadSafe>();
+  pQuantized->SetNumUninitialized(int32(numVertices) * 3);
+  uint16* pOut = pQuantized->GetData();
+  for (uint32 i = 0; i < numVertices; ++i) {
+    const FVector3f& position = positions.VertexPosition(i);
+    for (int32 axis = 0; axis < 3; ++axis) {
+      const float normalized =
+          extent[axis] > 0.0f
+              ? (position[axis] - bounds.Min[axis]) / extent[axis]
+              : 0.0f;
+      *pOut++ = uint16(
+          FMath::RoundToInt(FMath::Clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+    }
   }
+
+  primitiveResult.QuantizedPointPositions = pQuantized;
+  primitiveResult.QuantizedPointOffset = bounds.Min;
+  primitiveResult.QuantizedPointScale = extent;
+
+  // The points are only drawn from the quantized positions, so the float
+  // positions don't need to take up GPU memory.
+  positions.Init(1, false);
+  positions.VertexPosition(0) = bounds.GetCenter();
+}
+
+static void releaseTerrainVertices(FStaticMeshLODResources& lod) {
+  // Terrain that is drawn from its heightmap only keeps a single degenerate
+  // triangle, at the center of its bounds, once its collision mesh is built.
+  FStaticMeshVertexBuffers& vertexBuffers = lod.VertexBuffers;
+  FPositionVertexBuffer& positions = vertexBuffers.PositionVertexBuffer;
+  FBox3f bounds(ForceInit);
+  for (uint32 i = 0; i < positions.GetNumVertices(); ++i) {
+    bounds += positions.VertexPosition(i);
+  }
+  positions.Init(1, false);
+  positions.VertexPosition(0) = bounds.GetCenter();
+
+  FStaticMeshVertexBuffer& vertexBuffer = vertexBuffers.StaticMeshVertexBuffer;
+  const uint32 numTexCoords = vertexBuffer.GetNumTexCoords();
+  vertexBuffer.Init(1, numTexCoords, false);
+  vertexBuffer.SetVertexTangents(
+      0,
+      TMeshVector3(1.0f, 0.0f, 0.0f),
+      TMeshVector3(0.0f, 1.0f, 0.0f),
+      TMeshVector3(0.0f, 0.0f, 1.0f));
+  for (uint32 uvIndex = 0; uvIndex < numTexCoords; ++uvIndex) {
+    vertexBuffer.SetVertexUV(0, uvIndex, TMeshVector2(0.0f));
+  }
+
+  if (vertexBuffers.ColorVertexBuffer.GetNumVertices() > 0) {
+    vertexBuffers.ColorVertexBuffer.InitFromSingleColor(FColor::White, 1);
+  }
+
+  lod.Sections[0].NumTriangles = 1;
+  lod.Sections[0].MaxVertexIndex = 0;
+  lod.IndexBuffer.SetIndices(
+      TArray<uint32>({0, 0, 0}),
+      EIndexBufferStride::Type::Force16Bit);
 }
 
-static void computeFlatNormals(TArray<FStaticMeshBuildVertex>& vertices) {
+static void computeFlatNormals(FStaticMeshVertexBuffers& vertexBuffers) {
+  const FPositionVertexBuffer& positions = vertexBuffers.PositionVertexBuffer;
+  FStaticMeshVertexBuffer& vertexBuffer = vertexBuffers.StaticMeshVertexBuffer;
+
   // Compute flat normals
-  for (int i = 0; i < vertices.Num(); i += 3) {
-    FStaticMeshBuildVertex& v0 = vertices[i];
-    FStaticMeshBuildVertex& v1 = vertices[i + 1];
-    FStaticMeshBuildVertex& v2 = vertices[i + 2];
+  for (uint32 i = 0; i + 2 < positions.GetNumVertices(); i += 3) {
+    const TMeshVector3& p0 = positions.VertexPosition(i);
+    const TMeshVector3& p1 = positions.VertexPosition(i + 1);
+    const TMeshVector3& p2 = positions.VertexPosition(i + 2);
 
     // The Y axis has previously been inverted, so undo that before
     // computing the normal direction. Then invert the Y coordinate of the
     // normal, too.
 
-    TMeshVector3 v01 = v1.Position - v0.Position;
+    TMeshVector3 v01 = p1 - p0;
     v01.Y = -v01.Y;
-    TMeshVector3 v02 = v2.Position - v0.Position;
+    TMeshVector3 v02 = p2 - p0;
     v02.Y = -v02.Y;
     TMeshVector3 normal = TMeshVector3::CrossProduct(v01, v02);
 
     normal.Y = -normal.Y;
+    normal = normal.GetSafeNormal();
+
+    for (uint32 j = i; j < i + 3; ++j) {
+      vertexBuffer.SetVertexTangents(
+          j,
+          TMeshVector3(0.0f),
+          TMeshVector3(0.0f),
+          normal);
+    }
+  }
+}
+
+/**
+ * Generates smooth normals for a triangle mesh that has none. The triangles
+ * around each vertex are grouped so that the normals of the triangles in a
+ * group are within the crease angle of the first one, and the vertex is split
+ * into one vertex per group, whose normal is the area-weighted average of the
+ * group's triangle normals.
+ *
+ * @param positions The positions of the glTF vertices.
+ * @param creaseAngleDegrees The angle above which an edge stays faceted.
+ * @param indices The indices of the triangles, which are replaced with the
+ * indices of the split vertices.
+ * @param vertexSources Receives the glTF vertex of each split vertex.
+ * @param normals Receives the normal of each split vertex, with its Y
+ * coordinate inverted like the positions.
+ * @returns false if an index is out of range, in which case nothing is
+ * modified.
+ */
+static bool computeSmoothNormals(
+    const AccessorView<TMeshVector3>& positions,
+    float creaseAngleDegrees,
+    TArray<uint32>& indices,
+    TArray<uint32>& vertexSources,
+    TArray<TMeshVector3>& normals) {
+  const int32 vertexCount = int32(positions.size());
+  const int32 triangleCount = indices.Num() / 3;
+  const int32 cornerCount = triangleCount * 3;
+
+  for (int32 i = 0; i < cornerCount; ++i) {
+    if (indices[i] >= uint32(vertexCount)) {
+      return false;
+    }
+  }
 
-    v0.TangentX = v1.TangentX = v2.TangentX = TMeshVector3(0.0f);
-    v0.TangentY = v1.TangentY = v2.TangentY = TMeshVector3(0.0f);
-    v0.TangentZ = v1.TangentZ = v2.TangentZ = normal.GetSafeNormal();
+  // The length of a triangle's cross product is twice its area, so summing
+  // them weights the triangles by area.
+  TArray<TMeshVector3> faceNormals;
+  TArray<TMeshVector3> unitFaceNormals;
+  faceNormals.SetNumUninitialized(triangleCount);
+  unitFaceNormals.SetNumUninitialized(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const TMeshVector3& p0 = positions[indices[3 * i]];
+    const TMeshVector3& p1 = positions[indices[3 * i + 1]];
+    const TMeshVector3& p2 = positions[indices[3 * i + 2]];
+    faceNormals[i] = TMeshVector3::CrossProduct(p1 - p0, p2 - p0);
+    unitFaceNormals[i] = faceNormals[i].GetSafeNormal();
+  }
+
+  // The triangle corners around each vertex, in vertex order.
+  TArray<int32> cornerOffsets;
+  cornerOffsets.SetNumZeroed(vertexCount + 1);
+  for (int32 i = 0; i < cornerCount; ++i) {
+    ++cornerOffsets[indices[i] + 1];
+  }
+  for (int32 i = 0; i < vertexCount; ++i) {
+    cornerOffsets[i + 1] += cornerOffsets[i];
+  }
+
+  TArray<int32> corners;
+  corners.SetNumUninitialized(cornerCount);
+  TArray<int32> nextCorner(cornerOffsets.GetData(), vertexCount);
+  for (int32 i = 0; i < cornerCount; ++i) {
+    corners[nextCorner[indices[i]]++] = i;
+  }
+
+  const float minimumCosine =
+      FMath::Cos(FMath::DegreesToRadians(creaseAngleDegrees));
+  constexpr uint32 unassigned = TNumericLimits<uint32>::Max();
+
+  TArray<uint32> splitIndices;
+  splitIndices.Init(unassigned, cornerCount);
+  vertexSources.Reset(vertexCount);
+  normals.Reset(vertexCount);
+
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    const int32 begin = cornerOffsets[vertex];
+    const int32 end = cornerOffsets[vertex + 1];
+
+    for (int32 i = begin; i < end; ++i) {
+      if (splitIndices[corners[i]] != unassigned) {
+        continue;
+      }
+
+      const uint32 splitVertex = uint32(vertexSources.Num());
+      const TMeshVector3& seedNormal = unitFaceNormals[corners[i] / 3];
+      TMeshVector3 normal(0.0f);
+
+      for (int32 j = i; j < end; ++j) {
+        const int32 corner = corners[j];
+        if (splitIndices[corner] != unassigned) {
+          continue;
+        }
+
+        // Degenerate triangles join any group.
+        const TMeshVector3& unitFaceNormal = unitFaceNormals[corner / 3];
+        if (j != i && !unitFaceNormal.IsZero() &&
+            TMeshVector3::DotProduct(seedNormal, unitFaceNormal) <
+                minimumCosine) {
+          continue;
+        }
+
+        splitIndices[corner] = splitVertex;
+        normal += faceNormals[corner / 3];
+      }
+
+      normal = normal.GetSafeNormal();
+      normal.Y = -normal.Y;
+      vertexSources.Add(uint32(vertex));
+      normals.Add(normal);
+    }
   }
+
+  indices = MoveTemp(splitIndices);
+  return true;
 }
 
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices);
+/**
+ * Reorders the triangles of a triangle mesh for the post-transform vertex
+ * cache and then to reduce overdraw, and reorders its vertices in the order
+ * that the triangles first use them. Vertices that no triangle uses are
+ * removed.
+ *
+ * @param positions The positions of the glTF vertices.
+ * @param indices The indices of the triangles, which are reordered and
+ * replaced with the indices of the reordered vertices.
+ * @param vertexSources The glTF vertex of each vertex, or empty if the
+ * vertices are the glTF vertices. Receives the glTF vertex of each reordered
+ * vertex.
+ * @param normals The normal of each vertex, or empty. Reordered like the
+ * vertices.
+ * @returns false if an index is out of range, in which case nothing is
+ * modified.
+ */
+static bool optimizeMesh(
+    const AccessorView<TMeshVector3>& positions,
+    TArray<uint32>& indices,
+    TArray<uint32>& vertexSources,
+    TArray<TMeshVector3>& normals) {
+  const bool hasSources = !vertexSources.IsEmpty();
+  const int32 vertexCount =
+      hasSources ? vertexSources.Num() : int32(positions.size());
+  const int32 indexCount = indices.Num();
+  if (vertexCount == 0 || indexCount == 0 || indexCount % 3 != 0) {
+    return false;
+  }
+
+  for (int32 i = 0; i < indexCount; ++i) {
+    if (indices[i] >= uint32(vertexCount)) {
+      return false;
+    }
+  }
+
+  // The overdraw optimizer reads the positions through a stride, so the glTF
+  // positions are used directly when the vertices are the glTF vertices.
+  TArray<TMeshVector3> gatheredPositions;
+  const float* pPositions = nullptr;
+  size_t positionStride = sizeof(TMeshVector3);
+  const int64 stride = positions.stride();
+  if (!hasSources && stride % int64(sizeof(float)) == 0 && stride <= 256) {
+    pPositions = &positions[0].X;
+    positionStride = size_t(stride);
+  } else {
+    gatheredPositions.SetNumUninitialized(vertexCount);
+    for (int32 i = 0; i < vertexCount; ++i) {
+      gatheredPositions[i] = positions[hasSources ? vertexSources[i] : i];
+    }
+    pPositions = &gatheredPositions[0].X;
+  }
+
+  // The threshold recommended by meshoptimizer, which lets the overdraw
+  // optimizer make the vertex cache hit rate up to 5% worse.
+  constexpr float overdrawThreshold = 1.05f;
+
+  TArray<uint32> cacheOptimized;
+  cacheOptimized.SetNumUninitialized(indexCount);
+  meshopt_optimizeVertexCache(
+      cacheOptimized.GetData(),
+      indices.GetData(),
+      size_t(indexCount),
+      size_t(vertexCount));
+  meshopt_optimizeOverdraw(
+      indices.GetData(),
+      cacheOptimized.GetData(),
+      size_t(indexCount),
+      pPositions,
+      size_t(vertexCount),
+      positionStride,
+      overdrawThreshold);
+
+  TArray<uint32> remap;
+  remap.SetNumUninitialized(vertexCount);
+  const int32 usedVertexCount = int32(meshopt_optimizeVertexFetchRemap(
+      remap.GetData(),
+      indices.GetData(),
+      size_t(indexCount),
+      size_t(vertexCount)));
+  meshopt_remapIndexBuffer(
+      indices.GetData(),
+      indices.GetData(),
+      size_t(indexCount),
+      remap.GetData());
+
+  TArray<uint32> reorderedSources;
+  reorderedSources.SetNumUninitialized(usedVertexCount);
+  TArray<TMeshVector3> reorderedNormals;
+  if (!normals.IsEmpty()) {
+    reorderedNormals.SetNumUninitialized(usedVertexCount);
+  }
+
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    const uint32 target = remap[vertex];
+    if (target == TNumericLimits<uint32>::Max()) {
+      continue;
+    }
+    reorderedSources[target] =
+        hasSources ? vertexSources[vertex] : uint32(vertex);
+    if (!normals.IsEmpty()) {
+      reorderedNormals[target] = normals[vertex];
+    }
+  }
+
+  vertexSources = MoveTemp(reorderedSources);
+  normals = MoveTemp(reorderedNormals);
+  return true;
+}
+
+/**
+ * Adds a second LOD to a mesh, with about a quarter of the triangles of the
+ * first LOD, which must have a single section of triangles. The triangles
+ * are simplified with quadric error metrics. The border of the mesh is kept
+ * as it is, so that there are no cracks between the LOD and the tiles next to
+ * it.
+ *
+ * @param renderData The render data, whose first LOD has been created.
+ * @param indices The indices of the triangles of the first LOD.
+ * @param trianglesShareVertices Whether the triangles share vertices, rather
+ * than each triangle having its own three vertices.
+ * @param screenSize The screen size below which the LOD is used.
+ * @returns false if the mesh can't be simplified enough to be worth a second
+ * LOD, in which case the render data is left as it is.
+ */
+static bool addSimplifiedLod(
+    FStaticMeshRenderData& renderData,
+    const TArray<uint32>& indices,
+    bool trianglesShareVertices,
+    float screenSize) {
+  // The fraction of the triangles to keep, and the largest deviation from
+  // the original mesh, relative to its size.
+  constexpr float targetTriangleRatio = 0.25f;
+  constexpr float targetError = 0.01f;
+  // A LOD with more than this fraction of the triangles isn't worth its
+  // memory.
+  constexpr float maximumTriangleRatio = 0.75f;
+
+  const FStaticMeshVertexBuffers& source =
+      renderData.LODResources[0].VertexBuffers;
+  const int32 vertexCount =
+      int32(source.PositionVertexBuffer.GetNumVertices());
+  const int32 indexCount = indices.Num();
+  if (vertexCount == 0 || indexCount == 0 || indexCount % 3 != 0) {
+    return false;
+  }
+
+  const float* pPositions = &source.PositionVertexBuffer.VertexPosition(0).X;
+  constexpr size_t positionStride = sizeof(FVector3f);
+
+  // The simplifier keeps the seams between shared vertices that have the
+  // same position, such as texture coordinate seams. When each triangle has
+  // its own vertices, they are all seams, so the topology is taken from the
+  // positions alone.
+  TArray<uint32> shadowIndices;
+  if (!trianglesShareVertices) {
+    shadowIndices.SetNumUninitialized(indexCount);
+    meshopt_generateShadowIndexBuffer(
+        shadowIndices.GetData(),
+        indices.GetData(),
+        size_t(indexCount),
+        pPositions,
+        size_t(vertexCount),
+        sizeof(FVector3f),
+        positionStride);
+  }
+  const TArray<uint32>& topology =
+      trianglesShareVertices ? indices : shadowIndices;
+
+  const size_t targetIndexCount =
+      size_t(FMath::FloorToInt32(indexCount / 3 * targetTriangleRatio)) * 3;
+  TArray<uint32> simplifiedIndices;
+  simplifiedIndices.SetNumUninitialized(indexCount);
+  const int32 simplifiedIndexCount = int32(meshopt_simplify(
+      simplifiedIndices.GetData(),
+      topology.GetData(),
+      size_t(indexCount),
+      pPositions,
+      size_t(vertexCount),
+      positionStride,
+      targetIndexCount,
+      targetError,
+      meshopt_SimplifyLockBorder,
+      nullptr));
+  if (simplifiedIndexCount == 0 ||
+      simplifiedIndexCount > indexCount * maximumTriangleRatio) {
+    return false;
+  }
+  simplifiedIndices.SetNum(simplifiedIndexCount);
+
+  // Only the vertices that are still used are copied to the LOD.
+  TArray<uint32> remap;
+  remap.SetNumUninitialized(vertexCount);
+  const int32 lodVertexCount = int32(meshopt_optimizeVertexFetchRemap(
+      remap.GetData(),
+      simplifiedIndices.GetData(),
+      size_t(simplifiedIndexCount),
+      size_t(vertexCount)));
+  meshopt_remapIndexBuffer(
+      simplifiedIndices.GetData(),
+      simplifiedIndices.GetData(),
+      size_t(simplifiedIndexCount),
+      remap.GetData());
+
+  // Like AllocateLODResources, which can only be called once.
+  renderData.LODResources.Add(new FStaticMeshLODResources());
+  new (renderData.LODVertexFactories)
+      FStaticMeshVertexFactories(GMaxRHIFeatureLevel);
+  FStaticMeshLODResources& lod = renderData.LODResources[1];
+  FStaticMeshVertexBuffers& target = lod.VertexBuffers;
+
+  const uint32 texCoordCount = source.StaticMeshVertexBuffer.GetNumTexCoords();
+  const bool hasColors = source.ColorVertexBuffer.GetNumVertices() != 0;
+  target.PositionVertexBuffer.Init(uint32(lodVertexCount), false);
+  target.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
+      source.StaticMeshVertexBuffer.GetUseFullPrecisionUVs());
+  target.StaticMeshVertexBuffer.Init(
+      uint32(lodVertexCount),
+      texCoordCount,
+      false);
+  if (hasColors) {
+    target.ColorVertexBuffer.Init(uint32(lodVertexCount), false);
+  }
+
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    const uint32 lodVertex = remap[vertex];
+    if (lodVertex == TNumericLimits<uint32>::Max()) {
+      continue;
+    }
+
+    target.PositionVertexBuffer.VertexPosition(lodVertex) =
+        source.PositionVertexBuffer.VertexPosition(vertex);
+    target.StaticMeshVertexBuffer.SetVertexTangents(
+        lodVertex,
+        FVector3f(source.StaticMeshVertexBuffer.VertexTangentX(vertex)),
+        FVector3f(source.StaticMeshVertexBuffer.VertexTangentY(vertex)),
+        FVector3f(source.StaticMeshVertexBuffer.VertexTangentZ(vertex)));
+    for (uint32 uv = 0; uv < texCoordCount; ++uv) {
+      target.StaticMeshVertexBuffer.SetVertexUV(
+          lodVertex,
+          uv,
+          source.StaticMeshVertexBuffer.GetVertexUV(vertex, uv));
+    }
+    if (hasColors) {
+      target.ColorVertexBuffer.VertexColor(lodVertex) =
+          source.ColorVertexBuffer.VertexColor(vertex);
+    }
+  }
+
+  // The section is copied, so that it has the same material and flags.
+  FStaticMeshSection& section =
+      lod.Sections.Add_GetRef(renderData.LODResources[0].Sections[0]);
+  section.NumTriangles = uint32(simplifiedIndexCount / 3);
+  section.MaxVertexIndex = uint32(lodVertexCount - 1);
+  section.bEnableCollision = false;
+
+  lod.IndexBuffer.SetIndices(
+      simplifiedIndices,
+      lodVertexCount <= TNumericLimits<uint16>::Max()
+          ? EIndexBufferStride::Type::Force16Bit
+          : EIndexBufferStride::Type::Force32Bit);
+  lod.bHasColorVertexData = hasColors;
+  lod.bHasDepthOnlyIndices = false;
+  lod.bHasReversedIndices = false;
+  lod.bHasReversedDepthOnlyIndices = false;
+
+  renderData.ScreenSize[1].Default = screenSize;
+  return true;
+}
 
 static const Material defaultMaterial;
 static const MaterialPBRMetallicRoughness defaultPbrMetallicRoughness;
 
 struct ColorVisitor {
   bool duplicateVertices;
-  TArray<FStaticMeshBuildVertex>& StaticMeshBuildVertices;
+  FColorVertexBuffer& ColorVertexBuffer;
   const TArray<uint32>& indices;
 
   bool operator()(AccessorView<nullptr_t>&& invalidView) { return false; }
@@ -331,22 +1077,23 @@ struct ColorVisitor {
     bool success = true;
     if (duplicateVertices) {
       for (int i = 0; success && i < this->indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
+        FColor& color = this->ColorVertexBuffer.VertexColor(i);
         uint32 vertexIndex = this->indices[i];
         if (vertexIndex >= colorView.size()) {
           success = false;
         } else {
-          success =
-              ColorVisitor::convertColor(colorView[vertexIndex], vertex.Color);
+          success = ColorVisitor::convertColor(colorView[vertexIndex], color);
         }
       }
     } else {
-      for (int i = 0; success && i < this->StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
+      const int32 vertexCount =
+          int32(this->ColorVertexBuffer.GetNumVertices());
+      for (int i = 0; success && i < vertexCount; ++i) {
+        FColor& color = this->ColorVertexBuffer.VertexColor(i);
         if (i >= colorView.size()) {
           success = false;
         } else {
-          success = ColorVisitor::convertColor(colorView[i], vertex.Color);
+          success = ColorVisitor::convertColor(colorView[i], color);
         }
       }
     }
@@ -372,6 +1119,26 @@ struct ColorVisitor {
            convertElement(color.value[3], out.A);
   }
 
+  static bool
+  convertColor(const AccessorTypes::VEC3<float>& color, FColor& out) {
+    out = CesiumVertexKernels::convertColor(
+        color.value[0],
+        color.value[1],
+        color.value[2],
+        1.0f);
+    return true;
+  }
+
+  static bool
+  convertColor(const AccessorTypes::VEC4<float>& color, FColor& out) {
+    out = CesiumVertexKernels::convertColor(
+        color.value[0],
+        color.value[1],
+        color.value[2],
+        color.value[3]);
+    return true;
+  }
+
   static bool convertElement(float value, uint8_t& out) {
     out = uint8_t(value * 255.0f);
     return true;
@@ -425,6 +1192,101 @@ static TUniquePtr<CesiumTextureUtility::LoadedTextureResult> loadTexture(
       textureResources);
 }
 
+/**
+ * Block-compresses the image of a color texture, if it isn't already, so
+ * that it takes less GPU memory.
+ */
+template <class T>
+static void compressColorTexture(
+    CesiumGltf::Model& model,
+    const std::optional<T>& gltfTexture) {
+  if (!gltfTexture) {
+    return;
+  }
+
+  const CesiumGltf::Texture* pTexture =
+      Model::getSafe(&model.textures, gltfTexture.value().index);
+  if (!pTexture) {
+    return;
+  }
+
+  const CesiumGltf::ExtensionTextureWebp* pWebpExtension =
+      pTexture->getExtension<CesiumGltf::ExtensionTextureWebp>();
+  CesiumGltf::Image* pImage = Model::getSafe(
+      &model.images,
+      pWebpExtension ? pWebpExtension->source : pTexture->source);
+  if (pImage && !pImage->cesium.pixelData.empty()) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompressTexture)
+    CesiumConvertedTileCache::compressImage(pImage->cesium);
+  }
+}
+
+namespace {
+
+/**
+ * How a water mask image is used once it has been examined.
+ */
+enum class WaterMaskContent { Mixed, OnlyWater, OnlyLand };
+
+/**
+ * Examines a water mask image, whose first channel is 255 where there is
+ * water and 0 where there is land.
+ *
+ * A mask of a single value needs no texture, because the OnlyWater and
+ * OnlyLand material parameters describe it just as well. A mixed mask keeps
+ * only its first channel, so its texture is created as `PF_R8`. Children
+ * upsampled from a tile carry an identical copy of its mask, with a
+ * translation and scale selecting their part of it, so the texture of the
+ * parent's mask is then shared rather than created again.
+ */
+WaterMaskContent reduceWaterMask(CesiumGltf::ImageCesium& image) {
+  if (image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 || image.channels < 1 || image.width <= 0 ||
+      image.height <= 0) {
+    return WaterMaskContent::Mixed;
+  }
+
+  const size_t texelCount = size_t(image.width) * size_t(image.height);
+  const size_t channels = size_t(image.channels);
+  if (image.pixelData.size() < texelCount * channels) {
+    return WaterMaskContent::Mixed;
+  }
+
+  const std::byte first = image.pixelData[0];
+  bool uniform = true;
+  for (size_t i = 1; i < texelCount && uniform; ++i) {
+    uniform = image.pixelData[i * channels] == first;
+  }
+
+  if (uniform && first == std::byte(255)) {
+    return WaterMaskContent::OnlyWater;
+  }
+  if (uniform && first == std::byte(0)) {
+    return WaterMaskContent::OnlyLand;
+  }
+
+  if (channels > 1) {
+    // The mips, if any, follow the image with the same layout, so they're
+    // reduced along with it.
+    const size_t reducedSize = image.pixelData.size() / channels;
+    for (size_t i = 0; i < reducedSize; ++i) {
+      image.pixelData[i] = image.pixelData[i * channels];
+    }
+    image.pixelData.resize(reducedSize);
+    image.pixelData.shrink_to_fit();
+    for (CesiumGltf::ImageCesiumMipPosition& mip : image.mipPositions) {
+      mip.byteOffset /= channels;
+      mip.byteSize /= channels;
+    }
+    image.channels = 1;
+  }
+
+  return WaterMaskContent::Mixed;
+}
+
+} // namespace
+
 static void applyWaterMask(
     Model& model,
     const MeshPrimitive& primitive,
@@ -449,8 +1311,24 @@ static void applyWaterMask(
             waterMaskTextureIdIt->second.getInt64OrDefault(-1));
         TextureInfo waterMaskInfo;
         waterMaskInfo.index = waterMaskTextureId;
-        if (waterMaskTextureId >= 0 &&
-            waterMaskTextureId < model.textures.size()) {
+        const CesiumGltf::Texture* pTexture =
+            Model::getSafe(&model.textures, waterMaskTextureId);
+        CesiumGltf::Image* pImage =
+            pTexture ? Model::getSafe(&model.images, pTexture->source)
+                     : nullptr;
+
+        // The pixel data of an image whose texture was already created for
+        // another primitive is gone, and that texture is used as it is.
+        WaterMaskContent content = WaterMaskContent::Mixed;
+        if (pImage && !pImage->cesium.pixelData.empty()) {
+          content = reduceWaterMask(pImage->cesium);
+        }
+
+        if (content == WaterMaskContent::OnlyWater) {
+          primitiveResult.onlyWater = true;
+        } else if (content == WaterMaskContent::OnlyLand) {
+          primitiveResult.onlyLand = true;
+        } else if (pTexture) {
           primitiveResult.waterMaskTexture = loadTexture(
               model,
               std::make_optional(waterMaskInfo),
@@ -617,6 +1495,96 @@ static void createTexCoordAccessorsForFeaturesMetadata(
   }
 }
 
+/**
+ * How the feature IDs of an attribute or implicit feature ID set are stored in
+ * a texture coordinate channel, when feature IDs are packed. The material reads
+ * it from the set's `_PACKING` parameter.
+ */
+enum class FeatureIdPacking : uint32 {
+  // The feature IDs are the U of the channel.
+  U = 0,
+  // The feature IDs are the V of a channel whose U holds another set.
+  V = 1,
+  // The low 16 bits of the feature IDs are the U of the channel, and the high
+  // 16 bits are its V, for feature IDs that a float can't hold exactly.
+  Split = 2
+};
+
+/**
+ * Stores the feature IDs of an attribute or implicit feature ID set in the
+ * texture coordinates, and records the channel they're in as a material
+ * parameter.
+ *
+ * Without packing, each set takes the U of a channel of its own. With packing,
+ * two sets share a channel when a float holds their feature IDs exactly. The
+ * channel with a free V, if any, is tracked by `sharedChannel`.
+ */
+static void writeFeatureIds(
+    const FString& safeName,
+    const TArray<int64>& featureIds,
+    bool packFeatureIds,
+    int32_t gltfKey,
+    int32& sharedChannel,
+    TexCoordChannels& texCoords,
+    TMap<FString, uint32_t>& featuresMetadataTexcoordParameters,
+    std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
+  // Integers up to 2^24 are exact in a 32-bit float.
+  constexpr int64 largestExactInteger = int64(1) << 24;
+  bool isExact = true;
+  for (int64 featureId : featureIds) {
+    if (featureId > largestExactInteger || featureId < -largestExactInteger) {
+      isExact = false;
+      break;
+    }
+  }
+
+  const FString packingName =
+      safeName + CesiumEncodedFeaturesMetadata::MaterialFeatureIdPackingSuffix;
+
+  if (packFeatureIds && isExact && sharedChannel >= 0) {
+    TArray<TMeshVector2>& uvs = texCoords.getChannel(uint32(sharedChannel));
+    for (int32 i = 0; i < uvs.Num() && i < featureIds.Num(); ++i) {
+      uvs[i].Y = static_cast<float>(featureIds[i]);
+    }
+    featuresMetadataTexcoordParameters.Emplace(
+        safeName,
+        uint32_t(sharedChannel));
+    featuresMetadataTexcoordParameters.Emplace(
+        packingName,
+        uint32_t(FeatureIdPacking::V));
+    sharedChannel = -1;
+    return;
+  }
+
+  const uint32_t textureCoordinateIndex = gltfToUnrealTexCoordMap.size();
+  gltfToUnrealTexCoordMap[gltfKey] = textureCoordinateIndex;
+  featuresMetadataTexcoordParameters.Emplace(safeName, textureCoordinateIndex);
+
+  const bool split = packFeatureIds && !isExact;
+  TArray<TMeshVector2>& uvs = texCoords.getChannel(textureCoordinateIndex);
+  for (int32 i = 0; i < uvs.Num() && i < featureIds.Num(); ++i) {
+    if (split) {
+      // The bits of the feature ID as a 32-bit integer, so that the null
+      // feature ID of -1 comes back as -1 too.
+      const uint32 bits = static_cast<uint32>(featureIds[i]);
+      uvs[i] = TMeshVector2(
+          static_cast<float>(bits & 0xffff),
+          static_cast<float>(bits >> 16));
+    } else {
+      uvs[i] = TMeshVector2(static_cast<float>(featureIds[i]), 0.0f);
+    }
+  }
+
+  if (packFeatureIds) {
+    featuresMetadataTexcoordParameters.Emplace(
+        packingName,
+        uint32_t(split ? FeatureIdPacking::Split : FeatureIdPacking::U));
+    if (!split) {
+      sharedChannel = int32(textureCoordinateIndex);
+    }
+  }
+}
+
 /**
  * Updates the primitive's information for the texture coordinates required for
  * features and metadata styling. This processes existing texture coordinate
@@ -627,7 +1595,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    TexCoordChannels& texCoords,
     const TArray<uint32>& indices,
     const FCesiumPrimitiveFeatures& primitiveFeatures,
     const CesiumEncodedFeaturesMetadata::EncodedPrimitiveFeatures&
@@ -636,6 +1604,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
         encodedPrimitiveMetadata,
     const CesiumEncodedFeaturesMetadata::EncodedModelMetadata&
         encodedModelMetadata,
+    bool packFeatureIds,
     TMap<FString, uint32_t>& featuresMetadataTexcoordParameters,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
 
@@ -666,7 +1635,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
               model,
               primitive,
               duplicateVertices,
-              vertices,
+              texCoords,
               indices,
               "TEXCOORD_" +
                   std::to_string(encodedProperty.textureCoordinateSetIndex),
@@ -683,6 +1652,11 @@ static void updateTextureCoordinatesForFeaturesMetadata(
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(
           primitiveFeatures);
 
+  // The feature IDs of each attribute or implicit set, for each vertex of the
+  // mesh, and the channel whose V can take the next set when packing.
+  TArray<int64> featureIds;
+  int32 sharedChannel = -1;
+
   for (const CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet&
            encodedFeatureIDSet : encodedPrimitiveFeatures.featureIdSets) {
     FString SafeName = CesiumEncodedFeaturesMetadata::createHlslSafeName(
@@ -698,12 +1672,6 @@ static void updateTextureCoordinatesForFeaturesMetadata(
       // This was already validated when creating the EncodedFeatureIdSet.
       int32_t accessor = primitive.attributes.at(attributeName);
 
-      uint32_t textureCoordinateIndex = gltfToUnrealTexCoordMap.size();
-      gltfToUnrealTexCoordMap[accessor] = textureCoordinateIndex;
-      featuresMetadataTexcoordParameters.Emplace(
-          SafeName,
-          textureCoordinateIndex);
-
       const FCesiumFeatureIdSet& featureIDSet =
           featureIDSets[encodedFeatureIDSet.index];
       const FCesiumFeatureIdAttribute& featureIDAttribute =
@@ -714,34 +1682,30 @@ static void updateTextureCoordinatesForFeaturesMetadata(
           UCesiumFeatureIdAttributeBlueprintLibrary::GetVertexCount(
               featureIDAttribute);
 
-      // We encode unsigned integer feature ids as floats in the u-channel of
-      // a texture coordinate slot.
-      if (duplicateVertices) {
-        for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          uint32 vertexIndex = indices[i];
-          if (vertexIndex >= 0 && vertexIndex < vertexCount) {
-            float featureId = static_cast<float>(
-                UCesiumFeatureIdAttributeBlueprintLibrary::
-                    GetFeatureIDForVertex(featureIDAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-          }
+      // We encode unsigned integer feature ids as floats in the texture
+      // coordinates.
+      featureIds.SetNumZeroed(texCoords.vertexCount);
+      for (int32 i = 0; i < featureIds.Num(); ++i) {
+        int64 vertexIndex = i;
+        if (duplicateVertices) {
+          vertexIndex = i < indices.Num() ? int64(indices[i]) : -1;
         }
-      } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          if (i < vertexCount) {
-            float featureId = static_cast<float>(
-                UCesiumFeatureIdAttributeBlueprintLibrary::
-                    GetFeatureIDForVertex(featureIDAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-          }
+        if (vertexIndex >= 0 && vertexIndex < vertexCount) {
+          featureIds[i] =
+              UCesiumFeatureIdAttributeBlueprintLibrary::GetFeatureIDForVertex(
+                  featureIDAttribute,
+                  vertexIndex);
         }
       }
+      writeFeatureIds(
+          SafeName,
+          featureIds,
+          packFeatureIds,
+          accessor,
+          sharedChannel,
+          texCoords,
+          featuresMetadataTexcoordParameters,
+          gltfToUnrealTexCoordMap);
     } else if (encodedFeatureIDSet.texture) {
       const CesiumEncodedFeaturesMetadata::EncodedFeatureIdTexture&
           encodedFeatureIDTexture = *encodedFeatureIDSet.texture;
@@ -751,7 +1715,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
               model,
               primitive,
               duplicateVertices,
-              vertices,
+              texCoords,
               indices,
               "TEXCOORD_" +
                   std::to_string(
@@ -759,28 +1723,25 @@ static void updateTextureCoordinatesForFeaturesMetadata(
               gltfToUnrealTexCoordMap));
     } else {
       // Similar to feature ID attributes, we encode the unsigned integer vertex
-      // ids as floats in the u-channel of a texture coordinate slot. If it ever
-      // becomes possible to access the vertex ID through an Unreal material
-      // node, this can be removed.
-      uint32_t textureCoordinateIndex = gltfToUnrealTexCoordMap.size();
-      gltfToUnrealTexCoordMap[-1] = textureCoordinateIndex;
-      featuresMetadataTexcoordParameters.Emplace(
-          SafeName,
-          textureCoordinateIndex);
-      if (duplicateVertices) {
-        for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          uint32 vertexIndex = indices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
-        }
-      } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(i), 0.0f);
+      // ids as floats in the texture coordinates. If it ever becomes possible
+      // to access the vertex ID through an Unreal material node, this can be
+      // removed.
+      featureIds.SetNumZeroed(texCoords.vertexCount);
+      for (int32 i = 0; i < featureIds.Num(); ++i) {
+        featureIds[i] = i;
+        if (duplicateVertices) {
+          featureIds[i] = i < indices.Num() ? int64(indices[i]) : 0;
         }
       }
+      writeFeatureIds(
+          SafeName,
+          featureIds,
+          packFeatureIds,
+          -1,
+          sharedChannel,
+          texCoords,
+          featuresMetadataTexcoordParameters,
+          gltfToUnrealTexCoordMap);
     }
   }
 }
@@ -790,7 +1751,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
     const Model& model,
     const MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    TexCoordChannels& texCoords,
     const TArray<uint32>& indices,
     const CesiumEncodedMetadataUtility::EncodedMetadata& encodedMetadata,
     const CesiumEncodedMetadataUtility::EncodedMetadataPrimitive&
@@ -810,7 +1771,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
             model,
             primitive,
             duplicateVertices,
-            vertices,
+            texCoords,
             indices,
             "TEXCOORD_" +
                 std::to_string(
@@ -832,7 +1793,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
                 model,
                 primitive,
                 duplicateVertices,
-                vertices,
+                texCoords,
                 indices,
                 "TEXCOORD_" + std::to_string(
                                   encodedProperty.textureCoordinateAttributeId),
@@ -873,30 +1834,24 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& uvs = texCoords.getChannel(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          if (i < vertexCount) {
-            float featureId = static_cast<float>(
-                UCesiumFeatureIdAttributeBlueprintLibrary::
-                    GetFeatureIDForVertex(featureIdAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
-          } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-          }
+        for (int64_t i = 0; i < uvs.Num() && i < vertexCount; ++i) {
+          float featureId = static_cast<float>(
+              UCesiumFeatureIdAttributeBlueprintLibrary::GetFeatureIDForVertex(
+                  featureIdAttribute,
+                  i));
+          uvs[i] = TMeshVector2(featureId, 0.0f);
         }
       }
     }
@@ -910,7 +1865,7 @@ static void loadPrimitiveFeaturesMetadata(
     CesiumGltf::Model& model,
     CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    TexCoordChannels& texCoords,
     const TArray<uint32>& indices,
     std::vector<FCesiumTextureResourceBase*>& textureResources) {
 
@@ -982,8 +1937,9 @@ static void loadPrimitiveFeaturesMetadata(
       pModelResult->Metadata,
       primitiveResult.TexCoordAccessorMap);
 
-  const FCesiumFeaturesMetadataDescription* pFeaturesMetadataDescription =
-      pModelOptions->pFeaturesMetadataDescription;
+  const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription*
+      pFeaturesMetadataDescription =
+          pModelOptions->pFeaturesMetadataDescription;
 
   // Check for deprecated metadata description
   const FMetadataDescription* pMetadataDescription_DEPRECATED =
@@ -995,12 +1951,13 @@ static void loadPrimitiveFeaturesMetadata(
   if (pFeaturesMetadataDescription) {
     primitiveResult.EncodedFeatures =
         CesiumEncodedFeaturesMetadata::encodePrimitiveFeaturesAnyThreadPart(
-            pFeaturesMetadataDescription->Features,
-            primitiveResult.Features);
+            pFeaturesMetadataDescription->getDescription().Features,
+            primitiveResult.Features,
+            &pFeaturesMetadataDescription->getFeatureIdSets());
 
     primitiveResult.EncodedMetadata =
         CesiumEncodedFeaturesMetadata::encodePrimitiveMetadataAnyThreadPart(
-            pFeaturesMetadataDescription->PrimitiveMetadata,
+            pFeaturesMetadataDescription->getDescription().PrimitiveMetadata,
             primitiveResult.Metadata,
             pModelResult->Metadata);
 
@@ -1008,12 +1965,13 @@ static void loadPrimitiveFeaturesMetadata(
         model,
         primitive,
         duplicateVertices,
-        vertices,
+        texCoords,
         indices,
         primitiveResult.Features,
         primitiveResult.EncodedFeatures,
         primitiveResult.EncodedMetadata,
         pModelResult->EncodedMetadata,
+        pModelOptions->packFeatureIds,
         primitiveResult.FeaturesMetadataTexCoordParameters,
         gltfToUnrealTexCoordMap);
   } else if (pMetadataDescription_DEPRECATED) {
@@ -1026,7 +1984,7 @@ static void loadPrimitiveFeaturesMetadata(
         model,
         primitive,
         duplicateVertices,
-        vertices,
+        texCoords,
         indices,
         *pModelResult->EncodedMetadata_DEPRECATED,
         *primitiveResult.EncodedMetadata_DEPRECATED,
@@ -1041,61 +1999,6 @@ static void loadPrimitiveFeaturesMetadata(
 
 namespace {
 
-/**
- * @brief Constrain the length of the given string.
- *
- * If the string is shorter than the maximum length, it is returned.
- * If it is not longer than 3 characters, the first maxLength
- * characters will be returned.
- * Otherwise, the result will be of the form `prefix + "..." + suffix`,
- * with the prefix and suffix chosen so that the length of the result
- * is maxLength
- *
- * @param s The input string
- * @param maxLength The maximum length.
- * @return The constrained string
- */
-std::string constrainLength(const std::string& s, const size_t maxLength) {
-  if (s.length() <= maxLength) {
-    return s;
-  }
-  if (maxLength <= 3) {
-    return s.substr(0, maxLength);
-  }
-  const std::string ellipsis("...");
-  const size_t prefixLength = ((maxLength - ellipsis.length()) + 1) / 2;
-  const size_t suffixLength = (maxLength - ellipsis.length()) / 2;
-  const std::string prefix = s.substr(0, prefixLength);
-  const std::string suffix = s.substr(s.length() - suffixLength, suffixLength);
-  return prefix + ellipsis + suffix;
-}
-
-/**
- * @brief Create an FName from the given strings.
- *
- * This will combine the prefix and the suffix and create an FName.
- * If the string would be longer than the given length, then
- * the prefix will be shortened (in an unspecified way), to
- * constrain the result to a length of maxLength.
- *
- * The default maximum length is 256, because Unreal may in turn
- * add a prefix like the `/Internal/Path/Name` to this name.
- *
- * @param prefix The prefix input string
- * @param suffix The suffix input string
- * @param maxLength The maximum length
- * @return The FName
- */
-FName createSafeName(
-    const std::string& prefix,
-    const std::string& suffix,
-    const size_t maxLength = 256) {
-  std::string constrainedPrefix =
-      constrainLength(prefix, maxLength - suffix.length());
-  std::string combined = constrainedPrefix + suffix;
-  return FName(combined.c_str());
-}
-
 // This matrix converts from right-handed Z-up to Unreal
 // left-handed Z-up by flipping the Y axis. It effectively undoes the Y-axis
 // flipping that we did when creating the mesh in the first place. This is
@@ -1123,6 +2026,18 @@ constexpr glm::dmat4 yInvertMatrix = {
     1.0};
 } // namespace
 
+/**
+ * @brief Locks the parts of the model that are shared by all of its
+ * primitives, if the primitives are being loaded concurrently.
+ */
+static std::unique_lock<std::mutex>
+lockModel(const CreatePrimitiveOptions& options) {
+  if (!options.pModelMutex) {
+    return std::unique_lock<std::mutex>();
+  }
+  return std::unique_lock<std::mutex>(*options.pModelMutex);
+}
+
 template <class TIndexAccessor>
 static void loadPrimitive(
     LoadPrimitiveResult& primitiveResult,
@@ -1140,6 +2055,14 @@ static void loadPrimitive(
   Mesh& mesh = *options.pMeshOptions->pMesh;
   MeshPrimitive& primitive = *options.pPrimitive;
 
+  // Without rendering, only the positions and indices that collision is built
+  // from are needed, so points, which have no collision, are skipped.
+  const bool headless =
+      options.pMeshOptions->pNodeOptions->pModelOptions->headless;
+  if (headless && primitive.mode == MeshPrimitive::Mode::POINTS) {
+    return;
+  }
+
   if (primitive.mode != MeshPrimitive::Mode::TRIANGLES &&
       primitive.mode != MeshPrimitive::Mode::TRIANGLE_STRIP &&
       primitive.mode != MeshPrimitive::Mode::POINTS) {
@@ -1254,8 +2177,9 @@ static void loadPrimitive(
   }
 
   bool needsTangents =
-      hasNormalMap ||
-      options.pMeshOptions->pNodeOptions->pModelOptions->alwaysIncludeTangents;
+      !headless &&
+      (hasNormalMap || options.pMeshOptions->pNodeOptions->pModelOptions
+                           ->alwaysIncludeTangents);
 
   bool hasTangents = false;
   auto tangentAccessorIt = primitive.attributes.find("TANGENT");
@@ -1273,11 +2197,21 @@ static void loadPrimitive(
     }
   }
 
-  applyWaterMask(model, primitive, primitiveResult, textureResources);
+  if (!headless) {
+    std::unique_lock<std::mutex> modelLock = lockModel(options);
+    applyWaterMask(model, primitive, primitiveResult, textureResources);
+  }
 
   // The water effect works by animating the normal, and the normal is
-  // expressed in tangent space. So if we have water, we need tangents.
+  // expressed in tangent space. So if we have water, we need tangents. When
+  // that is the only reason, the cheaper tangents may be used instead of
+  // mikktspace, if requested.
+  bool useFastTangents = false;
   if (primitiveResult.onlyWater || primitiveResult.waterMaskTexture) {
+    useFastTangents =
+        !needsTangents && !hasTangents &&
+        options.pMeshOptions->pNodeOptions->pModelOptions
+            ->useFastTangentsForWater;
     needsTangents = true;
   }
 
@@ -1295,15 +2229,11 @@ static void loadPrimitive(
     glm::dvec3 minPosition{std::numeric_limits<double>::max()};
     glm::dvec3 maxPosition{std::numeric_limits<double>::lowest()};
     if (min.size() != 3 || max.size() != 3) {
-      for (int32_t i = 0; i < positionView.size(); ++i) {
-        minPosition.x = glm::min<double>(minPosition.x, positionView[i].X);
-        minPosition.y = glm::min<double>(minPosition.y, positionView[i].Y);
-        minPosition.z = glm::min<double>(minPosition.z, positionView[i].Z);
-
-        maxPosition.x = glm::max<double>(maxPosition.x, positionView[i].X);
-        maxPosition.y = glm::max<double>(maxPosition.y, positionView[i].Y);
-        maxPosition.z = glm::max<double>(maxPosition.z, positionView[i].Z);
-      }
+      TMeshVector3 minimum(0.0f);
+      TMeshVector3 maximum(0.0f);
+      CesiumVertexKernels::computeBounds(positionView, minimum, maximum);
+      minPosition = glm::dvec3(minimum.X, minimum.Y, minimum.Z);
+      maxPosition = glm::dvec3(maximum.X, maximum.Y, maximum.Z);
     } else {
       minPosition = glm::dvec3(min[0], min[1], min[2]);
       maxPosition = glm::dvec3(max[0], max[1], max[2]);
@@ -1328,8 +2258,12 @@ static void loadPrimitive(
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
     indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
 
-    for (int32 i = 0; i < indicesView.size(); ++i) {
-      indices[i] = indicesView[i];
+    if constexpr (IsAccessorView<TIndexAccessor>::value) {
+      CesiumVertexKernels::copyIndices(indicesView, indices.GetData());
+    } else {
+      for (int32 i = 0; i < indicesView.size(); ++i) {
+        indices[i] = indicesView[i];
+      }
     }
   } else {
     // assume TRIANGLE_STRIP because all others are rejected earlier.
@@ -1349,50 +2283,132 @@ static void loadPrimitive(
     }
   }
 
+  // Quantized-mesh terrain may be drawn from a heightmap that its triangles
+  // are resampled into, in place of its vertices. It then only needs the
+  // positions, for collision, and the texture coordinates, which are
+  // resampled into the heightmap too. The heightmap rebuilds the normals and
+  // tangents of the terrain, so its vertices are never duplicated.
+  const CreateGltfOptions::CreateModelOptions* pModelOptions =
+      options.pMeshOptions->pNodeOptions->pModelOptions;
+  TSharedPtr<CesiumTerrainHeightmap::Heightmap, ESPMode::ThreadSafe>
+      pHeightmap;
+  CesiumTerrainHeightmap::Resampling heightmapResampling;
+  if (pModelOptions->useTerrainHeightmaps && !headless &&
+      CesiumTerrainHeightmap::isTerrainPrimitive(primitive) &&
+      RHISupportsManualVertexFetch(GMaxRHIShaderPlatform)) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateTerrainHeightmap)
+    TArray<FVector3f> gltfPositions;
+    gltfPositions.SetNumUninitialized(int32(positionView.size()));
+    for (int32 i = 0; i < gltfPositions.Num(); ++i) {
+      gltfPositions[i] = positionView[i];
+    }
+    pHeightmap = CesiumTerrainHeightmap::create(
+        primitive,
+        gltfPositions,
+        indices,
+        transform,
+        ellipsoid,
+        pModelOptions->terrainHeightmapResolution,
+        heightmapResampling);
+  }
+
+  if (pHeightmap) {
+    needsTangents = false;
+    useFastTangents = false;
+  }
+
   // If we don't have normals, the gltf spec prescribes that the client
   // implementation must generate flat normals, which requires duplicating
   // vertices shared by multiple triangles. If we don't have tangents, but
   // need them, we need to use a tangent space generation algorithm which
   // requires duplicated vertices.
-  bool duplicateVertices = !hasNormals || (needsTangents && !hasTangents);
-  duplicateVertices =
-      duplicateVertices && primitive.mode != MeshPrimitive::Mode::POINTS;
+  bool duplicateVertices =
+      !hasNormals || (needsTangents && !hasTangents && !useFastTangents);
+  duplicateVertices = duplicateVertices && !headless && !pHeightmap &&
+                      primitive.mode != MeshPrimitive::Mode::POINTS;
+
+  // When vertices are duplicated, or split by smooth normal generation, this
+  // is the glTF vertex that each vertex is copied from.
+  TArray<uint32> vertexSources;
+  TArray<TMeshVector3> smoothNormals;
+
+  bool hasSmoothNormals = false;
+  if (!hasNormals && isTriangles && !primitiveResult.isUnlit && !headless &&
+      !pHeightmap && pModelOptions->generateSmoothNormals) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeSmoothNormals)
+    hasSmoothNormals = computeSmoothNormals(
+        positionView,
+        pModelOptions->smoothNormalsCreaseAngle,
+        indices,
+        vertexSources,
+        smoothNormals);
+  }
+
+  if (duplicateVertices && !hasSmoothNormals) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DuplicateVertices)
+    vertexSources = indices;
+    for (int32 i = 0; i < indices.Num(); i++) {
+      indices[i] = i;
+    }
+  }
 
-  TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
-  StaticMeshBuildVertices.SetNum(
-      duplicateVertices ? indices.Num()
-                        : static_cast<int>(positionView.size()));
+  // Whether triangles share vertices, rather than each triangle having its
+  // own three vertices.
+  const bool trianglesShareVertices = !duplicateVertices || hasSmoothNormals;
+
+  if (pModelOptions->optimizeMeshes && isTriangles && trianglesShareVertices &&
+      !headless && !pHeightmap) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::OptimizeMesh)
+    const double startTime = FPlatformTime::Seconds();
+    // The reordered vertices are always copied through vertexSources, as if
+    // they were duplicated.
+    if (optimizeMesh(positionView, indices, vertexSources, smoothNormals)) {
+      duplicateVertices = true;
+    }
+    UCesiumTilesetStatistics::RecordStage(
+        ECesiumTileLoadStage::MeshOptimization,
+        (FPlatformTime::Seconds() - startTime) * 1000.0);
+  }
+
+  // Points are shuffled, so that any prefix of them is an even subsample of
+  // the primitive. The scene proxy draws only a prefix when the points are
+  // dense on screen.
+  if (primitive.mode == MeshPrimitive::Mode::POINTS && indices.Num() > 1) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShufflePoints)
+    vertexSources = MoveTemp(indices);
+    FRandomStream random(vertexSources.Num());
+    for (int32 i = vertexSources.Num() - 1; i > 0; --i) {
+      vertexSources.Swap(i, random.RandRange(0, i));
+    }
+
+    indices.SetNumUninitialized(vertexSources.Num());
+    for (int32 i = 0; i < indices.Num(); ++i) {
+      indices[i] = uint32(i);
+    }
+    duplicateVertices = true;
+  }
+
+  // The vertex data is written straight into the vertex buffers of the LOD
+  // resources, one attribute at a time.
+  FStaticMeshVertexBuffers& VertexBuffers = LODResources.VertexBuffers;
+  const uint32 numVertices = duplicateVertices
+                                 ? uint32(vertexSources.Num())
+                                 : static_cast<uint32>(positionView.size());
 
   {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyDuplicatedPositions)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector3& pos = positionView[vertexIndex];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
-    } else {
+    FPositionVertexBuffer& PositionVertexBuffer =
+        VertexBuffers.PositionVertexBuffer;
+    PositionVertexBuffer.Init(numVertices, false);
+
+    if (numVertices > 0) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector3& pos = positionView[i];
-        vertex.Position.X = pos.X;
-        vertex.Position.Y = -pos.Y;
-        vertex.Position.Z = pos.Z;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
+      RenderData->Bounds.SphereRadius =
+          CesiumVertexKernels::copyPositionsInvertingY(
+              positionView,
+              duplicateVertices ? vertexSources.GetData() : nullptr,
+              int64(numVertices),
+              TMeshVector3(RenderData->Bounds.Origin),
+              &PositionVertexBuffer.VertexPosition(0));
     }
   }
 
@@ -1402,33 +2418,56 @@ static void loadPrimitive(
   if (colorAccessorIt != primitive.attributes.end()) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyVertexColors)
     int colorAccessorID = colorAccessorIt->second;
+    FColorVertexBuffer& ColorVertexBuffer = VertexBuffers.ColorVertexBuffer;
+    ColorVertexBuffer.Init(numVertices, false);
     hasVertexColors = createAccessorView(
         model,
         colorAccessorID,
-        ColorVisitor{duplicateVertices, StaticMeshBuildVertices, indices});
+        ColorVisitor{duplicateVertices, ColorVertexBuffer, vertexSources});
+    if (!hasVertexColors) {
+      ColorVertexBuffer.CleanUp();
+    }
   }
 
   LODResources.bHasColorVertexData = hasVertexColors;
 
   // We need to copy the texture coordinates associated with each texture (if
-  // any) into the the appropriate UVs slot in FStaticMeshBuildVertex.
+  // any) into the the appropriate UV channel of the static mesh vertex buffer.
 
   std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap =
       primitiveResult.GltfToUnrealTexCoordMap;
 
-  // This must be done before material textures are loaded, in case any of the
-  // material textures are also used for features + metadata.
-  loadPrimitiveFeaturesMetadata(
-      primitiveResult,
-      options,
-      model,
-      primitive,
-      duplicateVertices,
-      StaticMeshBuildVertices,
-      indices,
-      textureResources);
+  TexCoordChannels texCoords;
+  texCoords.vertexCount = int32(numVertices);
 
   {
+    // Features metadata and material textures add extensions to the model's
+    // textures and take the pixel data from its images.
+    std::unique_lock<std::mutex> modelLock = lockModel(options);
+
+    // This must be done before material textures are loaded, in case any of
+    // the material textures are also used for features + metadata.
+    loadPrimitiveFeaturesMetadata(
+        primitiveResult,
+        options,
+        model,
+        primitive,
+        duplicateVertices,
+        texCoords,
+        vertexSources,
+        textureResources);
+
+    // Only color textures are compressed, because block compression loses
+    // too much from normal maps and packed material parameters.
+    if (options.pMeshOptions->pNodeOptions->pModelOptions->compressTextures &&
+        !headless) {
+      compressColorTexture(model, pbrMetallicRoughness.baseColorTexture);
+      compressColorTexture(model, material.emissiveTexture);
+    }
+  }
+
+  if (!headless) {
+    std::unique_lock<std::mutex> modelLock = lockModel(options);
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadTextures)
     primitiveResult.baseColorTexture = loadTexture(
         model,
@@ -1448,7 +2487,7 @@ static void loadPrimitive(
         loadTexture(model, material.emissiveTexture, true, textureResources);
   }
 
-  {
+  if (!headless) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureCoordinates)
 
     primitiveResult
@@ -1457,8 +2496,8 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
-            indices,
+            texCoords,
+            vertexSources,
             pbrMetallicRoughness.baseColorTexture,
             gltfToUnrealTexCoordMap);
     primitiveResult.textureCoordinateParameters
@@ -1466,8 +2505,8 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
-        indices,
+        texCoords,
+        vertexSources,
         pbrMetallicRoughness.metallicRoughnessTexture,
         gltfToUnrealTexCoordMap);
     primitiveResult
@@ -1476,8 +2515,8 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
-            indices,
+            texCoords,
+            vertexSources,
             material.normalTexture,
             gltfToUnrealTexCoordMap);
     primitiveResult
@@ -1486,8 +2525,8 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
-            indices,
+            texCoords,
+            vertexSources,
             material.occlusionTexture,
             gltfToUnrealTexCoordMap);
     primitiveResult
@@ -1496,8 +2535,8 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
-            indices,
+            texCoords,
+            vertexSources,
             material.emissiveTexture,
             gltfToUnrealTexCoordMap);
 
@@ -1506,14 +2545,18 @@ static void loadPrimitive(
          ++i) {
       std::string attributeName = "_CESIUMOVERLAY_" + std::to_string(i);
       auto overlayIt = primitive.attributes.find(attributeName);
-      if (overlayIt != primitive.attributes.end()) {
+      if (pModelOptions->computeOverlayTextureCoordinates) {
+        // The material computes the overlay's texture coordinates from the
+        // vertex positions, so they don't take a UV channel.
+        primitiveResult.overlayTextureCoordinateIDToUVIndex[i] = -1;
+      } else if (overlayIt != primitive.attributes.end()) {
         primitiveResult.overlayTextureCoordinateIDToUVIndex[i] =
             updateTextureCoordinates(
                 model,
                 primitive,
                 duplicateVertices,
-                StaticMeshBuildVertices,
-                indices,
+                texCoords,
+                vertexSources,
                 attributeName,
                 gltfToUnrealTexCoordMap);
       } else {
@@ -1522,33 +2565,92 @@ static void loadPrimitive(
     }
   }
 
+  FStaticMeshVertexBuffer& StaticMeshVertexBuffer =
+      VertexBuffers.StaticMeshVertexBuffer;
+
+  if (pHeightmap) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ResampleTerrainTextureCoordinates)
+    CesiumTerrainHeightmap::resampleTexCoords(
+        *pHeightmap,
+        heightmapResampling,
+        texCoords.channels);
+    primitiveResult.TerrainHeightmap = pHeightmap;
+  }
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTextureCoordinates)
+
+    // Use full precision (32-bit) UVs unless the compact vertex format was
+    // requested. Full precision is always needed for metadata, because
+    // integer feature IDs can and will lose meaningful precision when using
+    // 16-bit floats.
+    const bool useCompactVertexFormat =
+        headless || (options.pMeshOptions->pNodeOptions->pModelOptions
+                         ->useCompactVertexFormat &&
+                     primitiveResult.FeaturesMetadataTexCoordParameters.Num() ==
+                         0);
+    StaticMeshVertexBuffer.SetUseFullPrecisionUVs(!useCompactVertexFormat);
+
+    const uint32 numTexCoords = FMath::Clamp<uint32>(
+        uint32(gltfToUnrealTexCoordMap.size()),
+        1,
+        MAX_STATIC_TEXCOORDS);
+    StaticMeshVertexBuffer.Init(numVertices, numTexCoords, false);
+
+    for (uint32 uvIndex = 0; uvIndex < numTexCoords; ++uvIndex) {
+      const TArray<TMeshVector2>* pUVs =
+          int32(uvIndex) < texCoords.channels.Num()
+              ? &texCoords.channels[uvIndex]
+              : nullptr;
+      if (pUVs && uint32(pUVs->Num()) == numVertices) {
+        for (uint32 i = 0; i < numVertices; ++i) {
+          StaticMeshVertexBuffer.SetVertexUV(i, uvIndex, (*pUVs)[i]);
+        }
+      } else {
+        for (uint32 i = 0; i < numVertices; ++i) {
+          StaticMeshVertexBuffer.SetVertexUV(i, uvIndex, TMeshVector2(0.0f));
+        }
+      }
+    }
+  }
+
   // TangentX: Tangent
   // TangentY: Bi-tangent
   // TangentZ: Normal
 
-  if (hasNormals) {
+  if (headless || pHeightmap) {
+    // The tangent basis is left unset, as nothing shades the mesh, or the
+    // heightmap rebuilds it.
+  } else if (hasSmoothNormals) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopySmoothNormals)
+    for (uint32 i = 0; i < numVertices; ++i) {
+      StaticMeshVertexBuffer.SetVertexTangents(
+          i,
+          TMeshVector3(0.0f, 0.0f, 0.0f),
+          TMeshVector3(0.0f, 0.0f, 0.0f),
+          smoothNormals[i]);
+    }
+  } else if (hasNormals) {
     if (duplicateVertices) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormalsForDuplicatedVertices)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
+      for (int i = 0; i < vertexSources.Num(); ++i) {
+        uint32 vertexIndex = vertexSources[i];
         const TMeshVector3& normal = normalAccessor[vertexIndex];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        StaticMeshVertexBuffer.SetVertexTangents(
+            i,
+            TMeshVector3(0.0f, 0.0f, 0.0f),
+            TMeshVector3(0.0f, 0.0f, 0.0f),
+            TMeshVector3(normal.X, -normal.Y, normal.Z));
       }
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormals)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
+      for (uint32 i = 0; i < numVertices; ++i) {
         const TMeshVector3& normal = normalAccessor[i];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
+        StaticMeshVertexBuffer.SetVertexTangents(
+            i,
+            TMeshVector3(0.0f, 0.0f, 0.0f),
+            TMeshVector3(0.0f, 0.0f, 0.0f),
+            TMeshVector3(normal.X, -normal.Y, normal.Z));
       }
     }
   } else {
@@ -1562,74 +2664,81 @@ static void loadPrimitive(
               ellipsoid.geodeticSurfaceNormal(glm::dvec3(ecefCenter)),
               0.0)));
       upDir.Y *= -1;
-      setUniformNormals(StaticMeshBuildVertices, upDir);
+      setUniformNormals(StaticMeshVertexBuffer, upDir);
     } else {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeFlatNormals)
-      computeFlatNormals(StaticMeshBuildVertices);
+      computeFlatNormals(VertexBuffers);
     }
   }
 
-  if (hasTangents) {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangentsForDuplicatedVertices)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector4& tangent = tangentAccessor[vertexIndex];
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
-            tangent.W;
-      }
-    } else {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector4& tangent = tangentAccessor[i];
-        vertex.TangentX = tangent;
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
-            tangent.W;
-      }
+  if (hasTangents && !headless && !pHeightmap) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
+    for (uint32 i = 0; i < numVertices; ++i) {
+      uint32 vertexIndex = duplicateVertices ? vertexSources[i] : i;
+      const TMeshVector4& tangent = tangentAccessor[vertexIndex];
+      const TMeshVector3 tangentZ(StaticMeshVertexBuffer.VertexTangentZ(i));
+      const TMeshVector3 tangentX(tangent.X, -tangent.Y, tangent.Z);
+      StaticMeshVertexBuffer.SetVertexTangents(
+          i,
+          tangentX,
+          TMeshVector3::CrossProduct(tangentZ, tangentX) * tangent.W,
+          tangentZ);
     }
   }
 
   if (needsTangents && !hasTangents) {
-    // Use mikktspace to calculate the tangents.
     // Note that this assumes normals and UVs are already populated.
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
-    computeTangentSpace(StaticMeshBuildVertices);
+    if (useFastTangents) {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeFastTangents)
+      computeFastTangents(VertexBuffers, indices);
+    } else {
+      // Use mikktspace to calculate the tangents.
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
+      CesiumConvertedTileCache::generateTangents(
+          VertexBuffers,
+          indices,
+          FString::Printf(
+              TEXT("mikktspace:%d:%d"),
+              trianglesShareVertices ? 1 : 0,
+              MikkTSpaceTrianglesPerChunk),
+          [&]() {
+            computeTangentSpace(VertexBuffers, indices, trianglesShareVertices);
+          });
+    }
   }
 
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
-
-    // Set to full precision (32-bit) UVs. This is especially important for
-    // metadata because integer feature IDs can and will lose meaningful
-    // precision when using 16-bit floats.
-    LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
-        true);
-
-    LODResources.VertexBuffers.PositionVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        false);
+  // The clusters reorder the triangles, so they're built once the vertices
+  // are complete and before the index buffer is filled.
+  if (pModelOptions->useClusterCulling && isTriangles && !headless &&
+      !pHeightmap) {
+    CesiumMeshClusters::build(
+        VertexBuffers.PositionVertexBuffer,
+        indices,
+        primitiveResult.Clusters);
+  }
 
-    FColorVertexBuffer& ColorVertexBuffer =
-        LODResources.VertexBuffers.ColorVertexBuffer;
-    if (hasVertexColors) {
-      ColorVertexBuffer.Init(StaticMeshBuildVertices, false);
-    }
+  // Gaussian splats are packed from the float positions and colors, and are
+  // drawn from the packed splats rather than from the points.
+  if (CesiumGaussianSplats::isGaussianSplatPrimitive(primitive) &&
+      numVertices > 0) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadGaussianSplats)
+    primitiveResult.GaussianSplats = CesiumGaussianSplats::load(
+        model,
+        primitive,
+        VertexBuffers.PositionVertexBuffer,
+        hasVertexColors ? &VertexBuffers.ColorVertexBuffer : nullptr,
+        duplicateVertices ? vertexSources.GetData() : nullptr);
+  }
 
-    LODResources.VertexBuffers.StaticMeshVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        gltfToUnrealTexCoordMap.size() == 0 ? 1
-                                            : gltfToUnrealTexCoordMap.size(),
-        false);
+  // Quantized points are drawn by the point attenuation vertex factory, which
+  // requires manual vertex fetch. This runs last, because the float positions
+  // are needed to compute normals.
+  if (primitive.mode == MeshPrimitive::Mode::POINTS &&
+      !primitiveResult.GaussianSplats &&
+      pModelOptions->quantizePointClouds && numVertices > 0 &&
+      RHISupportsManualVertexFetch(GMaxRHIShaderPlatform)) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::QuantizePointPositions)
+    quantizePointPositions(VertexBuffers.PositionVertexBuffer, primitiveResult);
   }
 
   FStaticMeshSectionArray& Sections = LODResources.Sections;
@@ -1638,31 +2747,68 @@ static void loadPrimitive(
   section.NumTriangles = indices.Num() / 3;
   section.FirstIndex = 0;
   section.MinVertexIndex = 0;
-  section.MaxVertexIndex = StaticMeshBuildVertices.Num() - 1;
+  section.MaxVertexIndex = numVertices - 1;
   section.bEnableCollision = primitive.mode != MeshPrimitive::Mode::POINTS;
   section.bCastShadow = true;
   section.MaterialIndex = 0;
 
-  if (duplicateVertices) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
-    for (int32 i = 0; i < indices.Num(); i++) {
-      indices[i] = i;
-    }
-  }
+  // Every index fits in 16 bits when there are at most 65535 vertices. Like
+  // Unreal's own auto-detection, the largest 16-bit index is reserved.
+  const bool use16BitIndices = numVertices <= TNumericLimits<uint16>::Max();
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
     LODResources.IndexBuffer.SetIndices(
         indices,
-        StaticMeshBuildVertices.Num() >= std::numeric_limits<uint16>::max()
-            ? EIndexBufferStride::Type::Force32Bit
-            : EIndexBufferStride::Type::Force16Bit);
+        use16BitIndices ? EIndexBufferStride::Type::Force16Bit
+                        : EIndexBufferStride::Type::Force32Bit);
   }
 
   LODResources.bHasDepthOnlyIndices = false;
   LODResources.bHasReversedIndices = false;
   LODResources.bHasReversedDepthOnlyIndices = false;
 
+  if (pModelOptions->generateSimplifiedLod && isTriangles && !headless &&
+      !pHeightmap) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SimplifyMesh)
+    addSimplifiedLod(
+        *RenderData,
+        indices,
+        trianglesShareVertices,
+        pModelOptions->simplifiedLodScreenSize);
+  }
+
+#if WITH_EDITOR
+  // Nanite only renders opaque and masked materials.
+  if (pModelOptions->buildNaniteMeshes && isTriangles && !headless &&
+      !pHeightmap &&
+      material.alphaMode != CesiumGltf::Material::AlphaMode::BLEND) {
+    CesiumNaniteBuilder::build(*RenderData, indices);
+  }
+#endif
+
+  primitiveResult.vertexBytes = 0;
+  primitiveResult.indexBytes = 0;
+  for (const FStaticMeshLODResources& lod : RenderData->LODResources) {
+    const FStaticMeshVertexBuffers& lodBuffers = lod.VertexBuffers;
+    primitiveResult.vertexBytes +=
+        uint64(lodBuffers.PositionVertexBuffer.GetNumVertices()) *
+            lodBuffers.PositionVertexBuffer.GetStride() +
+        uint64(lodBuffers.StaticMeshVertexBuffer.GetResourceSize()) +
+        uint64(lodBuffers.ColorVertexBuffer.GetNumVertices()) *
+            lodBuffers.ColorVertexBuffer.GetStride();
+    primitiveResult.indexBytes += uint64(lod.IndexBuffer.GetIndexDataSize());
+  }
+  if (primitiveResult.QuantizedPointPositions) {
+    primitiveResult.vertexBytes +=
+        uint64(primitiveResult.QuantizedPointPositions->Num()) *
+        sizeof(uint16);
+  }
+  if (primitiveResult.GaussianSplats) {
+    primitiveResult.vertexBytes +=
+        uint64(primitiveResult.GaussianSplats->Num()) * sizeof(FVector4f);
+  }
+
   primitiveResult.pModel = &model;
   primitiveResult.pMeshPrimitive = &primitive;
   primitiveResult.RenderData = std::move(RenderData);
@@ -1671,20 +2817,45 @@ static void loadPrimitive(
 
   primitiveResult.transform = transform * yInvertMatrix;
 
+  // The position buffer keeps its data until its RHI resource is created on
+  // the render thread, so the collision mesh can still be built from it. When
+  // physics meshes are created on demand, the tileset builds them later from
+  // the glTF, only for the tiles near its physics mesh focus actors.
   if (primitive.mode != MeshPrimitive::Mode::POINTS &&
-      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
-    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
-      primitiveResult.pCollisionMesh =
-          StaticMeshBuildVertices.Num() < TNumericLimits<uint16>::Max()
-              ? BuildChaosTriangleMeshes<uint16>(
-                    StaticMeshBuildVertices,
-                    indices)
-              : BuildChaosTriangleMeshes<int32>(
-                    StaticMeshBuildVertices,
-                    indices);
+      pModelOptions->createPhysicsMeshes &&
+      !pModelOptions->createPhysicsMeshesOnDemand) {
+    if (numVertices != 0 && indices.Num() != 0) {
+      primitiveResult.pCollisionMesh = CesiumPhysicsMeshCache::getOrBuild(
+          TArrayView<const FVector3f>(
+              &VertexBuffers.PositionVertexBuffer.VertexPosition(0),
+              int32(numVertices)),
+          indices,
+          pModelOptions->physicsMeshSimplificationError);
+      if (primitiveResult.pCollisionMesh) {
+        const Chaos::FTriangleMeshImplicitObject& collisionMesh =
+            *primitiveResult.pCollisionMesh;
+        const uint64 collisionVertexCount =
+            uint64(collisionMesh.Particles().Size());
+        const uint64 indexSize =
+            collisionVertexCount <= TNumericLimits<uint16>::Max()
+                ? sizeof(uint16)
+                : sizeof(int32);
+        const uint64 collisionTriangleCount =
+            uint64(collisionMesh.Elements().GetNumTriangles());
+        primitiveResult.collisionBytes =
+            collisionVertexCount * sizeof(FVector3f) +
+            collisionTriangleCount * (3 * indexSize +
+                                      CollisionBVHBytesPerTriangle);
+      }
     }
   }
+
+  if (pHeightmap) {
+    FStaticMeshLODResources& lod = primitiveResult.RenderData->LODResources[0];
+    releaseTerrainVertices(lod);
+    primitiveResult.vertexBytes = pHeightmap->getSizeBytes();
+    primitiveResult.indexBytes = uint64(lod.IndexBuffer.GetIndexDataSize());
+  }
 }
 
 static void loadIndexedPrimitive(
@@ -1750,6 +2921,137 @@ static void loadIndexedPrimitive(
   }
 }
 
+namespace {
+// Hashes the data of a primitive's attributes and indices, or returns zero if
+// any of them isn't a plain view of a buffer.
+uint64
+hashPrimitiveGeometry(const Model& model, const MeshPrimitive& primitive) {
+  uint64 hash = uint64(primitive.mode) + 1;
+
+  const auto hashAccessor = [&model, &hash](int32_t accessorIndex) {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+    if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0) {
+      return false;
+    }
+    const CesiumGltf::BufferView* pBufferView =
+        Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+    const CesiumGltf::Buffer* pBuffer =
+        pBufferView ? Model::getSafe(&model.buffers, pBufferView->buffer)
+                    : nullptr;
+    if (!pBuffer) {
+      return false;
+    }
+
+    const int64_t elementSize = pAccessor->computeByteSizeOfOneElement();
+    const int64_t stride = pBufferView->byteStride.value_or(elementSize);
+    const int64_t offset = pBufferView->byteOffset + pAccessor->byteOffset;
+    const int64_t size = stride * (pAccessor->count - 1) + elementSize;
+    if (offset < 0 || size <= 0 ||
+        offset + size > int64_t(pBuffer->cesium.data.size())) {
+      return false;
+    }
+
+    const int64_t layout[] = {
+        int64_t(pAccessor->componentType),
+        pAccessor->count,
+        stride,
+        pAccessor->normalized ? 1 : 0};
+    hash = CityHash64WithSeed(
+        reinterpret_cast<const char*>(layout),
+        uint32(sizeof(layout)),
+        hash);
+    hash = CityHash64WithSeed(
+        reinterpret_cast<const char*>(pBuffer->cesium.data.data() + offset),
+        uint32(size),
+        hash);
+    return true;
+  };
+
+  // The attributes are ordered by name, so the hash doesn't depend on the
+  // order in which the glTF lists them.
+  for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+    hash = CityHash64WithSeed(semantic.data(), uint32(semantic.size()), hash);
+    if (!hashAccessor(accessorIndex)) {
+      return 0;
+    }
+  }
+  if (primitive.indices >= 0 && !hashAccessor(primitive.indices)) {
+    return 0;
+  }
+
+  return hash == 0 ? 1 : hash;
+}
+} // namespace
+
+/**
+ * Loads a primitive with the EXT_primitive_voxels extension. Its voxels are
+ * drawn by a CesiumGltfVoxelComponent from a brick, so the render data is only
+ * a placeholder with the bounds of the voxel grid, and it has no collision.
+ */
+static void loadVoxelPrimitive(
+    LoadPrimitiveResult& primitiveResult,
+    const glm::dmat4x4& transform,
+    const CreatePrimitiveOptions& options) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadVoxelPrimitive)
+
+  const CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+  if (modelOptions.headless) {
+    return;
+  }
+
+  const Model& model = *modelOptions.pModel;
+  const MeshPrimitive& primitive = *options.pPrimitive;
+  primitiveResult.Voxels =
+      CesiumVoxels::load(model, primitive, modelOptions.voxelAttribute);
+  if (!primitiveResult.Voxels) {
+    return;
+  }
+
+  TUniquePtr<FStaticMeshRenderData> RenderData =
+      MakeUnique<FStaticMeshRenderData>();
+  RenderData->AllocateLODResources(1);
+  RenderData->Bounds = FBoxSphereBounds(
+      FVector::ZeroVector,
+      FVector::OneVector,
+      FMath::Sqrt(3.0));
+
+  FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
+  FStaticMeshVertexBuffers& VertexBuffers = LODResources.VertexBuffers;
+  VertexBuffers.PositionVertexBuffer.Init(1, false);
+  VertexBuffers.PositionVertexBuffer.VertexPosition(0) = FVector3f(0.0f);
+  VertexBuffers.StaticMeshVertexBuffer.Init(1, 1, false);
+  VertexBuffers.ColorVertexBuffer.Init(1, false);
+
+  FStaticMeshSection& section = LODResources.Sections.AddDefaulted_GetRef();
+  section.NumTriangles = 1;
+  section.FirstIndex = 0;
+  section.MinVertexIndex = 0;
+  section.MaxVertexIndex = 0;
+  section.bEnableCollision = false;
+  section.bCastShadow = false;
+  section.MaterialIndex = 0;
+
+  LODResources.IndexBuffer.SetIndices(
+      TArray<uint32>({0, 0, 0}),
+      EIndexBufferStride::Type::Force16Bit);
+  LODResources.bHasDepthOnlyIndices = false;
+  LODResources.bHasReversedIndices = false;
+  LODResources.bHasReversedDepthOnlyIndices = false;
+
+  primitiveResult.dimensions =
+      glm::vec3(transform * glm::dvec4(2.0, 2.0, 2.0, 0.0));
+  primitiveResult.vertexBytes = primitiveResult.Voxels->getSizeBytes();
+  primitiveResult.indexBytes = 0;
+  primitiveResult.pModel = &model;
+  primitiveResult.pMeshPrimitive = &primitive;
+  primitiveResult.RenderData = std::move(RenderData);
+  primitiveResult.pMaterial = &defaultMaterial;
+  primitiveResult.isUnlit = true;
+  primitiveResult.pCollisionMesh = nullptr;
+  primitiveResult.transform = transform * yInvertMatrix;
+}
+
 static void loadPrimitive(
     LoadPrimitiveResult& result,
     const glm::dmat4x4& transform,
@@ -1762,6 +3064,23 @@ static void loadPrimitive(
       *options.pMeshOptions->pNodeOptions->pModelOptions->pModel;
   const MeshPrimitive& primitive = *options.pPrimitive;
 
+  // The geometry is hashed before anything is derived from it.
+  if (options.pMeshOptions->pNodeOptions->pModelOptions->mergeInstancedMeshes &&
+      !options.pMeshOptions->pHalfConstructedNodeResult->InstanceTransforms
+           .IsEmpty()) {
+    result.instanceGeometryHash = hashPrimitiveGeometry(model, primitive);
+  }
+
+  result.textureCoordinateParameters = TextureCoordinateParameterMap(
+      options.pMeshOptions->pNodeOptions->pHalfConstructedModelResult
+          ->getAllocator<TextureCoordinateParameterMap::value_type>());
+
+  // Voxel primitives have no positions.
+  if (CesiumVoxels::isVoxelPrimitive(primitive)) {
+    loadVoxelPrimitive(result, transform, options);
+    return;
+  }
+
   auto positionAccessorIt = primitive.attributes.find("POSITION");
   if (positionAccessorIt == primitive.attributes.end()) {
     // This primitive doesn't have a POSITION semantic, ignore it.
@@ -1804,36 +3123,129 @@ static void loadPrimitive(
         ellipsoid);
   }
   result.PositionAccessor = std::move(positionView);
+
+  // The trace mesh and feature index are built from the glTF rather than the
+  // vertex buffers, so that their face indices refer to the faces of the
+  // primitive even when the mesh is optimized.
+  const CreateGltfOptions::CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+  if (result.RenderData &&
+      (modelOptions.createTraceMeshes || modelOptions.createFeatureIndices)) {
+    TArray<FVector3f> tracePositions;
+    TArray<uint32> traceIndices;
+    if (CesiumPhysicsMeshes::copyTriangles(
+            result.PositionAccessor,
+            result.IndexAccessor,
+            primitive.mode,
+            tracePositions,
+            traceIndices)) {
+      if (modelOptions.createFeatureIndices) {
+        result.pFeatureIndex = CesiumFeatureIndex::build(
+            result.Features,
+            tracePositions,
+            traceIndices);
+      }
+      if (modelOptions.createTraceMeshes) {
+        result.pTraceMesh =
+            CesiumTriangleBVH::build(MoveTemp(tracePositions), traceIndices);
+        if (result.pTraceMesh) {
+          result.collisionBytes += result.pTraceMesh->getAllocatedSize();
+        }
+      }
+    }
+  }
 }
 
+namespace {
+/**
+ * @brief A primitive found while traversing a model's scene graph. The
+ * primitives are loaded after the traversal, so that all of a model's
+ * primitives can be loaded in parallel.
+ */
+struct PrimitiveLoadJob {
+  size_t nodeIndex;
+  size_t primitiveIndex;
+  glm::dmat4x4 transform;
+  const Node* pNode;
+  Mesh* pMesh;
+  MeshPrimitive* pPrimitive;
+};
+} // namespace
+
 static void loadMesh(
     std::optional<LoadMeshResult>& result,
     const glm::dmat4x4& transform,
     const CreateMeshOptions& options,
-    std::vector<FCesiumTextureResourceBase*>& textureResources,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+    size_t nodeIndex,
+    std::vector<PrimitiveLoadJob>& primitiveJobs) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadMesh)
 
-  const Model& model = *options.pNodeOptions->pModelOptions->pModel;
   Mesh& mesh = *options.pMesh;
 
-  result = LoadMeshResult();
-  result->primitiveResults.reserve(mesh.primitives.size());
-  for (CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
-    CreatePrimitiveOptions primitiveOptions = {&options, &*result, &primitive};
-    auto& primitiveResult = result->primitiveResults.emplace_back();
-    loadPrimitive(
-        primitiveResult,
+  result = LoadMeshResult{ArenaVector<LoadPrimitiveResult>(
+      options.pNodeOptions->pHalfConstructedModelResult
+          ->getAllocator<LoadPrimitiveResult>())};
+  result->primitiveResults.resize(mesh.primitives.size());
+  for (size_t i = 0; i < mesh.primitives.size(); ++i) {
+    primitiveJobs.push_back(PrimitiveLoadJob{
+        nodeIndex,
+        i,
         transform,
-        primitiveOptions,
-        textureResources,
-        ellipsoid);
+        options.pNodeOptions->pNode,
+        &mesh,
+        &mesh.primitives[i]});
+  }
+}
+
+static void loadPrimitives(
+    LoadModelResult& result,
+    const CreateModelOptions& options,
+    const std::vector<PrimitiveLoadJob>& primitiveJobs,
+    std::vector<FCesiumTextureResourceBase*>& textureResources,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadPrimitives)
+
+  std::mutex modelMutex;
+
+  ParallelFor(
+      static_cast<int32>(primitiveJobs.size()),
+      [&](int32 i) {
+        const PrimitiveLoadJob& job = primitiveJobs[i];
+        LoadNodeResult& nodeResult = result.nodeResults[job.nodeIndex];
+        LoadMeshResult& meshResult = *nodeResult.meshResult;
+
+        CreateNodeOptions nodeOptions = {&options, &result, job.pNode};
+        CreateMeshOptions meshOptions = {&nodeOptions, &nodeResult, job.pMesh};
+        CreatePrimitiveOptions primitiveOptions = {
+            &meshOptions,
+            &meshResult,
+            job.pPrimitive,
+            &modelMutex};
+        loadPrimitive(
+            meshResult.primitiveResults[job.primitiveIndex],
+            job.transform,
+            primitiveOptions,
+            textureResources,
+            ellipsoid);
+      });
 
-    // if it doesn't have render data, then it can't be loaded
-    if (!primitiveResult.RenderData) {
-      result->primitiveResults.pop_back();
+  // If a primitive doesn't have render data, then it can't be loaded.
+  for (LoadNodeResult& nodeResult : result.nodeResults) {
+    if (!nodeResult.meshResult) {
+      continue;
     }
+
+    ArenaVector<LoadPrimitiveResult>& primitiveResults =
+        nodeResult.meshResult->primitiveResults;
+    primitiveResults.erase(
+        std::remove_if(
+            primitiveResults.begin(),
+            primitiveResults.end(),
+            [](const LoadPrimitiveResult& primitiveResult) {
+              return !primitiveResult.RenderData;
+            }),
+        primitiveResults.end());
   }
 }
 
@@ -1971,7 +3383,9 @@ static void loadInstancingData(
   } else {
     UE_LOG(LogCesium, Warning, TEXT("Invalid accessor for instance scales"));
   }
-  result.InstanceTransforms.resize(count);
+  // The transforms are built here in the array that the instanced component
+  // takes, so that the game thread adds all of them in one call.
+  result.InstanceTransforms.SetNumUninitialized(int32(count));
   for (int64_t i = 0; i < count; ++i) {
     glm::dmat4 unrealMat =
         yInvertMatrix * instanceTransforms[i] * yInvertMatrix;
@@ -1981,11 +3395,10 @@ static void loadInstancingData(
 }
 
 static void loadNode(
-    std::vector<LoadNodeResult>& loadNodeResults,
+    ArenaVector<LoadNodeResult>& loadNodeResults,
     const glm::dmat4x4& transform,
     const CreateNodeOptions& options,
-    std::vector<FCesiumTextureResourceBase*>& textureResources,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+    std::vector<PrimitiveLoadJob>& primitiveJobs) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadNode)
 
@@ -2010,6 +3423,7 @@ static void loadNode(
   Model& model = *options.pModelOptions->pModel;
   const Node& node = *options.pNode;
 
+  const size_t nodeIndex = loadNodeResults.size();
   LoadNodeResult& result = loadNodeResults.emplace_back();
 
   glm::dmat4x4 nodeTransform = transform;
@@ -2069,8 +3483,8 @@ static void loadNode(
         result.meshResult,
         nodeTransform,
         meshOptions,
-        textureResources,
-        ellipsoid);
+        nodeIndex,
+        primitiveJobs);
   }
 
   for (int childNodeId : node.children) {
@@ -2083,8 +3497,7 @@ static void loadNode(
           loadNodeResults,
           nodeTransform,
           childNodeOptions,
-          textureResources,
-          ellipsoid);
+          primitiveJobs);
     }
   }
 }
@@ -2207,8 +3620,8 @@ loadModelMetadata(LoadModelResult& result, const CreateModelOptions& options) {
 
   result.Metadata = FCesiumModelMetadata(model, *pModelMetadata);
 
-  const FCesiumFeaturesMetadataDescription* pFeaturesMetadataDescription =
-      options.pFeaturesMetadataDescription;
+  const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription*
+      pFeaturesMetadataDescription = options.pFeaturesMetadataDescription;
 
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   const FMetadataDescription* pMetadataDescription_DEPRECATED =
@@ -2216,8 +3629,10 @@ loadModelMetadata(LoadModelResult& result, const CreateModelOptions& options) {
   if (pFeaturesMetadataDescription) {
     result.EncodedMetadata =
         CesiumEncodedFeaturesMetadata::encodeModelMetadataAnyThreadPart(
-            pFeaturesMetadataDescription->ModelMetadata,
-            result.Metadata);
+            pFeaturesMetadataDescription->getDescription().ModelMetadata,
+            result.Metadata,
+            &model,
+            &pFeaturesMetadataDescription->getModelMetadata());
   } else if (pMetadataDescription_DEPRECATED) {
     result.EncodedMetadata_DEPRECATED =
         CesiumEncodedMetadataUtility::encodeMetadataAnyThreadPart(
@@ -2227,23 +3642,71 @@ loadModelMetadata(LoadModelResult& result, const CreateModelOptions& options) {
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
-static void loadModelAnyThreadPart(
+/**
+ * Releases the buffers of a model whose primitives have been loaded, and
+ * points the views of the picking data that was kept at the new buffer, or
+ * clears them if nothing was kept.
+ */
+static void releaseModelBuffers(
     LoadModelResult& result,
-    const glm::dmat4x4& transform,
-    const CreateModelOptions& options,
-    std::vector<FCesiumTextureResourceBase*>& textureResources,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadModelAnyThreadPart)
+    Model& model,
+    bool keepPickingData) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseModelBuffers)
 
-  Model& model = *options.pModel;
+  CesiumGltfBufferRelease::release(model, keepPickingData);
 
-  // Generate mipmaps if needed.
-  // An image needs mipmaps generated for it if:
-  // 1. It is used by a Texture that has a Sampler with a mipmap filtering
-  // mode, and
-  // 2. It does not already have mipmaps.
-  // It's ok if an image has mipmaps even if not all textures will use them.
-  // There's no reason to have two RHI textures, one with and one without
+  for (LoadNodeResult& nodeResult : result.nodeResults) {
+    if (!nodeResult.meshResult) {
+      continue;
+    }
+
+    for (LoadPrimitiveResult& primitiveResult :
+         nodeResult.meshResult->primitiveResults) {
+      primitiveResult.TexCoordAccessorMap.clear();
+      const MeshPrimitive* pPrimitive = primitiveResult.pMeshPrimitive;
+      if (!keepPickingData || !pPrimitive) {
+        primitiveResult.PositionAccessor = AccessorView<FVector3f>();
+        primitiveResult.IndexAccessor = IndexAccessorType();
+        continue;
+      }
+
+      auto positionIt = pPrimitive->attributes.find("POSITION");
+      if (positionIt != pPrimitive->attributes.end()) {
+        primitiveResult.PositionAccessor =
+            AccessorView<FVector3f>(model, positionIt->second);
+      }
+      if (pPrimitive->indices >= 0) {
+        primitiveResult.IndexAccessor =
+            getIndexAccessorView(model, *pPrimitive);
+      }
+    }
+  }
+}
+
+static void loadModelAnyThreadPart(
+    LoadModelResult& result,
+    const glm::dmat4x4& transform,
+    const CreateModelOptions& options,
+    std::vector<FCesiumTextureResourceBase*>& textureResources,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadModelAnyThreadPart)
+
+  Model& model = *options.pModel;
+
+  // The containers of the nodes and primitives only live until the tile's
+  // components are created, so they're allocated from one arena and freed
+  // together.
+  result.pArena = std::make_shared<CesiumLoadArena>();
+  result.nodeResults =
+      ArenaVector<LoadNodeResult>(result.getAllocator<LoadNodeResult>());
+
+  // Generate mipmaps if needed.
+  // An image needs mipmaps generated for it if:
+  // 1. It is used by a Texture that has a Sampler with a mipmap filtering
+  // mode, and
+  // 2. It does not already have mipmaps.
+  // It's ok if an image has mipmaps even if not all textures will use them.
+  // There's no reason to have two RHI textures, one with and one without
   // mips.
   for (const Texture& texture : model.textures) {
     const Sampler& sampler = model.getSafe(model.samplers, texture.sampler);
@@ -2280,10 +3743,20 @@ static void loadModelAnyThreadPart(
     }
   }
 
+  // Primitives are merged before anything is loaded from them, so the rest of
+  // the load sees the merged primitives only.
+  if (options.mergeSmallPrimitives) {
+    CesiumPrimitiveMerging::mergeSmallPrimitives(model);
+  }
+
   loadModelMetadata(result, options);
 
   glm::dmat4x4 rootTransform = transform;
 
+  // Each primitive's geometry is loaded once the scene graph has been
+  // traversed, so that the primitives can be loaded in parallel.
+  std::vector<PrimitiveLoadJob> primitiveJobs;
+
   {
     rootTransform =
         CesiumGltfContent::GltfUtilities::applyRtcCenter(model, rootTransform);
@@ -2299,8 +3772,7 @@ static void loadModelAnyThreadPart(
           result.nodeResults,
           rootTransform,
           nodeOptions,
-          textureResources,
-          ellipsoid);
+          primitiveJobs);
     }
   } else if (model.scenes.size() > 0) {
     // There's no default, so show the first scene
@@ -2311,8 +3783,7 @@ static void loadModelAnyThreadPart(
           result.nodeResults,
           rootTransform,
           nodeOptions,
-          textureResources,
-          ellipsoid);
+          primitiveJobs);
     }
   } else if (model.nodes.size() > 0) {
     // No scenes at all, use the first node as the root node.
@@ -2321,12 +3792,12 @@ static void loadModelAnyThreadPart(
         result.nodeResults,
         rootTransform,
         nodeOptions,
-        textureResources,
-        ellipsoid);
+        primitiveJobs);
   } else if (model.meshes.size() > 0) {
     // No nodes either, show all the meshes.
     for (Mesh& mesh : model.meshes) {
       CreateNodeOptions dummyNodeOptions = {&options, &result, nullptr};
+      const size_t nodeIndex = result.nodeResults.size();
       LoadNodeResult& dummyNodeResult = result.nodeResults.emplace_back();
       CreateMeshOptions meshOptions = {
           &dummyNodeOptions,
@@ -2336,15 +3807,28 @@ static void loadModelAnyThreadPart(
           dummyNodeResult.meshResult,
           rootTransform,
           meshOptions,
-          textureResources,
-          ellipsoid);
+          nodeIndex,
+          primitiveJobs);
     }
   }
+
+  loadPrimitives(
+      result,
+      options,
+      primitiveJobs,
+      textureResources,
+      ellipsoid);
+
+  // The meshes and textures have what they need now, so the buffers are only
+  // kept for the data that is read from the model later.
+  if (options.releaseBuffers && CesiumGltfBufferRelease::canRelease(model)) {
+    releaseModelBuffers(result, model, options.keepPickingBuffers);
+  }
 }
 
 bool applyTexture(
     CesiumGltf::Model& model,
-    UMaterialInstanceDynamic* pMaterial,
+    CesiumMaterialParameters& parameters,
     const FMaterialParameterInfo& info,
     CesiumTextureUtility::LoadedTextureResult* pLoadedTexture) {
   CesiumUtility::IntrusivePointer<
@@ -2356,7 +3840,7 @@ bool applyTexture(
     return false;
   }
 
-  pMaterial->SetTextureParameterValueByInfo(info, pTexture->getUnrealTexture());
+  parameters.setTexture(info, pTexture->getUnrealTexture());
 
   return true;
 }
@@ -2368,20 +3852,22 @@ static void SetGltfParameterValues(
     LoadPrimitiveResult& loadResult,
     const Material& material,
     const MaterialPBRMetallicRoughness& pbr,
-    UMaterialInstanceDynamic* pMaterial,
+    CesiumMaterialParameters& parameters,
     EMaterialParameterAssociation association,
     int32 index) {
   for (auto& textureCoordinateSet : loadResult.textureCoordinateParameters) {
-    pMaterial->SetScalarParameterValueByInfo(
+    parameters.setScalar(
         FMaterialParameterInfo(
-            UTF8_TO_TCHAR(textureCoordinateSet.first.c_str()),
+            FName(
+                int32(textureCoordinateSet.first.size()),
+                textureCoordinateSet.first.data()),
             association,
             index),
         static_cast<float>(textureCoordinateSet.second));
   }
 
   if (pbr.baseColorFactor.size() > 3) {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("baseColorFactor", association, index),
         FLinearColor(
             pbr.baseColorFactor[0],
@@ -2389,7 +3875,7 @@ static void SetGltfParameterValues(
             pbr.baseColorFactor[2],
             pbr.baseColorFactor[3]));
   } else if (pbr.baseColorFactor.size() == 3) {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("baseColorFactor", association, index),
         FLinearColor(
             pbr.baseColorFactor[0],
@@ -2397,43 +3883,43 @@ static void SetGltfParameterValues(
             pbr.baseColorFactor[2],
             1.));
   } else {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("baseColorFactor", association, index),
         FLinearColor(1., 1., 1., 1.));
   }
-  pMaterial->SetScalarParameterValueByInfo(
+  parameters.setScalar(
       FMaterialParameterInfo("metallicFactor", association, index),
       static_cast<float>(loadResult.isUnlit ? 0.0f : pbr.metallicFactor));
-  pMaterial->SetScalarParameterValueByInfo(
+  parameters.setScalar(
       FMaterialParameterInfo("roughnessFactor", association, index),
       static_cast<float>(loadResult.isUnlit ? 1.0f : pbr.roughnessFactor));
-  pMaterial->SetScalarParameterValueByInfo(
+  parameters.setScalar(
       FMaterialParameterInfo("opacityMask", association, index),
       1.0f);
 
   applyTexture(
       model,
-      pMaterial,
+      parameters,
       FMaterialParameterInfo("baseColorTexture", association, index),
       loadResult.baseColorTexture.Get());
   applyTexture(
       model,
-      pMaterial,
+      parameters,
       FMaterialParameterInfo("metallicRoughnessTexture", association, index),
       loadResult.metallicRoughnessTexture.Get());
   applyTexture(
       model,
-      pMaterial,
+      parameters,
       FMaterialParameterInfo("normalTexture", association, index),
       loadResult.normalTexture.Get());
   bool hasEmissiveTexture = applyTexture(
       model,
-      pMaterial,
+      parameters,
       FMaterialParameterInfo("emissiveTexture", association, index),
       loadResult.emissiveTexture.Get());
   applyTexture(
       model,
-      pMaterial,
+      parameters,
       FMaterialParameterInfo("occlusionTexture", association, index),
       loadResult.occlusionTexture.Get());
 
@@ -2449,7 +3935,7 @@ static void SetGltfParameterValues(
     if (textureTransform.status() == KhrTextureTransformStatus::Valid) {
       const glm::dvec2& scale = textureTransform.scale();
       const glm::dvec2& offset = textureTransform.offset();
-      pMaterial->SetVectorParameterValueByInfo(
+      parameters.setVector(
           FMaterialParameterInfo("baseColorScaleOffset", association, index),
           FLinearColor(scale[0], scale[1], offset[0], offset[1]));
 
@@ -2471,7 +3957,7 @@ static void SetGltfParameterValues(
     if (textureTransform.status() == KhrTextureTransformStatus::Valid) {
       const glm::dvec2& scale = textureTransform.scale();
       const glm::dvec2& offset = textureTransform.offset();
-      pMaterial->SetVectorParameterValueByInfo(
+      parameters.setVector(
           FMaterialParameterInfo(
               "metallicRoughnessScaleOffset",
               association,
@@ -2486,7 +3972,7 @@ static void SetGltfParameterValues(
   }
 
   if (pBaseColorTextureTransform || pMetallicRoughnessTextureTransform) {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo(
             "baseColorMetallicRoughnessRotation",
             association,
@@ -2506,7 +3992,7 @@ static void SetGltfParameterValues(
     textureTransform = KhrTextureTransform(*pEmissiveTextureTransform);
     const glm::dvec2& scale = textureTransform.scale();
     const glm::dvec2& offset = textureTransform.offset();
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("emissiveScaleOffset", association, index),
         FLinearColor(scale[0], scale[1], offset[0], offset[1]));
 
@@ -2525,7 +4011,7 @@ static void SetGltfParameterValues(
     textureTransform = KhrTextureTransform(*pNormalTextureTransform);
     const glm::dvec2& scale = textureTransform.scale();
     const glm::dvec2& offset = textureTransform.offset();
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("normalScaleOffset", association, index),
         FLinearColor(scale[0], scale[1], offset[0], offset[1]));
     const glm::dvec2& rotationSineCosine =
@@ -2535,7 +4021,7 @@ static void SetGltfParameterValues(
   }
 
   if (pEmissiveTextureTransform || pNormalTextureTransform) {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("emissiveNormalRotation", association, index),
         emissiveNormalRotation);
   }
@@ -2550,13 +4036,13 @@ static void SetGltfParameterValues(
     textureTransform = KhrTextureTransform(*pOcclusionTransform);
     const glm::dvec2& scale = textureTransform.scale();
     const glm::dvec2& offset = textureTransform.offset();
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("occlusionScaleOffset", association, index),
         FLinearColor(scale[0], scale[1], offset[0], offset[1]));
 
     const glm::dvec2& rotationSineCosine =
         textureTransform.rotationSineCosine();
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("occlusionRotation", association, index),
         FLinearColor(
             float(rotationSineCosine[0]),
@@ -2566,7 +4052,7 @@ static void SetGltfParameterValues(
   }
 
   if (material.emissiveFactor.size() >= 3) {
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("emissiveFactor", association, index),
         FVector(
             material.emissiveFactor[0],
@@ -2576,7 +4062,7 @@ static void SetGltfParameterValues(
     // When we have an emissive texture but not a factor, we need to use a
     // factor of vec3(1.0). The default, vec3(0.0), would disable the emission
     // from the texture.
-    pMaterial->SetVectorParameterValueByInfo(
+    parameters.setVector(
         FMaterialParameterInfo("emissiveFactor", association, index),
         FVector(1.0f, 1.0f, 1.0f));
   }
@@ -2585,25 +4071,25 @@ static void SetGltfParameterValues(
 void SetWaterParameterValues(
     CesiumGltf::Model& model,
     LoadPrimitiveResult& loadResult,
-    UMaterialInstanceDynamic* pMaterial,
+    CesiumMaterialParameters& parameters,
     EMaterialParameterAssociation association,
     int32 index) {
-  pMaterial->SetScalarParameterValueByInfo(
+  parameters.setScalar(
       FMaterialParameterInfo("OnlyLand", association, index),
       static_cast<float>(loadResult.onlyLand));
-  pMaterial->SetScalarParameterValueByInfo(
+  parameters.setScalar(
       FMaterialParameterInfo("OnlyWater", association, index),
       static_cast<float>(loadResult.onlyWater));
 
   if (!loadResult.onlyLand && !loadResult.onlyWater) {
     applyTexture(
         model,
-        pMaterial,
+        parameters,
         FMaterialParameterInfo("WaterMask", association, index),
         loadResult.waterMaskTexture.Get());
   }
 
-  pMaterial->SetVectorParameterValueByInfo(
+  parameters.setVector(
       FMaterialParameterInfo("WaterMaskTranslationScale", association, index),
       FVector(
           loadResult.waterMaskTranslationX,
@@ -2614,24 +4100,17 @@ void SetWaterParameterValues(
 static void SetFeatureIdTextureParameterValues(
     const CesiumEncodedFeaturesMetadata::EncodedFeatureIdTexture&
         encodedFeatureIdTexture,
-    const FString& name,
+    const CesiumEncodedFeaturesMetadata::FeatureIdSetParameterNames& names,
     UMaterialInstanceDynamic* pMaterial,
     EMaterialParameterAssociation association,
     int32 index) {
   pMaterial->SetTextureParameterValueByInfo(
-      FMaterialParameterInfo(
-          FName(name + CesiumEncodedFeaturesMetadata::MaterialTextureSuffix),
-          association,
-          index),
+      FMaterialParameterInfo(names.texture, association, index),
       encodedFeatureIdTexture.pTexture->pTexture->getUnrealTexture());
 
   size_t numChannels = encodedFeatureIdTexture.channels.size();
   pMaterial->SetScalarParameterValueByInfo(
-      FMaterialParameterInfo(
-          FName(
-              name + CesiumEncodedFeaturesMetadata::MaterialNumChannelsSuffix),
-          association,
-          index),
+      FMaterialParameterInfo(names.numChannels, association, index),
       static_cast<float>(numChannels));
 
   std::vector<float> channelsAsFloats{0.0f, 0.0f, 0.0f, 0.0f};
@@ -2648,10 +4127,7 @@ static void SetFeatureIdTextureParameterValues(
   };
 
   pMaterial->SetVectorParameterValueByInfo(
-      FMaterialParameterInfo(
-          FName(name + CesiumEncodedFeaturesMetadata::MaterialChannelsSuffix),
-          association,
-          index),
+      FMaterialParameterInfo(names.channels, association, index),
       channels);
 
   if (!encodedFeatureIdTexture.textureTransform) {
@@ -2662,28 +4138,18 @@ static void SetFeatureIdTextureParameterValues(
   glm::dvec2 offset = encodedFeatureIdTexture.textureTransform->offset();
 
   pMaterial->SetVectorParameterValueByInfo(
-      FMaterialParameterInfo(
-          FName(
-              name +
-              CesiumEncodedFeaturesMetadata::MaterialTextureScaleOffsetSuffix),
-          association,
-          index),
+      FMaterialParameterInfo(names.textureScaleOffset, association, index),
       FLinearColor(scale[0], scale[1], offset[0], offset[1]));
 
   glm::dvec2 rotation =
       encodedFeatureIdTexture.textureTransform->rotationSineCosine();
   pMaterial->SetVectorParameterValueByInfo(
-      FMaterialParameterInfo(
-          FName(
-              name +
-              CesiumEncodedFeaturesMetadata::MaterialTextureRotationSuffix),
-          association,
-          index),
+      FMaterialParameterInfo(names.textureRotation, association, index),
       FLinearColor(rotation[0], rotation[1], 0.0f, 1.0f));
 }
 
 static void SetPropertyParameterValue(
-    const FString& name,
+    const FName& name,
     ECesiumEncodedMetadataType type,
     const FCesiumMetadataValue& value,
     const float defaultValue,
@@ -2692,7 +4158,7 @@ static void SetPropertyParameterValue(
     int32 index) {
   if (type == ECesiumEncodedMetadataType::Scalar) {
     pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(FName(name), association, index),
+        FMaterialParameterInfo(name, association, index),
         UCesiumMetadataValueBlueprintLibrary::GetFloat(value, defaultValue));
   } else if (
       type == ECesiumEncodedMetadataType::Vec2 ||
@@ -2703,7 +4169,7 @@ static void SetPropertyParameterValue(
         FVector4(defaultValue, defaultValue, defaultValue, defaultValue));
 
     pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo(FName(name), association, index),
+        FMaterialParameterInfo(name, association, index),
         FLinearColor(
             static_cast<float>(vector4Value.X),
             static_cast<float>(vector4Value.Y),
@@ -2712,6 +4178,69 @@ static void SetPropertyParameterValue(
   }
 }
 
+/**
+ * Sets the parameters that property table properties and property texture
+ * properties have in common.
+ */
+template <typename TEncodedProperty>
+static void SetPropertyTransformParameterValues(
+    const TEncodedProperty& encodedProperty,
+    UMaterialInstanceDynamic* pMaterial,
+    EMaterialParameterAssociation association,
+    int32 index) {
+  const CesiumEncodedFeaturesMetadata::PropertyParameterNames& names =
+      encodedProperty.parameterNames;
+
+  if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(encodedProperty.offset)) {
+    SetPropertyParameterValue(
+        names.offset,
+        encodedProperty.type,
+        encodedProperty.offset,
+        0.0f,
+        pMaterial,
+        association,
+        index);
+  }
+
+  if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(encodedProperty.scale)) {
+    SetPropertyParameterValue(
+        names.scale,
+        encodedProperty.type,
+        encodedProperty.scale,
+        1.0f,
+        pMaterial,
+        association,
+        index);
+  }
+
+  if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(encodedProperty.noData)) {
+    SetPropertyParameterValue(
+        names.noData,
+        encodedProperty.type,
+        encodedProperty.noData,
+        0.0f,
+        pMaterial,
+        association,
+        index);
+  }
+
+  if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
+          encodedProperty.defaultValue)) {
+    SetPropertyParameterValue(
+        names.defaultValue,
+        encodedProperty.type,
+        encodedProperty.defaultValue,
+        0.0f,
+        pMaterial,
+        association,
+        index);
+
+    pMaterial->SetScalarParameterValueByInfo(
+        FMaterialParameterInfo(names.hasValue, association, index),
+        encodedProperty.pTexture ? 1.0 : 0.0);
+  }
+}
+
 static void SetPropertyTableParameterValues(
     const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
         encodedPropertyTable,
@@ -2720,81 +4249,20 @@ static void SetPropertyTableParameterValues(
     int32 index) {
   for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty&
            encodedProperty : encodedPropertyTable.properties) {
-    FString fullPropertyName =
-        CesiumEncodedFeaturesMetadata::getMaterialNameForPropertyTableProperty(
-            encodedPropertyTable.name,
-            encodedProperty.name);
-
     if (encodedProperty.pTexture) {
       pMaterial->SetTextureParameterValueByInfo(
-          FMaterialParameterInfo(FName(fullPropertyName), association, index),
+          FMaterialParameterInfo(
+              encodedProperty.parameterNames.texture,
+              association,
+              index),
           encodedProperty.pTexture->pTexture->getUnrealTexture());
     }
 
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.offset)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyOffsetSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(encodedProperty.scale)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyScaleSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          1.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.noData)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyNoDataSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.defaultValue)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyDefaultValueSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-
-      FString hasValueName = fullPropertyName =
-          CesiumEncodedFeaturesMetadata::MaterialPropertyHasValueSuffix;
-      pMaterial->SetScalarParameterValueByInfo(
-          FMaterialParameterInfo(FName(hasValueName), association, index),
-          encodedProperty.pTexture ? 1.0 : 0.0);
-    }
+    SetPropertyTransformParameterValues(
+        encodedProperty,
+        pMaterial,
+        association,
+        index);
   }
 }
 
@@ -2806,94 +4274,28 @@ static void SetPropertyTextureParameterValues(
     int32 index) {
   for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTextureProperty&
            encodedProperty : encodedPropertyTexture.properties) {
-    FString fullPropertyName = CesiumEncodedFeaturesMetadata::
-        getMaterialNameForPropertyTextureProperty(
-            encodedPropertyTexture.name,
-            encodedProperty.name);
+    const CesiumEncodedFeaturesMetadata::PropertyParameterNames& names =
+        encodedProperty.parameterNames;
 
     if (encodedProperty.pTexture) {
       pMaterial->SetTextureParameterValueByInfo(
-          FMaterialParameterInfo(FName(fullPropertyName), association, index),
+          FMaterialParameterInfo(names.texture, association, index),
           encodedProperty.pTexture->pTexture->getUnrealTexture());
     }
 
     pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo(
-            FName(
-                fullPropertyName +
-                CesiumEncodedFeaturesMetadata::MaterialChannelsSuffix),
-            association,
-            index),
+        FMaterialParameterInfo(names.channels, association, index),
         FLinearColor(
             encodedProperty.channels[0],
             encodedProperty.channels[1],
             encodedProperty.channels[2],
             encodedProperty.channels[3]));
 
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.offset)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyOffsetSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(encodedProperty.scale)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyScaleSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          1.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.noData)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyNoDataSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-    }
-
-    if (!UCesiumMetadataValueBlueprintLibrary::IsEmpty(
-            encodedProperty.defaultValue)) {
-      FString parameterName =
-          fullPropertyName +
-          CesiumEncodedFeaturesMetadata::MaterialPropertyDefaultValueSuffix;
-      SetPropertyParameterValue(
-          parameterName,
-          encodedProperty.type,
-          encodedProperty.offset,
-          0.0f,
-          pMaterial,
-          association,
-          index);
-
-      FString hasValueName = fullPropertyName =
-          CesiumEncodedFeaturesMetadata::MaterialPropertyHasValueSuffix;
-      pMaterial->SetScalarParameterValueByInfo(
-          FMaterialParameterInfo(FName(hasValueName), association, index),
-          encodedProperty.pTexture ? 1.0 : 0.0);
-    }
+    SetPropertyTransformParameterValues(
+        encodedProperty,
+        pMaterial,
+        association,
+        index);
 
     if (!encodedProperty.textureTransform) {
       continue;
@@ -2903,24 +4305,30 @@ static void SetPropertyTextureParameterValues(
     glm::dvec2 offset = encodedProperty.textureTransform->offset();
 
     pMaterial->SetVectorParameterValueByInfo(
-        FMaterialParameterInfo(
-            FName(
-                fullPropertyName + CesiumEncodedFeaturesMetadata::
-                                       MaterialTextureScaleOffsetSuffix),
-            association,
-            index),
+        FMaterialParameterInfo(names.textureScaleOffset, association, index),
         FLinearColor(scale[0], scale[1], offset[0], offset[1]));
 
     glm::dvec2 rotation =
         encodedProperty.textureTransform->rotationSineCosine();
     pMaterial->SetVectorParameterValueByInfo(
+        FMaterialParameterInfo(names.textureRotation, association, index),
+        FLinearColor(rotation[0], rotation[1], 0.0f, 1.0f));
+  }
+}
+
+static void SetFeatureStateParameterValues(
+    const UCesiumGltfComponent& gltfComponent,
+    UMaterialInstanceDynamic* pMaterial,
+    EMaterialParameterAssociation association,
+    int32 index) {
+  for (const TPair<int32, FCesiumFeatureStateTexture>& featureState :
+       gltfComponent.GetFeatureStates()) {
+    pMaterial->SetTextureParameterValueByInfo(
         FMaterialParameterInfo(
-            FName(
-                fullPropertyName +
-                CesiumEncodedFeaturesMetadata::MaterialTextureRotationSuffix),
+            featureState.Value.ParameterName,
             association,
             index),
-        FLinearColor(rotation[0], rotation[1], 0.0f, 1.0f));
+        featureState.Value.Texture);
   }
 }
 
@@ -2946,14 +4354,10 @@ static void SetFeaturesMetadataParameterValues(
   if (encodePrimitiveFeaturesGameThreadPart(loadResult.EncodedFeatures)) {
     for (CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet&
              encodedFeatureIdSet : loadResult.EncodedFeatures.featureIdSets) {
-      FString SafeName = CesiumEncodedFeaturesMetadata::createHlslSafeName(
-          encodedFeatureIdSet.name);
       if (encodedFeatureIdSet.nullFeatureId) {
         pMaterial->SetScalarParameterValueByInfo(
             FMaterialParameterInfo(
-                FName(
-                    SafeName +
-                    CesiumEncodedFeaturesMetadata::MaterialNullFeatureIdSuffix),
+                encodedFeatureIdSet.parameterNames.nullFeatureId,
                 association,
                 index),
             static_cast<float>(*encodedFeatureIdSet.nullFeatureId));
@@ -2962,7 +4366,7 @@ static void SetFeaturesMetadataParameterValues(
       if (encodedFeatureIdSet.texture) {
         SetFeatureIdTextureParameterValues(
             *encodedFeatureIdSet.texture,
-            SafeName,
+            encodedFeatureIdSet.parameterNames,
             pMaterial,
             association,
             index);
@@ -2987,6 +4391,8 @@ static void SetFeaturesMetadataParameterValues(
           index);
     }
   }
+
+  SetFeatureStateParameterValues(gltfComponent, pMaterial, association, index);
 }
 
 static void SetMetadataFeatureTableParameterValues_DEPRECATED(
@@ -3148,6 +4554,35 @@ static void SetMetadataParameterValues_DEPRECATED(
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 #pragma endregion
 
+// Whether the instances of a primitive can be drawn by a batch that is shared
+// with the primitives of other tiles. Nothing may give its material values
+// that differ from tile to tile.
+static bool canMergeInstances(
+    const LoadPrimitiveResult& loadResult,
+    const ACesium3DTileset& tilesetActor) {
+  if (!tilesetActor.GetMergeInstancedMeshes() ||
+      loadResult.instanceGeometryHash == 0 || !loadResult.Clusters.IsEmpty() ||
+      loadResult.Voxels ||
+      !loadResult.EncodedFeatures.featureIdSets.IsEmpty() ||
+      !loadResult.EncodedMetadata.propertyTextureIndices.IsEmpty()) {
+    return false;
+  }
+
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  if (loadResult.EncodedMetadata_DEPRECATED) {
+    return false;
+  }
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+
+  if (tilesetActor.FindComponentByClass<UCesiumRasterOverlay>()) {
+    return false;
+  }
+
+  const UCesiumPolygonClippingComponent* pClipping =
+      tilesetActor.FindComponentByClass<UCesiumPolygonClippingComponent>();
+  return !pClipping || !pClipping->IsActive();
+}
+
 static void loadPrimitiveGameThreadPart(
     CesiumGltf::Model& model,
     UCesiumGltfComponent* pGltf,
@@ -3156,7 +4591,7 @@ static void loadPrimitiveGameThreadPart(
     const Cesium3DTilesSelection::Tile& tile,
     bool createNavCollision,
     ACesium3DTileset* pTilesetActor,
-    const std::vector<FTransform>& instanceTransforms) {
+    const TArray<FTransform>& instanceTransforms) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
 
 #if DEBUG_GLTF_ASSET_NAMES
@@ -3168,71 +4603,8 @@ static void loadPrimitiveGameThreadPart(
   const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
       tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
 
-  UStaticMeshComponent* pMesh = nullptr;
-  ICesiumPrimitive* pCesiumPrimitive = nullptr;
-  if (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS) {
-    UCesiumGltfPointsComponent* pPointMesh =
-        NewObject<UCesiumGltfPointsComponent>(pGltf, componentName);
-    pPointMesh->UsesAdditiveRefinement =
-        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
-    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
-    pPointMesh->Dimensions = loadResult.dimensions;
-    pMesh = pPointMesh;
-    pCesiumPrimitive = pPointMesh;
-  } else if (!instanceTransforms.empty()) {
-    auto* pInstancedComponent =
-        NewObject<UCesiumGltfInstancedComponent>(pGltf, componentName);
-    pMesh = pInstancedComponent;
-    for (const FTransform& transform : instanceTransforms) {
-      pInstancedComponent->AddInstance(transform, false);
-    }
-    pCesiumPrimitive = pInstancedComponent;
-  } else {
-    auto* pComponent =
-        NewObject<UCesiumGltfPrimitiveComponent>(pGltf, componentName);
-    pMesh = pComponent;
-    pCesiumPrimitive = pComponent;
-  }
-  CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
-
-  UStaticMesh* pStaticMesh;
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMesh)
-    primData.pTilesetActor = pTilesetActor;
-    primData.overlayTextureCoordinateIDToUVIndex =
-        loadResult.overlayTextureCoordinateIDToUVIndex;
-    primData.GltfToUnrealTexCoordMap =
-        std::move(loadResult.GltfToUnrealTexCoordMap);
-    primData.TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
-    primData.PositionAccessor = std::move(loadResult.PositionAccessor);
-    primData.IndexAccessor = std::move(loadResult.IndexAccessor);
-    primData.HighPrecisionNodeTransform = loadResult.transform;
-    pCesiumPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
-    pMesh->bUseDefaultCollision = false;
-    pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
-    pMesh->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    primData.pModel = loadResult.pModel;
-    primData.pMeshPrimitive = loadResult.pMeshPrimitive;
-    primData.boundingVolume = boundingVolume;
-    pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
-    pMesh->SetCustomDepthStencilWriteMask(
-        pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
-    pMesh->SetCustomDepthStencilValue(
-        pGltf->CustomDepthParameters.CustomDepthStencilValue);
-    if (loadResult.isUnlit) {
-      pMesh->bCastDynamicShadow = false;
-    }
-
-    pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
-    pMesh->SetStaticMesh(pStaticMesh);
-
-    pStaticMesh->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    pStaticMesh->NeverStream = true;
-
-    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
-  }
+  CesiumPrimitiveComponentPool& componentPool =
+      pTilesetActor->GetPrimitiveComponentPool();
 
   const Material& material =
       loadResult.pMaterial ? *loadResult.pMaterial : defaultMaterial;
@@ -3267,35 +4639,33 @@ static void loadPrimitiveGameThreadPart(
   }
 #endif
 
-  UMaterialInstanceDynamic* pMaterial;
+  // Collect the glTF material's parameters first, so that the material
+  // instance can be created from a cached template with the same values, and
+  // so that instances can be merged with those of other tiles that have the
+  // same mesh and the same values.
+  CesiumMaterialParameters parameters;
+  UCesiumMaterialUserData* pCesiumData;
   {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMaterial)
-
-    pMaterial = UMaterialInstanceDynamic::Create(
-        pBaseMaterial,
-        nullptr,
-        ImportedSlotName);
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectMaterialParameters)
 
-    pMaterial->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
     SetGltfParameterValues(
         model,
         loadResult,
         material,
         pbr,
-        pMaterial,
+        parameters,
         EMaterialParameterAssociation::GlobalParameter,
         INDEX_NONE);
     SetWaterParameterValues(
         model,
         loadResult,
-        pMaterial,
+        parameters,
         EMaterialParameterAssociation::GlobalParameter,
         INDEX_NONE);
 
     UMaterialInstance* pBaseAsMaterialInstance =
         Cast<UMaterialInstance>(pBaseMaterial);
-    UCesiumMaterialUserData* pCesiumData =
+    pCesiumData =
         pBaseAsMaterialInstance
             ? pBaseAsMaterialInstance
                   ->GetAssetUserData<UCesiumMaterialUserData>()
@@ -3330,7 +4700,7 @@ static void loadPrimitiveGameThreadPart(
           loadResult,
           material,
           pbr,
-          pMaterial,
+          parameters,
           EMaterialParameterAssociation::LayerParameter,
           0);
 
@@ -3338,13 +4708,13 @@ static void loadPrimitiveGameThreadPart(
       // are off.
       int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
       if (fadeLayerIndex >= 0) {
-        pMaterial->SetScalarParameterValueByInfo(
+        parameters.setScalar(
             FMaterialParameterInfo(
                 "FadePercentage",
                 EMaterialParameterAssociation::LayerParameter,
                 fadeLayerIndex),
             1.0f);
-        pMaterial->SetScalarParameterValueByInfo(
+        parameters.setScalar(
             FMaterialParameterInfo(
                 "FadingType",
                 EMaterialParameterAssociation::LayerParameter,
@@ -3358,15 +4728,180 @@ static void loadPrimitiveGameThreadPart(
         SetWaterParameterValues(
             model,
             loadResult,
-            pMaterial,
+            parameters,
             EMaterialParameterAssociation::LayerParameter,
             waterIndex);
       }
+    }
+  }
 
-      int32 featuresMetadataIndex =
-          pCesiumData->LayerNames.Find("FeaturesMetadata");
-      int32 metadataIndex = pCesiumData->LayerNames.Find("Metadata");
-      if (featuresMetadataIndex >= 0) {
+  // Instances that can be merged across tiles are added to the batch of their
+  // mesh and material, if another tile has created it already.
+  uint64 instanceBatchKey = 0;
+  if (!instanceTransforms.IsEmpty() &&
+      loadResult.pMeshPrimitive->mode != MeshPrimitive::Mode::POINTS &&
+      canMergeInstances(loadResult, *pTilesetActor)) {
+    instanceBatchKey = CesiumInstanceBatches::computeKey(
+        loadResult.instanceGeometryHash,
+        pBaseMaterial,
+        parameters);
+    if (pTilesetActor->GetInstanceBatches().addToBatch(
+            instanceBatchKey,
+            *pGltf,
+            loadResult.transform,
+            cesiumToUnrealTransform,
+            instanceTransforms)) {
+      return;
+    }
+  }
+
+  UStaticMeshComponent* pMesh = nullptr;
+  ICesiumPrimitive* pCesiumPrimitive = nullptr;
+  if (loadResult.GaussianSplats) {
+    auto* pSplatComponent =
+        componentPool.acquire<UCesiumGltfGaussianSplatComponent>(
+            pGltf,
+            componentName);
+    pSplatComponent->Splats = MoveTemp(loadResult.GaussianSplats);
+    pMesh = pSplatComponent;
+    pCesiumPrimitive = pSplatComponent;
+  } else if (loadResult.TerrainHeightmap) {
+    auto* pTerrainComponent =
+        componentPool.acquire<UCesiumGltfTerrainHeightmapComponent>(
+            pGltf,
+            componentName);
+    pTerrainComponent->Heightmap = MoveTemp(loadResult.TerrainHeightmap);
+    pMesh = pTerrainComponent;
+    pCesiumPrimitive = pTerrainComponent;
+  } else if (loadResult.Voxels) {
+    auto* pVoxelComponent =
+        componentPool.acquire<UCesiumGltfVoxelComponent>(pGltf, componentName);
+    pVoxelComponent->Brick = MoveTemp(loadResult.Voxels);
+    pMesh = pVoxelComponent;
+    pCesiumPrimitive = pVoxelComponent;
+  } else if (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS) {
+    UCesiumGltfPointsComponent* pPointMesh =
+        componentPool.acquire<UCesiumGltfPointsComponent>(pGltf, componentName);
+    pPointMesh->UsesAdditiveRefinement =
+        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
+    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
+    pPointMesh->Dimensions = loadResult.dimensions;
+    pPointMesh->QuantizedPositions = loadResult.QuantizedPointPositions;
+    pPointMesh->QuantizedPositionOffset = loadResult.QuantizedPointOffset;
+    pPointMesh->QuantizedPositionScale = loadResult.QuantizedPointScale;
+    pMesh = pPointMesh;
+    pCesiumPrimitive = pPointMesh;
+  } else if (!instanceTransforms.IsEmpty()) {
+    auto* pInstancedComponent =
+        componentPool.acquire<UCesiumGltfInstancedComponent>(
+            pGltf,
+            componentName);
+    pMesh = pInstancedComponent;
+    // The component isn't registered yet, so adding the instances doesn't
+    // update any render or physics state. Adding them all at once also
+    // reserves the instance data once, and marks the component dirty once.
+    pInstancedComponent->AddInstances(instanceTransforms, false);
+    pCesiumPrimitive = pInstancedComponent;
+  } else {
+    auto* pComponent =
+        componentPool.acquire<UCesiumGltfPrimitiveComponent>(
+            pGltf,
+            componentName);
+    pMesh = pComponent;
+    pCesiumPrimitive = pComponent;
+  }
+  CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
+
+  UStaticMesh* pStaticMesh;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMesh)
+    primData.pTilesetActor = pTilesetActor;
+    primData.overlayTextureCoordinateIDToUVIndex =
+        loadResult.overlayTextureCoordinateIDToUVIndex;
+    primData.GltfToUnrealTexCoordMap =
+        std::move(loadResult.GltfToUnrealTexCoordMap);
+    primData.TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
+    primData.PositionAccessor = std::move(loadResult.PositionAccessor);
+    primData.IndexAccessor = std::move(loadResult.IndexAccessor);
+    primData.Clusters = MoveTemp(loadResult.Clusters);
+    primData.pTraceMesh = MoveTemp(loadResult.pTraceMesh);
+    primData.pFeatureIndex = MoveTemp(loadResult.pFeatureIndex);
+    primData.HighPrecisionNodeTransform = loadResult.transform;
+    pCesiumPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
+    pMesh->bUseDefaultCollision = false;
+    pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+    pMesh->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    primData.pModel = loadResult.pModel;
+    primData.pMeshPrimitive = loadResult.pMeshPrimitive;
+    primData.boundingVolume = boundingVolume;
+    // Eye-dome lighting finds the point clouds by their custom depth.
+    pMesh->SetRenderCustomDepth(
+        pGltf->CustomDepthParameters.RenderCustomDepth ||
+        (loadResult.pMeshPrimitive->mode == MeshPrimitive::Mode::POINTS &&
+         pTilesetActor->GetPointCloudShading().EyeDomeLighting));
+    pMesh->SetCustomDepthStencilWriteMask(
+        pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
+    pMesh->SetCustomDepthStencilValue(
+        pGltf->CustomDepthParameters.CustomDepthStencilValue);
+    if (loadResult.isUnlit) {
+      pMesh->bCastDynamicShadow = false;
+    }
+    pMesh->bVisibleInRayTracing =
+        pGltf->GetRayTracing() != ECesiumGltfRayTracing::None;
+    // The meshes of instances may be shared by the batches of several tiles,
+    // so only other primitives are culled by their size on screen. The
+    // distance is set even when it is zero, for pooled components.
+    if (pTilesetActor && instanceTransforms.IsEmpty()) {
+      const glm::dvec3 size = glm::dvec3(
+          cesiumToUnrealTransform *
+          glm::dvec4(glm::dvec3(loadResult.dimensions), 0.0));
+      pMesh->SetCullDistance(static_cast<float>(
+          pTilesetActor->ComputePrimitiveCullDistance(glm::length(size))));
+    }
+    if (pTilesetActor) {
+      pMesh->RuntimeVirtualTextures = pTilesetActor->RuntimeVirtualTextures;
+      pMesh->VirtualTextureRenderPassType =
+          pTilesetActor->VirtualTextureRenderPassType;
+      pMesh->ShadowCacheInvalidationBehavior =
+          pTilesetActor->ShadowCacheInvalidationBehavior;
+    }
+
+    pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
+    pMesh->SetStaticMesh(pStaticMesh);
+
+    pStaticMesh->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pStaticMesh->NeverStream = true;
+
+    // Ray tracing geometry would be built from the placeholder positions of
+    // quantized points, of terrain heightmaps, and of voxels.
+    if (loadResult.QuantizedPointPositions ||
+        pMesh->IsA<UCesiumGltfTerrainHeightmapComponent>() ||
+        pMesh->IsA<UCesiumGltfVoxelComponent>()) {
+      pStaticMesh->bSupportRayTracing = false;
+    }
+
+    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+  }
+
+  UMaterialInstanceDynamic* pMaterial;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMaterial)
+
+    pMaterial =
+        pTilesetActor->GetMaterialInstanceCache().createMaterialInstance(
+            pBaseMaterial,
+            ImportedSlotName,
+            parameters);
+    pMaterial->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+
+    if (pCesiumData) {
+      int32 featuresMetadataIndex =
+          pCesiumData->LayerNames.Find("FeaturesMetadata");
+      int32 metadataIndex = pCesiumData->LayerNames.Find("Metadata");
+      if (featuresMetadataIndex >= 0) {
         SetFeaturesMetadataParameterValues(
             model,
             *pGltf,
@@ -3385,6 +4920,46 @@ static void loadPrimitiveGameThreadPart(
             metadataIndex);
       }
     }
+
+    const UCesiumPolygonClippingComponent* pClipping =
+        pTilesetActor->FindComponentByClass<UCesiumPolygonClippingComponent>();
+    if (pClipping && pClipping->IsActive()) {
+      pClipping->SetMaterialParameterValues(pMaterial, pCesiumData);
+    }
+  }
+
+  {
+    FCesiumMemoryUsage geometry;
+    geometry.VertexBytes = int64(loadResult.vertexBytes);
+    geometry.IndexBytes = int64(loadResult.indexBytes);
+    geometry.CollisionBytes = int64(loadResult.collisionBytes);
+    geometry.MaterialBytes = int64(
+        pMaterial->GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+
+    std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*>
+        textures;
+    for (const CesiumTextureUtility::LoadedTextureResult* pTexture :
+         {loadResult.baseColorTexture.Get(),
+          loadResult.metallicRoughnessTexture.Get(),
+          loadResult.normalTexture.Get(),
+          loadResult.emissiveTexture.Get(),
+          loadResult.occlusionTexture.Get(),
+          loadResult.waterMaskTexture.Get()}) {
+      if (pTexture) {
+        textures.emplace_back(pTexture->pTexture.get());
+      }
+    }
+    for (const CesiumEncodedFeaturesMetadata::EncodedFeatureIdSet& set :
+         loadResult.EncodedFeatures.featureIdSets) {
+      if (set.texture && set.texture->pTexture) {
+        textures.emplace_back(set.texture->pTexture->pTexture.get());
+      }
+    }
+
+    pTilesetActor->GetMemoryUsageTracker().addPrimitive(
+        pGltf,
+        geometry,
+        textures);
   }
 
   primData.Features = std::move(loadResult.Features);
@@ -3416,11 +4991,6 @@ static void loadPrimitiveGameThreadPart(
 
   pStaticMesh->SetLightingGuid();
 
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitResources)
-    pStaticMesh->InitResources();
-  }
-
   // Set up RenderData bounds and LOD data
   pStaticMesh->CalculateExtendedBounds();
   pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
@@ -3437,11 +5007,7 @@ static void loadPrimitiveGameThreadPart(
         ECollisionTraceFlag::CTF_UseComplexAsSimple;
 
     if (loadResult.pCollisionMesh) {
-#if ENGINE_VERSION_5_4_OR_HIGHER
-      pBodySetup->TriMeshGeometries.Add(loadResult.pCollisionMesh);
-#else
-      pBodySetup->ChaosTriMeshes.Add(loadResult.pCollisionMesh);
-#endif
+      CesiumPhysicsMeshes::addMesh(*pBodySetup, loadResult.pCollisionMesh);
     }
 
     // Mark physics meshes created, no matter if we actually have a collision
@@ -3459,11 +5025,41 @@ static void loadPrimitiveGameThreadPart(
 
   pMesh->SetMobility(pGltf->Mobility);
 
+  // When the tileset manages navigation, it decides later whether the mesh
+  // affects navigation, so that the mesh isn't added to the navigation octree
+  // as soon as it is registered.
+  pMesh->SetCanEverAffectNavigation(
+      !pTilesetActor || !pTilesetActor->IsNavigationManaged());
+
   pMesh->SetupAttachment(pGltf);
 
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RegisterComponent)
-    pMesh->RegisterComponent();
+  if (instanceBatchKey != 0) {
+    // The batch of instances below needs the mesh's render resources right
+    // away.
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitResources)
+      pStaticMesh->InitResources();
+    }
+    {
+      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RegisterComponent)
+      pMesh->RegisterComponent();
+    }
+  } else {
+    // The render resources are created along with those of the other tiles
+    // that finish loading in the same frame.
+    CesiumMeshResourceBatch::initResourcesAndRegister(*pStaticMesh, *pMesh);
+  }
+
+  // This is the first primitive with its mesh and material, so it starts the
+  // batch that the same instanced mesh in other tiles is added to.
+  if (instanceBatchKey != 0) {
+    pTilesetActor->GetInstanceBatches().createBatch(
+        instanceBatchKey,
+        *pGltf,
+        *CastChecked<UInstancedStaticMeshComponent>(pMesh),
+        loadResult.transform,
+        cesiumToUnrealTransform,
+        instanceTransforms);
   }
 }
 
@@ -3496,7 +5092,8 @@ UCesiumGltfComponent::CreateOffGameThread(
     UMaterialInterface* pBaseWaterMaterial,
     FCustomDepthParameters CustomDepthParameters,
     const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision) {
+    bool createNavCollision,
+    double timeLimitMilliseconds) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadModel)
 
   HalfConstructedReal* pReal =
@@ -3513,7 +5110,9 @@ UCesiumGltfComponent::CreateOffGameThread(
   Gltf->SetFlags(RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
 
   Gltf->Metadata = std::move(pReal->loadModelResult.Metadata);
+  Gltf->Metadata.setModel(model);
   Gltf->EncodedMetadata = std::move(pReal->loadModelResult.EncodedMetadata);
+  Gltf->_pModel = &model;
   Gltf->EncodedMetadata_DEPRECATED =
       std::move(pReal->loadModelResult.EncodedMetadata_DEPRECATED);
 
@@ -3531,30 +5130,36 @@ UCesiumGltfComponent::CreateOffGameThread(
 
   Gltf->CustomDepthParameters = CustomDepthParameters;
 
+  // The tileset decides when it's worth building the BLAS of the tile.
+  if (pTilesetActor->IsRayTracingManaged()) {
+    Gltf->_rayTracing = ECesiumGltfRayTracing::None;
+  }
+
   encodeModelMetadataGameThreadPart(Gltf->EncodedMetadata);
 
+  std::vector<ReferenceCountedUnrealTexture*> propertyTableTextures;
+  for (const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+           propertyTable : Gltf->EncodedMetadata.propertyTables) {
+    addPropertyTableTextures(propertyTable, propertyTableTextures);
+  }
+  pTilesetActor->GetMemoryUsageTracker().addEncodedTextures(
+      Gltf,
+      propertyTableTextures);
+
   if (Gltf->EncodedMetadata_DEPRECATED) {
     encodeMetadataGameThreadPart(*Gltf->EncodedMetadata_DEPRECATED);
   }
 
-  for (LoadNodeResult& node : pReal->loadModelResult.nodeResults) {
-    if (node.meshResult) {
-      for (LoadPrimitiveResult& primitive : node.meshResult->primitiveResults) {
-        loadPrimitiveGameThreadPart(
-            model,
-            Gltf,
-            primitive,
-            cesiumToUnrealTransform,
-            tile,
-            createNavCollision,
-            pTilesetActor,
-            node.InstanceTransforms);
-      }
-    }
-  }
+  auto pBuild = MakeUnique<IncrementalBuild>();
+  pBuild->pHalfConstructed = std::move(pHalfConstructed);
+  pBuild->pModel = &model;
+  pBuild->pTile = &tile;
+  pBuild->pTilesetActor = pTilesetActor;
+  pBuild->cesiumToUnrealTransform = cesiumToUnrealTransform;
+  pBuild->createNavCollision = createNavCollision;
+  Gltf->_pPendingBuild = std::move(pBuild);
 
-  Gltf->SetVisibility(false, true);
-  Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  Gltf->ContinueBuild(timeLimitMilliseconds);
   return Gltf;
 }
 
@@ -3594,6 +5199,14 @@ UCesiumGltfComponent::~UCesiumGltfComponent() {
 
 void UCesiumGltfComponent::UpdateTransformFromCesium(
     const glm::dmat4& cesiumToUnrealTransform) {
+  IncrementalBuild* pBuild =
+      static_cast<IncrementalBuild*>(this->_pPendingBuild.Get());
+  if (pBuild) {
+    pBuild->cesiumToUnrealTransform = cesiumToUnrealTransform;
+  }
+
+  this->_pendingCesiumToUnrealTransform.reset();
+
   for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
     if (auto* pCesiumPrimitive = Cast<ICesiumPrimitive>(pSceneComponent)) {
       pCesiumPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
@@ -3601,37 +5214,269 @@ void UCesiumGltfComponent::UpdateTransformFromCesium(
   }
 }
 
+void UCesiumGltfComponent::UpdateTransformFromCesiumWhenVisible(
+    const glm::dmat4& cesiumToUnrealTransform) {
+  if (this->IsVisible()) {
+    this->UpdateTransformFromCesium(cesiumToUnrealTransform);
+    return;
+  }
+
+  // Primitives that are still to be created need the new transform, but
+  // moving the existing ones can wait until they're shown.
+  IncrementalBuild* pBuild =
+      static_cast<IncrementalBuild*>(this->_pPendingBuild.Get());
+  if (pBuild) {
+    pBuild->cesiumToUnrealTransform = cesiumToUnrealTransform;
+  }
+
+  this->_pendingCesiumToUnrealTransform = cesiumToUnrealTransform;
+}
+
+void UCesiumGltfComponent::ApplyPendingTransform() {
+  if (this->_pendingCesiumToUnrealTransform) {
+    this->UpdateTransformFromCesium(*this->_pendingCesiumToUnrealTransform);
+  }
+}
+
 namespace {
+template <typename Func>
+void forPrimitiveComponent(USceneComponent* pSceneComponent, Func&& f) {
+  UCesiumGltfPrimitiveComponent* pPrimitive =
+      Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
+  if (pPrimitive) {
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0));
+
+    if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
+      // Don't try to update the material while it's in the process of
+      // being destroyed. This can lead to the render thread freaking out
+      // when it's asked to update a parameter for a material that has
+      // been marked for garbage collection.
+      return;
+    }
+
+    UMaterialInterface* pBaseMaterial = pMaterial->Parent;
+    UMaterialInstance* pBaseAsMaterialInstance =
+        Cast<UMaterialInstance>(pBaseMaterial);
+    UCesiumMaterialUserData* pCesiumData =
+        pBaseAsMaterialInstance
+            ? pBaseAsMaterialInstance
+                  ->GetAssetUserData<UCesiumMaterialUserData>()
+            : nullptr;
+
+    f(pPrimitive, pMaterial, pCesiumData);
+  }
+}
+
 template <typename Func>
 void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
   for (USceneComponent* pSceneComponent : pGltf->GetAttachChildren()) {
-    UCesiumGltfPrimitiveComponent* pPrimitive =
-        Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
-    if (pPrimitive) {
-      UMaterialInstanceDynamic* pMaterial =
-          Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0));
-
-      if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
-        // Don't try to update the material while it's in the process of
-        // being destroyed. This can lead to the render thread freaking out
-        // when it's asked to update a parameter for a material that has
-        // been marked for garbage collection.
+    forPrimitiveComponent(pSceneComponent, f);
+  }
+}
+
+/**
+ * Sets an overlay's texture array on a material, unless it is set already.
+ */
+void setRasterTextureArray(
+    UMaterialInstanceDynamic* pMaterial,
+    UCesiumMaterialUserData* pCesiumData,
+    CesiumRasterOverlayRendererData& overlayData) {
+  CesiumRasterOverlayTextureArray* pTextureArray =
+      overlayData.getTextureArray();
+  UTexture* pArrayTexture =
+      pTextureArray ? pTextureArray->getTexture() : nullptr;
+  if (!pArrayTexture) {
+    return;
+  }
+
+  auto setIfChanged = [pMaterial,
+                       pArrayTexture](const FMaterialParameterInfo& info) {
+    UTexture* pCurrent = nullptr;
+    if (!pMaterial->GetTextureParameterValue(
+            FHashedMaterialParameterInfo(info),
+            pCurrent,
+            true) ||
+        pCurrent != pArrayTexture) {
+      pMaterial->SetTextureParameterValueByInfo(info, pArrayTexture);
+    }
+  };
+
+  if (pCesiumData) {
+    for (int32 i : overlayData.getLayerIndices(*pCesiumData)) {
+      setIfChanged(FMaterialParameterInfo(
+          "TextureArray",
+          EMaterialParameterAssociation::LayerParameter,
+          i));
+    }
+  } else {
+    setIfChanged(
+        FMaterialParameterInfo(overlayData.getTextureArrayParameterName()));
+  }
+}
+
+/**
+ * Sets the parameters that a material needs to compute the texture
+ * coordinates of an overlay from the positions of a primitive's vertices.
+ */
+void setOverlayProjectionParameters(
+    const CesiumPrimitiveData& primData,
+    UMaterialInstanceDynamic* pMaterial,
+    UCesiumMaterialUserData* pCesiumData,
+    const CesiumRasterOverlayRendererData& overlayData,
+    const OverlayProjection& projection) {
+  // The rows of the transform from the vertex positions to ECEF.
+  static const FName rowNames[3] = {
+      "LocalToEcefRow0",
+      "LocalToEcefRow1",
+      "LocalToEcefRow2"};
+  const glm::dmat4& localToEcef = primData.HighPrecisionNodeTransform;
+  FVector4 rows[3];
+  for (int32 i = 0; i < 3; ++i) {
+    rows[i] = FVector4(
+        localToEcef[0][i],
+        localToEcef[1][i],
+        localToEcef[2][i],
+        localToEcef[3][i]);
+  }
+
+  if (pCesiumData) {
+    for (int32 i : overlayData.getLayerIndices(*pCesiumData)) {
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(
+              "ProjectionRectangle",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          projection.rectangle);
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(
+              "ProjectionEllipsoid",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          projection.ellipsoid);
+      for (int32 row = 0; row < 3; ++row) {
+        pMaterial->SetVectorParameterValueByInfo(
+            FMaterialParameterInfo(
+                rowNames[row],
+                EMaterialParameterAssociation::LayerParameter,
+                i),
+            rows[row]);
+      }
+    }
+  } else {
+    pMaterial->SetVectorParameterValue(
+        overlayData.getProjectionRectangleParameterName(),
+        projection.rectangle);
+    pMaterial->SetVectorParameterValue(
+        overlayData.getProjectionEllipsoidParameterName(),
+        projection.ellipsoid);
+    for (int32 row = 0; row < 3; ++row) {
+      pMaterial->SetVectorParameterValue(rowNames[row], rows[row]);
+    }
+  }
+}
+
+void attachRasterTileToPrimitive(
+    UCesiumGltfPrimitiveComponent* pPrimitive,
+    UMaterialInstanceDynamic* pMaterial,
+    UCesiumMaterialUserData* pCesiumData,
+    const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+    UTexture2D* pTexture,
+    const FVector4& translationAndScale,
+    int32 textureCoordinateID,
+    int32 textureArraySlice,
+    const OverlayProjection& projection) {
+  CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
+  const float textureCoordinateIndex = static_cast<float>(
+      primData.overlayTextureCoordinateIDToUVIndex[textureCoordinateID]);
+
+  CesiumRasterOverlayRendererData* pOverlayData =
+      CesiumRasterOverlayRendererData::get(rasterTile.getOverlay());
+  if (!pOverlayData) {
+    return;
+  }
+
+  if (textureCoordinateIndex < 0.0f) {
+    setOverlayProjectionParameters(
+        primData,
+        pMaterial,
+        pCesiumData,
+        *pOverlayData,
+        projection);
+  }
+
+  const int32 customDataIndex =
+      pOverlayData->getOptions()->customPrimitiveDataIndex;
+  if (customDataIndex >= 0) {
+    // The material reads everything but the texture from the primitive's
+    // custom data, which doesn't require a material parameter update.
+    pPrimitive->SetCustomPrimitiveDataVector4(
+        customDataIndex,
+        translationAndScale);
+    pPrimitive->SetCustomPrimitiveDataFloat(
+        customDataIndex + 4,
+        textureCoordinateIndex);
+
+    if (pOverlayData->usesTextureArray()) {
+      pPrimitive->SetCustomPrimitiveDataFloat(
+          customDataIndex + 5,
+          static_cast<float>(textureArraySlice));
+    }
+  }
+
+  if (textureArraySlice >= 0) {
+    // The tile is in the overlay's texture array, so no texture needs to be
+    // bound once the array is.
+    setRasterTextureArray(pMaterial, pCesiumData, *pOverlayData);
+    return;
+  }
+
+  // If this material uses material layers and has the Cesium user data,
+  // set the parameters on each material layer that maps to this overlay
+  // tile.
+  if (pCesiumData) {
+    for (int32 i : pOverlayData->getLayerIndices(*pCesiumData)) {
+      pMaterial->SetTextureParameterValueByInfo(
+          FMaterialParameterInfo(
+              "Texture",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          pTexture);
+
+      if (customDataIndex >= 0) {
         continue;
       }
 
-      UMaterialInterface* pBaseMaterial = pMaterial->Parent;
-      UMaterialInstance* pBaseAsMaterialInstance =
-          Cast<UMaterialInstance>(pBaseMaterial);
-      UCesiumMaterialUserData* pCesiumData =
-          pBaseAsMaterialInstance
-              ? pBaseAsMaterialInstance
-                    ->GetAssetUserData<UCesiumMaterialUserData>()
-              : nullptr;
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(
+              "TranslationScale",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          translationAndScale);
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "TextureCoordinateIndex",
+              EMaterialParameterAssociation::LayerParameter,
+              i),
+          textureCoordinateIndex);
+    }
+  } else {
+    pMaterial->SetTextureParameterValue(
+        pOverlayData->getTextureParameterName(),
+        pTexture);
 
-      f(pPrimitive, pMaterial, pCesiumData);
+    if (customDataIndex >= 0) {
+      return;
     }
+
+    pMaterial->SetVectorParameterValue(
+        pOverlayData->getTranslationScaleParameterName(),
+        translationAndScale);
+    pMaterial->SetScalarParameterValue(
+        pOverlayData->getTextureCoordinateIndexParameterName(),
+        textureCoordinateIndex);
   }
-} // namespace
+}
 
 } // namespace
 
@@ -3641,64 +5486,47 @@ void UCesiumGltfComponent::AttachRasterTile(
     UTexture2D* pTexture,
     const glm::dvec2& translation,
     const glm::dvec2& scale,
-    int32 textureCoordinateID) {
+    int32 textureCoordinateID,
+    int32 textureArraySlice) {
   FVector4 translationAndScale(translation.x, translation.y, scale.x, scale.y);
+  const OverlayProjection projection =
+      getOverlayProjection(tile, textureCoordinateID);
+
+  IncrementalBuild* pBuild =
+      static_cast<IncrementalBuild*>(this->_pPendingBuild.Get());
+  if (pBuild) {
+    // Primitives that haven't been created yet will get this raster tile
+    // when they are.
+    pBuild->rasterAttachments.push_back(IncrementalBuild::RasterAttachment{
+        &rasterTile,
+        pTexture,
+        translationAndScale,
+        textureCoordinateID,
+        textureArraySlice,
+        projection});
+  }
 
   forEachPrimitiveComponent(
       this,
-      [&rasterTile, pTexture, &translationAndScale, textureCoordinateID](
+      [&rasterTile,
+       pTexture,
+       &translationAndScale,
+       textureCoordinateID,
+       textureArraySlice,
+       &projection](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
-        CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
-        // If this material uses material layers and has the Cesium user data,
-        // set the parameters on each material layer that maps to this overlay
-        // tile.
-        if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
-
-            pMaterial->SetTextureParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "Texture",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                pTexture);
-            pMaterial->SetVectorParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TranslationScale",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                translationAndScale);
-            pMaterial->SetScalarParameterValueByInfo(
-                FMaterialParameterInfo(
-                    "TextureCoordinateIndex",
-                    EMaterialParameterAssociation::LayerParameter,
-                    i),
-                static_cast<float>(primData.overlayTextureCoordinateIDToUVIndex
-                                       [textureCoordinateID]));
-          }
-        } else {
-          pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
-              pTexture);
-          pMaterial->SetVectorParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TranslationScale"),
-              translationAndScale);
-          pMaterial->SetScalarParameterValue(
-              createSafeName(
-                  rasterTile.getOverlay().getName(),
-                  "_TextureCoordinateIndex"),
-              static_cast<float>(primData.overlayTextureCoordinateIDToUVIndex
-                                     [textureCoordinateID]));
-        }
+        attachRasterTileToPrimitive(
+            pPrimitive,
+            pMaterial,
+            pCesiumData,
+            rasterTile,
+            pTexture,
+            translationAndScale,
+            textureCoordinateID,
+            textureArraySlice,
+            projection);
       });
 }
 
@@ -3706,23 +5534,47 @@ void UCesiumGltfComponent::DetachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture) {
+  IncrementalBuild* pBuild =
+      static_cast<IncrementalBuild*>(this->_pPendingBuild.Get());
+  if (pBuild) {
+    auto& attachments = pBuild->rasterAttachments;
+    attachments.erase(
+        std::remove_if(
+            attachments.begin(),
+            attachments.end(),
+            [&rasterTile, pTexture](
+                const IncrementalBuild::RasterAttachment& attachment) {
+              return attachment.pRasterTile == &rasterTile &&
+                     attachment.pTexture == pTexture;
+            }),
+        attachments.end());
+  }
+
   forEachPrimitiveComponent(
       this,
       [this, &rasterTile, pTexture](
           UCesiumGltfPrimitiveComponent* pPrimitive,
           UMaterialInstanceDynamic* pMaterial,
           UCesiumMaterialUserData* pCesiumData) {
+        CesiumRasterOverlayRendererData* pOverlayData =
+            CesiumRasterOverlayRendererData::get(rasterTile.getOverlay());
+        if (!pOverlayData) {
+          return;
+        }
+
+        if (!pTexture && pOverlayData->usesTextureArray()) {
+          // The tile was in the overlay's texture array, which stays bound.
+          pPrimitive->SetCustomPrimitiveDataFloat(
+              pOverlayData->getOptions()->customPrimitiveDataIndex + 5,
+              -1.0f);
+          return;
+        }
+
         // If this material uses material layers and has the Cesium user data,
         // clear the parameters on each material layer that maps to this
         // overlay tile.
         if (pCesiumData) {
-          FString name(
-              UTF8_TO_TCHAR(rasterTile.getOverlay().getName().c_str()));
-          for (int32 i = 0; i < pCesiumData->LayerNames.Num(); ++i) {
-            if (pCesiumData->LayerNames[i] != name) {
-              continue;
-            }
-
+          for (int32 i : pOverlayData->getLayerIndices(*pCesiumData)) {
             pMaterial->SetTextureParameterValueByInfo(
                 FMaterialParameterInfo(
                     "Texture",
@@ -3732,14 +5584,469 @@ void UCesiumGltfComponent::DetachRasterTile(
           }
         } else {
           pMaterial->SetTextureParameterValue(
-              createSafeName(rasterTile.getOverlay().getName(), "_Texture"),
+              pOverlayData->getTextureParameterName(),
               this->Transparent1x1);
         }
       });
 }
 
+bool UCesiumGltfComponent::ContinueBuild(double timeLimitMilliseconds) {
+  IncrementalBuild* pBuild =
+      static_cast<IncrementalBuild*>(this->_pPendingBuild.Get());
+  if (!pBuild) {
+    return true;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ContinueGltfBuild)
+
+  const double endTime =
+      FPlatformTime::Seconds() + timeLimitMilliseconds / 1000.0;
+
+  HalfConstructedReal* pReal =
+      static_cast<HalfConstructedReal*>(pBuild->pHalfConstructed.Get());
+  ArenaVector<LoadNodeResult>& nodes = pReal->loadModelResult.nodeResults;
+
+  while (pBuild->nodeIndex < nodes.size()) {
+    LoadNodeResult& node = nodes[pBuild->nodeIndex];
+    if (!node.meshResult ||
+        pBuild->primitiveIndex >= node.meshResult->primitiveResults.size()) {
+      ++pBuild->nodeIndex;
+      pBuild->primitiveIndex = 0;
+      continue;
+    }
+
+    const int32 firstNewChild = this->GetAttachChildren().Num();
+
+    loadPrimitiveGameThreadPart(
+        *pBuild->pModel,
+        this,
+        node.meshResult->primitiveResults[pBuild->primitiveIndex],
+        pBuild->cesiumToUnrealTransform,
+        *pBuild->pTile,
+        pBuild->createNavCollision,
+        pBuild->pTilesetActor,
+        node.InstanceTransforms);
+    ++pBuild->primitiveIndex;
+
+    const TArray<USceneComponent*>& children = this->GetAttachChildren();
+    for (int32 i = firstNewChild; i < children.Num(); ++i) {
+      for (const IncrementalBuild::RasterAttachment& attachment :
+           pBuild->rasterAttachments) {
+        forPrimitiveComponent(
+            children[i],
+            [&attachment](
+                UCesiumGltfPrimitiveComponent* pPrimitive,
+                UMaterialInstanceDynamic* pMaterial,
+                UCesiumMaterialUserData* pCesiumData) {
+              attachRasterTileToPrimitive(
+                  pPrimitive,
+                  pMaterial,
+                  pCesiumData,
+                  *attachment.pRasterTile,
+                  attachment.pTexture,
+                  attachment.translationAndScale,
+                  attachment.textureCoordinateID,
+                  attachment.textureArraySlice,
+                  attachment.projection);
+            });
+      }
+    }
+
+    if (timeLimitMilliseconds > 0.0 && FPlatformTime::Seconds() >= endTime) {
+      break;
+    }
+  }
+
+  // Keep the whole component hidden until the tileset decides to show it,
+  // which only happens once it is complete.
+  this->SetVisibility(false, true);
+  this->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+  if (pBuild->nodeIndex < nodes.size()) {
+    return false;
+  }
+
+  this->_pPendingBuild.Reset();
+  return true;
+}
+
+void UCesiumGltfComponent::CancelBuild() {
+  this->_pPendingBuild.Reset();
+  this->_pModel = nullptr;
+}
+
+bool UCesiumGltfComponent::EncodeMissingProperties(
+    const TArray<FCesiumPropertyTableDescription>& PropertyTables) {
+  if (!this->_pModel) {
+    return false;
+  }
+
+  // Only encode the properties that aren't encoded already.
+  FCesiumModelMetadataDescription missing;
+  for (const FCesiumPropertyTableDescription& propertyTable : PropertyTables) {
+    const CesiumEncodedFeaturesMetadata::EncodedPropertyTable* pEncoded =
+        this->EncodedMetadata.propertyTables.FindByPredicate(
+            [&propertyTable](
+                const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                    encodedPropertyTable) {
+              return encodedPropertyTable.name == propertyTable.Name;
+            });
+
+    FCesiumPropertyTableDescription* pMissing = nullptr;
+    for (const FCesiumPropertyTablePropertyDescription& property :
+         propertyTable.Properties) {
+      const FString name =
+          CesiumEncodedFeaturesMetadata::createHlslSafeName(property.Name);
+      if (pEncoded &&
+          pEncoded->properties.ContainsByPredicate(
+              [&name](const CesiumEncodedFeaturesMetadata::
+                          EncodedPropertyTableProperty& encodedProperty) {
+                return encodedProperty.name == name;
+              })) {
+        continue;
+      }
+
+      if (!pMissing) {
+        pMissing = &missing.PropertyTables.Emplace_GetRef();
+        pMissing->Name = propertyTable.Name;
+      }
+      pMissing->Properties.Add(property);
+    }
+  }
+
+  if (missing.PropertyTables.IsEmpty()) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EncodeMissingProperties)
+
+  CesiumEncodedFeaturesMetadata::EncodedModelMetadata encoded;
+  {
+    CesiumTextureUtility::AsyncTextureCreations textureCreations;
+    encoded = CesiumEncodedFeaturesMetadata::encodeModelMetadataAnyThreadPart(
+        missing,
+        this->Metadata,
+        this->_pModel);
+  }
+
+  bool encodedAny = false;
+  for (CesiumEncodedFeaturesMetadata::EncodedPropertyTable& propertyTable :
+       encoded.propertyTables) {
+    if (propertyTable.properties.IsEmpty() ||
+        !CesiumEncodedFeaturesMetadata::encodePropertyTableGameThreadPart(
+            propertyTable)) {
+      continue;
+    }
+
+    this->AddEncodedPropertyTable(MoveTemp(propertyTable));
+    encodedAny = true;
+  }
+
+  return encodedAny;
+}
+
+bool UCesiumGltfComponent::ApplyFeatureStyle(
+    const CesiumCompiledFeatureStyle& Style) {
+  if (!this->_pModel) {
+    return false;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ApplyFeatureStyle)
+
+  TArray<CesiumEncodedFeaturesMetadata::EncodedPropertyTable> encoded;
+  {
+    CesiumTextureUtility::AsyncTextureCreations textureCreations;
+    for (const FCesiumPropertyTable& propertyTable :
+         UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(
+             this->Metadata)) {
+      TArray<FColor> colors = Style.evaluate(propertyTable);
+      if (colors.IsEmpty()) {
+        continue;
+      }
+
+      CesiumEncodedFeaturesMetadata::EncodedPropertyTable& encodedTable =
+          encoded.Emplace_GetRef();
+      encodedTable.name =
+          CesiumEncodedFeaturesMetadata::getNameForPropertyTable(propertyTable);
+      encodedTable.properties.Emplace(
+          CesiumEncodedFeaturesMetadata::encodeFeatureStyleAnyThreadPart(
+              encodedTable.name,
+              colors));
+    }
+  }
+
+  bool appliedAny = false;
+  for (CesiumEncodedFeaturesMetadata::EncodedPropertyTable& propertyTable :
+       encoded) {
+    if (!CesiumEncodedFeaturesMetadata::encodePropertyTableGameThreadPart(
+            propertyTable)) {
+      continue;
+    }
+
+    this->AddEncodedPropertyTable(MoveTemp(propertyTable));
+    appliedAny = true;
+  }
+
+  return appliedAny;
+}
+
+void UCesiumGltfComponent::SetPolygonClipping(
+    const UCesiumPolygonClippingComponent& Clipping) {
+  forEachPrimitiveComponent(
+      this,
+      [&Clipping](
+          UCesiumGltfPrimitiveComponent*,
+          UMaterialInstanceDynamic* pMaterial,
+          UCesiumMaterialUserData* pCesiumData) {
+        Clipping.SetMaterialParameterValues(pMaterial, pCesiumData);
+      });
+}
+
+void UCesiumGltfComponent::AddEncodedPropertyTable(
+    CesiumEncodedFeaturesMetadata::EncodedPropertyTable&& PropertyTable) {
+  forEachPrimitiveComponent(
+      this,
+      [&PropertyTable](
+          UCesiumGltfPrimitiveComponent*,
+          UMaterialInstanceDynamic* pMaterial,
+          UCesiumMaterialUserData* pCesiumData) {
+        const int32 index =
+            pCesiumData ? pCesiumData->LayerNames.Find("FeaturesMetadata")
+                        : INDEX_NONE;
+        if (index != INDEX_NONE) {
+          SetPropertyTableParameterValues(
+              PropertyTable,
+              pMaterial,
+              EMaterialParameterAssociation::LayerParameter,
+              index);
+        }
+      });
+
+  // Primitives that are created later get the properties from here.
+  CesiumEncodedFeaturesMetadata::EncodedPropertyTable* pExisting =
+      this->EncodedMetadata.propertyTables.FindByPredicate(
+          [&PropertyTable](
+              const CesiumEncodedFeaturesMetadata::EncodedPropertyTable&
+                  encodedPropertyTable) {
+            return encodedPropertyTable.name == PropertyTable.name;
+          });
+  if (!pExisting) {
+    ACesium3DTileset* pTilesetActor = this->GetOwner<ACesium3DTileset>();
+    if (pTilesetActor) {
+      std::vector<ReferenceCountedUnrealTexture*> textures;
+      addPropertyTableTextures(PropertyTable, textures);
+      pTilesetActor->GetMemoryUsageTracker().addEncodedTextures(
+          this,
+          textures);
+    }
+    this->EncodedMetadata.propertyTables.Emplace(MoveTemp(PropertyTable));
+    return;
+  }
+
+  for (CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty& property :
+       PropertyTable.properties) {
+    CesiumEncodedFeaturesMetadata::EncodedPropertyTableProperty* pProperty =
+        pExisting->properties.FindByPredicate(
+            [&property](const CesiumEncodedFeaturesMetadata::
+                            EncodedPropertyTableProperty& existingProperty) {
+              return existingProperty.name == property.name;
+            });
+    if (pProperty) {
+      *pProperty = MoveTemp(property);
+    } else {
+      pExisting->properties.Emplace(MoveTemp(property));
+    }
+  }
+}
+
+bool UCesiumGltfComponent::SetFeatureState(
+    int64 PropertyTableIndex,
+    int64 FeatureID,
+    uint8 Flags) {
+  const TArray<FCesiumPropertyTable>& propertyTables =
+      UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(this->Metadata);
+  if (PropertyTableIndex < 0 || PropertyTableIndex >= propertyTables.Num()) {
+    return false;
+  }
+
+  const FCesiumPropertyTable& propertyTable =
+      propertyTables[int32(PropertyTableIndex)];
+  const int64 featureCount =
+      UCesiumPropertyTableBlueprintLibrary::GetPropertyTableCount(
+          propertyTable);
+  if (FeatureID < 0 || FeatureID >= featureCount) {
+    return false;
+  }
+
+  FCesiumFeatureStateTexture* pFeatureState =
+      this->FeatureStates.Find(int32(PropertyTableIndex));
+  if (!pFeatureState) {
+    if (Flags == 0) {
+      // Features without a state texture already have no flags.
+      return true;
+    }
+
+    pFeatureState = &this->FeatureStates.Add(int32(PropertyTableIndex));
+    pFeatureState->Dimension =
+        int32(FMath::CeilToInt(FMath::Sqrt(double(featureCount))));
+    pFeatureState->States.SetNumZeroed(
+        pFeatureState->Dimension * pFeatureState->Dimension);
+    pFeatureState->ParameterName = FName(
+        CesiumEncodedFeaturesMetadata::getMaterialNameForPropertyTableProperty(
+            CesiumEncodedFeaturesMetadata::getNameForPropertyTable(
+                propertyTable),
+            CesiumEncodedFeaturesMetadata::FeatureStatePropertyName));
+
+    UTexture2D* pTexture = UTexture2D::CreateTransient(
+        pFeatureState->Dimension,
+        pFeatureState->Dimension,
+        EPixelFormat::PF_G8,
+        MakeUniqueObjectName(
+            GetTransientPackage(),
+            UTexture2D::StaticClass(),
+            "CesiumFeatureStateTexture"));
+    pTexture->AddressX = TextureAddress::TA_Clamp;
+    pTexture->AddressY = TextureAddress::TA_Clamp;
+    pTexture->Filter = TextureFilter::TF_Nearest;
+    pTexture->LODGroup = TEXTUREGROUP_8BitData;
+    pTexture->SRGB = false;
+    pTexture->NeverStream = true;
+
+    FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+    void* pPixels = mip.BulkData.Lock(LOCK_READ_WRITE);
+    FMemory::Memzero(pPixels, pFeatureState->States.Num());
+    mip.BulkData.Unlock();
+    pTexture->UpdateResource();
+    pFeatureState->Texture = pTexture;
+
+    const FName parameterName = pFeatureState->ParameterName;
+    forEachPrimitiveComponent(
+        this,
+        [parameterName, pTexture](
+            UCesiumGltfPrimitiveComponent*,
+            UMaterialInstanceDynamic* pMaterial,
+            UCesiumMaterialUserData* pCesiumData) {
+          const int32 index =
+              pCesiumData ? pCesiumData->LayerNames.Find("FeaturesMetadata")
+                          : INDEX_NONE;
+          if (index != INDEX_NONE) {
+            pMaterial->SetTextureParameterValueByInfo(
+                FMaterialParameterInfo(
+                    parameterName,
+                    EMaterialParameterAssociation::LayerParameter,
+                    index),
+                pTexture);
+          }
+        });
+  }
+
+  uint8& state = pFeatureState->States[int32(FeatureID)];
+  if (state != Flags) {
+    state = Flags;
+    const int32 row = int32(FeatureID / pFeatureState->Dimension);
+    this->MarkFeatureStateDirty(*pFeatureState, row, row);
+  }
+
+  return true;
+}
+
+uint8 UCesiumGltfComponent::GetFeatureState(
+    int64 PropertyTableIndex,
+    int64 FeatureID) const {
+  if (PropertyTableIndex < 0 || PropertyTableIndex > MAX_int32) {
+    return 0;
+  }
+
+  const FCesiumFeatureStateTexture* pFeatureState =
+      this->FeatureStates.Find(int32(PropertyTableIndex));
+  if (!pFeatureState || FeatureID < 0 ||
+      FeatureID >= pFeatureState->States.Num()) {
+    return 0;
+  }
+
+  return pFeatureState->States[int32(FeatureID)];
+}
+
+void UCesiumGltfComponent::ClearFeatureStates() {
+  for (TPair<int32, FCesiumFeatureStateTexture>& pair : this->FeatureStates) {
+    FCesiumFeatureStateTexture& featureState = pair.Value;
+    FMemory::Memzero(featureState.States.GetData(), featureState.States.Num());
+    this->MarkFeatureStateDirty(featureState, 0, featureState.Dimension - 1);
+  }
+}
+
+void UCesiumGltfComponent::MarkFeatureStateDirty(
+    FCesiumFeatureStateTexture& FeatureState,
+    int32 FirstRow,
+    int32 LastRow) {
+  if (FeatureState.FirstDirtyRow == INDEX_NONE) {
+    FeatureState.FirstDirtyRow = FirstRow;
+    FeatureState.LastDirtyRow = LastRow;
+  } else {
+    FeatureState.FirstDirtyRow =
+        FMath::Min(FeatureState.FirstDirtyRow, FirstRow);
+    FeatureState.LastDirtyRow = FMath::Max(FeatureState.LastDirtyRow, LastRow);
+  }
+
+  // Copy all of the changes of this frame to the textures at once.
+  if (!this->_featureStateUpdatePending) {
+    this->_featureStateUpdatePending = true;
+    AsyncTask(
+        ENamedThreads::GameThread,
+        [pThis = TWeakObjectPtr<UCesiumGltfComponent>(this)]() {
+          if (UCesiumGltfComponent* pGltf = pThis.Get()) {
+            pGltf->UpdateFeatureStateTextures();
+          }
+        });
+  }
+}
+
+void UCesiumGltfComponent::UpdateFeatureStateTextures() {
+  this->_featureStateUpdatePending = false;
+
+  for (TPair<int32, FCesiumFeatureStateTexture>& pair : this->FeatureStates) {
+    FCesiumFeatureStateTexture& featureState = pair.Value;
+    if (featureState.FirstDirtyRow == INDEX_NONE) {
+      continue;
+    }
+
+    const int32 firstRow = featureState.FirstDirtyRow;
+    const int32 rowCount = featureState.LastDirtyRow - firstRow + 1;
+    featureState.FirstDirtyRow = INDEX_NONE;
+    featureState.LastDirtyRow = INDEX_NONE;
+    if (!IsValid(featureState.Texture)) {
+      continue;
+    }
+
+    // Only the dirty rows are copied. The render thread frees the copy once
+    // it has updated the texture.
+    const int32 dimension = featureState.Dimension;
+    const int32 byteCount = rowCount * dimension;
+    uint8* pPixels = new uint8[byteCount];
+    FMemory::Memcpy(
+        pPixels,
+        featureState.States.GetData() + firstRow * dimension,
+        byteCount);
+
+    FUpdateTextureRegion2D* pRegion =
+        new FUpdateTextureRegion2D(0, firstRow, 0, 0, dimension, rowCount);
+    featureState.Texture->UpdateTextureRegions(
+        0,
+        1,
+        pRegion,
+        uint32(dimension),
+        1,
+        pPixels,
+        [](uint8* pPixels, const FUpdateTextureRegion2D* pRegion) {
+          delete[] pPixels;
+          delete pRegion;
+        });
+  }
+}
+
 void UCesiumGltfComponent::SetCollisionEnabled(
     ECollisionEnabled::Type NewType) {
+  this->_collisionEnabled = NewType;
   for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
@@ -3749,12 +6056,197 @@ void UCesiumGltfComponent::SetCollisionEnabled(
   }
 }
 
+void UCesiumGltfComponent::SetShadowCasting(
+    ECesiumGltfShadowCasting ShadowCasting) {
+  if (this->_shadowCasting == ShadowCasting) {
+    return;
+  }
+  this->_shadowCasting = ShadowCasting;
+
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UPrimitiveComponent* pPrimitive =
+        Cast<UPrimitiveComponent>(pSceneComponent);
+    if (pPrimitive) {
+      this->applyShadowAndRayTracing(pPrimitive);
+    }
+  }
+}
+
+void UCesiumGltfComponent::SetRayTracing(ECesiumGltfRayTracing RayTracing) {
+  if (this->_rayTracing == RayTracing) {
+    return;
+  }
+  this->_rayTracing = RayTracing;
+
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UPrimitiveComponent* pPrimitive =
+        Cast<UPrimitiveComponent>(pSceneComponent);
+    if (pPrimitive) {
+      this->applyShadowAndRayTracing(pPrimitive);
+    }
+  }
+}
+
+void UCesiumGltfComponent::applyShadowAndRayTracing(
+    UPrimitiveComponent* pPrimitive) const {
+  // A ray tracing proxy is visible, so it only casts the shadows of a shadow
+  // proxy, which would otherwise be cast while it is hidden.
+  const bool rayTracingProxy =
+      this->_rayTracing == ECesiumGltfRayTracing::HiddenProxy;
+  const bool shadowProxy =
+      this->_shadowCasting == ECesiumGltfShadowCasting::HiddenProxy;
+  pPrimitive->SetCastShadow(
+      rayTracingProxy ? shadowProxy
+                      : this->_shadowCasting != ECesiumGltfShadowCasting::None);
+  pPrimitive->SetCastHiddenShadow(shadowProxy);
+
+  const bool visibleInRayTracing =
+      this->_rayTracing != ECesiumGltfRayTracing::None;
+  if (pPrimitive->bVisibleInRayTracing != visibleInRayTracing ||
+      pPrimitive->bRenderInMainPass == rayTracingProxy) {
+    pPrimitive->bVisibleInRayTracing = visibleInRayTracing;
+    pPrimitive->bRenderInMainPass = !rayTracingProxy;
+    pPrimitive->bRenderInDepthPass = !rayTracingProxy;
+    pPrimitive->MarkRenderStateDirty();
+  }
+
+  // The primitives of a proxy are shown without showing this component, so
+  // that the tileset still knows that its tile is hidden.
+  const bool visible = rayTracingProxy || this->IsVisible();
+  if (pPrimitive->GetVisibleFlag() != visible) {
+    pPrimitive->SetVisibility(visible);
+  }
+}
+
+namespace {
+const TArray<FString>*
+getMaterialLayerNames(const UMaterialInterface* pMaterial) {
+  const UMaterialInstance* pInstance = Cast<UMaterialInstance>(pMaterial);
+  const UCesiumMaterialUserData* pCesiumData =
+      pInstance ? pInstance->GetAssetUserData<UCesiumMaterialUserData>()
+                : nullptr;
+  return pCesiumData ? &pCesiumData->LayerNames : nullptr;
+}
+} // namespace
+
+/*static*/ bool UCesiumGltfComponent::HaveSameMaterialLayers(
+    const UMaterialInterface* pMaterial,
+    const UMaterialInterface* pOtherMaterial) {
+  const TArray<FString>* pLayerNames = getMaterialLayerNames(pMaterial);
+  const TArray<FString>* pOtherLayerNames =
+      getMaterialLayerNames(pOtherMaterial);
+  if (!pLayerNames || !pOtherLayerNames) {
+    return !pLayerNames && !pOtherLayerNames;
+  }
+  return *pLayerNames == *pOtherLayerNames;
+}
+
+void UCesiumGltfComponent::SetBaseMaterials(
+    UMaterialInterface* pMaterial,
+    UMaterialInterface* pTranslucentMaterial,
+    UMaterialInterface* pWaterMaterial) {
+  const UCesiumGltfComponent* pDefaults = GetDefault<UCesiumGltfComponent>();
+  UMaterialInterface* pNewOpaque =
+      pMaterial ? pMaterial : pDefaults->BaseMaterial;
+  UMaterialInterface* pNewTranslucent =
+      pTranslucentMaterial ? pTranslucentMaterial
+                           : pDefaults->BaseMaterialWithTranslucency;
+  UMaterialInterface* pNewWater =
+      pWaterMaterial ? pWaterMaterial : pDefaults->BaseMaterialWithWater;
+
+  UMaterialInterface* pOldOpaque = this->BaseMaterial;
+  UMaterialInterface* pOldTranslucent = this->BaseMaterialWithTranslucency;
+  UMaterialInterface* pOldWater = this->BaseMaterialWithWater;
+  if (pOldOpaque == pNewOpaque && pOldTranslucent == pNewTranslucent &&
+      pOldWater == pNewWater) {
+    return;
+  }
+
+  // Primitives that are created later get the new materials too.
+  this->BaseMaterial = pNewOpaque;
+  this->BaseMaterialWithTranslucency = pNewTranslucent;
+  this->BaseMaterialWithWater = pNewWater;
+
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pSceneComponent);
+    UMaterialInstanceDynamic* pOldInstance =
+        pMesh ? Cast<UMaterialInstanceDynamic>(pMesh->GetMaterial(0))
+              : nullptr;
+    if (!IsValid(pOldInstance) || pOldInstance->IsUnreachable()) {
+      continue;
+    }
+
+    // The base materials may be the same material, in which case the blend
+    // mode tells which of them the primitive was created with.
+    UMaterialInterface* pParent = pOldInstance->Parent;
+    UMaterialInterface* pNewParent = nullptr;
+    if (pParent == pOldTranslucent &&
+        (pParent != pOldOpaque ||
+         IsTranslucentBlendMode(pOldInstance->GetBlendMode()))) {
+      pNewParent = pNewTranslucent;
+    } else if (pParent == pOldOpaque) {
+      pNewParent = pNewOpaque;
+    } else if (pParent == pOldWater) {
+      pNewParent = pNewWater;
+    }
+    if (!pNewParent || pNewParent == pParent) {
+      continue;
+    }
+
+    // The parameters of the glTF, the raster overlays, and the fade are all
+    // overrides of the old instance, so the new instance has them too.
+    UMaterialInstanceDynamic* pNewInstance =
+        UMaterialInstanceDynamic::Create(pNewParent, nullptr);
+    pNewInstance->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pNewInstance->CopyParameterOverrides(pOldInstance);
+    pMesh->SetMaterial(0, pNewInstance);
+    CesiumLifetime::destroy(pOldInstance);
+  }
+}
+
+void UCesiumGltfComponent::SetCustomDepthParameters(
+    const FCustomDepthParameters& InCustomDepthParameters,
+    bool bPointsRenderCustomDepth) {
+  this->CustomDepthParameters = InCustomDepthParameters;
+
+  for (USceneComponent* pSceneComponent : this->GetAttachChildren()) {
+    UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pSceneComponent);
+    if (!pMesh || !Cast<ICesiumPrimitive>(pSceneComponent)) {
+      continue;
+    }
+
+    pMesh->SetRenderCustomDepth(
+        InCustomDepthParameters.RenderCustomDepth ||
+        (bPointsRenderCustomDepth &&
+         Cast<UCesiumGltfPointsComponent>(pSceneComponent)));
+    pMesh->SetCustomDepthStencilWriteMask(
+        InCustomDepthParameters.CustomDepthStencilWriteMask);
+    pMesh->SetCustomDepthStencilValue(
+        InCustomDepthParameters.CustomDepthStencilValue);
+  }
+}
+
+void UCesiumGltfComponent::OnVisibilityChanged() {
+  Super::OnVisibilityChanged();
+
+  ACesium3DTileset* pTilesetActor = this->GetOwner<ACesium3DTileset>();
+  if (pTilesetActor && pTilesetActor->GetMergeInstancedMeshes()) {
+    pTilesetActor->GetInstanceBatches().setVisibility(
+        *this,
+        this->GetVisibleFlag());
+  }
+}
+
 void UCesiumGltfComponent::BeginDestroy() {
+  this->CancelBuild();
+
   // Clear everything we can in order to reduce memory usage, because this
   // UObject might not actually get deleted by the garbage collector until
   // much later.
   this->Metadata = FCesiumModelMetadata();
   this->EncodedMetadata = CesiumEncodedFeaturesMetadata::EncodedModelMetadata();
+  this->FeatureStates.Empty();
 
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   this->EncodedMetadata_DEPRECATED.reset();
@@ -3810,73 +6302,161 @@ void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
   }
 }
 
-static bool isTriangleDegenerate(
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B,
-    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C) {
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AB = B - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType AC = C - A;
-  Chaos::FTriangleMeshImplicitObject::ParticleVecType Normal =
-      Chaos::FTriangleMeshImplicitObject::ParticleVecType::CrossProduct(AB, AC);
-  return (Normal.SafeNormalize() < 1.e-8f);
+void UCesiumGltfComponent::UpdateTimedFade(
+    int32 customDataIndex,
+    float startTime,
+    float length,
+    bool fadingIn) {
+  if (!this->IsVisible()) {
+    return;
+  }
+
+  for (USceneComponent* pChild : this->GetAttachChildren()) {
+    UCesiumGltfPrimitiveComponent* pPrimitive =
+        Cast<UCesiumGltfPrimitiveComponent>(pChild);
+    if (!pPrimitive) {
+      continue;
+    }
+
+    pPrimitive->SetCustomPrimitiveDataFloat(customDataIndex, startTime);
+    pPrimitive->SetCustomPrimitiveDataFloat(customDataIndex + 1, length);
+    pPrimitive->SetCustomPrimitiveDataFloat(
+        customDataIndex + 2,
+        fadingIn ? 0.0f : 1.0f);
+  }
+
+  this->_timedFadeStartTime = startTime;
+  this->_timedFadeLength = length;
+  this->_timedFadeIn = fadingIn;
 }
 
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices) {
-  int32 vertexCount = vertexData.Num();
-  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
-  vertices.AddParticles(vertexCount);
-  for (int32 i = 0; i < vertexCount; ++i) {
-    vertices.X(i) = vertexData[i].Position;
+bool UCesiumGltfComponent::IsTimedFadeCurrent(
+    float fadePercentage,
+    bool fadingIn,
+    float time,
+    float length) const {
+  if (!this->_timedFadeStartTime || this->_timedFadeIn != fadingIn ||
+      this->_timedFadeLength != length) {
+    return false;
   }
 
-  int32 triangleCount = indices.Num() / 3;
-  TArray<Chaos::TVector<TIndex, 3>> triangles;
-  triangles.Reserve(triangleCount);
-  TArray<int32> faceRemap;
-  faceRemap.Reserve(triangleCount);
+  // The tileset advances fades by the same game time that the material
+  // measures them with, so they only drift apart when the fade is restarted
+  // or reversed part way through.
+  constexpr float tolerance = 0.05f;
+  const float predicted =
+      length > 0.0f
+          ? glm::clamp((time - *this->_timedFadeStartTime) / length, 0.0f, 1.0f)
+          : 1.0f;
+  return FMath::Abs(predicted - glm::clamp(fadePercentage, 0.0f, 1.0f)) <=
+         tolerance;
+}
 
-  for (int32 i = 0; i < triangleCount; ++i) {
-    const int32 index0 = 3 * i;
-    int32 vIndex0 = indices[index0 + 1];
-    int32 vIndex1 = indices[index0];
-    int32 vIndex2 = indices[index0 + 2];
-
-    if (!isTriangleDegenerate(
-            vertices.X(vIndex0),
-            vertices.X(vIndex1),
-            vertices.X(vIndex2))) {
-      triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
-      faceRemap.Add(i);
-    }
-  }
-
-  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
-  TArray<uint16> materials;
-  materials.SetNum(triangles.Num());
-
-#if ENGINE_VERSION_5_4_OR_HIGHER
-  return new Chaos::FTriangleMeshImplicitObject(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#else
-  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#endif
+double UCesiumGltfComponent::GetTileCost(
+    ECesiumTileCostMetric Metric,
+    const CesiumMemoryUsageTracker& MemoryUsageTracker) const {
+  switch (Metric) {
+  case ECesiumTileCostMetric::LoadTime:
+    return this->LoadMilliseconds;
+  case ECesiumTileCostMetric::TextureBytes:
+    return double(MemoryUsageTracker.getComponentTextureBytes(this));
+  case ECesiumTileCostMetric::RefinementDepth:
+    return double(this->RefinementDepth);
+  case ECesiumTileCostMetric::TriangleCount:
+  case ECesiumTileCostMetric::DrawCalls:
+    break;
+  default:
+    return 0.0;
+  }
+
+  int64 triangles = 0;
+  int64 sections = 0;
+  for (const USceneComponent* pChild : this->GetAttachChildren()) {
+    const UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pChild);
+    const UStaticMesh* pStaticMesh = pMesh ? pMesh->GetStaticMesh() : nullptr;
+    const FStaticMeshRenderData* pRenderData =
+        pStaticMesh ? pStaticMesh->GetRenderData() : nullptr;
+    if (!pRenderData || pRenderData->LODResources.IsEmpty()) {
+      continue;
+    }
+
+    const FStaticMeshLODResources& lod = pRenderData->LODResources[0];
+    const UInstancedStaticMeshComponent* pInstanced =
+        Cast<UInstancedStaticMeshComponent>(pMesh);
+    const int64 instances = pInstanced ? pInstanced->GetInstanceCount() : 1;
+    triangles += int64(lod.GetNumTriangles()) * instances;
+    sections += lod.Sections.Num();
+  }
+
+  return Metric == ECesiumTileCostMetric::TriangleCount ? double(triangles)
+                                                         : double(sections);
+}
+
+void UCesiumGltfComponent::SetDebugColor(
+    const std::optional<FLinearColor>& Color) {
+  if (this->_debugColor == Color) {
+    return;
+  }
+  this->_debugColor = Color;
+
+  for (USceneComponent* pChild : this->GetAttachChildren()) {
+    UStaticMeshComponent* pMesh = Cast<UStaticMeshComponent>(pChild);
+    ICesiumPrimitive* pCesiumPrimitive = Cast<ICesiumPrimitive>(pChild);
+    if (!pMesh || !pCesiumPrimitive) {
+      continue;
+    }
+
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pMesh->GetMaterial(0));
+    if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
+      continue;
+    }
+
+    // The glTF's own base color factor, as set when the material was
+    // created.
+    const CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
+    FLinearColor baseColorFactor(1.0f, 1.0f, 1.0f, 1.0f);
+    const Material* pGltfMaterial =
+        primData.pModel && primData.pMeshPrimitive
+            ? Model::getSafe(
+                  &primData.pModel->materials,
+                  primData.pMeshPrimitive->material)
+            : nullptr;
+    if (pGltfMaterial && pGltfMaterial->pbrMetallicRoughness) {
+      const std::vector<double>& factor =
+          pGltfMaterial->pbrMetallicRoughness->baseColorFactor;
+      if (factor.size() >= 3) {
+        baseColorFactor = FLinearColor(
+            factor[0],
+            factor[1],
+            factor[2],
+            factor.size() > 3 ? factor[3] : 1.0);
+      }
+    }
+
+    FLinearColor value = baseColorFactor;
+    if (Color) {
+      value = *Color;
+      value.A = baseColorFactor.A;
+    }
+
+    UMaterialInstance* pBaseAsMaterialInstance =
+        Cast<UMaterialInstance>(pMaterial->Parent);
+    UCesiumMaterialUserData* pCesiumData =
+        pBaseAsMaterialInstance
+            ? pBaseAsMaterialInstance
+                  ->GetAssetUserData<UCesiumMaterialUserData>()
+            : nullptr;
+    if (pCesiumData) {
+      pMaterial->SetVectorParameterValueByInfo(
+          FMaterialParameterInfo(
+              "baseColorFactor",
+              EMaterialParameterAssociation::LayerParameter,
+              0),
+          value);
+    }
+    pMaterial->SetVectorParameterValueByInfo(
+        FMaterialParameterInfo("baseColorFactor"),
+        value);
+  }
 }
@@ -7,6 +7,8 @@
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumTileContentBuilder.h"
+#include "CesiumTrace.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/SceneComponent.h"
 #include "CoreMinimal.h"
@@ -14,8 +16,12 @@
 #include "Interfaces/IHttpRequest.h"
 #include <glm/mat4x4.hpp>
 #include <memory>
+#include <optional>
 #include "CesiumGltfComponent.generated.h"
 
+class CesiumCompiledFeatureStyle;
+class CesiumMemoryUsageTracker;
+class UCesiumPolygonClippingComponent;
 class UMaterialInterface;
 class UTexture2D;
 class UStaticMeshComponent;
@@ -54,6 +60,62 @@ struct FRasterOverlayTile {
   int32 TextureCoordinateID = -1;
 };
 
+/**
+ * The state flags of the features of a property table, and the texture that
+ * passes them to the materials.
+ */
+USTRUCT()
+struct FCesiumFeatureStateTexture {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  UTexture2D* Texture = nullptr;
+
+  // The name of the texture parameter of the materials.
+  FName ParameterName;
+
+  // The flags of each feature by feature ID, padded to fill the square
+  // texture.
+  TArray<uint8> States;
+  int32 Dimension = 0;
+
+  // The rows of the texture with flags that changed since it was last
+  // updated, or INDEX_NONE if none did.
+  int32 FirstDirtyRow = INDEX_NONE;
+  int32 LastDirtyRow = INDEX_NONE;
+};
+
+/**
+ * How the primitives of a glTF cast shadows.
+ */
+enum class ECesiumGltfShadowCasting : uint8 {
+  /** The primitives cast shadows while they are visible. */
+  Visible,
+  /** The primitives do not cast shadows. */
+  None,
+  /**
+   * The primitives cast shadows while they are hidden, standing in for the
+   * shadows of more detailed tiles that do not cast their own.
+   */
+  HiddenProxy
+};
+
+/**
+ * How the primitives of a glTF take part in ray tracing, including Lumen's.
+ */
+enum class ECesiumGltfRayTracing : uint8 {
+  /** The primitives are ray traced while they are visible. */
+  Visible,
+  /** The primitives are not ray traced. */
+  None,
+  /**
+   * The primitives are ray traced while the glTF is hidden, but not drawn in
+   * the main or depth passes, standing in for more detailed tiles that are
+   * not ray traced.
+   */
+  HiddenProxy
+};
+
 UCLASS()
 class UCesiumGltfComponent : public USceneComponent {
   GENERATED_BODY()
@@ -62,6 +124,25 @@ public:
   class HalfConstructed {
   public:
     virtual ~HalfConstructed() = default;
+
+    /**
+     * The tile's load in a worker thread, which is traced once the tile has
+     * been created in the game thread. Only set while the Cesium trace
+     * channel is enabled.
+     */
+    CesiumTrace::TileLoadStatistics TraceStatistics;
+
+    /**
+     * The time, in milliseconds, spent creating this in a worker thread.
+     */
+    double LoadMilliseconds = 0.0;
+
+    /**
+     * What the tileset's tile content builder prepared for the tile in the
+     * worker thread, if it has one.
+     */
+    TUniquePtr<ICesiumTileContentBuilder::LoadThreadResult>
+        TileContentBuilderResult;
   };
 
   static TUniquePtr<HalfConstructed> CreateOffGameThread(
@@ -80,7 +161,8 @@ public:
       UMaterialInterface* BaseWaterMaterial,
       FCustomDepthParameters CustomDepthParameters,
       const Cesium3DTilesSelection::Tile& tile,
-      bool createNavCollision);
+      bool createNavCollision,
+      double timeLimitMilliseconds = 0.0);
 
   UCesiumGltfComponent();
   virtual ~UCesiumGltfComponent();
@@ -97,6 +179,28 @@ public:
   UPROPERTY(EditAnywhere, Category = "Rendering")
   FCustomDepthParameters CustomDepthParameters{};
 
+  /**
+   * The time, in milliseconds, spent creating this tile's meshes in a worker
+   * thread and its components in the game thread.
+   */
+  double LoadMilliseconds = 0.0;
+
+  /**
+   * The depth of this tile in its tileset's tile tree, where the root tile is
+   * zero.
+   */
+  int32 RefinementDepth = 0;
+
+  /**
+   * Whether this tile is still to be given to the tileset's tile content
+   * builder, once it is complete, along with the builder's result from the
+   * worker thread and the tile's model.
+   */
+  bool TileContentBuildPending = false;
+  TUniquePtr<ICesiumTileContentBuilder::LoadThreadResult>
+      TileContentBuilderResult;
+  const CesiumGltf::Model* pTileContentModel = nullptr;
+
   FCesiumModelMetadata Metadata{};
   CesiumEncodedFeaturesMetadata::EncodedModelMetadata EncodedMetadata{};
 
@@ -107,13 +211,31 @@ public:
 
   void UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform);
 
+  /**
+   * Updates the transforms of the primitives like UpdateTransformFromCesium
+   * if this component is visible. Otherwise, only the new transform is
+   * recorded, and it's applied by ApplyPendingTransform when the component is
+   * shown again. Most of a tileset's loaded tiles are usually hidden, so this
+   * keeps the cost of changing the georeference proportional to the number
+   * of visible tiles.
+   */
+  void UpdateTransformFromCesiumWhenVisible(
+      const glm::dmat4& CesiumToUnrealTransform);
+
+  /**
+   * Applies the transform recorded by UpdateTransformFromCesiumWhenVisible
+   * while this component was hidden, if any.
+   */
+  void ApplyPendingTransform();
+
   void AttachRasterTile(
       const Cesium3DTilesSelection::Tile& Tile,
       const CesiumRasterOverlays::RasterOverlayTile& RasterTile,
       UTexture2D* Texture,
       const glm::dvec2& Translation,
       const glm::dvec2& Scale,
-      int32_t TextureCoordinateID);
+      int32_t TextureCoordinateID,
+      int32 TextureArraySlice = -1);
 
   void DetachRasterTile(
       const Cesium3DTilesSelection::Tile& Tile,
@@ -123,11 +245,271 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Collision")
   virtual void SetCollisionEnabled(ECollisionEnabled::Type NewType);
 
+  /**
+   * Gets the collision that was last set on all of this glTF's primitives
+   * with SetCollisionEnabled.
+   */
+  ECollisionEnabled::Type GetPrimitiveCollisionEnabled() const {
+    return this->_collisionEnabled;
+  }
+
+  /**
+   * Determines if all of the primitives of this glTF have been created. A
+   * component that is still being built is kept hidden.
+   */
+  bool IsBuildComplete() const { return !this->_pPendingBuild.IsValid(); }
+
+  /**
+   * Sets how this glTF's primitives cast shadows. Nothing is changed if it is
+   * the current shadow casting.
+   */
+  void SetShadowCasting(ECesiumGltfShadowCasting ShadowCasting);
+
+  ECesiumGltfShadowCasting GetShadowCasting() const {
+    return this->_shadowCasting;
+  }
+
+  /**
+   * Sets how this glTF's primitives take part in ray tracing. Nothing is
+   * changed if it is the current ray tracing. Primitives that are created
+   * later start with it too.
+   */
+  void SetRayTracing(ECesiumGltfRayTracing RayTracing);
+
+  ECesiumGltfRayTracing GetRayTracing() const { return this->_rayTracing; }
+
+  /**
+   * Replaces the base materials of this glTF's primitives, giving each
+   * primitive a new material instance with the parameters of its current
+   * one. A null material is replaced by the default one. The parameters only
+   * mean the same to a new base material with the same material layers as
+   * the one it replaces, see HaveSameMaterialLayers.
+   */
+  void SetBaseMaterials(
+      UMaterialInterface* pMaterial,
+      UMaterialInterface* pTranslucentMaterial,
+      UMaterialInterface* pWaterMaterial);
+
+  /**
+   * Determines if the material instances of two base materials have the same
+   * material layers, so that the parameters of an instance of one of them can
+   * be copied to an instance of the other.
+   */
+  static bool HaveSameMaterialLayers(
+      const UMaterialInterface* pMaterial,
+      const UMaterialInterface* pOtherMaterial);
+
+  /**
+   * Sets the custom depth parameters of this glTF's primitives.
+   *
+   * @param InCustomDepthParameters The new parameters.
+   * @param bPointsRenderCustomDepth Whether point primitives render custom
+   * depth anyway, which eye-dome lighting needs.
+   */
+  void SetCustomDepthParameters(
+      const FCustomDepthParameters& InCustomDepthParameters,
+      bool bPointsRenderCustomDepth);
+
+  /**
+   * Continues creating this glTF's primitives until all of them are created
+   * or the time limit is exceeded. At least one primitive is created per
+   * call. A time limit of zero or less means no limit.
+   *
+   * @return True if the component is now complete.
+   */
+  bool ContinueBuild(double timeLimitMilliseconds);
+
+  /**
+   * Abandons the creation of any remaining primitives, and of any properties
+   * that are still to be encoded. This must be called before the glTF model
+   * or tile this component was created from is destroyed.
+   */
+  void CancelBuild();
+
+  /**
+   * Encodes the properties of the given property tables that are in this
+   * glTF's metadata but haven't been encoded yet, and sets them on the
+   * materials of its primitives. This is how properties that are encoded on
+   * demand are added to tiles that are already loaded.
+   *
+   * @return True if any properties were encoded.
+   */
+  bool EncodeMissingProperties(
+      const TArray<FCesiumPropertyTableDescription>& PropertyTables);
+
+  /**
+   * Evaluates a style for the features of each property table in this glTF's
+   * metadata, and sets the resulting style textures on the materials of its
+   * primitives, replacing those of any previous style.
+   *
+   * @return True if the style was applied to any property table.
+   */
+  bool ApplyFeatureStyle(const CesiumCompiledFeatureStyle& Style);
+
+  /**
+   * Sets the parameters of polygon clipping on the materials of this glTF's
+   * primitives.
+   */
+  void SetPolygonClipping(const UCesiumPolygonClippingComponent& Clipping);
+
+  /**
+   * Sets the state flags of a feature of a property table in this glTF's
+   * metadata. The texels that changed are copied to the property table's
+   * state texture once at the end of the frame, however many features were
+   * changed.
+   *
+   * @return True if the property table and feature exist.
+   */
+  bool SetFeatureState(int64 PropertyTableIndex, int64 FeatureID, uint8 Flags);
+
+  /**
+   * Gets the state flags of a feature of a property table in this glTF's
+   * metadata, which are zero unless they were set.
+   */
+  uint8 GetFeatureState(int64 PropertyTableIndex, int64 FeatureID) const;
+
+  /**
+   * Clears the state flags of all features of this glTF's property tables.
+   */
+  void ClearFeatureStates();
+
+  /**
+   * Gets the state flags of the features of the property tables, by property
+   * table index, for the property tables with features that have had their
+   * state set.
+   */
+  const TMap<int32, FCesiumFeatureStateTexture>& GetFeatureStates() const {
+    return this->FeatureStates;
+  }
+
   virtual void BeginDestroy() override;
 
+  /**
+   * Shows or hides this tile's instances that are merged into the tileset's
+   * instance batches along with this component.
+   */
+  virtual void OnVisibilityChanged() override;
+
   void UpdateFade(float fadePercentage, bool fadingIn);
 
+  /**
+   * Writes an LOD transition fade to the Custom Primitive Data of this
+   * component's primitives, so the material can compute its progress. See
+   * ACesium3DTileset::LodTransitionCustomPrimitiveDataIndex.
+   *
+   * @param customDataIndex The index of the first of the three floats.
+   * @param startTime The game time at which the fade started.
+   * @param length The length of the fade, in seconds.
+   * @param fadingIn Whether the component is fading in or out.
+   */
+  void UpdateTimedFade(
+      int32 customDataIndex,
+      float startTime,
+      float length,
+      bool fadingIn);
+
+  /**
+   * Determines whether the fade most recently written by
+   * {@link UpdateTimedFade} still predicts the given fade percentage at the
+   * given game time, so that it doesn't need to be written again.
+   */
+  bool IsTimedFadeCurrent(
+      float fadePercentage,
+      bool fadingIn,
+      float time,
+      float length) const;
+
+  /**
+   * Records that this component's tile is rendered in the given frame of its
+   * tileset. Each tileset tick uses a new epoch, so a component stamped with
+   * the current one is known to be visible without searching the list of
+   * rendered tiles.
+   */
+  void MarkRendered(uint64 epoch) { this->_renderedEpoch = epoch; }
+
+  /**
+   * Determines if {@link MarkRendered} was called with the given epoch.
+   */
+  bool WasRenderedIn(uint64 epoch) const {
+    return this->_renderedEpoch == epoch;
+  }
+
+  /**
+   * Gets the cost of this tile by the given metric, for the tileset's tile
+   * cost heatmap.
+   *
+   * @param Metric The metric. None gives zero.
+   * @param MemoryUsageTracker The tracker of the tileset's memory, which
+   * knows the sizes of this tile's textures.
+   */
+  double GetTileCost(
+      ECesiumTileCostMetric Metric,
+      const CesiumMemoryUsageTracker& MemoryUsageTracker) const;
+
+  /**
+   * Sets the base color factor of the materials of this glTF's primitives to
+   * the given color, keeping their alpha, or restores the glTF's own base
+   * color factors if the color is empty. Nothing is changed if the color is
+   * the one most recently set.
+   */
+  void SetDebugColor(const std::optional<FLinearColor>& Color);
+
 private:
+  /**
+   * Sets the encoded properties of a property table on the materials of the
+   * primitives, and keeps them for the primitives that are created later.
+   * They replace any encoded properties of the property table with the same
+   * names.
+   */
+  void AddEncodedPropertyTable(
+      CesiumEncodedFeaturesMetadata::EncodedPropertyTable&& PropertyTable);
+
+  /**
+   * Copies the state flags that changed to the state textures.
+   */
+  void UpdateFeatureStateTextures();
+
+  void MarkFeatureStateDirty(
+      FCesiumFeatureStateTexture& FeatureState,
+      int32 FirstRow,
+      int32 LastRow);
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  UPROPERTY()
+  TMap<int32, FCesiumFeatureStateTexture> FeatureStates;
+
+  // Whether the state textures will be updated at the end of the frame.
+  bool _featureStateUpdatePending = false;
+
+  // The remaining work when this component is being created incrementally,
+  // or nullptr if it is complete.
+  TUniquePtr<HalfConstructed> _pPendingBuild;
+
+  // The transform to apply to the primitives when this component is shown,
+  // if it changed while the component was hidden.
+  std::optional<glm::dmat4> _pendingCesiumToUnrealTransform;
+
+  // The tileset epoch in which this component was last rendered.
+  uint64 _renderedEpoch = 0;
+
+  ECesiumGltfShadowCasting _shadowCasting = ECesiumGltfShadowCasting::Visible;
+  ECesiumGltfRayTracing _rayTracing = ECesiumGltfRayTracing::Visible;
+  ECollisionEnabled::Type _collisionEnabled = ECollisionEnabled::NoCollision;
+
+  // Applies the shadow casting and ray tracing to one of the primitives.
+  void applyShadowAndRayTracing(UPrimitiveComponent* pPrimitive) const;
+
+  // The fade most recently written to the primitives' Custom Primitive Data.
+  std::optional<float> _timedFadeStartTime;
+  float _timedFadeLength = 0.0f;
+  bool _timedFadeIn = false;
+
+  // The color most recently set by SetDebugColor, if any.
+  std::optional<FLinearColor> _debugColor;
+
+  // The glTF model that the metadata was created from, or nullptr once it may
+  // be destroyed.
+  const CesiumGltf::Model* _pModel = nullptr;
 };
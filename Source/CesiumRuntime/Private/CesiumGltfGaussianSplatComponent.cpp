@@ -0,0 +1,26 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfGaussianSplatComponent.h"
+#include "CesiumGaussianSplatSceneProxy.h"
+#include "SceneInterface.h"
+
+// Sets default values for this component's properties
+UCesiumGltfGaussianSplatComponent::UCesiumGltfGaussianSplatComponent()
+    : Splats() {}
+
+UCesiumGltfGaussianSplatComponent::~UCesiumGltfGaussianSplatComponent() {}
+
+FPrimitiveSceneProxy* UCesiumGltfGaussianSplatComponent::CreateSceneProxy() {
+  if (!IsValid(this)) {
+    return nullptr;
+  }
+
+  // Splats are only drawn with shader model 5.
+  FSceneInterface* pScene = GetScene();
+  if (!this->Splats || !pScene ||
+      pScene->GetFeatureLevel() < ERHIFeatureLevel::SM5) {
+    return Super::CreateSceneProxy();
+  }
+
+  return new FCesiumGaussianSplatSceneProxy(this, pScene->GetFeatureLevel());
+}
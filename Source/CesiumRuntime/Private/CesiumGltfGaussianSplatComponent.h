@@ -0,0 +1,28 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGaussianSplats.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumGltfGaussianSplatComponent.generated.h"
+
+/**
+ * A primitive component for a glTF point primitive that consists of Gaussian
+ * splats. The splats are drawn by a FCesiumGaussianSplatSceneProxy, in place
+ * of the points of the static mesh.
+ */
+UCLASS()
+class UCesiumGltfGaussianSplatComponent : public UCesiumGltfPrimitiveComponent {
+  GENERATED_BODY()
+
+public:
+  // Sets default values for this component's properties
+  UCesiumGltfGaussianSplatComponent();
+  virtual ~UCesiumGltfGaussianSplatComponent();
+
+  // The packed splats of the primitive.
+  CesiumGaussianSplats::PackedSplats Splats;
+
+  // Override UPrimitiveComponent interface.
+  virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+};
@@ -8,7 +8,10 @@
 UCesiumGltfPointsComponent::UCesiumGltfPointsComponent()
     : UsesAdditiveRefinement(false),
       GeometricError(0),
-      Dimensions(glm::vec3(0)) {}
+      Dimensions(glm::vec3(0)),
+      QuantizedPositions(),
+      QuantizedPositionOffset(0.0f),
+      QuantizedPositionScale(0.0f) {}
 
 UCesiumGltfPointsComponent::~UCesiumGltfPointsComponent() {}
 
@@ -25,6 +25,15 @@ public:
   // error.
   glm::vec3 Dimensions;
 
+  // The positions of the points quantized to 16 bits per component, if the
+  // tileset quantizes point clouds. The static mesh then only has a
+  // placeholder position.
+  TSharedPtr<const TArray<uint16>, ESPMode::ThreadSafe> QuantizedPositions;
+
+  // The bounding box that the quantized positions are relative to.
+  FVector3f QuantizedPositionOffset;
+  FVector3f QuantizedPositionScale;
+
   // Override UPrimitiveComponent interface.
   virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
 };
@@ -2,6 +2,7 @@
 
 #include "CesiumGltfPointsSceneProxy.h"
 #include "CesiumGltfPointsComponent.h"
+#include "CesiumGltfPointsSceneProxyUpdater.h"
 #include "DataDrivenShaderPlatformInfo.h"
 #include "Engine/StaticMesh.h"
 #include "RHIResources.h"
@@ -10,8 +11,7 @@
 #include "StaticMeshResources.h"
 
 FCesiumGltfPointsSceneProxyTilesetData::FCesiumGltfPointsSceneProxyTilesetData()
-    : PointCloudShading(),
-      MaximumScreenSpaceError(0.0),
+    : Settings(),
       UsesAdditiveRefinement(false),
       GeometricError(0.0f),
       Dimensions() {}
@@ -19,9 +19,8 @@ FCesiumGltfPointsSceneProxyTilesetData::FCesiumGltfPointsSceneProxyTilesetData()
 void FCesiumGltfPointsSceneProxyTilesetData::UpdateFromComponent(
     UCesiumGltfPointsComponent* Component) {
   CesiumPrimitiveData& primData = Component->getPrimitiveData();
-  ACesium3DTileset* Tileset = primData.pTilesetActor;
-  PointCloudShading = Tileset->GetPointCloudShading();
-  MaximumScreenSpaceError = Tileset->MaximumScreenSpaceError;
+  Settings = FCesiumGltfPointsSceneProxyUpdater::GetSharedSettings(
+      primData.pTilesetActor);
   UsesAdditiveRefinement = Component->UsesAdditiveRefinement;
   GeometricError = Component->GeometricError;
   Dimensions = Component->Dimensions;
@@ -45,6 +44,11 @@ FCesiumGltfPointsSceneProxy::FCesiumGltfPointsSceneProxy(
           InFeatureLevel,
           &RenderData->LODResources[0].VertexBuffers.PositionVertexBuffer),
       AttenuationIndexBuffer(NumPoints, bAttenuationSupported),
+      bHasQuantizedPositions(
+          bAttenuationSupported && InComponent->QuantizedPositions.IsValid()),
+      QuantizedPositionBuffer(InComponent->QuantizedPositions),
+      QuantizedPositionOffset(InComponent->QuantizedPositionOffset),
+      QuantizedPositionScale(InComponent->QuantizedPositionScale),
       Material(InComponent->GetMaterial(0)),
       MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {}
 
@@ -55,23 +59,27 @@ void FCesiumGltfPointsSceneProxy::CreateRenderThreadResources(
     FRHICommandListBase& RHICmdList) {
   AttenuationVertexFactory.InitResource(RHICmdList);
   AttenuationIndexBuffer.InitResource(RHICmdList);
+  QuantizedPositionBuffer.InitResource(RHICmdList);
 }
 #elif ENGINE_VERSION_5_3_OR_HIGHER
 void FCesiumGltfPointsSceneProxy::CreateRenderThreadResources() {
   FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
   AttenuationVertexFactory.InitResource(RHICmdList);
   AttenuationIndexBuffer.InitResource(RHICmdList);
+  QuantizedPositionBuffer.InitResource(RHICmdList);
 }
 #else
 void FCesiumGltfPointsSceneProxy::CreateRenderThreadResources() {
   AttenuationVertexFactory.InitResource();
   AttenuationIndexBuffer.InitResource();
+  QuantizedPositionBuffer.InitResource();
 }
 #endif
 
 void FCesiumGltfPointsSceneProxy::DestroyRenderThreadResources() {
   AttenuationVertexFactory.ReleaseResource();
   AttenuationIndexBuffer.ReleaseResource();
+  QuantizedPositionBuffer.ReleaseResource();
 }
 
 void FCesiumGltfPointsSceneProxy::GetDynamicMeshElements(
@@ -82,16 +90,19 @@ void FCesiumGltfPointsSceneProxy::GetDynamicMeshElements(
   QUICK_SCOPE_CYCLE_COUNTER(STAT_GltfPointsSceneProxy_GetDynamicMeshElements);
 
   const bool useAttenuation =
-      bAttenuationSupported && TilesetData.PointCloudShading.Attenuation;
+      bHasQuantizedPositions ||
+      (bAttenuationSupported &&
+       TilesetData.Settings->PointCloudShading.Attenuation);
 
   for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
     if (VisibilityMap & (1 << ViewIndex)) {
       const FSceneView* View = Views[ViewIndex];
+      const int32 NumPointsToDraw = GetNumPointsToDraw(View);
       FMeshBatch& Mesh = Collector.AllocateMesh();
       if (useAttenuation) {
-        CreateMeshWithAttenuation(Mesh, View, Collector);
+        CreateMeshWithAttenuation(Mesh, View, Collector, NumPointsToDraw);
       } else {
-        CreateMesh(Mesh);
+        CreateMesh(Mesh, NumPointsToDraw);
       }
       Collector.AddMesh(ViewIndex, Mesh);
     }
@@ -131,7 +142,8 @@ void FCesiumGltfPointsSceneProxy::UpdateTilesetData(
 }
 
 float FCesiumGltfPointsSceneProxy::GetGeometricError() const {
-  FCesiumPointCloudShading PointCloudShading = TilesetData.PointCloudShading;
+  const FCesiumPointCloudShading& PointCloudShading =
+      TilesetData.Settings->PointCloudShading;
   float GeometricError = TilesetData.GeometricError;
   if (GeometricError > 0.0f) {
     return GeometricError;
@@ -147,6 +159,51 @@ float FCesiumGltfPointsSceneProxy::GetGeometricError() const {
   return FMath::Pow(Volume / NumPoints, 1.0f / 3.0f);
 }
 
+int32 FCesiumGltfPointsSceneProxy::GetNumPointsToDraw(
+    const FSceneView* View) const {
+  const FCesiumPointCloudShading& PointCloudShading =
+      TilesetData.Settings->PointCloudShading;
+  const float MinimumPointSpacing = PointCloudShading.MinimumPointSpacing;
+  if (MinimumPointSpacing <= 0.0f || NumPoints <= 1 ||
+      !View->IsPerspectiveProjection()) {
+    return NumPoints;
+  }
+
+  // The points of tiles are usually spread over a surface, so their spacing
+  // is estimated from the area of the two largest dimensions of the tile.
+  float PointSpacing = PointCloudShading.BaseResolution;
+  if (PointSpacing <= 0.0f) {
+    const glm::vec3& Dimensions = TilesetData.Dimensions;
+    const float Area = FMath::Max3(
+        Dimensions.x * Dimensions.y,
+        Dimensions.y * Dimensions.z,
+        Dimensions.x * Dimensions.z);
+    PointSpacing = FMath::Sqrt(Area / NumPoints);
+  }
+
+  const double Distance = FMath::Sqrt(
+      GetBounds().GetBox().ComputeSquaredDistanceToPoint(
+          View->ViewMatrices.GetViewOrigin()));
+  if (PointSpacing <= 0.0f || Distance <= 0.0) {
+    return NumPoints;
+  }
+
+  const double PixelsPerUnit =
+      View->UnconstrainedViewRect.Height() /
+      (2.0 * FMath::Tan(0.5 * FMath::DegreesToRadians(View->FOV)) * Distance);
+  const double ScreenSpacing =
+      PointSpacing * GetLocalToWorld().GetMaximumAxisScale() * PixelsPerUnit;
+
+  // Drawing a fraction of the points of a surface increases the distance
+  // between them by the inverse of its square root.
+  const double Fraction =
+      FMath::Square(ScreenSpacing / double(MinimumPointSpacing));
+  if (Fraction >= 1.0) {
+    return NumPoints;
+  }
+  return FMath::Max(1, int32(FMath::CeilToDouble(NumPoints * Fraction)));
+}
+
 void FCesiumGltfPointsSceneProxy::CreatePointAttenuationUserData(
     FMeshBatchElement& BatchElement,
     const FSceneView* View,
@@ -160,17 +217,37 @@ void FCesiumGltfPointsSceneProxy::CreatePointAttenuationUserData(
       RenderData->LODVertexFactories[0].VertexFactory;
 
   UserData.PositionBuffer = OriginalVertexFactory.GetPositionsSRV();
+  UserData.QuantizedPositionBuffer =
+      bHasQuantizedPositions
+          ? QuantizedPositionBuffer.PositionsSRV.GetReference()
+          : nullptr;
+  UserData.bHasQuantizedPositions = bHasQuantizedPositions;
+  UserData.QuantizedPositionOffset = QuantizedPositionOffset;
+  UserData.QuantizedPositionScale = QuantizedPositionScale;
   UserData.PackedTangentsBuffer = OriginalVertexFactory.GetTangentsSRV();
   UserData.ColorBuffer = OriginalVertexFactory.GetColorComponentsSRV();
   UserData.TexCoordBuffer = OriginalVertexFactory.GetTextureCoordinatesSRV();
   UserData.NumTexCoords = OriginalVertexFactory.GetNumTexcoords();
   UserData.bHasPointColors = RenderData->LODResources[0].bHasColorVertexData;
 
-  FCesiumPointCloudShading PointCloudShading = TilesetData.PointCloudShading;
+  const FCesiumGltfPointsSceneProxyTilesetSettings& Settings =
+      *TilesetData.Settings;
+  const FCesiumPointCloudShading& PointCloudShading =
+      Settings.PointCloudShading;
+
+  if (!PointCloudShading.Attenuation) {
+    // Quantized points are drawn with this vertex factory even without
+    // attenuation. Clamping them to one pixel makes them look like a point
+    // list.
+    UserData.AttenuationParameters = FVector3f(1.0f, 1.0f, 1.0e20f);
+    BatchElement.UserData = &UserDataWrapper->Data;
+    return;
+  }
 
-  float MaximumPointSize = TilesetData.UsesAdditiveRefinement
-                               ? 5.0f
-                               : TilesetData.MaximumScreenSpaceError;
+  float MaximumPointSize =
+      TilesetData.UsesAdditiveRefinement
+          ? 5.0f
+          : static_cast<float>(Settings.MaximumScreenSpaceError);
 
   if (PointCloudShading.MaximumAttenuation > 0.0f) {
     // Don't multiply by DPI scale; let Unreal handle scaling.
@@ -194,7 +271,8 @@ void FCesiumGltfPointsSceneProxy::CreatePointAttenuationUserData(
 void FCesiumGltfPointsSceneProxy::CreateMeshWithAttenuation(
     FMeshBatch& Mesh,
     const FSceneView* View,
-    FMeshElementCollector& Collector) const {
+    FMeshElementCollector& Collector,
+    int32 NumPointsToDraw) const {
   Mesh.VertexFactory = &AttenuationVertexFactory;
   Mesh.MaterialRenderProxy = Material->GetRenderProxy();
   Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -207,16 +285,18 @@ void FCesiumGltfPointsSceneProxy::CreateMeshWithAttenuation(
 
   FMeshBatchElement& BatchElement = Mesh.Elements[0];
   BatchElement.IndexBuffer = &AttenuationIndexBuffer;
-  BatchElement.NumPrimitives = NumPoints * 2;
+  BatchElement.NumPrimitives = NumPointsToDraw * 2;
   BatchElement.FirstIndex = 0;
   BatchElement.MinVertexIndex = 0;
-  BatchElement.MaxVertexIndex = NumPoints * 4 - 1;
+  BatchElement.MaxVertexIndex = NumPointsToDraw * 4 - 1;
   BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
 
   CreatePointAttenuationUserData(BatchElement, View, Collector);
 }
 
-void FCesiumGltfPointsSceneProxy::CreateMesh(FMeshBatch& Mesh) const {
+void FCesiumGltfPointsSceneProxy::CreateMesh(
+    FMeshBatch& Mesh,
+    int32 NumPointsToDraw) const {
   Mesh.VertexFactory = &RenderData->LODVertexFactories[0].VertexFactory;
   Mesh.MaterialRenderProxy = Material->GetRenderProxy();
   Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
@@ -229,7 +309,7 @@ void FCesiumGltfPointsSceneProxy::CreateMesh(FMeshBatch& Mesh) const {
 
   FMeshBatchElement& BatchElement = Mesh.Elements[0];
   BatchElement.IndexBuffer = &RenderData->LODResources[0].IndexBuffer;
-  BatchElement.NumPrimitives = NumPoints;
+  BatchElement.NumPrimitives = NumPointsToDraw;
   BatchElement.FirstIndex = 0;
   BatchElement.MinVertexIndex = 0;
   BatchElement.MaxVertexIndex = BatchElement.NumPrimitives - 1;
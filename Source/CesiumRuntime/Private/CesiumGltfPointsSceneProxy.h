@@ -10,12 +10,23 @@
 class UCesiumGltfPointsComponent;
 
 /**
- * Used to pass tile data and Cesium3DTileset settings to a SceneProxy, usually
- * via render thread.
+ * The Cesium3DTileset settings that affect how points are rendered. A single
+ * instance is shared by all of the points scene proxies of a tileset, and is
+ * updated through a single render command when the settings change.
  */
-struct FCesiumGltfPointsSceneProxyTilesetData {
+struct FCesiumGltfPointsSceneProxyTilesetSettings {
   FCesiumPointCloudShading PointCloudShading;
-  double MaximumScreenSpaceError;
+  double MaximumScreenSpaceError = 0.0;
+};
+
+/**
+ * Used to pass tile data and Cesium3DTileset settings to a SceneProxy.
+ */
+struct FCesiumGltfPointsSceneProxyTilesetData {
+  TSharedPtr<
+      const FCesiumGltfPointsSceneProxyTilesetSettings,
+      ESPMode::ThreadSafe>
+      Settings;
   bool UsesAdditiveRefinement;
   float GeometricError;
   glm::vec3 Dimensions;
@@ -76,11 +87,27 @@ private:
   FCesiumPointAttenuationVertexFactory AttenuationVertexFactory;
   FCesiumPointAttenuationIndexBuffer AttenuationIndexBuffer;
 
+  // Whether the positions of the points are quantized. If so, they are always
+  // drawn with the point attenuation vertex factory, because the static mesh
+  // only has a placeholder position.
+  bool bHasQuantizedPositions;
+  FCesiumQuantizedPointPositionBuffer QuantizedPositionBuffer;
+  FVector3f QuantizedPositionOffset;
+  FVector3f QuantizedPositionScale;
+
   UMaterialInterface* Material;
   FMaterialRelevance MaterialRelevance;
 
   float GetGeometricError() const;
 
+  /**
+   * Gets the number of points to draw for a view, so that the points that are
+   * drawn are at least the Minimum Point Spacing apart on screen. The points
+   * are shuffled when they are loaded, so the first points are an even
+   * subsample of all of them.
+   */
+  int32 GetNumPointsToDraw(const FSceneView* View) const;
+
   void CreatePointAttenuationUserData(
       FMeshBatchElement& BatchElement,
       const FSceneView* View,
@@ -89,6 +116,7 @@ private:
   void CreateMeshWithAttenuation(
       FMeshBatch& Mesh,
       const FSceneView* View,
-      FMeshElementCollector& Collector) const;
-  void CreateMesh(FMeshBatch& Mesh) const;
+      FMeshElementCollector& Collector,
+      int32 NumPointsToDraw) const;
+  void CreateMesh(FMeshBatch& Mesh, int32 NumPointsToDraw) const;
 };
@@ -12,41 +12,74 @@
  */
 class FCesiumGltfPointsSceneProxyUpdater {
 public:
-  /** Updates proxies with new tileset settings. Must be called from a game
-   * thread. */
+  /**
+   * Gets the settings shared by the points scene proxies of a tileset,
+   * creating them from the current tileset settings if this is the first
+   * proxy. Must be called from a game thread.
+   */
+  static TSharedRef<
+      const FCesiumGltfPointsSceneProxyTilesetSettings,
+      ESPMode::ThreadSafe>
+  GetSharedSettings(ACesium3DTileset* Tileset) {
+    check(IsInGameThread());
+    if (!Tileset->_pPointsSceneProxySettings) {
+      Tileset->_pPointsSceneProxySettings =
+          MakeShared<
+              FCesiumGltfPointsSceneProxyTilesetSettings,
+              ESPMode::ThreadSafe>(GetSettings(Tileset));
+    }
+    return Tileset->_pPointsSceneProxySettings.ToSharedRef();
+  }
+
+  /**
+   * Updates proxies with new tileset settings. Must be called from a game
+   * thread.
+   *
+   * All of the proxies of a tileset share its settings, so a single render
+   * command updates them, regardless of how many proxies there are. Only
+   * when eye-dome lighting is switched on or off are the points components
+   * visited, to change whether they render custom depth.
+   */
   static void UpdateSettingsInProxies(ACesium3DTileset* Tileset) {
     if (!IsValid(Tileset) || !IsInGameThread()) {
       return;
     }
 
-    TInlineComponentArray<UCesiumGltfPointsComponent*> ComponentArray;
-    Tileset->GetComponents<UCesiumGltfPointsComponent>(ComponentArray);
+    const bool bEyeDomeLighting =
+        Tileset->GetPointCloudShading().EyeDomeLighting;
+    if (bEyeDomeLighting != Tileset->_pointsUseEyeDomeLighting) {
+      Tileset->_pointsUseEyeDomeLighting = bEyeDomeLighting;
 
-    // Used to pass tileset data updates to render thread
-    TArray<FCesiumGltfPointsSceneProxy*> SceneProxies;
-    TArray<FCesiumGltfPointsSceneProxyTilesetData> ProxyTilesetData;
-
-    for (UCesiumGltfPointsComponent* PointsComponent : ComponentArray) {
-      FCesiumGltfPointsSceneProxy* PointsProxy =
-          static_cast<FCesiumGltfPointsSceneProxy*>(
-              PointsComponent->SceneProxy);
-      if (PointsProxy) {
-        SceneProxies.Add(PointsProxy);
+      // Eye-dome lighting finds the point clouds by their custom depth.
+      const bool bRenderCustomDepth =
+          bEyeDomeLighting ||
+          Tileset->GetCustomDepthParameters().RenderCustomDepth;
+      TInlineComponentArray<UCesiumGltfPointsComponent*> ComponentArray;
+      Tileset->GetComponents<UCesiumGltfPointsComponent>(ComponentArray);
+      for (UCesiumGltfPointsComponent* PointsComponent : ComponentArray) {
+        PointsComponent->SetRenderCustomDepth(bRenderCustomDepth);
       }
+    }
 
-      FCesiumGltfPointsSceneProxyTilesetData TilesetData;
-      TilesetData.UpdateFromComponent(PointsComponent);
-      ProxyTilesetData.Add(TilesetData);
+    if (!Tileset->_pPointsSceneProxySettings) {
+      // No proxy has been created yet. The first one will get the current
+      // settings.
+      return;
     }
 
-    // Update tileset data
     ENQUEUE_RENDER_COMMAND(TransferCesium3DTilesetSettingsToPointsProxies)
-    ([SceneProxies,
-      ProxyTilesetData](FRHICommandListImmediate& RHICmdList) mutable {
-      // Iterate over proxies and update their data
-      for (int32 i = 0; i < SceneProxies.Num(); i++) {
-        SceneProxies[i]->UpdateTilesetData(ProxyTilesetData[i]);
-      }
+    ([pSettings = Tileset->_pPointsSceneProxySettings,
+      Settings = GetSettings(Tileset)](FRHICommandListImmediate& RHICmdList) {
+      *pSettings = Settings;
     });
   }
+
+private:
+  static FCesiumGltfPointsSceneProxyTilesetSettings
+  GetSettings(const ACesium3DTileset* Tileset) {
+    FCesiumGltfPointsSceneProxyTilesetSettings Settings;
+    Settings.PointCloudShading = Tileset->GetPointCloudShading();
+    Settings.MaximumScreenSpaceError = Tileset->MaximumScreenSpaceError;
+    return Settings;
+  }
 };
@@ -2,6 +2,7 @@
 
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CalcBounds.h"
+#include "CesiumClusterCullingSceneProxy.h"
 #include "CesiumLifetime.h"
 #include "CesiumMaterialUserData.h"
 #include "Engine/Texture.h"
@@ -80,22 +81,74 @@ calcBounds(const ICesiumPrimitive& primitive, const FTransform& LocalToWorld) {
       *primData.boundingVolume);
 }
 
+/**
+ * Combines the bounds of a tile with those of one of its meshes into bounds
+ * that are no larger than either.
+ *
+ * The tile's bounding volume is usually an oriented box, which may fit the
+ * tile well but whose world-aligned box is much larger once the globe is
+ * rotated to the georeference. The mesh's own box is computed from its
+ * vertices, and fits the mesh rather than the whole tile, but grows the same
+ * way. Both contain the mesh, so their overlap does too.
+ */
+FBoxSphereBounds combineBounds(
+    const FBoxSphereBounds& tileBounds,
+    const FBoxSphereBounds& meshBounds) {
+  if (meshBounds.SphereRadius <= 0.0 && meshBounds.BoxExtent.IsZero()) {
+    // The mesh has no vertices yet, such as an instanced mesh without
+    // instances, so its bounds say nothing.
+    return tileBounds;
+  }
+
+  const FBox overlap = tileBounds.GetBox().Overlap(meshBounds.GetBox());
+  if (!overlap.IsValid) {
+    // The mesh doesn't lie within its tile's bounding volume, so the
+    // bounding volume is wrong.
+    return meshBounds;
+  }
+
+  FBoxSphereBounds result;
+  overlap.GetCenterAndExtents(result.Origin, result.BoxExtent);
+
+  // Each sphere also contains the mesh, so one centered on the overlap that
+  // encloses either of them does too.
+  const double tileRadius =
+      FVector::Dist(result.Origin, tileBounds.Origin) + tileBounds.SphereRadius;
+  const double meshRadius =
+      FVector::Dist(result.Origin, meshBounds.Origin) + meshBounds.SphereRadius;
+  result.SphereRadius =
+      FMath::Min3(result.BoxExtent.Size(), tileRadius, meshRadius);
+  return result;
+}
+
 } // namespace
 
 FBoxSphereBounds UCesiumGltfPrimitiveComponent::CalcBounds(
     const FTransform& LocalToWorld) const {
+  const FBoxSphereBounds meshBounds = Super::CalcBounds(LocalToWorld);
   if (auto bounds = calcBounds(*this, LocalToWorld)) {
-    return *bounds;
+    return combineBounds(*bounds, meshBounds);
   }
-  return Super::CalcBounds(LocalToWorld);
+  return meshBounds;
+}
+
+FPrimitiveSceneProxy* UCesiumGltfPrimitiveComponent::CreateSceneProxy() {
+  UStaticMesh* pMesh = this->GetStaticMesh();
+  if (this->_cesiumData.Clusters.IsEmpty() || !IsValid(pMesh) ||
+      !pMesh->GetRenderData() || pMesh->HasValidNaniteData()) {
+    return Super::CreateSceneProxy();
+  }
+
+  return new FCesiumClusterCullingSceneProxy(this, this->_cesiumData.Clusters);
 }
 
 FBoxSphereBounds UCesiumGltfInstancedComponent::CalcBounds(
     const FTransform& LocalToWorld) const {
+  const FBoxSphereBounds meshBounds = Super::CalcBounds(LocalToWorld);
   if (auto bounds = calcBounds(*this, LocalToWorld)) {
-    return *bounds;
+    return combineBounds(*bounds, meshBounds);
   }
-  return Super::CalcBounds(LocalToWorld);
+  return meshBounds;
 }
 
 namespace {
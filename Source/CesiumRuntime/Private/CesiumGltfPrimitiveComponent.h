@@ -33,6 +33,8 @@ public:
 
   FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
 
+  FPrimitiveSceneProxy* CreateSceneProxy() override;
+
   void
   UpdateTransformFromCesium(const glm::dmat4& CesiumToUnrealTransform) override;
 
@@ -0,0 +1,30 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfTerrainHeightmapComponent.h"
+#include "CesiumTerrainHeightmapSceneProxy.h"
+#include "DataDrivenShaderPlatformInfo.h"
+#include "SceneInterface.h"
+
+// Sets default values for this component's properties
+UCesiumGltfTerrainHeightmapComponent::UCesiumGltfTerrainHeightmapComponent()
+    : Heightmap() {}
+
+UCesiumGltfTerrainHeightmapComponent::~UCesiumGltfTerrainHeightmapComponent() {}
+
+FPrimitiveSceneProxy*
+UCesiumGltfTerrainHeightmapComponent::CreateSceneProxy() {
+  if (!IsValid(this)) {
+    return nullptr;
+  }
+
+  // Heightmaps are only created where manual vertex fetch is supported.
+  FSceneInterface* pScene = GetScene();
+  if (!this->Heightmap || !pScene ||
+      !RHISupportsManualVertexFetch(pScene->GetShaderPlatform())) {
+    return Super::CreateSceneProxy();
+  }
+
+  return new FCesiumTerrainHeightmapSceneProxy(
+      this,
+      pScene->GetFeatureLevel());
+}
@@ -0,0 +1,30 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumTerrainHeightmap.h"
+#include "CesiumGltfTerrainHeightmapComponent.generated.h"
+
+/**
+ * A primitive component for a terrain tile that is drawn from a heightmap. The
+ * heightmap is drawn by a FCesiumTerrainHeightmapSceneProxy, and the static
+ * mesh only has a placeholder vertex, while the collision of the tile is
+ * still built from its triangles.
+ */
+UCLASS()
+class UCesiumGltfTerrainHeightmapComponent
+    : public UCesiumGltfPrimitiveComponent {
+  GENERATED_BODY()
+
+public:
+  // Sets default values for this component's properties
+  UCesiumGltfTerrainHeightmapComponent();
+  virtual ~UCesiumGltfTerrainHeightmapComponent();
+
+  // The heightmap of the terrain tile.
+  CesiumTerrainHeightmap::SharedHeightmap Heightmap;
+
+  // Override UPrimitiveComponent interface.
+  virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+};
@@ -0,0 +1,30 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfVoxelComponent.h"
+#include "Cesium3DTileset.h"
+#include "CesiumVoxelSceneProxy.h"
+#include "SceneInterface.h"
+
+// Sets default values for this component's properties
+UCesiumGltfVoxelComponent::UCesiumGltfVoxelComponent() : Brick() {}
+
+UCesiumGltfVoxelComponent::~UCesiumGltfVoxelComponent() {}
+
+FPrimitiveSceneProxy* UCesiumGltfVoxelComponent::CreateSceneProxy() {
+  if (!IsValid(this)) {
+    return nullptr;
+  }
+
+  // Voxels are only drawn with shader model 5, and the placeholder mesh has
+  // nothing to draw.
+  FSceneInterface* pScene = GetScene();
+  if (!this->Brick || !pScene ||
+      pScene->GetFeatureLevel() < ERHIFeatureLevel::SM5) {
+    return nullptr;
+  }
+
+  const ACesium3DTileset* pTileset = getPrimitiveData().pTilesetActor;
+  return new FCesiumVoxelSceneProxy(
+      this,
+      pTileset ? pTileset->GetVoxelRendering() : FCesiumVoxelRendering());
+}
@@ -0,0 +1,28 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumVoxels.h"
+#include "CesiumGltfVoxelComponent.generated.h"
+
+/**
+ * A primitive component for a glTF primitive with the EXT_primitive_voxels
+ * extension. Its voxels are raymarched by a FCesiumVoxelSceneProxy, in place
+ * of the placeholder static mesh.
+ */
+UCLASS()
+class UCesiumGltfVoxelComponent : public UCesiumGltfPrimitiveComponent {
+  GENERATED_BODY()
+
+public:
+  // Sets default values for this component's properties
+  UCesiumGltfVoxelComponent();
+  virtual ~UCesiumGltfVoxelComponent();
+
+  // The brick of the voxels' drawn attribute.
+  CesiumVoxels::SharedBrick Brick;
+
+  // Override UPrimitiveComponent interface.
+  virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+};
@@ -0,0 +1,19 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumHLODSource.h"
+#include "Cesium3DTileset.h"
+#include "CesiumHLODSourceComponent.h"
+
+ACesiumHLODSource::ACesiumHLODSource() : AActor() {
+  PrimaryActorTick.bCanEverTick = false;
+
+  this->Box = CreateDefaultSubobject<UCesiumHLODSourceComponent>(TEXT("Box"));
+  this->SetRootComponent(this->Box);
+  this->SetActorHiddenInGame(true);
+}
+
+#if WITH_EDITOR
+bool ACesiumHLODSource::IsHLODRelevant() const {
+  return !this->Tileset.IsNull();
+}
+#endif
@@ -0,0 +1,15 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumHLODSourceComponent.h"
+
+UCesiumHLODSourceComponent::UCesiumHLODSourceComponent() {
+  this->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  this->SetCanEverAffectNavigation(false);
+  this->SetHiddenInGame(true);
+  this->bEnableAutoLODGeneration = true;
+  this->BoxExtent = FVector(50000.0);
+}
+
+#if WITH_EDITOR
+bool UCesiumHLODSourceComponent::IsHLODRelevant() const { return true; }
+#endif
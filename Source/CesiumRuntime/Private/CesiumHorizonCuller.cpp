@@ -0,0 +1,162 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumHorizonCuller.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <glm/geometric.hpp>
+#include <optional>
+#include <variant>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+
+struct GetBoundingBox {
+  CesiumGeometry::OrientedBoundingBox
+  operator()(const CesiumGeometry::BoundingSphere& sphere) const {
+    return CesiumGeometry::OrientedBoundingBox(
+        sphere.getCenter(),
+        glm::dmat3(sphere.getRadius()));
+  }
+
+  CesiumGeometry::OrientedBoundingBox
+  operator()(const CesiumGeometry::OrientedBoundingBox& box) const {
+    return box;
+  }
+
+  CesiumGeometry::OrientedBoundingBox
+  operator()(const CesiumGeospatial::BoundingRegion& region) const {
+    return region.getBoundingBox();
+  }
+
+  CesiumGeometry::OrientedBoundingBox operator()(
+      const CesiumGeospatial::BoundingRegionWithLooseFittingHeights& region)
+      const {
+    return region.getBoundingRegion().getBoundingBox();
+  }
+
+  CesiumGeometry::OrientedBoundingBox
+  operator()(const CesiumGeospatial::S2CellBoundingVolume& s2) const {
+    return s2.computeBoundingRegion().getBoundingBox();
+  }
+};
+
+/**
+ * Computes how far along a direction, in scaled space, the horizon culling
+ * point must be for a position to be hidden whenever the point is. Positions
+ * below the ellipsoid are treated as if they were on it.
+ *
+ * @returns The distance, or std::nullopt if the position can't be hidden by
+ * any point along the direction.
+ */
+std::optional<double> computeMagnitude(
+    const glm::dvec3& scaledPosition,
+    const glm::dvec3& scaledDirection) {
+  const double magnitudeSquared = glm::dot(scaledPosition, scaledPosition);
+  if (magnitudeSquared <= 0.0) {
+    return std::nullopt;
+  }
+
+  const double magnitude = glm::sqrt(magnitudeSquared);
+  const glm::dvec3 direction = scaledPosition / magnitude;
+
+  const double clampedMagnitudeSquared = glm::max(1.0, magnitudeSquared);
+  const double clampedMagnitude = glm::max(1.0, magnitude);
+  const double cosAlpha = glm::dot(direction, scaledDirection);
+  const double sinAlpha = glm::length(glm::cross(direction, scaledDirection));
+  const double cosBeta = 1.0 / clampedMagnitude;
+  const double sinBeta = glm::sqrt(clampedMagnitudeSquared - 1.0) * cosBeta;
+
+  const double denominator = cosAlpha * cosBeta - sinAlpha * sinBeta;
+  if (denominator <= 0.0) {
+    return std::nullopt;
+  }
+  return 1.0 / denominator;
+}
+
+/**
+ * Computes the horizon culling point of a box, in scaled space.
+ */
+std::optional<glm::dvec3> computeHorizonCullingPoint(
+    const CesiumGeometry::OrientedBoundingBox& box,
+    const glm::dvec3& inverseRadii) {
+  const glm::dvec3 scaledCenter = box.getCenter() * inverseRadii;
+  const double centerLength = glm::length(scaledCenter);
+  if (centerLength <= 0.0) {
+    return std::nullopt;
+  }
+  const glm::dvec3 scaledDirection = scaledCenter / centerLength;
+
+  const glm::dmat3& halfAxes = box.getHalfAxes();
+  double resultMagnitude = 0.0;
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::dvec3 position =
+        box.getCenter() + ((corner & 1) ? halfAxes[0] : -halfAxes[0]) +
+        ((corner & 2) ? halfAxes[1] : -halfAxes[1]) +
+        ((corner & 4) ? halfAxes[2] : -halfAxes[2]);
+    const std::optional<double> magnitude =
+        computeMagnitude(position * inverseRadii, scaledDirection);
+    if (!magnitude) {
+      return std::nullopt;
+    }
+    resultMagnitude = glm::max(resultMagnitude, *magnitude);
+  }
+
+  return scaledDirection * resultMagnitude;
+}
+
+} // namespace
+
+void CesiumHorizonCuller::setViews(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const std::vector<glm::dvec3>& positions) {
+  this->_inverseRadii = 1.0 / ellipsoid.getRadii();
+  this->_views.clear();
+  this->_views.reserve(positions.size());
+
+  for (const glm::dvec3& position : positions) {
+    const glm::dvec3 scaledPosition = position * this->_inverseRadii;
+    const double horizonDistanceSquared =
+        glm::dot(scaledPosition, scaledPosition) - 1.0;
+    if (horizonDistanceSquared <= 0.0) {
+      // Nothing is hidden by the horizon from inside the ellipsoid, which is
+      // also where the views of tilesets that aren't on a globe usually are.
+      this->_views.clear();
+      return;
+    }
+    this->_views.push_back({scaledPosition, horizonDistanceSquared});
+  }
+}
+
+bool CesiumHorizonCuller::isBelowHorizon(
+    const BoundingVolume& boundingVolume) const {
+  if (this->_views.empty()) {
+    return false;
+  }
+
+  const std::optional<glm::dvec3> maybePoint = computeHorizonCullingPoint(
+      std::visit(GetBoundingBox{}, boundingVolume),
+      this->_inverseRadii);
+  if (!maybePoint) {
+    return false;
+  }
+
+  for (const ScaledView& view : this->_views) {
+    const glm::dvec3 viewToPoint = *maybePoint - view.position;
+    const double distanceAlongView = -glm::dot(viewToPoint, view.position);
+    const bool isHidden =
+        distanceAlongView > view.horizonDistanceSquared &&
+        distanceAlongView * distanceAlongView /
+                glm::dot(viewToPoint, viewToPoint) >
+            view.horizonDistanceSquared;
+    if (!isHidden) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool CesiumHorizonCuller::shouldExclude(const Tile& tile) const noexcept {
+  return this->isBelowHorizon(tile.getBoundingVolume());
+}
@@ -0,0 +1,55 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/ITileExcluder.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <glm/vec3.hpp>
+#include <vector>
+
+/**
+ * Excludes the tiles that are hidden behind the horizon of the ellipsoid in
+ * all views. A tile is hidden if a conservative point computed from the
+ * corners of its bounding volume, called the horizon culling point, can't be
+ * seen past the ellipsoid, so tall content that reaches above the horizon is
+ * kept.
+ */
+class CesiumHorizonCuller : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  /**
+   * @brief Sets the views to cull tiles for, until they are set again. Must
+   * not be called while tiles are being selected.
+   *
+   * @param ellipsoid The ellipsoid whose horizon hides tiles.
+   * @param positions The positions of the views, in the coordinates of the
+   * tileset, which are centered on the ellipsoid. If there are none, or any of
+   * them is inside the ellipsoid, no tiles are culled.
+   */
+  void setViews(
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      const std::vector<glm::dvec3>& positions);
+
+  /**
+   * @brief Determines whether a bounding volume is behind the horizon in all
+   * of the views.
+   */
+  bool
+  isBelowHorizon(const Cesium3DTilesSelection::BoundingVolume& boundingVolume)
+      const;
+
+  bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+
+private:
+  // A view, in the scaled space in which the ellipsoid is a unit sphere.
+  struct ScaledView {
+    glm::dvec3 position;
+
+    // The squared distance from the view to the horizon.
+    double horizonDistanceSquared;
+  };
+
+  glm::dvec3 _inverseRadii = glm::dvec3(1.0);
+  std::vector<ScaledView> _views;
+};
@@ -0,0 +1,371 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumInstanceBatches.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumMaterialInstanceCache.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Hash/CityHash.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "VecMath.h"
+
+namespace {
+// The fewest free instances in a batch for which it is compacted, so that
+// small batches aren't rebuilt over and over as tiles come and go.
+constexpr int32 MinimumFreeInstancesToCompact = 1024;
+
+const FTransform HiddenTransform(
+    FQuat::Identity,
+    FVector::ZeroVector,
+    FVector::ZeroVector);
+
+void addParameterInfo(
+    TArray<uint64>& words,
+    const FMaterialParameterInfo& info) {
+  words.Add(GetTypeHash(info.Name));
+  words.Add(uint64(info.Association));
+  words.Add(uint64(uint32(info.Index)));
+}
+
+FTransform computeNodeToRoot(
+    const glm::dmat4& nodeTransform,
+    const glm::dmat4& cesiumToUnrealTransform) {
+  return FTransform(
+      VecMath::createMatrix(cesiumToUnrealTransform * nodeTransform));
+}
+} // namespace
+
+CesiumInstanceBatches::CesiumInstanceBatches(ACesium3DTileset* pTilesetActor)
+    : _pTilesetActor(pTilesetActor), _batches(), _tiles() {}
+
+/*static*/ uint64 CesiumInstanceBatches::computeKey(
+    uint64 geometryHash,
+    const UMaterialInterface* pBaseMaterial,
+    const CesiumMaterialParameters& parameters) {
+  // Shared textures are found by their content, so the textures of identical
+  // images in different tiles are the same objects.
+  TArray<uint64> words;
+  words.Add(uint64(UPTRINT(pBaseMaterial)));
+  for (const FScalarParameterValue& scalar : parameters.scalars) {
+    addParameterInfo(words, scalar.ParameterInfo);
+    words.Add(uint64(GetTypeHash(scalar.ParameterValue)));
+  }
+  for (const FVectorParameterValue& vector : parameters.vectors) {
+    addParameterInfo(words, vector.ParameterInfo);
+    words.Add(uint64(GetTypeHash(vector.ParameterValue)));
+  }
+  for (const FTextureParameterValue& texture : parameters.textures) {
+    addParameterInfo(words, texture.ParameterInfo);
+    words.Add(uint64(UPTRINT(texture.ParameterValue.Get())));
+  }
+
+  const uint64 key = CityHash64WithSeed(
+      reinterpret_cast<const char*>(words.GetData()),
+      uint32(words.Num() * sizeof(uint64)),
+      geometryHash);
+
+  // Zero is the key of primitives that can't be batched.
+  return key == 0 ? 1 : key;
+}
+
+bool CesiumInstanceBatches::addToBatch(
+    uint64 key,
+    const UCesiumGltfComponent& gltf,
+    const glm::dmat4& nodeTransform,
+    const glm::dmat4& cesiumToUnrealTransform,
+    const TArray<FTransform>& instanceTransforms) {
+  Batch* pBatch = this->_batches.Find(key);
+  if (!pBatch || !IsValid(pBatch->pComponent)) {
+    return false;
+  }
+
+  this->addRange(
+      key,
+      *pBatch,
+      gltf,
+      nodeTransform,
+      cesiumToUnrealTransform,
+      instanceTransforms);
+  return true;
+}
+
+void CesiumInstanceBatches::createBatch(
+    uint64 key,
+    const UCesiumGltfComponent& gltf,
+    UInstancedStaticMeshComponent& primitive,
+    const glm::dmat4& nodeTransform,
+    const glm::dmat4& cesiumToUnrealTransform,
+    const TArray<FTransform>& instanceTransforms) {
+  ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  if (!pTilesetActor || this->_batches.Contains(key)) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateInstanceBatch)
+
+  UHierarchicalInstancedStaticMeshComponent* pComponent =
+      NewObject<UHierarchicalInstancedStaticMeshComponent>(pTilesetActor);
+  pComponent->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pComponent->SetMobility(primitive.Mobility);
+  pComponent->BodyInstance.CopyBodyInstancePropertiesFrom(
+      &primitive.BodyInstance);
+  pComponent->SetRenderCustomDepth(primitive.bRenderCustomDepth);
+  pComponent->SetCustomDepthStencilWriteMask(
+      primitive.CustomDepthStencilWriteMask);
+  pComponent->SetCustomDepthStencilValue(primitive.CustomDepthStencilValue);
+  pComponent->bCastDynamicShadow = primitive.bCastDynamicShadow;
+  pComponent->RuntimeVirtualTextures = primitive.RuntimeVirtualTextures;
+  pComponent->VirtualTextureRenderPassType =
+      primitive.VirtualTextureRenderPassType;
+  pComponent->ShadowCacheInvalidationBehavior =
+      primitive.ShadowCacheInvalidationBehavior;
+  pComponent->SetCanEverAffectNavigation(false);
+
+  // The static mesh holds the material, so the primitive gives up both, and
+  // neither is destroyed with its tile.
+  pComponent->SetStaticMesh(primitive.GetStaticMesh());
+  primitive.ClearInstances();
+  primitive.SetStaticMesh(nullptr);
+
+  pComponent->SetupAttachment(pTilesetActor->GetRootComponent());
+  pComponent->RegisterComponent();
+
+  Batch& batch = this->_batches.Add(key);
+  batch.pComponent = pComponent;
+  this->addRange(
+      key,
+      batch,
+      gltf,
+      nodeTransform,
+      cesiumToUnrealTransform,
+      instanceTransforms);
+}
+
+void CesiumInstanceBatches::remove(const UCesiumGltfComponent& gltf) {
+  TArray<TileRange> tileRanges;
+  if (!this->_tiles.RemoveAndCopyValue(&gltf, tileRanges)) {
+    return;
+  }
+
+  for (const TileRange& tileRange : tileRanges) {
+    Batch* pBatch = this->_batches.Find(tileRange.key);
+    if (!pBatch || !pBatch->ranges.IsValidIndex(tileRange.range)) {
+      continue;
+    }
+
+    Range& range = pBatch->ranges[tileRange.range];
+    range.visible = false;
+    this->writeRange(*pBatch, range);
+    pBatch->freeRanges.Add(FreeRange{range.first, range.instances.Num()});
+    pBatch->freeCount += range.instances.Num();
+    pBatch->ranges.RemoveAt(tileRange.range);
+
+    if (pBatch->ranges.IsEmpty()) {
+      this->destroyBatch(*pBatch);
+      this->_batches.Remove(tileRange.key);
+    } else if (
+        pBatch->freeCount >= MinimumFreeInstancesToCompact &&
+        IsValid(pBatch->pComponent) &&
+        2 * pBatch->freeCount > pBatch->pComponent->GetInstanceCount()) {
+      this->compact(*pBatch);
+    }
+  }
+}
+
+void CesiumInstanceBatches::setVisibility(
+    const UCesiumGltfComponent& gltf,
+    bool visible) {
+  const TArray<TileRange>* pTileRanges = this->_tiles.Find(&gltf);
+  if (!pTileRanges) {
+    return;
+  }
+
+  for (const TileRange& tileRange : *pTileRanges) {
+    Batch* pBatch = this->_batches.Find(tileRange.key);
+    if (!pBatch || !pBatch->ranges.IsValidIndex(tileRange.range)) {
+      continue;
+    }
+
+    Range& range = pBatch->ranges[tileRange.range];
+    if (range.visible != visible) {
+      range.visible = visible;
+      this->writeRange(*pBatch, range);
+    }
+  }
+}
+
+void CesiumInstanceBatches::setCustomDepthParameters(
+    const FCustomDepthParameters& parameters) {
+  for (TPair<uint64, Batch>& pair : this->_batches) {
+    UHierarchicalInstancedStaticMeshComponent* pComponent =
+        pair.Value.pComponent;
+    if (!pComponent) {
+      continue;
+    }
+    pComponent->SetRenderCustomDepth(parameters.RenderCustomDepth);
+    pComponent->SetCustomDepthStencilWriteMask(
+        parameters.CustomDepthStencilWriteMask);
+    pComponent->SetCustomDepthStencilValue(parameters.CustomDepthStencilValue);
+  }
+}
+
+void CesiumInstanceBatches::updateTransforms(
+    const glm::dmat4& cesiumToUnrealTransform) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateInstanceBatchTransforms)
+
+  for (TPair<uint64, Batch>& pair : this->_batches) {
+    Batch& batch = pair.Value;
+    for (Range& range : batch.ranges) {
+      range.nodeToRoot =
+          computeNodeToRoot(range.nodeTransform, cesiumToUnrealTransform);
+      if (range.visible) {
+        this->writeRange(batch, range);
+      }
+    }
+  }
+}
+
+void CesiumInstanceBatches::clear() {
+  for (TPair<uint64, Batch>& pair : this->_batches) {
+    this->destroyBatch(pair.Value);
+  }
+  this->_batches.Empty();
+  this->_tiles.Empty();
+}
+
+void CesiumInstanceBatches::AddReferencedObjects(
+    FReferenceCollector& Collector) {
+  for (TPair<uint64, Batch>& pair : this->_batches) {
+    Collector.AddReferencedObject(pair.Value.pComponent);
+  }
+}
+
+FString CesiumInstanceBatches::GetReferencerName() const {
+  return TEXT("CesiumInstanceBatches");
+}
+
+void CesiumInstanceBatches::addRange(
+    uint64 key,
+    Batch& batch,
+    const UCesiumGltfComponent& gltf,
+    const glm::dmat4& nodeTransform,
+    const glm::dmat4& cesiumToUnrealTransform,
+    const TArray<FTransform>& instanceTransforms) {
+  const int32 count = instanceTransforms.Num();
+
+  Range range;
+  range.first = INDEX_NONE;
+  range.visible = gltf.GetVisibleFlag();
+  range.nodeTransform = nodeTransform;
+  range.nodeToRoot = computeNodeToRoot(nodeTransform, cesiumToUnrealTransform);
+  range.instances = instanceTransforms;
+
+  // Reuse the first free range that is big enough, if any.
+  for (int32 i = 0; i < batch.freeRanges.Num(); ++i) {
+    FreeRange& free = batch.freeRanges[i];
+    if (free.count < count) {
+      continue;
+    }
+
+    range.first = free.first;
+    free.first += count;
+    free.count -= count;
+    batch.freeCount -= count;
+    if (free.count == 0) {
+      batch.freeRanges.RemoveAtSwap(i, 1, false);
+    }
+    break;
+  }
+
+  if (range.first == INDEX_NONE) {
+    range.first = batch.pComponent->GetInstanceCount();
+    TArray<FTransform> hidden;
+    hidden.Init(HiddenTransform, count);
+    batch.pComponent->AddInstances(hidden, false);
+  }
+
+  if (range.visible) {
+    this->writeRange(batch, range);
+  }
+
+  const int32 rangeIndex = batch.ranges.Add(MoveTemp(range));
+  this->_tiles.FindOrAdd(&gltf).Add(TileRange{key, rangeIndex});
+}
+
+void CesiumInstanceBatches::writeRange(Batch& batch, const Range& range) {
+  if (!IsValid(batch.pComponent) || range.instances.IsEmpty()) {
+    return;
+  }
+
+  TArray<FTransform> transforms;
+  if (range.visible) {
+    transforms.Reserve(range.instances.Num());
+    for (const FTransform& instance : range.instances) {
+      transforms.Add(instance * range.nodeToRoot);
+    }
+  } else {
+    transforms.Init(HiddenTransform, range.instances.Num());
+  }
+
+  batch.pComponent->BatchUpdateInstancesTransforms(
+      range.first,
+      transforms,
+      /*bWorldSpace*/ false,
+      /*bMarkRenderStateDirty*/ true,
+      /*bTeleport*/ true);
+}
+
+void CesiumInstanceBatches::compact(Batch& batch) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CompactInstanceBatch)
+
+  // The ranges keep their indices, so the tiles' references to them stay
+  // valid; only the instances that they refer to move.
+  TArray<FTransform> transforms;
+  for (Range& range : batch.ranges) {
+    range.first = transforms.Num();
+    for (const FTransform& instance : range.instances) {
+      transforms.Add(
+          range.visible ? instance * range.nodeToRoot : HiddenTransform);
+    }
+  }
+
+  batch.pComponent->ClearInstances();
+  batch.pComponent->AddInstances(transforms, false);
+  batch.freeRanges.Empty();
+  batch.freeCount = 0;
+}
+
+void CesiumInstanceBatches::destroyBatch(Batch& batch) {
+  UHierarchicalInstancedStaticMeshComponent* pComponent = batch.pComponent;
+  batch.pComponent = nullptr;
+  if (!IsValid(pComponent)) {
+    return;
+  }
+
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+
+  UStaticMesh* pMesh = pComponent->GetStaticMesh();
+  pComponent->SetStaticMesh(nullptr);
+  if (pMesh) {
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pMesh->GetMaterial(0));
+    if (pMaterial) {
+      CesiumLifetime::destroy(pMaterial);
+    }
+
+    UBodySetup* pBodySetup = pMesh->GetBodySetup();
+    if (pBodySetup) {
+      CesiumLifetime::destroy(pBodySetup);
+    }
+
+    CesiumLifetime::destroy(pMesh);
+  }
+
+  CesiumLifetime::destroyComponentRecursively(pComponent);
+}
@@ -0,0 +1,169 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/SparseArray.h"
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include <glm/mat4x4.hpp>
+
+class ACesium3DTileset;
+class UCesiumGltfComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+struct CesiumMaterialParameters;
+struct FCustomDepthParameters;
+
+/**
+ * Draws the instances of the EXT_mesh_gpu_instancing primitives of all of a
+ * tileset's tiles that have the same mesh and material with a single
+ * hierarchical instanced static mesh component.
+ *
+ * Otherwise each instanced primitive of each tile gets its own instanced
+ * static mesh component, so a dataset of trees or poles spread over thousands
+ * of tiles draws the same mesh with thousands of draw calls. Here, the first
+ * tile that loads a particular mesh and material creates a batch from its
+ * primitive, which gives the batch its static mesh, its material, and its
+ * instances. The primitives with the same mesh and material in tiles loaded
+ * later don't get a component at all; their instances are added to the batch.
+ *
+ * The instances of each primitive occupy a range of the batch's instances,
+ * which doesn't move while its tile is loaded, even as other tiles are loaded
+ * and unloaded. Hiding a tile collapses the instances of its ranges to zero
+ * scale. Unloading it frees its ranges, which are reused for the instances of
+ * tiles loaded later. The instances are only compacted, giving the ranges new
+ * places, when most of a batch is free.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumInstanceBatches : public FGCObject {
+public:
+  CesiumInstanceBatches(ACesium3DTileset* pTilesetActor);
+
+  /**
+   * @brief Computes the key of the batch for the instances of a primitive,
+   * from the hash of its geometry and the values that its material is created
+   * with.
+   */
+  static uint64 computeKey(
+      uint64 geometryHash,
+      const UMaterialInterface* pBaseMaterial,
+      const CesiumMaterialParameters& parameters);
+
+  /**
+   * @brief Adds the instances of a primitive to the batch with the given key,
+   * if there is one.
+   *
+   * @param key The key of the batch, from {@link computeKey}.
+   * @param gltf The glTF component of the primitive's tile.
+   * @param nodeTransform The transform of the primitive's glTF node.
+   * @param cesiumToUnrealTransform The transform from the tileset's
+   * coordinates to the coordinates of its root component.
+   * @param instanceTransforms The transforms of the instances, relative to the
+   * node.
+   * @returns Whether there is a batch with the key, which now includes the
+   * instances.
+   */
+  bool addToBatch(
+      uint64 key,
+      const UCesiumGltfComponent& gltf,
+      const glm::dmat4& nodeTransform,
+      const glm::dmat4& cesiumToUnrealTransform,
+      const TArray<FTransform>& instanceTransforms);
+
+  /**
+   * @brief Creates the batch with the given key from an instanced primitive
+   * component, which gives the batch its static mesh and its instances. The
+   * component is left without either.
+   */
+  void createBatch(
+      uint64 key,
+      const UCesiumGltfComponent& gltf,
+      UInstancedStaticMeshComponent& primitive,
+      const glm::dmat4& nodeTransform,
+      const glm::dmat4& cesiumToUnrealTransform,
+      const TArray<FTransform>& instanceTransforms);
+
+  /**
+   * @brief Removes the instances of a tile from the batches. Batches that are
+   * left without instances are destroyed.
+   */
+  void remove(const UCesiumGltfComponent& gltf);
+
+  /**
+   * @brief Shows or hides the instances of a tile.
+   */
+  void setVisibility(const UCesiumGltfComponent& gltf, bool visible);
+
+  /**
+   * @brief Moves the instances of all tiles for a new transform from the
+   * tileset's coordinates to the coordinates of its root component.
+   */
+  void updateTransforms(const glm::dmat4& cesiumToUnrealTransform);
+
+  /**
+   * @brief Sets the custom depth parameters of all batches, which were taken
+   * from the tileset when they were created.
+   */
+  void setCustomDepthParameters(const FCustomDepthParameters& parameters);
+
+  /**
+   * @brief Destroys all batches.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of batches, which is the number of draw calls
+   * that the instances of all tiles take, per mesh section.
+   */
+  int32 getBatchCount() const { return this->_batches.Num(); }
+
+  // FGCObject
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  struct Range {
+    int32 first;
+    bool visible;
+    glm::dmat4 nodeTransform;
+    FTransform nodeToRoot;
+    TArray<FTransform> instances;
+  };
+
+  struct FreeRange {
+    int32 first;
+    int32 count;
+  };
+
+  struct Batch {
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> pComponent;
+    TSparseArray<Range> ranges;
+    TArray<FreeRange> freeRanges;
+    int32 freeCount = 0;
+  };
+
+  struct TileRange {
+    uint64 key;
+    int32 range;
+  };
+
+  void addRange(
+      uint64 key,
+      Batch& batch,
+      const UCesiumGltfComponent& gltf,
+      const glm::dmat4& nodeTransform,
+      const glm::dmat4& cesiumToUnrealTransform,
+      const TArray<FTransform>& instanceTransforms);
+  void writeRange(Batch& batch, const Range& range);
+  void compact(Batch& batch);
+  void destroyBatch(Batch& batch);
+
+  TWeakObjectPtr<ACesium3DTileset> _pTilesetActor;
+  TMap<uint64, Batch> _batches;
+
+  // The ranges of the instances of each tile, by its glTF component. The
+  // components are only used as keys here, never dereferenced.
+  TMap<const UCesiumGltfComponent*, TArray<TileRange>> _tiles;
+};
@@ -2,35 +2,132 @@
 
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "Engine/Selection.h"
 #endif
+#include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "RenderingThread.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshResources.h"
 #include "UObject/Object.h"
-#include <algorithm>
 
-/*static*/
-AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
+namespace {
 
-/*static*/ void CesiumLifetime::destroy(UObject* pObject) {
-  amortizedDestructor.destroy(pObject);
+struct LargestFirst {
+  template <typename T> bool operator()(const T& a, const T& b) const {
+    return a.bytes > b.bytes;
+  }
+};
+
+int64 estimateBytes(UObject* pObject) {
+  if (pObject->HasAnyFlags(RF_BeginDestroyed)) {
+    return 0;
+  }
+  return int64(
+      pObject->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal));
 }
 
-/*static*/ void
-CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
+// Estimates the memory held by a tree of components, including the meshes
+// that are destroyed along with them.
+int64 estimateComponentTreeBytes(USceneComponent* pComponent) {
+  int64 bytes = estimateBytes(pComponent);
+
+  UStaticMeshComponent* pMeshComponent =
+      Cast<UStaticMeshComponent>(pComponent);
+  if (pMeshComponent && pMeshComponent->GetStaticMesh()) {
+    bytes += estimateBytes(pMeshComponent->GetStaticMesh());
+  }
+
+  for (USceneComponent* pChild : pComponent->GetAttachChildren()) {
+    if (pChild) {
+      bytes += estimateComponentTreeBytes(pChild);
+    }
+  }
+
+  return bytes;
+}
+
+// Frees the GPU and CPU memory held by an object's render and physics
+// resources right away, ahead of the destruction of the object itself, which
+// may be deferred. The object must no longer be used by a registered
+// component.
+void releaseRenderResources(UObject* pObject) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseRenderResources)
+
+  if (pObject->HasAnyFlags(RF_BeginDestroyed)) {
+    // Destruction already released them.
+    return;
+  }
+
+  UTexture2D* pTexture2D = Cast<UTexture2D>(pObject);
+  if (pTexture2D) {
+    pTexture2D->ReleaseResource();
+
+    // The resource is released on the render thread, so the platform data is
+    // deleted there too, after it.
+    FTexturePlatformData* pPlatformData = pTexture2D->GetPlatformData();
+    if (pPlatformData) {
+      pTexture2D->SetPlatformData(nullptr);
+      ENQUEUE_RENDER_COMMAND(Cesium_DeleteTexturePlatformData)
+      ([pPlatformData](FRHICommandListImmediate& RHICmdList) {
+        delete pPlatformData;
+      });
+    }
+  }
+
+  UStaticMesh* pMesh = Cast<UStaticMesh>(pObject);
+  if (pMesh) {
+    pMesh->ReleaseResources();
+  }
+
+  UBodySetup* pBodySetup = Cast<UBodySetup>(pObject);
+  if (pBodySetup) {
+    pBodySetup->ClearPhysicsMeshes();
+  }
+}
+
+// Removes a tree of components from the scene and the physics scene, and
+// releases the resources of its meshes, so that only the UObjects themselves
+// remain to be destroyed.
+void unregisterComponentTree(USceneComponent* pComponent) {
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+
+  UStaticMeshComponent* pMeshComponent =
+      Cast<UStaticMeshComponent>(pComponent);
+  UStaticMesh* pMesh =
+      pMeshComponent ? pMeshComponent->GetStaticMesh() : nullptr;
+  if (pMesh) {
+    releaseRenderResources(pMesh);
+    if (pMesh->GetBodySetup()) {
+      releaseRenderResources(pMesh->GetBodySetup());
+    }
+  }
+
+  for (USceneComponent* pChild : pComponent->GetAttachChildren()) {
+    if (pChild) {
+      unregisterComponentTree(pChild);
+    }
+  }
+}
+
+void destroyComponentTree(USceneComponent* pComponent) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DestroyComponent)
   UE_LOG(
       LogCesium,
       VeryVerbose,
       TEXT("Destroying scene component recursively"));
 
-  if (!pComponent) {
+  if (!pComponent || pComponent->IsBeingDestroyed() ||
+      pComponent->HasAnyFlags(RF_BeginDestroyed)) {
     return;
   }
 
@@ -40,7 +137,7 @@ CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
 
   TArray<USceneComponent*> children = pComponent->GetAttachChildren();
   for (USceneComponent* pChild : children) {
-    destroyComponentRecursively(pChild);
+    destroyComponentTree(pChild);
   }
 
 #if WITH_EDITOR
@@ -59,6 +156,28 @@ CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
   UE_LOG(LogCesium, VeryVerbose, TEXT("Destroying scene component done"));
 }
 
+} // namespace
+
+/*static*/
+AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
+
+/*static*/ void CesiumLifetime::destroy(UObject* pObject) {
+  amortizedDestructor.destroy(pObject);
+}
+
+/*static*/ void
+CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
+  amortizedDestructor.destroyComponentRecursively(pComponent);
+}
+
+/*static*/ int32 CesiumLifetime::getPendingDestructionCount() {
+  return amortizedDestructor.getPendingCount();
+}
+
+/*static*/ int64 CesiumLifetime::getPendingDestructionBytes() {
+  return amortizedDestructor.getPendingBytes();
+}
+
 void AmortizedDestructor::Tick(float DeltaTime) { processPending(); }
 
 ETickableTickType AmortizedDestructor::GetTickableTickType() const {
@@ -69,12 +188,49 @@ bool AmortizedDestructor::IsTickableWhenPaused() const { return true; }
 
 bool AmortizedDestructor::IsTickableInEditor() const { return true; }
 
-TStatId AmortizedDestructor::GetStatId() const { return TStatId(); }
+TStatId AmortizedDestructor::GetStatId() const {
+  return GET_STATID(STAT_CesiumAmortizedDestruction);
+}
 
 void AmortizedDestructor::destroy(UObject* pObject) {
-  if (!runDestruction(pObject)) {
-    addToPending(pObject);
+  if (!pObject) {
+    return;
+  }
+
+  if (this->isBudgetExhausted()) {
+    // Free the memory now, and leave only the UObject for later.
+    releaseRenderResources(pObject);
+    this->addToPending(pObject, estimateBytes(pObject), false);
+    return;
+  }
+
+  // Estimate the size now, because it can't be estimated once the object has
+  // begun to be destroyed.
+  const int64 bytes = estimateBytes(pObject);
+  const double startTime = FPlatformTime::Seconds();
+  if (!this->runDestruction(pObject)) {
+    this->addToPending(pObject, bytes, false);
   }
+  this->recordTime(startTime);
+}
+
+void AmortizedDestructor::destroyComponentRecursively(
+    USceneComponent* pComponent) {
+  if (!pComponent) {
+    return;
+  }
+
+  if (!this->isBudgetExhausted()) {
+    const double startTime = FPlatformTime::Seconds();
+    destroyComponentTree(pComponent);
+    this->recordTime(startTime);
+    return;
+  }
+
+  // The tree must disappear this frame, and its memory is freed now too, so
+  // only the destruction of the components themselves is deferred.
+  unregisterComponentTree(pComponent);
+  this->addToPending(pComponent, estimateComponentTreeBytes(pComponent), true);
 }
 
 bool AmortizedDestructor::runDestruction(UObject* pObject) const {
@@ -108,17 +264,83 @@ bool AmortizedDestructor::runDestruction(UObject* pObject) const {
   return false;
 }
 
-void AmortizedDestructor::addToPending(UObject* pObject) {
-  _pending.Add(pObject);
+void AmortizedDestructor::addToPending(
+    UObject* pObject,
+    int64 bytes,
+    bool isComponentTree) {
+  this->_pending.HeapPush(
+      PendingDestruction{pObject, bytes, isComponentTree},
+      LargestFirst());
+  this->_pendingBytes += bytes;
 }
 
 void AmortizedDestructor::processPending() {
-  std::swap(_nextPending, _pending);
-  _pending.Empty();
+  if (this->_pending.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ProcessPendingDestruction)
+
+  // Process the largest first, and at least one each frame so that the
+  // backlog always shrinks.
+  bool first = true;
+  while (!this->_pending.IsEmpty()) {
+    if (this->isBudgetExhausted() && !first) {
+      break;
+    }
+    first = false;
+
+    PendingDestruction pending;
+    this->_pending.HeapPop(pending, LargestFirst(), false);
+    this->_pendingBytes -= pending.bytes;
+
+    UObject* pObject = pending.pObject.Get(true);
+    if (!pObject) {
+      // Already collected.
+      continue;
+    }
 
-  for (TWeakObjectPtr<UObject> pObject : _nextPending) {
-    destroy(pObject.Get(true));
+    const double startTime = FPlatformTime::Seconds();
+    if (pending.isComponentTree) {
+      destroyComponentTree(Cast<USceneComponent>(pObject));
+    } else if (!this->runDestruction(pObject)) {
+      // Retry this one next frame rather than again in this one.
+      this->_notReady.Add(pending);
+    }
+    this->recordTime(startTime);
   }
+
+  for (const PendingDestruction& pending : this->_notReady) {
+    this->addToPending(
+        pending.pObject.Get(true),
+        pending.bytes,
+        pending.isComponentTree);
+  }
+  this->_notReady.Reset();
+}
+
+bool AmortizedDestructor::isBudgetExhausted() {
+  if (IsEngineExitRequested()) {
+    return false;
+  }
+
+  const float budget =
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadDestructionBudget;
+  if (budget <= 0.0f) {
+    return false;
+  }
+
+  if (this->_budgetFrame != GFrameCounter) {
+    this->_budgetFrame = GFrameCounter;
+    this->_budgetMillisecondsUsed = 0.0;
+  }
+
+  return this->_budgetMillisecondsUsed >= budget;
+}
+
+void AmortizedDestructor::recordTime(double startTime) {
+  this->_budgetMillisecondsUsed +=
+      (FPlatformTime::Seconds() - startTime) * 1000.0;
 }
 
 void AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
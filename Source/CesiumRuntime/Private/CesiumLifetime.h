@@ -9,6 +9,15 @@
 class UObject;
 class UTexture;
 
+/**
+ * Destroys objects and component trees within a per-frame game-thread budget,
+ * configured by `UCesiumRuntimeSettings::MainThreadDestructionBudget`. Work
+ * that does not fit within the budget, and objects that are not yet ready to
+ * finish being destroyed, are kept pending and processed in later frames, the
+ * ones holding the most memory first. The render and physics resources of
+ * deferred objects are released right away, on the render thread, so that
+ * only the UObjects themselves wait.
+ */
 class AmortizedDestructor : FTickableGameObject {
 public:
   void Tick(float DeltaTime) override;
@@ -17,15 +26,42 @@ public:
   bool IsTickableInEditor() const override;
   TStatId GetStatId() const;
   void destroy(UObject* pObject);
+  void destroyComponentRecursively(USceneComponent* pComponent);
+
+  /**
+   * @brief Gets the number of objects and component trees waiting to be
+   * destroyed.
+   */
+  int32 getPendingCount() const { return this->_pending.Num(); }
+
+  /**
+   * @brief Gets the estimated number of bytes of CPU and GPU memory held by
+   * the objects and component trees waiting to be destroyed.
+   */
+  int64 getPendingBytes() const { return this->_pendingBytes; }
 
 private:
+  struct PendingDestruction {
+    TWeakObjectPtr<UObject> pObject;
+    int64 bytes;
+    bool isComponentTree;
+  };
+
   bool runDestruction(UObject* pObject) const;
-  void addToPending(UObject* pObject);
+  void
+  addToPending(UObject* pObject, int64 bytes, bool isComponentTree);
   void processPending();
   void finalizeDestroy(UObject* pObject) const;
+  bool isBudgetExhausted();
+  void recordTime(double startTime);
 
-  TArray<TWeakObjectPtr<UObject>> _pending;
-  TArray<TWeakObjectPtr<UObject>> _nextPending;
+  // A heap of the pending destructions, largest first.
+  TArray<PendingDestruction> _pending;
+  TArray<PendingDestruction> _notReady;
+  int64 _pendingBytes = 0;
+
+  uint64 _budgetFrame = 0;
+  double _budgetMillisecondsUsed = 0.0;
 };
 
 class CesiumLifetime {
@@ -33,6 +69,18 @@ public:
   static void destroy(UObject* pObject);
   static void destroyComponentRecursively(USceneComponent* pComponent);
 
+  /**
+   * @brief Gets the number of objects and component trees waiting to be
+   * destroyed in a later frame.
+   */
+  static int32 getPendingDestructionCount();
+
+  /**
+   * @brief Gets the estimated number of bytes of memory held by the objects
+   * and component trees waiting to be destroyed in a later frame.
+   */
+  static int64 getPendingDestructionBytes();
+
 private:
   static AmortizedDestructor amortizedDestructor;
 };
@@ -0,0 +1,229 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumLinkedTileComponents.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace {
+
+template <typename TParameterValue>
+bool areParametersEqual(
+    const TArray<TParameterValue>& a,
+    const TArray<TParameterValue>& b) {
+  if (a.Num() != b.Num()) {
+    return false;
+  }
+  for (int32 i = 0; i < a.Num(); ++i) {
+    if (!(a[i].ParameterInfo == b[i].ParameterInfo) ||
+        a[i].ParameterValue != b[i].ParameterValue) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Raster overlays and feature styles change the parameters of the materials
+// of tiles after they are shown.
+bool haveSameParameters(
+    const UMaterialInstance& a,
+    const UMaterialInstance& b) {
+  return areParametersEqual(
+             a.TextureParameterValues,
+             b.TextureParameterValues) &&
+         areParametersEqual(a.ScalarParameterValues, b.ScalarParameterValues) &&
+         areParametersEqual(a.VectorParameterValues, b.VectorParameterValues);
+}
+
+} // namespace
+
+CesiumLinkedTileComponents::CesiumLinkedTileComponents(
+    ACesium3DTileset* pTilesetActor)
+    : _pTilesetActor(pTilesetActor) {}
+
+void CesiumLinkedTileComponents::update(const ACesium3DTileset& sourceTileset) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateLinkedTiles)
+
+  if (this->_pSourceTileset.Get() != &sourceTileset) {
+    this->clear();
+    this->_pSourceTileset = &sourceTileset;
+  }
+
+  ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  USceneComponent* pSourceRoot = sourceTileset.GetRootComponent();
+  if (!pTilesetActor || !pSourceRoot) {
+    return;
+  }
+
+  for (TPair<TWeakObjectPtr<UCesiumGltfComponent>, CopiedTile>& pair :
+       this->_tiles) {
+    pair.Value.seen = false;
+  }
+
+  const bool sourceVisible = !sourceTileset.IsHidden();
+  for (USceneComponent* pChild : pSourceRoot->GetAttachChildren()) {
+    UCesiumGltfComponent* pGltf = Cast<UCesiumGltfComponent>(pChild);
+    if (!IsValid(pGltf) || !pGltf->IsBuildComplete()) {
+      continue;
+    }
+
+    CopiedTile* pTile = this->_tiles.Find(pGltf);
+    if (!pTile) {
+      pTile = &this->_tiles.Add(pGltf, this->copyTile(sourceTileset, *pGltf));
+    }
+    pTile->seen = true;
+
+    // The tiles move when the georeference changes.
+    USceneComponent* pRoot = pTile->pRoot.Get();
+    if (pRoot &&
+        !pRoot->GetRelativeTransform().Equals(pGltf->GetRelativeTransform())) {
+      pRoot->SetRelativeTransform(pGltf->GetRelativeTransform());
+    }
+
+    for (const CopiedPrimitive& primitive : pTile->primitives) {
+      UStaticMeshComponent* pSource = primitive.pSource.Get();
+      UStaticMeshComponent* pCopy = primitive.pCopy.Get();
+      if (!pSource || !pCopy) {
+        continue;
+      }
+
+      const bool visible =
+          sourceVisible && pGltf->IsVisible() && pSource->IsVisible();
+      if (pCopy->IsVisible() != visible) {
+        pCopy->SetVisibility(visible);
+      }
+      if (visible) {
+        this->updateMaterials(sourceTileset, *pSource, *pCopy);
+      }
+    }
+  }
+
+  for (auto it = this->_tiles.CreateIterator(); it; ++it) {
+    if (!it->Value.seen) {
+      this->destroyTile(it->Value);
+      it.RemoveCurrent();
+    }
+  }
+}
+
+void CesiumLinkedTileComponents::clear() {
+  for (TPair<TWeakObjectPtr<UCesiumGltfComponent>, CopiedTile>& pair :
+       this->_tiles) {
+    this->destroyTile(pair.Value);
+  }
+  this->_tiles.Empty();
+  this->_pSourceTileset.Reset();
+}
+
+CesiumLinkedTileComponents::CopiedTile CesiumLinkedTileComponents::copyTile(
+    const ACesium3DTileset& sourceTileset,
+    UCesiumGltfComponent& gltf) {
+  CopiedTile tile;
+  ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  const bool otherWorld = sourceTileset.GetWorld() != pTilesetActor->GetWorld();
+
+  USceneComponent* pRoot = NewObject<USceneComponent>(pTilesetActor);
+  pRoot->SetMobility(gltf.Mobility);
+  pRoot->SetupAttachment(pTilesetActor->GetRootComponent());
+  pRoot->SetRelativeTransform(gltf.GetRelativeTransform());
+  pRoot->RegisterComponent();
+  tile.pRoot = pRoot;
+
+  TArray<USceneComponent*> children;
+  gltf.GetChildrenComponents(false, children);
+  for (USceneComponent* pChild : children) {
+    UStaticMeshComponent* pSource = Cast<UStaticMeshComponent>(pChild);
+    if (!pSource || pSource->IsA<UInstancedStaticMeshComponent>() ||
+        !pSource->GetStaticMesh()) {
+      continue;
+    }
+
+    UStaticMeshComponent* pCopy =
+        NewObject<UStaticMeshComponent>(pTilesetActor);
+    pCopy->SetMobility(pSource->Mobility);
+    if (otherWorld) {
+      // The body setup is the static mesh's, so the collision meshes are
+      // shared too.
+      pCopy->BodyInstance.CopyBodyInstancePropertiesFrom(
+          &pSource->BodyInstance);
+      pCopy->SetCollisionEnabled(pSource->GetCollisionEnabled());
+    } else {
+      pCopy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+    pCopy->SetCanEverAffectNavigation(false);
+    pCopy->SetStaticMesh(pSource->GetStaticMesh());
+    pCopy->SetCastShadow(pSource->CastShadow);
+    pCopy->SetupAttachment(pRoot);
+    pCopy->SetRelativeTransform(pSource->GetRelativeTransform());
+    pCopy->SetVisibility(false);
+    this->updateMaterials(sourceTileset, *pSource, *pCopy);
+    pCopy->RegisterComponent();
+
+    tile.primitives.Add({pSource, pCopy});
+  }
+
+  return tile;
+}
+
+void CesiumLinkedTileComponents::updateMaterials(
+    const ACesium3DTileset& sourceTileset,
+    const UStaticMeshComponent& source,
+    UStaticMeshComponent& copy) {
+  const ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  for (int32 i = 0; i < source.GetNumMaterials(); ++i) {
+    UMaterialInterface* pMaterial = source.GetMaterial(i);
+    UMaterialInstanceDynamic* pSourceInstance =
+        Cast<UMaterialInstanceDynamic>(pMaterial);
+
+    // The linked tileset's own material, if it has one that differs from the
+    // one the tile was created with.
+    UMaterialInterface* pOwnMaterial = nullptr;
+    if (pSourceInstance && pTilesetActor) {
+      const bool translucent =
+          IsTranslucentBlendMode(pSourceInstance->GetBlendMode());
+      pOwnMaterial = translucent ? pTilesetActor->GetTranslucentMaterial()
+                                 : pTilesetActor->GetMaterial();
+      UMaterialInterface* pSourceMaterial =
+          translucent ? sourceTileset.GetTranslucentMaterial()
+                      : sourceTileset.GetMaterial();
+      if (pOwnMaterial == pSourceMaterial) {
+        pOwnMaterial = nullptr;
+      }
+    }
+
+    if (!pOwnMaterial) {
+      if (copy.GetMaterial(i) != pMaterial) {
+        copy.SetMaterial(i, pMaterial);
+      }
+      continue;
+    }
+
+    UMaterialInstanceDynamic* pCopyInstance =
+        Cast<UMaterialInstanceDynamic>(copy.GetMaterial(i));
+    if (!pCopyInstance || pCopyInstance->Parent != pOwnMaterial) {
+      pCopyInstance = UMaterialInstanceDynamic::Create(pOwnMaterial, &copy);
+      pCopyInstance->CopyParameterOverrides(pSourceInstance);
+      copy.SetMaterial(i, pCopyInstance);
+    } else if (!haveSameParameters(*pSourceInstance, *pCopyInstance)) {
+      pCopyInstance->CopyParameterOverrides(pSourceInstance);
+    }
+  }
+}
+
+void CesiumLinkedTileComponents::destroyTile(CopiedTile& tile) {
+  for (const CopiedPrimitive& primitive : tile.primitives) {
+    UStaticMeshComponent* pCopy = primitive.pCopy.Get();
+    if (pCopy) {
+      pCopy->DestroyComponent();
+    }
+  }
+  tile.primitives.Empty();
+
+  USceneComponent* pRoot = tile.pRoot.Get();
+  if (pRoot) {
+    pRoot->DestroyComponent();
+  }
+  tile.pRoot.Reset();
+}
@@ -0,0 +1,85 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACesium3DTileset;
+class UCesiumGltfComponent;
+class UMaterialInstanceDynamic;
+class UStaticMeshComponent;
+class USceneComponent;
+
+/**
+ * The components with which a linked tileset shows the tiles of the tileset
+ * it is linked to, at its own transform.
+ *
+ * Each tile of the linked-to tileset that is built gets a copy of its
+ * primitive components, attached to the linked tileset and referencing the
+ * same static meshes, so the vertex and index buffers and the textures on the
+ * GPU are shared rather than loaded twice. The copies follow the visibility of
+ * the originals, and are destroyed with them. Their materials are the same
+ * material instances, or, where the linked tileset has a material of its own,
+ * instances of that material with the parameters of the originals.
+ *
+ * The copies have no collision, unless the linked-to tileset is in another
+ * world, whose physics scene this tileset's world doesn't see: then they have
+ * the collision of the originals, with the same collision meshes. Instanced
+ * primitives are not copied.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumLinkedTileComponents {
+public:
+  CesiumLinkedTileComponents(ACesium3DTileset* pTilesetActor);
+
+  /**
+   * @brief Adds copies of the tiles of the given tileset that are new, updates
+   * the visibility and materials of the copies, and destroys the copies of
+   * tiles that are gone. If the tileset is not the one whose tiles were
+   * copied before, all copies are replaced.
+   */
+  void update(const ACesium3DTileset& sourceTileset);
+
+  /**
+   * @brief Destroys all copies.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the number of tiles that are copied.
+   */
+  int32 getTileCount() const { return this->_tiles.Num(); }
+
+  /**
+   * @brief Gets the tileset whose tiles are copied, if any.
+   */
+  const ACesium3DTileset* getSourceTileset() const {
+    return this->_pSourceTileset.Get();
+  }
+
+private:
+  struct CopiedPrimitive {
+    TWeakObjectPtr<UStaticMeshComponent> pSource;
+    TWeakObjectPtr<UStaticMeshComponent> pCopy;
+  };
+
+  struct CopiedTile {
+    TWeakObjectPtr<USceneComponent> pRoot;
+    TArray<CopiedPrimitive> primitives;
+    bool seen = false;
+  };
+
+  CopiedTile copyTile(
+      const ACesium3DTileset& sourceTileset,
+      UCesiumGltfComponent& gltf);
+  void updateMaterials(
+      const ACesium3DTileset& sourceTileset,
+      const UStaticMeshComponent& source,
+      UStaticMeshComponent& copy);
+  void destroyTile(CopiedTile& tile);
+
+  TWeakObjectPtr<ACesium3DTileset> _pTilesetActor;
+  TWeakObjectPtr<const ACesium3DTileset> _pSourceTileset;
+  TMap<TWeakObjectPtr<UCesiumGltfComponent>, CopiedTile> _tiles;
+};
@@ -0,0 +1,62 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumLoadArena.h"
+
+namespace {
+// Allocations larger than this fraction of a block get a block of their own,
+// so that they don't waste the rest of the current one.
+constexpr size_t LargeAllocationDivisor = 4;
+
+constexpr size_t BlockHeaderSize =
+    Align(sizeof(void*), alignof(std::max_align_t));
+} // namespace
+
+CesiumLoadArena::CesiumLoadArena(size_t blockSize)
+    : _mutex(),
+      _pBlocks(nullptr),
+      _pNext(nullptr),
+      _pEnd(nullptr),
+      _blockSize(blockSize),
+      _allocatedBytes(0) {}
+
+CesiumLoadArena::~CesiumLoadArena() {
+  Block* pBlock = this->_pBlocks;
+  while (pBlock) {
+    Block* pNext = pBlock->pNext;
+    FMemory::Free(pBlock);
+    pBlock = pNext;
+  }
+}
+
+void* CesiumLoadArena::allocate(size_t size, size_t alignment) {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  if (size > this->_blockSize / LargeAllocationDivisor) {
+    return Align(
+        static_cast<uint8*>(this->allocateBlock(size + alignment)),
+        alignment);
+  }
+
+  uint8* pResult = Align(this->_pNext, alignment);
+  if (!pResult || pResult + size > this->_pEnd) {
+    this->_pNext = static_cast<uint8*>(this->allocateBlock(this->_blockSize));
+    this->_pEnd = this->_pNext + this->_blockSize;
+    pResult = Align(this->_pNext, alignment);
+  }
+
+  this->_pNext = pResult + size;
+  return pResult;
+}
+
+size_t CesiumLoadArena::getAllocatedBytes() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_allocatedBytes;
+}
+
+void* CesiumLoadArena::allocateBlock(size_t size) {
+  Block* pBlock = static_cast<Block*>(FMemory::Malloc(BlockHeaderSize + size));
+  pBlock->pNext = this->_pBlocks;
+  this->_pBlocks = pBlock;
+  this->_allocatedBytes += BlockHeaderSize + size;
+  return reinterpret_cast<uint8*>(pBlock) + BlockHeaderSize;
+}
@@ -0,0 +1,106 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+
+/**
+ * A monotonic allocator for the temporaries of loading a single tile, which
+ * are all released at once when the arena is destroyed. Deallocating an
+ * individual allocation does nothing.
+ *
+ * Small allocations are carved out of large blocks, so that the many small
+ * containers filled while loading a tile's primitives don't each go to the
+ * general-purpose allocator, which is contended by all of the loading
+ * threads. The primitives of a tile are loaded in parallel, so allocating is
+ * thread-safe.
+ */
+class CesiumLoadArena {
+public:
+  explicit CesiumLoadArena(size_t blockSize = DefaultBlockSize);
+  ~CesiumLoadArena();
+
+  CesiumLoadArena(const CesiumLoadArena&) = delete;
+  CesiumLoadArena& operator=(const CesiumLoadArena&) = delete;
+
+  /**
+   * @brief Allocates memory that stays valid until the arena is destroyed.
+   */
+  void* allocate(size_t size, size_t alignment);
+
+  /**
+   * @brief Gets the total size of the blocks allocated by the arena so far.
+   */
+  size_t getAllocatedBytes() const;
+
+  static constexpr size_t DefaultBlockSize = 16 * 1024;
+
+private:
+  struct Block {
+    Block* pNext;
+  };
+
+  void* allocateBlock(size_t size);
+
+  mutable std::mutex _mutex;
+  Block* _pBlocks;
+  uint8* _pNext;
+  uint8* _pEnd;
+  size_t _blockSize;
+  size_t _allocatedBytes;
+};
+
+/**
+ * A standard allocator that allocates from a `CesiumLoadArena`, or from the
+ * general-purpose allocator if it has no arena. Containers that use it must
+ * be destroyed before their arena.
+ */
+template <typename T> class CesiumLoadArenaAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  CesiumLoadArenaAllocator() noexcept : _pArena(nullptr) {}
+
+  explicit CesiumLoadArenaAllocator(CesiumLoadArena* pArena) noexcept
+      : _pArena(pArena) {}
+
+  template <typename U>
+  CesiumLoadArenaAllocator(const CesiumLoadArenaAllocator<U>& other) noexcept
+      : _pArena(other.getArena()) {}
+
+  T* allocate(size_t count) {
+    const size_t size = count * sizeof(T);
+    if (this->_pArena) {
+      return static_cast<T*>(this->_pArena->allocate(size, alignof(T)));
+    }
+    return static_cast<T*>(FMemory::Malloc(size, alignof(T)));
+  }
+
+  void deallocate(T* p, size_t) noexcept {
+    if (!this->_pArena) {
+      FMemory::Free(p);
+    }
+  }
+
+  CesiumLoadArena* getArena() const noexcept { return this->_pArena; }
+
+  template <typename U>
+  bool operator==(const CesiumLoadArenaAllocator<U>& other) const noexcept {
+    return this->_pArena == other.getArena();
+  }
+
+  template <typename U>
+  bool operator!=(const CesiumLoadArenaAllocator<U>& other) const noexcept {
+    return this->_pArena != other.getArena();
+  }
+
+private:
+  CesiumLoadArena* _pArena;
+};
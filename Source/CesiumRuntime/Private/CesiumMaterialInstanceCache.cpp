@@ -0,0 +1,168 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMaterialInstanceCache.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+
+namespace {
+// Templates are cheap, but a tileset with a huge number of distinct
+// materials shouldn't accumulate them without bound.
+constexpr int32 MaximumTemplates = 1024;
+
+template <typename TParameterValue>
+void setParameter(
+    TArray<TParameterValue>& values,
+    const FMaterialParameterInfo& info,
+    const decltype(TParameterValue::ParameterValue)& value) {
+  for (TParameterValue& existing : values) {
+    if (existing.ParameterInfo == info) {
+      existing.ParameterValue = value;
+      return;
+    }
+  }
+
+  TParameterValue& added = values.Emplace_GetRef();
+  added.ParameterInfo = info;
+  added.ParameterValue = value;
+}
+
+uint32 hashParameterInfo(const FMaterialParameterInfo& info) {
+  return HashCombine(
+      GetTypeHash(info.Name),
+      HashCombine(GetTypeHash(uint8(info.Association)), GetTypeHash(info.Index)));
+}
+
+uint32 computeHash(
+    const UMaterialInterface* pBaseMaterial,
+    const CesiumMaterialParameters& parameters) {
+  uint32 hash = GetTypeHash(pBaseMaterial);
+  for (const FScalarParameterValue& scalar : parameters.scalars) {
+    hash = HashCombine(hash, hashParameterInfo(scalar.ParameterInfo));
+    hash = HashCombine(hash, GetTypeHash(scalar.ParameterValue));
+  }
+  for (const FVectorParameterValue& vector : parameters.vectors) {
+    hash = HashCombine(hash, hashParameterInfo(vector.ParameterInfo));
+    hash = HashCombine(hash, GetTypeHash(vector.ParameterValue));
+  }
+  return hash;
+}
+
+template <typename TParameterValue>
+bool parametersEqual(
+    const TArray<TParameterValue>& a,
+    const TArray<TParameterValue>& b) {
+  if (a.Num() != b.Num()) {
+    return false;
+  }
+
+  for (int32 i = 0; i < a.Num(); ++i) {
+    if (!(a[i].ParameterInfo == b[i].ParameterInfo) ||
+        a[i].ParameterValue != b[i].ParameterValue) {
+      return false;
+    }
+  }
+
+  return true;
+}
+} // namespace
+
+void CesiumMaterialParameters::setScalar(
+    const FMaterialParameterInfo& info,
+    float value) {
+  setParameter(this->scalars, info, value);
+}
+
+void CesiumMaterialParameters::setVector(
+    const FMaterialParameterInfo& info,
+    const FLinearColor& value) {
+  setParameter(this->vectors, info, value);
+}
+
+void CesiumMaterialParameters::setTexture(
+    const FMaterialParameterInfo& info,
+    UTexture* pValue) {
+  setParameter(this->textures, info, pValue);
+}
+
+UMaterialInstanceDynamic* CesiumMaterialInstanceCache::createMaterialInstance(
+    UMaterialInterface* pBaseMaterial,
+    FName name,
+    const CesiumMaterialParameters& parameters) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateMaterialInstance)
+
+  UMaterialInstanceDynamic* pTemplate =
+      this->findOrCreateTemplate(pBaseMaterial, parameters);
+
+  UMaterialInstanceDynamic* pMaterial =
+      UMaterialInstanceDynamic::Create(pBaseMaterial, nullptr, name);
+  pMaterial->CopyParameterOverrides(pTemplate);
+
+  for (const FTextureParameterValue& texture : parameters.textures) {
+    pMaterial->SetTextureParameterValueByInfo(
+        texture.ParameterInfo,
+        texture.ParameterValue);
+  }
+
+  return pMaterial;
+}
+
+UMaterialInstanceDynamic* CesiumMaterialInstanceCache::findOrCreateTemplate(
+    UMaterialInterface* pBaseMaterial,
+    const CesiumMaterialParameters& parameters) {
+  uint32 hash = computeHash(pBaseMaterial, parameters);
+
+  for (auto it = this->_templates.CreateKeyIterator(hash); it; ++it) {
+    const Entry& entry = it.Value();
+    if (entry.pBaseMaterial == pBaseMaterial &&
+        parametersEqual(entry.scalars, parameters.scalars) &&
+        parametersEqual(entry.vectors, parameters.vectors) &&
+        IsValid(entry.pTemplate)) {
+      ++this->_hits;
+      return entry.pTemplate;
+    }
+  }
+
+  ++this->_misses;
+
+  if (this->_templates.Num() >= MaximumTemplates) {
+    this->clear();
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateMaterialTemplate)
+
+  UMaterialInstanceDynamic* pTemplate =
+      UMaterialInstanceDynamic::Create(pBaseMaterial, nullptr);
+  pTemplate->SetFlags(
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+
+  for (const FScalarParameterValue& scalar : parameters.scalars) {
+    pTemplate->SetScalarParameterValueByInfo(
+        scalar.ParameterInfo,
+        scalar.ParameterValue);
+  }
+  for (const FVectorParameterValue& vector : parameters.vectors) {
+    pTemplate->SetVectorParameterValueByInfo(
+        vector.ParameterInfo,
+        vector.ParameterValue);
+  }
+
+  this->_templates.Add(
+      hash,
+      Entry{pBaseMaterial, parameters.scalars, parameters.vectors, pTemplate});
+
+  return pTemplate;
+}
+
+void CesiumMaterialInstanceCache::clear() { this->_templates.Empty(); }
+
+void CesiumMaterialInstanceCache::AddReferencedObjects(
+    FReferenceCollector& Collector) {
+  for (auto& pair : this->_templates) {
+    Collector.AddReferencedObject(pair.Value.pBaseMaterial);
+    Collector.AddReferencedObject(pair.Value.pTemplate);
+  }
+}
+
+FString CesiumMaterialInstanceCache::GetReferencerName() const {
+  return TEXT("CesiumMaterialInstanceCache");
+}
@@ -0,0 +1,77 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Materials/MaterialInstance.h"
+#include "UObject/GCObject.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+/**
+ * The parameter values of a material instance, collected before the
+ * instance is created. Setting a value that was already set replaces it.
+ */
+struct CesiumMaterialParameters {
+  TArray<FScalarParameterValue> scalars;
+  TArray<FVectorParameterValue> vectors;
+  TArray<FTextureParameterValue> textures;
+
+  void setScalar(const FMaterialParameterInfo& info, float value);
+  void setVector(const FMaterialParameterInfo& info, const FLinearColor& value);
+  void setTexture(const FMaterialParameterInfo& info, UTexture* pValue);
+};
+
+/**
+ * Creates the dynamic material instances for a tileset's primitives.
+ *
+ * Setting each parameter on a `UMaterialInstanceDynamic` individually costs
+ * a parameter search and a render command. Most primitives of a tileset
+ * share the same base material and the same scalar and vector parameter
+ * values, differing only in their textures. So for each distinct combination
+ * of base material and scalar/vector values, a template instance is created
+ * once and kept in this cache. New instances copy all of the template's values
+ * in a single operation, and then only set their own textures.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumMaterialInstanceCache : public FGCObject {
+public:
+  /**
+   * @brief Creates a new dynamic material instance of the given base material
+   * with the given parameter values.
+   */
+  UMaterialInstanceDynamic* createMaterialInstance(
+      UMaterialInterface* pBaseMaterial,
+      FName name,
+      const CesiumMaterialParameters& parameters);
+
+  /**
+   * @brief Releases all template instances.
+   */
+  void clear();
+
+  int64 getHitCount() const { return this->_hits; }
+  int64 getMissCount() const { return this->_misses; }
+
+  // FGCObject
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  struct Entry {
+    TObjectPtr<UMaterialInterface> pBaseMaterial;
+    TArray<FScalarParameterValue> scalars;
+    TArray<FVectorParameterValue> vectors;
+    TObjectPtr<UMaterialInstanceDynamic> pTemplate;
+  };
+
+  UMaterialInstanceDynamic* findOrCreateTemplate(
+      UMaterialInterface* pBaseMaterial,
+      const CesiumMaterialParameters& parameters);
+
+  TMultiMap<uint32, Entry> _templates;
+  int64 _hits = 0;
+  int64 _misses = 0;
+};
@@ -9,6 +9,7 @@ void UCesiumMaterialUserData::PostEditChangeOwner() {
 
 #if WITH_EDITORONLY_DATA
   this->LayerNames.Empty();
+  ++this->LayerNamesVersion;
 
   UMaterialInstance* pMaterial = Cast<UMaterialInstance>(this->GetOuter());
   if (pMaterial) {
@@ -26,4 +26,10 @@ public:
 
   UPROPERTY()
   TArray<FString> LayerNames;
+
+  /**
+   * Incremented each time LayerNames is rebuilt, so that anything derived
+   * from the layer names can tell when it needs to be recomputed.
+   */
+  uint32 LayerNamesVersion = 0;
 };
@@ -0,0 +1,383 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMemoryCacheAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumTilesetStatistics.h"
+#include "Misc/DateTime.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const std::string getMethod = "GET";
+
+class CachedAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  CachedAssetResponse(const CesiumAsync::IAssetResponse& response)
+      : _statusCode(response.statusCode()),
+        _contentType(response.contentType()),
+        _headers(response.headers()),
+        _data(response.data().begin(), response.data().end()) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+/**
+ * A copy of a completed request and its response, which may be shared by
+ * any number of callers.
+ */
+class CachedAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  CachedAssetRequest(const CesiumAsync::IAssetRequest& request)
+      : _method(request.method()),
+        _url(request.url()),
+        _headers(request.headers()),
+        _response(*request.response()) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  CachedAssetResponse _response;
+};
+
+std::string trim(const std::string& s) {
+  const size_t begin = s.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return std::string();
+  }
+  const size_t end = s.find_last_not_of(" \t");
+  return s.substr(begin, end - begin + 1);
+}
+
+/**
+ * Determines how long a response may be kept, from its `Cache-Control` and
+ * `Expires` headers.
+ *
+ * @return The lifetime, or std::nullopt if the response must not be kept.
+ */
+std::optional<std::chrono::seconds>
+getFreshnessLifetime(const CesiumAsync::HttpHeaders& headers) {
+  auto cacheControlIt = headers.find("Cache-Control");
+  if (cacheControlIt != headers.end()) {
+    std::string cacheControl = cacheControlIt->second;
+    std::transform(
+        cacheControl.begin(),
+        cacheControl.end(),
+        cacheControl.begin(),
+        [](unsigned char c) { return char(std::tolower(c)); });
+
+    std::optional<std::chrono::seconds> maxAge;
+    size_t start = 0;
+    while (start <= cacheControl.size()) {
+      size_t end = cacheControl.find(',', start);
+      if (end == std::string::npos) {
+        end = cacheControl.size();
+      }
+
+      const std::string directive =
+          trim(cacheControl.substr(start, end - start));
+      if (directive == "no-store" || directive == "no-cache") {
+        return std::nullopt;
+      }
+
+      constexpr char maxAgePrefix[] = "max-age=";
+      if (directive.compare(0, sizeof(maxAgePrefix) - 1, maxAgePrefix) == 0) {
+        maxAge = std::chrono::seconds(
+            std::atoll(directive.c_str() + sizeof(maxAgePrefix) - 1));
+      }
+
+      start = end + 1;
+    }
+
+    if (maxAge) {
+      return maxAge->count() > 0 ? maxAge : std::nullopt;
+    }
+  }
+
+  auto expiresIt = headers.find("Expires");
+  if (expiresIt != headers.end()) {
+    FDateTime expires;
+    if (FDateTime::ParseHttpDate(
+            UTF8_TO_TCHAR(expiresIt->second.c_str()),
+            expires)) {
+      const int64 seconds =
+          int64((expires - FDateTime::UtcNow()).GetTotalSeconds());
+      if (seconds > 0) {
+        return std::chrono::seconds(seconds);
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
+// Identifies identical requests, whose responses may be shared.
+std::string getRequestKey(
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  std::string key = url;
+  for (const CesiumAsync::IAssetAccessor::THeader& header : headers) {
+    key += '\n';
+    key += header.first;
+    key += ':';
+    key += header.second;
+  }
+  return key;
+}
+
+} // namespace
+
+CesiumMemoryCacheAssetAccessor::CesiumMemoryCacheAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    int64_t maximumBytes)
+    : _pAssetAccessor(pAssetAccessor),
+      _maximumBytes(maximumBytes),
+      _mutex(),
+      _entries(),
+      _entriesByUrl(),
+      _sizeBytes(0),
+      _requestsInFlight() {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumMemoryCacheAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (this->_maximumBytes > 0) {
+    std::shared_ptr<CesiumAsync::IAssetRequest> pHit;
+    {
+      std::scoped_lock<std::mutex> lock(this->_mutex);
+      auto it = this->_entriesByUrl.find(url);
+      if (it != this->_entriesByUrl.end()) {
+        if (it->second->expiry > Clock::now()) {
+          this->_entries.splice(
+              this->_entries.begin(),
+              this->_entries,
+              it->second);
+          pHit = it->second->pRequest;
+        } else {
+          this->_sizeBytes -= it->second->sizeBytes;
+          this->_entries.erase(it->second);
+          this->_entriesByUrl.erase(it);
+        }
+      }
+    }
+
+    if (pHit) {
+      UCesiumTilesetStatistics::RecordMemoryCacheLookup(true);
+      return asyncSystem.createResolvedFuture(std::move(pHit));
+    }
+  }
+
+  UCesiumTilesetStatistics::RecordMemoryCacheLookup(false);
+
+  const auto share =
+      [](const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+        return pRequest;
+      };
+
+  std::string key = getRequestKey(url, headers);
+  CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+      asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+  CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>
+      response = promise.getFuture().share();
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto [it, added] = this->_requestsInFlight.emplace(key, response);
+    if (!added) {
+      return it->second.thenImmediately(share);
+    }
+  }
+
+  // The response is kept before the request stops being in flight, so that
+  // the same request made in between is answered from memory.
+  this->_pAssetAccessor->get(asyncSystem, url, headers)
+      .thenImmediately(
+          [pThis = this->shared_from_this(), key, promise](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            if (pThis->_maximumBytes > 0) {
+              pThis->add(pRequest);
+            }
+            pThis->finishRequest(key);
+            promise.resolve(std::move(pRequest));
+          })
+      .catchImmediately(
+          [pThis = this->shared_from_this(), key, promise](
+              std::exception&& e) {
+            pThis->finishRequest(key);
+            promise.reject(std::runtime_error(e.what()));
+          });
+
+  return response.thenImmediately(share);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumMemoryCacheAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  // A GET made through the general method is still shared with identical
+  // requests in flight.
+  if (verb == getMethod && contentPayload.empty()) {
+    return this->get(asyncSystem, url, headers);
+  }
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumMemoryCacheAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+size_t CesiumMemoryCacheAssetAccessor::getEntryCount() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_entries.size();
+}
+
+int64_t CesiumMemoryCacheAssetAccessor::getSizeBytes() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_sizeBytes;
+}
+
+void CesiumMemoryCacheAssetAccessor::add(
+    const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest) {
+  const CesiumAsync::IAssetResponse* pResponse =
+      pRequest ? pRequest->response() : nullptr;
+  if (!pResponse || pRequest->method() != getMethod ||
+      pResponse->statusCode() != 200) {
+    return;
+  }
+
+  std::optional<std::chrono::seconds> lifetime =
+      getFreshnessLifetime(pResponse->headers());
+  if (!lifetime) {
+    return;
+  }
+
+  // Count the request and response headers too, roughly, so that many small
+  // responses don't exceed the budget by much.
+  const int64_t sizeBytes =
+      int64_t(pResponse->data().size() + pRequest->url().size() * 2 + 256);
+  if (sizeBytes > this->_maximumBytes) {
+    return;
+  }
+
+  auto pCached = std::make_shared<CachedAssetRequest>(*pRequest);
+
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+
+    auto it = this->_entriesByUrl.find(pRequest->url());
+    if (it != this->_entriesByUrl.end()) {
+      this->_sizeBytes -= it->second->sizeBytes;
+      this->_entries.erase(it->second);
+      this->_entriesByUrl.erase(it);
+    }
+
+    this->_entries.push_front(Entry{
+        pRequest->url(),
+        std::move(pCached),
+        sizeBytes,
+        Clock::now() + *lifetime});
+    this->_entriesByUrl.emplace(pRequest->url(), this->_entries.begin());
+    this->_sizeBytes += sizeBytes;
+
+    while (this->_sizeBytes > this->_maximumBytes) {
+      this->removeLeastRecentlyUsed();
+    }
+  }
+
+  this->recordSize();
+}
+
+void CesiumMemoryCacheAssetAccessor::finishRequest(const std::string& key) {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  this->_requestsInFlight.erase(key);
+}
+
+void CesiumMemoryCacheAssetAccessor::removeLeastRecentlyUsed() {
+  const Entry& last = this->_entries.back();
+  this->_sizeBytes -= last.sizeBytes;
+  this->_entriesByUrl.erase(last.url);
+  this->_entries.pop_back();
+}
+
+void CesiumMemoryCacheAssetAccessor::recordSize() const {
+  int32 entries;
+  int64 bytes;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    entries = int32(this->_entries.size());
+    bytes = this->_sizeBytes;
+  }
+  UCesiumTilesetStatistics::RecordMemoryCacheSize(entries, bytes);
+}
+
+CesiumDiskCacheMissCountingAssetAccessor::
+    CesiumDiskCacheMissCountingAssetAccessor(
+        const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumDiskCacheMissCountingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  UCesiumTilesetStatistics::RecordDiskCacheMiss();
+  return this->_pAssetAccessor->get(asyncSystem, url, headers);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumDiskCacheMissCountingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumDiskCacheMissCountingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
@@ -0,0 +1,137 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/SharedFuture.h"
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * An asset accessor that keeps recent responses in memory, in front of the
+ * on-disk request cache. It is meant to wrap the accessor that decompresses
+ * responses, so that a revisited tile costs neither a SQLite read nor a
+ * gunzip.
+ *
+ * Only successful GET responses that may be cached and that state when they
+ * expire, with a `Cache-Control` max-age or an `Expires` header, are kept.
+ * They are keyed by URL alone and are not returned after they expire. When
+ * the total size of the kept responses exceeds the budget, the least recently
+ * used are discarded.
+ *
+ * A GET made while an identical one, with the same URL and headers, is in
+ * flight shares its response rather than being requested again, whether or
+ * not the response may be kept, and whether it is made with `get` or with
+ * `request`. Tilesets whose raster overlays show the same
+ * imagery, such as terrain and a photogrammetry tileset draped with the same
+ * Bing Maps or WMTS layer, select nearly the same imagery tiles at the same
+ * time, and so fetch each of them once.
+ */
+class CesiumMemoryCacheAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumMemoryCacheAssetAccessor> {
+public:
+  /**
+   * Creates an accessor.
+   *
+   * @param pAssetAccessor The accessor to use for requests that are not
+   * answered from memory.
+   * @param maximumBytes The maximum total size of the responses to keep. A
+   * value of zero keeps nothing.
+   */
+  CesiumMemoryCacheAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      int64_t maximumBytes);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Gets the number of responses currently kept in memory.
+   */
+  size_t getEntryCount() const;
+
+  /**
+   * Gets the total size of the responses currently kept in memory.
+   */
+  int64_t getSizeBytes() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::string url;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    int64_t sizeBytes;
+    Clock::time_point expiry;
+  };
+
+  void add(const std::shared_ptr<CesiumAsync::IAssetRequest>& pRequest);
+  void finishRequest(const std::string& key);
+  void removeLeastRecentlyUsed();
+  void recordSize() const;
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  int64_t _maximumBytes;
+
+  mutable std::mutex _mutex;
+  // Most recently used first.
+  std::list<Entry> _entries;
+  std::unordered_map<std::string, std::list<Entry>::iterator> _entriesByUrl;
+  int64_t _sizeBytes;
+
+  // The GETs in flight, by URL and headers.
+  std::unordered_map<
+      std::string,
+      CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>>
+      _requestsInFlight;
+};
+
+/**
+ * An asset accessor that counts the GET requests passed through it as misses
+ * of the on-disk request cache. It is placed between the caching accessor and
+ * the network accessor, where the only requests that arrive are those the
+ * cache could not answer.
+ */
+class CesiumDiskCacheMissCountingAssetAccessor
+    : public CesiumAsync::IAssetAccessor {
+public:
+  CesiumDiskCacheMissCountingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+private:
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+};
@@ -0,0 +1,127 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMemoryUsageTracker.h"
+
+void CesiumMemoryUsageTracker::addPrimitive(
+    const UCesiumGltfComponent* pGltf,
+    const FCesiumMemoryUsage& geometry,
+    const std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*>&
+        textures) {
+  check(IsInGameThread());
+
+  auto [componentIt, added] = this->_components.try_emplace(pGltf);
+  if (added) {
+    ++this->_componentsAdded;
+  }
+  ComponentUsage& component = componentIt->second;
+  component.geometry.VertexBytes += geometry.VertexBytes;
+  component.geometry.IndexBytes += geometry.IndexBytes;
+  component.geometry.CollisionBytes += geometry.CollisionBytes;
+  component.geometry.MaterialBytes += geometry.MaterialBytes;
+
+  this->_usage.VertexBytes += geometry.VertexBytes;
+  this->_usage.IndexBytes += geometry.IndexBytes;
+  this->_usage.CollisionBytes += geometry.CollisionBytes;
+  this->_usage.MaterialBytes += geometry.MaterialBytes;
+
+  for (CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture :
+       textures) {
+    this->addTexture(component, pTexture, false);
+  }
+}
+
+void CesiumMemoryUsageTracker::addEncodedTextures(
+    const UCesiumGltfComponent* pGltf,
+    const std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*>&
+        textures) {
+  check(IsInGameThread());
+
+  auto [componentIt, added] = this->_components.try_emplace(pGltf);
+  if (added) {
+    ++this->_componentsAdded;
+  }
+  ComponentUsage& component = componentIt->second;
+  for (CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture :
+       textures) {
+    this->addTexture(component, pTexture, true);
+  }
+}
+
+void CesiumMemoryUsageTracker::removeComponent(
+    const UCesiumGltfComponent* pGltf) {
+  check(IsInGameThread());
+
+  auto componentIt = this->_components.find(pGltf);
+  if (componentIt == this->_components.end()) {
+    return;
+  }
+
+  const ComponentUsage& component = componentIt->second;
+  this->_usage.VertexBytes -= component.geometry.VertexBytes;
+  this->_usage.IndexBytes -= component.geometry.IndexBytes;
+  this->_usage.CollisionBytes -= component.geometry.CollisionBytes;
+  this->_usage.MaterialBytes -= component.geometry.MaterialBytes;
+
+  for (const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture :
+       component.textures) {
+    auto textureIt = this->_textures.find(pTexture);
+    if (textureIt != this->_textures.end() && --textureIt->second.uses == 0) {
+      const int64 bytes = int64(pTexture->getSizeBytes());
+      this->_usage.TextureBytes -= bytes;
+      if (textureIt->second.isEncoded) {
+        this->_encodedTextureBytes -= bytes;
+      }
+      this->_textures.erase(textureIt);
+    }
+  }
+
+  this->_components.erase(componentIt);
+  ++this->_componentsRemoved;
+}
+
+int64 CesiumMemoryUsageTracker::getUnrealOnlyBytes() const noexcept {
+  return this->_usage.VertexBytes + this->_usage.IndexBytes +
+         this->_usage.CollisionBytes + this->_usage.MaterialBytes +
+         this->_encodedTextureBytes;
+}
+
+int64 CesiumMemoryUsageTracker::getComponentTextureBytes(
+    const UCesiumGltfComponent* pGltf) const {
+  auto componentIt = this->_components.find(pGltf);
+  if (componentIt == this->_components.end()) {
+    return 0;
+  }
+
+  TSet<const CesiumTextureUtility::ReferenceCountedUnrealTexture*> counted;
+  int64 bytes = 0;
+  for (const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture :
+       componentIt->second.textures) {
+    bool alreadyCounted = false;
+    counted.Add(pTexture, &alreadyCounted);
+    if (!alreadyCounted) {
+      bytes += int64(pTexture->getSizeBytes());
+    }
+  }
+  return bytes;
+}
+
+void CesiumMemoryUsageTracker::addTexture(
+    ComponentUsage& component,
+    CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture,
+    bool isEncoded) {
+  if (!pTexture) {
+    return;
+  }
+
+  TextureUse& use = this->_textures[pTexture];
+  if (use.uses++ == 0) {
+    const int64 bytes = int64(pTexture->getSizeBytes());
+    use.pTexture = pTexture;
+    use.isEncoded = isEncoded;
+    this->_usage.TextureBytes += bytes;
+    if (isEncoded) {
+      this->_encodedTextureBytes += bytes;
+    }
+  }
+  component.textures.emplace_back(pTexture);
+}
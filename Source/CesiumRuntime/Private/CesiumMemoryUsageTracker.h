@@ -0,0 +1,123 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMemoryUsage.h"
+#include "CesiumTextureUtility.h"
+#include <CesiumUtility/IntrusivePointer.h>
+#include <unordered_map>
+#include <vector>
+
+class UCesiumGltfComponent;
+
+/**
+ * Keeps the running totals of the memory taken by the tiles that a tileset
+ * has loaded, reported by `ACesium3DTileset::GetMemoryUsage`.
+ *
+ * Each primitive adds the size of its meshes and textures as it is created,
+ * and all of a glTF component's sizes are removed when its tile is unloaded.
+ * A texture shared by several primitives, or several tiles, is counted until
+ * the last of them is removed. This must only be used from the game thread.
+ */
+class CesiumMemoryUsageTracker {
+public:
+  /**
+   * @brief Adds the sizes of a primitive of a glTF component.
+   *
+   * @param pGltf The glTF component that the primitive belongs to.
+   * @param geometry The sizes of the primitive's meshes and material. Its
+   * `TextureBytes` are ignored.
+   * @param textures The textures used by the primitive. The same texture may
+   * appear more than once, and null pointers are skipped.
+   */
+  void addPrimitive(
+      const UCesiumGltfComponent* pGltf,
+      const FCesiumMemoryUsage& geometry,
+      const std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*>&
+          textures);
+
+  /**
+   * @brief Adds the sizes of textures of a glTF component that Unreal encodes
+   * from the glTF's data, such as those of its property tables, rather than
+   * creating from its images.
+   *
+   * @param pGltf The glTF component that the textures belong to.
+   * @param textures The textures. Null pointers are skipped.
+   */
+  void addEncodedTextures(
+      const UCesiumGltfComponent* pGltf,
+      const std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*>&
+          textures);
+
+  /**
+   * @brief Removes the sizes of all the primitives and textures that were
+   * added for a glTF component.
+   */
+  void removeComponent(const UCesiumGltfComponent* pGltf);
+
+  /**
+   * @brief Gets the current totals.
+   */
+  const FCesiumMemoryUsage& getUsage() const noexcept { return this->_usage; }
+
+  /**
+   * @brief Gets the part of the current totals that cesium-native doesn't
+   * count in the size of its tiles: the meshes, collision meshes, materials,
+   * and encoded textures that are created from the glTF data. The textures
+   * created from the glTF's images are excluded, because cesium-native counts
+   * the images.
+   */
+  int64 getUnrealOnlyBytes() const noexcept;
+
+  /**
+   * @brief Gets the size of the textures of a glTF component, including
+   * those that are shared with other components. Each texture is counted
+   * once, however many of the component's primitives use it.
+   */
+  int64 getComponentTextureBytes(const UCesiumGltfComponent* pGltf) const;
+
+  /**
+   * @brief Gets the number of glTF components whose sizes have been added,
+   * which is the number of tiles with content that have been loaded.
+   */
+  int64 getComponentsAdded() const noexcept { return this->_componentsAdded; }
+
+  /**
+   * @brief Gets the number of glTF components whose sizes have been removed,
+   * which is the number of tiles with content that have been unloaded.
+   */
+  int64 getComponentsRemoved() const noexcept {
+    return this->_componentsRemoved;
+  }
+
+private:
+  struct TextureUse {
+    // Keeps the texture alive while it's counted, so that its address isn't
+    // reused by another texture.
+    CesiumUtility::IntrusivePointer<
+        CesiumTextureUtility::ReferenceCountedUnrealTexture>
+        pTexture;
+    int32 uses = 0;
+    bool isEncoded = false;
+  };
+
+  struct ComponentUsage {
+    FCesiumMemoryUsage geometry;
+    std::vector<CesiumTextureUtility::ReferenceCountedUnrealTexture*> textures;
+  };
+
+  std::unordered_map<
+      const CesiumTextureUtility::ReferenceCountedUnrealTexture*,
+      TextureUse>
+      _textures;
+  void addTexture(
+      ComponentUsage& component,
+      CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture,
+      bool isEncoded);
+
+  std::unordered_map<const UCesiumGltfComponent*, ComponentUsage> _components;
+  FCesiumMemoryUsage _usage;
+  int64 _encodedTextureBytes = 0;
+  int64 _componentsAdded = 0;
+  int64 _componentsRemoved = 0;
+};
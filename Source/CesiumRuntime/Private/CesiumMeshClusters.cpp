@@ -0,0 +1,101 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshClusters.h"
+#include "Rendering/PositionVertexBuffer.h"
+#include <meshoptimizer.h>
+
+namespace {
+
+// The largest clusters that meshoptimizer builds. Large clusters keep the
+// number of draws low when a mesh is partly visible.
+constexpr size_t MaximumClusterVertices = 255;
+constexpr size_t MaximumClusterTriangles = 512;
+
+} // namespace
+
+namespace CesiumMeshClusters {
+
+bool build(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    TArray<CesiumMeshCluster>& clusters) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildMeshClusters)
+
+  const uint32 vertexCount = positions.GetNumVertices();
+  const int32 indexCount = indices.Num();
+  if (vertexCount == 0 || indexCount % 3 != 0 ||
+      indexCount / 3 < MinimumTriangleCount) {
+    return false;
+  }
+
+  for (int32 i = 0; i < indexCount; ++i) {
+    if (indices[i] >= vertexCount) {
+      return false;
+    }
+  }
+
+  const float* pPositions = &positions.VertexPosition(0).X;
+  constexpr size_t positionStride = sizeof(FVector3f);
+
+  const size_t maximumClusters = meshopt_buildMeshletsBound(
+      size_t(indexCount),
+      MaximumClusterVertices,
+      MaximumClusterTriangles);
+  TArray<meshopt_Meshlet> meshlets;
+  meshlets.SetNumUninitialized(int32(maximumClusters));
+  TArray<uint32> meshletVertices;
+  meshletVertices.SetNumUninitialized(
+      int32(maximumClusters * MaximumClusterVertices));
+  TArray<uint8> meshletTriangles;
+  meshletTriangles.SetNumUninitialized(
+      int32(maximumClusters * MaximumClusterTriangles * 3));
+
+  // The cone weight only matters for backface culling of clusters, which
+  // isn't used because tile materials are two-sided.
+  const int32 clusterCount = int32(meshopt_buildMeshlets(
+      meshlets.GetData(),
+      meshletVertices.GetData(),
+      meshletTriangles.GetData(),
+      indices.GetData(),
+      size_t(indexCount),
+      pPositions,
+      size_t(vertexCount),
+      positionStride,
+      MaximumClusterVertices,
+      MaximumClusterTriangles,
+      0.0f));
+
+  TArray<uint32> clusteredIndices;
+  clusteredIndices.Reserve(indexCount);
+  clusters.Reset(clusterCount);
+
+  for (int32 i = 0; i < clusterCount; ++i) {
+    const meshopt_Meshlet& meshlet = meshlets[i];
+    const uint32* pVertices = &meshletVertices[meshlet.vertex_offset];
+    const uint8* pTriangles = &meshletTriangles[meshlet.triangle_offset];
+
+    const meshopt_Bounds bounds = meshopt_computeMeshletBounds(
+        pVertices,
+        pTriangles,
+        meshlet.triangle_count,
+        pPositions,
+        size_t(vertexCount),
+        positionStride);
+
+    CesiumMeshCluster& cluster = clusters.Emplace_GetRef();
+    cluster.center =
+        FVector3f(bounds.center[0], bounds.center[1], bounds.center[2]);
+    cluster.radius = bounds.radius;
+    cluster.firstIndex = uint32(clusteredIndices.Num());
+    cluster.triangleCount = meshlet.triangle_count;
+
+    for (uint32 j = 0; j < meshlet.triangle_count * 3; ++j) {
+      clusteredIndices.Add(pVertices[pTriangles[j]]);
+    }
+  }
+
+  indices = MoveTemp(clusteredIndices);
+  return true;
+}
+
+} // namespace CesiumMeshClusters
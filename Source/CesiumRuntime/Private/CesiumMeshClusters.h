@@ -0,0 +1,60 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FPositionVertexBuffer;
+
+/**
+ * A cluster of nearby triangles of a tile mesh, whose indices are contiguous
+ * in the index buffer, so that it can be culled and drawn on its own.
+ */
+struct CesiumMeshCluster {
+  /**
+   * The center of the bounding sphere of the cluster, in the local
+   * coordinates of the mesh.
+   */
+  FVector3f center;
+
+  /**
+   * The radius of the bounding sphere of the cluster.
+   */
+  float radius;
+
+  /**
+   * The index of the first index of the cluster in the index buffer.
+   */
+  uint32 firstIndex;
+
+  /**
+   * The number of triangles in the cluster.
+   */
+  uint32 triangleCount;
+};
+
+namespace CesiumMeshClusters {
+
+/**
+ * The smallest number of triangles for which a mesh is split into clusters.
+ * Smaller meshes are culled as a whole.
+ */
+constexpr int32 MinimumTriangleCount = 8192;
+
+/**
+ * @brief Splits a triangle mesh into clusters of nearby triangles, and
+ * reorders its triangles so that those of each cluster are contiguous. May be
+ * called from any thread.
+ *
+ * @param positions The positions of the vertices.
+ * @param indices The indices of the triangles, which are reordered.
+ * @param clusters Receives the clusters, in the order of their triangles.
+ * @returns false if the mesh has fewer than {@link MinimumTriangleCount}
+ * triangles or an index is out of range, in which case nothing is modified.
+ */
+bool build(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    TArray<CesiumMeshCluster>& clusters);
+
+} // namespace CesiumMeshClusters
@@ -0,0 +1,119 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumMeshResourceBatch.h"
+#include "CesiumCommon.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "RenderingThread.h"
+#include "StaticMeshResources.h"
+
+namespace CesiumMeshResourceBatch {
+
+namespace {
+struct PendingMesh {
+  TWeakObjectPtr<UStaticMesh> pStaticMesh;
+  TWeakObjectPtr<UStaticMeshComponent> pComponent;
+};
+
+int32 scopeDepth = 0;
+TArray<PendingMesh> pendingMeshes;
+
+void initAndRegister(UStaticMesh& staticMesh, UStaticMeshComponent& component) {
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitResources)
+    staticMesh.InitResources();
+  }
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RegisterComponent)
+    component.RegisterComponent();
+  }
+}
+
+void initBuffers(
+    FRHICommandListBase& RHICmdList,
+    FStaticMeshRenderData& renderData) {
+  for (FStaticMeshLODResources& lod : renderData.LODResources) {
+#if ENGINE_VERSION_5_3_OR_HIGHER
+    lod.IndexBuffer.InitResource(RHICmdList);
+    lod.VertexBuffers.PositionVertexBuffer.InitResource(RHICmdList);
+    lod.VertexBuffers.StaticMeshVertexBuffer.InitResource(RHICmdList);
+    lod.VertexBuffers.ColorVertexBuffer.InitResource(RHICmdList);
+#else
+    lod.IndexBuffer.InitResource();
+    lod.VertexBuffers.PositionVertexBuffer.InitResource();
+    lod.VertexBuffers.StaticMeshVertexBuffer.InitResource();
+    lod.VertexBuffers.ColorVertexBuffer.InitResource();
+#endif
+  }
+}
+
+void flush() {
+  TArray<PendingMesh> meshes = MoveTemp(pendingMeshes);
+  pendingMeshes.Reset();
+
+  // Tiles that were unloaded in the meantime may have destroyed their
+  // components, or given them back to the component pool for other meshes.
+  TArray<TPair<UStaticMesh*, UStaticMeshComponent*>> valid;
+  valid.Reserve(meshes.Num());
+  for (const PendingMesh& pending : meshes) {
+    UStaticMesh* pStaticMesh = pending.pStaticMesh.Get();
+    UStaticMeshComponent* pComponent = pending.pComponent.Get();
+    if (IsValid(pStaticMesh) && IsValid(pComponent) &&
+        !pComponent->IsRegistered() &&
+        pComponent->GetStaticMesh() == pStaticMesh &&
+        pStaticMesh->GetRenderData()) {
+      valid.Emplace(pStaticMesh, pComponent);
+    }
+  }
+
+  if (valid.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitMeshResourceBatch)
+
+  // The render data outlives this command, because the meshes' resources are
+  // only released by render commands that are enqueued after it.
+  TArray<FStaticMeshRenderData*> renderData;
+  renderData.Reserve(valid.Num());
+  for (const TPair<UStaticMesh*, UStaticMeshComponent*>& mesh : valid) {
+    renderData.Add(mesh.Key->GetRenderData());
+  }
+
+  ENQUEUE_RENDER_COMMAND(Cesium_InitMeshBuffers)
+  ([renderData = MoveTemp(renderData)](FRHICommandListImmediate& RHICmdList) {
+    for (FStaticMeshRenderData* pRenderData : renderData) {
+      initBuffers(RHICmdList, *pRenderData);
+    }
+  });
+
+  for (const TPair<UStaticMesh*, UStaticMeshComponent*>& mesh : valid) {
+    initAndRegister(*mesh.Key, *mesh.Value);
+  }
+}
+} // namespace
+
+Scope::Scope() {
+  check(IsInGameThread());
+  ++scopeDepth;
+}
+
+Scope::~Scope() {
+  check(IsInGameThread());
+  if (--scopeDepth == 0) {
+    flush();
+  }
+}
+
+void initResourcesAndRegister(
+    UStaticMesh& staticMesh,
+    UStaticMeshComponent& component) {
+  check(IsInGameThread());
+  if (scopeDepth > 0) {
+    pendingMeshes.Add(PendingMesh{&staticMesh, &component});
+  } else {
+    initAndRegister(staticMesh, component);
+  }
+}
+
+} // namespace CesiumMeshResourceBatch
@@ -0,0 +1,49 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+class UStaticMeshComponent;
+
+/**
+ * Coalesces the creation of the vertex and index buffers of new tile meshes.
+ *
+ * Each UStaticMesh::InitResources creates the RHI buffers of its mesh in
+ * render commands of its own, which adds up to thousands of small commands
+ * when many tiles finish loading in the same frame. While a {@link Scope} is
+ * open, the meshes are queued instead, along with the components that draw
+ * them. When the outermost scope closes, the buffers of all of them are
+ * created in a single render command. Their InitResources then only finds the
+ * buffers already created, and the components are registered.
+ *
+ * Outside of a scope, a mesh is initialized and its component registered
+ * right away. All functions must be called from the game thread.
+ */
+namespace CesiumMeshResourceBatch {
+
+/**
+ * @brief Queues the meshes of new tiles until it is destroyed. Scopes can be
+ * nested, and only the outermost one initializes the queued meshes.
+ */
+class Scope {
+public:
+  Scope();
+  ~Scope();
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+};
+
+/**
+ * @brief Initializes the render resources of a mesh and registers the
+ * component that draws it, now or when the open scope closes. If the mesh or
+ * the component is destroyed, or the component no longer draws the mesh, by
+ * then, neither is touched.
+ */
+void initResourcesAndRegister(
+    UStaticMesh& staticMesh,
+    UStaticMeshComponent& component);
+
+} // namespace CesiumMeshResourceBatch
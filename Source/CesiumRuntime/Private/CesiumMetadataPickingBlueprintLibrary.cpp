@@ -1,6 +1,7 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumMetadataPickingBlueprintLibrary.h"
+#include "CesiumFeatureIndex.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumMetadataValue.h"
@@ -230,3 +231,70 @@ UCesiumMetadataPickingBlueprintLibrary::GetPropertyTextureValuesFromHit(
       propertyTextures[PropertyTextureIndex],
       Hit);
 }
+
+namespace {
+
+const CesiumFeatureIndex::Feature* findIndexedFeature(
+    const UPrimitiveComponent* Component,
+    int64 FeatureID,
+    int64 FeatureIDSetIndex,
+    const CesiumFeatureIndex*& pFeatureIndex) {
+  const UCesiumGltfPrimitiveComponent* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(Component);
+  if (!IsValid(pGltfComponent) || FeatureIDSetIndex < 0 ||
+      FeatureIDSetIndex > MAX_int32) {
+    return nullptr;
+  }
+
+  pFeatureIndex = pGltfComponent->getPrimitiveData().pFeatureIndex.Get();
+  return pFeatureIndex
+             ? pFeatureIndex->find(int32(FeatureIDSetIndex), FeatureID)
+             : nullptr;
+}
+
+} // namespace
+
+bool UCesiumMetadataPickingBlueprintLibrary::GetFeatureBounds(
+    const UPrimitiveComponent* Component,
+    int64 FeatureID,
+    FBox& Bounds,
+    int64 FeatureIDSetIndex) {
+  const CesiumFeatureIndex* pFeatureIndex = nullptr;
+  const CesiumFeatureIndex::Feature* pFeature = findIndexedFeature(
+      Component,
+      FeatureID,
+      FeatureIDSetIndex,
+      pFeatureIndex);
+  if (!pFeature) {
+    Bounds = FBox(ForceInit);
+    return false;
+  }
+
+  Bounds = FBox(pFeature->bounds).TransformBy(
+      Component->GetComponentTransform());
+  return true;
+}
+
+TArray<int64> UCesiumMetadataPickingBlueprintLibrary::GetFacesOfFeature(
+    const UPrimitiveComponent* Component,
+    int64 FeatureID,
+    int64 FeatureIDSetIndex) {
+  const CesiumFeatureIndex* pFeatureIndex = nullptr;
+  const CesiumFeatureIndex::Feature* pFeature = findIndexedFeature(
+      Component,
+      FeatureID,
+      FeatureIDSetIndex,
+      pFeatureIndex);
+  if (!pFeature) {
+    return TArray<int64>();
+  }
+
+  TArray<int64> faces;
+  for (const CesiumFeatureIndex::FaceRange& range :
+       pFeatureIndex->getFaceRanges(*pFeature)) {
+    for (int32 i = 0; i < range.faceCount; ++i) {
+      faces.Add(range.firstFace + i);
+    }
+  }
+  return faces;
+}
@@ -0,0 +1,35 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <type_traits>
+
+namespace CesiumMetadataRawValues {
+
+/**
+ * Determines whether the raw values of a property with the given element type
+ * can be copied into values of type TResult, and then normalized, scaled, and
+ * offset, with the same results as converting each value with
+ * MetadataConversions.
+ */
+template <typename T, bool Normalized, typename TResult>
+constexpr bool canCopyRawValues() {
+  if constexpr (!std::is_arithmetic_v<T> || std::is_same_v<T, bool>) {
+    return false;
+  } else if constexpr (Normalized) {
+    // Normalized values are transformed in double precision.
+    return std::is_same_v<TResult, double>;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    // Scale and offset are applied in the precision of the property, and
+    // narrowing is range-checked.
+    return std::is_same_v<T, TResult>;
+  } else if constexpr (std::is_floating_point_v<TResult>) {
+    return true;
+  } else {
+    // Integers must fit without a range check.
+    return std::is_same_v<T, TResult> ||
+           (std::is_signed_v<TResult> && sizeof(T) < sizeof(TResult));
+  }
+}
+
+} // namespace CesiumMetadataRawValues
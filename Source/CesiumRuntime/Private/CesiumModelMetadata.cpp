@@ -15,12 +15,10 @@ static FCesiumPropertyTexture EmptyPropertyTexture;
 
 FCesiumModelMetadata::FCesiumModelMetadata(
     const Model& InModel,
-    const ExtensionModelExtStructuralMetadata& Metadata) {
-  this->_propertyTables.Reserve(Metadata.propertyTables.size());
-  for (const auto& propertyTable : Metadata.propertyTables) {
-    this->_propertyTables.Emplace(FCesiumPropertyTable(InModel, propertyTable));
-  }
-
+    const ExtensionModelExtStructuralMetadata& Metadata)
+    : _pModel(Metadata.propertyTables.empty() ? nullptr : &InModel) {
+  // The property textures are created right away, because they may need to
+  // copy images that the model gives away once it is loaded.
   this->_propertyTextures.Reserve(Metadata.propertyTextures.size());
   for (const auto& propertyTexture : Metadata.propertyTextures) {
     this->_propertyTextures.Emplace(
@@ -28,6 +26,32 @@ FCesiumModelMetadata::FCesiumModelMetadata(
   }
 }
 
+void FCesiumModelMetadata::setModel(const Model& InModel) {
+  if (this->_pModel) {
+    this->_pModel = &InModel;
+  }
+}
+
+void FCesiumModelMetadata::createPropertyTables() const {
+  if (!this->_pModel) {
+    return;
+  }
+
+  const Model& model = *this->_pModel;
+  this->_pModel = nullptr;
+
+  const ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  if (!pMetadata) {
+    return;
+  }
+
+  this->_propertyTables.Reserve(pMetadata->propertyTables.size());
+  for (const auto& propertyTable : pMetadata->propertyTables) {
+    this->_propertyTables.Emplace(FCesiumPropertyTable(model, propertyTable));
+  }
+}
+
 /*static*/
 const FCesiumModelMetadata&
 UCesiumModelMetadataBlueprintLibrary::GetModelMetadata(
@@ -51,6 +75,7 @@ UCesiumModelMetadataBlueprintLibrary::GetModelMetadata(
 /*static*/ const TMap<FString, FCesiumPropertyTable>
 UCesiumModelMetadataBlueprintLibrary::GetFeatureTables(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata) {
+  ModelMetadata.createPropertyTables();
   TMap<FString, FCesiumPropertyTable> result;
   for (const FCesiumPropertyTable& propertyTable :
        ModelMetadata._propertyTables) {
@@ -80,6 +105,7 @@ UCesiumModelMetadataBlueprintLibrary::GetFeatureTextures(
 const TArray<FCesiumPropertyTable>&
 UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata) {
+  ModelMetadata.createPropertyTables();
   return ModelMetadata._propertyTables;
 }
 
@@ -87,6 +113,7 @@ UCesiumModelMetadataBlueprintLibrary::GetPropertyTables(
 UCesiumModelMetadataBlueprintLibrary::GetPropertyTable(
     UPARAM(ref) const FCesiumModelMetadata& ModelMetadata,
     const int64 Index) {
+  ModelMetadata.createPropertyTables();
   if (Index < 0 || Index >= ModelMetadata._propertyTables.Num()) {
     return EmptyPropertyTable;
   }
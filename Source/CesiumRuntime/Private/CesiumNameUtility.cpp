@@ -0,0 +1,32 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumNameUtility.h"
+
+namespace CesiumNameUtility {
+
+std::string constrainLength(const std::string& s, const size_t maxLength) {
+  if (s.length() <= maxLength) {
+    return s;
+  }
+  if (maxLength <= 3) {
+    return s.substr(0, maxLength);
+  }
+  const std::string ellipsis("...");
+  const size_t prefixLength = ((maxLength - ellipsis.length()) + 1) / 2;
+  const size_t suffixLength = (maxLength - ellipsis.length()) / 2;
+  const std::string prefix = s.substr(0, prefixLength);
+  const std::string suffix = s.substr(s.length() - suffixLength, suffixLength);
+  return prefix + ellipsis + suffix;
+}
+
+FName createSafeName(
+    const std::string& prefix,
+    const std::string& suffix,
+    const size_t maxLength) {
+  std::string constrainedPrefix =
+      constrainLength(prefix, maxLength - suffix.length());
+  std::string combined = constrainedPrefix + suffix;
+  return FName(combined.c_str());
+}
+
+} // namespace CesiumNameUtility
@@ -0,0 +1,47 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "UObject/NameTypes.h"
+#include <string>
+
+namespace CesiumNameUtility {
+
+/**
+ * @brief Constrain the length of the given string.
+ *
+ * If the string is shorter than the maximum length, it is returned.
+ * If it is not longer than 3 characters, the first maxLength
+ * characters will be returned.
+ * Otherwise, the result will be of the form `prefix + "..." + suffix`,
+ * with the prefix and suffix chosen so that the length of the result
+ * is maxLength
+ *
+ * @param s The input string
+ * @param maxLength The maximum length.
+ * @return The constrained string
+ */
+std::string constrainLength(const std::string& s, const size_t maxLength);
+
+/**
+ * @brief Create an FName from the given strings.
+ *
+ * This will combine the prefix and the suffix and create an FName.
+ * If the string would be longer than the given length, then
+ * the prefix will be shortened (in an unspecified way), to
+ * constrain the result to a length of maxLength.
+ *
+ * The default maximum length is 256, because Unreal may in turn
+ * add a prefix like the `/Internal/Path/Name` to this name.
+ *
+ * @param prefix The prefix input string
+ * @param suffix The suffix input string
+ * @param maxLength The maximum length
+ * @return The FName
+ */
+FName createSafeName(
+    const std::string& prefix,
+    const std::string& suffix,
+    const size_t maxLength = 256);
+
+} // namespace CesiumNameUtility
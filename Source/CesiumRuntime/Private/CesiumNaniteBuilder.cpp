@@ -0,0 +1,170 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumNaniteBuilder.h"
+
+#if WITH_EDITOR
+
+#include "CesiumCommon.h"
+#include "CesiumRuntime.h"
+#include "Engine/EngineTypes.h"
+#include "Modules/ModuleManager.h"
+#include "NaniteBuilder.h"
+#include "RenderUtils.h"
+#include "Rendering/NaniteResources.h"
+#include "StaticMeshResources.h"
+
+namespace {
+
+const FName NaniteBuilderModuleName = TEXT("NaniteBuilder");
+
+Nanite::FResources& getNaniteResources(FStaticMeshRenderData& renderData) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  return *renderData.NaniteResourcesPtr;
+#else
+  return renderData.NaniteResources;
+#endif
+}
+
+} // namespace
+
+namespace CesiumNaniteBuilder {
+
+bool loadModule() {
+  check(IsInGameThread());
+
+  if (!DoesPlatformSupportNanite(GMaxRHIShaderPlatform)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "Build Nanite Meshes is set, but the current platform doesn't render Nanite. Tiles will be rendered without it."));
+    return false;
+  }
+
+  return FModuleManager::Get().LoadModule(NaniteBuilderModuleName) != nullptr;
+}
+
+bool build(FStaticMeshRenderData& renderData, const TArray<uint32>& indices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildNanite)
+
+  Nanite::IBuilderModule* pBuilder =
+      FModuleManager::Get().GetModulePtr<Nanite::IBuilderModule>(
+          NaniteBuilderModuleName);
+  if (!pBuilder || renderData.LODResources.IsEmpty() || indices.IsEmpty()) {
+    return false;
+  }
+
+  const FStaticMeshLODResources& lod = renderData.LODResources[0];
+  const FStaticMeshVertexBuffers& vertexBuffers = lod.VertexBuffers;
+  const uint32 vertexCount =
+      vertexBuffers.PositionVertexBuffer.GetNumVertices();
+  const uint32 texCoordCount =
+      vertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords();
+  const bool hasColors =
+      vertexBuffers.ColorVertexBuffer.GetNumVertices() == vertexCount;
+
+  FMeshNaniteSettings settings;
+  settings.bEnabled = true;
+
+  // Nanite builds its own clusters and simplified levels, and takes the
+  // vertices in the same layout as the static mesh build.
+  TArray<uint32> triangleIndices = indices;
+  TArray<int32> materialIndices;
+  materialIndices.Init(0, indices.Num() / 3);
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  Nanite::IBuilderModule::FInputMeshData input;
+  FMeshBuildVertexData& vertices = input.Vertices;
+  vertices.Position.SetNumUninitialized(vertexCount);
+  vertices.TangentX.SetNumUninitialized(vertexCount);
+  vertices.TangentY.SetNumUninitialized(vertexCount);
+  vertices.TangentZ.SetNumUninitialized(vertexCount);
+  vertices.UVs.SetNum(texCoordCount);
+  for (TArray<FVector2f>& uvs : vertices.UVs) {
+    uvs.SetNumUninitialized(vertexCount);
+  }
+  if (hasColors) {
+    vertices.Color.SetNumUninitialized(vertexCount);
+  }
+
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    vertices.Position[i] = vertexBuffers.PositionVertexBuffer.VertexPosition(i);
+    vertices.TangentX[i] =
+        FVector3f(vertexBuffers.StaticMeshVertexBuffer.VertexTangentX(i));
+    vertices.TangentY[i] =
+        FVector3f(vertexBuffers.StaticMeshVertexBuffer.VertexTangentY(i));
+    vertices.TangentZ[i] =
+        vertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i);
+    for (uint32 uv = 0; uv < texCoordCount; ++uv) {
+      vertices.UVs[uv][i] =
+          vertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, uv);
+    }
+    if (hasColors) {
+      vertices.Color[i] = vertexBuffers.ColorVertexBuffer.VertexColor(i);
+    }
+  }
+
+  input.TriangleIndices = MoveTemp(triangleIndices);
+  input.MaterialIndices = MoveTemp(materialIndices);
+  input.TriangleCounts.Add(uint32(indices.Num() / 3));
+  input.Sections = lod.Sections;
+  input.NumTexCoords = texCoordCount;
+  input.PercentTriangles = 1.0f;
+  input.MaxDeviation = 0.0f;
+
+  Nanite::FResources& resources = getNaniteResources(renderData);
+  const bool succeeded = pBuilder->Build(
+      resources,
+      input,
+      TArrayView<Nanite::IBuilderModule::FOutputMeshData>(),
+      settings);
+#else
+  TArray<FStaticMeshBuildVertex> vertices;
+  vertices.SetNumUninitialized(vertexCount);
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    FStaticMeshBuildVertex& vertex = vertices[i];
+    vertex.Position = vertexBuffers.PositionVertexBuffer.VertexPosition(i);
+    vertex.TangentX =
+        FVector3f(vertexBuffers.StaticMeshVertexBuffer.VertexTangentX(i));
+    vertex.TangentY =
+        FVector3f(vertexBuffers.StaticMeshVertexBuffer.VertexTangentY(i));
+    vertex.TangentZ =
+        FVector3f(vertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(i));
+    for (uint32 uv = 0; uv < MAX_STATIC_TEXCOORDS; ++uv) {
+      vertex.UVs[uv] =
+          uv < texCoordCount
+              ? vertexBuffers.StaticMeshVertexBuffer.GetVertexUV(i, uv)
+              : FVector2f::ZeroVector;
+    }
+    vertex.Color = hasColors ? vertexBuffers.ColorVertexBuffer.VertexColor(i)
+                             : FColor::White;
+  }
+
+  TArray<uint32> meshTriangleCounts;
+  meshTriangleCounts.Add(uint32(indices.Num() / 3));
+
+  Nanite::FResources& resources = getNaniteResources(renderData);
+  const bool succeeded = pBuilder->Build(
+      resources,
+      vertices,
+      triangleIndices,
+      materialIndices,
+      meshTriangleCounts,
+      texCoordCount,
+      settings);
+#endif
+
+  if (!succeeded) {
+    resources = Nanite::FResources();
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("Failed to build Nanite resources for a tile mesh."));
+  }
+
+  return succeeded;
+}
+
+} // namespace CesiumNaniteBuilder
+
+#endif
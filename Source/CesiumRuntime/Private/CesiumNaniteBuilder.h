@@ -0,0 +1,44 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_EDITOR
+
+class FStaticMeshRenderData;
+
+/**
+ * Builds Nanite resources for tile meshes, for tilesets with Build Nanite
+ * Meshes set. Nanite can only be built with the editor's NaniteBuilder
+ * module, so this is only available in the editor, including Play In Editor.
+ */
+namespace CesiumNaniteBuilder {
+
+/**
+ * @brief Loads the NaniteBuilder module, so that {@link build} may be used
+ * from worker threads. Must be called from the game thread.
+ *
+ * @returns false if the module can't be loaded, or the current platform
+ * doesn't render Nanite.
+ */
+bool loadModule();
+
+/**
+ * @brief Builds the Nanite resources of a static mesh from its first LOD,
+ * which must have a single section of triangles. May be called from any
+ * thread once {@link loadModule} has succeeded.
+ *
+ * The LOD resources are kept, and are used where Nanite isn't, such as for
+ * the fallback mesh.
+ *
+ * @param renderData The render data, which receives the Nanite resources.
+ * @param indices The indices of the triangles.
+ * @returns false if the Nanite resources couldn't be built, in which case
+ * the render data is left as it is.
+ */
+bool build(FStaticMeshRenderData& renderData, const TArray<uint32>& indices);
+
+} // namespace CesiumNaniteBuilder
+
+#endif
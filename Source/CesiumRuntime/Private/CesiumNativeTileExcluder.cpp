@@ -0,0 +1,130 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumNativeTileExcluder.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumEllipsoid.h"
+#include "CesiumGeoreference.h"
+#include "CesiumTileExclusionPredicate.h"
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+UCesiumNativeTileExcluder::UCesiumNativeTileExcluder() {
+  PrimaryComponentTick.bCanEverTick = false;
+  bAutoActivate = true;
+}
+
+void UCesiumNativeTileExcluder::AddToTileset() {
+  if (this->_pPredicate) {
+    return;
+  }
+
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  if (!pCesiumTileset) {
+    return;
+  }
+  Tileset* pTileset = pCesiumTileset->GetTileset();
+  if (!pTileset) {
+    return;
+  }
+
+  ACesiumGeoreference* pGeoreference = pCesiumTileset->ResolveGeoreference();
+  UCesiumEllipsoid* pEllipsoid =
+      IsValid(pGeoreference) ? pGeoreference->GetEllipsoid() : nullptr;
+  if (!IsValid(pEllipsoid)) {
+    return;
+  }
+
+  std::vector<CesiumTileExclusionPredicate::Region> regions;
+  regions.reserve(this->Regions.Num());
+  for (const FCesiumTileExclusionRegion& region : this->Regions) {
+    regions.push_back(
+        {GlobeRectangle::fromDegrees(
+             region.West,
+             region.South,
+             region.East,
+             region.North),
+         region.MinimumHeight,
+         region.MaximumHeight});
+  }
+
+  const FTransform worldToTileset =
+      pCesiumTileset->GetActorTransform().Inverse();
+  std::vector<CartographicPolygon> polygons;
+  polygons.reserve(this->Polygons.Num());
+  for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (IsValid(pPolygon)) {
+      polygons.emplace_back(
+          pPolygon->CreateCartographicPolygon(worldToTileset));
+    }
+  }
+
+  std::vector<CesiumTileExclusionPredicate::MetadataCondition> conditions;
+  conditions.reserve(this->MetadataConditions.Num());
+  for (const FCesiumTileMetadataCondition& condition :
+       this->MetadataConditions) {
+    conditions.push_back(
+        {TCHAR_TO_UTF8(*condition.PropertyTableName),
+         TCHAR_TO_UTF8(*condition.PropertyName),
+         condition.Minimum,
+         condition.Maximum});
+  }
+
+  this->_pPredicate = std::make_shared<CesiumTileExclusionPredicate>(
+      pEllipsoid->GetNativeEllipsoid(),
+      std::move(regions),
+      std::move(polygons),
+      this->InvertSelection,
+      std::move(conditions));
+  pTileset->getOptions().excluders.push_back(this->_pPredicate);
+}
+
+void UCesiumNativeTileExcluder::RemoveFromTileset() {
+  if (!this->_pPredicate) {
+    return;
+  }
+
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  Tileset* pTileset = pCesiumTileset ? pCesiumTileset->GetTileset() : nullptr;
+  if (pTileset) {
+    std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+        pTileset->getOptions().excluders;
+    auto it = std::find(excluders.begin(), excluders.end(), this->_pPredicate);
+    if (it != excluders.end()) {
+      excluders.erase(it);
+    }
+  }
+
+  this->_pPredicate.reset();
+}
+
+void UCesiumNativeTileExcluder::Refresh() {
+  this->RemoveFromTileset();
+  this->AddToTileset();
+}
+
+void UCesiumNativeTileExcluder::Activate(bool bReset) {
+  Super::Activate(bReset);
+  this->AddToTileset();
+}
+
+void UCesiumNativeTileExcluder::Deactivate() {
+  Super::Deactivate();
+  this->RemoveFromTileset();
+}
+
+void UCesiumNativeTileExcluder::OnComponentDestroyed(
+    bool bDestroyingHierarchy) {
+  this->RemoveFromTileset();
+  Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+#if WITH_EDITOR
+void UCesiumNativeTileExcluder::PostEditChangeProperty(
+    FPropertyChangedEvent& PropertyChangedEvent) {
+  Super::PostEditChangeProperty(PropertyChangedEvent);
+  this->Refresh();
+}
+#endif
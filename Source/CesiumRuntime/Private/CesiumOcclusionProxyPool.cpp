@@ -0,0 +1,166 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumOcclusionProxyPool.h"
+#include "CalcBounds.h"
+#include "CesiumViewExtension.h"
+#include "VecMath.h"
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <variant>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+
+// The proxies have no components, so they are cheap enough that the number of
+// them is effectively unlimited.
+constexpr int32_t MaximumProxies = 1 << 20;
+
+// Identifies a proxy for as long as it's mapped to a tile. Results are looked
+// up by it, so that results for a previous tile are never applied to a reused
+// proxy. It's shared by all pools, since the view extension is.
+uint32 nextProxyKey = 1;
+
+} // namespace
+
+class CesiumOcclusionProxyPool::Proxy : public TileOcclusionRendererProxy {
+public:
+  Proxy(CesiumOcclusionProxyPool& pool, int32 slot)
+      : slot(slot), _pool(pool) {}
+
+  TileOcclusionState getOcclusionState() const override {
+    return this->state;
+  }
+
+  // Zero while the proxy isn't mapped to a tile.
+  uint32 key = 0;
+
+  TileOcclusionState state = TileOcclusionState::OcclusionUnavailable;
+
+  BoundingVolume bounds =
+      CesiumGeometry::OrientedBoundingBox(glm::dvec3(0.0), glm::dmat3(1.0));
+
+  // The index of this proxy in the proxies of the pool, which is also the
+  // index of its bounds and results.
+  int32 slot;
+
+protected:
+  void reset(const Tile* pTile) override {
+    this->state = TileOcclusionState::OcclusionUnavailable;
+    if (pTile) {
+      this->key = nextProxyKey++;
+      if (nextProxyKey == 0) {
+        nextProxyKey = 1;
+      }
+      this->bounds = pTile->getBoundingVolume();
+    } else {
+      this->key = 0;
+    }
+    this->_pool._changedSlots.Add(this->slot);
+  }
+
+private:
+  CesiumOcclusionProxyPool& _pool;
+};
+
+CesiumOcclusionProxyPool::CesiumOcclusionProxyPool()
+    : TileOcclusionRendererProxyPool(MaximumProxies) {}
+
+CesiumOcclusionProxyPool::~CesiumOcclusionProxyPool() { this->destroyPool(); }
+
+void CesiumOcclusionProxyPool::update(
+    CesiumViewExtension& viewExtension,
+    const ACesium3DTileset* pTileset,
+    const FSceneInterface* pScene,
+    const glm::dmat4& tilesetToUnrealWorld) {
+  if (viewExtension.GetOcclusionResults(pTileset, this->_results)) {
+    for (const CesiumViewExtension::OcclusionResult& result : this->_results) {
+      // A result only applies if the proxy in its slot is still mapped to the
+      // same tile as when it was tested.
+      if (result.slot < int32(this->_proxies.size())) {
+        Proxy* pProxy = this->_proxies[result.slot];
+        if (pProxy->key == result.key) {
+          pProxy->state = result.visible ? TileOcclusionState::NotOccluded
+                                         : TileOcclusionState::Occluded;
+        }
+      }
+    }
+  }
+
+  if (!pScene) {
+    if (this->_pScene) {
+      viewExtension.SetOcclusionBounds(pTileset, nullptr, {});
+      this->_pScene = nullptr;
+    }
+    return;
+  }
+
+  // The bounds of all proxies only need to be computed again when the
+  // tileset moves. Otherwise only the proxies that have been mapped to other
+  // tiles are.
+  const bool updateAll = pScene != this->_pScene ||
+                         tilesetToUnrealWorld != this->_tilesetToUnrealWorld;
+  if (!updateAll && this->_changedSlots.IsEmpty()) {
+    return;
+  }
+
+  this->_pScene = pScene;
+  this->_tilesetToUnrealWorld = tilesetToUnrealWorld;
+
+  // The bounding volumes are in tileset coordinates, so there is no tile
+  // transform to undo.
+  const FTransform tilesetToWorld(VecMath::createMatrix(tilesetToUnrealWorld));
+  const glm::dmat4 identity(1.0);
+  const CalcBoundsOperation calcBounds{tilesetToWorld, identity};
+
+  auto updateBounds = [this, &calcBounds](int32 slot) {
+    const Proxy* pProxy = this->_proxies[slot];
+    CesiumViewExtension::OcclusionBounds& slotBounds = this->_bounds[slot];
+    slotBounds.key = pProxy->key;
+    if (pProxy->key != 0) {
+      const FBoxSphereBounds box = std::visit(calcBounds, pProxy->bounds);
+      slotBounds.center = box.Origin;
+      slotBounds.extent = box.BoxExtent;
+    } else {
+      slotBounds.center = FVector::ZeroVector;
+      slotBounds.extent = FVector::ZeroVector;
+    }
+  };
+
+  this->_bounds.SetNum(int32(this->_proxies.size()));
+  if (updateAll) {
+    for (int32 slot = 0; slot < this->_bounds.Num(); ++slot) {
+      updateBounds(slot);
+    }
+  } else {
+    for (int32 slot : this->_changedSlots) {
+      if (slot < this->_bounds.Num()) {
+        updateBounds(slot);
+      }
+    }
+  }
+  this->_changedSlots.Reset();
+
+  TArray<CesiumViewExtension::OcclusionBounds> bounds(this->_bounds);
+  viewExtension.SetOcclusionBounds(pTileset, pScene, MoveTemp(bounds));
+}
+
+TileOcclusionRendererProxy* CesiumOcclusionProxyPool::createProxy() {
+  Proxy* pProxy = new Proxy(*this, int32(this->_proxies.size()));
+  this->_proxies.push_back(pProxy);
+  this->_changedSlots.Add(pProxy->slot);
+  return pProxy;
+}
+
+void CesiumOcclusionProxyPool::destroyProxy(
+    TileOcclusionRendererProxy* pProxy) {
+  Proxy* pOurProxy = static_cast<Proxy*>(pProxy);
+  Proxy* pLast = this->_proxies.back();
+  if (pLast != pOurProxy) {
+    pLast->slot = pOurProxy->slot;
+    this->_proxies[pLast->slot] = pLast;
+    this->_changedSlots.Add(pLast->slot);
+  }
+  this->_proxies.pop_back();
+  delete pOurProxy;
+}
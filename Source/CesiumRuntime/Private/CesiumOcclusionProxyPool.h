@@ -0,0 +1,69 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumViewExtension.h"
+#include "CoreMinimal.h"
+#include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+class ACesium3DTileset;
+class FSceneInterface;
+
+/**
+ * The occlusion proxies of the tiles of a tileset. Instead of drawing each
+ * proxy with an occlusion query, the bounds of all proxies are tested together
+ * against the depth of the previous frame by the {@link CesiumViewExtension},
+ * so the proxies don't need components and their number isn't limited.
+ */
+class CesiumOcclusionProxyPool
+    : public Cesium3DTilesSelection::TileOcclusionRendererProxyPool {
+public:
+  CesiumOcclusionProxyPool();
+  ~CesiumOcclusionProxyPool();
+
+  /**
+   * @brief Applies the occlusion results that have changed to the proxies,
+   * and submits their bounds to be tested if they have changed. Must be called
+   * from the game thread, once per frame.
+   *
+   * @param viewExtension The view extension that tests the bounds.
+   * @param pTileset The tileset that owns this pool.
+   * @param pScene The scene to test the bounds in, or nullptr to stop testing
+   * them.
+   * @param tilesetToUnrealWorld The transformation from the tileset
+   * coordinates to the Unreal world.
+   */
+  void update(
+      CesiumViewExtension& viewExtension,
+      const ACesium3DTileset* pTileset,
+      const FSceneInterface* pScene,
+      const glm::dmat4& tilesetToUnrealWorld);
+
+protected:
+  Cesium3DTilesSelection::TileOcclusionRendererProxy* createProxy() override;
+
+  void destroyProxy(
+      Cesium3DTilesSelection::TileOcclusionRendererProxy* pProxy) override;
+
+private:
+  class Proxy;
+
+  // The proxies, by slot. The bounds and results of the proxies are indexed
+  // by their slots, which only change when the pool is destroyed.
+  std::vector<Proxy*> _proxies;
+
+  // The bounds that were last submitted, by slot.
+  TArray<CesiumViewExtension::OcclusionBounds> _bounds;
+
+  // The slots of the proxies that have been mapped or unmapped since the
+  // bounds were last submitted.
+  TArray<int32> _changedSlots;
+
+  const FSceneInterface* _pScene = nullptr;
+  glm::dmat4 _tilesetToUnrealWorld = glm::dmat4(1.0);
+
+  // Reused for the changed results each frame.
+  TArray<CesiumViewExtension::OcclusionResult> _results;
+};
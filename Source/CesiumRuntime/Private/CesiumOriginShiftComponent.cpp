@@ -28,6 +28,15 @@ void UCesiumOriginShiftComponent::SetDistance(double NewDistance) {
   this->Distance = NewDistance;
 }
 
+double UCesiumOriginShiftComponent::GetSubLevelPreloadDistance() const {
+  return this->SubLevelPreloadDistance;
+}
+
+void UCesiumOriginShiftComponent::SetSubLevelPreloadDistance(
+    double NewDistance) {
+  this->SubLevelPreloadDistance = FMath::Max(NewDistance, 0.0);
+}
+
 UCesiumOriginShiftComponent::UCesiumOriginShiftComponent() {
   this->PrimaryComponentTick.bCanEverTick = true;
   this->PrimaryComponentTick.TickGroup = ETickingGroup::TG_PrePhysics;
@@ -99,36 +108,39 @@ void UCesiumOriginShiftComponent::TickComponent(
 
   ALevelInstance* ClosestActiveLevel = nullptr;
   double ClosestLevelDistance = std::numeric_limits<double>::max();
-
-  for (int32 i = 0; i < Sublevels.Num(); ++i) {
-    ALevelInstance* Current = Sublevels[i].Get();
-    if (!IsValid(Current))
-      continue;
-
-    UCesiumSubLevelComponent* SubLevelComponent =
-        Current->FindComponentByClass<UCesiumSubLevelComponent>();
-    if (!IsValid(SubLevelComponent))
-      continue;
-
-    if (!SubLevelComponent->GetEnabled())
-      continue;
-
-    FVector LevelEcef =
-        Ellipsoid->LongitudeLatitudeHeightToEllipsoidCenteredEllipsoidFixed(
-            FVector(
-                SubLevelComponent->GetOriginLongitude(),
-                SubLevelComponent->GetOriginLatitude(),
-                SubLevelComponent->GetOriginHeight()));
-
-    double LevelDistance = FVector::Distance(LevelEcef, ActorEcef);
-    if (LevelDistance < SubLevelComponent->GetLoadRadius() &&
-        LevelDistance < ClosestLevelDistance) {
-      ClosestActiveLevel = Current;
-      ClosestLevelDistance = LevelDistance;
+  ALevelInstance* ClosestPreloadLevel = nullptr;
+  double ClosestPreloadLevelDistance = std::numeric_limits<double>::max();
+
+  TArray<UCesiumSubLevelSwitcherComponent::SubLevelInRange> LevelsInRange;
+  Switcher->FindSubLevelsNear(
+      *Ellipsoid,
+      ActorEcef,
+      this->SubLevelPreloadDistance,
+      LevelsInRange);
+
+  for (const UCesiumSubLevelSwitcherComponent::SubLevelInRange& Level :
+       LevelsInRange) {
+    if (Level.distance < Level.loadRadius &&
+        Level.distance < ClosestLevelDistance) {
+      if (ClosestActiveLevel &&
+          ClosestLevelDistance < ClosestPreloadLevelDistance) {
+        // The previous closest level may still be the closest one to preload.
+        ClosestPreloadLevel = ClosestActiveLevel;
+        ClosestPreloadLevelDistance = ClosestLevelDistance;
+      }
+      ClosestActiveLevel = Level.pSubLevel;
+      ClosestLevelDistance = Level.distance;
+    } else if (Level.distance < ClosestPreloadLevelDistance) {
+      // Every level found is within its Load Radius plus the preload
+      // distance, so this one could be preloaded.
+      ClosestPreloadLevel = Level.pSubLevel;
+      ClosestPreloadLevelDistance = Level.distance;
     }
   }
 
   Switcher->SetTargetSubLevel(ClosestActiveLevel);
+  Switcher->SetPreloadSubLevel(
+      this->SubLevelPreloadDistance > 0.0 ? ClosestPreloadLevel : nullptr);
 
   // Only shift the origin when we're outside of all sub-levels.
   bool doOriginShift =
@@ -0,0 +1,72 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPSOPrecaching.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumPointAttenuationVertexFactory.h"
+#include "CesiumTerrainHeightmapVertexFactory.h"
+#include "DataDrivenShaderPlatformInfo.h"
+#include "LocalVertexFactory.h"
+#include "Materials/MaterialInterface.h"
+#include "PSOPrecache.h"
+
+namespace CesiumPSOPrecaching {
+
+void precacheTileset(const ACesium3DTileset& tileset) {
+  if (!IsComponentPSOPrecachingEnabled()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::PrecachePSOs)
+
+  // Like UCesiumGltfComponent::SetBaseMaterials, the defaults stand in for
+  // the materials that the tileset doesn't set.
+  const UCesiumGltfComponent* pDefaults = GetDefault<UCesiumGltfComponent>();
+  TArray<UMaterialInterface*, TInlineAllocator<3>> materials;
+  materials.AddUnique(
+      tileset.GetMaterial() ? tileset.GetMaterial() : pDefaults->BaseMaterial);
+  materials.AddUnique(
+      tileset.GetTranslucentMaterial()
+          ? tileset.GetTranslucentMaterial()
+          : pDefaults->BaseMaterialWithTranslucency);
+#if !PLATFORM_MAC
+  // The water material isn't used on Mac.
+  materials.AddUnique(
+      tileset.GetWaterMaterial() ? tileset.GetWaterMaterial()
+                                 : pDefaults->BaseMaterialWithWater);
+#endif
+
+  // Meshes and points without attenuation use the local vertex factory. The
+  // others require manual vertex fetch, and are only used when the tileset is
+  // set up for them.
+  FPSOPrecacheVertexFactoryDataList vertexFactories;
+  vertexFactories.Add(
+      FPSOPrecacheVertexFactoryData(&FLocalVertexFactory::StaticType));
+  if (RHISupportsManualVertexFetch(GMaxRHIShaderPlatform)) {
+    if (tileset.GetPointCloudShading().Attenuation ||
+        tileset.GetQuantizePointClouds()) {
+      vertexFactories.Add(FPSOPrecacheVertexFactoryData(
+          &FCesiumPointAttenuationVertexFactory::StaticType));
+    }
+    if (tileset.GetUseTerrainHeightmaps()) {
+      vertexFactories.Add(FPSOPrecacheVertexFactoryData(
+          &FCesiumTerrainHeightmapVertexFactory::StaticType));
+    }
+  }
+
+  FPSOPrecacheParams params;
+  params.SetMobility(tileset.GetMobility());
+
+  TArray<FMaterialPSOPrecacheRequestID> requestIDs;
+  for (UMaterialInterface* pMaterial : materials) {
+    if (pMaterial) {
+      pMaterial->PrecachePSOs(
+          vertexFactories,
+          params,
+          EPSOPrecachePriority::High,
+          requestIDs);
+    }
+  }
+}
+
+} // namespace CesiumPSOPrecaching
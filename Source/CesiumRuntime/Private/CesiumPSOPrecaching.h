@@ -0,0 +1,29 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACesium3DTileset;
+
+/**
+ * Precaches the pipeline state objects (PSOs) that the tiles of a tileset
+ * will be drawn with, so that they're compiled in the background before the
+ * first tiles appear, rather than causing a hitch when each is first drawn.
+ *
+ * The material instances of tiles are dynamic instances of the tileset's base
+ * materials, which they share the shaders of. So the PSOs only depend on the
+ * opaque, translucent, and water base materials, including the layers of
+ * their raster overlays and metadata, and on the vertex factories that the
+ * tileset's settings lead to.
+ */
+namespace CesiumPSOPrecaching {
+
+/**
+ * @brief Starts precaching the PSOs of the base materials of a tileset with
+ * the vertex factories that its tiles may use. Does nothing if PSO
+ * precaching is disabled. Must be called from the game thread.
+ */
+void precacheTileset(const ACesium3DTileset& tileset);
+
+} // namespace CesiumPSOPrecaching
@@ -0,0 +1,41 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Map.h"
+#include "Engine/World.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * State that is kept separately for each world, such as the play-in-editor
+ * world and the editor world, which tick in the same frame.
+ *
+ * The state of a world that has been destroyed is forgotten the next time
+ * the state of a new world is added, so the states don't accumulate as worlds
+ * come and go.
+ *
+ * Must only be used from the game thread.
+ */
+template <typename TState> class CesiumPerWorldState {
+public:
+  /**
+   * @brief Gets the state of the given world, adding a default-constructed
+   * one if there is none yet.
+   */
+  TState& get(const UWorld* pWorld) {
+    TState* pState = this->_states.Find(pWorld);
+    if (pState) {
+      return *pState;
+    }
+
+    for (auto it = this->_states.CreateIterator(); it; ++it) {
+      if (!it.Key().ResolveObjectPtr()) {
+        it.RemoveCurrent();
+      }
+    }
+    return this->_states.Add(pWorld);
+  }
+
+private:
+  TMap<TObjectKey<UWorld>, TState> _states;
+};
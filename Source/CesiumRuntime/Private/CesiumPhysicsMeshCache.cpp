@@ -0,0 +1,146 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshCache.h"
+#include "CesiumConvertedTileCache.h"
+#include "Chaos/ChaosArchive.h"
+#include "Hash/CityHash.h"
+#include "Serialization/CustomVersion.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace {
+
+// Changed whenever the way that physics meshes are built or serialized
+// changes, so that physics meshes cached by older versions aren't used.
+constexpr int32 CacheFormatVersion = 1;
+
+std::string createCacheKey(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double simplificationError) {
+  uint64 hash = CityHash64(
+      reinterpret_cast<const char*>(positions.GetData()),
+      uint32(positions.Num() * sizeof(FVector3f)));
+  hash = CityHash64WithSeed(
+      reinterpret_cast<const char*>(indices.GetData()),
+      uint32(indices.Num() * sizeof(uint32)),
+      hash);
+
+  return CesiumConvertedTileCache::createKey(
+      TEXT("physics-mesh"),
+      CacheFormatVersion,
+      FString::Printf(
+          TEXT("%g:%d:%d"),
+          simplificationError,
+          positions.Num(),
+          indices.Num()),
+      hash);
+}
+
+// The custom versions that the mesh was written with are stored before it,
+// so that it can be read with the same versions.
+bool serialize(
+    const CesiumPhysicsMeshes::MeshPointer& pMesh,
+    TArray<uint8>& data) {
+  TArray<uint8> meshData;
+  FMemoryWriter meshWriter(meshData);
+  Chaos::FChaosArchive meshArchive(meshWriter);
+  TArray<CesiumPhysicsMeshes::MeshPointer> meshes{pMesh};
+  meshArchive << meshes;
+  if (meshWriter.IsError()) {
+    return false;
+  }
+
+  FCustomVersionContainer customVersions = meshWriter.GetCustomVersions();
+  FMemoryWriter writer(data);
+  customVersions.Serialize(writer);
+  writer << meshData;
+  return !writer.IsError();
+}
+
+CesiumPhysicsMeshes::MeshPointer
+deserialize(const std::vector<std::byte>& data) {
+  FMemoryReaderView reader(TArrayView<const uint8>(
+      reinterpret_cast<const uint8*>(data.data()),
+      int32(data.size())));
+  FCustomVersionContainer customVersions;
+  customVersions.Serialize(reader);
+  TArray<uint8> meshData;
+  reader << meshData;
+  if (reader.IsError()) {
+    return nullptr;
+  }
+
+  FMemoryReader meshReader(meshData);
+  meshReader.SetCustomVersions(customVersions);
+  Chaos::FChaosArchive meshArchive(meshReader);
+  TArray<CesiumPhysicsMeshes::MeshPointer> meshes;
+  meshArchive << meshes;
+  if (meshReader.IsError() || meshes.Num() != 1) {
+    return nullptr;
+  }
+
+  return meshes[0];
+}
+
+CesiumPhysicsMeshes::MeshPointer build(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double simplificationError) {
+  TArray<FVector3f> simplifiedPositions;
+  TArray<uint32> simplifiedIndices;
+  if (CesiumPhysicsMeshes::simplify(
+          positions,
+          indices,
+          simplificationError,
+          simplifiedPositions,
+          simplifiedIndices)) {
+    return CesiumPhysicsMeshes::build(simplifiedPositions, simplifiedIndices);
+  }
+  return CesiumPhysicsMeshes::build(positions, indices);
+}
+
+} // namespace
+
+namespace CesiumPhysicsMeshCache {
+
+CesiumPhysicsMeshes::MeshPointer getOrBuild(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double simplificationError) {
+  if (!CesiumConvertedTileCache::isEnabled() ||
+      indices.Num() / 3 < MinimumTriangleCount) {
+    return build(positions, indices, simplificationError);
+  }
+
+  const std::string key =
+      createCacheKey(positions, indices, simplificationError);
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReadCachedPhysicsMesh)
+    std::optional<std::vector<std::byte>> maybeData =
+        CesiumConvertedTileCache::read(key);
+    if (maybeData) {
+      CesiumPhysicsMeshes::MeshPointer pMesh = deserialize(*maybeData);
+      if (pMesh) {
+        return pMesh;
+      }
+    }
+  }
+
+  CesiumPhysicsMeshes::MeshPointer pMesh =
+      build(positions, indices, simplificationError);
+  if (!pMesh) {
+    return pMesh;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::WriteCachedPhysicsMesh)
+  TArray<uint8> data;
+  if (serialize(pMesh, data)) {
+    CesiumConvertedTileCache::write(key, data);
+  }
+
+  return pMesh;
+}
+
+} // namespace CesiumPhysicsMeshCache
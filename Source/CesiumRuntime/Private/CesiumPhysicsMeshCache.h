@@ -0,0 +1,37 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPhysicsMeshes.h"
+#include "CoreMinimal.h"
+
+namespace CesiumPhysicsMeshCache {
+
+/**
+ * The smallest number of triangles for which a physics mesh is cached.
+ * Smaller meshes are faster to build than to read from the cache.
+ */
+constexpr int32 MinimumTriangleCount = 2048;
+
+/**
+ * @brief Gets the physics mesh of a triangle mesh from the request cache, or
+ * simplifies and builds it with {@link CesiumPhysicsMeshes::simplify} and
+ * {@link CesiumPhysicsMeshes::build} and stores it there.
+ *
+ * The physics mesh is cached under a hash of the positions, the indices and
+ * the simplification error in the {@link CesiumConvertedTileCache}, so the
+ * physics meshes of tiles that are loaded again, after they were unloaded or
+ * in a later session, don't need to be rebuilt. May be called from any thread.
+ *
+ * @param positions The positions of the vertices.
+ * @param indices The indices of the triangles, three per triangle.
+ * @param simplificationError The largest distance by which the physics mesh
+ * may deviate from the triangles, or zero to not simplify them.
+ * @returns The mesh, or nullptr if it could not be built.
+ */
+CesiumPhysicsMeshes::MeshPointer getOrBuild(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double simplificationError);
+
+} // namespace CesiumPhysicsMeshCache
@@ -0,0 +1,331 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumPrimitive.h"
+#include "PhysicsEngine/BodySetup.h"
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <meshoptimizer.h>
+#include <variant>
+
+using namespace CesiumGltf;
+
+namespace {
+
+bool isTriangleDegenerate(
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& A,
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& B,
+    const Chaos::FTriangleMeshImplicitObject::ParticleVecType& C) {
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType AB = B - A;
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType AC = C - A;
+  Chaos::FTriangleMeshImplicitObject::ParticleVecType Normal =
+      Chaos::FTriangleMeshImplicitObject::ParticleVecType::CrossProduct(AB, AC);
+  return (Normal.SafeNormalize() < 1.e-8f);
+}
+
+template <typename TIndex>
+CesiumPhysicsMeshes::MeshPointer buildWithIndexType(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices) {
+  int32 vertexCount = positions.Num();
+  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+  vertices.AddParticles(vertexCount);
+  for (int32 i = 0; i < vertexCount; ++i) {
+    vertices.X(i) = positions[i];
+  }
+
+  int32 triangleCount = indices.Num() / 3;
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.Reserve(triangleCount);
+  TArray<int32> faceRemap;
+  faceRemap.Reserve(triangleCount);
+
+  // The winding order is reversed, because the Y axis of the mesh is flipped
+  // relative to glTF.
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 index0 = 3 * i;
+    int32 vIndex0 = indices[index0 + 1];
+    int32 vIndex1 = indices[index0];
+    int32 vIndex2 = indices[index0 + 2];
+
+    if (!isTriangleDegenerate(
+            vertices.X(vIndex0),
+            vertices.X(vIndex1),
+            vertices.X(vIndex2))) {
+      triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
+      faceRemap.Add(i);
+    }
+  }
+
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
+  TArray<uint16> materials;
+  materials.SetNum(triangles.Num());
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  return new Chaos::FTriangleMeshImplicitObject(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#else
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#endif
+}
+
+/**
+ * Converts the indices of a glTF primitive, or the implicit indices of a
+ * primitive without them, to a triangle list.
+ */
+struct TriangleListFromIndices {
+  MeshPrimitive::Mode mode;
+  int64 vertexCount;
+  TArray<uint32>& indices;
+
+  bool operator()(std::monostate) {
+    return this->copy(this->vertexCount, [](int64 i) { return i; });
+  }
+
+  template <typename T> bool operator()(const AccessorView<T>& indexView) {
+    if (indexView.status() != AccessorViewStatus::Valid) {
+      return false;
+    }
+    return this->copy(indexView.size(), [&indexView](int64 i) {
+      return int64(indexView[i]);
+    });
+  }
+
+  template <typename GetIndex> bool copy(int64 indexCount, GetIndex&& get) {
+    int64 triangleCount;
+    switch (this->mode) {
+    case MeshPrimitive::Mode::TRIANGLES:
+      triangleCount = indexCount / 3;
+      break;
+    case MeshPrimitive::Mode::TRIANGLE_STRIP:
+    case MeshPrimitive::Mode::TRIANGLE_FAN:
+      triangleCount = indexCount - 2;
+      break;
+    default:
+      return false;
+    }
+
+    if (triangleCount <= 0) {
+      return false;
+    }
+
+    this->indices.SetNumUninitialized(int32(triangleCount * 3));
+    for (int64 i = 0; i < triangleCount; ++i) {
+      int64 face[3];
+      if (this->mode == MeshPrimitive::Mode::TRIANGLES) {
+        face[0] = get(3 * i);
+        face[1] = get(3 * i + 1);
+        face[2] = get(3 * i + 2);
+      } else if (this->mode == MeshPrimitive::Mode::TRIANGLE_FAN) {
+        face[0] = get(0);
+        face[1] = get(i + 1);
+        face[2] = get(i + 2);
+      } else if (i % 2) {
+        face[0] = get(i);
+        face[1] = get(i + 2);
+        face[2] = get(i + 1);
+      } else {
+        face[0] = get(i);
+        face[1] = get(i + 1);
+        face[2] = get(i + 2);
+      }
+
+      for (int32 j = 0; j < 3; ++j) {
+        if (face[j] < 0 || face[j] >= this->vertexCount) {
+          this->indices.Reset();
+          return false;
+        }
+        this->indices[int32(3 * i + j)] = uint32(face[j]);
+      }
+    }
+
+    return true;
+  }
+};
+
+} // namespace
+
+namespace CesiumPhysicsMeshes {
+
+MeshPointer
+build(TArrayView<const FVector3f> positions, const TArray<uint32>& indices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+
+  const uint32 vertexCount = uint32(positions.Num());
+  for (uint32 index : indices) {
+    if (index >= vertexCount) {
+      return nullptr;
+    }
+  }
+
+  return vertexCount <= TNumericLimits<uint16>::Max()
+             ? buildWithIndexType<uint16>(positions, indices)
+             : buildWithIndexType<int32>(positions, indices);
+}
+
+bool simplify(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double maximumError,
+    TArray<FVector3f>& simplifiedPositions,
+    TArray<uint32>& simplifiedIndices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SimplifyPhysicsMesh)
+
+  const int32 vertexCount = positions.Num();
+  const int32 indexCount = indices.Num();
+  if (maximumError <= 0.0 || vertexCount == 0 || indexCount == 0 ||
+      indexCount % 3 != 0) {
+    return false;
+  }
+
+  for (uint32 index : indices) {
+    if (index >= uint32(vertexCount)) {
+      return false;
+    }
+  }
+
+  const float* pPositions = &positions[0].X;
+  constexpr size_t positionStride = sizeof(FVector3f);
+
+  // Only the positions matter for collision, so vertices that are duplicated
+  // for normals or texture coordinates are merged, otherwise they would be
+  // kept as seams.
+  TArray<uint32> shadowIndices;
+  shadowIndices.SetNumUninitialized(indexCount);
+  meshopt_generateShadowIndexBuffer(
+      shadowIndices.GetData(),
+      indices.GetData(),
+      size_t(indexCount),
+      pPositions,
+      size_t(vertexCount),
+      sizeof(FVector3f),
+      positionStride);
+
+  const float scale =
+      meshopt_simplifyScale(pPositions, size_t(vertexCount), positionStride);
+  if (scale <= 0.0f) {
+    return false;
+  }
+
+  simplifiedIndices.SetNumUninitialized(indexCount);
+  const int32 simplifiedIndexCount = int32(meshopt_simplify(
+      simplifiedIndices.GetData(),
+      shadowIndices.GetData(),
+      size_t(indexCount),
+      pPositions,
+      size_t(vertexCount),
+      positionStride,
+      0,
+      float(maximumError / scale),
+      meshopt_SimplifyLockBorder,
+      nullptr));
+  if (simplifiedIndexCount == 0 || simplifiedIndexCount >= indexCount) {
+    simplifiedIndices.Reset();
+    return false;
+  }
+  simplifiedIndices.SetNum(simplifiedIndexCount);
+
+  // Only the vertices that are still used are kept.
+  TArray<uint32> remap;
+  remap.SetNumUninitialized(vertexCount);
+  const int32 simplifiedVertexCount = int32(meshopt_optimizeVertexFetchRemap(
+      remap.GetData(),
+      simplifiedIndices.GetData(),
+      size_t(simplifiedIndexCount),
+      size_t(vertexCount)));
+  meshopt_remapIndexBuffer(
+      simplifiedIndices.GetData(),
+      simplifiedIndices.GetData(),
+      size_t(simplifiedIndexCount),
+      remap.GetData());
+
+  simplifiedPositions.SetNumUninitialized(simplifiedVertexCount);
+  for (int32 i = 0; i < vertexCount; ++i) {
+    if (remap[i] != ~0u) {
+      simplifiedPositions[remap[i]] = positions[i];
+    }
+  }
+
+  return true;
+}
+
+bool copyTriangles(
+    const AccessorView<FVector3f>& positionView,
+    const IndexAccessorType& indexAccessor,
+    int32_t mode,
+    TArray<FVector3f>& positions,
+    TArray<uint32>& indices) {
+  if (positionView.status() != AccessorViewStatus::Valid ||
+      positionView.size() == 0) {
+    return false;
+  }
+
+  if (!std::visit(
+          TriangleListFromIndices{mode, positionView.size(), indices},
+          indexAccessor)) {
+    return false;
+  }
+
+  // Like the vertex buffers of the mesh, the Y coordinates are inverted to
+  // convert the positions to Unreal's left-handed coordinate system.
+  positions.SetNumUninitialized(int32(positionView.size()));
+  for (int32 i = 0; i < positions.Num(); ++i) {
+    const FVector3f& position = positionView[i];
+    positions[i] = FVector3f(position.X, -position.Y, position.Z);
+  }
+
+  return true;
+}
+
+bool copyTriangles(
+    const CesiumPrimitiveData& primitiveData,
+    TArray<FVector3f>& positions,
+    TArray<uint32>& indices) {
+  if (!primitiveData.pMeshPrimitive) {
+    return false;
+  }
+
+  return copyTriangles(
+      primitiveData.PositionAccessor,
+      primitiveData.IndexAccessor,
+      primitiveData.pMeshPrimitive->mode,
+      positions,
+      indices);
+}
+
+void addMesh(UBodySetup& bodySetup, const MeshPointer& pMesh) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  bodySetup.TriMeshGeometries.Add(pMesh);
+#else
+  bodySetup.ChaosTriMeshes.Add(pMesh);
+#endif
+}
+
+void removeMeshes(UBodySetup& bodySetup) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  bodySetup.TriMeshGeometries.Empty();
+#else
+  bodySetup.ChaosTriMeshes.Empty();
+#endif
+}
+
+bool hasMeshes(const UBodySetup& bodySetup) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  return !bodySetup.TriMeshGeometries.IsEmpty();
+#else
+  return !bodySetup.ChaosTriMeshes.IsEmpty();
+#endif
+}
+
+} // namespace CesiumPhysicsMeshes
@@ -0,0 +1,139 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "CoreMinimal.h"
+#include "Templates/SharedPointer.h"
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/AccessorView.h>
+#include <cstdint>
+
+class CesiumPrimitiveData;
+class UBodySetup;
+
+namespace CesiumPhysicsMeshes {
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+using MeshPointer = Chaos::FTriangleMeshImplicitObjectPtr;
+#else
+using MeshPointer =
+    TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+#endif
+
+/**
+ * The state of the physics mesh of a primitive, when physics meshes are
+ * created on demand.
+ */
+enum class OnDemandState {
+  /**
+   * The primitive has no physics mesh.
+   */
+  None,
+
+  /**
+   * The physics mesh is being built in a worker thread.
+   */
+  Building,
+
+  /**
+   * The physics mesh has been added to the body setup of the primitive.
+   */
+  Added,
+
+  /**
+   * The primitive has no triangles to build a physics mesh from.
+   */
+  Unavailable
+};
+
+/**
+ * @brief Builds a Chaos triangle mesh for collision. Degenerate triangles are
+ * skipped, but the face indices of hits still refer to the triangles in
+ * `indices`. May be called from any thread.
+ *
+ * @param positions The positions of the vertices, in the local coordinates of
+ * the mesh.
+ * @param indices The indices of the triangles, three per triangle.
+ * @returns The mesh, or nullptr if an index is out of range.
+ */
+MeshPointer
+build(TArrayView<const FVector3f> positions, const TArray<uint32>& indices);
+
+/**
+ * @brief Simplifies a triangle mesh before it is built into a collision mesh
+ * with {@link build}. The borders of the mesh are kept, so that the collision
+ * meshes of neighboring tiles still meet. May be called from any thread.
+ *
+ * @param positions The positions of the vertices.
+ * @param indices The indices of the triangles, three per triangle.
+ * @param maximumError The largest distance by which the simplified mesh may
+ * deviate from the original, in the units of the positions.
+ * @param simplifiedPositions Receives the positions of the vertices that are
+ * used by the simplified mesh.
+ * @param simplifiedIndices Receives the indices of the simplified triangles.
+ * @returns false if the mesh could not be simplified, in which case the
+ * original mesh should be used.
+ */
+bool simplify(
+    TArrayView<const FVector3f> positions,
+    const TArray<uint32>& indices,
+    double maximumError,
+    TArray<FVector3f>& simplifiedPositions,
+    TArray<uint32>& simplifiedIndices);
+
+/**
+ * @brief Copies the triangles of a glTF primitive into a triangle list, in the
+ * order of the faces of the primitive, so that the collision mesh of the
+ * primitive can be built later with {@link build}. Must be called from the
+ * game thread, while the glTF of the primitive is still loaded.
+ *
+ * @param primitiveData The data of the primitive.
+ * @param positions Receives the positions of the vertices, in the local
+ * coordinates of the mesh.
+ * @param indices Receives the indices of the triangles.
+ * @returns false if the primitive has no triangles.
+ */
+bool copyTriangles(
+    const CesiumPrimitiveData& primitiveData,
+    TArray<FVector3f>& positions,
+    TArray<uint32>& indices);
+
+/**
+ * @brief Copies the triangles of a glTF primitive, given its accessors, into a
+ * triangle list in the order of the faces of the primitive. May be called from
+ * any thread while the glTF is loaded.
+ *
+ * @param positionView The position accessor of the primitive.
+ * @param indexAccessor The index accessor of the primitive, or std::monostate
+ * if the primitive isn't indexed.
+ * @param mode The {@link CesiumGltf::MeshPrimitive::Mode} of the primitive.
+ * @param positions Receives the positions of the vertices, in the local
+ * coordinates of the mesh.
+ * @param indices Receives the indices of the triangles.
+ * @returns false if the primitive has no triangles.
+ */
+bool copyTriangles(
+    const CesiumGltf::AccessorView<FVector3f>& positionView,
+    const CesiumGltf::IndexAccessorType& indexAccessor,
+    int32_t mode,
+    TArray<FVector3f>& positions,
+    TArray<uint32>& indices);
+
+/**
+ * @brief Adds a collision mesh to a body setup.
+ */
+void addMesh(UBodySetup& bodySetup, const MeshPointer& pMesh);
+
+/**
+ * @brief Removes all collision meshes from a body setup.
+ */
+void removeMeshes(UBodySetup& bodySetup);
+
+/**
+ * @brief Determines if a body setup has any collision meshes.
+ */
+bool hasMeshes(const UBodySetup& bodySetup);
+
+} // namespace CesiumPhysicsMeshes
@@ -14,10 +14,12 @@
 #define RHI_CREATE_BUFFER RHICmdList.CreateBuffer
 #define RHI_LOCK_BUFFER RHICmdList.LockBuffer
 #define RHI_UNLOCK_BUFFER RHICmdList.UnlockBuffer
+#define RHI_CREATE_SHADER_RESOURCE_VIEW RHICmdList.CreateShaderResourceView
 #else
 #define RHI_CREATE_BUFFER RHICreateBuffer
 #define RHI_LOCK_BUFFER RHILockBuffer
 #define RHI_UNLOCK_BUFFER RHIUnlockBuffer
+#define RHI_CREATE_SHADER_RESOURCE_VIEW RHICreateShaderResourceView
 #endif
 
 void FCesiumPointAttenuationIndexBuffer::INIT_RHI_SIGNATURE {
@@ -57,6 +59,38 @@ void FCesiumPointAttenuationIndexBuffer::INIT_RHI_SIGNATURE {
   RHI_UNLOCK_BUFFER(IndexBufferRHI);
 }
 
+void FCesiumQuantizedPointPositionBuffer::INIT_RHI_SIGNATURE {
+  if (!Positions || Positions->IsEmpty()) {
+    return;
+  }
+
+  check(IsInRenderingThread());
+
+  FRHIResourceCreateInfo CreateInfo(
+      TEXT("FCesiumQuantizedPointPositionBuffer"));
+  const uint32 Size = uint32(Positions->Num()) * sizeof(uint16);
+
+  VertexBufferRHI = RHI_CREATE_BUFFER(
+      Size,
+      BUF_Static | BUF_ShaderResource,
+      0,
+      ERHIAccess::SRVMask,
+      CreateInfo);
+
+  void* Data = RHI_LOCK_BUFFER(VertexBufferRHI, 0, Size, RLM_WriteOnly);
+  FMemory::Memcpy(Data, Positions->GetData(), Size);
+  RHI_UNLOCK_BUFFER(VertexBufferRHI);
+
+  // The positions are read as normalized values between zero and one.
+  PositionsSRV =
+      RHI_CREATE_SHADER_RESOURCE_VIEW(VertexBufferRHI, sizeof(uint16), PF_G16);
+}
+
+void FCesiumQuantizedPointPositionBuffer::ReleaseRHI() {
+  PositionsSRV.SafeRelease();
+  FVertexBuffer::ReleaseRHI();
+}
+
 class FCesiumPointAttenuationVertexFactoryShaderParameters
     : public FVertexFactoryShaderParameters {
 
@@ -67,12 +101,20 @@ class FCesiumPointAttenuationVertexFactoryShaderParameters
 public:
   void Bind(const FShaderParameterMap& ParameterMap) {
     PositionBuffer.Bind(ParameterMap, TEXT("PositionBuffer"));
+    QuantizedPositionBuffer.Bind(
+        ParameterMap,
+        TEXT("QuantizedPositionBuffer"));
     PackedTangentsBuffer.Bind(ParameterMap, TEXT("PackedTangentsBuffer"));
     ColorBuffer.Bind(ParameterMap, TEXT("ColorBuffer"));
     TexCoordBuffer.Bind(ParameterMap, TEXT("TexCoordBuffer"));
     NumTexCoords.Bind(ParameterMap, TEXT("NumTexCoords"));
     bHasPointColors.Bind(ParameterMap, TEXT("bHasPointColors"));
     AttenuationParameters.Bind(ParameterMap, TEXT("AttenuationParameters"));
+    bHasQuantizedPositions.Bind(ParameterMap, TEXT("bHasQuantizedPositions"));
+    QuantizedPositionOffset.Bind(
+        ParameterMap,
+        TEXT("QuantizedPositionOffset"));
+    QuantizedPositionScale.Bind(ParameterMap, TEXT("QuantizedPositionScale"));
   }
 
   void GetElementShaderBindings(
@@ -90,6 +132,15 @@ public:
     if (UserData->PositionBuffer && PositionBuffer.IsBound()) {
       ShaderBindings.Add(PositionBuffer, UserData->PositionBuffer);
     }
+    if (QuantizedPositionBuffer.IsBound()) {
+      // The parameter must be bound even when the positions aren't quantized,
+      // so the float positions, which are read the same way, stand in for
+      // them.
+      ShaderBindings.Add(
+          QuantizedPositionBuffer,
+          UserData->QuantizedPositionBuffer ? UserData->QuantizedPositionBuffer
+                                            : UserData->PositionBuffer);
+    }
     if (UserData->PackedTangentsBuffer && PackedTangentsBuffer.IsBound()) {
       ShaderBindings.Add(PackedTangentsBuffer, UserData->PackedTangentsBuffer);
     }
@@ -110,6 +161,21 @@ public:
           AttenuationParameters,
           UserData->AttenuationParameters);
     }
+    if (bHasQuantizedPositions.IsBound()) {
+      ShaderBindings.Add(
+          bHasQuantizedPositions,
+          UserData->bHasQuantizedPositions);
+    }
+    if (QuantizedPositionOffset.IsBound()) {
+      ShaderBindings.Add(
+          QuantizedPositionOffset,
+          UserData->QuantizedPositionOffset);
+    }
+    if (QuantizedPositionScale.IsBound()) {
+      ShaderBindings.Add(
+          QuantizedPositionScale,
+          UserData->QuantizedPositionScale);
+    }
   }
 
 private:
@@ -120,6 +186,10 @@ private:
   LAYOUT_FIELD(FShaderParameter, NumTexCoords);
   LAYOUT_FIELD(FShaderParameter, bHasPointColors);
   LAYOUT_FIELD(FShaderParameter, AttenuationParameters);
+  LAYOUT_FIELD(FShaderResourceParameter, QuantizedPositionBuffer);
+  LAYOUT_FIELD(FShaderParameter, bHasQuantizedPositions);
+  LAYOUT_FIELD(FShaderParameter, QuantizedPositionOffset);
+  LAYOUT_FIELD(FShaderParameter, QuantizedPositionScale);
 };
 
 /**
@@ -171,6 +241,12 @@ bool FCesiumPointAttenuationVertexFactory::ShouldCompilePermutation(
          Parameters.MaterialParameters.bIsSpecialEngineMaterial;
 }
 
+void FCesiumPointAttenuationVertexFactory::GetPSOPrecacheVertexFetchElements(
+    EVertexInputStreamType VertexInputStreamType,
+    FVertexDeclarationElementList& Elements) {
+  Elements.Add(FVertexElement(0, 0, VET_Float3, 0, sizeof(FVector3f), false));
+}
+
 void FCesiumPointAttenuationVertexFactory::INIT_RHI_SIGNATURE {
   FVertexDeclarationElementList Elements;
   Elements.Add(AccessStreamComponent(
@@ -199,4 +275,5 @@ IMPLEMENT_VERTEX_FACTORY_TYPE(
     "/Plugin/CesiumForUnreal/Private/CesiumPointAttenuationVertexFactory.ush",
     EVertexFactoryFlags::UsedWithMaterials |
         EVertexFactoryFlags::SupportsDynamicLighting |
-        EVertexFactoryFlags::SupportsPositionOnly);
+        EVertexFactoryFlags::SupportsPositionOnly |
+        EVertexFactoryFlags::SupportsPSOPrecaching);
@@ -37,18 +37,44 @@ private:
   const bool bAttenuationSupported;
 };
 
+/**
+ * The positions of the points of a FCesiumGltfPointsComponent, quantized to
+ * 16 bits per component relative to the bounding box of the points. These are
+ * used by the point attenuation vertex factory in place of the positions in
+ * the static mesh.
+ */
+class FCesiumQuantizedPointPositionBuffer : public FVertexBuffer {
+public:
+  FCesiumQuantizedPointPositionBuffer(
+      const TSharedPtr<const TArray<uint16>, ESPMode::ThreadSafe>& Positions)
+      : Positions(Positions) {}
+
+  virtual void INIT_RHI_SIGNATURE override;
+  virtual void ReleaseRHI() override;
+
+  FShaderResourceViewRHIRef PositionsSRV;
+
+private:
+  // Three components per point.
+  const TSharedPtr<const TArray<uint16>, ESPMode::ThreadSafe> Positions;
+};
+
 /**
  * The parameters to be passed as UserData to the
  * shader.
  */
 struct FCesiumPointAttenuationBatchElementUserData {
   FRHIShaderResourceView* PositionBuffer;
+  FRHIShaderResourceView* QuantizedPositionBuffer;
   FRHIShaderResourceView* PackedTangentsBuffer;
   FRHIShaderResourceView* ColorBuffer;
   FRHIShaderResourceView* TexCoordBuffer;
   uint32 NumTexCoords;
   uint32 bHasPointColors;
   FVector3f AttenuationParameters;
+  uint32 bHasQuantizedPositions;
+  FVector3f QuantizedPositionOffset;
+  FVector3f QuantizedPositionScale;
 };
 
 class FCesiumPointAttenuationBatchElementUserDataWrapper
@@ -70,6 +96,14 @@ public:
   static bool ShouldCompilePermutation(
       const FVertexFactoryShaderPermutationParameters& Parameters);
 
+  /**
+   * Gets the vertex declaration that PSOs are precached with, which is the
+   * same for all points.
+   */
+  static void GetPSOPrecacheVertexFetchElements(
+      EVertexInputStreamType VertexInputStreamType,
+      FVertexDeclarationElementList& Elements);
+
 private:
   virtual void INIT_RHI_SIGNATURE override;
   virtual void ReleaseRHI() override;
@@ -0,0 +1,271 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPolygonClippingComponent.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCartographicPolygon.h"
+#include "CesiumEllipsoid.h"
+#include "CesiumGeoreference.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumMaterialUserData.h"
+#include "CesiumTileExclusionPredicate.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+namespace {
+// This must match CESIUM_POLYGON_CLIPPING_TEXTURE_WIDTH in
+// CesiumPolygonClipping.ush.
+constexpr int32 EdgeTextureWidth = 256;
+
+const FName EdgesParameterName = "PolygonClippingEdges";
+const FName TexelCountParameterName = "PolygonClippingTexelCount";
+const FName OriginParameterName = "PolygonClippingOrigin";
+const FName AxisXParameterName = "PolygonClippingAxisX";
+const FName AxisYParameterName = "PolygonClippingAxisY";
+const FName InvertParameterName = "PolygonClippingInvert";
+} // namespace
+
+UCesiumPolygonClippingComponent::UCesiumPolygonClippingComponent() {
+  PrimaryComponentTick.bCanEverTick = false;
+  bAutoActivate = true;
+}
+
+void UCesiumPolygonClippingComponent::Refresh() {
+  this->RemoveFromTileset();
+  this->AddToTileset();
+}
+
+void UCesiumPolygonClippingComponent::AddToTileset() {
+  if (this->EdgeTexture) {
+    return;
+  }
+
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  if (!pCesiumTileset) {
+    return;
+  }
+  Tileset* pTileset = pCesiumTileset->GetTileset();
+  if (!pTileset) {
+    return;
+  }
+  ACesiumGeoreference* pGeoreference = pCesiumTileset->ResolveGeoreference();
+  if (!IsValid(pGeoreference)) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UploadClippingPolygons)
+
+  TArray<TArray<FVector>> polygons;
+  polygons.Reserve(this->Polygons.Num());
+  FVector origin = FVector::ZeroVector;
+  int32 vertexCount = 0;
+  for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+    if (!IsValid(pPolygon) ||
+        pPolygon->Polygon->GetNumberOfSplinePoints() < 3) {
+      continue;
+    }
+
+    TArray<FVector>& vertices = polygons.Emplace_GetRef();
+    const int32 pointCount = pPolygon->Polygon->GetNumberOfSplinePoints();
+    vertices.Reserve(pointCount);
+    for (int32 i = 0; i < pointCount; ++i) {
+      const FVector position = pPolygon->Polygon->GetLocationAtSplinePoint(
+          i,
+          ESplineCoordinateSpace::World);
+      vertices.Add(position);
+      origin += position;
+    }
+    vertexCount += pointCount;
+  }
+
+  if (polygons.IsEmpty()) {
+    return;
+  }
+
+  // Project the polygons onto the plane tangent to the ellipsoid at their
+  // center, in which the material tests each pixel against them.
+  this->_origin = origin / double(vertexCount);
+  const FMatrix eastSouthUpToUnreal =
+      pGeoreference->ComputeEastSouthUpToUnrealTransformation(this->_origin);
+  this->_axisX = eastSouthUpToUnreal.GetUnitAxis(EAxis::X);
+  this->_axisY = eastSouthUpToUnreal.GetUnitAxis(EAxis::Y);
+
+  // Each polygon is a texel with its edge count, a texel with its bounds,
+  // and a texel per edge.
+  TArray<FLinearColor> texels;
+  texels.Reserve(2 * polygons.Num() + vertexCount);
+  for (const TArray<FVector>& vertices : polygons) {
+    const int32 headerIndex = texels.Num();
+    texels.Emplace(float(vertices.Num()), 0.0f, 0.0f, 0.0f);
+    texels.AddDefaulted();
+
+    FBox2f bounds(ForceInit);
+    FVector2f previous;
+    for (int32 i = 0; i <= vertices.Num(); ++i) {
+      const FVector offset = vertices[i % vertices.Num()] - this->_origin;
+      const FVector2f position(
+          float(FVector::DotProduct(offset, this->_axisX)),
+          float(FVector::DotProduct(offset, this->_axisY)));
+      if (i > 0) {
+        texels.Emplace(previous.X, previous.Y, position.X, position.Y);
+      }
+      bounds += position;
+      previous = position;
+    }
+
+    texels[headerIndex + 1] =
+        FLinearColor(bounds.Min.X, bounds.Min.Y, bounds.Max.X, bounds.Max.Y);
+  }
+
+  this->_texelCount = texels.Num();
+  const int32 height =
+      FMath::DivideAndRoundUp(this->_texelCount, EdgeTextureWidth);
+  texels.SetNumZeroed(EdgeTextureWidth * height);
+
+  UTexture2D* pTexture = UTexture2D::CreateTransient(
+      EdgeTextureWidth,
+      height,
+      EPixelFormat::PF_A32B32G32R32F,
+      MakeUniqueObjectName(
+          GetTransientPackage(),
+          UTexture2D::StaticClass(),
+          "CesiumClippingPolygonEdges"));
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->Filter = TextureFilter::TF_Nearest;
+  pTexture->SRGB = false;
+  pTexture->NeverStream = true;
+
+  FTexture2DMipMap& mip = pTexture->GetPlatformData()->Mips[0];
+  void* pPixels = mip.BulkData.Lock(LOCK_READ_WRITE);
+  FMemory::Memcpy(
+      pPixels,
+      texels.GetData(),
+      texels.Num() * texels.GetTypeSize());
+  mip.BulkData.Unlock();
+  pTexture->UpdateResource();
+  this->EdgeTexture = pTexture;
+
+  if (this->ExcludeSelectedTiles) {
+    UCesiumEllipsoid* pEllipsoid = pGeoreference->GetEllipsoid();
+    if (IsValid(pEllipsoid)) {
+      const FTransform worldToTileset =
+          pCesiumTileset->GetActorTransform().Inverse();
+      std::vector<CartographicPolygon> cartographicPolygons;
+      cartographicPolygons.reserve(this->Polygons.Num());
+      for (ACesiumCartographicPolygon* pPolygon : this->Polygons) {
+        if (IsValid(pPolygon)) {
+          cartographicPolygons.emplace_back(
+              pPolygon->CreateCartographicPolygon(worldToTileset));
+        }
+      }
+
+      this->_pExcluder = std::make_shared<CesiumTileExclusionPredicate>(
+          pEllipsoid->GetNativeEllipsoid(),
+          std::vector<CesiumTileExclusionPredicate::Region>(),
+          std::move(cartographicPolygons),
+          this->InvertSelection,
+          std::vector<CesiumTileExclusionPredicate::MetadataCondition>());
+      pTileset->getOptions().excluders.push_back(this->_pExcluder);
+    }
+  }
+
+  this->UpdateLoadedTiles();
+}
+
+void UCesiumPolygonClippingComponent::RemoveFromTileset() {
+  ACesium3DTileset* pCesiumTileset = this->GetOwner<ACesium3DTileset>();
+  Tileset* pTileset = pCesiumTileset ? pCesiumTileset->GetTileset() : nullptr;
+  if (this->_pExcluder && pTileset) {
+    std::vector<std::shared_ptr<ITileExcluder>>& excluders =
+        pTileset->getOptions().excluders;
+    auto it = std::find(excluders.begin(), excluders.end(), this->_pExcluder);
+    if (it != excluders.end()) {
+      excluders.erase(it);
+    }
+  }
+  this->_pExcluder.reset();
+
+  if (!this->EdgeTexture) {
+    return;
+  }
+
+  this->EdgeTexture = nullptr;
+  this->_texelCount = 0;
+  this->UpdateLoadedTiles();
+}
+
+void UCesiumPolygonClippingComponent::SetMaterialParameterValues(
+    UMaterialInstanceDynamic* pMaterial,
+    const UCesiumMaterialUserData* pCesiumData) const {
+  const int32 layerIndex =
+      pCesiumData ? pCesiumData->LayerNames.Find("PolygonClipping")
+                  : INDEX_NONE;
+  const EMaterialParameterAssociation association =
+      layerIndex != INDEX_NONE ? EMaterialParameterAssociation::LayerParameter
+                               : EMaterialParameterAssociation::GlobalParameter;
+
+  pMaterial->SetScalarParameterValueByInfo(
+      FMaterialParameterInfo(TexelCountParameterName, association, layerIndex),
+      float(this->_texelCount));
+  if (!this->EdgeTexture) {
+    return;
+  }
+
+  pMaterial->SetTextureParameterValueByInfo(
+      FMaterialParameterInfo(EdgesParameterName, association, layerIndex),
+      this->EdgeTexture);
+  pMaterial->SetVectorParameterValueByInfo(
+      FMaterialParameterInfo(OriginParameterName, association, layerIndex),
+      FLinearColor(this->_origin));
+  pMaterial->SetVectorParameterValueByInfo(
+      FMaterialParameterInfo(AxisXParameterName, association, layerIndex),
+      FLinearColor(this->_axisX));
+  pMaterial->SetVectorParameterValueByInfo(
+      FMaterialParameterInfo(AxisYParameterName, association, layerIndex),
+      FLinearColor(this->_axisY));
+  pMaterial->SetScalarParameterValueByInfo(
+      FMaterialParameterInfo(InvertParameterName, association, layerIndex),
+      this->InvertSelection ? 1.0f : 0.0f);
+}
+
+void UCesiumPolygonClippingComponent::UpdateLoadedTiles() const {
+  const AActor* pOwner = this->GetOwner();
+  if (!pOwner) {
+    return;
+  }
+
+  TArray<UCesiumGltfComponent*> gltfComponents;
+  pOwner->GetComponents<UCesiumGltfComponent>(gltfComponents);
+  for (UCesiumGltfComponent* pGltf : gltfComponents) {
+    pGltf->SetPolygonClipping(*this);
+  }
+}
+
+void UCesiumPolygonClippingComponent::Activate(bool bReset) {
+  Super::Activate(bReset);
+  this->AddToTileset();
+}
+
+void UCesiumPolygonClippingComponent::Deactivate() {
+  Super::Deactivate();
+  this->RemoveFromTileset();
+}
+
+void UCesiumPolygonClippingComponent::OnComponentDestroyed(
+    bool bDestroyingHierarchy) {
+  this->RemoveFromTileset();
+  Super::OnComponentDestroyed(bDestroyingHierarchy);
+}
+
+#if WITH_EDITOR
+void UCesiumPolygonClippingComponent::PostEditChangeProperty(
+    FPropertyChangedEvent& PropertyChangedEvent) {
+  Super::PostEditChangeProperty(PropertyChangedEvent);
+  this->Refresh();
+}
+#endif
@@ -0,0 +1,166 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPooledCacheDatabase.h"
+#include "CesiumAsync/CacheItem.h"
+#include "Tasks/Task.h"
+#include <utility>
+
+CesiumPooledCacheDatabase::CesiumPooledCacheDatabase(
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pWriteDatabase,
+    const std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>>&
+        readDatabases,
+    size_t maximumPendingEntries)
+    : _pWriteDatabase(pWriteDatabase),
+      _readDatabases(readDatabases),
+      _maximumPendingEntries(maximumPendingEntries),
+      _nextReadDatabase(0),
+      _pendingMutex(),
+      _pending(),
+      _writeMutex(),
+      _flushScheduled(false) {
+  if (this->_readDatabases.empty()) {
+    this->_readDatabases.emplace_back(this->_pWriteDatabase);
+  }
+}
+
+std::optional<CesiumAsync::CacheItem>
+CesiumPooledCacheDatabase::getEntry(const std::string& key) const {
+  std::shared_ptr<const PendingEntry> pPending;
+  {
+    std::scoped_lock<std::mutex> lock(this->_pendingMutex);
+    auto it = this->_pending.find(key);
+    if (it != this->_pending.end()) {
+      pPending = it->second;
+    }
+  }
+
+  if (pPending) {
+    return CesiumAsync::CacheItem(
+        pPending->expiryTime,
+        CesiumAsync::CacheRequest(
+            pPending->requestHeaders,
+            pPending->requestMethod,
+            pPending->url),
+        CesiumAsync::CacheResponse(
+            pPending->statusCode,
+            pPending->responseHeaders,
+            pPending->responseData));
+  }
+
+  const size_t index =
+      this->_nextReadDatabase.fetch_add(1) % this->_readDatabases.size();
+  return this->_readDatabases[index]->getEntry(key);
+}
+
+bool CesiumPooledCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  std::shared_ptr<const PendingEntry> pPending =
+      std::make_shared<const PendingEntry>(PendingEntry{
+          expiryTime,
+          url,
+          requestMethod,
+          requestHeaders,
+          statusCode,
+          responseHeaders,
+          std::vector<std::byte>(responseData.begin(), responseData.end())});
+
+  size_t pendingCount;
+  {
+    std::scoped_lock<std::mutex> lock(this->_pendingMutex);
+    this->_pending[key] = std::move(pPending);
+    pendingCount = this->_pending.size();
+  }
+
+  if (pendingCount > this->_maximumPendingEntries) {
+    // The background task isn't keeping up, so make the caller wait for the
+    // database instead of letting the queue grow.
+    this->flush();
+  } else {
+    this->scheduleFlush();
+  }
+
+  return true;
+}
+
+bool CesiumPooledCacheDatabase::prune() {
+  std::scoped_lock<std::mutex> lock(this->_writeMutex);
+  this->flushPending();
+  return this->_pWriteDatabase->prune();
+}
+
+bool CesiumPooledCacheDatabase::clearAll() {
+  std::scoped_lock<std::mutex> lock(this->_writeMutex);
+  {
+    std::scoped_lock<std::mutex> pendingLock(this->_pendingMutex);
+    this->_pending.clear();
+  }
+  return this->_pWriteDatabase->clearAll();
+}
+
+void CesiumPooledCacheDatabase::flush() {
+  std::scoped_lock<std::mutex> lock(this->_writeMutex);
+  this->flushPending();
+}
+
+size_t CesiumPooledCacheDatabase::getPendingEntryCount() const {
+  std::scoped_lock<std::mutex> lock(this->_pendingMutex);
+  return this->_pending.size();
+}
+
+void CesiumPooledCacheDatabase::scheduleFlush() {
+  bool expected = false;
+  if (!this->_flushScheduled.compare_exchange_strong(expected, true)) {
+    return;
+  }
+
+  UE::Tasks::Launch(
+      TEXT("CesiumPooledCacheDatabaseFlush"),
+      [pThis = this->shared_from_this()]() {
+        pThis->_flushScheduled = false;
+        pThis->flush();
+      },
+      UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void CesiumPooledCacheDatabase::flushPending() {
+  std::vector<std::pair<std::string, std::shared_ptr<const PendingEntry>>>
+      batch;
+  {
+    std::scoped_lock<std::mutex> lock(this->_pendingMutex);
+    batch.reserve(this->_pending.size());
+    for (const auto& [key, pPending] : this->_pending) {
+      batch.emplace_back(key, pPending);
+    }
+  }
+
+  for (const auto& [key, pPending] : batch) {
+    this->_pWriteDatabase->storeEntry(
+        key,
+        pPending->expiryTime,
+        pPending->url,
+        pPending->requestMethod,
+        pPending->requestHeaders,
+        pPending->statusCode,
+        pPending->responseHeaders,
+        gsl::span<const std::byte>(
+            pPending->responseData.data(),
+            pPending->responseData.size()));
+  }
+
+  // Entries stay queued until they're written, so that lookups in between
+  // still find them. Entries stored again in the meantime stay queued.
+  std::scoped_lock<std::mutex> lock(this->_pendingMutex);
+  for (const auto& [key, pPending] : batch) {
+    auto it = this->_pending.find(key);
+    if (it != this->_pending.end() && it->second == pPending) {
+      this->_pending.erase(it);
+    }
+  }
+}
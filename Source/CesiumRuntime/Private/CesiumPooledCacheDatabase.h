@@ -0,0 +1,112 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/ICacheDatabase.h"
+#include <atomic>
+#include <cstddef>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A request cache database that looks entries up in parallel through a pool
+ * of read connections and stores them behind the caller's back.
+ *
+ * Each connection, such as a `SqliteCache`, serializes its own calls, so
+ * worker threads looking up tiles at the same time would otherwise wait for
+ * one another. Lookups are instead spread over the read connections in turn.
+ *
+ * Stored entries are queued in memory, where lookups can already find them,
+ * and a background task writes the queue to the write connection in one pass,
+ * so a burst of completed requests neither waits for the database nor
+ * contends for it. Entries stored again before they are written are only
+ * written once.
+ */
+class CesiumPooledCacheDatabase
+    : public CesiumAsync::ICacheDatabase,
+      public std::enable_shared_from_this<CesiumPooledCacheDatabase> {
+public:
+  /**
+   * Creates a database.
+   *
+   * @param pWriteDatabase The connection through which entries are stored,
+   * pruned, and cleared.
+   * @param readDatabases The connections through which entries are looked up.
+   * If empty, the write connection is used.
+   * @param maximumPendingEntries The number of queued entries beyond which
+   * {@link storeEntry} writes the queue itself rather than leaving it to the
+   * background task, so that the queue can't grow without bound.
+   */
+  CesiumPooledCacheDatabase(
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pWriteDatabase,
+      const std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>>&
+          readDatabases,
+      size_t maximumPendingEntries = 1024);
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  /**
+   * Writes the queued entries, then prunes the write connection.
+   */
+  virtual bool prune() override;
+
+  /**
+   * Discards the queued entries, then clears the write connection.
+   */
+  virtual bool clearAll() override;
+
+  /**
+   * Writes the queued entries and waits until they are written.
+   */
+  void flush();
+
+  /**
+   * Gets the number of entries waiting to be written.
+   */
+  size_t getPendingEntryCount() const;
+
+private:
+  struct PendingEntry {
+    std::time_t expiryTime;
+    std::string url;
+    std::string requestMethod;
+    CesiumAsync::HttpHeaders requestHeaders;
+    uint16_t statusCode;
+    CesiumAsync::HttpHeaders responseHeaders;
+    std::vector<std::byte> responseData;
+  };
+
+  void scheduleFlush();
+  void flushPending();
+
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pWriteDatabase;
+  std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>> _readDatabases;
+  size_t _maximumPendingEntries;
+
+  mutable std::atomic<size_t> _nextReadDatabase;
+
+  mutable std::mutex _pendingMutex;
+  std::unordered_map<std::string, std::shared_ptr<const PendingEntry>>
+      _pending;
+
+  // Held while writing to the write connection, so that the queue is written
+  // by one thread at a time and in the order it was stored.
+  std::mutex _writeMutex;
+
+  std::atomic<bool> _flushScheduled;
+};
@@ -25,4 +25,11 @@ void CesiumPrimitiveData::destroy() {
   std::unordered_map<int32_t, CesiumGltf::TexCoordAccessorType>
       emptyAccessorMap;
   this->TexCoordAccessorMap.swap(emptyAccessorMap);
+
+  this->Clusters.Empty();
+  this->pTraceMesh.Reset();
+  this->pFeatureIndex.Reset();
+
+  this->PhysicsMeshState = CesiumPhysicsMeshes::OnDemandState::None;
+  ++this->PhysicsMeshBuild;
 }
@@ -5,10 +5,14 @@
 #include "Cesium3DTileset.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
+#include "CesiumFeatureIndex.h"
+#include "CesiumMeshClusters.h"
 #include "CesiumMetadataPrimitive.h"
+#include "CesiumPhysicsMeshes.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
+#include "CesiumTriangleBVH.h"
 #include <CesiumGltf/AccessorUtility.h>
 #include <cstdint>
 #include <glm/mat4x4.hpp>
@@ -99,6 +103,40 @@ public:
    */
   CesiumGltf::IndexAccessorType IndexAccessor;
 
+  /**
+   * The clusters of the mesh's triangles, if it was split into clusters to be
+   * culled separately. Used to create the scene proxy.
+   */
+  TArray<CesiumMeshCluster> Clusters;
+
+  /**
+   * The hierarchy over the triangles of the primitive, in the local
+   * coordinates of its component, that the tileset traces lines against, if
+   * trace meshes are created.
+   */
+  TSharedPtr<const CesiumTriangleBVH> pTraceMesh;
+
+  /**
+   * The index from the feature IDs of the primitive to its faces and their
+   * bounds, in the local coordinates of its component, if feature indices
+   * are created.
+   */
+  TSharedPtr<const CesiumFeatureIndex> pFeatureIndex;
+
+  /**
+   * The state of the physics mesh of the primitive, when physics meshes are
+   * created on demand.
+   */
+  CesiumPhysicsMeshes::OnDemandState PhysicsMeshState =
+      CesiumPhysicsMeshes::OnDemandState::None;
+
+  /**
+   * Identifies the latest on-demand build of the physics mesh of the
+   * primitive. It is changed when the physics mesh is removed or the primitive
+   * is destroyed, so that a build that completes afterwards is discarded.
+   */
+  uint32 PhysicsMeshBuild = 0;
+
   std::optional<Cesium3DTilesSelection::BoundingVolume> boundingVolume;
 
   void destroy();
@@ -0,0 +1,200 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveComponentPool.h"
+#include "Cesium3DTileset.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumPrimitive.h"
+#include "CesiumRuntimeSettings.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace {
+constexpr ERenameFlags PoolRenameFlags =
+    REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_DoNotDirty |
+    REN_NonTransactional;
+
+// Releases everything the component holds that belongs to a particular tile,
+// leaving it in a state where it can be set up again for a different tile.
+void resetComponent(UStaticMeshComponent* pComponent) {
+  ICesiumPrimitive* pCesiumPrimitive = Cast<ICesiumPrimitive>(pComponent);
+  if (pCesiumPrimitive) {
+    pCesiumPrimitive->getPrimitiveData().destroy();
+    pCesiumPrimitive->getPrimitiveData().boundingVolume.reset();
+  }
+
+  UInstancedStaticMeshComponent* pInstanced =
+      Cast<UInstancedStaticMeshComponent>(pComponent);
+  if (pInstanced) {
+    pInstanced->ClearInstances();
+  }
+
+  UMaterialInstanceDynamic* pMaterial =
+      Cast<UMaterialInstanceDynamic>(pComponent->GetMaterial(0));
+  if (pMaterial) {
+    CesiumLifetime::destroy(pMaterial);
+  }
+
+  UStaticMesh* pMesh = pComponent->GetStaticMesh();
+  if (pMesh) {
+    pComponent->SetStaticMesh(nullptr);
+
+    UBodySetup* pBodySetup = pMesh->GetBodySetup();
+    if (pBodySetup) {
+      CesiumLifetime::destroy(pBodySetup);
+    }
+
+    CesiumLifetime::destroy(pMesh);
+  }
+
+  pComponent->EmptyOverrideMaterials();
+
+  const UStaticMeshComponent* pDefaults =
+      pComponent->GetClass()->GetDefaultObject<UStaticMeshComponent>();
+  pComponent->bCastDynamicShadow = pDefaults->bCastDynamicShadow;
+  pComponent->CastShadow = pDefaults->CastShadow;
+  pComponent->bCastHiddenShadow = pDefaults->bCastHiddenShadow;
+  pComponent->ShadowCacheInvalidationBehavior =
+      pDefaults->ShadowCacheInvalidationBehavior;
+  pComponent->bVisibleInRayTracing = pDefaults->bVisibleInRayTracing;
+  pComponent->bRenderInMainPass = pDefaults->bRenderInMainPass;
+  pComponent->bRenderInDepthPass = pDefaults->bRenderInDepthPass;
+  pComponent->SetRelativeTransform(FTransform::Identity);
+}
+} // namespace
+
+CesiumPrimitiveComponentPool::CesiumPrimitiveComponentPool(
+    ACesium3DTileset* pTilesetActor)
+    : _pTilesetActor(pTilesetActor), _pooled(), _stats() {}
+
+UStaticMeshComponent* CesiumPrimitiveComponentPool::acquireComponent(
+    UClass* pClass,
+    UCesiumGltfComponent* pGltf,
+    FName name) {
+  TArray<TObjectPtr<UStaticMeshComponent>>* pPool = this->_pooled.Find(pClass);
+  while (pPool && !pPool->IsEmpty()) {
+    UStaticMeshComponent* pComponent = pPool->Pop(false);
+    if (!IsValid(pComponent)) {
+      continue;
+    }
+
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReusePooledComponent)
+
+    FName uniqueName =
+        name.IsNone() ? NAME_None : MakeUniqueObjectName(pGltf, pClass, name);
+    pComponent->Rename(
+        uniqueName.IsNone() ? nullptr : *uniqueName.ToString(),
+        pGltf,
+        PoolRenameFlags);
+
+    ++this->_stats.ComponentsReused;
+    return pComponent;
+  }
+
+  ++this->_stats.ComponentsCreated;
+  return NewObject<UStaticMeshComponent>(pGltf, pClass, name);
+}
+
+void CesiumPrimitiveComponentPool::releaseGltfComponent(
+    UCesiumGltfComponent* pGltf) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleaseGltfComponent)
+
+  if (!pGltf) {
+    return;
+  }
+
+  ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  if (IsValid(pTilesetActor) &&
+      !pTilesetActor->HasAnyFlags(RF_BeginDestroyed)) {
+    if (pGltf->IsRegistered()) {
+      pGltf->UnregisterComponent();
+    }
+
+    // Copy the array, because releasing a component detaches it.
+    TArray<USceneComponent*> children = pGltf->GetAttachChildren();
+    for (USceneComponent* pChild : children) {
+      UStaticMeshComponent* pComponent = Cast<UStaticMeshComponent>(pChild);
+      if (pComponent && Cast<ICesiumPrimitive>(pComponent) &&
+          this->releaseComponent(pComponent)) {
+        continue;
+      }
+
+      ++this->_stats.ComponentsDestroyed;
+      CesiumLifetime::destroyComponentRecursively(pChild);
+    }
+  }
+
+  CesiumLifetime::destroyComponentRecursively(pGltf);
+}
+
+bool CesiumPrimitiveComponentPool::releaseComponent(
+    UStaticMeshComponent* pComponent) {
+  int32 maximum =
+      GetDefault<UCesiumRuntimeSettings>()->MaximumPooledComponentsPerTileset;
+  if (this->getPooledComponentCount() >= maximum) {
+    return false;
+  }
+
+  ACesium3DTileset* pTilesetActor = this->_pTilesetActor.Get();
+  if (!IsValid(pComponent) || !pTilesetActor) {
+    return false;
+  }
+
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+
+  pComponent->DetachFromComponent(
+      FDetachmentTransformRules::KeepRelativeTransform);
+
+  resetComponent(pComponent);
+
+  // The glTF component that owned this one is about to be destroyed, so
+  // transfer ownership to the tileset actor while the component is pooled.
+  pComponent->Rename(nullptr, pTilesetActor, PoolRenameFlags);
+
+  this->_pooled.FindOrAdd(pComponent->GetClass()).Add(pComponent);
+  ++this->_stats.ComponentsReleased;
+  return true;
+}
+
+void CesiumPrimitiveComponentPool::clear() {
+  for (auto& pair : this->_pooled) {
+    for (UStaticMeshComponent* pComponent : pair.Value) {
+      if (IsValid(pComponent)) {
+        ++this->_stats.ComponentsDestroyed;
+        CesiumLifetime::destroyComponentRecursively(pComponent);
+      }
+    }
+  }
+
+  this->_pooled.Empty();
+}
+
+FCesiumPrimitiveComponentPoolStats
+CesiumPrimitiveComponentPool::getStats() const {
+  FCesiumPrimitiveComponentPoolStats result = this->_stats;
+  result.PooledComponents = this->getPooledComponentCount();
+  return result;
+}
+
+void CesiumPrimitiveComponentPool::AddReferencedObjects(
+    FReferenceCollector& Collector) {
+  for (auto& pair : this->_pooled) {
+    Collector.AddReferencedObjects(pair.Value);
+  }
+}
+
+FString CesiumPrimitiveComponentPool::GetReferencerName() const {
+  return TEXT("CesiumPrimitiveComponentPool");
+}
+
+int32 CesiumPrimitiveComponentPool::getPooledComponentCount() const {
+  int32 count = 0;
+  for (const auto& pair : this->_pooled) {
+    count += pair.Value.Num();
+  }
+  return count;
+}
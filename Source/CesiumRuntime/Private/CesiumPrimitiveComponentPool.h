@@ -0,0 +1,74 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumPrimitiveComponentPoolStats.h"
+#include "Components/StaticMeshComponent.h"
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+
+class ACesium3DTileset;
+class UCesiumGltfComponent;
+
+/**
+ * A per-tileset pool of the primitive components (static mesh, instanced
+ * static mesh, and point components) that are created for glTF primitives.
+ *
+ * When a tile is unloaded, its primitive components are stripped of their
+ * tile-specific state and kept here, owned by the tileset actor, instead of
+ * being destroyed. They are then reused for newly-loaded tiles. This avoids
+ * creating and garbage collecting thousands of components over a long
+ * session.
+ *
+ * The meshes, materials, and body setups of the primitives are not pooled;
+ * they are released as usual.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumPrimitiveComponentPool : public FGCObject {
+public:
+  CesiumPrimitiveComponentPool(ACesium3DTileset* pTilesetActor);
+
+  /**
+   * @brief Gets a component of the given type, either from the pool or by
+   * creating a new one. The component's outer is set to the given glTF
+   * component. It is not registered or attached to anything.
+   */
+  template <typename TComponent>
+  TComponent* acquire(UCesiumGltfComponent* pGltf, FName name) {
+    UStaticMeshComponent* pComponent =
+        this->acquireComponent(TComponent::StaticClass(), pGltf, name);
+    return CastChecked<TComponent>(pComponent);
+  }
+
+  /**
+   * @brief Releases the primitive components of the given glTF component to
+   * the pool, and destroys the glTF component itself. Components that do
+   * not fit in the pool are destroyed.
+   */
+  void releaseGltfComponent(UCesiumGltfComponent* pGltf);
+
+  /**
+   * @brief Destroys all pooled components.
+   */
+  void clear();
+
+  /**
+   * @brief Gets the pool's usage counters.
+   */
+  FCesiumPrimitiveComponentPoolStats getStats() const;
+
+  // FGCObject
+  virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+  virtual FString GetReferencerName() const override;
+
+private:
+  UStaticMeshComponent*
+  acquireComponent(UClass* pClass, UCesiumGltfComponent* pGltf, FName name);
+  bool releaseComponent(UStaticMeshComponent* pComponent);
+  int32 getPooledComponentCount() const;
+
+  TWeakObjectPtr<ACesium3DTileset> _pTilesetActor;
+  TMap<UClass*, TArray<TObjectPtr<UStaticMeshComponent>>> _pooled;
+  FCesiumPrimitiveComponentPoolStats _stats;
+};
@@ -0,0 +1,496 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveMerging.h"
+#include <CesiumGltf/AccessorUtility.h>
+#include <CesiumGltf/ExtensionExtMeshFeatures.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/matrix.hpp>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+// The elements of an accessor in its buffer.
+struct ElementView {
+  const std::byte* pData;
+  int64_t stride;
+  int64_t elementSize;
+  int64_t count;
+
+  const std::byte* operator[](int64_t i) const {
+    return this->pData + i * this->stride;
+  }
+};
+
+std::optional<ElementView>
+getElements(const Model& model, int32_t accessorIndex) {
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor || pAccessor->sparse || pAccessor->count <= 0) {
+    return std::nullopt;
+  }
+  const BufferView* pBufferView =
+      Model::getSafe(&model.bufferViews, pAccessor->bufferView);
+  const Buffer* pBuffer =
+      pBufferView ? Model::getSafe(&model.buffers, pBufferView->buffer)
+                  : nullptr;
+  if (!pBuffer) {
+    return std::nullopt;
+  }
+
+  const int64_t elementSize = pAccessor->computeByteSizeOfOneElement();
+  const int64_t stride = pBufferView->byteStride.value_or(elementSize);
+  const int64_t offset = pBufferView->byteOffset + pAccessor->byteOffset;
+  const int64_t size = stride * (pAccessor->count - 1) + elementSize;
+  if (elementSize <= 0 || stride < elementSize || offset < 0 ||
+      offset + size > int64_t(pBuffer->cesium.data.size())) {
+    return std::nullopt;
+  }
+
+  return ElementView{
+      pBuffer->cesium.data.data() + offset,
+      stride,
+      elementSize,
+      pAccessor->count};
+}
+
+struct Candidate {
+  MeshPrimitive* pPrimitive;
+  glm::dmat4 transform;
+  int64_t vertexCount;
+};
+
+bool isIndexAccessor(const Accessor& accessor) {
+  return accessor.type == Accessor::Type::SCALAR &&
+         (accessor.componentType == Accessor::ComponentType::UNSIGNED_BYTE ||
+          accessor.componentType == Accessor::ComponentType::UNSIGNED_SHORT ||
+          accessor.componentType == Accessor::ComponentType::UNSIGNED_INT);
+}
+
+// Gets the key of the primitives that a primitive can be merged with, or
+// nothing if it can't be merged with any.
+std::optional<std::string> getMergeKey(
+    const Model& model,
+    const Node& node,
+    const MeshPrimitive& primitive,
+    int64_t& vertexCount) {
+  if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
+      !primitive.targets.empty() || !primitive.extras.empty() ||
+      node.getExtension<ExtensionExtMeshGpuInstancing>()) {
+    return std::nullopt;
+  }
+  for (const auto& [name, extension] : primitive.extensions) {
+    if (name != ExtensionExtMeshFeatures::ExtensionName &&
+        name != ExtensionMeshPrimitiveExtStructuralMetadata::ExtensionName &&
+        name != "KHR_draco_mesh_compression") {
+      return std::nullopt;
+    }
+  }
+
+  const Accessor* pPosition =
+      Model::getSafe(&model.accessors, primitive.getAttribute("POSITION"));
+  if (!pPosition || pPosition->type != Accessor::Type::VEC3 ||
+      pPosition->componentType != Accessor::ComponentType::FLOAT ||
+      pPosition->count > CesiumPrimitiveMerging::MaximumPrimitiveVertexCount) {
+    return std::nullopt;
+  }
+  vertexCount = pPosition->count;
+
+  std::string key = std::to_string(primitive.material);
+
+  // The attributes are ordered by name, so the key doesn't depend on the
+  // order in which the glTF lists them.
+  for (const auto& [semantic, accessorIndex] : primitive.attributes) {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+    std::optional<ElementView> elements = getElements(model, accessorIndex);
+    if (!pAccessor || !elements || elements->count != vertexCount) {
+      return std::nullopt;
+    }
+    if ((semantic == "NORMAL" && pAccessor->type != Accessor::Type::VEC3) ||
+        (semantic == "TANGENT" && pAccessor->type != Accessor::Type::VEC4) ||
+        ((semantic == "NORMAL" || semantic == "TANGENT") &&
+         pAccessor->componentType != Accessor::ComponentType::FLOAT)) {
+      return std::nullopt;
+    }
+
+    key += "|" + semantic + ":" + pAccessor->type + ":" +
+           std::to_string(pAccessor->componentType) +
+           (pAccessor->normalized ? "n" : "");
+  }
+
+  if (primitive.indices >= 0) {
+    const Accessor* pIndices =
+        Model::getSafe(&model.accessors, primitive.indices);
+    std::optional<ElementView> indices =
+        getElements(model, primitive.indices);
+    if (!pIndices || !indices || !isIndexAccessor(*pIndices) ||
+        indices->count % 3 != 0) {
+      return std::nullopt;
+    }
+  } else if (vertexCount % 3 != 0) {
+    return std::nullopt;
+  }
+
+  // The feature IDs must have the same meaning in every merged primitive.
+  // Only the IDs in attributes are kept apart by the merging, so implicit IDs
+  // and ID textures rule it out.
+  if (const ExtensionExtMeshFeatures* pFeatures =
+          primitive.getExtension<ExtensionExtMeshFeatures>()) {
+    for (const FeatureId& featureId : pFeatures->featureIds) {
+      if (!featureId.attribute || featureId.texture) {
+        return std::nullopt;
+      }
+      key += "|f" + std::to_string(*featureId.attribute) + ":" +
+             std::to_string(featureId.propertyTable.value_or(-1)) + ":" +
+             std::to_string(featureId.nullFeatureId.value_or(-1)) + ":" +
+             featureId.label.value_or("");
+    }
+  }
+
+  if (const ExtensionMeshPrimitiveExtStructuralMetadata* pMetadata =
+          primitive
+              .getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>()) {
+    key += "|t";
+    for (int64_t index : pMetadata->propertyTextures) {
+      key += ":" + std::to_string(index);
+    }
+    key += "|a";
+    for (int64_t index : pMetadata->propertyAttributes) {
+      key += ":" + std::to_string(index);
+    }
+  }
+
+  return key;
+}
+
+template <typename T> T read(const std::byte* pData) {
+  T value;
+  std::memcpy(&value, pData, sizeof(T));
+  return value;
+}
+
+uint32_t readIndex(const std::byte* pData, int32_t componentType) {
+  switch (componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return uint32_t(read<uint8_t>(pData));
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return uint32_t(read<uint16_t>(pData));
+  default:
+    return read<uint32_t>(pData);
+  }
+}
+
+class MergedBuffer {
+public:
+  MergedBuffer(Model& model)
+      : _model(model), _bufferIndex(int32_t(model.buffers.size())) {}
+
+  ~MergedBuffer() {
+    if (!this->_data.empty()) {
+      Buffer& buffer = this->_model.buffers.emplace_back();
+      buffer.byteLength = int64_t(this->_data.size());
+      buffer.cesium.data = std::move(this->_data);
+    }
+  }
+
+  // Adds an accessor with the given layout and count, and gives the data to
+  // write its elements to, tightly packed.
+  std::byte* addAccessor(
+      int32_t& accessorIndex,
+      const std::string& type,
+      int32_t componentType,
+      bool normalized,
+      int64_t count) {
+    const int64_t elementSize =
+        Accessor::computeNumberOfComponents(type) *
+        Accessor::computeByteSizeOfComponent(componentType);
+    const int64_t offset = (int64_t(this->_data.size()) + 3) & ~int64_t(3);
+    this->_data.resize(size_t(offset + elementSize * count));
+
+    BufferView& bufferView = this->_model.bufferViews.emplace_back();
+    bufferView.buffer = this->_bufferIndex;
+    bufferView.byteOffset = offset;
+    bufferView.byteLength = elementSize * count;
+
+    accessorIndex = int32_t(this->_model.accessors.size());
+    Accessor& accessor = this->_model.accessors.emplace_back();
+    accessor.bufferView = int32_t(this->_model.bufferViews.size() - 1);
+    accessor.type = type;
+    accessor.componentType = componentType;
+    accessor.normalized = normalized;
+    accessor.count = count;
+
+    return this->_data.data() + offset;
+  }
+
+private:
+  Model& _model;
+  int32_t _bufferIndex;
+  std::vector<std::byte> _data;
+};
+
+// Recounts the features of the feature ID sets of a merged primitive, as the
+// number of distinct feature IDs other than the null ID.
+void recountFeatures(const Model& model, MeshPrimitive& primitive) {
+  ExtensionExtMeshFeatures* pFeatures =
+      primitive.getExtension<ExtensionExtMeshFeatures>();
+  if (!pFeatures) {
+    return;
+  }
+
+  for (FeatureId& featureId : pFeatures->featureIds) {
+    const FeatureIdAccessorType view =
+        getFeatureIdAccessorView(model, primitive, *featureId.attribute);
+    const int64_t count = std::visit(CountFromAccessor{}, view);
+    std::unordered_set<int64_t> ids;
+    for (int64_t i = 0; i < count; ++i) {
+      const int64_t id = std::visit(FeatureIdFromAccessor{i}, view);
+      if (id >= 0 && id != featureId.nullFeatureId.value_or(-1)) {
+        ids.insert(id);
+      }
+    }
+    featureId.featureCount = int64_t(ids.size());
+  }
+}
+
+// Merges primitives into the first of them. The features of the merged
+// primitive must be recounted once the buffer is added to the model.
+void mergePrimitives(
+    Model& model,
+    MergedBuffer& buffer,
+    const std::vector<const Candidate*>& members) {
+  const Candidate& first = *members.front();
+  const glm::dmat4 toFirst = glm::inverse(first.transform);
+
+  std::vector<glm::dmat4> transforms;
+  transforms.reserve(members.size());
+  int64_t vertexCount = 0;
+  int64_t indexCount = 0;
+  for (const Candidate* pMember : members) {
+    transforms.emplace_back(toFirst * pMember->transform);
+    vertexCount += pMember->vertexCount;
+    const Accessor* pIndices =
+        Model::getSafe(&model.accessors, pMember->pPrimitive->indices);
+    indexCount += pIndices ? pIndices->count : pMember->vertexCount;
+  }
+
+  MeshPrimitive merged = *first.pPrimitive;
+  merged.extensions.erase("KHR_draco_mesh_compression");
+
+  for (auto& [semantic, accessorIndex] : merged.attributes) {
+    const Accessor& layout = model.accessors[size_t(accessorIndex)];
+    const std::string type = layout.type;
+    const int32_t componentType = layout.componentType;
+    const bool normalized = layout.normalized;
+    std::byte* pOut = buffer.addAccessor(
+        accessorIndex,
+        type,
+        componentType,
+        normalized,
+        vertexCount);
+
+    const bool isPosition = semantic == "POSITION";
+    const bool isNormal = semantic == "NORMAL";
+    const bool isTangent = semantic == "TANGENT";
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(std::numeric_limits<float>::lowest());
+
+    for (size_t m = 0; m < members.size(); ++m) {
+      const MeshPrimitive& primitive = *members[m]->pPrimitive;
+      const ElementView elements =
+          *getElements(model, primitive.attributes.at(semantic));
+      const glm::dmat4& transform = transforms[m];
+      const glm::dmat3 normalTransform =
+          glm::inverseTranspose(glm::dmat3(transform));
+
+      for (int64_t i = 0; i < elements.count; ++i) {
+        if (isPosition) {
+          const glm::vec3 position(
+              transform * glm::dvec4(read<glm::vec3>(elements[i]), 1.0));
+          min = glm::min(min, position);
+          max = glm::max(max, position);
+          std::memcpy(pOut, &position, sizeof(position));
+        } else if (isNormal) {
+          const glm::vec3 normal(glm::normalize(
+              normalTransform * glm::dvec3(read<glm::vec3>(elements[i]))));
+          std::memcpy(pOut, &normal, sizeof(normal));
+        } else if (isTangent) {
+          const glm::vec4 tangent = read<glm::vec4>(elements[i]);
+          const glm::vec4 transformed(
+              glm::normalize(
+                  glm::dmat3(transform) * glm::dvec3(glm::vec3(tangent))),
+              tangent.w);
+          std::memcpy(pOut, &transformed, sizeof(transformed));
+        } else {
+          std::memcpy(pOut, elements[i], size_t(elements.elementSize));
+        }
+        pOut += elements.elementSize;
+      }
+    }
+
+    if (isPosition) {
+      Accessor& position = model.accessors[size_t(accessorIndex)];
+      position.min = {min.x, min.y, min.z};
+      position.max = {max.x, max.y, max.z};
+    }
+  }
+
+  std::byte* pIndexData = buffer.addAccessor(
+      merged.indices,
+      Accessor::Type::SCALAR,
+      Accessor::ComponentType::UNSIGNED_INT,
+      false,
+      indexCount);
+  uint32_t* pIndices = reinterpret_cast<uint32_t*>(pIndexData);
+  uint32_t firstVertex = 0;
+  for (size_t m = 0; m < members.size(); ++m) {
+    const MeshPrimitive& primitive = *members[m]->pPrimitive;
+    const int64_t count =
+        primitive.indices >= 0
+            ? model.accessors[size_t(primitive.indices)].count
+            : members[m]->vertexCount;
+    const std::optional<ElementView> indices =
+        primitive.indices >= 0 ? getElements(model, primitive.indices)
+                               : std::nullopt;
+    const int32_t componentType =
+        primitive.indices >= 0
+            ? model.accessors[size_t(primitive.indices)].componentType
+            : Accessor::ComponentType::UNSIGNED_INT;
+
+    // Mirrored primitives would be drawn inside out without reversing their
+    // triangles.
+    const bool flip = glm::determinant(glm::dmat3(transforms[m])) < 0.0;
+    for (int64_t i = 0; i < count; i += 3) {
+      uint32_t triangle[3];
+      for (int64_t j = 0; j < 3; ++j) {
+        triangle[j] =
+            firstVertex +
+            (indices ? readIndex((*indices)[i + j], componentType)
+                     : uint32_t(i + j));
+      }
+      if (flip) {
+        std::swap(triangle[1], triangle[2]);
+      }
+      std::memcpy(pIndices, triangle, sizeof(triangle));
+      pIndices += 3;
+    }
+    firstVertex += uint32_t(members[m]->vertexCount);
+  }
+
+  *first.pPrimitive = std::move(merged);
+}
+
+} // namespace
+
+int32 CesiumPrimitiveMerging::mergeSmallPrimitives(Model& model) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MergeSmallPrimitives)
+
+  std::vector<Candidate> candidates;
+  std::vector<std::string> keys;
+  std::unordered_map<const MeshPrimitive*, int32_t> visits;
+  model.forEachPrimitiveInScene(
+      model.scene,
+      [&candidates, &keys, &visits](
+          Model& gltf,
+          Node& node,
+          Mesh& /*mesh*/,
+          MeshPrimitive& primitive,
+          const glm::dmat4& transform) {
+        if (++visits[&primitive] > 1) {
+          return;
+        }
+        int64_t vertexCount = 0;
+        std::optional<std::string> key =
+            getMergeKey(gltf, node, primitive, vertexCount);
+        if (key) {
+          candidates.push_back({&primitive, transform, vertexCount});
+          keys.emplace_back(std::move(*key));
+        }
+      });
+
+  // Group the candidates by key, in the order of their first primitives.
+  // Primitives that are drawn more than once, through several nodes, can't
+  // be moved into one of them.
+  std::vector<std::vector<const Candidate*>> groups;
+  std::unordered_map<std::string, size_t> groupIndices;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    if (visits[candidates[i].pPrimitive] > 1) {
+      continue;
+    }
+    auto [it, added] = groupIndices.emplace(keys[i], groups.size());
+    if (added) {
+      groups.emplace_back();
+    }
+    groups[it->second].push_back(&candidates[i]);
+  }
+
+  std::unordered_set<const MeshPrimitive*> removed;
+  std::vector<MeshPrimitive*> merged;
+  {
+    MergedBuffer buffer(model);
+    std::vector<const Candidate*> members;
+    int64_t vertexCount = 0;
+
+    const auto flush = [&]() {
+      if (members.size() > 1 &&
+          std::abs(glm::determinant(members.front()->transform)) > 0.0) {
+        for (size_t i = 1; i < members.size(); ++i) {
+          removed.insert(members[i]->pPrimitive);
+        }
+        mergePrimitives(model, buffer, members);
+        merged.push_back(members.front()->pPrimitive);
+      }
+      members.clear();
+      vertexCount = 0;
+    };
+
+    for (const std::vector<const Candidate*>& group : groups) {
+      for (const Candidate* pCandidate : group) {
+        if (vertexCount + pCandidate->vertexCount >
+            CesiumPrimitiveMerging::MaximumMergedVertexCount) {
+          flush();
+        }
+        members.push_back(pCandidate);
+        vertexCount += pCandidate->vertexCount;
+      }
+      flush();
+    }
+  }
+
+  if (removed.empty()) {
+    return 0;
+  }
+
+  for (MeshPrimitive* pPrimitive : merged) {
+    recountFeatures(model, *pPrimitive);
+  }
+
+  for (Mesh& mesh : model.meshes) {
+    mesh.primitives.erase(
+        std::remove_if(
+            mesh.primitives.begin(),
+            mesh.primitives.end(),
+            [&removed](const MeshPrimitive& primitive) {
+              return removed.count(&primitive) > 0;
+            }),
+        mesh.primitives.end());
+  }
+
+  return int32(removed.size());
+}
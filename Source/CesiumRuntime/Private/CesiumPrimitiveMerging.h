@@ -0,0 +1,51 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace CesiumPrimitiveMerging {
+
+/**
+ * The most vertices that a primitive may have to be merged with others.
+ * Larger primitives are drawn on their own.
+ */
+constexpr int64 MaximumPrimitiveVertexCount = 8192;
+
+/**
+ * The most vertices of a primitive created by merging others. Primitives
+ * beyond this start another merged primitive, so that the merged primitives
+ * are still culled in parts.
+ */
+constexpr int64 MaximumMergedVertexCount = 256 * 1024;
+
+/**
+ * @brief Merges the small triangle primitives of a glTF's scene that can be
+ * drawn together into larger primitives, so that a tile with hundreds of tiny
+ * primitives that share a material gets a few components and draw calls
+ * instead of hundreds.
+ *
+ * Primitives are merged when they have the same material, the same
+ * attributes with the same types, and the same feature ID sets and metadata.
+ * The vertices of each group of merged primitives are transformed into the
+ * coordinates of the node of its first primitive, which is replaced by the
+ * merged primitive; the others are removed from their meshes. The merged data
+ * is written to a new buffer. Feature IDs, which come from attributes, are
+ * kept, and the feature counts are recounted.
+ *
+ * Primitives are left alone if they have implicit feature IDs or feature ID
+ * textures, morph targets, extras, or extensions other than those for
+ * features, metadata, and Draco, or if they're instanced, or in a mesh used by
+ * more than one node.
+ *
+ * May be called from any thread, while nothing else uses the model.
+ *
+ * @returns The number of primitives that were merged into others and removed.
+ */
+int32 mergeSmallPrimitives(CesiumGltf::Model& model);
+
+} // namespace CesiumPrimitiveMerging
@@ -7,6 +7,50 @@ using namespace CesiumGltf;
 
 static FCesiumPropertyTableProperty EmptyPropertyTableProperty;
 
+namespace {
+/**
+ * Writes the values of a property for the features into the given storage,
+ * one for each feature ID, and returns the type of the values. A property
+ * that doesn't exist or isn't valid gets empty values.
+ */
+FCesiumMetadataValueType copyValuesForFeatures(
+    const FCesiumPropertyTableProperty* pProperty,
+    int64 featureCount,
+    TArrayView<const int64> featureIDs,
+    TArrayView<FCesiumMetadataValue> values) {
+  const ECesiumPropertyTablePropertyStatus status =
+      pProperty ? UCesiumPropertyTablePropertyBlueprintLibrary::
+                      GetPropertyTablePropertyStatus(*pProperty)
+                : ECesiumPropertyTablePropertyStatus::ErrorInvalidProperty;
+
+  if (status == ECesiumPropertyTablePropertyStatus::Valid) {
+    UCesiumPropertyTablePropertyBlueprintLibrary::CopyValuesForFeatures(
+        *pProperty,
+        featureIDs,
+        values);
+  } else if (
+      status == ECesiumPropertyTablePropertyStatus::EmptyPropertyWithDefault) {
+    const FCesiumMetadataValue defaultValue =
+        UCesiumPropertyTablePropertyBlueprintLibrary::GetDefaultValue(
+            *pProperty);
+    for (int32 i = 0; i < featureIDs.Num(); ++i) {
+      const int64 featureID = featureIDs[i];
+      values[i] = featureID >= 0 && featureID < featureCount
+                      ? defaultValue
+                      : FCesiumMetadataValue();
+    }
+  } else {
+    for (FCesiumMetadataValue& value : values) {
+      value = FCesiumMetadataValue();
+    }
+    return FCesiumMetadataValueType();
+  }
+
+  return UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(
+      *pProperty);
+}
+} // namespace
+
 FCesiumPropertyTable::FCesiumPropertyTable(
     const Model& Model,
     const PropertyTable& PropertyTable)
@@ -110,6 +154,48 @@ UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeature(
   return values;
 }
 
+/*static*/ TArray<FCesiumPropertyTableValues>
+UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatures(
+    UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+    const TArray<int64>& FeatureIDs,
+    const TArray<FString>& PropertyNames) {
+  TArray<FCesiumPropertyTableValues> result;
+  result.Reserve(PropertyNames.Num());
+
+  for (const FString& propertyName : PropertyNames) {
+    FCesiumPropertyTableValues& values = result.Emplace_GetRef();
+    values.PropertyName = propertyName;
+    values.Values.SetNum(FeatureIDs.Num());
+    values.ValueType = copyValuesForFeatures(
+        PropertyTable._properties.Find(propertyName),
+        PropertyTable._count,
+        FeatureIDs,
+        values.Values);
+  }
+
+  return result;
+}
+
+/*static*/ void
+UCesiumPropertyTableBlueprintLibrary::CopyMetadataValuesForFeatures(
+    const FCesiumPropertyTable& PropertyTable,
+    TArrayView<const int64> FeatureIDs,
+    TArrayView<const FString> PropertyNames,
+    FCesiumPropertyTableValuesBuffer& Values) {
+  Values._featureCount = FeatureIDs.Num();
+  Values._valueTypes.Reset(PropertyNames.Num());
+  Values._values.Reset(PropertyNames.Num() * FeatureIDs.Num());
+  Values._values.AddDefaulted(PropertyNames.Num() * FeatureIDs.Num());
+
+  for (int32 i = 0; i < PropertyNames.Num(); ++i) {
+    Values._valueTypes.Add(copyValuesForFeatures(
+        PropertyTable._properties.Find(PropertyNames[i]),
+        PropertyTable._count,
+        FeatureIDs,
+        Values.GetValuesMutable(i)));
+  }
+}
+
 /*static*/ TMap<FString, FString>
 UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatureAsStrings(
     UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
@@ -2,8 +2,12 @@
 
 #include "CesiumPropertyTableProperty.h"
 #include "CesiumGltf/MetadataConversions.h"
+#include "CesiumGltf/PropertyTransformations.h"
 #include "CesiumGltf/PropertyTypeTraits.h"
+#include "CesiumMetadataRawValues.h"
 #include "UnrealMetadataConversions.h"
+#include <algorithm>
+#include <type_traits>
 #include <utility>
 
 using namespace CesiumGltf;
@@ -830,6 +834,118 @@ TResult propertyTablePropertyCallback(
   }
 }
 
+template <typename TView> struct PropertyViewTraits;
+
+template <typename T, bool Normalized>
+struct PropertyViewTraits<PropertyTablePropertyView<T, Normalized>> {
+  using ElementType = T;
+  static constexpr bool normalized = Normalized;
+};
+
+/**
+ * Gets the values of the features from firstFeatureID onwards, one for each
+ * element of values, dispatching on the type of the property only once.
+ */
+template <typename TResult>
+void copyPropertyTablePropertyValues(
+    const std::any& property,
+    const FCesiumMetadataValueType& valueType,
+    bool normalized,
+    int64 firstFeatureID,
+    TArrayView<TResult> values,
+    TResult defaultValue) {
+  propertyTablePropertyCallback<void>(
+      property,
+      valueType,
+      normalized,
+      [firstFeatureID, values, defaultValue](const auto& view) {
+        const int64 count = values.Num();
+        // size() returns zero if the view is invalid.
+        const int32 begin =
+            int32(std::clamp(-firstFeatureID, int64(0), count));
+        const int32 end = int32(std::clamp(
+            int64(view.size()) - firstFeatureID,
+            int64(begin),
+            count));
+
+        for (int32 i = 0; i < begin; ++i) {
+          values[i] = defaultValue;
+        }
+        for (int32 i = end; i < count; ++i) {
+          values[i] = defaultValue;
+        }
+
+        using Traits = PropertyViewTraits<std::decay_t<decltype(view)>>;
+        using T = typename Traits::ElementType;
+        if constexpr (CesiumMetadataRawValues::
+                          canCopyRawValues<T, Traits::normalized, TResult>()) {
+          // Without a "no data" value, every value is transformed the same
+          // way, so do it in simple passes over the whole range.
+          if (view.status() == PropertyTablePropertyViewStatus::Valid &&
+              !view.noData()) {
+            for (int32 i = begin; i < end; ++i) {
+              if constexpr (Traits::normalized) {
+                values[i] =
+                    CesiumGltf::normalize(view.getRaw(firstFeatureID + i));
+              } else {
+                values[i] = TResult(view.getRaw(firstFeatureID + i));
+              }
+            }
+
+            if constexpr (Traits::normalized || std::is_floating_point_v<T>) {
+              if (view.scale()) {
+                const TResult scale = *view.scale();
+                for (int32 i = begin; i < end; ++i) {
+                  values[i] *= scale;
+                }
+              }
+              if (view.offset()) {
+                const TResult offset = *view.offset();
+                for (int32 i = begin; i < end; ++i) {
+                  values[i] += offset;
+                }
+              }
+            }
+            return;
+          }
+        }
+
+        for (int32 i = begin; i < end; ++i) {
+          auto maybeValue = view.get(firstFeatureID + i);
+          if (maybeValue) {
+            auto value = *maybeValue;
+            values[i] =
+                CesiumGltf::MetadataConversions<TResult, decltype(value)>::
+                    convert(value)
+                        .value_or(defaultValue);
+          } else {
+            values[i] = defaultValue;
+          }
+        }
+      });
+}
+
+template <typename TResult>
+TArray<TResult> getPropertyTablePropertyValues(
+    const std::any& property,
+    const FCesiumMetadataValueType& valueType,
+    bool normalized,
+    int64 firstFeatureID,
+    int64 count,
+    TResult defaultValue) {
+  TArray<TResult> values;
+  values.SetNumUninitialized(
+      int32(std::clamp(count, int64(0), int64(MAX_int32))));
+  copyPropertyTablePropertyValues<TResult>(
+      property,
+      valueType,
+      normalized,
+      firstFeatureID,
+      values,
+      defaultValue);
+  return values;
+}
+
 } // namespace
 
 ECesiumPropertyTablePropertyStatus
@@ -1025,6 +1141,90 @@ double UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
       });
 }
 
+TArray<int32> UCesiumPropertyTablePropertyBlueprintLibrary::GetIntegerValues(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    int64 Count,
+    int32 DefaultValue) {
+  return getPropertyTablePropertyValues<int32>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Count,
+      DefaultValue);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::CopyIntegerValues(
+    const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    TArrayView<int32> Values,
+    int32 DefaultValue) {
+  copyPropertyTablePropertyValues<int32>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Values,
+      DefaultValue);
+}
+
+TArray<float> UCesiumPropertyTablePropertyBlueprintLibrary::GetFloatValues(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    int64 Count,
+    float DefaultValue) {
+  return getPropertyTablePropertyValues<float>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Count,
+      DefaultValue);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::CopyFloatValues(
+    const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    TArrayView<float> Values,
+    float DefaultValue) {
+  copyPropertyTablePropertyValues<float>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Values,
+      DefaultValue);
+}
+
+TArray<double> UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64Values(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    int64 Count,
+    double DefaultValue) {
+  return getPropertyTablePropertyValues<double>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Count,
+      DefaultValue);
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::CopyFloat64Values(
+    const FCesiumPropertyTableProperty& Property,
+    int64 FirstFeatureID,
+    TArrayView<double> Values,
+    double DefaultValue) {
+  copyPropertyTablePropertyValues<double>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      FirstFeatureID,
+      Values,
+      DefaultValue);
+}
+
 FIntPoint UCesiumPropertyTablePropertyBlueprintLibrary::GetIntPoint(
     UPARAM(ref) const FCesiumPropertyTableProperty& Property,
     int64 FeatureID,
@@ -1307,6 +1507,37 @@ FCesiumMetadataValue UCesiumPropertyTablePropertyBlueprintLibrary::GetValue(
       });
 }
 
+TArray<FCesiumMetadataValue>
+UCesiumPropertyTablePropertyBlueprintLibrary::GetValuesForFeatures(
+    UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+    const TArray<int64>& FeatureIDs) {
+  TArray<FCesiumMetadataValue> values;
+  values.SetNum(FeatureIDs.Num());
+  CopyValuesForFeatures(Property, FeatureIDs, values);
+  return values;
+}
+
+void UCesiumPropertyTablePropertyBlueprintLibrary::CopyValuesForFeatures(
+    const FCesiumPropertyTableProperty& Property,
+    TArrayView<const int64> FeatureIDs,
+    TArrayView<FCesiumMetadataValue> Values) {
+  check(Values.Num() == FeatureIDs.Num());
+  propertyTablePropertyCallback<void>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      [FeatureIDs, Values](const auto& view) {
+        // size() returns zero if the view is invalid.
+        const int64 size = view.size();
+        for (int32 i = 0; i < FeatureIDs.Num(); ++i) {
+          const int64 featureID = FeatureIDs[i];
+          Values[i] = featureID >= 0 && featureID < size
+                          ? FCesiumMetadataValue(view.get(featureID))
+                          : FCesiumMetadataValue();
+        }
+      });
+}
+
 FCesiumMetadataValue UCesiumPropertyTablePropertyBlueprintLibrary::GetRawValue(
     UPARAM(ref) const FCesiumPropertyTableProperty& Property,
     int64 FeatureID) {
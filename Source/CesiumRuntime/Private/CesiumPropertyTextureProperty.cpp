@@ -1,12 +1,17 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumPropertyTextureProperty.h"
+#include "Async/ParallelFor.h"
 #include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumMetadataRawValues.h"
 #include "UnrealMetadataConversions.h"
 
 #include <CesiumGltf/MetadataConversions.h>
+#include <CesiumGltf/PropertyTransformations.h>
+#include <CesiumUtility/Tracing.h>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 
 using namespace CesiumGltf;
 
@@ -313,6 +318,107 @@ TResult propertyTexturePropertyCallback(
   }
 }
 
+template <typename TView> struct PropertyViewTraits;
+
+template <typename T, bool Normalized>
+struct PropertyViewTraits<PropertyTexturePropertyView<T, Normalized>> {
+  using ElementType = T;
+  static constexpr bool normalized = Normalized;
+};
+
+/**
+ * The number of texture coordinates that each worker thread samples at once.
+ */
+constexpr int32 UVsPerSamplingChunk = 4096;
+
+/**
+ * Samples the property at each of the texture coordinates in parallel,
+ * dispatching on the type of the property only once for each chunk of
+ * coordinates.
+ */
+template <typename TResult>
+void copyPropertyTexturePropertyValues(
+    const std::any& property,
+    const FCesiumMetadataValueType& valueType,
+    bool normalized,
+    TArrayView<const FVector2D> uvs,
+    TArrayView<TResult> values,
+    TResult defaultValue) {
+  check(uvs.Num() == values.Num());
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SamplePropertyTextureProperty)
+
+  const int32 chunkCount =
+      FMath::DivideAndRoundUp(uvs.Num(), UVsPerSamplingChunk);
+  ParallelFor(chunkCount, [&](int32 chunk) {
+    const int32 begin = chunk * UVsPerSamplingChunk;
+    const int32 end = FMath::Min(begin + UVsPerSamplingChunk, uvs.Num());
+
+    propertyTexturePropertyCallback<void>(
+        property,
+        valueType,
+        normalized,
+        [uvs, values, defaultValue, begin, end](const auto& view) {
+          if (view.status() != PropertyTexturePropertyViewStatus::Valid) {
+            for (int32 i = begin; i < end; ++i) {
+              values[i] = defaultValue;
+            }
+            return;
+          }
+
+          using Traits = PropertyViewTraits<std::decay_t<decltype(view)>>;
+          using T = typename Traits::ElementType;
+          if constexpr (CesiumMetadataRawValues::canCopyRawValues<
+                            T,
+                            Traits::normalized,
+                            TResult>()) {
+            // Without a "no data" value, every value is transformed the same
+            // way, so do it in simple passes over the chunk that the compiler
+            // can vectorize.
+            if (!view.noData()) {
+              for (int32 i = begin; i < end; ++i) {
+                const T raw = view.getRaw(uvs[i].X, uvs[i].Y);
+                if constexpr (Traits::normalized) {
+                  values[i] = CesiumGltf::normalize(raw);
+                } else {
+                  values[i] = TResult(raw);
+                }
+              }
+
+              if constexpr (Traits::normalized || std::is_floating_point_v<T>) {
+                if (view.scale()) {
+                  const TResult scale = *view.scale();
+                  for (int32 i = begin; i < end; ++i) {
+                    values[i] *= scale;
+                  }
+                }
+                if (view.offset()) {
+                  const TResult offset = *view.offset();
+                  for (int32 i = begin; i < end; ++i) {
+                    values[i] += offset;
+                  }
+                }
+              }
+              return;
+            }
+          }
+
+          for (int32 i = begin; i < end; ++i) {
+            auto maybeValue = view.get(uvs[i].X, uvs[i].Y);
+            if (maybeValue) {
+              auto value = *maybeValue;
+              values[i] =
+                  CesiumGltf::MetadataConversions<TResult, decltype(value)>::
+                      convert(value)
+                          .value_or(defaultValue);
+            } else {
+              values[i] = defaultValue;
+            }
+          }
+        });
+  });
+}
+
 } // namespace
 
 const int64 FCesiumPropertyTextureProperty::getTexCoordSetIndex() const {
@@ -558,6 +664,54 @@ double UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64(
       });
 }
 
+TArray<int32> UCesiumPropertyTexturePropertyBlueprintLibrary::GetIntegerValues(
+    UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+    const TArray<FVector2D>& UVs,
+    int32 DefaultValue) {
+  TArray<int32> values;
+  values.SetNumUninitialized(UVs.Num());
+  CopyIntegerValues(Property, UVs, values, DefaultValue);
+  return values;
+}
+
+void UCesiumPropertyTexturePropertyBlueprintLibrary::CopyIntegerValues(
+    const FCesiumPropertyTextureProperty& Property,
+    TArrayView<const FVector2D> UVs,
+    TArrayView<int32> Values,
+    int32 DefaultValue) {
+  copyPropertyTexturePropertyValues<int32>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      UVs,
+      Values,
+      DefaultValue);
+}
+
+TArray<double> UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+    UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+    const TArray<FVector2D>& UVs,
+    double DefaultValue) {
+  TArray<double> values;
+  values.SetNumUninitialized(UVs.Num());
+  CopyFloat64Values(Property, UVs, values, DefaultValue);
+  return values;
+}
+
+void UCesiumPropertyTexturePropertyBlueprintLibrary::CopyFloat64Values(
+    const FCesiumPropertyTextureProperty& Property,
+    TArrayView<const FVector2D> UVs,
+    TArrayView<double> Values,
+    double DefaultValue) {
+  copyPropertyTexturePropertyValues<double>(
+      Property._property,
+      Property._valueType,
+      Property._normalized,
+      UVs,
+      Values,
+      DefaultValue);
+}
+
 FIntPoint UCesiumPropertyTexturePropertyBlueprintLibrary::GetIntPoint(
     UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
     const FVector2D& UV,
@@ -0,0 +1,336 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRangeAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+namespace {
+
+using RequestPointer = std::shared_ptr<CesiumAsync::IAssetRequest>;
+
+const std::string getMethod = "GET";
+const std::string rangeHeader = "Range";
+
+// The extensions of the tile content formats that may be large.
+const std::string segmentedExtensions[] =
+    {".glb", ".b3dm", ".i3dm", ".cmpt", ".pnts"};
+
+/**
+ * The range of the content in a partial response, from its `Content-Range`
+ * header.
+ */
+struct ContentRange {
+  uint64_t first;
+  uint64_t totalLength;
+};
+
+/**
+ * A response put together from the segments of the content. It has the
+ * headers of the first segment, without its range.
+ */
+class SegmentedAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  SegmentedAssetResponse(
+      const CesiumAsync::IAssetResponse& firstSegment,
+      std::vector<std::byte>&& data)
+      : _headers(firstSegment.headers()),
+        _contentType(firstSegment.contentType()),
+        _data(std::move(data)) {
+    this->_headers.erase("Content-Range");
+    this->_headers.insert_or_assign(
+        "Content-Length",
+        std::to_string(this->_data.size()));
+  }
+
+  virtual uint16_t statusCode() const override { return 200; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  CesiumAsync::HttpHeaders _headers;
+  std::string _contentType;
+  std::vector<std::byte> _data;
+};
+
+/**
+ * A request for the whole content, with the headers it was made with rather
+ * than those of the range requests.
+ */
+class SegmentedAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  SegmentedAssetRequest(
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const CesiumAsync::IAssetResponse& firstSegment,
+      std::vector<std::byte>&& data)
+      : _method(getMethod),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(firstSegment, std::move(data)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  SegmentedAssetResponse _response;
+};
+
+std::vector<CesiumAsync::IAssetAccessor::THeader> withRange(
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    uint64_t first,
+    uint64_t last) {
+  std::vector<CesiumAsync::IAssetAccessor::THeader> result = headers;
+  result.emplace_back(
+      rangeHeader,
+      "bytes=" + std::to_string(first) + "-" + std::to_string(last));
+  return result;
+}
+
+bool hasRange(
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  const CesiumAsync::CaseInsensitiveCompare less;
+  return std::any_of(
+      headers.begin(),
+      headers.end(),
+      [&less](const CesiumAsync::IAssetAccessor::THeader& header) {
+        return !less(header.first, rangeHeader) &&
+               !less(rangeHeader, header.first);
+      });
+}
+
+/**
+ * Parses a `Content-Range` header of the form `bytes first-last/length`.
+ * Returns std::nullopt if there is none, or its length is unknown.
+ */
+std::optional<ContentRange>
+getContentRange(const CesiumAsync::IAssetResponse& response) {
+  const CesiumAsync::HttpHeaders& headers = response.headers();
+  auto it = headers.find("Content-Range");
+  if (it == headers.end()) {
+    return std::nullopt;
+  }
+
+  const std::string& value = it->second;
+  const size_t start = value.find_first_of("0123456789");
+  const size_t slash = value.rfind('/');
+  if (start == std::string::npos || slash == std::string::npos ||
+      start > slash) {
+    return std::nullopt;
+  }
+
+  char* pEnd = nullptr;
+  const uint64_t first = std::strtoull(value.c_str() + start, &pEnd, 10);
+  if (*pEnd != '-') {
+    return std::nullopt;
+  }
+
+  const uint64_t totalLength =
+      std::strtoull(value.c_str() + slash + 1, &pEnd, 10);
+  if (pEnd == value.c_str() + slash + 1 || *pEnd != '\0') {
+    return std::nullopt;
+  }
+
+  return ContentRange{first, totalLength};
+}
+
+// Ranges of content compressed in transfer are ranges of the compressed
+// bytes, which the HTTP client may or may not have inflated.
+bool isEncoded(const CesiumAsync::IAssetResponse& response) {
+  const CesiumAsync::HttpHeaders& headers = response.headers();
+  auto it = headers.find("Content-Encoding");
+  return it != headers.end() && !it->second.empty() &&
+         it->second != "identity";
+}
+
+} // namespace
+
+CesiumRangeAssetAccessor::CesiumRangeAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    uint64_t segmentBytes)
+    : _pAssetAccessor(pAssetAccessor),
+      _segmentBytes(std::max<uint64_t>(segmentBytes, 1)) {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRangeAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (!isSegmentedUrl(url) || hasRange(headers)) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  return this->_pAssetAccessor
+      ->get(asyncSystem, url, withRange(headers, 0, this->_segmentBytes - 1))
+      .thenImmediately(
+          [pThis = this->shared_from_this(), asyncSystem, url, headers](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pFirstSegment) {
+            return pThis->getRemainingSegments(
+                asyncSystem,
+                url,
+                headers,
+                std::move(pFirstSegment));
+          });
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRangeAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumRangeAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+/*static*/ bool
+CesiumRangeAssetAccessor::isSegmentedUrl(const std::string& url) {
+  const size_t end = url.find_first_of("?#");
+  const std::string path =
+      end == std::string::npos ? url : url.substr(0, end);
+  return std::any_of(
+      std::begin(segmentedExtensions),
+      std::end(segmentedExtensions),
+      [&path](const std::string& extension) {
+        return path.size() > extension.size() &&
+               path.compare(
+                   path.size() - extension.size(),
+                   extension.size(),
+                   extension) == 0;
+      });
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRangeAssetAccessor::getRemainingSegments(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    std::shared_ptr<CesiumAsync::IAssetRequest>&& pFirstSegment) {
+  const CesiumAsync::IAssetResponse* pResponse =
+      pFirstSegment ? pFirstSegment->response() : nullptr;
+  if (!pResponse || pResponse->statusCode() != 206) {
+    // The server sent the whole content, or an error.
+    return asyncSystem.createResolvedFuture(std::move(pFirstSegment));
+  }
+
+  const std::optional<ContentRange> range = getContentRange(*pResponse);
+  const gsl::span<const std::byte> firstData = pResponse->data();
+  if (!range || range->first != 0 || isEncoded(*pResponse) ||
+      firstData.size() > range->totalLength) {
+    // The segments can't be put together, so the content is requested whole.
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  auto pContent = std::make_shared<std::vector<std::byte>>(
+      size_t(range->totalLength));
+  std::memcpy(pContent->data(), firstData.data(), firstData.size());
+
+  const uint64_t firstSize = uint64_t(firstData.size());
+  if (firstSize == range->totalLength) {
+    return asyncSystem.createResolvedFuture<RequestPointer>(
+        std::make_shared<SegmentedAssetRequest>(
+            url,
+            headers,
+            *pResponse,
+            std::move(*pContent)));
+  }
+
+  const uint64_t remaining = range->totalLength - firstSize;
+  const uint64_t segmentBytes = std::max(
+      this->_segmentBytes,
+      (remaining + MaximumSegmentRequests - 1) / MaximumSegmentRequests);
+
+  std::vector<CesiumAsync::Future<RequestPointer>> segments;
+  for (uint64_t offset = firstSize; offset < range->totalLength;
+       offset += segmentBytes) {
+    const uint64_t last =
+        std::min(offset + segmentBytes, range->totalLength) - 1;
+    segments.emplace_back(this->_pAssetAccessor->get(
+        asyncSystem,
+        url,
+        withRange(headers, offset, last)));
+  }
+
+  // A segment that fails makes the content be requested whole.
+  return asyncSystem.all(std::move(segments))
+      .thenInWorkerThread(
+          [url,
+           headers,
+           pFirstSegment = std::move(pFirstSegment),
+           pContent,
+           firstSize](
+              std::vector<RequestPointer>&& requests) -> RequestPointer {
+            uint64_t offset = firstSize;
+            for (RequestPointer& pRequest : requests) {
+              const CesiumAsync::IAssetResponse* pSegment =
+                  pRequest ? pRequest->response() : nullptr;
+              const std::optional<ContentRange> segmentRange =
+                  pSegment && pSegment->statusCode() == 206
+                      ? getContentRange(*pSegment)
+                      : std::nullopt;
+              if (!segmentRange || segmentRange->first != offset ||
+                  offset + pSegment->data().size() > pContent->size()) {
+                return nullptr;
+              }
+
+              const gsl::span<const std::byte> data = pSegment->data();
+              std::memcpy(pContent->data() + offset, data.data(), data.size());
+              offset += data.size();
+
+              // Each segment is released as soon as it is copied, so that the
+              // content isn't held twice.
+              pRequest.reset();
+            }
+
+            if (offset != pContent->size()) {
+              return nullptr;
+            }
+
+            return std::make_shared<SegmentedAssetRequest>(
+                url,
+                headers,
+                *pFirstSegment->response(),
+                std::move(*pContent));
+          })
+      .catchImmediately([](std::exception&&) { return RequestPointer(); })
+      .thenImmediately(
+          [pThis = this->shared_from_this(), asyncSystem, url, headers](
+              RequestPointer&& pRequest) {
+            if (pRequest) {
+              return asyncSystem.createResolvedFuture(std::move(pRequest));
+            }
+            return pThis->_pAssetAccessor->get(asyncSystem, url, headers);
+          });
+}
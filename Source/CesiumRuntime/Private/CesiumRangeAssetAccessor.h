@@ -0,0 +1,84 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * An asset accessor that downloads large tile content, such as GLB and B3DM
+ * files, as several HTTP range requests in flight at once, rather than as a
+ * single response.
+ *
+ * The first request for tile content asks for its first segment only. If the
+ * server answers with a partial response and the content turns out to be
+ * larger than the segment, the rest is requested in up to
+ * {@link MaximumSegmentRequests} more ranges at once, and the segments are
+ * copied into a single buffer of the content's full size as they are put
+ * together. A tile of tens of megabytes then downloads over several
+ * connections, and its content is never reallocated as it grows. The result
+ * looks like an ordinary 200 response to the accessors above this one, so it
+ * is cached under the URL as usual.
+ *
+ * Content that is smaller than a segment costs no extra request. When the
+ * server ignores the range, or when the content is compressed in transfer,
+ * or a segment fails, the content is requested whole instead.
+ */
+class CesiumRangeAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumRangeAssetAccessor> {
+public:
+  /**
+   * The most segments, after the first, that the content of a tile is
+   * requested in.
+   */
+  static constexpr size_t MaximumSegmentRequests = 8;
+
+  /**
+   * Creates an accessor.
+   *
+   * @param pAssetAccessor The accessor to use for requests.
+   * @param segmentBytes The size of the first segment, and the smallest size
+   * of the others.
+   */
+  CesiumRangeAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      uint64_t segmentBytes);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Determines whether a URL is for tile content that is worth downloading
+   * in segments, from the extension of its path.
+   */
+  static bool isSegmentedUrl(const std::string& url);
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  getRemainingSegments(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      std::shared_ptr<CesiumAsync::IAssetRequest>&& pFirstSegment);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  uint64_t _segmentBytes;
+};
@@ -5,6 +5,7 @@
 #include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTileset.h"
 #include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRasterOverlayRendererData.h"
 #include "CesiumRasterOverlays/RasterOverlayLoadFailureDetails.h"
 #include "CesiumRuntime.h"
 
@@ -38,6 +39,11 @@ void UCesiumRasterOverlay::AddToTileset() {
     return;
   }
 
+  // A dedicated server doesn't render, so it has no use for overlay images.
+  if (IsRunningDedicatedServer()) {
+    return;
+  }
+
   Cesium3DTilesSelection::Tileset* pTileset = FindTileset();
   if (!pTileset) {
     return;
@@ -50,7 +56,10 @@ void UCesiumRasterOverlay::AddToTileset() {
   options.maximumTextureSize = this->MaximumTextureSize;
   options.subTileCacheBytes = this->SubTileCacheBytes;
   options.showCreditsOnScreen = this->ShowCreditsOnScreen;
-  options.rendererOptions = &this->rendererOptions;
+  options.rendererOptions = CesiumRasterOverlayRendererDataPtr(
+      MakeShared<CesiumRasterOverlayRendererData>(
+          TCHAR_TO_UTF8(*this->MaterialLayerKey),
+          &this->rendererOptions));
   options.loadErrorCallback =
       [this](const CesiumRasterOverlays::RasterOverlayLoadFailureDetails&
                  details) {
@@ -97,6 +106,7 @@ void UCesiumRasterOverlay::AddToTileset() {
     this->_pOverlay = pOverlay.release();
 
     pTileset->getOverlays().add(this->_pOverlay);
+    this->GetOwner<ACesium3DTileset>()->InvalidateIdleEditorUpdate();
 
     this->OnAdd(pTileset, this->_pOverlay);
   }
@@ -123,6 +133,7 @@ void UCesiumRasterOverlay::RemoveFromTileset() {
   this->OnRemove(pTileset, this->_pOverlay);
   pTileset->getOverlays().remove(this->_pOverlay);
   this->_pOverlay = nullptr;
+  this->GetOwner<ACesium3DTileset>()->InvalidateIdleEditorUpdate();
 }
 
 void UCesiumRasterOverlay::Refresh() {
@@ -172,6 +183,17 @@ void UCesiumRasterOverlay::SetSubTileCacheBytes(int64 Value) {
   }
 }
 
+FCesiumMemoryUsage UCesiumRasterOverlay::GetMemoryUsage() const {
+  FCesiumMemoryUsage usage;
+  const CesiumRasterOverlayRendererData* pData =
+      this->_pOverlay ? CesiumRasterOverlayRendererData::get(*this->_pOverlay)
+                      : nullptr;
+  if (pData) {
+    usage.TextureBytes = pData->getTextureBytes();
+  }
+  return usage;
+}
+
 void UCesiumRasterOverlay::Activate(bool bReset) {
   Super::Activate(bReset);
   this->AddToTileset();
@@ -0,0 +1,98 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRasterOverlayRendererData.h"
+#include "CesiumNameUtility.h"
+#include "CesiumRasterOverlay.h"
+#include "CesiumRasterOverlayTextureArray.h"
+#include "CesiumTextureUtility.h"
+#include <CesiumRasterOverlays/RasterOverlay.h>
+
+using namespace CesiumNameUtility;
+
+CesiumRasterOverlayRendererData::CesiumRasterOverlayRendererData(
+    const std::string& materialLayerKey,
+    const FRasterOverlayRendererOptions* pOptions)
+    : _pOptions(pOptions),
+      _materialLayerKey(UTF8_TO_TCHAR(materialLayerKey.c_str())),
+      _textureParameterName(createSafeName(materialLayerKey, "_Texture")),
+      _translationScaleParameterName(
+          createSafeName(materialLayerKey, "_TranslationScale")),
+      _textureCoordinateIndexParameterName(
+          createSafeName(materialLayerKey, "_TextureCoordinateIndex")),
+      _textureArrayParameterName(
+          createSafeName(materialLayerKey, "_TextureArray")),
+      _projectionRectangleParameterName(
+          createSafeName(materialLayerKey, "_ProjectionRectangle")),
+      _projectionEllipsoidParameterName(
+          createSafeName(materialLayerKey, "_ProjectionEllipsoid")),
+      _pTextureArray(),
+      _layerIndices(),
+      _textureUses(),
+      _textureBytes(0) {}
+
+CesiumRasterOverlayRendererData::~CesiumRasterOverlayRendererData() noexcept =
+    default;
+
+bool CesiumRasterOverlayRendererData::usesTextureArray() const noexcept {
+  return this->_pOptions && this->_pOptions->customPrimitiveDataIndex >= 0 &&
+         this->_pOptions->textureArraySize > 0;
+}
+
+CesiumRasterOverlayTextureArray*
+CesiumRasterOverlayRendererData::getTextureArray() {
+  if (!this->_pTextureArray && this->usesTextureArray()) {
+    this->_pTextureArray =
+        std::make_unique<CesiumRasterOverlayTextureArray>(*this->_pOptions);
+  }
+  return this->_pTextureArray.get();
+}
+
+/*static*/ CesiumRasterOverlayRendererData*
+CesiumRasterOverlayRendererData::get(
+    const CesiumRasterOverlays::RasterOverlay& overlay) {
+  const CesiumRasterOverlayRendererDataPtr* ppData =
+      std::any_cast<CesiumRasterOverlayRendererDataPtr>(
+          &overlay.getOptions().rendererOptions);
+  return ppData ? ppData->Get() : nullptr;
+}
+
+const TArray<int32>& CesiumRasterOverlayRendererData::getLayerIndices(
+    const UCesiumMaterialUserData& userData) {
+  LayerIndices& entry = this->_layerIndices.FindOrAdd(&userData);
+  if (entry.layerNamesVersion == userData.LayerNamesVersion &&
+      entry.initialized) {
+    return entry.indices;
+  }
+
+  entry.initialized = true;
+  entry.layerNamesVersion = userData.LayerNamesVersion;
+  entry.indices.Reset();
+  for (int32 i = 0; i < userData.LayerNames.Num(); ++i) {
+    if (userData.LayerNames[i] == this->_materialLayerKey) {
+      entry.indices.Add(i);
+    }
+  }
+  return entry.indices;
+}
+
+void CesiumRasterOverlayRendererData::addTexture(
+    const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture) {
+  if (pTexture && this->_textureUses.FindOrAdd(pTexture)++ == 0) {
+    this->_textureBytes += int64(pTexture->getSizeBytes());
+  }
+}
+
+void CesiumRasterOverlayRendererData::removeTexture(
+    const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture) {
+  int32* pUses = pTexture ? this->_textureUses.Find(pTexture) : nullptr;
+  if (pUses && --*pUses == 0) {
+    this->_textureBytes -= int64(pTexture->getSizeBytes());
+    this->_textureUses.Remove(pTexture);
+  }
+}
+
+int64 CesiumRasterOverlayRendererData::getTextureBytes() const noexcept {
+  return this->_textureBytes +
+         (this->_pTextureArray ? int64(this->_pTextureArray->getSizeBytes())
+                               : 0);
+}
@@ -0,0 +1,184 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMaterialUserData.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Templates/SharedPointer.h"
+#include "UObject/NameTypes.h"
+#include "UObject/ObjectKey.h"
+#include <memory>
+#include <string>
+
+namespace CesiumRasterOverlays {
+class RasterOverlay;
+}
+
+namespace CesiumTextureUtility {
+struct ReferenceCountedUnrealTexture;
+}
+
+struct FRasterOverlayRendererOptions;
+class CesiumRasterOverlayTextureArray;
+
+/**
+ * The Unreal-side state that a {@link UCesiumRasterOverlay} passes to the
+ * renderer through `RasterOverlayOptions::rendererOptions`. It holds the
+ * material parameter names for the overlay, computed once when the overlay is
+ * created, so that attaching a raster tile to a primitive doesn't need to
+ * build and intern new names.
+ */
+class CesiumRasterOverlayRendererData {
+public:
+  /**
+   * Creates the renderer data for an overlay.
+   *
+   * @param materialLayerKey The overlay's material layer key, which is also the
+   * name of the cesium-native raster overlay.
+   * @param pOptions The overlay's renderer options. The UCesiumRasterOverlay
+   * that owns them must outlive the cesium-native raster overlay.
+   */
+  CesiumRasterOverlayRendererData(
+      const std::string& materialLayerKey,
+      const FRasterOverlayRendererOptions* pOptions);
+  ~CesiumRasterOverlayRendererData() noexcept;
+
+  /**
+   * Gets the renderer data for a cesium-native raster overlay, or nullptr if
+   * the overlay was not created by a UCesiumRasterOverlay.
+   */
+  static CesiumRasterOverlayRendererData*
+  get(const CesiumRasterOverlays::RasterOverlay& overlay);
+
+  /**
+   * Gets the renderer options of the overlay.
+   */
+  const FRasterOverlayRendererOptions* getOptions() const noexcept {
+    return this->_pOptions;
+  }
+
+  /**
+   * Gets the name of the texture parameter, `<key>_Texture`, used by
+   * materials without a Cesium layer stack.
+   */
+  const FName& getTextureParameterName() const noexcept {
+    return this->_textureParameterName;
+  }
+
+  /**
+   * Gets the name of the translation and scale parameter,
+   * `<key>_TranslationScale`, used by materials without a Cesium layer stack.
+   */
+  const FName& getTranslationScaleParameterName() const noexcept {
+    return this->_translationScaleParameterName;
+  }
+
+  /**
+   * Gets the name of the texture coordinate index parameter,
+   * `<key>_TextureCoordinateIndex`, used by materials without a Cesium layer
+   * stack.
+   */
+  const FName& getTextureCoordinateIndexParameterName() const noexcept {
+    return this->_textureCoordinateIndexParameterName;
+  }
+
+  /**
+   * Gets the name of the texture array parameter, `<key>_TextureArray`, used
+   * by materials without a Cesium layer stack.
+   */
+  const FName& getTextureArrayParameterName() const noexcept {
+    return this->_textureArrayParameterName;
+  }
+
+  /**
+   * Gets the name of the projection rectangle parameter,
+   * `<key>_ProjectionRectangle`, used by materials without a Cesium layer
+   * stack when the texture coordinates of overlays are computed by the
+   * material.
+   */
+  const FName& getProjectionRectangleParameterName() const noexcept {
+    return this->_projectionRectangleParameterName;
+  }
+
+  /**
+   * Gets the name of the projection ellipsoid parameter,
+   * `<key>_ProjectionEllipsoid`, used by materials without a Cesium layer
+   * stack when the texture coordinates of overlays are computed by the
+   * material.
+   */
+  const FName& getProjectionEllipsoidParameterName() const noexcept {
+    return this->_projectionEllipsoidParameterName;
+  }
+
+  /**
+   * Gets whether this overlay's tiles are packed into a texture array. May be
+   * called from any thread.
+   */
+  bool usesTextureArray() const noexcept;
+
+  /**
+   * Gets the texture array that this overlay's tiles are packed into,
+   * creating it the first time, or nullptr if they aren't packed into one.
+   * Must only be called from the game thread.
+   */
+  CesiumRasterOverlayTextureArray* getTextureArray();
+
+  /**
+   * Gets the indices of the layers in a material's Cesium layer stack whose
+   * name matches this overlay's material layer key. The indices are found the
+   * first time a material is seen and are reused until its layer names change.
+   * Must only be called from the game thread.
+   */
+  const TArray<int32>& getLayerIndices(const UCesiumMaterialUserData& userData);
+
+  /**
+   * Counts a texture created for one of this overlay's tiles in the overlay's
+   * memory usage. A texture added more than once, because identical tiles
+   * share it, is counted once until it has been removed as many times. Must
+   * only be called from the game thread.
+   */
+  void addTexture(
+      const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture);
+
+  /**
+   * Stops counting a texture added with {@link addTexture}. Must only be
+   * called from the game thread.
+   */
+  void removeTexture(
+      const CesiumTextureUtility::ReferenceCountedUnrealTexture* pTexture);
+
+  /**
+   * Gets the GPU memory taken by the textures of this overlay's tiles,
+   * including its texture array if it has one.
+   */
+  int64 getTextureBytes() const noexcept;
+
+private:
+  struct LayerIndices {
+    bool initialized = false;
+    uint32 layerNamesVersion = 0;
+    TArray<int32> indices;
+  };
+
+  const FRasterOverlayRendererOptions* _pOptions;
+  FString _materialLayerKey;
+  FName _textureParameterName;
+  FName _translationScaleParameterName;
+  FName _textureCoordinateIndexParameterName;
+  FName _textureArrayParameterName;
+  FName _projectionRectangleParameterName;
+  FName _projectionEllipsoidParameterName;
+  std::unique_ptr<CesiumRasterOverlayTextureArray> _pTextureArray;
+  TMap<TObjectKey<UCesiumMaterialUserData>, LayerIndices> _layerIndices;
+  TMap<const CesiumTextureUtility::ReferenceCountedUnrealTexture*, int32>
+      _textureUses;
+  int64 _textureBytes;
+};
+
+/**
+ * The type stored in `RasterOverlayOptions::rendererOptions` for overlays
+ * created by a UCesiumRasterOverlay.
+ */
+using CesiumRasterOverlayRendererDataPtr =
+    TSharedPtr<CesiumRasterOverlayRendererData>;
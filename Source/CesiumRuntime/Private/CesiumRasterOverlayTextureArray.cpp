@@ -0,0 +1,298 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRasterOverlayTextureArray.h"
+#include "Async/Async.h"
+#include "CesiumCommon.h"
+#include "CesiumLifetime.h"
+#include "CesiumRasterOverlay.h"
+#include "CesiumRuntime.h"
+#include "CesiumTextureUtility.h"
+#include "Engine/Texture2DArray.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "UObject/Package.h"
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltfReader/GltfReader.h>
+#include <algorithm>
+
+namespace {
+
+/**
+ * The texture resource of the `Texture2DArray`. The RHI texture is created
+ * empty, and slices are copied into it as overlay tiles are loaded.
+ */
+class FCesiumTextureArrayResource : public FTextureResource {
+public:
+  FCesiumTextureArrayResource(
+      uint32 sliceSize,
+      uint32 sliceCount,
+      uint32 mipCount,
+      bool sRGB)
+      : _sliceSize(sliceSize), _sliceCount(sliceCount), _mipCount(mipCount) {
+    this->bSRGB = sRGB;
+  }
+
+  uint32 GetSizeX() const override { return this->_sliceSize; }
+  uint32 GetSizeY() const override { return this->_sliceSize; }
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  virtual void InitRHI(FRHICommandListBase& RHICmdList) override {
+#else
+  virtual void InitRHI() override {
+#endif
+    FSamplerStateInitializerRHI samplerStateInitializer(
+        this->_mipCount > 1 ? SF_AnisotropicLinear : SF_Bilinear,
+        AM_Clamp,
+        AM_Clamp,
+        AM_Clamp);
+    this->SamplerStateRHI = GetOrCreateSamplerState(samplerStateInitializer);
+
+    ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
+    if (this->bSRGB) {
+      textureFlags |= TexCreate_SRGB;
+    }
+
+    this->TextureRHI = RHICreateTexture(
+        FRHITextureCreateDesc::Create2DArray(
+            TEXT("CesiumRasterOverlayTextureArray"))
+            .SetExtent(int32(this->_sliceSize), int32(this->_sliceSize))
+            .SetArraySize(uint16(this->_sliceCount))
+            .SetFormat(PF_R8G8B8A8)
+            .SetNumMips(uint8(this->_mipCount))
+            .SetFlags(textureFlags)
+            .SetInitialState(ERHIAccess::SRVMask));
+  }
+
+private:
+  uint32 _sliceSize;
+  uint32 _sliceCount;
+  uint32 _mipCount;
+};
+
+void resizeImage(CesiumGltf::ImageCesium& image, int32 size) {
+  if (image.width == size && image.height == size) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ResizeOverlayImage)
+
+  // Bilinear resampling, with texel centers aligned.
+  const int32 channels = image.channels;
+  std::vector<std::byte> resized(size_t(size) * size * channels);
+  const double scaleX = double(image.width) / double(size);
+  const double scaleY = double(image.height) / double(size);
+  const uint8* pSource = reinterpret_cast<const uint8*>(image.pixelData.data());
+  uint8* pDestination = reinterpret_cast<uint8*>(resized.data());
+
+  for (int32 y = 0; y < size; ++y) {
+    const double sourceY =
+        FMath::Clamp((y + 0.5) * scaleY - 0.5, 0.0, image.height - 1.0);
+    const int32 y0 = int32(sourceY);
+    const int32 y1 = FMath::Min(y0 + 1, image.height - 1);
+    const double fy = sourceY - y0;
+
+    for (int32 x = 0; x < size; ++x) {
+      const double sourceX =
+          FMath::Clamp((x + 0.5) * scaleX - 0.5, 0.0, image.width - 1.0);
+      const int32 x0 = int32(sourceX);
+      const int32 x1 = FMath::Min(x0 + 1, image.width - 1);
+      const double fx = sourceX - x0;
+
+      const uint8* p00 = pSource + (size_t(y0) * image.width + x0) * channels;
+      const uint8* p10 = pSource + (size_t(y0) * image.width + x1) * channels;
+      const uint8* p01 = pSource + (size_t(y1) * image.width + x0) * channels;
+      const uint8* p11 = pSource + (size_t(y1) * image.width + x1) * channels;
+      uint8* pOut = pDestination + (size_t(y) * size + x) * channels;
+
+      for (int32 c = 0; c < channels; ++c) {
+        const double top = p00[c] + (p10[c] - p00[c]) * fx;
+        const double bottom = p01[c] + (p11[c] - p01[c]) * fx;
+        pOut[c] = uint8(FMath::RoundToInt(top + (bottom - top) * fy));
+      }
+    }
+  }
+
+  image.pixelData = std::move(resized);
+  image.mipPositions.clear();
+  image.width = size;
+  image.height = size;
+}
+
+} // namespace
+
+CesiumRasterOverlayTextureArray::CesiumRasterOverlayTextureArray(
+    const FRasterOverlayRendererOptions& options)
+    : _pTexture(nullptr),
+      _sliceSize(uint32(FMath::RoundUpToPowerOfTwo(
+          uint32(FMath::Max(options.textureArraySliceSize, 1))))),
+      _sizeBytes(0),
+      _freeSlices() {
+  check(IsInGameThread());
+
+  const uint32 sliceCount = uint32(FMath::Max(options.textureArraySize, 1));
+  const uint32 mipCount =
+      options.useMipmaps ? FMath::FloorLog2(this->_sliceSize) + 1 : 1;
+
+  const uint64 sliceBytes = uint64(this->_sliceSize) * this->_sliceSize * 4;
+  this->_sizeBytes =
+      sliceCount * (mipCount > 1 ? sliceBytes + sliceBytes / 3 : sliceBytes);
+
+  // Slices are handed out from the end.
+  this->_freeSlices.Reserve(int32(sliceCount));
+  for (int32 i = int32(sliceCount) - 1; i >= 0; --i) {
+    this->_freeSlices.Add(i);
+  }
+
+  UTexture2DArray* pTexture = NewObject<UTexture2DArray>(
+      GetTransientPackage(),
+      MakeUniqueObjectName(
+          GetTransientPackage(),
+          UTexture2DArray::StaticClass(),
+          "CesiumRasterOverlayTextureArray"),
+      RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  pTexture->AddressX = TextureAddress::TA_Clamp;
+  pTexture->AddressY = TextureAddress::TA_Clamp;
+  pTexture->Filter = options.filter;
+  pTexture->LODGroup = options.group;
+  pTexture->SRGB = true;
+  pTexture->NeverStream = true;
+  pTexture->AddToRoot();
+
+  FCesiumTextureArrayResource* pResource = new FCesiumTextureArrayResource(
+      this->_sliceSize,
+      sliceCount,
+      mipCount,
+      true);
+  pTexture->SetResource(pResource);
+
+  ENQUEUE_RENDER_COMMAND(Cesium_InitTextureArrayResource)
+  ([pTexture, pResource](FRHICommandListImmediate& RHICmdList) {
+    pResource->SetTextureReference(
+        pTexture->TextureReference.TextureReferenceRHI);
+#if ENGINE_VERSION_5_3_OR_HIGHER
+    pResource->InitResource(FRHICommandListImmediate::Get());
+#else
+    pResource->InitResource();
+#endif
+  });
+
+  this->_pTexture = pTexture;
+}
+
+CesiumRasterOverlayTextureArray::~CesiumRasterOverlayTextureArray() noexcept {
+  UTexture2DArray* pLocal = this->_pTexture;
+  this->_pTexture = nullptr;
+
+  if (IsValid(pLocal)) {
+    if (IsInGameThread()) {
+      pLocal->RemoveFromRoot();
+      CesiumLifetime::destroy(pLocal);
+    } else {
+      AsyncTask(ENamedThreads::GameThread, [pLocal]() {
+        pLocal->RemoveFromRoot();
+        CesiumLifetime::destroy(pLocal);
+      });
+    }
+  }
+}
+
+/*static*/ bool CesiumRasterOverlayTextureArray::prepareImage(
+    CesiumGltf::ImageCesium& image,
+    const FRasterOverlayRendererOptions& options) {
+  if (image.compressedPixelFormat !=
+          CesiumGltf::GpuCompressedPixelFormat::NONE ||
+      image.channels != 4 || image.bytesPerChannel != 1 || image.width <= 0 ||
+      image.height <= 0 ||
+      image.pixelData.size() <
+          size_t(image.width) * size_t(image.height) * 4) {
+    return false;
+  }
+
+  resizeImage(
+      image,
+      int32(FMath::RoundUpToPowerOfTwo(
+          uint32(FMath::Max(options.textureArraySliceSize, 1)))));
+
+  if (options.useMipmaps) {
+    std::optional<std::string> errorMessage =
+        CesiumGltfReader::GltfReader::generateMipMaps(image);
+    if (errorMessage) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("%s"),
+          UTF8_TO_TCHAR(errorMessage->c_str()));
+    }
+  }
+
+  return true;
+}
+
+int32 CesiumRasterOverlayTextureArray::addTexture(
+    const CesiumUtility::IntrusivePointer<
+        CesiumTextureUtility::ReferenceCountedUnrealTexture>& pTexture) {
+  check(IsInGameThread());
+
+  UTexture2D* pUnrealTexture =
+      pTexture ? pTexture->getUnrealTexture().Get() : nullptr;
+  if (!pUnrealTexture || !this->_pTexture || this->_freeSlices.IsEmpty()) {
+    return -1;
+  }
+
+  FTextureResource* pSource = pUnrealTexture->GetResource();
+  FTextureResource* pDestination = this->_pTexture->GetResource();
+  if (!pSource || !pDestination || pSource->GetSizeX() != this->_sliceSize ||
+      pSource->GetSizeY() != this->_sliceSize) {
+    return -1;
+  }
+
+  const int32 slice = this->_freeSlices.Pop();
+
+  // The command holds a reference to the texture, so it's only released
+  // after it has been copied.
+  ENQUEUE_RENDER_COMMAND(Cesium_CopyToTextureArray)
+  ([pTexture, pSource, pDestination, slice](
+       FRHICommandListImmediate& RHICmdList) {
+    FRHITexture* pSourceRHI = pSource->TextureRHI;
+    FRHITexture* pDestinationRHI = pDestination->TextureRHI;
+    if (!pSourceRHI || !pDestinationRHI) {
+      return;
+    }
+
+    FRHICopyTextureInfo copyInfo;
+    copyInfo.DestSliceIndex = uint32(slice);
+    copyInfo.NumMips =
+        FMath::Min(pSourceRHI->GetNumMips(), pDestinationRHI->GetNumMips());
+
+    RHICmdList.Transition(
+        {FRHITransitionInfo(
+             pSourceRHI,
+             ERHIAccess::SRVMask,
+             ERHIAccess::CopySrc),
+         FRHITransitionInfo(
+             pDestinationRHI,
+             ERHIAccess::SRVMask,
+             ERHIAccess::CopyDest)});
+    RHICmdList.CopyTexture(pSourceRHI, pDestinationRHI, copyInfo);
+    RHICmdList.Transition(
+        {FRHITransitionInfo(
+             pSourceRHI,
+             ERHIAccess::CopySrc,
+             ERHIAccess::SRVMask),
+         FRHITransitionInfo(
+             pDestinationRHI,
+             ERHIAccess::CopyDest,
+             ERHIAccess::SRVMask)});
+  });
+
+  return slice;
+}
+
+void CesiumRasterOverlayTextureArray::removeTexture(int32 slice) {
+  check(IsInGameThread());
+
+  if (slice >= 0) {
+    this->_freeSlices.Add(slice);
+  }
+}
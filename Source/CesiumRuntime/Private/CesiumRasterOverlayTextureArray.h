@@ -0,0 +1,86 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include <CesiumUtility/IntrusivePointer.h>
+
+namespace CesiumGltf {
+struct ImageCesium;
+} // namespace CesiumGltf
+
+namespace CesiumTextureUtility {
+struct ReferenceCountedUnrealTexture;
+} // namespace CesiumTextureUtility
+
+struct FRasterOverlayRendererOptions;
+class UTexture2DArray;
+
+/**
+ * A `Texture2DArray` holding the tiles of one raster overlay, one per slice,
+ * for overlays whose `textureArraySize` is not zero. Attaching and detaching
+ * an overlay tile then only changes the slice index in each primitive's
+ * Custom Primitive Data, and the array is bound to a primitive's material
+ * just once.
+ *
+ * All slices have the same size and the `PF_R8G8B8A8` format, so overlay
+ * tile images are resized with {@link prepareImage} before their textures are
+ * created. Except for `prepareImage`, this must be used from the game
+ * thread.
+ */
+class CesiumRasterOverlayTextureArray {
+public:
+  CesiumRasterOverlayTextureArray(const FRasterOverlayRendererOptions& options);
+  ~CesiumRasterOverlayTextureArray() noexcept;
+
+  CesiumRasterOverlayTextureArray(const CesiumRasterOverlayTextureArray&) =
+      delete;
+  CesiumRasterOverlayTextureArray&
+  operator=(const CesiumRasterOverlayTextureArray&) = delete;
+
+  /**
+   * @brief Resizes an overlay tile image to the size of the slices, and
+   * generates its mipmaps if the overlay uses mipmaps. May be called from any
+   * thread.
+   *
+   * @returns false if the image can't be stored in a slice, because it isn't
+   * an uncompressed 8-bit RGBA image. The image is left as it is then.
+   */
+  static bool prepareImage(
+      CesiumGltf::ImageCesium& image,
+      const FRasterOverlayRendererOptions& options);
+
+  /**
+   * @brief Gets the `Texture2DArray` that materials sample.
+   */
+  UTexture2DArray* getTexture() const noexcept { return this->_pTexture; }
+
+  /**
+   * @brief Gets the GPU memory taken by all the slices of the array, including
+   * their mips, whether or not they're in use.
+   */
+  uint64 getSizeBytes() const noexcept { return this->_sizeBytes; }
+
+  /**
+   * @brief Copies an overlay tile texture, created from an image passed to
+   * {@link prepareImage}, into a free slice. The texture is released once it
+   * has been copied.
+   *
+   * @returns The index of the slice, or -1 if there is no free slice or the
+   * texture doesn't have the size of the slices.
+   */
+  int32 addTexture(
+      const CesiumUtility::IntrusivePointer<
+          CesiumTextureUtility::ReferenceCountedUnrealTexture>& pTexture);
+
+  /**
+   * @brief Frees a slice returned by {@link addTexture}.
+   */
+  void removeTexture(int32 slice);
+
+private:
+  UTexture2DArray* _pTexture;
+  uint32 _sliceSize;
+  uint64 _sizeBytes;
+  TArray<int32> _freeSlices;
+};
@@ -0,0 +1,432 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRecordingAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+// Identifies the format of a recorded response, and its version.
+constexpr char archiveMagic[4] = {'C', 'R', 'R', '1'};
+
+class RecordedAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  RecordedAssetResponse(
+      uint16_t statusCode,
+      std::string&& contentType,
+      CesiumAsync::HttpHeaders&& headers,
+      std::vector<std::byte>&& data)
+      : _statusCode(statusCode),
+        _contentType(std::move(contentType)),
+        _headers(std::move(headers)),
+        _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    return this->_contentType;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  uint16_t _statusCode;
+  std::string _contentType;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class RecordedAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  RecordedAssetRequest(
+      const std::string& method,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      RecordedAssetResponse&& response)
+      : _method(method),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(std::move(response)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  RecordedAssetResponse _response;
+};
+
+// Gets the path of the recorded response to a request. The name is a 64-bit
+// FNV-1a hash of the request, which is stable across platforms and runs.
+std::string getArchivePath(
+    const std::string& archiveDirectory,
+    const std::string& verb,
+    const std::string& url,
+    const gsl::span<const std::byte>& payload) {
+  uint64_t hash = 14695981039346656037ull;
+  const auto add = [&hash](const void* pData, size_t size) {
+    const uint8_t* pBytes = static_cast<const uint8_t*>(pData);
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ pBytes[i]) * 1099511628211ull;
+    }
+  };
+  add(verb.data(), verb.size());
+  add(" ", 1);
+  add(url.data(), url.size());
+  add(payload.data(), payload.size());
+
+  char name[24];
+  std::snprintf(
+      name,
+      sizeof(name),
+      "%016llx.bin",
+      static_cast<unsigned long long>(hash));
+  return archiveDirectory + "/" + name;
+}
+
+void writeUint32(TArray<uint8>& out, uint32_t value) {
+  for (int32 i = 0; i < 4; ++i) {
+    out.Add(uint8(value >> (8 * i)));
+  }
+}
+
+void writeBytes(TArray<uint8>& out, const void* pData, size_t size) {
+  writeUint32(out, uint32_t(size));
+  out.Append(static_cast<const uint8*>(pData), int32(size));
+}
+
+void writeString(TArray<uint8>& out, const std::string& value) {
+  writeBytes(out, value.data(), value.size());
+}
+
+TArray<uint8> serialize(const CesiumAsync::IAssetRequest& request) {
+  const CesiumAsync::IAssetResponse& response = *request.response();
+  const gsl::span<const std::byte> data = response.data();
+
+  TArray<uint8> out;
+  out.Reserve(int32(data.size()) + 1024);
+  out.Append(reinterpret_cast<const uint8*>(archiveMagic), 4);
+  writeString(out, request.method());
+  writeString(out, request.url());
+  writeUint32(out, response.statusCode());
+  writeString(out, response.contentType());
+  writeUint32(out, uint32_t(response.headers().size()));
+  for (const auto& [name, value] : response.headers()) {
+    writeString(out, name);
+    writeString(out, value);
+  }
+  writeBytes(out, data.data(), data.size());
+  return out;
+}
+
+/**
+ * Reads the fields of a recorded response in order, failing once any of them
+ * runs past the end of the file.
+ */
+class ArchiveReader {
+public:
+  ArchiveReader(const TArray64<uint8>& data) : _data(data), _offset(0) {}
+
+  bool readUint32(uint32_t& value) {
+    if (this->_offset + 4 > this->_data.Num()) {
+      return false;
+    }
+    value = 0;
+    for (int32 i = 0; i < 4; ++i) {
+      value |= uint32_t(this->_data[this->_offset++]) << (8 * i);
+    }
+    return true;
+  }
+
+  bool readString(std::string& value) {
+    uint32_t size;
+    if (!this->readUint32(size) || this->_offset + size > this->_data.Num()) {
+      return false;
+    }
+    value.assign(
+        reinterpret_cast<const char*>(this->_data.GetData() + this->_offset),
+        size);
+    this->_offset += size;
+    return true;
+  }
+
+  bool readBytes(std::vector<std::byte>& value) {
+    uint32_t size;
+    if (!this->readUint32(size) || this->_offset + size > this->_data.Num()) {
+      return false;
+    }
+    const std::byte* pBegin =
+        reinterpret_cast<const std::byte*>(this->_data.GetData()) +
+        this->_offset;
+    value.assign(pBegin, pBegin + size);
+    this->_offset += size;
+    return true;
+  }
+
+private:
+  const TArray64<uint8>& _data;
+  int64 _offset;
+};
+
+std::optional<RecordedAssetResponse> deserialize(
+    const TArray64<uint8>& data,
+    const std::string& verb,
+    const std::string& url) {
+  if (data.Num() < 4 || std::memcmp(data.GetData(), archiveMagic, 4) != 0) {
+    return std::nullopt;
+  }
+
+  ArchiveReader reader(data);
+  uint32_t magic;
+  std::string method;
+  std::string recordedUrl;
+  uint32_t statusCode;
+  std::string contentType;
+  uint32_t headerCount;
+  if (!reader.readUint32(magic) || !reader.readString(method) ||
+      !reader.readString(recordedUrl) || !reader.readUint32(statusCode) ||
+      !reader.readString(contentType) || !reader.readUint32(headerCount)) {
+    return std::nullopt;
+  }
+
+  // Guards against a hash collision.
+  if (method != verb || recordedUrl != url) {
+    return std::nullopt;
+  }
+
+  CesiumAsync::HttpHeaders headers;
+  for (uint32_t i = 0; i < headerCount; ++i) {
+    std::string name;
+    std::string value;
+    if (!reader.readString(name) || !reader.readString(value)) {
+      return std::nullopt;
+    }
+    headers.emplace(std::move(name), std::move(value));
+  }
+
+  std::vector<std::byte> body;
+  if (!reader.readBytes(body)) {
+    return std::nullopt;
+  }
+
+  return RecordedAssetResponse(
+      uint16_t(statusCode),
+      std::move(contentType),
+      std::move(headers),
+      std::move(body));
+}
+
+} // namespace
+
+CesiumRecordingAssetAccessor::CesiumRecordingAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    Mode mode,
+    const std::string& archiveDirectory,
+    double latencySeconds,
+    double bytesPerSecond)
+    : _pAssetAccessor(pAssetAccessor),
+      _mode(mode),
+      _archiveDirectory(archiveDirectory),
+      _latency(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(std::max(latencySeconds, 0.0)))),
+      _bytesPerSecond(std::max(bytesPerSecond, 0.0)),
+      _mutex(),
+      _pending(),
+      _linkAvailable(),
+      _missCount(0) {
+  if (this->_mode == Mode::Record) {
+    IFileManager::Get().MakeDirectory(
+        UTF8_TO_TCHAR(this->_archiveDirectory.c_str()),
+        true);
+  }
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRecordingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  return this->request(asyncSystem, "GET", url, headers, {});
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRecordingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  std::string path =
+      getArchivePath(this->_archiveDirectory, verb, url, contentPayload);
+
+  if (this->_mode == Mode::Replay) {
+    return this->replay(asyncSystem, verb, url, headers, path);
+  }
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> response =
+      verb == "GET" ? this->_pAssetAccessor->get(asyncSystem, url, headers)
+                    : this->_pAssetAccessor->request(
+                          asyncSystem,
+                          verb,
+                          url,
+                          headers,
+                          contentPayload);
+  return std::move(response).thenInWorkerThread(
+      [path = std::move(path)](
+          std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+        if (pRequest && pRequest->response()) {
+          const TArray<uint8> data = serialize(*pRequest);
+          if (!FFileHelper::SaveArrayToFile(
+                  data,
+                  UTF8_TO_TCHAR(path.c_str()))) {
+            UE_LOG(
+                LogCesium,
+                Warning,
+                TEXT("Could not record the response to %s in %s"),
+                UTF8_TO_TCHAR(pRequest->url().c_str()),
+                UTF8_TO_TCHAR(path.c_str()));
+          }
+        }
+        return std::move(pRequest);
+      });
+}
+
+void CesiumRecordingAssetAccessor::tick() noexcept {
+  if (this->_pAssetAccessor) {
+    this->_pAssetAccessor->tick();
+  }
+
+  std::vector<PendingResponse> completed;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    const Clock::time_point now = Clock::now();
+    auto it = std::partition(
+        this->_pending.begin(),
+        this->_pending.end(),
+        [now](const PendingResponse& pending) {
+          return pending.completion > now;
+        });
+    completed.assign(
+        std::make_move_iterator(it),
+        std::make_move_iterator(this->_pending.end()));
+    this->_pending.erase(it, this->_pending.end());
+  }
+
+  for (PendingResponse& pending : completed) {
+    pending.promise.resolve(std::move(pending.pRequest));
+  }
+}
+
+int32_t CesiumRecordingAssetAccessor::getMissCount() const {
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  return this->_missCount;
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumRecordingAssetAccessor::replay(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const std::string& path) {
+  // The simulated transfer starts when the request is made, not when its
+  // response has been read from the archive.
+  const Clock::time_point requested = Clock::now();
+
+  return asyncSystem
+      .runInWorkerThread(
+          [pThis = this->shared_from_this(), verb, url, headers, path]()
+              -> std::shared_ptr<CesiumAsync::IAssetRequest> {
+        TArray64<uint8> data;
+        std::optional<RecordedAssetResponse> maybeResponse;
+        if (FFileHelper::LoadFileToArray(
+                data,
+                UTF8_TO_TCHAR(path.c_str()),
+                FILEREAD_Silent)) {
+          maybeResponse = deserialize(data, verb, url);
+        }
+
+        if (!maybeResponse) {
+          {
+            std::scoped_lock<std::mutex> lock(pThis->_mutex);
+            ++pThis->_missCount;
+          }
+          UE_LOG(
+              LogCesium,
+              Warning,
+              TEXT("No recorded response to %s %s"),
+              UTF8_TO_TCHAR(verb.c_str()),
+              UTF8_TO_TCHAR(url.c_str()));
+          maybeResponse.emplace(
+              uint16_t(404),
+              std::string(),
+              CesiumAsync::HttpHeaders(),
+              std::vector<std::byte>());
+        }
+
+        return std::make_shared<RecordedAssetRequest>(
+            verb,
+            url,
+            headers,
+            std::move(*maybeResponse));
+      })
+      .thenImmediately(
+          [pThis = this->shared_from_this(), asyncSystem, requested](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            if (pThis->_latency == Clock::duration::zero() &&
+                pThis->_bytesPerSecond == 0.0) {
+              return asyncSystem.createResolvedFuture(std::move(pRequest));
+            }
+
+            const double transferSeconds =
+                pThis->_bytesPerSecond > 0.0
+                    ? double(pRequest->response()->data().size()) /
+                          pThis->_bytesPerSecond
+                    : 0.0;
+
+            CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>
+                promise = asyncSystem.createPromise<
+                    std::shared_ptr<CesiumAsync::IAssetRequest>>();
+            {
+              // Responses share the bandwidth by being transferred one after
+              // another.
+              std::scoped_lock<std::mutex> lock(pThis->_mutex);
+              Clock::time_point completion = requested + pThis->_latency;
+              if (pThis->_bytesPerSecond > 0.0) {
+                completion =
+                    std::max(completion, pThis->_linkAvailable) +
+                    std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(transferSeconds));
+                pThis->_linkAvailable = completion;
+              }
+              pThis->_pending.push_back(
+                  PendingResponse{completion, std::move(pRequest), promise});
+            }
+            return promise.getFuture();
+          });
+}
@@ -0,0 +1,103 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/Promise.h"
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * An asset accessor that records the responses to requests in an archive
+ * directory, or replays them from it without using the network, so that
+ * benchmarks give the same results from run to run and can run offline.
+ *
+ * While recording, each request is passed on, and its response is written to
+ * the archive, one file per request, named after a hash of the verb, URL and
+ * payload. Request headers are not part of the key, so a recording can be
+ * replayed with other access tokens.
+ *
+ * While replaying, each request is answered from the archive, and a request
+ * that was not recorded is answered with a 404 response. Responses are
+ * delayed to simulate a network with the given latency and bandwidth, which
+ * is shared by all requests, and are completed when this accessor is ticked.
+ */
+class CesiumRecordingAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumRecordingAssetAccessor> {
+public:
+  enum class Mode { Record, Replay };
+
+  /**
+   * Creates an accessor.
+   *
+   * @param pAssetAccessor The accessor to pass requests on to while
+   * recording. It is not used while replaying.
+   * @param mode Whether to record or replay responses.
+   * @param archiveDirectory The directory of the recorded responses.
+   * @param latencySeconds The time, in seconds, between a request and the
+   * first byte of its replayed response.
+   * @param bytesPerSecond The bandwidth of the simulated network, or zero for
+   * no limit.
+   */
+  CesiumRecordingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      Mode mode,
+      const std::string& archiveDirectory,
+      double latencySeconds = 0.0,
+      double bytesPerSecond = 0.0);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Gets the number of replayed requests that were not found in the archive.
+   */
+  int32_t getMissCount() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  struct PendingResponse {
+    Clock::time_point completion;
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise;
+  };
+
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> replay(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const std::string& path);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  Mode _mode;
+  std::string _archiveDirectory;
+  Clock::duration _latency;
+  double _bytesPerSecond;
+
+  mutable std::mutex _mutex;
+  // The replayed responses that are waiting for their simulated transfer to
+  // complete.
+  std::vector<PendingResponse> _pending;
+  // When the simulated network is free to transfer the next response.
+  Clock::time_point _linkAvailable;
+  int32_t _missCount;
+};
@@ -0,0 +1,211 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumReplicatedGlobeTransform.h"
+#include "CesiumGeometry/Transforms.h"
+#include "VecMath.h"
+#include <cmath>
+
+namespace {
+
+// The precision of quantized positions, in meters.
+constexpr double PositionPrecision = 0.01;
+
+// The largest coordinate that can be quantized to a 32-bit integer.
+constexpr double MaxQuantizedCoordinate =
+    double(TNumericLimits<int32>::Max()) * PositionPrecision;
+
+// The components of a unit quaternion other than the largest are within this
+// range.
+constexpr double RotationRange = 0.70710678118654752;
+constexpr double RotationSteps = double(TNumericLimits<uint16>::Max());
+
+// The flags that are sent ahead of the quantized values.
+constexpr uint8 FullPrecisionPositionFlag = 1;
+constexpr uint8 ScaleFlag = 2;
+constexpr int64 FlagBits = 2;
+constexpr int64 LargestComponentBits = 2;
+
+bool canQuantizePosition(const FVector& position) {
+  return FMath::Abs(position.X) < MaxQuantizedCoordinate &&
+         FMath::Abs(position.Y) < MaxQuantizedCoordinate &&
+         FMath::Abs(position.Z) < MaxQuantizedCoordinate;
+}
+
+int32 quantizeCoordinate(double coordinate) {
+  return int32(std::llround(coordinate / PositionPrecision));
+}
+
+double dequantizeCoordinate(int32 coordinate) {
+  return double(coordinate) * PositionPrecision;
+}
+
+/**
+ * Quantizes a rotation to the index of the largest component of its
+ * quaternion, and the other three components. The quaternion is negated if
+ * needed so that its largest component is positive, which represents the same
+ * rotation.
+ */
+void quantizeRotation(
+    const FQuat& rotation,
+    uint32& largest,
+    uint16 (&components)[3]) {
+  const FQuat normalized = rotation.GetNormalized();
+  const double values[4] =
+      {normalized.X, normalized.Y, normalized.Z, normalized.W};
+
+  largest = 0;
+  for (uint32 i = 1; i < 4; ++i) {
+    if (FMath::Abs(values[i]) > FMath::Abs(values[largest])) {
+      largest = i;
+    }
+  }
+
+  const double sign = values[largest] < 0.0 ? -1.0 : 1.0;
+  uint32 component = 0;
+  for (uint32 i = 0; i < 4; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    const double normalizedValue =
+        (sign * values[i] / RotationRange + 1.0) * 0.5;
+    components[component++] = uint16(FMath::RoundToInt(
+        FMath::Clamp(normalizedValue, 0.0, 1.0) * RotationSteps));
+  }
+}
+
+FQuat dequantizeRotation(uint32 largest, const uint16 (&components)[3]) {
+  double values[4];
+  double sumOfSquares = 0.0;
+  uint32 component = 0;
+  for (uint32 i = 0; i < 4; ++i) {
+    if (i == largest) {
+      continue;
+    }
+    const double value =
+        (double(components[component++]) / RotationSteps * 2.0 - 1.0) *
+        RotationRange;
+    values[i] = value;
+    sumOfSquares += value * value;
+  }
+  values[largest] = std::sqrt(FMath::Max(1.0 - sumOfSquares, 0.0));
+
+  return FQuat(values[0], values[1], values[2], values[3]).GetNormalized();
+}
+
+bool isUnitScale(const FVector& scale) {
+  return scale.Equals(FVector::OneVector, 1e-6);
+}
+
+} // namespace
+
+FCesiumReplicatedGlobeTransform FCesiumReplicatedGlobeTransform::FromMatrix(
+    const FMatrix& ActorToEarthCenteredEarthFixed) {
+  glm::dvec3 translation;
+  glm::dquat rotation;
+  glm::dvec3 scale;
+  CesiumGeometry::Transforms::computeTranslationRotationScaleFromMatrix(
+      VecMath::createMatrix4D(ActorToEarthCenteredEarthFixed),
+      &translation,
+      &rotation,
+      &scale);
+
+  FCesiumReplicatedGlobeTransform result;
+
+  result.Position = VecMath::createVector(translation);
+  if (canQuantizePosition(result.Position)) {
+    result.Position = FVector(
+        dequantizeCoordinate(quantizeCoordinate(result.Position.X)),
+        dequantizeCoordinate(quantizeCoordinate(result.Position.Y)),
+        dequantizeCoordinate(quantizeCoordinate(result.Position.Z)));
+  }
+
+  uint32 largest;
+  uint16 components[3];
+  quantizeRotation(VecMath::createQuaternion(rotation), largest, components);
+  result.Rotation = dequantizeRotation(largest, components);
+
+  result.Scale = VecMath::createVector(scale);
+  if (isUnitScale(result.Scale)) {
+    result.Scale = FVector::OneVector;
+  } else {
+    result.Scale = FVector(FVector3f(result.Scale));
+  }
+
+  return result;
+}
+
+FMatrix FCesiumReplicatedGlobeTransform::ToMatrix() const {
+  return VecMath::createMatrix(
+      CesiumGeometry::Transforms::createTranslationRotationScaleMatrix(
+          VecMath::createVector3D(this->Position),
+          VecMath::createQuaternion(this->Rotation),
+          VecMath::createVector3D(this->Scale)));
+}
+
+bool FCesiumReplicatedGlobeTransform::NetSerialize(
+    FArchive& Ar,
+    UPackageMap* Map,
+    bool& bOutSuccess) {
+  uint8 flags = 0;
+  if (Ar.IsSaving()) {
+    if (!canQuantizePosition(this->Position)) {
+      flags |= FullPrecisionPositionFlag;
+    }
+    if (!isUnitScale(this->Scale)) {
+      flags |= ScaleFlag;
+    }
+  }
+  Ar.SerializeBits(&flags, FlagBits);
+
+  if (flags & FullPrecisionPositionFlag) {
+    Ar << this->Position.X;
+    Ar << this->Position.Y;
+    Ar << this->Position.Z;
+  } else {
+    int32 coordinates[3];
+    if (Ar.IsSaving()) {
+      for (int32 i = 0; i < 3; ++i) {
+        coordinates[i] = quantizeCoordinate(this->Position[i]);
+      }
+    }
+    for (int32 i = 0; i < 3; ++i) {
+      Ar << coordinates[i];
+    }
+    if (Ar.IsLoading()) {
+      this->Position = FVector(
+          dequantizeCoordinate(coordinates[0]),
+          dequantizeCoordinate(coordinates[1]),
+          dequantizeCoordinate(coordinates[2]));
+    }
+  }
+
+  uint32 largest = 0;
+  uint16 components[3] = {0, 0, 0};
+  if (Ar.IsSaving()) {
+    quantizeRotation(this->Rotation, largest, components);
+  }
+  Ar.SerializeBits(&largest, LargestComponentBits);
+  for (int32 i = 0; i < 3; ++i) {
+    Ar << components[i];
+  }
+  if (Ar.IsLoading()) {
+    this->Rotation = dequantizeRotation(largest, components);
+  }
+
+  if (flags & ScaleFlag) {
+    FVector3f scale(this->Scale);
+    Ar << scale;
+    this->Scale = FVector(scale);
+  } else if (Ar.IsLoading()) {
+    this->Scale = FVector::OneVector;
+  }
+
+  bOutSuccess = !Ar.IsError();
+  return true;
+}
+
+bool FCesiumReplicatedGlobeTransform::operator==(
+    const FCesiumReplicatedGlobeTransform& Other) const {
+  return this->Position == Other.Position && this->Rotation == Other.Rotation &&
+         this->Scale == Other.Scale;
+}
@@ -5,11 +5,26 @@
 #include "CesiumAsync/CachingAssetAccessor.h"
 #include "CesiumAsync/GunzipAssetAccessor.h"
 #include "CesiumAsync/SqliteCache.h"
+#include "CesiumBakedCacheDatabase.h"
+#include "CesiumCacheDatabase.h"
+#include "CesiumDeferredCacheDatabase.h"
+#include "CesiumMemoryCacheAssetAccessor.h"
+#include "CesiumPooledCacheDatabase.h"
+#include "CesiumRangeAssetAccessor.h"
+#include "CesiumRecordingAssetAccessor.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
+#include "CesiumTextureResidency.h"
+#include "CesiumTextureUtility.h"
 #include "CesiumUtility/Tracing.h"
+#include "CesiumWarmStartAssetAccessor.h"
+#include "CesiumWebMapServiceBundlingAssetAccessor.h"
 #include "HAL/FileManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Parse.h"
 #include "Misc/Paths.h"
 #include "ShaderCore.h"
 #include "SpdlogUnrealLoggerSink.h"
@@ -19,6 +34,7 @@
 #include <CesiumAsync/IAssetAccessor.h>
 #include <Modules/ModuleManager.h>
 #include <spdlog/spdlog.h>
+#include <vector>
 
 #if CESIUM_TRACING_ENABLED
 #include <chrono>
@@ -50,9 +66,27 @@ void FCesiumRuntimeModule::StartupModule() {
   AddShaderSourceDirectoryMapping(
       TEXT("/Plugin/CesiumForUnreal"),
       PluginShaderDir);
+
+  // Start opening the request cache now, so that it is usually ready by the
+  // time the first tileset asks for it.
+  getCacheDatabase();
+
+  this->_onEndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(
+      this,
+      &FCesiumRuntimeModule::OnEndFrame);
 }
 
-void FCesiumRuntimeModule::ShutdownModule() { CESIUM_TRACE_SHUTDOWN(); }
+void FCesiumRuntimeModule::ShutdownModule() {
+  FCoreDelegates::OnEndFrame.Remove(this->_onEndFrameHandle);
+  getTaskProcessor()->shutdown();
+  CESIUM_TRACE_SHUTDOWN();
+}
+
+void FCesiumRuntimeModule::OnEndFrame() {
+  CesiumTextureUtility::releaseUnusedSharedTextures();
+  CesiumTextureResidency::update();
+  CesiumStats::updateFrame();
+}
 
 #undef LOCTEXT_NAMESPACE
 
@@ -62,15 +96,48 @@ FCesium3DTilesetIonTroubleshooting OnCesium3DTilesetIonTroubleshooting{};
 FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting{};
 
+const std::shared_ptr<UnrealTaskProcessor>& getTaskProcessor() noexcept {
+  static std::shared_ptr<UnrealTaskProcessor> pTaskProcessor = []() {
+    const UCesiumRuntimeSettings* pSettings =
+        GetDefault<UCesiumRuntimeSettings>();
+    int32 threadCount = 0;
+    if (pSettings->UseDedicatedTaskThreads) {
+      threadCount = pSettings->DedicatedTaskThreadCount;
+      if (threadCount <= 0) {
+        threadCount = FMath::Max(
+            1,
+            FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 2);
+      }
+    }
+    return std::make_shared<UnrealTaskProcessor>(threadCount);
+  }();
+  return pTaskProcessor;
+}
+
 CesiumAsync::AsyncSystem& getAsyncSystem() noexcept {
-  static CesiumAsync::AsyncSystem asyncSystem(
-      std::make_shared<UnrealTaskProcessor>());
+  static CesiumAsync::AsyncSystem asyncSystem(getTaskProcessor());
   return asyncSystem;
 }
 
 namespace {
 
+// The request cache database given with -CesiumRequestCache=<path> on the
+// command line, such as the one being baked by the CesiumBakeTiles commandlet,
+// or an empty string.
+FString getCommandLineCacheDatabaseName() {
+  FString filename;
+  FParse::Value(FCommandLine::Get(), TEXT("CesiumRequestCache="), filename);
+  return filename;
+}
+
 std::string getCacheDatabaseName() {
+  const FString commandLineName = getCommandLineCacheDatabaseName();
+  if (!commandLineName.IsEmpty()) {
+    const FString path = FPaths::ConvertRelativePathToFull(commandLineName);
+    UE_LOG(LogCesium, Display, TEXT("Caching Cesium requests in %s"), *path);
+    return TCHAR_TO_UTF8(*path);
+  }
+
 #if PLATFORM_ANDROID
   FString BaseDirectory = FPaths::ProjectPersistentDownloadDir();
 #elif PLATFORM_IOS
@@ -98,30 +165,193 @@ std::string getCacheDatabaseName() {
   return TCHAR_TO_UTF8(*PlatformAbsolutePath);
 }
 
-} // namespace
+std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>>
+createCacheReadDatabases(
+    const std::string& databaseName,
+    int maxItems,
+    int count) {
+  std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>> databases;
+  databases.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    databases.emplace_back(std::make_shared<CesiumAsync::SqliteCache>(
+        spdlog::default_logger(),
+        databaseName,
+        maxItems));
+  }
+  return databases;
+}
 
-std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
+// The accessor that sends requests to the network, or that records or replays
+// their responses when benchmarking.
+std::shared_ptr<CesiumAsync::IAssetAccessor> createNetworkAssetAccessor() {
+  std::shared_ptr<CesiumAsync::IAssetAccessor> pNetworkAccessor =
+      std::make_shared<UnrealAssetAccessor>();
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (pSettings->RangeRequestSegmentMB > 0) {
+    pNetworkAccessor = std::make_shared<CesiumRangeAssetAccessor>(
+        pNetworkAccessor,
+        uint64_t(pSettings->RangeRequestSegmentMB) * 1024 * 1024);
+  }
+  if (pSettings->RequestArchiveMode == ECesiumRequestArchiveMode::Disabled) {
+    return pNetworkAccessor;
+  }
+
+  const FString directory = FPaths::ConvertRelativePathToFull(
+      FPaths::ProjectSavedDir(),
+      pSettings->RequestArchiveDirectory);
+  const bool replay =
+      pSettings->RequestArchiveMode == ECesiumRequestArchiveMode::Replay;
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("%s network responses in %s"),
+      replay ? TEXT("Replaying") : TEXT("Recording"),
+      *directory);
+
+  return std::make_shared<CesiumRecordingAssetAccessor>(
+      pNetworkAccessor,
+      replay ? CesiumRecordingAssetAccessor::Mode::Replay
+             : CesiumRecordingAssetAccessor::Mode::Record,
+      TCHAR_TO_UTF8(*directory),
+      pSettings->ReplayLatencyMilliseconds / 1000.0,
+      pSettings->ReplayBandwidthMegabitsPerSecond * 1000000.0 / 8.0);
+}
+
+// The on-disk cache of the user, where responses are stored.
+const std::shared_ptr<CesiumCacheDatabase>& getUserCacheDatabase() {
   static int MaxCacheItems =
       GetDefault<UCesiumRuntimeSettings>()->MaxCacheItems;
 
-  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
-      std::make_shared<CesiumAsync::SqliteCache>(
-          spdlog::default_logger(),
-          getCacheDatabaseName(),
-          MaxCacheItems);
+  static int64 MaxCacheSizeBytes =
+      int64(GetDefault<UCesiumRuntimeSettings>()->MaxCacheSizeMB) * 1024 *
+      1024;
+  static int CacheReadConnections =
+      GetDefault<UCesiumRuntimeSettings>()->CacheReadConnections;
+  static std::string CacheDatabaseName = getCacheDatabaseName();
 
+  static std::shared_ptr<CesiumCacheDatabase> pCacheDatabase =
+      std::make_shared<CesiumCacheDatabase>(
+          std::make_shared<CesiumPooledCacheDatabase>(
+              std::make_shared<CesiumAsync::SqliteCache>(
+                  spdlog::default_logger(),
+                  CacheDatabaseName,
+                  MaxCacheItems),
+              createCacheReadDatabases(
+                  CacheDatabaseName,
+                  MaxCacheItems,
+                  CacheReadConnections)),
+          MaxCacheSizeBytes,
+          UTF8_TO_TCHAR((CacheDatabaseName + ".index").c_str()));
+
+  return pCacheDatabase;
+}
+
+// Puts the baked cache database of the project, if there is one, in front of
+// the cache of the user. A cache given on the command line is used alone, so
+// that baking doesn't find the responses of an earlier bake.
+std::shared_ptr<CesiumAsync::ICacheDatabase> createCacheDatabase() {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (pSettings->BakedCacheFilename.IsEmpty() ||
+      !getCommandLineCacheDatabaseName().IsEmpty()) {
+    return getUserCacheDatabase();
+  }
+
+  const FString filename = FPaths::Combine(
+      FPaths::ProjectContentDir(),
+      pSettings->BakedCacheFilename);
+  if (!IFileManager::Get().FileExists(*filename)) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT("The baked Cesium request cache %s does not exist."),
+        *filename);
+    return getUserCacheDatabase();
+  }
+
+  const std::string bakedName = TCHAR_TO_UTF8(
+      *IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(
+          *filename));
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Looking up Cesium requests in the baked cache %s"),
+      UTF8_TO_TCHAR(bakedName.c_str()));
+
+  // The baked database is never written, so its first read connection stands
+  // in for the write connection.
+  std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>> readDatabases =
+      createCacheReadDatabases(
+          bakedName,
+          pSettings->MaxCacheItems,
+          pSettings->CacheReadConnections);
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pWriteDatabase =
+      readDatabases.front();
+  return std::make_shared<CesiumBakedCacheDatabase>(
+      std::make_shared<CesiumPooledCacheDatabase>(
+          pWriteDatabase,
+          std::move(readDatabases)),
+      getUserCacheDatabase());
+}
+
+// The request cache database, created in a background task the first time it
+// is asked for.
+const std::shared_ptr<CesiumDeferredCacheDatabase>&
+getDeferredCacheDatabase() {
+  static std::shared_ptr<CesiumDeferredCacheDatabase> pCacheDatabase = []() {
+    // The settings are read in the background task, so their default object
+    // is created here rather than there.
+    GetDefault<UCesiumRuntimeSettings>();
+    return std::make_shared<CesiumDeferredCacheDatabase>(createCacheDatabase);
+  }();
   return pCacheDatabase;
 }
 
+// Answers the requests that bootstrap each tileset with the responses of the
+// previous session, if enabled.
+std::shared_ptr<CesiumAsync::IAssetAccessor> createWarmStartAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor) {
+  if (!GetDefault<UCesiumRuntimeSettings>()->WarmStartTilesetRequests) {
+    return pAssetAccessor;
+  }
+  return std::make_shared<CesiumWarmStartAssetAccessor>(
+      pAssetAccessor,
+      getCacheDatabase());
+}
+
+} // namespace
+
+std::shared_ptr<CesiumAsync::ICacheDatabase>& getCacheDatabase() {
+  static std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
+      getDeferredCacheDatabase();
+  return pCacheDatabase;
+}
+
+void flushCacheDatabase() {
+  getDeferredCacheDatabase()->getDatabase();
+  getUserCacheDatabase()->pruneNow();
+}
+
 const std::shared_ptr<CesiumAsync::IAssetAccessor>& getAssetAccessor() {
   static int RequestsPerCachePrune =
       GetDefault<UCesiumRuntimeSettings>()->RequestsPerCachePrune;
+  static int64 MemoryCacheSizeBytes =
+      int64(GetDefault<UCesiumRuntimeSettings>()->MemoryCacheSizeMB) * 1024 *
+      1024;
   static std::shared_ptr<CesiumAsync::IAssetAccessor> pAssetAccessor =
-      std::make_shared<CesiumAsync::GunzipAssetAccessor>(
-          std::make_shared<CesiumAsync::CachingAssetAccessor>(
-              spdlog::default_logger(),
-              std::make_shared<UnrealAssetAccessor>(),
-              getCacheDatabase(),
-              RequestsPerCachePrune));
+      std::make_shared<CesiumWebMapServiceBundlingAssetAccessor>(
+          createWarmStartAssetAccessor(
+              std::make_shared<CesiumMemoryCacheAssetAccessor>(
+                  std::make_shared<CesiumAsync::GunzipAssetAccessor>(
+                      std::make_shared<CesiumAsync::CachingAssetAccessor>(
+                          spdlog::default_logger(),
+                          std::make_shared<
+                              CesiumDiskCacheMissCountingAssetAccessor>(
+                              createNetworkAssetAccessor()),
+                          getCacheDatabase(),
+                          RequestsPerCachePrune)),
+                  MemoryCacheSizeBytes)));
   return pAssetAccessor;
 }
@@ -0,0 +1,49 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumSampleHeightMostDetailedAsyncAction.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntime.h"
+#include <CesiumAsync/Future.h>
+
+/*static*/ UCesiumSampleHeightMostDetailedAsyncAction*
+UCesiumSampleHeightMostDetailedAsyncAction::SampleHeightMostDetailed(
+    ACesium3DTileset* Tileset,
+    const TArray<FVector>& LongitudeLatitudeHeightArray,
+    double LoadTilesFromHeight) {
+  UCesiumSampleHeightMostDetailedAsyncAction* pAction =
+      NewObject<UCesiumSampleHeightMostDetailedAsyncAction>();
+  pAction->_pTileset = Tileset;
+  pAction->_positions = LongitudeLatitudeHeightArray;
+  pAction->_loadTilesFromHeight = LoadTilesFromHeight;
+  return pAction;
+}
+
+void UCesiumSampleHeightMostDetailedAsyncAction::Activate() {
+  if (!IsValid(this->_pTileset)) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Cannot sample heights without a valid tileset."));
+    TArray<FCesiumSampleHeightResult> result;
+    result.SetNum(this->_positions.Num());
+    for (int32 i = 0; i < result.Num(); ++i) {
+      result[i].LongitudeLatitudeHeight = this->_positions[i];
+    }
+    this->OnHeightsSampled.Broadcast(result);
+    this->SetReadyToDestroy();
+    return;
+  }
+
+  // The action is kept alive until the heights have been sampled, even in
+  // the editor, where there is no game instance to register with.
+  this->AddToRoot();
+  this->_pTileset
+      ->SampleHeightMostDetailedAsync(
+          this->_positions,
+          this->_loadTilesFromHeight)
+      .thenInMainThread([this](TArray<FCesiumSampleHeightResult>&& result) {
+        this->OnHeightsSampled.Broadcast(result);
+        this->RemoveFromRoot();
+        this->SetReadyToDestroy();
+      });
+}
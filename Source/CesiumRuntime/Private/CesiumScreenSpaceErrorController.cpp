@@ -0,0 +1,65 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScreenSpaceErrorController.h"
+#include <algorithm>
+#include <cmath>
+
+void CesiumScreenSpaceErrorController::reset(double screenSpaceError) {
+  this->_screenSpaceError = screenSpaceError;
+  this->_baseExponent = std::log2(std::max(screenSpaceError, 1e-6));
+  this->_integral = 0.0;
+  this->_lastError = 0.0;
+  this->_isCorrecting = false;
+}
+
+double CesiumScreenSpaceErrorController::update(
+    const Settings& settings,
+    double error,
+    double deltaTime) {
+  if (!(deltaTime > 0.0) || !std::isfinite(error)) {
+    return this->_screenSpaceError;
+  }
+
+  const double magnitude = std::abs(error);
+  const bool wasCorrecting = this->_isCorrecting;
+  if (this->_isCorrecting) {
+    this->_isCorrecting = magnitude >= settings.tolerance * 0.5;
+  } else {
+    this->_isCorrecting = magnitude > settings.tolerance;
+  }
+
+  const double correctedError = this->_isCorrecting ? error : 0.0;
+  if (this->_isCorrecting != wasCorrecting) {
+    // Don't let the jump into or out of the tolerance kick the derivative.
+    this->_lastError = correctedError;
+  }
+  const double derivative = (correctedError - this->_lastError) / deltaTime;
+  this->_lastError = correctedError;
+
+  const double minimumExponent =
+      std::log2(std::max(settings.minimumScreenSpaceError, 1e-6));
+  const double maximumExponent = std::max(
+      minimumExponent,
+      std::log2(std::max(settings.maximumScreenSpaceError, 1e-6)));
+
+  // Keep the integral term within the limits, so that it doesn't wind up
+  // while the output can't follow it.
+  this->_integral += correctedError * deltaTime;
+  if (settings.integralGain > 0.0) {
+    this->_integral = std::clamp(
+        this->_integral,
+        (minimumExponent - this->_baseExponent) / settings.integralGain,
+        (maximumExponent - this->_baseExponent) / settings.integralGain);
+  } else {
+    this->_integral = 0.0;
+  }
+
+  const double exponent = this->_baseExponent +
+                          settings.proportionalGain * correctedError +
+                          settings.integralGain * this->_integral +
+                          settings.derivativeGain * derivative;
+
+  this->_screenSpaceError =
+      std::exp2(std::clamp(exponent, minimumExponent, maximumExponent));
+  return this->_screenSpaceError;
+}
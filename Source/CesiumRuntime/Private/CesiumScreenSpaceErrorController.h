@@ -0,0 +1,58 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+/**
+ * A PID controller that adjusts a screen-space error so as to drive a
+ * relative error, such as how far the frame time is above its target, to
+ * zero. The output is computed in powers of two of the screen-space error,
+ * so that a given error changes it by the same factor whatever its value.
+ *
+ * Errors are ignored until their magnitude exceeds the tolerance, and then
+ * corrected until it falls below half of the tolerance, so that noise around
+ * the target doesn't keep changing the level of detail.
+ */
+class CesiumScreenSpaceErrorController {
+public:
+  struct Settings {
+    double minimumScreenSpaceError = 2.0;
+    double maximumScreenSpaceError = 64.0;
+    double tolerance = 0.1;
+    double proportionalGain = 1.0;
+    double integralGain = 0.5;
+    double derivativeGain = 0.0;
+  };
+
+  /**
+   * @brief Starts controlling from the given screen-space error, forgetting
+   * the errors seen so far.
+   */
+  void reset(double screenSpaceError);
+
+  /**
+   * @brief Updates the controller with the latest error.
+   *
+   * @param settings The limits and gains of the controller.
+   * @param error The relative error, which is positive when the screen-space
+   * error should be raised to reduce the load, and negative when it can be
+   * lowered to show more detail.
+   * @param deltaTime The time since the last update, in seconds.
+   * @returns The new screen-space error.
+   */
+  double update(const Settings& settings, double error, double deltaTime);
+
+  double getScreenSpaceError() const { return this->_screenSpaceError; }
+
+  /**
+   * @brief Determines whether the error was outside the tolerance and is
+   * being corrected.
+   */
+  bool isCorrecting() const { return this->_isCorrecting; }
+
+private:
+  double _screenSpaceError = 16.0;
+  double _baseExponent = 4.0;
+  double _integral = 0.0;
+  double _lastError = 0.0;
+  bool _isCorrecting = false;
+};
@@ -0,0 +1,219 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumSelectionTrace.h"
+#include "CesiumRuntime.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include <Cesium3DTilesSelection/ViewUpdateResult.h>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+// "CSTR", and the version of the format.
+constexpr uint32 traceMagic = 0x52545343;
+constexpr uint32 traceVersion = 1;
+
+void serializeVector(FArchive& archive, glm::dvec3& vector) {
+  archive << vector.x << vector.y << vector.z;
+}
+} // namespace
+
+TSharedPtr<CesiumSelectionTrace>
+CesiumSelectionTrace::open(Mode mode, const FString& filename) {
+  IFileManager& fileManager = IFileManager::Get();
+  TUniquePtr<FArchive> pArchive;
+  if (mode == Mode::Record) {
+    fileManager.MakeDirectory(*FPaths::GetPath(filename), true);
+    pArchive.Reset(fileManager.CreateFileWriter(*filename));
+  } else {
+    pArchive.Reset(fileManager.CreateFileReader(*filename));
+  }
+  if (!pArchive) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Could not open the selection trace %s"),
+        *filename);
+    return nullptr;
+  }
+
+  uint32 magic = traceMagic;
+  uint32 version = traceVersion;
+  *pArchive << magic << version;
+  if (magic != traceMagic || version != traceVersion || pArchive->IsError()) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT(
+            "%s is not a selection trace of this version of Cesium for Unreal"),
+        *filename);
+    return nullptr;
+  }
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("%s the tile selection in %s"),
+      mode == Mode::Record ? TEXT("Recording") : TEXT("Replaying"),
+      *filename);
+  return MakeShareable(
+      new CesiumSelectionTrace(mode, filename, MoveTemp(pArchive)));
+}
+
+CesiumSelectionTrace::CesiumSelectionTrace(
+    Mode mode,
+    const FString& filename,
+    TUniquePtr<FArchive>&& pArchive)
+    : _mode(mode), _filename(filename), _pArchive(MoveTemp(pArchive)) {}
+
+CesiumSelectionTrace::~CesiumSelectionTrace() {
+  if (this->_mode == Mode::Replay && this->_pArchive) {
+    this->logSummary();
+  }
+  if (this->_pArchive) {
+    this->_pArchive->Close();
+  }
+}
+
+bool CesiumSelectionTrace::replayViews(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    std::vector<ViewState>& viewStates,
+    float& deltaTime) {
+  check(this->_mode == Mode::Replay);
+  if (!this->_pArchive) {
+    return false;
+  }
+
+  if (this->_pArchive->AtEnd()) {
+    this->logSummary();
+    this->_pArchive.Reset();
+    return false;
+  }
+
+  serialize(*this->_pArchive, this->_frame);
+  if (this->_pArchive->IsError()) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("The selection trace %s is truncated"),
+        *this->_filename);
+    this->logSummary();
+    this->_pArchive.Reset();
+    return false;
+  }
+  this->_hasFrame = true;
+
+  viewStates.clear();
+  viewStates.reserve(this->_frame.views.size());
+  for (const View& view : this->_frame.views) {
+    viewStates.push_back(ViewState::create(
+        view.position,
+        view.direction,
+        view.up,
+        view.viewportSize,
+        view.horizontalFieldOfView,
+        view.verticalFieldOfView,
+        ellipsoid));
+  }
+  deltaTime = this->_frame.deltaTime;
+  return true;
+}
+
+void CesiumSelectionTrace::addFrame(
+    const std::vector<ViewState>& viewStates,
+    float deltaTime,
+    double viewUpdateMilliseconds,
+    const ViewUpdateResult& result,
+    int32 tilesLoaded) {
+  if (!this->_pArchive) {
+    return;
+  }
+
+  Result counts;
+  counts.tilesRendered = int32(result.tilesToRenderThisFrame.size());
+  counts.tilesFadingOut = int32(result.tilesFadingOut.size());
+  counts.workerThreadQueueLength =
+      int32(result.workerThreadTileLoadQueueLength);
+  counts.mainThreadQueueLength = int32(result.mainThreadTileLoadQueueLength);
+  counts.tilesVisited = int32(result.tilesVisited);
+  counts.tilesCulled = int32(result.tilesCulled);
+  counts.maxDepthVisited = int32(result.maxDepthVisited);
+  counts.tilesLoaded = tilesLoaded;
+
+  ++this->_frameCount;
+  this->_replayedMilliseconds += viewUpdateMilliseconds;
+
+  if (this->_mode == Mode::Replay) {
+    if (this->_hasFrame) {
+      this->_recordedMilliseconds += this->_frame.viewUpdateMilliseconds;
+      if (!(counts == this->_frame.result)) {
+        ++this->_mismatchedFrameCount;
+      }
+      this->_hasFrame = false;
+    }
+    return;
+  }
+
+  Frame frame;
+  frame.deltaTime = deltaTime;
+  frame.viewUpdateMilliseconds = viewUpdateMilliseconds;
+  frame.result = counts;
+  frame.views.reserve(viewStates.size());
+  for (const ViewState& viewState : viewStates) {
+    frame.views.push_back(
+        {viewState.getPosition(),
+         viewState.getDirection(),
+         viewState.getUp(),
+         viewState.getViewportSize(),
+         viewState.getHorizontalFieldOfView(),
+         viewState.getVerticalFieldOfView()});
+  }
+  serialize(*this->_pArchive, frame);
+}
+
+bool CesiumSelectionTrace::Result::operator==(const Result& other) const {
+  return tilesRendered == other.tilesRendered &&
+         tilesFadingOut == other.tilesFadingOut &&
+         workerThreadQueueLength == other.workerThreadQueueLength &&
+         mainThreadQueueLength == other.mainThreadQueueLength &&
+         tilesVisited == other.tilesVisited &&
+         tilesCulled == other.tilesCulled &&
+         maxDepthVisited == other.maxDepthVisited &&
+         tilesLoaded == other.tilesLoaded;
+}
+
+void CesiumSelectionTrace::serialize(FArchive& archive, Frame& frame) {
+  archive << frame.deltaTime << frame.viewUpdateMilliseconds;
+
+  int32 viewCount = int32(frame.views.size());
+  archive << viewCount;
+  if (archive.IsLoading()) {
+    frame.views.resize(size_t(FMath::Max(viewCount, 0)));
+  }
+  for (View& view : frame.views) {
+    serializeVector(archive, view.position);
+    serializeVector(archive, view.direction);
+    serializeVector(archive, view.up);
+    archive << view.viewportSize.x << view.viewportSize.y;
+    archive << view.horizontalFieldOfView << view.verticalFieldOfView;
+  }
+
+  Result& result = frame.result;
+  archive << result.tilesRendered << result.tilesFadingOut
+          << result.workerThreadQueueLength << result.mainThreadQueueLength
+          << result.tilesVisited << result.tilesCulled
+          << result.maxDepthVisited << result.tilesLoaded;
+}
+
+void CesiumSelectionTrace::logSummary() const {
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT(
+          "Replayed %d frames of %s: %d selected differently than recorded, %.1f ms in view updates (%.1f ms when recorded)"),
+      this->_frameCount,
+      *this->_filename,
+      this->_mismatchedFrameCount,
+      this->_replayedMilliseconds,
+      this->_recordedMilliseconds);
+}
@@ -0,0 +1,126 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <Cesium3DTilesSelection/ViewState.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class ViewUpdateResult;
+}
+
+/**
+ * A file with the tile selection of each frame of a tileset, so that a
+ * streaming problem can be reproduced exactly, and changes to the scheduling
+ * and budgeting of loads can be profiled against a real trace.
+ *
+ * While recording, each frame adds the view states that were passed to the
+ * view update, the delta time, the time the view update took, the counts of
+ * its result, and the number of tiles loaded so far.
+ *
+ * While replaying, the view states and delta time of each frame are read
+ * back and passed to the view update instead of the tileset's own views, and
+ * the result is compared with the recorded one. Together with a replay of the
+ * request archive, the selection is the same as when it was recorded, with
+ * or without a renderer. A summary is logged at the end of the trace.
+ *
+ * The file is a small header followed by the frames, in the byte order of
+ * the platform that wrote it. All functions must be called from the game
+ * thread.
+ */
+class CesiumSelectionTrace {
+public:
+  enum class Mode { Record, Replay };
+
+  /**
+   * @brief Opens a trace to record or to replay.
+   *
+   * @returns The trace, or nullptr if the file could not be opened, or, when
+   * replaying, is not a selection trace.
+   */
+  static TSharedPtr<CesiumSelectionTrace>
+  open(Mode mode, const FString& filename);
+
+  ~CesiumSelectionTrace();
+
+  Mode getMode() const { return this->_mode; }
+
+  /**
+   * @brief Replaces the view states and delta time of a view update with those
+   * of the next recorded frame.
+   *
+   * @returns false if the trace has no more frames, in which case the summary
+   * of the replay has been logged.
+   */
+  bool replayViews(
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      float& deltaTime);
+
+  /**
+   * @brief Records a view update, or, when replaying, compares its result with
+   * the recorded one.
+   */
+  void addFrame(
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      float deltaTime,
+      double viewUpdateMilliseconds,
+      const Cesium3DTilesSelection::ViewUpdateResult& result,
+      int32 tilesLoaded);
+
+private:
+  struct View {
+    glm::dvec3 position;
+    glm::dvec3 direction;
+    glm::dvec3 up;
+    glm::dvec2 viewportSize;
+    double horizontalFieldOfView;
+    double verticalFieldOfView;
+  };
+
+  struct Result {
+    int32 tilesRendered = 0;
+    int32 tilesFadingOut = 0;
+    int32 workerThreadQueueLength = 0;
+    int32 mainThreadQueueLength = 0;
+    int32 tilesVisited = 0;
+    int32 tilesCulled = 0;
+    int32 maxDepthVisited = 0;
+    int32 tilesLoaded = 0;
+
+    bool operator==(const Result& other) const;
+  };
+
+  struct Frame {
+    float deltaTime = 0.0f;
+    double viewUpdateMilliseconds = 0.0;
+    std::vector<View> views;
+    Result result;
+  };
+
+  CesiumSelectionTrace(
+      Mode mode,
+      const FString& filename,
+      TUniquePtr<FArchive>&& pArchive);
+
+  static void serialize(FArchive& archive, Frame& frame);
+  void logSummary() const;
+
+  Mode _mode;
+  FString _filename;
+  TUniquePtr<FArchive> _pArchive;
+
+  // The last frame that was read, while replaying.
+  Frame _frame;
+  bool _hasFrame = false;
+
+  int32 _frameCount = 0;
+  int32 _mismatchedFrameCount = 0;
+  double _recordedMilliseconds = 0.0;
+  double _replayedMilliseconds = 0.0;
+};
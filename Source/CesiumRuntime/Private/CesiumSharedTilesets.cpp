@@ -0,0 +1,88 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumSharedTilesets.h"
+#include "Cesium3DTileset.h"
+#include "CesiumIonServer.h"
+#include "Engine/World.h"
+
+namespace CesiumSharedTilesets {
+
+namespace {
+// The shared tilesets, in the order they were added.
+TArray<TWeakObjectPtr<ACesium3DTileset>> tilesets;
+FDelegateHandle worldCleanupHandle;
+
+/**
+ * Identifies the tiles that a tileset loads, regardless of its other
+ * settings.
+ */
+FString getSourceKey(const ACesium3DTileset& tileset) {
+  switch (tileset.GetTilesetSource()) {
+  case ETilesetSource::FromCesiumIon: {
+    const UCesiumIonServer* pServer = tileset.GetCesiumIonServer();
+    return FString::Printf(
+        TEXT("ion:%s:%lld"),
+        pServer ? *pServer->GetPathName() : TEXT(""),
+        tileset.GetIonAssetID());
+  }
+  case ETilesetSource::FromUrl:
+    return TEXT("url:") + tileset.GetUrl();
+  case ETilesetSource::FromLocalPackage:
+    return TEXT("package:") + tileset.GetLocalPackageFilename();
+  }
+  return FString();
+}
+
+bool isShared(const ACesium3DTileset* pTileset) {
+  return IsValid(pTileset) && pTileset->ShareTilesAcrossWorlds &&
+         !IsValid(pTileset->LinkedTileset);
+}
+
+void onWorldCleanup(
+    UWorld* pWorld,
+    bool bSessionEnded,
+    bool bCleanupResources) {
+  tilesets.RemoveAll([pWorld](const TWeakObjectPtr<ACesium3DTileset>& pWeak) {
+    const ACesium3DTileset* pTileset = pWeak.Get();
+    return !pTileset || pTileset->GetWorld() == pWorld;
+  });
+
+  for (const TWeakObjectPtr<ACesium3DTileset>& pWeak : tilesets) {
+    ACesium3DTileset* pTileset = pWeak.Get();
+    if (pTileset) {
+      pTileset->ReleaseTilesSharedFromWorld(pWorld);
+    }
+  }
+}
+} // namespace
+
+ACesium3DTileset* findSource(const ACesium3DTileset& tileset) {
+  check(IsInGameThread());
+
+  if (!worldCleanupHandle.IsValid()) {
+    worldCleanupHandle =
+        FWorldDelegates::OnWorldCleanup.AddStatic(&onWorldCleanup);
+  }
+
+  tilesets.RemoveAll([](const TWeakObjectPtr<ACesium3DTileset>& pWeak) {
+    return !pWeak.IsValid();
+  });
+
+  ACesium3DTileset* pTileset = const_cast<ACesium3DTileset*>(&tileset);
+  tilesets.AddUnique(pTileset);
+
+  const FString key = getSourceKey(tileset);
+  for (const TWeakObjectPtr<ACesium3DTileset>& pWeak : tilesets) {
+    ACesium3DTileset* pCandidate = pWeak.Get();
+    if (pCandidate == pTileset) {
+      return nullptr;
+    }
+    if (isShared(pCandidate) && getSourceKey(*pCandidate) == key) {
+      return pCandidate;
+    }
+  }
+
+  return nullptr;
+}
+
+} // namespace CesiumSharedTilesets
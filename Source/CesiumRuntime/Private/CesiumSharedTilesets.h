@@ -0,0 +1,33 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ACesium3DTileset;
+
+/**
+ * The tilesets of all worlds of the process that share their tiles with the
+ * tilesets that load the same tiles, because Share Tiles Across Worlds is set.
+ *
+ * Of the tilesets with the same source, the one that asked first is the one
+ * that loads the tiles. The others are linked to it, like a tileset with a
+ * Linked Tileset, and show copies of its tiles that use the same meshes,
+ * textures, and collision meshes. So each world only has its own components.
+ *
+ * When a world is cleaned up, the copies of the tiles of its tilesets are
+ * destroyed in the other worlds, so that they don't keep it from being
+ * garbage collected, and another tileset then loads the tiles.
+ *
+ * All functions must be called from the game thread.
+ */
+namespace CesiumSharedTilesets {
+
+/**
+ * @brief Gets the tileset whose tiles the given tileset shares, or nullptr if
+ * it loads them itself. The tileset is added to the shared tilesets if it
+ * wasn't already.
+ */
+ACesium3DTileset* findSource(const ACesium3DTileset& tileset);
+
+} // namespace CesiumSharedTilesets
@@ -0,0 +1,189 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStats.h"
+#include "CesiumLifetime.h"
+#include "CesiumTilesetStatistics.h"
+#include "CesiumTrace.h"
+#include "Engine/Engine.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include <atomic>
+
+DEFINE_STAT(STAT_CesiumTilesetTick);
+DEFINE_STAT(STAT_CesiumTileCreation);
+DEFINE_STAT(STAT_CesiumAmortizedDestruction);
+
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Tiles Rendered"),
+    STAT_CesiumTilesRendered,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Tiles Visited"),
+    STAT_CesiumTilesVisited,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Tiles Loading"),
+    STAT_CesiumTilesLoading,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Main Thread Queue"),
+    STAT_CesiumMainThreadQueue,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("HTTP Requests Pending"),
+    STAT_CesiumRequestsPending,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("HTTP Requests In Flight"),
+    STAT_CesiumRequestsInFlight,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Destruction Backlog"),
+    STAT_CesiumDestructionBacklog,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_ACCUMULATOR_STAT(
+    TEXT("Cache Hit Rate %"),
+    STAT_CesiumCacheHitRate,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Texture Memory"),
+    STAT_CesiumTextureMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Mesh Memory"),
+    STAT_CesiumMeshMemory,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Destruction Backlog Memory"),
+    STAT_CesiumDestructionBacklogMemory,
+    STATGROUP_Cesium);
+
+CSV_DEFINE_CATEGORY(Cesium, true);
+
+namespace CesiumStats {
+
+namespace {
+
+// The counters of each tileset, by tileset. Only used in the game thread.
+TMap<const void*, TilesetStats> tilesets;
+
+std::atomic<int32> pendingRequests(0);
+std::atomic<int32> activeRequests(0);
+
+float toMegabytes(int64 bytes) { return float(double(bytes) / (1024 * 1024)); }
+
+void publishTilesets() {
+  TilesetStats total;
+  for (const TPair<const void*, TilesetStats>& pair : tilesets) {
+    total.tilesRendered += pair.Value.tilesRendered;
+    total.tilesVisited += pair.Value.tilesVisited;
+    total.workerThreadQueueLength += pair.Value.workerThreadQueueLength;
+    total.mainThreadQueueLength += pair.Value.mainThreadQueueLength;
+    total.textureBytes += pair.Value.textureBytes;
+    total.meshBytes += pair.Value.meshBytes;
+  }
+
+  SET_DWORD_STAT(STAT_CesiumTilesRendered, total.tilesRendered);
+  SET_DWORD_STAT(STAT_CesiumTilesVisited, total.tilesVisited);
+  SET_DWORD_STAT(STAT_CesiumTilesLoading, total.workerThreadQueueLength);
+  SET_DWORD_STAT(STAT_CesiumMainThreadQueue, total.mainThreadQueueLength);
+  SET_MEMORY_STAT(STAT_CesiumTextureMemory, total.textureBytes);
+  SET_MEMORY_STAT(STAT_CesiumMeshMemory, total.meshBytes);
+
+  CSV_CUSTOM_STAT(
+      Cesium,
+      TilesRendered,
+      total.tilesRendered,
+      ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      TilesVisited,
+      total.tilesVisited,
+      ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      TilesLoading,
+      total.workerThreadQueueLength,
+      ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      MainThreadQueue,
+      total.mainThreadQueueLength,
+      ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      TextureMB,
+      toMegabytes(total.textureBytes),
+      ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      MeshMB,
+      toMegabytes(total.meshBytes),
+      ECsvCustomStatOp::Set);
+}
+
+} // namespace
+
+void updateTileset(const void* pTileset, const TilesetStats& stats) {
+  tilesets.Add(pTileset, stats);
+  publishTilesets();
+}
+
+TilesetStats getTileset(const void* pTileset) {
+  const TilesetStats* pStats = tilesets.Find(pTileset);
+  return pStats ? *pStats : TilesetStats();
+}
+
+void removeTileset(const void* pTileset) {
+  if (tilesets.Remove(pTileset) > 0) {
+    publishTilesets();
+  }
+}
+
+void updateRequestQueue(int32 pendingChange, int32 activeChange) {
+  const int32 pending =
+      pendingRequests.fetch_add(pendingChange) + pendingChange;
+  const int32 active = activeRequests.fetch_add(activeChange) + activeChange;
+  CesiumTrace::traceRequestQueue(pending, active);
+}
+
+void updateFrame() {
+  const int32 pending = pendingRequests;
+  const int32 active = activeRequests;
+
+  // The share of cache lookups that did not need a network request, since
+  // the statistics were last reset.
+  float hitRate = 0.0f;
+  const UCesiumTilesetStatistics* pStatistics =
+      GEngine ? GEngine->GetEngineSubsystem<UCesiumTilesetStatistics>()
+              : nullptr;
+  if (pStatistics) {
+    const FCesiumRequestCacheStatistics cache =
+        pStatistics->GetCacheStatistics();
+    const int64 lookups = cache.MemoryHits + cache.MemoryMisses;
+    if (lookups > 0) {
+      hitRate = float(
+          100.0 * double(cache.MemoryHits + cache.DiskHits) / double(lookups));
+    }
+  }
+
+  const int32 backlog = CesiumLifetime::getPendingDestructionCount();
+  const int64 backlogBytes = CesiumLifetime::getPendingDestructionBytes();
+
+  SET_DWORD_STAT(STAT_CesiumRequestsPending, pending);
+  SET_DWORD_STAT(STAT_CesiumRequestsInFlight, active);
+  SET_FLOAT_STAT(STAT_CesiumCacheHitRate, hitRate);
+  SET_DWORD_STAT(STAT_CesiumDestructionBacklog, backlog);
+  SET_MEMORY_STAT(STAT_CesiumDestructionBacklogMemory, backlogBytes);
+
+  CSV_CUSTOM_STAT(Cesium, RequestsPending, pending, ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(Cesium, RequestsInFlight, active, ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(Cesium, CacheHitRate, hitRate, ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(Cesium, DestructionBacklog, backlog, ECsvCustomStatOp::Set);
+  CSV_CUSTOM_STAT(
+      Cesium,
+      DestructionBacklogMB,
+      toMegabytes(backlogBytes),
+      ECsvCustomStatOp::Set);
+}
+
+} // namespace CesiumStats
@@ -0,0 +1,77 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+
+/**
+ * The stat group of the live counters of the tile pipeline, for all tilesets,
+ * shown with `stat Cesium`. The same counters are written to the `Cesium`
+ * category of CSV profiler captures. Both are available in Development and
+ * Test builds, as well as in the Editor.
+ */
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(
+    TEXT("Tileset Tick"),
+    STAT_CesiumTilesetTick,
+    STATGROUP_Cesium, );
+DECLARE_CYCLE_STAT_EXTERN(
+    TEXT("Tile Creation"),
+    STAT_CesiumTileCreation,
+    STATGROUP_Cesium, );
+DECLARE_CYCLE_STAT_EXTERN(
+    TEXT("Amortized Destruction"),
+    STAT_CesiumAmortizedDestruction,
+    STATGROUP_Cesium, );
+
+namespace CesiumStats {
+
+/**
+ * The counters of a single tileset, from its most recent view update.
+ */
+struct TilesetStats {
+  int32 tilesRendered = 0;
+  int32 tilesVisited = 0;
+  int32 workerThreadQueueLength = 0;
+  int32 mainThreadQueueLength = 0;
+  int64 textureBytes = 0;
+  int64 meshBytes = 0;
+};
+
+/**
+ * Updates the counters of a tileset, and the stats that add up the counters
+ * of all tilesets. Only called from the game thread.
+ *
+ * @param pTileset The tileset whose counters these are.
+ * @param stats Its counters.
+ */
+void updateTileset(const void* pTileset, const TilesetStats& stats);
+
+/**
+ * Gets the counters of a tileset from its most recent view update, or zeros
+ * if it has not updated its view yet. Only called from the game thread.
+ */
+TilesetStats getTileset(const void* pTileset);
+
+/**
+ * Forgets the counters of a tileset that is being destroyed.
+ */
+void removeTileset(const void* pTileset);
+
+/**
+ * Updates the number of network requests that are waiting to be sent and
+ * that are in flight. It may be called from any thread.
+ */
+void updateRequestQueue(int32 pendingChange, int32 activeChange);
+
+/**
+ * Updates the stats that are not specific to a tileset: the network
+ * requests, the hit rate of the request cache, and the backlog of the
+ * amortized destruction. Called by the runtime module at the end of each
+ * frame, from the game thread.
+ */
+void updateFrame();
+
+} // namespace CesiumStats
@@ -0,0 +1,217 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStreamingGovernor.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "UnrealTaskProcessor.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+/**
+ * The time between two readings of the battery, which can be slow on some
+ * platforms.
+ */
+constexpr double PollSeconds = 1.0;
+
+/**
+ * The time constant with which the pressure rises towards that of the device.
+ */
+constexpr double RiseSeconds = 2.0;
+
+/**
+ * The time constant with which the pressure falls towards that of the device.
+ */
+constexpr double FallSeconds = 30.0;
+
+/**
+ * The pressure above which physics meshes are deferred, and the pressure
+ * below which they are created again.
+ */
+constexpr double DeferPhysicsMeshesPressure = 0.5;
+constexpr double ResumePhysicsMeshesPressure = 0.25;
+
+/**
+ * The pressure of the low power mode, in which the operating system already
+ * throttles the device.
+ */
+constexpr double LowPowerModePressure = 0.5;
+
+struct Governor {
+  // The thermal state and low power mode, reported from any thread.
+  std::atomic<double> thermalLevel{0.0};
+  std::atomic<bool> isLowPowerMode{false};
+  std::atomic<bool> deferPhysicsMeshes{false};
+
+  // Everything else is only used in the game thread.
+  bool isRegistered = false;
+  CesiumStreamingGovernor::DeviceState state;
+  double lastPolled = 0.0;
+  double lastUpdated = 0.0;
+  double pressure = 0.0;
+  int32 activeThreads = 0;
+  uint64 lastUpdatedFrame = 0;
+};
+
+Governor& getGovernor() {
+  static Governor governor;
+  return governor;
+}
+
+template <typename TSeverity> double getThermalLevel(TSeverity severity) {
+  if (severity == ETemperatureSeverity::Critical) {
+    return 1.0;
+  }
+  if (severity == ETemperatureSeverity::Serious) {
+    return 2.0 / 3.0;
+  }
+  if (severity == ETemperatureSeverity::Bad) {
+    return 1.0 / 3.0;
+  }
+  return 0.0;
+}
+
+void registerDelegates(Governor& governor) {
+  if (governor.isRegistered) {
+    return;
+  }
+  governor.isRegistered = true;
+
+  // The thermal state and low power mode are only reported as they change,
+  // so the delegates are never removed.
+  FCoreDelegates::OnTemperatureChange.AddLambda([](auto severity) {
+    getGovernor().thermalLevel = getThermalLevel(severity);
+  });
+  FCoreDelegates::OnLowPowerMode.AddLambda([](bool isLowPowerMode) {
+    getGovernor().isLowPowerMode = isLowPowerMode;
+  });
+}
+
+/**
+ * Lets as many dedicated task threads run as the load scale allows.
+ */
+void updateActiveThreads(Governor& governor, double loadScale) {
+  UnrealTaskProcessor& taskProcessor = *getTaskProcessor();
+  const int32 threadCount = taskProcessor.getDedicatedThreadCount();
+  if (threadCount == 0) {
+    return;
+  }
+
+  const int32 activeThreads = FMath::Clamp(
+      int32(std::ceil(double(threadCount) * loadScale)),
+      1,
+      threadCount);
+  if (activeThreads != governor.activeThreads) {
+    governor.activeThreads = activeThreads;
+    taskProcessor.setActiveDedicatedThreadCount(activeThreads);
+  }
+}
+
+} // namespace
+
+namespace CesiumStreamingGovernor {
+
+double computePressure(const DeviceState& state, int32 batteryThreshold) {
+  double pressure = FMath::Clamp(state.thermalLevel, 0.0, 1.0);
+  if (state.isLowPowerMode) {
+    pressure = std::max(pressure, LowPowerModePressure);
+  }
+  if (state.isRunningOnBattery && state.batteryLevel >= 0 &&
+      state.batteryLevel < batteryThreshold) {
+    pressure = std::max(
+        pressure,
+        double(batteryThreshold - state.batteryLevel) /
+            double(batteryThreshold));
+  }
+  return std::min(pressure, 1.0);
+}
+
+bool isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->EnableStreamingGovernor;
+}
+
+void update() {
+  check(IsInGameThread());
+
+  Governor& governor = getGovernor();
+  if (governor.lastUpdatedFrame == GFrameCounter) {
+    return;
+  }
+  governor.lastUpdatedFrame = GFrameCounter;
+
+  const double now = FPlatformTime::Seconds();
+  const double deltaTime =
+      governor.lastUpdated > 0.0 ? now - governor.lastUpdated : 0.0;
+  governor.lastUpdated = now;
+
+  if (!isEnabled()) {
+    governor.pressure = 0.0;
+    governor.deferPhysicsMeshes = false;
+    if (governor.activeThreads != 0) {
+      updateActiveThreads(governor, 1.0);
+    }
+    return;
+  }
+
+  registerDelegates(governor);
+
+  if (now - governor.lastPolled >= PollSeconds) {
+    governor.lastPolled = now;
+    governor.state.isRunningOnBattery = FPlatformMisc::IsRunningOnBattery();
+    governor.state.batteryLevel = FPlatformMisc::GetBatteryLevel();
+  }
+  governor.state.thermalLevel = governor.thermalLevel;
+  governor.state.isLowPowerMode = governor.isLowPowerMode;
+
+  const double target = computePressure(
+      governor.state,
+      GetDefault<UCesiumRuntimeSettings>()->StreamingGovernorBatteryThreshold);
+  const double timeConstant =
+      target > governor.pressure ? RiseSeconds : FallSeconds;
+  governor.pressure += (target - governor.pressure) *
+                       (1.0 - std::exp(-deltaTime / timeConstant));
+
+  if (governor.pressure >= DeferPhysicsMeshesPressure) {
+    governor.deferPhysicsMeshes = true;
+  } else if (governor.pressure < ResumePhysicsMeshesPressure) {
+    governor.deferPhysicsMeshes = false;
+  }
+
+  updateActiveThreads(governor, getLoadScale());
+}
+
+double getPressure() {
+  check(IsInGameThread());
+  return isEnabled() ? getGovernor().pressure : 0.0;
+}
+
+double getLoadScale() {
+  const double minimum = FMath::Clamp(
+      double(GetDefault<UCesiumRuntimeSettings>()
+                 ->StreamingGovernorMinimumLoadFraction),
+      0.0,
+      1.0);
+  return 1.0 - getPressure() * (1.0 - minimum);
+}
+
+double getScreenSpaceErrorScale() {
+  const double maximum = std::max(
+      double(GetDefault<UCesiumRuntimeSettings>()
+                 ->StreamingGovernorMaximumScreenSpaceErrorScale),
+      1.0);
+  return 1.0 + getPressure() * (maximum - 1.0);
+}
+
+bool shouldDeferPhysicsMeshes() {
+  return isEnabled() &&
+         GetDefault<UCesiumRuntimeSettings>()
+             ->StreamingGovernorDefersPhysicsMeshes &&
+         getGovernor().deferPhysicsMeshes;
+}
+
+} // namespace CesiumStreamingGovernor
@@ -0,0 +1,94 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Scales down the streaming work of the tilesets while the device is hot or
+ * its battery is low, when the Streaming Governor is enabled in the Cesium
+ * runtime settings, so that mobile and XR sessions don't end up throttled by
+ * the operating system.
+ *
+ * The thermal state and low power mode reported by the platform, and the
+ * battery level while the device runs on battery, are combined into a
+ * pressure between zero and one. The pressure rises within seconds and falls
+ * over half a minute, so that a device isn't heated up again as soon as it
+ * has cooled down. As it rises, fewer tile loads and dedicated task threads
+ * are allowed, the Maximum Screen Space Error of the tilesets is raised, and
+ * above one half the physics meshes of newly-loaded tiles are deferred until
+ * the pressure drops again.
+ */
+namespace CesiumStreamingGovernor {
+
+/**
+ * @brief The state of the device that the pressure is computed from.
+ */
+struct DeviceState {
+  /**
+   * @brief The thermal state, from zero when the device is at a normal
+   * temperature or its temperature is unknown, to one when it is at its
+   * critical temperature.
+   */
+  double thermalLevel = 0.0;
+
+  /** @brief Whether the operating system is in low power mode. */
+  bool isLowPowerMode = false;
+
+  /** @brief Whether the device runs on its battery. */
+  bool isRunningOnBattery = false;
+
+  /** @brief The battery level in percent, or -1 if it is unknown. */
+  int32 batteryLevel = -1;
+};
+
+/**
+ * @brief Computes the pressure, between zero and one, that the device is
+ * under.
+ *
+ * @param state The state of the device.
+ * @param batteryThreshold The battery level, in percent, below which the
+ * battery adds to the pressure. The pressure from the battery grows to one
+ * as the battery level drops to zero.
+ */
+double computePressure(const DeviceState& state, int32 batteryThreshold);
+
+/**
+ * @brief Gets whether the streaming work is governed. May be called from any
+ * thread.
+ */
+bool isEnabled();
+
+/**
+ * @brief Reads the state of the device and updates the pressure and the
+ * number of active dedicated task threads. Only the first call in a frame
+ * has an effect. Must be called from the game thread.
+ */
+void update();
+
+/**
+ * @brief Gets the smoothed pressure, between zero and one, that the device is
+ * under. Must be called from the game thread.
+ */
+double getPressure();
+
+/**
+ * @brief Gets the factor, at most one, by which the number of simultaneous
+ * tile loads and of active dedicated task threads are scaled. Must be called
+ * from the game thread.
+ */
+double getLoadScale();
+
+/**
+ * @brief Gets the factor, at least one, by which the Maximum Screen Space
+ * Error of the tilesets is scaled. Must be called from the game thread.
+ */
+double getScreenSpaceErrorScale();
+
+/**
+ * @brief Gets whether the physics meshes of the tiles that are loaded now are
+ * deferred. May be called from any thread.
+ */
+bool shouldDeferPhysicsMeshes();
+
+} // namespace CesiumStreamingGovernor
@@ -31,6 +31,7 @@ double UCesiumSubLevelComponent::GetOriginLongitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLongitude(double value) {
   this->OriginLongitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -40,6 +41,7 @@ double UCesiumSubLevelComponent::GetOriginLatitude() const {
 
 void UCesiumSubLevelComponent::SetOriginLatitude(double value) {
   this->OriginLatitude = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -49,6 +51,7 @@ double UCesiumSubLevelComponent::GetOriginHeight() const {
 
 void UCesiumSubLevelComponent::SetOriginHeight(double value) {
   this->OriginHeight = value;
+  this->_invalidateSwitcherIndex();
   this->UpdateGeoreferenceIfSubLevelIsActive();
 }
 
@@ -58,6 +61,7 @@ double UCesiumSubLevelComponent::GetLoadRadius() const {
 
 void UCesiumSubLevelComponent::SetLoadRadius(double value) {
   this->LoadRadius = value;
+  this->_invalidateSwitcherIndex();
 }
 
 TSoftObjectPtr<ACesiumGeoreference>
@@ -115,6 +119,7 @@ void UCesiumSubLevelComponent::SetOriginLongitudeLatitudeHeight(
     this->OriginLongitude = longitudeLatitudeHeight.X;
     this->OriginLatitude = longitudeLatitudeHeight.Y;
     this->OriginHeight = longitudeLatitudeHeight.Z;
+    this->_invalidateSwitcherIndex();
     this->UpdateGeoreferenceIfSubLevelIsActive();
   }
 }
@@ -448,7 +453,12 @@ void UCesiumSubLevelComponent::PostEditChangeProperty(
           GET_MEMBER_NAME_CHECKED(UCesiumSubLevelComponent, OriginLatitude) ||
       propertyName ==
           GET_MEMBER_NAME_CHECKED(UCesiumSubLevelComponent, OriginHeight)) {
+    this->_invalidateSwitcherIndex();
     this->UpdateGeoreferenceIfSubLevelIsActive();
+  } else if (
+      propertyName ==
+      GET_MEMBER_NAME_CHECKED(UCesiumSubLevelComponent, LoadRadius)) {
+    this->_invalidateSwitcherIndex();
   }
 }
 
@@ -556,6 +566,12 @@ UCesiumSubLevelComponent::_getSwitcher() noexcept {
       ->FindComponentByClass<UCesiumSubLevelSwitcherComponent>();
 }
 
+void UCesiumSubLevelComponent::_invalidateSwitcherIndex() noexcept {
+  UCesiumSubLevelSwitcherComponent* pSwitcher = this->_getSwitcher();
+  if (pSwitcher)
+    pSwitcher->_invalidateSubLevelIndex();
+}
+
 ALevelInstance* UCesiumSubLevelComponent::_getLevelInstance() const noexcept {
   ALevelInstance* pOwner = Cast<ALevelInstance>(this->GetOwner());
   if (!pOwner) {
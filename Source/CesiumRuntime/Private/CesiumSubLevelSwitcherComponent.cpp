@@ -2,6 +2,7 @@
 
 #include "CesiumSubLevelSwitcherComponent.h"
 #include "CesiumCommon.h"
+#include "CesiumEllipsoid.h"
 #include "CesiumRuntime.h"
 #include "CesiumSubLevelComponent.h"
 #include "Engine/LevelStreaming.h"
@@ -28,6 +29,17 @@ FString GetActorLabel(AActor* pActor) {
 #endif
 }
 
+// The smallest size of the cells of the grid of sub-level origins, in meters,
+// so that sub-levels with tiny Load Radius don't make for a huge grid.
+constexpr double MinimumIndexCellSize = 1000.0;
+
+FIntVector getIndexCell(const FVector& position, double cellSize) {
+  return FIntVector(
+      FMath::FloorToInt32(position.X / cellSize),
+      FMath::FloorToInt32(position.Y / cellSize),
+      FMath::FloorToInt32(position.Z / cellSize));
+}
+
 } // namespace
 
 UCesiumSubLevelSwitcherComponent::UCesiumSubLevelSwitcherComponent() {
@@ -37,6 +49,7 @@ UCesiumSubLevelSwitcherComponent::UCesiumSubLevelSwitcherComponent() {
 void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.AddUnique(pSubLevel);
+  this->_invalidateSubLevelIndex();
 
   // Do extra checks on the next tick so that if we're in a game and this level
   // is already loaded and shouldn't be, we can unload it.
@@ -56,6 +69,7 @@ void UCesiumSubLevelSwitcherComponent::RegisterSubLevel(
 void UCesiumSubLevelSwitcherComponent::UnregisterSubLevel(
     ALevelInstance* pSubLevel) noexcept {
   this->_sublevels.Remove(pSubLevel);
+  this->_invalidateSubLevelIndex();
 
   // Next tick, we need to check if the target is still registered, in case this
   // method call just removed it. But we can't actually do the check here
@@ -105,6 +119,86 @@ void UCesiumSubLevelSwitcherComponent::SetTargetSubLevel(
   }
 }
 
+ALevelInstance*
+UCesiumSubLevelSwitcherComponent::GetPreloadSubLevel() const noexcept {
+  return this->_pPreload.Get();
+}
+
+void UCesiumSubLevelSwitcherComponent::SetPreloadSubLevel(
+    ALevelInstance* pLevelInstance) noexcept {
+  if (this->_pPreload != pLevelInstance) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("New preload sub-level %s."),
+        *GetActorLabel(pLevelInstance));
+    this->_pPreload = pLevelInstance;
+  }
+}
+
+void UCesiumSubLevelSwitcherComponent::FindSubLevelsNear(
+    UCesiumEllipsoid& Ellipsoid,
+    const FVector& Position,
+    double ExtraDistance,
+    TArray<SubLevelInRange>& Result) {
+  Result.Reset();
+
+  if (!this->_indexIsValid || this->_pIndexEllipsoid != &Ellipsoid) {
+    this->_buildSubLevelIndex(Ellipsoid);
+  }
+
+  if (this->_indexedSubLevels.IsEmpty()) {
+    return;
+  }
+
+  auto test = [&Position, ExtraDistance, &Result](
+                  const IndexedSubLevel& indexed) {
+    ALevelInstance* pSubLevel = indexed.pSubLevel.Get();
+    const UCesiumSubLevelComponent* pComponent = indexed.pComponent.Get();
+    if (!IsValid(pSubLevel) || !IsValid(pComponent) ||
+        !pComponent->GetEnabled()) {
+      return;
+    }
+
+    const double distance = FVector::Distance(indexed.position, Position);
+    if (distance < indexed.loadRadius + ExtraDistance) {
+      Result.Add({pSubLevel, distance, indexed.loadRadius});
+    }
+  };
+
+  // Look in the cells that may hold an origin within range. If there are more
+  // of those than sub-levels, it's quicker to look at every sub-level.
+  const double range =
+      this->_indexMaximumLoadRadius + FMath::Max(ExtraDistance, 0.0);
+  const int64 cellsPerAxis =
+      2 * int64(FMath::CeilToDouble(range / this->_indexCellSize)) + 1;
+  if (cellsPerAxis * cellsPerAxis * cellsPerAxis >
+      this->_indexedSubLevels.Num()) {
+    for (const IndexedSubLevel& indexed : this->_indexedSubLevels) {
+      test(indexed);
+    }
+    return;
+  }
+
+  const FIntVector minimum =
+      getIndexCell(Position - FVector(range), this->_indexCellSize);
+  const FIntVector maximum =
+      getIndexCell(Position + FVector(range), this->_indexCellSize);
+  for (int32 x = minimum.X; x <= maximum.X; ++x) {
+    for (int32 y = minimum.Y; y <= maximum.Y; ++y) {
+      for (int32 z = minimum.Z; z <= maximum.Z; ++z) {
+        const TArray<int32>* pCell =
+            this->_indexCells.Find(FIntVector(x, y, z));
+        if (pCell) {
+          for (int32 i : *pCell) {
+            test(this->_indexedSubLevels[i]);
+          }
+        }
+      }
+    }
+  }
+}
+
 void UCesiumSubLevelSwitcherComponent::TickComponent(
     float DeltaTime,
     enum ELevelTick TickType,
@@ -129,7 +223,8 @@ void UCesiumSubLevelSwitcherComponent::TickComponent(
         if (!IsValid(pSubLevel))
           continue;
 
-        if (pSubLevel == this->_pCurrent || pSubLevel == this->_pTarget)
+        if (pSubLevel == this->_pCurrent || pSubLevel == this->_pTarget ||
+            pSubLevel == this->_pPreload)
           continue;
 
         ULevelStreaming* pStreaming =
@@ -177,6 +272,7 @@ void UCesiumSubLevelSwitcherComponent::TickComponent(
 #endif
 
   this->_updateSubLevelStateGame();
+  this->_updatePreloadedSubLevelGame();
 }
 
 void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
@@ -210,40 +306,63 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
       this->_pCurrent->UnloadLevelInstance();
     }
 
-    switch (state) {
-    case ELevelStreamingState::Loading:
-    case ELevelStreamingState::MakingInvisible:
-    case ELevelStreamingState::MakingVisible:
-      // Wait for these transitions to finish before doing anything further.
-      // TODO: maybe we can cancel these transitions somehow?
-      UE_LOG(
-          LogCesium,
-          Log,
-          TEXT(
-              "Waiting for sub-level %s to transition out of an intermediate state while unloading it."),
-          *GetActorLabel(this->_pCurrent.Get()));
-      this->_isTransitioningSubLevels = true;
-      break;
-    case ELevelStreamingState::FailedToLoad:
-    case ELevelStreamingState::LoadedNotVisible:
-    case ELevelStreamingState::LoadedVisible:
-      UE_LOG(
-          LogCesium,
-          Display,
-          TEXT("Starting unload of sub-level %s."),
-          *GetActorLabel(this->_pCurrent.Get()));
-      this->_isTransitioningSubLevels = true;
-      this->_pCurrent->UnloadLevelInstance();
-      break;
-    case ELevelStreamingState::Removed:
-    case ELevelStreamingState::Unloaded:
-      UE_LOG(
-          LogCesium,
-          Display,
-          TEXT("Finished unloading sub-level %s."),
-          *GetActorLabel(this->_pCurrent.Get()));
-      this->_pCurrent = nullptr;
-      break;
+    if (IsValid(pStreaming) && this->_pCurrent == this->_pPreload &&
+        (state == ELevelStreamingState::LoadedVisible ||
+         state == ELevelStreamingState::LoadedNotVisible)) {
+      // The sub-level is still close enough to preload, so only hide it.
+      if (state == ELevelStreamingState::LoadedVisible) {
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT("Hiding sub-level %s, which stays loaded."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_isTransitioningSubLevels = true;
+        pStreaming->SetShouldBeVisible(false);
+      } else {
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT("Finished hiding sub-level %s."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_pPreloaded = this->_pCurrent;
+        this->_pCurrent = nullptr;
+      }
+    } else {
+      switch (state) {
+      case ELevelStreamingState::Loading:
+      case ELevelStreamingState::MakingInvisible:
+      case ELevelStreamingState::MakingVisible:
+        // Wait for these transitions to finish before doing anything further.
+        // TODO: maybe we can cancel these transitions somehow?
+        UE_LOG(
+            LogCesium,
+            Log,
+            TEXT(
+                "Waiting for sub-level %s to transition out of an intermediate state while unloading it."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_isTransitioningSubLevels = true;
+        break;
+      case ELevelStreamingState::FailedToLoad:
+      case ELevelStreamingState::LoadedNotVisible:
+      case ELevelStreamingState::LoadedVisible:
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT("Starting unload of sub-level %s."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_isTransitioningSubLevels = true;
+        this->_pCurrent->UnloadLevelInstance();
+        break;
+      case ELevelStreamingState::Removed:
+      case ELevelStreamingState::Unloaded:
+        UE_LOG(
+            LogCesium,
+            Display,
+            TEXT("Finished unloading sub-level %s."),
+            *GetActorLabel(this->_pCurrent.Get()));
+        this->_pCurrent = nullptr;
+        break;
+      }
     }
   }
 
@@ -272,6 +391,19 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
       state = ELevelStreamingState::FailedToLoad;
     }
 
+    if (state == ELevelStreamingState::LoadedNotVisible &&
+        IsValid(pStreaming) && !pStreaming->ShouldBeVisible()) {
+      // The target was preloaded, so it only needs to be shown.
+      UE_LOG(
+          LogCesium,
+          Display,
+          TEXT("Showing preloaded sub-level %s."),
+          *GetActorLabel(this->_pTarget.Get()));
+      this->_isTransitioningSubLevels = true;
+      pStreaming->SetShouldBeVisible(true);
+      return;
+    }
+
     switch (state) {
     case ELevelStreamingState::Loading:
     case ELevelStreamingState::MakingInvisible:
@@ -319,6 +451,109 @@ void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateGame() {
   }
 }
 
+void UCesiumSubLevelSwitcherComponent::_updatePreloadedSubLevelGame() {
+  ALevelInstance* pPreload = this->_pPreload.Get();
+  if (pPreload == this->_pCurrent || pPreload == this->_pTarget) {
+    // The sub-level is, or is becoming, the active one, so it's loaded and
+    // shown like any other.
+    pPreload = nullptr;
+  }
+
+  if (this->_pPreloaded != pPreload) {
+    ALevelInstance* pPrevious = this->_pPreloaded.Get();
+    if (IsValid(pPrevious) && pPrevious != this->_pCurrent &&
+        pPrevious != this->_pTarget) {
+      UE_LOG(
+          LogCesium,
+          Display,
+          TEXT("Unloading preloaded sub-level %s."),
+          *GetActorLabel(pPrevious));
+      pPrevious->UnloadLevelInstance();
+    }
+    this->_pPreloaded = pPreload;
+  }
+
+  if (!IsValid(pPreload) || pPreload->GetWorldAsset().IsNull()) {
+    return;
+  }
+
+  ULevelStreaming* pStreaming = this->_getLevelStreamingForSubLevel(pPreload);
+  ELevelStreamingState state = IsValid(pStreaming)
+                                   ? pStreaming->GetLevelStreamingState()
+                                   : ELevelStreamingState::Unloaded;
+
+  switch (state) {
+  case ELevelStreamingState::Removed:
+  case ELevelStreamingState::Unloaded:
+    if (!IsValid(pStreaming) || !pStreaming->ShouldBeLoaded()) {
+      UE_LOG(
+          LogCesium,
+          Display,
+          TEXT("Starting preload of sub-level %s."),
+          *GetActorLabel(pPreload));
+      pPreload->LoadLevelInstance();
+    }
+    break;
+  default:
+    // Level instances are shown as soon as they're loaded, so keep asking for
+    // this one to be hidden until it is.
+    if (IsValid(pStreaming) && pStreaming->ShouldBeVisible()) {
+      pStreaming->SetShouldBeVisible(false);
+    }
+    break;
+  }
+}
+
+void UCesiumSubLevelSwitcherComponent::_invalidateSubLevelIndex() noexcept {
+  this->_indexIsValid = false;
+}
+
+void UCesiumSubLevelSwitcherComponent::_buildSubLevelIndex(
+    UCesiumEllipsoid& ellipsoid) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildSubLevelIndex)
+
+  this->_indexedSubLevels.Reset();
+  this->_indexCells.Reset();
+  this->_indexMaximumLoadRadius = 0.0;
+
+  for (const TWeakObjectPtr<ALevelInstance>& pWeak : this->_sublevels) {
+    ALevelInstance* pSubLevel = pWeak.Get();
+    if (!IsValid(pSubLevel))
+      continue;
+
+    UCesiumSubLevelComponent* pComponent =
+        pSubLevel->FindComponentByClass<UCesiumSubLevelComponent>();
+    if (!IsValid(pComponent))
+      continue;
+
+    const double loadRadius = pComponent->GetLoadRadius();
+    this->_indexedSubLevels.Add(
+        {pSubLevel,
+         pComponent,
+         ellipsoid.LongitudeLatitudeHeightToEllipsoidCenteredEllipsoidFixed(
+             FVector(
+                 pComponent->GetOriginLongitude(),
+                 pComponent->GetOriginLatitude(),
+                 pComponent->GetOriginHeight())),
+         loadRadius});
+    this->_indexMaximumLoadRadius =
+        FMath::Max(this->_indexMaximumLoadRadius, loadRadius);
+  }
+
+  this->_indexCellSize =
+      FMath::Max(this->_indexMaximumLoadRadius, MinimumIndexCellSize);
+  for (int32 i = 0; i < this->_indexedSubLevels.Num(); ++i) {
+    this->_indexCells
+        .FindOrAdd(getIndexCell(
+            this->_indexedSubLevels[i].position,
+            this->_indexCellSize))
+        .Add(i);
+  }
+
+  this->_pIndexEllipsoid = &ellipsoid;
+  this->_indexIsValid = true;
+}
+
 #if WITH_EDITOR
 
 void UCesiumSubLevelSwitcherComponent::_updateSubLevelStateEditor() {
@@ -0,0 +1,415 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTerrainHeightmap.h"
+
+#include <Cesium3DTilesContent/SkirtMeshMetadata.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumUtility/Math.h>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+using namespace CesiumGltf;
+
+namespace {
+
+/**
+ * The terms of the ECEF position of a point on a parallel of the ellipsoid:
+ * the radius of the parallel, its height above the equatorial plane, and the
+ * cosine and sine of its latitude.
+ */
+struct Parallel {
+  double radius;
+  double z;
+  double cosLatitude;
+  double sinLatitude;
+};
+
+Parallel getParallel(const glm::dvec3& radii, double latitude) {
+  const double cosLatitude = std::cos(latitude);
+  const double sinLatitude = std::sin(latitude);
+  const double a2 = radii.x * radii.x;
+  const double b2 = radii.z * radii.z;
+  const double n = a2 / std::sqrt(
+                            a2 * cosLatitude * cosLatitude +
+                            b2 * sinLatitude * sinLatitude);
+  return Parallel{
+      n * cosLatitude,
+      n * (b2 / a2) * sinLatitude,
+      cosLatitude,
+      sinLatitude};
+}
+
+// The longitude, latitude, and height of a vertex, and whether it has been
+// converted yet.
+struct Sample {
+  glm::dvec3 cartographic;
+  bool converted;
+};
+
+/**
+ * Fills the samples that no triangle covered, which are only ever a few along
+ * the edges of the rectangle, from a covered neighbor.
+ */
+bool fillUncovered(
+    int32 resolution,
+    TArray<bool>& covered,
+    CesiumTerrainHeightmap::Resampling& resampling) {
+  if (!covered.Contains(true)) {
+    return false;
+  }
+
+  TArray<TPair<int32, int32>> filled;
+  for (;;) {
+    filled.Reset();
+    for (int32 row = 0; row < resolution; ++row) {
+      for (int32 column = 0; column < resolution; ++column) {
+        const int32 index = row * resolution + column;
+        if (covered[index]) {
+          continue;
+        }
+
+        const int32 neighbors[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+        for (const int32* offset : neighbors) {
+          const int32 c = column + offset[0];
+          const int32 r = row + offset[1];
+          if (c >= 0 && c < resolution && r >= 0 && r < resolution &&
+              covered[r * resolution + c]) {
+            filled.Emplace(index, r * resolution + c);
+            break;
+          }
+        }
+      }
+    }
+
+    if (filled.IsEmpty()) {
+      return true;
+    }
+    for (const TPair<int32, int32>& pair : filled) {
+      resampling.Vertices[pair.Key] = resampling.Vertices[pair.Value];
+      resampling.Weights[pair.Key] = resampling.Weights[pair.Value];
+      covered[pair.Key] = true;
+    }
+  }
+}
+
+} // namespace
+
+namespace CesiumTerrainHeightmap {
+
+uint64 Heightmap::getSizeBytes() const {
+  return uint64(this->Heights.Num()) +
+         uint64(this->Axes.Num()) * sizeof(FVector4f) +
+         uint64(this->TexCoords.Num()) * sizeof(FVector2f);
+}
+
+bool isTerrainPrimitive(const MeshPrimitive& primitive) {
+  return primitive.mode == MeshPrimitive::Mode::TRIANGLES &&
+         primitive.extras.find("skirtMeshMetadata") != primitive.extras.end();
+}
+
+TSharedPtr<Heightmap, ESPMode::ThreadSafe> create(
+    const MeshPrimitive& primitive,
+    TArrayView<const FVector3f> positions,
+    TArrayView<const uint32> indices,
+    const glm::dmat4& transform,
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    int32 resolution,
+    Resampling& resampling) {
+  const std::optional<Cesium3DTilesContent::SkirtMeshMetadata> maybeSkirt =
+      Cesium3DTilesContent::SkirtMeshMetadata::parseFromGltfExtras(
+          primitive.extras);
+  if (!maybeSkirt) {
+    return nullptr;
+  }
+
+  // The skirts come after the triangles of the terrain itself.
+  const int64 firstIndex = int64(maybeSkirt->noSkirtIndicesBegin);
+  const int64 indexCount = FMath::Min(
+                               int64(maybeSkirt->noSkirtIndicesCount),
+                               int64(indices.Num()) - firstIndex) /
+                           3 * 3;
+  if (firstIndex < 0 || indexCount < 3 || positions.IsEmpty()) {
+    return nullptr;
+  }
+
+  resolution = FMath::Clamp(resolution, 2, 1025);
+
+  // Only the vertices of the triangles other than the skirts are converted.
+  TArray<Sample> samples;
+  samples.SetNumZeroed(positions.Num());
+  glm::dvec2 minimum(std::numeric_limits<double>::max());
+  glm::dvec2 maximum(std::numeric_limits<double>::lowest());
+  for (int64 i = firstIndex; i < firstIndex + indexCount; ++i) {
+    const uint32 vertex = indices[i];
+    if (vertex >= uint32(positions.Num())) {
+      return nullptr;
+    }
+    Sample& sample = samples[vertex];
+    if (sample.converted) {
+      continue;
+    }
+
+    const FVector3f& position = positions[vertex];
+    const glm::dvec3 ecef(
+        transform * glm::dvec4(position.X, position.Y, position.Z, 1.0));
+    const std::optional<CesiumGeospatial::Cartographic> maybeCartographic =
+        ellipsoid.cartesianToCartographic(ecef);
+    if (!maybeCartographic) {
+      return nullptr;
+    }
+
+    sample.cartographic = glm::dvec3(
+        maybeCartographic->longitude,
+        maybeCartographic->latitude,
+        maybeCartographic->height);
+    sample.converted = true;
+    minimum = glm::min(minimum, glm::dvec2(sample.cartographic));
+    maximum = glm::max(maximum, glm::dvec2(sample.cartographic));
+  }
+
+  const glm::dvec2 size = maximum - minimum;
+  if (size.x <= 0.0 || size.y <= 0.0 || size.x > CesiumUtility::Math::OnePi) {
+    return nullptr;
+  }
+
+  TSharedRef<Heightmap, ESPMode::ThreadSafe> pHeightmap =
+      MakeShared<Heightmap, ESPMode::ThreadSafe>();
+  Heightmap& heightmap = *pHeightmap;
+  heightmap.Resolution = resolution;
+
+  const int32 numSamples = resolution * resolution;
+  resampling.Vertices.SetNumZeroed(numSamples);
+  resampling.Weights.SetNumZeroed(numSamples);
+  TArray<bool> covered;
+  covered.SetNumZeroed(numSamples);
+
+  {
+    // Each triangle is rasterized in the grid's coordinates, in which the
+    // samples are at integer coordinates.
+    const glm::dvec2 toGrid = glm::dvec2(resolution - 1) / size;
+    for (int64 i = firstIndex; i < firstIndex + indexCount; i += 3) {
+      const FUintVector3 vertices(indices[i], indices[i + 1], indices[i + 2]);
+      glm::dvec2 grid[3];
+      for (int32 j = 0; j < 3; ++j) {
+        grid[j] = (glm::dvec2(samples[vertices[j]].cartographic) - minimum) *
+                  toGrid;
+      }
+
+      const double determinant =
+          (grid[1].y - grid[2].y) * (grid[0].x - grid[2].x) +
+          (grid[2].x - grid[1].x) * (grid[0].y - grid[2].y);
+      if (std::abs(determinant) < 1e-12) {
+        continue;
+      }
+
+      const double epsilon = 1e-6;
+      const glm::dvec2 lower = glm::min(grid[0], glm::min(grid[1], grid[2]));
+      const glm::dvec2 upper = glm::max(grid[0], glm::max(grid[1], grid[2]));
+      const int32 firstColumn =
+          FMath::Max(int32(std::ceil(lower.x - epsilon)), 0);
+      const int32 lastColumn =
+          FMath::Min(int32(std::floor(upper.x + epsilon)), resolution - 1);
+      const int32 firstRow = FMath::Max(int32(std::ceil(lower.y - epsilon)), 0);
+      const int32 lastRow =
+          FMath::Min(int32(std::floor(upper.y + epsilon)), resolution - 1);
+
+      for (int32 row = firstRow; row <= lastRow; ++row) {
+        for (int32 column = firstColumn; column <= lastColumn; ++column) {
+          const double x = column - grid[2].x;
+          const double y = row - grid[2].y;
+          const double w0 = ((grid[1].y - grid[2].y) * x +
+                             (grid[2].x - grid[1].x) * y) /
+                            determinant;
+          const double w1 = ((grid[2].y - grid[0].y) * x +
+                             (grid[0].x - grid[2].x) * y) /
+                            determinant;
+          const double w2 = 1.0 - w0 - w1;
+          if (w0 < -epsilon || w1 < -epsilon || w2 < -epsilon) {
+            continue;
+          }
+
+          const int32 index = row * resolution + column;
+          resampling.Vertices[index] = vertices;
+          resampling.Weights[index] =
+              FVector3f(float(w0), float(w1), float(w2));
+          covered[index] = true;
+        }
+      }
+    }
+  }
+
+  if (!fillUncovered(resolution, covered, resampling)) {
+    return nullptr;
+  }
+
+  TArray<float> heights;
+  heights.SetNumUninitialized(numSamples);
+  for (int32 i = 0; i < numSamples; ++i) {
+    const FUintVector3& vertices = resampling.Vertices[i];
+    const FVector3f& weights = resampling.Weights[i];
+    heights[i] = float(
+        weights.X * samples[vertices.X].cartographic.z +
+        weights.Y * samples[vertices.Y].cartographic.z +
+        weights.Z * samples[vertices.Z].cartographic.z);
+  }
+
+  {
+    // Heights are kept in 16 bits when that quantizes them to a centimeter or
+    // better, which it does for all but the coarsest tiles.
+    float minimumHeight = heights[0];
+    float maximumHeight = heights[0];
+    for (float height : heights) {
+      minimumHeight = FMath::Min(minimumHeight, height);
+      maximumHeight = FMath::Max(maximumHeight, height);
+    }
+
+    const float range = maximumHeight - minimumHeight;
+    if (range / 65535.0f <= 0.01f) {
+      heightmap.Format = PF_G16;
+      heightmap.HeightOffset = minimumHeight;
+      heightmap.HeightScale = range;
+      heightmap.Heights.SetNumUninitialized(numSamples * sizeof(uint16));
+      uint16* pHeights = reinterpret_cast<uint16*>(heightmap.Heights.GetData());
+      for (int32 i = 0; i < numSamples; ++i) {
+        const float normalized =
+            range > 0.0f ? (heights[i] - minimumHeight) / range : 0.0f;
+        pHeights[i] = uint16(FMath::RoundToInt(
+            FMath::Clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+      }
+    } else {
+      heightmap.Format = PF_R32_FLOAT;
+      heightmap.HeightOffset = 0.0f;
+      heightmap.HeightScale = 1.0f;
+      heightmap.Heights.SetNumUninitialized(numSamples * sizeof(float));
+      FMemory::Memcpy(
+          heightmap.Heights.GetData(),
+          heights.GetData(),
+          numSamples * sizeof(float));
+    }
+  }
+
+  {
+    const glm::dvec3 radii = ellipsoid.getRadii();
+    const glm::dvec2 reference = minimum + 0.5 * size;
+    const Parallel referenceParallel = getParallel(radii, reference.y);
+    const double cosReference = std::cos(reference.x);
+    const double sinReference = std::sin(reference.x);
+
+    heightmap.Axes.SetNumUninitialized(2 * resolution);
+    for (int32 i = 0; i < resolution; ++i) {
+      const double t = double(i) / double(resolution - 1);
+      const double longitude = minimum.x + t * size.x;
+      const double cosLongitude = std::cos(longitude);
+      const double sinLongitude = std::sin(longitude);
+      heightmap.Axes[i] = FVector4f(
+          float(referenceParallel.radius * (cosLongitude - cosReference)),
+          float(referenceParallel.radius * (sinLongitude - sinReference)),
+          float(cosLongitude),
+          float(sinLongitude));
+
+      const double latitude = minimum.y + t * size.y;
+      const Parallel parallel = getParallel(radii, latitude);
+      heightmap.Axes[resolution + i] = FVector4f(
+          float(parallel.radius - referenceParallel.radius),
+          float(parallel.z - referenceParallel.z),
+          float(parallel.cosLatitude),
+          float(parallel.sinLatitude));
+    }
+
+    // The coordinates of the static mesh are the glTF coordinates with an
+    // inverted Y axis.
+    const glm::dmat4 yInvert(
+        glm::dvec4(1.0, 0.0, 0.0, 0.0),
+        glm::dvec4(0.0, -1.0, 0.0, 0.0),
+        glm::dvec4(0.0, 0.0, 1.0, 0.0),
+        glm::dvec4(0.0, 0.0, 0.0, 1.0));
+    const glm::dmat4 ecefToLocal = yInvert * glm::affineInverse(transform);
+    const glm::dvec3 referenceEcef(
+        referenceParallel.radius * cosReference,
+        referenceParallel.radius * sinReference,
+        referenceParallel.z);
+    const glm::dvec3 origin(ecefToLocal * glm::dvec4(referenceEcef, 1.0));
+    heightmap.Origin =
+        FVector3f(float(origin.x), float(origin.y), float(origin.z));
+
+    // glm matrices are indexed by column and Unreal's transform row vectors,
+    // so the elements of the rotation are in the same places in both.
+    heightmap.EcefToLocal = FMatrix44f::Identity;
+    for (int32 i = 0; i < 3; ++i) {
+      for (int32 j = 0; j < 3; ++j) {
+        heightmap.EcefToLocal.M[i][j] = float(ecefToLocal[i][j]);
+      }
+    }
+  }
+
+  heightmap.SkirtHeight = float(std::max(
+      {maybeSkirt->skirtWestHeight,
+       maybeSkirt->skirtSouthHeight,
+       maybeSkirt->skirtEastHeight,
+       maybeSkirt->skirtNorthHeight}));
+
+  resampleTexCoords(heightmap, resampling, {});
+
+  return pHeightmap;
+}
+
+void resampleTexCoords(
+    Heightmap& heightmap,
+    const Resampling& resampling,
+    TArrayView<const TArray<FVector2f>> texCoords) {
+  // Like the static mesh, the heightmap has at least one texture coordinate.
+  const int32 numTexCoords = FMath::Max(texCoords.Num(), 1);
+  const int32 numSamples = resampling.Vertices.Num();
+  heightmap.NumTexCoords = numTexCoords;
+  heightmap.TexCoords.SetNumZeroed(numSamples * numTexCoords);
+
+  for (int32 channel = 0; channel < texCoords.Num(); ++channel) {
+    const TArray<FVector2f>& uvs = texCoords[channel];
+    if (uvs.IsEmpty()) {
+      continue;
+    }
+
+    for (int32 i = 0; i < numSamples; ++i) {
+      const FUintVector3& vertices = resampling.Vertices[i];
+      if (vertices.GetMax() >= uint32(uvs.Num())) {
+        continue;
+      }
+      const FVector3f& weights = resampling.Weights[i];
+      heightmap.TexCoords[i * numTexCoords + channel] =
+          uvs[vertices.X] * weights.X + uvs[vertices.Y] * weights.Y +
+          uvs[vertices.Z] * weights.Z;
+    }
+  }
+}
+
+float getHeight(const Heightmap& heightmap, int32 column, int32 row) {
+  const int32 index = row * heightmap.Resolution + column;
+  if (heightmap.Format == PF_G16) {
+    const uint16* pHeights =
+        reinterpret_cast<const uint16*>(heightmap.Heights.GetData());
+    return heightmap.HeightOffset +
+           heightmap.HeightScale * (float(pHeights[index]) / 65535.0f);
+  }
+  return reinterpret_cast<const float*>(heightmap.Heights.GetData())[index];
+}
+
+FVector3f getPosition(const Heightmap& heightmap, int32 column, int32 row) {
+  const FVector4f& columnAxis = heightmap.Axes[column];
+  const FVector4f& rowAxis = heightmap.Axes[heightmap.Resolution + row];
+  const float height = getHeight(heightmap, column, row);
+
+  const FVector3f ecefDelta(
+      rowAxis.X * columnAxis.Z + columnAxis.X +
+          height * rowAxis.Z * columnAxis.Z,
+      rowAxis.X * columnAxis.W + columnAxis.Y +
+          height * rowAxis.Z * columnAxis.W,
+      rowAxis.Y + height * rowAxis.W);
+  return heightmap.Origin + heightmap.EcefToLocal.TransformVector(ecefDelta);
+}
+
+} // namespace CesiumTerrainHeightmap
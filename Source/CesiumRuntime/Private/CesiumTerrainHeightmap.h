@@ -0,0 +1,161 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/IntVector.h"
+#include "Math/Matrix.h"
+#include "Math/Vector.h"
+#include "Math/Vector2D.h"
+#include "Math/Vector4.h"
+#include "PixelFormat.h"
+#include "Templates/SharedPointer.h"
+#include <glm/mat4x4.hpp>
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+namespace CesiumGltf {
+struct MeshPrimitive;
+}
+
+/**
+ * Resamples quantized-mesh terrain into heightmaps, which a
+ * FCesiumTerrainHeightmapVertexFactory draws by displacing a grid that is
+ * shared by all tiles of the same resolution.
+ *
+ * The grid is regular in longitude and latitude, over the rectangle that the
+ * vertices of the tile cover. The position of each of its samples is rebuilt
+ * in the vertex shader from the height of the sample, in float precision,
+ * relative to a reference point at the center of the rectangle: the terms of
+ * the ellipsoid that only depend on the column or the row of the sample are
+ * computed in double precision here, as differences from the reference point,
+ * and are small enough that float precision loses nothing that matters.
+ */
+namespace CesiumTerrainHeightmap {
+
+struct Heightmap {
+  /**
+   * The number of samples along each side of the grid.
+   */
+  int32 Resolution = 0;
+
+  /**
+   * The heights of the samples, row by row from the south, in the format of
+   * the height texture. 16-bit heights are normalized, and are dequantized as
+   * `HeightOffset + HeightScale * height`.
+   */
+  TArray<uint8> Heights;
+  EPixelFormat Format = PF_G16;
+  float HeightOffset = 0.0f;
+  float HeightScale = 1.0f;
+
+  /**
+   * The terms of the position of each column of samples, followed by those of
+   * each row. For a column, the differences of the cosine and sine of its
+   * longitude from those of the reference point, scaled by the radius of the
+   * parallel through the reference point, and then the cosine and sine of
+   * its longitude. For a row, the differences of the radius of its parallel
+   * and of the height of its parallel above the equatorial plane from those
+   * of the reference point, and then the cosine and sine of its latitude.
+   */
+  TArray<FVector4f> Axes;
+
+  /**
+   * The reference point in the coordinates of the static mesh, and the
+   * rotation from ECEF to those coordinates, whose Y axis is inverted.
+   */
+  FVector3f Origin = FVector3f::ZeroVector;
+  FMatrix44f EcefToLocal = FMatrix44f::Identity;
+
+  /**
+   * How far below the edge of the grid its skirts reach, in meters.
+   */
+  float SkirtHeight = 0.0f;
+
+  /**
+   * The texture coordinates of the samples, NumTexCoords for each, in the
+   * same order as the heights. These are the texture coordinates of the
+   * static mesh that the heightmap replaces, interpolated across its
+   * triangles.
+   */
+  TArray<FVector2f> TexCoords;
+  int32 NumTexCoords = 0;
+
+  /**
+   * Gets the number of bytes that the heightmap takes in GPU memory.
+   */
+  uint64 getSizeBytes() const;
+};
+
+using SharedHeightmap = TSharedPtr<const Heightmap, ESPMode::ThreadSafe>;
+
+/**
+ * Where the samples of a heightmap were taken from: the vertices of the
+ * triangle that each sample is in, and its barycentric weights in that
+ * triangle. The texture coordinates are resampled with these once they have
+ * been computed.
+ */
+struct Resampling {
+  TArray<FUintVector3> Vertices;
+  TArray<FVector3f> Weights;
+};
+
+/**
+ * Determines if a primitive is terrain loaded from quantized-mesh, which
+ * marks the primitives it creates with the metadata of their skirts.
+ */
+bool isTerrainPrimitive(const CesiumGltf::MeshPrimitive& primitive);
+
+/**
+ * Resamples the triangles of a terrain primitive, other than its skirts, into
+ * a heightmap. The heightmap has a single texture coordinate of zero until
+ * {@link resampleTexCoords} is called.
+ *
+ * @param primitive The terrain primitive.
+ * @param positions The positions of the vertices, in glTF coordinates.
+ * @param indices The indices of the triangles of the primitive.
+ * @param transform The transform from glTF coordinates to ECEF.
+ * @param ellipsoid The ellipsoid of the tileset.
+ * @param resolution The number of samples along each side of the grid.
+ * @param resampling Receives where the samples were taken from.
+ * @return The heightmap, or nullptr if the primitive can't be resampled, for
+ * example because its vertices don't cover a usable rectangle.
+ */
+TSharedPtr<Heightmap, ESPMode::ThreadSafe> create(
+    const CesiumGltf::MeshPrimitive& primitive,
+    TArrayView<const FVector3f> positions,
+    TArrayView<const uint32> indices,
+    const glm::dmat4& transform,
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    int32 resolution,
+    Resampling& resampling);
+
+/**
+ * Resamples the texture coordinates of the static mesh that a heightmap
+ * replaces into the heightmap.
+ *
+ * @param heightmap The heightmap.
+ * @param resampling Where the samples of the heightmap were taken from.
+ * @param texCoords The texture coordinate channels of the static mesh, with a
+ * texture coordinate for each vertex, or none if the channel is unused.
+ */
+void resampleTexCoords(
+    Heightmap& heightmap,
+    const Resampling& resampling,
+    TArrayView<const TArray<FVector2f>> texCoords);
+
+/**
+ * Gets the height of a sample of a heightmap, in meters.
+ */
+float getHeight(const Heightmap& heightmap, int32 column, int32 row);
+
+/**
+ * Gets the position of a sample of a heightmap, in the coordinates of the
+ * static mesh, as the vertex factory rebuilds it.
+ */
+FVector3f getPosition(const Heightmap& heightmap, int32 column, int32 row);
+
+} // namespace CesiumTerrainHeightmap
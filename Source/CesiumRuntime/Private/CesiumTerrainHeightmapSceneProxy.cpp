@@ -0,0 +1,138 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTerrainHeightmapSceneProxy.h"
+#include "CesiumGltfTerrainHeightmapComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "SceneInterface.h"
+
+SIZE_T FCesiumTerrainHeightmapSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+FCesiumTerrainHeightmapSceneProxy::FCesiumTerrainHeightmapSceneProxy(
+    UCesiumGltfTerrainHeightmapComponent* InComponent,
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FPrimitiveSceneProxy(InComponent),
+      Heightmap(InComponent->Heightmap),
+      VertexFactory(InFeatureLevel),
+      Buffers(InComponent->Heightmap),
+      IndexBuffer(),
+      Material(InComponent->GetMaterial(0)),
+      MaterialRelevance(InComponent->GetMaterialRelevance(InFeatureLevel)) {}
+
+FCesiumTerrainHeightmapSceneProxy::~FCesiumTerrainHeightmapSceneProxy() {}
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+void FCesiumTerrainHeightmapSceneProxy::CreateRenderThreadResources(
+    FRHICommandListBase& RHICmdList) {
+  VertexFactory.InitResource(RHICmdList);
+  Buffers.InitResource(RHICmdList);
+  IndexBuffer =
+      FCesiumTerrainGridIndexBuffer::Acquire(RHICmdList, Heightmap->Resolution);
+}
+#elif ENGINE_VERSION_5_3_OR_HIGHER
+void FCesiumTerrainHeightmapSceneProxy::CreateRenderThreadResources() {
+  FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+  VertexFactory.InitResource(RHICmdList);
+  Buffers.InitResource(RHICmdList);
+  IndexBuffer =
+      FCesiumTerrainGridIndexBuffer::Acquire(RHICmdList, Heightmap->Resolution);
+}
+#else
+void FCesiumTerrainHeightmapSceneProxy::CreateRenderThreadResources() {
+  VertexFactory.InitResource();
+  Buffers.InitResource();
+  IndexBuffer = FCesiumTerrainGridIndexBuffer::Acquire(Heightmap->Resolution);
+}
+#endif
+
+void FCesiumTerrainHeightmapSceneProxy::DestroyRenderThreadResources() {
+  VertexFactory.ReleaseResource();
+  Buffers.ReleaseResource();
+  IndexBuffer.Reset();
+}
+
+void FCesiumTerrainHeightmapSceneProxy::GetDynamicMeshElements(
+    const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily,
+    uint32 VisibilityMap,
+    FMeshElementCollector& Collector) const {
+  QUICK_SCOPE_CYCLE_COUNTER(
+      STAT_TerrainHeightmapSceneProxy_GetDynamicMeshElements);
+
+  if (!IndexBuffer || !Buffers.HeightTexture) {
+    return;
+  }
+
+  // The parameters are the same in every view.
+  FCesiumTerrainHeightmapBatchElementUserDataWrapper* UserDataWrapper =
+      &Collector.AllocateOneFrameResource<
+          FCesiumTerrainHeightmapBatchElementUserDataWrapper>();
+  FCesiumTerrainHeightmapBatchElementUserData& UserData = UserDataWrapper->Data;
+  UserData.HeightTexture = Buffers.HeightTexture.GetReference();
+  UserData.AxisBuffer = Buffers.AxisSRV.GetReference();
+  UserData.TexCoordBuffer = Buffers.TexCoordSRV.GetReference();
+  UserData.HeightOffsetAndScale =
+      FVector2f(Heightmap->HeightOffset, Heightmap->HeightScale);
+  UserData.Resolution = uint32(Heightmap->Resolution);
+  UserData.NumTexCoords = uint32(Heightmap->NumTexCoords);
+  UserData.SkirtHeight = Heightmap->SkirtHeight;
+  UserData.HeightmapOrigin = Heightmap->Origin;
+  UserData.EcefToLocal = Heightmap->EcefToLocal;
+
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
+    if (!(VisibilityMap & (1 << ViewIndex))) {
+      continue;
+    }
+
+    FMeshBatch& Mesh = Collector.AllocateMesh();
+    Mesh.VertexFactory = &VertexFactory;
+    Mesh.MaterialRenderProxy = Material->GetRenderProxy();
+    Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+    Mesh.Type = PT_TriangleList;
+    Mesh.DepthPriorityGroup = SDPG_World;
+    Mesh.LODIndex = 0;
+    Mesh.CastShadow = true;
+    Mesh.bCanApplyViewModeOverrides = false;
+    Mesh.bUseAsOccluder = false;
+    Mesh.bWireframe = false;
+
+    FMeshBatchElement& BatchElement = Mesh.Elements[0];
+    BatchElement.IndexBuffer = IndexBuffer.Get();
+    BatchElement.NumPrimitives = uint32(IndexBuffer->GetNumTriangles());
+    BatchElement.FirstIndex = 0;
+    BatchElement.MinVertexIndex = 0;
+    BatchElement.MaxVertexIndex = uint32(IndexBuffer->GetNumVertices() - 1);
+    BatchElement.PrimitiveUniformBuffer = GetUniformBuffer();
+    BatchElement.UserData = &UserDataWrapper->Data;
+
+    Collector.AddMesh(ViewIndex, Mesh);
+  }
+}
+
+FPrimitiveViewRelevance FCesiumTerrainHeightmapSceneProxy::GetViewRelevance(
+    const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View);
+  Result.bDynamicRelevance = true;
+  Result.bStaticRelevance = false;
+
+  Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bRenderInDepthPass = ShouldRenderInDepthPass();
+  Result.bUsesLightingChannels =
+      GetLightingChannelMask() != GetDefaultLightingChannelMask();
+  Result.bShadowRelevance = IsShadowCast(View);
+  Result.bVelocityRelevance =
+      IsMovable() & Result.bOpaque & Result.bRenderInMainPass;
+
+  MaterialRelevance.SetPrimitiveViewRelevance(Result);
+
+  return Result;
+}
+
+uint32 FCesiumTerrainHeightmapSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize());
+}
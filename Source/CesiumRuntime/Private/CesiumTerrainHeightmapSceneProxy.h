@@ -0,0 +1,56 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTerrainHeightmapVertexFactory.h"
+#include "PrimitiveSceneProxy.h"
+
+class UCesiumGltfTerrainHeightmapComponent;
+
+/**
+ * Draws a terrain tile from its heightmap, with a
+ * FCesiumTerrainHeightmapVertexFactory. The grid that the heightmap displaces
+ * is shared with the other tiles of the same resolution, so the only GPU
+ * memory of the tile itself is its height texture, and the terms and texture
+ * coordinates of its samples.
+ */
+class FCesiumTerrainHeightmapSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  FCesiumTerrainHeightmapSceneProxy(
+      UCesiumGltfTerrainHeightmapComponent* InComponent,
+      ERHIFeatureLevel::Type InFeatureLevel);
+
+  virtual ~FCesiumTerrainHeightmapSceneProxy();
+
+  SIZE_T GetTypeHash() const override;
+
+protected:
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  virtual void
+  CreateRenderThreadResources(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void CreateRenderThreadResources() override;
+#endif
+  virtual void DestroyRenderThreadResources() override;
+
+  virtual void GetDynamicMeshElements(
+      const TArray<const FSceneView*>& Views,
+      const FSceneViewFamily& ViewFamily,
+      uint32 VisibilityMap,
+      FMeshElementCollector& Collector) const override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  CesiumTerrainHeightmap::SharedHeightmap Heightmap;
+
+  FCesiumTerrainHeightmapVertexFactory VertexFactory;
+  FCesiumTerrainHeightmapBuffers Buffers;
+  TSharedPtr<FCesiumTerrainGridIndexBuffer> IndexBuffer;
+
+  UMaterialInterface* Material;
+  FMaterialRelevance MaterialRelevance;
+};
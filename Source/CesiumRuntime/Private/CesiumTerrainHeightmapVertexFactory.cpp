@@ -0,0 +1,353 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTerrainHeightmapVertexFactory.h"
+
+#include "DataDrivenShaderPlatformInfo.h"
+#include "MaterialDomain.h"
+#include "MeshBatch.h"
+#include "MeshDrawShaderBindings.h"
+#include "MeshMaterialShader.h"
+#include "RenderUtils.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+#define RHI_CREATE_BUFFER RHICmdList.CreateBuffer
+#define RHI_LOCK_BUFFER RHICmdList.LockBuffer
+#define RHI_UNLOCK_BUFFER RHICmdList.UnlockBuffer
+#define RHI_CREATE_SHADER_RESOURCE_VIEW RHICmdList.CreateShaderResourceView
+#else
+#define RHI_CREATE_BUFFER RHICreateBuffer
+#define RHI_LOCK_BUFFER RHILockBuffer
+#define RHI_UNLOCK_BUFFER RHIUnlockBuffer
+#define RHI_CREATE_SHADER_RESOURCE_VIEW RHICreateShaderResourceView
+#endif
+
+namespace {
+// The grid index buffers of the resolutions that are drawn. Only accessed from
+// the render thread.
+TMap<int32, TWeakPtr<FCesiumTerrainGridIndexBuffer>> GridIndexBuffers;
+} // namespace
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+TSharedRef<FCesiumTerrainGridIndexBuffer>
+FCesiumTerrainGridIndexBuffer::Acquire(
+    FRHICommandListBase& RHICmdList,
+    int32 Resolution) {
+#else
+TSharedRef<FCesiumTerrainGridIndexBuffer>
+FCesiumTerrainGridIndexBuffer::Acquire(int32 Resolution) {
+#endif
+  check(IsInRenderingThread());
+
+  TWeakPtr<FCesiumTerrainGridIndexBuffer>& pWeak =
+      GridIndexBuffers.FindOrAdd(Resolution);
+  if (TSharedPtr<FCesiumTerrainGridIndexBuffer> pExisting = pWeak.Pin()) {
+    return pExisting.ToSharedRef();
+  }
+
+  // The last heightmap of the resolution to stop being drawn releases the
+  // index buffer, from the render thread.
+  TSharedRef<FCesiumTerrainGridIndexBuffer> pIndexBuffer = MakeShareable(
+      new FCesiumTerrainGridIndexBuffer(Resolution),
+      [](FCesiumTerrainGridIndexBuffer* pBuffer) {
+        pBuffer->ReleaseResource();
+        delete pBuffer;
+      });
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  pIndexBuffer->InitResource(RHICmdList);
+#else
+  pIndexBuffer->InitResource();
+#endif
+  pWeak = pIndexBuffer;
+  return pIndexBuffer;
+}
+
+int32 FCesiumTerrainGridIndexBuffer::GetNumVertices() const {
+  return (Resolution + 2) * (Resolution + 2);
+}
+
+int32 FCesiumTerrainGridIndexBuffer::GetNumTriangles() const {
+  return (Resolution + 1) * (Resolution + 1) * 2;
+}
+
+void FCesiumTerrainGridIndexBuffer::INIT_RHI_SIGNATURE {
+  check(IsInRenderingThread());
+
+  FRHIResourceCreateInfo CreateInfo(TEXT("FCesiumTerrainGridIndexBuffer"));
+  const uint32 NumIndices = uint32(GetNumTriangles()) * 3;
+  const uint32 Size = NumIndices * sizeof(uint32);
+
+  IndexBufferRHI = RHI_CREATE_BUFFER(
+      Size,
+      BUF_Static | BUF_IndexBuffer,
+      sizeof(uint32),
+      ERHIAccess::VertexOrIndexBuffer,
+      CreateInfo);
+
+  uint32* Data =
+      (uint32*)RHI_LOCK_BUFFER(IndexBufferRHI, 0, Size, RLM_WriteOnly);
+
+  // Columns go east and rows go north, and the triangles wind counterclockwise
+  // when seen from above in glTF coordinates, like those of the terrain.
+  const uint32 GridSize = uint32(Resolution) + 2;
+  uint32 bufferIndex = 0;
+  for (uint32 row = 0; row + 1 < GridSize; ++row) {
+    for (uint32 column = 0; column + 1 < GridSize; ++column) {
+      const uint32 southWest = row * GridSize + column;
+      const uint32 southEast = southWest + 1;
+      const uint32 northWest = southWest + GridSize;
+      const uint32 northEast = northWest + 1;
+      Data[bufferIndex++] = southWest;
+      Data[bufferIndex++] = southEast;
+      Data[bufferIndex++] = northEast;
+      Data[bufferIndex++] = southWest;
+      Data[bufferIndex++] = northEast;
+      Data[bufferIndex++] = northWest;
+    }
+  }
+
+  RHI_UNLOCK_BUFFER(IndexBufferRHI);
+}
+
+void FCesiumTerrainHeightmapBuffers::INIT_RHI_SIGNATURE {
+  if (!Heightmap) {
+    return;
+  }
+
+  check(IsInRenderingThread());
+
+  const CesiumTerrainHeightmap::Heightmap& heightmap = *Heightmap;
+  const int32 resolution = heightmap.Resolution;
+
+  {
+    HeightTexture =
+        RHICreateTexture(FRHITextureCreateDesc::Create2D(
+                             TEXT("FCesiumTerrainHeightmapBuffers"))
+                             .SetExtent(resolution, resolution)
+                             .SetFormat(heightmap.Format)
+                             .SetNumMips(1)
+                             .SetNumSamples(1)
+                             .SetFlags(TexCreate_ShaderResource)
+                             .SetInitialState(ERHIAccess::SRVMask));
+
+    const uint32 sourcePitch =
+        uint32(resolution) * GPixelFormats[heightmap.Format].BlockBytes;
+    uint32 destinationPitch;
+    uint8* pDestination = (uint8*)RHILockTexture2D(
+        HeightTexture,
+        0,
+        RLM_WriteOnly,
+        destinationPitch,
+        false);
+    for (int32 row = 0; row < resolution; ++row) {
+      FMemory::Memcpy(
+          pDestination + row * destinationPitch,
+          heightmap.Heights.GetData() + row * sourcePitch,
+          sourcePitch);
+    }
+    RHIUnlockTexture2D(HeightTexture, 0, false);
+  }
+
+  const auto createBuffer = [&](const void* pData,
+                                uint32 Size,
+                                uint32 Stride,
+                                EPixelFormat Format,
+                                FBufferRHIRef& Buffer,
+                                FShaderResourceViewRHIRef& SRV) {
+    FRHIResourceCreateInfo CreateInfo(TEXT("FCesiumTerrainHeightmapBuffers"));
+    Buffer = RHI_CREATE_BUFFER(
+        Size,
+        BUF_Static | BUF_ShaderResource,
+        0,
+        ERHIAccess::SRVMask,
+        CreateInfo);
+    void* Data = RHI_LOCK_BUFFER(Buffer, 0, Size, RLM_WriteOnly);
+    FMemory::Memcpy(Data, pData, Size);
+    RHI_UNLOCK_BUFFER(Buffer);
+    SRV = RHI_CREATE_SHADER_RESOURCE_VIEW(Buffer, Stride, Format);
+  };
+
+  createBuffer(
+      heightmap.Axes.GetData(),
+      uint32(heightmap.Axes.Num()) * sizeof(FVector4f),
+      sizeof(FVector4f),
+      PF_A32B32G32R32F,
+      AxisBuffer,
+      AxisSRV);
+  createBuffer(
+      heightmap.TexCoords.GetData(),
+      uint32(heightmap.TexCoords.Num()) * sizeof(FVector2f),
+      sizeof(FVector2f),
+      PF_G32R32F,
+      TexCoordBuffer,
+      TexCoordSRV);
+}
+
+void FCesiumTerrainHeightmapBuffers::ReleaseRHI() {
+  AxisSRV.SafeRelease();
+  TexCoordSRV.SafeRelease();
+  AxisBuffer.SafeRelease();
+  TexCoordBuffer.SafeRelease();
+  HeightTexture.SafeRelease();
+  FRenderResource::ReleaseRHI();
+}
+
+class FCesiumTerrainHeightmapVertexFactoryShaderParameters
+    : public FVertexFactoryShaderParameters {
+
+  DECLARE_TYPE_LAYOUT(
+      FCesiumTerrainHeightmapVertexFactoryShaderParameters,
+      NonVirtual);
+
+public:
+  void Bind(const FShaderParameterMap& ParameterMap) {
+    HeightTexture.Bind(ParameterMap, TEXT("HeightTexture"));
+    HeightTextureSampler.Bind(ParameterMap, TEXT("HeightTextureSampler"));
+    HeightOffsetAndScale.Bind(ParameterMap, TEXT("HeightOffsetAndScale"));
+    AxisBuffer.Bind(ParameterMap, TEXT("AxisBuffer"));
+    TexCoordBuffer.Bind(ParameterMap, TEXT("TexCoordBuffer"));
+    Resolution.Bind(ParameterMap, TEXT("Resolution"));
+    NumTexCoords.Bind(ParameterMap, TEXT("NumTexCoords"));
+    SkirtHeight.Bind(ParameterMap, TEXT("SkirtHeight"));
+    HeightmapOrigin.Bind(ParameterMap, TEXT("HeightmapOrigin"));
+    EcefToLocal.Bind(ParameterMap, TEXT("EcefToLocal"));
+  }
+
+  void GetElementShaderBindings(
+      const FSceneInterface* Scene,
+      const FSceneView* View,
+      const FMeshMaterialShader* Shader,
+      const EVertexInputStreamType InputStreamType,
+      ERHIFeatureLevel::Type FeatureLevel,
+      const FVertexFactory* VertexFactory,
+      const FMeshBatchElement& BatchElement,
+      FMeshDrawSingleShaderBindings& ShaderBindings,
+      FVertexInputStreamArray& VertexStreams) const {
+    FCesiumTerrainHeightmapBatchElementUserData* UserData =
+        (FCesiumTerrainHeightmapBatchElementUserData*)BatchElement.UserData;
+    if (HeightTexture.IsBound()) {
+      ShaderBindings.AddTexture(
+          HeightTexture,
+          HeightTextureSampler,
+          TStaticSamplerState<SF_Point, AM_Clamp, AM_Clamp>::GetRHI(),
+          UserData->HeightTexture);
+    }
+    if (HeightOffsetAndScale.IsBound()) {
+      ShaderBindings.Add(HeightOffsetAndScale, UserData->HeightOffsetAndScale);
+    }
+    if (AxisBuffer.IsBound()) {
+      ShaderBindings.Add(AxisBuffer, UserData->AxisBuffer);
+    }
+    if (TexCoordBuffer.IsBound()) {
+      ShaderBindings.Add(TexCoordBuffer, UserData->TexCoordBuffer);
+    }
+    if (Resolution.IsBound()) {
+      ShaderBindings.Add(Resolution, UserData->Resolution);
+    }
+    if (NumTexCoords.IsBound()) {
+      ShaderBindings.Add(NumTexCoords, UserData->NumTexCoords);
+    }
+    if (SkirtHeight.IsBound()) {
+      ShaderBindings.Add(SkirtHeight, UserData->SkirtHeight);
+    }
+    if (HeightmapOrigin.IsBound()) {
+      ShaderBindings.Add(HeightmapOrigin, UserData->HeightmapOrigin);
+    }
+    if (EcefToLocal.IsBound()) {
+      ShaderBindings.Add(EcefToLocal, UserData->EcefToLocal);
+    }
+  }
+
+private:
+  LAYOUT_FIELD(FShaderResourceParameter, HeightTexture);
+  LAYOUT_FIELD(FShaderResourceParameter, HeightTextureSampler);
+  LAYOUT_FIELD(FShaderParameter, HeightOffsetAndScale);
+  LAYOUT_FIELD(FShaderResourceParameter, AxisBuffer);
+  LAYOUT_FIELD(FShaderResourceParameter, TexCoordBuffer);
+  LAYOUT_FIELD(FShaderParameter, Resolution);
+  LAYOUT_FIELD(FShaderParameter, NumTexCoords);
+  LAYOUT_FIELD(FShaderParameter, SkirtHeight);
+  LAYOUT_FIELD(FShaderParameter, HeightmapOrigin);
+  LAYOUT_FIELD(FShaderParameter, EcefToLocal);
+};
+
+/**
+ * A dummy vertex buffer to bind when drawing terrain heightmaps. This prevents
+ * rendering pipeline errors that can occur with zero-stream input layouts.
+ */
+class FCesiumTerrainHeightmapDummyVertexBuffer : public FVertexBuffer {
+public:
+  virtual void INIT_RHI_SIGNATURE override;
+};
+
+void FCesiumTerrainHeightmapDummyVertexBuffer::INIT_RHI_SIGNATURE {
+  FRHIResourceCreateInfo CreateInfo(
+      TEXT("FCesiumTerrainHeightmapDummyVertexBuffer"));
+  VertexBufferRHI = RHI_CREATE_BUFFER(
+      sizeof(FVector3f),
+      BUF_Static | BUF_VertexBuffer,
+      0,
+      ERHIAccess::VertexOrIndexBuffer,
+      CreateInfo);
+  FVector3f* DummyContents = (FVector3f*)
+      RHI_LOCK_BUFFER(VertexBufferRHI, 0, sizeof(FVector3f), RLM_WriteOnly);
+  DummyContents[0] = FVector3f(0.0f, 0.0f, 0.0f);
+  RHI_UNLOCK_BUFFER(VertexBufferRHI);
+}
+
+TGlobalResource<FCesiumTerrainHeightmapDummyVertexBuffer>
+    GCesiumTerrainHeightmapDummyVertexBuffer;
+
+FCesiumTerrainHeightmapVertexFactory::FCesiumTerrainHeightmapVertexFactory(
+    ERHIFeatureLevel::Type InFeatureLevel)
+    : FLocalVertexFactory(
+          InFeatureLevel,
+          "FCesiumTerrainHeightmapVertexFactory") {}
+
+bool FCesiumTerrainHeightmapVertexFactory::ShouldCompilePermutation(
+    const FVertexFactoryShaderPermutationParameters& Parameters) {
+  if (!RHISupportsManualVertexFetch(Parameters.Platform)) {
+    return false;
+  }
+
+  return Parameters.MaterialParameters.MaterialDomain == MD_Surface ||
+         Parameters.MaterialParameters.bIsDefaultMaterial ||
+         Parameters.MaterialParameters.bIsSpecialEngineMaterial;
+}
+
+void FCesiumTerrainHeightmapVertexFactory::GetPSOPrecacheVertexFetchElements(
+    EVertexInputStreamType VertexInputStreamType,
+    FVertexDeclarationElementList& Elements) {
+  Elements.Add(FVertexElement(0, 0, VET_Float3, 0, 0, false));
+}
+
+void FCesiumTerrainHeightmapVertexFactory::INIT_RHI_SIGNATURE {
+  FVertexDeclarationElementList Elements;
+  Elements.Add(AccessStreamComponent(
+      FVertexStreamComponent(
+          &GCesiumTerrainHeightmapDummyVertexBuffer,
+          0,
+          0,
+          VET_Float3),
+      0));
+  InitDeclaration(Elements);
+}
+
+void FCesiumTerrainHeightmapVertexFactory::ReleaseRHI() {
+  FVertexFactory::ReleaseRHI();
+}
+
+IMPLEMENT_TYPE_LAYOUT(FCesiumTerrainHeightmapVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_PARAMETER_TYPE(
+    FCesiumTerrainHeightmapVertexFactory,
+    SF_Vertex,
+    FCesiumTerrainHeightmapVertexFactoryShaderParameters);
+
+IMPLEMENT_VERTEX_FACTORY_TYPE(
+    FCesiumTerrainHeightmapVertexFactory,
+    "/Plugin/CesiumForUnreal/Private/CesiumTerrainHeightmapVertexFactory.ush",
+    EVertexFactoryFlags::UsedWithMaterials |
+        EVertexFactoryFlags::SupportsDynamicLighting |
+        EVertexFactoryFlags::SupportsPositionOnly |
+        EVertexFactoryFlags::SupportsPSOPrecaching);
@@ -0,0 +1,129 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "CesiumTerrainHeightmap.h"
+#include "LocalVertexFactory.h"
+#include "RHIDefinitions.h"
+#include "RHIResources.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "SceneManagement.h"
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+#define INIT_RHI_SIGNATURE InitRHI(FRHICommandListBase& RHICmdList)
+#else
+#define INIT_RHI_SIGNATURE InitRHI()
+#endif
+
+/**
+ * The indices of the grid that heightmaps of a resolution are drawn with. The
+ * grid has a vertex for each sample of the heightmap, and a ring of skirt
+ * vertices around them, and none of them have vertex data of their own.
+ *
+ * A single index buffer is shared by all of the heightmaps of the same
+ * resolution, for as long as any of them are drawn.
+ */
+class FCesiumTerrainGridIndexBuffer : public FIndexBuffer {
+public:
+  FCesiumTerrainGridIndexBuffer(int32 InResolution)
+      : Resolution(InResolution) {}
+
+  /**
+   * Gets the index buffer for a resolution, creating it if no heightmap of
+   * that resolution is drawn yet. Must be called from the render thread.
+   */
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  static TSharedRef<FCesiumTerrainGridIndexBuffer>
+  Acquire(FRHICommandListBase& RHICmdList, int32 Resolution);
+#else
+  static TSharedRef<FCesiumTerrainGridIndexBuffer> Acquire(int32 Resolution);
+#endif
+
+  /**
+   * The number of vertices of the grid, including its skirts.
+   */
+  int32 GetNumVertices() const;
+
+  /**
+   * The number of triangles of the grid, including its skirts.
+   */
+  int32 GetNumTriangles() const;
+
+  virtual void INIT_RHI_SIGNATURE override;
+
+private:
+  const int32 Resolution;
+};
+
+/**
+ * The heights, column and row terms, and texture coordinates of a heightmap
+ * in GPU memory.
+ */
+class FCesiumTerrainHeightmapBuffers : public FRenderResource {
+public:
+  FCesiumTerrainHeightmapBuffers(
+      const CesiumTerrainHeightmap::SharedHeightmap& InHeightmap)
+      : Heightmap(InHeightmap) {}
+
+  virtual void INIT_RHI_SIGNATURE override;
+  virtual void ReleaseRHI() override;
+
+  FTexture2DRHIRef HeightTexture;
+  FBufferRHIRef AxisBuffer;
+  FShaderResourceViewRHIRef AxisSRV;
+  FBufferRHIRef TexCoordBuffer;
+  FShaderResourceViewRHIRef TexCoordSRV;
+
+private:
+  const CesiumTerrainHeightmap::SharedHeightmap Heightmap;
+};
+
+/**
+ * The parameters to be passed as UserData to the shader.
+ */
+struct FCesiumTerrainHeightmapBatchElementUserData {
+  FRHITexture* HeightTexture;
+  FRHIShaderResourceView* AxisBuffer;
+  FRHIShaderResourceView* TexCoordBuffer;
+  FVector2f HeightOffsetAndScale;
+  uint32 Resolution;
+  uint32 NumTexCoords;
+  float SkirtHeight;
+  FVector3f HeightmapOrigin;
+  FMatrix44f EcefToLocal;
+};
+
+class FCesiumTerrainHeightmapBatchElementUserDataWrapper
+    : public FOneFrameResource {
+public:
+  FCesiumTerrainHeightmapBatchElementUserData Data;
+};
+
+/**
+ * Draws terrain from a heightmap, by displacing the vertices of a
+ * FCesiumTerrainGridIndexBuffer in the vertex shader. Requires manual vertex
+ * fetch.
+ */
+class FCesiumTerrainHeightmapVertexFactory : public FLocalVertexFactory {
+
+  DECLARE_VERTEX_FACTORY_TYPE(FCesiumTerrainHeightmapVertexFactory);
+
+public:
+  FCesiumTerrainHeightmapVertexFactory(ERHIFeatureLevel::Type InFeatureLevel);
+
+  static bool ShouldCompilePermutation(
+      const FVertexFactoryShaderPermutationParameters& Parameters);
+
+  /**
+   * Gets the vertex declaration that PSOs are precached with, which is the
+   * same for all heightmaps.
+   */
+  static void GetPSOPrecacheVertexFetchElements(
+      EVertexInputStreamType VertexInputStreamType,
+      FVertexDeclarationElementList& Elements);
+
+private:
+  virtual void INIT_RHI_SIGNATURE override;
+  virtual void ReleaseRHI() override;
+};
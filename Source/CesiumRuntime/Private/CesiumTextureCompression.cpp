@@ -0,0 +1,577 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureCompression.h"
+#include "PixelFormat.h"
+#include "RHI.h"
+#include <CesiumGltf/ImageCesium.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+
+// The texels of a 4x4 block, in row-major order, as RGBA.
+using Block = std::array<std::array<int32_t, 4>, 16>;
+
+void readBlock(
+    const std::byte* pPixels,
+    int32_t width,
+    int32_t height,
+    int32_t channels,
+    int32_t blockX,
+    int32_t blockY,
+    Block& block) {
+  for (int32_t y = 0; y < 4; ++y) {
+    // Blocks at the edge of mips smaller than the block are filled by
+    // repeating the last row or column.
+    const int32_t sourceY = std::min(blockY * 4 + y, height - 1);
+    for (int32_t x = 0; x < 4; ++x) {
+      const int32_t sourceX = std::min(blockX * 4 + x, width - 1);
+      const std::byte* pTexel =
+          pPixels + (size_t(sourceY) * size_t(width) + size_t(sourceX)) *
+                        size_t(channels);
+      std::array<int32_t, 4>& texel = block[y * 4 + x];
+      texel[0] = int32_t(pTexel[0]);
+      texel[1] = int32_t(pTexel[1]);
+      texel[2] = int32_t(pTexel[2]);
+      texel[3] = channels == 4 ? int32_t(pTexel[3]) : 255;
+    }
+  }
+}
+
+int32_t squaredColorDistance(
+    const std::array<int32_t, 4>& a,
+    const std::array<int32_t, 3>& b) {
+  const int32_t dr = a[0] - b[0];
+  const int32_t dg = a[1] - b[1];
+  const int32_t db = a[2] - b[2];
+  return dr * dr + dg * dg + db * db;
+}
+
+uint16_t packRgb565(const std::array<int32_t, 4>& color) {
+  const uint16_t r = uint16_t((color[0] * 31 + 127) / 255);
+  const uint16_t g = uint16_t((color[1] * 63 + 127) / 255);
+  const uint16_t b = uint16_t((color[2] * 31 + 127) / 255);
+  return uint16_t((r << 11) | (g << 5) | b);
+}
+
+std::array<int32_t, 3> unpackRgb565(uint16_t packed) {
+  const int32_t r = (packed >> 11) & 0x1f;
+  const int32_t g = (packed >> 5) & 0x3f;
+  const int32_t b = packed & 0x1f;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/**
+ * Writes the 8-byte BC1 color block for the block, using the four-color mode.
+ * The endpoints are the texels at either end of the block's principal axis.
+ */
+void encodeBc1ColorBlock(const Block& block, uint8_t* pOut) {
+  double mean[3] = {0.0, 0.0, 0.0};
+  for (const std::array<int32_t, 4>& texel : block) {
+    for (int32_t c = 0; c < 3; ++c) {
+      mean[c] += texel[c];
+    }
+  }
+  for (int32_t c = 0; c < 3; ++c) {
+    mean[c] /= 16.0;
+  }
+
+  double covariance[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  for (const std::array<int32_t, 4>& texel : block) {
+    const double r = texel[0] - mean[0];
+    const double g = texel[1] - mean[1];
+    const double b = texel[2] - mean[2];
+    covariance[0] += r * r;
+    covariance[1] += r * g;
+    covariance[2] += r * b;
+    covariance[3] += g * g;
+    covariance[4] += g * b;
+    covariance[5] += b * b;
+  }
+
+  // A few steps of power iteration are enough to find the principal axis.
+  double axis[3] = {1.0, 1.0, 1.0};
+  for (int32_t i = 0; i < 4; ++i) {
+    const double r = covariance[0] * axis[0] + covariance[1] * axis[1] +
+                     covariance[2] * axis[2];
+    const double g = covariance[1] * axis[0] + covariance[3] * axis[1] +
+                     covariance[4] * axis[2];
+    const double b = covariance[2] * axis[0] + covariance[4] * axis[1] +
+                     covariance[5] * axis[2];
+    const double length = std::max({std::abs(r), std::abs(g), std::abs(b)});
+    if (length <= 0.0) {
+      break;
+    }
+    axis[0] = r / length;
+    axis[1] = g / length;
+    axis[2] = b / length;
+  }
+
+  int32_t minimumIndex = 0;
+  int32_t maximumIndex = 0;
+  double minimum = std::numeric_limits<double>::max();
+  double maximum = std::numeric_limits<double>::lowest();
+  for (int32_t i = 0; i < 16; ++i) {
+    const double projection = block[i][0] * axis[0] + block[i][1] * axis[1] +
+                              block[i][2] * axis[2];
+    if (projection < minimum) {
+      minimum = projection;
+      minimumIndex = i;
+    }
+    if (projection > maximum) {
+      maximum = projection;
+      maximumIndex = i;
+    }
+  }
+
+  uint16_t color0 = packRgb565(block[maximumIndex]);
+  uint16_t color1 = packRgb565(block[minimumIndex]);
+  if (color0 < color1) {
+    std::swap(color0, color1);
+  }
+
+  uint32_t indices = 0;
+  if (color0 != color1) {
+    const std::array<int32_t, 3> endpoint0 = unpackRgb565(color0);
+    const std::array<int32_t, 3> endpoint1 = unpackRgb565(color1);
+    std::array<std::array<int32_t, 3>, 4> palette;
+    palette[0] = endpoint0;
+    palette[1] = endpoint1;
+    for (int32_t c = 0; c < 3; ++c) {
+      palette[2][c] = (2 * endpoint0[c] + endpoint1[c]) / 3;
+      palette[3][c] = (endpoint0[c] + 2 * endpoint1[c]) / 3;
+    }
+
+    for (int32_t i = 0; i < 16; ++i) {
+      uint32_t best = 0;
+      int32_t bestDistance = std::numeric_limits<int32_t>::max();
+      for (uint32_t p = 0; p < 4; ++p) {
+        const int32_t distance = squaredColorDistance(block[i], palette[p]);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = p;
+        }
+      }
+      indices |= best << (i * 2);
+    }
+  }
+
+  pOut[0] = uint8_t(color0 & 0xff);
+  pOut[1] = uint8_t(color0 >> 8);
+  pOut[2] = uint8_t(color1 & 0xff);
+  pOut[3] = uint8_t(color1 >> 8);
+  for (int32_t i = 0; i < 4; ++i) {
+    pOut[4 + i] = uint8_t((indices >> (i * 8)) & 0xff);
+  }
+}
+
+/**
+ * Writes the 8-byte BC3 alpha block for the block, using the eight-value mode
+ * between the smallest and largest alpha.
+ */
+void encodeBc3AlphaBlock(const Block& block, uint8_t* pOut) {
+  int32_t alpha0 = 0;
+  int32_t alpha1 = 255;
+  for (const std::array<int32_t, 4>& texel : block) {
+    alpha0 = std::max(alpha0, texel[3]);
+    alpha1 = std::min(alpha1, texel[3]);
+  }
+
+  uint64_t indices = 0;
+  if (alpha0 != alpha1) {
+    int32_t palette[8];
+    palette[0] = alpha0;
+    palette[1] = alpha1;
+    for (int32_t i = 1; i < 7; ++i) {
+      palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+    }
+
+    for (int32_t i = 0; i < 16; ++i) {
+      uint64_t best = 0;
+      int32_t bestDistance = std::numeric_limits<int32_t>::max();
+      for (uint64_t p = 0; p < 8; ++p) {
+        const int32_t distance = std::abs(block[i][3] - palette[p]);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          best = p;
+        }
+      }
+      indices |= best << (i * 3);
+    }
+  }
+
+  pOut[0] = uint8_t(alpha0);
+  pOut[1] = uint8_t(alpha1);
+  for (int32_t i = 0; i < 6; ++i) {
+    pOut[2 + i] = uint8_t((indices >> (i * 8)) & 0xff);
+  }
+}
+
+// The ETC1 intensity modifier tables. Each table's modifiers are, by pixel
+// index, {a, b, -a, -b}.
+constexpr int32_t etcModifiers[8][2] = {
+    {2, 8},
+    {5, 17},
+    {9, 29},
+    {13, 42},
+    {18, 60},
+    {24, 80},
+    {33, 106},
+    {47, 183}};
+
+// The EAC alpha modifier tables, by table index and pixel index.
+constexpr int32_t eacModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+int32_t clampByte(int32_t value) { return std::clamp(value, 0, 255); }
+
+struct EtcSubblock {
+  int32_t base[3];
+  int32_t table;
+  // The 2-bit pixel index of each texel of the block in the subblock.
+  uint32_t indices[16];
+  int64_t error;
+};
+
+/**
+ * Finds the quantized base color and modifier table that best represent the
+ * given texels of a block, in the ETC1 individual mode.
+ */
+void encodeEtcSubblock(
+    const Block& block,
+    const int32_t* pTexels,
+    EtcSubblock& result) {
+  int32_t sum[3] = {0, 0, 0};
+  for (int32_t i = 0; i < 8; ++i) {
+    for (int32_t c = 0; c < 3; ++c) {
+      sum[c] += block[pTexels[i]][c];
+    }
+  }
+
+  int32_t expanded[3];
+  for (int32_t c = 0; c < 3; ++c) {
+    result.base[c] = ((sum[c] / 8) * 15 + 127) / 255;
+    expanded[c] = (result.base[c] << 4) | result.base[c];
+  }
+
+  result.error = std::numeric_limits<int64_t>::max();
+  for (int32_t table = 0; table < 8; ++table) {
+    const int32_t modifiers[4] = {
+        etcModifiers[table][0],
+        etcModifiers[table][1],
+        -etcModifiers[table][0],
+        -etcModifiers[table][1]};
+
+    int64_t error = 0;
+    uint32_t indices[16];
+    for (int32_t i = 0; i < 8; ++i) {
+      const std::array<int32_t, 4>& texel = block[pTexels[i]];
+      int32_t bestDistance = std::numeric_limits<int32_t>::max();
+      for (uint32_t m = 0; m < 4; ++m) {
+        const std::array<int32_t, 3> candidate = {
+            clampByte(expanded[0] + modifiers[m]),
+            clampByte(expanded[1] + modifiers[m]),
+            clampByte(expanded[2] + modifiers[m])};
+        const int32_t distance = squaredColorDistance(texel, candidate);
+        if (distance < bestDistance) {
+          bestDistance = distance;
+          indices[pTexels[i]] = m;
+        }
+      }
+      error += bestDistance;
+    }
+
+    if (error < result.error) {
+      result.error = error;
+      result.table = table;
+      for (int32_t i = 0; i < 8; ++i) {
+        result.indices[pTexels[i]] = indices[pTexels[i]];
+      }
+    }
+  }
+}
+
+/**
+ * Writes the 8-byte ETC2 color block for the block, using the ETC1-compatible
+ * individual mode with whichever subblock orientation fits it better.
+ */
+void encodeEtc2ColorBlock(const Block& block, uint8_t* pOut) {
+  // The texels of each subblock, indexed in row-major order. Without a flip
+  // the subblocks are the left and right halves of the block; with a flip,
+  // they are the top and bottom halves.
+  constexpr int32_t subblockTexels[2][2][8] = {
+      {{0, 1, 4, 5, 8, 9, 12, 13}, {2, 3, 6, 7, 10, 11, 14, 15}},
+      {{0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}}};
+
+  EtcSubblock best[2];
+  int32_t bestFlip = 0;
+  int64_t bestError = std::numeric_limits<int64_t>::max();
+  for (int32_t flip = 0; flip < 2; ++flip) {
+    EtcSubblock subblocks[2];
+    encodeEtcSubblock(block, subblockTexels[flip][0], subblocks[0]);
+    encodeEtcSubblock(block, subblockTexels[flip][1], subblocks[1]);
+    const int64_t error = subblocks[0].error + subblocks[1].error;
+    if (error < bestError) {
+      bestError = error;
+      bestFlip = flip;
+      best[0] = subblocks[0];
+      best[1] = subblocks[1];
+    }
+  }
+
+  pOut[0] = uint8_t((best[0].base[0] << 4) | best[1].base[0]);
+  pOut[1] = uint8_t((best[0].base[1] << 4) | best[1].base[1]);
+  pOut[2] = uint8_t((best[0].base[2] << 4) | best[1].base[2]);
+  pOut[3] =
+      uint8_t((best[0].table << 5) | (best[1].table << 2) | bestFlip);
+
+  // The pixel indices are stored in column-major order, with the most
+  // significant bits of all sixteen indices first.
+  uint32_t bits = 0;
+  for (int32_t subblock = 0; subblock < 2; ++subblock) {
+    for (int32_t i = 0; i < 8; ++i) {
+      const int32_t texel = subblockTexels[bestFlip][subblock][i];
+      const int32_t position = (texel % 4) * 4 + texel / 4;
+      const uint32_t index = best[subblock].indices[texel];
+      bits |= ((index >> 1) & 1) << (position + 16);
+      bits |= (index & 1) << position;
+    }
+  }
+
+  pOut[4] = uint8_t(bits >> 24);
+  pOut[5] = uint8_t(bits >> 16);
+  pOut[6] = uint8_t(bits >> 8);
+  pOut[7] = uint8_t(bits);
+}
+
+/**
+ * Writes the 8-byte EAC alpha block of an ETC2 RGBA block for the block.
+ */
+void encodeEacAlphaBlock(const Block& block, uint8_t* pOut) {
+  int32_t minimum = 255;
+  int32_t maximum = 0;
+  for (const std::array<int32_t, 4>& texel : block) {
+    minimum = std::min(minimum, texel[3]);
+    maximum = std::max(maximum, texel[3]);
+  }
+
+  int32_t bestBase = minimum;
+  int32_t bestMultiplier = 1;
+  // Table 13 has a modifier of zero, which represents a uniform block exactly.
+  int32_t bestTable = 13;
+  uint64_t bestIndices[16];
+  std::fill(std::begin(bestIndices), std::end(bestIndices), 4);
+
+  if (minimum != maximum) {
+    int64_t bestError = std::numeric_limits<int64_t>::max();
+    for (int32_t table = 0; table < 16; ++table) {
+      const int32_t lowest = eacModifiers[table][3];
+      const int32_t highest = eacModifiers[table][7];
+      const int32_t range = highest - lowest;
+      const int32_t estimate = std::clamp(
+          (maximum - minimum + range / 2) / range,
+          1,
+          15);
+
+      for (int32_t multiplier = std::max(estimate - 1, 1);
+           multiplier <= std::min(estimate + 1, 15);
+           ++multiplier) {
+        const int32_t base = clampByte(
+            (minimum + maximum - (lowest + highest) * multiplier + 1) / 2);
+
+        int64_t error = 0;
+        uint64_t indices[16];
+        for (int32_t i = 0; i < 16; ++i) {
+          int32_t bestDistance = std::numeric_limits<int32_t>::max();
+          for (uint64_t m = 0; m < 8; ++m) {
+            const int32_t value =
+                clampByte(base + eacModifiers[table][m] * multiplier);
+            const int32_t distance = std::abs(block[i][3] - value);
+            if (distance < bestDistance) {
+              bestDistance = distance;
+              indices[i] = m;
+            }
+          }
+          error += int64_t(bestDistance) * bestDistance;
+        }
+
+        if (error < bestError) {
+          bestError = error;
+          bestBase = base;
+          bestMultiplier = multiplier;
+          bestTable = table;
+          std::copy(std::begin(indices), std::end(indices), bestIndices);
+        }
+      }
+    }
+  }
+
+  // The 3-bit pixel indices are stored in column-major order, starting from
+  // the most significant bits.
+  uint64_t bits = 0;
+  for (int32_t i = 0; i < 16; ++i) {
+    const int32_t position = (i % 4) * 4 + i / 4;
+    bits |= bestIndices[i] << (45 - position * 3);
+  }
+
+  pOut[0] = uint8_t(bestBase);
+  pOut[1] = uint8_t((bestMultiplier << 4) | bestTable);
+  for (int32_t i = 0; i < 6; ++i) {
+    pOut[2 + i] = uint8_t((bits >> (40 - i * 8)) & 0xff);
+  }
+}
+
+bool hasTransparentTexels(const ImageCesium& image) {
+  if (image.channels != 4) {
+    return false;
+  }
+
+  for (size_t i = 3; i < image.pixelData.size(); i += 4) {
+    if (image.pixelData[i] != std::byte(255)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+namespace CesiumTextureCompression {
+
+GpuCompressedPixelFormat getTargetFormat(bool hasAlpha) {
+  if (hasAlpha && GPixelFormats[PF_DXT5].Supported) {
+    return GpuCompressedPixelFormat::BC3_RGBA;
+  }
+  if (!hasAlpha && GPixelFormats[PF_DXT1].Supported) {
+    return GpuCompressedPixelFormat::BC1_RGB;
+  }
+  if (GPixelFormats[PF_ETC2_RGBA].Supported) {
+    return GpuCompressedPixelFormat::ETC2_RGBA;
+  }
+  return GpuCompressedPixelFormat::NONE;
+}
+
+bool compressImage(ImageCesium& image) {
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
+    return false;
+  }
+
+  const GpuCompressedPixelFormat format =
+      getTargetFormat(hasTransparentTexels(image));
+  if (format == GpuCompressedPixelFormat::NONE) {
+    return false;
+  }
+
+  return compressImage(image, format);
+}
+
+bool compressImage(ImageCesium& image, GpuCompressedPixelFormat format) {
+  if (image.compressedPixelFormat != GpuCompressedPixelFormat::NONE ||
+      image.bytesPerChannel != 1 ||
+      (image.channels != 3 && image.channels != 4) || image.width <= 0 ||
+      image.height <= 0 || image.width % 4 != 0 || image.height % 4 != 0) {
+    return false;
+  }
+
+  size_t blockBytes;
+  switch (format) {
+  case GpuCompressedPixelFormat::BC1_RGB:
+    blockBytes = 8;
+    break;
+  case GpuCompressedPixelFormat::BC3_RGBA:
+  case GpuCompressedPixelFormat::ETC2_RGBA:
+    blockBytes = 16;
+    break;
+  default:
+    return false;
+  }
+
+  std::vector<ImageCesiumMipPosition> sourceMips = image.mipPositions;
+  if (sourceMips.empty()) {
+    sourceMips.push_back({0, image.pixelData.size()});
+  }
+
+  std::vector<std::byte> compressed;
+  std::vector<ImageCesiumMipPosition> compressedMips;
+  compressedMips.reserve(sourceMips.size());
+
+  for (size_t mip = 0; mip < sourceMips.size(); ++mip) {
+    const int32_t width = std::max(image.width >> mip, 1);
+    const int32_t height = std::max(image.height >> mip, 1);
+    const ImageCesiumMipPosition& source = sourceMips[mip];
+    if (source.byteOffset + size_t(width) * size_t(height) *
+                                size_t(image.channels) >
+        image.pixelData.size()) {
+      return false;
+    }
+
+    const int32_t blocksX = (width + 3) / 4;
+    const int32_t blocksY = (height + 3) / 4;
+    const size_t byteOffset = compressed.size();
+    const size_t byteSize = size_t(blocksX) * size_t(blocksY) * blockBytes;
+    compressed.resize(byteOffset + byteSize);
+    compressedMips.push_back({byteOffset, byteSize});
+
+    const std::byte* pPixels = image.pixelData.data() + source.byteOffset;
+    uint8_t* pOut = reinterpret_cast<uint8_t*>(compressed.data() + byteOffset);
+    Block block;
+    for (int32_t blockY = 0; blockY < blocksY; ++blockY) {
+      for (int32_t blockX = 0; blockX < blocksX; ++blockX) {
+        readBlock(
+            pPixels,
+            width,
+            height,
+            image.channels,
+            blockX,
+            blockY,
+            block);
+
+        switch (format) {
+        case GpuCompressedPixelFormat::BC1_RGB:
+          encodeBc1ColorBlock(block, pOut);
+          break;
+        case GpuCompressedPixelFormat::BC3_RGBA:
+          encodeBc3AlphaBlock(block, pOut);
+          encodeBc1ColorBlock(block, pOut + 8);
+          break;
+        default:
+          encodeEacAlphaBlock(block, pOut);
+          encodeEtc2ColorBlock(block, pOut + 8);
+          break;
+        }
+        pOut += blockBytes;
+      }
+    }
+  }
+
+  image.pixelData = std::move(compressed);
+  if (!image.mipPositions.empty()) {
+    image.mipPositions = std::move(compressedMips);
+  }
+  image.compressedPixelFormat = format;
+  return true;
+}
+
+} // namespace CesiumTextureCompression
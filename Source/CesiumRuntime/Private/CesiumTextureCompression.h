@@ -0,0 +1,53 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
+
+namespace CesiumGltf {
+struct ImageCesium;
+} // namespace CesiumGltf
+
+namespace CesiumTextureCompression {
+
+/**
+ * @brief Gets the block-compressed format that uncompressed images are
+ * compressed to on this platform: BC1 or BC3 where the RHI supports them,
+ * otherwise ETC2, otherwise none.
+ *
+ * @param hasAlpha Whether the image to compress has any texels that are not
+ * fully opaque.
+ */
+CesiumGltf::GpuCompressedPixelFormat getTargetFormat(bool hasAlpha);
+
+/**
+ * @brief Block-compresses an 8-bit RGB or RGBA image, and any mips it has,
+ * into the format returned by {@link getTargetFormat}. Should be called in a
+ * worker thread, before the image is passed to
+ * `CesiumTextureUtility::loadTextureAnyThreadPart`.
+ *
+ * This reduces the memory taken by the texture on the GPU to between one
+ * quarter and one eighth, at a small cost in quality. It is best suited to
+ * color textures; normal maps and other data lose more to the compression.
+ *
+ * @param image The image to compress in place.
+ * @return True if the image was compressed. False if it is already
+ * compressed, is not an 8-bit RGB or RGBA image, its width or height is not a
+ * multiple of four, or the platform supports no suitable format. In that case,
+ * the image is left as it is.
+ */
+bool compressImage(CesiumGltf::ImageCesium& image);
+
+/**
+ * @brief Block-compresses an image into the given format. See
+ * {@link compressImage}.
+ *
+ * @param image The image to compress in place.
+ * @param format The format to compress to, which must be `BC1_RGB`,
+ * `BC3_RGBA`, or `ETC2_RGBA`.
+ */
+bool compressImage(
+    CesiumGltf::ImageCesium& image,
+    CesiumGltf::GpuCompressedPixelFormat format);
+
+} // namespace CesiumTextureCompression
@@ -0,0 +1,345 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureResidency.h"
+#include "CesiumCamera.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTextureResource.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstance.h"
+#include "RenderingThread.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+/**
+ * The number of frames between evaluations of the resident mips.
+ */
+constexpr uint64 FramesPerUpdate = 8;
+
+/**
+ * The maximum number of textures whose released mips are restored in one
+ * evaluation, which limits the amount of pixel data uploaded at once.
+ */
+constexpr size_t MaximumRestoresPerUpdate = 32;
+
+struct ResidentTexture {
+  TWeakObjectPtr<UTexture2D> pTexture;
+  FCesiumTextureResourceBase* pResource;
+
+  // The larger dimension of the texture's most detailed mip.
+  uint32 size;
+
+  // residentBytes[i] is the size of mips i and beyond.
+  std::vector<uint64> residentBytes;
+
+  uint32 maximumFirstMip;
+  uint32 firstResidentMip;
+  uint32 targetFirstMip;
+
+  // The largest size on screen, in pixels, of a rendered tile using this
+  // texture, or a negative value if no rendered tile uses it.
+  double screenPixels;
+};
+
+struct TextureResidency {
+  std::unordered_map<UTexture2D*, ResidentTexture> textures;
+  uint64 gatheringFrame = 0;
+  uint64 residentBytes = 0;
+};
+
+TextureResidency& getTextureResidency() {
+  static TextureResidency residency;
+  return residency;
+}
+
+uint64 getTextureMemoryBudget() {
+  return uint64(GetDefault<UCesiumRuntimeSettings>()->TextureMemoryBudgetMB) *
+         1024 * 1024;
+}
+
+double computeScreenPixels(
+    const FBoxSphereBounds& bounds,
+    const FCesiumCamera& camera) {
+  const double distance = FVector::Distance(bounds.Origin, camera.Location) -
+                          bounds.SphereRadius;
+  if (distance <= 0.0 || camera.FieldOfViewDegrees <= 0.0) {
+    // The camera is inside the bounds, so all the detail may be needed.
+    return TNumericLimits<double>::Max();
+  }
+
+  const double tanHalfFov =
+      FMath::Tan(FMath::DegreesToRadians(camera.FieldOfViewDegrees * 0.5));
+  return bounds.SphereRadius * camera.ViewportSize.X / (distance * tanHalfFov);
+}
+
+uint32 computeFootprintFirstMip(const ResidentTexture& texture) {
+  if (texture.screenPixels >= double(texture.size)) {
+    return 0;
+  }
+
+  const double texelsPerPixel =
+      double(texture.size) / FMath::Max(texture.screenPixels, 1.0);
+  return FMath::Min(
+      uint32(FMath::FloorToInt(FMath::Log2(texelsPerPixel))),
+      texture.maximumFirstMip);
+}
+
+} // namespace
+
+namespace CesiumTextureResidency {
+
+bool isEnabled() { return getTextureMemoryBudget() > 0; }
+
+uint32 getInitialFirstMip(uint32 width, uint32 height) {
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  if (!pSettings->ProgressiveTextureLoading) {
+    return 0;
+  }
+
+  const uint32 initialSize =
+      uint32(FMath::Max(pSettings->ProgressiveTextureInitialSize, 1));
+  uint32 size = FMath::Max(width, height);
+  uint32 result = 0;
+  while (size > initialSize) {
+    size >>= 1;
+    ++result;
+  }
+  return result;
+}
+
+void registerTexture(
+    UTexture2D* pTexture,
+    FCesiumTextureResourceBase* pResource) {
+  check(IsInGameThread());
+
+  if (!pTexture || !pResource) {
+    return;
+  }
+
+  std::vector<uint64> mipSizes = pResource->getMipSizes();
+  if (mipSizes.size() < 2) {
+    return;
+  }
+
+  ResidentTexture texture;
+  texture.pTexture = pTexture;
+  texture.pResource = pResource;
+  texture.size = FMath::Max(pResource->GetSizeX(), pResource->GetSizeY());
+  texture.residentBytes.resize(mipSizes.size());
+  uint64 bytes = 0;
+  for (size_t i = mipSizes.size(); i > 0; --i) {
+    bytes += mipSizes[i - 1];
+    texture.residentBytes[i - 1] = bytes;
+  }
+  texture.maximumFirstMip = pResource->getMaximumFirstResidentMip();
+  texture.firstResidentMip =
+      FMath::Min(pResource->getFirstResidentMip(), texture.maximumFirstMip);
+  texture.targetFirstMip = texture.firstResidentMip;
+  texture.screenPixels = -1.0;
+
+  TextureResidency& residency = getTextureResidency();
+  auto it = residency.textures.find(pTexture);
+  if (it != residency.textures.end()) {
+    // A texture that was destroyed had the same address.
+    const ResidentTexture& old = it->second;
+    residency.residentBytes -= old.residentBytes[old.firstResidentMip];
+    residency.textures.erase(it);
+  }
+
+  residency.residentBytes += texture.residentBytes[texture.firstResidentMip];
+  residency.textures.emplace(pTexture, std::move(texture));
+}
+
+bool isGatheringFootprints() {
+  check(IsInGameThread());
+
+  const TextureResidency& residency = getTextureResidency();
+  return !residency.textures.empty() &&
+         residency.gatheringFrame == GFrameCounter;
+}
+
+void addRenderedComponents(
+    const std::vector<FCesiumCamera>& cameras,
+    const TArray<UCesiumGltfComponent*>& components) {
+  check(IsInGameThread());
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GatherTextureFootprints)
+
+  TextureResidency& residency = getTextureResidency();
+
+  for (UCesiumGltfComponent* pGltf : components) {
+    if (!IsValid(pGltf)) {
+      continue;
+    }
+
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+      if (!IsValid(pPrimitive) || !pPrimitive->IsVisible()) {
+        continue;
+      }
+
+      double screenPixels = 0.0;
+      for (const FCesiumCamera& camera : cameras) {
+        screenPixels = FMath::Max(
+            screenPixels,
+            computeScreenPixels(pPrimitive->Bounds, camera));
+      }
+
+      for (int32 i = 0; i < pPrimitive->GetNumMaterials(); ++i) {
+        const UMaterialInstance* pMaterial =
+            Cast<UMaterialInstance>(pPrimitive->GetMaterial(i));
+        if (!pMaterial) {
+          continue;
+        }
+
+        for (const FTextureParameterValue& parameter :
+             pMaterial->TextureParameterValues) {
+          UTexture2D* pTexture = Cast<UTexture2D>(parameter.ParameterValue);
+          auto it = residency.textures.find(pTexture);
+          if (it != residency.textures.end()) {
+            it->second.screenPixels =
+                FMath::Max(it->second.screenPixels, screenPixels);
+          }
+        }
+      }
+    }
+  }
+}
+
+void update() {
+  check(IsInGameThread());
+
+  TextureResidency& residency = getTextureResidency();
+
+  for (auto it = residency.textures.begin(); it != residency.textures.end();) {
+    const ResidentTexture& texture = it->second;
+    UTexture2D* pTexture = texture.pTexture.Get();
+    if (!pTexture || pTexture->GetResource() != texture.pResource) {
+      residency.residentBytes -=
+          texture.residentBytes[texture.firstResidentMip];
+      it = residency.textures.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  if (residency.gatheringFrame >= GFrameCounter) {
+    return;
+  }
+
+  // The sizes on screen were gathered during an earlier frame, which is
+  // when the budget is applied, and the next ones are gathered a few frames
+  // from now.
+  residency.gatheringFrame = GFrameCounter + FramesPerUpdate - 1;
+
+  if (residency.textures.empty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTextureResidency)
+
+  const uint64 budget = getTextureMemoryBudget();
+
+  std::vector<ResidentTexture*> rendered;
+  std::vector<ResidentTexture*> notRendered;
+  uint64 targetBytes = 0;
+
+  for (auto& pair : residency.textures) {
+    ResidentTexture& texture = pair.second;
+    if (budget == 0) {
+      texture.targetFirstMip = 0;
+    } else if (texture.screenPixels >= 0.0) {
+      texture.targetFirstMip = computeFootprintFirstMip(texture);
+      rendered.emplace_back(&texture);
+    } else {
+      texture.targetFirstMip = texture.firstResidentMip;
+      notRendered.emplace_back(&texture);
+    }
+    targetBytes += texture.residentBytes[texture.targetFirstMip];
+  }
+
+  if (budget > 0 && targetBytes > budget) {
+    for (ResidentTexture* pTexture : notRendered) {
+      targetBytes -= pTexture->residentBytes[pTexture->targetFirstMip];
+      pTexture->targetFirstMip = pTexture->maximumFirstMip;
+      targetBytes += pTexture->residentBytes[pTexture->targetFirstMip];
+    }
+
+    std::vector<uint32> footprintFirstMips;
+    footprintFirstMips.reserve(rendered.size());
+    for (ResidentTexture* pTexture : rendered) {
+      footprintFirstMips.emplace_back(pTexture->targetFirstMip);
+    }
+
+    // Release one more mip of every rendered texture at a time, until the
+    // textures fit or only their least detailed mips remain.
+    bool changed = true;
+    for (uint32 bias = 1; targetBytes > budget && changed; ++bias) {
+      changed = false;
+      for (size_t i = 0; i < rendered.size(); ++i) {
+        ResidentTexture* pTexture = rendered[i];
+        const uint32 firstMip = FMath::Min(
+            footprintFirstMips[i] + bias,
+            pTexture->maximumFirstMip);
+        if (firstMip != pTexture->targetFirstMip) {
+          targetBytes -= pTexture->residentBytes[pTexture->targetFirstMip];
+          pTexture->targetFirstMip = firstMip;
+          targetBytes += pTexture->residentBytes[firstMip];
+          changed = true;
+        }
+      }
+    }
+  }
+
+  // Mips are released right away, but only a limited number of textures are
+  // restored each time, those largest on screen first.
+  std::vector<ResidentTexture*> changes;
+  std::vector<ResidentTexture*> restores;
+  for (auto& pair : residency.textures) {
+    ResidentTexture& texture = pair.second;
+    if (texture.targetFirstMip > texture.firstResidentMip) {
+      changes.emplace_back(&texture);
+    } else if (texture.targetFirstMip < texture.firstResidentMip) {
+      restores.emplace_back(&texture);
+    }
+  }
+
+  std::sort(
+      restores.begin(),
+      restores.end(),
+      [](const ResidentTexture* pLeft, const ResidentTexture* pRight) {
+        return pLeft->screenPixels > pRight->screenPixels;
+      });
+  if (restores.size() > MaximumRestoresPerUpdate) {
+    restores.resize(MaximumRestoresPerUpdate);
+  }
+  changes.insert(changes.end(), restores.begin(), restores.end());
+
+  // Each resource is released by a render command enqueued after these, so
+  // it's still alive when they run.
+  for (ResidentTexture* pTexture : changes) {
+    residency.residentBytes -=
+        pTexture->residentBytes[pTexture->firstResidentMip];
+    pTexture->firstResidentMip = pTexture->targetFirstMip;
+    residency.residentBytes +=
+        pTexture->residentBytes[pTexture->firstResidentMip];
+
+    FCesiumTextureResourceBase* pResource = pTexture->pResource;
+    const uint32 firstMip = pTexture->firstResidentMip;
+    ENQUEUE_RENDER_COMMAND(Cesium_SetFirstResidentMip)
+    ([pResource, firstMip](FRHICommandListImmediate& RHICmdList) {
+      pResource->setFirstResidentMip(firstMip);
+    });
+  }
+
+  for (auto& pair : residency.textures) {
+    pair.second.screenPixels = -1.0;
+  }
+}
+
+uint64 getResidentBytes() { return getTextureResidency().residentBytes; }
+
+} // namespace CesiumTextureResidency
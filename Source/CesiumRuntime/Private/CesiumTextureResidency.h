@@ -0,0 +1,80 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <vector>
+
+class FCesiumTextureResourceBase;
+class UCesiumGltfComponent;
+class UTexture2D;
+struct FCesiumCamera;
+
+/**
+ * Decides how many of the mips of Cesium's textures are resident on the GPU.
+ *
+ * Cesium creates its textures at runtime, so Unreal's texture streaming can't
+ * release their mips. Instead, when the Texture Memory Budget in the Cesium
+ * runtime settings is not zero, the textures keep their pixel data in main
+ * memory, and every few frames the size on screen of the tiles that are
+ * rendered is compared with the resolution of their textures. The mips more
+ * detailed than a tile needs are released from the GPU and restored when the
+ * tile gets closer. When the textures don't fit within the budget, the most
+ * detailed mips of textures that aren't rendered are released first, and then
+ * those of the textures that are.
+ *
+ * When textures load progressively, new textures with mips are first created
+ * without their most detailed mips, and the same mechanism restores them.
+ */
+namespace CesiumTextureResidency {
+
+/**
+ * @brief Gets whether the resident mips of textures are managed, so new
+ * textures should keep their pixel data. May be called from any thread.
+ */
+bool isEnabled();
+
+/**
+ * @brief Gets the index of the mip that a new texture of the given size, with
+ * mips, is first created with, which is zero unless textures load
+ * progressively. May be called from any thread.
+ */
+uint32 getInitialFirstMip(uint32 width, uint32 height);
+
+/**
+ * @brief Starts managing the resident mips of a texture, if its resource
+ * supports it. Must be called from the game thread.
+ */
+void registerTexture(
+    UTexture2D* pTexture,
+    FCesiumTextureResourceBase* pResource);
+
+/**
+ * @brief Gets whether tilesets should report the tiles they render this frame
+ * with {@link addRenderedComponents}. Must be called from the game thread.
+ */
+bool isGatheringFootprints();
+
+/**
+ * @brief Records the size on screen of the textures used by rendered tiles, as
+ * seen from the given cameras. Must be called from the game thread.
+ */
+void addRenderedComponents(
+    const std::vector<FCesiumCamera>& cameras,
+    const TArray<UCesiumGltfComponent*>& components);
+
+/**
+ * @brief Releases or restores the mips of textures according to the sizes on
+ * screen that were recorded, and forgets textures that were destroyed.
+ * The runtime module calls this at the end of each frame. Must be called from
+ * the game thread.
+ */
+void update();
+
+/**
+ * @brief Gets the total size in bytes of the resident mips of the managed
+ * textures, as requested from the render thread.
+ */
+uint64 getResidentBytes();
+
+} // namespace CesiumTextureResidency
@@ -1,11 +1,71 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumTextureResource.h"
+#include "CesiumTilesetStatistics.h"
+#include "GenerateMips.h"
 #include "Misc/CoreStats.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderResource.h"
 #include "RenderUtils.h"
 
 namespace {
 
+// The most released textures of each size and format that are kept for
+// reuse. Overlay tiles are released and loaded at about the same rate while
+// the camera moves, so a few suffice.
+constexpr int32 MaximumPooledTexturesPerSize = 32;
+
+struct PooledTextureKey {
+  FIntPoint extent;
+  EPixelFormat format;
+  uint8 mipCount;
+  ETextureCreateFlags flags;
+
+  bool operator==(const PooledTextureKey& rhs) const {
+    return this->extent == rhs.extent && this->format == rhs.format &&
+           this->mipCount == rhs.mipCount && this->flags == rhs.flags;
+  }
+
+  friend uint32 GetTypeHash(const PooledTextureKey& key) {
+    return HashCombine(
+        GetTypeHash(key.extent),
+        GetTypeHash(
+            uint64(key.format) | (uint64(key.mipCount) << 8) |
+            (uint64(key.flags) << 16)));
+  }
+};
+
+/**
+ * The RHI textures of released pooled texture resources, which are given to
+ * new resources of the same size and format instead of creating others. Only
+ * used from the render thread. The textures are released along with the RHI.
+ */
+class FCesiumTexturePool : public FRenderResource {
+public:
+  FTextureRHIRef acquire(const PooledTextureKey& key) {
+    TArray<FTextureRHIRef>* pTextures = this->_textures.Find(key);
+    if (!pTextures || pTextures->IsEmpty()) {
+      return nullptr;
+    }
+    return pTextures->Pop(false);
+  }
+
+  void release(const PooledTextureKey& key, FTextureRHIRef&& pTexture) {
+    TArray<FTextureRHIRef>& textures = this->_textures.FindOrAdd(key);
+    if (textures.Num() < MaximumPooledTexturesPerSize) {
+      textures.Emplace(MoveTemp(pTexture));
+    }
+  }
+
+  virtual void ReleaseRHI() override { this->_textures.Empty(); }
+
+private:
+  TMap<PooledTextureKey, TArray<FTextureRHIRef>> _textures;
+};
+
+TGlobalResource<FCesiumTexturePool> GCesiumTexturePool;
+
 ESamplerFilter convertFilter(TextureFilter filter) {
   switch (filter) {
   case TF_Nearest:
@@ -119,7 +179,8 @@ FCesiumTextureResourceBase::FCesiumTextureResourceBase(
       _addressX(convertAddressMode(addressX)),
       _addressY(convertAddressMode(addressY)),
       _useMipsIfAvailable(useMipsIfAvailable),
-      _platformExtData(extData) {
+      _platformExtData(extData),
+      _textureSize(0) {
   this->bGreyScaleFormat = (_format == PF_G8) || (_format == PF_BC4);
   this->bSRGB = sRGB;
   STAT(this->_lodGroupStatName = TextureGroupStatFNames[this->_textureGroup]);
@@ -160,18 +221,35 @@ void FCesiumTextureResourceBase::InitRHI() {
   this->DeferredPassSamplerStateRHI =
       GetOrCreateSamplerState(deferredSamplerStateInitializer);
 
+  double startTime = FPlatformTime::Seconds();
   this->TextureRHI = this->InitializeTextureRHI();
+  UCesiumTilesetStatistics::RecordStage(
+      ECesiumTileLoadStage::TextureCreation,
+      (FPlatformTime::Seconds() - startTime) * 1000.0);
 
   RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
 
+  this->updateTextureMemoryStats();
+}
+
+void FCesiumTextureResourceBase::updateTextureMemoryStats() {
 #if STATS
+  DEC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
+  DEC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+  this->_textureSize = 0;
+
+  if (!this->TextureRHI) {
+    return;
+  }
+
   ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
   if (this->bSRGB) {
     textureFlags |= TexCreate_SRGB;
   }
 
+  const FIntVector size = this->TextureRHI->GetSizeXYZ();
   const FIntPoint MipExtents =
-      CalcMipMapExtent(this->_width, this->_height, this->_format, 0);
+      CalcMipMapExtent(uint32(size.X), uint32(size.Y), this->_format, 0);
   uint32 alignment;
   this->_textureSize = RHICalcTexture2DPlatformSize(
       MipExtents.X,
@@ -191,6 +269,7 @@ void FCesiumTextureResourceBase::InitRHI() {
 void FCesiumTextureResourceBase::ReleaseRHI() {
   DEC_DWORD_STAT_BY(STAT_TextureMemory, this->_textureSize);
   DEC_DWORD_STAT_FNAME_BY(this->_lodGroupStatName, this->_textureSize);
+  this->_textureSize = 0;
 
   RHIUpdateTextureReference(TextureReferenceRHI, nullptr);
 
@@ -295,7 +374,11 @@ FCesiumCreateNewTextureResource::FCesiumCreateNewTextureResource(
     TextureAddress addressY,
     bool sRGB,
     bool useMipsIfAvailable,
-    uint32 extData)
+    uint32 extData,
+    bool generateMips,
+    bool retainImage,
+    bool pooled,
+    uint32 initialFirstMip)
     : FCesiumTextureResourceBase(
           textureGroup,
           width,
@@ -307,9 +390,133 @@ FCesiumCreateNewTextureResource::FCesiumCreateNewTextureResource(
           sRGB,
           useMipsIfAvailable,
           extData),
-      _image(std::move(image)) {}
+      _image(std::move(image)),
+      _generateMips(generateMips && this->_image.mipPositions.empty()),
+      _retainImage(
+          (retainImage || initialFirstMip > 0) &&
+          this->_image.mipPositions.size() > 1),
+      _releaseImageWhenResident(!retainImage),
+      _pooled(false),
+      _firstResidentMip(0) {
+  this->_firstResidentMip =
+      FMath::Min(initialFirstMip, this->getMaximumFirstResidentMip());
+
+  // An image that was only kept to restore the initially released mips isn't
+  // needed if none of them could be released.
+  if (this->_firstResidentMip == 0 && this->_releaseImageWhenResident) {
+    this->_retainImage = false;
+  }
+
+  this->_pooled = pooled && !this->_retainImage;
+}
+
+void FCesiumCreateNewTextureResource::ReleaseRHI() {
+  FTextureRHIRef pTexture = this->TextureRHI;
+
+  FCesiumTextureResourceBase::ReleaseRHI();
+
+  if (this->_pooled && pTexture) {
+    const FRHITextureDesc& desc = pTexture->GetDesc();
+    GCesiumTexturePool.release(
+        PooledTextureKey{desc.Extent, desc.Format, desc.NumMips, desc.Flags},
+        MoveTemp(pTexture));
+  }
+}
+
+std::vector<uint64> FCesiumCreateNewTextureResource::getMipSizes() const {
+  std::vector<uint64> result;
+  if (!this->_retainImage) {
+    return result;
+  }
+
+  result.reserve(this->_image.mipPositions.size());
+  for (const CesiumGltf::ImageCesiumMipPosition& mipPosition :
+       this->_image.mipPositions) {
+    result.emplace_back(uint64(mipPosition.byteSize));
+  }
+  return result;
+}
+
+uint32 FCesiumCreateNewTextureResource::getFirstResidentMip() const {
+  return this->_firstResidentMip;
+}
+
+uint32 FCesiumCreateNewTextureResource::getMaximumFirstResidentMip() const {
+  if (!this->_retainImage) {
+    return 0;
+  }
+
+  // The first resident mip must still be a whole number of blocks of a
+  // block-compressed format.
+  const uint32 blockSizeX = GPixelFormats[this->_format].BlockSizeX;
+  const uint32 blockSizeY = GPixelFormats[this->_format].BlockSizeY;
+
+  uint32 result = 0;
+  while (result + 1 < uint32(this->_image.mipPositions.size())) {
+    const uint32 width = this->_width >> (result + 1);
+    const uint32 height = this->_height >> (result + 1);
+    if (width == 0 || height == 0 || width % blockSizeX != 0 ||
+        height % blockSizeY != 0) {
+      break;
+    }
+    ++result;
+  }
+  return result;
+}
+
+void FCesiumCreateNewTextureResource::setFirstResidentMip(uint32 firstMip) {
+  check(IsInRenderingThread());
+
+  firstMip = FMath::Min(firstMip, this->getMaximumFirstResidentMip());
+  if (firstMip == this->_firstResidentMip) {
+    return;
+  }
+
+  this->_firstResidentMip = firstMip;
+
+  // Once the mips that were released initially are all restored, the image
+  // is no longer needed, unless mips may be released again.
+  const bool imageNeeded = firstMip > 0 || !this->_releaseImageWhenResident;
+  this->_retainImage = imageNeeded;
+
+  // A resource that isn't initialized yet creates its texture with this first
+  // mip when it is, and releases the image then if it isn't needed.
+  if (!this->IsInitialized()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetFirstResidentMip)
+
+  this->TextureRHI = this->createTexture();
+  RHIUpdateTextureReference(TextureReferenceRHI, this->TextureRHI);
+  this->updateTextureMemoryStats();
+
+  if (!imageNeeded) {
+    this->releaseImage();
+  }
+}
 
 FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
+  FTextureRHIRef rhiTexture = this->createTexture();
+
+  if (!this->_retainImage) {
+    this->releaseImage();
+  }
+
+  return rhiTexture;
+}
+
+void FCesiumCreateNewTextureResource::releaseImage() {
+  // Clear the now-unnecessary copy of the pixel data. Calling clear() isn't
+  // good enough because it won't actually release the memory.
+  std::vector<std::byte> pixelData;
+  this->_image.pixelData.swap(pixelData);
+
+  std::vector<CesiumGltf::ImageCesiumMipPosition> mipPositions;
+  this->_image.mipPositions.swap(mipPositions);
+}
+
+FTextureRHIRef FCesiumCreateNewTextureResource::createTexture() const {
   FRHIResourceCreateInfo createInfo{TEXT("CesiumTextureUtility")};
   createInfo.BulkData = nullptr;
   createInfo.ExtData = _platformExtData;
@@ -332,42 +539,74 @@ FTextureRHIRef FCesiumCreateNewTextureResource::InitializeTextureRHI() {
     textureFlags |= TexCreate_SRGB;
   }
 
+  const uint32 firstMip = this->_firstResidentMip;
+  const uint32 width = FMath::Max<uint32>(this->_width >> firstMip, 1);
+  const uint32 height = FMath::Max<uint32>(this->_height >> firstMip, 1);
+
   uint32 mipCount =
-      FMath::Max(1, static_cast<int32>(this->_image.mipPositions.size()));
+      FMath::Max(1, static_cast<int32>(this->_image.mipPositions.size())) -
+      firstMip;
+  uint32 uploadedMipCount = mipCount;
+
+  if (this->_generateMips) {
+    mipCount = FMath::FloorLog2(FMath::Max(this->_width, this->_height)) + 1;
+    uploadedMipCount = 1;
+
+    // The mips are generated by a compute shader where compute shaders can
+    // write to textures, and otherwise by drawing each mip.
+    textureFlags |= RHISupportsComputeShaders(GMaxRHIShaderPlatform)
+                        ? TexCreate_UAV
+                        : TexCreate_RenderTargetable;
+  }
 
-  // Create a new RHI texture, initially empty.
+  // Reuse a released texture of the same size and format, if there is one,
+  // since every mip of it is overwritten below. Otherwise create a new RHI
+  // texture, initially empty.
+  FTexture2DRHIRef rhiTexture;
+  if (this->_pooled) {
+    rhiTexture = GCesiumTexturePool.acquire(PooledTextureKey{
+        FIntPoint(int32(width), int32(height)),
+        this->_format,
+        uint8(mipCount),
+        textureFlags});
+  }
 
   // RHICreateTexture2D can actually copy over all the mips in one shot,
   // but it expects a particular memory layout. Might be worth configuring
   // Cesium Native's mip-map generation to obey a standard memory layout.
-  FTexture2DRHIRef rhiTexture =
-      RHICreateTexture(FRHITextureCreateDesc::Create2D(createInfo.DebugName)
-                           .SetExtent(int32(this->_width), int32(this->_height))
-                           .SetFormat(this->_format)
-                           .SetNumMips(uint8(mipCount))
-                           .SetNumSamples(1)
-                           .SetFlags(textureFlags)
-                           .SetInitialState(ERHIAccess::Unknown)
-                           .SetExtData(createInfo.ExtData)
-                           .SetGPUMask(createInfo.GPUMask)
-                           .SetClearValue(createInfo.ClearValueBinding));
+  if (!rhiTexture) {
+    rhiTexture =
+        RHICreateTexture(FRHITextureCreateDesc::Create2D(createInfo.DebugName)
+                             .SetExtent(int32(width), int32(height))
+                             .SetFormat(this->_format)
+                             .SetNumMips(uint8(mipCount))
+                             .SetNumSamples(1)
+                             .SetFlags(textureFlags)
+                             .SetInitialState(ERHIAccess::Unknown)
+                             .SetExtData(createInfo.ExtData)
+                             .SetGPUMask(createInfo.GPUMask)
+                             .SetClearValue(createInfo.ClearValueBinding));
+  }
 
   // Copy over all image data (including mip levels)
-  for (uint32 i = 0; i < mipCount; ++i) {
+  for (uint32 i = 0; i < uploadedMipCount; ++i) {
     uint32 DestPitch;
     void* pDestination =
         RHILockTexture2D(rhiTexture, i, RLM_WriteOnly, DestPitch, false);
-    CopyMip(pDestination, DestPitch, _format, this->_image, i);
+    CopyMip(pDestination, DestPitch, _format, this->_image, firstMip + i);
     RHIUnlockTexture2D(rhiTexture, i, false);
   }
 
-  // Clear the now-unnecessary copy of the pixel data. Calling clear() isn't
-  // good enough because it won't actually release the memory.
-  std::vector<std::byte> pixelData;
-  this->_image.pixelData.swap(pixelData);
+  if (uploadedMipCount < mipCount) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::GenerateMipsOnGpu)
 
-  std::vector<CesiumGltf::ImageCesiumMipPosition> mipPositions;
-  this->_image.mipPositions.swap(mipPositions);
+    FRDGBuilder graphBuilder(FRHICommandListImmediate::Get());
+    FRDGTextureRef pRdgTexture = graphBuilder.RegisterExternalTexture(
+        CreateRenderTarget(rhiTexture, TEXT("CesiumTextureUtility")));
+    FGenerateMips::Execute(graphBuilder, GMaxRHIFeatureLevel, pRdgTexture);
+    graphBuilder.SetTextureAccessFinal(pRdgTexture, ERHIAccess::SRVMask);
+    graphBuilder.Execute();
+  }
 
   return rhiTexture;
 }
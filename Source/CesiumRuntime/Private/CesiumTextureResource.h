@@ -6,6 +6,7 @@
 #include "Engine/Texture.h"
 #include "TextureResource.h"
 #include <CesiumGltf/ImageCesium.h>
+#include <vector>
 
 /**
  * The base class for Cesium texture resources, making Cesium's texture data
@@ -36,6 +37,33 @@ public:
 #endif
   virtual void ReleaseRHI() override;
 
+  /**
+   * Gets the size in bytes of each of this resource's mips, starting with the
+   * most detailed, if the number of them that are resident on the GPU can be
+   * changed with {@link setFirstResidentMip}. Otherwise, returns an empty
+   * vector.
+   */
+  virtual std::vector<uint64> getMipSizes() const { return {}; }
+
+  /**
+   * Gets the index of the least detailed mip that may be made the first
+   * resident mip of this resource.
+   */
+  virtual uint32 getMaximumFirstResidentMip() const { return 0; }
+
+  /**
+   * Gets the index of the most detailed mip of this resource that is
+   * resident on the GPU, or that will be once it is initialized.
+   */
+  virtual uint32 getFirstResidentMip() const { return 0; }
+
+  /**
+   * Releases the mips more detailed than `firstMip` from the GPU, or restores
+   * the ones that were released before. Must be called from the render
+   * thread.
+   */
+  virtual void setFirstResidentMip(uint32 firstMip) {}
+
 #if STATS
   static FName TextureGroupStatFNames[TEXTUREGROUP_MAX];
 #endif
@@ -43,6 +71,12 @@ public:
 protected:
   virtual FTextureRHIRef InitializeTextureRHI() = 0;
 
+  /**
+   * Records the memory used by the current `TextureRHI` in the texture memory
+   * stats, in place of what was recorded before.
+   */
+  void updateTextureMemoryStats();
+
   TextureGroup _textureGroup;
   uint32 _width;
   uint32 _height;
@@ -106,6 +140,24 @@ private:
  * `GRHISupportsAsyncTextureCreation` is false (everywhere but Direct3D), we can
  * only create a `FRHITexture` on the render thread, so this is the code that
  * does it.
+ *
+ * If `generateMips` is true, only the image's first mip is uploaded, and the
+ * rest of the mip chain is then generated on the GPU.
+ *
+ * If `retainImage` is true and the image has mips, the image is kept after
+ * the RHI texture is created, so that its most detailed mips can be released
+ * from the GPU and restored later with `setFirstResidentMip`.
+ *
+ * If `initialFirstMip` is not zero and the image has mips, the RHI texture is
+ * first created without the mips more detailed than it, so it can be
+ * rendered sooner. The image is then kept until the other mips are restored
+ * with `setFirstResidentMip`.
+ *
+ * If `pooled` is true and the image isn't retained, the RHI texture is taken
+ * from a pool of released textures of the same size and format, if there is
+ * one, and given back to the pool when this resource is released, rather
+ * than being created and destroyed. The RHI texture of a pooled resource must
+ * not be used by any other resource.
  */
 class FCesiumCreateNewTextureResource : public FCesiumTextureResourceBase {
 public:
@@ -120,11 +172,30 @@ public:
       TextureAddress addressY,
       bool sRGB,
       bool useMipsIfAvailable,
-      uint32 extData);
+      uint32 extData,
+      bool generateMips = false,
+      bool retainImage = false,
+      bool pooled = false,
+      uint32 initialFirstMip = 0);
+
+  virtual void ReleaseRHI() override;
+
+  virtual std::vector<uint64> getMipSizes() const override;
+  virtual uint32 getMaximumFirstResidentMip() const override;
+  virtual uint32 getFirstResidentMip() const override;
+  virtual void setFirstResidentMip(uint32 firstMip) override;
 
 protected:
   virtual FTextureRHIRef InitializeTextureRHI() override;
 
 private:
+  FTextureRHIRef createTexture() const;
+  void releaseImage();
+
   CesiumGltf::ImageCesium _image;
+  bool _generateMips;
+  bool _retainImage;
+  bool _releaseImageWhenResident;
+  bool _pooled;
+  uint32 _firstResidentMip;
 };
@@ -7,10 +7,12 @@
 #include "CesiumCommon.h"
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumTextureResidency.h"
 #include "CesiumTextureResource.h"
 #include "Containers/ResourceArray.h"
 #include "DynamicRHI.h"
 #include "GenericPlatform/GenericPlatformProcess.h"
+#include "Hash/CityHash.h"
 #include "PixelFormat.h"
 #include "RHICommandList.h"
 #include "RHIDefinitions.h"
@@ -26,22 +28,26 @@
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <mutex>
+#include <unordered_map>
 
 using namespace CesiumGltf;
 
 namespace {
 
-FTexture2DRHIRef createAsyncTextureAndWait(
+thread_local CesiumTextureUtility::AsyncTextureCreations*
+    pCurrentTextureCreations = nullptr;
+
+FTexture2DRHIRef createAsyncTexture(
     uint32 SizeX,
     uint32 SizeY,
     uint8 Format,
     uint32 NumMips,
     ETextureCreateFlags Flags,
     void** InitialMipData,
-    uint32 NumInitialMips) {
+    uint32 NumInitialMips,
+    FGraphEventRef& CompletionEvent) {
 #if ENGINE_VERSION_5_3_OR_HIGHER
-  FGraphEventRef CompletionEvent;
-
   FTexture2DRHIRef result = RHIAsyncCreateTexture2D(
       SizeX,
       SizeY,
@@ -52,8 +58,11 @@ FTexture2DRHIRef createAsyncTextureAndWait(
       NumInitialMips,
       CompletionEvent);
 
-  if (CompletionEvent) {
+  // Only wait here when the caller can't wait for the event asynchronously.
+  if (CompletionEvent &&
+      !CesiumTextureUtility::AsyncTextureCreations::getCurrent()) {
     CompletionEvent->Wait();
+    CompletionEvent = nullptr;
   }
 
   return result;
@@ -76,12 +85,15 @@ FTexture2DRHIRef createAsyncTextureAndWait(
  * @param image The CPU image to create on the GPU.
  * @param format The pixel format of the image.
  * @param Whether to use a sRGB color-space.
+ * @param completionEvent Set to the event that completes when the texture is
+ * ready, if the texture isn't ready yet when this returns.
  * @return The RHI texture reference.
  */
 FTexture2DRHIRef CreateRHITexture2D_Async(
     const CesiumGltf::ImageCesium& image,
     EPixelFormat format,
-    bool sRGB) {
+    bool sRGB,
+    FGraphEventRef& completionEvent) {
   check(GRHISupportsAsyncTextureCreation);
 
   ETextureCreateFlags textureFlags = TexCreate_ShaderResource;
@@ -109,24 +121,26 @@ FTexture2DRHIRef CreateRHITexture2D_Async(
       mipsData[i] = (void*)(&image.pixelData[mipPos.byteOffset]);
     }
 
-    return createAsyncTextureAndWait(
+    return createAsyncTexture(
         static_cast<uint32>(image.width),
         static_cast<uint32>(image.height),
         format,
         mipCount,
         textureFlags,
         mipsData,
-        mipCount);
+        mipCount,
+        completionEvent);
   } else {
     void* pTextureData = (void*)(image.pixelData.data());
-    return createAsyncTextureAndWait(
+    return createAsyncTexture(
         static_cast<uint32>(image.width),
         static_cast<uint32>(image.height),
         format,
         1,
         textureFlags,
         &pTextureData,
-        1);
+        1,
+        completionEvent);
   }
 }
 
@@ -139,12 +153,196 @@ struct ExtensionUnrealTexture {
       pTexture;
 };
 
+/**
+ * Identifies textures created from identical pixel data with identical
+ * settings, so that a texture can be shared rather than created again.
+ */
+struct SharedTextureKey {
+  uint64 hash;
+  uint64 sizeBytes;
+  int32 width;
+  int32 height;
+  EPixelFormat pixelFormat;
+  TextureAddress addressX;
+  TextureAddress addressY;
+  TextureFilter filter;
+  TextureGroup group;
+  bool sRGB;
+  bool useMipMaps;
+  bool generateMips;
+
+  bool operator==(const SharedTextureKey& rhs) const noexcept {
+    return this->hash == rhs.hash && this->sizeBytes == rhs.sizeBytes &&
+           this->width == rhs.width && this->height == rhs.height &&
+           this->pixelFormat == rhs.pixelFormat &&
+           this->addressX == rhs.addressX && this->addressY == rhs.addressY &&
+           this->filter == rhs.filter && this->group == rhs.group &&
+           this->sRGB == rhs.sRGB && this->useMipMaps == rhs.useMipMaps &&
+           this->generateMips == rhs.generateMips;
+  }
+};
+
+struct SharedTextureKeyHash {
+  size_t operator()(const SharedTextureKey& key) const noexcept {
+    // The pixel data hash already distinguishes nearly all keys.
+    return size_t(key.hash ^ (uint64(key.pixelFormat) << 1) ^
+                  (uint64(key.addressX) << 9) ^ (uint64(key.addressY) << 13) ^
+                  (uint64(key.filter) << 17) ^ (uint64(key.group) << 21) ^
+                  (uint64(key.sRGB) << 29) ^ (uint64(key.useMipMaps) << 30) ^
+                  (uint64(key.generateMips) << 31));
+  }
+};
+
+SharedTextureKey createSharedTextureKey(
+    const CesiumGltf::ImageCesium& imageCesium,
+    EPixelFormat pixelFormat,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureFilter filter,
+    bool useMipMaps,
+    TextureGroup group,
+    bool sRGB,
+    bool generateMips) {
+  uint64 hash = CityHash64(
+      reinterpret_cast<const char*>(imageCesium.pixelData.data()),
+      uint32(imageCesium.pixelData.size()));
+  if (!imageCesium.mipPositions.empty()) {
+    hash = CityHash64WithSeed(
+        reinterpret_cast<const char*>(imageCesium.mipPositions.data()),
+        uint32(
+            imageCesium.mipPositions.size() *
+            sizeof(CesiumGltf::ImageCesiumMipPosition)),
+        hash);
+  }
+
+  return SharedTextureKey{
+      hash,
+      uint64(imageCesium.pixelData.size()),
+      imageCesium.width,
+      imageCesium.height,
+      pixelFormat,
+      addressX,
+      addressY,
+      filter,
+      group,
+      sRGB,
+      useMipMaps,
+      generateMips};
+}
+
+/**
+ * The textures that can be shared, across all tiles of all tilesets.
+ *
+ * Each entry holds a reference to its texture. A texture no longer used by
+ * any tile is only referenced from here, and is released by
+ * {@link CesiumTextureUtility::releaseUnusedSharedTextures}. Because new
+ * references to a shared texture are only ever taken from here while the
+ * mutex is held, a texture with a single reference can't be picked up again
+ * while it's being released.
+ */
+struct SharedTextures {
+  std::mutex mutex;
+  std::unordered_map<
+      SharedTextureKey,
+      CesiumUtility::IntrusivePointer<
+          CesiumTextureUtility::ReferenceCountedUnrealTexture>,
+      SharedTextureKeyHash>
+      textures;
+
+  // The keys of the textures created from the data with each source key.
+  // Only `textures` holds references, so that an entry here never keeps a
+  // texture alive.
+  std::unordered_map<uint64, SharedTextureKey> sources;
+};
+
+SharedTextures& getSharedTextures() {
+  static SharedTextures sharedTextures;
+  return sharedTextures;
+}
+
+/**
+ * Makes sure that a shared texture that's still being created, for another
+ * tile, isn't used before it's ready.
+ */
+void waitForSharedTexture(
+    const CesiumTextureUtility::ReferenceCountedUnrealTexture& texture) {
+  const FGraphEventRef& pEvent = texture.getCreationEvent();
+  if (pEvent && !pEvent->IsComplete()) {
+    CesiumTextureUtility::AsyncTextureCreations* pCreations =
+        CesiumTextureUtility::AsyncTextureCreations::getCurrent();
+    if (pCreations) {
+      pCreations->add(pEvent, {});
+    } else {
+      pEvent->Wait();
+    }
+  }
+}
+
 } // namespace
 
 namespace CesiumTextureUtility {
 
+AsyncTextureCreations::AsyncTextureCreations() noexcept
+    : _pPrevious(pCurrentTextureCreations),
+      _completionEvents(),
+      _pixelData() {
+  pCurrentTextureCreations = this;
+}
+
+AsyncTextureCreations::~AsyncTextureCreations() noexcept {
+  check(pCurrentTextureCreations == this);
+  pCurrentTextureCreations = this->_pPrevious;
+
+  // Textures added after the last call to whenReady must still be waited on.
+  if (!this->_completionEvents.IsEmpty()) {
+    FTaskGraphInterface::Get().WaitUntilTasksComplete(this->_completionEvents);
+  }
+}
+
+AsyncTextureCreations* AsyncTextureCreations::getCurrent() noexcept {
+  return pCurrentTextureCreations;
+}
+
+void AsyncTextureCreations::add(
+    FGraphEventRef completionEvent,
+    std::vector<std::byte>&& pixelData) {
+  this->_completionEvents.Add(std::move(completionEvent));
+  this->_pixelData.emplace_back(std::move(pixelData));
+}
+
+CesiumAsync::Future<void>
+AsyncTextureCreations::whenReady(const CesiumAsync::AsyncSystem& asyncSystem) {
+  if (this->_completionEvents.IsEmpty()) {
+    this->_pixelData.clear();
+    return asyncSystem.createResolvedFuture();
+  }
+
+  CesiumAsync::Promise<void> promise = asyncSystem.createPromise<void>();
+
+  // The task holds a shared pointer because TFunction must be copyable.
+  auto pPixelData = std::make_shared<std::vector<std::vector<std::byte>>>(
+      std::move(this->_pixelData));
+  FFunctionGraphTask::CreateAndDispatchWhenReady(
+      [promise, pPixelData]() mutable {
+        pPixelData->clear();
+        promise.resolve();
+      },
+      TStatId(),
+      &this->_completionEvents,
+      ENamedThreads::AnyBackgroundThreadNormalTask);
+
+  this->_completionEvents.Empty();
+  this->_pixelData.clear();
+
+  return promise.getFuture();
+}
+
 ReferenceCountedUnrealTexture::ReferenceCountedUnrealTexture() noexcept
-    : _pUnrealTexture(nullptr), _pTextureResource(nullptr) {}
+    : _pUnrealTexture(nullptr),
+      _pTextureResource(nullptr),
+      _pCreationEvent(),
+      _textureArraySlice(-1),
+      _sizeBytes(0) {}
 
 ReferenceCountedUnrealTexture::~ReferenceCountedUnrealTexture() noexcept {
   UTexture2D* pLocal = this->_pUnrealTexture;
@@ -198,6 +396,30 @@ void ReferenceCountedUnrealTexture::setTextureResource(
   this->_pTextureResource = std::move(p);
 }
 
+const FGraphEventRef& ReferenceCountedUnrealTexture::getCreationEvent() const {
+  return this->_pCreationEvent;
+}
+
+void ReferenceCountedUnrealTexture::setCreationEvent(const FGraphEventRef& p) {
+  this->_pCreationEvent = p;
+}
+
+int32 ReferenceCountedUnrealTexture::getTextureArraySlice() const {
+  return this->_textureArraySlice;
+}
+
+void ReferenceCountedUnrealTexture::setTextureArraySlice(int32 slice) {
+  this->_textureArraySlice = slice;
+}
+
+uint64 ReferenceCountedUnrealTexture::getSizeBytes() const {
+  return this->_sizeBytes;
+}
+
+void ReferenceCountedUnrealTexture::setSizeBytes(uint64 sizeBytes) {
+  this->_sizeBytes = sizeBytes;
+}
+
 TUniquePtr<LoadedTextureResult> loadTextureFromModelAnyThreadPart(
     CesiumGltf::Model& model,
     CesiumGltf::Texture& texture,
@@ -297,7 +519,10 @@ TUniquePtr<LoadedTextureResult> loadTextureFromModelAnyThreadPart(
     // Note the index of this texture within the glTF.
     pResult->textureIndex = textureIndex;
 
-    if (source >= 0 && source < textureResources.size()) {
+    // When the texture is shared with another tile, its resource may be
+    // handed to the renderer at any time, and the pixel data is kept.
+    if (source >= 0 && source < textureResources.size() &&
+        image.cesium.pixelData.empty()) {
       // Make the RHI resource known so it can be used by other textures that
       // reference this same image.
       textureResources[source] = pResult->pTexture->getTextureResource().Get();
@@ -411,7 +636,11 @@ static UTexture2D* CreateTexture2D(LoadedTextureResult* pHalfLoadedTexture) {
   return pTexture;
 }
 
-TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
+/**
+ * Does the work of loadTextureAnyThreadPart. If retainPixelData is true, the
+ * image is not modified.
+ */
+static TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPartImpl(
     CesiumGltf::ImageCesium& imageCesium,
     TextureAddress addressX,
     TextureAddress addressY,
@@ -420,47 +649,27 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     TextureGroup group,
     bool sRGB,
     std::optional<EPixelFormat> overridePixelFormat,
-    FCesiumTextureResourceBase* pExistingImageResource) {
+    FCesiumTextureResourceBase* pExistingImageResource,
+    bool generateMipsOnGpu,
+    std::optional<uint64> sourceKey,
+    bool retainPixelData,
+    bool usePooledTexture) {
   EPixelFormat pixelFormat;
   if (imageCesium.compressedPixelFormat != GpuCompressedPixelFormat::NONE) {
-    switch (imageCesium.compressedPixelFormat) {
-    case GpuCompressedPixelFormat::ETC1_RGB:
-      pixelFormat = EPixelFormat::PF_ETC1;
-      break;
-    case GpuCompressedPixelFormat::ETC2_RGBA:
-      pixelFormat = EPixelFormat::PF_ETC2_RGBA;
-      break;
-    case GpuCompressedPixelFormat::BC1_RGB:
-      pixelFormat = EPixelFormat::PF_DXT1;
-      break;
-    case GpuCompressedPixelFormat::BC3_RGBA:
-      pixelFormat = EPixelFormat::PF_DXT5;
-      break;
-    case GpuCompressedPixelFormat::BC4_R:
-      pixelFormat = EPixelFormat::PF_BC4;
-      break;
-    case GpuCompressedPixelFormat::BC5_RG:
-      pixelFormat = EPixelFormat::PF_BC5;
-      break;
-    case GpuCompressedPixelFormat::BC7_RGBA:
-      pixelFormat = EPixelFormat::PF_BC7;
-      break;
-    case GpuCompressedPixelFormat::ASTC_4x4_RGBA:
-      pixelFormat = EPixelFormat::PF_ASTC_4x4;
-      break;
-    case GpuCompressedPixelFormat::PVRTC2_4_RGBA:
-      pixelFormat = EPixelFormat::PF_PVRTC2;
-      break;
-    case GpuCompressedPixelFormat::ETC2_EAC_R11:
-      pixelFormat = EPixelFormat::PF_ETC2_R11_EAC;
-      break;
-    case GpuCompressedPixelFormat::ETC2_EAC_RG11:
-      pixelFormat = EPixelFormat::PF_ETC2_RG11_EAC;
-      break;
-    default:
-      // Unsupported compressed texture format.
+    std::optional<EPixelFormat> maybePixelFormat =
+        getUnrealPixelFormat(imageCesium.compressedPixelFormat);
+    if (!maybePixelFormat || !GPixelFormats[*maybePixelFormat].Supported) {
+      // The image was transcoded to a format this platform can't sample, so
+      // it would only render as garbage.
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT(
+              "Skipping a texture with GPU compressed pixel format %d, which is not supported on this platform."),
+          int32(imageCesium.compressedPixelFormat));
       return nullptr;
-    };
+    }
+    pixelFormat = *maybePixelFormat;
   } else if (overridePixelFormat) {
     pixelFormat = *overridePixelFormat;
   } else {
@@ -479,7 +688,6 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
   }
 
   TUniquePtr<LoadedTextureResult> pResult = MakeUnique<LoadedTextureResult>();
-  pResult->pTexture = new ReferenceCountedUnrealTexture();
 
   pResult->addressX = addressX;
   pResult->addressY = addressY;
@@ -490,7 +698,71 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
   // Store the current size of the pixel data, because we're about to clear it
   // but we still want to have an accurate estimation of the size of the image
   // for caching purposes.
-  imageCesium.sizeBytes = int64_t(imageCesium.pixelData.size());
+  if (!retainPixelData) {
+    imageCesium.sizeBytes = int64_t(imageCesium.pixelData.size());
+  }
+
+  const bool generateMips =
+      generateMipsOnGpu && useMipMapsIfAvailable && !pExistingImageResource &&
+      imageCesium.compressedPixelFormat == GpuCompressedPixelFormat::NONE &&
+      imageCesium.mipPositions.empty();
+
+  // When the resident mips of textures are managed, textures with mips keep
+  // their pixel data so that the mips that are released can be restored.
+  const bool retainImage = !pExistingImageResource && !generateMips &&
+                           imageCesium.mipPositions.size() > 1 &&
+                           CesiumTextureResidency::isEnabled();
+
+  // When textures load progressively, those with mips are first created
+  // without their most detailed mips, which are restored over the following
+  // frames.
+  const uint32 initialFirstMip =
+      !pExistingImageResource && !generateMips &&
+              imageCesium.mipPositions.size() > 1
+          ? CesiumTextureResidency::getInitialFirstMip(
+                uint32(imageCesium.width),
+                uint32(imageCesium.height))
+          : 0;
+
+  // Many tiles of a tileset often use the very same image, such as a shared
+  // facade or roof atlas. Reuse the texture created for an identical image
+  // rather than creating and uploading another one.
+  std::optional<SharedTextureKey> sharedTextureKey;
+  if (!pExistingImageResource && !imageCesium.pixelData.empty()) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FindSharedTexture)
+
+    sharedTextureKey = createSharedTextureKey(
+        imageCesium,
+        pixelFormat,
+        addressX,
+        addressY,
+        filter,
+        useMipMapsIfAvailable,
+        group,
+        sRGB,
+        generateMips);
+
+    SharedTextures& shared = getSharedTextures();
+    std::scoped_lock<std::mutex> lock(shared.mutex);
+    auto it = shared.textures.find(*sharedTextureKey);
+    if (it != shared.textures.end()) {
+      pResult->pTexture = it->second;
+      if (sourceKey) {
+        shared.sources.insert_or_assign(*sourceKey, *sharedTextureKey);
+      }
+      waitForSharedTexture(*pResult->pTexture);
+      return pResult;
+    }
+  }
+
+  pResult->pTexture = new ReferenceCountedUnrealTexture();
+
+  // Mips generated on the GPU add a third to the size of the image.
+  if (!pExistingImageResource) {
+    const uint64 imageBytes = uint64(imageCesium.pixelData.size());
+    pResult->pTexture->setSizeBytes(
+        generateMips ? imageBytes + imageBytes / 3 : imageBytes);
+  }
 
   if (pExistingImageResource) {
     pResult->pTexture->setTextureResource(
@@ -507,13 +779,19 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
             useMipMapsIfAvailable,
             0));
   } else if (
-      GRHISupportsAsyncTextureCreation && !imageCesium.pixelData.empty()) {
+      GRHISupportsAsyncTextureCreation && !imageCesium.pixelData.empty() &&
+      !generateMips && !retainImage && initialFirstMip == 0 &&
+      !usePooledTexture) {
     // Create RHI texture resource on this worker thread, and then hand it off
     // to the renderer thread.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateRHITexture2D)
 
-    FTexture2DRHIRef textureReference =
-        CreateRHITexture2D_Async(imageCesium, pixelFormat, sRGB);
+    FGraphEventRef completionEvent;
+    FTexture2DRHIRef textureReference = CreateRHITexture2D_Async(
+        imageCesium,
+        pixelFormat,
+        sRGB,
+        completionEvent);
     pResult->pTexture->setTextureResource(
         MakeUnique<FCesiumUseExistingTextureResource>(
             textureReference,
@@ -529,22 +807,45 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
             0));
 
     // Clear the now-unnecessary copy of the pixel data. Calling clear() isn't
-    // good enough because it won't actually release the memory.
+    // good enough because it won't actually release the memory. If the
+    // texture isn't ready yet, the pixel data is released once it is. Pixel
+    // data that is retained belongs to a glTF that outlives the texture
+    // creations of its load.
     std::vector<std::byte> pixelData;
-    imageCesium.pixelData.swap(pixelData);
+    if (!retainPixelData) {
+      imageCesium.pixelData.swap(pixelData);
+    }
+    if (completionEvent) {
+      pResult->pTexture->setCreationEvent(completionEvent);
+      AsyncTextureCreations::getCurrent()->add(
+          completionEvent,
+          std::move(pixelData));
+    }
 
-    std::vector<CesiumGltf::ImageCesiumMipPosition> mipPositions;
-    imageCesium.mipPositions.swap(mipPositions);
+    if (!retainPixelData) {
+      std::vector<CesiumGltf::ImageCesiumMipPosition> mipPositions;
+      imageCesium.mipPositions.swap(mipPositions);
+    }
   } else {
     // The RHI texture will be created later on the render thread, directly
-    // from this texture source. We need valid pixelData here, though.
+    // from this texture source. We need valid pixelData here, though. This is
+    // also where mips are generated on the GPU, because that needs the render
+    // thread.
     if (imageCesium.pixelData.empty()) {
       return nullptr;
     }
 
+    // The texture resource takes the pixel data, so retained pixel data must
+    // be copied.
+    std::optional<CesiumGltf::ImageCesium> imageCopy;
+    if (retainPixelData) {
+      imageCopy.emplace(imageCesium);
+    }
+    CesiumGltf::ImageCesium& image = imageCopy ? *imageCopy : imageCesium;
+
     pResult->pTexture->setTextureResource(
         MakeUnique<FCesiumCreateNewTextureResource>(
-            std::move(imageCesium),
+            std::move(image),
             group,
             imageCesium.width,
             imageCesium.height,
@@ -554,14 +855,146 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
             addressY,
             sRGB,
             useMipMapsIfAvailable,
-            0));
+            0,
+            generateMips,
+            retainImage,
+            usePooledTexture,
+            initialFirstMip));
   }
 
   check(pResult->pTexture->getTextureResource() != nullptr);
 
+  if (sharedTextureKey) {
+    SharedTextures& shared = getSharedTextures();
+    std::scoped_lock<std::mutex> lock(shared.mutex);
+    shared.textures.emplace(*sharedTextureKey, pResult->pTexture);
+    if (sourceKey) {
+      shared.sources.insert_or_assign(*sourceKey, *sharedTextureKey);
+    }
+  }
+
   return pResult;
 }
 
+TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
+    CesiumGltf::ImageCesium& imageCesium,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureFilter filter,
+    bool useMipMapsIfAvailable,
+    TextureGroup group,
+    bool sRGB,
+    std::optional<EPixelFormat> overridePixelFormat,
+    FCesiumTextureResourceBase* pExistingImageResource,
+    bool generateMipsOnGpu,
+    std::optional<uint64> sourceKey,
+    bool usePooledTexture) {
+  return loadTextureAnyThreadPartImpl(
+      imageCesium,
+      addressX,
+      addressY,
+      filter,
+      useMipMapsIfAvailable,
+      group,
+      sRGB,
+      overridePixelFormat,
+      pExistingImageResource,
+      generateMipsOnGpu,
+      sourceKey,
+      false,
+      usePooledTexture);
+}
+
+TUniquePtr<LoadedTextureResult> loadTextureFromRetainedImageAnyThreadPart(
+    const CesiumGltf::ImageCesium& imageCesium,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureGroup group,
+    EPixelFormat pixelFormat) {
+  // The image is not modified when its pixel data is retained.
+  return loadTextureAnyThreadPartImpl(
+      const_cast<CesiumGltf::ImageCesium&>(imageCesium),
+      addressX,
+      addressY,
+      TextureFilter::TF_Nearest,
+      false,
+      group,
+      false,
+      pixelFormat,
+      nullptr,
+      false,
+      std::nullopt,
+      true,
+      false);
+}
+
+TUniquePtr<LoadedTextureResult>
+loadSharedTextureAnyThreadPart(uint64 sourceKey) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::FindSharedTexture)
+
+  TUniquePtr<LoadedTextureResult> pResult;
+
+  {
+    SharedTextures& shared = getSharedTextures();
+    std::scoped_lock<std::mutex> lock(shared.mutex);
+    auto sourceIt = shared.sources.find(sourceKey);
+    if (sourceIt == shared.sources.end()) {
+      return nullptr;
+    }
+
+    auto it = shared.textures.find(sourceIt->second);
+    if (it == shared.textures.end()) {
+      shared.sources.erase(sourceIt);
+      return nullptr;
+    }
+
+    const SharedTextureKey& key = it->first;
+    pResult = MakeUnique<LoadedTextureResult>();
+    pResult->addressX = key.addressX;
+    pResult->addressY = key.addressY;
+    pResult->filter = key.filter;
+    pResult->group = key.group;
+    pResult->sRGB = key.sRGB;
+    pResult->pTexture = it->second;
+  }
+
+  waitForSharedTexture(*pResult->pTexture);
+  return pResult;
+}
+
+void releaseUnusedSharedTextures() {
+  check(IsInGameThread());
+
+  std::vector<CesiumUtility::IntrusivePointer<ReferenceCountedUnrealTexture>>
+      unused;
+
+  {
+    SharedTextures& shared = getSharedTextures();
+    std::scoped_lock<std::mutex> lock(shared.mutex);
+    for (auto it = shared.textures.begin(); it != shared.textures.end();) {
+      if (it->second->getReferenceCount() == 1) {
+        unused.emplace_back(std::move(it->second));
+        it = shared.textures.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    if (!unused.empty()) {
+      for (auto it = shared.sources.begin(); it != shared.sources.end();) {
+        if (shared.textures.find(it->second) == shared.textures.end()) {
+          it = shared.sources.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+  }
+
+  // The textures are destroyed here, outside the lock, as `unused` goes out
+  // of scope.
+}
+
 CesiumUtility::IntrusivePointer<ReferenceCountedUnrealTexture>
 loadTextureGameThreadPart(
     CesiumGltf::Model& model,
@@ -617,11 +1050,78 @@ loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture) {
       pCesiumTextureResource->InitResource();
 #endif
     });
+
+    CesiumTextureResidency::registerTexture(pTexture, pCesiumTextureResource);
   }
 
   return pHalfLoadedTexture->pTexture;
 }
 
+std::optional<EPixelFormat>
+getUnrealPixelFormat(CesiumGltf::GpuCompressedPixelFormat format) {
+  switch (format) {
+  case GpuCompressedPixelFormat::ETC1_RGB:
+    return EPixelFormat::PF_ETC1;
+  case GpuCompressedPixelFormat::ETC2_RGBA:
+    return EPixelFormat::PF_ETC2_RGBA;
+  case GpuCompressedPixelFormat::BC1_RGB:
+    return EPixelFormat::PF_DXT1;
+  case GpuCompressedPixelFormat::BC3_RGBA:
+    return EPixelFormat::PF_DXT5;
+  case GpuCompressedPixelFormat::BC4_R:
+    return EPixelFormat::PF_BC4;
+  case GpuCompressedPixelFormat::BC5_RG:
+    return EPixelFormat::PF_BC5;
+  case GpuCompressedPixelFormat::BC7_RGBA:
+    return EPixelFormat::PF_BC7;
+  case GpuCompressedPixelFormat::ASTC_4x4_RGBA:
+    return EPixelFormat::PF_ASTC_4x4;
+  case GpuCompressedPixelFormat::PVRTC2_4_RGBA:
+    return EPixelFormat::PF_PVRTC2;
+  case GpuCompressedPixelFormat::ETC2_EAC_R11:
+    return EPixelFormat::PF_ETC2_R11_EAC;
+  case GpuCompressedPixelFormat::ETC2_EAC_RG11:
+    return EPixelFormat::PF_ETC2_RG11_EAC;
+  default:
+    return std::nullopt;
+  }
+}
+
+const CesiumGltf::Ktx2TranscodeTargets& getKtx2TranscodeTargets() {
+  static const CesiumGltf::Ktx2TranscodeTargets targets = []() {
+    auto isSupported = [](GpuCompressedPixelFormat format) {
+      std::optional<EPixelFormat> pixelFormat = getUnrealPixelFormat(format);
+      return pixelFormat && GPixelFormats[*pixelFormat].Supported;
+    };
+
+    // Only formats that loadTextureAnyThreadPart can upload are offered, so
+    // no KTX2 texture is transcoded to one that would then be skipped.
+    CesiumGltf::SupportedGpuCompressedPixelFormats supportedFormats;
+    supportedFormats.ETC1_RGB = isSupported(GpuCompressedPixelFormat::ETC1_RGB);
+    supportedFormats.ETC2_RGBA =
+        isSupported(GpuCompressedPixelFormat::ETC2_RGBA);
+    supportedFormats.BC1_RGB = isSupported(GpuCompressedPixelFormat::BC1_RGB);
+    supportedFormats.BC3_RGBA = isSupported(GpuCompressedPixelFormat::BC3_RGBA);
+    supportedFormats.BC4_R = isSupported(GpuCompressedPixelFormat::BC4_R);
+    supportedFormats.BC5_RG = isSupported(GpuCompressedPixelFormat::BC5_RG);
+    supportedFormats.BC7_RGBA = isSupported(GpuCompressedPixelFormat::BC7_RGBA);
+    supportedFormats.ASTC_4x4_RGBA =
+        isSupported(GpuCompressedPixelFormat::ASTC_4x4_RGBA);
+    supportedFormats.PVRTC2_4_RGBA =
+        isSupported(GpuCompressedPixelFormat::PVRTC2_4_RGBA);
+    supportedFormats.ETC2_EAC_R11 =
+        isSupported(GpuCompressedPixelFormat::ETC2_EAC_R11);
+    supportedFormats.ETC2_EAC_RG11 =
+        isSupported(GpuCompressedPixelFormat::ETC2_EAC_RG11);
+
+    // Not preserving high quality lets UASTC textures fall back to a
+    // lower-quality compressed format, rather than to RGBA, when neither
+    // ASTC nor BC7 is available.
+    return CesiumGltf::Ktx2TranscodeTargets(supportedFormats, false);
+  }();
+  return targets;
+}
+
 TextureAddress convertGltfWrapSToUnreal(int32_t wrapS) {
   // glTF spec: "When undefined, a sampler with repeat wrapping and auto
   // filtering should be used."
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Async/TaskGraphInterfaces.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumMetadataValueType.h"
 #include "CesiumTextureResource.h"
@@ -11,6 +12,10 @@
 #include "RHI.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "Templates/UniquePtr.h"
+#include <optional>
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumGltf/Ktx2TranscodeTargets.h>
 #include <CesiumUtility/IntrusivePointer.h>
 #include <CesiumUtility/ReferenceCounted.h>
 
@@ -50,9 +55,75 @@ struct ReferenceCountedUnrealTexture
   TUniquePtr<FCesiumTextureResourceBase>& getTextureResource();
   void setTextureResource(TUniquePtr<FCesiumTextureResourceBase>&& p);
 
+  // The event that completes when the RHI texture created on a worker thread
+  // is ready, or nullptr if it was ready when it was created.
+  const FGraphEventRef& getCreationEvent() const;
+  void setCreationEvent(const FGraphEventRef& p);
+
+  // The slice of a raster overlay's texture array holding this texture's
+  // pixels, or -1. A texture in a slice has no texture game object.
+  int32 getTextureArraySlice() const;
+  void setTextureArraySlice(int32 slice);
+
+  // The GPU memory taken by this texture's pixel data, including its mips.
+  // Zero for a texture that uses the pixel data of another one.
+  uint64 getSizeBytes() const;
+  void setSizeBytes(uint64 sizeBytes);
+
 private:
   TObjectPtr<UTexture2D> _pUnrealTexture;
   TUniquePtr<FCesiumTextureResourceBase> _pTextureResource;
+  FGraphEventRef _pCreationEvent;
+  int32 _textureArraySlice;
+  uint64 _sizeBytes;
+};
+
+/**
+ * @brief Lets RHI textures be created without blocking the thread creating
+ * them.
+ *
+ * While an instance exists, the RHI textures that
+ * {@link loadTextureAnyThreadPart} creates asynchronously on the same thread
+ * don't block the thread until they're ready. Instead, all of them are
+ * started, and {@link whenReady} gives a future that resolves when they're
+ * ready. Without an instance, each texture creation blocks until it's ready.
+ * Instances must be destroyed in the reverse order of their creation.
+ */
+class AsyncTextureCreations {
+public:
+  AsyncTextureCreations() noexcept;
+  ~AsyncTextureCreations() noexcept;
+
+  AsyncTextureCreations(const AsyncTextureCreations&) = delete;
+  AsyncTextureCreations& operator=(const AsyncTextureCreations&) = delete;
+
+  /**
+   * @brief Gets the instance that the textures created on this thread are
+   * added to, or nullptr if there isn't one.
+   */
+  static AsyncTextureCreations* getCurrent() noexcept;
+
+  /**
+   * @brief Adds the creation of a texture.
+   *
+   * @param completionEvent The event that completes when the texture is
+   * ready.
+   * @param pixelData The pixel data the texture is created from, which is
+   * kept until the texture is ready.
+   */
+  void add(FGraphEventRef completionEvent, std::vector<std::byte>&& pixelData);
+
+  /**
+   * @brief Gets a future that resolves when all the textures added so far are
+   * ready. The pixel data they were created from is released then.
+   */
+  CesiumAsync::Future<void>
+  whenReady(const CesiumAsync::AsyncSystem& asyncSystem);
+
+private:
+  AsyncTextureCreations* _pPrevious;
+  FGraphEventArray _completionEvents;
+  std::vector<std::vector<std::byte>> _pixelData;
 };
 
 /**
@@ -143,7 +214,21 @@ TUniquePtr<LoadedTextureResult> loadTextureFromImageAndSamplerAnyThreadPart(
  * created for this image, or nullptr if one hasn't been created yet. When this
  * parameter is not nullptr, the provided image's `pixelData` is not required
  * and can be empty.
- * @return The loaded texture.
+ * @param generateMipsOnGpu If true, `useMipMapsIfAvailable` is true, and the
+ * image is uncompressed and has no mips, only the image itself is uploaded,
+ * and its mips are then generated on the GPU.
+ * @param sourceKey Identifies the data that the image was created from, if
+ * the image is always created the same way from it. While the texture is
+ * shared, {@link loadSharedTextureAnyThreadPart} finds it with this key
+ * without the image having to be created again.
+ * @param usePooledTexture If true, the RHI texture is created on the render
+ * thread from a pool of released textures of the same size and format, and
+ * given back to the pool when the texture is released. This suits textures
+ * of a few sizes that are created and released all the time, such as those
+ * of raster overlay tiles.
+ * @return The loaded texture. If a texture was already created from identical
+ * pixel data with identical settings and is still in use, the result refers
+ * to that texture, and the `pixelData` is left as it is.
  */
 TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     CesiumGltf::ImageCesium& imageCesium,
@@ -154,7 +239,50 @@ TUniquePtr<LoadedTextureResult> loadTextureAnyThreadPart(
     TextureGroup group,
     bool sRGB,
     std::optional<EPixelFormat> overridePixelFormat,
-    FCesiumTextureResourceBase* pExistingImageResource);
+    FCesiumTextureResourceBase* pExistingImageResource,
+    bool generateMipsOnGpu = false,
+    std::optional<uint64> sourceKey = std::nullopt,
+    bool usePooledTexture = false);
+
+/**
+ * @brief Like {@link loadTextureAnyThreadPart}, but leaves the image as it is,
+ * for an image of a glTF that is also read on the CPU, such as the image of a
+ * feature ID texture. The texture is sampled without filtering or mips, and
+ * isn't sRGB.
+ *
+ * When the RHI can create textures on worker threads, the texture is created
+ * straight from the image's pixel data, which must then not change until the
+ * current AsyncTextureCreations are ready. Otherwise, the pixel data is copied
+ * for the renderer thread. If a texture was already created from identical
+ * pixel data with identical settings and is still in use, the result refers
+ * to that texture and nothing is copied.
+ *
+ * @param imageCesium The image.
+ * @param addressX The X addressing mode.
+ * @param addressY The Y addressing mode.
+ * @param group The texture group of this texture.
+ * @param pixelFormat The pixel format to use, which must match the layout of
+ * the image's pixel data.
+ * @return The loaded texture.
+ */
+TUniquePtr<LoadedTextureResult> loadTextureFromRetainedImageAnyThreadPart(
+    const CesiumGltf::ImageCesium& imageCesium,
+    TextureAddress addressX,
+    TextureAddress addressY,
+    TextureGroup group,
+    EPixelFormat pixelFormat);
+
+/**
+ * @brief Gets a texture shared between tiles that was created by
+ * {@link loadTextureAnyThreadPart} with the given source key, so that the
+ * image it was created from doesn't need to be created again.
+ *
+ * @param sourceKey The key of the data the image was created from.
+ * @return The loaded texture, with the settings it was created with, or
+ * nullptr if no texture with the source key is shared.
+ */
+TUniquePtr<LoadedTextureResult>
+loadSharedTextureAnyThreadPart(uint64 sourceKey);
 
 /**
  * @brief Does the main-thread part of render resource preparation for this
@@ -183,6 +311,31 @@ loadTextureGameThreadPart(
 CesiumUtility::IntrusivePointer<ReferenceCountedUnrealTexture>
 loadTextureGameThreadPart(LoadedTextureResult* pHalfLoadedTexture);
 
+/**
+ * @brief Releases the textures that were shared between tiles by
+ * {@link loadTextureAnyThreadPart} and are no longer used by any of them.
+ * The runtime module calls this at the end of each frame. Must be called from
+ * the game thread.
+ */
+void releaseUnusedSharedTextures();
+
+/**
+ * @brief Gets the Unreal pixel format of a GPU compressed pixel format.
+ *
+ * @returns The Unreal pixel format, or std::nullopt if the format is `NONE` or
+ * Unreal has no equivalent.
+ */
+std::optional<EPixelFormat>
+getUnrealPixelFormat(CesiumGltf::GpuCompressedPixelFormat format);
+
+/**
+ * @brief Gets the GPU compressed pixel formats that KTX2 textures are
+ * transcoded to, chosen from the formats that the RHI supports on this
+ * platform. Textures are then uploaded in that format, with the mips from the
+ * KTX2 container, and never decoded to RGBA.
+ */
+const CesiumGltf::Ktx2TranscodeTargets& getKtx2TranscodeTargets();
+
 /**
  * @brief Convert a glTF {@link CesiumGltf::Sampler::WrapS} value to an Unreal
  * `TextureAddress` value.
@@ -0,0 +1,40 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileDistanceExcluder.h"
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+
+using namespace Cesium3DTilesSelection;
+
+void CesiumTileDistanceExcluder::setViews(
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    const std::vector<glm::dvec3>& positions,
+    double distance) {
+  this->_ellipsoid = ellipsoid;
+  this->_distanceSquared = distance * distance;
+  this->_positions.clear();
+  if (distance > 0.0) {
+    this->_positions = positions;
+  }
+}
+
+bool CesiumTileDistanceExcluder::shouldExclude(
+    const Tile& tile) const noexcept {
+  if (this->_positions.empty()) {
+    return false;
+  }
+
+  const CesiumGeometry::OrientedBoundingBox box =
+      getOrientedBoundingBoxFromBoundingVolume(
+          tile.getBoundingVolume(),
+          this->_ellipsoid);
+  for (const glm::dvec3& position : this->_positions) {
+    if (box.computeDistanceSquaredToPosition(position) <=
+        this->_distanceSquared) {
+      return false;
+    }
+  }
+
+  return true;
+}
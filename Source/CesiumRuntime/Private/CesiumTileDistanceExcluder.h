@@ -0,0 +1,40 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <Cesium3DTilesSelection/ITileExcluder.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <glm/vec3.hpp>
+#include <vector>
+
+/**
+ * Excludes the tiles that are farther than a distance from all views, so that
+ * something else, such as the World Partition HLODs of the tileset, can show
+ * them instead.
+ */
+class CesiumTileDistanceExcluder
+    : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  /**
+   * @brief Sets the views to exclude tiles for, until they are set again. Must
+   * not be called while tiles are being selected.
+   *
+   * @param ellipsoid The ellipsoid of the tileset.
+   * @param positions The positions of the views, in the coordinates of the
+   * tileset.
+   * @param distance The distance in meters beyond which tiles are excluded.
+   * If it is zero, or there are no views, no tiles are excluded.
+   */
+  void setViews(
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      const std::vector<glm::dvec3>& positions,
+      double distance);
+
+  bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+
+private:
+  CesiumGeospatial::Ellipsoid _ellipsoid = CesiumGeospatial::Ellipsoid::WGS84;
+  std::vector<glm::dvec3> _positions;
+  double _distanceSquared = 0.0;
+};
@@ -0,0 +1,249 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileExclusionPredicate.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <glm/common.hpp>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <variant>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+namespace {
+
+struct HeightRange {
+  double minimum;
+  double maximum;
+};
+
+/**
+ * Computes a range of heights above the ellipsoid that contains a bounding
+ * volume. The range of volumes that aren't regions is that of their bounding
+ * sphere, so it may be much larger than the volume.
+ */
+struct GetHeightRange {
+  const Ellipsoid& ellipsoid;
+
+  HeightRange operator()(const BoundingRegion& region) const {
+    return {region.getMinimumHeight(), region.getMaximumHeight()};
+  }
+
+  HeightRange
+  operator()(const BoundingRegionWithLooseFittingHeights& region) const {
+    return (*this)(region.getBoundingRegion());
+  }
+
+  HeightRange operator()(const S2CellBoundingVolume& s2) const {
+    return {s2.getMinimumHeight(), s2.getMaximumHeight()};
+  }
+
+  HeightRange operator()(const CesiumGeometry::BoundingSphere& sphere) const {
+    const std::optional<Cartographic> maybeCenter =
+        this->ellipsoid.cartesianToCartographic(sphere.getCenter());
+    if (!maybeCenter) {
+      return {
+          std::numeric_limits<double>::lowest(),
+          std::numeric_limits<double>::max()};
+    }
+    return {
+        maybeCenter->height - sphere.getRadius(),
+        maybeCenter->height + sphere.getRadius()};
+  }
+
+  HeightRange
+  operator()(const CesiumGeometry::OrientedBoundingBox& box) const {
+    return (*this)(box.toSphere());
+  }
+};
+
+bool rectangleContains(
+    const GlobeRectangle& container,
+    const GlobeRectangle& rectangle) {
+  const std::optional<GlobeRectangle> maybeIntersection =
+      container.computeIntersection(rectangle);
+  if (!maybeIntersection) {
+    return false;
+  }
+
+  constexpr double epsilon = 1e-12;
+  return glm::abs(maybeIntersection->getWest() - rectangle.getWest()) <=
+             epsilon &&
+         glm::abs(maybeIntersection->getSouth() - rectangle.getSouth()) <=
+             epsilon &&
+         glm::abs(maybeIntersection->getEast() - rectangle.getEast()) <=
+             epsilon &&
+         glm::abs(maybeIntersection->getNorth() - rectangle.getNorth()) <=
+             epsilon;
+}
+
+std::optional<double>
+getNumber(const std::optional<CesiumUtility::JsonValue>& maybeValue) {
+  if (!maybeValue) {
+    return std::nullopt;
+  }
+  return maybeValue->getSafeNumber<double>();
+}
+
+/**
+ * Gets the range that a property table declares for the values of one of its
+ * properties, with the `min` and `max` of the property, or of its class
+ * property if the property has none.
+ */
+std::optional<std::pair<double, double>> getDeclaredRange(
+    const CesiumGltf::ExtensionModelExtStructuralMetadata& metadata,
+    const CesiumGltf::PropertyTable& propertyTable,
+    const std::string& propertyName,
+    const CesiumGltf::PropertyTableProperty& property) {
+  std::optional<double> minimum = getNumber(property.min);
+  std::optional<double> maximum = getNumber(property.max);
+
+  if ((!minimum || !maximum) && metadata.schema) {
+    auto classIt = metadata.schema->classes.find(propertyTable.classProperty);
+    if (classIt != metadata.schema->classes.end()) {
+      auto propertyIt = classIt->second.properties.find(propertyName);
+      if (propertyIt != classIt->second.properties.end()) {
+        if (!minimum) {
+          minimum = getNumber(propertyIt->second.min);
+        }
+        if (!maximum) {
+          maximum = getNumber(propertyIt->second.max);
+        }
+      }
+    }
+  }
+
+  if (!minimum || !maximum) {
+    return std::nullopt;
+  }
+  return std::make_pair(*minimum, *maximum);
+}
+
+} // namespace
+
+CesiumTileExclusionPredicate::CesiumTileExclusionPredicate(
+    const Ellipsoid& ellipsoid,
+    std::vector<Region>&& regions,
+    std::vector<CartographicPolygon>&& polygons,
+    bool invertSelection,
+    std::vector<MetadataCondition>&& metadataConditions)
+    : _ellipsoid(ellipsoid),
+      _regions(std::move(regions)),
+      _polygons(std::move(polygons)),
+      _invertSelection(invertSelection),
+      _metadataConditions(std::move(metadataConditions)) {}
+
+bool CesiumTileExclusionPredicate::excludesBoundingVolume(
+    const BoundingVolume& boundingVolume) const {
+  if (this->_regions.empty() && this->_polygons.empty()) {
+    return false;
+  }
+
+  const std::optional<GlobeRectangle> maybeRectangle =
+      estimateGlobeRectangle(boundingVolume, this->_ellipsoid);
+  if (!maybeRectangle) {
+    return false;
+  }
+
+  if (this->_invertSelection) {
+    return this->isOutsideSelection(*maybeRectangle);
+  }
+
+  const HeightRange heights =
+      std::visit(GetHeightRange{this->_ellipsoid}, boundingVolume);
+  return this->isInsideSelection(
+      *maybeRectangle,
+      heights.minimum,
+      heights.maximum);
+}
+
+bool CesiumTileExclusionPredicate::excludesContent(
+    const CesiumGltf::Model& model) const {
+  if (this->_metadataConditions.empty()) {
+    return false;
+  }
+
+  const CesiumGltf::ExtensionModelExtStructuralMetadata* pMetadata =
+      model.getExtension<CesiumGltf::ExtensionModelExtStructuralMetadata>();
+  if (!pMetadata) {
+    return false;
+  }
+
+  for (const MetadataCondition& condition : this->_metadataConditions) {
+    for (const CesiumGltf::PropertyTable& propertyTable :
+         pMetadata->propertyTables) {
+      // Property tables without names are referred to by their class, as in
+      // the features metadata description.
+      const std::string& propertyTableName =
+          propertyTable.name ? *propertyTable.name
+                             : propertyTable.classProperty;
+      if (propertyTableName != condition.propertyTableName) {
+        continue;
+      }
+
+      auto propertyIt = propertyTable.properties.find(condition.propertyName);
+      if (propertyIt == propertyTable.properties.end()) {
+        continue;
+      }
+
+      const std::optional<std::pair<double, double>> maybeRange =
+          getDeclaredRange(
+              *pMetadata,
+              propertyTable,
+              propertyIt->first,
+              propertyIt->second);
+      if (maybeRange && (maybeRange->second < condition.minimum ||
+                         maybeRange->first > condition.maximum)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+bool CesiumTileExclusionPredicate::shouldExclude(
+    const Tile& tile) const noexcept {
+  if (this->excludesBoundingVolume(tile.getBoundingVolume())) {
+    return true;
+  }
+
+  const TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  return pRenderContent && this->excludesContent(pRenderContent->getModel());
+}
+
+bool CesiumTileExclusionPredicate::isInsideSelection(
+    const GlobeRectangle& rectangle,
+    double minimumHeight,
+    double maximumHeight) const {
+  for (const Region& region : this->_regions) {
+    if (minimumHeight >= region.minimumHeight &&
+        maximumHeight <= region.maximumHeight &&
+        rectangleContains(region.rectangle, rectangle)) {
+      return true;
+    }
+  }
+
+  return !this->_polygons.empty() &&
+         CartographicPolygon::rectangleIsWithinPolygons(
+             rectangle,
+             this->_polygons);
+}
+
+bool CesiumTileExclusionPredicate::isOutsideSelection(
+    const GlobeRectangle& rectangle) const {
+  for (const Region& region : this->_regions) {
+    if (region.rectangle.computeIntersection(rectangle)) {
+      return false;
+    }
+  }
+
+  return this->_polygons.empty() ||
+         CartographicPolygon::rectangleIsOutsidePolygons(
+             rectangle,
+             this->_polygons);
+}
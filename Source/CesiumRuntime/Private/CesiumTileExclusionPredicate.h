@@ -0,0 +1,96 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <Cesium3DTilesSelection/BoundingVolume.h>
+#include <Cesium3DTilesSelection/ITileExcluder.h>
+#include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * Excludes tiles by their bounds and the metadata of their content, without
+ * calling into Unreal objects or Blueprints. It is immutable once created, so
+ * it may be evaluated from any thread.
+ */
+class CesiumTileExclusionPredicate
+    : public Cesium3DTilesSelection::ITileExcluder {
+public:
+  /**
+   * A region of the ellipsoid, between two heights above it.
+   */
+  struct Region {
+    CesiumGeospatial::GlobeRectangle rectangle;
+    double minimumHeight;
+    double maximumHeight;
+  };
+
+  /**
+   * A range that the values of a property of the tile content's property
+   * tables must overlap.
+   */
+  struct MetadataCondition {
+    std::string propertyTableName;
+    std::string propertyName;
+    double minimum;
+    double maximum;
+  };
+
+  /**
+   * @brief Creates the predicate.
+   *
+   * @param ellipsoid The ellipsoid of the tileset.
+   * @param regions The regions that tiles are excluded in.
+   * @param polygons The polygons that tiles are excluded in.
+   * @param invertSelection Whether tiles are excluded outside all of the
+   * regions and polygons, rather than inside any of them.
+   * @param metadataConditions The conditions that the metadata of loaded
+   * content must meet for its tile to be kept.
+   */
+  CesiumTileExclusionPredicate(
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      std::vector<Region>&& regions,
+      std::vector<CesiumGeospatial::CartographicPolygon>&& polygons,
+      bool invertSelection,
+      std::vector<MetadataCondition>&& metadataConditions);
+
+  /**
+   * @brief Determines whether a tile with the given bounding volume is
+   * excluded by the regions and polygons. A tile is only excluded by them
+   * when it is entirely inside one of them, or entirely outside all of them
+   * if the selection is inverted.
+   */
+  bool excludesBoundingVolume(
+      const Cesium3DTilesSelection::BoundingVolume& boundingVolume) const;
+
+  /**
+   * @brief Determines whether the tile of the given content is excluded by the
+   * metadata conditions. Content is only excluded when a property table
+   * declares the range of a property, with the `min` and `max` of the property
+   * or of its class property, and that range doesn't overlap the condition.
+   */
+  bool excludesContent(const CesiumGltf::Model& model) const;
+
+  bool shouldExclude(
+      const Cesium3DTilesSelection::Tile& tile) const noexcept override;
+
+private:
+  bool isInsideSelection(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      double minimumHeight,
+      double maximumHeight) const;
+  bool isOutsideSelection(const CesiumGeospatial::GlobeRectangle& rectangle)
+      const;
+
+  CesiumGeospatial::Ellipsoid _ellipsoid;
+  std::vector<Region> _regions;
+  std::vector<CesiumGeospatial::CartographicPolygon> _polygons;
+  bool _invertSelection;
+  std::vector<MetadataCondition> _metadataConditions;
+};
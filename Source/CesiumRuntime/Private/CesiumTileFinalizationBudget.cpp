@@ -0,0 +1,104 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileFinalizationBudget.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumPerWorldState.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "HAL/PlatformTime.h"
+
+namespace {
+
+struct WorldFinalizationState {
+  uint64 frame = 0;
+  FCesiumTileFinalizationStats current;
+  FCesiumTileFinalizationStats last;
+};
+
+WorldFinalizationState& getState(const UWorld* pWorld) {
+  static CesiumPerWorldState<WorldFinalizationState> states;
+  WorldFinalizationState& state = states.get(pWorld);
+
+  if (state.frame != GFrameCounter) {
+    // Only roll over the stats when exactly one frame has elapsed. Otherwise,
+    // nothing happened in the previous frame.
+    state.last = state.frame + 1 == GFrameCounter
+                     ? state.current
+                     : FCesiumTileFinalizationStats();
+    state.current = FCesiumTileFinalizationStats();
+    state.frame = GFrameCounter;
+  }
+
+  return state;
+}
+
+// cesium-native treats a limit of zero as "unlimited", so use a tiny positive
+// value to mean "finalize no more than one tile".
+constexpr double ExhaustedBudgetMilliseconds = 0.001;
+
+} // namespace
+
+/*static*/ double
+CesiumTileFinalizationBudget::getRemainingMilliseconds(const UWorld* pWorld) {
+  double budget = double(
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadTileFinalizationBudget);
+  if (budget <= 0.0) {
+    return 0.0;
+  }
+
+  const WorldFinalizationState& state = getState(pWorld);
+  return FMath::Max(
+      budget - state.current.MillisecondsSpent,
+      ExhaustedBudgetMilliseconds);
+}
+
+/*static*/ bool
+CesiumTileFinalizationBudget::isExhausted(const UWorld* pWorld) {
+  double budget = double(
+      GetDefault<UCesiumRuntimeSettings>()->MainThreadTileFinalizationBudget);
+  if (budget <= 0.0) {
+    return false;
+  }
+
+  return getState(pWorld).current.MillisecondsSpent >= budget;
+}
+
+/*static*/ void CesiumTileFinalizationBudget::recordTileFinalized(
+    const UWorld* pWorld,
+    double milliseconds) {
+  WorldFinalizationState& state = getState(pWorld);
+  ++state.current.TilesFinalized;
+  state.current.MillisecondsSpent += milliseconds;
+}
+
+/*static*/ void CesiumTileFinalizationBudget::recordFinalizationTime(
+    const UWorld* pWorld,
+    double milliseconds) {
+  getState(pWorld).current.MillisecondsSpent += milliseconds;
+}
+
+/*static*/ void
+CesiumTileFinalizationBudget::dispatchMainThreadTasks(const UWorld* pWorld) {
+  CesiumAsync::AsyncSystem& asyncSystem = getAsyncSystem();
+  runWithinBudget(pWorld, [&asyncSystem]() {
+    return asyncSystem.dispatchOneMainThreadTask() ? Step::Worked
+                                                   : Step::Done;
+  });
+}
+
+/*static*/ void CesiumTileFinalizationBudget::addQueueLength(
+    const UWorld* pWorld,
+    uint32 queueLength) {
+  WorldFinalizationState& state = getState(pWorld);
+  state.current.QueueLength += int32(queueLength);
+}
+
+/*static*/ FCesiumTileFinalizationStats
+CesiumTileFinalizationBudget::getLastFrameStats(const UWorld* pWorld) {
+  return getState(pWorld).last;
+}
+
+/*static*/ FCesiumTileFinalizationStats
+CesiumTileFinalizationBudget::getCurrentFrameStats(const UWorld* pWorld) {
+  return getState(pWorld).current;
+}
@@ -0,0 +1,129 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumTileFinalizationStats.h"
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+
+class UWorld;
+
+/**
+ * Tracks the game-thread time spent finalizing newly-loaded tiles (see
+ * `IPrepareRendererResources::prepareInMainThread`) so that all of the
+ * tilesets in a world share a single per-frame budget, configured by
+ * `UCesiumRuntimeSettings::MainThreadTileFinalizationBudget`.
+ *
+ * Tiles that do not fit within the budget remain in cesium-native's
+ * main-thread load queue, which is ordered by load priority, and are
+ * finalized in a subsequent frame.
+ *
+ * All functions must be called from the game thread.
+ */
+class CesiumTileFinalizationBudget {
+public:
+  /**
+   * @brief The outcome of one step of the work done by {@link runWithinBudget}.
+   */
+  enum class Step {
+    /** There is no work left. */
+    Done,
+    /** The step did no work, so its time doesn't count against the budget. */
+    Skipped,
+    /** The step did some work, whose time counts against the budget. */
+    Worked
+  };
+
+  /**
+   * @brief Runs the given step repeatedly until it is done or the budget of
+   * the given world is used up, and counts the time of the steps that did
+   * work against the budget.
+   *
+   * At least one step that does work runs regardless of the budget, so that
+   * the work never stalls.
+   *
+   * @param pWorld The world whose budget the work counts against.
+   * @param step A function that does one piece of the work and returns a
+   * {@link Step}.
+   */
+  template <typename TStep>
+  static void runWithinBudget(const UWorld* pWorld, TStep&& step) {
+    bool worked = false;
+    while (!worked || !isExhausted(pWorld)) {
+      const double start = FPlatformTime::Seconds();
+      const Step result = step();
+      if (result == Step::Done) {
+        return;
+      }
+      if (result == Step::Worked) {
+        recordFinalizationTime(
+            pWorld,
+            (FPlatformTime::Seconds() - start) * 1000.0);
+        worked = true;
+      }
+    }
+  }
+
+  /**
+   * @brief Gets the time, in milliseconds, that remains in the current frame's
+   * budget for the given world. This is suitable for use as
+   * `TilesetOptions::mainThreadLoadingTimeLimit`.
+   *
+   * Returns 0.0 when the budget is disabled, which cesium-native interprets as
+   * "no limit". When the budget is exhausted, a tiny positive value is
+   * returned instead so that each tileset still finalizes at least one tile
+   * per frame and loading can never stall completely.
+   */
+  static double getRemainingMilliseconds(const UWorld* pWorld);
+
+  /**
+   * @brief Determines if this frame's budget for the given world has been
+   * used up. Always returns false when the budget is disabled.
+   */
+  static bool isExhausted(const UWorld* pWorld);
+
+  /**
+   * @brief Records that a tile was finalized in the given world, taking the
+   * given number of milliseconds.
+   */
+  static void recordTileFinalized(const UWorld* pWorld, double milliseconds);
+
+  /**
+   * @brief Records game-thread time spent on finalization work in the given
+   * world that is not tied to a newly-finalized tile, such as continuing the
+   * incremental construction of a tile's components.
+   */
+  static void recordFinalizationTime(const UWorld* pWorld, double milliseconds);
+
+  /**
+   * @brief Runs the continuations queued for the main thread through
+   * `getAsyncSystem()`, such as the preparation of raster overlay tiles, one
+   * at a time until none are left or the budget of the given world is used
+   * up. Their time counts against the budget. At least one continuation runs
+   * regardless of the budget, so that the queue never stalls.
+   *
+   * cesium-native still runs all of them when a tileset updates its view.
+   * This is for the places where the plugin runs them itself, such as when
+   * an idle editor viewport skips the view update.
+   */
+  static void dispatchMainThreadTasks(const UWorld* pWorld);
+
+  /**
+   * @brief Adds a tileset's main-thread load queue length to the current
+   * frame's statistics for the given world.
+   */
+  static void addQueueLength(const UWorld* pWorld, uint32 queueLength);
+
+  /**
+   * @brief Gets the statistics of the last complete frame for the given
+   * world.
+   */
+  static FCesiumTileFinalizationStats getLastFrameStats(const UWorld* pWorld);
+
+  /**
+   * @brief Gets the statistics accumulated so far in the current frame for
+   * the given world.
+   */
+  static FCesiumTileFinalizationStats
+  getCurrentFrameStats(const UWorld* pWorld);
+};
@@ -0,0 +1,122 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilePropertyStatistics.h"
+#include "CesiumPropertyStatistics.h"
+#include "CesiumPropertyTableProperty.h"
+#include <CesiumUtility/Tracing.h>
+#include <cmath>
+#include <limits>
+
+namespace {
+int32 getBucket(double value, double minimum, double maximum, int32 count) {
+  if (!(maximum > minimum)) {
+    return 0;
+  }
+  const double position = (value - minimum) / (maximum - minimum);
+  return FMath::Clamp(int32(position * count), 0, count - 1);
+}
+} // namespace
+
+std::optional<CesiumTilePropertyStatistics>
+CesiumTilePropertyStatistics::compute(
+    const FCesiumPropertyTableProperty& property) {
+  if (UCesiumPropertyTablePropertyBlueprintLibrary::
+          GetPropertyTablePropertyStatus(property) !=
+      ECesiumPropertyTablePropertyStatus::Valid) {
+    return std::nullopt;
+  }
+
+  const FCesiumMetadataValueType valueType =
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetValueType(property);
+  if (valueType.Type != ECesiumMetadataType::Scalar || valueType.bIsArray) {
+    return std::nullopt;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputePropertyStatistics)
+
+  // "No data" values without a default become NaN, which is ignored.
+  TArray<double> values;
+  values.SetNumUninitialized(
+      UCesiumPropertyTablePropertyBlueprintLibrary::GetPropertySize(property));
+  UCesiumPropertyTablePropertyBlueprintLibrary::CopyFloat64Values(
+      property,
+      0,
+      values,
+      std::numeric_limits<double>::quiet_NaN());
+  return compute(values);
+}
+
+std::optional<CesiumTilePropertyStatistics>
+CesiumTilePropertyStatistics::compute(TArrayView<const double> values) {
+  CesiumTilePropertyStatistics statistics;
+  statistics.minimum = std::numeric_limits<double>::max();
+  statistics.maximum = std::numeric_limits<double>::lowest();
+  for (double value : values) {
+    if (std::isnan(value)) {
+      continue;
+    }
+    ++statistics.count;
+    statistics.sum += value;
+    statistics.minimum = FMath::Min(statistics.minimum, value);
+    statistics.maximum = FMath::Max(statistics.maximum, value);
+  }
+
+  if (statistics.count == 0) {
+    return std::nullopt;
+  }
+
+  for (double value : values) {
+    if (!std::isnan(value)) {
+      ++statistics.histogram[getBucket(
+          value,
+          statistics.minimum,
+          statistics.maximum,
+          HistogramBucketCount)];
+    }
+  }
+
+  return statistics;
+}
+
+FCesiumPropertyStatistics CesiumTilePropertyStatistics::aggregate(
+    TArrayView<const CesiumTilePropertyStatistics* const> tiles,
+    int32 histogramBucketCount) {
+  FCesiumPropertyStatistics result;
+  result.Minimum = std::numeric_limits<double>::max();
+  result.Maximum = std::numeric_limits<double>::lowest();
+
+  double sum = 0.0;
+  for (const CesiumTilePropertyStatistics* pTile : tiles) {
+    result.Count += pTile->count;
+    sum += pTile->sum;
+    result.Minimum = FMath::Min(result.Minimum, pTile->minimum);
+    result.Maximum = FMath::Max(result.Maximum, pTile->maximum);
+  }
+
+  if (result.Count == 0) {
+    return FCesiumPropertyStatistics();
+  }
+
+  result.Mean = sum / double(result.Count);
+  result.Histogram.SetNumZeroed(FMath::Max(histogramBucketCount, 1));
+
+  // Count the values of each bucket of the tiles in the combined bucket of
+  // its center.
+  for (const CesiumTilePropertyStatistics* pTile : tiles) {
+    const double width =
+        (pTile->maximum - pTile->minimum) / double(HistogramBucketCount);
+    for (int32 i = 0; i < HistogramBucketCount; ++i) {
+      if (pTile->histogram[i] == 0) {
+        continue;
+      }
+      const double center = pTile->minimum + (double(i) + 0.5) * width;
+      result.Histogram[getBucket(
+          center,
+          result.Minimum,
+          result.Maximum,
+          result.Histogram.Num())] += pTile->histogram[i];
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,62 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "CoreMinimal.h"
+#include <array>
+#include <optional>
+
+struct FCesiumPropertyStatistics;
+struct FCesiumPropertyTableProperty;
+
+/**
+ * The statistics of the values of a scalar property table property of a
+ * single tile, which are computed when the property is encoded and combined
+ * across tiles with {@link aggregate}.
+ */
+class CesiumTilePropertyStatistics {
+public:
+  /**
+   * The number of buckets of the histogram of a tile, between its minimum and
+   * maximum value. It is fine enough that the histograms of tiles with
+   * different ranges can be combined into fewer buckets.
+   */
+  static constexpr int32 HistogramBucketCount = 64;
+
+  /**
+   * @brief Computes the statistics of the values of a property. May be called
+   * from any thread while the property's glTF is loaded.
+   *
+   * @returns The statistics, or std::nullopt if the property is not a
+   * non-array scalar or has no values.
+   */
+  static std::optional<CesiumTilePropertyStatistics>
+  compute(const FCesiumPropertyTableProperty& property);
+
+  /**
+   * @brief Computes the statistics of values. Values that are NaN are
+   * ignored.
+   *
+   * @returns The statistics, or std::nullopt if there are no values.
+   */
+  static std::optional<CesiumTilePropertyStatistics>
+  compute(TArrayView<const double> values);
+
+  /**
+   * @brief Combines the statistics of the tiles.
+   *
+   * @param tiles The statistics of the tiles.
+   * @param histogramBucketCount The number of buckets of the combined
+   * histogram.
+   */
+  static FCesiumPropertyStatistics aggregate(
+      TArrayView<const CesiumTilePropertyStatistics* const> tiles,
+      int32 histogramBucketCount);
+
+  int64 count = 0;
+  double minimum = 0.0;
+  double maximum = 0.0;
+  double sum = 0.0;
+  std::array<int64, HistogramBucketCount> histogram{};
+};
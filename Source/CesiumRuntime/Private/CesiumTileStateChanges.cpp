@@ -0,0 +1,152 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileStateChanges.h"
+#include "CesiumGltfComponent.h"
+
+void CesiumTileStateChanges::setVisibility(
+    UCesiumGltfComponent* pGltf,
+    bool visible) {
+  this->_changes.FindOrAdd(pGltf).visible = visible;
+}
+
+void CesiumTileStateChanges::setCollisionEnabled(
+    UCesiumGltfComponent* pGltf,
+    ECollisionEnabled::Type collisionEnabled) {
+  this->_changes.FindOrAdd(pGltf).collisionEnabled = collisionEnabled;
+}
+
+void CesiumTileStateChanges::setFade(
+    UCesiumGltfComponent* pGltf,
+    float percentage,
+    bool fadingIn) {
+  this->_changes.FindOrAdd(pGltf).fade = Fade{percentage, fadingIn};
+}
+
+void CesiumTileStateChanges::setTimedFade(
+    UCesiumGltfComponent* pGltf,
+    int32 customDataIndex,
+    float startTime,
+    float length,
+    bool fadingIn) {
+  this->_changes.FindOrAdd(pGltf).fade =
+      Fade{0.0f, fadingIn, customDataIndex, startTime, length};
+}
+
+void CesiumTileStateChanges::append(CesiumTileStateChanges&& other) {
+  if (this->_changes.IsEmpty()) {
+    this->_changes = MoveTemp(other._changes);
+    other._changes.Reset();
+    return;
+  }
+
+  for (const TPair<UCesiumGltfComponent*, Change>& pair : other._changes) {
+    Change& change = this->_changes.FindOrAdd(pair.Key);
+    if (pair.Value.visible) {
+      change.visible = pair.Value.visible;
+    }
+    if (pair.Value.collisionEnabled) {
+      change.collisionEnabled = pair.Value.collisionEnabled;
+    }
+    if (pair.Value.fade) {
+      change.fade = pair.Value.fade;
+    }
+  }
+  other._changes.Reset();
+}
+
+void CesiumTileStateChanges::remove(UCesiumGltfComponent* pGltf) {
+  this->_changes.Remove(pGltf);
+}
+
+int32 CesiumTileStateChanges::commit(
+    int32 maximumCollisionCreations,
+    TConstArrayView<FVector> priorityLocations) {
+  if (this->_changes.IsEmpty()) {
+    return 0;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CommitTileStateChanges)
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CommitTileVisibility)
+    for (const TPair<UCesiumGltfComponent*, Change>& pair : this->_changes) {
+      UCesiumGltfComponent* pGltf = pair.Key;
+      const Change& change = pair.Value;
+
+      if (change.visible && *change.visible != pGltf->IsVisible()) {
+        if (*change.visible) {
+          pGltf->ApplyPendingTransform();
+        }
+        pGltf->SetVisibility(*change.visible, true);
+      }
+
+      if (change.fade && change.fade->customDataIndex >= 0) {
+        pGltf->UpdateTimedFade(
+            change.fade->customDataIndex,
+            change.fade->startTime,
+            change.fade->length,
+            change.fade->fadingIn);
+      } else if (change.fade) {
+        pGltf->UpdateFade(change.fade->percentage, change.fade->fadingIn);
+      }
+    }
+  }
+
+  int32 deferredCollisionCreations = 0;
+
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CommitTileCollision)
+
+    struct CollisionCreation {
+      UCesiumGltfComponent* pGltf;
+      ECollisionEnabled::Type collisionEnabled;
+      double distanceSquared;
+    };
+    TArray<CollisionCreation> creations;
+
+    for (const TPair<UCesiumGltfComponent*, Change>& pair : this->_changes) {
+      UCesiumGltfComponent* pGltf = pair.Key;
+      const Change& change = pair.Value;
+      if (!change.collisionEnabled ||
+          *change.collisionEnabled == pGltf->GetPrimitiveCollisionEnabled()) {
+        continue;
+      }
+
+      const bool createsPhysicsState =
+          *change.collisionEnabled != ECollisionEnabled::NoCollision &&
+          pGltf->GetPrimitiveCollisionEnabled() ==
+              ECollisionEnabled::NoCollision;
+      if (maximumCollisionCreations > 0 && createsPhysicsState) {
+        const FBox bounds = pGltf->Bounds.GetBox();
+        double distanceSquared =
+            priorityLocations.IsEmpty() ? 0.0 : TNumericLimits<double>::Max();
+        for (const FVector& location : priorityLocations) {
+          distanceSquared = FMath::Min(
+              distanceSquared,
+              bounds.ComputeSquaredDistanceToPoint(location));
+        }
+        creations.Add({pGltf, *change.collisionEnabled, distanceSquared});
+      } else {
+        pGltf->SetCollisionEnabled(*change.collisionEnabled);
+      }
+    }
+
+    // Creating physics state adds bodies to the physics scene synchronously,
+    // so a burst of new tiles is spread over several frames.
+    if (creations.Num() > maximumCollisionCreations) {
+      creations.Sort(
+          [](const CollisionCreation& a, const CollisionCreation& b) {
+            return a.distanceSquared < b.distanceSquared;
+          });
+      deferredCollisionCreations = creations.Num() - maximumCollisionCreations;
+      creations.SetNum(maximumCollisionCreations);
+    }
+    for (const CollisionCreation& creation : creations) {
+      creation.pGltf->SetCollisionEnabled(creation.collisionEnabled);
+    }
+  }
+
+  this->_changes.Reset();
+
+  return deferredCollisionCreations;
+}
@@ -0,0 +1,112 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Engine/EngineTypes.h"
+#include <optional>
+
+class UCesiumGltfComponent;
+
+/**
+ * Gathers the visibility, collision, and fade changes that a tileset makes to
+ * its tiles' glTF components during a tick, so that they can be applied
+ * together once the whole view update has been processed.
+ *
+ * A component that is requested to change more than once keeps only the last
+ * request of each kind, so each component is visited once and each primitive
+ * has its render state marked dirty at most once per change. Visibility is
+ * applied to all components before any collision changes, so that physics
+ * state is created and destroyed in a single pass at the end. Collision that
+ * a component already has is not set again.
+ *
+ * All functions must be called from the game thread, and the components must
+ * remain valid until {@link commit} is called.
+ */
+class CesiumTileStateChanges {
+public:
+  /**
+   * Requests that a component be shown or hidden.
+   */
+  void setVisibility(UCesiumGltfComponent* pGltf, bool visible);
+
+  /**
+   * Requests that collision be enabled or disabled for a component.
+   */
+  void setCollisionEnabled(
+      UCesiumGltfComponent* pGltf,
+      ECollisionEnabled::Type collisionEnabled);
+
+  /**
+   * Requests that a component's LOD transition fade be updated. The fade is
+   * only applied if the component is visible once its visibility change, if
+   * any, has been applied.
+   */
+  void setFade(UCesiumGltfComponent* pGltf, float percentage, bool fadingIn);
+
+  /**
+   * Requests that a component's LOD transition fade be written to its
+   * primitives' Custom Primitive Data, for the material to compute its
+   * progress from. See UCesiumGltfComponent::UpdateTimedFade.
+   */
+  void setTimedFade(
+      UCesiumGltfComponent* pGltf,
+      int32 customDataIndex,
+      float startTime,
+      float length,
+      bool fadingIn);
+
+  /**
+   * Moves the changes requested of another instance into this one. A change
+   * requested of both keeps the other instance's request.
+   */
+  void append(CesiumTileStateChanges&& other);
+
+  /**
+   * Forgets the changes requested for a component, such as one that is about
+   * to be destroyed before the changes are committed.
+   */
+  void remove(UCesiumGltfComponent* pGltf);
+
+  /**
+   * Determines if no changes have been requested since the last commit.
+   */
+  bool isEmpty() const { return this->_changes.IsEmpty(); }
+
+  /**
+   * Applies and clears all of the requested changes.
+   *
+   * @param maximumCollisionCreations The most components that have their
+   * collision enabled, which creates the physics state of their primitives,
+   * or zero for no limit. The components nearest to the priority locations
+   * go first. The others are left without collision; their requests are
+   * dropped, so they must be made again.
+   * @param priorityLocations The locations, such as those of the actors that
+   * collide with the tiles, from which the components are prioritized.
+   * @return The number of components whose collision was not enabled because
+   * of the limit.
+   */
+  int32 commit(
+      int32 maximumCollisionCreations = 0,
+      TConstArrayView<FVector> priorityLocations = {});
+
+private:
+  struct Fade {
+    float percentage;
+    bool fadingIn;
+    // Zero or greater for a fade written to Custom Primitive Data, starting
+    // at startTime, rather than set to a percentage.
+    int32 customDataIndex = -1;
+    float startTime = 0.0f;
+    float length = 0.0f;
+  };
+
+  struct Change {
+    std::optional<bool> visible;
+    std::optional<ECollisionEnabled::Type> collisionEnabled;
+    std::optional<Fade> fade;
+  };
+
+  TMap<UCesiumGltfComponent*, Change> _changes;
+};
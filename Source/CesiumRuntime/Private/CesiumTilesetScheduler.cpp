@@ -0,0 +1,237 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetScheduler.h"
+#include "Cesium3DTileset.h"
+#include "CesiumAdaptiveTileLoads.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStreamingGovernor.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+struct Share {
+  double weight = 0.0;
+  double minimum = 0.0;
+  double maximum = 0.0;
+  double value = 0.0;
+};
+
+/**
+ * Gives each share its minimum, and then distributes the rest of the budget
+ * in proportion to the weights, without exceeding any share's maximum. What a
+ * share can't take because of its maximum is distributed among the others.
+ */
+void distribute(double budget, TArray<Share>& shares) {
+  for (Share& share : shares) {
+    share.value = std::min(share.minimum, share.maximum);
+    budget -= share.value;
+  }
+
+  while (budget > 0.0) {
+    double totalWeight = 0.0;
+    for (const Share& share : shares) {
+      if (share.value < share.maximum) {
+        totalWeight += share.weight;
+      }
+    }
+    if (totalWeight <= 0.0) {
+      break;
+    }
+
+    double spent = 0.0;
+    bool anyReachedMaximum = false;
+    for (Share& share : shares) {
+      if (share.value >= share.maximum) {
+        continue;
+      }
+      double add = budget * share.weight / totalWeight;
+      if (share.value + add >= share.maximum) {
+        add = share.maximum - share.value;
+        anyReachedMaximum = true;
+      }
+      share.value += add;
+      spent += add;
+    }
+
+    budget -= spent;
+    if (!anyReachedMaximum) {
+      break;
+    }
+  }
+}
+
+/**
+ * Rounds the values of the shares down, and then rounds up those with the
+ * largest fractions until the rounded values add up to the budget.
+ */
+void roundShares(int64 budget, TArray<Share>& shares) {
+  TArray<int32> byFraction;
+  byFraction.Reserve(shares.Num());
+  for (int32 i = 0; i < shares.Num(); ++i) {
+    budget -= int64(std::floor(shares[i].value));
+    byFraction.Add(i);
+  }
+
+  byFraction.Sort([&shares](int32 a, int32 b) {
+    return shares[a].value - std::floor(shares[a].value) >
+           shares[b].value - std::floor(shares[b].value);
+  });
+
+  for (Share& share : shares) {
+    share.value = std::floor(share.value);
+  }
+
+  for (int32 i : byFraction) {
+    if (budget <= 0) {
+      break;
+    }
+    Share& share = shares[i];
+    if (share.value + 1.0 <= share.maximum) {
+      share.value += 1.0;
+      --budget;
+    }
+  }
+}
+
+/**
+ * Scales a number of tile loads by the load scale of the streaming governor,
+ * keeping at least one load unless there were none.
+ */
+int32 scaleTileLoads(int32 loads, double scale) {
+  if (loads <= 0) {
+    return loads;
+  }
+  return std::max(int32(std::ceil(double(loads) * scale)), 1);
+}
+
+} // namespace
+
+UCesiumTilesetScheduler::Allocation
+UCesiumTilesetScheduler::allocate(const ACesium3DTileset& tileset) {
+  TilesetState* pState = this->_tilesets.Find(&tileset);
+  const bool isNew = pState == nullptr;
+  if (isNew) {
+    pState = &this->_tilesets.Add(&tileset);
+    pState->pTileset = &tileset;
+  }
+  pState->lastActiveFrame = GFrameCounter;
+
+  if (isNew || this->_lastRebalancedFrame != GFrameCounter) {
+    this->rebalance();
+  }
+
+  return pState->allocation;
+}
+
+void UCesiumTilesetScheduler::reportDemand(
+    const ACesium3DTileset& tileset,
+    int32 tilesWaitingToLoad,
+    int32 tilesRendered) {
+  TilesetState* pState = this->_tilesets.Find(&tileset);
+  if (!pState) {
+    return;
+  }
+
+  pState->lastActiveFrame = GFrameCounter;
+  pState->tilesWaitingToLoad = tilesWaitingToLoad;
+  pState->tilesRendered = tilesRendered;
+}
+
+int32 UCesiumTilesetScheduler::GetAllocatedSimultaneousTileLoads(
+    const ACesium3DTileset* Tileset) const {
+  const TilesetState* pState = this->_tilesets.Find(Tileset);
+  return pState ? pState->allocation.maximumSimultaneousTileLoads : 0;
+}
+
+int64 UCesiumTilesetScheduler::GetAllocatedCachedBytes(
+    const ACesium3DTileset* Tileset) const {
+  const TilesetState* pState = this->_tilesets.Find(Tileset);
+  return pState ? pState->allocation.maximumCachedBytes : 0;
+}
+
+void UCesiumTilesetScheduler::rebalance() {
+  this->_lastRebalancedFrame = GFrameCounter;
+
+  // Forget the tilesets that have been destroyed or that weren't updated in
+  // the previous frame, such as those that aren't ticked anymore.
+  for (auto it = this->_tilesets.CreateIterator(); it; ++it) {
+    if (!it.Value().pTileset.IsValid() ||
+        it.Value().lastActiveFrame + 1 < GFrameCounter) {
+      it.RemoveCurrent();
+    }
+  }
+
+  TArray<const ACesium3DTileset*> tilesets;
+  TArray<TilesetState*> states;
+  tilesets.Reserve(this->_tilesets.Num());
+  states.Reserve(this->_tilesets.Num());
+  for (auto& pair : this->_tilesets) {
+    tilesets.Add(pair.Value.pTileset.Get());
+    states.Add(&pair.Value);
+  }
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  TArray<Share> shares;
+  shares.SetNum(tilesets.Num());
+
+  // Adaptive loads are shared like a fixed pool, and any tileset may use all
+  // of them, since they track the capacity of the network.
+  const bool adaptive = CesiumAdaptiveTileLoads::isEnabled();
+  if (adaptive) {
+    CesiumAdaptiveTileLoads::update();
+  }
+
+  // A device under thermal or battery pressure gets fewer loads, whether
+  // they are shared or not.
+  CesiumStreamingGovernor::update();
+  const double loadScale = CesiumStreamingGovernor::getLoadScale();
+
+  const int32 sharedLoads = scaleTileLoads(
+      adaptive ? CesiumAdaptiveTileLoads::getSimultaneousTileLoads()
+               : pSettings->SharedMaximumSimultaneousTileLoads,
+      loadScale);
+  if (sharedLoads > 0) {
+    for (int32 i = 0; i < tilesets.Num(); ++i) {
+      shares[i].weight = double(std::max(tilesets[i]->LoadPriority, 0.0f)) *
+                         double(states[i]->tilesWaitingToLoad);
+      shares[i].minimum = 1.0;
+      shares[i].maximum =
+          adaptive ? double(sharedLoads)
+                   : double(scaleTileLoads(
+                         tilesets[i]->MaximumSimultaneousTileLoads,
+                         loadScale));
+    }
+    distribute(double(sharedLoads), shares);
+    roundShares(sharedLoads, shares);
+  }
+  for (int32 i = 0; i < tilesets.Num(); ++i) {
+    states[i]->allocation.maximumSimultaneousTileLoads =
+        sharedLoads > 0 ? int32(shares[i].value)
+                        : scaleTileLoads(
+                              tilesets[i]->MaximumSimultaneousTileLoads,
+                              loadScale);
+  }
+
+  const int64 sharedBytes =
+      int64(pSettings->SharedMaximumCachedMB) * 1024 * 1024;
+  if (sharedBytes > 0) {
+    for (int32 i = 0; i < tilesets.Num(); ++i) {
+      // Count at least one tile, so that a tileset isn't left without a share
+      // just because it rendered nothing in the previous frame.
+      shares[i].weight =
+          double(std::max(tilesets[i]->LoadPriority, 0.0f)) *
+          double(std::max(states[i]->tilesRendered, 1));
+      shares[i].minimum = 0.0;
+      shares[i].maximum =
+          double(std::max(tilesets[i]->MaximumCachedBytes, int64(0)));
+    }
+    distribute(double(sharedBytes), shares);
+  }
+  for (int32 i = 0; i < tilesets.Num(); ++i) {
+    states[i]->allocation.maximumCachedBytes =
+        sharedBytes > 0 ? int64(shares[i].value)
+                        : tilesets[i]->MaximumCachedBytes;
+  }
+}
@@ -0,0 +1,284 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetStatistics.h"
+#include "CesiumStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+namespace {
+
+// The initialized subsystem, so that stages can be recorded from any thread
+// without going through GEngine.
+std::atomic<UCesiumTilesetStatistics*> pInstance = nullptr;
+
+double percentile(const TArray<double>& sorted, double fraction) {
+  // Nearest-rank percentile.
+  int32 rank = FMath::CeilToInt32(fraction * sorted.Num());
+  return sorted[FMath::Clamp(rank - 1, 0, sorted.Num() - 1)];
+}
+
+} // namespace
+
+void UCesiumTilesetStatistics::Initialize(
+    FSubsystemCollectionBase& Collection) {
+  Super::Initialize(Collection);
+  pInstance = this;
+}
+
+void UCesiumTilesetStatistics::Deinitialize() {
+  UCesiumTilesetStatistics* pExpected = this;
+  pInstance.compare_exchange_strong(pExpected, nullptr);
+  Super::Deinitialize();
+}
+
+/*static*/ void UCesiumTilesetStatistics::RecordStage(
+    ECesiumTileLoadStage Stage,
+    double ElapsedMilliseconds) {
+  UCesiumTilesetStatistics* pStatistics = pInstance;
+  if (pStatistics) {
+    pStatistics->record(Stage, ElapsedMilliseconds);
+  }
+}
+
+/*static*/ void
+UCesiumTilesetStatistics::RecordRequestQueued(const FString& Host) {
+  CesiumStats::updateRequestQueue(1, 0);
+  updateHost(Host, [](FCesiumHostRequestStatistics& stats) {
+    ++stats.PendingRequests;
+  });
+}
+
+/*static*/ void
+UCesiumTilesetStatistics::RecordRequestStarted(const FString& Host) {
+  CesiumStats::updateRequestQueue(-1, 1);
+  updateHost(Host, [](FCesiumHostRequestStatistics& stats) {
+    --stats.PendingRequests;
+    ++stats.ActiveRequests;
+  });
+}
+
+/*static*/ void UCesiumTilesetStatistics::RecordRequestFinished(
+    const FString& Host,
+    bool bWasStarted,
+    bool bSucceeded,
+    int64 BytesReceived) {
+  CesiumStats::updateRequestQueue(bWasStarted ? 0 : -1, bWasStarted ? -1 : 0);
+  updateHost(Host, [&](FCesiumHostRequestStatistics& stats) {
+    if (bWasStarted) {
+      --stats.ActiveRequests;
+    } else {
+      --stats.PendingRequests;
+    }
+    if (bSucceeded) {
+      ++stats.CompletedRequests;
+    } else {
+      ++stats.FailedRequests;
+    }
+    stats.BytesReceived += BytesReceived;
+  });
+}
+
+/*static*/ void UCesiumTilesetStatistics::RecordMemoryCacheLookup(bool bHit) {
+  UCesiumTilesetStatistics* pStatistics = pInstance;
+  if (pStatistics) {
+    FScopeLock lock(&pStatistics->_lock);
+    if (bHit) {
+      ++pStatistics->_cache.MemoryHits;
+    } else {
+      ++pStatistics->_cache.MemoryMisses;
+    }
+  }
+}
+
+/*static*/ void
+UCesiumTilesetStatistics::RecordMemoryCacheSize(int32 Entries, int64 Bytes) {
+  UCesiumTilesetStatistics* pStatistics = pInstance;
+  if (pStatistics) {
+    FScopeLock lock(&pStatistics->_lock);
+    pStatistics->_cache.MemoryEntries = Entries;
+    pStatistics->_cache.MemoryBytes = Bytes;
+  }
+}
+
+/*static*/ void UCesiumTilesetStatistics::RecordDiskCacheMiss() {
+  UCesiumTilesetStatistics* pStatistics = pInstance;
+  if (pStatistics) {
+    FScopeLock lock(&pStatistics->_lock);
+    ++pStatistics->_cache.DiskMisses;
+  }
+}
+
+FCesiumTileLoadStageStatistics
+UCesiumTilesetStatistics::GetStageStatistics(ECesiumTileLoadStage Stage) const {
+  FCesiumTileLoadStageStatistics result;
+
+  const int32 index = int32(Stage);
+  if (index < 0 || index >= StageCount) {
+    return result;
+  }
+
+  TArray<double> sorted;
+  {
+    FScopeLock lock(&this->_lock);
+    sorted = this->_stages[index].samples;
+    result.TotalSampleCount = this->_stages[index].total;
+    result.TotalMilliseconds = this->_stages[index].totalMilliseconds;
+  }
+
+  if (sorted.IsEmpty()) {
+    return result;
+  }
+
+  sorted.Sort();
+
+  double sum = 0.0;
+  for (double sample : sorted) {
+    sum += sample;
+  }
+
+  result.SampleCount = sorted.Num();
+  result.AverageMilliseconds = sum / sorted.Num();
+  result.P50Milliseconds = percentile(sorted, 0.5);
+  result.P90Milliseconds = percentile(sorted, 0.9);
+  result.P99Milliseconds = percentile(sorted, 0.99);
+  result.MaximumMilliseconds = sorted.Last();
+  return result;
+}
+
+TArray<FCesiumHostRequestStatistics>
+UCesiumTilesetStatistics::GetHostStatistics() const {
+  TArray<FCesiumHostRequestStatistics> result;
+  {
+    FScopeLock lock(&this->_lock);
+    this->_hosts.GenerateValueArray(result);
+  }
+  result.Sort([](const FCesiumHostRequestStatistics& a,
+                 const FCesiumHostRequestStatistics& b) {
+    return a.Host < b.Host;
+  });
+  return result;
+}
+
+FCesiumRequestCacheStatistics
+UCesiumTilesetStatistics::GetCacheStatistics() const {
+  FCesiumRequestCacheStatistics result;
+  {
+    FScopeLock lock(&this->_lock);
+    result = this->_cache;
+  }
+
+  // Every miss of the memory tier is a lookup in the disk tier, so the disk
+  // tier's hits are the lookups that didn't reach the network. A request
+  // still in flight may have been counted as a memory miss but not yet as a
+  // disk miss, so this can briefly overcount.
+  result.DiskHits =
+      FMath::Max(int64(0), result.MemoryMisses - result.DiskMisses);
+  return result;
+}
+
+void UCesiumTilesetStatistics::Reset() {
+  FScopeLock lock(&this->_lock);
+  for (StageSamples& stage : this->_stages) {
+    stage.samples.Empty();
+    stage.next = 0;
+    stage.total = 0;
+    stage.totalMilliseconds = 0.0;
+  }
+
+  for (auto it = this->_hosts.CreateIterator(); it; ++it) {
+    FCesiumHostRequestStatistics& stats = it.Value();
+    if (stats.PendingRequests == 0 && stats.ActiveRequests == 0) {
+      it.RemoveCurrent();
+    } else {
+      stats.CompletedRequests = 0;
+      stats.FailedRequests = 0;
+      stats.BytesReceived = 0;
+    }
+  }
+
+  this->_cache.MemoryHits = 0;
+  this->_cache.MemoryMisses = 0;
+  this->_cache.DiskMisses = 0;
+}
+
+FString UCesiumTilesetStatistics::ExportToCsv() const {
+  const UEnum* pStageEnum = StaticEnum<ECesiumTileLoadStage>();
+
+  FString csv = TEXT("Stage,SampleCount,TotalSampleCount,AverageMilliseconds,"
+                     "P50Milliseconds,P90Milliseconds,P99Milliseconds,"
+                     "MaximumMilliseconds,TotalMilliseconds\n");
+  for (int32 i = 0; i < StageCount; ++i) {
+    ECesiumTileLoadStage stage = ECesiumTileLoadStage(i);
+    FCesiumTileLoadStageStatistics stats = this->GetStageStatistics(stage);
+    csv += FString::Printf(
+        TEXT("%s,%d,%lld,%f,%f,%f,%f,%f,%f\n"),
+        *pStageEnum->GetNameStringByValue(int64(stage)),
+        stats.SampleCount,
+        stats.TotalSampleCount,
+        stats.AverageMilliseconds,
+        stats.P50Milliseconds,
+        stats.P90Milliseconds,
+        stats.P99Milliseconds,
+        stats.MaximumMilliseconds,
+        stats.TotalMilliseconds);
+  }
+  return csv;
+}
+
+bool UCesiumTilesetStatistics::SaveToCsvFile(const FString& Filename) const {
+  return FFileHelper::SaveStringToFile(this->ExportToCsv(), *Filename);
+}
+
+FString UCesiumTilesetStatistics::ExportHostStatisticsToCsv() const {
+  FString csv = TEXT("Host,PendingRequests,ActiveRequests,CompletedRequests,"
+                     "FailedRequests,BytesReceived\n");
+  for (const FCesiumHostRequestStatistics& stats : this->GetHostStatistics()) {
+    csv += FString::Printf(
+        TEXT("%s,%d,%d,%lld,%lld,%lld\n"),
+        *stats.Host,
+        stats.PendingRequests,
+        stats.ActiveRequests,
+        stats.CompletedRequests,
+        stats.FailedRequests,
+        stats.BytesReceived);
+  }
+  return csv;
+}
+
+void UCesiumTilesetStatistics::record(
+    ECesiumTileLoadStage stage,
+    double milliseconds) {
+  const int32 index = int32(stage);
+  if (index < 0 || index >= StageCount) {
+    return;
+  }
+
+  FScopeLock lock(&this->_lock);
+  StageSamples& samples = this->_stages[index];
+  if (samples.samples.Num() < MaximumSamplesPerStage) {
+    samples.samples.Add(milliseconds);
+  } else {
+    samples.samples[samples.next] = milliseconds;
+  }
+  samples.next = (samples.next + 1) % MaximumSamplesPerStage;
+  ++samples.total;
+  samples.totalMilliseconds += milliseconds;
+}
+
+/*static*/ void UCesiumTilesetStatistics::updateHost(
+    const FString& host,
+    TFunctionRef<void(FCesiumHostRequestStatistics&)> update) {
+  UCesiumTilesetStatistics* pStatistics = pInstance;
+  if (!pStatistics) {
+    return;
+  }
+
+  FScopeLock lock(&pStatistics->_lock);
+  FCesiumHostRequestStatistics* pStats = pStatistics->_hosts.Find(host);
+  if (!pStats) {
+    pStats = &pStatistics->_hosts.Add(host);
+    pStats->Host = host;
+  }
+  update(*pStats);
+}
@@ -0,0 +1,228 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTimeDynamicTilesetComponent.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntime.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+
+namespace {
+
+/**
+ * Copies the editable properties that Cesium3DTileset and its subclasses
+ * declare from one tileset to another. The properties of AActor, such as the
+ * transform, and transient state are not copied.
+ */
+void copyTilesetProperties(
+    const ACesium3DTileset& source,
+    ACesium3DTileset& target) {
+  for (TFieldIterator<FProperty> it(source.GetClass()); it; ++it) {
+    FProperty* pProperty = *it;
+    const UClass* pOwnerClass = pProperty->GetOwnerClass();
+    if (!pOwnerClass ||
+        !pOwnerClass->IsChildOf(ACesium3DTileset::StaticClass()) ||
+        !pProperty->HasAnyPropertyFlags(CPF_Edit) ||
+        pProperty->HasAnyPropertyFlags(CPF_Transient | CPF_EditConst)) {
+      continue;
+    }
+    pProperty->CopyCompleteValue_InContainer(&target, &source);
+  }
+}
+
+void setTimeStepVisible(ACesium3DTileset& tileset, bool visible) {
+  if (tileset.IsHidden() == visible) {
+    tileset.SetActorHiddenInGame(!visible);
+  }
+  if (tileset.GetActorEnableCollision() != visible) {
+    tileset.SetActorEnableCollision(visible);
+  }
+}
+
+} // namespace
+
+UCesiumTimeDynamicTilesetComponent::UCesiumTimeDynamicTilesetComponent() {
+  this->PrimaryComponentTick.bCanEverTick = true;
+}
+
+ACesium3DTileset*
+UCesiumTimeDynamicTilesetComponent::GetTimeStepTileset(int32 TimeStep) const {
+  const TObjectPtr<ACesium3DTileset>* ppTileset =
+      this->_timeSteps.Find(TimeStep);
+  return ppTileset && IsValid(*ppTileset) ? ppTileset->Get() : nullptr;
+}
+
+void UCesiumTimeDynamicTilesetComponent::BeginPlay() {
+  Super::BeginPlay();
+
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (!pTileset) {
+    UE_LOG(
+        LogCesium,
+        Warning,
+        TEXT(
+            "CesiumTimeDynamicTilesetComponent %s is not attached to a Cesium3DTileset, so it has no effect."),
+        *this->GetName());
+    return;
+  }
+
+  this->_originalSuspendUpdate = pTileset->SuspendUpdate;
+  this->_originalHidden = pTileset->IsHidden();
+  this->_originalCollision = pTileset->GetActorEnableCollision();
+  this->_displayedTimeStep = -1;
+
+  // The owner's own tiles are unloaded, and it loads no more while the time
+  // steps are shown in its place.
+  pTileset->SuspendUpdate = true;
+  pTileset->RefreshTileset();
+  setTimeStepVisible(*pTileset, false);
+  this->_isControlling = true;
+}
+
+void UCesiumTimeDynamicTilesetComponent::EndPlay(
+    const EEndPlayReason::Type EndPlayReason) {
+  this->destroyTimeSteps();
+
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (this->_isControlling && pTileset) {
+    pTileset->SuspendUpdate = this->_originalSuspendUpdate;
+    pTileset->SetActorHiddenInGame(this->_originalHidden);
+    pTileset->SetActorEnableCollision(this->_originalCollision);
+  }
+
+  this->_isControlling = false;
+
+  Super::EndPlay(EndPlayReason);
+}
+
+void UCesiumTimeDynamicTilesetComponent::TickComponent(
+    float DeltaTime,
+    ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+  ACesium3DTileset* pTileset = this->getTileset();
+  if (!this->_isControlling || !pTileset) {
+    return;
+  }
+
+  const int32 count = this->TimeStepUrls.Num();
+  if (count == 0) {
+    this->destroyTimeSteps();
+    return;
+  }
+
+  const int32 current = this->Loop
+                            ? ((this->CurrentTimeStep % count) + count) % count
+                            : FMath::Clamp(this->CurrentTimeStep, 0, count - 1);
+
+  // The current time step, the ones after it, and the one that is shown
+  // until the current one has loaded.
+  TArray<int32, TInlineAllocator<8>> wanted;
+  for (int32 i = 0; i <= FMath::Max(this->PrefetchTimeSteps, 0); ++i) {
+    int32 timeStep = current + i;
+    if (timeStep >= count) {
+      if (!this->Loop) {
+        break;
+      }
+      timeStep %= count;
+    }
+    wanted.AddUnique(timeStep);
+  }
+
+  if (this->_displayedTimeStep != current && this->WaitForTimeStepToLoad &&
+      this->_displayedTimeStep >= 0 &&
+      this->GetTimeStepTileset(this->_displayedTimeStep)) {
+    wanted.AddUnique(this->_displayedTimeStep);
+  }
+
+  for (auto it = this->_timeSteps.CreateIterator(); it; ++it) {
+    if (!IsValid(it->Value) || !wanted.Contains(it->Key) ||
+        it->Value->GetUrl() != this->TimeStepUrls[it->Key]) {
+      if (IsValid(it->Value)) {
+        it->Value->Destroy();
+      }
+      if (it->Key == this->_displayedTimeStep) {
+        this->_displayedTimeStep = -1;
+      }
+      it.RemoveCurrent();
+    }
+  }
+
+  for (int32 timeStep : wanted) {
+    if (!this->_timeSteps.Contains(timeStep)) {
+      ACesium3DTileset* pTimeStep = this->spawnTimeStep(*pTileset, timeStep);
+      if (pTimeStep) {
+        this->_timeSteps.Add(timeStep, pTimeStep);
+      }
+    }
+  }
+
+  if (this->_displayedTimeStep != current &&
+      (!this->WaitForTimeStepToLoad || this->_displayedTimeStep < 0 ||
+       this->isLoaded(current))) {
+    this->_displayedTimeStep = current;
+  }
+
+  for (const auto& pair : this->_timeSteps) {
+    setTimeStepVisible(*pair.Value, pair.Key == this->_displayedTimeStep);
+  }
+}
+
+ACesium3DTileset* UCesiumTimeDynamicTilesetComponent::getTileset() const {
+  return Cast<ACesium3DTileset>(this->GetOwner());
+}
+
+ACesium3DTileset* UCesiumTimeDynamicTilesetComponent::spawnTimeStep(
+    ACesium3DTileset& owner,
+    int32 timeStep) {
+  UWorld* pWorld = owner.GetWorld();
+  if (!pWorld) {
+    return nullptr;
+  }
+
+  const FString name =
+      FString::Printf(TEXT("%s_TimeStep%d"), *owner.GetName(), timeStep);
+
+  FActorSpawnParameters parameters;
+  parameters.Name = MakeUniqueObjectName(
+      pWorld->GetCurrentLevel(),
+      owner.GetClass(),
+      FName(name));
+  parameters.ObjectFlags = RF_Transient;
+  parameters.bDeferConstruction = true;
+  parameters.SpawnCollisionHandlingOverride =
+      ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+  const FTransform transform = owner.GetActorTransform();
+  ACesium3DTileset* pTimeStep = pWorld->SpawnActor<ACesium3DTileset>(
+      owner.GetClass(),
+      transform,
+      parameters);
+  if (!pTimeStep) {
+    return nullptr;
+  }
+
+  copyTilesetProperties(owner, *pTimeStep);
+  pTimeStep->SuspendUpdate = false;
+  pTimeStep->SetTilesetSource(ETilesetSource::FromUrl);
+  pTimeStep->SetUrl(this->TimeStepUrls[timeStep]);
+  pTimeStep->SetActorHiddenInGame(true);
+  pTimeStep->SetActorEnableCollision(false);
+  pTimeStep->FinishSpawning(transform);
+  return pTimeStep;
+}
+
+bool UCesiumTimeDynamicTilesetComponent::isLoaded(int32 timeStep) const {
+  const ACesium3DTileset* pTimeStep = this->GetTimeStepTileset(timeStep);
+  return pTimeStep && pTimeStep->GetLoadProgress() >= 100.0f;
+}
+
+void UCesiumTimeDynamicTilesetComponent::destroyTimeSteps() {
+  for (const auto& pair : this->_timeSteps) {
+    if (IsValid(pair.Value)) {
+      pair.Value->Destroy();
+    }
+  }
+  this->_timeSteps.Empty();
+  this->_displayedTimeStep = -1;
+}
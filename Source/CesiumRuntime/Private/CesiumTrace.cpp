@@ -0,0 +1,113 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTrace.h"
+#include "CesiumGltf/Model.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+UE_TRACE_CHANNEL_DEFINE(CesiumChannel)
+
+UE_TRACE_EVENT_BEGIN(Cesium, TileLoad)
+  UE_TRACE_EVENT_FIELD(uint64, LoadStartCycle)
+  UE_TRACE_EVENT_FIELD(uint64, LoadEndCycle)
+  UE_TRACE_EVENT_FIELD(uint64, FinalizeStartCycle)
+  UE_TRACE_EVENT_FIELD(uint64, FinalizeEndCycle)
+  UE_TRACE_EVENT_FIELD(uint64, ContentBytes)
+  UE_TRACE_EVENT_FIELD(uint64, VertexCount)
+  UE_TRACE_EVENT_FIELD(uint64, TextureBytes)
+  UE_TRACE_EVENT_FIELD(UE::Trace::WideString, TileId)
+  UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Url)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_INT_COUNTER(
+    CesiumWorkerThreadTileLoadQueue,
+    TEXT("Cesium/Tiles/WorkerThreadQueue"));
+TRACE_DECLARE_INT_COUNTER(
+    CesiumMainThreadTileLoadQueue,
+    TEXT("Cesium/Tiles/MainThreadQueue"));
+TRACE_DECLARE_INT_COUNTER(
+    CesiumIncrementalTileBuilds,
+    TEXT("Cesium/Tiles/IncrementalBuilds"));
+TRACE_DECLARE_INT_COUNTER(
+    CesiumPendingRequests,
+    TEXT("Cesium/Requests/Pending"));
+TRACE_DECLARE_INT_COUNTER(CesiumActiveRequests, TEXT("Cesium/Requests/Active"));
+
+namespace CesiumTrace {
+
+namespace {
+
+// The queue lengths of each tileset, by tileset. Only used in the game
+// thread.
+TMap<const void*, FIntVector> tileQueues;
+
+} // namespace
+
+bool isEnabled() { return UE_TRACE_CHANNELEXPR_IS_ENABLED(CesiumChannel); }
+
+void addModelSizes(const CesiumGltf::Model& model, TileLoadStatistics& stats) {
+  for (const CesiumGltf::Mesh& mesh : model.meshes) {
+    for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives) {
+      auto positionIt = primitive.attributes.find("POSITION");
+      if (positionIt == primitive.attributes.end()) {
+        continue;
+      }
+      const CesiumGltf::Accessor* pAccessor =
+          model.getSafe(&model.accessors, positionIt->second);
+      if (pAccessor) {
+        stats.vertexCount += uint64(pAccessor->count);
+      }
+    }
+  }
+
+  for (const CesiumGltf::Image& image : model.images) {
+    stats.textureBytes += uint64(image.cesium.pixelData.size());
+  }
+}
+
+void traceTileLoad(
+    const FString& tileId,
+    const TileLoadStatistics& stats,
+    uint64 finalizeStartCycle,
+    uint64 finalizeEndCycle) {
+  UE_TRACE_LOG(Cesium, TileLoad, CesiumChannel)
+      << TileLoad.LoadStartCycle(stats.loadStartCycle)
+      << TileLoad.LoadEndCycle(stats.loadEndCycle)
+      << TileLoad.FinalizeStartCycle(finalizeStartCycle)
+      << TileLoad.FinalizeEndCycle(finalizeEndCycle)
+      << TileLoad.ContentBytes(stats.contentBytes)
+      << TileLoad.VertexCount(stats.vertexCount)
+      << TileLoad.TextureBytes(stats.textureBytes)
+      << TileLoad.TileId(*tileId, tileId.Len())
+      << TileLoad.Url(*stats.url, stats.url.Len());
+}
+
+void traceTileQueues(
+    const void* pTileset,
+    int32 workerThreadQueueLength,
+    int32 mainThreadQueueLength,
+    int32 incrementalBuildCount) {
+  const FIntVector queues(
+      workerThreadQueueLength,
+      mainThreadQueueLength,
+      incrementalBuildCount);
+  if (queues == FIntVector::ZeroValue) {
+    tileQueues.Remove(pTileset);
+  } else {
+    tileQueues.Add(pTileset, queues);
+  }
+
+  FIntVector total = FIntVector::ZeroValue;
+  for (const TPair<const void*, FIntVector>& pair : tileQueues) {
+    total += pair.Value;
+  }
+  TRACE_COUNTER_SET(CesiumWorkerThreadTileLoadQueue, total.X);
+  TRACE_COUNTER_SET(CesiumMainThreadTileLoadQueue, total.Y);
+  TRACE_COUNTER_SET(CesiumIncrementalTileBuilds, total.Z);
+}
+
+void traceRequestQueue(int32 pendingRequests, int32 activeRequests) {
+  TRACE_COUNTER_SET(CesiumPendingRequests, pendingRequests);
+  TRACE_COUNTER_SET(CesiumActiveRequests, activeRequests);
+}
+
+} // namespace CesiumTrace
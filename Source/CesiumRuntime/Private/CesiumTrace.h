@@ -0,0 +1,91 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * The trace channel of the events that describe individual tiles as they are
+ * loaded. It is off by default, and is enabled in Unreal Insights or with
+ * `-trace=cpu,counters,cesium`. While it is enabled, the CPU timing scopes of
+ * the tile loading stages are also named after the tile they cover, so that a
+ * hitch can be traced back to the tiles that caused it.
+ */
+UE_TRACE_CHANNEL_EXTERN(CesiumChannel)
+
+namespace CesiumTrace {
+
+/**
+ * The sizes and times of the part of a tile's load that happens in a worker
+ * thread, which are traced with the rest of the tile's load once it is
+ * finished in the game thread. The times are in CPU cycles, as returned by
+ * `FPlatformTime::Cycles64`.
+ */
+struct TileLoadStatistics {
+  FString url;
+  uint64 contentBytes = 0;
+  uint64 vertexCount = 0;
+  uint64 textureBytes = 0;
+  uint64 loadStartCycle = 0;
+  uint64 loadEndCycle = 0;
+};
+
+/**
+ * Determines whether the Cesium trace channel is enabled, so that the
+ * information for its events only needs to be gathered when it is.
+ */
+bool isEnabled();
+
+/**
+ * Records the number of vertices and the size of the images of a model in the
+ * statistics.
+ */
+void addModelSizes(const CesiumGltf::Model& model, TileLoadStatistics& stats);
+
+/**
+ * Traces a `Cesium.TileLoad` event, for a tile that has been created in the
+ * game thread.
+ *
+ * @param tileId The tile's ID, as returned by
+ * `TileIdUtilities::createTileIdString`.
+ * @param stats The statistics of its load in a worker thread.
+ * @param finalizeStartCycle When its creation in the game thread started.
+ * @param finalizeEndCycle When its creation in the game thread ended.
+ */
+void traceTileLoad(
+    const FString& tileId,
+    const TileLoadStatistics& stats,
+    uint64 finalizeStartCycle,
+    uint64 finalizeEndCycle);
+
+/**
+ * Updates the trace counters of the tiles that are waiting to be loaded,
+ * which add up the queues of all tilesets.
+ *
+ * @param pTileset The tileset whose queues these are. Its queues are
+ * forgotten once they are all empty.
+ * @param workerThreadQueueLength The number of tiles waiting to be loaded in
+ * a worker thread.
+ * @param mainThreadQueueLength The number of tiles waiting to be finished in
+ * the game thread.
+ * @param incrementalBuildCount The number of tiles whose components are being
+ * created over several frames.
+ */
+void traceTileQueues(
+    const void* pTileset,
+    int32 workerThreadQueueLength,
+    int32 mainThreadQueueLength,
+    int32 incrementalBuildCount);
+
+/**
+ * Updates the trace counters of the network requests that are waiting to be
+ * sent and that are in flight.
+ */
+void traceRequestQueue(int32 pendingRequests, int32 activeRequests);
+
+} // namespace CesiumTrace
@@ -0,0 +1,304 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTriangleBVH.h"
+#include <algorithm>
+
+namespace {
+
+// Leaves with a few triangles keep the hierarchy small without making traces
+// test many triangles.
+constexpr int32 MaximumLeafTriangles = 4;
+
+// Used instead of the inverse of a zero direction component, to avoid
+// multiplying infinity by zero.
+constexpr double LargeInverse = 1.0e30;
+
+struct BuildTask {
+  int32 nodeIndex;
+  int32 first;
+  int32 count;
+};
+
+/**
+ * Intersects a line with the bounds of a node.
+ *
+ * @returns true if the line enters the bounds before maximumTime, in which
+ * case entryTime is set to when it does.
+ */
+bool intersectBounds(
+    const FVector3f& minimum,
+    const FVector3f& maximum,
+    const FVector& start,
+    const FVector& inverseDirection,
+    double maximumTime,
+    double& entryTime) {
+  double enter = 0.0;
+  double exit = maximumTime;
+  for (int32 axis = 0; axis < 3; ++axis) {
+    double t0 = (double(minimum[axis]) - start[axis]) * inverseDirection[axis];
+    double t1 = (double(maximum[axis]) - start[axis]) * inverseDirection[axis];
+    if (t0 > t1) {
+      std::swap(t0, t1);
+    }
+    enter = FMath::Max(enter, t0);
+    exit = FMath::Min(exit, t1);
+    if (enter > exit) {
+      return false;
+    }
+  }
+
+  entryTime = enter;
+  return true;
+}
+
+/**
+ * Intersects a line with a triangle, from either side, using the
+ * Möller-Trumbore algorithm.
+ */
+bool intersectTriangle(
+    const FVector& start,
+    const FVector& direction,
+    const FVector& v0,
+    const FVector& v1,
+    const FVector& v2,
+    double maximumTime,
+    double& time) {
+  const FVector edge1 = v1 - v0;
+  const FVector edge2 = v2 - v0;
+  const FVector p = FVector::CrossProduct(direction, edge2);
+  const double determinant = FVector::DotProduct(edge1, p);
+  if (FMath::Abs(determinant) < UE_DOUBLE_SMALL_NUMBER) {
+    return false;
+  }
+
+  const double inverseDeterminant = 1.0 / determinant;
+  const FVector s = start - v0;
+  const double u = FVector::DotProduct(s, p) * inverseDeterminant;
+  if (u < 0.0 || u > 1.0) {
+    return false;
+  }
+
+  const FVector q = FVector::CrossProduct(s, edge1);
+  const double v = FVector::DotProduct(direction, q) * inverseDeterminant;
+  if (v < 0.0 || u + v > 1.0) {
+    return false;
+  }
+
+  const double t = FVector::DotProduct(edge2, q) * inverseDeterminant;
+  if (t < 0.0 || t > maximumTime) {
+    return false;
+  }
+
+  time = t;
+  return true;
+}
+
+} // namespace
+
+/*static*/ TSharedPtr<const CesiumTriangleBVH> CesiumTriangleBVH::build(
+    TArray<FVector3f>&& positions,
+    const TArray<uint32>& indices) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BuildTriangleBVH)
+
+  const int32 triangleCount = indices.Num() / 3;
+  if (triangleCount == 0) {
+    return nullptr;
+  }
+
+  const uint32 vertexCount = uint32(positions.Num());
+  for (uint32 index : indices) {
+    if (index >= vertexCount) {
+      return nullptr;
+    }
+  }
+
+  TSharedPtr<CesiumTriangleBVH> pBVH = MakeShared<CesiumTriangleBVH>();
+  pBVH->_positions = MoveTemp(positions);
+  const TArray<FVector3f>& vertices = pBVH->_positions;
+
+  TArray<FVector3f> centroids;
+  centroids.SetNumUninitialized(triangleCount);
+  TArray<int32> order;
+  order.SetNumUninitialized(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    centroids[i] = (vertices[indices[3 * i]] + vertices[indices[3 * i + 1]] +
+                    vertices[indices[3 * i + 2]]) /
+                   3.0f;
+    order[i] = i;
+  }
+
+  // Each node is split at the median of the centroids of its triangles along
+  // the axis in which they are spread the most.
+  TArray<Node>& nodes = pBVH->_nodes;
+  nodes.Reserve(2 * (triangleCount / MaximumLeafTriangles + 1));
+  nodes.AddDefaulted();
+
+  TArray<BuildTask, TInlineAllocator<64>> tasks;
+  tasks.Add({0, 0, triangleCount});
+  while (!tasks.IsEmpty()) {
+    const BuildTask task = tasks.Pop(false);
+
+    FBox3f bounds(ForceInit);
+    FBox3f centroidBounds(ForceInit);
+    for (int32 i = task.first; i < task.first + task.count; ++i) {
+      const int32 triangle = order[i];
+      bounds += vertices[indices[3 * triangle]];
+      bounds += vertices[indices[3 * triangle + 1]];
+      bounds += vertices[indices[3 * triangle + 2]];
+      centroidBounds += centroids[triangle];
+    }
+
+    const FVector3f extent = centroidBounds.GetSize();
+    const int32 axis = extent.X >= extent.Y && extent.X >= extent.Z ? 0
+                       : extent.Y >= extent.Z                        ? 1
+                                                                     : 2;
+
+    Node& node = nodes[task.nodeIndex];
+    node.minimum = bounds.Min;
+    node.maximum = bounds.Max;
+
+    if (task.count <= MaximumLeafTriangles || extent[axis] <= 0.0f) {
+      node.index = task.first;
+      node.triangleCount = task.count;
+      continue;
+    }
+
+    const int32 firstChild = nodes.Num();
+    node.index = firstChild;
+    node.triangleCount = 0;
+    nodes.AddDefaulted(2);
+
+    const int32 middle = task.first + task.count / 2;
+    std::nth_element(
+        order.GetData() + task.first,
+        order.GetData() + middle,
+        order.GetData() + task.first + task.count,
+        [&centroids, axis](int32 a, int32 b) {
+          return centroids[a][axis] < centroids[b][axis];
+        });
+
+    tasks.Add({firstChild, task.first, middle - task.first});
+    tasks.Add({firstChild + 1, middle, task.first + task.count - middle});
+  }
+
+  pBVH->_triangles.SetNumUninitialized(triangleCount);
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 triangle = order[i];
+    pBVH->_triangles[i] = FIntVector(
+        int32(indices[3 * triangle]),
+        int32(indices[3 * triangle + 1]),
+        int32(indices[3 * triangle + 2]));
+  }
+  pBVH->_triangleIndices = MoveTemp(order);
+  nodes.Shrink();
+
+  return pBVH;
+}
+
+bool CesiumTriangleBVH::lineTrace(
+    const FVector& start,
+    const FVector& end,
+    Hit& hit) const {
+  if (this->_nodes.IsEmpty()) {
+    return false;
+  }
+
+  const FVector direction = end - start;
+  const FVector inverseDirection(
+      direction.X != 0.0 ? 1.0 / direction.X : LargeInverse,
+      direction.Y != 0.0 ? 1.0 / direction.Y : LargeInverse,
+      direction.Z != 0.0 ? 1.0 / direction.Z : LargeInverse);
+
+  double closestTime = 1.0;
+  int32 closestTriangle = -1;
+
+  TArray<int32, TInlineAllocator<64>> stack;
+  stack.Add(0);
+  while (!stack.IsEmpty()) {
+    const Node& node = this->_nodes[stack.Pop(false)];
+    double entryTime;
+    if (!intersectBounds(
+            node.minimum,
+            node.maximum,
+            start,
+            inverseDirection,
+            closestTime,
+            entryTime)) {
+      continue;
+    }
+
+    if (node.triangleCount == 0) {
+      // Visit the nearer child first, so that the farther one can often be
+      // skipped.
+      const Node& first = this->_nodes[node.index];
+      double firstTime;
+      double secondTime;
+      const bool hitsFirst = intersectBounds(
+          first.minimum,
+          first.maximum,
+          start,
+          inverseDirection,
+          closestTime,
+          firstTime);
+      const Node& second = this->_nodes[node.index + 1];
+      const bool hitsSecond = intersectBounds(
+          second.minimum,
+          second.maximum,
+          start,
+          inverseDirection,
+          closestTime,
+          secondTime);
+      if (hitsFirst && hitsSecond) {
+        const bool firstIsNearer = firstTime <= secondTime;
+        stack.Add(firstIsNearer ? node.index + 1 : node.index);
+        stack.Add(firstIsNearer ? node.index : node.index + 1);
+      } else if (hitsFirst) {
+        stack.Add(node.index);
+      } else if (hitsSecond) {
+        stack.Add(node.index + 1);
+      }
+      continue;
+    }
+
+    for (int32 i = node.index; i < node.index + node.triangleCount; ++i) {
+      const FIntVector& triangle = this->_triangles[i];
+      double time;
+      if (intersectTriangle(
+              start,
+              direction,
+              FVector(this->_positions[triangle.X]),
+              FVector(this->_positions[triangle.Y]),
+              FVector(this->_positions[triangle.Z]),
+              closestTime,
+              time)) {
+        closestTime = time;
+        closestTriangle = i;
+      }
+    }
+  }
+
+  if (closestTriangle < 0) {
+    return false;
+  }
+
+  const FIntVector& triangle = this->_triangles[closestTriangle];
+  const FVector v0(this->_positions[triangle.X]);
+  FVector normal = FVector::CrossProduct(
+      FVector(this->_positions[triangle.Y]) - v0,
+      FVector(this->_positions[triangle.Z]) - v0);
+  if (FVector::DotProduct(normal, direction) > 0.0) {
+    normal = -normal;
+  }
+
+  hit.time = closestTime;
+  hit.triangleIndex = this->_triangleIndices[closestTriangle];
+  hit.normal = normal;
+  return true;
+}
+
+SIZE_T CesiumTriangleBVH::getAllocatedSize() const {
+  return sizeof(*this) + this->_positions.GetAllocatedSize() +
+         this->_triangles.GetAllocatedSize() +
+         this->_triangleIndices.GetAllocatedSize() +
+         this->_nodes.GetAllocatedSize();
+}
@@ -0,0 +1,94 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A bounding volume hierarchy over the triangles of a tile mesh, for tracing
+ * lines against tiles without physics meshes. It is immutable once built, so
+ * it may be traced against from any thread.
+ */
+class CesiumTriangleBVH {
+public:
+  /**
+   * A hit of a line trace against the triangles.
+   */
+  struct Hit {
+    /**
+     * The fraction of the distance from the start to the end of the line at
+     * which the triangle was hit.
+     */
+    double time;
+
+    /**
+     * The index of the triangle that was hit, in the triangles that the
+     * hierarchy was built from.
+     */
+    int32 triangleIndex;
+
+    /**
+     * The normal of the triangle that was hit, facing the start of the line,
+     * in the coordinates of the triangles. It isn't normalized.
+     */
+    FVector normal;
+  };
+
+  /**
+   * @brief Builds a hierarchy. May be called from any thread.
+   *
+   * @param positions The positions of the vertices.
+   * @param indices The indices of the triangles, three per triangle.
+   * @returns The hierarchy, or nullptr if there are no triangles or an index
+   * is out of range.
+   */
+  static TSharedPtr<const CesiumTriangleBVH>
+  build(TArray<FVector3f>&& positions, const TArray<uint32>& indices);
+
+  /**
+   * @brief Finds the first triangle that a line segment hits. Both sides of
+   * the triangles are hit.
+   *
+   * @param start The start of the line, in the coordinates of the triangles.
+   * @param end The end of the line, in the coordinates of the triangles.
+   * @param hit Receives the first hit, if there is one.
+   * @returns true if a triangle was hit.
+   */
+  bool lineTrace(const FVector& start, const FVector& end, Hit& hit) const;
+
+  /**
+   * @brief Gets the number of bytes used by the hierarchy.
+   */
+  SIZE_T getAllocatedSize() const;
+
+private:
+  /**
+   * A node of the hierarchy. A leaf has triangles, and an inner node has two
+   * children, which are next to each other.
+   */
+  struct Node {
+    FVector3f minimum;
+    FVector3f maximum;
+
+    /**
+     * The index of the first triangle of a leaf, or of the first child of an
+     * inner node.
+     */
+    int32 index;
+
+    /**
+     * The number of triangles of a leaf, or zero for an inner node.
+     */
+    int32 triangleCount;
+  };
+
+  TArray<FVector3f> _positions;
+
+  // The vertex indices of the triangles, in the order of the leaves.
+  TArray<FIntVector> _triangles;
+
+  // The index of each triangle in the triangles the hierarchy was built from.
+  TArray<int32> _triangleIndices;
+
+  TArray<Node> _nodes;
+};
@@ -0,0 +1,261 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexKernels.h"
+#include <cstring>
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#define CESIUM_VERTEX_KERNELS_NEON 1
+#include <arm_neon.h>
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#define CESIUM_VERTEX_KERNELS_SSE 1
+#include <emmintrin.h>
+#endif
+
+#if defined(CESIUM_VERTEX_KERNELS_NEON) || defined(CESIUM_VERTEX_KERNELS_SSE)
+#define CESIUM_VERTEX_KERNELS_VECTORIZED 1
+#endif
+
+using namespace CesiumGltf;
+
+namespace {
+
+template <typename T> const std::byte* getData(const AccessorView<T>& view) {
+  return reinterpret_cast<const std::byte*>(&view[0]);
+}
+
+template <typename T> bool isTightlyPacked(const AccessorView<T>& view) {
+  return view.stride() == int64(sizeof(T));
+}
+
+#ifdef CESIUM_VERTEX_KERNELS_VECTORIZED
+/**
+ * Loads the position at the given index. Positions other than the last are
+ * loaded with a four-component load, which reads the first component of the
+ * next position into W, so W must be ignored.
+ */
+VectorRegister4Float loadPosition(
+    const std::byte* pData,
+    int64 stride,
+    int64 index,
+    int64 count) {
+  const float* pPosition =
+      reinterpret_cast<const float*>(pData + index * stride);
+  return index + 1 < count ? VectorLoad(pPosition)
+                           : VectorLoadFloat3(pPosition);
+}
+#endif
+
+} // namespace
+
+namespace CesiumVertexKernels {
+
+void computeBounds(
+    const AccessorView<FVector3f>& positions,
+    FVector3f& min,
+    FVector3f& max) {
+#ifdef CESIUM_VERTEX_KERNELS_VECTORIZED
+  const int64 count = positions.size();
+  if (count == 0) {
+    return;
+  }
+
+  const std::byte* pData = getData(positions);
+  const int64 stride = positions.stride();
+
+  VectorRegister4Float minimum = loadPosition(pData, stride, 0, count);
+  VectorRegister4Float maximum = minimum;
+  for (int64 i = 1; i < count; ++i) {
+    const VectorRegister4Float position =
+        loadPosition(pData, stride, i, count);
+    minimum = VectorMin(minimum, position);
+    maximum = VectorMax(maximum, position);
+  }
+
+  float result[4];
+  VectorStore(minimum, result);
+  min = FVector3f(result[0], result[1], result[2]);
+  VectorStore(maximum, result);
+  max = FVector3f(result[0], result[1], result[2]);
+#else
+  Scalar::computeBounds(positions, min, max);
+#endif
+}
+
+void copyIndices(const AccessorView<uint8_t>& indices, uint32* pOut) {
+  if (!isTightlyPacked(indices)) {
+    Scalar::copyIndices(indices, pOut);
+    return;
+  }
+
+  const int64 count = indices.size();
+  const uint8_t* pIn = count > 0 ? &indices[0] : nullptr;
+  int64 i = 0;
+
+#if defined(CESIUM_VERTEX_KERNELS_NEON)
+  for (; i + 16 <= count; i += 16) {
+    const uint8x16_t bytes = vld1q_u8(pIn + i);
+    const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+    const uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+    vst1q_u32(pOut + i, vmovl_u16(vget_low_u16(low)));
+    vst1q_u32(pOut + i + 4, vmovl_u16(vget_high_u16(low)));
+    vst1q_u32(pOut + i + 8, vmovl_u16(vget_low_u16(high)));
+    vst1q_u32(pOut + i + 12, vmovl_u16(vget_high_u16(high)));
+  }
+#elif defined(CESIUM_VERTEX_KERNELS_SSE)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 16 <= count; i += 16) {
+    const __m128i bytes =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+    const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+    __m128i* pDestination = reinterpret_cast<__m128i*>(pOut + i);
+    _mm_storeu_si128(pDestination, _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128(pDestination + 1, _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128(pDestination + 2, _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128(pDestination + 3, _mm_unpackhi_epi16(high, zero));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    pOut[i] = pIn[i];
+  }
+}
+
+void copyIndices(const AccessorView<uint16_t>& indices, uint32* pOut) {
+  if (!isTightlyPacked(indices)) {
+    Scalar::copyIndices(indices, pOut);
+    return;
+  }
+
+  const int64 count = indices.size();
+  const uint16_t* pIn = count > 0 ? &indices[0] : nullptr;
+  int64 i = 0;
+
+#if defined(CESIUM_VERTEX_KERNELS_NEON)
+  for (; i + 8 <= count; i += 8) {
+    const uint16x8_t shorts = vld1q_u16(pIn + i);
+    vst1q_u32(pOut + i, vmovl_u16(vget_low_u16(shorts)));
+    vst1q_u32(pOut + i + 4, vmovl_u16(vget_high_u16(shorts)));
+  }
+#elif defined(CESIUM_VERTEX_KERNELS_SSE)
+  const __m128i zero = _mm_setzero_si128();
+  for (; i + 8 <= count; i += 8) {
+    const __m128i shorts =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pIn + i));
+    __m128i* pDestination = reinterpret_cast<__m128i*>(pOut + i);
+    _mm_storeu_si128(pDestination, _mm_unpacklo_epi16(shorts, zero));
+    _mm_storeu_si128(pDestination + 1, _mm_unpackhi_epi16(shorts, zero));
+  }
+#endif
+
+  for (; i < count; ++i) {
+    pOut[i] = pIn[i];
+  }
+}
+
+void copyIndices(const AccessorView<uint32_t>& indices, uint32* pOut) {
+  if (!isTightlyPacked(indices)) {
+    Scalar::copyIndices(indices, pOut);
+    return;
+  }
+
+  const int64 count = indices.size();
+  if (count > 0) {
+    std::memcpy(pOut, &indices[0], size_t(count) * sizeof(uint32));
+  }
+}
+
+float copyPositionsInvertingY(
+    const AccessorView<FVector3f>& positions,
+    const uint32* pSources,
+    int64 count,
+    const FVector3f& center,
+    FVector3f* pOut) {
+#ifdef CESIUM_VERTEX_KERNELS_VECTORIZED
+  const int64 size = positions.size();
+  const std::byte* pData = size > 0 ? getData(positions) : nullptr;
+  const int64 stride = positions.stride();
+
+  // Multiplying by zero doesn't clear a W that isn't a number, but W is never
+  // stored, and VectorDot3 ignores it.
+  const VectorRegister4Float invertY =
+      MakeVectorRegister(1.0f, -1.0f, 1.0f, 0.0f);
+  const VectorRegister4Float centerRegister =
+      MakeVectorRegister(center.X, center.Y, center.Z, 0.0f);
+  VectorRegister4Float maximumDistanceSquared = VectorZeroFloat();
+
+  for (int64 i = 0; i < count; ++i) {
+    const int64 source = pSources ? int64(pSources[i]) : i;
+    const VectorRegister4Float position =
+        source < size ? VectorMultiply(
+                            loadPosition(pData, stride, source, size),
+                            invertY)
+                      : VectorZeroFloat();
+    VectorStoreFloat3(position, &pOut[i].X);
+
+    const VectorRegister4Float offset =
+        VectorSubtract(position, centerRegister);
+    maximumDistanceSquared =
+        VectorMax(maximumDistanceSquared, VectorDot3(offset, offset));
+  }
+
+  float result;
+  VectorStoreFloat1(maximumDistanceSquared, &result);
+  return FMath::Sqrt(result);
+#else
+  return Scalar::copyPositionsInvertingY(
+      positions,
+      pSources,
+      count,
+      center,
+      pOut);
+#endif
+}
+
+namespace Scalar {
+
+void computeBounds(
+    const AccessorView<FVector3f>& positions,
+    FVector3f& min,
+    FVector3f& max) {
+  if (positions.size() == 0) {
+    return;
+  }
+
+  FVector3f minimum = positions[0];
+  FVector3f maximum = minimum;
+  for (int64 i = 1; i < positions.size(); ++i) {
+    const FVector3f& position = positions[i];
+    minimum = minimum.ComponentMin(position);
+    maximum = maximum.ComponentMax(position);
+  }
+
+  min = minimum;
+  max = maximum;
+}
+
+float copyPositionsInvertingY(
+    const AccessorView<FVector3f>& positions,
+    const uint32* pSources,
+    int64 count,
+    const FVector3f& center,
+    FVector3f* pOut) {
+  float maximumDistanceSquared = 0.0f;
+  for (int64 i = 0; i < count; ++i) {
+    const int64 source = pSources ? int64(pSources[i]) : i;
+    FVector3f position(0.0f);
+    if (source < positions.size()) {
+      const FVector3f& gltfPosition = positions[source];
+      position = FVector3f(gltfPosition.X, -gltfPosition.Y, gltfPosition.Z);
+    }
+    pOut[i] = position;
+    maximumDistanceSquared = FMath::Max(
+        maximumDistanceSquared,
+        FVector3f::DistSquared(position, center));
+  }
+  return FMath::Sqrt(maximumDistanceSquared);
+}
+
+} // namespace Scalar
+
+} // namespace CesiumVertexKernels
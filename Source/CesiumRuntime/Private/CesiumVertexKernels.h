@@ -0,0 +1,126 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <CesiumGltf/AccessorView.h>
+
+/**
+ * The inner loops that run for every vertex or index of a glTF primitive as
+ * its mesh is created. Where the platform has vector intrinsics, which every
+ * 64-bit platform supported by Unreal does (SSE2 or NEON), they are used for
+ * accessors whose elements are tightly packed. Otherwise, and for other
+ * accessors, the scalar versions in {@link CesiumVertexKernels::Scalar} are
+ * used. All of them may be called from any thread.
+ */
+namespace CesiumVertexKernels {
+
+/**
+ * @brief Computes the bounding box of all the positions of an accessor.
+ *
+ * @param positions The positions, which must be valid.
+ * @param min Receives the minimum of each coordinate. Left as it is if there
+ * are no positions.
+ * @param max Receives the maximum of each coordinate. Left as it is if there
+ * are no positions.
+ */
+void computeBounds(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    FVector3f& min,
+    FVector3f& max);
+
+/**
+ * @brief Copies the indices of an accessor, widening them to 32 bits.
+ *
+ * @param indices The indices, which must be valid.
+ * @param pOut Receives `indices.size()` indices.
+ */
+void copyIndices(
+    const CesiumGltf::AccessorView<uint8_t>& indices,
+    uint32* pOut);
+
+/** @copydoc copyIndices */
+void copyIndices(
+    const CesiumGltf::AccessorView<uint16_t>& indices,
+    uint32* pOut);
+
+/** @copydoc copyIndices */
+void copyIndices(
+    const CesiumGltf::AccessorView<uint32_t>& indices,
+    uint32* pOut);
+
+/**
+ * @brief Copies positions into a vertex buffer, inverting their Y coordinates
+ * to convert them to Unreal's left-handed coordinate system.
+ *
+ * @param positions The positions, which must be valid.
+ * @param pSources If not null, the index of the position to copy to each
+ * vertex. A vertex whose index is out of range is set to the origin. If null,
+ * the positions are copied in order.
+ * @param count The number of vertices to write.
+ * @param center The point to measure distances from, in Unreal's coordinate
+ * system.
+ * @param pOut Receives the `count` positions.
+ * @return The largest distance between a copied position and the center, or
+ * zero if there are none.
+ */
+float copyPositionsInvertingY(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    const uint32* pSources,
+    int64 count,
+    const FVector3f& center,
+    FVector3f* pOut);
+
+/**
+ * @brief Converts a normalized floating-point color, whose components are
+ * between 0.0 and 1.0, to an 8-bit color. Components outside of that range
+ * are clamped, and the others are truncated like `uint8(value * 255.0f)`.
+ */
+FORCEINLINE FColor convertColor(float r, float g, float b, float a) {
+  // FColor is stored as BGRA.
+  const VectorRegister4Float scaled = VectorMultiply(
+      MakeVectorRegister(b, g, r, a),
+      MakeVectorRegister(255.0f, 255.0f, 255.0f, 255.0f));
+  FColor result;
+  VectorStoreByte4(
+      VectorMin(
+          VectorMax(scaled, VectorZeroFloat()),
+          MakeVectorRegister(255.0f, 255.0f, 255.0f, 255.0f)),
+      &result);
+  return result;
+}
+
+/**
+ * The scalar versions of the kernels, which give the same results. They're
+ * used for accessors whose elements aren't tightly packed, and by the tests
+ * to measure the speedup of the vectorized versions.
+ */
+namespace Scalar {
+
+/** @copydoc CesiumVertexKernels::computeBounds */
+void computeBounds(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    FVector3f& min,
+    FVector3f& max);
+
+/** @copydoc CesiumVertexKernels::copyIndices */
+template <typename TIndex>
+void copyIndices(
+    const CesiumGltf::AccessorView<TIndex>& indices,
+    uint32* pOut) {
+  for (int64 i = 0; i < indices.size(); ++i) {
+    pOut[i] = uint32(indices[i]);
+  }
+}
+
+/** @copydoc CesiumVertexKernels::copyPositionsInvertingY */
+float copyPositionsInvertingY(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    const uint32* pSources,
+    int64 count,
+    const FVector3f& center,
+    FVector3f* pOut);
+
+} // namespace Scalar
+
+} // namespace CesiumVertexKernels
@@ -4,209 +4,422 @@
 
 #include "Cesium3DTileset.h"
 #include "CesiumCommon.h"
+#include "CesiumGaussianSplatSceneProxy.h"
+#include "CesiumVoxelSceneProxy.h"
+#include "GlobalShader.h"
+#include "PixelShaderUtils.h"
+#include "RenderGraphUtils.h"
 #include "Runtime/Launch/Resources/Version.h"
-
-using namespace Cesium3DTilesSelection;
+#include "Runtime/Renderer/Private/PostProcess/PostProcessing.h"
+#include "Runtime/Renderer/Private/SceneRendering.h"
+#include "ShaderParameterStruct.h"
 
 CesiumViewExtension::CesiumViewExtension(const FAutoRegister& autoRegister)
     : FSceneViewExtensionBase(autoRegister) {}
 
 CesiumViewExtension::~CesiumViewExtension() = default;
 
-TileOcclusionState CesiumViewExtension::getPrimitiveOcclusionState(
-    const FPrimitiveComponentId& id,
-    bool previouslyOccluded,
-    float frameTimeCutoff) const {
-  if (_currentOcclusionResults.occlusionResultsByView.size() == 0) {
-    return TileOcclusionState::OcclusionUnavailable;
+void CesiumViewExtension::SetupViewFamily(FSceneViewFamily& InViewFamily) {}
+
+void CesiumViewExtension::SetupView(
+    FSceneViewFamily& InViewFamily,
+    FSceneView& InView) {}
+
+void CesiumViewExtension::BeginRenderViewFamily(
+    FSceneViewFamily& InViewFamily) {}
+
+namespace {
+
+// Readbacks that haven't finished after this many view families are left to
+// finish before more bounds are tested, so that a slow GPU doesn't accumulate
+// them.
+constexpr int32 MaximumOcclusionReadbacks = 8;
+
+class FCesiumHiZOcclusionCS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumHiZOcclusionCS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumHiZOcclusionCS, FGlobalShader);
+
+  static constexpr int32 ThreadGroupSize = 64;
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, BoundsCenters)
+  SHADER_PARAMETER_RDG_BUFFER_SRV(StructuredBuffer<float4>, BoundsExtents)
+  SHADER_PARAMETER(uint32, NumBounds)
+  SHADER_PARAMETER(FMatrix44f, TranslatedWorldToClip)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, HZBTexture)
+  SHADER_PARAMETER_SAMPLER(SamplerState, HZBSampler)
+  SHADER_PARAMETER(FVector2f, HZBUvFactor)
+  SHADER_PARAMETER(FVector2f, HZBSize)
+  SHADER_PARAMETER_RDG_BUFFER_UAV(RWBuffer<uint>, RWVisibility)
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
   }
+};
 
-  bool isOccluded = false;
-  bool historyMissing = false;
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumHiZOcclusionCS,
+    "/Plugin/CesiumForUnreal/Private/CesiumHiZOcclusion.usf",
+    "MainCS",
+    SF_Compute);
 
-  for (const SceneViewOcclusionResults& viewOcclusionResults :
-       _currentOcclusionResults.occlusionResultsByView) {
-    const PrimitiveOcclusionResult* pOcclusionResult =
-        viewOcclusionResults.PrimitiveOcclusionResults.Find(id);
+} // namespace
+
+void CesiumViewExtension::PostRenderViewFamily_RenderThread(
+    FRDGBuilder& GraphBuilder,
+    FSceneViewFamily& InViewFamily) {
+  this->_finishOcclusionReadbacks_renderThread();
 
-    if (pOcclusionResult &&
-        pOcclusionResult->LastConsideredTime >= frameTimeCutoff) {
-      if (!pOcclusionResult->OcclusionStateWasDefiniteLastFrame) {
-        return TileOcclusionState::OcclusionUnavailable;
+  if (!this->_isEnabled ||
+      this->_occlusionReadbacks_renderThread.Num() >=
+          MaximumOcclusionReadbacks) {
+    return;
+  }
+
+  // The depth pyramid of a view is built from its depth after the base pass,
+  // so it's still available here.
+  TArray<const FViewInfo*, TInlineAllocator<4>> views;
+  for (const FSceneView* pView : InViewFamily.Views) {
+    if (pView && pView->bIsViewInfo &&
+        pView->GetFeatureLevel() >= ERHIFeatureLevel::SM5) {
+      const FViewInfo* pViewInfo = static_cast<const FViewInfo*>(pView);
+      if (pViewInfo->HZB) {
+        views.Add(pViewInfo);
       }
+    }
+  }
 
-      if (previouslyOccluded) {
-        if (pOcclusionResult->LastPixelsPercentage > 0.01f) {
-          return TileOcclusionState::NotOccluded;
-        }
-      } else if (!pOcclusionResult->WasOccludedLastFrame) {
-        return TileOcclusionState::NotOccluded;
+  if (views.IsEmpty()) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::TestOcclusion)
+
+  // Gather the bounds of all tilesets in the scene, so they are tested
+  // together.
+  OcclusionReadback readback;
+  readback.count = 0;
+  readback.frameNumber = InViewFamily.FrameNumber;
+  TArray<FVector> centers;
+  TArray<FVector4f> extents;
+  {
+    FScopeLock lock(&this->_occlusionLock);
+    for (const auto& pair : this->_occlusion) {
+      if (pair.Value.pScene != InViewFamily.Scene ||
+          pair.Value.bounds.IsEmpty()) {
+        continue;
       }
 
-      isOccluded = true;
-    } else {
-      historyMissing = true;
+      TestedOcclusionBounds& tested = readback.tested.Emplace_GetRef();
+      tested.pTileset = pair.Key;
+      tested.boundsSerial = pair.Value.boundsSerial;
+      tested.keys.Reserve(pair.Value.bounds.Num());
+      for (const OcclusionBounds& bounds : pair.Value.bounds) {
+        // Unused slots are skipped by the shader, but keep their place so
+        // that the results stay indexed by slot.
+        tested.keys.Add(bounds.key);
+        centers.Add(bounds.center);
+        extents.Add(FVector4f(
+            FVector3f(bounds.extent),
+            bounds.key != 0 ? 1.0f : 0.0f));
+      }
     }
   }
 
-  if (historyMissing) {
-    return TileOcclusionState::OcclusionUnavailable;
-  } else if (isOccluded) {
-    return TileOcclusionState::Occluded;
-  } else {
-    return TileOcclusionState::NotOccluded;
+  readback.count = centers.Num();
+  if (readback.count == 0) {
+    return;
   }
+
+  FRDGBufferRef visibility = GraphBuilder.CreateBuffer(
+      FRDGBufferDesc::CreateBufferDesc(sizeof(uint32), readback.count),
+      TEXT("CesiumOcclusionVisibility"));
+  FRDGBufferUAVRef visibilityUAV =
+      GraphBuilder.CreateUAV(visibility, PF_R32_UINT);
+  AddClearUAVPass(GraphBuilder, visibilityUAV, 0u);
+
+  FRDGBufferSRVRef extentsSRV = GraphBuilder.CreateSRV(CreateStructuredBuffer(
+      GraphBuilder,
+      TEXT("CesiumOcclusionExtents"),
+      extents));
+
+  for (const FViewInfo* pViewInfo : views) {
+    // The centers are uploaded for each view, because they are relative to
+    // the view origin to keep their precision.
+    const FVector preViewTranslation =
+        pViewInfo->ViewMatrices.GetPreViewTranslation();
+    TArray<FVector4f> centers4;
+    centers4.SetNumUninitialized(readback.count);
+    for (int32 i = 0; i < readback.count; ++i) {
+      centers4[i] = FVector4f(FVector3f(centers[i] + preViewTranslation), 1.0f);
+    }
+
+    const FIntPoint viewSize = pViewInfo->ViewRect.Size();
+    const FIntPoint hzbSize = pViewInfo->HZBMipmap0Size;
+
+    FCesiumHiZOcclusionCS::FParameters* pParameters =
+        GraphBuilder.AllocParameters<FCesiumHiZOcclusionCS::FParameters>();
+    pParameters->BoundsCenters = GraphBuilder.CreateSRV(CreateStructuredBuffer(
+        GraphBuilder,
+        TEXT("CesiumOcclusionCenters"),
+        centers4));
+    pParameters->BoundsExtents = extentsSRV;
+    pParameters->NumBounds = uint32(readback.count);
+    pParameters->TranslatedWorldToClip = FMatrix44f(
+        pViewInfo->ViewMatrices.GetTranslatedViewProjectionMatrix());
+    pParameters->HZBTexture = pViewInfo->HZB;
+    pParameters->HZBSampler = TStaticSamplerState<SF_Point>::GetRHI();
+    pParameters->HZBUvFactor = FVector2f(
+        float(viewSize.X) / float(2 * hzbSize.X),
+        float(viewSize.Y) / float(2 * hzbSize.Y));
+    pParameters->HZBSize = FVector2f(hzbSize);
+    pParameters->RWVisibility = visibilityUAV;
+
+    TShaderMapRef<FCesiumHiZOcclusionCS> computeShader(pViewInfo->ShaderMap);
+    FComputeShaderUtils::AddPass(
+        GraphBuilder,
+        RDG_EVENT_NAME("CesiumHiZOcclusion"),
+        computeShader,
+        pParameters,
+        FComputeShaderUtils::GetGroupCount(
+            readback.count,
+            FCesiumHiZOcclusionCS::ThreadGroupSize));
+  }
+
+  readback.pReadback =
+      MakeUnique<FRHIGPUBufferReadback>(TEXT("CesiumOcclusionReadback"));
+  AddEnqueueCopyPass(
+      GraphBuilder,
+      readback.pReadback.Get(),
+      visibility,
+      readback.count * sizeof(uint32));
+  this->_occlusionReadbacks_renderThread.Add(MoveTemp(readback));
 }
 
-void CesiumViewExtension::SetupViewFamily(FSceneViewFamily& InViewFamily) {}
+void CesiumViewExtension::_finishOcclusionReadbacks_renderThread() {
+  int32 finished = 0;
+  for (OcclusionReadback& readback : this->_occlusionReadbacks_renderThread) {
+    if (!readback.pReadback->IsReady()) {
+      break;
+    }
+    ++finished;
+
+    const uint32* pVisibility = static_cast<const uint32*>(
+        readback.pReadback->Lock(readback.count * sizeof(uint32)));
+    FScopeLock lock(&this->_occlusionLock);
+    for (TestedOcclusionBounds& tested : readback.tested) {
+      const int32 count = tested.keys.Num();
+
+      // The tileset may have stopped culling occluded tiles since its bounds
+      // were tested.
+      TilesetOcclusion* pOcclusion = this->_occlusion.Find(tested.pTileset);
+      if (!pOcclusion) {
+        pVisibility += count;
+        continue;
+      }
 
-void CesiumViewExtension::SetupView(
-    FSceneViewFamily& InViewFamily,
-    FSceneView& InView) {}
+      // If the same bounds were tested in another view family of the frame,
+      // they are visible if they are visible in either.
+      const bool merge = pOcclusion->resultSerial == tested.boundsSerial &&
+                         pOcclusion->resultFrameNumber == readback.frameNumber;
+      pOcclusion->resultSerial = tested.boundsSerial;
+      pOcclusion->resultFrameNumber = readback.frameNumber;
+
+      pOcclusion->resultKeys.SetNumZeroed(count);
+      pOcclusion->resultVisibility.SetNumZeroed(count);
+      if (pOcclusion->isSlotChanged.Num() < count) {
+        pOcclusion->isSlotChanged.Add(
+            false,
+            count - pOcclusion->isSlotChanged.Num());
+      }
 
-void CesiumViewExtension::BeginRenderViewFamily(
-    FSceneViewFamily& InViewFamily) {
-  if (!this->_isEnabled)
-    return;
+      const uint8* pPrevious = pOcclusion->resultVisibility.GetData();
+      for (int32 slot = 0; slot < count; ++slot) {
+        const uint8 visible =
+            (pVisibility[slot] != 0 || (merge && pPrevious[slot])) ? 1 : 0;
+        pOcclusion->setResult(slot, tested.keys[slot], visible);
+      }
 
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DequeueOcclusionResults)
-  if (!_occlusionResultsQueue.IsEmpty()) {
-    // Recycle the current occlusion results.
-    for (SceneViewOcclusionResults& occlusionResults :
-         _currentOcclusionResults.occlusionResultsByView) {
-      occlusionResults.PrimitiveOcclusionResults.Reset();
-      _recycledOcclusionResultSets.Enqueue(
-          std::move(occlusionResults.PrimitiveOcclusionResults));
+      pVisibility += count;
     }
-    _currentOcclusionResults = {};
+    readback.pReadback->Unlock();
+  }
+
+  this->_occlusionReadbacks_renderThread.RemoveAt(0, finished);
+}
 
-    // Update occlusion results from the queue.
-    _currentOcclusionResults = std::move(*_occlusionResultsQueue.Peek());
-    _occlusionResultsQueue.Pop();
+void CesiumViewExtension::TilesetOcclusion::setResult(
+    int32 slot,
+    uint32 key,
+    uint8 visible) {
+  if (this->resultKeys[slot] == key &&
+      this->resultVisibility[slot] == visible) {
+    return;
+  }
+
+  this->resultKeys[slot] = key;
+  this->resultVisibility[slot] = visible;
+  if (key != 0 && !this->isSlotChanged[slot]) {
+    this->isSlotChanged[slot] = true;
+    this->changedSlots.Add(slot);
   }
 }
 
-namespace {
+void CesiumViewExtension::SetEnabled(bool enabled) {
+  this->_isEnabled = enabled;
+}
 
-const TSet<FPrimitiveOcclusionHistory, FPrimitiveOcclusionHistoryKeyFuncs>&
-getOcclusionHistorySet(const FSceneViewState* pViewState) {
-#if ENGINE_VERSION_5_3_OR_HIGHER
-  return pViewState->Occlusion.PrimitiveOcclusionHistorySet;
-#else
-  return pViewState->PrimitiveOcclusionHistorySet;
-#endif
+void CesiumViewExtension::SetOcclusionBounds(
+    const ACesium3DTileset* pTileset,
+    const FSceneInterface* pScene,
+    TArray<OcclusionBounds>&& bounds) {
+  FScopeLock lock(&this->_occlusionLock);
+  if (pScene) {
+    TilesetOcclusion& occlusion = this->_occlusion.FindOrAdd(pTileset);
+    occlusion.pScene = pScene;
+    occlusion.bounds = MoveTemp(bounds);
+    ++occlusion.boundsSerial;
+  } else {
+    this->_occlusion.Remove(pTileset);
+  }
 }
 
-} // namespace
+bool CesiumViewExtension::GetOcclusionResults(
+    const ACesium3DTileset* pTileset,
+    TArray<OcclusionResult>& changes) {
+  changes.Reset();
 
-void CesiumViewExtension::PostRenderViewFamily_RenderThread(
-    FRDGBuilder& GraphBuilder,
-    FSceneViewFamily& InViewFamily) {
-  if (!this->_isEnabled)
-    return;
+  FScopeLock lock(&this->_occlusionLock);
+  TilesetOcclusion* pOcclusion = this->_occlusion.Find(pTileset);
+  if (!pOcclusion || pOcclusion->changedSlots.IsEmpty()) {
+    return false;
+  }
 
-  if (_frameNumber_renderThread != InViewFamily.FrameNumber) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EnqueueAggregatedOcclusion)
-    if (_frameNumber_renderThread != -1) {
-      _occlusionResultsQueue.Enqueue(
-          std::move(_currentAggregation_renderThread));
-      _currentAggregation_renderThread = {};
+  changes.Reserve(pOcclusion->changedSlots.Num());
+  for (int32 slot : pOcclusion->changedSlots) {
+    // The results may have shrunk since the slot changed.
+    if (slot < pOcclusion->resultKeys.Num()) {
+      changes.Add(
+          {slot,
+           pOcclusion->resultKeys[slot],
+           pOcclusion->resultVisibility[slot] != 0});
     }
+    pOcclusion->isSlotChanged[slot] = false;
+  }
+  pOcclusion->changedSlots.Reset();
+  return !changes.IsEmpty();
+}
 
-    _frameNumber_renderThread = InViewFamily.FrameNumber;
+namespace {
+
+class FCesiumEyeDomeLightingPS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumEyeDomeLightingPS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumEyeDomeLightingPS, FGlobalShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneDepthTexture)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, CustomDepthTexture)
+  SHADER_PARAMETER(float, Strength)
+  SHADER_PARAMETER(float, Radius)
+  SHADER_PARAMETER(FIntPoint, ViewMin)
+  SHADER_PARAMETER(FIntPoint, ViewMax)
+  RENDER_TARGET_BINDING_SLOTS()
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
   }
+};
 
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AggregateOcclusionForViewFamily)
-  for (const FSceneView* pView : InViewFamily.Views) {
-    if (pView == nullptr || pView->State == nullptr)
-      continue;
-
-    const FSceneViewState* pViewState = pView->State->GetConcreteViewState();
-    if (pViewState && getOcclusionHistorySet(pViewState).Num()) {
-      SceneViewOcclusionResults& occlusionResults =
-          _currentAggregation_renderThread.occlusionResultsByView
-              .emplace_back();
-      // Do we actually need the view?
-      occlusionResults.pView = pView;
-
-      if (!_recycledOcclusionResultSets.IsEmpty()) {
-        // Recycle a previously allocated occlusion history set, if one is
-        // available.
-        occlusionResults.PrimitiveOcclusionResults =
-            std::move(*_recycledOcclusionResultSets.Peek());
-        _recycledOcclusionResultSets.Pop();
-      } else {
-        // If no previously-allocated set exists, just allocate a new one. It
-        // will be recycled later.
-      }
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumEyeDomeLightingPS,
+    "/Plugin/CesiumForUnreal/Private/CesiumEyeDomeLighting.usf",
+    "MainPS",
+    SF_Pixel);
 
-      occlusionResults.PrimitiveOcclusionResults.Reserve(
-          getOcclusionHistorySet(pViewState).Num());
-      for (const auto& element : getOcclusionHistorySet(pViewState)) {
-        occlusionResults.PrimitiveOcclusionResults.Emplace(element);
-      }
+} // namespace
 
-      // Unreal will not execute occlusion queries that get frustum culled in a
-      // particular view, leaving the occlusion results indefinite. And by just
-      // looking at the PrimitiveOcclusionHistorySet, we can't distinguish
-      // occlusion queries that haven't completed "yet" from occlusion queries
-      // that were culled. So here we detect primitives that have been
-      // conclusively proven to be not visible (outside the view frustum) and
-      // also mark them definitely occluded.
-      FScene* pScene = InViewFamily.Scene->GetRenderScene();
-      if (pView->bIsViewInfo && pScene != nullptr) {
-        const FViewInfo* pViewInfo = static_cast<const FViewInfo*>(pView);
-        const FSceneBitArray& visibility = pViewInfo->PrimitiveVisibilityMap;
-        auto& occlusion = occlusionResults.PrimitiveOcclusionResults;
-
-        const uint32 PrimitiveCount = pScene->Primitives.Num();
-        for (uint32 i = 0; i < PrimitiveCount; ++i) {
-          FPrimitiveSceneInfo* pSceneInfo = pScene->Primitives[i];
-          if (pSceneInfo == nullptr)
-            continue;
-
-          bool setOcclusionState = false;
-          bool isOccluded = false;
-
-          // Unreal will never compute occlusion for primitives that are
-          // selected in the Editor. So treat these as unoccluded.
-#if WITH_EDITOR
-          if (GIsEditor) {
-            if (pScene->PrimitivesSelected[i]) {
-              setOcclusionState = true;
-              isOccluded = false;
-            }
-          }
-#endif
-
-          // If this primitive is not visible at all (and also not selected!),
-          // treat is as occluded.
-          if (!setOcclusionState && !visibility[i]) {
-            setOcclusionState = true;
-            isOccluded = true;
-          }
-
-          if (setOcclusionState) {
-            const PrimitiveOcclusionResult* pOcclusionResult =
-                occlusion.Find(pSceneInfo->PrimitiveComponentId);
-            if (!pOcclusionResult || pOcclusionResult->LastConsideredTime <
-                                         pViewState->LastRenderTime) {
-              // No valid occlusion history for this culled primitive, so create
-              // it.
-              occlusion.Emplace(PrimitiveOcclusionResult(
-                  pSceneInfo->PrimitiveComponentId,
-                  pViewState->LastRenderTime,
-                  isOccluded ? 0.0f : 100.0f,
-                  true,
-                  isOccluded));
-            }
-          }
-        }
+void CesiumViewExtension::PrePostProcessPass_RenderThread(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    const FPostProcessingInputs& Inputs) {
+  if (!View.bIsViewInfo || View.GetFeatureLevel() < ERHIFeatureLevel::SM5 ||
+      !Inputs.SceneTextures) {
+    return;
+  }
+
+  FCesiumGaussianSplatSceneProxy::AddPasses(GraphBuilder, View, Inputs);
+  FCesiumVoxelSceneProxy::AddPasses(GraphBuilder, View, Inputs);
+
+  float strength = 0.0f;
+  float radius = 0.0f;
+  {
+    FScopeLock lock(&this->_eyeDomeLightingLock);
+    for (const auto& pair : this->_eyeDomeLighting) {
+      if (pair.Value.pScene == View.Family->Scene &&
+          pair.Value.strength > strength) {
+        strength = pair.Value.strength;
+        radius = pair.Value.radius;
       }
     }
   }
+
+  if (strength <= 0.0f) {
+    return;
+  }
+
+  const FSceneTextureUniformParameters& sceneTextures =
+      *Inputs.SceneTextures->GetParameters();
+  if (!sceneTextures.SceneColorTexture || !sceneTextures.SceneDepthTexture ||
+      !sceneTextures.CustomDepthTexture) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::EyeDomeLighting)
+
+  const FViewInfo& viewInfo = static_cast<const FViewInfo&>(View);
+
+  FCesiumEyeDomeLightingPS::FParameters* pParameters =
+      GraphBuilder.AllocParameters<FCesiumEyeDomeLightingPS::FParameters>();
+  pParameters->View = View.ViewUniformBuffer;
+  pParameters->SceneDepthTexture = sceneTextures.SceneDepthTexture;
+  pParameters->CustomDepthTexture = sceneTextures.CustomDepthTexture;
+  pParameters->Strength = strength;
+  pParameters->Radius = radius;
+  pParameters->ViewMin = viewInfo.ViewRect.Min;
+  pParameters->ViewMax = viewInfo.ViewRect.Max;
+  pParameters->RenderTargets[0] = FRenderTargetBinding(
+      sceneTextures.SceneColorTexture,
+      ERenderTargetLoadAction::ELoad);
+
+  // The shader only reads depth, so it darkens the scene color in place by
+  // multiplying it.
+  TShaderMapRef<FCesiumEyeDomeLightingPS> pixelShader(viewInfo.ShaderMap);
+  FPixelShaderUtils::AddFullscreenPass(
+      GraphBuilder,
+      viewInfo.ShaderMap,
+      RDG_EVENT_NAME("CesiumEyeDomeLighting"),
+      pixelShader,
+      pParameters,
+      viewInfo.ViewRect,
+      TStaticBlendState<CW_RGB, BO_Add, BF_DestColor, BF_Zero>::GetRHI());
 }
 
-void CesiumViewExtension::SetEnabled(bool enabled) {
-  this->_isEnabled = enabled;
+void CesiumViewExtension::SetEyeDomeLighting(
+    const ACesium3DTileset* pTileset,
+    const FSceneInterface* pScene,
+    float strength,
+    float radius) {
+  FScopeLock lock(&this->_eyeDomeLightingLock);
+  if (strength > 0.0f && pScene) {
+    this->_eyeDomeLighting.Add(pTileset, {pScene, strength, radius});
+  } else {
+    this->_eyeDomeLighting.Remove(pTileset);
+  }
 }
@@ -2,115 +2,167 @@
 
 #pragma once
 
-#include "Containers/Queue.h"
-#include "Containers/Set.h"
-#include "Runtime/Renderer/Private/ScenePrivate.h"
-#include "SceneTypes.h"
+#include "Containers/Map.h"
+#include "HAL/CriticalSection.h"
+#include "RHIGPUReadback.h"
 #include "SceneView.h"
 #include "SceneViewExtension.h"
-#include <Cesium3DTilesSelection/TileOcclusionRendererProxy.h>
-#include <cstdint>
-#include <unordered_set>
+#include "Templates/UniquePtr.h"
+#include <atomic>
 
 class ACesium3DTileset;
 
 class CesiumViewExtension : public FSceneViewExtensionBase {
-private:
-  // Occlusion results for a single view.
-  struct PrimitiveOcclusionResult {
-    PrimitiveOcclusionResult(
-        const FPrimitiveComponentId primitiveId,
-        float lastConsideredTime,
-        float lastPixelsPercentage,
-        bool occlusionStateWasDefiniteLastFrame,
-        bool wasOccludedLastFrame)
-        : PrimitiveId(primitiveId),
-          LastConsideredTime(lastConsideredTime),
-          LastPixelsPercentage(lastPixelsPercentage),
-          OcclusionStateWasDefiniteLastFrame(
-              occlusionStateWasDefiniteLastFrame),
-          WasOccludedLastFrame(wasOccludedLastFrame) {}
-
-    PrimitiveOcclusionResult(const FPrimitiveOcclusionHistory& renderer)
-        : PrimitiveId(renderer.PrimitiveId),
-          LastConsideredTime(renderer.LastConsideredTime),
-          LastPixelsPercentage(renderer.LastPixelsPercentage),
-          OcclusionStateWasDefiniteLastFrame(
-              renderer.OcclusionStateWasDefiniteLastFrame),
-          WasOccludedLastFrame(renderer.WasOccludedLastFrame) {}
-
-    FPrimitiveComponentId PrimitiveId;
-    float LastConsideredTime;
-    float LastPixelsPercentage;
-    bool OcclusionStateWasDefiniteLastFrame;
-    bool WasOccludedLastFrame;
+public:
+  /**
+   * The axis-aligned bounds of an occlusion proxy, in Unreal world
+   * coordinates. The bounds of the proxies of a tileset are indexed by the
+   * slots of the proxies, so that the results are too.
+   */
+  struct OcclusionBounds {
+    /**
+     * Identifies the tile the proxy in the slot is mapped to, or zero if the
+     * slot isn't used.
+     */
+    uint32 key;
+
+    FVector center;
+    FVector extent;
   };
 
-  // Defines how PrimitiveOcclusionResult is stored in a TSet
-  struct PrimitiveOcclusionResultKeyFuncs
-      : BaseKeyFuncs<PrimitiveOcclusionResult, FPrimitiveComponentId> {
-    typedef FPrimitiveComponentId KeyInitType;
+  /**
+   * A change in the visibility of the occlusion proxy in a slot.
+   */
+  struct OcclusionResult {
+    int32 slot;
 
-    static KeyInitType GetSetKey(const PrimitiveOcclusionResult& Element) {
-      return Element.PrimitiveId;
-    }
+    /**
+     * The key of the bounds that were tested.
+     */
+    uint32 key;
 
-    static bool Matches(KeyInitType A, KeyInitType B) { return A == B; }
+    bool visible;
+  };
 
-    static uint32 GetKeyHash(KeyInitType Key) {
-      return GetTypeHash(Key.PrimIDValue);
-    }
+private:
+  // The bounds of the occlusion proxies of a tileset, and the latest results
+  // of testing them.
+  struct TilesetOcclusion {
+    const FSceneInterface* pScene = nullptr;
+    TArray<OcclusionBounds> bounds;
+
+    // Incremented each time the bounds are set.
+    uint32 boundsSerial = 0;
+
+    // The keys of the latest bounds that were tested, and whether each one is
+    // visible in any of the views of the frame that tested them, by slot.
+    TArray<uint32> resultKeys;
+    TArray<uint8> resultVisibility;
+    uint32 resultSerial = 0;
+    uint32 resultFrameNumber = 0;
+
+    // The slots whose results changed since the game thread last got them.
+    TArray<int32> changedSlots;
+    TBitArray<> isSlotChanged;
+
+    void setResult(int32 slot, uint32 key, uint8 visible);
   };
 
-  // The occlusion results for a single view.
-  struct SceneViewOcclusionResults {
-    const FSceneView* pView = nullptr;
-    TSet<PrimitiveOcclusionResult, PrimitiveOcclusionResultKeyFuncs>
-        PrimitiveOcclusionResults{};
+  // The occlusion of each tileset that culls occluded tiles. It is set from
+  // the game thread and read from the render thread.
+  mutable FCriticalSection _occlusionLock;
+  TMap<const ACesium3DTileset*, TilesetOcclusion> _occlusion;
+
+  // The bounds of a tileset that were tested for a view family.
+  struct TestedOcclusionBounds {
+    const ACesium3DTileset* pTileset;
+    uint32 boundsSerial;
+    TArray<uint32> keys;
   };
 
-  // A collection of occlusion results by view.
-  struct AggregatedOcclusionUpdate {
-    std::vector<SceneViewOcclusionResults> occlusionResultsByView{};
+  // The visibility of the bounds tested for a view family, which is being
+  // copied back from the GPU. The visibility of the tilesets is in the order
+  // of their tested bounds.
+  struct OcclusionReadback {
+    TUniquePtr<FRHIGPUBufferReadback> pReadback;
+    TArray<TestedOcclusionBounds> tested;
+    int32 count;
+    uint32 frameNumber;
   };
 
-  // The current collection of occlusion results for this frame.
-  AggregatedOcclusionUpdate _currentAggregation_renderThread{};
-  AggregatedOcclusionUpdate _currentOcclusionResults{};
+  // The readbacks that haven't finished yet, oldest first. Only accessed from
+  // the render thread.
+  TArray<OcclusionReadback> _occlusionReadbacks_renderThread;
 
-  // A queue to pass occlusion results from the render thread to the game
-  // thread.
-  TQueue<AggregatedOcclusionUpdate, EQueueMode::Spsc> _occlusionResultsQueue;
+  void _finishOcclusionReadbacks_renderThread();
 
-  // A queue to recycle the previously-allocated occlusion result sets. The
-  // game thread recycles the sets by moving them into the queue and sending
-  // them back to the render thread.
-  TQueue<
-      TSet<PrimitiveOcclusionResult, PrimitiveOcclusionResultKeyFuncs>,
-      EQueueMode::Spsc>
-      _recycledOcclusionResultSets;
+  std::atomic<bool> _isEnabled = false;
 
-  // The last known frame number. This is used to determine when an occlusion
-  // results aggregation is complete.
-  int64_t _frameNumber_renderThread = -1;
+  // The eye-dome lighting of the point clouds of a tileset.
+  struct EyeDomeLighting {
+    const FSceneInterface* pScene;
+    float strength;
+    float radius;
+  };
 
-  std::atomic<bool> _isEnabled = false;
+  // The eye-dome lighting of each tileset that uses it. It is set from the
+  // game thread and read from the render thread.
+  mutable FCriticalSection _eyeDomeLightingLock;
+  TMap<const ACesium3DTileset*, EyeDomeLighting> _eyeDomeLighting;
 
 public:
   CesiumViewExtension(const FAutoRegister& autoRegister);
   ~CesiumViewExtension();
 
-  Cesium3DTilesSelection::TileOcclusionState getPrimitiveOcclusionState(
-      const FPrimitiveComponentId& id,
-      bool previouslyOccluded,
-      float frameTimeCutoff) const;
-
   void SetupViewFamily(FSceneViewFamily& InViewFamily) override;
   void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override;
   void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override;
   void PostRenderViewFamily_RenderThread(
       FRDGBuilder& GraphBuilder,
       FSceneViewFamily& InViewFamily) override;
+  void PrePostProcessPass_RenderThread(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      const FPostProcessingInputs& Inputs) override;
 
   void SetEnabled(bool enabled);
+
+  /**
+   * Sets the bounds of the occlusion proxies of a tileset, which are tested
+   * against the depth pyramid of each view of the scene after it's rendered,
+   * until they are replaced. If pScene is nullptr, the tileset's bounds and
+   * results are removed. Must be called from the game thread.
+   */
+  void SetOcclusionBounds(
+      const ACesium3DTileset* pTileset,
+      const FSceneInterface* pScene,
+      TArray<OcclusionBounds>&& bounds);
+
+  /**
+   * Gets the slots of the occlusion proxies of a tileset whose visibility has
+   * changed in the results read back from the GPU since the last call. Must
+   * be called from the game thread.
+   *
+   * @param pTileset The tileset.
+   * @param changes Receives the latest results of the changed slots.
+   * @returns false if no results have changed, in which case changes is
+   * left empty.
+   */
+  bool GetOcclusionResults(
+      const ACesium3DTileset* pTileset,
+      TArray<OcclusionResult>& changes);
+
+  /**
+   * Shades the point clouds of a tileset with eye-dome lighting, or stops
+   * shading them if strength is zero. The points must be drawn into custom
+   * depth. Must be called from the game thread.
+   *
+   * Since the point clouds of all tilesets in a scene are shaded in one pass,
+   * the strongest eye-dome lighting of them is used for all of them.
+   */
+  void SetEyeDomeLighting(
+      const ACesium3DTileset* pTileset,
+      const FSceneInterface* pScene,
+      float strength,
+      float radius);
 };
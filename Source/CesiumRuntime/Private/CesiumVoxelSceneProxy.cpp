@@ -0,0 +1,525 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVoxelSceneProxy.h"
+#include "CesiumGltfVoxelComponent.h"
+#include "CesiumRuntimeSettings.h"
+#include "GlobalShader.h"
+#include "PixelShaderUtils.h"
+#include "RenderGraphBuilder.h"
+#include "RenderGraphUtils.h"
+#include "RenderTargetPool.h"
+#include "Runtime/Renderer/Private/PostProcess/PostProcessing.h"
+#include "Runtime/Renderer/Private/SceneRendering.h"
+#include "ShaderParameterStruct.h"
+#include <cmath>
+
+namespace {
+
+/**
+ * The proxies whose render thread resources have been created. Only accessed
+ * from the render thread.
+ */
+TArray<FCesiumVoxelSceneProxy*>& getProxies() {
+  static TArray<FCesiumVoxelSceneProxy*> proxies;
+  return proxies;
+}
+
+/**
+ * A 3D texture atlas with a grid of slots for bricks of one size and format.
+ */
+struct BrickAtlas {
+  FIntVector brickDimensions;
+  EPixelFormat format;
+  FIntVector slotsPerAxis;
+  uint64 sizeBytes;
+  FTextureRHIRef texture;
+  TRefCountPtr<IPooledRenderTarget> renderTarget;
+
+  // The proxy that each slot holds the brick of, and the frame in which the
+  // slot was last drawn.
+  TArray<const void*> owners;
+  TArray<uint32> lastUsedFrames;
+
+  FIntVector getSlotOrigin(int32 slot) const {
+    const int32 x = slot % this->slotsPerAxis.X;
+    const int32 y = (slot / this->slotsPerAxis.X) % this->slotsPerAxis.Y;
+    const int32 z = slot / (this->slotsPerAxis.X * this->slotsPerAxis.Y);
+    return FIntVector(x, y, z) * this->brickDimensions;
+  }
+};
+
+/**
+ * The brick pool that the voxels of all proxies are drawn from. Only accessed
+ * from the render thread.
+ */
+class BrickPool {
+public:
+  static BrickPool& get() {
+    static BrickPool pool;
+    return pool;
+  }
+
+  const BrickAtlas& getAtlas(int32 atlasIndex) const {
+    return *this->_atlases[atlasIndex];
+  }
+
+  /**
+   * Finds or makes a slot that holds the brick of a proxy, and marks it as
+   * drawn in a frame. The slots of bricks that were drawn in the same frame
+   * are never taken, so this fails if the pool is full of them.
+   *
+   * @param atlasIndex The atlas of the slot that the proxy last held. Set to
+   * the atlas of the slot that holds the brick.
+   * @param slot The slot that the proxy last held. Set to the slot that holds
+   * the brick.
+   */
+  bool acquire(
+      const void* pOwner,
+      const CesiumVoxels::Brick& brick,
+      uint32 frameNumber,
+      int32& atlasIndex,
+      int32& slot) {
+    if (atlasIndex != INDEX_NONE &&
+        this->_atlases[atlasIndex]->owners[slot] == pOwner) {
+      this->_atlases[atlasIndex]->lastUsedFrames[slot] = frameNumber;
+      return true;
+    }
+
+    atlasIndex = this->findOrCreateAtlas(brick);
+    if (atlasIndex == INDEX_NONE) {
+      slot = INDEX_NONE;
+      return false;
+    }
+
+    BrickAtlas& atlas = *this->_atlases[atlasIndex];
+    slot = INDEX_NONE;
+    for (int32 i = 0; i < atlas.owners.Num(); ++i) {
+      if (!atlas.owners[i]) {
+        slot = i;
+        break;
+      }
+      if (atlas.lastUsedFrames[i] != frameNumber &&
+          (slot == INDEX_NONE ||
+           atlas.lastUsedFrames[i] < atlas.lastUsedFrames[slot])) {
+        slot = i;
+      }
+    }
+
+    if (slot == INDEX_NONE) {
+      atlasIndex = INDEX_NONE;
+      return false;
+    }
+
+    // The brick is uploaded right away, before the passes of the graph that
+    // sample it are executed.
+    const FIntVector origin = atlas.getSlotOrigin(slot);
+    const FIntVector& dimensions = brick.Dimensions;
+    const uint32 rowPitch =
+        uint32(dimensions.X) * GPixelFormats[brick.Format].BlockBytes;
+    FRHICommandListExecutor::GetImmediateCommandList().UpdateTexture3D(
+        atlas.texture,
+        0,
+        FUpdateTextureRegion3D(
+            uint32(origin.X),
+            uint32(origin.Y),
+            uint32(origin.Z),
+            0,
+            0,
+            0,
+            uint32(dimensions.X),
+            uint32(dimensions.Y),
+            uint32(dimensions.Z)),
+        rowPitch,
+        rowPitch * uint32(dimensions.Y),
+        brick.Data.GetData());
+
+    atlas.owners[slot] = pOwner;
+    atlas.lastUsedFrames[slot] = frameNumber;
+    return true;
+  }
+
+  /**
+   * Frees the slot of a proxy, unless the slot has been given to another
+   * proxy since.
+   */
+  void release(const void* pOwner, int32 atlasIndex, int32 slot) {
+    if (atlasIndex != INDEX_NONE &&
+        this->_atlases[atlasIndex]->owners[slot] == pOwner) {
+      this->_atlases[atlasIndex]->owners[slot] = nullptr;
+    }
+  }
+
+private:
+  int32 findOrCreateAtlas(const CesiumVoxels::Brick& brick) {
+    uint64 usedBytes = 0;
+    for (int32 i = 0; i < this->_atlases.Num(); ++i) {
+      const BrickAtlas& atlas = *this->_atlases[i];
+      if (atlas.brickDimensions == brick.Dimensions &&
+          atlas.format == brick.Format) {
+        return i;
+      }
+      usedBytes += atlas.sizeBytes;
+    }
+
+    // Each new size of brick gets what's left of the budget.
+    const uint64 budgetBytes =
+        uint64(GetDefault<UCesiumRuntimeSettings>()->VoxelBrickPoolSizeMB) *
+        1024 * 1024;
+    const uint64 brickBytes = brick.getSizeBytes();
+    if (brickBytes == 0 || usedBytes + brickBytes > budgetBytes) {
+      return INDEX_NONE;
+    }
+
+    const int32 maxDimension = int32(GMaxVolumeTextureDimensions);
+    const FIntVector maxSlots(
+        maxDimension / brick.Dimensions.X,
+        maxDimension / brick.Dimensions.Y,
+        maxDimension / brick.Dimensions.Z);
+    if (maxSlots.X < 1 || maxSlots.Y < 1 || maxSlots.Z < 1) {
+      return INDEX_NONE;
+    }
+
+    // The slots are laid out in a grid that is about as deep as it is wide.
+    const double slotCount = double((budgetBytes - usedBytes) / brickBytes);
+    FIntVector slots;
+    slots.X = FMath::Clamp(
+        int32(std::ceil(std::cbrt(slotCount))),
+        1,
+        maxSlots.X);
+    slots.Y = FMath::Clamp(
+        int32(std::floor(std::sqrt(slotCount / slots.X))),
+        1,
+        maxSlots.Y);
+    slots.Z = FMath::Clamp(
+        int32(std::floor(slotCount / (slots.X * slots.Y))),
+        1,
+        maxSlots.Z);
+
+    const FIntVector size = slots * brick.Dimensions;
+    TUniquePtr<BrickAtlas> pAtlas = MakeUnique<BrickAtlas>();
+    pAtlas->brickDimensions = brick.Dimensions;
+    pAtlas->format = brick.Format;
+    pAtlas->slotsPerAxis = slots;
+    pAtlas->sizeBytes = uint64(slots.X) * slots.Y * slots.Z * brickBytes;
+    pAtlas->texture = RHICreateTexture(
+        FRHITextureCreateDesc::Create3D(TEXT("CesiumVoxelBrickPool"))
+            .SetExtent(size.X, size.Y)
+            .SetDepth(uint16(size.Z))
+            .SetFormat(brick.Format)
+            .SetNumMips(1)
+            .SetFlags(TexCreate_ShaderResource)
+            .SetInitialState(ERHIAccess::SRVMask));
+    pAtlas->renderTarget =
+        CreateRenderTarget(pAtlas->texture, TEXT("CesiumVoxelBrickPool"));
+
+    const int32 numSlots = slots.X * slots.Y * slots.Z;
+    pAtlas->owners.Init(nullptr, numSlots);
+    pAtlas->lastUsedFrames.Init(0, numSlots);
+    return this->_atlases.Add(MoveTemp(pAtlas));
+  }
+
+  TArray<TUniquePtr<BrickAtlas>> _atlases;
+};
+
+class FCesiumVoxelRaymarchPS : public FGlobalShader {
+public:
+  DECLARE_GLOBAL_SHADER(FCesiumVoxelRaymarchPS);
+  SHADER_USE_PARAMETER_STRUCT(FCesiumVoxelRaymarchPS, FGlobalShader);
+
+  BEGIN_SHADER_PARAMETER_STRUCT(FParameters, )
+  SHADER_PARAMETER_STRUCT_REF(FViewUniformShaderParameters, View)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture2D, SceneDepthTexture)
+  SHADER_PARAMETER_RDG_TEXTURE(Texture3D, BrickPoolTexture)
+  SHADER_PARAMETER_SAMPLER(SamplerState, BrickPoolSampler)
+  SHADER_PARAMETER(FMatrix44f, TranslatedWorldToLocal)
+  SHADER_PARAMETER(FVector3f, CameraOrigin)
+  SHADER_PARAMETER(FVector3f, ViewForward)
+  SHADER_PARAMETER(FVector3f, BrickPoolInverseSize)
+  SHADER_PARAMETER(FVector3f, GridOrigin)
+  SHADER_PARAMETER(FVector3f, GridDimensions)
+  SHADER_PARAMETER(FVector3f, SlotMin)
+  SHADER_PARAMETER(FVector3f, SlotMax)
+  SHADER_PARAMETER(float, ValueOffset)
+  SHADER_PARAMETER(float, ValueScale)
+  SHADER_PARAMETER(float, MinimumValue)
+  SHADER_PARAMETER(float, InverseValueRange)
+  SHADER_PARAMETER(FVector4f, MinimumColor)
+  SHADER_PARAMETER(FVector4f, MaximumColor)
+  SHADER_PARAMETER(float, Density)
+  SHADER_PARAMETER(uint32, MaximumSteps)
+  RENDER_TARGET_BINDING_SLOTS()
+  END_SHADER_PARAMETER_STRUCT()
+
+  static bool ShouldCompilePermutation(
+      const FGlobalShaderPermutationParameters& Parameters) {
+    return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+  }
+};
+
+IMPLEMENT_GLOBAL_SHADER(
+    FCesiumVoxelRaymarchPS,
+    "/Plugin/CesiumForUnreal/Private/CesiumVoxelRaymarching.usf",
+    "MainPS",
+    SF_Pixel);
+
+// The corners of the box that the voxel grid fills, in the primitive's
+// coordinate system.
+const FVector BoxCorners[8] = {
+    FVector(-1.0, -1.0, -1.0),
+    FVector(1.0, -1.0, -1.0),
+    FVector(-1.0, 1.0, -1.0),
+    FVector(1.0, 1.0, -1.0),
+    FVector(-1.0, -1.0, 1.0),
+    FVector(1.0, -1.0, 1.0),
+    FVector(-1.0, 1.0, 1.0),
+    FVector(1.0, 1.0, 1.0)};
+
+} // namespace
+
+FCesiumVoxelSceneProxy::FCesiumVoxelSceneProxy(
+    UCesiumGltfVoxelComponent* InComponent,
+    const FCesiumVoxelRendering& InVoxelRendering)
+    : FPrimitiveSceneProxy(InComponent),
+      Brick(InComponent->Brick),
+      VoxelRendering(InVoxelRendering),
+      VisibleViews(),
+      VisibleFrameNumber(0),
+      PoolAtlas(INDEX_NONE),
+      PoolSlot(INDEX_NONE) {}
+
+FCesiumVoxelSceneProxy::~FCesiumVoxelSceneProxy() {}
+
+SIZE_T FCesiumVoxelSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+void FCesiumVoxelSceneProxy::CreateRenderThreadResources(
+    FRHICommandListBase& RHICmdList) {
+  getProxies().Add(this);
+}
+#else
+void FCesiumVoxelSceneProxy::CreateRenderThreadResources() {
+  getProxies().Add(this);
+}
+#endif
+
+void FCesiumVoxelSceneProxy::DestroyRenderThreadResources() {
+  getProxies().RemoveSwap(this);
+  BrickPool::get().release(this, PoolAtlas, PoolSlot);
+  PoolAtlas = INDEX_NONE;
+  PoolSlot = INDEX_NONE;
+}
+
+void FCesiumVoxelSceneProxy::GetDynamicMeshElements(
+    const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily,
+    uint32 VisibilityMap,
+    FMeshElementCollector& Collector) const {
+  // The voxels are raymarched after translucency, so no mesh is added. Each
+  // view family of a frame adds its views.
+  if (VisibleFrameNumber != ViewFamily.FrameNumber) {
+    VisibleViews.Reset();
+    VisibleFrameNumber = ViewFamily.FrameNumber;
+  }
+
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
+    if (VisibilityMap & (1 << ViewIndex)) {
+      VisibleViews.AddUnique(Views[ViewIndex]);
+    }
+  }
+}
+
+FPrimitiveViewRelevance
+FCesiumVoxelSceneProxy::GetViewRelevance(const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View) && Brick.IsValid();
+  Result.bDynamicRelevance = true;
+  Result.bStaticRelevance = false;
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bShadowRelevance = false;
+  Result.bVelocityRelevance = false;
+  return Result;
+}
+
+uint32 FCesiumVoxelSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize());
+}
+
+bool FCesiumVoxelSceneProxy::IsVisibleIn(const FSceneView& View) const {
+  return Brick.IsValid() && VisibleFrameNumber == View.Family->FrameNumber &&
+         VisibleViews.Contains(&View);
+}
+
+bool FCesiumVoxelSceneProxy::GetViewRect(
+    const FSceneView& View,
+    FIntRect& OutRect) const {
+  const FIntRect viewRect = static_cast<const FViewInfo&>(View).ViewRect;
+  const FMatrix& viewProjection = View.ViewMatrices.GetViewProjectionMatrix();
+  const FMatrix& localToWorld = GetLocalToWorld();
+
+  FVector2D minimum(1.0);
+  FVector2D maximum(-1.0);
+  for (const FVector& corner : BoxCorners) {
+    const FVector4 clip = viewProjection.TransformFVector4(
+        FVector4(localToWorld.TransformPosition(corner), 1.0));
+    if (clip.W <= UE_KINDA_SMALL_NUMBER) {
+      // The box reaches behind the camera, so it may cover any pixel.
+      OutRect = viewRect;
+      return true;
+    }
+    const FVector2D ndc(clip.X / clip.W, clip.Y / clip.W);
+    minimum = FVector2D::Min(minimum, ndc);
+    maximum = FVector2D::Max(maximum, ndc);
+  }
+
+  minimum = FVector2D::Max(minimum, FVector2D(-1.0));
+  maximum = FVector2D::Min(maximum, FVector2D(1.0));
+  if (minimum.X >= maximum.X || minimum.Y >= maximum.Y) {
+    return false;
+  }
+
+  // Clip space Y points up, and pixel Y down.
+  const FIntPoint size = viewRect.Size();
+  OutRect.Min.X = viewRect.Min.X +
+                  FMath::FloorToInt((minimum.X * 0.5 + 0.5) * size.X) - 1;
+  OutRect.Max.X = viewRect.Min.X +
+                  FMath::CeilToInt((maximum.X * 0.5 + 0.5) * size.X) + 1;
+  OutRect.Min.Y = viewRect.Min.Y +
+                  FMath::FloorToInt((0.5 - maximum.Y * 0.5) * size.Y) - 1;
+  OutRect.Max.Y = viewRect.Min.Y +
+                  FMath::CeilToInt((0.5 - minimum.Y * 0.5) * size.Y) + 1;
+  OutRect.Clip(viewRect);
+  return OutRect.Area() > 0;
+}
+
+/*static*/ void FCesiumVoxelSceneProxy::AddPasses(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    const FPostProcessingInputs& Inputs) {
+  if (!View.bIsViewInfo || View.GetFeatureLevel() < ERHIFeatureLevel::SM5 ||
+      !Inputs.SceneTextures) {
+    return;
+  }
+
+  TArray<FCesiumVoxelSceneProxy*, TInlineAllocator<64>> visible;
+  for (FCesiumVoxelSceneProxy* pProxy : getProxies()) {
+    if (pProxy->IsVisibleIn(View)) {
+      visible.Add(pProxy);
+    }
+  }
+
+  if (visible.IsEmpty()) {
+    return;
+  }
+
+  const FSceneTextureUniformParameters& sceneTextures =
+      *Inputs.SceneTextures->GetParameters();
+  if (!sceneTextures.SceneColorTexture || !sceneTextures.SceneDepthTexture) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::Voxels)
+  RDG_EVENT_SCOPE(GraphBuilder, "CesiumVoxels");
+
+  // The voxels of each proxy are blended over those of the proxies behind
+  // it.
+  const FVector viewOrigin = View.ViewMatrices.GetViewOrigin();
+  visible.Sort([&viewOrigin](
+                   const FCesiumVoxelSceneProxy& a,
+                   const FCesiumVoxelSceneProxy& b) {
+    return FVector::DistSquared(a.GetBounds().Origin, viewOrigin) >
+           FVector::DistSquared(b.GetBounds().Origin, viewOrigin);
+  });
+
+  for (FCesiumVoxelSceneProxy* pProxy : visible) {
+    pProxy->AddRaymarchPass(
+        GraphBuilder,
+        View,
+        sceneTextures.SceneColorTexture,
+        sceneTextures.SceneDepthTexture);
+  }
+}
+
+void FCesiumVoxelSceneProxy::AddRaymarchPass(
+    FRDGBuilder& GraphBuilder,
+    const FSceneView& View,
+    FRDGTextureRef SceneColor,
+    FRDGTextureRef SceneDepth) {
+  FIntRect rect;
+  if (!GetViewRect(View, rect)) {
+    return;
+  }
+
+  BrickPool& pool = BrickPool::get();
+  if (!pool.acquire(
+          this,
+          *Brick,
+          View.Family->FrameNumber,
+          PoolAtlas,
+          PoolSlot)) {
+    return;
+  }
+
+  const BrickAtlas& atlas = pool.getAtlas(PoolAtlas);
+  const FIntVector slotOrigin = atlas.getSlotOrigin(PoolSlot);
+  const FIntVector gridDimensions =
+      Brick->Dimensions - Brick->PaddingBefore - Brick->PaddingAfter;
+  const FIntVector atlasSize = atlas.slotsPerAxis * atlas.brickDimensions;
+  const FViewInfo& viewInfo = static_cast<const FViewInfo&>(View);
+
+  const FVector preViewTranslation = View.ViewMatrices.GetPreViewTranslation();
+  const FMatrix localToTranslatedWorld =
+      GetLocalToWorld().ConcatTranslation(preViewTranslation);
+  const float valueRange =
+      VoxelRendering.MaximumValue - VoxelRendering.MinimumValue;
+
+  auto* pParameters =
+      GraphBuilder.AllocParameters<FCesiumVoxelRaymarchPS::FParameters>();
+  pParameters->View = View.ViewUniformBuffer;
+  pParameters->SceneDepthTexture = SceneDepth;
+  pParameters->BrickPoolTexture =
+      GraphBuilder.RegisterExternalTexture(atlas.renderTarget);
+  pParameters->BrickPoolSampler =
+      TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+  pParameters->TranslatedWorldToLocal =
+      FMatrix44f(localToTranslatedWorld.Inverse());
+  pParameters->CameraOrigin =
+      FVector3f(View.ViewMatrices.GetViewOrigin() + preViewTranslation);
+  pParameters->ViewForward = FVector3f(View.GetViewDirection());
+  pParameters->BrickPoolInverseSize = FVector3f(
+      1.0f / float(atlasSize.X),
+      1.0f / float(atlasSize.Y),
+      1.0f / float(atlasSize.Z));
+  pParameters->GridOrigin = FVector3f(slotOrigin + Brick->PaddingBefore);
+  pParameters->GridDimensions = FVector3f(gridDimensions);
+  pParameters->SlotMin = FVector3f(slotOrigin) + 0.5f;
+  pParameters->SlotMax = FVector3f(slotOrigin + Brick->Dimensions) - 0.5f;
+  pParameters->ValueOffset = Brick->ValueOffset;
+  pParameters->ValueScale = Brick->ValueScale;
+  pParameters->MinimumValue = VoxelRendering.MinimumValue;
+  pParameters->InverseValueRange =
+      valueRange != 0.0f ? 1.0f / valueRange : 0.0f;
+  pParameters->MinimumColor = FVector4f(VoxelRendering.MinimumColor);
+  pParameters->MaximumColor = FVector4f(VoxelRendering.MaximumColor);
+  // The density is per meter, and the rays are marched in centimeters.
+  pParameters->Density = VoxelRendering.Density * 0.01f;
+  pParameters->MaximumSteps =
+      uint32(FMath::Clamp(VoxelRendering.MaximumSteps, 1, 1024));
+  pParameters->RenderTargets[0] =
+      FRenderTargetBinding(SceneColor, ERenderTargetLoadAction::ELoad);
+
+  // The voxels are premultiplied, and the depth of the scene ends the rays
+  // rather than being tested.
+  TShaderMapRef<FCesiumVoxelRaymarchPS> pixelShader(viewInfo.ShaderMap);
+  FPixelShaderUtils::AddFullscreenPass(
+      GraphBuilder,
+      viewInfo.ShaderMap,
+      RDG_EVENT_NAME("CesiumVoxelRaymarch"),
+      pixelShader,
+      pParameters,
+      rect,
+      TStaticBlendState<CW_RGB, BO_Add, BF_One, BF_InverseSourceAlpha>::
+          GetRHI());
+}
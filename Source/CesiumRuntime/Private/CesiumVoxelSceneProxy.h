@@ -0,0 +1,95 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "CesiumVoxelRendering.h"
+#include "CesiumVoxels.h"
+#include "PrimitiveSceneProxy.h"
+
+class FRDGBuilder;
+class UCesiumGltfVoxelComponent;
+struct FPostProcessingInputs;
+
+/**
+ * Raymarches the voxels of a glTF primitive with the EXT_primitive_voxels
+ * extension.
+ *
+ * Like Gaussian splats, the voxels don't go through the mesh passes: the proxy
+ * only records the views it's visible in, and the voxels of all visible
+ * proxies are then blended over the scene color by {@link AddPasses},
+ * farthest proxy first, after the translucency of each view.
+ *
+ * The brick of each proxy is uploaded into a slot of a brick pool the first
+ * time it is drawn. The pool is a 3D texture atlas for each size and format of
+ * brick, which together take at most the Voxel Brick Pool Size of the runtime
+ * settings. When a pool is full, the slot of the brick that was drawn least
+ * recently is given to the new brick, so the pool holds the bricks of the
+ * tiles that are being drawn, whatever the number of loaded tiles.
+ */
+class FCesiumVoxelSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  FCesiumVoxelSceneProxy(
+      UCesiumGltfVoxelComponent* InComponent,
+      const FCesiumVoxelRendering& InVoxelRendering);
+
+  virtual ~FCesiumVoxelSceneProxy();
+
+  SIZE_T GetTypeHash() const override;
+
+  /**
+   * Raymarches the voxels of the proxies that are visible in a view. Must be
+   * called from the render thread, after the proxies' dynamic mesh elements
+   * have been gathered for the view.
+   */
+  static void AddPasses(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      const FPostProcessingInputs& Inputs);
+
+protected:
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  virtual void
+  CreateRenderThreadResources(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void CreateRenderThreadResources() override;
+#endif
+  virtual void DestroyRenderThreadResources() override;
+
+  virtual void GetDynamicMeshElements(
+      const TArray<const FSceneView*>& Views,
+      const FSceneViewFamily& ViewFamily,
+      uint32 VisibilityMap,
+      FMeshElementCollector& Collector) const override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  bool IsVisibleIn(const FSceneView& View) const;
+
+  /**
+   * Computes the rectangle of the view that the box of the voxels covers.
+   * Returns false if it covers none of it.
+   */
+  bool GetViewRect(const FSceneView& View, FIntRect& OutRect) const;
+
+  void AddRaymarchPass(
+      FRDGBuilder& GraphBuilder,
+      const FSceneView& View,
+      FRDGTextureRef SceneColor,
+      FRDGTextureRef SceneDepth);
+
+  CesiumVoxels::SharedBrick Brick;
+  FCesiumVoxelRendering VoxelRendering;
+
+  // The views that the proxy is visible in, in the frame it was last drawn.
+  mutable TArray<const FSceneView*, TInlineAllocator<2>> VisibleViews;
+  mutable uint32 VisibleFrameNumber;
+
+  // The atlas and slot of the brick pool that hold the brick, if any.
+  int32 PoolAtlas;
+  int32 PoolSlot;
+};
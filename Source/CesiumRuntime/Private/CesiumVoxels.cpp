@@ -0,0 +1,270 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVoxels.h"
+#include "CesiumEncodedMetadataConversions.h"
+#include "CesiumMetadataPropertyDetails.h"
+
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/JsonValue.h>
+#include <optional>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+
+const std::string VoxelsExtensionName = "EXT_primitive_voxels";
+
+std::optional<FIntVector>
+getVector(const JsonValue& object, const std::string& key, int32 minimum) {
+  const JsonValue::Array* pArray =
+      object.getValuePtrForKey<JsonValue::Array>(key);
+  if (!pArray || pArray->size() != 3) {
+    return std::nullopt;
+  }
+
+  FIntVector result;
+  for (int32 i = 0; i < 3; ++i) {
+    const int64 value = (*pArray)[i].getSafeNumberOrDefault<int64>(-1);
+    if (value < minimum || value > 4096) {
+      return std::nullopt;
+    }
+    result[i] = int32(value);
+  }
+  return result;
+}
+
+/**
+ * The glTF attribute that holds the values of a voxel property, and the offset
+ * and scale that the property applies to them.
+ */
+struct VoxelAttribute {
+  std::string attribute;
+  double offset = 0.0;
+  double scale = 1.0;
+};
+
+std::optional<VoxelAttribute> findAttribute(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const std::string& name) {
+  const ExtensionModelExtStructuralMetadata* pModelMetadata =
+      model.getExtension<ExtensionModelExtStructuralMetadata>();
+  const ExtensionMeshPrimitiveExtStructuralMetadata* pPrimitiveMetadata =
+      primitive.getExtension<ExtensionMeshPrimitiveExtStructuralMetadata>();
+  if (pModelMetadata && pPrimitiveMetadata) {
+    for (int64 index : pPrimitiveMetadata->propertyAttributes) {
+      if (index < 0 ||
+          index >= int64(pModelMetadata->propertyAttributes.size())) {
+        continue;
+      }
+
+      const PropertyAttribute& propertyAttribute =
+          pModelMetadata->propertyAttributes[size_t(index)];
+      for (const auto& [propertyName, property] :
+           propertyAttribute.properties) {
+        if (!name.empty() && propertyName != name &&
+            property.attribute != name) {
+          continue;
+        }
+
+        VoxelAttribute result;
+        result.attribute = property.attribute;
+        if (property.offset) {
+          result.offset = property.offset->getSafeNumberOrDefault<double>(0.0);
+        }
+        if (property.scale) {
+          result.scale = property.scale->getSafeNumberOrDefault<double>(1.0);
+        }
+        return result;
+      }
+    }
+  }
+
+  // Without structural metadata, the glTF attribute is drawn directly.
+  if (!name.empty() && primitive.attributes.count(name)) {
+    return VoxelAttribute{name};
+  }
+  return std::nullopt;
+}
+
+ECesiumMetadataComponentType
+getMetadataComponentType(const Accessor& accessor) {
+  switch (accessor.componentType) {
+  case Accessor::ComponentType::BYTE:
+    return ECesiumMetadataComponentType::Int8;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return ECesiumMetadataComponentType::Uint8;
+  case Accessor::ComponentType::SHORT:
+    return ECesiumMetadataComponentType::Int16;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return ECesiumMetadataComponentType::Uint16;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    return ECesiumMetadataComponentType::Uint32;
+  case Accessor::ComponentType::FLOAT:
+    return ECesiumMetadataComponentType::Float32;
+  default:
+    return ECesiumMetadataComponentType::None;
+  }
+}
+
+/**
+ * Copies the values of an accessor into the data of a brick as floats,
+ * normalizing integers if the accessor is normalized.
+ */
+template <typename T>
+bool copyAsFloats(
+    const Model& model,
+    const Accessor& accessor,
+    int64 count,
+    TArray<uint8>& data) {
+  const AccessorView<T> view(model, accessor);
+  if (view.status() != AccessorViewStatus::Valid || view.size() != count) {
+    return false;
+  }
+
+  const double normalization =
+      accessor.normalized && std::is_integral_v<T>
+          ? 1.0 / double(TNumericLimits<T>::Max())
+          : 1.0;
+  data.SetNumUninitialized(int32(count * sizeof(float)));
+  float* pValues = reinterpret_cast<float*>(data.GetData());
+  for (int64 i = 0; i < count; ++i) {
+    pValues[i] = float(double(view[i]) * normalization);
+  }
+  return true;
+}
+
+} // namespace
+
+namespace CesiumVoxels {
+
+uint64 Brick::getSizeBytes() const {
+  return uint64(this->Dimensions.X) * uint64(this->Dimensions.Y) *
+         uint64(this->Dimensions.Z) * GPixelFormats[this->Format].BlockBytes;
+}
+
+bool isVoxelPrimitive(const MeshPrimitive& primitive) {
+  return primitive.getGenericExtension(VoxelsExtensionName) != nullptr;
+}
+
+SharedBrick load(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const std::string& attributeName) {
+  const JsonValue* pExtension =
+      primitive.getGenericExtension(VoxelsExtensionName);
+  if (!pExtension) {
+    return nullptr;
+  }
+
+  const std::optional<FIntVector> maybeDimensions =
+      getVector(*pExtension, "dimensions", 1);
+  if (!maybeDimensions) {
+    return nullptr;
+  }
+
+  FIntVector before = FIntVector::ZeroValue;
+  FIntVector after = FIntVector::ZeroValue;
+  const JsonValue* pPadding = pExtension->getValuePtrForKey("padding");
+  if (pPadding) {
+    before = getVector(*pPadding, "before", 0).value_or(before);
+    after = getVector(*pPadding, "after", 0).value_or(after);
+  }
+
+  const std::optional<VoxelAttribute> maybeAttribute =
+      findAttribute(model, primitive, attributeName);
+  if (!maybeAttribute) {
+    return nullptr;
+  }
+
+  auto attributeIt = primitive.attributes.find(maybeAttribute->attribute);
+  if (attributeIt == primitive.attributes.end()) {
+    return nullptr;
+  }
+  const Accessor* pAccessor =
+      Model::getSafe(&model.accessors, attributeIt->second);
+  if (!pAccessor || pAccessor->type != Accessor::Type::SCALAR) {
+    return nullptr;
+  }
+
+  TSharedRef<Brick, ESPMode::ThreadSafe> pBrick =
+      MakeShared<Brick, ESPMode::ThreadSafe>();
+  Brick& brick = *pBrick;
+  brick.Dimensions = *maybeDimensions + before + after;
+  brick.PaddingBefore = before;
+  brick.PaddingAfter = after;
+  const int64 count = int64(brick.Dimensions.X) * brick.Dimensions.Y *
+                      brick.Dimensions.Z;
+
+  // The values are encoded like the scalar properties of property tables:
+  // 8-bit integers as uint8, and everything else as floats.
+  const FCesiumMetadataEncodingDetails encoding =
+      CesiumMetadataPropertyDetailsToEncodingDetails(
+          FCesiumMetadataPropertyDetails(
+              ECesiumMetadataType::Scalar,
+              getMetadataComponentType(*pAccessor),
+              false));
+  brick.ComponentType = encoding.ComponentType;
+  brick.ValueOffset = float(maybeAttribute->offset);
+  brick.ValueScale = float(maybeAttribute->scale);
+
+  bool copied = false;
+  if (encoding.ComponentType == ECesiumEncodedMetadataComponentType::Uint8 &&
+      pAccessor->componentType == Accessor::ComponentType::UNSIGNED_BYTE) {
+    const AccessorView<uint8> view(model, *pAccessor);
+    if (view.status() == AccessorViewStatus::Valid && view.size() == count) {
+      brick.Format = PF_G8;
+      brick.Data.SetNumUninitialized(int32(count));
+      for (int64 i = 0; i < count; ++i) {
+        brick.Data[i] = view[i];
+      }
+      // The texture normalizes the values, which are only meant to be
+      // normalized if the accessor is.
+      if (!pAccessor->normalized) {
+        brick.ValueScale *= 255.0f;
+      }
+      copied = true;
+    }
+  } else if (
+      encoding.ComponentType == ECesiumEncodedMetadataComponentType::Float) {
+    brick.ComponentType = ECesiumEncodedMetadataComponentType::Float;
+    brick.Format = PF_R32_FLOAT;
+    switch (pAccessor->componentType) {
+    case Accessor::ComponentType::SHORT:
+      copied = copyAsFloats<int16>(model, *pAccessor, count, brick.Data);
+      break;
+    case Accessor::ComponentType::UNSIGNED_SHORT:
+      copied = copyAsFloats<uint16>(model, *pAccessor, count, brick.Data);
+      break;
+    case Accessor::ComponentType::UNSIGNED_INT:
+      copied = copyAsFloats<uint32>(model, *pAccessor, count, brick.Data);
+      break;
+    case Accessor::ComponentType::FLOAT:
+      copied = copyAsFloats<float>(model, *pAccessor, count, brick.Data);
+      break;
+    default:
+      break;
+    }
+  }
+
+  // Signed bytes are reinterpreted by the encoding of property tables, so
+  // they're converted to floats here instead.
+  if (!copied && pAccessor->componentType == Accessor::ComponentType::BYTE) {
+    brick.ComponentType = ECesiumEncodedMetadataComponentType::Float;
+    brick.Format = PF_R32_FLOAT;
+    copied = copyAsFloats<int8>(model, *pAccessor, count, brick.Data);
+  }
+
+  if (!copied) {
+    return nullptr;
+  }
+
+  return pBrick;
+}
+
+} // namespace CesiumVoxels
@@ -0,0 +1,92 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumMetadataEncodingDetails.h"
+#include "Containers/Array.h"
+#include "Math/IntVector.h"
+#include "PixelFormat.h"
+#include "Templates/SharedPointer.h"
+#include <string>
+
+namespace CesiumGltf {
+struct Model;
+struct MeshPrimitive;
+} // namespace CesiumGltf
+
+/**
+ * Loads the voxels of glTF primitives with the EXT_primitive_voxels extension,
+ * which the voxel tiles of 3DTILES_content_voxels tilesets are made of, into
+ * bricks that a FCesiumVoxelSceneProxy raymarches.
+ *
+ * Only box-shaped voxel grids are supported. The grid fills the box from -1 to
+ * 1 along each axis of the primitive's coordinate system, with its X index
+ * varying fastest, then its Y index, then its Z index.
+ */
+namespace CesiumVoxels {
+
+/**
+ * The values of one attribute of the voxels of a primitive, as they are
+ * uploaded into a slot of a brick pool.
+ */
+struct Brick {
+  /**
+   * The number of voxels along each axis, including the padding.
+   */
+  FIntVector Dimensions = FIntVector::ZeroValue;
+
+  /**
+   * The number of voxels of padding before and after the voxels of the grid
+   * along each axis. The padding repeats the voxels of neighboring tiles, so
+   * that the values can be interpolated up to the edges of the grid.
+   */
+  FIntVector PaddingBefore = FIntVector::ZeroValue;
+  FIntVector PaddingAfter = FIntVector::ZeroValue;
+
+  /**
+   * The component type that the values are encoded as, chosen the same way as
+   * for the property tables of the encoded features metadata, and the
+   * corresponding pixel format of the brick pool.
+   */
+  ECesiumEncodedMetadataComponentType ComponentType =
+      ECesiumEncodedMetadataComponentType::Float;
+  EPixelFormat Format = PF_R32_FLOAT;
+
+  /**
+   * The values, in the pixel format of the brick pool. They are decoded as
+   * `ValueOffset + ValueScale * value`, where 8-bit values are normalized.
+   */
+  TArray<uint8> Data;
+  float ValueOffset = 0.0f;
+  float ValueScale = 1.0f;
+
+  /**
+   * Gets the number of bytes that a slot for the brick takes in GPU memory.
+   */
+  uint64 getSizeBytes() const;
+};
+
+using SharedBrick = TSharedPtr<const Brick, ESPMode::ThreadSafe>;
+
+/**
+ * Determines if a primitive has the EXT_primitive_voxels extension.
+ */
+bool isVoxelPrimitive(const CesiumGltf::MeshPrimitive& primitive);
+
+/**
+ * Loads an attribute of the voxels of a primitive into a brick.
+ *
+ * @param model The model that contains the primitive.
+ * @param primitive The voxel primitive.
+ * @param attributeName The name of the property of the voxels' property
+ * attribute that is drawn, or of the glTF attribute itself. If empty, the
+ * first property of the property attribute is drawn.
+ * @return The brick, or nullptr if the primitive has no such attribute, or
+ * its attribute doesn't have a scalar value for each voxel.
+ */
+SharedBrick load(
+    const CesiumGltf::Model& model,
+    const CesiumGltf::MeshPrimitive& primitive,
+    const std::string& attributeName);
+
+} // namespace CesiumVoxels
@@ -0,0 +1,280 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumWarmStartAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumJsonReader/JsonObjectJsonHandler.h"
+#include "CesiumJsonReader/JsonReader.h"
+#include "CesiumUtility/JsonValue.h"
+#include "Misc/Base64.h"
+#include <utility>
+#include <vector>
+
+namespace {
+
+const std::string getMethod = "GET";
+
+// Kept responses are stored under this prefix and the URL, so that they are
+// never mistaken for the entries of the request cache itself.
+const std::string keyPrefix = "warm-start:";
+
+// How long kept responses other than ion endpoints are used.
+constexpr std::time_t keptLifetimeSeconds = 7 * 24 * 60 * 60;
+
+// Kept ion endpoint responses stop being used this long before their access
+// token expires, so that the token doesn't expire while the root tileset is
+// loading.
+constexpr std::time_t accessTokenMarginSeconds = 5 * 60;
+
+class WarmStartAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  WarmStartAssetResponse(CesiumAsync::CacheResponse&& response)
+      : _statusCode(response.statusCode),
+        _headers(std::move(response.headers)),
+        _data(std::move(response.data)) {}
+
+  virtual uint16_t statusCode() const override { return this->_statusCode; }
+
+  virtual std::string contentType() const override {
+    auto it = this->_headers.find("Content-Type");
+    return it == this->_headers.end() ? std::string() : it->second;
+  }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  uint16_t _statusCode;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class WarmStartAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  WarmStartAssetRequest(CesiumAsync::CacheItem&& item)
+      : _method(getMethod),
+        _url(std::move(item.cacheRequest.url)),
+        _headers(std::move(item.cacheRequest.headers)),
+        _response(std::move(item.cacheResponse)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  WarmStartAssetResponse _response;
+};
+
+// The path of a URL, without its query or fragment.
+std::string getPath(const std::string& url) {
+  const size_t end = url.find_first_of("?#");
+  return end == std::string::npos ? url : url.substr(0, end);
+}
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+  return s.size() >= suffix.size() &&
+         s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool isEndpointUrl(const std::string& url) {
+  const std::string path = getPath(url);
+  return path.find("/v1/assets/") != std::string::npos &&
+         endsWith(path, "/endpoint");
+}
+
+std::optional<CesiumUtility::JsonValue>
+readJson(const gsl::span<const std::byte>& data) {
+  CesiumJsonReader::JsonObjectJsonHandler handler;
+  CesiumJsonReader::ReadJsonResult<CesiumUtility::JsonValue> result =
+      CesiumJsonReader::JsonReader::readJson(data, handler);
+  return std::move(result.value);
+}
+
+} // namespace
+
+CesiumWarmStartAssetAccessor::CesiumWarmStartAssetAccessor(
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase)
+    : _pAssetAccessor(pAssetAccessor),
+      _pCacheDatabase(pCacheDatabase),
+      _mutex(),
+      _requestedUrls() {}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWarmStartAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (!isWarmStartUrl(url)) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  bool firstRequest;
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    firstRequest = this->_requestedUrls.insert(url).second;
+  }
+  if (!firstRequest) {
+    return this->send(asyncSystem, url, headers);
+  }
+
+  // The lookup may wait for SQLite, so it is not made on the calling thread,
+  // which is often the game thread.
+  return asyncSystem
+      .runInWorkerThread([pThis = this->shared_from_this(), url]() {
+        return pThis->_pCacheDatabase->getEntry(keyPrefix + url);
+      })
+      .thenImmediately(
+          [pThis = this->shared_from_this(), asyncSystem, url, headers](
+              std::optional<CesiumAsync::CacheItem>&& maybeItem) {
+            if (!maybeItem || maybeItem->expiryTime <= std::time(nullptr)) {
+              return pThis->send(asyncSystem, url, headers);
+            }
+
+            // Revalidate the kept response for the next session.
+            pThis->send(asyncSystem, url, headers);
+
+            return asyncSystem
+                .createResolvedFuture<
+                    std::shared_ptr<CesiumAsync::IAssetRequest>>(
+                    std::make_shared<WarmStartAssetRequest>(
+                        std::move(*maybeItem)));
+          });
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWarmStartAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumWarmStartAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
+
+bool CesiumWarmStartAssetAccessor::isWarmStartUrl(const std::string& url) {
+  if (url.rfind("http://", 0) != 0 && url.rfind("https://", 0) != 0) {
+    return false;
+  }
+
+  const std::string path = getPath(url);
+  return endsWith(path, "/tileset.json") || endsWith(path, "/layer.json") ||
+         isEndpointUrl(url);
+}
+
+std::optional<std::time_t> CesiumWarmStartAssetAccessor::getAccessTokenExpiry(
+    const gsl::span<const std::byte>& endpointResponse) {
+  const std::optional<CesiumUtility::JsonValue> maybeEndpoint =
+      readJson(endpointResponse);
+  const std::string* pToken =
+      maybeEndpoint
+          ? maybeEndpoint->getValuePtrForKey<std::string>("accessToken")
+          : nullptr;
+  if (!pToken) {
+    return std::nullopt;
+  }
+
+  // The claims of a JSON web token are the second of its three parts,
+  // encoded with the URL-safe base64 alphabet and without padding.
+  const size_t claimsBegin = pToken->find('.');
+  const size_t claimsEnd = claimsBegin == std::string::npos
+                               ? std::string::npos
+                               : pToken->find('.', claimsBegin + 1);
+  if (claimsEnd == std::string::npos) {
+    return std::nullopt;
+  }
+
+  FString encoded(UTF8_TO_TCHAR(
+      pToken->substr(claimsBegin + 1, claimsEnd - claimsBegin - 1).c_str()));
+  while (encoded.Len() % 4 != 0) {
+    encoded.AppendChar(TEXT('='));
+  }
+  TArray<uint8> claims;
+  if (!FBase64::Decode(encoded, claims, EBase64Mode::UrlSafe)) {
+    return std::nullopt;
+  }
+
+  const std::optional<CesiumUtility::JsonValue> maybeClaims =
+      readJson(gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(claims.GetData()),
+          size_t(claims.Num())));
+  const CesiumUtility::JsonValue* pExpiry =
+      maybeClaims ? maybeClaims->getValuePtrForKey("exp") : nullptr;
+  if (!pExpiry) {
+    return std::nullopt;
+  }
+
+  std::optional<int64_t> maybeSeconds = pExpiry->getSafeNumber<int64_t>();
+  if (!maybeSeconds) {
+    return std::nullopt;
+  }
+  return std::time_t(*maybeSeconds);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWarmStartAssetAccessor::send(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  return this->_pAssetAccessor->get(asyncSystem, url, headers)
+      .thenInWorkerThread(
+          [pThis = this->shared_from_this()](
+              std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest) {
+            if (pRequest) {
+              pThis->keep(*pRequest);
+            }
+            return std::move(pRequest);
+          });
+}
+
+void CesiumWarmStartAssetAccessor::keep(
+    const CesiumAsync::IAssetRequest& request) {
+  const CesiumAsync::IAssetResponse* pResponse = request.response();
+  if (!pResponse || request.method() != getMethod ||
+      pResponse->statusCode() != 200) {
+    return;
+  }
+
+  std::time_t expiryTime = std::time(nullptr) + keptLifetimeSeconds;
+  if (isEndpointUrl(request.url())) {
+    std::optional<std::time_t> maybeTokenExpiry =
+        getAccessTokenExpiry(pResponse->data());
+    if (maybeTokenExpiry) {
+      expiryTime = *maybeTokenExpiry - accessTokenMarginSeconds;
+    }
+  }
+
+  this->_pCacheDatabase->storeEntry(
+      keyPrefix + request.url(),
+      expiryTime,
+      request.url(),
+      request.method(),
+      request.headers(),
+      pResponse->statusCode(),
+      pResponse->headers(),
+      pResponse->data());
+}
@@ -0,0 +1,98 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
+/**
+ * An asset accessor that answers the requests each tileset makes before it
+ * can load any tile, with the responses they got the last time, so that
+ * tilesets don't bootstrap one round trip after another each time the
+ * application starts.
+ *
+ * Those requests are for the endpoint of a Cesium ion asset, the root
+ * `tileset.json` of a tileset, and the `layer.json` of quantized-mesh
+ * terrain. Their successful responses are kept in the request cache database
+ * under keys of their own, whatever their cache headers say. The first
+ * request for each URL in a session is answered with the kept response, if
+ * there is one, while the same request is sent in the background and its
+ * response replaces the kept one for the next session. Later requests for the
+ * URL, such as the one made to refresh an expired ion access token, are
+ * always sent.
+ *
+ * Kept ion endpoint responses are only used until the access token they
+ * contain expires. Other kept responses are used for up to a week, so a
+ * tileset that changed on the server may show the previous version for one
+ * session.
+ */
+class CesiumWarmStartAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<CesiumWarmStartAssetAccessor> {
+public:
+  /**
+   * Creates an accessor.
+   *
+   * @param pAssetAccessor The accessor to use for the requests that are sent.
+   * @param pCacheDatabase The database in which to keep the responses.
+   */
+  CesiumWarmStartAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+      const std::shared_ptr<CesiumAsync::ICacheDatabase>& pCacheDatabase);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Determines whether the responses to a URL are kept for the next session:
+   * a Cesium ion asset endpoint, a `tileset.json`, or a `layer.json`.
+   */
+  static bool isWarmStartUrl(const std::string& url);
+
+  /**
+   * Gets the time at which the access token in a Cesium ion endpoint
+   * response expires, from the `exp` claim of the token.
+   *
+   * @return The expiry time, or std::nullopt if the response has no access
+   * token or its expiry can't be read.
+   */
+  static std::optional<std::time_t>
+  getAccessTokenExpiry(const gsl::span<const std::byte>& endpointResponse);
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> send(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers);
+
+  void keep(const CesiumAsync::IAssetRequest& request);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+  std::shared_ptr<CesiumAsync::ICacheDatabase> _pCacheDatabase;
+
+  // The URLs that have been requested in this session.
+  std::mutex _mutex;
+  std::unordered_set<std::string> _requestedUrls;
+};
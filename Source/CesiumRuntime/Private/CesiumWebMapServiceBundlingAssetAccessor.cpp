@@ -0,0 +1,548 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumWebMapServiceBundlingAssetAccessor.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumGltf/ImageCesium.h"
+#include "CesiumGltfReader/GltfReader.h"
+#include "CesiumTextureUtility.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+struct CesiumWebMapServiceBundlingAssetAccessor::Block {
+  CesiumGltf::ImageCesium image;
+};
+
+namespace {
+
+// The most blocks that are kept after they're loaded. A block is only needed
+// until the tiles around the one that was requested first are requested too,
+// which is nearly always within a few frames.
+constexpr size_t MaximumKeptBlocks = 32;
+
+// The largest image a block may be, so that servers don't reject it.
+constexpr int32_t MaximumBlockImageSize = 2048;
+
+struct QueryParameter {
+  std::string name;
+  std::string value;
+};
+
+struct ParsedUrl {
+  std::string path;
+  std::vector<QueryParameter> parameters;
+};
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+  return a.size() == b.size() &&
+         std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) ==
+                  std::tolower(static_cast<unsigned char>(y));
+         });
+}
+
+ParsedUrl parseUrl(const std::string& url) {
+  ParsedUrl result;
+  const size_t queryStart = url.find('?');
+  result.path = url.substr(0, queryStart);
+  if (queryStart == std::string::npos) {
+    return result;
+  }
+
+  size_t start = queryStart + 1;
+  while (start <= url.size()) {
+    size_t end = url.find('&', start);
+    if (end == std::string::npos) {
+      end = url.size();
+    }
+    if (end > start) {
+      const std::string parameter = url.substr(start, end - start);
+      const size_t equals = parameter.find('=');
+      result.parameters.push_back(
+          equals == std::string::npos
+              ? QueryParameter{parameter, std::string()}
+              : QueryParameter{
+                    parameter.substr(0, equals),
+                    parameter.substr(equals + 1)});
+    }
+    start = end + 1;
+  }
+  return result;
+}
+
+std::string formatUrl(const ParsedUrl& url) {
+  std::string result = url.path;
+  char separator = '?';
+  for (const QueryParameter& parameter : url.parameters) {
+    result += separator;
+    result += parameter.name;
+    if (!parameter.value.empty()) {
+      result += '=';
+      result += parameter.value;
+    }
+    separator = '&';
+  }
+  return result;
+}
+
+QueryParameter* findParameter(ParsedUrl& url, const std::string& name) {
+  auto it = std::find_if(
+      url.parameters.begin(),
+      url.parameters.end(),
+      [&name](const QueryParameter& parameter) {
+        return equalsIgnoreCase(parameter.name, name);
+      });
+  return it == url.parameters.end() ? nullptr : &*it;
+}
+
+bool hasParameter(
+    ParsedUrl& url,
+    const std::string& name,
+    const std::string& value) {
+  const QueryParameter* pParameter = findParameter(url, name);
+  return pParameter && equalsIgnoreCase(pParameter->value, value);
+}
+
+std::string formatDegrees(double degrees) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.12g", degrees);
+  return buffer;
+}
+
+// A tile of a GetMap request, within the block of tiles that is requested
+// instead.
+struct BundledTile {
+  std::string blockUrl;
+  int32_t columns;
+  int32_t rows;
+  // The tile's column in the block, from the west, and row, from the north.
+  int32_t column;
+  int32_t row;
+  int32_t width;
+  int32_t height;
+};
+
+std::optional<BundledTile> findBlock(ParsedUrl url, int32_t bundleSize) {
+  if (!hasParameter(url, "request", "GetMap") ||
+      !hasParameter(url, "version", "1.3.0") ||
+      !hasParameter(url, "crs", "EPSG:4326")) {
+    return std::nullopt;
+  }
+
+  QueryParameter* pBoundingBox = findParameter(url, "bbox");
+  QueryParameter* pWidth = findParameter(url, "width");
+  QueryParameter* pHeight = findParameter(url, "height");
+  if (!pBoundingBox || !pWidth || !pHeight) {
+    return std::nullopt;
+  }
+
+  // WMS 1.3.0 gives EPSG:4326 bounding boxes in latitude, longitude order.
+  double bounds[4];
+  const char* pNext = pBoundingBox->value.c_str();
+  for (int32_t i = 0; i < 4; ++i) {
+    char* pEnd = nullptr;
+    bounds[i] = std::strtod(pNext, &pEnd);
+    if (pEnd == pNext || (i < 3 && *pEnd != ',')) {
+      return std::nullopt;
+    }
+    pNext = pEnd + 1;
+  }
+  const double south = bounds[0];
+  const double west = bounds[1];
+  const double north = bounds[2];
+  const double east = bounds[3];
+
+  const int32_t width = std::atoi(pWidth->value.c_str());
+  const int32_t height = std::atoi(pHeight->value.c_str());
+  if (width <= 0 || height <= 0) {
+    return std::nullopt;
+  }
+
+  // The tile must be one of the tiling scheme with two root tiles, whose
+  // tiles are as many degrees wide as they are high.
+  const double span = north - south;
+  const double tolerance = span * 1e-4;
+  if (!(span > 0.0) || std::abs((east - west) - span) > tolerance) {
+    return std::nullopt;
+  }
+  const int64_t tilesY = std::llround(180.0 / span);
+  const int64_t tilesX = tilesY * 2;
+  if (tilesY < 1 || (tilesY & (tilesY - 1)) != 0 ||
+      std::abs(180.0 / double(tilesY) - span) > tolerance) {
+    return std::nullopt;
+  }
+
+  const int64_t x = std::llround((west + 180.0) / span);
+  const int64_t y = std::llround((south + 90.0) / span);
+  if (x < 0 || x >= tilesX || y < 0 || y >= tilesY ||
+      std::abs(double(x) * span - 180.0 - west) > tolerance ||
+      std::abs(double(y) * span - 90.0 - south) > tolerance) {
+    return std::nullopt;
+  }
+
+  const int64_t blockX = x - x % bundleSize;
+  const int64_t blockY = y - y % bundleSize;
+  const int32_t columns =
+      int32_t(std::min<int64_t>(bundleSize, tilesX - blockX));
+  const int32_t rows =
+      int32_t(std::min<int64_t>(bundleSize, tilesY - blockY));
+  if ((columns == 1 && rows == 1) ||
+      int64_t(columns) * width > MaximumBlockImageSize ||
+      int64_t(rows) * height > MaximumBlockImageSize) {
+    return std::nullopt;
+  }
+
+  const double blockSouth = double(blockY) * span - 90.0;
+  const double blockWest = double(blockX) * span - 180.0;
+  pBoundingBox->value = formatDegrees(blockSouth) + "," +
+                        formatDegrees(blockWest) + "," +
+                        formatDegrees(blockSouth + rows * span) + "," +
+                        formatDegrees(blockWest + columns * span);
+  pWidth->value = std::to_string(columns * width);
+  pHeight->value = std::to_string(rows * height);
+
+  return BundledTile{
+      formatUrl(url),
+      columns,
+      rows,
+      int32_t(x - blockX),
+      int32_t(blockY + rows - 1 - y),
+      width,
+      height};
+}
+
+uint32_t computeCrc32(const std::byte* pData, size_t size, uint32_t crc = 0) {
+  static const std::array<uint32_t, 256> table = []() {
+    std::array<uint32_t, 256> result{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int32_t k = 0; k < 8; ++k) {
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      }
+      result[i] = c;
+    }
+    return result;
+  }();
+
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ uint32_t(pData[i])) & 0xFF] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+void appendUint32(std::vector<std::byte>& out, uint32_t value) {
+  out.push_back(std::byte(value >> 24));
+  out.push_back(std::byte(value >> 16));
+  out.push_back(std::byte(value >> 8));
+  out.push_back(std::byte(value));
+}
+
+void appendChunk(
+    std::vector<std::byte>& out,
+    const char* type,
+    const std::vector<std::byte>& data) {
+  appendUint32(out, uint32_t(data.size()));
+  const size_t typeOffset = out.size();
+  for (int32_t i = 0; i < 4; ++i) {
+    out.push_back(std::byte(type[i]));
+  }
+  out.insert(out.end(), data.begin(), data.end());
+  appendUint32(
+      out,
+      computeCrc32(out.data() + typeOffset, out.size() - typeOffset));
+}
+
+// Encodes part of an image as a PNG without compression, which takes little
+// more than copying the pixels and is decoded just as quickly.
+std::vector<std::byte> encodeUncompressedPng(
+    const CesiumGltf::ImageCesium& image,
+    int32_t x,
+    int32_t y,
+    int32_t width,
+    int32_t height) {
+  const int32_t channels = image.channels;
+  const size_t rowSize = size_t(width * channels);
+
+  // Each row starts with the filter type, which is none.
+  std::vector<std::byte> pixels;
+  pixels.reserve((rowSize + 1) * size_t(height));
+  for (int32_t row = 0; row < height; ++row) {
+    const std::byte* pRow =
+        image.pixelData.data() +
+        (size_t(y + row) * size_t(image.width) + size_t(x)) * channels;
+    pixels.push_back(std::byte(0));
+    pixels.insert(pixels.end(), pRow, pRow + rowSize);
+  }
+
+  // A zlib stream of stored deflate blocks.
+  std::vector<std::byte> compressed;
+  compressed.reserve(pixels.size() + pixels.size() / 65535 * 5 + 16);
+  compressed.push_back(std::byte(0x78));
+  compressed.push_back(std::byte(0x01));
+  size_t offset = 0;
+  do {
+    const size_t size = std::min<size_t>(pixels.size() - offset, 65535);
+    const bool last = offset + size == pixels.size();
+    compressed.push_back(std::byte(last ? 1 : 0));
+    compressed.push_back(std::byte(size & 0xFF));
+    compressed.push_back(std::byte(size >> 8));
+    compressed.push_back(std::byte(~size & 0xFF));
+    compressed.push_back(std::byte((~size >> 8) & 0xFF));
+    compressed.insert(
+        compressed.end(),
+        pixels.begin() + offset,
+        pixels.begin() + offset + size);
+    offset += size;
+  } while (offset < pixels.size());
+
+  uint32_t a = 1;
+  uint32_t b = 0;
+  for (std::byte value : pixels) {
+    a = (a + uint32_t(value)) % 65521;
+    b = (b + a) % 65521;
+  }
+  appendUint32(compressed, (b << 16) | a);
+
+  static constexpr uint8_t colorTypes[] = {0, 4, 2, 6};
+  std::vector<std::byte> header;
+  appendUint32(header, uint32_t(width));
+  appendUint32(header, uint32_t(height));
+  header.push_back(std::byte(8));
+  header.push_back(std::byte(colorTypes[channels - 1]));
+  header.push_back(std::byte(0));
+  header.push_back(std::byte(0));
+  header.push_back(std::byte(0));
+
+  std::vector<std::byte> result;
+  result.reserve(compressed.size() + 64);
+  static constexpr uint8_t signature[] =
+      {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  for (uint8_t value : signature) {
+    result.push_back(std::byte(value));
+  }
+  appendChunk(result, "IHDR", header);
+  appendChunk(result, "IDAT", compressed);
+  appendChunk(result, "IEND", {});
+  return result;
+}
+
+class BundledAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  BundledAssetResponse(std::vector<std::byte>&& data)
+      : _headers(), _data(std::move(data)) {}
+
+  virtual uint16_t statusCode() const override { return 200; }
+
+  virtual std::string contentType() const override { return "image/png"; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual gsl::span<const std::byte> data() const override {
+    return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+  }
+
+private:
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+class BundledAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  BundledAssetRequest(
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      std::vector<std::byte>&& data)
+      : _method("GET"),
+        _url(url),
+        _headers(headers.begin(), headers.end()),
+        _response(std::move(data)) {}
+
+  virtual const std::string& method() const override { return this->_method; }
+
+  virtual const std::string& url() const override { return this->_url; }
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override {
+    return this->_headers;
+  }
+
+  virtual const CesiumAsync::IAssetResponse* response() const override {
+    return &this->_response;
+  }
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  BundledAssetResponse _response;
+};
+
+} // namespace
+
+CesiumWebMapServiceBundlingAssetAccessor::
+    CesiumWebMapServiceBundlingAssetAccessor(
+        const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor)
+    : _pAssetAccessor(pAssetAccessor), _mutex(), _blocks(), _blockUrls() {}
+
+std::string CesiumWebMapServiceBundlingAssetAccessor::addBundleSizeToUrl(
+    const std::string& baseUrl,
+    int32_t bundleSize) {
+  return baseUrl + (baseUrl.find('?') == std::string::npos ? "?" : "&") +
+         BundleSizeParameter + "=" + std::to_string(bundleSize);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWebMapServiceBundlingAssetAccessor::get(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  if (url.find(BundleSizeParameter) == std::string::npos) {
+    return this->_pAssetAccessor->get(asyncSystem, url, headers);
+  }
+
+  // The parameter is only for this accessor, so it's removed from every
+  // request of the overlay, such as that of the server's capabilities.
+  ParsedUrl parsed = parseUrl(url);
+  int32_t bundleSize = 1;
+  parsed.parameters.erase(
+      std::remove_if(
+          parsed.parameters.begin(),
+          parsed.parameters.end(),
+          [&bundleSize](const QueryParameter& parameter) {
+            if (parameter.name != BundleSizeParameter) {
+              return false;
+            }
+            bundleSize = std::clamp(
+                std::atoi(parameter.value.c_str()),
+                1,
+                MaximumBundleSize);
+            return true;
+          }),
+      parsed.parameters.end());
+  std::string tileUrl = formatUrl(parsed);
+
+  std::optional<BundledTile> maybeTile =
+      bundleSize > 1 ? findBlock(parsed, bundleSize) : std::nullopt;
+  if (!maybeTile) {
+    return this->_pAssetAccessor->get(asyncSystem, tileUrl, headers);
+  }
+
+  return this->getBlock(asyncSystem, maybeTile->blockUrl, headers)
+      .thenInWorkerThread(
+          [pThis = this->shared_from_this(),
+           asyncSystem,
+           tileUrl = std::move(tileUrl),
+           headers,
+           tile = std::move(*maybeTile)](
+              const std::shared_ptr<const Block>& pBlock) {
+            if (!pBlock) {
+              return pThis->_pAssetAccessor->get(asyncSystem, tileUrl, headers);
+            }
+
+            std::shared_ptr<CesiumAsync::IAssetRequest> pRequest =
+                std::make_shared<BundledAssetRequest>(
+                    tileUrl,
+                    headers,
+                    encodeUncompressedPng(
+                        pBlock->image,
+                        tile.column * tile.width,
+                        tile.row * tile.height,
+                        tile.width,
+                        tile.height));
+            return asyncSystem.createResolvedFuture(std::move(pRequest));
+          });
+}
+
+CesiumAsync::SharedFuture<
+    std::shared_ptr<const CesiumWebMapServiceBundlingAssetAccessor::Block>>
+CesiumWebMapServiceBundlingAssetAccessor::getBlock(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers) {
+  {
+    std::scoped_lock<std::mutex> lock(this->_mutex);
+    auto it = this->_blocks.find(url);
+    if (it != this->_blocks.end()) {
+      this->_blockUrls.remove(url);
+      this->_blockUrls.push_front(url);
+      return it->second;
+    }
+  }
+
+  // A block that can't be loaded is kept too, as nothing, so that its tiles
+  // are requested on their own without trying the block again.
+  CesiumAsync::SharedFuture<std::shared_ptr<const Block>> block =
+      this->_pAssetAccessor->get(asyncSystem, url, headers)
+          .thenInWorkerThread(
+              [](std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest)
+                  -> std::shared_ptr<const Block> {
+                const CesiumAsync::IAssetResponse* pResponse =
+                    pRequest ? pRequest->response() : nullptr;
+                if (!pResponse || pResponse->statusCode() < 200 ||
+                    pResponse->statusCode() > 299) {
+                  return nullptr;
+                }
+
+                CesiumGltfReader::ImageReaderResult result =
+                    CesiumGltfReader::GltfReader::readImage(
+                        pResponse->data(),
+                        CesiumTextureUtility::getKtx2TranscodeTargets());
+                if (!result.image) {
+                  return nullptr;
+                }
+
+                const CesiumGltf::ImageCesium& image = *result.image;
+                if (image.bytesPerChannel != 1 || image.channels < 1 ||
+                    image.channels > 4 || !image.mipPositions.empty() ||
+                    image.compressedPixelFormat !=
+                        CesiumGltf::GpuCompressedPixelFormat::NONE ||
+                    image.pixelData.size() != size_t(image.width) *
+                                                  size_t(image.height) *
+                                                  size_t(image.channels)) {
+                  return nullptr;
+                }
+
+                auto pBlock = std::make_shared<Block>();
+                pBlock->image = std::move(*result.image);
+                return pBlock;
+              })
+          .catchImmediately([](std::exception&&) {
+            return std::shared_ptr<const Block>();
+          })
+          .share();
+
+  std::scoped_lock<std::mutex> lock(this->_mutex);
+  auto [it, added] = this->_blocks.emplace(url, block);
+  if (added) {
+    this->_blockUrls.push_front(url);
+    while (this->_blockUrls.size() > MaximumKeptBlocks) {
+      this->_blocks.erase(this->_blockUrls.back());
+      this->_blockUrls.pop_back();
+    }
+  }
+  return it->second;
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+CesiumWebMapServiceBundlingAssetAccessor::request(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::string& verb,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+    const gsl::span<const std::byte>& contentPayload) {
+  return this->_pAssetAccessor
+      ->request(asyncSystem, verb, url, headers, contentPayload);
+}
+
+void CesiumWebMapServiceBundlingAssetAccessor::tick() noexcept {
+  this->_pAssetAccessor->tick();
+}
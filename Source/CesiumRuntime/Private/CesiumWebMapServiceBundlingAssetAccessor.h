@@ -0,0 +1,91 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/SharedFuture.h"
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * An asset accessor that answers the GetMap requests of Web Map Service
+ * raster overlay tiles from images covering several tiles, so that a block of
+ * N×N tiles takes one request instead of N².
+ *
+ * Only the requests of overlays that ask for bundling are changed. Their base
+ * URL carries a {@link BundleSizeParameter} giving N, which this accessor
+ * removes from every request before it is sent. For a GetMap request of a
+ * tile, the block of tiles containing it is requested instead, with a
+ * bounding box and an image size N times as large. The block's image is
+ * decoded once in a worker thread, and each of its tiles is answered with its
+ * part of the image, as an uncompressed PNG. Blocks are kept for the other
+ * tiles that are requested soon after. If a block can't be loaded, the tile
+ * is requested on its own.
+ *
+ * This relies on cesium-native requesting WMS 1.3.0 tiles of the geographic
+ * tiling scheme with two root tiles, with a `bbox` in EPSG:4326 axis order.
+ * Any other request is sent unchanged.
+ */
+class CesiumWebMapServiceBundlingAssetAccessor
+    : public CesiumAsync::IAssetAccessor,
+      public std::enable_shared_from_this<
+          CesiumWebMapServiceBundlingAssetAccessor> {
+public:
+  /**
+   * The name of the URL query parameter giving the number of tiles along
+   * each side of a block.
+   */
+  static constexpr const char* BundleSizeParameter = "cesiumTileBundle";
+
+  /**
+   * The most tiles along each side of a block.
+   */
+  static constexpr int32_t MaximumBundleSize = 4;
+
+  CesiumWebMapServiceBundlingAssetAccessor(
+      const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor);
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers)
+      override;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override;
+
+  virtual void tick() noexcept override;
+
+  /**
+   * Adds the {@link BundleSizeParameter} to the base URL of an overlay.
+   */
+  static std::string
+  addBundleSizeToUrl(const std::string& baseUrl, int32_t bundleSize);
+
+  struct Block;
+
+private:
+  CesiumAsync::SharedFuture<std::shared_ptr<const Block>> getBlock(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers);
+
+  std::shared_ptr<CesiumAsync::IAssetAccessor> _pAssetAccessor;
+
+  std::mutex _mutex;
+  // The blocks that are loading or were loaded recently, by URL, and their
+  // URLs, most recently used first.
+  std::unordered_map<
+      std::string,
+      CesiumAsync::SharedFuture<std::shared_ptr<const Block>>>
+      _blocks;
+  std::list<std::string> _blockUrls;
+};
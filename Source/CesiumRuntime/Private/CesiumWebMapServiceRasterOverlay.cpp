@@ -4,6 +4,7 @@
 #include "Algo/Transform.h"
 #include "CesiumRasterOverlays/WebMapServiceRasterOverlay.h"
 #include "CesiumRuntime.h"
+#include "CesiumWebMapServiceBundlingAssetAccessor.h"
 
 std::unique_ptr<CesiumRasterOverlays::RasterOverlay>
 UCesiumWebMapServiceRasterOverlay::CreateOverlay(
@@ -21,9 +22,19 @@ UCesiumWebMapServiceRasterOverlay::CreateOverlay(
   wmsOptions.layers = TCHAR_TO_UTF8(*Layers);
   wmsOptions.tileWidth = TileWidth;
   wmsOptions.tileHeight = TileHeight;
+
+  std::string baseUrl = TCHAR_TO_UTF8(*this->BaseUrl);
+  if (this->RequestBundleSize > 1) {
+    baseUrl = CesiumWebMapServiceBundlingAssetAccessor::addBundleSizeToUrl(
+        baseUrl,
+        FMath::Min(
+            this->RequestBundleSize,
+            CesiumWebMapServiceBundlingAssetAccessor::MaximumBundleSize));
+  }
+
   return std::make_unique<CesiumRasterOverlays::WebMapServiceRasterOverlay>(
       TCHAR_TO_UTF8(*this->MaterialLayerKey),
-      TCHAR_TO_UTF8(*this->BaseUrl),
+      baseUrl,
       std::vector<CesiumAsync::IAssetAccessor::THeader>(),
       wmsOptions,
       options);
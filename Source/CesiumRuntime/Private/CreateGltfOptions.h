@@ -2,12 +2,14 @@
 
 #pragma once
 
+#include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataComponent.h"
 #include "CesiumGltf/Mesh.h"
 #include "CesiumGltf/MeshPrimitive.h"
 #include "CesiumGltf/Model.h"
 #include "CesiumGltf/Node.h"
 #include "LoadGltfResult.h"
+#include <mutex>
 
 // TODO: internal documentation
 namespace CreateGltfOptions {
@@ -16,14 +18,61 @@ struct CreateModelOptions {
    * A pointer to the glTF model.
    */
   CesiumGltf::Model* pModel = nullptr;
-  const FCesiumFeaturesMetadataDescription* pFeaturesMetadataDescription =
-      nullptr;
+  const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription*
+      pFeaturesMetadataDescription = nullptr;
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   const FMetadataDescription* pEncodedMetadataDescription_DEPRECATED = nullptr;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
   bool alwaysIncludeTangents = false;
   bool createPhysicsMeshes = true;
+  bool createPhysicsMeshesOnDemand = false;
+  double physicsMeshSimplificationError = 0.0;
+  bool createTraceMeshes = false;
+  bool createFeatureIndices = false;
   bool ignoreKhrMaterialsUnlit = false;
+  bool compressTextures = false;
+  bool useCompactVertexFormat = false;
+  bool quantizePointClouds = false;
+  bool generateSmoothNormals = false;
+  float smoothNormalsCreaseAngle = 45.0f;
+  bool useFastTangentsForWater = false;
+  bool useTerrainHeightmaps = false;
+  int32 terrainHeightmapResolution = 65;
+  /**
+   * Whether the texture coordinates of raster overlays are left to the
+   * material to compute, instead of being copied into the UVs of the meshes.
+   */
+  bool computeOverlayTextureCoordinates = false;
+  /**
+   * Whether attribute and implicit feature IDs are packed into the texture
+   * coordinates, two sets per channel, or split over both components of a
+   * channel when a float can't hold them exactly.
+   */
+  bool packFeatureIds = false;
+  /**
+   * The property of the voxels of voxel primitives that is loaded into their
+   * bricks. If empty, the first property is loaded.
+   */
+  std::string voxelAttribute;
+  bool optimizeMeshes = false;
+  bool buildNaniteMeshes = false;
+  bool generateSimplifiedLod = false;
+  float simplifiedLodScreenSize = 0.25f;
+  bool useClusterCulling = false;
+  bool mergeInstancedMeshes = false;
+  bool mergeSmallPrimitives = false;
+  /**
+   * Whether the data of the model's buffers is released once its meshes have
+   * been created, keeping only the positions and indices of its primitives if
+   * `keepPickingBuffers` is true.
+   */
+  bool releaseBuffers = false;
+  bool keepPickingBuffers = true;
+  /**
+   * Whether only what collision needs is created, without textures, normals,
+   * tangents, or other render data, as on a dedicated server.
+   */
+  bool headless = false;
 };
 
 struct CreateNodeOptions {
@@ -42,5 +91,11 @@ struct CreatePrimitiveOptions {
   const CreateMeshOptions* pMeshOptions = nullptr;
   const LoadGltfResult::LoadMeshResult* pHalfConstructedMeshResult = nullptr;
   CesiumGltf::MeshPrimitive* pPrimitive = nullptr;
+  /**
+   * Guards the parts of the model shared by all of its primitives, such as
+   * textures and images, when primitives are loaded concurrently. May be
+   * nullptr if they are not.
+   */
+  std::mutex* pModelMutex = nullptr;
 };
 } // namespace CreateGltfOptions
@@ -7,6 +7,7 @@
 #include "CesiumTransforms.h"
 #include "VecMath.h"
 #include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtx/norm.hpp>
 #include <glm/gtx/quaternion.hpp>
 
 using namespace CesiumGeospatial;
@@ -40,7 +41,9 @@ GeoTransforms::GeoTransforms()
       _center(0.0),
       _scale(1.0),
       _ecefToUnreal(),
-      _unrealToEcef() {
+      _unrealToEcef(),
+      _localApproximationRadius(0.0),
+      _localApproximation() {
   // Coordinate system is initialized with the default values. This function
   // overrides them with proper values.
   this->updateTransforms();
@@ -61,7 +64,9 @@ GeoTransforms::GeoTransforms(
       _center(center),
       _scale(scale),
       _ecefToUnreal(),
-      _unrealToEcef() {
+      _unrealToEcef(),
+      _localApproximationRadius(0.0),
+      _localApproximation() {
   // Coordinate system is initialized with the default values. This function
   // overrides them with proper values.
   this->updateTransforms();
@@ -82,6 +87,13 @@ void GeoTransforms::setEllipsoid(
   }
 }
 
+void GeoTransforms::setLocalApproximationRadius(double radius) noexcept {
+  if (this->_localApproximationRadius != radius) {
+    this->_localApproximationRadius = radius;
+    updateTransforms();
+  }
+}
+
 glm::dquat GeoTransforms::ComputeSurfaceNormalRotation(
     const glm::dvec3& oldPosition,
     const glm::dvec3& newPosition) const {
@@ -112,6 +124,34 @@ void GeoTransforms::updateTransforms() noexcept {
   this->_unrealToEcef = VecMath::createMatrix(
       this->_coordinateSystem.getLocalToEcefTransformation());
 
+  // The local approximation works in the meridian plane, so it needs an
+  // ellipsoid of revolution, and the center must be far enough from the axis
+  // that the positions around it don't cross over a pole.
+  this->_localApproximation.reset();
+  const glm::dvec3& radii = this->_ellipsoid.getRadii();
+  const double distanceFromAxis = glm::length(glm::dvec2(this->_center));
+  std::optional<Cartographic> maybeCenter;
+  if (this->_localApproximationRadius > 0.0 && radii.x == radii.y &&
+      distanceFromAxis > this->_localApproximationRadius) {
+    maybeCenter = this->_ellipsoid.cartesianToCartographic(this->_center);
+  }
+  if (maybeCenter) {
+    const double sinLatitude = glm::sin(maybeCenter->latitude);
+    const double axisRatio = radii.z / radii.x;
+    const double eccentricitySquared = 1.0 - axisRatio * axisRatio;
+    const double w = 1.0 - eccentricitySquared * sinLatitude * sinLatitude;
+    this->_localApproximation = LocalApproximation{
+        maybeCenter->latitude,
+        maybeCenter->height,
+        sinLatitude,
+        glm::cos(maybeCenter->latitude),
+        distanceFromAxis,
+        this->_center.z,
+        radii.x * (1.0 - eccentricitySquared) / (w * glm::sqrt(w)),
+        1.5 * eccentricitySquared * sinLatitude *
+            glm::cos(maybeCenter->latitude) / w};
+  }
+
   UE_LOG(
       LogCesium,
       Verbose,
@@ -136,6 +176,12 @@ glm::dvec3 GeoTransforms::TransformLongitudeLatitudeHeightToEcef(
 
 glm::dvec3 GeoTransforms::TransformEcefToLongitudeLatitudeHeight(
     const glm::dvec3& ecef) const noexcept {
+  std::optional<glm::dvec3> maybeApproximation =
+      this->approximateEcefToLongitudeLatitudeHeight(ecef);
+  if (maybeApproximation) {
+    return *maybeApproximation;
+  }
+
   std::optional<CesiumGeospatial::Cartographic> llh =
       _ellipsoid.cartesianToCartographic(ecef);
   if (!llh) {
@@ -150,6 +196,39 @@ glm::dvec3 GeoTransforms::TransformEcefToLongitudeLatitudeHeight(
       llh->height);
 }
 
+std::optional<glm::dvec3>
+GeoTransforms::approximateEcefToLongitudeLatitudeHeight(
+    const glm::dvec3& ecef) const {
+  const double radius = this->_localApproximationRadius;
+  if (!this->_localApproximation ||
+      glm::distance2(ecef, this->_center) > radius * radius) {
+    return std::nullopt;
+  }
+
+  // Geodetic latitude and height only depend on the distance from the axis
+  // and the height above the equator, so find the position relative to the
+  // center in the meridian plane, in the directions north and up. The
+  // latitude and height then follow from the circle that osculates the
+  // meridian at the center, with a second-order correction to the latitude
+  // for the change in the meridian's curvature away from the center.
+  const LocalApproximation& center = *this->_localApproximation;
+  const double dp = glm::length(glm::dvec2(ecef)) - center.distanceFromAxis;
+  const double dz = ecef.z - center.z;
+  const double north = center.cosLatitude * dz - center.sinLatitude * dp;
+  const double up = center.cosLatitude * dp + center.sinLatitude * dz;
+  const double fromCurvatureCenter = center.meridianRadius + center.height + up;
+
+  const double angle = glm::atan(north, fromCurvatureCenter);
+
+  return glm::dvec3(
+      glm::degrees(glm::atan(ecef.y, ecef.x)),
+      glm::degrees(
+          center.latitude + angle -
+          center.latitudeCorrection * angle * angle),
+      glm::sqrt(north * north + fromCurvatureCenter * fromCurvatureCenter) -
+          center.meridianRadius);
+}
+
 glm::dvec3 GeoTransforms::TransformLongitudeLatitudeHeightToUnreal(
     const glm::dvec3& origin,
     const glm::dvec3& longitudeLatitudeHeight) const noexcept {
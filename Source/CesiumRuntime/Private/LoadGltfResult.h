@@ -4,12 +4,19 @@
 
 #include "CesiumCommon.h"
 #include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumFeatureIndex.h"
+#include "CesiumGaussianSplats.h"
+#include "CesiumLoadArena.h"
+#include "CesiumMeshClusters.h"
 #include "CesiumMetadataPrimitive.h"
 #include "CesiumModelMetadata.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
 #include "CesiumRasterOverlays.h"
+#include "CesiumTerrainHeightmap.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTriangleBVH.h"
+#include "CesiumVoxels.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
 #include "Containers/Map.h"
 #include "Containers/UnrealString.h"
@@ -23,12 +30,32 @@
 #include <CesiumGltf/Model.h>
 #include <cstdint>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace LoadGltfResult {
+/**
+ * A vector of the temporaries of a tile's load, allocated from the tile's
+ * `CesiumLoadArena`.
+ */
+template <typename T>
+using ArenaVector = std::vector<T, CesiumLoadArenaAllocator<T>>;
+
+/**
+ * A map of material parameter names to texture coordinate indices, allocated
+ * from the tile's `CesiumLoadArena`. The names must be string literals.
+ */
+using TextureCoordinateParameterMap = std::unordered_map<
+    std::string_view,
+    uint32_t,
+    std::hash<std::string_view>,
+    std::equal_to<std::string_view>,
+    CesiumLoadArenaAllocator<std::pair<const std::string_view, uint32_t>>>;
+
 /**
  * Represents the result of loading a glTF primitive on a game thread.
  * Temporarily holds render data that will be used in the Unreal material, as
@@ -64,7 +91,7 @@ struct LoadPrimitiveResult {
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult> emissiveTexture;
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult> occlusionTexture;
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult> waterMaskTexture;
-  std::unordered_map<std::string, uint32_t> textureCoordinateParameters;
+  TextureCoordinateParameterMap textureCoordinateParameters;
   /**
    * A map of feature ID set names to their corresponding texture coordinate
    * indices in the Unreal mesh.
@@ -82,9 +109,61 @@ struct LoadPrimitiveResult {
 
   /**
    * The dimensions of the primitive. Passed to a CesiumGltfPointsComponent for
-   * use in computing attenuation.
+   * use in computing attenuation, and used for the primitive's draw distance.
+   */
+  glm::vec3 dimensions{0.0f};
+
+  /**
+   * The positions of a point primitive quantized to 16 bits per component, if
+   * point clouds are quantized. Passed to a CesiumGltfPointsComponent, which
+   * draws them in place of the positions in the render data, which are then
+   * only a placeholder.
+   */
+  TSharedPtr<const TArray<uint16>, ESPMode::ThreadSafe> QuantizedPointPositions;
+
+  /**
+   * The bounding box of the quantized point positions, which a position is
+   * dequantized with as `offset + scale * (quantized / 65535)`.
+   */
+  FVector3f QuantizedPointOffset{0.0f};
+  FVector3f QuantizedPointScale{0.0f};
+
+  /**
+   * The packed splats of a point primitive that consists of Gaussian splats.
+   * Passed to a CesiumGltfGaussianSplatComponent, which draws them in place
+   * of the points.
+   */
+  CesiumGaussianSplats::PackedSplats GaussianSplats;
+
+  /**
+   * The heightmap of a quantized-mesh terrain primitive, when terrain is drawn
+   * from heightmaps. Passed to a CesiumGltfTerrainHeightmapComponent, which
+   * draws it in place of the render data, which is then only a placeholder.
+   */
+  CesiumTerrainHeightmap::SharedHeightmap TerrainHeightmap;
+
+  /**
+   * The brick of a voxel primitive. Passed to a CesiumGltfVoxelComponent,
+   * which raymarches it in place of the render data, which is then only a
+   * placeholder.
    */
-  glm::vec3 dimensions;
+  CesiumVoxels::SharedBrick Voxels;
+
+  /**
+   * The sizes in bytes of the vertex and index buffers in the render data,
+   * and of the collision and trace meshes.
+   */
+  uint64 vertexBytes = 0;
+  uint64 indexBytes = 0;
+  uint64 collisionBytes = 0;
+
+  /**
+   * A hash of the glTF attributes and indices of an instanced primitive, if
+   * instanced meshes are merged across tiles, which identifies the primitives
+   * of different tiles with the same geometry. Zero when the primitive isn't
+   * instanced, or its geometry can't be hashed.
+   */
+  uint64 instanceGeometryHash = 0;
 
 #pragma endregion
 
@@ -143,6 +222,24 @@ struct LoadPrimitiveResult {
    */
   CesiumGltf::IndexAccessorType IndexAccessor;
 
+  /**
+   * The clusters of the mesh's triangles, if it was split into clusters to be
+   * culled separately.
+   */
+  TArray<CesiumMeshCluster> Clusters;
+
+  /**
+   * The hierarchy over the triangles of the primitive that the tileset traces
+   * lines against, if trace meshes are created.
+   */
+  TSharedPtr<const CesiumTriangleBVH> pTraceMesh;
+
+  /**
+   * The index from the feature IDs of the primitive to its faces, if feature
+   * indices are created.
+   */
+  TSharedPtr<const CesiumFeatureIndex> pFeatureIndex;
+
 #pragma endregion
 };
 
@@ -150,7 +247,7 @@ struct LoadPrimitiveResult {
  * Represents the result of loading a glTF mesh on a game thread.
  */
 struct LoadMeshResult {
-  std::vector<LoadPrimitiveResult> primitiveResults{};
+  ArenaVector<LoadPrimitiveResult> primitiveResults{};
 };
 
 /**
@@ -161,7 +258,7 @@ struct LoadNodeResult {
   /**
    * Array of instance transforms, if any.
    */
-  std::vector<FTransform> InstanceTransforms;
+  TArray<FTransform> InstanceTransforms;
 };
 
 /**
@@ -170,7 +267,14 @@ struct LoadNodeResult {
  * CesiumGltfComponent after it is created on the main thread.
  */
 struct LoadModelResult {
-  std::vector<LoadNodeResult> nodeResults{};
+  /**
+   * The arena of the short-lived containers of this result and of its nodes
+   * and primitives, which are freed all at once with it. This is declared
+   * first so that it is destroyed last.
+   */
+  std::shared_ptr<CesiumLoadArena> pArena{};
+
+  ArenaVector<LoadNodeResult> nodeResults{};
 
   // Parses the root EXT_structural_metadata extension.
   FCesiumModelMetadata Metadata{};
@@ -181,5 +285,12 @@ struct LoadModelResult {
   // For backwards compatibility with CesiumEncodedMetadataComponent.
   std::optional<CesiumEncodedMetadataUtility::EncodedMetadata>
       EncodedMetadata_DEPRECATED{};
+
+  /**
+   * @brief Gets an allocator from this result's arena.
+   */
+  template <typename T> CesiumLoadArenaAllocator<T> getAllocator() const {
+    return CesiumLoadArenaAllocator<T>(this->pArena.get());
+  }
 };
 } // namespace LoadGltfResult
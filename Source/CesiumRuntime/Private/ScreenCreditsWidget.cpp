@@ -8,6 +8,7 @@
 #include "Framework/Application/SlateApplication.h"
 #include "HttpModule.h"
 #include "ImageUtils.h"
+#include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Math/UnrealMathUtility.h"
 #include "Misc/Base64.h"
@@ -23,6 +24,75 @@
 #include <string>
 #include <vector>
 
+namespace {
+
+using ImageCallback = TFunction<void(const TArray<uint8>*)>;
+
+/**
+ * The credit images downloaded so far, by URL, and the callbacks waiting for
+ * the images being downloaded. They are shared by all credit widgets, so
+ * that an image is downloaded once even if the widget is recreated or several
+ * worlds show the same credit. Only used from the game thread.
+ */
+struct CreditImageDownloads {
+  TMap<FString, TArray<uint8>> images;
+  TMap<FString, TArray<ImageCallback>> waiting;
+};
+
+CreditImageDownloads& getCreditImageDownloads() {
+  static CreditImageDownloads downloads;
+  return downloads;
+}
+
+/**
+ * Calls the callback with the data of the image at the URL, or with nullptr
+ * if it can't be downloaded. If the image has been downloaded before, the
+ * callback is called immediately. Failed downloads are tried again the next
+ * time the image is asked for.
+ */
+void downloadCreditImage(const FString& url, ImageCallback&& callback) {
+  CreditImageDownloads& downloads = getCreditImageDownloads();
+  const TArray<uint8>* pImage = downloads.images.Find(url);
+  if (pImage) {
+    callback(pImage);
+    return;
+  }
+
+  TArray<ImageCallback>* pWaiting = downloads.waiting.Find(url);
+  if (pWaiting) {
+    pWaiting->Add(MoveTemp(callback));
+    return;
+  }
+  downloads.waiting.Add(url).Add(MoveTemp(callback));
+
+  TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest =
+      FHttpModule::Get().CreateRequest();
+  HttpRequest->OnProcessRequestComplete().BindLambda(
+      [url](
+          FHttpRequestPtr HttpRequest,
+          FHttpResponsePtr HttpResponse,
+          bool bSucceeded) {
+        CreditImageDownloads& downloads = getCreditImageDownloads();
+        const TArray<uint8>* pImage = nullptr;
+        if (bSucceeded && HttpResponse.IsValid() &&
+            EHttpResponseCodes::IsOk(HttpResponse->GetResponseCode()) &&
+            HttpResponse->GetContentLength() > 0) {
+          pImage = &downloads.images.Add(url, HttpResponse->GetContent());
+        }
+
+        TArray<ImageCallback> callbacks;
+        downloads.waiting.RemoveAndCopyValue(url, callbacks);
+        for (ImageCallback& waitingCallback : callbacks) {
+          waitingCallback(pImage);
+        }
+      });
+  HttpRequest->SetURL(url);
+  HttpRequest->SetVerb(TEXT("GET"));
+  HttpRequest->ProcessRequest();
+}
+
+} // namespace
+
 class SCreditImage : public SCompoundWidget {
 public:
   SLATE_BEGIN_ARGS(SCreditImage) {}
@@ -177,6 +247,9 @@ void UScreenCreditsWidget::OnPopupClicked() {
   _showPopup = !_showPopup;
   BackgroundBlur->SetVisibility(
       _showPopup ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
+  if (_numImagesLoading == 0) {
+    UpdateText();
+  }
 }
 
 void UScreenCreditsWidget::NativeConstruct() {
@@ -207,16 +280,12 @@ void UScreenCreditsWidget::NativeConstruct() {
   }
 }
 
-void UScreenCreditsWidget::HandleImageRequest(
-    FHttpRequestPtr HttpRequest,
-    FHttpResponsePtr HttpResponse,
-    bool bSucceeded,
+void UScreenCreditsWidget::HandleImage(
+    const TArray<uint8>* pImageData,
     int32 id) {
   UTexture2D* texture = nullptr;
-  if (bSucceeded && HttpResponse.IsValid() &&
-      HttpResponse->GetContentLength() > 0 &&
-      (texture = FImageUtils::ImportBufferAsTexture2D(
-           HttpResponse->GetContent())) != nullptr) {
+  if (pImageData && (texture = FImageUtils::ImportBufferAsTexture2D(
+                         *pImageData)) != nullptr) {
     texture->SRGB = true;
     texture->UpdateResource();
     _textures.Add(texture);
@@ -228,7 +297,7 @@ void UScreenCreditsWidget::HandleImageRequest(
   // Only update credits after all of the images are done loading.
   --_numImagesLoading;
   if (_numImagesLoading == 0) {
-    SetCredits(_credits, _onScreenCredits);
+    UpdateText();
   }
 }
 
@@ -249,18 +318,16 @@ std::string UScreenCreditsWidget::LoadImage(const std::string& url) {
     }
   } else {
     ++_numImagesLoading;
-    TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest =
-        FHttpModule::Get().CreateRequest();
-
-    _creditImages.AddDefaulted();
-    HttpRequest->OnProcessRequestComplete().BindUObject(
-        this,
-        &UScreenCreditsWidget::HandleImageRequest,
-        _creditImages.Num() - 1);
-
-    HttpRequest->SetURL(UTF8_TO_TCHAR(url.c_str()));
-    HttpRequest->SetVerb(TEXT("GET"));
-    HttpRequest->ProcessRequest();
+    const int32 id = _creditImages.AddDefaulted();
+    downloadCreditImage(
+        UTF8_TO_TCHAR(url.c_str()),
+        [pThis = TWeakObjectPtr<UScreenCreditsWidget>(this),
+         id](const TArray<uint8>* pImageData) {
+          if (pThis.IsValid()) {
+            pThis->HandleImage(pImageData, id);
+          }
+        });
+    return std::to_string(id);
   }
   return std::to_string(_creditImages.Num() - 1);
 }
@@ -268,15 +335,25 @@ std::string UScreenCreditsWidget::LoadImage(const std::string& url) {
 void UScreenCreditsWidget::SetCredits(
     const FString& InCredits,
     const FString& InOnScreenCredits) {
-  if (_numImagesLoading != 0) {
-    _credits = InCredits;
-    _onScreenCredits = InOnScreenCredits;
-    return;
+  _credits = InCredits;
+  _onScreenCredits = InOnScreenCredits;
+  if (_numImagesLoading == 0) {
+    UpdateText();
   }
-  if (RichTextPopup) {
-    RichTextPopup->SetText(FText::FromString(InCredits));
+}
+
+void UScreenCreditsWidget::UpdateText() {
+  // Setting the text of a rich text block parses and lays it out again, so
+  // it's only set when it has changed, and the popup's only while it's shown.
+  if (RichTextOnScreen && !_onScreenCredits.Equals(
+                              _onScreenCreditsShown,
+                              ESearchCase::CaseSensitive)) {
+    RichTextOnScreen->SetText(FText::FromString(_onScreenCredits));
+    _onScreenCreditsShown = _onScreenCredits;
   }
-  if (RichTextOnScreen) {
-    RichTextOnScreen->SetText(FText::FromString(InOnScreenCredits));
+  if (RichTextPopup && _showPopup &&
+      !_credits.Equals(_creditsShown, ESearchCase::CaseSensitive)) {
+    RichTextPopup->SetText(FText::FromString(_credits));
+    _creditsShown = _credits;
   }
 }
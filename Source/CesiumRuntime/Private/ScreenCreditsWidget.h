@@ -5,7 +5,6 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/RichTextBlockDecorator.h"
 #include "CoreMinimal.h"
-#include "Interfaces/IHttpRequest.h"
 #include <memory>
 #include <string>
 #include "ScreenCreditsWidget.generated.h"
@@ -31,11 +30,9 @@ private:
 
   void OnPopupClicked();
 
-  void HandleImageRequest(
-      FHttpRequestPtr HttpRequest,
-      FHttpResponsePtr HttpResponse,
-      bool bSucceeded,
-      int32 id);
+  void UpdateText();
+
+  void HandleImage(const TArray<uint8>* pImageData, int32 id);
 
   UPROPERTY(meta = (BindWidget))
   class URichTextBlock* RichTextOnScreen;
@@ -51,6 +48,9 @@ private:
 
   FString _credits = "";
   FString _onScreenCredits = "";
+  // The text last given to each rich text block.
+  FString _creditsShown = "";
+  FString _onScreenCreditsShown = "";
   bool _showPopup = false;
   class UCreditsDecorator* _decoratorOnScreen;
   class UCreditsDecorator* _decoratorPopup;
@@ -0,0 +1,150 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "Cesium3DTilesPackage.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <string>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FCesium3DTilesPackageSpec,
+    "Cesium.Unit.3DTilesPackage",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+FString filename;
+END_DEFINE_SPEC(FCesium3DTilesPackageSpec)
+
+namespace {
+
+void writeUint16(TArray<uint8>& bytes, uint16 value) {
+  bytes.Add(uint8(value));
+  bytes.Add(uint8(value >> 8));
+}
+
+void writeUint32(TArray<uint8>& bytes, uint32 value) {
+  writeUint16(bytes, uint16(value));
+  writeUint16(bytes, uint16(value >> 16));
+}
+
+void writeString(TArray<uint8>& bytes, const std::string& value) {
+  bytes.Append(reinterpret_cast<const uint8*>(value.data()), value.size());
+}
+
+/**
+ * Creates a ZIP archive with the given entries, all of them stored without
+ * compression.
+ */
+TArray<uint8> createStoredZip(
+    const std::vector<std::pair<std::string, std::string>>& entries) {
+  TArray<uint8> zip;
+  TArray<uint8> directory;
+
+  for (const auto& [name, content] : entries) {
+    const uint32 localHeaderOffset = uint32(zip.Num());
+
+    writeUint32(zip, 0x04034b50);
+    writeUint16(zip, 20);
+    writeUint16(zip, 0);
+    writeUint16(zip, 0);
+    writeUint16(zip, 0);
+    writeUint16(zip, 0);
+    writeUint32(zip, 0);
+    writeUint32(zip, uint32(content.size()));
+    writeUint32(zip, uint32(content.size()));
+    writeUint16(zip, uint16(name.size()));
+    writeUint16(zip, 0);
+    writeString(zip, name);
+    writeString(zip, content);
+
+    writeUint32(directory, 0x02014b50);
+    writeUint16(directory, 20);
+    writeUint16(directory, 20);
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint32(directory, 0);
+    writeUint32(directory, uint32(content.size()));
+    writeUint32(directory, uint32(content.size()));
+    writeUint16(directory, uint16(name.size()));
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint16(directory, 0);
+    writeUint32(directory, 0);
+    writeUint32(directory, localHeaderOffset);
+    writeString(directory, name);
+  }
+
+  const uint32 directoryOffset = uint32(zip.Num());
+  zip.Append(directory);
+
+  writeUint32(zip, 0x06054b50);
+  writeUint16(zip, 0);
+  writeUint16(zip, 0);
+  writeUint16(zip, uint16(entries.size()));
+  writeUint16(zip, uint16(entries.size()));
+  writeUint32(zip, uint32(directory.Num()));
+  writeUint32(zip, directoryOffset);
+  writeUint16(zip, 0);
+
+  return zip;
+}
+
+FString toString(const Cesium3DTilesPackage::EntryData& data) {
+  return FString(
+      int32(data.data.size()),
+      reinterpret_cast<const ANSICHAR*>(data.data.data()));
+}
+
+} // namespace
+
+void FCesium3DTilesPackageSpec::Define() {
+  BeforeEach([this]() {
+    filename = FPaths::CreateTempFilename(
+        *FPaths::ProjectIntermediateDir(),
+        TEXT("CesiumPackage"),
+        TEXT(".3tz"));
+  });
+
+  AfterEach([this]() { IFileManager::Get().Delete(*filename); });
+
+  It("reads stored entries by path", [this]() {
+    TArray<uint8> zip = createStoredZip(
+        {{"tileset.json", "{\"asset\":{\"version\":\"1.1\"}}"},
+         {"tiles/0/0/0.glb", "glTF"}});
+    TestTrue("save", FFileHelper::SaveArrayToFile(zip, *filename));
+
+    std::shared_ptr<Cesium3DTilesPackage> pPackage =
+        Cesium3DTilesPackage::open(filename);
+    if (!TestNotNull("pPackage", pPackage.get())) {
+      return;
+    }
+
+    TestEqual("entry count", int32(pPackage->getEntryCount()), 2);
+
+    Cesium3DTilesPackage::EntryData tileset;
+    TestTrue("read tileset.json", pPackage->read("tileset.json", tileset));
+    TestEqual(
+        "tileset.json",
+        toString(tileset),
+        FString(TEXT("{\"asset\":{\"version\":\"1.1\"}}")));
+
+    Cesium3DTilesPackage::EntryData tile;
+    TestTrue("read tile", pPackage->read("tiles/0/0/0.glb", tile));
+    TestEqual("tile", toString(tile), FString(TEXT("glTF")));
+
+    Cesium3DTilesPackage::EntryData missing;
+    TestFalse("read missing", pPackage->read("missing.glb", missing));
+  });
+
+  It("rejects a file that is not a ZIP archive", [this]() {
+    TestTrue(
+        "save",
+        FFileHelper::SaveStringToFile(TEXT("not a zip file"), *filename));
+    AddExpectedError(TEXT("is not a valid ZIP archive"));
+    TestNull("pPackage", Cesium3DTilesPackage::open(filename).get());
+  });
+}
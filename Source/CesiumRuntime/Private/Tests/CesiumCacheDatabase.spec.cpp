@@ -0,0 +1,64 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCacheDatabase.h"
+#include "CesiumTestHelpers.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+using CesiumTestHelpers::TestCacheDatabase;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCacheDatabaseSpec,
+    "Cesium.Unit.CacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+FString indexFilename;
+END_DEFINE_SPEC(FCesiumCacheDatabaseSpec)
+
+void FCesiumCacheDatabaseSpec::Define() {
+  BeforeEach([this]() {
+    indexFilename = FPaths::CreateTempFilename(
+        *FPaths::ProjectIntermediateDir(),
+        TEXT("CesiumCacheIndex"));
+  });
+
+  AfterEach([this]() { IFileManager::Get().Delete(*indexFilename); });
+
+  It("evicts large entries first to stay within the byte budget", [this]() {
+    auto pInner = std::make_shared<TestCacheDatabase>();
+    auto pDatabase =
+        std::make_shared<CesiumCacheDatabase>(pInner, 30000, indexFilename);
+
+    CesiumTestHelpers::storeTestEntry(*pDatabase, "small.json", 1000);
+    CesiumTestHelpers::storeTestEntry(*pDatabase, "large.glb", 20000);
+    CesiumTestHelpers::storeTestEntry(*pDatabase, "medium.glb", 10000);
+
+    pDatabase->pruneNow();
+
+    TestTrue("within budget", pDatabase->getSizeBytes() <= 30000);
+    const TestCacheDatabase::Entry& large = pInner->entries["large.glb"];
+    TestEqual("large expired", large.expiryTime, std::time_t(0));
+    TestEqual("large emptied", large.data.size(), size_t(0));
+
+    const TestCacheDatabase::Entry& small = pInner->entries["small.json"];
+    const TestCacheDatabase::Entry& medium = pInner->entries["medium.glb"];
+    TestNotEqual("small kept", small.expiryTime, std::time_t(0));
+    TestNotEqual("medium kept", medium.expiryTime, std::time_t(0));
+    TestEqual("pruneCount", pInner->pruneCount, 1);
+  });
+
+  It("keeps its index across instances", [this]() {
+    auto pInner = std::make_shared<TestCacheDatabase>();
+    {
+      auto pDatabase =
+          std::make_shared<CesiumCacheDatabase>(pInner, 0, indexFilename);
+      CesiumTestHelpers::storeTestEntry(*pDatabase, "a.glb", 5000);
+      pDatabase->pruneNow();
+    }
+
+    auto pDatabase =
+        std::make_shared<CesiumCacheDatabase>(pInner, 0, indexFilename);
+    TestTrue("size", pDatabase->getSizeBytes() >= 5000);
+  });
+}
@@ -0,0 +1,100 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumCancellableAssetAccessor.h"
+#include "CesiumRuntime.h"
+#include "Misc/AutomationTest.h"
+#include <optional>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCancellableAssetAccessorSpec,
+    "Cesium.Unit.CancellableAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumCancellableAssetAccessorSpec)
+
+namespace {
+
+using RequestPromise =
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+/**
+ * Never answers a request by itself. The promises of the requests are kept,
+ * so that the test can answer them.
+ */
+class PendingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  std::vector<RequestPromise> promises;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    RequestPromise promise = asyncSystem.createPromise<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>();
+    this->promises.emplace_back(promise);
+    return promise.getFuture();
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+// Waits for a request, and determines whether it failed.
+bool fails(
+    CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>&&
+        request) {
+  try {
+    std::move(request).wait();
+    return false;
+  } catch (const std::exception&) {
+    return true;
+  }
+}
+
+} // namespace
+
+void FCesiumCancellableAssetAccessorSpec::Define() {
+  It("rejects the requests in flight when cancelled", [this]() {
+    auto pPending = std::make_shared<PendingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumCancellableAssetAccessor>(pPending);
+
+    auto request =
+        pAccessor->get(getAsyncSystem(), "https://example.com/a", {});
+    TestFalse("cancelled", pAccessor->isCancelled());
+
+    pAccessor->cancel();
+    TestTrue("cancelled after cancel", pAccessor->isCancelled());
+    TestTrue("in flight fails", fails(std::move(request)));
+
+    // The response that comes after the cancellation is dropped.
+    pPending->promises[0].resolve(nullptr);
+
+    TestTrue(
+        "later request fails",
+        fails(pAccessor->get(getAsyncSystem(), "https://example.com/b", {})));
+    TestEqual("requests sent", int32(pPending->promises.size()), 1);
+  });
+
+  It("passes responses through until cancelled", [this]() {
+    auto pPending = std::make_shared<PendingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumCancellableAssetAccessor>(pPending);
+
+    auto request =
+        pAccessor->get(getAsyncSystem(), "https://example.com/a", {});
+    pPending->promises[0].resolve(nullptr);
+    TestFalse("succeeds", fails(std::move(request)));
+  });
+}
@@ -0,0 +1,88 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCoroutine.h"
+#include "Misc/AutomationTest.h"
+
+#if CESIUM_HAS_COROUTINES
+
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumRuntime.h"
+#include <stdexcept>
+
+using namespace CesiumCoroutine;
+
+namespace {
+
+Task<int32> one() { co_return 1; }
+
+Task<int32> sumOfOnes(int32 count) {
+  int32 sum = 0;
+  for (int32 i = 0; i < count; ++i) {
+    sum += co_await one();
+  }
+  co_return sum;
+}
+
+Task<int32> fail() {
+  throw std::runtime_error("failed");
+  co_return 0;
+}
+
+Task<bool> catchFailure() {
+  try {
+    co_await fail();
+  } catch (const std::runtime_error&) {
+    co_return true;
+  }
+  co_return false;
+}
+
+Task<int32> sumInWorkerThread() {
+  co_await resumeInWorkerThread();
+  if (IsInGameThread()) {
+    co_return -1;
+  }
+  co_return co_await sumOfOnes(3);
+}
+
+} // namespace
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCoroutineSpec,
+    "Cesium.Unit.Coroutine",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumCoroutineSpec)
+
+void FCesiumCoroutineSpec::Define() {
+  It("resumes awaiting coroutines without growing the stack", [this]() {
+    const int32 count = 1000000;
+    TestEqual(
+        "sum",
+        toFuture(getAsyncSystem(), sumOfOnes(count)).wait(),
+        count);
+  });
+
+  It("passes exceptions to the awaiting coroutine", [this]() {
+    TestTrue("caught", toFuture(getAsyncSystem(), catchFailure()).wait());
+  });
+
+  It("rejects the future of a coroutine that throws", [this]() {
+    bool rejected = false;
+    try {
+      toFuture(getAsyncSystem(), fail()).wait();
+    } catch (const std::exception&) {
+      rejected = true;
+    }
+    TestTrue("rejected", rejected);
+  });
+
+  It("continues in a worker thread", [this]() {
+    TestEqual(
+        "sum",
+        toFuture(getAsyncSystem(), sumInWorkerThread()).wait(),
+        3);
+  });
+}
+
+#endif
@@ -0,0 +1,40 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumDeferredCacheDatabase.h"
+#include "CesiumTestHelpers.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include <atomic>
+
+using CesiumTestHelpers::TestCacheDatabase;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumDeferredCacheDatabaseSpec,
+    "Cesium.Unit.DeferredCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumDeferredCacheDatabaseSpec)
+
+void FCesiumDeferredCacheDatabaseSpec::Define() {
+  It("waits for the database to be created", [this]() {
+    std::atomic<bool> canCreate(false);
+    auto pDatabase = std::make_shared<TestCacheDatabase>();
+    CesiumDeferredCacheDatabase deferred([&canCreate, pDatabase]() {
+      while (!canCreate) {
+        FPlatformProcess::Sleep(0.001f);
+      }
+      return std::shared_ptr<CesiumAsync::ICacheDatabase>(pDatabase);
+    });
+    TestFalse("ready", deferred.isReady());
+
+    canCreate = true;
+    CesiumTestHelpers::storeTestEntry(deferred, "a", 16);
+    TestTrue("ready after call", deferred.isReady());
+    TestEqual("stored", pDatabase->entries.size(), size_t(1));
+
+    std::optional<CesiumAsync::CacheItem> item = deferred.getEntry("a");
+    TestTrue("found", item.has_value());
+    TestFalse("missing", deferred.getEntry("b").has_value());
+  });
+}
@@ -0,0 +1,65 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumEncodedFeaturesMetadata;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumEncodedFeaturesMetadataSpec,
+    "Cesium.Unit.EncodedFeaturesMetadata",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumEncodedFeaturesMetadataSpec)
+
+void FCesiumEncodedFeaturesMetadataSpec::Define() {
+  Describe("DescriptionsByName", [this]() {
+    It("finds descriptions by name", [this]() {
+      TArray<FCesiumFeatureIdSetDescription> descriptions;
+      descriptions.Emplace_GetRef().Name = TEXT("first");
+      descriptions.Emplace_GetRef().Name = TEXT("second");
+
+      DescriptionsByName<FCesiumFeatureIdSetDescription> index(descriptions);
+      TestEqual("first", index.find(TEXT("first")), &descriptions[0]);
+      TestEqual("second", index.find(TEXT("second")), &descriptions[1]);
+      TestNull("missing", index.find(TEXT("third")));
+    });
+
+    It("finds the first of several descriptions with a name", [this]() {
+      TArray<FCesiumFeatureIdSetDescription> descriptions;
+      descriptions.Emplace_GetRef().Name = TEXT("name");
+      descriptions.Emplace_GetRef().Name = TEXT("NAME");
+
+      DescriptionsByName<FCesiumFeatureIdSetDescription> index(descriptions);
+      TestEqual("found", index.find(TEXT("Name")), &descriptions[0]);
+    });
+  });
+
+  Describe("IndexedFeaturesMetadataDescription", [this]() {
+    It("indexes the property tables and their properties", [this]() {
+      FCesiumFeaturesMetadataDescription description;
+      FCesiumPropertyTableDescription& propertyTable =
+          description.ModelMetadata.PropertyTables.Emplace_GetRef();
+      propertyTable.Name = TEXT("table");
+      propertyTable.Properties.Emplace_GetRef().Name = TEXT("property");
+
+      IndexedFeaturesMetadataDescription indexed(MoveTemp(description));
+      const FCesiumPropertyTableDescription& indexedTable =
+          indexed.getDescription().ModelMetadata.PropertyTables[0];
+
+      const PropertyTableDescriptionIndex* pTable =
+          indexed.getModelMetadata().findPropertyTable(TEXT("table"));
+      if (!TestNotNull("table", pTable)) {
+        return;
+      }
+      TestEqual("description", pTable->pDescription, &indexedTable);
+      TestEqual(
+          "property",
+          pTable->properties.find(TEXT("property")),
+          &indexedTable.Properties[0]);
+      TestNull(
+          "missing table",
+          indexed.getModelMetadata().findPropertyTable(TEXT("other")));
+    });
+  });
+}
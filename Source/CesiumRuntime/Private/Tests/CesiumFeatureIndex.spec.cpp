@@ -0,0 +1,76 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureIndex.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPrimitiveFeatures.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFeatureIndexSpec,
+    "Cesium.Unit.FeatureIndex",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+MeshPrimitive* pPrimitive;
+ExtensionExtMeshFeatures* pExtension;
+END_DEFINE_SPEC(FCesiumFeatureIndexSpec)
+
+void FCesiumFeatureIndexSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    Mesh& mesh = model.meshes.emplace_back();
+    pPrimitive = &mesh.primitives.emplace_back();
+    pExtension = &pPrimitive->addExtension<ExtensionExtMeshFeatures>();
+  });
+
+  It("indexes the faces and bounds of features", [this]() {
+    // Features 0, 1, 0 for the three faces.
+    std::vector<uint8_t> attributeIDs{0, 0, 0, 1, 1, 1, 0, 0, 0};
+    AddFeatureIDsAsAttributeToModel(model, *pPrimitive, attributeIDs, 2, 0);
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.count = 9;
+    pPrimitive->attributes.insert(
+        {"POSITION", static_cast<int32_t>(model.accessors.size() - 1)});
+
+    FCesiumPrimitiveFeatures features(model, *pPrimitive, *pExtension);
+
+    TArray<FVector3f> positions;
+    TArray<uint32> indices;
+    for (int32 i = 0; i < 9; ++i) {
+      positions.Emplace(float(i), 0.0f, float(i % 3));
+      indices.Add(i);
+    }
+
+    TSharedPtr<const CesiumFeatureIndex> pIndex =
+        CesiumFeatureIndex::build(features, positions, indices);
+    if (!TestTrue("built", pIndex.IsValid())) {
+      return;
+    }
+
+    const CesiumFeatureIndex::Feature* pFeature = pIndex->find(0, 0);
+    if (!TestNotNull("feature 0", pFeature)) {
+      return;
+    }
+    TArrayView<const CesiumFeatureIndex::FaceRange> ranges =
+        pIndex->getFaceRanges(*pFeature);
+    if (TestEqual("ranges", ranges.Num(), 2)) {
+      TestEqual("first face", ranges[0].firstFace, 0);
+      TestEqual("second face", ranges[1].firstFace, 2);
+    }
+    TestEqual("minimum", pFeature->bounds.Min, FVector3f(0.0f, 0.0f, 0.0f));
+    TestEqual("maximum", pFeature->bounds.Max, FVector3f(8.0f, 0.0f, 2.0f));
+
+    pFeature = pIndex->find(0, 1);
+    if (TestNotNull("feature 1", pFeature)) {
+      TestEqual("faces", pIndex->getFaceRanges(*pFeature).Num(), 1);
+      TestEqual("bounds", pFeature->bounds.Min.X, 3.0f);
+    }
+
+    TestNull("missing feature", pIndex->find(0, 2));
+    TestNull("missing feature ID set", pIndex->find(1, 0));
+  });
+}
@@ -0,0 +1,109 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumFeatureStyleExpression.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFeatureStyleExpressionSpec,
+    "Cesium.Unit.FeatureStyleExpression",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+using Value = CesiumFeatureStyleExpression::Value;
+
+Value evaluate(const FString& source, const TArray<Value>& values = {}) {
+  TArray<FString> variables;
+  FString error;
+  TSharedPtr<const CesiumFeatureStyleExpression> pExpression =
+      CesiumFeatureStyleExpression::parse(source, variables, error);
+  if (!pExpression) {
+    AddError(FString::Printf(TEXT("%s: %s"), *source, *error));
+    return Value();
+  }
+
+  return pExpression->evaluate([&values](int32 variable) {
+    return values.IsValidIndex(variable) ? values[variable] : Value();
+  });
+}
+END_DEFINE_SPEC(FCesiumFeatureStyleExpressionSpec)
+
+void FCesiumFeatureStyleExpressionSpec::Define() {
+  Describe("parse", [this]() {
+    It("collects the variables of expressions", [this]() {
+      TArray<FString> variables;
+      FString error;
+      TestTrue(
+          "first",
+          CesiumFeatureStyleExpression::parse(
+              TEXT("${height} > ${minimum}"),
+              variables,
+              error)
+              .IsValid());
+      TestTrue(
+          "second",
+          CesiumFeatureStyleExpression::parse(
+              TEXT("${height} * 2"),
+              variables,
+              error)
+              .IsValid());
+      TestEqual("variables", variables, TArray<FString>{"height", "minimum"});
+    });
+
+    It("rejects invalid expressions", [this]() {
+      TArray<FString> variables;
+      FString error;
+      TestFalse(
+          "unbalanced",
+          CesiumFeatureStyleExpression::parse(
+              TEXT("(${a} + 1"),
+              variables,
+              error)
+              .IsValid());
+      TestFalse("error", error.IsEmpty());
+      TestFalse(
+          "unknown function",
+          CesiumFeatureStyleExpression::parse(
+              TEXT("${b} + sqrt(2)"),
+              variables,
+              error)
+              .IsValid());
+      TestTrue("no variables added", variables.IsEmpty());
+    });
+  });
+
+  Describe("evaluate", [this]() {
+    It("follows operator precedence", [this]() {
+      TestTrue("arithmetic", evaluate(TEXT("1 + 2 * 3 - 4")) == Value(3.0));
+      TestTrue(
+          "logic",
+          evaluate(TEXT("1 < 2 && 3 >= 4 || !false")) == Value(true));
+      TestTrue(
+          "conditional",
+          evaluate(TEXT("${a} > 10 ? 'tall' : 'short'"), {15.0}) ==
+              Value(FString(TEXT("tall"))));
+    });
+
+    It("compares values strictly", [this]() {
+      TestTrue(
+          "strings",
+          evaluate(TEXT("${name} === 'tower'"), {FString(TEXT("tower"))}) ==
+              Value(true));
+      TestTrue("mixed types", evaluate(TEXT("1 == '1'")) == Value(false));
+      TestTrue("undefined", evaluate(TEXT("${missing} + 1")) == Value());
+    });
+
+    It("creates colors", [this]() {
+      TestTrue(
+          "named",
+          evaluate(TEXT("color('red', 0.5)")) ==
+              Value(FLinearColor(1.0f, 0.0f, 0.0f, 0.5f)));
+      TestTrue(
+          "hex",
+          evaluate(TEXT("color('#00f')")) ==
+              Value(FLinearColor(0.0f, 0.0f, 1.0f)));
+      TestTrue(
+          "rgba",
+          evaluate(TEXT("rgba(0, 255, 0, 1)")) ==
+              Value(FLinearColor(0.0f, 1.0f, 0.0f)));
+    });
+  });
+}
@@ -0,0 +1,46 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGaussianSplats.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumGaussianSplatsSpec,
+    "Cesium.Unit.GaussianSplats",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumGaussianSplatsSpec)
+
+void FCesiumGaussianSplatsSpec::Define() {
+  Describe("packSplat", [this]() {
+    It("packs the squared scales of an unrotated splat", [this]() {
+      FVector4f packed[CesiumGaussianSplats::Float4sPerSplat];
+      CesiumGaussianSplats::packSplat(
+          FVector3f(1.0f, 2.0f, 3.0f),
+          FVector3f(1.0f, 2.0f, 3.0f),
+          FVector4f(0.0f, 0.0f, 0.0f, 1.0f),
+          FColor(255, 0, 0, 51),
+          packed);
+
+      TestTrue("position", packed[0].Equals(FVector4f(1.0f, 2.0f, 3.0f, 0.2f)));
+      TestTrue("XX, XY, XZ, YY", packed[1].Equals(FVector4f(1.0f, 0, 0, 4.0f)));
+      TestTrue("YZ", FMath::IsNearlyZero(packed[2].X));
+      TestTrue("ZZ", FMath::IsNearlyEqual(packed[2].Y, 9.0f));
+    });
+
+    It("negates the covariance that mixes Y with another axis", [this]() {
+      // A rotation of 45 degrees around Z.
+      const float halfAngle = FMath::DegreesToRadians(22.5f);
+      FVector4f packed[CesiumGaussianSplats::Float4sPerSplat];
+      CesiumGaussianSplats::packSplat(
+          FVector3f(0.0f),
+          FVector3f(2.0f, 1.0f, 1.0f),
+          FVector4f(0.0f, 0.0f, FMath::Sin(halfAngle), FMath::Cos(halfAngle)),
+          FColor::White,
+          packed);
+
+      TestTrue("XX", FMath::IsNearlyEqual(packed[1].X, 2.5f, 1e-5f));
+      TestTrue("XY", FMath::IsNearlyEqual(packed[1].Y, -1.5f, 1e-5f));
+      TestTrue("YY", FMath::IsNearlyEqual(packed[1].W, 2.5f, 1e-5f));
+    });
+  });
+}
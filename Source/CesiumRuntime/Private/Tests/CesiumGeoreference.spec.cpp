@@ -112,6 +112,61 @@ void FCesiumGeoreferenceSpec::Define() {
     });
   });
 
+  Describe("Batch Position Transformation", [this]() {
+    It("matches the single position transforms", [this]() {
+      TArray<FVector> llhs;
+      for (int32 i = 0; i < 3000; ++i) {
+        llhs.Emplace(-180.0 + 0.1 * i, -80.0 + 0.05 * i, double(i % 100));
+      }
+
+      TArray<FVector> unrealPositions;
+      pGeoreference90Longitude
+          ->TransformLongitudeLatitudeHeightPositionsToUnreal(
+              llhs,
+              unrealPositions);
+      TArray<FVector> ecefs;
+      pGeoreference90Longitude
+          ->TransformUnrealPositionsToEarthCenteredEarthFixed(
+              unrealPositions,
+              ecefs);
+      TArray<FVector> roundTrip;
+      pGeoreference90Longitude
+          ->TransformUnrealPositionsToLongitudeLatitudeHeight(
+              unrealPositions,
+              roundTrip);
+      TestEqual("unrealPositions", unrealPositions.Num(), llhs.Num());
+      TestEqual("ecefs", ecefs.Num(), llhs.Num());
+      TestEqual("roundTrip", roundTrip.Num(), llhs.Num());
+
+      for (int32 i = 0; i < llhs.Num(); ++i) {
+        const FVector expectedUnreal =
+            pGeoreference90Longitude
+                ->TransformLongitudeLatitudeHeightPositionToUnreal(llhs[i]);
+        TestTrue(
+            "unrealPosition",
+            unrealPositions[i].Equals(expectedUnreal, 1e-6));
+        TestTrue(
+            "ecef",
+            ecefs[i].Equals(
+                pGeoreference90Longitude
+                    ->TransformUnrealPositionToEarthCenteredEarthFixed(
+                        expectedUnreal),
+                1e-6));
+        TestTrue("roundTrip", roundTrip[i].Equals(llhs[i], 1e-6));
+      }
+
+      // Transforming in place gives the same result.
+      TArray<FVector> inPlace = ecefs;
+      pGeoreference90Longitude
+          ->TransformEarthCenteredEarthFixedPositionsToUnreal(
+              TArrayView<const FVector>(inPlace),
+              TArrayView<FVector>(inPlace));
+      for (int32 i = 0; i < inPlace.Num(); ++i) {
+        TestTrue("inPlace", inPlace[i].Equals(unrealPositions[i], 1e-3));
+      }
+    });
+  });
+
   Describe("Direction Transformation", [this]() {
     It("transforms Earth-Centered, Earth-Fixed directions to Unreal", [this]() {
       FVector northAtNullIslandUnreal =
@@ -2,6 +2,7 @@
 
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
+#include "CesiumGlobeAnchorSubsystem.h"
 #include "CesiumTestHelpers.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Misc/AutomationTest.h"
@@ -94,6 +95,41 @@ void FCesiumGlobeAnchorSpec::Define() {
         beforeLLH);
   });
 
+  It("batches globe position updates from actor transform changes", [this]() {
+    this->pGlobeAnchor->SetBatchTransformChanges(true);
+    UCesiumGlobeAnchorSubsystem* pSubsystem =
+        this->pActor->GetWorld()->GetSubsystem<UCesiumGlobeAnchorSubsystem>();
+    TestNotNull("subsystem", pSubsystem);
+
+    ACesiumGeoreference* pGeoreference =
+        this->pGlobeAnchor->GetResolvedGeoreference();
+    const FVector targetLLH(90.0, 2.0, 3.0);
+    FRotator beforeRotation = this->pActor->GetActorRotation();
+    this->pActor->SetActorLocation(
+        pGeoreference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            targetLLH));
+
+    // The change is queued, so the orientation isn't adjusted yet.
+    TestEqual("rotation", this->pActor->GetActorRotation(), beforeRotation);
+
+    pSubsystem->ProcessTransformChanges();
+    TestNotEqual("rotation", this->pActor->GetActorRotation(), beforeRotation);
+    TestTrue(
+        "globe position",
+        this->pGlobeAnchor->GetLongitudeLatitudeHeight().Equals(
+            targetLLH,
+            1e-6));
+
+    // Reading the globe position processes a queued change immediately.
+    this->pActor->SetActorLocation(FVector(1000.0, 2000.0, 3000.0));
+    TestTrue(
+        "globe position after read",
+        this->pGlobeAnchor->GetEarthCenteredEarthFixedPosition().Equals(
+            pGeoreference->TransformUnrealPositionToEarthCenteredEarthFixed(
+                FVector(1000.0, 2000.0, 3000.0)),
+            1e-6));
+  });
+
   It("allows the actor transform to be set when not registered", [this]() {
     FVector beforeLLH = this->pGlobeAnchor->GetLongitudeLatitudeHeight();
 
@@ -0,0 +1,89 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfBufferRelease.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumGltfBufferReleaseSpec,
+    "Cesium.Unit.GltfBufferRelease",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+END_DEFINE_SPEC(FCesiumGltfBufferReleaseSpec)
+
+void FCesiumGltfBufferReleaseSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    MeshPrimitive& primitive =
+        model.meshes.emplace_back().primitives.emplace_back();
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "POSITION",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        std::vector<glm::vec3>{
+            glm::vec3(0.0f, 0.0f, 0.0f),
+            glm::vec3(1.0f, 0.0f, 0.0f),
+            glm::vec3(0.0f, 1.0f, 0.0f)});
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "NORMAL",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        std::vector<glm::vec3>(3, glm::vec3(0.0f, 0.0f, 1.0f)));
+    CreateIndicesForPrimitive(
+        model,
+        primitive,
+        AccessorSpec::ComponentType::UNSIGNED_SHORT,
+        std::vector<uint16_t>{0, 1, 2});
+  });
+
+  It("keeps only the positions and indices", [this]() {
+    const int64 released = CesiumGltfBufferRelease::release(model, true);
+    TestTrue("released", released > 0);
+    TestEqual("buffers", model.buffers.size(), size_t(1));
+
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    TestEqual("positions", positions.status(), AccessorViewStatus::Valid);
+    TestEqual("position", positions[1], glm::vec3(1.0f, 0.0f, 0.0f));
+
+    AccessorView<uint16_t> indices(model, primitive.indices);
+    TestEqual("indices", indices.status(), AccessorViewStatus::Valid);
+    TestEqual("index", indices[2], uint16_t(2));
+
+    AccessorView<glm::vec3> normals(model, primitive.attributes.at("NORMAL"));
+    TestNotEqual("normals", normals.status(), AccessorViewStatus::Valid);
+  });
+
+  It("keeps nothing without picking data", [this]() {
+    CesiumGltfBufferRelease::release(model, false);
+    TestEqual("buffers", model.buffers.size(), size_t(0));
+
+    const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    TestNotEqual("positions", positions.status(), AccessorViewStatus::Valid);
+  });
+
+  It("doesn't release models with overlay texture coordinates", [this]() {
+    TestTrue("before", CesiumGltfBufferRelease::canRelease(model));
+    CreateAttributeForPrimitive(
+        model,
+        model.meshes[0].primitives[0],
+        "_CESIUMOVERLAY_0",
+        AccessorSpec::Type::VEC2,
+        AccessorSpec::ComponentType::FLOAT,
+        std::vector<glm::vec2>(3, glm::vec2(0.0f)));
+    TestFalse("after", CesiumGltfBufferRelease::canRelease(model));
+  });
+}
@@ -0,0 +1,306 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumEncodedFeaturesMetadata.h"
+#include "CesiumGltf/ExtensionModelExtStructuralMetadata.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPhysicsMeshes.h"
+#include "CesiumPropertyTable.h"
+#include "CreateGltfOptions.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_precision.hpp>
+#include <vector>
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumGltfConversionBenchmarksSpec,
+    "Cesium.Performance.GltfConversion",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+END_DEFINE_SPEC(FCesiumGltfConversionBenchmarksSpec)
+
+namespace {
+
+// The number of vertices along each side of the grids that are converted.
+constexpr int32 gridSizes[] = {32, 128, 512};
+
+// Each stage is timed this many times, and the fastest time is reported.
+constexpr int32 repetitions = 5;
+
+struct GridAttributes {
+  bool normals = true;
+  bool texCoords = false;
+  bool colors = false;
+};
+
+/**
+ * Creates a model with one primitive, a rippled square grid of `size` by
+ * `size` vertices, with the given attributes.
+ */
+Model createGridModel(int32 size, const GridAttributes& attributes) {
+  Model model;
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::TRIANGLES;
+
+  const size_t vertexCount = size_t(size) * size_t(size);
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec2> texCoords;
+  std::vector<glm::vec4> colors;
+  positions.reserve(vertexCount);
+  normals.reserve(vertexCount);
+  texCoords.reserve(vertexCount);
+  colors.reserve(vertexCount);
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      const float u = float(x) / float(size - 1);
+      const float v = float(y) / float(size - 1);
+      positions.emplace_back(
+          u * 100.0f,
+          v * 100.0f,
+          std::sin(u * 20.0f) * std::cos(v * 20.0f));
+      normals.emplace_back(0.0f, 0.0f, 1.0f);
+      texCoords.emplace_back(u, v);
+      colors.emplace_back(u, v, 1.0f - u, 1.0f);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  indices.reserve(size_t(size - 1) * size_t(size - 1) * 6);
+  for (int32 y = 0; y + 1 < size; ++y) {
+    for (int32 x = 0; x + 1 < size; ++x) {
+      const uint32_t i = uint32_t(y * size + x);
+      const uint32_t below = i + uint32_t(size);
+      indices.insert(indices.end(), {i, i + 1, below, i + 1, below + 1, below});
+    }
+  }
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  if (attributes.normals) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "NORMAL",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        normals);
+  }
+  if (attributes.texCoords) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "TEXCOORD_0",
+        AccessorSpec::Type::VEC2,
+        AccessorSpec::ComponentType::FLOAT,
+        texCoords);
+  }
+  if (attributes.colors) {
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "COLOR_0",
+        AccessorSpec::Type::VEC4,
+        AccessorSpec::ComponentType::FLOAT,
+        colors);
+  }
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_INT,
+      indices);
+
+  return model;
+}
+
+// Runs the function the given number of times, and returns the fastest time,
+// in milliseconds.
+template <typename Func> double time(Func&& f) {
+  double best = TNumericLimits<double>::Max();
+  for (int32 i = 0; i < repetitions; ++i) {
+    const double start = FPlatformTime::Seconds();
+    f();
+    best = std::min(best, (FPlatformTime::Seconds() - start) * 1000.0);
+  }
+  return best;
+}
+
+// The time, in milliseconds, to convert a model on a worker thread, without
+// physics meshes.
+double timeConversion(
+    const GridAttributes& attributes,
+    int32 size,
+    bool alwaysIncludeTangents = false) {
+  double best = TNumericLimits<double>::Max();
+  for (int32 i = 0; i < repetitions; ++i) {
+    // The conversion may change the model, so each run converts a new one.
+    Model model = createGridModel(size, attributes);
+    CreateGltfOptions::CreateModelOptions options;
+    options.pModel = &model;
+    options.createPhysicsMeshes = false;
+    options.alwaysIncludeTangents = alwaysIncludeTangents;
+    const double start = FPlatformTime::Seconds();
+    UCesiumGltfComponent::CreateOffGameThread(glm::dmat4(1.0), options);
+    best = std::min(best, (FPlatformTime::Seconds() - start) * 1000.0);
+  }
+  return best;
+}
+
+double millionsPerSecond(int64 count, double milliseconds) {
+  return milliseconds > 0.0 ? double(count) / (milliseconds * 1000.0) : 0.0;
+}
+
+} // namespace
+
+void FCesiumGltfConversionBenchmarksSpec::Define() {
+  It("reports the throughput of each conversion stage", [this]() {
+    for (int32 size : gridSizes) {
+      const int64 vertexCount = int64(size) * size;
+
+      // Every stage is measured as the extra time it adds to the conversion
+      // of a grid with normals, and nothing else to compute.
+      const double baseline = timeConversion(GridAttributes(), size);
+
+      GridAttributes withoutNormals;
+      withoutNormals.normals = false;
+      const double flatNormals =
+          std::max(timeConversion(withoutNormals, size) - baseline, 0.0);
+
+      GridAttributes withTexCoords;
+      withTexCoords.texCoords = true;
+      const double tangents = std::max(
+          timeConversion(withTexCoords, size, true) -
+              timeConversion(withTexCoords, size),
+          0.0);
+
+      GridAttributes withColors;
+      withColors.colors = true;
+      const double colors =
+          std::max(timeConversion(withColors, size) - baseline, 0.0);
+
+      Model model = createGridModel(size, GridAttributes());
+      const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+      const AccessorView<FVector3f> positionView(
+          model,
+          primitive.attributes.at("POSITION"));
+      const AccessorView<uint32_t> indexView(model, primitive.indices);
+      TArray<FVector3f> positions;
+      positions.Reserve(int32(positionView.size()));
+      for (int64 i = 0; i < positionView.size(); ++i) {
+        positions.Add(positionView[i]);
+      }
+      TArray<uint32> indices;
+      indices.Reserve(int32(indexView.size()));
+      for (int64 i = 0; i < indexView.size(); ++i) {
+        indices.Add(indexView[i]);
+      }
+      CesiumPhysicsMeshes::MeshPointer pMesh;
+      const double physics = time(
+          [&]() { pMesh = CesiumPhysicsMeshes::build(positions, indices); });
+      TestTrue("physics mesh", pMesh.IsValid());
+
+      AddInfo(FString::Printf(
+          TEXT(
+              "%lld vertices: conversion %.3fms (%.2fM vertices/s), flat normals %.3fms (%.2fM/s), tangent space %.3fms (%.2fM/s), colors %.3fms (%.2fM/s), physics mesh %.3fms (%.2fM/s)"),
+          vertexCount,
+          baseline,
+          millionsPerSecond(vertexCount, baseline),
+          flatNormals,
+          millionsPerSecond(vertexCount, flatNormals),
+          tangents,
+          millionsPerSecond(vertexCount, tangents),
+          colors,
+          millionsPerSecond(vertexCount, colors),
+          physics,
+          millionsPerSecond(vertexCount, physics)));
+    }
+  });
+
+  It("reports the throughput of property table encoding", [this]() {
+    for (int32 featureCount : {1000, 100000, 1000000}) {
+      Model model;
+      ExtensionModelExtStructuralMetadata& extension =
+          model.addExtension<ExtensionModelExtStructuralMetadata>();
+      extension.schema.emplace();
+      PropertyTable& gltfPropertyTable =
+          extension.propertyTables.emplace_back();
+      gltfPropertyTable.classProperty = "buildings";
+      gltfPropertyTable.count = featureCount;
+
+      std::vector<float> heights(size_t(featureCount));
+      std::vector<glm::u8vec3> colors(size_t(featureCount));
+      for (int32 i = 0; i < featureCount; ++i) {
+        heights[i] = float(i % 200);
+        colors[i] = glm::u8vec3(uint8(i), uint8(i >> 8), uint8(i >> 16));
+      }
+      AddPropertyTablePropertyToModel(
+          model,
+          gltfPropertyTable,
+          "height",
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::FLOAT32,
+          heights);
+      AddPropertyTablePropertyToModel(
+          model,
+          gltfPropertyTable,
+          "color",
+          ClassProperty::Type::VEC3,
+          ClassProperty::ComponentType::UINT8,
+          colors);
+
+      FCesiumPropertyTableDescription description;
+      description.Name = TEXT("buildings");
+      FCesiumPropertyTablePropertyDescription& height =
+          description.Properties.Emplace_GetRef();
+      height.Name = TEXT("height");
+      height.PropertyDetails = FCesiumMetadataPropertyDetails(
+          ECesiumMetadataType::Scalar,
+          ECesiumMetadataComponentType::Float32,
+          false);
+      height.EncodingDetails = FCesiumMetadataEncodingDetails(
+          ECesiumEncodedMetadataType::Scalar,
+          ECesiumEncodedMetadataComponentType::Float,
+          ECesiumEncodedMetadataConversion::Coerce);
+      FCesiumPropertyTablePropertyDescription& color =
+          description.Properties.Emplace_GetRef();
+      color.Name = TEXT("color");
+      color.PropertyDetails = FCesiumMetadataPropertyDetails(
+          ECesiumMetadataType::Vec3,
+          ECesiumMetadataComponentType::Uint8,
+          false);
+      color.EncodingDetails = FCesiumMetadataEncodingDetails(
+          ECesiumEncodedMetadataType::Vec3,
+          ECesiumEncodedMetadataComponentType::Uint8,
+          ECesiumEncodedMetadataConversion::Coerce);
+
+      const FCesiumPropertyTable propertyTable(model, gltfPropertyTable);
+      int32 encodedCount = 0;
+      const double encoding = time([&]() {
+        CesiumEncodedFeaturesMetadata::EncodedPropertyTable encoded =
+            CesiumEncodedFeaturesMetadata::encodePropertyTableAnyThreadPart(
+                description,
+                propertyTable);
+        encodedCount = encoded.properties.Num();
+      });
+      TestEqual("encoded properties", encodedCount, 2);
+
+      AddInfo(FString::Printf(
+          TEXT("%d features: encoding %.3fms (%.2fM features/s)"),
+          featureCount,
+          encoding,
+          millionsPerSecond(featureCount, encoding)));
+    }
+  });
+}
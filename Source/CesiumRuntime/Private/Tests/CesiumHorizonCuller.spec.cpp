@@ -0,0 +1,99 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumHorizonCuller.h"
+#include "Misc/AutomationTest.h"
+#include <CesiumGeometry/BoundingSphere.h>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumHorizonCullerSpec,
+    "Cesium.Unit.HorizonCuller",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumHorizonCullerSpec)
+
+void FCesiumHorizonCullerSpec::Define() {
+  const double radius = Ellipsoid::WGS84.getRadii().x;
+
+  It("culls nothing without views", [this, radius]() {
+    CesiumHorizonCuller culler;
+    TestFalse(
+        "below horizon",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(-radius, 0.0, 0.0), 100.0)));
+  });
+
+  It("culls the far side of the globe", [this, radius]() {
+    CesiumHorizonCuller culler;
+    culler.setViews(
+        Ellipsoid::WGS84,
+        {glm::dvec3(radius + 1000.0, 0.0, 0.0)});
+
+    TestTrue(
+        "far side",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(-radius, 0.0, 0.0), 100.0)));
+    TestFalse(
+        "below the view",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(radius, 0.0, 0.0), 100.0)));
+  });
+
+  It("keeps volumes that reach above the horizon", [this, radius]() {
+    CesiumHorizonCuller culler;
+    culler.setViews(
+        Ellipsoid::WGS84,
+        {glm::dvec3(radius + 1000.0, 0.0, 0.0)});
+
+    // About 1100 km away, the surface is below the horizon, but a volume
+    // 200 km above it is not.
+    const double angle = FMath::DegreesToRadians(10.0);
+    const glm::dvec3 direction(FMath::Cos(angle), FMath::Sin(angle), 0.0);
+    TestTrue(
+        "on the surface",
+        culler.isBelowHorizon(BoundingSphere(direction * radius, 10000.0)));
+    TestFalse(
+        "above the surface",
+        culler.isBelowHorizon(
+            BoundingSphere(direction * (radius + 200000.0), 10000.0)));
+  });
+
+  It("only culls volumes hidden in all views", [this, radius]() {
+    CesiumHorizonCuller culler;
+    culler.setViews(
+        Ellipsoid::WGS84,
+        {glm::dvec3(radius + 1000.0, 0.0, 0.0),
+         glm::dvec3(-radius - 1000.0, 0.0, 0.0)});
+    TestFalse(
+        "below the second view",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(-radius, 0.0, 0.0), 100.0)));
+  });
+
+  It("culls nothing from inside the ellipsoid", [this, radius]() {
+    CesiumHorizonCuller culler;
+    culler.setViews(Ellipsoid::WGS84, {glm::dvec3(10.0, 0.0, 0.0)});
+    TestFalse(
+        "below horizon",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(-radius, 0.0, 0.0), 100.0)));
+  });
+
+  It("uses the radii of other ellipsoids", [this]() {
+    const double moonRadius = 1737400.0;
+    const Ellipsoid moon(moonRadius, moonRadius, moonRadius);
+    CesiumHorizonCuller culler;
+    culler.setViews(moon, {glm::dvec3(moonRadius + 1000.0, 0.0, 0.0)});
+
+    TestTrue(
+        "far side",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(-moonRadius, 0.0, 0.0), 100.0)));
+    TestFalse(
+        "near side",
+        culler.isBelowHorizon(
+            BoundingSphere(glm::dvec3(moonRadius, 0.0, 0.0), 100.0)));
+  });
+}
@@ -0,0 +1,75 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumLoadArena.h"
+#include "Misc/AutomationTest.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumLoadArenaSpec,
+    "Cesium.Unit.LoadArena",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumLoadArenaSpec)
+
+void FCesiumLoadArenaSpec::Define() {
+  It("aligns allocations", [this]() {
+    CesiumLoadArena arena;
+    for (size_t alignment : {1, 2, 4, 8, 16, 64}) {
+      arena.allocate(3, 1);
+      const uintptr_t address =
+          reinterpret_cast<uintptr_t>(arena.allocate(5, alignment));
+      TestTrue("aligned", address % alignment == 0);
+    }
+  });
+
+  It("carves small allocations out of a single block", [this]() {
+    CesiumLoadArena arena(1024);
+    for (int32 i = 0; i < 16; ++i) {
+      arena.allocate(16, 8);
+    }
+    TestTrue("one block", arena.getAllocatedBytes() < 2 * 1024);
+  });
+
+  It("gives large allocations a block of their own", [this]() {
+    CesiumLoadArena arena(1024);
+    uint8* pSmall = static_cast<uint8*>(arena.allocate(16, 8));
+    arena.allocate(4096, 8);
+    uint8* pNextSmall = static_cast<uint8*>(arena.allocate(16, 8));
+    TestEqual(
+        "continues the current block",
+        int64(pNextSmall - pSmall),
+        int64(16));
+  });
+
+  It("backs standard containers", [this]() {
+    CesiumLoadArena arena;
+    std::vector<int32, CesiumLoadArenaAllocator<int32>> values(
+        (CesiumLoadArenaAllocator<int32>(&arena)));
+    for (int32 i = 0; i < 1000; ++i) {
+      values.push_back(i);
+    }
+
+    using Map = std::unordered_map<
+        std::string_view,
+        uint32_t,
+        std::hash<std::string_view>,
+        std::equal_to<std::string_view>,
+        CesiumLoadArenaAllocator<std::pair<const std::string_view, uint32_t>>>;
+    Map map((Map::allocator_type(&arena)));
+    map["first"] = 1;
+    map["second"] = 2;
+
+    TestEqual("last value", values.back(), 999);
+    TestEqual("first", map["first"], 1u);
+    TestEqual("second", map["second"], 2u);
+    TestTrue("allocated from the arena", arena.getAllocatedBytes() > 0);
+  });
+
+  It("falls back to the general allocator without an arena", [this]() {
+    std::vector<int32, CesiumLoadArenaAllocator<int32>> values;
+    values.resize(100, 7);
+    TestEqual("value", values[99], 7);
+  });
+}
@@ -7,11 +7,27 @@
 #include "CesiumAsync/ICacheDatabase.h"
 #include "CesiumRuntime.h"
 
+#include "CesiumGeoreference.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumTilesetStatistics.h"
+#include "DynamicRHI.h"
 #include "Editor.h"
+#include "Engine/Texture2D.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
 #include "Settings/LevelEditorPlaySettings.h"
 #include "Tests/AutomationCommon.h"
 #include "Tests/AutomationEditorCommon.h"
+#include "UObject/UObjectIterator.h"
 #include "UnrealClient.h"
+#include <algorithm>
+#include <cmath>
 
 namespace Cesium {
 
@@ -36,6 +52,388 @@ struct LoadTestContext {
 
 LoadTestContext gLoadTestContext;
 
+FrameTiming getLastFrameTiming() {
+  FrameTiming timing;
+  timing.frameTime = FApp::GetDeltaTime() * 1000.0;
+  timing.gameThreadTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+  timing.renderThreadTime = FPlatformTime::ToMilliseconds(GRenderThreadTime);
+  timing.gpuTime = FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles());
+  return timing;
+}
+
+// Moves the camera the given distance along the pass's path, and returns
+// whether it has reached the end.
+bool moveCameraAlongPath(
+    SceneGenerationContext& context,
+    const TestPass& pass,
+    double distance) {
+  const std::vector<FVector>& path = pass.cameraPath;
+  if (path.size() < 2) {
+    return true;
+  }
+
+  // The path is followed in Unreal coordinates, which are in centimeters.
+  distance *= 100.0;
+  FVector start = context.georeference
+                      ->TransformLongitudeLatitudeHeightPositionToUnreal(
+                          path[0]);
+
+  if (pass.loopCameraPath) {
+    double pathLength = 0.0;
+    FVector previous = start;
+    for (size_t i = 1; i < path.size(); ++i) {
+      const FVector next =
+          context.georeference
+              ->TransformLongitudeLatitudeHeightPositionToUnreal(path[i]);
+      pathLength += FVector::Distance(previous, next);
+      previous = next;
+    }
+    if (pathLength > 0.0) {
+      distance = std::fmod(distance, pathLength);
+    }
+  }
+  for (size_t i = 1; i < path.size(); ++i) {
+    const FVector end =
+        context.georeference->TransformLongitudeLatitudeHeightPositionToUnreal(
+            path[i]);
+    const double length = FVector::Distance(start, end);
+    if (distance <= length || i == path.size() - 1) {
+      const double t = length > 0.0 ? FMath::Min(distance / length, 1.0) : 1.0;
+      context.setCamera(
+          FMath::Lerp(start, end, t),
+          (end - start).GetSafeNormal().Rotation());
+      return distance >= length && i == path.size() - 1;
+    }
+    distance -= length;
+    start = end;
+  }
+  return true;
+}
+
+template <typename T> int32 countObjects() {
+  int32 count = 0;
+  for (TObjectIterator<T> it; it; ++it) {
+    ++count;
+  }
+  return count;
+}
+
+int64 getFileSize(const FString& filename) {
+  return FMath::Max(IFileManager::Get().FileSize(*filename), int64(0));
+}
+
+ResourceSample
+sampleResources(SceneGenerationContext& context, const TestPass& pass) {
+  ResourceSample sample;
+  sample.time = pass.elapsedTime;
+  sample.usedPhysicalBytes = uint64(FPlatformMemory::GetStats().UsedPhysical);
+
+  FTextureMemoryStats textureMemory;
+  RHIGetTextureMemoryStats(textureMemory);
+  sample.gpuTextureBytes =
+      textureMemory.StreamingMemorySize + textureMemory.NonStreamingMemorySize;
+
+  sample.tileMemoryBytes = context.getTileMemoryBytes();
+  sample.gltfComponentCount = countObjects<UCesiumGltfComponent>();
+  sample.textureCount = countObjects<UTexture2D>();
+  sample.materialInstanceCount = countObjects<UMaterialInstanceDynamic>();
+  sample.destructionBacklog = CesiumLifetime::getPendingDestructionCount();
+
+  // The editor keeps its request cache in the engine's user directory.
+  const FString cacheFilename = FPaths::Combine(
+      FPaths::EngineUserDir(),
+      TEXT("cesium-request-cache.sqlite"));
+  sample.cacheFileBytes = getFileSize(cacheFilename) +
+                          getFileSize(cacheFilename + TEXT("-wal"));
+  return sample;
+}
+
+// Adds the total time of each stage of the tile pipeline, times the sign, to
+// the breakdown and view cost of the pass. A pass subtracts the totals when it
+// starts and adds them when it ends.
+void addStageTotals(TestPass& pass, double sign) {
+  const UCesiumTilesetStatistics* pStatistics =
+      GEngine ? GEngine->GetEngineSubsystem<UCesiumTilesetStatistics>()
+              : nullptr;
+  if (!pStatistics) {
+    return;
+  }
+
+  auto getTotal = [pStatistics, sign](ECesiumTileLoadStage stage) {
+    return sign * pStatistics->GetStageStatistics(stage).TotalMilliseconds;
+  };
+  LoadTimeBreakdown& breakdown = pass.breakdown;
+  breakdown.networkWait += getTotal(ECesiumTileLoadStage::NetworkFetch);
+  breakdown.cacheRead += getTotal(ECesiumTileLoadStage::CacheRead);
+  breakdown.workerConversion +=
+      getTotal(ECesiumTileLoadStage::CreateOffGameThread);
+  breakdown.meshOptimization +=
+      getTotal(ECesiumTileLoadStage::MeshOptimization);
+  breakdown.gameThreadFinalize +=
+      getTotal(ECesiumTileLoadStage::CreateOnGameThread);
+  breakdown.rhiUpload += getTotal(ECesiumTileLoadStage::TextureCreation);
+  pass.viewCost.viewUpdateTime += getTotal(ECesiumTileLoadStage::ViewUpdate);
+  pass.viewCost.occlusionUpdateTime +=
+      getTotal(ECesiumTileLoadStage::OcclusionUpdate);
+}
+
+// Turns the totals of the view cost of a pass into averages per frame.
+void averageViewCost(ViewCost& viewCost) {
+  if (viewCost.frameCount <= 0) {
+    return;
+  }
+  const double frames = double(viewCost.frameCount);
+  viewCost.viewUpdateTime /= frames;
+  viewCost.occlusionUpdateTime /= frames;
+  viewCost.tilesVisited /= frames;
+  viewCost.tilesRendered /= frames;
+}
+
+FString describeViewCost(const ViewCost& viewCost) {
+  return FString::Printf(
+      TEXT("view update %.3f ms, occlusion %.3f ms, %.0f tiles visited, ")
+          TEXT("%.0f rendered per frame"),
+      viewCost.viewUpdateTime,
+      viewCost.occlusionUpdateTime,
+      viewCost.tilesVisited,
+      viewCost.tilesRendered);
+}
+
+// The parts of a breakdown, with their names in reports.
+const std::vector<std::pair<const TCHAR*, double LoadTimeBreakdown::*>>&
+getBreakdownParts() {
+  static const std::vector<
+      std::pair<const TCHAR*, double LoadTimeBreakdown::*>>
+      parts = {
+          {TEXT("network wait"), &LoadTimeBreakdown::networkWait},
+          {TEXT("cache reads"), &LoadTimeBreakdown::cacheRead},
+          {TEXT("worker conversion"), &LoadTimeBreakdown::workerConversion},
+          {TEXT("mesh optimization"), &LoadTimeBreakdown::meshOptimization},
+          {TEXT("game-thread finalize"),
+           &LoadTimeBreakdown::gameThreadFinalize},
+          {TEXT("RHI upload"), &LoadTimeBreakdown::rhiUpload},
+          {TEXT("idle"), &LoadTimeBreakdown::idle}};
+  return parts;
+}
+
+FString describeBreakdown(const LoadTimeBreakdown& breakdown) {
+  FString description;
+  for (const auto& [name, pPart] : getBreakdownParts()) {
+    description += FString::Printf(
+        TEXT("%s%s %.0f ms"),
+        description.IsEmpty() ? TEXT("") : TEXT(", "),
+        name,
+        breakdown.*pPart);
+  }
+  return description;
+}
+
+void computeFrameStatistics(TestPass& pass) {
+  pass.averageFrameTime = pass.p99FrameTime = pass.worstFrameTime = 0;
+  pass.worstGameThreadTime = pass.worstRenderThreadTime = pass.worstGpuTime =
+      0;
+  pass.hitchCount = 0;
+
+  if (pass.frames.empty()) {
+    return;
+  }
+
+  std::vector<double> frameTimes;
+  frameTimes.reserve(pass.frames.size());
+  for (const FrameTiming& frame : pass.frames) {
+    frameTimes.push_back(frame.frameTime);
+    pass.averageFrameTime += frame.frameTime;
+    pass.worstGameThreadTime =
+        std::max(pass.worstGameThreadTime, frame.gameThreadTime);
+    pass.worstRenderThreadTime =
+        std::max(pass.worstRenderThreadTime, frame.renderThreadTime);
+    pass.worstGpuTime = std::max(pass.worstGpuTime, frame.gpuTime);
+    if (frame.frameTime > HitchThresholdMilliseconds) {
+      ++pass.hitchCount;
+    }
+  }
+  pass.averageFrameTime /= double(frameTimes.size());
+
+  // The nearest-rank 99th percentile.
+  std::sort(frameTimes.begin(), frameTimes.end());
+  const size_t p99Rank =
+      size_t(std::ceil(0.99 * double(frameTimes.size()))) - 1;
+  pass.p99FrameTime = frameTimes[std::min(p99Rank, frameTimes.size() - 1)];
+  pass.worstFrameTime = frameTimes.back();
+}
+
+double getHoleTimePercentage(const TestPass& pass) {
+  return pass.elapsedTime > 0.0 ? 100.0 * pass.holeTime / pass.elapsedTime
+                                : 0.0;
+}
+
+double getPerSecond(int64 count, const TestPass& pass) {
+  return pass.elapsedTime > 0.0 ? double(count) / pass.elapsedTime : 0.0;
+}
+
+FString describeBreakdownChange(
+    const TestPass& baseline,
+    const TestPass& pass,
+    double thresholdPercent) {
+  FString description;
+  for (const auto& [name, pPart] : getBreakdownParts()) {
+    const double before = baseline.breakdown.*pPart;
+    const double after = pass.breakdown.*pPart;
+    if (before <= 0.0) {
+      continue;
+    }
+    const double change = 100.0 * (after - before) / before;
+    if (FMath::Abs(change) > thresholdPercent) {
+      description += FString::Printf(
+          TEXT("%s%s %+.0f%%"),
+          description.IsEmpty() ? TEXT("") : TEXT(", "),
+          name,
+          change);
+    }
+  }
+  return description;
+}
+
+FString escapeJson(const FString& value) {
+  return value.Replace(TEXT("\\"), TEXT("\\\\"))
+      .Replace(TEXT("\""), TEXT("\\\""));
+}
+
+FString formatJsonReport(
+    const FString& testName,
+    const std::vector<TestPass>& testPasses) {
+  FString json = FString::Printf(
+      TEXT("{\n  \"test\": \"%s\",\n  \"hitchThresholdMs\": %.1f,\n")
+          TEXT("  \"passes\": ["),
+      *escapeJson(testName),
+      HitchThresholdMilliseconds);
+
+  for (size_t i = 0; i < testPasses.size(); ++i) {
+    const TestPass& pass = testPasses[i];
+    json += i == 0 ? TEXT("\n") : TEXT(",\n");
+    json += FString::Printf(
+        TEXT("    {\n      \"name\": \"%s\",\n")
+            TEXT("      \"elapsedTimeSeconds\": %.4f,\n")
+            TEXT("      \"timedOut\": %s,\n")
+            TEXT("      \"fastest\": %s,\n")
+            TEXT("      \"frameCount\": %d,\n")
+            TEXT("      \"averageFrameTimeMs\": %.3f,\n")
+            TEXT("      \"p99FrameTimeMs\": %.3f,\n")
+            TEXT("      \"worstFrameTimeMs\": %.3f,\n")
+            TEXT("      \"worstGameThreadTimeMs\": %.3f,\n")
+            TEXT("      \"worstRenderThreadTimeMs\": %.3f,\n")
+            TEXT("      \"worstGpuTimeMs\": %.3f,\n")
+            TEXT("      \"hitchCount\": %d,\n")
+            TEXT("      \"holeTimePercent\": %.2f,\n")
+            TEXT("      \"tilesLoaded\": %lld,\n")
+            TEXT("      \"tilesUnloaded\": %lld,\n")
+            TEXT("      \"tilesLoadedPerSecond\": %.2f,\n")
+            TEXT("      \"tilesUnloadedPerSecond\": %.2f,\n")
+            TEXT("      \"peakTileMemoryBytes\": %lld,\n")
+            TEXT("      \"peakUsedPhysicalBytes\": %llu,\n")
+            TEXT("      \"breakdownMs\": {\"networkWait\": %.3f, ")
+            TEXT("\"cacheRead\": %.3f, \"workerConversion\": %.3f, ")
+            TEXT("\"meshOptimization\": %.3f, ")
+            TEXT("\"gameThreadFinalize\": %.3f, \"rhiUpload\": %.3f, ")
+            TEXT("\"idle\": %.3f},\n")
+            TEXT("      \"viewCostPerFrame\": {\"viewUpdateMs\": %.3f, ")
+            TEXT("\"occlusionUpdateMs\": %.3f, \"tilesVisited\": %.1f, ")
+            TEXT("\"tilesRendered\": %.1f},\n")
+            TEXT("      \"samples\": ["),
+        *escapeJson(pass.name),
+        pass.elapsedTime,
+        pass.timedOut ? TEXT("true") : TEXT("false"),
+        pass.isFastest ? TEXT("true") : TEXT("false"),
+        int32(pass.frames.size()),
+        pass.averageFrameTime,
+        pass.p99FrameTime,
+        pass.worstFrameTime,
+        pass.worstGameThreadTime,
+        pass.worstRenderThreadTime,
+        pass.worstGpuTime,
+        pass.hitchCount,
+        getHoleTimePercentage(pass),
+        pass.tilesLoaded,
+        pass.tilesUnloaded,
+        getPerSecond(pass.tilesLoaded, pass),
+        getPerSecond(pass.tilesUnloaded, pass),
+        pass.peakTileMemoryBytes,
+        pass.peakUsedPhysicalBytes,
+        pass.breakdown.networkWait,
+        pass.breakdown.cacheRead,
+        pass.breakdown.workerConversion,
+        pass.breakdown.meshOptimization,
+        pass.breakdown.gameThreadFinalize,
+        pass.breakdown.rhiUpload,
+        pass.breakdown.idle,
+        pass.viewCost.viewUpdateTime,
+        pass.viewCost.occlusionUpdateTime,
+        pass.viewCost.tilesVisited,
+        pass.viewCost.tilesRendered);
+
+    // Each sample is [time, used physical, GPU textures, tiles, glTF
+    // components, textures, material instances, destruction backlog, cache
+    // files], to keep the file small.
+    for (size_t j = 0; j < pass.samples.size(); ++j) {
+      const ResourceSample& sample = pass.samples[j];
+      json += FString::Printf(
+          TEXT("%s[%.1f, %llu, %lld, %lld, %d, %d, %d, %d, %lld]"),
+          j == 0 ? TEXT("") : TEXT(", "),
+          sample.time,
+          sample.usedPhysicalBytes,
+          sample.gpuTextureBytes,
+          sample.tileMemoryBytes,
+          sample.gltfComponentCount,
+          sample.textureCount,
+          sample.materialInstanceCount,
+          sample.destructionBacklog,
+          sample.cacheFileBytes);
+    }
+    json += TEXT("],\n      \"frames\": [");
+
+    // Each frame is [frame, game thread, render thread, GPU], to keep the
+    // file small.
+    for (size_t j = 0; j < pass.frames.size(); ++j) {
+      const FrameTiming& frame = pass.frames[j];
+      json += FString::Printf(
+          TEXT("%s[%.3f, %.3f, %.3f, %.3f]"),
+          j == 0 ? TEXT("") : TEXT(", "),
+          frame.frameTime,
+          frame.gameThreadTime,
+          frame.renderThreadTime,
+          frame.gpuTime);
+    }
+    json += TEXT("]\n    }");
+  }
+
+  json += TEXT("\n  ]\n}\n");
+  return json;
+}
+
+void saveJsonReport(
+    const FString& testName,
+    const std::vector<TestPass>& testPasses) {
+  const FString filename = FPaths::Combine(
+      FPaths::AutomationDir(),
+      TEXT("CesiumLoadTests"),
+      testName + TEXT(".json"));
+  if (FFileHelper::SaveStringToFile(
+          formatJsonReport(testName, testPasses),
+          *filename)) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Wrote load test results to %s"),
+        *filename);
+  } else {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Could not write load test results to %s"),
+        *filename);
+  }
+}
+
 DEFINE_LATENT_AUTOMATION_COMMAND_THREE_PARAMETER(
     TimeLoadingCommand,
     FString,
@@ -50,10 +448,22 @@ bool TimeLoadingCommand::Update() {
 
     // Set up the world for this pass
     playContext.syncWorldCamera();
+    moveCameraAlongPath(playContext, pass, 0.0);
     if (pass.setupStep)
       pass.setupStep(playContext, pass.optionalParameter);
 
     // Start test mark, turn updates back on
+    pass.frames.clear();
+    pass.samples.clear();
+    pass.timedOut = false;
+    pass.holeTime = 0;
+    pass.tilesLoaded = -playContext.getTilesLoaded();
+    pass.tilesUnloaded = -playContext.getTilesUnloaded();
+    pass.peakTileMemoryBytes = 0;
+    pass.peakUsedPhysicalBytes = 0;
+    pass.breakdown = LoadTimeBreakdown();
+    pass.viewCost = ViewCost();
+    addStageTotals(pass, -1.0);
     pass.startMark = FPlatformTime::Seconds();
     UE_LOG(LogCesium, Display, TEXT("-- Load start mark -- %s"), *loggingName);
 
@@ -69,14 +479,54 @@ bool TimeLoadingCommand::Update() {
 
   pass.elapsedTime = timeMark - pass.startMark;
 
-  // The command is over if tilesets are loaded, or timed out
-  // Wait for a maximum of 30 seconds
-  const size_t testTimeout = 30;
+  // This is called once per frame, after the world has ticked.
+  if (pass.recordFrames) {
+    pass.frames.push_back(getLastFrameTiming());
+  }
+  if (pass.sampleInterval > 0.0 &&
+      (pass.samples.empty() ||
+       pass.elapsedTime - pass.samples.back().time >= pass.sampleInterval)) {
+    pass.samples.push_back(sampleResources(playContext, pass));
+  }
+
+  ++pass.viewCost.frameCount;
+  pass.viewCost.tilesVisited += double(playContext.getTilesVisited());
+  pass.viewCost.tilesRendered += double(playContext.getTilesRendered());
+
   bool tilesetsloaded = playContext.areTilesetsDoneLoading();
-  bool timedOut = pass.elapsedTime >= testTimeout;
+  if (!tilesetsloaded) {
+    pass.holeTime += FApp::GetDeltaTime();
+  }
+  pass.peakTileMemoryBytes =
+      std::max(pass.peakTileMemoryBytes, playContext.getTileMemoryBytes());
+  pass.peakUsedPhysicalBytes = std::max(
+      pass.peakUsedPhysicalBytes,
+      uint64(FPlatformMemory::GetStats().UsedPhysical));
+
+  // The command is over if tilesets are loaded, or the camera has reached the
+  // end of its path, or timed out
+  bool finished = pass.cameraPath.empty()
+                      ? tilesetsloaded
+                      : moveCameraAlongPath(
+                            playContext,
+                            pass,
+                            pass.cameraSpeed * pass.elapsedTime);
+  finished = finished && pass.elapsedTime >= pass.minimumDuration;
+  bool timedOut = pass.elapsedTime >= pass.timeout;
+  if (timedOut && pass.loopCameraPath) {
+    finished = true;
+    timedOut = false;
+  }
 
-  if (tilesetsloaded || timedOut) {
+  if (finished || timedOut) {
     pass.endMark = timeMark;
+    pass.timedOut = timedOut;
+    pass.tilesLoaded += playContext.getTilesLoaded();
+    pass.tilesUnloaded += playContext.getTilesUnloaded();
+    addStageTotals(pass, 1.0);
+    pass.breakdown.idle = (pass.elapsedTime - pass.holeTime) * 1000.0;
+    averageViewCost(pass.viewCost);
+    computeFrameStatistics(pass);
     UE_LOG(LogCesium, Display, TEXT("-- Load end mark -- %s"), *loggingName);
 
     if (timedOut) {
@@ -92,6 +542,28 @@ bool TimeLoadingCommand::Update() {
           TEXT("Tileset load completed in %.2f seconds"),
           pass.elapsedTime);
     }
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("%d frames, P99 %.2f ms, worst %.2f ms, %d hitches, ")
+            TEXT("%lld tiles loaded, %lld unloaded, %.1f%% hole time"),
+        int32(pass.frames.size()),
+        pass.p99FrameTime,
+        pass.worstFrameTime,
+        pass.hitchCount,
+        pass.tilesLoaded,
+        pass.tilesUnloaded,
+        getHoleTimePercentage(pass));
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Breakdown: %s"),
+        *describeBreakdown(pass.breakdown));
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("View cost: %s"),
+        *describeViewCost(pass.viewCost));
 
     if (pass.verifyStep)
       pass.verifyStep(playContext, pass.optionalParameter);
@@ -127,12 +599,35 @@ void defaultReportStep(const std::vector<TestPass>& testPasses) {
   FString reportStr;
   reportStr += "\n\nTest Results\n";
   reportStr += "-----------------------------\n";
-  reportStr += "(measured time) - (pass name)\n";
+  reportStr += "(measured time) - (P99 / worst frame) - (hitches) - (pass "
+               "name)\n";
   std::vector<TestPass>::const_iterator it;
   for (it = testPasses.begin(); it != testPasses.end(); ++it) {
     const TestPass& pass = *it;
-    reportStr +=
-        FString::Printf(TEXT("%.2f secs - %s\n"), pass.elapsedTime, *pass.name);
+    reportStr += FString::Printf(
+        TEXT("%.2f secs - %.1f / %.1f ms - %d - %s\n"),
+        pass.elapsedTime,
+        pass.p99FrameTime,
+        pass.worstFrameTime,
+        pass.hitchCount,
+        *pass.name);
+  }
+  reportStr += "-----------------------------\n";
+
+  // Where the time went, and how it changed from the first pass.
+  for (it = testPasses.begin(); it != testPasses.end(); ++it) {
+    const TestPass& pass = *it;
+    reportStr += FString::Printf(
+        TEXT("%s: %s\n"),
+        *pass.name,
+        *describeBreakdown(pass.breakdown));
+    if (it != testPasses.begin()) {
+      const FString change = describeBreakdownChange(testPasses.front(), pass);
+      reportStr += FString::Printf(
+          TEXT("  compared to %s: %s\n"),
+          *testPasses.front().name,
+          change.IsEmpty() ? TEXT("no notable change") : *change);
+    }
   }
   reportStr += "-----------------------------\n";
 
@@ -163,6 +658,8 @@ bool TestCleanupCommand::Update() {
   else
     defaultReportStep(context.testPasses);
 
+  saveJsonReport(context.testName, context.testPasses);
+
   // Turn on the editor tileset updates so we can see what we loaded
   // gLoadTestContext.creationContext.setSuspendUpdate(false);
   return true;
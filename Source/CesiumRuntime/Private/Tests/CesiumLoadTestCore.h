@@ -6,11 +6,79 @@
 
 #include <functional>
 #include <variant>
+#include <vector>
 
 #include "CesiumSceneGeneration.h"
 
 namespace Cesium {
 
+/**
+ * Frames that take longer than this, in milliseconds, are counted as hitches.
+ * This is Unreal's default hitch threshold.
+ */
+constexpr double HitchThresholdMilliseconds = 60.0;
+
+/**
+ * The times of a frame while a pass loads, in milliseconds.
+ */
+struct FrameTiming {
+  double frameTime = 0;
+  double gameThreadTime = 0;
+  double renderThreadTime = 0;
+  double gpuTime = 0;
+};
+
+/**
+ * The resources in use at a moment during a pass, which are sampled
+ * periodically to find slow growth over long runs.
+ */
+struct ResourceSample {
+  // The time of the sample, in seconds since the pass started.
+  double time = 0;
+  uint64 usedPhysicalBytes = 0;
+  // The size of the textures allocated by the RHI.
+  int64 gpuTextureBytes = 0;
+  // The size of the tiles loaded by the tilesets.
+  int64 tileMemoryBytes = 0;
+  int32 gltfComponentCount = 0;
+  int32 textureCount = 0;
+  int32 materialInstanceCount = 0;
+  int32 destructionBacklog = 0;
+  // The size of the request cache database files.
+  int64 cacheFileBytes = 0;
+};
+
+/**
+ * Where the time of the tile pipeline went during a pass, in milliseconds,
+ * from the stages recorded by UCesiumTilesetStatistics. Each stage is summed
+ * over all of its runs, which overlap on different threads, so the total can
+ * exceed the time of the pass.
+ */
+struct LoadTimeBreakdown {
+  double networkWait = 0;
+  double cacheRead = 0;
+  double workerConversion = 0;
+  // Part of the worker conversion.
+  double meshOptimization = 0;
+  double gameThreadFinalize = 0;
+  double rhiUpload = 0;
+  // The time in which the tilesets had nothing left to load.
+  double idle = 0;
+};
+
+/**
+ * The game-thread cost of selecting the tiles of the tilesets' views during a
+ * pass, per frame, averaged over the frames of the pass.
+ */
+struct ViewCost {
+  int frameCount = 0;
+  // In milliseconds, from the stages recorded by UCesiumTilesetStatistics.
+  double viewUpdateTime = 0;
+  double occlusionUpdateTime = 0;
+  double tilesVisited = 0;
+  double tilesRendered = 0;
+};
+
 struct TestPass {
   typedef std::variant<int, float> TestingParameter;
   typedef std::function<void(SceneGenerationContext&, TestingParameter)>
@@ -26,11 +94,74 @@ struct TestPass {
   double endMark = 0;
   double elapsedTime = 0;
 
+  // Loading stops after this many seconds, and the pass is marked as timed
+  // out.
+  double timeout = 30.0;
+  bool timedOut = false;
+
+  // The pass lasts at least this many seconds, even when the tilesets are
+  // loaded sooner, so that the costs of the frames after loading are measured
+  // too.
+  double minimumDuration = 0;
+
+  // When set, the camera moves along these longitude, latitude, height
+  // waypoints at cameraSpeed meters per second, facing the way it moves, and
+  // the pass lasts until the camera reaches the end, rather than until the
+  // tilesets are loaded.
+  std::vector<FVector> cameraPath;
+  double cameraSpeed = 0;
+
+  // When set, the camera goes around its path again each time it reaches the
+  // end, and the pass lasts until its timeout, which doesn't count as timing
+  // out. The path should end where it starts.
+  bool loopCameraPath = false;
+
+  // Whether the timing of each frame is kept. Long passes don't keep them,
+  // so that they don't grow the memory they measure.
+  bool recordFrames = true;
+
+  // When greater than zero, the resources in use are sampled this often, in
+  // seconds.
+  double sampleInterval = 0;
+
+  std::vector<FrameTiming> frames;
+  std::vector<ResourceSample> samples;
+  LoadTimeBreakdown breakdown;
+  ViewCost viewCost;
+
+  // The time, in seconds, during which the tilesets were still loading tiles
+  // for the view, which shows as holes and coarse tiles while the camera
+  // moves.
+  double holeTime = 0;
+  int64 tilesLoaded = 0;
+  int64 tilesUnloaded = 0;
+  int64 peakTileMemoryBytes = 0;
+  uint64 peakUsedPhysicalBytes = 0;
+
+  // Computed from the frames when the pass ends.
+  double averageFrameTime = 0;
+  double p99FrameTime = 0;
+  double worstFrameTime = 0;
+  double worstGameThreadTime = 0;
+  double worstRenderThreadTime = 0;
+  double worstGpuTime = 0;
+  int hitchCount = 0;
+
   bool isFastest = false;
 };
 
 typedef std::function<void(const std::vector<TestPass>&)> ReportCallback;
 
+/**
+ * Describes how the load time breakdown of a pass differs from that of a
+ * baseline pass, like "game-thread finalize +40%, network wait -12%", listing
+ * only the parts that changed by more than the threshold, in percent.
+ */
+FString describeBreakdownChange(
+    const TestPass& baseline,
+    const TestPass& pass,
+    double thresholdPercent = 10.0);
+
 bool RunLoadTest(
     const FString& testName,
     std::function<void(SceneGenerationContext&)> locationSetup,
@@ -0,0 +1,196 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAsync/Promise.h"
+#include "CesiumMemoryCacheAssetAccessor.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using CesiumTestHelpers::TestAssetRequest;
+using CesiumTestHelpers::TestAssetResponse;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumMemoryCacheAssetAccessorSpec,
+    "Cesium.Unit.MemoryCacheAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumMemoryCacheAssetAccessorSpec)
+
+namespace {
+
+std::shared_ptr<TestAssetRequest> createRequest(
+    const std::string& url,
+    const std::string& cacheControl,
+    size_t size) {
+  CesiumAsync::HttpHeaders headers;
+  if (!cacheControl.empty()) {
+    headers.emplace("Cache-Control", cacheControl);
+  }
+  return std::make_shared<TestAssetRequest>(
+      url,
+      CesiumAsync::HttpHeaders(),
+      TestAssetResponse(
+          200,
+          std::move(headers),
+          std::vector<std::byte>(size, std::byte(1))));
+}
+
+/**
+ * Answers every request immediately, and counts the requests it answers.
+ */
+class CountingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  std::string cacheControl = "max-age=3600";
+  size_t size = 1000;
+  int32 requestCount = 0;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->requestCount;
+    return asyncSystem.createResolvedFuture<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>(
+        createRequest(url, this->cacheControl, this->size));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+/**
+ * Answers requests only when told to, and counts the requests it receives.
+ */
+class DeferredAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  int32 requestCount = 0;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->requestCount;
+    using Request = std::shared_ptr<CesiumAsync::IAssetRequest>;
+    CesiumAsync::Promise<Request> promise =
+        asyncSystem.createPromise<Request>();
+    this->_pending.emplace_back(url, promise);
+    return promise.getFuture();
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+
+  void answerAll() {
+    for (auto& [url, promise] : this->_pending) {
+      promise.resolve(createRequest(url, "no-store", 10));
+    }
+    this->_pending.clear();
+  }
+
+private:
+  std::vector<std::pair<
+      std::string,
+      CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>>>
+      _pending;
+};
+
+void getAndWait(CesiumAsync::IAssetAccessor& accessor, const std::string& url) {
+  accessor.get(getAsyncSystem(), url, {}).wait();
+}
+
+} // namespace
+
+void FCesiumMemoryCacheAssetAccessorSpec::Define() {
+  It("answers repeated requests from memory", [this]() {
+    auto pInner = std::make_shared<CountingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumMemoryCacheAssetAccessor>(pInner, 1000000);
+
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    getAndWait(*pAccessor, "https://example.com/b.glb");
+
+    TestEqual("requestCount", pInner->requestCount, 2);
+    TestEqual("entries", int32(pAccessor->getEntryCount()), 2);
+  });
+
+  It("does not keep responses that may not be cached", [this]() {
+    auto pInner = std::make_shared<CountingAssetAccessor>();
+    pInner->cacheControl = "no-cache, max-age=3600";
+    auto pAccessor =
+        std::make_shared<CesiumMemoryCacheAssetAccessor>(pInner, 1000000);
+
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+
+    TestEqual("requestCount", pInner->requestCount, 2);
+    TestEqual("entries", int32(pAccessor->getEntryCount()), 0);
+  });
+
+  It("discards the least recently used responses", [this]() {
+    auto pInner = std::make_shared<CountingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumMemoryCacheAssetAccessor>(pInner, 3000);
+
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    getAndWait(*pAccessor, "https://example.com/b.glb");
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    getAndWait(*pAccessor, "https://example.com/c.glb");
+
+    TestEqual("requestCount", pInner->requestCount, 3);
+    TestTrue("size", pAccessor->getSizeBytes() <= 3000);
+
+    // b was the least recently used, so it was discarded to make room for c.
+    getAndWait(*pAccessor, "https://example.com/a.glb");
+    TestEqual("requestCount after a", pInner->requestCount, 3);
+    getAndWait(*pAccessor, "https://example.com/b.glb");
+    TestEqual("requestCount after b", pInner->requestCount, 4);
+  });
+
+  It("shares the response of identical requests in flight", [this]() {
+    auto pInner = std::make_shared<DeferredAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumMemoryCacheAssetAccessor>(pInner, 1000000);
+    const std::string url = "https://example.com/tiles/3/2/1.png";
+
+    auto first = pAccessor->get(getAsyncSystem(), url, {});
+    auto second = pAccessor->get(getAsyncSystem(), url, {});
+    auto viaRequest = pAccessor->request(getAsyncSystem(), "GET", url, {}, {});
+    auto other =
+        pAccessor->get(getAsyncSystem(), url, {{"Authorization", "x"}});
+    TestEqual("requestCount", pInner->requestCount, 2);
+
+    pInner->answerAll();
+    std::shared_ptr<CesiumAsync::IAssetRequest> pFirst = first.wait();
+    std::shared_ptr<CesiumAsync::IAssetRequest> pSecond = second.wait();
+    other.wait();
+    TestTrue("shared", pFirst && pFirst == pSecond);
+    TestTrue("shared via request", viaRequest.wait() == pFirst);
+
+    // The response may not be kept, so once it has arrived, the same request
+    // is made again.
+    auto third = pAccessor->get(getAsyncSystem(), url, {});
+    TestEqual("requestCount after response", pInner->requestCount, 3);
+    pInner->answerAll();
+    third.wait();
+  });
+}
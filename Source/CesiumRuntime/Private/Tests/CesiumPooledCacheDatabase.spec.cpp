@@ -0,0 +1,59 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumAsync/CacheItem.h"
+#include "CesiumPooledCacheDatabase.h"
+#include "CesiumTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using CesiumTestHelpers::TestCacheDatabase;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPooledCacheDatabaseSpec,
+    "Cesium.Unit.PooledCacheDatabase",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumPooledCacheDatabaseSpec)
+
+void FCesiumPooledCacheDatabaseSpec::Define() {
+  It("finds entries that are not yet written", [this]() {
+    auto pWrite = std::make_shared<TestCacheDatabase>();
+    auto pRead = std::make_shared<TestCacheDatabase>();
+    auto pDatabase = std::make_shared<CesiumPooledCacheDatabase>(
+        pWrite,
+        std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>>{pRead},
+        1000);
+
+    CesiumTestHelpers::storeTestEntry(*pDatabase, "a.glb", 100);
+    std::optional<CesiumAsync::CacheItem> item = pDatabase->getEntry("a.glb");
+    if (TestTrue("found", item.has_value())) {
+      TestEqual("size", item->cacheResponse.data.size(), size_t(100));
+    }
+
+    pDatabase->flush();
+    TestEqual("pending", pDatabase->getPendingEntryCount(), size_t(0));
+    TestTrue("written", pWrite->entries.count("a.glb") == 1);
+
+    pDatabase->getEntry("a.glb");
+    TestEqual("read connection used", pRead->getCount, 1);
+  });
+
+  It("spreads lookups over the read connections", [this]() {
+    auto pWrite = std::make_shared<TestCacheDatabase>();
+    auto pRead1 = std::make_shared<TestCacheDatabase>();
+    auto pRead2 = std::make_shared<TestCacheDatabase>();
+    auto pDatabase = std::make_shared<CesiumPooledCacheDatabase>(
+        pWrite,
+        std::vector<std::shared_ptr<CesiumAsync::ICacheDatabase>>{
+            pRead1,
+            pRead2});
+
+    for (int32 i = 0; i < 10; ++i) {
+      pDatabase->getEntry("missing");
+    }
+
+    TestEqual("first", pRead1->getCount, 5);
+    TestEqual("second", pRead2->getCount, 5);
+    TestEqual("write", pWrite->getCount, 0);
+  });
+}
@@ -0,0 +1,128 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitiveMerging.h"
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitiveMergingSpec,
+    "Cesium.Unit.PrimitiveMerging",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+Model model;
+END_DEFINE_SPEC(FCesiumPrimitiveMergingSpec)
+
+namespace {
+
+// Adds a node with a mesh of one triangle, translated by the given offset,
+// whose vertices all have the given feature ID.
+MeshPrimitive&
+addTriangle(Model& model, const glm::dvec3& offset, uint8_t featureId) {
+  const int32_t nodeIndex = int32_t(model.nodes.size());
+  Node& node = model.nodes.emplace_back();
+  node.mesh = int32_t(model.meshes.size());
+  node.translation = {offset.x, offset.y, offset.z};
+  model.scenes[0].nodes.push_back(nodeIndex);
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.material = 0;
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      std::vector<glm::vec3>{
+          glm::vec3(0.0f, 0.0f, 0.0f),
+          glm::vec3(1.0f, 0.0f, 0.0f),
+          glm::vec3(0.0f, 1.0f, 0.0f)});
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_SHORT,
+      std::vector<uint16_t>{0, 1, 2});
+  AddFeatureIDsAsAttributeToModel(
+      model,
+      primitive,
+      std::vector<uint8_t>(3, featureId),
+      1,
+      0);
+  return primitive;
+}
+
+} // namespace
+
+void FCesiumPrimitiveMergingSpec::Define() {
+  BeforeEach([this]() {
+    model = Model();
+    model.scene = 0;
+    model.scenes.emplace_back();
+    model.materials.emplace_back();
+    model.materials.emplace_back();
+  });
+
+  It("merges primitives with the same material", [this]() {
+    addTriangle(model, glm::dvec3(0.0), 0);
+    addTriangle(model, glm::dvec3(10.0, 0.0, 0.0), 1);
+
+    TestEqual(
+        "removed",
+        CesiumPrimitiveMerging::mergeSmallPrimitives(model),
+        1);
+    TestEqual("first mesh", model.meshes[0].primitives.size(), size_t(1));
+    TestEqual("second mesh", model.meshes[1].primitives.size(), size_t(0));
+
+    const MeshPrimitive& merged = model.meshes[0].primitives[0];
+    AccessorView<glm::vec3> positions(
+        model,
+        merged.attributes.at("POSITION"));
+    TestEqual("vertices", positions.size(), int64_t(6));
+    TestEqual("moved", positions[4].x, 11.0f);
+
+    AccessorView<uint32_t> indices(model, merged.indices);
+    TestEqual("indices", indices.size(), int64_t(6));
+    TestEqual("offset", indices[3], uint32_t(3));
+
+    AccessorView<uint8_t> featureIds(
+        model,
+        merged.attributes.at("_FEATURE_ID_0"));
+    TestEqual("first feature", featureIds[0], uint8_t(0));
+    TestEqual("second feature", featureIds[5], uint8_t(1));
+
+    const ExtensionExtMeshFeatures* pFeatures =
+        merged.getExtension<ExtensionExtMeshFeatures>();
+    TestNotNull("features", pFeatures);
+    TestEqual(
+        "feature count",
+        pFeatures->featureIds[0].featureCount,
+        int64_t(2));
+  });
+
+  It("keeps primitives with different materials", [this]() {
+    addTriangle(model, glm::dvec3(0.0), 0);
+    addTriangle(model, glm::dvec3(10.0, 0.0, 0.0), 1).material = 1;
+
+    TestEqual(
+        "removed",
+        CesiumPrimitiveMerging::mergeSmallPrimitives(model),
+        0);
+    TestEqual("second mesh", model.meshes[1].primitives.size(), size_t(1));
+  });
+
+  It("keeps primitives of meshes used by several nodes", [this]() {
+    addTriangle(model, glm::dvec3(0.0), 0);
+    addTriangle(model, glm::dvec3(10.0, 0.0, 0.0), 0);
+    Node& node = model.nodes.emplace_back();
+    node.mesh = 1;
+    model.scenes[0].nodes.push_back(int32_t(model.nodes.size() - 1));
+
+    TestEqual(
+        "removed",
+        CesiumPrimitiveMerging::mergeSmallPrimitives(model),
+        0);
+  });
+}
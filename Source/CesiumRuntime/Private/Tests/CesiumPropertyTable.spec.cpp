@@ -666,6 +666,135 @@ void FCesiumPropertyTableSpec::Define() {
     });
   });
 
+  Describe("GetMetadataValuesForFeatures", [this]() {
+    BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
+
+    It("returns the values of each property for each feature", [this]() {
+      std::string scalarPropertyName("scalarProperty");
+      std::vector<int32_t> scalarValues{1, 2, 3, 4};
+      pPropertyTable->count = static_cast<int64_t>(scalarValues.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          scalarPropertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          scalarValues);
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+
+      const TArray<int64> featureIDs{2, -1, 0, 10};
+      const TArray<FString> propertyNames{
+          FString(scalarPropertyName.c_str()),
+          TEXT("missingProperty")};
+      const TArray<FCesiumPropertyTableValues> result =
+          UCesiumPropertyTableBlueprintLibrary::GetMetadataValuesForFeatures(
+              propertyTable,
+              featureIDs,
+              propertyNames);
+      if (!TestEqual("number of properties", result.Num(), 2)) {
+        return;
+      }
+
+      const FCesiumPropertyTableValues& scalar = result[0];
+      TestEqual("scalar name", scalar.PropertyName, propertyNames[0]);
+      TestEqual(
+          "scalar type",
+          scalar.ValueType.ComponentType,
+          ECesiumMetadataComponentType::Int32);
+      if (TestEqual("number of scalar values", scalar.Values.Num(), 4)) {
+        TestEqual(
+            "value for feature 2",
+            UCesiumMetadataValueBlueprintLibrary::GetInteger(
+                scalar.Values[0],
+                0),
+            scalarValues[2]);
+        TestTrue(
+            "no value for negative feature ID",
+            UCesiumMetadataValueBlueprintLibrary::IsEmpty(scalar.Values[1]));
+        TestEqual(
+            "value for feature 0",
+            UCesiumMetadataValueBlueprintLibrary::GetInteger(
+                scalar.Values[2],
+                0),
+            scalarValues[0]);
+        TestTrue(
+            "no value for out-of-range feature ID",
+            UCesiumMetadataValueBlueprintLibrary::IsEmpty(scalar.Values[3]));
+      }
+
+      const FCesiumPropertyTableValues& missing = result[1];
+      TestEqual("missing name", missing.PropertyName, propertyNames[1]);
+      if (TestEqual("number of missing values", missing.Values.Num(), 4)) {
+        for (const FCesiumMetadataValue& value : missing.Values) {
+          TestTrue(
+              "no value for missing property",
+              UCesiumMetadataValueBlueprintLibrary::IsEmpty(value));
+        }
+      }
+    });
+  });
+
+  Describe("CopyMetadataValuesForFeatures", [this]() {
+    BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
+
+    It("replaces the values in the buffer", [this]() {
+      std::string scalarPropertyName("scalarProperty");
+      std::vector<int32_t> scalarValues{1, 2, 3, 4};
+      pPropertyTable->count = static_cast<int64_t>(scalarValues.size());
+      AddPropertyTablePropertyToModel(
+          model,
+          *pPropertyTable,
+          scalarPropertyName,
+          ClassProperty::Type::SCALAR,
+          ClassProperty::ComponentType::INT32,
+          scalarValues);
+
+      FCesiumPropertyTable propertyTable(model, *pPropertyTable);
+
+      const TArray<FString> propertyNames{
+          TEXT("missingProperty"),
+          FString(scalarPropertyName.c_str())};
+      FCesiumPropertyTableValuesBuffer buffer;
+      UCesiumPropertyTableBlueprintLibrary::CopyMetadataValuesForFeatures(
+          propertyTable,
+          TArray<int64>{0, 1, 2},
+          propertyNames,
+          buffer);
+      TestEqual("first feature count", buffer.GetFeatureCount(), 3);
+
+      const TArray<int64> featureIDs{3, 7};
+      UCesiumPropertyTableBlueprintLibrary::CopyMetadataValuesForFeatures(
+          propertyTable,
+          featureIDs,
+          propertyNames,
+          buffer);
+      if (!TestEqual("property count", buffer.GetPropertyCount(), 2) ||
+          !TestEqual("feature count", buffer.GetFeatureCount(), 2)) {
+        return;
+      }
+
+      TestTrue(
+          "no value for missing property",
+          UCesiumMetadataValueBlueprintLibrary::IsEmpty(
+              buffer.GetValues(0)[0]));
+      TestEqual(
+          "scalar type",
+          buffer.GetValueType(1).ComponentType,
+          ECesiumMetadataComponentType::Int32);
+      TestEqual(
+          "value for feature 3",
+          UCesiumMetadataValueBlueprintLibrary::GetInteger(
+              buffer.GetValues(1)[0],
+              0),
+          scalarValues[3]);
+      TestTrue(
+          "no value for out-of-range feature ID",
+          UCesiumMetadataValueBlueprintLibrary::IsEmpty(
+              buffer.GetValues(1)[1]));
+    });
+  });
+
   Describe("GetMetadataValuesForFeatureAsStrings", [this]() {
     BeforeEach([this]() { pPropertyTable->classProperty = "testClass"; });
 
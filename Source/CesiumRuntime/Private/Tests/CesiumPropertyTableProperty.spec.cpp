@@ -1789,6 +1789,95 @@ void FCesiumPropertyTablePropertySpec::Define() {
     });
   });
 
+  Describe("GetFloat64Values", [this]() {
+    It("returns default values for invalid property", [this]() {
+      FCesiumPropertyTableProperty property;
+      TArray<double> result =
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64Values(
+              property,
+              0,
+              2,
+              -1.0);
+      TestEqual("number of values", result.Num(), 2);
+      TestEqual("value0", result[0], -1.0);
+      TestEqual("value1", result[1], -1.0);
+    });
+
+    It("gets normalized values with offset and scale", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+      classProperty.offset = 1.0;
+      classProperty.scale = 2.0;
+
+      std::vector<uint8_t> values{0, 64, 128, 255};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<uint8_t, true> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+
+      // Start before the first feature and end after the last.
+      TArray<double> result =
+          UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64Values(
+              property,
+              -1,
+              int64(values.size()) + 2,
+              -1.0);
+      if (!TestEqual(
+              "number of values",
+              result.Num(),
+              int32(values.size()) + 2)) {
+        return;
+      }
+
+      TestEqual("before first feature", result[0], -1.0);
+      for (size_t i = 0; i < values.size(); i++) {
+        TestEqual(
+            std::string("value" + std::to_string(i)).c_str(),
+            result[int32(i) + 1],
+            UCesiumPropertyTablePropertyBlueprintLibrary::GetFloat64(
+                property,
+                int64(i)));
+      }
+      TestEqual("after last feature", result.Last(), -1.0);
+    });
+
+    It("gets values that match the property's no data value", [this]() {
+      PropertyTableProperty propertyTableProperty;
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::INT32;
+      classProperty.noData = 0;
+      classProperty.defaultProperty = 10;
+
+      std::vector<int32_t> values{-1, 0, 1};
+      std::vector<std::byte> data = GetValuesAsBytes(values);
+
+      PropertyTablePropertyView<int32_t> propertyView(
+          propertyTableProperty,
+          classProperty,
+          static_cast<int64_t>(values.size()),
+          gsl::span<const std::byte>(data.data(), data.size()));
+      FCesiumPropertyTableProperty property(propertyView);
+
+      TArray<double> result;
+      result.SetNum(int32(values.size()));
+      UCesiumPropertyTablePropertyBlueprintLibrary::CopyFloat64Values(
+          property,
+          0,
+          result);
+      TestEqual("value0", result[0], -1.0);
+      TestEqual("value1", result[1], 10.0);
+      TestEqual("value2", result[2], 1.0);
+    });
+  });
+
   Describe("GetIntPoint", [this]() {
     It("returns default value for invalid property", [this]() {
       FCesiumPropertyTableProperty property;
@@ -1040,6 +1040,97 @@ void FCesiumPropertyTexturePropertySpec::Define() {
     });
   });
 
+  Describe("GetFloat64Values", [this]() {
+    It("matches GetFloat64 for every texture coordinate", [this]() {
+      PropertyTextureProperty propertyTextureProperty;
+      propertyTextureProperty.channels = {0};
+
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.normalized = true;
+      classProperty.offset = 5.0;
+      classProperty.scale = 2.0;
+
+      Sampler sampler;
+      ImageCesium image;
+      image.width = 2;
+      image.height = 2;
+      image.channels = 1;
+      image.bytesPerChannel = 1;
+
+      std::vector<uint8_t> values{0, 128, 255, 0};
+      image.pixelData = GetValuesAsBytes(values);
+
+      PropertyTexturePropertyView<uint8, true> propertyView(
+          propertyTextureProperty,
+          classProperty,
+          sampler,
+          image);
+      FCesiumPropertyTextureProperty property(propertyView);
+
+      // Enough coordinates to be sampled by several threads.
+      TArray<FVector2D> uvs;
+      for (int32 i = 0; i < 10000; ++i) {
+        uvs.Add(texCoords[i % texCoords.size()]);
+      }
+
+      const TArray<double> result =
+          UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64Values(
+              property,
+              uvs);
+      if (!TestEqual("count", result.Num(), uvs.Num())) {
+        return;
+      }
+      for (int32 i = 0; i < uvs.Num(); ++i) {
+        const double expected =
+            UCesiumPropertyTexturePropertyBlueprintLibrary::GetFloat64(
+                property,
+                uvs[i]);
+        if (!TestEqual("value", result[i], expected)) {
+          break;
+        }
+      }
+    });
+  });
+
+  Describe("GetIntegerValues", [this]() {
+    It("uses the default value for no data", [this]() {
+      PropertyTextureProperty propertyTextureProperty;
+      propertyTextureProperty.channels = {0};
+
+      ClassProperty classProperty;
+      classProperty.type = ClassProperty::Type::SCALAR;
+      classProperty.componentType = ClassProperty::ComponentType::UINT8;
+      classProperty.noData = 255;
+
+      Sampler sampler;
+      ImageCesium image;
+      image.width = 2;
+      image.height = 2;
+      image.channels = 1;
+      image.bytesPerChannel = 1;
+
+      std::vector<uint8_t> values{255, 7, 3, 255};
+      image.pixelData = GetValuesAsBytes(values);
+
+      PropertyTexturePropertyView<uint8> propertyView(
+          propertyTextureProperty,
+          classProperty,
+          sampler,
+          image);
+      FCesiumPropertyTextureProperty property(propertyView);
+
+      const TArray<FVector2D> uvs(texCoords.data(), int32(texCoords.size()));
+      const TArray<int32> result =
+          UCesiumPropertyTexturePropertyBlueprintLibrary::GetIntegerValues(
+              property,
+              uvs,
+              -1);
+      TestEqual("values", result, TArray<int32>{-1, 7, 3, -1});
+    });
+  });
+
   Describe("GetIntPoint", [this]() {
     It("returns default value for invalid property", [this]() {
       FCesiumPropertyTextureProperty property;
@@ -0,0 +1,151 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRangeAssetAccessor.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "Misc/AutomationTest.h"
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using CesiumTestHelpers::TestAssetRequest;
+using CesiumTestHelpers::TestAssetResponse;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumRangeAssetAccessorSpec,
+    "Cesium.Unit.RangeAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumRangeAssetAccessorSpec)
+
+namespace {
+
+/**
+ * Answers every request with the same content, or the part of it in the
+ * request's range if ranges are supported, and records the ranges asked
+ * for.
+ */
+class ContentAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  explicit ContentAssetAccessor(size_t size, bool supportsRanges = true)
+      : content(size), supportsRanges(supportsRanges), ranges() {
+    for (size_t i = 0; i < size; ++i) {
+      this->content[i] = std::byte(i * 7);
+    }
+  }
+
+  std::vector<std::byte> content;
+  bool supportsRanges;
+  std::vector<std::string> ranges;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    auto range = std::find_if(
+        headers.begin(),
+        headers.end(),
+        [](const THeader& header) { return header.first == "Range"; });
+    this->ranges.emplace_back(
+        range == headers.end() ? std::string() : range->second);
+
+    uint16_t statusCode = 200;
+    CesiumAsync::HttpHeaders responseHeaders{
+        {"Content-Type", "model/gltf-binary"}};
+    std::vector<std::byte> data = this->content;
+    if (range != headers.end() && this->supportsRanges) {
+      char* pEnd = nullptr;
+      const size_t first =
+          std::strtoull(range->second.c_str() + 6, &pEnd, 10);
+      const size_t last = std::min<size_t>(
+          std::strtoull(pEnd + 1, nullptr, 10),
+          this->content.size() - 1);
+      statusCode = 206;
+      responseHeaders.emplace(
+          "Content-Range",
+          "bytes " + std::to_string(first) + "-" + std::to_string(last) +
+              "/" + std::to_string(this->content.size()));
+      data.assign(
+          this->content.begin() + first,
+          this->content.begin() + last + 1);
+    }
+
+    return asyncSystem.createResolvedFuture<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>(
+        std::make_shared<TestAssetRequest>(
+            url,
+            CesiumAsync::HttpHeaders(headers.begin(), headers.end()),
+            TestAssetResponse(
+                statusCode,
+                std::move(responseHeaders),
+                std::move(data))));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+bool hasContent(
+    const CesiumAsync::IAssetRequest& request,
+    const std::vector<std::byte>& content) {
+  const gsl::span<const std::byte> data = request.response()->data();
+  return data.size() == content.size() &&
+         std::equal(data.begin(), data.end(), content.begin());
+}
+
+} // namespace
+
+void FCesiumRangeAssetAccessorSpec::Define() {
+  It("puts large content together from several ranges", [this]() {
+    auto pNetwork = std::make_shared<ContentAssetAccessor>(30);
+    auto pAccessor = std::make_shared<CesiumRangeAssetAccessor>(pNetwork, 4);
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest =
+        pAccessor->get(getAsyncSystem(), "https://example.com/0/0.glb?v=1", {})
+            .wait();
+
+    TestEqual("status", int32(pRequest->response()->statusCode()), 200);
+    TestTrue("content", hasContent(*pRequest, pNetwork->content));
+    TestTrue(
+        "no Content-Range",
+        pRequest->response()->headers().count("Content-Range") == 0);
+    TestTrue("no Range", pRequest->headers().count("Range") == 0);
+    TestTrue("first range", pNetwork->ranges[0] == "bytes=0-3");
+    TestEqual("requests", pNetwork->ranges.size(), size_t(8));
+  });
+
+  It("uses the whole response of servers that ignore ranges", [this]() {
+    auto pNetwork = std::make_shared<ContentAssetAccessor>(30, false);
+    auto pAccessor = std::make_shared<CesiumRangeAssetAccessor>(pNetwork, 4);
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest =
+        pAccessor->get(getAsyncSystem(), "https://example.com/0/0.b3dm", {})
+            .wait();
+
+    TestTrue("content", hasContent(*pRequest, pNetwork->content));
+    TestEqual("requests", pNetwork->ranges.size(), size_t(1));
+  });
+
+  It("requests other content whole", [this]() {
+    auto pNetwork = std::make_shared<ContentAssetAccessor>(30);
+    auto pAccessor = std::make_shared<CesiumRangeAssetAccessor>(pNetwork, 4);
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRequest =
+        pAccessor->get(getAsyncSystem(), "https://example.com/tileset.json", {})
+            .wait();
+
+    TestTrue("content", hasContent(*pRequest, pNetwork->content));
+    TestEqual("requests", pNetwork->ranges.size(), size_t(1));
+    TestTrue("no range", pNetwork->ranges[0].empty());
+  });
+}
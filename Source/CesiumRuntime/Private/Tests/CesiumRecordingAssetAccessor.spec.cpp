@@ -0,0 +1,153 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRecordingAssetAccessor.h"
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+using CesiumTestHelpers::TestAssetRequest;
+using CesiumTestHelpers::TestAssetResponse;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumRecordingAssetAccessorSpec,
+    "Cesium.Unit.RecordingAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+FString archiveDirectory;
+END_DEFINE_SPEC(FCesiumRecordingAssetAccessorSpec)
+
+namespace {
+
+/**
+ * Answers every request immediately with its URL as the body, and counts the
+ * requests it answers.
+ */
+class EchoAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  int32 requestCount = 0;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    ++this->requestCount;
+    std::vector<std::byte> body(url.size());
+    std::memcpy(body.data(), url.data(), url.size());
+    return asyncSystem.createResolvedFuture<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>(
+        std::make_shared<TestAssetRequest>(
+            url,
+            CesiumAsync::HttpHeaders(),
+            TestAssetResponse(
+                200,
+                {{"Content-Type", "application/json"}},
+                std::move(body))));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+std::string getBody(const CesiumAsync::IAssetRequest& request) {
+  const gsl::span<const std::byte> data = request.response()->data();
+  return std::string(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+} // namespace
+
+void FCesiumRecordingAssetAccessorSpec::Define() {
+  BeforeEach([this]() {
+    archiveDirectory = FPaths::CreateTempFilename(
+        *FPaths::ProjectIntermediateDir(),
+        TEXT("CesiumRequestArchive"));
+  });
+
+  AfterEach([this]() {
+    IFileManager::Get().DeleteDirectory(*archiveDirectory, false, true);
+  });
+
+  It("replays recorded responses without the network", [this]() {
+    const std::string directory = TCHAR_TO_UTF8(*archiveDirectory);
+    const std::string url = "https://example.com/tileset.json?v=1";
+
+    auto pNetwork = std::make_shared<EchoAssetAccessor>();
+    auto pRecorder = std::make_shared<CesiumRecordingAssetAccessor>(
+        pNetwork,
+        CesiumRecordingAssetAccessor::Mode::Record,
+        directory);
+    pRecorder->get(getAsyncSystem(), url, {}).wait();
+    TestEqual("requestCount", pNetwork->requestCount, 1);
+
+    auto pOffline = std::make_shared<EchoAssetAccessor>();
+    auto pPlayer = std::make_shared<CesiumRecordingAssetAccessor>(
+        pOffline,
+        CesiumRecordingAssetAccessor::Mode::Replay,
+        directory);
+    std::shared_ptr<CesiumAsync::IAssetRequest> pRecorded =
+        pPlayer->get(getAsyncSystem(), url, {{"Authorization", "other"}})
+            .wait();
+    TestEqual("offline requestCount", pOffline->requestCount, 0);
+    TestEqual("status", pRecorded->response()->statusCode(), uint16_t(200));
+    TestEqual("body", getBody(*pRecorded), url);
+    TestEqual(
+        "contentType",
+        pRecorded->response()->contentType(),
+        std::string("application/json"));
+
+    std::shared_ptr<CesiumAsync::IAssetRequest> pMissing =
+        pPlayer->get(getAsyncSystem(), url + "&v=2", {}).wait();
+    TestEqual("missing", pMissing->response()->statusCode(), uint16_t(404));
+    TestEqual("missCount", pPlayer->getMissCount(), 1);
+  });
+
+  It("delays replayed responses until ticked after the latency", [this]() {
+    const std::string directory = TCHAR_TO_UTF8(*archiveDirectory);
+    const std::string url = "https://example.com/tiles/1/0/0.glb";
+
+    std::make_shared<CesiumRecordingAssetAccessor>(
+        std::make_shared<EchoAssetAccessor>(),
+        CesiumRecordingAssetAccessor::Mode::Record,
+        directory)
+        ->get(getAsyncSystem(), url, {})
+        .wait();
+
+    auto pPlayer = std::make_shared<CesiumRecordingAssetAccessor>(
+        nullptr,
+        CesiumRecordingAssetAccessor::Mode::Replay,
+        directory,
+        0.05);
+
+    std::atomic<bool> done(false);
+    const double start = FPlatformTime::Seconds();
+    pPlayer->get(getAsyncSystem(), url, {})
+        .thenImmediately(
+            [&done](std::shared_ptr<CesiumAsync::IAssetRequest>&&) {
+              done = true;
+            });
+
+    while (!done && FPlatformTime::Seconds() - start < 5.0) {
+      getAsyncSystem().dispatchMainThreadTasks();
+      pPlayer->tick();
+      FPlatformProcess::Sleep(0.001f);
+    }
+
+    TestTrue("done", bool(done));
+    TestTrue("delayed", FPlatformTime::Seconds() - start >= 0.05);
+  });
+}
@@ -0,0 +1,81 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumReplicatedGlobeTransform.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumReplicatedGlobeTransformSpec,
+    "Cesium.Unit.ReplicatedGlobeTransform",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+FCesiumReplicatedGlobeTransform
+roundTrip(const FCesiumReplicatedGlobeTransform& transform, int64& numBits) {
+  FCesiumReplicatedGlobeTransform source = transform;
+  bool success = false;
+  FBitWriter writer(0, true);
+  source.NetSerialize(writer, nullptr, success);
+  TestTrue("written", success);
+  numBits = writer.GetNumBits();
+
+  FCesiumReplicatedGlobeTransform result;
+  FBitReader reader(writer.GetData(), writer.GetNumBits());
+  result.NetSerialize(reader, nullptr, success);
+  TestTrue("read", success);
+  return result;
+}
+
+END_DEFINE_SPEC(FCesiumReplicatedGlobeTransformSpec)
+
+void FCesiumReplicatedGlobeTransformSpec::Define() {
+  It("keeps positions on the globe to a centimeter", [this]() {
+    const FTransform original(
+        FQuat(FVector(1.0, 2.0, 3.0).GetSafeNormal(), 0.7),
+        FVector(1215107.7636, -4736682.9043, 4081926.0951));
+    const FCesiumReplicatedGlobeTransform quantized =
+        FCesiumReplicatedGlobeTransform::FromMatrix(
+            original.ToMatrixWithScale());
+
+    int64 numBits = 0;
+    const FCesiumReplicatedGlobeTransform received =
+        this->roundTrip(quantized, numBits);
+
+    TestTrue("equal", received == quantized);
+    TestTrue("compact", numBits < 8 * 20);
+
+    const FTransform result(received.ToMatrix());
+    TestTrue(
+        "position",
+        result.GetLocation().Equals(original.GetLocation(), 0.005));
+    TestTrue(
+        "rotation",
+        result.GetRotation().AngularDistance(original.GetRotation()) < 1e-4);
+    TestTrue("scale", result.GetScale3D().Equals(FVector::OneVector));
+  });
+
+  It("keeps distant positions and scales in full", [this]() {
+    const FTransform original(
+        FQuat::Identity,
+        FVector(42164000.0, 0.25, -3.5),
+        FVector(2.0, 3.0, 4.0));
+    const FCesiumReplicatedGlobeTransform quantized =
+        FCesiumReplicatedGlobeTransform::FromMatrix(
+            original.ToMatrixWithScale());
+
+    int64 numBits = 0;
+    const FCesiumReplicatedGlobeTransform received =
+        this->roundTrip(quantized, numBits);
+
+    TestTrue("equal", received == quantized);
+
+    const FTransform result(received.ToMatrix());
+    TestTrue(
+        "position",
+        result.GetLocation().Equals(original.GetLocation(), 1e-6));
+    TestTrue(
+        "scale",
+        result.GetScale3D().Equals(original.GetScale3D(), 1e-6));
+  });
+}
@@ -11,6 +11,8 @@
 
 #include "Cesium3DTileset.h"
 #include "CesiumGeoreference.h"
+#include "CesiumMemoryUsageTracker.h"
+#include "CesiumStats.h"
 #include "CesiumSunSky.h"
 #include "GlobeAwareDefaultPawn.h"
 
@@ -76,6 +78,52 @@ bool SceneGenerationContext::areTilesetsDoneLoading() {
   return true;
 }
 
+int64 SceneGenerationContext::getTilesLoaded() {
+  int64 count = 0;
+  for (ACesium3DTileset* tileset : tilesets)
+    count += tileset->GetMemoryUsageTracker().getComponentsAdded();
+  return count;
+}
+
+int64 SceneGenerationContext::getTilesUnloaded() {
+  int64 count = 0;
+  for (ACesium3DTileset* tileset : tilesets)
+    count += tileset->GetMemoryUsageTracker().getComponentsRemoved();
+  return count;
+}
+
+int64 SceneGenerationContext::getTileMemoryBytes() {
+  int64 bytes = 0;
+  for (ACesium3DTileset* tileset : tilesets) {
+    const FCesiumMemoryUsage usage = tileset->GetMemoryUsage();
+    bytes += usage.TextureBytes + usage.VertexBytes + usage.IndexBytes +
+             usage.CollisionBytes + usage.MaterialBytes;
+  }
+  return bytes;
+}
+
+int64 SceneGenerationContext::getTilesVisited() {
+  int64 count = 0;
+  for (ACesium3DTileset* tileset : tilesets)
+    count += CesiumStats::getTileset(tileset).tilesVisited;
+  return count;
+}
+
+int64 SceneGenerationContext::getTilesRendered() {
+  int64 count = 0;
+  for (ACesium3DTileset* tileset : tilesets)
+    count += CesiumStats::getTileset(tileset).tilesRendered;
+  return count;
+}
+
+void SceneGenerationContext::setCamera(
+    const FVector& position,
+    const FRotator& rotation) {
+  startPosition = position;
+  startRotation = rotation;
+  syncWorldCamera();
+}
+
 void SceneGenerationContext::trackForPlay() {
   CesiumTestHelpers::trackForPlay(sunSky);
   CesiumTestHelpers::trackForPlay(georeference);
@@ -37,6 +37,20 @@ struct SceneGenerationContext {
   void setMaximumSimultaneousTileLoads(int32 value);
   bool areTilesetsDoneLoading();
 
+  // The numbers of tiles with content that the tilesets have loaded and
+  // unloaded since they were created, and the memory that their loaded tiles
+  // take.
+  int64 getTilesLoaded();
+  int64 getTilesUnloaded();
+  int64 getTileMemoryBytes();
+
+  // The numbers of tiles that the tilesets visited and rendered in their most
+  // recent view updates.
+  int64 getTilesVisited();
+  int64 getTilesRendered();
+
+  void setCamera(const FVector& position, const FRotator& rotation);
+
   void trackForPlay();
   void initForPlay(SceneGenerationContext& creationContext);
   void syncWorldCamera();
@@ -0,0 +1,69 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScreenSpaceErrorController.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumScreenSpaceErrorControllerSpec,
+    "Cesium.Unit.ScreenSpaceErrorController",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumScreenSpaceErrorControllerSpec)
+
+void FCesiumScreenSpaceErrorControllerSpec::Define() {
+  const CesiumScreenSpaceErrorController::Settings settings;
+
+  It("holds the screen-space error within the tolerance", [this, settings]() {
+    CesiumScreenSpaceErrorController controller;
+    controller.reset(16.0);
+    for (int i = 0; i < 10; ++i) {
+      controller.update(settings, 0.05, 0.1);
+      controller.update(settings, -0.05, 0.1);
+    }
+    TestEqual("screen-space error", controller.getScreenSpaceError(), 16.0);
+  });
+
+  It("raises the screen-space error when too slow", [this, settings]() {
+    CesiumScreenSpaceErrorController controller;
+    controller.reset(16.0);
+    const double first = controller.update(settings, 0.5, 0.1);
+    const double second = controller.update(settings, 0.5, 0.1);
+    TestTrue("raised", first > 16.0);
+    TestTrue("keeps raising", second > first);
+  });
+
+  It("lowers the screen-space error with time to spare", [this, settings]() {
+    CesiumScreenSpaceErrorController controller;
+    controller.reset(16.0);
+    TestTrue("lowered", controller.update(settings, -0.5, 0.1) < 16.0);
+  });
+
+  It("stays within the limits without winding up", [this, settings]() {
+    CesiumScreenSpaceErrorController controller;
+    controller.reset(16.0);
+    for (int i = 0; i < 10; ++i) {
+      controller.update(settings, 10.0, 1.0);
+    }
+    TestEqual(
+        "maximum",
+        controller.getScreenSpaceError(),
+        settings.maximumScreenSpaceError);
+    TestTrue(
+        "recovers immediately",
+        controller.update(settings, -0.5, 0.1) <
+            settings.maximumScreenSpaceError);
+  });
+
+  It("keeps correcting until well within the tolerance", [this, settings]() {
+    CesiumScreenSpaceErrorController controller;
+    controller.reset(16.0);
+    controller.update(settings, 0.08, 0.1);
+    TestFalse("starts within the tolerance", controller.isCorrecting());
+    controller.update(settings, 0.2, 0.1);
+    TestTrue("starts correcting", controller.isCorrecting());
+    controller.update(settings, 0.08, 0.1);
+    TestTrue("keeps correcting", controller.isCorrecting());
+    controller.update(settings, 0.01, 0.1);
+    TestFalse("stops correcting", controller.isCorrecting());
+  });
+}
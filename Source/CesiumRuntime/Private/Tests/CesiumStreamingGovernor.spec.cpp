@@ -0,0 +1,50 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumStreamingGovernor.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumStreamingGovernor;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumStreamingGovernorSpec,
+    "Cesium.Unit.StreamingGovernor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumStreamingGovernorSpec)
+
+void FCesiumStreamingGovernorSpec::Define() {
+  It("has no pressure on a cool device that is plugged in", [this]() {
+    DeviceState state;
+    state.batteryLevel = 5;
+    TestEqual("pressure", computePressure(state, 30), 0.0);
+  });
+
+  It("follows the thermal state", [this]() {
+    DeviceState state;
+    state.thermalLevel = 2.0 / 3.0;
+    TestEqual("pressure", computePressure(state, 30), 2.0 / 3.0);
+    state.thermalLevel = 1.5;
+    TestEqual("clamped pressure", computePressure(state, 30), 1.0);
+  });
+
+  It("grows as the battery drains below the threshold", [this]() {
+    DeviceState state;
+    state.isRunningOnBattery = true;
+    state.batteryLevel = 50;
+    TestEqual("above threshold", computePressure(state, 40), 0.0);
+    state.batteryLevel = 10;
+    TestEqual("below threshold", computePressure(state, 40), 0.75);
+    state.batteryLevel = -1;
+    TestEqual("unknown level", computePressure(state, 40), 0.0);
+  });
+
+  It("takes the largest of the pressures", [this]() {
+    DeviceState state;
+    state.isLowPowerMode = true;
+    state.isRunningOnBattery = true;
+    state.batteryLevel = 20;
+    TestEqual("low power mode", computePressure(state, 30), 0.5);
+    state.thermalLevel = 1.0;
+    TestEqual("critical temperature", computePressure(state, 30), 1.0);
+  });
+}
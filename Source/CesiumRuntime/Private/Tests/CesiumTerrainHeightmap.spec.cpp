@@ -0,0 +1,191 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTerrainHeightmap.h"
+#include "Misc/AutomationTest.h"
+#include <Cesium3DTilesContent/SkirtMeshMetadata.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace CesiumGeospatial;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTerrainHeightmapSpec,
+    "Cesium.Unit.TerrainHeightmap",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+const double West = 0.001;
+const double South = 0.002;
+const double Size = 0.0001;
+const double Height = 100.0;
+
+CesiumGltf::MeshPrimitive primitive;
+TArray<FVector3f> positions;
+TArray<uint32> indices;
+glm::dmat4 transform;
+
+glm::dvec3 getEcef(double longitude, double latitude) {
+  return Ellipsoid::WGS84.cartographicToCartesian(
+      Cartographic(longitude, latitude, Height));
+}
+
+END_DEFINE_SPEC(FCesiumTerrainHeightmapSpec)
+
+void FCesiumTerrainHeightmapSpec::Define() {
+  BeforeEach([this]() {
+    // A flat quad, at the same height above the ellipsoid everywhere, whose
+    // skirts are left out.
+    const glm::dvec3 center =
+        this->getEcef(West + 0.5 * Size, South + 0.5 * Size);
+    this->transform = glm::translate(glm::dmat4(1.0), center);
+
+    this->positions.Empty();
+    for (int32 corner = 0; corner < 4; ++corner) {
+      const glm::dvec3 ecef = this->getEcef(
+          West + ((corner == 1 || corner == 2) ? Size : 0.0),
+          South + (corner >= 2 ? Size : 0.0));
+      const glm::dvec3 local = ecef - center;
+      this->positions.Add(FVector3f(local.x, local.y, local.z));
+    }
+    this->indices = {0, 1, 2, 0, 2, 3};
+
+    Cesium3DTilesContent::SkirtMeshMetadata skirt;
+    skirt.noSkirtIndicesBegin = 0;
+    skirt.noSkirtIndicesCount = 6;
+    skirt.meshCenter = center;
+    skirt.skirtWestHeight = 10.0;
+    skirt.skirtSouthHeight = 20.0;
+    skirt.skirtEastHeight = 10.0;
+    skirt.skirtNorthHeight = 10.0;
+
+    this->primitive = CesiumGltf::MeshPrimitive();
+    this->primitive.extras =
+        Cesium3DTilesContent::SkirtMeshMetadata::createGltfExtras(skirt);
+  });
+
+  Describe("isTerrainPrimitive", [this]() {
+    It("detects primitives with skirt metadata", [this]() {
+      TestTrue(
+          "terrain",
+          CesiumTerrainHeightmap::isTerrainPrimitive(this->primitive));
+      TestFalse(
+          "not terrain",
+          CesiumTerrainHeightmap::isTerrainPrimitive(
+              CesiumGltf::MeshPrimitive()));
+    });
+  });
+
+  Describe("create", [this]() {
+    It("resamples the heights of the triangles", [this]() {
+      CesiumTerrainHeightmap::Resampling resampling;
+      const auto pHeightmap = CesiumTerrainHeightmap::create(
+          this->primitive,
+          this->positions,
+          this->indices,
+          this->transform,
+          Ellipsoid::WGS84,
+          5,
+          resampling);
+      if (!TestTrue("created", pHeightmap.IsValid())) {
+        return;
+      }
+
+      TestEqual("resolution", pHeightmap->Resolution, 5);
+      TestEqual("samples", resampling.Vertices.Num(), 25);
+      TestTrue(
+          "skirt height",
+          FMath::IsNearlyEqual(pHeightmap->SkirtHeight, 20.0f));
+      for (int32 row = 0; row < 5; ++row) {
+        for (int32 column = 0; column < 5; ++column) {
+          const float height =
+              CesiumTerrainHeightmap::getHeight(*pHeightmap, column, row);
+          TestTrue(
+              "height",
+              FMath::IsNearlyEqual(height, float(Height), 0.01f));
+        }
+      }
+    });
+
+    It("rebuilds the positions of the corners", [this]() {
+      CesiumTerrainHeightmap::Resampling resampling;
+      const auto pHeightmap = CesiumTerrainHeightmap::create(
+          this->primitive,
+          this->positions,
+          this->indices,
+          this->transform,
+          Ellipsoid::WGS84,
+          3,
+          resampling);
+      if (!TestTrue("created", pHeightmap.IsValid())) {
+        return;
+      }
+
+      // The positions are in the coordinates of the static mesh, whose Y axis
+      // is inverted.
+      const FVector3f southWest =
+          CesiumTerrainHeightmap::getPosition(*pHeightmap, 0, 0);
+      const FVector3f northEast =
+          CesiumTerrainHeightmap::getPosition(*pHeightmap, 2, 2);
+      TestTrue(
+          "south-west",
+          southWest.Equals(
+              this->positions[0] * FVector3f(1.0f, -1.0f, 1.0f),
+              0.01f));
+      TestTrue(
+          "north-east",
+          northEast.Equals(
+              this->positions[2] * FVector3f(1.0f, -1.0f, 1.0f),
+              0.01f));
+    });
+
+    It("rejects primitives without skirt metadata", [this]() {
+      CesiumTerrainHeightmap::Resampling resampling;
+      const auto pHeightmap = CesiumTerrainHeightmap::create(
+          CesiumGltf::MeshPrimitive(),
+          this->positions,
+          this->indices,
+          this->transform,
+          Ellipsoid::WGS84,
+          3,
+          resampling);
+      TestFalse("created", pHeightmap.IsValid());
+    });
+  });
+
+  Describe("resampleTexCoords", [this]() {
+    It("interpolates the texture coordinates of the vertices", [this]() {
+      CesiumTerrainHeightmap::Resampling resampling;
+      const auto pHeightmap = CesiumTerrainHeightmap::create(
+          this->primitive,
+          this->positions,
+          this->indices,
+          this->transform,
+          Ellipsoid::WGS84,
+          3,
+          resampling);
+      if (!TestTrue("created", pHeightmap.IsValid())) {
+        return;
+      }
+
+      const TArray<TArray<FVector2f>> texCoords = {
+          {FVector2f(0.0f, 0.0f),
+           FVector2f(1.0f, 0.0f),
+           FVector2f(1.0f, 1.0f),
+           FVector2f(0.0f, 1.0f)}};
+      CesiumTerrainHeightmap::resampleTexCoords(
+          *pHeightmap,
+          resampling,
+          texCoords);
+
+      TestEqual("channels", pHeightmap->NumTexCoords, 1);
+      TestTrue(
+          "center",
+          pHeightmap->TexCoords[4].Equals(FVector2f(0.5f, 0.5f), 0.01f));
+      TestTrue(
+          "north-east",
+          pHeightmap->TexCoords[8].Equals(FVector2f(1.0f, 1.0f), 0.01f));
+    });
+  });
+}
@@ -1,6 +1,7 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumTestHelpers.h"
+#include "CesiumAsync/CacheItem.h"
 #include "CesiumGeoreference.h"
 #include "Engine/Engine.h"
 
@@ -72,4 +73,103 @@ void trackForPlay(UActorComponent* pEditorComponent) {
   pEditorComponent->ComponentTags.Add(getUniqueTag(pEditorComponent));
 }
 
+
+TestAssetResponse::TestAssetResponse(
+    uint16_t statusCode,
+    CesiumAsync::HttpHeaders headers,
+    std::vector<std::byte> data)
+    : _statusCode(statusCode),
+      _headers(std::move(headers)),
+      _data(std::move(data)) {}
+
+uint16_t TestAssetResponse::statusCode() const { return this->_statusCode; }
+
+std::string TestAssetResponse::contentType() const {
+  auto it = this->_headers.find("Content-Type");
+  return it == this->_headers.end() ? std::string() : it->second;
+}
+
+const CesiumAsync::HttpHeaders& TestAssetResponse::headers() const {
+  return this->_headers;
+}
+
+gsl::span<const std::byte> TestAssetResponse::data() const {
+  return gsl::span<const std::byte>(this->_data.data(), this->_data.size());
+}
+
+TestAssetRequest::TestAssetRequest(
+    const std::string& url,
+    CesiumAsync::HttpHeaders headers,
+    TestAssetResponse response)
+    : _method("GET"),
+      _url(url),
+      _headers(std::move(headers)),
+      _response(std::move(response)) {}
+
+const std::string& TestAssetRequest::method() const { return this->_method; }
+
+const std::string& TestAssetRequest::url() const { return this->_url; }
+
+const CesiumAsync::HttpHeaders& TestAssetRequest::headers() const {
+  return this->_headers;
+}
+
+const CesiumAsync::IAssetResponse* TestAssetRequest::response() const {
+  return &this->_response;
+}
+
+std::optional<CesiumAsync::CacheItem>
+TestCacheDatabase::getEntry(const std::string& key) const {
+  ++this->getCount;
+  auto it = this->entries.find(key);
+  if (it == this->entries.end()) {
+    return std::nullopt;
+  }
+  return CesiumAsync::CacheItem(
+      it->second.expiryTime,
+      CesiumAsync::CacheRequest({}, "GET", key),
+      CesiumAsync::CacheResponse(200, {}, it->second.data));
+}
+
+bool TestCacheDatabase::storeEntry(
+    const std::string& key,
+    std::time_t expiryTime,
+    const std::string& url,
+    const std::string& requestMethod,
+    const CesiumAsync::HttpHeaders& requestHeaders,
+    uint16_t statusCode,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& responseData) {
+  this->entries[key] = Entry{
+      expiryTime,
+      std::vector<std::byte>(responseData.begin(), responseData.end())};
+  return true;
+}
+
+bool TestCacheDatabase::prune() {
+  ++this->pruneCount;
+  return true;
+}
+
+bool TestCacheDatabase::clearAll() {
+  this->entries.clear();
+  return true;
+}
+
+void storeTestEntry(
+    CesiumAsync::ICacheDatabase& database,
+    const std::string& key,
+    size_t size) {
+  std::vector<std::byte> data(size);
+  database.storeEntry(
+      key,
+      std::time(nullptr) + 3600,
+      key,
+      "GET",
+      {},
+      200,
+      {},
+      gsl::span<const std::byte>(data.data(), data.size()));
+}
+
 } // namespace CesiumTestHelpers
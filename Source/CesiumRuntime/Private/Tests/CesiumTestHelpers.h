@@ -2,12 +2,18 @@
 
 #pragma once
 
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/IAssetResponse.h"
+#include "CesiumAsync/ICacheDatabase.h"
 #include "CesiumRuntime.h"
 #include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Math/MathFwd.h"
 #include "Misc/AutomationTest.h"
 #include "TimerManager.h"
+#include <ctime>
+#include <map>
+#include <vector>
 
 #if WITH_EDITOR
 #include "Editor.h"
@@ -135,6 +141,101 @@ FName getUniqueTag(AActor* pActor);
 /// <returns>The unique tag.</returns>
 FName getUniqueTag(UActorComponent* pComponent);
 
+/// <summary>
+/// A response with fixed contents, for asset accessors that answer requests
+/// without a network. Its content type is that of its Content-Type header.
+/// </summary>
+class TestAssetResponse : public CesiumAsync::IAssetResponse {
+public:
+  TestAssetResponse(
+      uint16_t statusCode,
+      CesiumAsync::HttpHeaders headers,
+      std::vector<std::byte> data);
+
+  virtual uint16_t statusCode() const override;
+
+  virtual std::string contentType() const override;
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override;
+
+  virtual gsl::span<const std::byte> data() const override;
+
+private:
+  uint16_t _statusCode;
+  CesiumAsync::HttpHeaders _headers;
+  std::vector<std::byte> _data;
+};
+
+/// <summary>
+/// A completed GET request with a <see cref="TestAssetResponse" />.
+/// </summary>
+class TestAssetRequest : public CesiumAsync::IAssetRequest {
+public:
+  TestAssetRequest(
+      const std::string& url,
+      CesiumAsync::HttpHeaders headers,
+      TestAssetResponse response);
+
+  virtual const std::string& method() const override;
+
+  virtual const std::string& url() const override;
+
+  virtual const CesiumAsync::HttpHeaders& headers() const override;
+
+  virtual const CesiumAsync::IAssetResponse* response() const override;
+
+private:
+  std::string _method;
+  std::string _url;
+  CesiumAsync::HttpHeaders _headers;
+  TestAssetResponse _response;
+};
+
+/// <summary>
+/// A cache database that keeps its entries in memory and counts the calls
+/// made to it, for testing the databases that wrap another one.
+/// </summary>
+class TestCacheDatabase : public CesiumAsync::ICacheDatabase {
+public:
+  struct Entry {
+    std::time_t expiryTime;
+    std::vector<std::byte> data;
+  };
+
+  std::map<std::string, Entry> entries;
+  mutable int32 getCount = 0;
+  int32 pruneCount = 0;
+
+  virtual std::optional<CesiumAsync::CacheItem>
+  getEntry(const std::string& key) const override;
+
+  virtual bool storeEntry(
+      const std::string& key,
+      std::time_t expiryTime,
+      const std::string& url,
+      const std::string& requestMethod,
+      const CesiumAsync::HttpHeaders& requestHeaders,
+      uint16_t statusCode,
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& responseData) override;
+
+  virtual bool prune() override;
+
+  virtual bool clearAll() override;
+};
+
+/// <summary>
+/// Stores a successful GET response of the given size, which expires in an
+/// hour, in a cache database.
+/// </summary>
+/// <param name="database">The database to store the entry in.</param>
+/// <param name="key">The key of the entry, which is also its URL.</param>
+/// <param name="size">The size of the response data in bytes.</param>
+void storeTestEntry(
+    CesiumAsync::ICacheDatabase& database,
+    const std::string& key,
+    size_t size);
+
 #if WITH_EDITOR
 
 /// <summary>
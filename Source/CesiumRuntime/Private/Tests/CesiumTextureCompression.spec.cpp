@@ -0,0 +1,109 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTextureCompression.h"
+#include "Misc/AutomationTest.h"
+#include <CesiumGltf/ImageCesium.h>
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTextureCompressionSpec,
+    "Cesium.Unit.TextureCompression",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTextureCompressionSpec)
+
+namespace {
+
+ImageCesium createSolidImage(int32_t width, int32_t height, uint8_t alpha) {
+  ImageCesium image;
+  image.width = width;
+  image.height = height;
+  image.channels = 4;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(size_t(width * height * 4));
+  for (size_t i = 0; i < image.pixelData.size(); i += 4) {
+    image.pixelData[i] = std::byte(255);
+    image.pixelData[i + 1] = std::byte(0);
+    image.pixelData[i + 2] = std::byte(0);
+    image.pixelData[i + 3] = std::byte(alpha);
+  }
+  return image;
+}
+
+} // namespace
+
+void FCesiumTextureCompressionSpec::Define() {
+  It("compresses a solid block to BC1", [this]() {
+    ImageCesium image = createSolidImage(4, 4, 255);
+    TestTrue(
+        "compressed",
+        CesiumTextureCompression::compressImage(
+            image,
+            GpuCompressedPixelFormat::BC1_RGB));
+    TestTrue(
+        "format",
+        image.compressedPixelFormat == GpuCompressedPixelFormat::BC1_RGB);
+    if (!TestEqual("size", image.pixelData.size(), size_t(8))) {
+      return;
+    }
+
+    // Pure red is 0xF800 in RGB565, and every texel uses the first color.
+    const uint8_t expected[8] = {0x00, 0xF8, 0x00, 0xF8, 0, 0, 0, 0};
+    for (int32_t i = 0; i < 8; ++i) {
+      TestEqual("byte", uint8_t(image.pixelData[i]), expected[i]);
+    }
+  });
+
+  It("compresses each mip", [this]() {
+    ImageCesium image = createSolidImage(8, 8, 255);
+    image.mipPositions = {{0, 256}};
+    size_t offset = 256;
+    for (int32_t size = 4; size >= 1; size /= 2) {
+      const size_t mipBytes = size_t(size * size * 4);
+      image.mipPositions.push_back({offset, mipBytes});
+      offset += mipBytes;
+    }
+    image.pixelData.resize(offset, std::byte(255));
+
+    TestTrue(
+        "compressed",
+        CesiumTextureCompression::compressImage(
+            image,
+            GpuCompressedPixelFormat::BC3_RGBA));
+    TestEqual("mips", image.mipPositions.size(), size_t(4));
+    TestEqual("size", image.pixelData.size(), size_t(64 + 16 + 16 + 16));
+    TestEqual("last mip offset", image.mipPositions[3].byteOffset, size_t(96));
+  });
+
+  It("compresses uniform alpha exactly to ETC2", [this]() {
+    ImageCesium image = createSolidImage(4, 4, 200);
+    TestTrue(
+        "compressed",
+        CesiumTextureCompression::compressImage(
+            image,
+            GpuCompressedPixelFormat::ETC2_RGBA));
+    if (!TestEqual("size", image.pixelData.size(), size_t(16))) {
+      return;
+    }
+
+    // A base of 200 with a multiplier of 1, and every texel using the zero
+    // modifier of table 13.
+    const uint8_t expected[8] = {200, 0x1D, 0x92, 0x49, 0x24, 0x92, 0x49, 0x24};
+    for (int32_t i = 0; i < 8; ++i) {
+      TestEqual("byte", uint8_t(image.pixelData[i]), expected[i]);
+    }
+  });
+
+  It("leaves images that aren't a multiple of four", [this]() {
+    ImageCesium image = createSolidImage(6, 4, 255);
+    TestFalse(
+        "compressed",
+        CesiumTextureCompression::compressImage(
+            image,
+            GpuCompressedPixelFormat::BC1_RGB));
+    TestTrue(
+        "format",
+        image.compressedPixelFormat == GpuCompressedPixelFormat::NONE);
+  });
+}
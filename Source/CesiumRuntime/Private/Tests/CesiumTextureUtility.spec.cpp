@@ -2,6 +2,7 @@
 
 #include "CesiumTextureUtility.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/CoreDelegates.h"
 #include "RenderingThread.h"
 
 using namespace CesiumGltf;
@@ -37,6 +38,9 @@ void CheckGroup(
 END_DEFINE_SPEC(CesiumTextureUtilitySpec)
 
 void CesiumTextureUtilitySpec::Define() {
+  // Identical images are shared between tests otherwise.
+  AfterEach([this]() { releaseUnusedSharedTextures(); });
+
   Describe("Without Mips", [this]() {
     BeforeEach([this]() {
       originalPixels = {0x20, 0x40, 0x80, 0xF0, 0x21, 0x41, 0x81, 0xF1,
@@ -376,6 +380,57 @@ void CesiumTextureUtilitySpec::RunTests() {
     TestEqual("Same textures", pRefCountedTexture2, pRefCountedTexture);
   });
 
+  It("Loading a shared texture by its source key", [this]() {
+    const uint64 sourceKey = 0x5ca1ab1e;
+    TestNull(
+        "Before loading",
+        loadSharedTextureAnyThreadPart(sourceKey).Get());
+
+    ImageCesium copy = imageCesium;
+    TUniquePtr<LoadedTextureResult> pHalfLoaded = loadTextureAnyThreadPart(
+        copy,
+        TextureAddress::TA_Clamp,
+        TextureAddress::TA_Mirror,
+        TextureFilter::TF_Nearest,
+        false,
+        TEXTUREGROUP_8BitData,
+        false,
+        std::nullopt,
+        nullptr,
+        false,
+        sourceKey);
+    TestNotNull("pHalfLoaded", pHalfLoaded.Get());
+
+    TUniquePtr<LoadedTextureResult> pShared =
+        loadSharedTextureAnyThreadPart(sourceKey);
+    TestNotNull("pShared", pShared.Get());
+    if (!pHalfLoaded || !pShared)
+      return;
+
+    TestEqual("Same textures", pShared->pTexture, pHalfLoaded->pTexture);
+    TestEqual("addressX", pShared->addressX, TextureAddress::TA_Clamp);
+    TestEqual("addressY", pShared->addressY, TextureAddress::TA_Mirror);
+    TestEqual("filter", pShared->filter, TextureFilter::TF_Nearest);
+
+    IntrusivePointer<ReferenceCountedUnrealTexture> pRefCountedTexture =
+        loadTextureGameThreadPart(pHalfLoaded.Get());
+    CheckPixels(pRefCountedTexture);
+    TestEqual(
+        "Shared texture after the game thread part",
+        loadTextureGameThreadPart(pShared.Get()),
+        pRefCountedTexture);
+
+    // Once no tile uses the texture, it can't be found by its source anymore
+    // after the end of the frame.
+    pHalfLoaded.Reset();
+    pShared.Reset();
+    pRefCountedTexture = nullptr;
+    FCoreDelegates::OnEndFrame.Broadcast();
+    TestNull(
+        "After the end of the frame",
+        loadSharedTextureAnyThreadPart(sourceKey).Get());
+  });
+
   It("Loading the same texture twice from one model", [this]() {
     Model model;
 
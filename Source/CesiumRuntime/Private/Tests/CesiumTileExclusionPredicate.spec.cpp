@@ -0,0 +1,98 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileExclusionPredicate.h"
+#include "Misc/AutomationTest.h"
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGltf/ExtensionModelExtStructuralMetadata.h>
+#include <CesiumGltf/Model.h>
+
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileExclusionPredicateSpec,
+    "Cesium.Unit.TileExclusionPredicate",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+BoundingRegion
+createRegion(double west, double south, double east, double north) {
+  return BoundingRegion(
+      GlobeRectangle::fromDegrees(west, south, east, north),
+      0.0,
+      100.0,
+      Ellipsoid::WGS84);
+}
+
+CesiumTileExclusionPredicate createPredicate(bool invertSelection) {
+  std::vector<CesiumTileExclusionPredicate::Region> regions{
+      {GlobeRectangle::fromDegrees(0.0, 0.0, 10.0, 10.0), -10.0, 1000.0}};
+  return CesiumTileExclusionPredicate(
+      Ellipsoid::WGS84,
+      std::move(regions),
+      {},
+      invertSelection,
+      {});
+}
+END_DEFINE_SPEC(FCesiumTileExclusionPredicateSpec)
+
+void FCesiumTileExclusionPredicateSpec::Define() {
+  Describe("excludesBoundingVolume", [this]() {
+    It("excludes tiles entirely inside a region", [this]() {
+      CesiumTileExclusionPredicate predicate = createPredicate(false);
+      TestTrue(
+          "inside",
+          predicate.excludesBoundingVolume(createRegion(1.0, 1.0, 2.0, 2.0)));
+      TestFalse(
+          "partially inside",
+          predicate.excludesBoundingVolume(createRegion(9.0, 9.0, 11.0, 11.0)));
+      TestFalse(
+          "outside",
+          predicate.excludesBoundingVolume(
+              createRegion(20.0, 20.0, 21.0, 21.0)));
+    });
+
+    It("excludes tiles entirely outside when inverted", [this]() {
+      CesiumTileExclusionPredicate predicate = createPredicate(true);
+      TestFalse(
+          "inside",
+          predicate.excludesBoundingVolume(createRegion(1.0, 1.0, 2.0, 2.0)));
+      TestFalse(
+          "partially inside",
+          predicate.excludesBoundingVolume(createRegion(9.0, 9.0, 11.0, 11.0)));
+      TestTrue(
+          "outside",
+          predicate.excludesBoundingVolume(
+              createRegion(20.0, 20.0, 21.0, 21.0)));
+    });
+  });
+
+  Describe("excludesContent", [this]() {
+    It("excludes content whose declared range doesn't overlap", [this]() {
+      std::vector<CesiumTileExclusionPredicate::MetadataCondition> conditions{
+          {"buildings", "height", 50.0, 100.0}};
+      CesiumTileExclusionPredicate predicate(
+          Ellipsoid::WGS84,
+          {},
+          {},
+          false,
+          std::move(conditions));
+
+      Model model;
+      ExtensionModelExtStructuralMetadata& metadata =
+          model.addExtension<ExtensionModelExtStructuralMetadata>();
+      PropertyTable& propertyTable = metadata.propertyTables.emplace_back();
+      propertyTable.name = "buildings";
+      PropertyTableProperty& property = propertyTable.properties["height"];
+
+      TestFalse("no range", predicate.excludesContent(model));
+
+      property.min = CesiumUtility::JsonValue(10.0);
+      property.max = CesiumUtility::JsonValue(40.0);
+      TestTrue("below", predicate.excludesContent(model));
+
+      property.max = CesiumUtility::JsonValue(60.0);
+      TestFalse("overlapping", predicate.excludesContent(model));
+    });
+  });
+}
@@ -0,0 +1,104 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileFinalizationBudget.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTestHelpers.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileFinalizationBudgetSpec,
+    "Cesium.Unit.TileFinalizationBudget",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+float originalBudget;
+END_DEFINE_SPEC(FCesiumTileFinalizationBudgetSpec)
+
+void FCesiumTileFinalizationBudgetSpec::Define() {
+  BeforeEach([this]() {
+    originalBudget =
+        GetDefault<UCesiumRuntimeSettings>()->MainThreadTileFinalizationBudget;
+  });
+
+  AfterEach([this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = originalBudget;
+  });
+
+  It("reports no limit when the budget is disabled", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = 0.0f;
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    TestEqual(
+        "remaining",
+        CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld),
+        0.0);
+  });
+
+  It("subtracts finalization time from the remaining budget", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = 1000.0f;
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+
+    double before =
+        CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld);
+    int32 tilesBefore =
+        CesiumTileFinalizationBudget::getCurrentFrameStats(pWorld)
+            .TilesFinalized;
+
+    CesiumTileFinalizationBudget::recordTileFinalized(pWorld, 10.0);
+
+    double after =
+        CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld);
+    TestEqual("remaining", after, before - 10.0);
+    TestEqual(
+        "tiles finalized",
+        CesiumTileFinalizationBudget::getCurrentFrameStats(pWorld)
+            .TilesFinalized,
+        tilesBefore + 1);
+  });
+
+  It("never reports an exhausted budget as unlimited", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = 1.0f;
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+
+    CesiumTileFinalizationBudget::recordTileFinalized(pWorld, 5.0);
+
+    double remaining =
+        CesiumTileFinalizationBudget::getRemainingMilliseconds(pWorld);
+    TestTrue("remaining is positive", remaining > 0.0);
+    TestTrue("remaining is tiny", remaining < 0.01);
+  });
+
+  It("does one step of work even when the budget is used up", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = 1.0f;
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+
+    CesiumTileFinalizationBudget::recordTileFinalized(pWorld, 5.0);
+
+    using Step = CesiumTileFinalizationBudget::Step;
+    int32 steps = 0;
+    CesiumTileFinalizationBudget::runWithinBudget(pWorld, [&steps]() {
+      ++steps;
+      // Skipped steps don't count as progress.
+      return steps < 3 ? Step::Skipped : Step::Worked;
+    });
+    TestEqual("steps", steps, 3);
+  });
+
+  It("stops when there is no work left", [this]() {
+    GetMutableDefault<UCesiumRuntimeSettings>()
+        ->MainThreadTileFinalizationBudget = 0.0f;
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+
+    using Step = CesiumTileFinalizationBudget::Step;
+    int32 steps = 0;
+    CesiumTileFinalizationBudget::runWithinBudget(pWorld, [&steps]() {
+      ++steps;
+      return steps < 5 ? Step::Worked : Step::Done;
+    });
+    TestEqual("steps", steps, 5);
+  });
+}
@@ -0,0 +1,57 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilePropertyStatistics.h"
+#include "CesiumPropertyStatistics.h"
+#include "Misc/AutomationTest.h"
+#include <limits>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTilePropertyStatisticsSpec,
+    "Cesium.Unit.TilePropertyStatistics",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTilePropertyStatisticsSpec)
+
+void FCesiumTilePropertyStatisticsSpec::Define() {
+  It("ignores NaN values", [this]() {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    TArray<double> values{3.0, nan, -1.0, 4.0};
+    std::optional<CesiumTilePropertyStatistics> statistics =
+        CesiumTilePropertyStatistics::compute(values);
+    if (!TestTrue("computed", statistics.has_value())) {
+      return;
+    }
+    TestEqual("count", statistics->count, int64(3));
+    TestEqual("minimum", statistics->minimum, -1.0);
+    TestEqual("maximum", statistics->maximum, 4.0);
+    TestEqual("sum", statistics->sum, 6.0);
+
+    TArray<double> noValues{nan};
+    TestFalse(
+        "no values",
+        CesiumTilePropertyStatistics::compute(noValues).has_value());
+  });
+
+  It("aggregates the statistics of tiles", [this]() {
+    TArray<double> first{0.0, 1.0, 2.0, 3.0};
+    TArray<double> second{6.0, 7.0};
+    std::optional<CesiumTilePropertyStatistics> firstStatistics =
+        CesiumTilePropertyStatistics::compute(first);
+    std::optional<CesiumTilePropertyStatistics> secondStatistics =
+        CesiumTilePropertyStatistics::compute(second);
+    if (!TestTrue("computed", firstStatistics && secondStatistics)) {
+      return;
+    }
+
+    TArray<const CesiumTilePropertyStatistics*> tiles{
+        &*firstStatistics,
+        &*secondStatistics};
+    FCesiumPropertyStatistics result =
+        CesiumTilePropertyStatistics::aggregate(tiles, 2);
+    TestEqual("count", result.Count, int64(6));
+    TestEqual("minimum", result.Minimum, 0.0);
+    TestEqual("maximum", result.Maximum, 7.0);
+    TestEqual("mean", result.Mean, 19.0 / 6.0);
+    TestEqual("histogram", result.Histogram, TArray<int64>{4, 2});
+  });
+}
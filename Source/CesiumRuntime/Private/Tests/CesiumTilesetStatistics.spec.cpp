@@ -0,0 +1,131 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetStatistics.h"
+#include "Engine/Engine.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTilesetStatisticsSpec,
+    "Cesium.Unit.TilesetStatistics",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+UCesiumTilesetStatistics* pStatistics;
+END_DEFINE_SPEC(FCesiumTilesetStatisticsSpec)
+
+void FCesiumTilesetStatisticsSpec::Define() {
+  BeforeEach([this]() {
+    pStatistics = GEngine->GetEngineSubsystem<UCesiumTilesetStatistics>();
+    TestNotNull("pStatistics", pStatistics);
+    if (pStatistics) {
+      pStatistics->Reset();
+    }
+  });
+
+  AfterEach([this]() {
+    if (pStatistics) {
+      pStatistics->Reset();
+    }
+  });
+
+  It("computes percentiles of the recorded samples", [this]() {
+    if (!pStatistics) {
+      return;
+    }
+
+    for (int32 i = 1; i <= 100; ++i) {
+      UCesiumTilesetStatistics::RecordStage(
+          ECesiumTileLoadStage::CreateOffGameThread,
+          double(i));
+    }
+
+    FCesiumTileLoadStageStatistics stats = pStatistics->GetStageStatistics(
+        ECesiumTileLoadStage::CreateOffGameThread);
+    TestEqual("SampleCount", stats.SampleCount, 100);
+    TestEqual("AverageMilliseconds", stats.AverageMilliseconds, 50.5);
+    TestEqual("P50Milliseconds", stats.P50Milliseconds, 50.0);
+    TestEqual("P90Milliseconds", stats.P90Milliseconds, 90.0);
+    TestEqual("P99Milliseconds", stats.P99Milliseconds, 99.0);
+    TestEqual("MaximumMilliseconds", stats.MaximumMilliseconds, 100.0);
+
+    FCesiumTileLoadStageStatistics otherStats =
+        pStatistics->GetStageStatistics(ECesiumTileLoadStage::NetworkFetch);
+    TestEqual("other SampleCount", otherStats.SampleCount, 0);
+  });
+
+  It("keeps only the most recent samples", [this]() {
+    if (!pStatistics) {
+      return;
+    }
+
+    const int32 count = UCesiumTilesetStatistics::MaximumSamplesPerStage;
+    for (int32 i = 0; i < count; ++i) {
+      UCesiumTilesetStatistics::RecordStage(
+          ECesiumTileLoadStage::NetworkFetch,
+          1000.0);
+    }
+    for (int32 i = 0; i < count; ++i) {
+      UCesiumTilesetStatistics::RecordStage(
+          ECesiumTileLoadStage::NetworkFetch,
+          1.0);
+    }
+
+    FCesiumTileLoadStageStatistics stats =
+        pStatistics->GetStageStatistics(ECesiumTileLoadStage::NetworkFetch);
+    TestEqual("SampleCount", stats.SampleCount, count);
+    TestEqual("TotalSampleCount", stats.TotalSampleCount, int64(count) * 2);
+    TestEqual("TotalMilliseconds", stats.TotalMilliseconds, count * 1001.0);
+    TestEqual("MaximumMilliseconds", stats.MaximumMilliseconds, 1.0);
+  });
+
+  It("exports one CSV row per stage", [this]() {
+    if (!pStatistics) {
+      return;
+    }
+
+    TArray<FString> lines;
+    pStatistics->ExportToCsv().ParseIntoArrayLines(lines);
+    TestEqual("lines", lines.Num(), 9);
+    if (lines.Num() == 9) {
+      TestTrue("header", lines[0].StartsWith(TEXT("Stage,")));
+      TestTrue("row", lines[1].StartsWith(TEXT("NetworkFetch,")));
+    }
+  });
+
+  It("counts requests per host", [this]() {
+    if (!pStatistics) {
+      return;
+    }
+
+    const FString host = TEXT("tiles.example.com");
+    UCesiumTilesetStatistics::RecordRequestQueued(host);
+    UCesiumTilesetStatistics::RecordRequestQueued(host);
+    UCesiumTilesetStatistics::RecordRequestQueued(host);
+    UCesiumTilesetStatistics::RecordRequestStarted(host);
+    UCesiumTilesetStatistics::RecordRequestStarted(host);
+    UCesiumTilesetStatistics::RecordRequestFinished(host, true, true, 100);
+    UCesiumTilesetStatistics::RecordRequestFinished(host, false, false, 0);
+
+    TArray<FCesiumHostRequestStatistics> hosts =
+        pStatistics->GetHostStatistics();
+    if (!TestEqual("hosts", hosts.Num(), 1)) {
+      return;
+    }
+
+    TestEqual("Host", hosts[0].Host, host);
+    TestEqual("PendingRequests", hosts[0].PendingRequests, 0);
+    TestEqual("ActiveRequests", hosts[0].ActiveRequests, 1);
+    TestEqual("CompletedRequests", hosts[0].CompletedRequests, int64(1));
+    TestEqual("FailedRequests", hosts[0].FailedRequests, int64(1));
+    TestEqual("BytesReceived", hosts[0].BytesReceived, int64(100));
+
+    // Resetting keeps the request that is still in flight.
+    pStatistics->Reset();
+    hosts = pStatistics->GetHostStatistics();
+    if (TestEqual("hosts after reset", hosts.Num(), 1)) {
+      TestEqual("ActiveRequests after reset", hosts[0].ActiveRequests, 1);
+      TestEqual("BytesReceived after reset", hosts[0].BytesReceived, int64(0));
+    }
+
+    UCesiumTilesetStatistics::RecordRequestFinished(host, true, true, 0);
+  });
+}
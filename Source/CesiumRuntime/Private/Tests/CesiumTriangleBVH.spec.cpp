@@ -0,0 +1,98 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTriangleBVH.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTriangleBVHSpec,
+    "Cesium.Unit.TriangleBVH",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumTriangleBVHSpec)
+
+namespace {
+
+// A grid of quads in the XY plane at a height of zero, each one unit wide.
+TSharedPtr<const CesiumTriangleBVH> createGrid(int32 size) {
+  TArray<FVector3f> positions;
+  for (int32 y = 0; y <= size; ++y) {
+    for (int32 x = 0; x <= size; ++x) {
+      positions.Emplace(float(x), float(y), 0.0f);
+    }
+  }
+
+  TArray<uint32> indices;
+  for (int32 y = 0; y < size; ++y) {
+    for (int32 x = 0; x < size; ++x) {
+      const uint32 corner = uint32(y * (size + 1) + x);
+      indices.Append({corner, corner + 1, corner + size + 2});
+      indices.Append({corner, corner + size + 2, corner + size + 1});
+    }
+  }
+
+  return CesiumTriangleBVH::build(MoveTemp(positions), indices);
+}
+
+} // namespace
+
+void FCesiumTriangleBVHSpec::Define() {
+  It("returns nullptr without triangles", [this]() {
+    TestFalse(
+        "built",
+        CesiumTriangleBVH::build({FVector3f(0.0f)}, {}).IsValid());
+  });
+
+  It("returns nullptr when an index is out of range", [this]() {
+    TestFalse(
+        "built",
+        CesiumTriangleBVH::build(
+            {FVector3f(0.0f), FVector3f(1.0f, 0.0f, 0.0f)},
+            {0, 1, 2})
+            .IsValid());
+  });
+
+  It("finds the triangle under a vertical line", [this]() {
+    TSharedPtr<const CesiumTriangleBVH> pBVH = createGrid(16);
+    TestTrue("built", pBVH.IsValid());
+
+    CesiumTriangleBVH::Hit hit;
+    TestTrue(
+        "hit",
+        pBVH->lineTrace(
+            FVector(5.75, 3.25, 10.0),
+            FVector(5.75, 3.25, -10.0),
+            hit));
+    TestEqual("time", hit.time, 0.5);
+
+    // The point is below the diagonal of the quad at (5, 3), so it's in the
+    // first of its triangles.
+    TestEqual("triangle", hit.triangleIndex, 2 * (3 * 16 + 5));
+    TestTrue("normal faces the start", hit.normal.Z > 0.0);
+  });
+
+  It("hits the back of triangles", [this]() {
+    TSharedPtr<const CesiumTriangleBVH> pBVH = createGrid(4);
+
+    CesiumTriangleBVH::Hit hit;
+    TestTrue(
+        "hit",
+        pBVH->lineTrace(
+            FVector(1.5, 1.25, -1.0),
+            FVector(1.5, 1.25, 3.0),
+            hit));
+    TestEqual("time", hit.time, 0.25);
+    TestTrue("normal faces the start", hit.normal.Z < 0.0);
+  });
+
+  It("misses outside the triangles and beyond the end", [this]() {
+    TSharedPtr<const CesiumTriangleBVH> pBVH = createGrid(4);
+
+    CesiumTriangleBVH::Hit hit;
+    TestFalse(
+        "outside",
+        pBVH->lineTrace(FVector(5.0, 1.0, 1.0), FVector(5.0, 1.0, -1.0), hit));
+    TestFalse(
+        "beyond the end",
+        pBVH->lineTrace(FVector(1.0, 1.0, 2.0), FVector(1.0, 1.0, 1.0), hit));
+  });
+}
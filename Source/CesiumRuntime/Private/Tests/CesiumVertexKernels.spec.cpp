@@ -0,0 +1,203 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexKernels.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVertexKernelsSpec,
+    "Cesium.Unit.VertexKernels",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumVertexKernelsSpec)
+
+namespace {
+
+std::vector<FVector3f> createPositions(int32 count) {
+  FRandomStream random(42);
+  std::vector<FVector3f> positions(size_t(count));
+  for (FVector3f& position : positions) {
+    position = FVector3f(
+        random.FRandRange(-1000.0f, 1000.0f),
+        random.FRandRange(-1000.0f, 1000.0f),
+        random.FRandRange(-1000.0f, 1000.0f));
+  }
+  return positions;
+}
+
+template <typename T> AccessorView<T> createView(const std::vector<T>& data) {
+  return AccessorView<T>(
+      reinterpret_cast<const std::byte*>(data.data()),
+      int64_t(sizeof(T)),
+      0,
+      int64_t(data.size()));
+}
+
+} // namespace
+
+void FCesiumVertexKernelsSpec::Define() {
+  It("computes the same bounds as the scalar version", [this]() {
+    for (int32 count : {1, 2, 3, 1001}) {
+      std::vector<FVector3f> positions = createPositions(count);
+      AccessorView<FVector3f> view = createView(positions);
+
+      FVector3f min(0.0f), max(0.0f);
+      CesiumVertexKernels::computeBounds(view, min, max);
+      FVector3f expectedMin(0.0f), expectedMax(0.0f);
+      CesiumVertexKernels::Scalar::computeBounds(
+          view,
+          expectedMin,
+          expectedMax);
+
+      TestTrue("min", min.Equals(expectedMin));
+      TestTrue("max", max.Equals(expectedMax));
+    }
+  });
+
+  It("computes the bounds of interleaved positions", [this]() {
+    // Each position is followed by a normal that must be skipped.
+    std::vector<FVector3f> interleaved = {
+        FVector3f(1.0f, 2.0f, 3.0f),
+        FVector3f(100.0f),
+        FVector3f(-1.0f, 5.0f, 0.0f),
+        FVector3f(-100.0f)};
+    AccessorView<FVector3f> view(
+        reinterpret_cast<const std::byte*>(interleaved.data()),
+        int64_t(2 * sizeof(FVector3f)),
+        0,
+        2);
+
+    FVector3f min(0.0f), max(0.0f);
+    CesiumVertexKernels::computeBounds(view, min, max);
+    TestTrue("min", min.Equals(FVector3f(-1.0f, 2.0f, 0.0f)));
+    TestTrue("max", max.Equals(FVector3f(1.0f, 5.0f, 3.0f)));
+  });
+
+  It("widens indices of every size", [this]() {
+    std::vector<uint8_t> bytes(37);
+    std::vector<uint16_t> shorts(37);
+    std::vector<uint32_t> ints(37);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] = uint8_t(255 - i);
+      shorts[i] = uint16_t(65535 - i);
+      ints[i] = uint32_t(100000 + i);
+    }
+
+    std::vector<uint32> out(37);
+    CesiumVertexKernels::copyIndices(createView(bytes), out.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+      TestEqual("uint8", out[i], uint32(bytes[i]));
+    }
+
+    CesiumVertexKernels::copyIndices(createView(shorts), out.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+      TestEqual("uint16", out[i], uint32(shorts[i]));
+    }
+
+    CesiumVertexKernels::copyIndices(createView(ints), out.data());
+    for (size_t i = 0; i < out.size(); ++i) {
+      TestEqual("uint32", out[i], uint32(ints[i]));
+    }
+  });
+
+  It("copies positions with an inverted Y coordinate", [this]() {
+    std::vector<FVector3f> positions = {
+        FVector3f(1.0f, 2.0f, 3.0f),
+        FVector3f(4.0f, 5.0f, 6.0f)};
+    const uint32 sources[] = {1, 0, 1, 7};
+    FVector3f out[4];
+
+    const float radius = CesiumVertexKernels::copyPositionsInvertingY(
+        createView(positions),
+        sources,
+        4,
+        FVector3f(0.0f),
+        out);
+
+    TestTrue("first", out[0].Equals(FVector3f(4.0f, -5.0f, 6.0f)));
+    TestTrue("second", out[1].Equals(FVector3f(1.0f, -2.0f, 3.0f)));
+    TestTrue("third", out[2].Equals(FVector3f(4.0f, -5.0f, 6.0f)));
+    TestTrue("out of range", out[3].Equals(FVector3f(0.0f)));
+    TestEqual("radius", radius, FMath::Sqrt(16.0f + 25.0f + 36.0f));
+  });
+
+  It("converts float colors like a truncating cast", [this]() {
+    const FColor color =
+        CesiumVertexKernels::convertColor(1.0f, 0.5f, 0.0f, 0.25f);
+    TestEqual("R", color.R, uint8(255));
+    TestEqual("G", color.G, uint8(127));
+    TestEqual("B", color.B, uint8(0));
+    TestEqual("A", color.A, uint8(63));
+
+    const FColor clamped =
+        CesiumVertexKernels::convertColor(2.0f, -1.0f, 0.0f, 1.0f);
+    TestEqual("clamped R", clamped.R, uint8(255));
+    TestEqual("clamped G", clamped.G, uint8(0));
+  });
+
+  It("reports the time per million vertices", [this]() {
+    constexpr int32 count = 1000000;
+    std::vector<FVector3f> positions = createPositions(count);
+    AccessorView<FVector3f> view = createView(positions);
+    std::vector<uint16_t> shortIndices(size_t(count));
+    for (int32 i = 0; i < count; ++i) {
+      shortIndices[i] = uint16_t(i);
+    }
+    AccessorView<uint16_t> indexView = createView(shortIndices);
+    std::vector<FVector3f> outPositions(size_t(count));
+    std::vector<uint32> outIndices(size_t(count));
+
+    auto time = [](auto&& kernel) {
+      const double start = FPlatformTime::Seconds();
+      kernel();
+      return (FPlatformTime::Seconds() - start) * 1000.0;
+    };
+
+    FVector3f min, max;
+    float radius = 0.0f, scalarRadius = 0.0f;
+
+    const double scalarBounds = time([&]() {
+      CesiumVertexKernels::Scalar::computeBounds(view, min, max);
+    });
+    const double vectorBounds =
+        time([&]() { CesiumVertexKernels::computeBounds(view, min, max); });
+
+    const double scalarIndices = time([&]() {
+      CesiumVertexKernels::Scalar::copyIndices(indexView, outIndices.data());
+    });
+    const double vectorIndices = time([&]() {
+      CesiumVertexKernels::copyIndices(indexView, outIndices.data());
+    });
+
+    const double scalarPositions = time([&]() {
+      scalarRadius = CesiumVertexKernels::Scalar::copyPositionsInvertingY(
+          view,
+          nullptr,
+          count,
+          FVector3f(0.0f),
+          outPositions.data());
+    });
+    const double vectorPositions = time([&]() {
+      radius = CesiumVertexKernels::copyPositionsInvertingY(
+          view,
+          nullptr,
+          count,
+          FVector3f(0.0f),
+          outPositions.data());
+    });
+
+    TestEqual("radius", radius, scalarRadius, 1e-2f);
+    AddInfo(FString::Printf(
+        TEXT(
+            "Per million vertices, scalar / vectorized: bounds %.3fms / %.3fms, uint16 indices %.3fms / %.3fms, positions %.3fms / %.3fms"),
+        scalarBounds,
+        vectorBounds,
+        scalarIndices,
+        vectorIndices,
+        scalarPositions,
+        vectorPositions));
+  });
+}
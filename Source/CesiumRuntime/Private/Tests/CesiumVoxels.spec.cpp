@@ -0,0 +1,133 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVoxels.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+#include <CesiumGltf/ExtensionMeshPrimitiveExtStructuralMetadata.h>
+#include <CesiumUtility/JsonValue.h>
+
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVoxelsSpec,
+    "Cesium.Unit.Voxels",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+Model model;
+MeshPrimitive* pPrimitive;
+
+void addVoxelsExtension(
+    const JsonValue::Array& dimensions,
+    const JsonValue::Array& before,
+    const JsonValue::Array& after) {
+  const JsonValue::Object padding{{"before", before}, {"after", after}};
+  this->pPrimitive->extensions["EXT_primitive_voxels"] = JsonValue(
+      JsonValue::Object{{"dimensions", dimensions}, {"padding", padding}});
+}
+
+END_DEFINE_SPEC(FCesiumVoxelsSpec)
+
+void FCesiumVoxelsSpec::Define() {
+  BeforeEach([this]() {
+    this->model = Model();
+    Mesh& mesh = this->model.meshes.emplace_back();
+    this->pPrimitive = &mesh.primitives.emplace_back();
+  });
+
+  It("ignores primitives without voxels", [this]() {
+    TestFalse(
+        "isVoxelPrimitive",
+        CesiumVoxels::isVoxelPrimitive(*this->pPrimitive));
+    TestFalse(
+        "load",
+        CesiumVoxels::load(this->model, *this->pPrimitive, "").IsValid());
+  });
+
+  It("loads float properties of a property attribute", [this]() {
+    this->addVoxelsExtension({2, 1, 1}, {1, 0, 0}, {0, 0, 0});
+    const std::vector<float> values{5.0f, 1.0f, 2.0f};
+    CreateAttributeForPrimitive(
+        this->model,
+        *this->pPrimitive,
+        "_TEMPERATURE",
+        AccessorSpec::Type::SCALAR,
+        AccessorSpec::ComponentType::FLOAT,
+        values);
+
+    ExtensionModelExtStructuralMetadata& metadata =
+        this->model.addExtension<ExtensionModelExtStructuralMetadata>();
+    PropertyAttribute& propertyAttribute =
+        metadata.propertyAttributes.emplace_back();
+    PropertyAttributeProperty& property =
+        propertyAttribute.properties["temperature"];
+    property.attribute = "_TEMPERATURE";
+    property.offset = JsonValue(10.0);
+    property.scale = JsonValue(2.0);
+    this->pPrimitive
+        ->addExtension<ExtensionMeshPrimitiveExtStructuralMetadata>()
+        .propertyAttributes.push_back(0);
+
+    TestTrue(
+        "isVoxelPrimitive",
+        CesiumVoxels::isVoxelPrimitive(*this->pPrimitive));
+    CesiumVoxels::SharedBrick pBrick =
+        CesiumVoxels::load(this->model, *this->pPrimitive, "temperature");
+    if (!TestTrue("loaded", pBrick.IsValid())) {
+      return;
+    }
+
+    TestTrue("Dimensions", pBrick->Dimensions == FIntVector(3, 1, 1));
+    TestTrue("PaddingBefore", pBrick->PaddingBefore == FIntVector(1, 0, 0));
+    TestTrue("Format", pBrick->Format == PF_R32_FLOAT);
+    TestTrue("ValueOffset", pBrick->ValueOffset == 10.0f);
+    TestTrue("ValueScale", pBrick->ValueScale == 2.0f);
+    TestEqual("Data", pBrick->Data.Num(), int32(3 * sizeof(float)));
+    TestTrue(
+        "First value",
+        reinterpret_cast<const float*>(pBrick->Data.GetData())[0] == 5.0f);
+    TestTrue("getSizeBytes", pBrick->getSizeBytes() == 12);
+  });
+
+  It("loads unsigned bytes as they are", [this]() {
+    this->addVoxelsExtension({2, 2, 1}, {0, 0, 0}, {0, 0, 0});
+    const std::vector<uint8> values{0, 64, 128, 255};
+    CreateAttributeForPrimitive(
+        this->model,
+        *this->pPrimitive,
+        "_DENSITY",
+        AccessorSpec::Type::SCALAR,
+        AccessorSpec::ComponentType::UNSIGNED_BYTE,
+        values);
+
+    CesiumVoxels::SharedBrick pBrick =
+        CesiumVoxels::load(this->model, *this->pPrimitive, "_DENSITY");
+    if (!TestTrue("loaded", pBrick.IsValid())) {
+      return;
+    }
+
+    TestTrue("Format", pBrick->Format == PF_G8);
+    TestEqual("Data", pBrick->Data.Num(), 4);
+    TestTrue("Last value", pBrick->Data[3] == 255);
+    // The texture normalizes the bytes, so they're scaled back.
+    TestTrue("ValueScale", pBrick->ValueScale == 255.0f);
+  });
+
+  It("rejects attributes without a value for each voxel", [this]() {
+    this->addVoxelsExtension({2, 2, 2}, {0, 0, 0}, {0, 0, 0});
+    const std::vector<float> values{1.0f, 2.0f};
+    CreateAttributeForPrimitive(
+        this->model,
+        *this->pPrimitive,
+        "_DENSITY",
+        AccessorSpec::Type::SCALAR,
+        AccessorSpec::ComponentType::FLOAT,
+        values);
+
+    TestFalse(
+        "load",
+        CesiumVoxels::load(this->model, *this->pPrimitive, "_DENSITY")
+            .IsValid());
+  });
+}
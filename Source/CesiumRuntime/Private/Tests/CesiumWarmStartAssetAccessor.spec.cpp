@@ -0,0 +1,77 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumWarmStartAssetAccessor.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Base64.h"
+#include <string>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumWarmStartAssetAccessorSpec,
+    "Cesium.Unit.WarmStartAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumWarmStartAssetAccessorSpec)
+
+namespace {
+
+std::string base64UrlEncode(const std::string& s) {
+  FString encoded = FBase64::Encode(
+      reinterpret_cast<const uint8*>(s.data()),
+      uint32(s.size()),
+      EBase64Mode::UrlSafe);
+  encoded.RemoveFromEnd(TEXT("=="));
+  encoded.RemoveFromEnd(TEXT("="));
+  return TCHAR_TO_UTF8(*encoded);
+}
+
+std::optional<std::time_t> getExpiry(const std::string& endpoint) {
+  return CesiumWarmStartAssetAccessor::getAccessTokenExpiry(
+      gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(endpoint.data()),
+          endpoint.size()));
+}
+
+} // namespace
+
+void FCesiumWarmStartAssetAccessorSpec::Define() {
+  It("keeps only the requests that bootstrap a tileset", [this]() {
+    TestTrue(
+        "endpoint",
+        CesiumWarmStartAssetAccessor::isWarmStartUrl(
+            "https://api.cesium.com/v1/assets/1/endpoint?access_token=a"));
+    TestTrue(
+        "tileset.json",
+        CesiumWarmStartAssetAccessor::isWarmStartUrl(
+            "https://assets.ion.cesium.com/1/tileset.json?v=2"));
+    TestTrue(
+        "layer.json",
+        CesiumWarmStartAssetAccessor::isWarmStartUrl(
+            "https://assets.ion.cesium.com/1/layer.json"));
+    TestFalse(
+        "tile",
+        CesiumWarmStartAssetAccessor::isWarmStartUrl(
+            "https://assets.ion.cesium.com/1/0/0/0.terrain"));
+    TestFalse(
+        "file",
+        CesiumWarmStartAssetAccessor::isWarmStartUrl(
+            "file:///C:/data/tileset.json"));
+  });
+
+  It("reads the expiry of the ion access token", [this]() {
+    const std::string token = base64UrlEncode("{\"alg\":\"HS256\"}") + "." +
+                              base64UrlEncode("{\"exp\":1700000000}") + ".x";
+    std::optional<std::time_t> maybeExpiry =
+        getExpiry("{\"url\":\"u\",\"accessToken\":\"" + token + "\"}");
+    TestTrue("has expiry", maybeExpiry.has_value());
+    if (maybeExpiry) {
+      TestEqual("expiry", int64(*maybeExpiry), int64(1700000000));
+    }
+
+    TestFalse(
+        "no token",
+        getExpiry("{\"url\":\"u\",\"options\":{}}").has_value());
+    TestFalse(
+        "malformed token",
+        getExpiry("{\"accessToken\":\"not-a-token\"}").has_value());
+  });
+}
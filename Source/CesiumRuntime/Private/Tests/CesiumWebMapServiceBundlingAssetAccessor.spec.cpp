@@ -0,0 +1,123 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumRuntime.h"
+#include "CesiumTestHelpers.h"
+#include "CesiumWebMapServiceBundlingAssetAccessor.h"
+#include "Misc/AutomationTest.h"
+#include <vector>
+
+using CesiumTestHelpers::TestAssetRequest;
+using CesiumTestHelpers::TestAssetResponse;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumWebMapServiceBundlingAssetAccessorSpec,
+    "Cesium.Unit.WebMapServiceBundlingAssetAccessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumWebMapServiceBundlingAssetAccessorSpec)
+
+namespace {
+
+/**
+ * Answers every request immediately with a 404 Not Found, and records the
+ * URLs it was asked for.
+ */
+class RecordingAssetAccessor : public CesiumAsync::IAssetAccessor {
+public:
+  std::vector<std::string> urls;
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  get(const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>& headers) override {
+    this->urls.push_back(url);
+    return asyncSystem.createResolvedFuture<
+        std::shared_ptr<CesiumAsync::IAssetRequest>>(
+        std::make_shared<TestAssetRequest>(
+            url,
+            CesiumAsync::HttpHeaders(),
+            TestAssetResponse(404, {}, {})));
+  }
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  request(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& verb,
+      const std::string& url,
+      const std::vector<THeader>& headers,
+      const gsl::span<const std::byte>& contentPayload) override {
+    return this->get(asyncSystem, url, headers);
+  }
+
+  virtual void tick() noexcept override {}
+};
+
+const std::string BaseUrl =
+    CesiumWebMapServiceBundlingAssetAccessor::addBundleSizeToUrl(
+        "https://example.com/wms",
+        2);
+
+std::string getMapUrl(const std::string& baseUrl, const std::string& bbox) {
+  return baseUrl + "request=GetMap&version=1.3.0&service=WMS&crs=EPSG:4326&" +
+         bbox;
+}
+
+} // namespace
+
+void FCesiumWebMapServiceBundlingAssetAccessorSpec::Define() {
+  It("removes the bundle size from other requests", [this]() {
+    auto pInner = std::make_shared<RecordingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumWebMapServiceBundlingAssetAccessor>(pInner);
+
+    pAccessor
+        ->get(
+            getAsyncSystem(),
+            BaseUrl + "&request=GetCapabilities&version=1.3.0&service=WMS",
+            {})
+        .wait();
+
+    TestEqual("requests", pInner->urls.size(), size_t(1));
+    TestEqual(
+        "url",
+        pInner->urls[0],
+        std::string("https://example.com/wms?request=GetCapabilities"
+                    "&version=1.3.0&service=WMS"));
+  });
+
+  It("requests the block containing a tile", [this]() {
+    auto pInner = std::make_shared<RecordingAssetAccessor>();
+    auto pAccessor =
+        std::make_shared<CesiumWebMapServiceBundlingAssetAccessor>(pInner);
+    const std::string bundled = BaseUrl + "&";
+    const std::string unbundled = "https://example.com/wms?";
+
+    // The north-east tile of level 1, whose block is the eastern half.
+    pAccessor
+        ->get(
+            getAsyncSystem(),
+            getMapUrl(bundled, "bbox=0,90,90,180&width=256&height=256"),
+            {})
+        .wait();
+
+    TestEqual("requests", pInner->urls.size(), size_t(2));
+    TestEqual(
+        "block",
+        pInner->urls[0],
+        getMapUrl(unbundled, "bbox=-90,0,90,180&width=512&height=512"));
+
+    // The block couldn't be loaded, so the tile is requested on its own, as
+    // is the next tile of the same block.
+    TestEqual(
+        "tile",
+        pInner->urls[1],
+        getMapUrl(unbundled, "bbox=0,90,90,180&width=256&height=256"));
+    pAccessor
+        ->get(
+            getAsyncSystem(),
+            getMapUrl(bundled, "bbox=0,0,90,90&width=256&height=256"),
+            {})
+        .wait();
+    TestEqual("requests after second tile", pInner->urls.size(), size_t(3));
+  });
+}
@@ -4,6 +4,7 @@
 #include "CesiumUtility/Math.h"
 #include "GeoTransforms.h"
 #include "Misc/AutomationTest.h"
+#include <glm/geometric.hpp>
 
 using namespace CesiumGeospatial;
 using namespace CesiumUtility;
@@ -28,4 +29,48 @@ void FGeoTransformsSpec::Define() {
       TestEqual("is at the origin", ue, glm::dvec3(0.0));
     });
   });
+
+  Describe("TransformEcefToLongitudeLatitudeHeight", [this]() {
+    It("approximates positions near the center to a millimeter", [this]() {
+      GeoTransforms exact{};
+      const glm::dvec3 center = exact.TransformLongitudeLatitudeHeightToEcef(
+          glm::dvec3(-75.0, 40.0, 100.0));
+      exact.setCenter(center);
+      GeoTransforms approximate = exact;
+      approximate.setLocalApproximationRadius(5000.0);
+
+      for (double dx = -3000.0; dx <= 3000.0; dx += 1000.0) {
+        for (double dz = -3000.0; dz <= 3000.0; dz += 1000.0) {
+          const glm::dvec3 ecef = center + glm::dvec3(dx, 0.5 * dz, dz);
+          const glm::dvec3 expected =
+              exact.TransformEcefToLongitudeLatitudeHeight(ecef);
+          const glm::dvec3 actual =
+              approximate.TransformEcefToLongitudeLatitudeHeight(ecef);
+          const glm::dvec3 expectedEcef =
+              exact.TransformLongitudeLatitudeHeightToEcef(expected);
+          const glm::dvec3 actualEcef =
+              exact.TransformLongitudeLatitudeHeightToEcef(actual);
+          TestTrue(
+              "within a millimeter",
+              glm::distance(expectedEcef, actualEcef) < 0.001);
+        }
+      }
+    });
+
+    It("uses the exact conversion outside the radius", [this]() {
+      GeoTransforms exact{};
+      const glm::dvec3 center = exact.TransformLongitudeLatitudeHeightToEcef(
+          glm::dvec3(10.0, -30.0, 0.0));
+      exact.setCenter(center);
+      GeoTransforms approximate = exact;
+      approximate.setLocalApproximationRadius(1000.0);
+
+      const glm::dvec3 far = exact.TransformLongitudeLatitudeHeightToEcef(
+          glm::dvec3(12.0, -31.0, 500.0));
+      TestEqual(
+          "far",
+          approximate.TransformEcefToLongitudeLatitudeHeight(far),
+          exact.TransformEcefToLongitudeLatitudeHeight(far));
+    });
+  });
 }
@@ -4,13 +4,20 @@
 
 #include "CesiumLoadTestCore.h"
 
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "Engine/World.h"
 #include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
 
 #include "Cesium3DTileset.h"
 #include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumCameraManager.h"
 #include "CesiumRuntime.h"
 #include "CesiumSunSky.h"
+#include <algorithm>
 
 using namespace Cesium;
 
@@ -59,6 +66,31 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     "Cesium.Performance.GoogleTiles.VaryMaxTileLoads",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGoogleTilesPathWalk,
+    "Cesium.Performance.GoogleTiles.PathWalk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGoogleTilesPathDrive,
+    "Cesium.Performance.GoogleTiles.PathDrive",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGoogleTilesPathFlight,
+    "Cesium.Performance.GoogleTiles.PathFlight",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGoogleTilesSoak,
+    "Cesium.Performance.GoogleTiles.Soak",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FGoogleTilesMultiView,
+    "Cesium.Performance.GoogleTiles.MultiView",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
 #define TEST_SCREEN_WIDTH 1280
 #define TEST_SCREEN_HEIGHT 720
 
@@ -311,4 +343,355 @@ bool FGoogleTilesMaxTileLoads::RunTest(const FString& Parameters) {
       TEST_SCREEN_HEIGHT);
 }
 
+// A cold cache pass that moves the camera along a path, taking about the given
+// number of seconds.
+TestPass
+createPathPass(std::vector<FVector>&& path, double speed, double duration) {
+  TestPass pass{"Cold Cache", googleSetupClearCache, nullptr};
+  pass.cameraPath = std::move(path);
+  pass.cameraSpeed = speed;
+  pass.timeout = duration + 30.0;
+  return pass;
+}
+
+bool FGoogleTilesPathWalk::RunTest(const FString& Parameters) {
+  // Walking west along East 42nd Street, past the Chrysler Building, at eye
+  // height.
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(createPathPass(
+      {FVector(-73.973775, 40.749801, -12.0),
+       FVector(-73.975173, 40.750394, -12.0),
+       FVector(-73.976490, 40.750948, -12.0)},
+      1.5,
+      150.0));
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForChrysler,
+      testPasses,
+      TEST_SCREEN_WIDTH,
+      TEST_SCREEN_HEIGHT);
+}
+
+bool FGoogleTilesPathDrive::RunTest(const FString& Parameters) {
+  // Driving close to the ground through the badlands below Zabriskie Point.
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(createPathPass(
+      {FVector(-116.812278, 36.42, 200.0),
+       FVector(-116.800, 36.410, 200.0),
+       FVector(-116.790, 36.395, 200.0)},
+      25.0,
+      135.0));
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForDeathValley,
+      testPasses,
+      TEST_SCREEN_WIDTH,
+      TEST_SCREEN_HEIGHT);
+}
+
+bool FGoogleTilesPathFlight::RunTest(const FString& Parameters) {
+  // Flying over central Tokyo from Tokyo Tower towards Shinjuku.
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(createPathPass(
+      {FVector(139.7563178458, 35.652798383944, 525.62),
+       FVector(139.735, 35.670, 525.62),
+       FVector(139.700, 35.690, 525.62)},
+      100.0,
+      70.0));
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForTokyo,
+      testPasses,
+      TEST_SCREEN_WIDTH,
+      TEST_SCREEN_HEIGHT);
+}
+
+// The least-squares slope of a resource's samples, per hour.
+double getGrowthPerHour(
+    const std::vector<ResourceSample>& samples,
+    size_t first,
+    const std::function<double(const ResourceSample&)>& value) {
+  const double count = double(samples.size() - first);
+  double meanTime = 0.0;
+  double meanValue = 0.0;
+  for (size_t i = first; i < samples.size(); ++i) {
+    meanTime += samples[i].time;
+    meanValue += value(samples[i]);
+  }
+  meanTime /= count;
+  meanValue /= count;
+
+  double covariance = 0.0;
+  double variance = 0.0;
+  for (size_t i = first; i < samples.size(); ++i) {
+    const double dt = samples[i].time - meanTime;
+    covariance += dt * (value(samples[i]) - meanValue);
+    variance += dt * dt;
+  }
+  return variance > 0.0 ? covariance / variance * 3600.0 : 0.0;
+}
+
+void soakReportStep(const std::vector<TestPass>& testPasses) {
+  // Resources that grow by more than this fraction of their average over the
+  // measured part of the run are flagged.
+  constexpr double growthThreshold = 0.05;
+
+  const std::vector<
+      std::pair<const TCHAR*, std::function<double(const ResourceSample&)>>>
+      resources = {
+          {TEXT("Used physical memory"),
+           [](const ResourceSample& s) { return double(s.usedPhysicalBytes); }},
+          {TEXT("GPU texture memory"),
+           [](const ResourceSample& s) { return double(s.gpuTextureBytes); }},
+          {TEXT("Tile memory"),
+           [](const ResourceSample& s) { return double(s.tileMemoryBytes); }},
+          {TEXT("glTF components"),
+           [](const ResourceSample& s) {
+             return double(s.gltfComponentCount);
+           }},
+          {TEXT("UTexture2D objects"),
+           [](const ResourceSample& s) { return double(s.textureCount); }},
+          {TEXT("Dynamic material instances"),
+           [](const ResourceSample& s) {
+             return double(s.materialInstanceCount);
+           }},
+          {TEXT("Destruction backlog"),
+           [](const ResourceSample& s) {
+             return double(s.destructionBacklog);
+           }},
+          {TEXT("Request cache files"),
+           [](const ResourceSample& s) { return double(s.cacheFileBytes); }}};
+
+  for (const TestPass& pass : testPasses) {
+    // The first quarter of the run is a warm-up, in which the caches fill
+    // and the tiles along the path are first loaded.
+    const size_t first = pass.samples.size() / 4;
+    if (pass.samples.size() - first < 4) {
+      UE_LOG(
+          LogCesium,
+          Warning,
+          TEXT("%s: too few resource samples to find growth trends"),
+          *pass.name);
+      continue;
+    }
+
+    const double hours =
+        (pass.samples.back().time - pass.samples[first].time) / 3600.0;
+    FString report = FString::Printf(
+        TEXT("\n\nSoak Test Results: %s, %.2f hours measured\n"),
+        *pass.name,
+        hours);
+    report += "-----------------------------\n";
+    report += "(first) - (last) - (growth per hour) - (resource)\n";
+
+    for (const auto& [name, value] : resources) {
+      double average = 0.0;
+      for (size_t i = first; i < pass.samples.size(); ++i) {
+        average += value(pass.samples[i]);
+      }
+      average /= double(pass.samples.size() - first);
+
+      const double growthPerHour =
+          getGrowthPerHour(pass.samples, first, value);
+      report += FString::Printf(
+          TEXT("%.0f - %.0f - %.1f - %s\n"),
+          value(pass.samples[first]),
+          value(pass.samples.back()),
+          growthPerHour,
+          name);
+
+      if (growthPerHour > 0.0 && average > 0.0 &&
+          growthPerHour * hours > growthThreshold * average) {
+        UE_LOG(
+            LogCesium,
+            Warning,
+            TEXT("GROWTH: %s grew by %.1f%% of its average over %.2f hours"),
+            name,
+            100.0 * growthPerHour * hours / average,
+            hours);
+      }
+    }
+    report += "-----------------------------\n";
+
+    UE_LOG(LogCesium, Display, TEXT("%s"), *report);
+  }
+}
+
+bool FGoogleTilesSoak::RunTest(const FString& Parameters) {
+  // The length of the run, which defaults to an hour, and how often the
+  // resources are sampled, can be set on the command line.
+  double hours = 1.0;
+  FParse::Value(FCommandLine::Get(), TEXT("CesiumSoakHours="), hours);
+  double sampleSeconds = 60.0;
+  FParse::Value(
+      FCommandLine::Get(),
+      TEXT("CesiumSoakSampleSeconds="),
+      sampleSeconds);
+
+  // Circling over central Tokyo, from Tokyo Tower to Shinjuku, Ikebukuro and
+  // Ueno, and back, so that tiles are loaded and unloaded on every lap.
+  TestPass pass{"Tokyo Loop", googleSetupRefreshTilesets, nullptr};
+  pass.cameraPath = {
+      FVector(139.7563178458, 35.652798383944, 525.62),
+      FVector(139.700, 35.690, 525.62),
+      FVector(139.711, 35.729, 525.62),
+      FVector(139.774, 35.714, 525.62),
+      FVector(139.7563178458, 35.652798383944, 525.62)};
+  pass.cameraSpeed = 100.0;
+  pass.loopCameraPath = true;
+  pass.recordFrames = false;
+  pass.sampleInterval = std::max(sampleSeconds, 1.0);
+  pass.timeout = std::max(hours, 0.0) * 3600.0;
+
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(std::move(pass));
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForTokyo,
+      testPasses,
+      TEST_SCREEN_WIDTH,
+      TEST_SCREEN_HEIGHT,
+      soakReportStep);
+}
+
+// The views added to the player's view by the multi-view passes, which are
+// removed before the next pass adds its own.
+struct ExtraViews {
+  TArray<TWeakObjectPtr<ASceneCapture2D>> sceneCaptures;
+  TWeakObjectPtr<ACesiumCameraManager> pCameraManager;
+  TArray<int32> cameraIds;
+};
+
+ExtraViews gExtraViews;
+
+void removeExtraViews() {
+  for (const TWeakObjectPtr<ASceneCapture2D>& pSceneCapture :
+       gExtraViews.sceneCaptures) {
+    if (pSceneCapture.IsValid()) {
+      pSceneCapture->Destroy();
+    }
+  }
+  if (gExtraViews.pCameraManager.IsValid()) {
+    for (int32 cameraId : gExtraViews.cameraIds) {
+      gExtraViews.pCameraManager->RemoveCamera(cameraId);
+    }
+  }
+  gExtraViews = ExtraViews();
+}
+
+// Sets up the given number of views from the start position, like the walls
+// of a cave installation, 45 degrees apart. The first is the player's view.
+// The others alternate between scene captures and camera manager cameras, so
+// both are measured.
+void multiViewSetupPass(
+    SceneGenerationContext& context,
+    TestPass::TestingParameter parameter) {
+  // The extra views render at half the resolution of the player's view.
+  constexpr int32 width = TEST_SCREEN_WIDTH / 2;
+  constexpr int32 height = TEST_SCREEN_HEIGHT / 2;
+
+  removeExtraViews();
+
+  const int viewCount = std::get<int>(parameter);
+  gExtraViews.pCameraManager =
+      ACesiumCameraManager::GetDefaultCameraManager(context.world);
+  for (int i = 1; i < viewCount; ++i) {
+    FRotator rotation = context.startRotation;
+    rotation.Yaw += 45.0 * i;
+
+    if (i % 2 == 1) {
+      ASceneCapture2D* pSceneCapture =
+          context.world->SpawnActor<ASceneCapture2D>(
+              context.startPosition,
+              rotation);
+      USceneCaptureComponent2D* pCaptureComponent =
+          pSceneCapture->GetCaptureComponent2D();
+      UTextureRenderTarget2D* pRenderTarget =
+          NewObject<UTextureRenderTarget2D>(pSceneCapture);
+      pRenderTarget->InitAutoFormat(width, height);
+      pCaptureComponent->TextureTarget = pRenderTarget;
+      pCaptureComponent->FOVAngle = context.startFieldOfView;
+      gExtraViews.sceneCaptures.Add(pSceneCapture);
+    } else if (gExtraViews.pCameraManager.IsValid()) {
+      gExtraViews.cameraIds.Add(gExtraViews.pCameraManager->AddCamera(
+          FCesiumCamera(
+              FVector2D(width, height),
+              context.startPosition,
+              rotation,
+              context.startFieldOfView)));
+    }
+  }
+}
+
+void multiViewReportStep(const std::vector<TestPass>& testPasses) {
+  // The passes after the warm-up are measured, the first of them with a
+  // single view.
+  if (testPasses.size() < 2) {
+    return;
+  }
+  const ViewCost& single = testPasses[1].viewCost;
+
+  FString report;
+  report += "\n\nMulti-View Results\n";
+  report += "-----------------------------\n";
+  report += "(view update ms) - (occlusion ms) - (tiles visited) - (tiles "
+            "rendered) - (update / occlusion / visited relative to one "
+            "view) - (pass name)\n";
+  for (size_t i = 1; i < testPasses.size(); ++i) {
+    const TestPass& pass = testPasses[i];
+    const ViewCost& cost = pass.viewCost;
+    report += FString::Printf(
+        TEXT("%.3f - %.3f - %.0f - %.0f - %.2fx / %.2fx / %.2fx - %s\n"),
+        cost.viewUpdateTime,
+        cost.occlusionUpdateTime,
+        cost.tilesVisited,
+        cost.tilesRendered,
+        single.viewUpdateTime > 0.0
+            ? cost.viewUpdateTime / single.viewUpdateTime
+            : 0.0,
+        single.occlusionUpdateTime > 0.0
+            ? cost.occlusionUpdateTime / single.occlusionUpdateTime
+            : 0.0,
+        single.tilesVisited > 0.0 ? cost.tilesVisited / single.tilesVisited
+                                  : 0.0,
+        *pass.name);
+  }
+  report += "-----------------------------\n";
+
+  UE_LOG(LogCesium, Display, TEXT("%s"), *report);
+}
+
+bool FGoogleTilesMultiView::RunTest(const FString& Parameters) {
+  gExtraViews = ExtraViews();
+
+  // The warm-up pass loads the tiles of all the views into the request
+  // cache, so that the measured passes aren't limited by the network. Each
+  // measured pass lasts long enough to average the cost of selecting tiles
+  // once they are loaded.
+  auto createPass = [](const FString& name, int viewCount) {
+    TestPass pass{name, multiViewSetupPass, nullptr, viewCount};
+    pass.minimumDuration = 10.0;
+    return pass;
+  };
+
+  std::vector<TestPass> testPasses;
+  testPasses.push_back(createPass("Warm Up", 8));
+  testPasses.push_back(createPass("1 View", 1));
+  testPasses.push_back(createPass("2 Views", 2));
+  testPasses.push_back(createPass("4 Views", 4));
+  testPasses.push_back(createPass("8 Views", 8));
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForChrysler,
+      testPasses,
+      TEST_SCREEN_WIDTH,
+      TEST_SCREEN_HEIGHT,
+      multiViewReportStep);
+}
+
 #endif
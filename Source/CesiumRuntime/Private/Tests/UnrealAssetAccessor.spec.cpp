@@ -4,9 +4,13 @@
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumRuntime.h"
 #include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/AutomationTest.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "SocketSubsystem.h"
+#include "Sockets.h"
 #include "UnrealAssetAccessor.h"
 
 BEGIN_DEFINE_SPEC(
@@ -87,4 +91,63 @@ void FUnrealAssetAccessorSpec::Define() {
 
     TestAccessorRequest(Uri, randomText);
   });
+
+  It("Limits and cancels HTTP requests to a host", [this]() {
+    // A local socket that listens but never accepts, so requests to it
+    // connect but stay in flight until they are cancelled.
+    ISocketSubsystem* pSockets =
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    FSocket* pListener =
+        pSockets->CreateSocket(NAME_Stream, TEXT("Cesium test server"), false);
+    if (!TestNotNull("listener", pListener)) {
+      return;
+    }
+    TSharedRef<FInternetAddr> pAddress = pSockets->CreateInternetAddr();
+    pAddress->SetLoopbackAddress();
+    pAddress->SetPort(0);
+    if (!TestTrue("bind", pListener->Bind(*pAddress)) ||
+        !TestTrue("listen", pListener->Listen(8))) {
+      pSockets->DestroySocket(pListener);
+      return;
+    }
+
+    const std::string server =
+        "http://127.0.0.1:" + std::to_string(pListener->GetPortNo());
+    const std::string first = server + "/first.json";
+    const std::string second = server + "/second.json";
+
+    UnrealAssetAccessor accessor{};
+    accessor.setMaximumRequestsPerHost(1);
+
+    // Shared, because the rejections may still arrive after a timeout.
+    auto pRejected = std::make_shared<int32>(0);
+    auto countRejection = [pRejected](std::exception&&) {
+      ++*pRejected;
+      return std::shared_ptr<CesiumAsync::IAssetRequest>();
+    };
+    accessor.get(getAsyncSystem(), first, {})
+        .catchInMainThread(countRejection);
+    accessor.get(getAsyncSystem(), second, {})
+        .catchInMainThread(countRejection);
+
+    TestEqual("active", accessor.getActiveRequestCount(), 1);
+    TestEqual("pending", accessor.getPendingRequestCount(), 1);
+
+    accessor.cancelRequest(second);
+    TestEqual("pending after cancel", accessor.getPendingRequestCount(), 0);
+
+    accessor.cancelRequest(first);
+    const double deadline = FPlatformTime::Seconds() + 10.0;
+    while (*pRejected < 2 && FPlatformTime::Seconds() < deadline) {
+      accessor.tick();
+      getAsyncSystem().dispatchMainThreadTasks();
+      FPlatformProcess::Sleep(0.001f);
+    }
+
+    TestEqual("rejected", *pRejected, 2);
+    TestEqual("active after cancel", accessor.getActiveRequestCount(), 0);
+
+    pListener->Close();
+    pSockets->DestroySocket(pListener);
+  });
 }
@@ -0,0 +1,72 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "UnrealTaskProcessor.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/AutomationTest.h"
+#include <atomic>
+
+BEGIN_DEFINE_SPEC(
+    FUnrealTaskProcessorSpec,
+    "Cesium.Unit.UnrealTaskProcessor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FUnrealTaskProcessorSpec)
+
+void FUnrealTaskProcessorSpec::Define() {
+  It("restores the previous priority at the end of a scope", [this]() {
+    {
+      CesiumTaskPriorityScope outer(ECesiumTaskPriority::Low);
+      {
+        CesiumTaskPriorityScope inner(ECesiumTaskPriority::High);
+        TestTrue(
+            "inner",
+            CesiumTaskPriorityScope::getCurrent() ==
+                ECesiumTaskPriority::High);
+      }
+      TestTrue(
+          "outer",
+          CesiumTaskPriorityScope::getCurrent() == ECesiumTaskPriority::Low);
+    }
+    TestTrue(
+        "default",
+        CesiumTaskPriorityScope::getCurrent() == ECesiumTaskPriority::Normal);
+  });
+
+  It("runs work started by dedicated threads with its priority", [this]() {
+    UnrealTaskProcessor processor(2);
+    TestEqual("thread count", processor.getDedicatedThreadCount(), 2);
+
+    std::atomic<int32> lowPriorityChildren{0};
+    {
+      CesiumTaskPriorityScope scope(ECesiumTaskPriority::Low);
+      for (int32 i = 0; i < 8; ++i) {
+        processor.startTask([&processor, &lowPriorityChildren]() {
+          processor.startTask([&lowPriorityChildren]() {
+            if (CesiumTaskPriorityScope::getCurrent() ==
+                ECesiumTaskPriority::Low) {
+              ++lowPriorityChildren;
+            }
+          });
+        });
+      }
+    }
+
+    const double timeout = FPlatformTime::Seconds() + 10.0;
+    while (processor.getStatistics(ECesiumTaskPriority::Low).completed < 16 &&
+           FPlatformTime::Seconds() < timeout) {
+      FPlatformProcess::Sleep(0.001f);
+    }
+    processor.shutdown();
+
+    const UnrealTaskProcessor::QueueStatistics low =
+        processor.getStatistics(ECesiumTaskPriority::Low);
+    TestEqual("submitted", low.submitted, int64(16));
+    TestEqual("completed", low.completed, int64(16));
+    TestEqual("queued", low.queued, int64(0));
+    TestEqual("children", lowPriorityChildren.load(), 8);
+    TestEqual(
+        "no high priority work",
+        processor.getStatistics(ECesiumTaskPriority::High).submitted,
+        int64(0));
+  });
+}
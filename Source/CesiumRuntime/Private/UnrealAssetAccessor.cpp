@@ -2,25 +2,38 @@
 
 #include "UnrealAssetAccessor.h"
 #include "Async/Async.h"
+#include "Async/AsyncFileHandle.h"
 #include "Async/AsyncWork.h"
+#include "Async/MappedFileHandle.h"
 
+#include "CesiumAdaptiveTileLoads.h"
 #include "CesiumAsync/AsyncSystem.h"
 #include "CesiumAsync/IAssetRequest.h"
 #include "CesiumAsync/IAssetResponse.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTilesetStatistics.h"
+#include "HAL/PlatformFileManager.h"
 #include "HttpManager.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/App.h"
+#include "Misc/Compression.h"
 #include "Misc/EngineVersion.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "PlatformHttp.h"
+#include "UnrealTaskProcessor.h"
 #include <cstddef>
+#include <algorithm>
 #include <cstring>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <uriparser/Uri.h>
+#include <vector>
 
 namespace {
 
@@ -40,11 +53,59 @@ CesiumAsync::HttpHeaders parseHeaders(const TArray<FString>& unrealHeaders) {
   return result;
 }
 
+/**
+ * Inflates gzip-compressed content into a buffer of exactly its decompressed
+ * size, which is recorded at the end of the gzip stream. Returns false if the
+ * content isn't gzip-compressed or can't be inflated in one step, such as
+ * when it holds several gzip members.
+ *
+ * The recorded size comes from the server, so it is only trusted as far as
+ * deflate can actually compress: a size more than 1032 times that of the
+ * content is rejected before anything is allocated.
+ */
+bool gunzipContent(const TArray<uint8>& content, std::vector<std::byte>& out) {
+  // A gzip stream has a 10-byte header and an 8-byte trailer.
+  constexpr int32 minimumGzipSize = 18;
+  if (content.Num() < minimumGzipSize || content[0] != 0x1f ||
+      content[1] != 0x8b) {
+    return false;
+  }
+
+  const uint8* pTrailer = content.GetData() + content.Num() - 4;
+  const uint32 uncompressedSize = uint32(pTrailer[0]) |
+                                  (uint32(pTrailer[1]) << 8) |
+                                  (uint32(pTrailer[2]) << 16) |
+                                  (uint32(pTrailer[3]) << 24);
+  constexpr int64 maximumDeflateRatio = 1032;
+  if (uncompressedSize == 0 || uncompressedSize > uint32(MAX_int32) ||
+      int64(uncompressedSize) > int64(content.Num()) * maximumDeflateRatio) {
+    return false;
+  }
+
+  out.resize(uncompressedSize);
+  if (!FCompression::UncompressMemory(
+          NAME_Gzip,
+          out.data(),
+          int32(uncompressedSize),
+          content.GetData(),
+          content.Num())) {
+    out.clear();
+    out.shrink_to_fit();
+    return false;
+  }
+
+  return true;
+}
+
 class UnrealAssetResponse : public CesiumAsync::IAssetResponse {
 public:
-  UnrealAssetResponse(FHttpResponsePtr pResponse)
+  UnrealAssetResponse(FHttpResponsePtr pResponse, bool decompress)
       : _pResponse(pResponse),
-        _headers(parseHeaders(pResponse->GetAllHeaders())) {}
+        _headers(parseHeaders(pResponse->GetAllHeaders())),
+        _decompress(decompress),
+        _decompressOnce(),
+        _decompressed(),
+        _isDecompressed(false) {}
 
   virtual uint16_t statusCode() const override {
     return static_cast<uint16_t>(this->_pResponse->GetResponseCode());
@@ -60,6 +121,21 @@ public:
 
   virtual gsl::span<const std::byte> data() const override {
     const TArray<uint8>& content = this->_pResponse->GetContent();
+
+    if (this->_decompress) {
+      // Inflated the first time the data is needed, usually in a worker
+      // thread, so that the cache stores the inflated data and the glTF
+      // reader consumes this buffer without a further copy.
+      std::call_once(this->_decompressOnce, [this, &content]() {
+        this->_isDecompressed = gunzipContent(content, this->_decompressed);
+      });
+      if (this->_isDecompressed) {
+        return gsl::span<const std::byte>(
+            this->_decompressed.data(),
+            this->_decompressed.size());
+      }
+    }
+
     return gsl::span(
         reinterpret_cast<const std::byte*>(content.GetData()),
         content.Num());
@@ -68,13 +144,21 @@ public:
 private:
   FHttpResponsePtr _pResponse;
   CesiumAsync::HttpHeaders _headers;
+  bool _decompress;
+  mutable std::once_flag _decompressOnce;
+  mutable std::vector<std::byte> _decompressed;
+  mutable bool _isDecompressed;
 };
 
 class UnrealAssetRequest : public CesiumAsync::IAssetRequest {
 public:
-  UnrealAssetRequest(FHttpRequestPtr pRequest, FHttpResponsePtr pResponse)
+  UnrealAssetRequest(
+      FHttpRequestPtr pRequest,
+      FHttpResponsePtr pResponse,
+      bool decompress)
       : _pRequest(pRequest),
-        _pResponse(std::make_unique<UnrealAssetResponse>(pResponse)) {
+        _pResponse(
+            std::make_unique<UnrealAssetResponse>(pResponse, decompress)) {
     this->_headers = parseHeaders(this->_pRequest->GetAllHeaders());
     this->_url = TCHAR_TO_UTF8(*this->_pRequest->GetURL());
     this->_method = TCHAR_TO_UTF8(*this->_pRequest->GetVerb());
@@ -102,8 +186,302 @@ private:
 
 } // namespace
 
+/**
+ * The HTTP requests of an {@link UnrealAssetAccessor} that are waiting to be
+ * sent or are in flight, grouped by host.
+ *
+ * This is shared with the completion callbacks of the requests, so that a
+ * request completing after the accessor is destroyed is still safe.
+ */
+class UnrealAssetAccessor::RequestQueue
+    : public std::enable_shared_from_this<UnrealAssetAccessor::RequestQueue> {
+public:
+  using Promise =
+      CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>;
+
+  explicit RequestQueue(int32 maximumRequestsPerHost)
+      : _lock(),
+        _hosts(),
+        _maximumRequestsPerHost(maximumRequestsPerHost),
+        _batch(0),
+        _nextSequence(0) {}
+
+  /**
+   * Adds a request to the queue of its host, and sends it right away if the
+   * host has room. The request's completion callback must call
+   * {@link onComplete}.
+   */
+  void submit(
+      const FHttpRequestPtr& pRequest,
+      const Promise& promise,
+      bool recordStatistics) {
+    const FString host = FPlatformHttp::GetUrlDomain(pRequest->GetURL());
+    {
+      FScopeLock lock(&this->_lock);
+      this->_hosts.FindOrAdd(host).pending.emplace_back(Pending{
+          pRequest,
+          promise,
+          recordStatistics,
+          0.0,
+          this->_batch,
+          this->_nextSequence++});
+    }
+    UCesiumTilesetStatistics::RecordRequestQueued(host);
+    this->dispatch(host);
+  }
+
+  /**
+   * Removes a completed request from the requests in flight, and sends the
+   * next waiting request to the same host.
+   */
+  void onComplete(
+      const FHttpRequestPtr& pRequest,
+      const FHttpResponsePtr& pResponse,
+      bool connectedSuccessfully) {
+    const FString host = FPlatformHttp::GetUrlDomain(pRequest->GetURL());
+    std::optional<Active> completed;
+    {
+      FScopeLock lock(&this->_lock);
+      Host* pHost = this->_hosts.Find(host);
+      if (pHost) {
+        auto it = std::find_if(
+            pHost->active.begin(),
+            pHost->active.end(),
+            [&pRequest](const Active& active) {
+              return active.pRequest == pRequest;
+            });
+        if (it != pHost->active.end()) {
+          completed = std::move(*it);
+          pHost->active.erase(it);
+        }
+      }
+    }
+
+    if (completed) {
+      if (completed->recordStatistics) {
+        UCesiumTilesetStatistics::RecordStage(
+            ECesiumTileLoadStage::NetworkFetch,
+            (FPlatformTime::Seconds() - completed->startTime) * 1000.0);
+      }
+
+      const bool succeeded =
+          connectedSuccessfully && pResponse.IsValid() &&
+          EHttpResponseCodes::IsOk(pResponse->GetResponseCode());
+
+      // Requests that failed to connect, or were cancelled, say nothing
+      // about how congested the network is.
+      if (pResponse.IsValid()) {
+        const int32 responseCode = pResponse->GetResponseCode();
+        CesiumAdaptiveTileLoads::recordResponse(
+            FPlatformTime::Seconds() - completed->startTime,
+            pResponse->GetContent().Num(),
+            responseCode == EHttpResponseCodes::RequestTimeout ||
+                responseCode == EHttpResponseCodes::TooManyRequests ||
+                responseCode == EHttpResponseCodes::ServiceUnavail ||
+                responseCode == EHttpResponseCodes::GatewayTimeout);
+      }
+      UCesiumTilesetStatistics::RecordRequestFinished(
+          host,
+          true,
+          succeeded,
+          pResponse.IsValid() ? pResponse->GetContent().Num() : 0);
+    }
+
+    this->dispatch(host);
+  }
+
+  void setPriority(const FString& url, double priority) {
+    const FString host = FPlatformHttp::GetUrlDomain(url);
+    FScopeLock lock(&this->_lock);
+    Host* pHost = this->_hosts.Find(host);
+    if (pHost) {
+      for (Pending& pending : pHost->pending) {
+        if (pending.pRequest->GetURL() == url) {
+          pending.priority = priority;
+        }
+      }
+    }
+  }
+
+  void cancel(const FString& url) {
+    const FString host = FPlatformHttp::GetUrlDomain(url);
+    std::vector<Pending> cancelledPending;
+    std::vector<FHttpRequestPtr> cancelledActive;
+    {
+      FScopeLock lock(&this->_lock);
+      Host* pHost = this->_hosts.Find(host);
+      if (!pHost) {
+        return;
+      }
+
+      auto pendingEnd = std::stable_partition(
+          pHost->pending.begin(),
+          pHost->pending.end(),
+          [&url](const Pending& pending) {
+            return pending.pRequest->GetURL() != url;
+          });
+      cancelledPending.insert(
+          cancelledPending.end(),
+          std::make_move_iterator(pendingEnd),
+          std::make_move_iterator(pHost->pending.end()));
+      pHost->pending.erase(pendingEnd, pHost->pending.end());
+
+      for (const Active& active : pHost->active) {
+        if (active.pRequest->GetURL() == url) {
+          cancelledActive.emplace_back(active.pRequest);
+        }
+      }
+    }
+
+    // Requests that were never sent have no completion callback to reject
+    // their promise, so reject it here. Cancelling a request in flight
+    // invokes its completion callback, which rejects the promise and calls
+    // onComplete. Neither may happen while the lock is held.
+    for (Pending& pending : cancelledPending) {
+      pending.pRequest->OnProcessRequestComplete().Unbind();
+      pending.promise.reject(std::runtime_error("Request cancelled."));
+      UCesiumTilesetStatistics::RecordRequestFinished(host, false, false, 0);
+    }
+
+    for (const FHttpRequestPtr& pRequest : cancelledActive) {
+      pRequest->CancelRequest();
+    }
+  }
+
+  void onTick() {
+    FScopeLock lock(&this->_lock);
+    ++this->_batch;
+  }
+
+  void setMaximumRequestsPerHost(int32 maximumRequestsPerHost) {
+    TArray<FString> hosts;
+    {
+      FScopeLock lock(&this->_lock);
+      this->_maximumRequestsPerHost = maximumRequestsPerHost;
+      this->_hosts.GetKeys(hosts);
+    }
+
+    // Raising the limit may leave room for waiting requests.
+    for (const FString& host : hosts) {
+      this->dispatch(host);
+    }
+  }
+
+  int32 getMaximumRequestsPerHost() const {
+    FScopeLock lock(&this->_lock);
+    return this->_maximumRequestsPerHost;
+  }
+
+  int32 getPendingRequestCount() const {
+    FScopeLock lock(&this->_lock);
+    int32 count = 0;
+    for (const auto& pair : this->_hosts) {
+      count += int32(pair.Value.pending.size());
+    }
+    return count;
+  }
+
+  int32 getActiveRequestCount() const {
+    FScopeLock lock(&this->_lock);
+    int32 count = 0;
+    for (const auto& pair : this->_hosts) {
+      count += int32(pair.Value.active.size());
+    }
+    return count;
+  }
+
+private:
+  struct Pending {
+    FHttpRequestPtr pRequest;
+    Promise promise;
+    bool recordStatistics;
+    double priority;
+    uint64 batch;
+    uint64 sequence;
+  };
+
+  struct Active {
+    FHttpRequestPtr pRequest;
+    bool recordStatistics;
+    double startTime;
+  };
+
+  struct Host {
+    std::vector<Pending> pending;
+    std::vector<Active> active;
+  };
+
+  /**
+   * Determines if waiting request `a` should be sent before `b`: lower
+   * priority values first, then requests from the most recent batch, then
+   * requests in the order they were made.
+   */
+  static bool isMoreUrgent(const Pending& a, const Pending& b) {
+    if (a.priority != b.priority) {
+      return a.priority < b.priority;
+    }
+    if (a.batch != b.batch) {
+      return a.batch > b.batch;
+    }
+    return a.sequence < b.sequence;
+  }
+
+  /**
+   * Sends the most urgent waiting requests to the given host until it is at
+   * its limit.
+   */
+  void dispatch(const FString& host) {
+    std::vector<FHttpRequestPtr> toSend;
+    {
+      FScopeLock lock(&this->_lock);
+      Host* pHost = this->_hosts.Find(host);
+      if (!pHost) {
+        return;
+      }
+
+      while (!pHost->pending.empty() &&
+             (this->_maximumRequestsPerHost <= 0 ||
+              int32(pHost->active.size()) < this->_maximumRequestsPerHost)) {
+        auto it = std::min_element(
+            pHost->pending.begin(),
+            pHost->pending.end(),
+            isMoreUrgent);
+        pHost->active.emplace_back(Active{
+            it->pRequest,
+            it->recordStatistics,
+            FPlatformTime::Seconds()});
+        toSend.emplace_back(std::move(it->pRequest));
+        pHost->pending.erase(it);
+      }
+
+      if (pHost->pending.empty() && pHost->active.empty()) {
+        this->_hosts.Remove(host);
+      }
+    }
+
+    for (const FHttpRequestPtr& pRequest : toSend) {
+      UCesiumTilesetStatistics::RecordRequestStarted(host);
+      pRequest->ProcessRequest();
+    }
+  }
+
+  mutable FCriticalSection _lock;
+  TMap<FString, Host> _hosts;
+  int32 _maximumRequestsPerHost;
+  uint64 _batch;
+  uint64 _nextSequence;
+};
+
 UnrealAssetAccessor::UnrealAssetAccessor()
-    : _userAgent(), _cesiumRequestHeaders() {
+    : _userAgent(),
+      _cesiumRequestHeaders(),
+      _pRequestQueue(std::make_shared<RequestQueue>(
+          GetDefault<UCesiumRuntimeSettings>()
+              ->MaximumSimultaneousRequestsPerHost)),
+      _completeOnHttpThread(
+          GetDefault<UCesiumRuntimeSettings>()->CompleteRequestsOnHttpThread),
+      _decompressResponses(
+          GetDefault<UCesiumRuntimeSettings>()->CacheDecompressedResponses) {
   FString OsVersion, OsSubVersion;
   FPlatformMisc::GetOSVersions(OsVersion, OsSubVersion);
   OsVersion += " " + FPlatformMisc::GetOSVersion();
@@ -164,9 +542,18 @@ UnrealAssetAccessor::get(
   const FString& userAgent = this->_userAgent;
   const TMap<FString, FString>& cesiumRequestHeaders =
       this->_cesiumRequestHeaders;
+  const std::shared_ptr<RequestQueue>& pRequestQueue = this->_pRequestQueue;
+  const bool completeOnHttpThread = this->_completeOnHttpThread;
+  const bool decompress = this->_decompressResponses;
 
   return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
-      [&url, &headers, &userAgent, &cesiumRequestHeaders](const auto& promise) {
+      [&url,
+       &headers,
+       &userAgent,
+       &cesiumRequestHeaders,
+       &pRequestQueue,
+       completeOnHttpThread,
+       decompress](const auto& promise) {
         FHttpModule& httpModule = FHttpModule::Get();
         TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
             httpModule.CreateRequest();
@@ -184,17 +571,38 @@ UnrealAssetAccessor::get(
 
         pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
 
+        if (completeOnHttpThread) {
+          pRequest->SetDelegateThreadPolicy(
+              EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+        }
+
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise, CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
+            [promise,
+             pWeakQueue = std::weak_ptr<RequestQueue>(pRequestQueue),
+             decompress,
+             priority = CesiumTaskPriorityScope::getCurrent(),
+             CESIUM_TRACE_LAMBDA_CAPTURE_TRACK()](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) mutable {
               CESIUM_TRACE_USE_CAPTURED_TRACK();
               CESIUM_TRACE_END_IN_TRACK("requestAsset");
 
+              // The work continuing from the response has the priority of the
+              // work that made the request.
+              CesiumTaskPriorityScope priorityScope(priority);
+
+              std::shared_ptr<RequestQueue> pQueue = pWeakQueue.lock();
+              if (pQueue) {
+                pQueue->onComplete(pRequest, pResponse, connectedSuccessfully);
+              }
+
               if (connectedSuccessfully) {
                 promise.resolve(
-                    std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
+                    std::make_unique<UnrealAssetRequest>(
+                        pRequest,
+                        pResponse,
+                        decompress));
               } else {
                 switch (pRequest->GetStatus()) {
                 case EHttpRequestStatus::Failed_ConnectionError:
@@ -205,7 +613,7 @@ UnrealAssetAccessor::get(
               }
             });
 
-        pRequest->ProcessRequest();
+        pRequestQueue->submit(pRequest, promise, true);
       });
 }
 
@@ -220,6 +628,8 @@ UnrealAssetAccessor::request(
   const FString& userAgent = this->_userAgent;
   const TMap<FString, FString>& cesiumRequestHeaders =
       this->_cesiumRequestHeaders;
+  const std::shared_ptr<RequestQueue>& pRequestQueue = this->_pRequestQueue;
+  const bool completeOnHttpThread = this->_completeOnHttpThread;
 
   return asyncSystem.createFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>(
       [&verb,
@@ -227,7 +637,9 @@ UnrealAssetAccessor::request(
        &headers,
        &userAgent,
        &cesiumRequestHeaders,
-       &contentPayload](const auto& promise) {
+       &contentPayload,
+       &pRequestQueue,
+       completeOnHttpThread](const auto& promise) {
         FHttpModule& httpModule = FHttpModule::Get();
         TSharedRef<IHttpRequest, ESPMode::ThreadSafe> pRequest =
             httpModule.CreateRequest();
@@ -246,18 +658,34 @@ UnrealAssetAccessor::request(
 
         pRequest->AppendToHeader(TEXT("User-Agent"), userAgent);
 
+        if (completeOnHttpThread) {
+          pRequest->SetDelegateThreadPolicy(
+              EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+        }
+
         pRequest->SetContent(TArray<uint8>(
             reinterpret_cast<const uint8*>(contentPayload.data()),
             contentPayload.size()));
 
         pRequest->OnProcessRequestComplete().BindLambda(
-            [promise](
+            [promise,
+             pWeakQueue = std::weak_ptr<RequestQueue>(pRequestQueue),
+             priority = CesiumTaskPriorityScope::getCurrent()](
                 FHttpRequestPtr pRequest,
                 FHttpResponsePtr pResponse,
                 bool connectedSuccessfully) {
+              CesiumTaskPriorityScope priorityScope(priority);
+              std::shared_ptr<RequestQueue> pQueue = pWeakQueue.lock();
+              if (pQueue) {
+                pQueue->onComplete(pRequest, pResponse, connectedSuccessfully);
+              }
+
               if (connectedSuccessfully) {
                 promise.resolve(
-                    std::make_unique<UnrealAssetRequest>(pRequest, pResponse));
+                    std::make_unique<UnrealAssetRequest>(
+                        pRequest,
+                        pResponse,
+                        false));
               } else {
                 switch (pRequest->GetStatus()) {
                 case EHttpRequestStatus::Failed_ConnectionError:
@@ -268,13 +696,48 @@ UnrealAssetAccessor::request(
               }
             });
 
-        pRequest->ProcessRequest();
+        pRequestQueue->submit(pRequest, promise, false);
       });
 }
 
 void UnrealAssetAccessor::tick() noexcept {
-  FHttpManager& manager = FHttpModule::Get().GetHttpManager();
-  manager.Tick(0.0f);
+  // When requests complete on the HTTP thread, they don't need the manager to
+  // be ticked in order to finish.
+  if (!this->_completeOnHttpThread) {
+    FHttpManager& manager = FHttpModule::Get().GetHttpManager();
+    manager.Tick(0.0f);
+  }
+
+  // Requests made from here on are more urgent than those still waiting from
+  // earlier ticks.
+  this->_pRequestQueue->onTick();
+}
+
+void UnrealAssetAccessor::setMaximumRequestsPerHost(
+    int32 maximumRequestsPerHost) {
+  this->_pRequestQueue->setMaximumRequestsPerHost(maximumRequestsPerHost);
+}
+
+int32 UnrealAssetAccessor::getMaximumRequestsPerHost() const {
+  return this->_pRequestQueue->getMaximumRequestsPerHost();
+}
+
+void UnrealAssetAccessor::setRequestPriority(
+    const std::string& url,
+    double priority) {
+  this->_pRequestQueue->setPriority(UTF8_TO_TCHAR(url.c_str()), priority);
+}
+
+void UnrealAssetAccessor::cancelRequest(const std::string& url) {
+  this->_pRequestQueue->cancel(UTF8_TO_TCHAR(url.c_str()));
+}
+
+int32 UnrealAssetAccessor::getPendingRequestCount() const {
+  return this->_pRequestQueue->getPendingRequestCount();
+}
+
+int32 UnrealAssetAccessor::getActiveRequestCount() const {
+  return this->_pRequestQueue->getActiveRequestCount();
 }
 
 namespace {
@@ -286,7 +749,25 @@ public:
       std::string&& url,
       uint16_t statusCode,
       TArray64<uint8>&& data)
-      : _url(std::move(url)), _statusCode(statusCode), _data(data) {}
+      : _url(std::move(url)),
+        _statusCode(statusCode),
+        _data(std::move(data)),
+        _pMappedFile(),
+        _pMappedRegion() {}
+
+  /**
+   * Creates a successful response whose data is read directly from a
+   * memory-mapped file, without copying it.
+   */
+  UnrealFileAssetRequestResponse(
+      std::string&& url,
+      TUniquePtr<IMappedFileHandle>&& pMappedFile,
+      TUniquePtr<IMappedFileRegion>&& pMappedRegion)
+      : _url(std::move(url)),
+        _statusCode(200),
+        _data(),
+        _pMappedFile(std::move(pMappedFile)),
+        _pMappedRegion(std::move(pMappedRegion)) {}
 
   virtual const std::string& method() const { return getMethod; }
 
@@ -305,6 +786,13 @@ public:
   virtual std::string contentType() const override { return std::string(); }
 
   virtual gsl::span<const std::byte> data() const override {
+    if (this->_pMappedRegion) {
+      return gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(
+              this->_pMappedRegion->GetMappedPtr()),
+          size_t(this->_pMappedRegion->GetMappedSize()));
+    }
+
     return gsl::span<const std::byte>(
         reinterpret_cast<const std::byte*>(this->_data.GetData()),
         size_t(this->_data.Num()));
@@ -317,6 +805,11 @@ private:
   std::string _url;
   uint16_t _statusCode;
   TArray64<uint8> _data;
+
+  // The region must be unmapped before the file handle is closed, so it is
+  // declared after the handle and destroyed before it.
+  TUniquePtr<IMappedFileHandle> _pMappedFile;
+  TUniquePtr<IMappedFileRegion> _pMappedRegion;
 };
 
 const std::string UnrealFileAssetRequestResponse::getMethod = "GET";
@@ -351,6 +844,25 @@ std::string convertFileUriToFilename(const std::string& url) {
   return result;
 }
 
+/**
+ * A read of a whole file with the platform's asynchronous file I/O. The read
+ * request must not be deleted before its callback has returned, so it is
+ * waited for when this is destroyed.
+ */
+struct FCesiumAsyncFileRead {
+  TArray64<uint8> data;
+  TUniquePtr<IAsyncReadFileHandle> pHandle;
+  TUniquePtr<IAsyncReadRequest> pRequest;
+
+  ~FCesiumAsyncFileRead() {
+    if (this->pRequest) {
+      this->pRequest->WaitCompletion();
+      this->pRequest.Reset();
+    }
+    this->pHandle.Reset();
+  }
+};
+
 class FCesiumReadFileWorker : public FNonAbandonableTask {
 public:
   FCesiumReadFileWorker(
@@ -359,8 +871,8 @@ public:
       : _url(url),
         _promise(
             asyncSystem
-                .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()) {
-  }
+                .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>()),
+        _pAsyncRead() {}
 
   FORCEINLINE TStatId GetStatId() const {
     RETURN_QUICK_DECLARE_CYCLE_STAT(
@@ -375,6 +887,27 @@ public:
   void DoWork() {
     FString filename =
         UTF8_TO_TCHAR(convertFileUriToFilename(this->_url).c_str());
+
+    // Map the file when the platform supports it, so that its contents are
+    // paged in from disk on demand instead of being copied into memory.
+    TUniquePtr<IMappedFileHandle> pMappedFile(
+        FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*filename));
+    if (pMappedFile && pMappedFile->GetFileSize() > 0) {
+      TUniquePtr<IMappedFileRegion> pMappedRegion(pMappedFile->MapRegion());
+      if (pMappedRegion) {
+        this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
+            std::move(this->_url),
+            std::move(pMappedFile),
+            std::move(pMappedRegion)));
+        return;
+      }
+    }
+    pMappedFile.Reset();
+
+    if (this->readAsync(filename)) {
+      return;
+    }
+
     TArray64<uint8> data;
     if (FFileHelper::LoadFileToArray(data, *filename)) {
       this->_promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
@@ -390,8 +923,57 @@ public:
   }
 
 private:
+  /**
+   * Starts reading a file that can't be mapped, such as one in a compressed
+   * pak file, with the platform's asynchronous file I/O. It reads straight
+   * into the response's buffer, and any decompression is done by the I/O
+   * system, so this thread doesn't wait for the disk. The promise is resolved
+   * once the file has been read.
+   *
+   * @return False if the read couldn't be started, in which case the file
+   * should be read synchronously instead.
+   */
+  bool readAsync(const FString& filename) {
+    IPlatformFile& platformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const int64 size = platformFile.FileSize(*filename);
+    if (size <= 0) {
+      return false;
+    }
+
+    this->_pAsyncRead = MakeUnique<FCesiumAsyncFileRead>();
+    FCesiumAsyncFileRead& read = *this->_pAsyncRead;
+    read.pHandle.Reset(platformFile.OpenAsyncRead(*filename));
+    if (!read.pHandle) {
+      this->_pAsyncRead.Reset();
+      return false;
+    }
+    read.data.SetNumUninitialized(size);
+
+    FAsyncFileCallBack callback = [&read,
+                                   url = this->_url,
+                                   promise = this->_promise](
+                                      bool wasCancelled,
+                                      IAsyncReadRequest* pRequest) mutable {
+      const bool succeeded = !wasCancelled && pRequest->GetReadResults();
+      promise.resolve(std::make_shared<UnrealFileAssetRequestResponse>(
+          std::move(url),
+          succeeded ? 200 : 404,
+          succeeded ? MoveTemp(read.data) : TArray64<uint8>()));
+    };
+    read.pRequest.Reset(read.pHandle->ReadRequest(
+        0,
+        size,
+        AIOP_Normal,
+        &callback,
+        read.data.GetData()));
+    return true;
+  }
+
   std::string _url;
   CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> _promise;
+  // The read in progress, if the file is read asynchronously. It is kept
+  // until the task is destroyed, after the promise has been resolved.
+  TUniquePtr<FCesiumAsyncFileRead> _pAsyncRead;
 };
 
 } // namespace
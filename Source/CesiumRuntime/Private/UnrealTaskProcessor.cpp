@@ -1,12 +1,340 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "UnrealTaskProcessor.h"
-#include "Async/Async.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
 #include "Misc/QueuedThreadPool.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <vector>
 
-void UnrealTaskProcessor::startTask(std::function<void()> f) {
-  AsyncTask(ENamedThreads::Type::AnyBackgroundThreadNormalTask, [f]() {
+namespace {
+
+thread_local ECesiumTaskPriority currentPriority = ECesiumTaskPriority::Normal;
+
+// The pool of the dedicated thread running on this thread, if any, and the
+// index of that thread in it.
+thread_local const void* pCurrentPool = nullptr;
+thread_local int32 currentWorker = INDEX_NONE;
+
+} // namespace
+
+CesiumTaskPriorityScope::CesiumTaskPriorityScope(
+    ECesiumTaskPriority priority) noexcept
+    : _previous(currentPriority) {
+  currentPriority = priority;
+}
+
+CesiumTaskPriorityScope::~CesiumTaskPriorityScope() noexcept {
+  currentPriority = this->_previous;
+}
+
+ECesiumTaskPriority CesiumTaskPriorityScope::getCurrent() noexcept {
+  return currentPriority;
+}
+
+struct UnrealTaskProcessor::Task {
+  std::function<void()> function;
+  ECesiumTaskPriority priority = ECesiumTaskPriority::Normal;
+  Counters* pCounters = nullptr;
+
+  void run() {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::AsyncTask)
-    f();
-  });
+    ++this->pCounters->started;
+    CesiumTaskPriorityScope scope(this->priority);
+    this->function();
+    ++this->pCounters->completed;
+  }
+};
+
+/**
+ * A task graph task that holds a Cesium task itself, rather than a function
+ * that runs it, like AsyncTask does. The task is moved into the block the
+ * task graph allocates for each of its tasks, so this needs no further
+ * allocation.
+ */
+class UnrealTaskProcessor::FCesiumGraphTask {
+public:
+  FCesiumGraphTask(Task&& task, ENamedThreads::Type thread)
+      : _task(std::move(task)), _thread(thread) {}
+
+  ENamedThreads::Type GetDesiredThread() const { return this->_thread; }
+
+  static ESubsequentsMode::Type GetSubsequentsMode() {
+    return ESubsequentsMode::FireAndForget;
+  }
+
+  TStatId GetStatId() const {
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FCesiumGraphTask, STATGROUP_TaskGraphTasks);
+  }
+
+  void DoTask(ENamedThreads::Type, const FGraphEventRef&) {
+    this->_task.run();
+  }
+
+private:
+  Task _task;
+  ENamedThreads::Type _thread;
+};
+
+class UnrealTaskProcessor::WorkerPool {
+public:
+  WorkerPool(UnrealTaskProcessor& processor, int32 threadCount)
+      : _processor(processor), _activeThreadCount(threadCount) {
+    this->_queues.reserve(threadCount);
+    for (int32 i = 0; i < threadCount; ++i) {
+      this->_queues.emplace_back(std::make_unique<Queues>());
+    }
+
+    this->_workers.reserve(threadCount);
+    for (int32 i = 0; i < threadCount; ++i) {
+      Worker& worker =
+          *this->_workers.emplace_back(std::make_unique<Worker>(*this, i));
+      worker.pThread = FRunnableThread::Create(
+          &worker,
+          *FString::Printf(TEXT("CesiumWorker %d"), i),
+          0,
+          TPri_BelowNormal);
+    }
+  }
+
+  ~WorkerPool() noexcept { this->stop(); }
+
+  int32 getThreadCount() const noexcept {
+    return int32(this->_workers.size());
+  }
+
+  /**
+   * Adds work of the given priority to the queue of the dedicated thread this
+   * is called from, or to the shared queue. Returns false, without adding
+   * the work, if the threads have been stopped.
+   */
+  bool push(Task&& task) {
+    {
+      std::lock_guard<std::mutex> lock(this->_wakeMutex);
+      if (this->_stopping) {
+        return false;
+      }
+      ++this->_pending;
+    }
+
+    Queues& queues = pCurrentPool == this ? *this->_queues[currentWorker]
+                                          : this->_shared;
+    {
+      std::lock_guard<std::mutex> lock(queues.mutex);
+      queues.tasks[size_t(task.priority)].emplace_back(std::move(task));
+    }
+
+    // A thread that isn't active would ignore the notification.
+    if (this->_activeThreadCount < this->getThreadCount()) {
+      this->_wake.notify_all();
+    } else {
+      this->_wake.notify_one();
+    }
+    return true;
+  }
+
+  void setActiveThreadCount(int32 count) noexcept {
+    {
+      std::lock_guard<std::mutex> lock(this->_wakeMutex);
+      if (this->_stopping) {
+        return;
+      }
+      this->_activeThreadCount =
+          FMath::Clamp(count, 1, this->getThreadCount());
+    }
+    this->_wake.notify_all();
+  }
+
+  /**
+   * Stops the threads after they finish all of the work that has been added.
+   */
+  void stop() noexcept {
+    {
+      std::lock_guard<std::mutex> lock(this->_wakeMutex);
+      this->_stopping = true;
+      // All of the threads finish the work.
+      this->_activeThreadCount = this->getThreadCount();
+    }
+    this->_wake.notify_all();
+
+    for (const std::unique_ptr<Worker>& pWorker : this->_workers) {
+      if (pWorker->pThread) {
+        pWorker->pThread->WaitForCompletion();
+        delete pWorker->pThread;
+        pWorker->pThread = nullptr;
+      }
+    }
+  }
+
+private:
+  struct Queues {
+    std::mutex mutex;
+    std::array<std::deque<Task>, PriorityCount> tasks;
+  };
+
+  class Worker : public FRunnable {
+  public:
+    Worker(WorkerPool& pool, int32 index) : pool(pool), index(index) {}
+
+    virtual uint32 Run() override {
+      this->pool.run(this->index);
+      return 0;
+    }
+
+    WorkerPool& pool;
+    int32 index;
+    FRunnableThread* pThread = nullptr;
+  };
+
+  static bool takeNewest(Queues& queues, size_t priority, Task& task) {
+    std::lock_guard<std::mutex> lock(queues.mutex);
+    std::deque<Task>& tasks = queues.tasks[priority];
+    if (tasks.empty()) {
+      return false;
+    }
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    return true;
+  }
+
+  static bool takeOldest(Queues& queues, size_t priority, Task& task) {
+    std::lock_guard<std::mutex> lock(queues.mutex);
+    std::deque<Task>& tasks = queues.tasks[priority];
+    if (tasks.empty()) {
+      return false;
+    }
+    task = std::move(tasks.front());
+    tasks.pop_front();
+    return true;
+  }
+
+  bool take(int32 index, Task& task) {
+    const int32 count = int32(this->_queues.size());
+    for (size_t priority = 0; priority < PriorityCount; ++priority) {
+      if (takeNewest(*this->_queues[index], priority, task) ||
+          takeOldest(this->_shared, priority, task)) {
+        return true;
+      }
+
+      for (int32 i = 1; i < count; ++i) {
+        if (takeOldest(*this->_queues[(index + i) % count], priority, task)) {
+          ++this->_processor._counters[priority].stolen;
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void run(int32 index) {
+    pCurrentPool = this;
+    currentWorker = index;
+
+    Task task;
+    while (true) {
+      if (index < this->_activeThreadCount && this->take(index, task)) {
+        --this->_pending;
+        task.run();
+        task.function = nullptr;
+        continue;
+      }
+
+      // Work counted as pending may not have been added to its queue yet, in
+      // which case this looks again until it is.
+      std::unique_lock<std::mutex> lock(this->_wakeMutex);
+      this->_wake.wait(lock, [this, index]() {
+        return (this->_pending > 0 && index < this->_activeThreadCount) ||
+               this->_stopping;
+      });
+      if (this->_pending == 0 && this->_stopping) {
+        break;
+      }
+    }
+
+    pCurrentPool = nullptr;
+    currentWorker = INDEX_NONE;
+  }
+
+  UnrealTaskProcessor& _processor;
+  std::vector<std::unique_ptr<Queues>> _queues;
+  Queues _shared;
+  std::vector<std::unique_ptr<Worker>> _workers;
+
+  std::mutex _wakeMutex;
+  std::condition_variable _wake;
+  std::atomic<int64> _pending{0};
+  std::atomic<int32> _activeThreadCount;
+  bool _stopping = false;
+};
+
+UnrealTaskProcessor::UnrealTaskProcessor(int32 dedicatedThreadCount)
+    : _pPool(
+          dedicatedThreadCount > 0
+              ? std::make_unique<WorkerPool>(*this, dedicatedThreadCount)
+              : nullptr),
+      _pActivePool(this->_pPool.get()) {}
+
+UnrealTaskProcessor::~UnrealTaskProcessor() noexcept { this->shutdown(); }
+
+void UnrealTaskProcessor::startTask(std::function<void()> f) {
+  const ECesiumTaskPriority priority = currentPriority;
+  Counters& counters = this->_counters[size_t(priority)];
+  ++counters.submitted;
+
+  // The function is moved, never copied, from here until it runs, so that
+  // the state it captures is not copied either.
+  Task task{std::move(f), priority, &counters};
+
+  WorkerPool* pPool = this->_pActivePool;
+  if (!pPool || !pPool->push(std::move(task))) {
+    startOnTaskGraph(std::move(task));
+  }
+}
+
+UnrealTaskProcessor::QueueStatistics UnrealTaskProcessor::getStatistics(
+    ECesiumTaskPriority priority) const noexcept {
+  const Counters& counters = this->_counters[size_t(priority)];
+  QueueStatistics result;
+  result.submitted = counters.submitted;
+  result.completed = counters.completed;
+  result.stolen = counters.stolen;
+  result.queued = result.submitted - counters.started;
+  return result;
+}
+
+int32 UnrealTaskProcessor::getDedicatedThreadCount() const noexcept {
+  const WorkerPool* pPool = this->_pActivePool;
+  return pPool ? pPool->getThreadCount() : 0;
+}
+
+void UnrealTaskProcessor::setActiveDedicatedThreadCount(
+    int32 count) noexcept {
+  WorkerPool* pPool = this->_pActivePool;
+  if (pPool) {
+    pPool->setActiveThreadCount(count);
+  }
+}
+
+void UnrealTaskProcessor::shutdown() noexcept {
+  // The pool itself is kept until this is destroyed, in case work is added
+  // to it at the same time. It refuses that work once it is stopped.
+  this->_pActivePool = nullptr;
+  if (this->_pPool) {
+    this->_pPool->stop();
+  }
+}
+
+void UnrealTaskProcessor::startOnTaskGraph(Task&& task) noexcept {
+  const ENamedThreads::Type thread =
+      task.priority == ECesiumTaskPriority::High
+          ? ENamedThreads::Type::AnyBackgroundHiPriTask
+          : ENamedThreads::Type::AnyBackgroundThreadNormalTask;
+  TGraphTask<FCesiumGraphTask>::CreateTask().ConstructAndDispatchWhenReady(
+      std::move(task),
+      thread);
 }
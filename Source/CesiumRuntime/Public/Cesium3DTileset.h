@@ -12,24 +12,49 @@
 #include "CesiumGeoreference.h"
 #include "CesiumIonServer.h"
 #include "CesiumPointCloudShading.h"
+#include "CesiumMemoryUsage.h"
+#include "CesiumPrimitiveComponentPoolStats.h"
+#include "CesiumSampleHeightResult.h"
+#include "CesiumTileFinalizationStats.h"
+#include "CesiumVoxelRendering.h"
 #include "CoreMinimal.h"
 #include "CustomDepthParameters.h"
 #include "Engine/EngineTypes.h"
 #include "GameFramework/Actor.h"
+#include "HAL/CriticalSection.h"
 #include "Interfaces/IHttpRequest.h"
 #include "PrimitiveSceneProxy.h"
+#include "VT/RuntimeVirtualTextureEnum.h"
 #include <PhysicsEngine/BodyInstance.h>
 #include <atomic>
 #include <chrono>
 #include <glm/mat4x4.hpp>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include "Cesium3DTileset.generated.h"
 
 class UMaterialInterface;
+class UCesiumGltfComponent;
+class CesiumPrimitiveComponentPool;
+class CesiumMaterialInstanceCache;
+class CesiumInstanceBatches;
+class CesiumMemoryUsageTracker;
+class CesiumLinkedTileComponents;
+class CesiumTileStateChanges;
+struct CesiumSampleHeightQuery;
+struct FCesiumGltfPointsSceneProxyTilesetSettings;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
-class UCesiumBoundingVolumePoolComponent;
+class APlayerController;
+class CesiumCompiledFeatureStyle;
+class CesiumHorizonCuller;
+class CesiumSelectionTrace;
+class ICesiumTileContentBuilder;
+class CesiumTileDistanceExcluder;
+class CesiumCancellableAssetAccessor;
+class CesiumOcclusionProxyPool;
+class URuntimeVirtualTexture;
 class CesiumViewExtension;
 struct FCesiumCamera;
 
@@ -39,6 +64,14 @@ class TilesetView;
 class TileOcclusionRendererProxyPool;
 } // namespace Cesium3DTilesSelection
 
+namespace CesiumAsync {
+template <typename T> class Future;
+}
+
+namespace CesiumEncodedFeaturesMetadata {
+class IndexedFeaturesMetadataDescription;
+}
+
 /**
  * The delegate for OnCesium3DTilesetLoadFailure, which is triggered when
  * the tileset encounters a load error.
@@ -67,12 +100,84 @@ enum class ETilesetSource : uint8 {
   /**
    * The tileset will be loaded from the specified Url.
    */
-  FromUrl UMETA(DisplayName = "From Url")
+  FromUrl UMETA(DisplayName = "From Url"),
+
+  /**
+   * The tileset will be loaded from the specified local 3D Tiles package
+   * (.3tz) file.
+   */
+  FromLocalPackage UMETA(DisplayName = "From Local 3D Tiles Package")
 };
 
 UENUM(BlueprintType)
 enum class EApplyDpiScaling : uint8 { Yes, No, UseProjectDefault };
 
+/**
+ * A per-tile cost that the tiles of a tileset can be colored by, to find the
+ * tiles that are expensive to load or to render.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTileCostMetric : uint8 {
+  /**
+   * Tiles are shown with their own colors.
+   */
+  None,
+
+  /**
+   * The time, in milliseconds, spent creating the tile's meshes in a worker
+   * thread and its components in the game thread.
+   */
+  LoadTime,
+
+  /**
+   * The number of triangles in the tile's meshes, including those of all of
+   * its instances.
+   */
+  TriangleCount,
+
+  /**
+   * The size of the tile's textures, including textures that are shared with
+   * other tiles.
+   */
+  TextureBytes,
+
+  /**
+   * The number of mesh sections that the tile's primitives draw.
+   */
+  DrawCalls,
+
+  /**
+   * The depth of the tile in the tileset's tile tree, where the root tile is
+   * zero.
+   */
+  RefinementDepth
+};
+
+/**
+ * Which of the data of a tile's glTF is kept in CPU memory once its meshes and
+ * textures have been created on the GPU.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTileBufferResidency : uint8 {
+  /**
+   * All of the glTF's buffers are kept.
+   */
+  KeepAll,
+
+  /**
+   * Only the positions and indices of the glTF's primitives are kept, which
+   * are needed to build physics meshes on demand, to sample heights, and to
+   * find the texture coordinates of hits from their face indices.
+   */
+  KeepPickingData,
+
+  /**
+   * None of the glTF's buffers are kept. Heights can't be sampled from the
+   * tileset, and physics meshes can't be built on demand.
+   */
+  KeepNothing
+};
+
 UCLASS()
 class CESIUMRUNTIME_API ACesium3DTileset : public AActor {
   GENERATED_BODY()
@@ -227,17 +332,6 @@ private:
       Meta = (AllowPrivateAccess))
   ACesiumCameraManager* ResolvedCameraManager = nullptr;
 
-  /**
-   * The bounding volume pool component that manages occlusion bounding volume
-   * proxies.
-   */
-  UPROPERTY(
-      Transient,
-      BlueprintReadOnly,
-      Category = "Cesium",
-      Meta = (AllowPrivateAccess))
-  UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
-
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -277,6 +371,39 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   bool ShowCreditsOnScreen = false;
 
+  /**
+   * Another tileset whose tiles this tileset shows instead of loading its
+   * own, such as the same tileset in a mirror world for a minimap.
+   *
+   * This tileset then loads nothing. Instead, the linked tileset also selects
+   * tiles for the views of this tileset, and this tileset shows copies of the
+   * tiles that the linked tileset has loaded, at its own transform. The
+   * copies share the meshes and textures of the linked tileset, so the tiles
+   * are downloaded and kept in GPU memory only once. They use the Material
+   * and Translucent Material of this tileset, if it has its own, and have no
+   * collision. Instanced tiles are not shown.
+   *
+   * A tileset that is itself linked to another can't be linked to.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ACesium3DTileset* LinkedTileset = nullptr;
+
+  /**
+   * Whether this tileset shares its tiles with the tilesets of all worlds,
+   * such as the editor world and a Play In Editor world, or the worlds of a
+   * multi-world server, that load the same source and set this too.
+   *
+   * Of these tilesets, the first one to update loads the tiles, and the others
+   * behave as if it was their Linked Tileset, except that it may be in
+   * another world, and that their copies of its tiles have its collision.
+   * When the world of the tileset that loads the tiles is cleaned up, another
+   * one of them loads them.
+   *
+   * This is ignored if the Linked Tileset is set.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool ShareTilesAcrossWorlds = false;
+
   /** @copydoc ACesium3DTileset::CameraManager */
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   TSoftObjectPtr<ACesiumCameraManager> GetCameraManager() const;
@@ -336,6 +463,77 @@ public:
       Category = "Cesium|Level of Detail")
   EApplyDpiScaling ApplyDpiScaling = EApplyDpiScaling::UseProjectDefault;
 
+  /**
+   * How many times larger the screen-space error of the tiles in the views
+   * of Scene Capture 2D actors may be, since their render targets are often
+   * much smaller than the main view, such as for a minimap.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (ClampMin = 1.0))
+  double SceneCaptureScreenSpaceErrorMultiplier = 1.0;
+
+  /**
+   * Whether the views of Scene Capture 2D actors only show tiles that other
+   * views have already loaded, so that a minimap or another secondary render
+   * target doesn't load any tiles of its own.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail")
+  bool SceneCapturesUseLoadedTilesOnly = false;
+
+  /**
+   * Whether the views of the two eyes of a stereo device, such as a VR
+   * headset, select tiles as a single view. The single view is as detailed
+   * as the more detailed eye and contains both eyes' frustums, so selection
+   * runs once instead of twice, and the eyes never disagree about which
+   * tiles to show.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail")
+  bool MergeStereoViews = false;
+
+  /**
+   * The size on screen, in pixels, below which the primitives of tiles are
+   * culled, or zero to draw them at any distance.
+   *
+   * Once a tile is selected, each of its primitives is drawn wherever the tile
+   * is, including the tiny primitives of a large tile at the far edge of the
+   * view. With this set, each primitive gets a draw distance beyond which it
+   * would be smaller than this on screen, so that the renderer culls it
+   * without waiting for the tile to be refined or unloaded.
+   *
+   * The draw distance comes from the size of the primitive and from the
+   * viewports and fields of view of the tileset's cameras when its tile
+   * loads, so a change to this only applies to the tiles that load afterwards.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (ClampMin = 0.0))
+  float MinimumPrimitiveScreenSize = 0.0f;
+
+  /**
+   * The distance, in meters, beyond which the tiles of this tileset are
+   * neither loaded nor shown, so that the World Partition HLODs built from
+   * the tileset by Cesium HLOD Sources show the far field instead. This
+   * should be about the loading range of the runtime grid of the HLODs. Zero
+   * means that tiles are shown at any distance.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Level of Detail",
+      meta = (ClampMin = 0.0))
+  double HLODDistance = 0.0;
+
   /**
    * Whether to preload ancestor tiles.
    *
@@ -396,6 +594,74 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
   int64 MaximumCachedBytes = 256 * 1024 * 1024;
 
+  /**
+   * Whether the Unreal resources of the loaded tiles count against Maximum
+   * Cached Bytes, in addition to their glTF data. These are the meshes,
+   * collision meshes, materials, and metadata textures that are created for
+   * the tiles, as reported by GetMemoryUsage. When this is false, only the
+   * tiles' glTF data and images are counted, so the total memory taken by the
+   * tileset can be well above Maximum Cached Bytes.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool IncludeUnrealResourcesInCachedBytes = true;
+
+  /**
+   * The relative share of this tileset in the tile loads and cache budget that
+   * are shared by all tilesets, when Shared Maximum Simultaneous Tile Loads or
+   * Shared Maximum Cached MB is set in the Cesium project settings. A tileset
+   * with twice the priority of another is given twice as many loads and
+   * cached bytes when both need the same. This has no effect otherwise.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0.0))
+  float LoadPriority = 1.0f;
+
+  /**
+   * Whether to also load the tiles that will be needed where the cameras are
+   * predicted to be after Prefetch Time, so that fast, predictable motion,
+   * like that of a flight simulator, doesn't leave holes at the leading edge
+   * of the view.
+   *
+   * The predicted location follows the path of a flight in progress by a
+   * Cesium Fly To Component on the view target of a player, and otherwise
+   * extrapolates the Velocity of the camera, or how far it moved since the
+   * previous frame. The tiles for the predicted views are only loaded to a
+   * screen-space error that is Prefetch Screen Space Error Multiplier times
+   * larger, so that they don't take too many loads from the current views.
+   * Those tiles are selected like any other, but they are mostly outside of
+   * the current views, so Unreal doesn't draw them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool PrefetchAlongCameraMotion = false;
+
+  /**
+   * How far ahead, in seconds, to predict the locations of the cameras when
+   * Prefetch Along Camera Motion is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (EditCondition = "PrefetchAlongCameraMotion",
+           ClampMin = 0.0,
+           Units = "Seconds"))
+  float PrefetchTime = 1.0f;
+
+  /**
+   * How many times larger the screen-space error of the tiles loaded for the
+   * predicted views may be, when Prefetch Along Camera Motion is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (EditCondition = "PrefetchAlongCameraMotion", ClampMin = 1.0))
+  float PrefetchScreenSpaceErrorMultiplier = 2.0f;
+
   /**
    * The number of loading descendents a tile should allow before deciding to
    * render itself instead of waiting.
@@ -414,6 +680,26 @@ public:
       meta = (ClampMin = 0))
   int32 LoadingDescendantLimit = 20;
 
+  /**
+   * Which of the data of each tile's glTF is kept in CPU memory once the
+   * tile's meshes and textures have been created, for tilesets whose glTF
+   * buffers take a large share of the memory. The images of the glTFs are
+   * always released once their textures are created.
+   *
+   * The buffers of glTFs with features or metadata, or that are used to drape
+   * raster overlays, are always kept, because they are read from whenever the
+   * features or metadata are queried, or the tile is upsampled for the
+   * overlays. Keep Picking Data is used instead of Keep Nothing when Create
+   * Physics Meshes On Demand is set.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTileBufferResidency,
+      BlueprintSetter = SetTileBufferResidency,
+      Category = "Cesium|Tile Loading")
+  ECesiumTileBufferResidency TileBufferResidency =
+      ECesiumTileBufferResidency::KeepAll;
+
   /**
    * Whether to cull tiles that are outside the frustum.
    *
@@ -451,6 +737,26 @@ public:
       Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
   bool EnableFogCulling = true;
 
+  /**
+   * Whether to cull tiles that are hidden behind the horizon of the ellipsoid
+   * of the georeference.
+   *
+   * At low altitudes, many tiles on the far side of the globe are inside the
+   * frustum but can't be seen. When this is enabled, they are not loaded or
+   * rendered. Tiles whose bounding volumes reach above the horizon, such as
+   * tall mountains or buildings, are kept. This works for any ellipsoid, and
+   * has no effect when the camera is inside the ellipsoid, as it usually is
+   * for tilesets that aren't placed on a globe.
+   *
+   * Note that this will always be disabled if UseLodTransitions is set to true.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Culling",
+      Meta = (EditCondition = "!UseLodTransitions", EditConditionHides))
+  bool EnableHorizonCulling = false;
+
   /**
    * Whether a specified screen-space error should be enforced for tiles that
    * are outside the frustum or hidden in fog.
@@ -513,12 +819,12 @@ public:
    * Culling Feature" is enabled in the Plugins -> Cesium section of the Project
    * Settings.
    *
-   * When enabled, this feature will use Unreal's occlusion system to determine
-   * if tiles are actually visible on the screen. For tiles found to be
-   * occluded, the tile will not refine to show descendants, but it will still
-   * be rendered to avoid holes. This results in less tile loads and less GPU
-   * resource usage for dense, high-occlusion scenes like ground-level views in
-   * cities.
+   * When enabled, the bounding volumes of the tiles are tested on the GPU
+   * against the depth of the previous frame to determine if tiles are actually
+   * visible on the screen. For tiles found to be occluded, the tile will not
+   * refine to show descendants, but it will still be rendered to avoid holes.
+   * This results in less tile loads and less GPU resource usage for dense,
+   * high-occlusion scenes like ground-level views in cities.
    *
    * This will not work for tilesets with poorly fit bounding volumes and cause
    * more draw calls with very few extra culled tiles. When there is minimal
@@ -534,23 +840,12 @@ public:
       meta = (EditCondition = "CanEnableOcclusionCulling"))
   bool EnableOcclusionCulling = true;
 
-  /**
-   * The number of CesiumBoundingVolumeComponents to use for querying the
-   * occlusion state of traversed tiles.
-   *
-   * Only applicable when EnableOcclusionCulling is enabled.
-   */
   UPROPERTY(
-      EditAnywhere,
-      BlueprintGetter = GetOcclusionPoolSize,
-      BlueprintSetter = SetOcclusionPoolSize,
-      Category = "Cesium|Tile Occlusion",
       meta =
-          (EditCondition =
-               "EnableOcclusionCulling && CanEnableOcclusionCulling",
-           ClampMin = "0",
-           ClampMax = "1000"))
-  int32 OcclusionPoolSize = 500;
+          (DeprecatedProperty,
+           DeprecationMessage =
+               "The occlusion of all tiles is now tested together on the GPU, so there is no pool size."))
+  int32 OcclusionPoolSize_DEPRECATED = 500;
 
   /**
    * Whether to wait for valid occlusion results before refining tiles.
@@ -592,12 +887,50 @@ public:
   UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
   bool UpdateInEditor = true;
 
+  /**
+   * If true, the level-of-detail and culling update of this tileset in the
+   * editor is skipped while the editor is idle: the cameras, the
+   * georeference, and this tileset's transform and properties are the same
+   * as in its last update, and it has no tiles left to load or fade. Updates
+   * resume in the first frame in which any of these change. This has no
+   * effect while playing.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      Category = "Cesium|Debug",
+      meta = (EditCondition = "UpdateInEditor"))
+  bool SkipIdleEditorUpdates = true;
+
   /**
    * If true, stats about tile selection are printed to the Output Log.
    */
   UPROPERTY(EditAnywhere, Category = "Cesium|Debug")
   bool LogSelectionStats = false;
 
+  /**
+   * Colors each tile by the chosen cost, from blue for the cheapest tiles to
+   * red for the most expensive, so that problem content can be found in the
+   * viewport. The color replaces the base color factor of the tile's
+   * material, so it is multiplied with the tile's base color texture, if
+   * any.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Debug")
+  ECesiumTileCostMetric DebugTileCostMetric = ECesiumTileCostMetric::None;
+
+  /**
+   * The cost at which tiles are shown in red by Debug Tile Cost Metric. If
+   * zero, it is the highest cost of the tiles that are currently loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Debug",
+      meta =
+          (EditCondition =
+               "DebugTileCostMetric != ECesiumTileCostMetric::None",
+           ClampMin = 0.0))
+  double DebugTileCostMaximum = 0.0;
+
   /**
    * Define the collision profile for all the 3D tiles created inside this
    * actor.
@@ -641,6 +974,32 @@ public:
       meta = (EditCondition = "UseLodTransitions", EditConditionHides))
   float LodTransitionLength = 0.5f;
 
+  /**
+   * If zero or greater, the LOD transition fade of each tile primitive is
+   * written to its Custom Primitive Data when the fade starts, instead of to
+   * material parameters every frame. The game time at which the fade
+   * started, the Lod Transition Length, and the fading type (0 when fading
+   * in, 1 when fading out) occupy three consecutive floats starting at this
+   * index. The material computes the fade percentage from them and its Time,
+   * for example with the CesiumLodTransitionFadePercentage function of
+   * "/Plugin/CesiumForUnreal/Private/CesiumDitherFade.ush", and passes it to
+   * the DitherFade material layer.
+   *
+   * This makes fades cost nothing on the CPU while they progress, but it
+   * requires a material that reads these values from Custom Primitive Data.
+   * The materials included with Cesium for Unreal do not.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition = "UseLodTransitions",
+           EditConditionHides,
+           ClampMin = -1,
+           ClampMax = 33))
+  int32 LodTransitionCustomPrimitiveDataIndex = -1;
+
 private:
   UPROPERTY(BlueprintGetter = GetLoadProgress, Category = "Cesium")
   float LoadProgress = 0.0f;
@@ -669,6 +1028,21 @@ private:
       meta = (EditCondition = "TilesetSource==ETilesetSource::FromUrl"))
   FString Url = "";
 
+  /**
+   * The path of a local 3D Tiles package (.3tz) file containing this tileset.
+   *
+   * The package is opened once and its index is kept in memory, so tiles are
+   * read directly from it without extracting the archive.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetLocalPackageFilename,
+      BlueprintSetter = SetLocalPackageFilename,
+      Category = "Cesium",
+      meta =
+          (EditCondition = "TilesetSource==ETilesetSource::FromLocalPackage"))
+  FString LocalPackageFilename = "";
+
   /**
    * The ID of the Cesium ion asset to use.
    *
@@ -728,6 +1102,10 @@ private:
    * meshes will not be created.
    *
    * Physics meshes cannot be generated for primitives containing points.
+   *
+   * Changing this option adds or removes the physics meshes of the tiles that
+   * are already loaded, without reloading them, unless Tile Buffer Residency
+   * is Keep Nothing.
    */
   UPROPERTY(
       EditAnywhere,
@@ -736,6 +1114,123 @@ private:
       Category = "Cesium|Physics")
   bool CreatePhysicsMeshes = true;
 
+  /**
+   * Whether to create physics meshes only for the tiles near the actors in
+   * Physics Mesh Focus Actors, instead of for every tile that is loaded.
+   *
+   * The physics meshes are built in the background when a tile comes within
+   * Physics Mesh Radius of one of the actors, and are removed again when it is
+   * no longer near any of them. Tiles far away from all of the actors cannot be
+   * collided with, nor hit by traces. Loading tiles is faster, and uses less
+   * memory, because most of them never need a physics mesh.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCreatePhysicsMeshesOnDemand,
+      BlueprintSetter = SetCreatePhysicsMeshesOnDemand,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  bool CreatePhysicsMeshesOnDemand = false;
+
+  /**
+   * The largest distance, in meters, by which the physics meshes of tiles may
+   * deviate from their visual meshes. When this is greater than zero, the
+   * triangles of the physics meshes are reduced until that distance is
+   * reached, which makes the physics meshes faster to build, use less memory,
+   * and faster to collide with. The borders of each tile are kept, so that the
+   * physics meshes of neighboring tiles still meet.
+   *
+   * The triangles of a simplified physics mesh no longer correspond to those
+   * of the visual mesh, so features and metadata can't be picked from the face
+   * index of a hit against it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshSimplificationError,
+      BlueprintSetter = SetPhysicsMeshSimplificationError,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes", ClampMin = 0.0))
+  double PhysicsMeshSimplificationError = 0.0;
+
+  /**
+   * The distance, in centimeters, from the bounds of a Physics Mesh Focus
+   * Actor within which tiles get physics meshes, when Create Physics Meshes On
+   * Demand is set.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshRadius,
+      BlueprintSetter = SetPhysicsMeshRadius,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CreatePhysicsMeshesOnDemand",
+           ClampMin = 0.0))
+  double PhysicsMeshRadius = 100000.0;
+
+  /**
+   * The actors around which tiles get physics meshes, when Create Physics
+   * Meshes On Demand is set. These are usually the physics bodies that collide
+   * with the tileset, or volumes enclosing the traces made against it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshFocusActors,
+      BlueprintSetter = SetPhysicsMeshFocusActors,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CreatePhysicsMeshesOnDemand"))
+  TArray<TObjectPtr<AActor>> PhysicsMeshFocusActors;
+
+  /**
+   * The maximum number of tiles that have their collision enabled each frame,
+   * or zero for no limit.
+   *
+   * Enabling the collision of a tile creates the physics state of its
+   * primitives and adds their bodies to the physics scene, all in the frame in
+   * which the tile is shown. Limiting the number of tiles spreads that work
+   * out when many tiles are shown at once. The tiles nearest to the Physics
+   * Mesh Focus Actors, or to the players if there are none, go first; the
+   * others are shown without collision until their turn comes.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta = (ClampMin = 0))
+  int32 MaximumCollisionUpdatesPerFrame = 0;
+
+  /**
+   * Whether to build a lightweight trace mesh for each tile that is loaded,
+   * so that lines can be traced against the tileset with LineTraceTiles and
+   * heights sampled with SampleHeightMostDetailed.
+   *
+   * Trace meshes are built in the background while tiles load, and don't need
+   * physics meshes, so traces work even when Create Physics Meshes is
+   * disabled. Only the tiles that are currently shown are traced against.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCreateTraceMeshes,
+      BlueprintSetter = SetCreateTraceMeshes,
+      Category = "Cesium|Queries")
+  bool CreateTraceMeshes = false;
+
+  /**
+   * Whether to build an index from the feature IDs of each primitive that is
+   * loaded to its faces and their bounds, so that the faces and bounds of a
+   * feature, such as a building to zoom to, are found without searching all
+   * of the faces with GetFeatureIDFromFace.
+   *
+   * The indices are built in the background while tiles load. See
+   * GetFeatureBounds and GetFacesOfFeature.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCreateFeatureIndices,
+      BlueprintSetter = SetCreateFeatureIndices,
+      Category = "Cesium|Queries")
+  bool CreateFeatureIndices = false;
+
   /**
    * Whether to generate navigation collisions for this tileset.
    *
@@ -751,6 +1246,44 @@ private:
       Category = "Cesium|Navigation")
   bool CreateNavCollision = false;
 
+  /**
+   * Whether only the tiles within the radius of a navigation invoker affect
+   * navigation, when Create Nav Collision is set.
+   *
+   * This is useful with "Runtime Generation" set to "Dynamic" and "Generate
+   * Navigation Only Around Navigation Invokers" set in the navigation system
+   * settings, because otherwise every tile that is loaded, however far it is
+   * from any invoker, makes the navigation data around it be rebuilt.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetRestrictNavigationToInvokers,
+      BlueprintSetter = SetRestrictNavigationToInvokers,
+      Category = "Cesium|Navigation",
+      meta = (EditCondition = "CreateNavCollision"))
+  bool RestrictNavigationToInvokers = false;
+
+  /**
+   * The maximum number of tile meshes that start or stop affecting navigation
+   * in each frame, when Create Nav Collision is set, or zero for no limit.
+   *
+   * Each change marks the area of the mesh as needing its navigation data to
+   * be rebuilt. Limiting the number of changes spreads the rebuilds out when
+   * many tiles are loaded at once, so that they don't take up all of the
+   * worker threads. The meshes nearest to navigation invokers are updated
+   * first.
+   *
+   * Navigation data is built from the physics meshes of tiles, so a Physics
+   * Mesh Simplification Error also makes the navigation data faster to build.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetMaximumNavigationUpdatesPerFrame,
+      BlueprintSetter = SetMaximumNavigationUpdatesPerFrame,
+      Category = "Cesium|Navigation",
+      meta = (EditCondition = "CreateNavCollision", ClampMin = 0))
+  int32 MaximumNavigationUpdatesPerFrame = 0;
+
   /**
    * Whether to always generate a correct tangent space basis for tiles that
    * don't have them.
@@ -778,9 +1311,11 @@ private:
    *
    * According to the Gltf spec: "When normals are not specified, client
    * implementations should calculate flat normals." However, calculating flat
-   * normals requires duplicating vertices. This option allows the gltfs to be
-   * sent with explicit smooth normals when the original gltf was missing
-   * normals.
+   * normals requires duplicating vertices, so a mesh without normals, as is
+   * common in photogrammetry, takes about three times as many vertices as it
+   * has in the glTF. Smooth normals keep the vertices shared between
+   * triangles, and only split a vertex at edges sharper than the Smooth
+   * Normals Crease Angle, so those edges still look faceted.
    */
   UPROPERTY(
       EditAnywhere,
@@ -789,6 +1324,22 @@ private:
       Category = "Cesium|Rendering")
   bool GenerateSmoothNormals = false;
 
+  /**
+   * The angle in degrees between two triangles above which the edge they share
+   * is faceted when smooth normals are generated. At 0 degrees, every edge that
+   * isn't flat is faceted, and at 180 degrees none is.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetSmoothNormalsCreaseAngle,
+      BlueprintSetter = SetSmoothNormalsCreaseAngle,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition = "GenerateSmoothNormals",
+           ClampMin = 0.0,
+           ClampMax = 180.0))
+  float SmoothNormalsCreaseAngle = 45.0f;
+
   /**
    * Whether to request and render the water mask.
    *
@@ -822,12 +1373,312 @@ private:
   bool IgnoreKhrMaterialsUnlit = false;
 
   /**
-   * A custom Material to use to render opaque elements in this tileset, in
-   * order to implement custom visual effects.
+   * Whether to block-compress the color textures of this tileset's tiles
+   * when they are loaded, if they are not already compressed. This reduces
+   * the GPU memory taken by a texture to between a quarter and an eighth, at
+   * a small cost in quality and load time, which can let many more tiles fit
+   * on devices with little memory.
    *
-   * The custom material should generally be created by copying the Material
+   * The textures are compressed to BC1 or BC3 where the platform supports
+   * them, or to ETC2 otherwise, such as on Android. Textures whose width or
+   * height is not a multiple of four are not compressed.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCompressTextures,
+      BlueprintSetter = SetCompressTextures,
+      Category = "Cesium|Rendering")
+  bool CompressTextures = false;
+
+  /**
+   * Whether to store the texture coordinates of this tileset's meshes as
+   * 16-bit floats rather than 32-bit floats. This takes 4 fewer bytes per
+   * vertex for each set of texture coordinates, including the ones used by
+   * raster overlays, which adds up on large terrain and photogrammetry
+   * tilesets.
+   *
+   * A 16-bit float has about three significant digits, which is plenty for
+   * texture coordinates within a tile, but not for feature IDs or metadata. So
+   * primitives whose features or metadata are encoded for the material always
+   * keep 32-bit texture coordinates. Normals and tangents are always stored
+   * packed into 8 bits per component.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseCompactVertexFormat,
+      BlueprintSetter = SetUseCompactVertexFormat,
+      Category = "Cesium|Rendering")
+  bool UseCompactVertexFormat = false;
+
+  /**
+   * Whether to pack the feature IDs of feature ID attributes and implicit
+   * feature IDs more tightly into the texture coordinates of this tileset's
+   * meshes.
+   *
+   * These feature IDs are stored as floats in the U of a texture coordinate
+   * channel of their own, which wastes the V of the channel and loses
+   * precision above 16,777,216 features. When this is enabled, a second set of
+   * feature IDs takes the V of the channel, which saves a channel and 8 bytes
+   * per vertex, and feature IDs that a float can't hold exactly are split
+   * into their low and high 16 bits, in the U and V of a channel.
+   *
+   * Where the feature IDs are is set on the material as a `_PACKING`
+   * parameter next to the texture coordinate index of each feature ID set: 0
+   * for the U, 1 for the V, and 2 for split feature IDs. Materials then need
+   * to decode them with CesiumDecodeFeatureId in
+   * /Plugin/CesiumForUnreal/Private/CesiumFeatureIds.ush.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPackFeatureIds,
+      BlueprintSetter = SetPackFeatureIds,
+      Category = "Cesium|Rendering")
+  bool PackFeatureIds = false;
+
+  /**
+   * Whether to store the positions of point cloud points as 16-bit integers
+   * relative to the bounding box of their tile, rather than as 32-bit floats.
+   * This halves the GPU memory taken by the positions, which is often what
+   * limits how much of a large LiDAR scan can be shown. The precision is still
+   * a 65535th of the size of the tile.
+   *
+   * Quantized points are always drawn as camera-facing quads, even without
+   * point attenuation, so this has no effect on platforms that don't support
+   * point attenuation.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetQuantizePointClouds,
+      BlueprintSetter = SetQuantizePointClouds,
+      Category = "Cesium|Rendering")
+  bool QuantizePointClouds = false;
+
+  /**
+   * Whether to generate cheaper tangents for meshes that only need tangents
+   * for the water effect of Enable Water Mask.
+   *
+   * Tangents are normally generated with MikkTSpace, which needs three
+   * vertices for every triangle and is one of the most expensive steps of
+   * loading a tile. The cheaper tangents are derived from the texture
+   * coordinates around each vertex, which is accurate enough for the animated
+   * water normals, and keep the vertices shared between triangles. Meshes with
+   * a normal map, or when Always Include Tangents is set, still use
+   * MikkTSpace.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseFastTangentsForWater,
+      BlueprintSetter = SetUseFastTangentsForWater,
+      Category = "Cesium|Rendering")
+  bool UseFastTangentsForWater = false;
+
+  /**
+   * Whether to draw quantized-mesh terrain, such as Cesium World Terrain,
+   * from heightmaps rather than from the triangles of each tile.
+   *
+   * The triangles of each terrain tile are resampled into a heightmap as the
+   * tile loads, which is drawn by displacing a grid that all terrain tiles
+   * share in the vertex shader. The tiles then need no vertex buffers, no
+   * normals, and no tangents of their own, which takes much less memory and
+   * loading time. Collision is still built from the triangles of the tile.
+   *
+   * The heightmaps require manual vertex fetch, and terrain is drawn from its
+   * triangles where it isn't supported. Tiles that aren't quantized-mesh
+   * terrain are not affected.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseTerrainHeightmaps,
+      BlueprintSetter = SetUseTerrainHeightmaps,
+      Category = "Cesium|Rendering")
+  bool UseTerrainHeightmaps = false;
+
+  /**
+   * The number of samples along each side of the heightmap of a terrain tile,
+   * when Use Terrain Heightmaps is enabled. Quantized-mesh tiles are usually
+   * 65 samples across at the resolution of their source data.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTerrainHeightmapResolution,
+      BlueprintSetter = SetTerrainHeightmapResolution,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition = "UseTerrainHeightmaps",
+           ClampMin = 2,
+           ClampMax = 1025))
+  int32 TerrainHeightmapResolution = 65;
+
+  /**
+   * Whether the texture coordinates of raster overlays are computed by the
+   * material from the position of each vertex, rather than being stored in
+   * the vertices of each tile.
+   *
+   * By default, the texture coordinates of each overlay projection are added
+   * to the vertices of a tile as an extra UV channel. When this is enabled,
+   * the channel isn't created, which saves eight bytes per vertex for each
+   * projection, and the Texture Coordinate Index of each overlay is set to
+   * -1. The material then needs to compute the texture coordinates with
+   * CesiumOverlayTextureCoordinates in
+   * /Plugin/CesiumForUnreal/Private/CesiumRasterOverlayProjection.ush, from
+   * the Local Position and the Projection Rectangle, Projection Ellipsoid, and
+   * Local To Ecef parameters that are set on it. The computed coordinates are
+   * accurate to about a meter, so the overlays of very detailed imagery may be
+   * better off with the vertex texture coordinates.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetComputeRasterOverlayTextureCoordinates,
+      BlueprintSetter = SetComputeRasterOverlayTextureCoordinates,
+      Category = "Cesium|Rendering")
+  bool ComputeRasterOverlayTextureCoordinates = false;
+
+  /**
+   * Whether to reorder the triangles and vertices of each mesh as it is
+   * loaded, so that the GPU can reuse more of its transformed vertices and
+   * draws fewer hidden pixels.
+   *
+   * The triangles are reordered for the post-transform vertex cache and then
+   * to reduce overdraw, and the vertices are then reordered in the order that
+   * the triangles use them. This is done in a worker thread, and makes
+   * loading a tile a little slower, in return for less vertex shader time on
+   * dense meshes such as photogrammetry and city models. The time it takes is
+   * reported by the MeshOptimization stage of the Cesium Tileset Statistics.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetOptimizeMeshes,
+      BlueprintSetter = SetOptimizeMeshes,
+      Category = "Cesium|Rendering")
+  bool OptimizeMeshes = false;
+
+  /**
+   * Whether to build Nanite resources for the meshes of loaded tiles, so that
+   * dense tiles are rendered with Nanite's cluster culling and level of
+   * detail instead of as regular static meshes.
+   *
+   * Nanite can only be built in the editor, including Play In Editor, and
+   * this is ignored in packaged games and on platforms that don't render
+   * Nanite. It is built in a worker thread as each tile is loaded, which
+   * makes loading much slower, so it's best suited to static tilesets that
+   * are viewed up close. Meshes with translucent materials, points, and
+   * lines are rendered without Nanite.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetBuildNaniteMeshes,
+      BlueprintSetter = SetBuildNaniteMeshes,
+      Category = "Cesium|Rendering")
+  bool BuildNaniteMeshes = false;
+
+  /**
+   * Whether to build a second, simplified level of detail for the meshes of
+   * each tile, with about a quarter of the triangles.
+   *
+   * The simplified level of detail is used when the tile takes a small part
+   * of the screen, which is cheaper to render for tiles that are kept loaded
+   * while they are far away, such as with Forbid Holes. It is built in a
+   * worker thread as each tile is loaded, and takes more memory. The edges of
+   * each tile are not simplified, so that there are no cracks between tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetGenerateSimplifiedLod,
+      BlueprintSetter = SetGenerateSimplifiedLod,
+      Category = "Cesium|Rendering")
+  bool GenerateSimplifiedLod = false;
+
+  /**
+   * The screen size below which the simplified level of detail of a tile's
+   * meshes is used, when Generate Simplified Lod is set. This is the fraction
+   * of the height of the screen that the bounding sphere of the mesh takes.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetSimplifiedLodScreenSize,
+      BlueprintSetter = SetSimplifiedLodScreenSize,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition = "GenerateSimplifiedLod",
+           ClampMin = 0.0,
+           ClampMax = 1.0))
+  float SimplifiedLodScreenSize = 0.25f;
+
+  /**
+   * Whether to split the meshes of large tiles into clusters of nearby
+   * triangles that are culled separately against the view frustum.
+   *
+   * Normally a tile mesh is drawn as a whole when any part of it is in view.
+   * With this set, meshes with many triangles are split into clusters as they
+   * are loaded, and only the clusters in view are drawn, which saves vertex
+   * shading for large tiles that are only partly on screen. These meshes are
+   * then drawn through Unreal's dynamic mesh path, which takes more game and
+   * render thread time than cached static meshes, so this is best suited to
+   * tilesets with large, dense tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseClusterCulling,
+      BlueprintSetter = SetUseClusterCulling,
+      Category = "Cesium|Rendering")
+  bool UseClusterCulling = false;
+
+  /**
+   * Whether to draw the EXT_mesh_gpu_instancing instances of all tiles that
+   * have the same mesh and material with a single hierarchical instanced
+   * static mesh component.
+   *
+   * Normally each instanced primitive of each tile is drawn with its own
+   * component, so a dataset of trees or poles spread over thousands of tiles
+   * draws the same mesh with thousands of draw calls. With this set, the
+   * instances of identical meshes with identical materials are merged across
+   * tiles, and shown, hidden, and removed along with their tiles.
+   *
+   * Only primitives without feature IDs or property textures are merged, and
+   * only while the tileset has no raster overlays and no active polygon
+   * clipping, which all give each tile a different material. The merged
+   * instances don't fade with LOD transitions, and can't be traced to the
+   * features of their tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetMergeInstancedMeshes,
+      BlueprintSetter = SetMergeInstancedMeshes,
+      Category = "Cesium|Rendering")
+  bool MergeInstancedMeshes = false;
+
+  /**
+   * Whether to merge the small primitives of each tile that have the same
+   * material and vertex attributes into larger primitives, as the tile is
+   * loaded.
+   *
+   * Some tilesets, especially converted CAD and BIM models, have tiles with
+   * hundreds of tiny primitives that each become a component with its own
+   * draw call. With this set, primitives of up to 8192 vertices are merged, in
+   * a worker thread, into primitives of up to 262144 vertices, which keep the
+   * feature IDs of their vertices for picking and styling.
+   *
+   * Primitives with implicit feature IDs or feature ID textures, morph
+   * targets, or instances aren't merged.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetMergeSmallPrimitives,
+      BlueprintSetter = SetMergeSmallPrimitives,
+      Category = "Cesium|Rendering")
+  bool MergeSmallPrimitives = false;
+
+  /**
+   * A custom Material to use to render opaque elements in this tileset, in
+   * order to implement custom visual effects.
+   *
+   * The custom material should generally be created by copying the Material
    * Instance "MI_CesiumThreeOverlaysAndClipping" and customizing the copy as
    * desired.
+   *
+   * Changing the material gives the tiles that are already loaded new
+   * material instances with the same parameters, without reloading them, as
+   * long as the new material has the same material layers as the old one.
    */
   UPROPERTY(
       EditAnywhere,
@@ -877,6 +1728,166 @@ private:
       meta = (ShowOnlyInnerProperties))
   FCustomDepthParameters CustomDepthParameters;
 
+  /**
+   * The Runtime Virtual Textures that this tileset's tiles are rendered into,
+   * together with their raster overlays. Decals, foliage, and other materials
+   * can then sample the tileset's appearance from a single cached virtual
+   * texture instead of evaluating every overlay themselves.
+   *
+   * Only the tileset's Material writes to the virtual textures, so it must
+   * contain a Runtime Virtual Texture Output node. A Runtime Virtual Texture
+   * Volume that covers the tiles, and that uses the same virtual texture, is
+   * also needed in the level.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetRuntimeVirtualTextures,
+      BlueprintSetter = SetRuntimeVirtualTextures,
+      Category = "Cesium|Rendering")
+  TArray<TObjectPtr<URuntimeVirtualTexture>> RuntimeVirtualTextures;
+
+  /**
+   * Whether this tileset's tiles are still rendered in the main pass when
+   * they're rendered into Runtime Virtual Textures. "From Virtual Texture"
+   * renders them only when no virtual texture is available to sample from
+   * instead.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      Category = "Cesium|Rendering",
+      meta = (DisplayName = "Draw in Main Pass"))
+  ERuntimeVirtualTextureMainPassType VirtualTextureRenderPassType =
+      ERuntimeVirtualTextureMainPassType::Always;
+
+  /**
+   * The distance, in meters, beyond which the tiles of this tileset stop
+   * casting shadows. Distant tiles are often detailed enough for the views
+   * but add many triangles to the shadow depth passes, where their shadows
+   * are too small to matter. Zero means that all tiles cast shadows.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (ClampMin = 0.0))
+  double ShadowCastingDistance = 0.0;
+
+  /**
+   * How changes to the tiles invalidate the shadow pages that Virtual Shadow
+   * Maps cache for them. Tiles are not animated unless their materials are,
+   * so "Rigid" keeps their pages cached until they are moved, such as by a
+   * change of the georeference origin, even when their materials use World
+   * Position Offset. "Static" never invalidates them, so it suits tilesets
+   * that are never moved.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Rendering")
+  EShadowCacheInvalidationBehavior ShadowCacheInvalidationBehavior =
+      EShadowCacheInvalidationBehavior::Auto;
+
+  /**
+   * The length, in seconds, of the windows in which the tiles that are
+   * shown, hidden, and faded are gathered and then changed together. Each
+   * tile that is shown or hidden invalidates the shadow pages it covers, so
+   * tiles streaming in every frame keep Virtual Shadow Maps from caching
+   * anything. Longer windows let the cached pages be reused in between, at
+   * the cost of showing newly-loaded tiles later. Zero changes the tiles
+   * every frame.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (ClampMin = 0.0, Units = "s"))
+  float TileUpdateWindow = 0.0f;
+
+  /**
+   * The distance, in meters, beyond which the tiles of this tileset are not
+   * ray traced, such as by Lumen's hardware ray tracing or by ray-traced
+   * reflections. Every tile that is ray traced needs a bottom-level
+   * acceleration structure (BLAS), which is built when the tile appears, so
+   * streaming in distant tiles leaves little time for the nearby ones. Zero
+   * means that all tiles are ray traced.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (ClampMin = 0.0))
+  double RayTracingDistance = 0.0;
+
+  /**
+   * Whether the tiles beyond the Ray Tracing Distance are stood in for in
+   * ray tracing by a coarser, already-loaded ancestor, so that distant
+   * reflections and global illumination don't disappear. The ancestor is not
+   * drawn in the main pass, and it only needs one BLAS for all of the tiles
+   * it stands in for.
+   *
+   * Only ancestors that are completely beyond the Ray Tracing Distance are
+   * used, so that no part of the tileset is ray traced twice.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "RayTracingDistance > 0"))
+  bool UseAncestorRayTracingProxies = false;
+
+  /**
+   * The most levels above a tile that its ray tracing proxy may be.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition =
+               "RayTracingDistance > 0 && UseAncestorRayTracingProxies",
+           ClampMin = 1))
+  int32 RayTracingProxyAncestorLevels = 2;
+
+  /**
+   * The maximum number of tiles that are added to ray tracing each frame, or
+   * zero for no limit. Tiles that are shown are at first only rasterized,
+   * until their turn comes to have their BLAS built; the nearest tiles go
+   * first. This keeps fast motion, which streams in many tiles at once, from
+   * stalling the frames in which their BLASes are built.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (ClampMin = 0))
+  int32 MaximumRayTracingUpdatesPerFrame = 0;
+
+  /**
+   * Whether the tiles beyond the Shadow Casting Distance have their shadows
+   * cast by a coarser, already-loaded ancestor instead of casting none. The
+   * ancestor stays hidden, and is only drawn into the shadow depth passes.
+   *
+   * Only ancestors that are completely beyond the Shadow Casting Distance
+   * are used, so that no shadow is cast twice.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta = (EditCondition = "ShadowCastingDistance > 0"))
+  bool UseAncestorShadowProxies = false;
+
+  /**
+   * The most levels above a tile that its shadow proxy may be. Higher levels
+   * have fewer triangles, but their shadows match the tiles less closely.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition =
+               "ShadowCastingDistance > 0 && UseAncestorShadowProxies",
+           ClampMin = 1))
+  int32 ShadowProxyAncestorLevels = 2;
+
   /**
    * If this tileset contains points, their appearance can be configured with
    * these point cloud shading parameters.
@@ -890,6 +1901,19 @@ private:
       Category = "Cesium|Rendering")
   FCesiumPointCloudShading PointCloudShading;
 
+  /**
+   * If this tileset contains voxels, their appearance can be configured with
+   * these voxel rendering parameters.
+   *
+   * These settings are not supported on mobile platforms.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetVoxelRendering,
+      BlueprintSetter = SetVoxelRendering,
+      Category = "Cesium|Rendering")
+  FCesiumVoxelRendering VoxelRendering;
+
 protected:
   UPROPERTY()
   FString PlatformName;
@@ -903,6 +1927,64 @@ public:
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   float GetLoadProgress() const { return LoadProgress; }
 
+  /**
+   * Gets statistics about the game-thread finalization of newly-loaded tiles
+   * during the last frame. The statistics cover all tilesets in this
+   * tileset's world, because they share a single finalization budget.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Tile Loading")
+  FCesiumTileFinalizationStats GetTileFinalizationStats() const;
+
+  /**
+   * Gets counters describing how this tileset recycles the components it
+   * creates for tile primitives.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Tile Loading")
+  FCesiumPrimitiveComponentPoolStats GetPrimitiveComponentPoolStats() const;
+
+  /**
+   * Gets the pool of recycled primitive components used by this tileset.
+   * This is used internally when creating and destroying tile components.
+   */
+  CesiumPrimitiveComponentPool& GetPrimitiveComponentPool();
+
+  /**
+   * Gets the cache of material instance templates used by this tileset.
+   * This is used internally when creating the materials of tile primitives.
+   */
+  CesiumMaterialInstanceCache& GetMaterialInstanceCache();
+
+  /**
+   * Gets the batches that the instances of identical instanced meshes of all
+   * tiles are merged into, when MergeInstancedMeshes is set. This is used
+   * internally when creating, showing, and destroying tile components.
+   */
+  CesiumInstanceBatches& GetInstanceBatches();
+
+  /**
+   * Computes the draw distance of a primitive of the given size, both in
+   * Unreal units, beyond which it is smaller than the Minimum Primitive Screen
+   * Size in all of the tileset's views. Returns zero when primitives aren't
+   * culled. This is used internally when creating tile components.
+   */
+  double ComputePrimitiveCullDistance(double PrimitiveSize) const;
+
+  /**
+   * Gets the memory taken by the tiles of this tileset that are currently
+   * loaded: textures, mesh vertex and index buffers, collision meshes, and
+   * materials.
+   * The textures of raster overlays are reported by each overlay's
+   * GetMemoryUsage instead.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Tile Loading")
+  FCesiumMemoryUsage GetMemoryUsage() const;
+
+  /**
+   * Gets the running totals of the memory taken by this tileset's tiles.
+   * This is used internally when creating and destroying tile components.
+   */
+  CesiumMemoryUsageTracker& GetMemoryUsageTracker();
+
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   bool GetUseLodTransitions() const { return UseLodTransitions; }
 
@@ -921,6 +2003,12 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium")
   void SetUrl(const FString& InUrl);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  FString GetLocalPackageFilename() const { return LocalPackageFilename; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetLocalPackageFilename(const FString& InFilename);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   int64 GetIonAssetID() const { return IonAssetID; }
 
@@ -951,10 +2039,22 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
   void SetEnableOcclusionCulling(bool bEnableOcclusionCulling);
 
-  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
-  int32 GetOcclusionPoolSize() const { return OcclusionPoolSize; }
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Tile Culling|Experimental",
+      meta =
+          (DeprecatedFunction,
+           DeprecationMessage =
+               "The occlusion of all tiles is now tested together on the GPU, so there is no pool size."))
+  int32 GetOcclusionPoolSize() const { return OcclusionPoolSize_DEPRECATED; }
 
-  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Culling|Experimental")
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Tile Culling|Experimental",
+      meta =
+          (DeprecatedFunction,
+           DeprecationMessage =
+               "The occlusion of all tiles is now tested together on the GPU, so there is no pool size."))
   void SetOcclusionPoolSize(int32 newOcclusionPoolSize);
 
   UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Culling|Experimental")
@@ -971,12 +2071,217 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
   void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCreatePhysicsMeshesOnDemand() const {
+    return CreatePhysicsMeshesOnDemand;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCreatePhysicsMeshesOnDemand(bool bCreatePhysicsMeshesOnDemand);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  double GetPhysicsMeshSimplificationError() const {
+    return PhysicsMeshSimplificationError;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void
+  SetPhysicsMeshSimplificationError(double InPhysicsMeshSimplificationError);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  double GetPhysicsMeshRadius() const { return PhysicsMeshRadius; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsMeshRadius(double InPhysicsMeshRadius);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  TArray<AActor*> GetPhysicsMeshFocusActors() const {
+    return PhysicsMeshFocusActors;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsMeshFocusActors(
+      const TArray<AActor*>& InPhysicsMeshFocusActors);
+
+  /**
+   * Adds an actor around which tiles get physics meshes, when Create Physics
+   * Meshes On Demand is set. Does nothing if the actor was already added.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  void AddPhysicsMeshFocusActor(AActor* Actor);
+
+  /**
+   * Removes an actor added with AddPhysicsMeshFocusActor. The physics meshes
+   * of the tiles that are no longer near any focus actor are removed in the
+   * next frame.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Physics")
+  void RemovePhysicsMeshFocusActor(AActor* Actor);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Queries")
+  bool GetCreateTraceMeshes() const { return CreateTraceMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Queries")
+  void SetCreateTraceMeshes(bool bCreateTraceMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Queries")
+  bool GetCreateFeatureIndices() const { return CreateFeatureIndices; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Queries")
+  void SetCreateFeatureIndices(bool bCreateFeatureIndices);
+
+  /**
+   * Traces a line against the tiles that are currently shown, using their
+   * trace meshes rather than the physics scene. Both sides of the triangles
+   * are hit. Requires Create Trace Meshes.
+   *
+   * @param Start The start of the line, in Unreal world coordinates.
+   * @param End The end of the line, in Unreal world coordinates.
+   * @param OutHit Receives the first hit. Its face index is the index of the
+   * triangle in the glTF primitive that was hit.
+   * @returns Whether a tile was hit.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Queries")
+  bool LineTraceTiles(
+      const FVector& Start,
+      const FVector& End,
+      FHitResult& OutHit) const;
+
+  /**
+   * Traces many lines against the tiles that are currently shown, like
+   * LineTraceTiles. The lines are traced in parallel.
+   *
+   * @param Starts The starts of the lines, in Unreal world coordinates.
+   * @param Ends The ends of the lines, which must be as many as the starts.
+   * @param OutHits Receives the first hit of each line. Lines that hit nothing
+   * have no blocking hit.
+   * @returns The number of lines that hit a tile.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Queries")
+  int32 LineTraceTilesBatch(
+      const TArray<FVector>& Starts,
+      const TArray<FVector>& Ends,
+      TArray<FHitResult>& OutHits) const;
+
+  /**
+   * Picks the tile that is shown at a position on the screen of a player, by
+   * tracing a line from the player's camera through the position with
+   * LineTraceTiles. Requires Create Trace Meshes, but not Create Physics
+   * Meshes, so tilesets that are only shown can still be picked.
+   *
+   * The hit may be passed to the functions that get feature IDs and metadata
+   * from hits, such as GetPropertyTableValuesFromHit.
+   *
+   * @param PlayerController The player whose screen the position is on.
+   * @param ScreenPosition The position on the screen, in pixels, such as the
+   * position of the mouse cursor.
+   * @param OutHit Receives the first hit.
+   * @param TraceDistance How far from the camera to trace, in Unreal units.
+   * @returns Whether a tile was hit.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Queries")
+  bool LineTraceTilesFromScreenPosition(
+      const APlayerController* PlayerController,
+      const FVector2D& ScreenPosition,
+      FHitResult& OutHit,
+      double TraceDistance = 1.0e10) const;
+
+  /**
+   * Samples the height of the most detailed tiles that are currently shown at
+   * a position, by tracing a vertical line against their trace meshes.
+   * Requires Create Trace Meshes.
+   *
+   * @param LongitudeLatitudeHeight The position to sample, as longitude and
+   * latitude in degrees. The height is ignored.
+   * @param OutLongitudeLatitudeHeight Receives the sampled position, with the
+   * height of the highest tile surface there, in meters above the ellipsoid.
+   * @returns Whether a tile was found at the position.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Queries")
+  bool SampleHeightMostDetailed(
+      const FVector& LongitudeLatitudeHeight,
+      FVector& OutLongitudeLatitudeHeight);
+
+  /**
+   * Samples the heights of many positions, like SampleHeightMostDetailed. The
+   * positions are sampled in parallel.
+   *
+   * @param LongitudeLatitudeHeights The positions to sample.
+   * @param OutLongitudeLatitudeHeights Receives the sampled positions. A
+   * position at which no tile was found is returned unchanged.
+   * @param OutSampleSuccess Receives whether a tile was found at each
+   * position.
+   * @returns The number of positions at which a tile was found.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Queries")
+  int32 SampleHeightMostDetailedBatch(
+      const TArray<FVector>& LongitudeLatitudeHeights,
+      TArray<FVector>& OutLongitudeLatitudeHeights,
+      TArray<bool>& OutSampleSuccess);
+
+  /**
+   * Samples the heights of the tileset at many positions, like
+   * SampleHeightMostDetailedBatch, optionally loading the tiles that are
+   * needed first. The positions are grouped into cells, and a view looking
+   * down at each cell is added to the camera manager until the tiles it needs
+   * have been loaded. Requires Create Trace Meshes.
+   *
+   * @param LongitudeLatitudeHeights The positions to sample, as longitude and
+   * latitude in degrees. The heights are ignored.
+   * @param LoadTilesFromHeight If greater than zero, the tiles that would be
+   * shown to a view looking down from this many meters above the ellipsoid at
+   * each position are loaded before the heights are sampled, which sets the
+   * detail of the heights. Otherwise, only the tiles that are already shown
+   * are sampled, and the future is resolved immediately.
+   * @returns A future that resolves in the game thread with a result for each
+   * of the positions, in the same order.
+   */
+  CesiumAsync::Future<TArray<FCesiumSampleHeightResult>>
+  SampleHeightMostDetailedAsync(
+      const TArray<FVector>& LongitudeLatitudeHeights,
+      double LoadTilesFromHeight = 0.0);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
   bool GetCreateNavCollision() const { return CreateNavCollision; }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
   void SetCreateNavCollision(bool bCreateNavCollision);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
+  bool GetRestrictNavigationToInvokers() const {
+    return RestrictNavigationToInvokers;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
+  void SetRestrictNavigationToInvokers(bool bRestrictNavigationToInvokers);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
+  int32 GetMaximumNavigationUpdatesPerFrame() const {
+    return MaximumNavigationUpdatesPerFrame;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
+  void SetMaximumNavigationUpdatesPerFrame(
+      int32 InMaximumNavigationUpdatesPerFrame);
+
+  /**
+   * Whether the tileset decides when each of its tiles is ray traced, rather
+   * than all of them being ray traced as soon as they are shown.
+   */
+  bool IsRayTracingManaged() const {
+    return RayTracingDistance > 0.0 || MaximumRayTracingUpdatesPerFrame > 0;
+  }
+
+  /**
+   * Whether the tileset decides which of its tile meshes affect navigation,
+   * rather than all of them affecting it as soon as they are created.
+   */
+  bool IsNavigationManaged() const {
+    return CreateNavCollision &&
+           (RestrictNavigationToInvokers ||
+            MaximumNavigationUpdatesPerFrame > 0);
+  }
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetAlwaysIncludeTangents() const { return AlwaysIncludeTangents; }
 
@@ -989,6 +2294,12 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  float GetSmoothNormalsCreaseAngle() const { return SmoothNormalsCreaseAngle; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetSmoothNormalsCreaseAngle(float InSmoothNormalsCreaseAngle);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetEnableWaterMask() const { return EnableWaterMask; }
 
@@ -1000,6 +2311,109 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetIgnoreKhrMaterialsUnlit(bool bIgnoreKhrMaterialsUnlit);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetCompressTextures() const { return CompressTextures; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetCompressTextures(bool bCompressTextures);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseCompactVertexFormat() const { return UseCompactVertexFormat; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseCompactVertexFormat(bool bUseCompactVertexFormat);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetPackFeatureIds() const { return PackFeatureIds; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetPackFeatureIds(bool bPackFeatureIds);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetQuantizePointClouds() const { return QuantizePointClouds; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetQuantizePointClouds(bool bQuantizePointClouds);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseFastTangentsForWater() const { return UseFastTangentsForWater; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseFastTangentsForWater(bool bUseFastTangentsForWater);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseTerrainHeightmaps() const { return UseTerrainHeightmaps; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseTerrainHeightmaps(bool bUseTerrainHeightmaps);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  int32 GetTerrainHeightmapResolution() const {
+    return TerrainHeightmapResolution;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetTerrainHeightmapResolution(int32 InTerrainHeightmapResolution);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetComputeRasterOverlayTextureCoordinates() const {
+    return ComputeRasterOverlayTextureCoordinates;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetComputeRasterOverlayTextureCoordinates(
+      bool bComputeRasterOverlayTextureCoordinates);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetOptimizeMeshes() const { return OptimizeMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetOptimizeMeshes(bool bOptimizeMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetBuildNaniteMeshes() const { return BuildNaniteMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetBuildNaniteMeshes(bool bBuildNaniteMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetGenerateSimplifiedLod() const { return GenerateSimplifiedLod; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetGenerateSimplifiedLod(bool bGenerateSimplifiedLod);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  float GetSimplifiedLodScreenSize() const { return SimplifiedLodScreenSize; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetSimplifiedLodScreenSize(float InSimplifiedLodScreenSize);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetUseClusterCulling() const { return UseClusterCulling; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetUseClusterCulling(bool bUseClusterCulling);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetMergeInstancedMeshes() const { return MergeInstancedMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetMergeInstancedMeshes(bool bMergeInstancedMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetMergeSmallPrimitives() const { return MergeSmallPrimitives; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetMergeSmallPrimitives(bool bMergeSmallPrimitives);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Tile Loading")
+  ECesiumTileBufferResidency GetTileBufferResidency() const {
+    return TileBufferResidency;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Tile Loading")
+  void SetTileBufferResidency(ECesiumTileBufferResidency InResidency);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   UMaterialInterface* GetMaterial() const { return Material; }
 
@@ -1028,6 +2442,15 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Rendering")
   void SetCustomDepthParameters(FCustomDepthParameters InCustomDepthParameters);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  TArray<URuntimeVirtualTexture*> GetRuntimeVirtualTextures() const {
+    return RuntimeVirtualTextures;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetRuntimeVirtualTextures(
+      const TArray<URuntimeVirtualTexture*>& InRuntimeVirtualTextures);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   FCesiumPointCloudShading GetPointCloudShading() const {
     return PointCloudShading;
@@ -1036,6 +2459,12 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetPointCloudShading(FCesiumPointCloudShading InPointCloudShading);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  FCesiumVoxelRendering GetVoxelRendering() const { return VoxelRendering; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetVoxelRendering(FCesiumVoxelRendering InVoxelRendering);
+
   UFUNCTION(BlueprintCallable, Category = "Cesium|Rendering")
   void PlayMovieSequencer();
 
@@ -1061,6 +2490,13 @@ public:
     return this->_pTileset.Get();
   }
 
+  /**
+   * Makes the next tick update this tileset's view, even if the editor is
+   * idle, after a change that the tileset can't see, like a raster overlay
+   * being added or removed.
+   */
+  void InvalidateIdleEditorUpdate() { this->_isEditorViewIdle = false; }
+
   // AActor overrides (some or most of them should be protected)
   virtual bool ShouldTickIfViewportsOnly() const override;
   virtual void Tick(float DeltaTime) override;
@@ -1104,6 +2540,32 @@ protected:
       FVector NormalImpulse,
       const FHitResult& Hit) override;
 
+public:
+  /**
+   * Sets the builder whose stages are part of the creation of the content of
+   * this tileset's tiles, or nullptr for none. Changing it reloads the
+   * tileset.
+   */
+  void SetTileContentBuilder(
+      const TSharedPtr<ICesiumTileContentBuilder, ESPMode::ThreadSafe>&
+          Builder);
+
+  /**
+   * Gets the builder whose stages are part of the creation of the content of
+   * this tileset's tiles, if any.
+   */
+  const TSharedPtr<ICesiumTileContentBuilder, ESPMode::ThreadSafe>&
+  GetTileContentBuilder() const {
+    return this->_pTileContentBuilder;
+  }
+
+  /**
+   * Destroys the copies of the tiles of a tileset in the given world that this
+   * tileset shows because of Share Tiles Across Worlds, so that they don't
+   * keep the world from being garbage collected.
+   */
+  void ReleaseTilesSharedFromWorld(const UWorld* World);
+
 private:
   void LoadTileset();
   void DestroyTileset();
@@ -1114,6 +2576,18 @@ private:
       UCesiumEllipsoid* ellipsoid);
 
   std::vector<FCesiumCamera> GetCameras() const;
+  ACesium3DTileset* getLinkedTileset() const;
+  void addLinkedTilesetCameras(std::vector<FCesiumCamera>& cameras) const;
+  const std::vector<FCesiumCamera>& GetWorldCameras() const;
+  void addPrefetchViewStates(
+      const std::vector<FCesiumCamera>& cameras,
+      const glm::dmat4& unrealWorldToTileset,
+      UCesiumEllipsoid* ellipsoid,
+      float deltaTime,
+      std::vector<Cesium3DTilesSelection::ViewState>& viewStates);
+  Cesium3DTilesSelection::ViewUpdateResult updateViewForMovie(
+      std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      size_t frameViewCount);
   std::vector<FCesiumCamera> GetPlayerCameras() const;
   std::vector<FCesiumCamera> GetSceneCaptures() const;
 
@@ -1158,9 +2632,165 @@ private:
    * be rendered in the current frame.
    *
    * @param tiles The tiles
+   * @param changes The changes to add the tiles' visibility and collision to
    */
-  void
-  showTilesToRender(const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+  void showTilesToRender(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      CesiumTileStateChanges& changes);
+
+  /**
+   * Stops the rendered tiles beyond the ShadowCastingDistance from casting
+   * shadows, and has their ancestors cast them instead when
+   * UseAncestorShadowProxies is enabled. The tiles changed in a previous
+   * frame that are no longer beyond the distance cast shadows again.
+   *
+   * @param tiles The tiles rendered this frame
+   * @param views The views the distances are measured from
+   */
+  void updateShadowCasting(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  /**
+   * Removes the rendered tiles beyond the RayTracingDistance from ray
+   * tracing, has their ancestors stand in for them when
+   * UseAncestorRayTracingProxies is enabled, and adds the other rendered
+   * tiles to ray tracing, at most MaximumRayTracingUpdatesPerFrame at a time.
+   * When ray tracing is no longer managed, all tiles are ray traced again.
+   *
+   * @param tiles The tiles rendered this frame
+   * @param views The views the distances are measured from
+   */
+  void updateRayTracing(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+      const std::vector<Cesium3DTilesSelection::ViewState>& views);
+
+  /**
+   * Continues building the glTF components of tiles whose primitives could
+   * not all be created within the tile finalization budget of a previous
+   * frame.
+   */
+  void continueIncrementalGltfBuilds();
+  void finishTileContent(UCesiumGltfComponent& gltf);
+
+  /**
+   * Gets the feature IDs and metadata that tiles encode when they are
+   * loaded, or nullptr if they don't encode any. May be called from any
+   * thread.
+   */
+  TSharedPtr<
+      const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+      ESPMode::ThreadSafe>
+  getFeaturesMetadataDescription() const;
+
+  /**
+   * Updates the properties that are encoded on demand when the used
+   * properties of the features metadata component change, and continues
+   * encoding the newly used properties for the tiles that are already loaded,
+   * within the tile finalization budget.
+   */
+  void updateMetadataEncodedOnDemand();
+
+  /**
+   * Compiles the style of the features metadata component when it changes,
+   * and continues applying it to the tiles that are already loaded, within
+   * the tile finalization budget.
+   */
+  void updateFeatureStyle();
+
+  /**
+   * Colors the tiles that are loaded by the Debug Tile Cost Metric, or
+   * restores their own colors once it is set back to None.
+   */
+  void updateTileCostHeatmap();
+
+  /**
+   * When Create Physics Meshes On Demand is set, starts building the physics
+   * meshes of the primitives near the physics mesh focus actors, and removes
+   * those of the primitives that are no longer near any of them.
+   */
+  void updatePhysicsMeshesOnDemand();
+
+  /**
+   * After Create Physics Meshes has changed, removes the physics meshes of the
+   * loaded tiles, or builds those that are missing, instead of reloading the
+   * tiles. Tiles that were being loaded at the time are created with the value
+   * they were loaded with, so this continues until they have all been
+   * created.
+   */
+  void updatePhysicsMeshesInPlace();
+
+  /**
+   * Has updatePhysicsMeshesInPlace reconcile the loaded tiles with a new value
+   * of Create Physics Meshes, or reloads them if they can't be.
+   */
+  void onCreatePhysicsMeshesChanged();
+
+  /**
+   * Gives the loaded tiles the current Material, Translucent Material, and
+   * Water Material, instead of reloading them.
+   *
+   * @returns false if the tiles must be reloaded, because a new material has
+   * other material layers than the one it replaces, or because the instances
+   * of tiles are merged into batches, which are made for their materials.
+   */
+  bool updateMaterialsInPlace();
+
+  /**
+   * Gives the loaded tiles the current Custom Depth Parameters.
+   */
+  void updateCustomDepthInPlace();
+
+  /**
+   * When navigation is managed by the tileset, makes the tile meshes that
+   * should affect navigation do so, and the others not, within the budget of
+   * Maximum Navigation Updates Per Frame.
+   */
+  void updateNavigationRelevance();
+
+  /**
+   * Gets the locations from which tiles are prioritized when Maximum
+   * Collision Updates Per Frame limits the tiles that have their collision
+   * enabled: those of the Physics Mesh Focus Actors, or of the players' pawns
+   * or cameras if there are none.
+   */
+  TArray<FVector> getCollisionPriorityLocations() const;
+
+  /**
+   * Commits tile changes within the budget of Maximum Collision Updates Per
+   * Frame.
+   */
+  void commitTileStateChanges(CesiumTileStateChanges& changes);
+
+  /**
+   * Samples the heights of the pending SampleHeightMostDetailedAsync queries
+   * whose tiles have finished loading, and resolves them.
+   */
+  void updateSampleHeightQueries();
+
+  /**
+   * Resolves all pending SampleHeightMostDetailedAsync queries with the
+   * tiles that are shown now, and removes their views.
+   */
+  void finishSampleHeightQueries();
+
+  /**
+   * Passes the eye-dome lighting of the Point Cloud Shading to the view
+   * extension that shades the point clouds.
+   */
+  void updateEyeDomeLighting();
+
+  /**
+   * Recreates the render state of the voxel components of this tileset, so
+   * that they're drawn with the current Voxel Rendering.
+   */
+  void updateVoxelRendering();
+
+  /**
+   * Applies the latest occlusion results to the tiles of this tileset and
+   * submits the bounds of the tiles to test in the next frame.
+   */
+  void updateOcclusion();
 
   /**
    * Will be called after the tileset is loaded or spawned, to register
@@ -1191,8 +2821,15 @@ private:
 private:
   TUniquePtr<Cesium3DTilesSelection::Tileset> _pTileset;
 
-  std::optional<FCesiumFeaturesMetadataDescription>
-      _featuresMetadataDescription;
+  // The feature IDs and metadata that tiles encode when they are loaded.
+  // Tiles are loaded on worker threads while the properties encoded on demand
+  // can change, so this is replaced rather than modified, under the lock. It
+  // is indexed once here rather than searched by every tile.
+  TSharedPtr<
+      const CesiumEncodedFeaturesMetadata::IndexedFeaturesMetadataDescription,
+      ESPMode::ThreadSafe>
+      _pFeaturesMetadataDescription;
+  mutable FCriticalSection _featuresMetadataDescriptionLock;
 
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   std::optional<FMetadataDescription> _metadataDescription_DEPRECATED;
@@ -1213,6 +2850,12 @@ private:
   std::chrono::high_resolution_clock::time_point _startTime;
 
   bool _captureMovieMode;
+
+  // The views of the last view update in the editor, and whether that update
+  // left nothing to load or fade, in which case the next update is skipped if
+  // the views are unchanged. See SkipIdleEditorUpdates.
+  std::vector<Cesium3DTilesSelection::ViewState> _lastEditorViewStates;
+  bool _isEditorViewIdle = false;
   bool _beforeMoviePreloadAncestors;
   bool _beforeMoviePreloadSiblings;
   int32_t _beforeMovieLoadingDescendantLimit;
@@ -1220,6 +2863,10 @@ private:
 
   bool _scaleUsingDPI;
 
+  // The locations of the cameras in the previous frame, from which their
+  // velocities are estimated for prefetching.
+  std::vector<FVector> _previousCameraLocations;
+
   // This is used as a workaround for cesium-native#186
   //
   // The tiles that are no longer supposed to be rendered in the current
@@ -1234,8 +2881,122 @@ private:
   // tilesToHideThisFrame may be hidden immediately.
   std::vector<Cesium3DTilesSelection::Tile*> _tilesToHideNextFrame;
 
+  // Incremented on each tick that updates the view. Components of tiles
+  // rendered in that tick are stamped with it, so that tiles in
+  // _tilesToHideNextFrame that are rendered again can be skipped without
+  // searching tilesToRenderThisFrame.
+  uint64 _renderEpoch = 0;
+
+  // The largest number of pixels that an object one unit across covers at a
+  // distance of one unit, in the views of the last tick that updated the view.
+  // Primitive draw distances are derived from it.
+  double _largestProjectionScale = 0.0;
+
+  // The glTF components that are still being created incrementally, oldest
+  // first. They are kept hidden until they are complete.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _gltfComponentsBeingBuilt;
+
+  // The version of the features metadata component's used properties that
+  // the properties encoded on demand were last selected with.
+  int32 _usedMetadataPropertiesVersion = 0;
+
+  // The glTF components that may be missing properties encoded on demand.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _gltfComponentsToEncode;
+
+  // The style of the features metadata component, compiled, or nullptr if no
+  // style has been applied to the tiles.
+  TSharedPtr<const CesiumCompiledFeatureStyle> _pFeatureStyle;
+
+  // The version of the features metadata component's style that was last
+  // compiled, or INDEX_NONE before it is first compiled.
+  int32 _featureStyleVersion = INDEX_NONE;
+
+  // The glTF components that the current feature style still needs to be
+  // applied to.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _gltfComponentsToStyle;
+
+  // The tile cost that the tiles were last colored by.
+  ECesiumTileCostMetric _tileCostMetric = ECesiumTileCostMetric::None;
+
+  TSharedPtr<CesiumPrimitiveComponentPool> _pPrimitiveComponentPool;
+  TSharedPtr<CesiumMaterialInstanceCache> _pMaterialInstanceCache;
+  TSharedPtr<CesiumInstanceBatches> _pInstanceBatches;
+  TSharedPtr<CesiumMemoryUsageTracker> _pMemoryUsageTracker;
+
+  // The tiles shown in the previous frame for the views that use loaded tiles
+  // only, which the view update did not select.
+  std::vector<Cesium3DTilesSelection::Tile*> _loadedTilesOnlyRendered;
+
+  // The glTF components whose shadow casting updateShadowCasting changed.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _shadowCastingChanged;
+
+  // The tile changes held back until the current TileUpdateWindow ends, and
+  // the time it started.
+  TSharedPtr<CesiumTileStateChanges> _pHeldTileStateChanges;
+  double _lastTileUpdateWindowStart = 0.0;
+
+  // The number of tiles whose collision was left disabled by the last commit
+  // of tile changes, because of MaximumCollisionUpdatesPerFrame.
+  int32 _deferredCollisionUpdates = 0;
+
+  // The glTF components standing in for tiles beyond the RayTracingDistance,
+  // and whether updateRayTracing managed the ray tracing of the tiles last
+  // frame.
+  TArray<TWeakObjectPtr<UCesiumGltfComponent>> _rayTracingProxies;
+  bool _isRayTracingManaged = false;
+
+  // Whether updatePhysicsMeshesInPlace has tiles to reconcile with a change
+  // of Create Physics Meshes.
+  bool _physicsMeshesChanged = false;
+
+  // Whether tiles were loaded without their physics meshes because the
+  // streaming governor deferred them. Set from the load threads.
+  std::atomic<bool> _physicsMeshesDeferred{false};
+
+  TSharedPtr<ICesiumTileContentBuilder, ESPMode::ThreadSafe>
+      _pTileContentBuilder;
+
+  // The trace that the tile selection is recorded to or replayed from, if
+  // any.
+  TSharedPtr<CesiumSelectionTrace> _pSelectionTrace;
+
+  // The copies of the tiles of the LinkedTileset that this tileset shows.
+  TSharedPtr<CesiumLinkedTileComponents> _pLinkedTileComponents;
+
+  // The tilesets that are linked to this one, whose views this tileset also
+  // selects tiles for.
+  TArray<TWeakObjectPtr<ACesium3DTileset>> _linkedTilesets;
+
+  // The SampleHeightMostDetailedAsync queries that wait for tiles to load.
+  TArray<TSharedPtr<CesiumSampleHeightQuery>> _sampleHeightQueries;
+
+  // The settings shared by the scene proxies of the points components of this
+  // tileset. Created with the first of them, and only accessed from the render
+  // thread after that.
+  TSharedPtr<FCesiumGltfPointsSceneProxyTilesetSettings, ESPMode::ThreadSafe>
+      _pPointsSceneProxySettings;
+
+  // Whether the points components of this tileset render custom depth for
+  // eye-dome lighting.
+  bool _pointsUseEyeDomeLighting = false;
+
+  // The occlusion proxies of the tiles, when occluded tiles are culled. It's
+  // shared with the native tileset.
+  std::shared_ptr<CesiumOcclusionProxyPool> _pOcclusionPool;
+
+  // Excludes the tiles behind the horizon. It's one of the excluders of the
+  // native tileset.
+  std::shared_ptr<CesiumHorizonCuller> _pHorizonCuller;
+  std::shared_ptr<CesiumTileDistanceExcluder> _pDistanceExcluder;
+
+  // The accessor through which the native tileset makes its requests. It is
+  // cancelled when the tileset is destroyed, so that the destruction doesn't
+  // wait for the requests in flight.
+  std::shared_ptr<CesiumCancellableAssetAccessor> _pAssetAccessor;
+
   int32 _tilesetsBeingDestroyed;
 
   friend class UnrealResourcePreparer;
   friend class UCesiumGltfPointsComponent;
+  friend class FCesiumGltfPointsSceneProxyUpdater;
 };
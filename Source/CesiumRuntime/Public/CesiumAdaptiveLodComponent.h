@@ -0,0 +1,172 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumAdaptiveLodComponent.generated.h"
+
+class ACesium3DTileset;
+class CesiumScreenSpaceErrorController;
+
+/**
+ * Adjusts the Maximum Screen Space Error of the Cesium3DTileset that owns it
+ * while playing, so that the frame rate stays at a target and the tileset's
+ * tiles stay within a memory budget, without tuning the screen-space error by
+ * hand for each platform and scene.
+ *
+ * The frame time is the longest of the game thread, render thread, and GPU
+ * times of the previous frame. When it is above the target, or the tiles take
+ * more memory than the budget, the screen-space error is raised to load fewer
+ * tiles, and when there is time to spare, it is lowered again to show more
+ * detail. It always stays between the minimum and maximum given here. The
+ * original values of the tileset are restored when play ends.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumAdaptiveLodComponent : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumAdaptiveLodComponent();
+
+  /**
+   * The frame rate to hold, in frames per second.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      meta = (ClampMin = 1.0))
+  float TargetFramesPerSecond = 60.0f;
+
+  /**
+   * The maximum total size, in megabytes, of the tileset's loaded tiles, as
+   * reported by its GetMemoryUsage function. When the tiles take more than
+   * this, the screen-space error is raised even if the frame rate is on
+   * target, and it is not lowered while they take nearly this much. A value
+   * of zero ignores the memory taken by the tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      meta = (ClampMin = 0, Units = "Megabytes"))
+  int32 MemoryBudgetMB = 0;
+
+  /**
+   * The lowest, and therefore most detailed, Maximum Screen Space Error that
+   * may be set on the tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      meta = (ClampMin = 0.0))
+  double MinimumScreenSpaceError = 2.0;
+
+  /**
+   * The highest, and therefore least detailed, Maximum Screen Space Error
+   * that may be set on the tileset.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      meta = (ClampMin = 0.0))
+  double MaximumScreenSpaceError = 64.0;
+
+  /**
+   * Whether to scale the tileset's Culled Screen Space Error along with its
+   * Maximum Screen Space Error, keeping the ratio between them that the
+   * tileset started with.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Adaptive LOD")
+  bool AdjustCulledScreenSpaceError = true;
+
+  /**
+   * How far the frame time may be from the target, as a fraction of the
+   * target, before the screen-space error is changed. Once it changes, it
+   * keeps changing until the frame time is within half of this, so that small
+   * variations in the frame time don't make the level of detail flicker.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0, ClampMax = 1.0))
+  float Tolerance = 0.1f;
+
+  /**
+   * The time, in seconds, over which the frame times are averaged before they
+   * are compared with the target.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0, Units = "Seconds"))
+  float SmoothingTime = 0.25f;
+
+  /**
+   * How strongly the screen-space error follows the current error of the
+   * frame time. The screen-space error is doubled for each unit of this
+   * gain times the relative error.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0))
+  float ProportionalGain = 1.0f;
+
+  /**
+   * How quickly the screen-space error changes while the frame time stays
+   * away from the target, which removes the error that remains with the
+   * proportional gain alone.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0))
+  float IntegralGain = 0.5f;
+
+  /**
+   * How strongly the screen-space error reacts to changes of the error of the
+   * frame time, which damps overshooting the target.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Adaptive LOD",
+      AdvancedDisplay,
+      meta = (ClampMin = 0.0))
+  float DerivativeGain = 0.0f;
+
+  /**
+   * Gets the averaged frame time, in milliseconds, that the screen-space error
+   * is currently adjusted for.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Adaptive LOD")
+  float GetSmoothedFrameTime() const { return this->_smoothedFrameTime; }
+
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  virtual void TickComponent(
+      float DeltaTime,
+      ELevelTick TickType,
+      FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+  ACesium3DTileset* getTileset() const;
+
+  TSharedPtr<CesiumScreenSpaceErrorController> _pController;
+  float _smoothedFrameTime = 0.0f;
+  double _originalScreenSpaceError = 0.0;
+  double _originalCulledScreenSpaceError = 0.0;
+  bool _isControlling = false;
+};
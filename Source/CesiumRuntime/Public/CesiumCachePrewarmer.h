@@ -0,0 +1,199 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "UObject/Object.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "CesiumCachePrewarmer.generated.h"
+
+class ACesium3DTileset;
+class ACesiumCartographicPolygon;
+
+/**
+ * The progress of a {@link UCesiumCachePrewarmer}.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumCachePrewarmProgress {
+  GENERATED_BODY()
+
+  /**
+   * The number of views whose tiles have all been loaded, including those
+   * completed in an earlier run that was resumed.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 CompletedViews = 0;
+
+  /**
+   * The total number of views needed to cover the region.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 TotalViews = 0;
+
+  /**
+   * The load progress of the tileset for the views currently being loaded,
+   * from 0 to 100.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  float CurrentLoadProgress = 0.0f;
+
+  /**
+   * Whether the prewarmer has finished, either because every view was loaded
+   * or because it was cancelled.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  bool bIsComplete = false;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FCesiumCachePrewarmProgressDelegate,
+    const FCesiumCachePrewarmProgress&,
+    Progress);
+
+/**
+ * Fills the request cache with the tiles and raster overlay tiles that a
+ * tileset needs over a region, before anyone views the region.
+ *
+ * The region is covered with a grid of downward-looking views at the given
+ * height. The views are added to the tileset's camera manager a few at a
+ * time, and the next views are added once the tileset has finished loading
+ * for the current ones. Everything the tileset loads along the way goes
+ * through the request cache. For the duration, the tileset's Maximum Screen
+ * Space Error and Maximum Simultaneous Tile Loads are replaced with the
+ * values given here.
+ *
+ * If a resume file is given, the number of completed views is saved to it
+ * after each step, and a later run with the same region and settings
+ * continues from there.
+ */
+UCLASS(BlueprintType)
+class CESIUMRUNTIME_API UCesiumCachePrewarmer : public UObject,
+                                                public FTickableGameObject {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The tileset whose tiles to load.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ACesium3DTileset* Tileset = nullptr;
+
+  /**
+   * The region in which to load tiles.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ACesiumCartographicPolygon* Region = nullptr;
+
+  /**
+   * The maximum screen space error to load tiles to. Lower values load more
+   * detailed tiles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  double MaximumScreenSpaceError = 16.0;
+
+  /**
+   * The height of the views above the ellipsoid, in meters. This should be
+   * the lowest height from which the region will usually be seen. The views
+   * are spaced by this distance, too.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1.0, Units = "Meters"))
+  double ViewHeight = 500.0;
+
+  /**
+   * The number of views loaded at the same time.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Throughput",
+      meta = (ClampMin = 1))
+  int32 ViewsPerStep = 4;
+
+  /**
+   * The tileset's Maximum Simultaneous Tile Loads while prewarming.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Throughput",
+      meta = (ClampMin = 1))
+  int32 MaximumSimultaneousTileLoads = 20;
+
+  /**
+   * The file in which to save progress so that an interrupted run can be
+   * resumed. If empty, progress is not saved.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString ResumeFilename;
+
+  /**
+   * Raised each time a step of views has finished loading.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium")
+  FCesiumCachePrewarmProgressDelegate OnProgress;
+
+  /**
+   * Raised when prewarming finishes or is cancelled.
+   */
+  UPROPERTY(BlueprintAssignable, Category = "Cesium")
+  FCesiumCachePrewarmProgressDelegate OnComplete;
+
+  /**
+   * Starts prewarming. This does nothing if prewarming is already running.
+   *
+   * @return True if prewarming started, false if the tileset or region is
+   * missing or invalid.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  bool Start();
+
+  /**
+   * Stops prewarming and restores the tileset's settings. Progress that was
+   * saved to the resume file is kept.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void Cancel();
+
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  bool IsRunning() const { return this->_running; }
+
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  FCesiumCachePrewarmProgress GetProgress() const;
+
+  virtual void BeginDestroy() override;
+
+  // FTickableGameObject
+  virtual void Tick(float DeltaTime) override;
+  virtual ETickableTickType GetTickableTickType() const override;
+  virtual bool IsTickable() const override;
+  virtual bool IsTickableWhenPaused() const override;
+  virtual bool IsTickableInEditor() const override;
+  virtual TStatId GetStatId() const override;
+
+private:
+  void addViews();
+  void removeViews();
+  void finish(bool deleteResumeFile);
+  FString getResumeSignature() const;
+  int32 loadResumePoint() const;
+  void saveResumePoint() const;
+
+  bool _running = false;
+  TWeakObjectPtr<ACesium3DTileset> _pTileset;
+  TArray<FVector> _viewLocations;
+  TArray<int32> _activeCameraIds;
+  int32 _completedViews = 0;
+  int32 _stepViews = 0;
+  int32 _framesSinceStep = 0;
+  double _originalMaximumScreenSpaceError = 0.0;
+  int32 _originalMaximumSimultaneousTileLoads = 0;
+};
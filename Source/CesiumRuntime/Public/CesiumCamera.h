@@ -56,6 +56,75 @@ public:
   UPROPERTY(BlueprintReadWrite, Category = "Cesium")
   double OverrideAspectRatio = 0.0;
 
+  /**
+   * @brief The point that the viewer is looking at, for example as reported
+   * by an eye tracker, in normalized viewport coordinates from (0, 0) at the
+   * top left to (1, 1) at the bottom right.
+   *
+   * This is only used when FocusRadiusDegrees is greater than zero.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  FVector2D FocusPoint = FVector2D(0.5, 0.5);
+
+  /**
+   * @brief The angular radius, in degrees, of the region around the focus
+   * point in which tiles are refined to the tileset's Maximum Screen Space
+   * Error.
+   *
+   * Outside of this region and its falloff, tiles are refined to a screen-space
+   * error that is PeripheralScreenSpaceErrorMultiplier times larger, so fewer
+   * tiles are loaded and rendered where the viewer can't make out the detail.
+   * When this is 0.0, the whole view is refined evenly.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  double FocusRadiusDegrees = 0.0;
+
+  /**
+   * @brief The angle, in degrees, beyond the focus radius over which the
+   * screen-space error rises to the peripheral one. It rises in a few steps
+   * rather than smoothly.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  double FocusFalloffDegrees = 10.0;
+
+  /**
+   * @brief How many times larger the screen-space error of the tiles outside
+   * of the focus region and its falloff may be.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  double PeripheralScreenSpaceErrorMultiplier = 4.0;
+
+  /**
+   * @brief The velocity of the camera, in Unreal units per second, that
+   * tilesets with Prefetch Along Camera Motion enabled use to load the tiles
+   * ahead of it.
+   *
+   * When this is zero, tilesets estimate the velocity from how far the camera
+   * moved since the previous frame.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  FVector Velocity = FVector::ZeroVector;
+
+  /**
+   * @brief How many times larger the screen-space error of the tiles in this
+   * view may be than the Maximum Screen Space Error of the tileset, such as
+   * for a small minimap that doesn't need the detail of the main view.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  double ScreenSpaceErrorMultiplier = 1.0;
+
+  /**
+   * @brief Whether this view only shows tiles that other views have already
+   * loaded, without loading any for itself.
+   *
+   * The view is then shown the most detailed of the loaded tiles that meets
+   * its screen-space error, or less detailed ones where those are all that
+   * are loaded. Like the tiles of other views, these are only loaded as
+   * long as at least one view of the tileset loads tiles.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  bool UseLoadedTilesOnly = false;
+
   /**
    * @brief Construct an uninitialized FCesiumCamera object.
    */
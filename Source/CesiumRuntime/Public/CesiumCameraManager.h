@@ -68,6 +68,29 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   const TMap<int32, FCesiumCamera>& GetCameras() const;
 
+  /**
+   * @brief Sets the cameras of frames that will be rendered soon, such as the
+   * next frames of the camera track of a movie being rendered.
+   *
+   * While a Level Sequence is played to render a movie, tilesets wait for the
+   * tiles of each frame to load before it's rendered. The tiles for these
+   * cameras start loading at the same time, and stay loaded, but aren't
+   * waited for, so that they're mostly loaded by the time their frames are
+   * rendered. Outside of movie rendering, these cameras are ignored.
+   *
+   * The cameras are kept until they're set again, so they should be updated
+   * every frame as the movie advances.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void SetUpcomingCameras(const TArray<FCesiumCamera>& Cameras);
+
+  /**
+   * @brief Gets the cameras of frames that will be rendered soon, as given to
+   * SetUpcomingCameras.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  const TArray<FCesiumCamera>& GetUpcomingCameras() const;
+
   virtual bool ShouldTickIfViewportsOnly() const override;
 
   virtual void Tick(float DeltaTime) override;
@@ -75,6 +98,7 @@ public:
 private:
   int32 _currentCameraId = 0;
   TMap<int32, FCesiumCamera> _cameras;
+  TArray<FCesiumCamera> _upcomingCameras;
 
   static FName DEFAULT_CAMERAMANAGER_TAG;
 };
@@ -0,0 +1,372 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#define CESIUM_HAS_COROUTINES 1
+#else
+#define CESIUM_HAS_COROUTINES 0
+#endif
+
+#if CESIUM_HAS_COROUTINES
+
+#include "Async/TaskGraphInterfaces.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumAsync/Future.h"
+#include "CesiumAsync/IAssetAccessor.h"
+#include "CesiumAsync/IAssetRequest.h"
+#include "CesiumAsync/Promise.h"
+#include "CesiumRuntime.h"
+#include "RenderingThread.h"
+#include "UnrealTaskProcessor.h"
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * C++20 coroutines over Cesium's asynchronous work, for code extending the
+ * tile pipeline that is easier to write as a sequence of steps than as a
+ * chain of futures.
+ *
+ * A coroutine returning a {@link CesiumCoroutine::Task} starts when it is
+ * awaited, and resumes the coroutine awaiting it directly when it finishes,
+ * without going through a scheduler. Within one, the awaitables below move
+ * the rest of the coroutine to another thread. Unlike the continuations of a
+ * future, these don't allocate anything besides the task that Unreal or the
+ * dedicated threads run the coroutine in. The coroutine frames themselves
+ * are allocated once per coroutine, not once per step. Use
+ * {@link CesiumCoroutine::toFuture} to hand a coroutine's result to code that
+ * expects a future.
+ *
+ * This is only available when the module is compiled as C++20, which is the
+ * case from Unreal Engine 5.4. Check CESIUM_HAS_COROUTINES before using it.
+ */
+namespace CesiumCoroutine {
+
+template <typename T = void> class Task;
+
+namespace Detail {
+
+struct PromiseBase {
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename TPromise>
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<TPromise> handle) noexcept {
+      return handle.promise().continuation;
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+  void unhandled_exception() noexcept {
+    this->pException = std::current_exception();
+  }
+
+  std::coroutine_handle<> continuation = std::noop_coroutine();
+  std::exception_ptr pException;
+};
+
+template <typename T> struct Promise : PromiseBase {
+  Task<T> get_return_object() noexcept;
+
+  template <typename TValue> void return_value(TValue&& value) {
+    this->value.emplace(std::forward<TValue>(value));
+  }
+
+  T takeResult() {
+    if (this->pException) {
+      std::rethrow_exception(this->pException);
+    }
+    return std::move(*this->value);
+  }
+
+  std::optional<T> value;
+};
+
+template <> struct Promise<void> : PromiseBase {
+  Task<void> get_return_object() noexcept;
+
+  void return_void() const noexcept {}
+
+  void takeResult() const {
+    if (this->pException) {
+      std::rethrow_exception(this->pException);
+    }
+  }
+};
+
+// A coroutine that starts immediately and destroys itself when it finishes.
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() const noexcept { return {}; }
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+    std::suspend_never final_suspend() const noexcept { return {}; }
+    void return_void() const noexcept {}
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+// A task graph task that resumes a coroutine.
+class ResumeGraphTask {
+public:
+  ResumeGraphTask(std::coroutine_handle<> handle, ENamedThreads::Type thread)
+      : _handle(handle), _thread(thread) {}
+
+  ENamedThreads::Type GetDesiredThread() const { return this->_thread; }
+
+  static ESubsequentsMode::Type GetSubsequentsMode() {
+    return ESubsequentsMode::FireAndForget;
+  }
+
+  TStatId GetStatId() const {
+    RETURN_QUICK_DECLARE_CYCLE_STAT(ResumeGraphTask, STATGROUP_TaskGraphTasks);
+  }
+
+  void DoTask(ENamedThreads::Type, const FGraphEventRef&) {
+    this->_handle.resume();
+  }
+
+private:
+  std::coroutine_handle<> _handle;
+  ENamedThreads::Type _thread;
+};
+
+inline void resumeInWorkerThread(std::coroutine_handle<> handle) {
+  // The function holds only the handle, so it fits in the function's own
+  // storage.
+  getTaskProcessor()->startTask([handle]() { handle.resume(); });
+}
+
+} // namespace Detail
+
+/**
+ * The result of a coroutine, which runs when it is awaited.
+ *
+ * A task runs at most once, and must be awaited at most once. If it is
+ * destroyed without being awaited, the coroutine never runs.
+ */
+template <typename T> class [[nodiscard]] Task {
+public:
+  using promise_type = Detail::Promise<T>;
+
+  Task(Task&& rhs) noexcept : _handle(std::exchange(rhs._handle, nullptr)) {}
+
+  Task& operator=(Task&& rhs) noexcept {
+    if (this != &rhs) {
+      if (this->_handle) {
+        this->_handle.destroy();
+      }
+      this->_handle = std::exchange(rhs._handle, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() noexcept {
+    if (this->_handle) {
+      this->_handle.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept {
+    return !this->_handle || this->_handle.done();
+  }
+
+  std::coroutine_handle<>
+  await_suspend(std::coroutine_handle<> awaiting) noexcept {
+    this->_handle.promise().continuation = awaiting;
+    return this->_handle;
+  }
+
+  T await_resume() { return this->_handle.promise().takeResult(); }
+
+private:
+  friend struct Detail::Promise<T>;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : _handle(handle) {}
+
+  std::coroutine_handle<promise_type> _handle;
+};
+
+template <typename T> Task<T> Detail::Promise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> Detail::Promise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * Continues the coroutine in a worker thread, with the priority of the work
+ * that started it. See {@link UnrealTaskProcessor}.
+ */
+inline auto resumeInWorkerThread() noexcept {
+  struct Awaitable {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const {
+      Detail::resumeInWorkerThread(handle);
+    }
+    void await_resume() const noexcept {}
+  };
+  return Awaitable{};
+}
+
+/**
+ * Continues the coroutine in the game thread. If the coroutine is already in
+ * the game thread, it continues immediately.
+ */
+inline auto resumeInMainThread() noexcept {
+  struct Awaitable {
+    bool await_ready() const noexcept { return IsInGameThread(); }
+    void await_suspend(std::coroutine_handle<> handle) const {
+      TGraphTask<Detail::ResumeGraphTask>::CreateTask()
+          .ConstructAndDispatchWhenReady(handle, ENamedThreads::GameThread);
+    }
+    void await_resume() const noexcept {}
+  };
+  return Awaitable{};
+}
+
+/**
+ * Continues the coroutine in a worker thread once the render thread has run
+ * the render commands enqueued, from this thread, before this is awaited.
+ * After starting the creation of a texture resource, await this before
+ * using its RHI texture.
+ */
+inline auto resumeAfterRenderCommands() noexcept {
+  struct Awaitable {
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) const {
+      ENQUEUE_RENDER_COMMAND(Cesium_ResumeCoroutine)
+      ([handle](FRHICommandListImmediate&) {
+        Detail::resumeInWorkerThread(handle);
+      });
+    }
+    void await_resume() const noexcept {}
+  };
+  return Awaitable{};
+}
+
+/**
+ * Waits for a future and gives its value, or throws its exception. The
+ * coroutine continues in whichever thread settles the future, so await
+ * {@link resumeInWorkerThread} or {@link resumeInMainThread} afterward when
+ * that matters. Unlike the other awaitables, this allocates a continuation
+ * of the future.
+ */
+template <typename T> class FutureAwaitable {
+public:
+  explicit FutureAwaitable(CesiumAsync::Future<T>&& future)
+      : _future(std::move(future)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // The coroutine may finish, and destroy this awaitable, as soon as it is
+    // resumed, so neither continuation uses this after resuming it.
+    if constexpr (std::is_void_v<T>) {
+      std::move(*this->_future)
+          .thenImmediately([handle]() { handle.resume(); })
+          .catchImmediately([this, handle](std::exception&& e) {
+            this->_pException =
+                std::make_exception_ptr(std::runtime_error(e.what()));
+            handle.resume();
+          });
+    } else {
+      std::move(*this->_future)
+          .thenImmediately([this, handle](T&& value) {
+            this->_value.emplace(std::move(value));
+            handle.resume();
+          })
+          .catchImmediately([this, handle](std::exception&& e) {
+            this->_pException =
+                std::make_exception_ptr(std::runtime_error(e.what()));
+            handle.resume();
+          });
+    }
+  }
+
+  T await_resume() {
+    if (this->_pException) {
+      std::rethrow_exception(this->_pException);
+    }
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(*this->_value);
+    }
+  }
+
+private:
+  std::optional<CesiumAsync::Future<T>> _future;
+  std::conditional_t<std::is_void_v<T>, bool, std::optional<T>> _value{};
+  std::exception_ptr _pException;
+};
+
+/**
+ * Waits for a future. See {@link FutureAwaitable}.
+ */
+template <typename T>
+FutureAwaitable<T> awaitFuture(CesiumAsync::Future<T>&& future) {
+  return FutureAwaitable<T>(std::move(future));
+}
+
+/**
+ * Requests a URL and waits for the response. The coroutine continues in the
+ * thread that completes the request, which is the game thread or Unreal's
+ * HTTP thread, so await {@link resumeInWorkerThread} before doing any
+ * significant work with the response.
+ */
+inline FutureAwaitable<std::shared_ptr<CesiumAsync::IAssetRequest>>
+awaitResponse(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<CesiumAsync::IAssetAccessor::THeader>& headers = {}) {
+  return awaitFuture(pAssetAccessor->get(asyncSystem, url, headers));
+}
+
+namespace Detail {
+
+template <typename T>
+Detached settle(Task<T> task, CesiumAsync::Promise<T> promise) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await task;
+      promise.resolve();
+    } else {
+      promise.resolve(co_await task);
+    }
+  } catch (...) {
+    promise.reject(std::current_exception());
+  }
+}
+
+} // namespace Detail
+
+/**
+ * Starts a coroutine and returns a future that settles with its result.
+ */
+template <typename T>
+CesiumAsync::Future<T>
+toFuture(const CesiumAsync::AsyncSystem& asyncSystem, Task<T>&& task) {
+  CesiumAsync::Promise<T> promise = asyncSystem.createPromise<T>();
+  CesiumAsync::Future<T> future = promise.getFuture();
+  Detail::settle(std::move(task), std::move(promise));
+  return future;
+}
+
+} // namespace CesiumCoroutine
+
+#endif
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CesiumUtility/CreditSystem.h"
 #include "Components/WidgetComponent.h"
 #include "Engine/Blueprint.h"
 #include "GameFramework/Actor.h"
@@ -10,6 +11,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #if WITH_EDITOR
 #include "IAssetViewport.h"
@@ -18,10 +21,6 @@
 
 #include "CesiumCreditSystem.generated.h"
 
-namespace CesiumUtility {
-class CreditSystem;
-}
-
 /**
  * Manages credits / atttribution for Cesium data sources. These credits
  * are displayed by the corresponding Blueprints class
@@ -86,11 +85,35 @@ private:
   // the underlying cesium-native credit system that is managed by this actor.
   std::shared_ptr<CesiumUtility::CreditSystem> _pCreditSystem;
 
-  size_t _lastCreditsCount;
+  // The credits shown in the last update of the widget, in the order in which
+  // they're shown.
+  std::vector<CesiumUtility::Credit> _lastCredits;
+
+  /**
+   * Gets the RTF of a credit's HTML. If the HTML hasn't been parsed yet, it
+   * starts parsing it in a worker thread and returns its text without any
+   * markup, until the credits are next updated.
+   */
+  FString getCreditRtf(const std::string& html);
+
+  void parseHtmlInBackground(const std::string& html);
 
-  FString ConvertHtmlToRtf(std::string html);
+  // The RTF of each credit's HTML. The images it refers to belong to the
+  // current widget, so this is cleared when the widget is recreated.
   std::unordered_map<std::string, FString> _htmlToRtf;
 
+  // Each credit's HTML converted to RTF, except for its images, which are
+  // loaded by the widget. The even elements are RTF, and the odd elements,
+  // between them, are the URLs of the images.
+  std::unordered_map<std::string, std::vector<std::string>> _parsedHtml;
+
+  // The HTML being parsed in worker threads.
+  std::unordered_set<std::string> _htmlBeingParsed;
+
+  // Whether HTML has been parsed since the credits were last updated, so
+  // that its RTF replaces its text.
+  bool _parsedHtmlChanged = false;
+
 #if WITH_EDITOR
   TWeakPtr<IAssetViewport> _pLastEditorViewport;
 #endif
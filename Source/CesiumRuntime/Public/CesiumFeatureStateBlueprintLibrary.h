@@ -0,0 +1,103 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/ObjectMacros.h"
+#include "CesiumFeatureStateBlueprintLibrary.generated.h"
+
+class UPrimitiveComponent;
+struct FHitResult;
+
+/**
+ * Common state flags of features, such as those of a selection. Materials
+ * test the bits of the flags they sample from the state texture of a property
+ * table, so other bits may be given other meanings.
+ */
+UENUM(BlueprintType, Meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor))
+enum class ECesiumFeatureStateFlags : uint8 {
+  None = 0 UMETA(Hidden),
+  Hidden = 1 << 0,
+  Highlighted = 1 << 1,
+  Selected = 1 << 2
+};
+ENUM_CLASS_FLAGS(ECesiumFeatureStateFlags)
+
+/**
+ * Sets state flags of the features of glTF primitives, such as whether they
+ * are highlighted or hidden, without reloading tiles or setting a material
+ * parameter per feature.
+ *
+ * The flags of the features of a property table are passed to the materials
+ * of the glTF as a texture parameter named
+ * "PTABLE_<property table name>_CESIUM_STATE", which holds the flags of each
+ * feature in its red channel, divided by 255. Its texels are addressed by
+ * feature ID like those of the property table's encoded properties. Only the
+ * texels that change are copied to the texture, once per frame.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumFeatureStateBlueprintLibrary
+    : public UBlueprintFunctionLibrary {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Sets the state flags of a feature of a property table of the glTF that a
+   * primitive component belongs to.
+   *
+   * @param Component A glTF primitive component, such as the component of a
+   * line trace hit.
+   * @param PropertyTableIndex The index of the property table in the glTF's
+   * CesiumModelMetadata.
+   * @param FeatureID The ID of the feature in the property table.
+   * @param Flags The flags of the feature, such as a combination of
+   * ECesiumFeatureStateFlags.
+   * @return False if the component is not a glTF primitive component, or the
+   * property table or feature doesn't exist.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|State")
+  static bool SetFeatureState(
+      UPrimitiveComponent* Component,
+      int64 PropertyTableIndex,
+      int64 FeatureID,
+      UPARAM(
+          Meta =
+              (Bitmask,
+               BitmaskEnum = "/Script/CesiumRuntime.ECesiumFeatureStateFlags"))
+          int32 Flags);
+
+  /**
+   * Sets the state flags of the feature that a line trace hit, with the
+   * property table of the given feature ID set. The feature ID set index
+   * indexes into the CesiumFeatureIdSets of the component's
+   * CesiumPrimitiveFeatures.
+   *
+   * @return False if the hit feature or its property table can't be found.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|State")
+  static bool SetFeatureStateFromHit(
+      const FHitResult& Hit,
+      UPARAM(
+          Meta =
+              (Bitmask,
+               BitmaskEnum = "/Script/CesiumRuntime.ECesiumFeatureStateFlags"))
+          int32 Flags,
+      int64 FeatureIDSetIndex = 0);
+
+  /**
+   * Gets the state flags of a feature of a property table of the glTF that a
+   * primitive component belongs to. The flags are zero unless they were set.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Features|State")
+  static int32 GetFeatureState(
+      const UPrimitiveComponent* Component,
+      int64 PropertyTableIndex,
+      int64 FeatureID);
+
+  /**
+   * Clears the state flags of all features of the glTF that a primitive
+   * component belongs to.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Features|State")
+  static void ClearFeatureStates(UPrimitiveComponent* Component);
+};
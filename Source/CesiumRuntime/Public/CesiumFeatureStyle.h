@@ -0,0 +1,63 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/UnrealString.h"
+#include "CesiumFeatureStyle.generated.h"
+
+/**
+ * A condition of a FCesiumFeatureStyle, and the color of the features that
+ * meet it.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFeatureStyleCondition {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The expression that features must meet to have the color, such as
+   * `${height} > 100`.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString Condition;
+
+  /**
+   * The expression that gives the color of the features that meet the
+   * condition, such as `color('red')`, `color('#ff0000', 0.5)`, or
+   * `rgba(255, 0, 0, 0.5)`.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString Color;
+};
+
+/**
+ * A declarative style for the features of property tables, in the expression
+ * language of the 3D Tiles styling specification. Expressions refer to the
+ * properties of a feature as `${name}`.
+ *
+ * The style is evaluated for every feature of the property tables of the
+ * loaded tiles, and the result is passed to the materials as a texture
+ * parameter named "PTABLE_<table name>_CESIUM_STYLE", so that changing the
+ * style doesn't reload any tiles. Each texel is the sRGB color of a feature
+ * with its alpha, or zero alpha if the feature is hidden, and the texels are
+ * addressed by feature ID like those of the property table's properties.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumFeatureStyle {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The expression that determines whether a feature is shown, such as
+   * `${height} > 10`. All features are shown if this is empty.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString Show;
+
+  /**
+   * The conditions that determine the color of a feature. The color of the
+   * first condition that a feature meets is used, and features that meet none
+   * of them are white. Use a condition of `true` for the other features.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumFeatureStyleCondition> ColorConditions;
+};
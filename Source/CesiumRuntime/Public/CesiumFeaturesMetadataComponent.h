@@ -3,8 +3,10 @@
 #pragma once
 
 #include "CesiumFeatureIdSet.h"
+#include "CesiumFeatureStyle.h"
 #include "CesiumMetadataEncodingDetails.h"
 #include "CesiumMetadataPropertyDetails.h"
+#include "CesiumPropertyStatistics.h"
 #include "Components/ActorComponent.h"
 #include "Containers/Array.h"
 #include "Containers/UnrealString.h"
@@ -16,6 +18,8 @@
 
 #include "CesiumFeaturesMetadataComponent.generated.h"
 
+class UMaterialInterface;
+
 #pragma region Features descriptions
 
 /**
@@ -412,4 +416,114 @@ public:
       Category = "Cesium|Model Metadata",
       Meta = (TitleProperty = "Name"))
   TArray<FCesiumPropertyTextureDescription> PropertyTextures;
+
+  /**
+   * Whether to encode the properties of the property tables only while they
+   * are used, rather than encoding every property described here for every
+   * tile when it loads.
+   *
+   * A property is used when a material of the tileset has a parameter for it,
+   * unless the properties used from its property table have been set with
+   * SetUsedProperties, which selects them for visualizations that are
+   * switched at runtime. Properties that become used are encoded over the
+   * next frames for the tiles that are already loaded, and properties that
+   * are no longer used stay encoded for the tiles that have them.
+   */
+  UPROPERTY(EditAnywhere, Category = "Cesium|Model Metadata")
+  bool EncodePropertiesOnDemand = false;
+
+  /**
+   * Sets the properties of a property table that are used, such as those of
+   * the active visualization, when Encode Properties On Demand is enabled.
+   * This replaces the properties used from the property table, rather than
+   * those that its material has parameters for.
+   *
+   * @param PropertyTableName The name of the property table.
+   * @param PropertyNames The names of the used properties.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Model Metadata")
+  void SetUsedProperties(
+      const FString& PropertyTableName,
+      const TArray<FString>& PropertyNames);
+
+  /**
+   * Uses the properties of every property table that the tileset's materials
+   * have parameters for again, rather than those set with SetUsedProperties.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Model Metadata")
+  void ClearUsedProperties();
+
+  /**
+   * Gets the property tables with the properties to encode for tiles that are
+   * rendered with the given materials. These are all of the described
+   * property tables, unless Encode Properties On Demand is enabled.
+   */
+  TArray<FCesiumPropertyTableDescription> GetPropertyTablesToEncode(
+      const TArray<const UMaterialInterface*>& Materials) const;
+
+  /**
+   * Gets a number that changes whenever the used properties are set or
+   * cleared, so that callers know when to get the property tables to encode
+   * again.
+   */
+  int32 GetUsedPropertiesVersion() const {
+    return this->_usedPropertiesVersion;
+  }
+
+  /**
+   * Gets the statistics of the values of a scalar property of a property
+   * table across the loaded tiles of the tileset, such as for the legend or
+   * range of a visualization. The statistics of each tile are computed when
+   * its property is encoded, so the property must be described here, and
+   * this only combines them.
+   *
+   * @param PropertyTableName The name of the property table.
+   * @param PropertyName The name of the property.
+   * @param Statistics The statistics of the property.
+   * @param HistogramBucketCount The number of buckets of the histogram.
+   * @return Whether any loaded tile has values of the property.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Model Metadata")
+  bool GetPropertyStatistics(
+      const FString& PropertyTableName,
+      const FString& PropertyName,
+      FCesiumPropertyStatistics& Statistics,
+      int32 HistogramBucketCount = 16) const;
+
+  /**
+   * The style of the features of the property tables. The style is evaluated
+   * for the loaded tiles without reloading them, and materials show it by
+   * sampling the style texture of a property table, as described for
+   * FCesiumFeatureStyle. The properties that the style refers to don't need to
+   * be described here.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadOnly,
+      BlueprintSetter = SetStyle,
+      Category = "Cesium|Styling")
+  FCesiumFeatureStyle Style;
+
+  /**
+   * Sets the style of the features, which is applied to the loaded tiles over
+   * the next frames.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Styling")
+  void SetStyle(const FCesiumFeatureStyle& NewStyle);
+
+  /**
+   * Gets a number that changes whenever the style is set, so that callers
+   * know when to evaluate it again.
+   */
+  int32 GetStyleVersion() const { return this->_styleVersion; }
+
+#if WITH_EDITOR
+  virtual void
+  PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+  TMap<FString, TArray<FString>> _usedProperties;
+  int32 _usedPropertiesVersion = 0;
+  int32 _styleVersion = 0;
 };
@@ -6,6 +6,7 @@
 #include "CesiumGlobeAnchoredActorComponent.h"
 #include "CesiumFlyToComponent.generated.h"
 
+class ACesiumCameraManager;
 class UCurveFloat;
 class UCesiumGlobeAnchorComponent;
 
@@ -122,6 +123,28 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   ECesiumFlyToRotation RotationToUse = ECesiumFlyToRotation::Actor;
 
+  /**
+   * Whether to start loading the tiles for the view at the destination when
+   * a flight starts, so that they are already loaded when the flight arrives.
+   * The view is added to the default Cesium Camera Manager, with the field of
+   * view and viewport size of the player controlling the Actor, if any, and
+   * removed when the flight ends.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool PrefetchDestination = true;
+
+  /**
+   * The number of views, evenly spaced along the path of a flight, whose
+   * tiles also start loading when the flight starts, if Prefetch Destination
+   * is enabled. Each view is removed once the flight has passed it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (EditCondition = "PrefetchDestination", ClampMin = 0))
+  int32 PrefetchPathSamples = 0;
+
   /**
    * A delegate that will be called when the Actor finishes flying.
    *
@@ -198,13 +221,32 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   void InterruptFlight();
 
+  /**
+   * Gets where the Actor will be, in Unreal coordinates, after the given
+   * number of seconds of the flight that is currently in progress. Past the
+   * end of the flight, this is the destination.
+   *
+   * @returns false if no flight is in progress, in which case the location is
+   * not changed.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  bool PredictLocationUnreal(float Seconds, FVector& Location);
+
 protected:
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
   virtual void TickComponent(
       float DeltaTime,
       ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
 
 private:
+  float computeFlyPercentage(float flyTime) const;
+  glm::dvec3 computePositionEcef(float flyPercentage) const;
+
+  void addPrefetchCameras();
+  void removePrefetchCameras(float upToFlyPercentage);
+
   FQuat GetCurrentRotationEastSouthUp();
   void SetCurrentRotationEastSouthUp(const FQuat& EastSouthUpRotation);
 
@@ -218,4 +260,13 @@ private:
   FVector _previousPositionEcef;
   TUniquePtr<CesiumGeospatial::SimplePlanarEllipsoidCurve> _currentCurve;
   double _length;
+
+  // The views registered to prefetch the tiles along the flight, and how far
+  // along the flight each of them is.
+  struct PrefetchCamera {
+    float flyPercentage;
+    int32 cameraId;
+  };
+  TArray<PrefetchCamera> _prefetchCameras;
+  TWeakObjectPtr<ACesiumCameraManager> _pPrefetchCameraManager;
 };
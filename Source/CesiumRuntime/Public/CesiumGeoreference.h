@@ -512,6 +512,91 @@ public:
   FVector TransformUnrealPositionToEarthCenteredEarthFixed(
       const FVector& UnrealPosition) const;
 
+  /**
+   * Transforms many longitude-latitude-height positions into Unreal
+   * coordinates, like TransformLongitudeLatitudeHeightPositionToUnreal does for
+   * each of them. This is much faster than calling that function for each
+   * position, especially from Blueprints.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void TransformLongitudeLatitudeHeightPositionsToUnreal(
+      const TArray<FVector>& LongitudeLatitudeHeights,
+      TArray<FVector>& UnrealPositions) const;
+
+  /**
+   * Transforms many positions like the function above, into the given
+   * storage, which must have room for them all. Large spans are transformed
+   * in parallel. The input and output may be the same span, to transform the
+   * positions in place.
+   */
+  void TransformLongitudeLatitudeHeightPositionsToUnreal(
+      TArrayView<const FVector> LongitudeLatitudeHeights,
+      TArrayView<FVector> UnrealPositions) const;
+
+  /**
+   * Transforms many positions in Unreal coordinates into
+   * longitude-latitude-height, like
+   * TransformUnrealPositionToLongitudeLatitudeHeight does for each of them.
+   * This is much faster than calling that function for each position,
+   * especially from Blueprints.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void TransformUnrealPositionsToLongitudeLatitudeHeight(
+      const TArray<FVector>& UnrealPositions,
+      TArray<FVector>& LongitudeLatitudeHeights) const;
+
+  /**
+   * Transforms many positions like the function above, into the given
+   * storage, which must have room for them all. Large spans are transformed
+   * in parallel. The input and output may be the same span, to transform the
+   * positions in place.
+   */
+  void TransformUnrealPositionsToLongitudeLatitudeHeight(
+      TArrayView<const FVector> UnrealPositions,
+      TArrayView<FVector> LongitudeLatitudeHeights) const;
+
+  /**
+   * Transforms many Earth-Centered, Earth-Fixed positions into Unreal
+   * coordinates, like TransformEarthCenteredEarthFixedPositionToUnreal does for
+   * each of them. This is much faster than calling that function for each
+   * position, especially from Blueprints.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void TransformEarthCenteredEarthFixedPositionsToUnreal(
+      const TArray<FVector>& EarthCenteredEarthFixedPositions,
+      TArray<FVector>& UnrealPositions) const;
+
+  /**
+   * Transforms many positions like the function above, into the given
+   * storage, which must have room for them all. Large spans are transformed
+   * in parallel. The input and output may be the same span, to transform the
+   * positions in place.
+   */
+  void TransformEarthCenteredEarthFixedPositionsToUnreal(
+      TArrayView<const FVector> EarthCenteredEarthFixedPositions,
+      TArrayView<FVector> UnrealPositions) const;
+
+  /**
+   * Transforms many positions in Unreal coordinates into Earth-Centered, Earth-
+   * Fixed, like TransformUnrealPositionToEarthCenteredEarthFixed does for each
+   * of them. This is much faster than calling that function for each position,
+   * especially from Blueprints.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void TransformUnrealPositionsToEarthCenteredEarthFixed(
+      const TArray<FVector>& UnrealPositions,
+      TArray<FVector>& EarthCenteredEarthFixedPositions) const;
+
+  /**
+   * Transforms many positions like the function above, into the given
+   * storage, which must have room for them all. Large spans are transformed
+   * in parallel. The input and output may be the same span, to transform the
+   * positions in place.
+   */
+  void TransformUnrealPositionsToEarthCenteredEarthFixed(
+      TArrayView<const FVector> UnrealPositions,
+      TArrayView<FVector> EarthCenteredEarthFixedPositions) const;
+
   /**
    * Transforms a direction vector in Earth-Centered, Earth-Fixed (ECEF)
    * coordinates into Unreal coordinates. The resulting direction vector should
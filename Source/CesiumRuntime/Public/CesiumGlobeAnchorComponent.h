@@ -3,11 +3,15 @@
 #pragma once
 
 #include "CesiumGeospatial/GlobeAnchor.h"
+#include "CesiumReplicatedGlobeTransform.h"
 #include "Components/ActorComponent.h"
 #include "Delegates/IDelegateInstance.h"
+#include "GeoTransforms.h"
+#include <optional>
 #include "CesiumGlobeAnchorComponent.generated.h"
 
 class ACesiumGeoreference;
+class UCesiumGlobeAnchorSubsystem;
 
 /**
  * This component can be added to a movable actor to anchor it to the globe
@@ -16,6 +20,12 @@ class ACesiumGeoreference;
  * automatically updated. The actor position can also be set in terms of
  * Earth-Centered, Earth-Fixed coordinates (ECEF) or Longitude, Latitude, and
  * Height relative to the ellipsoid.
+ *
+ * When this component replicates, the server sends the Actor's ECEF transform
+ * to the clients that simulate the Actor, quantized as a
+ * FCesiumReplicatedGlobeTransform, and the clients place the Actor relative to
+ * their own georeference. This is much smaller than the Actor's replicated
+ * movement, which can then be disabled.
  */
 UCLASS(ClassGroup = Cesium, Meta = (BlueprintSpawnableComponent))
 class CESIUMRUNTIME_API UCesiumGlobeAnchorComponent : public UActorComponent {
@@ -106,6 +116,63 @@ private:
       Meta = (AllowPrivateAccess))
   bool TeleportWhenUpdatingTransform = true;
 
+  /**
+   * Whether to compute the longitude, latitude, and height of the Actor with a
+   * local approximation when it is near the origin of the georeference.
+   *
+   * The exact conversion from Earth-Centered, Earth-Fixed coordinates is
+   * iterative. Within `LocalGeodeticApproximationRadius` of the georeference
+   * origin, the approximation is several times cheaper and, within 20
+   * kilometers, accurate to a fraction of a millimeter, which helps when many
+   * Actors' positions are queried every frame. Farther away, the exact
+   * conversion is used.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      BlueprintGetter = GetUseLocalGeodeticApproximation,
+      BlueprintSetter = SetUseLocalGeodeticApproximation,
+      Category = "Cesium",
+      Meta = (AllowPrivateAccess))
+  bool UseLocalGeodeticApproximation = false;
+
+  /**
+   * The distance from the georeference origin, in meters, within which the
+   * local approximation is used if `UseLocalGeodeticApproximation` is
+   * enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      BlueprintGetter = GetLocalGeodeticApproximationRadius,
+      BlueprintSetter = SetLocalGeodeticApproximationRadius,
+      Category = "Cesium",
+      Meta =
+          (AllowPrivateAccess,
+           ClampMin = 0.0,
+           EditCondition = "UseLocalGeodeticApproximation"))
+  double LocalGeodeticApproximationRadius = 5000.0;
+
+  /**
+   * Whether changes to the Actor's transform are queued and processed with
+   * those of the other globe anchors in a single batch per frame, instead of
+   * immediately.
+   *
+   * This is much faster when many anchored Actors move every frame. The globe
+   * transform of an Actor with a queued change is still updated immediately
+   * when it's read or set, so this only affects when the work is done, and
+   * when the Actor is rotated for globe curvature if
+   * `AdjustOrientationForGlobeWhenMoving` is enabled.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      BlueprintGetter = GetBatchTransformChanges,
+      BlueprintSetter = SetBatchTransformChanges,
+      Category = "Cesium",
+      Meta = (AllowPrivateAccess))
+  bool BatchTransformChanges = false;
+
   /**
    * The 4x4 transformation matrix from the Actors's local coordinate system to
    * the Earth-Centered, Earth-Fixed (ECEF) coordinate system.
@@ -275,6 +342,52 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium")
   void SetAdjustOrientationForGlobeWhenMoving(bool Value);
 
+  /**
+   * Gets whether to compute the longitude, latitude, and height of the Actor
+   * with a local approximation when it is near the origin of the
+   * georeference.
+   */
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  bool GetUseLocalGeodeticApproximation() const;
+
+  /**
+   * Sets whether to compute the longitude, latitude, and height of the Actor
+   * with a local approximation when it is near the origin of the
+   * georeference.
+   */
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetUseLocalGeodeticApproximation(bool Value);
+
+  /**
+   * Gets the distance from the georeference origin, in meters, within which
+   * the local approximation is used if `UseLocalGeodeticApproximation` is
+   * enabled.
+   */
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  double GetLocalGeodeticApproximationRadius() const;
+
+  /**
+   * Sets the distance from the georeference origin, in meters, within which
+   * the local approximation is used if `UseLocalGeodeticApproximation` is
+   * enabled.
+   */
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetLocalGeodeticApproximationRadius(double Value);
+
+  /**
+   * Gets whether changes to the Actor's transform are queued and processed
+   * with those of the other globe anchors in a single batch per frame.
+   */
+  UFUNCTION(BlueprintGetter, Category = "Cesium")
+  bool GetBatchTransformChanges() const;
+
+  /**
+   * Sets whether changes to the Actor's transform are queued and processed
+   * with those of the other globe anchors in a single batch per frame.
+   */
+  UFUNCTION(BlueprintSetter, Category = "Cesium")
+  void SetBatchTransformChanges(bool Value);
+
 #pragma endregion
 
 #pragma region Public Methods
@@ -523,6 +636,10 @@ protected:
    * changes to properties.
    */
   virtual void OnUnregister() override;
+
+public:
+  virtual void GetLifetimeReplicatedProps(
+      TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 #pragma endregion
 
 #pragma region Implementation Details
@@ -547,6 +664,41 @@ private:
 
   void _setNewActorToECEFFromRelativeTransform();
 
+  /**
+   * Updates the replicated transform from the ECEF transform, if this
+   * component replicates and has authority.
+   */
+  void _updateReplicatedTransform();
+
+  /**
+   * Places the Actor at the transform replicated from the server. The server
+   * already adjusted the orientation for the globe, so it isn't adjusted
+   * again.
+   */
+  UFUNCTION()
+  void _onReplicatedTransformChanged();
+
+  /**
+   * Registers this component with the globe anchor subsystem of its world so
+   * that changes to its transform are batched, or unregisters it after
+   * processing its queued change.
+   */
+  void _updateBatchRegistration(bool batchTransformChanges);
+
+  /**
+   * Processes the queued change to the Actor's transform, if there is one.
+   */
+  void _processPendingTransformChange() const;
+
+  /**
+   * Applies the result of processing a queued change to the Actor's
+   * transform in a batch.
+   */
+  void _updateFromBatchedTransformChange(
+      const glm::dmat4& anchorToFixed,
+      const glm::dmat4& anchorToLocal,
+      bool updateRelativeTransform);
+
 #if WITH_EDITORONLY_DATA
   // This is used only to preserve the transformation saved by old versions of
   // Cesium for Unreal. See the Serialize method.
@@ -563,6 +715,13 @@ private:
   UPROPERTY()
   bool _actorToECEFIsValid = false;
 
+  /**
+   * The ECEF transform of the Actor, as it is replicated to the clients that
+   * simulate it.
+   */
+  UPROPERTY(Transient, ReplicatedUsing = _onReplicatedTransformChanged)
+  FCesiumReplicatedGlobeTransform _replicatedTransform;
+
   /**
    * Whether an update of the actor transform is currently in progress,
    * and further calls that are received by _onActorTransformChanged
@@ -573,6 +732,26 @@ private:
   bool _lastRelativeTransformIsValid = false;
   FTransform _lastRelativeTransform{};
 
+  /**
+   * The transforms of the resolved georeference used for the local geodetic
+   * approximation. They're created when first needed and discarded when the
+   * georeference changes.
+   */
+  mutable std::optional<GeoTransforms> _geodeticApproximation;
+
+  /**
+   * The globe anchor subsystem this component is registered with to batch
+   * changes to its transform, and its slot there.
+   */
+  TWeakObjectPtr<UCesiumGlobeAnchorSubsystem> _pBatchSubsystem;
+  int32 _batchSlot = INDEX_NONE;
+
+  /**
+   * Whether a change to the Actor's transform is queued in the globe anchor
+   * subsystem and hasn't been processed yet.
+   */
+  bool _transformChangePending = false;
+
   /**
    * Called when the root transform of the Actor to which this Component is
    * attached has changed. So:
@@ -596,5 +775,6 @@ private:
   void _onGeoreferenceChanged();
 
   friend class FCesiumGlobeAnchorCustomization;
+  friend class UCesiumGlobeAnchorSubsystem;
 #pragma endregion
 };
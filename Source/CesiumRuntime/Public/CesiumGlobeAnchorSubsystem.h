@@ -0,0 +1,85 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakObjectPtr.h"
+#include <glm/mat4x4.hpp>
+#include "CesiumGlobeAnchorSubsystem.generated.h"
+
+class UCesiumGlobeAnchorComponent;
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+class LocalHorizontalCoordinateSystem;
+} // namespace CesiumGeospatial
+
+/**
+ * Updates the globe transforms of the globe anchors in a world whose Actors
+ * have moved, in a single batch per frame, instead of one anchor at a time as
+ * each Actor moves. Only the anchors with Batch Transform Changes enabled are
+ * updated this way.
+ *
+ * The anchors are registered into arrays of slots. A change to the transform
+ * of an anchor's Actor only marks its slot dirty. Once per frame, after the
+ * Actors have ticked, the relative transforms and globe transforms of all of
+ * the dirty anchors are gathered into flat arrays, the new globe transforms
+ * are computed from them in parallel, and the results are written back to the
+ * anchors. An anchor with a pending change is also updated immediately when
+ * its globe transform is read or set, so reading it never gives a stale
+ * result.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumGlobeAnchorSubsystem
+    : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * @brief Adds a globe anchor to those updated in batches, and returns its
+   * slot.
+   */
+  int32 registerAnchor(UCesiumGlobeAnchorComponent& anchor);
+
+  /**
+   * @brief Removes the globe anchor in the given slot from those updated in
+   * batches. Its pending change, if any, is discarded.
+   */
+  void unregisterAnchor(int32 slot);
+
+  /**
+   * @brief Marks the globe anchor in the given slot as having a change to its
+   * Actor's transform, to be processed in the next batch.
+   */
+  void markDirty(int32 slot);
+
+  /**
+   * Updates the globe transforms of all of the anchors whose Actors have
+   * moved since the last batch. This happens automatically once per frame,
+   * but it can be called to process the changes earlier.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void ProcessTransformChanges();
+
+  virtual void Deinitialize() override;
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickableInEditor() const override { return true; }
+
+private:
+  // The registered anchors and whether each has a pending change, by slot.
+  TArray<TWeakObjectPtr<UCesiumGlobeAnchorComponent>> _anchors;
+  TBitArray<> _dirty;
+  TArray<int32> _freeSlots;
+
+  // The inputs and outputs of the anchors in the current batch, by their
+  // index in the batch.
+  TArray<UCesiumGlobeAnchorComponent*> _batchAnchors;
+  TArray<const CesiumGeospatial::LocalHorizontalCoordinateSystem*>
+      _batchCoordinateSystems;
+  TArray<const CesiumGeospatial::Ellipsoid*> _batchEllipsoids;
+  TArray<uint8> _batchFlags;
+  TArray<glm::dmat4> _batchModelToLocal;
+  TArray<glm::dmat4> _batchAnchorToFixed;
+};
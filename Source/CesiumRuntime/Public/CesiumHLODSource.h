@@ -0,0 +1,48 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "CesiumHLODSource.generated.h"
+
+class ACesium3DTileset;
+class UCesiumHLODSourceComponent;
+
+/**
+ * A box in which the tiles of a tileset take part in the World Partition
+ * HLODs of the level.
+ *
+ * When the HLODs are built, the Cesium HLOD Builder loads the tiles inside
+ * the box down to the Maximum Screen Space Error of its settings, and merges
+ * them into a simplified proxy mesh with baked textures. The HLOD layer of
+ * this actor must be a custom layer whose builder is the Cesium HLOD
+ * Builder. Boxes about the size of a cell of the HLOD grid make one proxy per
+ * cell, so that far away regions are drawn by a few HLOD actors, and the
+ * tileset's HLOD Distance keeps it from loading tiles there.
+ *
+ * The box has nothing to draw or collide with in game.
+ */
+UCLASS(ClassGroup = (Cesium))
+class CESIUMRUNTIME_API ACesiumHLODSource : public AActor {
+  GENERATED_BODY()
+
+public:
+  ACesiumHLODSource();
+
+  /**
+   * The tileset whose tiles are captured.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TSoftObjectPtr<ACesium3DTileset> Tileset;
+
+  /**
+   * The box inside which the tiles are captured.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  UCesiumHLODSourceComponent* Box;
+
+#if WITH_EDITOR
+  virtual bool IsHLODRelevant() const override;
+#endif
+};
@@ -0,0 +1,25 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/BoxComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumHLODSourceComponent.generated.h"
+
+/**
+ * The box of a {@link ACesiumHLODSource}, inside which the tiles of its
+ * tileset are captured into World Partition HLODs. The box is never drawn or
+ * collided with in game, but it is relevant to HLODs, so that the Cesium HLOD
+ * Builder is given it for the cell that it is in.
+ */
+UCLASS(ClassGroup = (Cesium))
+class CESIUMRUNTIME_API UCesiumHLODSourceComponent : public UBoxComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumHLODSourceComponent();
+
+#if WITH_EDITOR
+  virtual bool IsHLODRelevant() const override;
+#endif
+};
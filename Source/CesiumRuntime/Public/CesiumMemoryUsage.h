@@ -0,0 +1,54 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumMemoryUsage.generated.h"
+
+/**
+ * The memory taken by the tiles that a tileset or raster overlay currently
+ * has loaded, in bytes. These are running totals, updated as tiles are loaded
+ * and unloaded, so they are cheap to read every frame, for example to raise
+ * the Maximum Screen Space Error when the totals approach a device's budget.
+ *
+ * The sizes are those of the data uploaded to the GPU and handed to the
+ * physics engine, plus an estimate of the bounding volume hierarchies that
+ * the physics engine builds over collision meshes. Padding and alignment
+ * added by the RHI are not included.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumMemoryUsage {
+  GENERATED_BODY()
+
+  /**
+   * The size of the textures, including their mips. A texture shared by
+   * several tiles is counted once.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TextureBytes = 0;
+
+  /**
+   * The size of the vertex buffers of the tiles' meshes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 VertexBytes = 0;
+
+  /**
+   * The size of the index buffers of the tiles' meshes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 IndexBytes = 0;
+
+  /**
+   * The size of the vertices, triangles, and bounding volume hierarchies of
+   * the tiles' collision meshes.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 CollisionBytes = 0;
+
+  /**
+   * The size of the dynamic material instances of the tiles' primitives.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MaterialBytes = 0;
+};
@@ -104,6 +104,42 @@ public:
       const FHitResult& Hit,
       int64 PrimitivePropertyTextureIndex = 0);
 
+  /**
+   * Gets the bounds of the faces of a feature of a glTF primitive component,
+   * such as to zoom to a building. This requires Create Feature Indices on
+   * the tileset, and only includes the faces of this primitive, not those of
+   * other primitives or tiles with the same feature.
+   *
+   * @param Component The glTF primitive component.
+   * @param FeatureID The ID of the feature.
+   * @param Bounds Receives the bounds, in Unreal world coordinates.
+   * @param FeatureIDSetIndex The index of the feature ID set in the
+   * CesiumFeatureIdSets of the component's CesiumPrimitiveFeatures.
+   * @return False if the component has no feature index or no faces of the
+   * feature.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Metadata|Picking")
+  static bool GetFeatureBounds(
+      const UPrimitiveComponent* Component,
+      int64 FeatureID,
+      FBox& Bounds,
+      int64 FeatureIDSetIndex = 0);
+
+  /**
+   * Gets the indices of the faces of a feature of a glTF primitive component,
+   * in order, as given to GetFeatureIDFromFace. This requires Create Feature
+   * Indices on the tileset. The result is empty if the component has no
+   * feature index or no faces of the feature.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|Picking")
+  static TArray<int64> GetFacesOfFeature(
+      const UPrimitiveComponent* Component,
+      int64 FeatureID,
+      int64 FeatureIDSetIndex = 0);
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Gets the metadata values for a face on a glTF primitive component.
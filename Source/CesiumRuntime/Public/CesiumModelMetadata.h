@@ -32,8 +32,27 @@ public:
       const CesiumGltf::Model& InModel,
       const CesiumGltf::ExtensionModelExtStructuralMetadata& Metadata);
 
+  /**
+   * Points this metadata at the model it was created from, after that model
+   * has been moved. Only needed while the property tables have not been
+   * created yet.
+   */
+  void setModel(const CesiumGltf::Model& InModel);
+
 private:
-  TArray<FCesiumPropertyTable> _propertyTables;
+  /**
+   * Creates the property tables from the model, if they have not been created
+   * yet. Most tiles never have their property tables accessed, so they are
+   * only created the first time they are needed.
+   */
+  void createPropertyTables() const;
+
+  /**
+   * The model whose property tables have not been created yet, or nullptr if
+   * they have been.
+   */
+  mutable const CesiumGltf::Model* _pModel = nullptr;
+  mutable TArray<FCesiumPropertyTable> _propertyTables;
   TArray<FCesiumPropertyTexture> _propertyTextures;
   // TODO: property attributes
 
@@ -0,0 +1,189 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include <memory>
+#include "CesiumNativeTileExcluder.generated.h"
+
+class ACesiumCartographicPolygon;
+class CesiumTileExclusionPredicate;
+
+/**
+ * A region on the globe, between two heights above the ellipsoid.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTileExclusionRegion {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The westernmost longitude of the region, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -180.0, ClampMax = 180.0))
+  double West = -180.0;
+
+  /**
+   * The southernmost latitude of the region, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -90.0, ClampMax = 90.0))
+  double South = -90.0;
+
+  /**
+   * The easternmost longitude of the region, in degrees. If it is less than
+   * West, the region crosses the antimeridian.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -180.0, ClampMax = 180.0))
+  double East = 180.0;
+
+  /**
+   * The northernmost latitude of the region, in degrees.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -90.0, ClampMax = 90.0))
+  double North = 90.0;
+
+  /**
+   * The lowest height of the region above the ellipsoid, in meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MinimumHeight = -100000.0;
+
+  /**
+   * The highest height of the region above the ellipsoid, in meters.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double MaximumHeight = 100000.0;
+};
+
+/**
+ * A range that the values of a property of a tile's content must overlap for
+ * the tile to be kept.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTileMetadataCondition {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The name of the property table, or of its class if it has no name.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString PropertyTableName;
+
+  /**
+   * The name of the scalar property.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString PropertyName;
+
+  /**
+   * The lowest value that the features of kept tiles may have.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double Minimum = 0.0;
+
+  /**
+   * The highest value that the features of kept tiles may have.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  double Maximum = 0.0;
+};
+
+/**
+ * An actor component that excludes the tiles of its Cesium 3D Tileset by
+ * regions, polygons, and metadata. Unlike UCesiumTileExcluder, it doesn't
+ * call into Blueprints or other Unreal objects while tiles are selected, so
+ * it is much cheaper for tilesets with many tiles.
+ *
+ * The exclusion is created from the properties of this component when it is
+ * added to the tileset, so call Refresh after changing them or moving the
+ * polygons at runtime.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumNativeTileExcluder : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumNativeTileExcluder();
+
+  /**
+   * The regions to exclude tiles in. A tile is excluded when its bounds are
+   * entirely inside one of them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumTileExclusionRegion> Regions;
+
+  /**
+   * The polygons to exclude tiles in. A tile is excluded when its bounds are
+   * entirely inside one of them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<ACesiumCartographicPolygon*> Polygons;
+
+  /**
+   * Whether to exclude the tiles that are entirely outside all of the regions
+   * and polygons, instead of those inside any of them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool InvertSelection = false;
+
+  /**
+   * The conditions on the metadata of tile content. Once a tile's content is
+   * loaded, the tile is excluded if one of its property tables declares the
+   * range of a property's values, with the `min` and `max` of
+   * EXT_structural_metadata, and the range doesn't overlap that of a
+   * condition.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<FCesiumTileMetadataCondition> MetadataConditions;
+
+  /**
+   * Adds this excluder to its owning Cesium 3D Tileset Actor. If the excluder
+   * is already added or if this component's Owner is not a Cesium 3D Tileset,
+   * this method does nothing.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void AddToTileset();
+
+  /**
+   * Removes this excluder from its owning Cesium 3D Tileset Actor. If the
+   * excluder is not yet added or if this component's Owner is not a Cesium 3D
+   * Tileset, this method does nothing.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void RemoveFromTileset();
+
+  /**
+   * Refreshes this excluder by removing it from its owning Cesium 3D Tileset
+   * Actor and re-adding it, so that changes to its properties take effect.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void Refresh();
+
+  virtual void Activate(bool bReset) override;
+  virtual void Deactivate() override;
+  virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+#if WITH_EDITOR
+  virtual void
+  PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+  std::shared_ptr<CesiumTileExclusionPredicate> _pPredicate;
+};
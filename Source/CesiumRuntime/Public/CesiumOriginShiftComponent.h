@@ -97,6 +97,23 @@ private:
       Category = "Cesium",
       Meta = (AllowPrivateAccess))
   double Distance = 0.0;
+
+  /**
+   * The distance, in meters, beyond a sub-level's Load Radius within which the
+   * sub-level is loaded in the background before the Actor enters it. The
+   * nearest such sub-level is kept loaded but hidden, so that entering it only
+   * has to show it, and the sub-level the Actor just left is kept the same
+   * way while it stays that close. When the value of this property is 0.0,
+   * sub-levels are only loaded once the Actor enters them.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      BlueprintGetter = GetSubLevelPreloadDistance,
+      BlueprintSetter = SetSubLevelPreloadDistance,
+      Category = "Cesium",
+      Meta = (AllowPrivateAccess, ClampMin = 0.0, Units = "Meters"))
+  double SubLevelPreloadDistance = 0.0;
 #pragma endregion
 
 #pragma region Property Accessors
@@ -138,6 +155,22 @@ public:
    */
   UFUNCTION(BlueprintSetter)
   void SetDistance(double NewDistance);
+
+  /**
+   * Gets the distance, in meters, beyond a sub-level's Load Radius within
+   * which the sub-level is loaded in the background before the Actor enters
+   * it.
+   */
+  UFUNCTION(BlueprintGetter)
+  double GetSubLevelPreloadDistance() const;
+
+  /**
+   * Sets the distance, in meters, beyond a sub-level's Load Radius within
+   * which the sub-level is loaded in the background before the Actor enters
+   * it.
+   */
+  UFUNCTION(BlueprintSetter)
+  void SetSubLevelPreloadDistance(double NewDistance);
 #pragma endregion
 
 public:
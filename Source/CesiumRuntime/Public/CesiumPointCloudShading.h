@@ -59,12 +59,70 @@ struct CESIUMRUNTIME_API FCesiumPointCloudShading {
       meta = (ClampMin = 0.0))
   float BaseResolution = 0.0f;
 
+  /**
+   * The smallest average distance between the points of a tile on screen, in
+   * pixels. When a tile is far enough away that its points would be closer
+   * together than this, only an even subset of them is drawn, which reduces
+   * the number of points to render for dense point clouds. If this is zero,
+   * all points are always drawn.
+   *
+   * The distance between the points of a tile is its Base Resolution, or is
+   * estimated from its size and number of points.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  float MinimumPointSpacing = 0.0f;
+
+  /**
+   * Whether or not to shade point clouds with eye-dome lighting, which darkens
+   * points that are behind their neighbors on screen. It only uses the depth
+   * of the scene, and makes the shape of point clouds readable even when their
+   * points are sparse.
+   *
+   * Point clouds are drawn into custom depth while this is enabled, so that
+   * the shading can be limited to them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool EyeDomeLighting = false;
+
+  /**
+   * How strongly eye-dome lighting darkens points that are behind their
+   * neighbors.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0, EditCondition = "EyeDomeLighting"))
+  float EyeDomeLightingStrength = 1.0f;
+
+  /**
+   * The distance in pixels at which eye-dome lighting compares the depth of a
+   * point with the depth of its neighbors. Larger values result in thicker
+   * outlines.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0, EditCondition = "EyeDomeLighting"))
+  float EyeDomeLightingRadius = 1.0f;
+
   bool
   operator==(const FCesiumPointCloudShading& OtherPointCloudShading) const {
     return Attenuation == OtherPointCloudShading.Attenuation &&
            GeometricErrorScale == OtherPointCloudShading.GeometricErrorScale &&
            MaximumAttenuation == OtherPointCloudShading.MaximumAttenuation &&
-           BaseResolution == OtherPointCloudShading.BaseResolution;
+           BaseResolution == OtherPointCloudShading.BaseResolution &&
+           MinimumPointSpacing == OtherPointCloudShading.MinimumPointSpacing &&
+           EyeDomeLighting == OtherPointCloudShading.EyeDomeLighting &&
+           EyeDomeLightingStrength ==
+               OtherPointCloudShading.EyeDomeLightingStrength &&
+           EyeDomeLightingRadius ==
+               OtherPointCloudShading.EyeDomeLightingRadius;
   }
 
   bool
@@ -0,0 +1,121 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include <memory>
+#include "CesiumPolygonClippingComponent.generated.h"
+
+class ACesiumCartographicPolygon;
+class CesiumTileExclusionPredicate;
+class UCesiumMaterialUserData;
+class UMaterialInstanceDynamic;
+class UTexture2D;
+
+/**
+ * An actor component that clips the tiles of its Cesium 3D Tileset by
+ * polygons in the material, per pixel, without rasterizing them into a raster
+ * overlay. The edges of all of the polygons are uploaded to a single texture
+ * once, which all tiles share, so it is much cheaper than a
+ * UCesiumPolygonRasterOverlay for many polygons.
+ *
+ * The material must clip with the CesiumPolygonClippingMask function of
+ * "/Plugin/CesiumForUnreal/Private/CesiumPolygonClipping.ush", from a Custom
+ * expression in a material layer named "PolygonClipping" or in the base
+ * material itself, using the following parameters:
+ *
+ *  - PolygonClippingEdges: The texture of the polygons' edges.
+ *  - PolygonClippingTexelCount: The number of texels used in the texture.
+ *  - PolygonClippingOrigin: The world position of the plane of the polygons.
+ *  - PolygonClippingAxisX, PolygonClippingAxisY: The world directions of the
+ *    plane's axes, which are east and south at the origin.
+ *  - PolygonClippingInvert: Whether the selection is inverted.
+ *
+ * The polygons are projected onto the plane tangent to the ellipsoid at their
+ * center, so they should each cover a small fraction of the globe, like the
+ * outline of a building or a construction site. Call Refresh after moving, or
+ * changing, the polygons at runtime, or after the origin of the world changes.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumPolygonClippingComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumPolygonClippingComponent();
+
+  /**
+   * The polygons to clip the tileset with.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  TArray<ACesiumCartographicPolygon*> Polygons;
+
+  /**
+   * Whether to clip the areas outside of all the polygons, instead of the
+   * areas inside them.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool InvertSelection = false;
+
+  /**
+   * Whether tiles that are entirely clipped should be excluded from loading
+   * and rendering. These are the tiles that are completely inside a polygon,
+   * or completely outside all of them if InvertSelection is true.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool ExcludeSelectedTiles = true;
+
+  /**
+   * Uploads the polygons again and sets them on the materials of the loaded
+   * tiles, so that changes to them take effect.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void Refresh();
+
+  /**
+   * Adds the clipping to the owning Cesium 3D Tileset Actor. If it is already
+   * added or if this component's Owner is not a Cesium 3D Tileset, this
+   * method does nothing.
+   */
+  void AddToTileset();
+
+  /**
+   * Removes the clipping from the owning Cesium 3D Tileset Actor, and stops
+   * clipping its loaded tiles.
+   */
+  void RemoveFromTileset();
+
+  /**
+   * Sets the clipping parameters on the material of a tile. This is done for
+   * the tiles that are loaded when the clipping is added, and by each tile
+   * that is loaded later.
+   */
+  void SetMaterialParameterValues(
+      UMaterialInstanceDynamic* pMaterial,
+      const UCesiumMaterialUserData* pCesiumData) const;
+
+  virtual void Activate(bool bReset) override;
+  virtual void Deactivate() override;
+  virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
+
+#if WITH_EDITOR
+  virtual void
+  PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+  /**
+   * Sets the clipping parameters on the materials of the loaded tiles.
+   */
+  void UpdateLoadedTiles() const;
+
+  UPROPERTY(Transient)
+  UTexture2D* EdgeTexture = nullptr;
+
+  int32 _texelCount = 0;
+  FVector _origin = FVector::ZeroVector;
+  FVector _axisX = FVector::XAxisVector;
+  FVector _axisY = FVector::YAxisVector;
+  std::shared_ptr<CesiumTileExclusionPredicate> _pExcluder;
+};
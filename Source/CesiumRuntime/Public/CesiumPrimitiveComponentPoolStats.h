@@ -0,0 +1,51 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumPrimitiveComponentPoolStats.generated.h"
+
+/**
+ * Counters describing how a tileset's pool of recycled primitive components
+ * is being used. These are cumulative over the lifetime of the tileset actor,
+ * except for PooledComponents. Components that are reused instead of created
+ * and destroyed reduce the load on the garbage collector.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumPrimitiveComponentPoolStats {
+  GENERATED_BODY()
+
+  /**
+   * The number of components currently waiting in the pool to be reused.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 PooledComponents = 0;
+
+  /**
+   * The number of components that were newly created because the pool had
+   * none available.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ComponentsCreated = 0;
+
+  /**
+   * The number of components that were taken from the pool instead of being
+   * created.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ComponentsReused = 0;
+
+  /**
+   * The number of components that were returned to the pool when their tile
+   * was unloaded.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ComponentsReleased = 0;
+
+  /**
+   * The number of components that were destroyed and left to the garbage
+   * collector, because the pool was full or has been cleared.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 ComponentsDestroyed = 0;
+};
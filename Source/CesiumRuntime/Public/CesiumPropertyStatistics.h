@@ -0,0 +1,49 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "CesiumPropertyStatistics.generated.h"
+
+/**
+ * Statistics of the values of a scalar property of a property table across
+ * the loaded tiles of a tileset, such as for the legend of a visualization
+ * that colors features by the property. The values are those after any
+ * offset and scale, and don't include "no data" values.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumPropertyStatistics {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The number of values.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  int64 Count = 0;
+
+  /**
+   * The smallest value.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double Minimum = 0.0;
+
+  /**
+   * The largest value.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double Maximum = 0.0;
+
+  /**
+   * The mean of the values.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  double Mean = 0.0;
+
+  /**
+   * The approximate number of values in each of a number of buckets of equal
+   * width between the minimum and the maximum. The counts are approximate
+   * because each tile's values are first counted in buckets of its own range.
+   */
+  UPROPERTY(BlueprintReadOnly, Category = "Cesium")
+  TArray<int64> Histogram;
+};
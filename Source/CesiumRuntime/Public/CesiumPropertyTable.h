@@ -72,6 +72,99 @@ private:
   friend class UCesiumPropertyTableBlueprintLibrary;
 };
 
+/**
+ * The values of one property of a property table for several features, as
+ * returned by GetMetadataValuesForFeatures.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumPropertyTableValues {
+  GENERATED_BODY()
+
+  /**
+   * The name of the property.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FString PropertyName;
+
+  /**
+   * The type of the property's values. This is the same for all of the values.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FCesiumMetadataValueType ValueType;
+
+  /**
+   * The values of the property, one for each of the requested features.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  TArray<FCesiumMetadataValue> Values;
+};
+
+/**
+ * Reusable storage for the values of properties of a property table for
+ * several features, as written by CopyMetadataValuesForFeatures. This is for
+ * C++ code that queries metadata often, such as while the cursor hovers over a
+ * tileset: reusing the same buffer for every query doesn't allocate once it is
+ * large enough, unlike GetMetadataValuesForFeatures.
+ *
+ * The values refer to the property table's glTF rather than copying strings
+ * and arrays, so they are only valid while the tile that has the property
+ * table is loaded, like those returned by the other functions of
+ * UCesiumPropertyTableBlueprintLibrary.
+ */
+class CESIUMRUNTIME_API FCesiumPropertyTableValuesBuffer {
+public:
+  /**
+   * Gets the number of properties that have values in the buffer.
+   */
+  int32 GetPropertyCount() const { return this->_valueTypes.Num(); }
+
+  /**
+   * Gets the number of features that have values in the buffer.
+   */
+  int32 GetFeatureCount() const { return this->_featureCount; }
+
+  /**
+   * Gets the type of the values of a property, by its index in the property
+   * names that were queried.
+   */
+  const FCesiumMetadataValueType& GetValueType(int32 PropertyIndex) const {
+    return this->_valueTypes[PropertyIndex];
+  }
+
+  /**
+   * Gets the values of a property, by its index in the property names that
+   * were queried, with one value for each queried feature ID.
+   */
+  TArrayView<const FCesiumMetadataValue> GetValues(int32 PropertyIndex) const {
+    return TArrayView<const FCesiumMetadataValue>(
+        this->_values.GetData() + PropertyIndex * this->_featureCount,
+        this->_featureCount);
+  }
+
+  /**
+   * Removes the values while keeping the allocated storage.
+   */
+  void Reset() {
+    this->_values.Reset();
+    this->_valueTypes.Reset();
+    this->_featureCount = 0;
+  }
+
+private:
+  TArrayView<FCesiumMetadataValue> GetValuesMutable(int32 PropertyIndex) {
+    return TArrayView<FCesiumMetadataValue>(
+        this->_values.GetData() + PropertyIndex * this->_featureCount,
+        this->_featureCount);
+  }
+
+  // The values of all properties, grouped by property.
+  TArray<FCesiumMetadataValue> _values;
+  TArray<FCesiumMetadataValueType> _valueTypes;
+  int32 _featureCount = 0;
+
+  friend class UCesiumPropertyTableBlueprintLibrary;
+};
+
 UCLASS()
 class CESIUMRUNTIME_API UCesiumPropertyTableBlueprintLibrary
     : public UBlueprintFunctionLibrary {
@@ -161,6 +254,47 @@ public:
       UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
       int64 FeatureID);
 
+  /**
+   * Gets the values of the given properties for many features at once, with
+   * the values of each property in one array. This is much faster than calling
+   * GetMetadataValuesForFeature for each feature, because it doesn't build a
+   * map for each feature, and the type of each property is only looked up
+   * once.
+   *
+   * There is one result for each property name, in the same order, and each
+   * result has one value for each feature ID, in the same order. A feature ID
+   * that is out-of-bounds, or a property that doesn't exist or isn't valid,
+   * gets empty values.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param PropertyNames The names of the properties to get the values of.
+   * @return The values of each property for the features.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTable")
+  static TArray<FCesiumPropertyTableValues> GetMetadataValuesForFeatures(
+      UPARAM(ref) const FCesiumPropertyTable& PropertyTable,
+      const TArray<int64>& FeatureIDs,
+      const TArray<FString>& PropertyNames);
+
+  /**
+   * Like {@link GetMetadataValuesForFeatures}, but writes the values into the
+   * given buffer, replacing its previous values. Reusing the buffer avoids
+   * allocating for each query.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @param PropertyNames The names of the properties to get the values of.
+   * @param Values The buffer that receives the values of each property for
+   * the features, in the same order as the property names.
+   */
+  static void CopyMetadataValuesForFeatures(
+      const FCesiumPropertyTable& PropertyTable,
+      TArrayView<const int64> FeatureIDs,
+      TArrayView<const FString> PropertyNames,
+      FCesiumPropertyTableValuesBuffer& Values);
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Gets all of the property values for a given feature as strings, mapped by
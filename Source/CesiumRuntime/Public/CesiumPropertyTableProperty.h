@@ -7,6 +7,7 @@
 #include "CesiumMetadataValue.h"
 #include "CesiumMetadataValueType.h"
 #include "CesiumPropertyArray.h"
+#include "Containers/ArrayView.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "UObject/ObjectMacros.h"
 #include <any>
@@ -517,6 +518,111 @@ public:
       int64 FeatureID,
       double DefaultValue = 0.0);
 
+  /**
+   * Gets the values of a range of features as Integers, converted as
+   * described for GetInteger. This is much faster than calling GetInteger for
+   * each feature, because the type of the property is only looked up once.
+   * When the property's values don't need to be converted, they are copied
+   * straight from its buffer, with its normalization, scale, and offset
+   * applied to the whole range at once.
+   *
+   * Features outside the property get the default value.
+   *
+   * @param FirstFeatureID The ID of the first feature.
+   * @param Count The number of features to get the values of.
+   * @param DefaultValue The default value to fall back on.
+   * @return The property values of the features, in order of feature ID.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static TArray<int32> GetIntegerValues(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      int64 Count,
+      int32 DefaultValue = 0);
+
+  /**
+   * Like {@link GetIntegerValues}, but writes the values into the given
+   * storage, one for each element, instead of allocating an array.
+   */
+  static void CopyIntegerValues(
+      const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      TArrayView<int32> Values,
+      int32 DefaultValue = 0);
+
+  /**
+   * Gets the values of a range of features as Floats, converted as
+   * described for GetFloat. This is much faster than calling GetFloat for
+   * each feature, because the type of the property is only looked up once.
+   * When the property's values don't need to be converted, they are copied
+   * straight from its buffer, with its normalization, scale, and offset
+   * applied to the whole range at once.
+   *
+   * Features outside the property get the default value.
+   *
+   * @param FirstFeatureID The ID of the first feature.
+   * @param Count The number of features to get the values of.
+   * @param DefaultValue The default value to fall back on.
+   * @return The property values of the features, in order of feature ID.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static TArray<float> GetFloatValues(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      int64 Count,
+      float DefaultValue = 0.0f);
+
+  /**
+   * Like {@link GetFloatValues}, but writes the values into the given
+   * storage, one for each element, instead of allocating an array.
+   */
+  static void CopyFloatValues(
+      const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      TArrayView<float> Values,
+      float DefaultValue = 0.0f);
+
+  /**
+   * Gets the values of a range of features as Float64s, converted as
+   * described for GetFloat64. This is much faster than calling GetFloat64 for
+   * each feature, because the type of the property is only looked up once.
+   * When the property's values don't need to be converted, they are copied
+   * straight from its buffer, with its normalization, scale, and offset
+   * applied to the whole range at once.
+   *
+   * Features outside the property get the default value.
+   *
+   * @param FirstFeatureID The ID of the first feature.
+   * @param Count The number of features to get the values of.
+   * @param DefaultValue The default value to fall back on.
+   * @return The property values of the features, in order of feature ID.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static TArray<double> GetFloat64Values(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      int64 Count,
+      double DefaultValue = 0.0);
+
+  /**
+   * Like {@link GetFloat64Values}, but writes the values into the given
+   * storage, one for each element, instead of allocating an array.
+   */
+  static void CopyFloat64Values(
+      const FCesiumPropertyTableProperty& Property,
+      int64 FirstFeatureID,
+      TArrayView<double> Values,
+      double DefaultValue = 0.0);
+
   /**
    * Attempts to retrieve the value for the given feature as a FIntPoint.
    *
@@ -945,6 +1051,34 @@ public:
       UPARAM(ref) const FCesiumPropertyTableProperty& Property,
       int64 FeatureID);
 
+  /**
+   * Retrieves the values of the property for the given features, as
+   * described for {@link GetValue}. This is much faster than calling GetValue
+   * for each feature, because the type of the property is only looked up
+   * once.
+   *
+   * Features outside the property get empty values.
+   *
+   * @param FeatureIDs The IDs of the features.
+   * @return The property values, in the same order as the feature IDs.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTableProperty")
+  static TArray<FCesiumMetadataValue> GetValuesForFeatures(
+      UPARAM(ref) const FCesiumPropertyTableProperty& Property,
+      const TArray<int64>& FeatureIDs);
+
+  /**
+   * Like {@link GetValuesForFeatures}, but writes the values into the given
+   * storage, one for each feature ID, instead of allocating an array.
+   */
+  static void CopyValuesForFeatures(
+      const FCesiumPropertyTableProperty& Property,
+      TArrayView<const int64> FeatureIDs,
+      TArrayView<FCesiumMetadataValue> Values);
+
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
    * Retrieves the value of the property for the given feature. This allows the
@@ -370,6 +370,66 @@ public:
       const FVector2D& UV,
       double DefaultValue = 0.0);
 
+  /**
+   * Samples the property at many texture coordinates as integers, converted
+   * as described for GetInteger. This is much faster than calling GetInteger
+   * for each coordinate, because the type of the property is only looked up
+   * once and the coordinates are sampled in parallel on worker threads.
+   *
+   * @param UVs The texture coordinates.
+   * @param DefaultValue The default value to fall back on.
+   * @return The property values, in the same order as the coordinates.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTextureProperty")
+  static TArray<int32> GetIntegerValues(
+      UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+      const TArray<FVector2D>& UVs,
+      int32 DefaultValue = 0);
+
+  /**
+   * Like {@link GetIntegerValues}, but writes the values into the given
+   * storage, one for each texture coordinate, instead of allocating an array.
+   */
+  static void CopyIntegerValues(
+      const FCesiumPropertyTextureProperty& Property,
+      TArrayView<const FVector2D> UVs,
+      TArrayView<int32> Values,
+      int32 DefaultValue = 0);
+
+  /**
+   * Samples the property at many texture coordinates as Float64s, converted
+   * as described for GetFloat64. This is much faster than calling GetFloat64
+   * for each coordinate, because the type of the property is only looked up
+   * once and the coordinates are sampled in parallel on worker threads. When
+   * the property's values don't need to be converted, its normalization,
+   * scale, and offset are applied to many values at once.
+   *
+   * @param UVs The texture coordinates.
+   * @param DefaultValue The default value to fall back on.
+   * @return The property values, in the same order as the coordinates.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      BlueprintPure,
+      Category = "Cesium|Metadata|PropertyTextureProperty")
+  static TArray<double> GetFloat64Values(
+      UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+      const TArray<FVector2D>& UVs,
+      double DefaultValue = 0.0);
+
+  /**
+   * Like {@link GetFloat64Values}, but writes the values into the given
+   * storage, one for each texture coordinate, instead of allocating an array.
+   */
+  static void CopyFloat64Values(
+      const FCesiumPropertyTextureProperty& Property,
+      TArrayView<const FVector2D> UVs,
+      TArrayView<double> Values,
+      double DefaultValue = 0.0);
+
   /**
    * Attempts to retrieve the value at the given texture coordinates as a
    * FIntPoint.
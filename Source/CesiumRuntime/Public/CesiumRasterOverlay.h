@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CesiumMemoryUsage.h"
 #include "CesiumRasterOverlayLoadFailureDetails.h"
 #include "CesiumRasterOverlays/RasterOverlay.h"
 #include "Components/ActorComponent.h"
@@ -42,6 +43,77 @@ struct FRasterOverlayRendererOptions {
 
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   bool useMipmaps = true;
+
+  /**
+   * Whether to generate this overlay's mipmaps on the GPU rather than on a
+   * worker thread, when Use Mipmaps is enabled. Only the full-resolution
+   * image is then kept in memory and uploaded. This has no effect when
+   * Compress Textures is enabled, because compressed mipmaps must be made
+   * from uncompressed ones on the CPU.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool generateMipmapsOnGpu = false;
+
+  /**
+   * Whether to block-compress this overlay's textures when they are loaded,
+   * so that they take between a quarter and an eighth of the GPU memory. The
+   * textures are compressed to BC1 or BC3 where the platform supports them,
+   * or to ETC2 otherwise.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool compressTextures = false;
+
+  /**
+   * If zero or greater, this overlay's per-tile translation and scale and its
+   * texture coordinate index are written to the Custom Primitive Data of each
+   * tile primitive instead of to material parameters. The translation and
+   * scale occupy four consecutive floats starting at this index, and the
+   * texture coordinate index is in the fifth. Only the overlay texture is
+   * still set as a material parameter.
+   *
+   * This makes attaching and detaching overlay tiles cheaper, but it requires
+   * a material that reads these values from Custom Primitive Data. The
+   * materials included with Cesium for Unreal do not.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = -1, ClampMax = 31))
+  int32 customPrimitiveDataIndex = -1;
+
+  /**
+   * If greater than zero, and Custom Primitive Data Index is zero or greater,
+   * this overlay's tiles are resized to Texture Array Slice Size and copied
+   * into the slices of a single `Texture2DArray` with this many slices. The
+   * array is set as the `<key>_TextureArray` material parameter, or the
+   * `TextureArray` parameter of matching material layers, and the slice of
+   * each primitive's overlay tile is written to the sixth Custom Primitive
+   * Data float after Custom Primitive Data Index. Attaching and detaching
+   * overlay tiles then changes no material parameters at all.
+   *
+   * When all slices are in use, further tiles get their own texture as usual
+   * and a slice index of -1. This requires a material that samples the
+   * array, which the materials included with Cesium for Unreal do not. The
+   * overlay's textures are then not compressed.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0, ClampMax = 2048))
+  int32 textureArraySize = 0;
+
+  /**
+   * The width and height of each slice of the texture array, when Texture
+   * Array Size is greater than zero. This is rounded up to a power of two.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 16, ClampMax = 2048))
+  int32 textureArraySliceSize = 256;
 };
 
 /**
@@ -125,6 +197,16 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   void SetSubTileCacheBytes(int64 Value);
 
+  /**
+   * Gets the memory taken by the overlay tiles that are currently loaded. Only
+   * the TextureBytes are used. A texture shared by identical overlay tiles is
+   * counted once, and the whole texture array is counted if the overlay's
+   * tiles are packed into one. This is zero when the overlay isn't added to
+   * a tileset.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  FCesiumMemoryUsage GetMemoryUsage() const;
+
   virtual void Activate(bool bReset) override;
   virtual void Deactivate() override;
   virtual void OnComponentDestroyed(bool bDestroyingHierarchy) override;
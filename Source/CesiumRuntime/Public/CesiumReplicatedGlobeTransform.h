@@ -0,0 +1,73 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumReplicatedGlobeTransform.generated.h"
+
+class UPackageMap;
+
+/**
+ * The transform of a globe-anchored Actor relative to the Earth-Centered,
+ * Earth-Fixed (ECEF) coordinate system, as it is replicated to clients.
+ *
+ * The position is quantized to a centimeter and sent as three 32-bit integers,
+ * which covers everything within about 21,000 kilometers of the center of the
+ * Earth. Positions further away are sent in full double precision. The
+ * rotation is sent as the three smallest components of its quaternion, in 16
+ * bits each, and the scale is only sent when it isn't one. This is about 19
+ * bytes per transform, rather than the 128 bytes of the full matrix.
+ *
+ * The values held by this struct are the quantized ones, so that the server
+ * only replicates the transform when a client would see the difference.
+ */
+USTRUCT()
+struct CESIUMRUNTIME_API FCesiumReplicatedGlobeTransform {
+  GENERATED_BODY()
+
+  /**
+   * The position of the Actor in ECEF coordinates, in meters.
+   */
+  UPROPERTY()
+  FVector Position = FVector::ZeroVector;
+
+  /**
+   * The rotation of the Actor relative to the ECEF axes.
+   */
+  UPROPERTY()
+  FQuat Rotation = FQuat::Identity;
+
+  /**
+   * The scale of the Actor.
+   */
+  UPROPERTY()
+  FVector Scale = FVector::OneVector;
+
+  /**
+   * Quantizes the translation, rotation, and scale of a transform from an
+   * Actor's local coordinate system to ECEF.
+   */
+  static FCesiumReplicatedGlobeTransform
+  FromMatrix(const FMatrix& ActorToEarthCenteredEarthFixed);
+
+  /**
+   * Gets the transform from the Actor's local coordinate system to ECEF.
+   */
+  FMatrix ToMatrix() const;
+
+  bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+  bool operator==(const FCesiumReplicatedGlobeTransform& Other) const;
+  bool operator!=(const FCesiumReplicatedGlobeTransform& Other) const {
+    return !(*this == Other);
+  }
+};
+
+template <>
+struct TStructOpsTypeTraits<FCesiumReplicatedGlobeTransform>
+    : public TStructOpsTypeTraitsBase2<FCesiumReplicatedGlobeTransform> {
+  enum {
+    WithNetSerializer = true,
+    WithIdenticalViaEquality = true,
+  };
+};
@@ -8,6 +8,7 @@
 
 class ACesium3DTileset;
 class UCesiumRasterOverlay;
+class UnrealTaskProcessor;
 
 namespace CesiumAsync {
 class AsyncSystem;
@@ -22,6 +23,17 @@ public:
   /** IModuleInterface implementation */
   virtual void StartupModule() override;
   virtual void ShutdownModule() override;
+
+private:
+  /**
+   * Updates the state that is shared by all tilesets, in all worlds: the
+   * textures shared between tiles, the resident mips of textures, and the
+   * stats that are not specific to a tileset. Called at the end of each
+   * frame.
+   */
+  void OnEndFrame();
+
+  FDelegateHandle _onEndFrameHandle;
 };
 
 /**
@@ -46,9 +58,17 @@ DECLARE_MULTICAST_DELEGATE_OneParam(
 CESIUMRUNTIME_API extern FCesiumRasterOverlayIonTroubleshooting
     OnCesiumRasterOverlayIonTroubleshooting;
 
+CESIUMRUNTIME_API const std::shared_ptr<UnrealTaskProcessor>&
+getTaskProcessor() noexcept;
 CESIUMRUNTIME_API CesiumAsync::AsyncSystem& getAsyncSystem() noexcept;
 CESIUMRUNTIME_API const std::shared_ptr<CesiumAsync::IAssetAccessor>&
 getAssetAccessor();
 
 CESIUMRUNTIME_API std::shared_ptr<CesiumAsync::ICacheDatabase>&
 getCacheDatabase();
+
+/**
+ * Writes the responses waiting to be stored in the on-disk request cache, and
+ * prunes it to its size budget, before returning.
+ */
+CESIUMRUNTIME_API void flushCacheDatabase();
@@ -6,6 +6,38 @@
 #include "Engine/DeveloperSettings.h"
 #include "CesiumRuntimeSettings.generated.h"
 
+/**
+ * Whether the responses to the plugin's network requests are recorded for
+ * benchmarks, or replayed from an earlier recording.
+ */
+UENUM()
+enum class ECesiumRequestArchiveMode : uint8 {
+  /** Requests are sent to the network as usual. */
+  Disabled,
+
+  /** Responses from the network are also written to the archive. */
+  Record,
+
+  /** Requests are answered from the archive, without using the network. */
+  Replay
+};
+
+/**
+ * Whether the tile selection of each frame of the tilesets is recorded, or
+ * replayed from an earlier recording.
+ */
+UENUM()
+enum class ECesiumSelectionTraceMode : uint8 {
+  /** Tilesets select tiles for their views as usual. */
+  Disabled,
+
+  /** The views and results of each view update are written to a trace. */
+  Record,
+
+  /** Tilesets select tiles for the views of their trace instead. */
+  Replay
+};
+
 /**
  * Stores runtime settings for the Cesium plugin.
  */
@@ -38,13 +70,332 @@ public:
   bool ScaleLevelOfDetailByDPI = true;
 
   /**
-   * Uses Unreal's occlusion culling engine to drive Cesium 3D Tiles selection,
-   * reducing the detail of tiles that are occluded by other objects in the
-   * scene so that less data overall needs to be loaded and rendered.
+   * Tests the bounding volumes of tiles against the depth of the previous
+   * frame on the GPU to drive Cesium 3D Tiles selection, reducing the detail
+   * of tiles that are occluded by other objects in the scene so that less data
+   * overall needs to be loaded and rendered.
    */
   UPROPERTY(Config, EditAnywhere, Category = "Experimental Feature Flags")
   bool EnableExperimentalOcclusionCullingFeature = false;
 
+  /**
+   * The maximum time, in milliseconds, that the game thread may spend each
+   * frame finalizing newly-loaded tiles (creating their Unreal components,
+   * meshes, and materials). The budget is shared by all tilesets in a world.
+   * Tiles that do not fit within it are finalized in later frames, most
+   * important tiles first. At least one tile per tileset is finalized each
+   * frame regardless of the budget. The time spent preparing raster overlay
+   * tiles also counts against it. A value of zero removes the limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0.0, Units = "Milliseconds"))
+  float MainThreadTileFinalizationBudget = 5.0f;
+
+  /**
+   * The maximum time, in milliseconds, that the game thread may spend each
+   * frame destroying the meshes, textures, materials, and components of
+   * unloaded tiles. Objects that do not fit within the budget are destroyed in
+   * later frames, those holding the most memory first. At least one object is
+   * destroyed each frame regardless of the budget. A value of zero removes the
+   * limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0.0, Units = "Milliseconds"))
+  float MainThreadDestructionBudget = 2.0f;
+
+  /**
+   * The maximum number of unused primitive components that each tileset keeps
+   * for reuse by newly-loaded tiles. Reusing components instead of creating
+   * new ones reduces garbage collection work when many tiles are loaded and
+   * unloaded. A value of zero disables reuse.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0))
+  int32 MaximumPooledComponentsPerTileset = 1000;
+
+  /**
+   * The maximum number of HTTP requests for tiles and other assets that may
+   * be in flight to a single host at once. Further requests to that host wait
+   * in a queue, and those made most recently are sent first, so tiles that
+   * just became visible are not stuck behind downloads that are no longer
+   * needed. This limit applies across all tilesets and raster overlays, unlike
+   * each tileset's Maximum Simultaneous Tile Loads, so a limit below the sum
+   * of those of the tilesets loading from one host slows them down. A value of
+   * zero, the default, removes the limit and sends every request right away.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0, ConfigRestartRequired = true))
+  int32 MaximumSimultaneousRequestsPerHost = 0;
+
+  /**
+   * The number of tile loads that may be in progress at once, shared by all
+   * of the tilesets in a world. Each frame, the loads are divided between
+   * the tilesets in proportion to their Load Priority and the number of their
+   * tiles that are waiting to be loaded, and no tileset is given more than its
+   * own Maximum Simultaneous Tile Loads. A value of zero lets each tileset use
+   * its own Maximum Simultaneous Tile Loads instead.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0))
+  int32 SharedMaximumSimultaneousTileLoads = 0;
+
+  /**
+   * Whether the number of tile loads that may be in progress at once is
+   * adjusted to the capacity of the network, rather than fixed. The number is
+   * raised by one while responses keep arriving quickly and throughput keeps
+   * up, and cut by 30% when their latency grows to twice the lowest observed
+   * or servers report that they are overloaded. The loads are shared between
+   * the tilesets in a world as with Shared Maximum Simultaneous Tile Loads,
+   * which this replaces, and are kept between the Minimum and Maximum
+   * Adaptive Tile Loads.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool AdaptiveSimultaneousTileLoads = false;
+
+  /**
+   * The fewest tile loads that Adaptive Simultaneous Tile Loads allows to be
+   * in progress at once.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 1, EditCondition = "AdaptiveSimultaneousTileLoads"))
+  int32 MinimumAdaptiveTileLoads = 4;
+
+  /**
+   * The most tile loads that Adaptive Simultaneous Tile Loads allows to be in
+   * progress at once.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 1, EditCondition = "AdaptiveSimultaneousTileLoads"))
+  int32 MaximumAdaptiveTileLoads = 100;
+
+  /**
+   * The maximum size, in megabytes, of the tiles cached by all of the tilesets
+   * in a world together. Each frame, the budget is divided between the
+   * tilesets in proportion to their Load Priority and the number of tiles
+   * they rendered, and no tileset is given more than its own Maximum Cached
+   * Bytes. Like Maximum Cached Bytes, this never causes tiles that are needed
+   * for rendering to be unloaded. A value of zero lets each tileset use its own
+   * Maximum Cached Bytes instead.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0, Units = "Megabytes"))
+  int32 SharedMaximumCachedMB = 0;
+
+  /**
+   * Completes HTTP requests for tiles and other assets on Unreal's HTTP thread
+   * instead of on the game thread. Normally a finished download is only
+   * handed to Cesium when the HTTP manager is ticked, once per frame, so a
+   * slow or hitching game thread also slows down downloads. With this
+   * enabled, download throughput is independent of the frame rate, which
+   * helps when rendering movies offline. It has no effect on platforms where
+   * Unreal's HTTP module does not use a thread.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ConfigRestartRequired = true))
+  bool CompleteRequestsOnHttpThread = false;
+
+  /**
+   * The size, in megabytes, of the segments in which tile content such as
+   * GLB and B3DM files is downloaded, with HTTP range requests. Content
+   * larger than this is downloaded over several connections at once, in up
+   * to nine segments, and put together into a single buffer, which helps
+   * with very large tiles. Servers that don't support range requests send
+   * the whole content in answer to the first. A value of zero downloads tile
+   * content in a single request.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta =
+          (ClampMin = 0, Units = "Megabytes", ConfigRestartRequired = true))
+  int32 RangeRequestSegmentMB = 0;
+
+  /**
+   * The maximum total size, in megabytes, of the mips of Cesium's textures
+   * that are kept on the GPU. When this is not zero, the most detailed mips of
+   * a texture are released while its tiles are too small on screen to need
+   * them, and restored when they get closer. When the textures still don't
+   * fit, more mips are released, from textures of tiles that aren't rendered
+   * first. This requires that textures keep a copy of their pixels in main
+   * memory, and only applies to textures that have mipmaps and are loaded
+   * after it is set. A value of zero keeps all mips of all textures resident.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 0, Units = "Megabytes"))
+  int32 TextureMemoryBudgetMB = 0;
+
+  /**
+   * The maximum total size, in megabytes, of the GPU brick pool that the
+   * voxels of voxel tilesets are raymarched from. The bricks of the tiles
+   * that were drawn least recently are evicted to make room for new ones, and
+   * tiles whose bricks don't fit in a frame aren't drawn in it.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 1, Units = "Megabytes"))
+  int32 VoxelBrickPoolSizeMB = 512;
+
+  /**
+   * Whether newly-loaded tiles first render with a less detailed mip of each
+   * of their textures, so that they appear sooner. The more detailed mips are
+   * then uploaded over the following frames, a few textures at a time, those
+   * largest on screen first. This only applies to textures that have mipmaps
+   * and are larger than the Progressive Texture Initial Size, which keep a
+   * copy of their pixels in main memory until all of their mips are resident.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool ProgressiveTextureLoading = false;
+
+  /**
+   * The largest width or height, in pixels, of the mip that textures are
+   * first created with when Progressive Texture Loading is enabled.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta =
+          (ClampMin = 1,
+           Units = "Pixels",
+           EditCondition = "ProgressiveTextureLoading"))
+  int32 ProgressiveTextureInitialSize = 256;
+
+  /**
+   * Whether to run Cesium's background work, like parsing tiles and creating
+   * their meshes, on threads of its own rather than on Unreal's background
+   * task threads. The dedicated threads start the work for the tiles selected
+   * for rendering first, and each prefers the newest work it started itself,
+   * taking work from the other threads only when it runs out.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ConfigRestartRequired = true))
+  bool UseDedicatedTaskThreads = false;
+
+  /**
+   * The number of threads dedicated to Cesium's background work when Use
+   * Dedicated Task Threads is enabled. A value of zero uses two fewer than
+   * the number of logical cores, leaving those to the game and rendering
+   * threads.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta =
+          (ClampMin = 0,
+           ConfigRestartRequired = true,
+           EditCondition = "UseDedicatedTaskThreads"))
+  int32 DedicatedTaskThreadCount = 0;
+
+  /**
+   * Whether the streaming work of the tilesets is scaled down while the
+   * device is hot, in low power mode, or low on battery, so that mobile and
+   * XR sessions stay smooth for their whole length rather than being
+   * throttled by the operating system. As the device gets hotter or its
+   * battery drains, fewer tile loads and dedicated task threads are allowed,
+   * the Maximum Screen Space Error of the tilesets is raised, and the physics
+   * meshes of newly-loaded tiles are built only once the device recovers.
+   * This builds on the Shared Maximum Simultaneous Tile Loads, the Adaptive
+   * Simultaneous Tile Loads, and any Cesium Adaptive Lod Component. It has no
+   * effect on platforms that report neither their thermal state nor their
+   * battery level.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Performance")
+  bool EnableStreamingGovernor = false;
+
+  /**
+   * The battery level, in percent, below which the Streaming Governor scales
+   * down the streaming work while the device runs on battery. The work is
+   * scaled down the most when the battery is empty.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta =
+          (ClampMin = 0,
+           ClampMax = 100,
+           Units = "Percent",
+           EditCondition = "EnableStreamingGovernor"))
+  int32 StreamingGovernorBatteryThreshold = 30;
+
+  /**
+   * The fraction of the simultaneous tile loads and dedicated task threads
+   * that the Streaming Governor still allows when the device is at its
+   * critical temperature or its battery is empty.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 1.0,
+           EditCondition = "EnableStreamingGovernor"))
+  float StreamingGovernorMinimumLoadFraction = 0.25f;
+
+  /**
+   * The factor by which the Streaming Governor multiplies the Maximum Screen
+   * Space Error of the tilesets when the device is at its critical
+   * temperature or its battery is empty.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (ClampMin = 1.0, EditCondition = "EnableStreamingGovernor"))
+  float StreamingGovernorMaximumScreenSpaceErrorScale = 4.0f;
+
+  /**
+   * Whether the Streaming Governor defers the physics meshes of the tiles that
+   * are loaded while the device is under more than half of its pressure. The
+   * physics meshes of those tiles are built once the pressure has dropped
+   * below a quarter. Disable this if the tiles must always collide as soon as
+   * they are rendered.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Performance",
+      meta = (EditCondition = "EnableStreamingGovernor"))
+  bool StreamingGovernorDefersPhysicsMeshes = true;
+
   /**
    * The number of requests to handle before each prune of old cached results
    * from the database.
@@ -66,4 +417,186 @@ public:
       Category = "Cache",
       meta = (ConfigRestartRequired = true))
   int MaxCacheItems = 4096;
+
+  /**
+   * The maximum total size, in megabytes, of the responses in the on-disk
+   * cache. When the cache grows beyond this, the entries with the largest
+   * product of size and time since last use are removed first, in a
+   * low-priority background task. A value of zero leaves only the limit of
+   * Max Cache Items.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 0, Units = "Megabytes", ConfigRestartRequired = true))
+  int32 MaxCacheSizeMB = 1024;
+
+  /**
+   * The number of connections to the on-disk cache through which requests
+   * are looked up, so that worker threads can look up several at once. New
+   * responses are always written in the background through one further
+   * connection.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 1, ClampMax = 16, ConfigRestartRequired = true))
+  int32 CacheReadConnections = 4;
+
+  /**
+   * Whether to store gzip-compressed responses in the on-disk cache after
+   * inflating them, rather than as they were downloaded. This uses more disk
+   * space, but responses found in the cache don't have to be inflated again
+   * each time they are loaded.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true))
+  bool CacheDecompressedResponses = false;
+
+  /**
+   * The maximum total size, in megabytes, of the responses kept in memory in
+   * front of the on-disk cache. Revisiting an area is then answered from
+   * memory, without reading and decompressing the responses again. A value
+   * of zero disables the in-memory cache.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ClampMin = 0, Units = "Megabytes", ConfigRestartRequired = true))
+  int32 MemoryCacheSizeMB = 256;
+
+  /**
+   * Whether to store the results of the expensive steps of converting tiles
+   * for Unreal in the on-disk cache next to the responses: cooked physics
+   * meshes, block-compressed textures, and generated tangents. Tiles that are
+   * loaded again then skip those steps. The results are only used with the
+   * plugin version, engine version, and tileset options they were created
+   * with.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Cache")
+  bool CacheConvertedTileData = true;
+
+  /**
+   * Whether to answer the requests that each tileset makes before it can load
+   * any tile - the Cesium ion asset endpoint, the root tileset.json, and the
+   * layer.json of terrain - with the responses they got in the previous
+   * session, while the requests are sent again in the background. Tiles
+   * then start loading without waiting for these round trips. The responses
+   * are used until the ion access token in them expires, or for up to a week
+   * otherwise, so a tileset that changed on the server may show its previous
+   * version for one session.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true))
+  bool WarmStartTilesetRequests = false;
+
+  /**
+   * A request cache database baked ahead of time with the CesiumBakeTiles
+   * commandlet and shipped with the project, relative to the project's
+   * Content directory. Requests are looked up in it before the on-disk cache,
+   * and its responses are used without asking the server whether they are
+   * still current, so the baked region loads without the network. It must be
+   * staged as a non-UFS file, because it can't be read from inside a pak
+   * file. Leave it empty to use only the on-disk cache.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Cache",
+      meta = (ConfigRestartRequired = true))
+  FString BakedCacheFilename;
+
+  /**
+   * Whether to record the responses to network requests in the
+   * RequestArchiveDirectory, or to answer requests from an earlier recording
+   * there without using the network. Replaying a recording makes benchmarks
+   * independent of network conditions and of changes on the servers.
+   *
+   * For automated runs, this can be set on the command line with
+   * `-ini:Engine:[/Script/CesiumRuntime.CesiumRuntimeSettings]:RequestArchiveMode=Replay`.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Benchmarking",
+      meta = (ConfigRestartRequired = true))
+  ECesiumRequestArchiveMode RequestArchiveMode =
+      ECesiumRequestArchiveMode::Disabled;
+
+  /**
+   * The directory of the recorded responses. A relative path is relative to
+   * the project's Saved directory.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Benchmarking",
+      meta = (ConfigRestartRequired = true))
+  FString RequestArchiveDirectory = TEXT("CesiumRequestArchive");
+
+  /**
+   * The time, in milliseconds, between a request and the start of its replayed
+   * response.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Benchmarking",
+      meta =
+          (ClampMin = 0,
+           Units = "Milliseconds",
+           EditCondition =
+               "RequestArchiveMode == ECesiumRequestArchiveMode::Replay",
+           ConfigRestartRequired = true))
+  float ReplayLatencyMilliseconds = 0.0f;
+
+  /**
+   * The bandwidth, in megabits per second, shared by all replayed responses.
+   * A value of zero replays responses as fast as they can be read.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Benchmarking",
+      meta =
+          (ClampMin = 0,
+           EditCondition =
+               "RequestArchiveMode == ECesiumRequestArchiveMode::Replay",
+           ConfigRestartRequired = true))
+  float ReplayBandwidthMegabitsPerSecond = 0.0f;
+
+  /**
+   * Whether to record the tile selection of each tileset in a trace in the
+   * SelectionTraceDirectory, or to replay it from an earlier trace there. A
+   * trace holds the view states, delta time and result of each view update,
+   * so that a streaming hitch can be reproduced exactly, such as in a
+   * headless run with `-nullrhi`. Replaying the views along with the request
+   * archive selects the same tiles as when they were recorded, and the log
+   * then shows how many frames selected differently, and the time spent in
+   * the view updates.
+   *
+   * This applies to the tilesets that are loaded after it is changed. For
+   * automated runs, it can be set on the command line with
+   * `-ini:Engine:[/Script/CesiumRuntime.CesiumRuntimeSettings]:SelectionTraceMode=Replay`.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Benchmarking")
+  ECesiumSelectionTraceMode SelectionTraceMode =
+      ECesiumSelectionTraceMode::Disabled;
+
+  /**
+   * The directory of the selection traces, which has one trace for each
+   * tileset, named after the tileset's actor. A relative path is relative to
+   * the project's Saved directory.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Benchmarking")
+  FString SelectionTraceDirectory = TEXT("CesiumSelectionTraces");
 };
@@ -0,0 +1,64 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumSampleHeightResult.h"
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "CesiumSampleHeightMostDetailedAsyncAction.generated.h"
+
+class ACesium3DTileset;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FCesiumSampleHeightMostDetailedComplete,
+    const TArray<FCesiumSampleHeightResult>&,
+    Result);
+
+/**
+ * The Blueprint node for
+ * {@link ACesium3DTileset::SampleHeightMostDetailedAsync}.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumSampleHeightMostDetailedAsyncAction
+    : public UBlueprintAsyncActionBase {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Samples the heights of a tileset at many positions, once the tiles that
+   * are needed have been loaded. The tileset must have Create Trace Meshes
+   * set.
+   *
+   * @param Tileset The tileset whose heights to sample.
+   * @param LongitudeLatitudeHeightArray The positions to sample, as longitude
+   * and latitude in degrees. The heights are ignored.
+   * @param LoadTilesFromHeight If greater than zero, the tiles that would be
+   * shown to a view looking down from this many meters above the ellipsoid at
+   * each position are loaded before the heights are sampled. Otherwise, only
+   * the tiles that are already shown are sampled.
+   */
+  UFUNCTION(
+      BlueprintCallable,
+      Category = "Cesium|Queries",
+      meta = (BlueprintInternalUseOnly = true))
+  static UCesiumSampleHeightMostDetailedAsyncAction* SampleHeightMostDetailed(
+      ACesium3DTileset* Tileset,
+      const TArray<FVector>& LongitudeLatitudeHeightArray,
+      double LoadTilesFromHeight = 0.0);
+
+  /**
+   * Raised with a result for each of the positions, in the same order, when
+   * the heights have been sampled.
+   */
+  UPROPERTY(BlueprintAssignable)
+  FCesiumSampleHeightMostDetailedComplete OnHeightsSampled;
+
+  virtual void Activate() override;
+
+private:
+  UPROPERTY()
+  TObjectPtr<ACesium3DTileset> _pTileset;
+
+  TArray<FVector> _positions;
+  double _loadTilesFromHeight = 0.0;
+};
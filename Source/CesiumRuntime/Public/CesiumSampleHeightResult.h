@@ -0,0 +1,29 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumSampleHeightResult.generated.h"
+
+/**
+ * The result of sampling the height of a tileset at a position.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumSampleHeightResult {
+  GENERATED_BODY()
+
+  /**
+   * The longitude in degrees (X), latitude in degrees (Y), and sampled height
+   * in meters above the ellipsoid (Z). If the sample failed, this is the
+   * position that was given.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  FVector LongitudeLatitudeHeight = FVector(0.0);
+
+  /**
+   * Whether a tile was found at the position, so that its height could be
+   * sampled.
+   */
+  UPROPERTY(BlueprintReadWrite, Category = "Cesium")
+  bool SampleSuccess = false;
+};
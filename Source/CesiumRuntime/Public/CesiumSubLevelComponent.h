@@ -404,5 +404,11 @@ private:
    */
   void _invalidateResolvedGeoreference();
 
+  /**
+   * Tells the sub-level switcher, if any, that this sub-level's origin or
+   * Load Radius has changed.
+   */
+  void _invalidateSwitcherIndex() noexcept;
+
   void PlaceOriginAtEcef(const FVector& NewOriginEcef);
 };
@@ -7,6 +7,8 @@
 
 class ACesiumGeoreference;
 class ALevelInstance;
+class UCesiumEllipsoid;
+class UCesiumSubLevelComponent;
 class ULevelStreaming;
 class UWorld;
 
@@ -60,6 +62,58 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
   void SetTargetSubLevel(ALevelInstance* LevelInstance) noexcept;
 
+  /**
+   * Gets the sub-level that is loaded in the background, but kept hidden,
+   * while it is not the target sub-level.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Sub-levels")
+  ALevelInstance* GetPreloadSubLevel() const noexcept;
+
+  /**
+   * Sets the sub-level to load in the background, and keep hidden while it is
+   * not the target sub-level, so that switching to it only needs to show it.
+   * This is usually the nearest sub-level that isn't the target. The
+   * previously preloaded sub-level, if any, is unloaded unless it is the
+   * current or target sub-level. Set it to nullptr to preload nothing.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Sub-levels")
+  void SetPreloadSubLevel(ALevelInstance* LevelInstance) noexcept;
+
+  /**
+   * A registered sub-level found by {@link FindSubLevelsNear}.
+   */
+  struct SubLevelInRange {
+    ALevelInstance* pSubLevel;
+    /** The distance from the position to the sub-level's origin, in meters. */
+    double distance;
+    /** The sub-level's Load Radius, in meters. */
+    double loadRadius;
+  };
+
+  /**
+   * Finds the enabled registered sub-levels whose origins are within their
+   * Load Radius, plus an extra distance, of an Earth-Centered, Earth-Fixed
+   * position.
+   *
+   * The sub-levels' origins are kept in a grid of cells as large as the
+   * largest Load Radius, so only the sub-levels in the cells around the
+   * position are visited. The grid is rebuilt when sub-levels are registered
+   * or unregistered, when their origins or Load Radius change, or when it is
+   * given a different ellipsoid.
+   *
+   * @param Ellipsoid The ellipsoid of the sub-levels' origins.
+   * @param Position The Earth-Centered, Earth-Fixed position.
+   * @param ExtraDistance The distance, in meters, to add to each sub-level's
+   * Load Radius.
+   * @param Result The sub-levels found, in no particular order, which replace
+   * its previous contents.
+   */
+  void FindSubLevelsNear(
+      UCesiumEllipsoid& Ellipsoid,
+      const FVector& Position,
+      double ExtraDistance,
+      TArray<SubLevelInRange>& Result);
+
 private:
   // To allow the sub-level to register/unregister itself with the functions
   // below.
@@ -84,6 +138,14 @@ private:
       FActorComponentTickFunction* ThisTickFunction) override;
 
   void _updateSubLevelStateGame();
+  void _updatePreloadedSubLevelGame();
+
+  /**
+   * Marks the grid of sub-level origins as out of date, so that it is rebuilt
+   * before it is next used.
+   */
+  void _invalidateSubLevelIndex() noexcept;
+  void _buildSubLevelIndex(UCesiumEllipsoid& ellipsoid);
 #if WITH_EDITOR
   void _updateSubLevelStateEditor();
 #endif
@@ -107,6 +169,31 @@ private:
   UPROPERTY(DuplicateTransient, TextExportTransient)
   TWeakObjectPtr<ALevelInstance> _pTarget = nullptr;
 
+  // Don't save/load or copy this.
+  UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+  TWeakObjectPtr<ALevelInstance> _pPreload = nullptr;
+
+  // The sub-level that was loaded in the background, which is unloaded when
+  // another is preloaded instead.
+  UPROPERTY(Transient, DuplicateTransient, TextExportTransient)
+  TWeakObjectPtr<ALevelInstance> _pPreloaded = nullptr;
+
+  struct IndexedSubLevel {
+    TWeakObjectPtr<ALevelInstance> pSubLevel;
+    TWeakObjectPtr<UCesiumSubLevelComponent> pComponent;
+    FVector position;
+    double loadRadius;
+  };
+
+  // The registered sub-levels' origins, and the indices of those in each
+  // cell of the grid.
+  TArray<IndexedSubLevel> _indexedSubLevels;
+  TMap<FIntVector, TArray<int32>> _indexCells;
+  double _indexCellSize = 0.0;
+  double _indexMaximumLoadRadius = 0.0;
+  TWeakObjectPtr<UCesiumEllipsoid> _pIndexEllipsoid = nullptr;
+  bool _indexIsValid = false;
+
   bool _doExtraChecksOnNextTick = false;
   bool _isTransitioningSubLevels = false;
 };
@@ -0,0 +1,82 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <glm/mat4x4.hpp>
+
+class ACesium3DTileset;
+class USceneComponent;
+
+namespace CesiumGltf {
+struct Model;
+}
+
+/**
+ * A project's own stages in the creation of the Unreal content of the tiles
+ * of a tileset, registered with {@link ACesium3DTileset::SetTileContentBuilder}
+ * so that specialized conversions, such as custom vertex formats or collision
+ * cooking, don't need changes to the plugin.
+ *
+ * A tile's glTF is first given to {@link prepareInLoadThread}, in a worker
+ * thread, before the plugin converts it into meshes, so the builder may change
+ * it and compute data of its own from it. Once all the components of the tile
+ * have been created in the game thread, they are given to
+ * {@link buildInGameThread} along with that data. Before the components are
+ * destroyed, or reused for another tile, they are given to
+ * {@link releaseInGameThread}, which must undo what the builder did to them.
+ */
+class CESIUMRUNTIME_API ICesiumTileContentBuilder {
+public:
+  /**
+   * The data of a tile that a builder computes in a worker thread.
+   */
+  class LoadThreadResult {
+  public:
+    virtual ~LoadThreadResult() = default;
+  };
+
+  virtual ~ICesiumTileContentBuilder() = default;
+
+  /**
+   * @brief Prepares a tile in a worker thread, before the plugin creates its
+   * meshes from the model. This may be called from several threads at once.
+   *
+   * @param model The tile's glTF, which may be changed.
+   * @param tileTransform The transform of the tile, from the coordinates of
+   * the model to those of the tileset.
+   * @param ellipsoid The ellipsoid of the tileset.
+   * @returns The data to give to {@link buildInGameThread}, or nullptr.
+   */
+  virtual TUniquePtr<LoadThreadResult> prepareInLoadThread(
+      CesiumGltf::Model& model,
+      const glm::dmat4& tileTransform,
+      const CesiumGeospatial::Ellipsoid& ellipsoid) = 0;
+
+  /**
+   * @brief Finishes a tile in the game thread, once all of its components
+   * have been created, and before it is first shown.
+   *
+   * @param tileset The tileset of the tile.
+   * @param tileComponent The component of the tile. The components of its
+   * primitives are attached to it.
+   * @param model The tile's glTF.
+   * @param pLoadThreadResult What {@link prepareInLoadThread} returned.
+   */
+  virtual void buildInGameThread(
+      ACesium3DTileset& tileset,
+      USceneComponent& tileComponent,
+      const CesiumGltf::Model& model,
+      TUniquePtr<LoadThreadResult>&& pLoadThreadResult) = 0;
+
+  /**
+   * @brief Undoes what {@link buildInGameThread} did to the component of a
+   * tile that is unloaded, since components are reused for other tiles. This
+   * is also called for tiles that were unloaded before they were finished.
+   */
+  virtual void releaseInGameThread(
+      ACesium3DTileset& tileset,
+      USceneComponent& tileComponent) {}
+};
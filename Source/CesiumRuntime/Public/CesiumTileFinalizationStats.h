@@ -0,0 +1,37 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CesiumTileFinalizationStats.generated.h"
+
+/**
+ * Statistics about the game-thread finalization of newly-loaded tiles,
+ * aggregated over all tilesets in a world for a single frame.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTileFinalizationStats {
+  GENERATED_BODY()
+
+  /**
+   * The number of tiles that finished loading in a worker thread and were
+   * still waiting to be finalized on the game thread after this frame's
+   * finalization.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 QueueLength = 0;
+
+  /**
+   * The number of tiles that were finalized on the game thread during the
+   * frame.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 TilesFinalized = 0;
+
+  /**
+   * The time, in milliseconds, that the game thread spent finalizing tiles
+   * during the frame.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MillisecondsSpent = 0.0;
+};
@@ -0,0 +1,93 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+#include "CesiumTilesetScheduler.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * Shares a single pool of simultaneous tile loads and a single cache budget
+ * between all of the tilesets in a world, as configured by Shared Maximum
+ * Simultaneous Tile Loads and Shared Maximum Cached MB in the Cesium project
+ * settings.
+ *
+ * The pool and budget are rebalanced once per frame. Each tileset's share of
+ * the loads is proportional to its Load Priority times the number of its
+ * tiles that were waiting to be loaded in the previous frame, and its share
+ * of the cache is proportional to its Load Priority times the number of tiles
+ * it rendered, so that tilesets covering more of the screen keep more cached
+ * tiles. No tileset is given more than its own Maximum Simultaneous Tile Loads
+ * or Maximum Cached Bytes, and each is given at least one load so that it can
+ * make progress.
+ *
+ * When Adaptive Simultaneous Tile Loads is enabled, the pool of loads is
+ * instead adjusted every frame to the capacity of the network, and a tileset
+ * may be given all of it. When the Streaming Governor is enabled, the loads
+ * are also scaled down while the device is hot or low on battery.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumTilesetScheduler : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The tile loads and cached bytes allocated to a tileset.
+   */
+  struct Allocation {
+    int32 maximumSimultaneousTileLoads = 0;
+    int64 maximumCachedBytes = 0;
+  };
+
+  /**
+   * @brief Gets the allocation of a tileset for the current frame,
+   * rebalancing the allocations of all tilesets first if this is the first
+   * call in this frame. A tileset that hasn't been allocated anything before
+   * is added to the tilesets sharing the pool.
+   */
+  Allocation allocate(const ACesium3DTileset& tileset);
+
+  /**
+   * @brief Records how many of a tileset's tiles are waiting to be loaded and
+   * how many it rendered in the current frame, to rebalance the allocations
+   * with in the next frame. A tileset that is neither allocated anything nor
+   * reports for a whole frame stops sharing the pool.
+   */
+  void reportDemand(
+      const ACesium3DTileset& tileset,
+      int32 tilesWaitingToLoad,
+      int32 tilesRendered);
+
+  /**
+   * Gets the number of simultaneous tile loads most recently allocated to a
+   * tileset, or zero if it isn't sharing the pool.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  int32 GetAllocatedSimultaneousTileLoads(
+      const ACesium3DTileset* Tileset) const;
+
+  /**
+   * Gets the number of cached bytes most recently allocated to a tileset, or
+   * zero if it isn't sharing the budget.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Tile Loading")
+  int64 GetAllocatedCachedBytes(const ACesium3DTileset* Tileset) const;
+
+private:
+  struct TilesetState {
+    TWeakObjectPtr<const ACesium3DTileset> pTileset;
+    uint64 lastActiveFrame = 0;
+    int32 tilesWaitingToLoad = 0;
+    int32 tilesRendered = 0;
+    Allocation allocation;
+  };
+
+  void rebalance();
+
+  TMap<TObjectKey<ACesium3DTileset>, TilesetState> _tilesets;
+  uint64 _lastRebalancedFrame = 0;
+};
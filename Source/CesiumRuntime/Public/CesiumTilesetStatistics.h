@@ -0,0 +1,358 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Subsystems/EngineSubsystem.h"
+#include <array>
+#include "CesiumTilesetStatistics.generated.h"
+
+/**
+ * A stage of the tile load pipeline that is timed by
+ * {@link UCesiumTilesetStatistics}.
+ */
+UENUM(BlueprintType)
+enum class ECesiumTileLoadStage : uint8 {
+  /**
+   * The time from sending an HTTP request until its response is complete.
+   * Requests for tileset and raster overlay metadata are included, as well as
+   * tile content.
+   */
+  NetworkFetch,
+
+  /**
+   * The time spent in a worker thread creating the Unreal mesh data for a
+   * tile's glTF.
+   */
+  CreateOffGameThread,
+
+  /**
+   * The time spent in the render thread creating the RHI resource for a tile
+   * or raster overlay texture.
+   */
+  TextureCreation,
+
+  /**
+   * The game-thread time spent creating the Unreal components for a tile in
+   * the frame in which it is first finalized.
+   */
+  CreateOnGameThread,
+
+  /**
+   * The time spent in a worker thread reordering the triangles and vertices
+   * of a single glTF primitive, for tilesets with Optimize Meshes set. This
+   * time is also included in CreateOffGameThread.
+   */
+  MeshOptimization,
+
+  /**
+   * The time spent reading a response from the on-disk request cache,
+   * whether or not it was found.
+   */
+  CacheRead,
+
+  /**
+   * The game-thread time of one tileset's view update, which selects the
+   * tiles to render for all of its views and includes the CreateOnGameThread
+   * time of the tiles finalized during the update.
+   */
+  ViewUpdate,
+
+  /**
+   * The game-thread time of one tileset's update of its occlusion proxies,
+   * which are tested in each of its views.
+   */
+  OcclusionUpdate
+};
+
+/**
+ * Rolling statistics for a single stage of the tile load pipeline, computed
+ * from its most recent samples. All times are in milliseconds.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumTileLoadStageStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of samples that these statistics were computed from.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 SampleCount = 0;
+
+  /**
+   * The total number of samples recorded for this stage since the statistics
+   * were last reset, including those no longer in the rolling window.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 TotalSampleCount = 0;
+
+  /**
+   * The sum of all samples recorded for this stage since the statistics were
+   * last reset, including those no longer in the rolling window. Runs of a
+   * stage on different threads overlap, so this can exceed the time that has
+   * passed.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double TotalMilliseconds = 0.0;
+
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double AverageMilliseconds = 0.0;
+
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double P50Milliseconds = 0.0;
+
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double P90Milliseconds = 0.0;
+
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double P99Milliseconds = 0.0;
+
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  double MaximumMilliseconds = 0.0;
+};
+
+/**
+ * Counts of the HTTP requests made to a single host through the Cesium asset
+ * accessor, for all tilesets and raster overlays.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumHostRequestStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The host name, without scheme or port.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  FString Host;
+
+  /**
+   * The number of requests waiting to be sent because the host is at its
+   * limit of simultaneous requests.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 PendingRequests = 0;
+
+  /**
+   * The number of requests that have been sent and have not yet completed.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 ActiveRequests = 0;
+
+  /**
+   * The number of requests that received a successful response since the
+   * statistics were last reset.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 CompletedRequests = 0;
+
+  /**
+   * The number of requests that failed, received an error response, or were
+   * cancelled since the statistics were last reset.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 FailedRequests = 0;
+
+  /**
+   * The number of response body bytes received since the statistics were last
+   * reset.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 BytesReceived = 0;
+};
+
+/**
+ * Hit and miss counts for the tiers of the request cache. A request is looked
+ * up in the in-memory tier first, then in the on-disk tier, and is fetched
+ * from the network only if neither has a fresh response.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumRequestCacheStatistics {
+  GENERATED_BODY()
+
+  /**
+   * The number of requests answered by the in-memory tier.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MemoryHits = 0;
+
+  /**
+   * The number of requests that the in-memory tier passed on to the on-disk
+   * tier.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MemoryMisses = 0;
+
+  /**
+   * The number of requests that missed the in-memory tier and were answered
+   * by the on-disk tier without a network request.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 DiskHits = 0;
+
+  /**
+   * The number of requests that missed both tiers and were fetched from the
+   * network, including revalidations of stale responses.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 DiskMisses = 0;
+
+  /**
+   * The number of responses currently held by the in-memory tier.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int32 MemoryEntries = 0;
+
+  /**
+   * The total size of the responses currently held by the in-memory tier.
+   */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Cesium")
+  int64 MemoryBytes = 0;
+};
+
+/**
+ * Records how long each stage of the tile load pipeline takes, for all
+ * tilesets, and keeps rolling percentiles over the most recent samples of
+ * each stage. It also counts the HTTP requests made to each host and the hits
+ * and misses of the request cache. Access it from Blueprints with the "Get
+ * Engine Subsystem" node.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumTilesetStatistics : public UEngineSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * The number of most recent samples of each stage that the statistics are
+   * computed from.
+   */
+  static constexpr int32 MaximumSamplesPerStage = 1024;
+
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+  virtual void Deinitialize() override;
+
+  /**
+   * Records the time taken by one run of a stage. This may be called from any
+   * thread, and does nothing if the subsystem has not been initialized.
+   */
+  static void
+  RecordStage(ECesiumTileLoadStage Stage, double ElapsedMilliseconds);
+
+  /**
+   * Records that an HTTP request to the given host is waiting to be sent.
+   * This and the other request functions may be called from any thread, and
+   * do nothing if the subsystem has not been initialized.
+   */
+  static void RecordRequestQueued(const FString& Host);
+
+  /**
+   * Records that a waiting HTTP request to the given host has been sent.
+   */
+  static void RecordRequestStarted(const FString& Host);
+
+  /**
+   * Records that an HTTP request to the given host has finished, whether or
+   * not it was sent.
+   *
+   * @param Host The host of the request.
+   * @param bWasStarted True if the request had been sent, false if it was
+   * cancelled while waiting.
+   * @param bSucceeded True if the request received a successful response.
+   * @param BytesReceived The size of the response body.
+   */
+  static void RecordRequestFinished(
+      const FString& Host,
+      bool bWasStarted,
+      bool bSucceeded,
+      int64 BytesReceived);
+
+  /**
+   * Records a lookup in the in-memory tier of the request cache.
+   */
+  static void RecordMemoryCacheLookup(bool bHit);
+
+  /**
+   * Records the current contents of the in-memory tier of the request cache.
+   */
+  static void RecordMemoryCacheSize(int32 Entries, int64 Bytes);
+
+  /**
+   * Records a request that missed the on-disk tier of the request cache and
+   * was sent to the network.
+   */
+  static void RecordDiskCacheMiss();
+
+  /**
+   * Gets the statistics for a stage of the tile load pipeline.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  FCesiumTileLoadStageStatistics
+  GetStageStatistics(ECesiumTileLoadStage Stage) const;
+
+  /**
+   * Gets the request counts of every host that has been sent a request since
+   * the statistics were last reset, or that has requests waiting or in
+   * flight.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  TArray<FCesiumHostRequestStatistics> GetHostStatistics() const;
+
+  /**
+   * Gets the hit and miss counts of the request cache tiers.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  FCesiumRequestCacheStatistics GetCacheStatistics() const;
+
+  /**
+   * Discards all recorded samples, request totals, and cache hit and miss
+   * counts. The counts of waiting and in-flight requests and the contents of
+   * the in-memory cache are kept, since those are still current.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  void Reset();
+
+  /**
+   * Formats the statistics of every stage as CSV, with a header row followed
+   * by one row per stage.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  FString ExportToCsv() const;
+
+  /**
+   * Writes the statistics of every stage to a CSV file, replacing it if it
+   * exists.
+   *
+   * @return True if the file was written.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  bool SaveToCsvFile(const FString& Filename) const;
+
+  /**
+   * Formats the request counts of every host as CSV, with a header row
+   * followed by one row per host.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium|Statistics")
+  FString ExportHostStatisticsToCsv() const;
+
+private:
+  struct StageSamples {
+    TArray<double> samples;
+    int32 next = 0;
+    int64 total = 0;
+    double totalMilliseconds = 0.0;
+  };
+
+  static constexpr int32 StageCount =
+      int32(ECesiumTileLoadStage::OcclusionUpdate) + 1;
+
+  void record(ECesiumTileLoadStage stage, double milliseconds);
+
+  static void updateHost(
+      const FString& host,
+      TFunctionRef<void(FCesiumHostRequestStatistics&)> update);
+
+  mutable FCriticalSection _lock;
+  std::array<StageSamples, StageCount> _stages;
+  TMap<FString, FCesiumHostRequestStatistics> _hosts;
+  FCesiumRequestCacheStatistics _cache;
+};
@@ -0,0 +1,122 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "CesiumTimeDynamicTilesetComponent.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * Shows one of a series of tilesets, such as the time steps of a flood
+ * simulation or of the progress of a construction site, on the
+ * Cesium3DTileset that owns it while playing.
+ *
+ * Rather than changing the URL of the tileset, which unloads all of its tiles
+ * before the next time step starts loading, each time step is loaded by a
+ * tileset of its own, with all of the settings of the owner. The current time
+ * step and the next few are loaded at once, for the same views. The time
+ * steps that aren't shown are hidden and have no collision, and their tiles
+ * load at a lower priority than those of the time step that is shown. Moving
+ * to the next time step then only swaps which tileset is visible.
+ *
+ * Tiles that are identical in several time steps are downloaded once when
+ * they have the same URL, and their textures are kept in GPU memory once, as
+ * they are for any tilesets.
+ *
+ * The tileset of each time step is spawned with the class, transform, and
+ * editable Cesium3DTileset properties of the owner, such as its georeference
+ * and materials. The components of the owner, like its raster overlays, are
+ * not copied. The owner itself loads nothing while the component is in use,
+ * and its original state is restored when play ends.
+ */
+UCLASS(ClassGroup = (Cesium), meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumTimeDynamicTilesetComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumTimeDynamicTilesetComponent();
+
+  /**
+   * The URLs of the tilesets of the time steps, in order.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Time Dynamic")
+  TArray<FString> TimeStepUrls;
+
+  /**
+   * The index of the time step to show.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Time Dynamic",
+      meta = (ClampMin = 0))
+  int32 CurrentTimeStep = 0;
+
+  /**
+   * The number of time steps after the current one that are loaded ahead of
+   * time. Each of them takes as much memory as the current one, except for
+   * what they share.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Time Dynamic",
+      meta = (ClampMin = 0))
+  int32 PrefetchTimeSteps = 1;
+
+  /**
+   * Whether the first time step follows the last one, so that the first time
+   * steps are loaded ahead of time while the last ones are shown.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Time Dynamic")
+  bool Loop = true;
+
+  /**
+   * Whether to keep showing the previous time step until the current one has
+   * finished loading, rather than showing the current one while it loads.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Time Dynamic")
+  bool WaitForTimeStepToLoad = true;
+
+  /**
+   * Gets the index of the time step that is shown, which is the current time
+   * step once it has loaded, or -1 if none is shown.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Time Dynamic")
+  int32 GetDisplayedTimeStep() const { return this->_displayedTimeStep; }
+
+  /**
+   * Gets the tileset that loads a time step, or nullptr if the time step
+   * isn't loaded.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium|Time Dynamic")
+  ACesium3DTileset* GetTimeStepTileset(int32 TimeStep) const;
+
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  virtual void TickComponent(
+      float DeltaTime,
+      ELevelTick TickType,
+      FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+  ACesium3DTileset* getTileset() const;
+  ACesium3DTileset* spawnTimeStep(ACesium3DTileset& owner, int32 timeStep);
+  bool isLoaded(int32 timeStep) const;
+  void destroyTimeSteps();
+
+  // The tilesets of the time steps that are loaded, by time step.
+  UPROPERTY(Transient)
+  TMap<int32, TObjectPtr<ACesium3DTileset>> _timeSteps;
+
+  int32 _displayedTimeStep = -1;
+
+  // The state of the owner before play, which is restored when play ends.
+  bool _isControlling = false;
+  bool _originalSuspendUpdate = false;
+  bool _originalHidden = false;
+  bool _originalCollision = true;
+};
@@ -0,0 +1,96 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "CesiumVoxelRendering.generated.h"
+
+/**
+ * Options for adjusting how the voxels of a voxel tileset
+ * (3DTILES_content_voxels) are rendered.
+ *
+ * The voxels are raymarched, and a single property of them is drawn. Its
+ * values are mapped to colors between the Minimum Color and the Maximum
+ * Color, and the alpha of the colors scales how much light the voxels absorb.
+ *
+ * These settings are not supported on mobile platforms.
+ */
+USTRUCT(BlueprintType)
+struct CESIUMRUNTIME_API FCesiumVoxelRendering {
+  GENERATED_USTRUCT_BODY()
+
+  /**
+   * The name of the property of the voxels that is drawn. If this is empty,
+   * the first property of the voxels is drawn.
+   *
+   * Changing this reloads the tileset.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString Attribute;
+
+  /**
+   * The value of the property that is drawn with the Minimum Color. Smaller
+   * values are drawn with it too.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  float MinimumValue = 0.0f;
+
+  /**
+   * The value of the property that is drawn with the Maximum Color. Larger
+   * values are drawn with it too.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  float MaximumValue = 1.0f;
+
+  /**
+   * The color of voxels with the Minimum Value. An alpha of zero makes them
+   * invisible.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor MinimumColor = FLinearColor(0.0f, 0.0f, 1.0f, 0.0f);
+
+  /**
+   * The color of voxels with the Maximum Value.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FLinearColor MaximumColor = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f);
+
+  /**
+   * How much light a meter of voxels with an alpha of one absorbs. Light
+   * passing through them keeps `exp(-Density * alpha * meters)` of its
+   * intensity.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 0.0))
+  float Density = 0.01f;
+
+  /**
+   * The largest number of samples that are taken along a ray through the
+   * voxels of a tile. By default, the voxels are sampled twice per voxel that
+   * a ray passes through.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1, ClampMax = 1024))
+  int32 MaximumSteps = 256;
+
+  bool operator==(const FCesiumVoxelRendering& OtherVoxelRendering) const {
+    return Attribute == OtherVoxelRendering.Attribute &&
+           MinimumValue == OtherVoxelRendering.MinimumValue &&
+           MaximumValue == OtherVoxelRendering.MaximumValue &&
+           MinimumColor == OtherVoxelRendering.MinimumColor &&
+           MaximumColor == OtherVoxelRendering.MaximumColor &&
+           Density == OtherVoxelRendering.Density &&
+           MaximumSteps == OtherVoxelRendering.MaximumSteps;
+  }
+
+  bool operator!=(const FCesiumVoxelRendering& OtherVoxelRendering) const {
+    return !(*this == OtherVoxelRendering);
+  }
+};
@@ -75,6 +75,25 @@ public:
       meta = (ClampMin = 0))
   int32 MaximumLevel = 14;
 
+  /**
+   * The number of tiles along each side of the blocks of tiles that are
+   * requested together.
+   *
+   * When this is more than 1, each GetMap request covers a block of up to
+   * this many by this many tiles, and the block's image is cut into tiles as
+   * it arrives, so that loading an area takes far fewer requests. This only
+   * works with servers that accept larger images, up to 2048 pixels on a side,
+   * and that draw the same image for a block as for its tiles, which is not
+   * the case for layers whose labels are placed within each image. Tiles that
+   * can't be requested as part of a block are requested on their own.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium",
+      meta = (ClampMin = 1, ClampMax = 4))
+  int32 RequestBundleSize = 1;
+
 protected:
   virtual std::unique_ptr<CesiumRasterOverlays::RasterOverlay> CreateOverlay(
       const CesiumRasterOverlays::RasterOverlayOptions& options = {}) override;
@@ -7,6 +7,7 @@
 #include "HAL/Platform.h"
 #include <glm/fwd.hpp>
 #include <glm/vec3.hpp>
+#include <optional>
 
 /**
  * @brief A lightweight structure to encapsulate coordinate transforms.
@@ -57,6 +58,31 @@ public:
    */
   void setEllipsoid(const CesiumGeospatial::Ellipsoid& ellipsoid) noexcept;
 
+  /**
+   * @brief Set the radius within which ECEF positions are converted to
+   * longitude, latitude, and height with a local approximation.
+   *
+   * Within this distance of the center, in meters,
+   * {@link TransformEcefToLongitudeLatitudeHeight} uses the circle that
+   * osculates the ellipsoid's meridian at the center instead of the exact
+   * iterative conversion. This is several times cheaper and, within 20
+   * kilometers, accurate to a fraction of a millimeter. Positions farther
+   * away, and all positions when the center is within this radius of a pole,
+   * use the exact conversion. The default of zero always uses the exact
+   * conversion.
+   *
+   * @param radius The radius in meters.
+   */
+  void setLocalApproximationRadius(double radius) noexcept;
+
+  /**
+   * @brief Gets the radius within which ECEF positions are converted to
+   * longitude, latitude, and height with a local approximation.
+   */
+  double getLocalApproximationRadius() const noexcept {
+    return this->_localApproximationRadius;
+  }
+
   /**
    * Transforms the given longitude in degrees (x), latitude in
    * degrees (y), and height in meters (z) into Earth-Centered, Earth-Fixed
@@ -229,6 +255,26 @@ private:
    */
   void updateTransforms() noexcept;
 
+  /**
+   * The center, the radius of curvature of the ellipsoid's meridian there,
+   * and the coefficient of the second-order correction to the latitude,
+   * precomputed for the local approximation of the conversion from ECEF to
+   * longitude, latitude, and height.
+   */
+  struct LocalApproximation {
+    double latitude;
+    double height;
+    double sinLatitude;
+    double cosLatitude;
+    double distanceFromAxis;
+    double z;
+    double meridianRadius;
+    double latitudeCorrection;
+  };
+
+  std::optional<glm::dvec3>
+  approximateEcefToLongitudeLatitudeHeight(const glm::dvec3& ecef) const;
+
   CesiumGeospatial::LocalHorizontalCoordinateSystem _coordinateSystem;
 
   // Modifiable state
@@ -237,4 +283,6 @@ private:
   double _scale;
   FMatrix _ecefToUnreal;
   FMatrix _unrealToEcef;
+  double _localApproximationRadius;
+  std::optional<LocalApproximation> _localApproximation;
 };
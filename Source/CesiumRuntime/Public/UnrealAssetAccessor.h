@@ -7,7 +7,29 @@
 #include "Containers/UnrealString.h"
 #include "HAL/Platform.h"
 #include <cstddef>
+#include <memory>
 
+/**
+ * An asset accessor that downloads through Unreal's HTTP module and reads
+ * file:/// URLs from disk.
+ *
+ * HTTP requests are not all sent at once. Each host has a limit on the number
+ * of requests in flight, and the rest wait in a queue. Waiting requests are
+ * sent in order of their priority, and among those with equal priority,
+ * requests made since the most recent {@link tick} go first. This way, when
+ * the camera moves quickly, tiles that just became visible don't wait behind
+ * downloads for tiles that were requested frames ago. Requests can also be
+ * cancelled, whether they are waiting or in flight.
+ *
+ * If `CompleteRequestsOnHttpThread` is enabled in the Cesium runtime settings,
+ * requests complete on Unreal's HTTP thread rather than when the HTTP manager
+ * is ticked on the game thread, so downloads are not limited by the frame
+ * rate.
+ *
+ * If `CacheDecompressedResponses` is enabled in the Cesium runtime settings,
+ * gzip-compressed responses to GET requests are inflated when their data is
+ * first read, so that the request cache stores them already inflated.
+ */
 class CESIUMRUNTIME_API UnrealAssetAccessor
     : public CesiumAsync::IAssetAccessor {
 public:
@@ -29,7 +51,48 @@ public:
 
   virtual void tick() noexcept override;
 
+  /**
+   * Sets the maximum number of HTTP requests that may be in flight to any
+   * single host. Further requests to that host wait until one completes. A
+   * value of zero removes the limit. The initial value is taken from
+   * `MaximumSimultaneousRequestsPerHost` in the Cesium runtime settings.
+   */
+  void setMaximumRequestsPerHost(int32 maximumRequestsPerHost);
+
+  /**
+   * Gets the maximum number of HTTP requests that may be in flight to any
+   * single host.
+   */
+  int32 getMaximumRequestsPerHost() const;
+
+  /**
+   * Sets the priority of the waiting request, if any, for the given URL.
+   * Requests with lower values are sent first. Requests have a priority of
+   * zero unless one is set here. This has no effect on requests that have
+   * already been sent.
+   */
+  void setRequestPriority(const std::string& url, double priority);
+
+  /**
+   * Cancels the requests, waiting or in flight, for the given URL. The futures
+   * returned for them are rejected.
+   */
+  void cancelRequest(const std::string& url);
+
+  /**
+   * Gets the number of HTTP requests that are waiting to be sent.
+   */
+  int32 getPendingRequestCount() const;
+
+  /**
+   * Gets the number of HTTP requests that have been sent and have not yet
+   * completed.
+   */
+  int32 getActiveRequestCount() const;
+
 private:
+  class RequestQueue;
+
   CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> getFromFile(
       const CesiumAsync::AsyncSystem& asyncSystem,
       const std::string& url,
@@ -37,4 +100,7 @@ private:
 
   FString _userAgent;
   TMap<FString, FString> _cesiumRequestHeaders;
+  std::shared_ptr<RequestQueue> _pRequestQueue;
+  bool _completeOnHttpThread;
+  bool _decompressResponses;
 };
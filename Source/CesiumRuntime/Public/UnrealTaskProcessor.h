@@ -4,9 +4,139 @@
 
 #include "CesiumAsync/ITaskProcessor.h"
 #include "HAL/Platform.h"
+#include <array>
+#include <atomic>
+#include <memory>
 
+/**
+ * The priority of the background work started by Cesium. Work of a higher
+ * priority is started before waiting work of a lower priority.
+ */
+enum class ECesiumTaskPriority : uint8 {
+  /** Work needed for the tiles selected for rendering. */
+  High,
+  /** Work with no particular priority. */
+  Normal,
+  /** Work for tiles that aren't needed yet, like preloading and prefetching. */
+  Low
+};
+
+/**
+ * Sets the priority of the background work started on this thread while it
+ * is in scope. Work started by a task runs with the priority of that task
+ * unless a scope sets another, so the continuations of an asynchronous chain
+ * have the priority the chain was started with.
+ */
+class CESIUMRUNTIME_API CesiumTaskPriorityScope {
+public:
+  explicit CesiumTaskPriorityScope(ECesiumTaskPriority priority) noexcept;
+  ~CesiumTaskPriorityScope() noexcept;
+
+  CesiumTaskPriorityScope(const CesiumTaskPriorityScope&) = delete;
+  CesiumTaskPriorityScope& operator=(const CesiumTaskPriorityScope&) = delete;
+
+  /**
+   * Gets the priority of the background work started on this thread.
+   */
+  static ECesiumTaskPriority getCurrent() noexcept;
+
+private:
+  ECesiumTaskPriority _previous;
+};
+
+/**
+ * Runs Cesium's background work, in order of its priority.
+ *
+ * By default, the work runs on Unreal's background task threads, where the
+ * high priority work uses the high priority threads. Alternatively, the work
+ * can run on a pool of threads dedicated to Cesium. Each dedicated thread has
+ * its own queues, one per priority. Work started on a dedicated thread is
+ * added to that thread's queues and the thread takes its newest work first,
+ * while it's still in the cache, and work started elsewhere is added to
+ * shared queues. A thread without work of a priority takes the oldest work of
+ * that priority from the shared queues, and then from the other threads'
+ * queues, before it looks for work of a lower priority.
+ */
 class CESIUMRUNTIME_API UnrealTaskProcessor
     : public CesiumAsync::ITaskProcessor {
 public:
+  /**
+   * The number of pieces of work of one priority.
+   */
+  struct QueueStatistics {
+    /** The number of pieces of work started. */
+    int64 submitted = 0;
+    /** The number of pieces of work finished. */
+    int64 completed = 0;
+    /**
+     * The number of pieces of work that a dedicated thread took from
+     * another dedicated thread's queue.
+     */
+    int64 stolen = 0;
+    /**
+     * The number of pieces of work that have been started and are waiting to
+     * run.
+     */
+    int64 queued = 0;
+  };
+
+  /**
+   * Creates a task processor.
+   *
+   * @param dedicatedThreadCount The number of threads dedicated to Cesium's
+   * work. If this is zero, the work runs on Unreal's background task threads
+   * instead.
+   */
+  explicit UnrealTaskProcessor(int32 dedicatedThreadCount = 0);
+  virtual ~UnrealTaskProcessor() noexcept;
+
   virtual void startTask(std::function<void()> f) override;
+
+  /**
+   * Gets the number of pieces of work of the given priority so far.
+   */
+  QueueStatistics getStatistics(ECesiumTaskPriority priority) const noexcept;
+
+  /**
+   * Gets the number of threads dedicated to Cesium's work, or zero if it runs
+   * on Unreal's background task threads.
+   */
+  int32 getDedicatedThreadCount() const noexcept;
+
+  /**
+   * Sets how many of the dedicated threads run work, between one and all of
+   * them. The other threads wait, without taking work, until they are
+   * allowed to run again, and their waiting work is taken by the threads
+   * that run. This has no effect if the work runs on Unreal's background
+   * task threads.
+   */
+  void setActiveDedicatedThreadCount(int32 count) noexcept;
+
+  /**
+   * Stops the dedicated threads, if any, after they finish the work that has
+   * been started. Work started later runs on Unreal's background task
+   * threads.
+   */
+  void shutdown() noexcept;
+
+private:
+  class WorkerPool;
+
+  struct Counters {
+    std::atomic<int64> submitted{0};
+    std::atomic<int64> started{0};
+    std::atomic<int64> completed{0};
+    std::atomic<int64> stolen{0};
+  };
+
+  struct Task;
+  class FCesiumGraphTask;
+
+  static void startOnTaskGraph(Task&& task) noexcept;
+
+  static constexpr size_t PriorityCount = 3;
+
+  std::array<Counters, PriorityCount> _counters;
+  std::unique_ptr<WorkerPool> _pPool;
+  std::atomic<WorkerPool*> _pActivePool;
 };